@@ -89,6 +89,47 @@ macro(global_target_config)
 
     set_target_properties (${LRS_TARGET} PROPERTIES FOLDER Library)
 
+    if(BUILD_WITH_JPEG_TURBO)
+        find_package(JPEG REQUIRED)
+        target_include_directories(${LRS_TARGET} PRIVATE ${JPEG_INCLUDE_DIR})
+        target_link_libraries(${LRS_TARGET} PRIVATE ${JPEG_LIBRARIES})
+        target_compile_definitions(${LRS_TARGET} PRIVATE RS2_USE_JPEG_TURBO)
+    endif()
+
+    if(BUILD_WITH_L500)
+        target_compile_definitions(${LRS_TARGET} PRIVATE WITH_L500=1)
+    endif()
+
+    if(BUILD_WITH_SR300)
+        target_compile_definitions(${LRS_TARGET} PRIVATE WITH_SR300=1)
+    endif()
+
+    if(BUILD_WITH_PROFILER STREQUAL "TRACY")
+        find_package(Tracy REQUIRED)
+        target_link_libraries(${LRS_TARGET} PRIVATE Tracy::TracyClient)
+        target_compile_definitions(${LRS_TARGET} PRIVATE RS2_PROFILER_TRACY)
+    elseif(BUILD_WITH_PROFILER STREQUAL "ITT")
+        find_path(ITT_INCLUDE_DIR ittnotify.h HINTS ${ITT_DIR}/include)
+        find_library(ITT_LIBRARY ittnotify HINTS ${ITT_DIR}/lib64 ${ITT_DIR}/lib)
+        if(NOT ITT_INCLUDE_DIR OR NOT ITT_LIBRARY)
+            message(FATAL_ERROR "BUILD_WITH_PROFILER=ITT requires ittnotify, set ITT_DIR to its location")
+        endif()
+        target_include_directories(${LRS_TARGET} PRIVATE ${ITT_INCLUDE_DIR})
+        target_link_libraries(${LRS_TARGET} PRIVATE ${ITT_LIBRARY} ${CMAKE_DL_LIBS})
+        target_compile_definitions(${LRS_TARGET} PRIVATE RS2_PROFILER_ITT)
+    elseif(BUILD_WITH_PROFILER STREQUAL "PERFETTO")
+        if(NOT EXISTS ${PERFETTO_SDK_DIR}/perfetto.cc)
+            message(FATAL_ERROR "BUILD_WITH_PROFILER=PERFETTO requires PERFETTO_SDK_DIR, the sdk directory of Perfetto")
+        endif()
+        # The SDK requires C++17
+        set_target_properties(${LRS_TARGET} PROPERTIES CXX_STANDARD 17)
+        target_sources(${LRS_TARGET} PRIVATE ${PERFETTO_SDK_DIR}/perfetto.cc)
+        target_include_directories(${LRS_TARGET} PRIVATE ${PERFETTO_SDK_DIR})
+        target_compile_definitions(${LRS_TARGET} PRIVATE RS2_PROFILER_PERFETTO)
+    elseif(NOT BUILD_WITH_PROFILER STREQUAL "NONE")
+        message(FATAL_ERROR "Unknown BUILD_WITH_PROFILER ${BUILD_WITH_PROFILER}, expected NONE, TRACY, ITT or PERFETTO")
+    endif()
+
     target_include_directories(${LRS_TARGET}
         PRIVATE
             ${ROSBAG_HEADER_DIRS}
@@ -2,9 +2,15 @@ option(ENABLE_CCACHE "Build with ccache." ON)
 option(BUILD_WITH_CUDA "Enable CUDA" OFF)
 option(BUILD_GRAPHICAL_EXAMPLES "Build graphical examples and tools. Implies BUILD_GLSL_EXTENSIONS" ON)
 option(BUILD_GLSL_EXTENSIONS "Build GLSL extensions API" ON)
+option(BUILD_GLSL_EGL "Let the GLSL extensions process on an offscreen EGL context, for machines without a display. Requires libEGL" OFF)
 option(BUILD_WITH_OPENMP "Use OpenMP" OFF)
+option(BUILD_WITH_JPEG_TURBO "Decode MJPEG with libjpeg-turbo" OFF)
 option(ENABLE_ZERO_COPY "Enable zero copy functionality" OFF)
 option(BUILD_WITH_TM2 "Build with support for Intel TM2 tracking device" ON)
+option(BUILD_WITH_L500 "Build with support for the L500 devices, their auto-calibration and the zero order processing block" ON)
+option(BUILD_WITH_SR300 "Build with support for the SR300 devices" ON)
+set(BUILD_WITH_PROFILER "NONE" CACHE STRING "Instrument the frame path for a profiler: NONE, TRACY, ITT (Intel ITT, set ITT_DIR) or PERFETTO (set PERFETTO_SDK_DIR)")
+set_property(CACHE BUILD_WITH_PROFILER PROPERTY STRINGS NONE TRACY ITT PERFETTO)
 option(BUILD_EASYLOGGINGPP "Build EasyLogging++ as a part of the build" ON)
 option(BUILD_WITH_STATIC_CRT "Build with static link CRT" ON)
 option(HWM_OVER_XU "Send HWM commands over UVC XU control" ON)
@@ -27,7 +33,11 @@ option(BUILD_OPENNI2_BINDINGS "Build OpenNI bindings" OFF)
 option(IMPORT_DEPTH_CAM_FW "Download the latest firmware for the depth cameras" ON)
 option(BUILD_CV_KINFU_EXAMPLE "Build OpenCV KinectFusion example" OFF)
 option(FORCE_RSUSB_BACKEND "Use RS USB backend, mandatory for Win7/MacOS/Android, optional for Linux" OFF)
+option(BUILD_WINUSB_STREAMING "Build the RS USB backend next to Media Foundation on Windows, selected at runtime by RS2_BACKEND=rsusb (requires the WinUSB driver)" OFF)
 option(BUILD_NETWORK_DEVICE "Build Network Device support" OFF)
+option(BUILD_NETWORK_VIDEO_CODEC "Let the network device stream color as H.264 or H.265, through the hardware encoders of FFmpeg when available. Requires libavcodec, libavutil and libswscale" OFF)
+option(BUILD_SHM_DEVICE "Build Shared Memory Device support, to stream one device to several processes" OFF)
+option(ENABLE_SHM_DEVICE_LOCK "Lock the V4L devices across processes with a robust mutex in shared memory instead of a file lock, Linux only. All the processes sharing a camera must be built alike" OFF)
 option(FORCE_LIBUVC "Explicitly turn-on libuvc backend - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
 option(FORCE_WINUSB_UVC "Explicitly turn-on winusb_uvc (for win7) backend - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
 option(ANDROID_USB_HOST_UVC "Build UVC backend for Android - deprecated, use FORCE_RSUSB_BACKEND instead" OFF)
@@ -25,6 +25,9 @@ macro(os_set_flags)
         set(BACKEND RS2_USE_WINUSB_UVC_BACKEND)
     else()
         set(BACKEND RS2_USE_WMF_BACKEND)
+        if(BUILD_WINUSB_STREAMING)
+            add_definitions(-DRS2_WITH_WINUSB_STREAMING)
+        endif()
     endif()
 
     if(MSVC)
@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 #define ONE_NIBBLE_ROLLED() \
        currentState = stateWord & 0x7fc0; \
@@ -8829,6 +8830,50 @@ static int DecompressionStateTable[510 * 16] =
 };
 
 
+// Two nibbles of the state table composed into one step per compressed byte, so that decoding a byte waits on a single table
+// lookup rather than on two. For state s and byte b the entry holds the event of the state the first nibble leads to (bits 0-7 the
+// difference to the pixel above, bit 8-10 the repeat count, bit 11 whether it is emitted), that state (bits 12-20)
+// and the state the second nibble leads to (bits 21-29)
+#define HUFFMAN_STATES 510
+
+static const uint32_t* get_decompression_byte_table()
+{
+    static const std::vector<uint32_t> table = []()
+    {
+        std::vector<uint32_t> res(HUFFMAN_STATES * 256);
+        for (uint32_t state = 0; state < HUFFMAN_STATES; state++)
+        {
+            for (uint32_t byte = 0; byte < 256; byte++)
+            {
+                uint32_t first = (uint32_t)DecompressionStateTable[state * 16 + (byte >> 4)];
+                uint32_t first_state = (first & 0x7fc0) >> 6;
+                uint32_t second = (uint32_t)DecompressionStateTable[first_state * 16 + (byte & 0xf)];
+                uint32_t second_state = (second & 0x7fc0) >> 6;
+                res[state * 256 + byte] = (first >> 24) | ((first & 0xf) << 8) | (first_state << 12) | (second_state << 21);
+            }
+        }
+        return res;
+    }();
+    return table.data();
+}
+
+// Writes the pixel of an emitting state and the pixels it repeats from the line above. Without branching on the state:
+// 8 bytes are always written and the line only advances past the emitted ones, the others are overwritten by the next events
+static inline void emit_pixels(unsigned char*& currentImageLine, uint32_t stride_bytes, uint32_t flag_and_count, unsigned char difference)
+{
+    const unsigned char* above = currentImageLine - stride_bytes;
+    memcpy(currentImageLine, above, 8);
+    currentImageLine[0] = (unsigned char)(above[0] + difference);
+    currentImageLine += ((flag_and_count >> 3) & 1) * ((flag_and_count & 0x7) + 1);
+}
+
+#define ONE_BYTE(_byte_, _second_nibble_) \
+       entry = byteTable[(state << 8) | (_byte_)]; \
+       emit_pixels(currentImageLine, stride_bytes, stateWord & 0xf, (unsigned char)(stateWord >> 24)); \
+       emit_pixels(currentImageLine, stride_bytes, (entry >> 8) & 0xf, (unsigned char)entry); \
+       stateWord = (uint32_t)DecompressionStateTable[((entry >> 12) & 0x1ff) * 16 + (_second_nibble_)]; \
+       state = entry >> 21;
+
 bool unhuffimage4(uint32_t* compressed_image, uint32_t compressed_length_u32s, uint32_t stride_bytes, uint32_t height, unsigned char* image)
 {
     memcpy(((char*)(image)), ((char*)(compressed_image)), stride_bytes);
@@ -8846,6 +8891,29 @@ bool unhuffimage4(uint32_t* compressed_image, uint32_t compressed_length_u32s, u
     uint32_t stateWord = *(uint32_t*)(((unsigned char*)DecompressionStateTable) + currentState + nibble);
 
     unsigned char* end = image + stride_bytes * height - 32;
+
+    // A compressed word emits up to 64 pixels, the byte steps run while the whole word and the bytes copied past it fit before end.
+    // The nibble loops below take over at the same point of the word, for the end of the image and of the compressed data
+    if (stride_bytes >= 8 && end - currentImageLine > 72) {
+        const uint32_t* byteTable = get_decompression_byte_table();
+        unsigned char* bytesEnd = end - 72;
+        uint32_t state = (stateWord & 0x7fc0) >> 6;
+        uint32_t entry;
+        while (currentImageLine < bytesEnd && currentCompressedWordP < compressedLim) {
+            uint32_t nextCompressedWord = *currentCompressedWordP;
+
+            ONE_BYTE((compressedWord >> 20) & 0xff, (compressedWord >> 20) & 0xf);
+            ONE_BYTE((compressedWord >> 12) & 0xff, (compressedWord >> 12) & 0xf);
+            ONE_BYTE((compressedWord >> 4) & 0xff, (compressedWord >> 4) & 0xf);
+            ONE_BYTE(((compressedWord & 0xf) << 4) | (nextCompressedWord >> 28), nextCompressedWord >> 28);
+
+            compressedWord = nextCompressedWord;
+            currentCompressedWordP++;
+        }
+        previousImageLine = currentImageLine - stride_bytes;
+        byteAbove = *previousImageLine++;
+    }
+
     while (currentImageLine < end) {
 
         uint32_t nextStateWord;
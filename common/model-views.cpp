@@ -1851,12 +1851,12 @@ namespace rs2
             {
                 if (viewer.synchronization_enable && is_synchronized_frame(viewer, f))
                 {
+                    viewer.ppf.frames.track(f);
                     syncer->invoke(f);
                 }
                 else
                 {
-                    auto id = f.get_profile().unique_id();
-                    viewer.ppf.frames_queue[id].enqueue(f);
+                    viewer.ppf.frames.put(f);
 
                     on_frame();
                 }
@@ -2068,6 +2068,13 @@ namespace rs2
         glPopAttrib();
     }
 
+    double stream_model::get_hardware_fps(const viewer_model& viewer) const
+    {
+        // measured on arrival, frames dropped later by the viewer do not lower it
+        auto captured = viewer.ppf.frames.get_fps(original_profile.unique_id());
+        return captured > 0 ? captured : fps.get_fps();
+    }
+
     bool stream_model::is_stream_visible()
     {
         if (dev &&
@@ -2601,7 +2608,7 @@ namespace rs2
 
                 ImGui::SameLine();
 
-                label = to_string() << "FPS: " << std::setprecision(2) << std::setw(7) << std::fixed << fps.get_fps();
+                label = to_string() << "FPS: " << std::setprecision(2) << std::setw(7) << std::fixed << get_hardware_fps(viewer);
                 ImGui::Text("%s", label.c_str());
                 if (ImGui::IsItemHovered())
                 {
@@ -2653,7 +2660,7 @@ namespace rs2
                     to_string() << rs2_format_to_string(profile.format()), "" });
 
                 stream_details.push_back({ "Hardware FPS",
-                    to_string() << std::setprecision(2) << std::fixed << fps.get_fps(),
+                    to_string() << std::setprecision(2) << std::fixed << get_hardware_fps(viewer),
                     "Hardware FPS captures the number of frames per second produced by the device.\n"
                     "It is possible and likely that not all of these frames will make it to the application." });
 
@@ -2662,6 +2669,11 @@ namespace rs2
                     "Viewer FPS captures how many frames the application manages to render.\n"
                     "Frame drops can occur for variety of reasons." });
 
+                stream_details.push_back({ "Viewer Drops",
+                    to_string() << viewer.ppf.frames.get_dropped(original_profile.unique_id()),
+                    "Viewer Drops counts the frames replaced by newer ones before the viewer could process them.\n"
+                    "The viewer always shows the latest frame, so a busy CPU or GPU skips frames instead of adding latency." });
+
                 stream_details.push_back({ "", "", "" });
             }
 
@@ -3699,18 +3711,12 @@ namespace rs2
                 }
                 else
                 {
-                    std::map<int, rs2::frame_queue> frames_queue_local;
+                    // one wait for all the streams, a stream without frames does not delay the others
+                    std::vector<frame> ready;
+                    if (frames.take(ready, std::chrono::milliseconds(30)))
                     {
-                        std::lock_guard<std::mutex> lock(viewer.streams_mutex);
-                        frames_queue_local = frames_queue;
-                    }
-                    for (auto&& q : frames_queue_local)
-                    {
-                        frame frm;
-                        if (q.second.try_wait_for_frame(&frm, 30))
-                        {
-                            processing_block.invoke(frm);
-                        }
+                        for (auto&& frm : ready)
+                            processing_block.invoke(std::move(frm));
                     }
                 }
             }
@@ -18,6 +18,7 @@
 #include <set>
 #include <array>
 #include <unordered_map>
+#include <condition_variable>
 
 #include "../third-party/json.hpp"
 #include "objects-in-frame.h"
@@ -362,6 +363,88 @@ namespace rs2
         std::mutex _lookup_mutex;
     };
 
+    // Latest frame of every stream, handed from the sensor callbacks to the processing thread.
+    // A frame the processing thread did not take in time is replaced rather than queued, so a busy
+    // viewer shows the newest image instead of falling behind. The arrival rate of every stream is
+    // measured here, on the capture side, so it reports the device even when the viewer drops frames
+    class frame_mailbox
+    {
+    public:
+        // Measure the arrival rate, for frames that reach the processing through other paths (the syncer)
+        void track(const frame& f)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& s = _streams[f.get_profile().unique_id()];
+            s.fps.add_timestamp(f.get_timestamp(), f.get_frame_number());
+        }
+
+        void put(frame f)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto& s = _streams[f.get_profile().unique_id()];
+                s.fps.add_timestamp(f.get_timestamp(), f.get_frame_number());
+                if (s.latest) s.dropped++;
+                s.latest = std::move(f);
+                _ready = true;
+            }
+            _cv.notify_one();
+        }
+
+        // Takes the latest frame of every stream that got one since the last call
+        bool take(std::vector<frame>& frames, std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_cv.wait_for(lock, timeout, [this] { return _ready; }))
+                return false;
+            for (auto&& kvp : _streams)
+            {
+                if (kvp.second.latest)
+                {
+                    frames.push_back(std::move(kvp.second.latest));
+                    kvp.second.latest = frame{};
+                }
+            }
+            _ready = false;
+            return !frames.empty();
+        }
+
+        void remove(int id)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _streams.erase(id);
+        }
+
+        // Frames per second arriving from the device, 0 until measured
+        double get_fps(int id) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _streams.find(id);
+            return it == _streams.end() ? 0 : it->second.fps.get_fps();
+        }
+
+        // Frames replaced before the processing thread took them
+        unsigned long long get_dropped(int id) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _streams.find(id);
+            return it == _streams.end() ? 0 : it->second.dropped;
+        }
+
+    private:
+        struct stream
+        {
+            frame latest;
+            fps_calc fps;
+            unsigned long long dropped = 0;
+        };
+
+        std::unordered_map<int, stream> _streams;
+        bool _ready = false;
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+    };
+
     // Preserve user selections in UI
     struct subdevice_ui_selection
     {
@@ -689,6 +772,7 @@ namespace rs2
     public:
         stream_model();
         std::shared_ptr<texture_buffer> upload_frame(frame&& f);
+        double get_hardware_fps(const viewer_model& viewer) const;
         bool is_stream_visible();
         void update_ae_roi_rect(const rect& stream_rect, const mouse_info& mouse, std::string& error_message);
         void show_frame(const rect& stream_rect, const mouse_info& g, std::string& error_message);
@@ -911,7 +995,7 @@ namespace rs2
         std::atomic<bool> depth_stream_active;
 
         const size_t resulting_queue_max_size;
-        std::map<int, rs2::frame_queue> frames_queue;
+        frame_mailbox frames;
         rs2::frame_queue resulting_queue;
 
         std::shared_ptr<pointcloud> get_pc() const { return pc; }
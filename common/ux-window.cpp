@@ -107,18 +107,22 @@ namespace rs2
         auto version = (const char*)glGetString(GL_VERSION);
         auto glsl = (const char*)glGetString(GL_SHADING_LANGUAGE_VERSION);
 
-        bool use_glsl = false;
+        // Colorizing, point-cloud and upload on the GPU keep the UI thread free, so they are the default
+        // whenever a hardware GLSL 1.3+ implementation is present
+        bool use_glsl = glsl != nullptr;
 
-        // Absolutely arbitrary list of manufacturers that are likely to benefit from GLSL optimisation
-        if (starts_with(to_lower(vendor), "intel") ||
-            starts_with(to_lower(vendor), "ati") ||
-            starts_with(to_lower(vendor), "nvidia"))
+        // Software rasterizers run the shaders on the CPU, slower than the CPU processing blocks
+        auto lower_renderer = to_lower(renderer ? renderer : "");
+        if (lower_renderer.find("llvmpipe") != std::string::npos ||
+            lower_renderer.find("softpipe") != std::string::npos ||
+            lower_renderer.find("software") != std::string::npos ||
+            lower_renderer.find("gdi generic") != std::string::npos)
         {
-            use_glsl = true;
+            use_glsl = false;
         }
 
         // Double-check that GLSL 1.3+ is supported
-        if (starts_with(to_lower(vendor), "1.1") || starts_with(to_lower(vendor), "1.2"))
+        if (glsl && (starts_with(glsl, "1.1") || starts_with(glsl, "1.2")))
         {
             use_glsl = false;
         }
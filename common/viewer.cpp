@@ -970,10 +970,7 @@ namespace rs2
                 selected_tex_source_uid = -1;
             streams.erase(i);
 
-            if(ppf.frames_queue.find(i) != ppf.frames_queue.end())
-            {
-                ppf.frames_queue.erase(i);
-            }
+            ppf.frames.remove(i);
         }
     }
 
@@ -3142,7 +3139,6 @@ namespace rs2
         // Starting post processing filter rendering thread
         ppf.start();
         streams[p.unique_id()].begin_stream(d, p);
-        ppf.frames_queue.emplace(p.unique_id(), rs2::frame_queue(5));
     }
 
     bool viewer_model::is_3d_texture_source(frame f)
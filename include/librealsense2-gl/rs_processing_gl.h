@@ -193,6 +193,16 @@ void rs2_gl_init_rendering_glfw(int api_version, glfw_binding bindings, int use_
  */
 void rs2_gl_init_processing(int api_version, int use_glsl, rs2_error** error);
 
+/**
+ * Initialize processing pipeline on an offscreen EGL context, without any window or display server.
+ * This lets the GL processing blocks run on the GPU of headless machines. Texture sharing is not available.
+ * Requires the library to be built with BUILD_GLSL_EGL, fails otherwise.
+ * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
+ * \param[in] use_glsl  Use GLSL shaders for processing
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_gl_init_processing_headless(int api_version, int use_glsl, rs2_error** error);
+
 /**
 * In order to share GL processing results with GLFW rendering application
 * the user need to initialize rendering by passing GLFW binding information
@@ -58,6 +58,13 @@ namespace rs2
             error::handle(e);
         }
 
+        inline void init_processing_headless(bool use_glsl = true)
+        {
+            rs2_error* e = nullptr;
+            rs2_gl_init_processing_headless(RS2_API_VERSION, use_glsl ? 1 : 0, &e);
+            error::handle(e);
+        }
+
         inline void shutdown_processing()
         {
             rs2_error* e = nullptr;
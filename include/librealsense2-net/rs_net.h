@@ -15,6 +15,22 @@ extern "C" {
 
 #include "librealsense2/rs.h"
 
+/** \brief Reception statistics of a stream of a net device, since the stream started */
+typedef struct rs2_net_stream_statistics
+{
+    unsigned long long frames_received;  /**< frames received complete */
+    unsigned long long frames_lost;      /**< frames sent by the server and not received, e.g. a packet of the frame was lost */
+    unsigned long long frames_dropped;   /**< frames received and not delivered, the queue of the stream was full or the frame missed the jitter buffer */
+    unsigned long long frames_corrupted; /**< frames received with a wrong size or failing to decompress */
+    unsigned long long frames_reordered; /**< frames received out of order */
+    unsigned long long packets_received; /**< RTP packets received */
+    unsigned long long packets_lost;     /**< RTP packets expected and not received */
+    double jitter_ms;                    /**< interarrival jitter of the RTP packets */
+    double bitrate_kbps;                 /**< received bitrate over the last second */
+    double latency_ms;                   /**< one way latency from the server sending a frame to the client receiving it, meaningful when the clocks of the hosts are synchronized, e.g. by NTP or PTP */
+    double server_latency_ms;            /**< latency on the server from the arrival of a frame from the camera to its sending */
+} rs2_net_stream_statistics;
+
 /**
  * Net device is a rs2_device that can be stream and be contolled remotely over network 
  * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
@@ -23,6 +39,51 @@ extern "C" {
  */
 rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_error** error);
 
+/**
+ * Net device that streams with the codecs chosen for its streams
+ * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
+ * \param[in] address remote devce ip address. should be the address of the hosting device
+ * \param[in] compression comma separated codecs per stream type, for example "depth=rvl,color=jpeg:90,infrared=none".
+ *                        The codecs are none, lz4[:key interval], rvl (16 bit streams), jpeg[:quality] and adaptive:kbps, JPEG with the quality
+ *                        following the bandwidth budget in kbps. With a key interval LZ4 codes the differences between the frames
+ *                        of 16 bit streams, with a key frame every interval frames. h264[:kbps] and h265[:kbps] code the color streams
+ *                        as video at the bitrate, from the resolution when not given, where the server was built with BUILD_NETWORK_VIDEO_CODEC.
+ *                        The streams without a codec use the default codec of the server
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+rs2_device* rs2_create_net_device_with_compression(int api_version, const char* address, const char* compression, rs2_error** error);
+
+/**
+ * Hold the received frames in a jitter buffer, so the frames delayed by the network are delivered in order and at a steady pace.
+ * Each frame is delayed by up to delay_ms, a frame arriving after the frames following it were delivered is dropped
+ * \param[in] device    net device created by rs2_create_net_device
+ * \param[in] delay_ms  buffering delay in milliseconds, 0 (the default) delivers the frames on arrival
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_net_device_set_jitter_buffer(const rs2_device* device, int delay_ms, rs2_error** error);
+
+/**
+ * Transport of the streams of a net device, applied to the streams started next.
+ * The packets of a large frame arrive in a burst, the default UDP socket buffer of the system may not hold them and the frame is lost.
+ * A larger receive buffer keeps the burst, RTP over TCP retransmits the lost packets at the cost of latency when the link loses packets
+ * \param[in] device             net device created by rs2_create_net_device
+ * \param[in] over_tcp           non zero to receive RTP interleaved on the RTSP connection, 0 (the default) to receive it over UDP
+ * \param[in] receive_buffer_kb  kernel receive buffer of the sockets of the streams in KB, 0 (the default) keeps the buffer of the system.
+ *                               The system may limit the buffer, e.g. net.core.rmem_max on Linux
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_net_device_set_transport(const rs2_device* device, int over_tcp, int receive_buffer_kb, rs2_error** error);
+
+/**
+ * Reception statistics of a stream of a net device, of the last streamed profile of the stream
+ * \param[in] device      net device created by rs2_create_net_device
+ * \param[in] stream      stream type
+ * \param[in] index       stream index
+ * \param[out] statistics receives the statistics of the stream
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_net_device_get_stream_statistics(const rs2_device* device, rs2_stream stream, int index, rs2_net_stream_statistics* statistics, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
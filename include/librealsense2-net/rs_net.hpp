@@ -16,6 +16,11 @@ namespace rs2
         public:
             net_device(const std::string& address) : rs2::device(init(address)) { }
 
+            /**
+            * \param[in] compression   codecs per stream type, for example "depth=rvl,color=h264:4000", see rs2_create_net_device_with_compression
+            */
+            net_device(const std::string& address, const std::string& compression) : rs2::device(init(address, compression)) { }
+
             /**
             * Add network device to existing context.
             * Any future queries on the context will return this device.
@@ -30,13 +35,44 @@ namespace rs2
                 error::handle(e);
             }
 
+            /**
+            * Delay the frames by up to delay_ms in a jitter buffer, see rs2_net_device_set_jitter_buffer
+            */
+            void set_jitter_buffer(int delay_ms) const
+            {
+                rs2_error* e = nullptr;
+                rs2_net_device_set_jitter_buffer(_dev.get(), delay_ms, &e);
+                error::handle(e);
+            }
+
+            /**
+            * Receive the streams started next over TCP or UDP, with a kernel receive buffer of receive_buffer_kb, see rs2_net_device_set_transport
+            */
+            void set_transport(bool over_tcp, int receive_buffer_kb = 0) const
+            {
+                rs2_error* e = nullptr;
+                rs2_net_device_set_transport(_dev.get(), over_tcp ? 1 : 0, receive_buffer_kb, &e);
+                error::handle(e);
+            }
+
+            /**
+            * Reception statistics of a stream: frames and packets lost, bitrate and latency, see rs2_net_stream_statistics
+            */
+            rs2_net_stream_statistics get_stream_statistics(rs2_stream stream, int index = 0) const
+            {
+                rs2_error* e = nullptr;
+                rs2_net_stream_statistics statistics;
+                rs2_net_device_get_stream_statistics(_dev.get(), stream, index, &statistics, &e);
+                error::handle(e);
+                return statistics;
+            }
 
         private:
-            std::shared_ptr<rs2_device> init(const std::string& address)
+            std::shared_ptr<rs2_device> init(const std::string& address, const std::string& compression = "")
             {
                 rs2_error* e = nullptr;
                 auto dev = std::shared_ptr<rs2_device>(
-                    rs2_create_net_device(RS2_API_VERSION, address.c_str(), &e),
+                    rs2_create_net_device_with_compression(RS2_API_VERSION, address.c_str(), compression.c_str(), &e),
                     rs2_delete_device);
                 error::handle(e);
 
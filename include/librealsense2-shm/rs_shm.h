@@ -0,0 +1,74 @@
+/* License: Apache 2.0. See LICENSE file in root directory.
+   Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+/** \file rs_shm.h
+* \
+* Exposes RealSense shared memory device functionality for C compilers
+*/
+
+#ifndef LIBREALSENSE_RS2_SHM_H
+#define LIBREALSENSE_RS2_SHM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "librealsense2/rs.h"
+
+/** \brief Publishes the frames of a device to the shm devices of other processes through a named shared memory ring */
+typedef struct rs2_shm_server rs2_shm_server;
+
+/**
+ * Create a shared memory server. The server copies each published frame once to a slot of the ring, and the shm devices of all
+ * the processes wrap the slots without copying them. A slot is reused once no process references its frame
+ * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
+ * \param[in] name        name of the ring, the shm devices open the ring by this name. A ring of the same name left by a server that crashed is replaced
+ * \param[in] slot_count  frames held by the ring, the frames are dropped when all of them are referenced by clients
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return the new server, delete it with rs2_delete_shm_server
+ */
+rs2_shm_server* rs2_create_shm_server(int api_version, const char* name, int slot_count, rs2_error** error);
+
+/**
+ * Delete a shared memory server and remove its ring, the devices that opened it keep their frames and stop receiving new ones
+ * \param[in] server  shared memory server to delete
+ */
+void rs2_delete_shm_server(rs2_shm_server* server);
+
+/**
+ * Add a stream to publish, before the server starts. The shm devices have a sensor of the same name streaming the profile
+ * \param[in] server       shared memory server
+ * \param[in] sensor_name  name of the sensor of the stream
+ * \param[in] profile      video or motion stream profile
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_shm_server_add_stream(rs2_shm_server* server, const char* sensor_name, const rs2_stream_profile* profile, rs2_error** error);
+
+/**
+ * Create the ring of the server, the shm devices can open it from now on
+ * \param[in] server  shared memory server
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_shm_server_start(rs2_shm_server* server, rs2_error** error);
+
+/**
+ * Publish a frame, or each frame of a frameset, of the added streams. The frames of the other streams are ignored
+ * \param[in] server  started shared memory server
+ * \param[in] frame   frame to publish, it stays owned by the caller
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_shm_server_publish(rs2_shm_server* server, rs2_frame* frame, rs2_error** error);
+
+/**
+ * Shm device is a rs2_device streaming the frames of a shared memory server of another process, each of its frames wraps a slot of the ring.
+ * The device has the sensors and the stream profiles added to the server
+ * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
+ * \param[in] name        name of the ring of the server
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+rs2_device* rs2_create_shm_device(int api_version, const char* name, rs2_error** error);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
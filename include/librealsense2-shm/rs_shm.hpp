@@ -0,0 +1,107 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#ifndef LIBREALSENSE_RS2_SHM_HPP
+#define LIBREALSENSE_RS2_SHM_HPP
+
+#include <librealsense2/rs.hpp>
+#include "rs_shm.h"
+
+#include <memory>
+
+namespace rs2
+{
+        /**
+        * Publishes frames to the shm devices of other processes, it can be passed as the frame callback of a sensor:
+        *     rs2::shm_server server("camera");
+        *     server.add_streams(sensor, profiles);
+        *     server.start();
+        *     sensor.open(profiles);
+        *     sensor.start(server);
+        */
+        class shm_server
+        {
+        public:
+            shm_server(const std::string& name, int slot_count = 16)
+            {
+                rs2_error* e = nullptr;
+                _server = std::shared_ptr<rs2_shm_server>(
+                    rs2_create_shm_server(RS2_API_VERSION, name.c_str(), slot_count, &e),
+                    rs2_delete_shm_server);
+                error::handle(e);
+            }
+
+            void add_stream(const std::string& sensor_name, const stream_profile& profile)
+            {
+                rs2_error* e = nullptr;
+                rs2_shm_server_add_stream(_server.get(), sensor_name.c_str(), profile.get(), &e);
+                error::handle(e);
+            }
+
+            void add_streams(const sensor& s, const std::vector<stream_profile>& profiles)
+            {
+                std::string name = s.get_info(RS2_CAMERA_INFO_NAME);
+                for (auto&& profile : profiles)
+                    add_stream(name, profile);
+            }
+
+            void start()
+            {
+                rs2_error* e = nullptr;
+                rs2_shm_server_start(_server.get(), &e);
+                error::handle(e);
+            }
+
+            void publish(const frame& f) const
+            {
+                rs2_error* e = nullptr;
+                rs2_shm_server_publish(_server.get(), f.get(), &e);
+                error::handle(e);
+            }
+
+            // called by the threads of the sensor, the errors are reported by the log of librealsense and not thrown
+            void operator()(frame f) const
+            {
+                rs2_error* e = nullptr;
+                rs2_shm_server_publish(_server.get(), f.get(), &e);
+                if (e)
+                    rs2_free_error(e);
+            }
+
+        private:
+            std::shared_ptr<rs2_shm_server> _server;
+        };
+
+        class shm_device : public rs2::device
+        {
+        public:
+            shm_device(const std::string& name) : rs2::device(init(name)) { }
+
+            /**
+            * Add shared memory device to existing context.
+            * Any future queries on the context will return this device.
+            * This operation cannot be undone (except for destroying the context)
+            *
+            * \param[in] ctx   context to add the device to
+            */
+            void add_to(context& ctx)
+            {
+                rs2_error* e = nullptr;
+                rs2_context_add_software_device(((std::shared_ptr<rs2_context>)ctx).get(), _dev.get(), &e);
+                error::handle(e);
+            }
+
+        private:
+            std::shared_ptr<rs2_device> init(const std::string& name)
+            {
+                rs2_error* e = nullptr;
+                auto dev = std::shared_ptr<rs2_device>(
+                    rs2_create_shm_device(RS2_API_VERSION, name.c_str(), &e),
+                    rs2_delete_device);
+                error::handle(e);
+
+                return dev;
+            }
+        };
+}
+#endif // LIBREALSENSE_RS2_SHM_HPP
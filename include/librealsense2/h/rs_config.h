@@ -163,6 +163,30 @@ extern "C" {
     */
     void rs2_config_disable_all_streams(rs2_config* config, rs2_error ** error);
 
+    /**
+    * Limit the time the pipeline syncer waits for the missing streams of a frameset.
+    * Once the oldest frame of a frameset waited budget_ms, the frameset is delivered without the streams that did not arrive,
+    * instead of waiting as long as the sync heuristics require. The budget is enforced when frames arrive, so a frameset
+    * is delivered no later than the first frame arriving after the budget elapsed.
+    *
+    * \param[in] config     A pointer to an instance of a config
+    * \param[in] budget_ms  The latency budget in milliseconds, 0 disables the limit
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_set_sync_latency_budget(rs2_config* config, float budget_ms, rs2_error ** error);
+
+    /**
+    * Call the callback of the pipeline on a dedicated thread, so that a slow callback does not hold the capture and the syncer.
+    * The frames wait in a mailbox per stream, the framesets in a mailbox of their own, of size frames each. A frame arriving
+    * at a full mailbox replaces the oldest one, counted as a drop of RS2_FRAME_DROP_CAUSE_QUEUE_FULL. Applies to pipelines
+    * started with a callback.
+    *
+    * \param[in] config  A pointer to an instance of a config
+    * \param[in] size    The frames per mailbox, 1 delivers the latest frame only, 0 calls the callback on the syncer thread
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_set_callback_mailbox_size(rs2_config* config, int size, rs2_error ** error);
+
     /**
     * Resolve the configuration filters, to find a matching device and streams profiles.
     * The method resolves the user configuration filters for the device and streams, and combines them with the requirements of
@@ -194,6 +218,23 @@ extern "C" {
     */
     int rs2_config_can_resolve(rs2_config* config, rs2_pipeline* pipe, rs2_error ** error);
 
+    /**
+    * Resolve the configs of several pipelines together, for devices that may share USB links.
+    * Each config is resolved as described in \c resolve(), then while the estimated payload of the streams on a link exceeds what
+    * the link carries, the most loaded device on it is given the next lower frame rate its requests leave unspecified, and then
+    * the next smaller resolution. The configs are updated to request the planned device and streams, so the pipelines started
+    * with them stream the returned profiles.
+    * The configs must select different devices, with \c enable_device() when several devices are connected.
+    *
+    * \param[in] configs   The configs to resolve
+    * \param[in] pipes     The pipeline of each config
+    * \param[in] count     The number of configs and pipelines
+    * \param[out] profiles Receives the resolved profile of each config, to be deleted with \c rs2_delete_pipeline_profile()
+    * \param[out] error    if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    * \return              True if all the links carry their streams, false if a link remains oversubscribed with all the unspecified fields lowered
+    */
+    int rs2_config_resolve_bandwidth(rs2_config** configs, rs2_pipeline** pipes, int count, rs2_pipeline_profile** profiles, rs2_error ** error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -14,6 +14,17 @@ extern "C" {
 #endif
 #include "rs_types.h"
 
+/** \brief Roles of the threads librealsense starts, the threads of a role share a scheduling policy, see rs2_set_thread_policy */
+typedef enum rs2_thread_role
+{
+    RS2_THREAD_ROLE_CAPTURE,    /**< Threads receiving the frames from the devices and running the frame callbacks of the sensors */
+    RS2_THREAD_ROLE_PROCESSING, /**< Workers of the shared executor running asynchronous processing blocks */
+    RS2_THREAD_ROLE_CONTROL,    /**< Dispatchers serializing the device commands, the pipeline and the notifications */
+    RS2_THREAD_ROLE_MONITORING, /**< Watchdogs, clock synchronization polling and device connection watchers */
+    RS2_THREAD_ROLE_COUNT       /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_thread_role;
+const char* rs2_thread_role_to_string(rs2_thread_role role);
+
 /**
 * \brief Creates RealSense context that is required for the rest of the API.
 * \param[in] api_version Users are expected to pass their version of \c RS2_API_VERSION to make sure they are running the correct librealsense version.
@@ -22,6 +33,20 @@ extern "C" {
 */
 rs2_context* rs2_create_context(int api_version, rs2_error** error);
 
+/**
+* \brief Sets the CPUs and the scheduling of the threads of a role, for all the contexts of the process.
+* The threads are named after their role (rs-capture, rs-processing, rs-control, rs-monitor) on Linux and macOS.
+* Applies to the threads started after the call, set the policies before creating the contexts and starting the streams.
+* A real-time priority on Linux is SCHED_FIFO, which needs the CAP_SYS_NICE capability, and maps to raised thread priorities on Windows.
+* The policies that cannot be applied are logged as warnings, the threads still run with the default scheduling
+* \param[in] role               Role of the threads
+* \param[in] cpus               CPU indices the threads may run on. May be null, the threads run on any CPU
+* \param[in] cpus_count         Number of entries in cpus
+* \param[in] realtime_priority  0 for the default scheduling, 1 to 99 for real-time scheduling at that priority
+* \param[out] error  If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
+*/
+void rs2_set_thread_policy(rs2_thread_role role, const int* cpus, int cpus_count, int realtime_priority, rs2_error** error);
+
 /**
 * \brief Frees the relevant context object.
 * \param[in] context Object that is no longer needed
@@ -80,6 +105,26 @@ void rs2_context_remove_device(rs2_context* ctx, const char* file, rs2_error** e
  */
 void rs2_context_unload_tracking_module(rs2_context* ctx, rs2_error** error);
 
+/**
+* Limit the frame buffers held by the library: the frames held by the user, the queues and the processing blocks, and the recycled
+* frames. The budget of a context caps the frames of its devices and of the processing blocks inside their sensors, the budget of
+* the process caps all of them, the processing blocks created by the user included. The buffers already held are kept.
+* Each frame buffer is reserved before it is allocated, so that the frames never exceed the budget together
+* \param[in] ctx     The context whose devices are capped, or null for the whole process
+* \param[in] bytes   Largest number of bytes of frame buffers, 0 for no limit
+* \param[in] policy  What happens to a frame whose buffer would exceed the budget. Processing blocks fail to process it in any case
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_memory_budget(rs2_context* ctx, long long bytes, rs2_memory_budget_policy policy, rs2_error** error);
+
+/**
+* Retrieve the memory held by the frames of the devices of a context and of the processing blocks inside their sensors
+* \param[in] ctx      The context
+* \param[out] usage   Receives the bytes held per category, the processing caches are counted by rs2_get_memory_usage only
+* \param[out] error   if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_context_memory_usage(const rs2_context* ctx, rs2_memory_usage* usage, rs2_error** error);
+
 /**
 * create a static snapshot of all connected devices at the time of the call
 * \param context     Object representing librealsense session
@@ -80,6 +80,33 @@ int rs2_supports_device_info(const rs2_device* device, rs2_camera_info info, rs2
  */
 void rs2_hardware_reset(const rs2_device * device, rs2_error ** error);
 
+/**
+* Retrieve the memory held by the frames of the sensors of a device and of the processing blocks inside them
+* \param[in]  device   RealSense device
+* \param[out] usage    Receives the bytes held per category, the processing caches are counted by rs2_get_memory_usage only
+* \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_device_memory_usage(const rs2_device* device, rs2_memory_usage* usage, rs2_error** error);
+
+/**
+* Retrieve the NUMA node of the USB controller the device is attached to, to keep the frames of the device in the memory of that node
+* \param[in]  device   RealSense device
+* \param[out] error    If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return              The node, or -1 when it is unknown or the system has a single node
+*/
+int rs2_get_device_numa_node(const rs2_device* device, rs2_error** error);
+
+/**
+* Map the frame buffers of all the sensors of a device directly from the system, replacing the frame allocators set on the sensors.
+* The frame pools recycle the buffers, so the mapping happens when the streams start rather than per frame
+* Must be called while the sensors of the device are not streaming
+* \param[in]  device      RealSense device
+* \param[in]  numa_node   Node the frame buffers are preferably taken from, for instance rs2_get_device_numa_node, or -1 for any node
+* \param[in]  huge_pages  Non-zero to map the frames of 1 MB and above on 2 MB pages: the reserved huge pages when there are any, transparent huge pages otherwise
+* \param[out] error       If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_memory_policy(const rs2_device* device, int numa_node, int huge_pages, rs2_error** error);
+
 /**
 * Send raw data to device
 * \param[in]  device                    RealSense device to send data to
@@ -400,6 +427,35 @@ void rs2_trigger_device_calibration( rs2_device* dev, rs2_calibration_type type,
 */
 const rs2_raw_data_buffer* rs2_run_tare_calibration(rs2_device* dev, float ground_truth_mm, const void* json_content, int content_size, rs2_update_progress_callback_ptr callback, void* client_data, int timeout_ms, rs2_error** error);
 
+/**
+* Start on-chip calibration and return once its parameters are validated. The calibration runs on a thread of its own,
+* the parameters are as described in rs2_run_on_chip_calibration_cpp(). The device only runs one calibration at a time.
+* \param[in] progress_callback   Optional callback to get progress notifications, called from the calibration thread
+* \param[in] done_callback       Called from the calibration thread with the new calibration table and its health,
+*                                 or with the error message when the calibration failed
+*/
+void rs2_run_on_chip_calibration_async_cpp(rs2_device* device, const void* json_content, int content_size, rs2_update_progress_callback* progress_callback, rs2_calibration_done_callback* done_callback, int timeout_ms, rs2_error** error);
+
+/**
+* Start on-chip calibration and return once its parameters are validated, as rs2_run_on_chip_calibration_async_cpp()
+* \param[in] client_data         Passed to both callbacks
+*/
+void rs2_run_on_chip_calibration_async(rs2_device* device, const void* json_content, int content_size, rs2_update_progress_callback_ptr progress_callback, rs2_calibration_done_callback_ptr done_callback, void* client_data, int timeout_ms, rs2_error** error);
+
+/**
+* Start tare calibration and return once its parameters are validated. The calibration runs on a thread of its own,
+* the parameters are as described in rs2_run_tare_calibration_cpp(). The device only runs one calibration at a time.
+* \param[in] progress_callback   Optional callback to get progress notifications, called from the calibration thread
+* \param[in] done_callback       Called from the calibration thread with the new calibration table, or with the error message when the calibration failed
+*/
+void rs2_run_tare_calibration_async_cpp(rs2_device* dev, float ground_truth_mm, const void* json_content, int content_size, rs2_update_progress_callback* progress_callback, rs2_calibration_done_callback* done_callback, int timeout_ms, rs2_error** error);
+
+/**
+* Start tare calibration and return once its parameters are validated, as rs2_run_tare_calibration_async_cpp()
+* \param[in] client_data         Passed to both callbacks
+*/
+void rs2_run_tare_calibration_async(rs2_device* dev, float ground_truth_mm, const void* json_content, int content_size, rs2_update_progress_callback_ptr progress_callback, rs2_calibration_done_callback_ptr done_callback, void* client_data, int timeout_ms, rs2_error** error);
+
 /**
 *  Read current calibration table from flash.
 * \return    Calibration table
@@ -14,6 +14,7 @@
 extern "C" {
 #endif
 #include "rs_types.h"
+#include "rs_sensor.h"
 
 /** \brief Specifies the clock in relation to which the frame timestamp was measured. */
 typedef enum rs2_timestamp_domain
@@ -25,6 +26,45 @@ typedef enum rs2_timestamp_domain
 } rs2_timestamp_domain;
 const char* rs2_timestamp_domain_to_string(rs2_timestamp_domain info);
 
+/** \brief Stages of the frame path stamped in the trace of a frame, see rs2_enable_frame_trace */
+typedef enum rs2_frame_trace_stage
+{
+    RS2_FRAME_TRACE_STAGE_BACKEND_DEQUEUE, /**< The backend handed the frame data to its sensor */
+    RS2_FRAME_TRACE_STAGE_ARCHIVE_PUBLISH, /**< The frame was allocated from the frame pool of its sensor or processing block */
+    RS2_FRAME_TRACE_STAGE_BLOCK_BEGIN,     /**< The processing block named by the stamp received the frame, format conversions included */
+    RS2_FRAME_TRACE_STAGE_BLOCK_END,       /**< The processing block named by the stamp delivered the frame */
+    RS2_FRAME_TRACE_STAGE_SYNCER_EMIT,     /**< The syncer delivered the frameset holding the frame */
+    RS2_FRAME_TRACE_STAGE_USER_DEQUEUE,    /**< The user took the frame from a frame queue or a pipeline */
+    RS2_FRAME_TRACE_STAGE_COUNT            /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_frame_trace_stage;
+const char* rs2_frame_trace_stage_to_string(rs2_frame_trace_stage stage);
+
+/** \brief Time a frame reached a stage of the frame path */
+typedef struct rs2_frame_trace_stamp
+{
+    rs2_frame_trace_stage stage;
+    const char* name;           /**< Name of the processing block of the block stages, empty otherwise. Valid until the process exits */
+    rs2_time_t time;            /**< System time in milliseconds, in the clock of the time of arrival metadata */
+} rs2_frame_trace_stamp;
+
+/** \brief The per-frame properties a consumer typically reads for every frame, retrieved together by rs2_get_frame_header */
+typedef struct rs2_frame_header
+{
+    const void* data;                       /**< Pointer to the frame data, valid while the frame is referenced */
+    int data_size;                          /**< Size of the frame data in bytes */
+    unsigned long long frame_number;        /**< Frame number */
+    rs2_time_t timestamp;                   /**< Timestamp in milliseconds */
+    rs2_timestamp_domain timestamp_domain;  /**< Domain of the timestamp */
+    const rs2_stream_profile* profile;      /**< Stream profile of the frame, owned by the library */
+    rs2_stream stream;                      /**< Stream type of the profile */
+    int stream_index;                       /**< Stream index of the profile */
+    rs2_format format;                      /**< Format of the profile */
+    int width;                              /**< Width in pixels, 0 for non-video frames */
+    int height;                             /**< Height in pixels, 0 for non-video frames */
+    int stride_in_bytes;                    /**< Stride in bytes, 0 for non-video frames */
+    int bits_per_pixel;                     /**< Bits per pixel, 0 for non-video frames */
+} rs2_frame_header;
+
 /** \brief Per-Frame-Metadata is the set of read-only properties that might be exposed for each individual frame. */
 typedef enum rs2_frame_metadata_value
 {
@@ -88,6 +128,17 @@ rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metad
 */
 int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error);
 
+/**
+* retrieve all the metadata attributes of a frame in one call, each attribute is parsed once per frame
+* \param[in] frame         handle returned from a callback
+* \param[out] values       array indexed by rs2_frame_metadata_value, receives the value of each supported attribute and 0 for the others
+* \param[out] supported    array indexed by rs2_frame_metadata_value, receives 1 for each supported attribute and 0 for the others
+* \param[in] count         the number of elements of both arrays, up to RS2_FRAME_METADATA_COUNT
+* \param[out] error        if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                  the number of supported attributes
+*/
+int rs2_get_all_frame_metadata(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error);
+
 /**
 * retrieve timestamp domain from frame handle. timestamps can only be comparable if they are in common domain
 * (for example, depth timestamp might come from system time while color timestamp might come from the device)
@@ -122,6 +173,15 @@ rs2_sensor* rs2_get_frame_sensor(const rs2_frame* frame, rs2_error** error);
 */
 unsigned long long rs2_get_frame_number(const rs2_frame* frame, rs2_error** error);
 
+/**
+* retrieve the data, number, timestamp, profile and (for video frames) dimensions of a frame in one call,
+* instead of one call per property
+* \param[in] frame      handle returned from a callback
+* \param[out] header    receives the frame properties
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_header(const rs2_frame* frame, rs2_frame_header* header, rs2_error** error);
+
 /**
 * retrieve data size from frame handle
 * \param[in] frame      handle returned from a callback
@@ -234,6 +294,42 @@ rs2_pixel* rs2_get_frame_texture_coordinates(const rs2_frame* frame, rs2_error**
 */
 int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error);
 
+/**
+* When called on Points frame type, this method copies the points of regions of the depth image to a compact list, skipping the pixels with no depth
+* \param[in] frame       Points frame
+* \param[in] regions     Regions in depth pixels, their bounds included
+* \param[in] count       Number of regions
+* \param[out] vertices   Receives up to capacity points
+* \param[out] pixels     If non-null, receives the depth pixel of each point
+* \param[in] capacity    Size of the vertices and pixels arrays, 0 to only count the points
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of points of the regions, larger than capacity when not all of them were copied
+*/
+int rs2_get_frame_vertices_in_regions(const rs2_frame* frame, const rs2_pixel_region* regions, int count,
+    rs2_vertex* vertices, rs2_pixel* pixels, int capacity, rs2_error** error);
+
+/**
+* When called on Points frame type, this method packs the vertices and the texture coordinates or the colors in a compact format, to stream, store or upload them
+* \param[in] frame       Points frame
+* \param[in] format      Layout of each point
+* \param[in] valid_only  When non-zero, the points with no depth are left out and the points are stored densely
+* \param[out] buffer     Receives the points, null to only count them
+* \param[in] size        Size of the buffer in bytes
+* \param[out] indices    If non-null, receives the index of the pixel of each point, to map the dense points back to the image
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of points
+*/
+int rs2_pack_points(const rs2_frame* frame, rs2_points_format format, int valid_only, void* buffer, int size, int* indices, rs2_error** error);
+
+/**
+* When called on Motion frame type, returns the number of samples of the frame, more than one when the sensor batches them, see RS2_OPTION_MOTION_BATCH_SIZE.
+* A batched frame holds the timestamps of its samples as doubles, then the x, y and z axes of the samples, each as an array of floats
+* \param[in] frame       Motion frame
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of samples
+*/
+int rs2_get_motion_samples_count(const rs2_frame* frame, rs2_error** error);
+
 /**
 * Returns the stream profile that was used to start the stream of this frame
 * \param[in] frame       frame reference, owned by the user
@@ -322,6 +418,17 @@ rs2_frame* rs2_extract_frame(rs2_frame* composite, int index, rs2_error** error)
 */
 int rs2_embedded_frames_count(rs2_frame* composite, rs2_error** error);
 
+/**
+* Retrieve the headers of all the frames embedded within a composite frame in one call, without extracting each frame
+* \param[in] composite   Composite input frame
+* \param[out] headers    Array receiving the header of each embedded frame, in the order of rs2_extract_frame.
+*                        The data pointers are valid while the composite frame is referenced
+* \param[in] count       Number of elements of the array
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of embedded frames. Only the first min(count, return value) headers are filled
+*/
+int rs2_get_frameset_headers(const rs2_frame* composite, rs2_frame_header* headers, int count, rs2_error** error);
+
 /**
 * This method will dispatch frame callback on a frame
 * \param[in] source      Frame pool provided by the processing block
@@ -331,6 +438,38 @@ int rs2_embedded_frames_count(rs2_frame* composite, rs2_error** error);
 void rs2_synthetic_frame_ready(rs2_source* source, rs2_frame* frame, rs2_error** error);
 
 
+/**
+* Enable or disable stamping the frames with the times they reach the stages of the frame path, disabled by default.
+* A frame derived by a processing block starts with the stamps of its original frame and holds up to 16 stamps
+* \param[in] enable      Non zero to stamp the frames allocated from now on
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_enable_frame_trace(int enable, rs2_error** error);
+
+/**
+* Get the stamps of a frame, in the order they were recorded
+* \param[in] frame       Frame, the stamps of the frames of a frameset are kept by each frame
+* \param[out] stamps     Array of at least count stamps, receives the first count stamps of the frame
+* \param[in] count       Size of the stamps array
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                Number of stamps of the frame, which may be more than count
+*/
+int rs2_get_frame_trace(const rs2_frame* frame, rs2_frame_trace_stamp* stamps, int count, rs2_error** error);
+
+/**
+* Enable the frame trace and write the stamps of the frames, as they are released, to a Chrome trace event file.
+* The file opens in chrome://tracing or ui.perfetto.dev, with a track per stream
+* \param[in] filename    File to write, replaced if it exists
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_start_frame_trace_file(const char* filename, rs2_error** error);
+
+/**
+* Complete and close the frame trace file, the frame trace stays enabled
+* \param[out] error      If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_stop_frame_trace_file(rs2_error** error);
+
 /**
 * When called on Pose frame type, this method returns the transformation represented by the pose data
 * \param[in] frame       Pose frame
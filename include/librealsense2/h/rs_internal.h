@@ -181,6 +181,16 @@ rs2_sensor* rs2_software_device_add_sensor(rs2_device* dev, const char* sensor_n
  */
 void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_frame frame, rs2_error** error);
 
+/**
+ * Inject several video frames to software sensor in one call. Each frame refers to its pixels without copying them,
+ * and its deleter is invoked once the frame is released or dropped
+ * \param[in] sensor the software sensor
+ * \param[in] frames array of the frames components, injected in order
+ * \param[in] count  the number of frames
+ * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_software_sensor_on_video_frames(rs2_sensor* sensor, const rs2_software_video_frame* frames, int count, rs2_error** error);
+
 /**
 * Inject motion frame to software sonsor
 * \param[in] sensor the software sensor
@@ -365,6 +375,17 @@ rs2_firmware_log_message* rs2_create_fw_log_message(rs2_device* dev, rs2_error**
 */
 int rs2_get_fw_log(rs2_device* dev, rs2_firmware_log_message* fw_log_msg, rs2_error** error);
 
+/**
+* \brief Gets the RealSense firmware logs collected so far, the device is polled for them in the background once logs are requested.
+* \param[in] dev            Device from which the FW logs should be taken
+* \param[in] fw_log_msgs    Firmware log message objects to be filled
+* \param[in] count          Number of message objects
+* \param[in] timeout_ms     Time to wait for the first log when none was collected yet
+* \param[out] error         If non-null, receives any error that occurs during this call, otherwise, errors are ignored.
+* \return                   the number of messages filled
+*/
+int rs2_get_fw_logs(rs2_device* dev, rs2_firmware_log_message** fw_log_msgs, int count, unsigned int timeout_ms, rs2_error** error);
+
 /**
 * \brief Gets RealSense flash log - this is a fw log that has been written in the device during the previous shutdown of the device
 * \param[in] dev            Device from which the FW log should be taken
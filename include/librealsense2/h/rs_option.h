@@ -101,6 +101,32 @@ extern "C" {
         RS2_OPTION_SEQUENCE_NAME, /**< HDR Sequence size */
         RS2_OPTION_SEQUENCE_SIZE, /**< HDR Sequence size */
         RS2_OPTION_SEQUENCE_ID, /**< HDR Sequence ID - 0 is not HDR; sequence ID for HDR configuartion starts from 1 */
+        RS2_OPTION_CAPTURE_BUFFERS, /**< Number of frame buffers the backend queues for each stream, 0 selects the backend default. Applied when the streams are opened */
+        RS2_OPTION_LATEST_FRAME_ONLY, /**< Deliver only the most recent frame, dropping the frames that became stale while waiting in the backend. Applied when the streams are opened */
+        RS2_OPTION_DEFERRED_CONVERSION, /**< Convert the frames on their first data access, frames dropped unread are never converted. Applied when streaming starts */
+        RS2_OPTION_SYNC_LATENCY_BUDGET, /**< Syncer only: longest time in milliseconds a frame waits for the missing streams before a partial frameset is emitted, 0 waits as long as the sync heuristics require */
+        RS2_OPTION_MOTION_BATCH_SIZE, /**< Number of motion samples delivered in each motion frame, see rs2_get_motion_samples_count. Applied when streaming starts */
+        RS2_OPTION_GLOBAL_TIME_FROM_METADATA, /**< Derive the global timestamps from the frame timestamps and arrival times instead of polling the device clock. Shared by the sensors of a device, applied when streaming starts */
+        RS2_OPTION_AUTO_EXPOSURE_SAMPLE_RATE, /**< Software Auto-Exposure: only every Nth pixel of every Nth row is counted in the histogram */
+        RS2_OPTION_AUTO_EXPOSURE_SKIP_FRAMES, /**< Software Auto-Exposure: number of frames skipped between two evaluated frames */
+        RS2_OPTION_VOXEL_SIZE, /**< Voxel grid filter: edge of the voxels in meters, the points of a voxel are merged into their centroid */
+        RS2_OPTION_SCAN_BINS, /**< Depth to scan: number of angle bins spanning the horizontal field of view of the depth */
+        RS2_OPTION_SCAN_ROWS, /**< Depth to scan: number of depth rows, centered on the principal point, the scan is taken from */
+        RS2_OPTION_ALIGN_OUTPUT_DOWNSAMPLE, /**< Align: the depth aligned to another stream is output at the resolution of the other divided by this factor */
+        RS2_OPTION_SPATIAL_FILTER_MODE, /**< Spatial filter: 0 - domain transform filter, 1 - guided filter of a cost independent of its radius */
+        RS2_OPTION_SPATIAL_FILTER_RADIUS, /**< Spatial filter: radius of the windows of the guided filter, in pixels */
+        RS2_OPTION_SPATIAL_FILTER_IR_GUIDED, /**< Spatial filter: the guided filter of a frameset holding infrared is guided by the infrared */
+        RS2_OPTION_TENSOR_WIDTH, /**< Tensor converter: width of the tensor the color is resized to */
+        RS2_OPTION_TENSOR_HEIGHT, /**< Tensor converter: height of the tensor the color is resized to */
+        RS2_OPTION_TENSOR_MEAN, /**< Tensor converter: mean subtracted from the color values, before the scale */
+        RS2_OPTION_TENSOR_SCALE, /**< Tensor converter: factor the color values less the mean are multiplied by */
+        RS2_OPTION_TENSOR_FLOAT, /**< Tensor converter: 0 - tensor of uint8, saturated, 1 - tensor of float */
+        RS2_OPTION_TENSOR_BGR, /**< Tensor converter: 0 - planes ordered R, G, B, 1 - planes ordered B, G, R */
+        RS2_OPTION_FRAME_DECIMATION, /**< Deliver every Nth frame of each stream of the sensor, the others are dropped before they are allocated and unpacked. Applied when the streams are opened */
+        RS2_OPTION_STANDBY, /**< Keep the streams of the sensor configured when it is closed, with their buffers allocated and the device powered, so that opening the same stream profiles again resumes them without renegotiation. Applied when the streams are closed, turning it off releases the streams left configured */
+        RS2_OPTION_CALLBACK_MAILBOX_SIZE, /**< Call the frame callback on a dedicated thread, the frames waiting in a mailbox per stream of this many frames, the oldest replaced when full. 0 calls it on the capture threads. Applied when streaming starts */
+        RS2_OPTION_POINTS_COLORS, /**< Sample the color of the texture of every point while mapping it, to pack the points with RS2_POINTS_FORMAT_XYZRGB */
+        RS2_OPTION_FRAME_POOL_RETENTION, /**< Time in milliseconds a released frame buffer of the sensor is kept for reuse by its next frames of the same size before it is freed */
         RS2_OPTION_COUNT /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
     } rs2_option;
 
@@ -217,6 +243,17 @@ extern "C" {
     */
     void rs2_set_option(const rs2_options* options, rs2_option option, float value, rs2_error** error);
 
+    /**
+    * read the values of several options in one pass, keeping the device powered and locked against the other processes between the reads
+    * \param[in] options    the options container
+    * \param[in] ids        the options to read
+    * \param[out] values    receives the value of each option, NaN for an option that is not supported or failed to read
+    * \param[in] count      number of options to read
+    * \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    * \return number of options read
+    */
+    int rs2_get_options_bulk(const rs2_options* options, const rs2_option* ids, float* values, int count, rs2_error** error);
+
    /**
    * get the list of supported options of options container
    * \param[in] options    the options container
@@ -18,6 +18,13 @@ extern "C" {
 #include "rs_sensor.h"
 #include "rs_config.h"
 
+/** \brief Outcome of starting one of the pipelines of \c rs2_pipelines_start() */
+typedef struct rs2_pipeline_start_report
+{
+    int started;        /**< Non-zero when the pipeline started */
+    double duration_ms; /**< Time spent starting the pipeline, or failing to */
+} rs2_pipeline_start_report;
+
     /**
     * Create a pipeline instance
     * The pipeline simplifies the user interaction with the device and computer vision processing modules.
@@ -91,6 +98,26 @@ extern "C" {
     */
     int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_frame, unsigned int timeout_ms, rs2_error ** error);
 
+    /**
+    * Add a consumer queue to the pipeline.
+    * The queue receives every frames set that \c wait_for_frames() returns, in addition to it and to the other consumers.
+    * The frames are shared between the consumers without copies. Each queue is bounded by its own capacity and drops its oldest
+    * frames set when its consumer falls behind, without stalling the pipeline or the other consumers.
+    * The consumers are kept across stop and start, the queue must outlive its registration.
+    * \param[in] pipe           the pipeline
+    * \param[in] queue          the queue to add, adding a queue twice has no effect
+    * \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_pipeline_add_consumer(rs2_pipeline* pipe, rs2_frame_queue* queue, rs2_error ** error);
+
+    /**
+    * Remove a consumer queue added by \c rs2_pipeline_add_consumer().
+    * \param[in] pipe           the pipeline
+    * \param[in] queue          the queue to remove
+    * \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_pipeline_remove_consumer(rs2_pipeline* pipe, rs2_frame_queue* queue, rs2_error ** error);
+
     /**
     * Delete a pipeline instance.
     * Upon destruction, the pipeline will implicitly stop itself
@@ -132,6 +159,25 @@ extern "C" {
     */
     rs2_pipeline_profile* rs2_pipeline_start_with_config(rs2_pipeline* pipe, rs2_config* config, rs2_error ** error);
 
+    /**
+    * Start several pipelines together, as the cameras of a rig.
+    * Each pipeline is started with its config as in \c rs2_pipeline_start_with_config(), on up to \c max_parallel threads.
+    * Most of the start of a device is spent waiting on its control transfers, so the rig comes up in about the time of its slowest
+    * device instead of the sum of their times. The configs should select different devices with \c rs2_config_enable_device().
+    * A failing start does not stop the others: all the outputs are filled, the pipelines that started remain started, and the
+    * error of the first failing pipeline is raised, the reports telling which ones failed.
+    *
+    * \param[in] pipes        The pipelines to start, none of them started
+    * \param[in] configs      The config of each pipeline, a null config starts its pipeline with the default configuration
+    * \param[in] count        The number of pipelines and configs
+    * \param[in] max_parallel The most pipelines started at the same time, 0 to start them all at once
+    * \param[out] profiles    Receives the active profile of each pipeline, null when it failed to start, to be deleted with \c rs2_delete_pipeline_profile()
+    * \param[out] reports     If non-null, receives the outcome and start time of each pipeline
+    * \param[out] error       if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_pipelines_start(rs2_pipeline** pipes, rs2_config** configs, int count, int max_parallel,
+        rs2_pipeline_profile** profiles, rs2_pipeline_start_report* reports, rs2_error ** error);
+
     /**
     * Start the pipeline streaming with its default configuration.
     * The pipeline captures samples from the device, and delivers them to the through the provided frame callback.
@@ -210,6 +256,19 @@ extern "C" {
     */
     rs2_pipeline_profile* rs2_pipeline_get_active_profile(rs2_pipeline* pipe, rs2_error ** error);
 
+    /**
+    * Retrieve the frame counters of the streams of the sensors used by the pipeline, see rs2_get_sensor_metrics.
+    * The framesets the pipeline dropped because its queue was full are counted as RS2_FRAME_DROP_CAUSE_QUEUE_FULL of each of their streams.
+    * The method returns a valid result only when the pipeline is active.
+    *
+    * \param[in] pipe    a pointer to an instance of the pipeline
+    * \param[out] metrics  array receiving the counters of up to count streams, may be null when count is 0
+    * \param[in] count     size of the metrics array
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    * \return  number of streams of the pipeline sensors, may be larger than count
+    */
+    int rs2_pipeline_get_metrics(rs2_pipeline* pipe, rs2_stream_metrics* metrics, int count, rs2_error ** error);
+
     /**
     * Retrieve the device used by the pipeline.
     * The device class provides the application access to control camera additional settings -
@@ -18,6 +18,22 @@ extern "C" {
 #include "rs_sensor.h"
 #include "rs_option.h"
 
+/** \brief Counters of a processing block since it was created. The time of a block excludes the time of the blocks and callbacks it delivered to */
+typedef struct rs2_processing_block_metrics
+{
+    unsigned long long frames; /**< Frames processed */
+    double total_time_ms;      /**< Total time spent processing */
+    double max_time_ms;        /**< Longest processing of a frame */
+} rs2_processing_block_metrics;
+
+/** \brief Occupancy of a frame queue */
+typedef struct rs2_frame_queue_metrics
+{
+    unsigned int size;          /**< Frames waiting in the queue */
+    unsigned int capacity;      /**< Frames the queue holds before the oldest ones are dropped */
+    unsigned long long dropped; /**< Frames dropped since the queue was created, because the queue was full */
+} rs2_frame_queue_metrics;
+
 /**
 * Creates Depth-Colorizer processing block that can be used to quickly visualize the depth data
 * This block will accept depth frames as input and replace them by depth frames with format RGB8
@@ -35,6 +51,17 @@ rs2_processing_block* rs2_create_colorizer(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error);
 
+/**
+* Creates Multi-Device Sync processing block. This block accepts frames from the sensors of several devices and output
+* composite frames of best matches across the devices. The streams of each device are synced as in the Sync processing block
+* and the devices are matched on the host clock: on the global timestamps when RS2_OPTION_GLOBAL_TIME_ENABLED is set on their sensors,
+* and on the arrival time of the frames otherwise
+* \param[in] tolerance_ms  max difference in milliseconds between matched frames of different devices,
+*                          0 uses half of the frame period of the slower stream
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance_ms, rs2_error** error);
+
 /**
 * Creates Point-Cloud processing block. This block accepts depth frames and outputs Points frames
 * In addition, given non-depth frame, the block will align texture coordinate to the non-depth stream
@@ -61,6 +88,52 @@ rs2_processing_block* rs2_create_yuy_decoder(rs2_error** error);
 */
 rs2_processing_block* rs2_create_threshold(rs2_error** error);
 
+/**
+* Creates voxel grid processing block. This block accepts depth frames or points and outputs points downsampled to
+* a point per occupied voxel, the centroid of the voxel holding the average texture coordinates of its points.
+* The edge of the voxels is set with RS2_OPTION_VOXEL_SIZE
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_voxel_grid_filter(rs2_error** error);
+
+/**
+* Creates depth to scan processing block. This block accepts depth frames and outputs a 2D scan of a band of rows
+* centered on the principal point: a single row of RS2_FORMAT_DISTANCE holding the nearest range in the horizontal plane
+* per angle bin, in meters, zero for the bins with no depth in range. The number of bins and of rows are set with
+* RS2_OPTION_SCAN_BINS and RS2_OPTION_SCAN_ROWS, the range with RS2_OPTION_MIN_DISTANCE and RS2_OPTION_MAX_DISTANCE
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_to_scan(rs2_error** error);
+
+/**
+* Returns the angles of the bins of the scans depth to scan computes from depth of the given intrinsics.
+* The angles are atan2(x, z) of the camera coordinates, in radians, growing to the right
+* \param[in] depth_intrinsics  intrinsics of the depth stream
+* \param[in] bins              number of angle bins of the scan
+* \param[out] angle_min        angle of the first bin
+* \param[out] angle_increment  angle between two bins
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_scan_angles(const rs2_intrinsics* depth_intrinsics, int bins, float* angle_min, float* angle_increment, rs2_error** error);
+
+/**
+* Creates median filter processing block. This block replaces every depth pixel by the median of the valid depth of its
+* 3x3 or 5x5 neighborhood, the pixels of no depth are ignored and stay holes.
+* The neighborhood radius, 1 or 2, is set with RS2_OPTION_FILTER_MAGNITUDE
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_median_filter(rs2_error** error);
+
+/**
+* Creates tensor converter processing block. This block converts color frames of RGB8, BGR8, RGBA8 or BGRA8 to the
+* input tensor of a network: resized bilinearly to RS2_OPTION_TENSOR_WIDTH by RS2_OPTION_TENSOR_HEIGHT, normalized to
+* (value - RS2_OPTION_TENSOR_MEAN) * RS2_OPTION_TENSOR_SCALE and laid out as planar channels, NCHW with N = 1.
+* The output frame is as wide as the tensor and three times as high, the R, G and B planes one below the other
+* (B, G and R with RS2_OPTION_TENSOR_BGR), of RS2_FORMAT_DISTANCE floats, or of RS2_FORMAT_Y8 with RS2_OPTION_TENSOR_FLOAT off
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_tensor_converter(rs2_error** error);
+
 /**
 * Creates depth units transformation processing block
 * All of the pixels are transformed from depth units into meters.
@@ -140,6 +213,33 @@ void rs2_process_frame(rs2_processing_block* block, rs2_frame* frame, rs2_error*
 */
 void rs2_delete_processing_block(rs2_processing_block* block);
 
+/**
+* Select whether the processing block runs inline on the thread calling rs2_process_frame (default) or on the shared processing executor
+* In asynchronous mode rs2_process_frame only queues the frame. Frames are still processed one at a time, in the order they were given
+* \param[in] block          Processing block
+* \param[in] async          non-zero to run the block on the shared processing executor
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_processing_block_async(rs2_processing_block* block, int async, rs2_error** error);
+
+/**
+* Configure the shared executor running asynchronous processing blocks
+* Joins the running workers, so it fails when called from a processing block running on them
+* \param[in] workers        number of worker threads, 0 selects the number of hardware threads
+* \param[in] cpus           CPU indices the workers are pinned to, round-robin. May be null
+* \param[in] cpus_count     number of entries in cpus
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_configure_processing_executor(int workers, const int* cpus, int cpus_count, rs2_error** error);
+
+/**
+* Retrieve the counters of a processing block
+* \param[in] block          Processing block
+* \param[out] metrics       Receives the counters of the block
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_processing_block_metrics(const rs2_processing_block* block, rs2_processing_block_metrics* metrics, rs2_error** error);
+
 /**
 * create frame queue. frame queues are the simplest x-platform synchronization primitive provided by librealsense
 * to help developers who are not using async APIs
@@ -183,6 +283,29 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
 */
 int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_frame** output_frame, rs2_error** error);
 
+/**
+* dequeue the frames available in the queue, up to max_frames of them, without waiting
+* \param[in] queue          the frame queue data structure
+* \param[out] output_frames array of at least max_frames frame handles, receives the frames in the order they were enqueued,
+*                           each to be released using rs2_release_frame
+* \param[in] max_frames     max number of frames to dequeue
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return number of frames stored to output_frames
+*/
+int rs2_poll_for_frames(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, rs2_error** error);
+
+/**
+* wait until a frame becomes available in the queue, then dequeue it together with the frames following it, up to max_frames frames
+* \param[in] queue          the frame queue data structure
+* \param[in] timeout_ms     max time in milliseconds to wait until a frame becomes available
+* \param[out] output_frames array of at least max_frames frame handles, receives the frames in the order they were enqueued,
+*                           each to be released using rs2_release_frame
+* \param[in] max_frames     max number of frames to dequeue
+* \param[out] error         if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return number of frames stored to output_frames, 0 if no frame arrived in time
+*/
+int rs2_wait_for_frames(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_frame** output_frames, int max_frames, rs2_error** error);
+
 /**
 * enqueue new frame into a queue
 * \param[in] frame frame handle to enqueue (this operation passed ownership to the queue)
@@ -190,6 +313,14 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
 */
 void rs2_enqueue_frame(rs2_frame* frame, void* queue);
 
+/**
+* retrieve the occupancy of a frame queue and the frames it dropped
+* \param[in] queue the frame queue data structure
+* \param[out] metrics receives the occupancy of the queue
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_queue_metrics(rs2_frame_queue* queue, rs2_frame_queue_metrics* metrics, rs2_error** error);
+
 /**
 * Creates Align processing block.
 * \param[in] align_to   stream type to be used as the target of frameset alignment
@@ -197,6 +328,23 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue);
 */
 rs2_processing_block* rs2_create_align(rs2_stream align_to, rs2_error** error);
 
+/**
+* Creates Align processing block aligning the depth to several streams in one pass, each depth pixel is deprojected once for all of them.
+* The output holds an aligned depth frame per target found in the frameset, in the order of the targets.
+* \param[in] align_to   stream types to be used as the targets of frameset alignment, RS2_STREAM_DEPTH can only be a single target
+* \param[in] count      number of stream types in align_to
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_align_to_streams(const rs2_stream* align_to, int count, rs2_error** error);
+
+/**
+* Creates a processing block aligning the depth to another stream and computing the pointcloud textured by it in one pass,
+* each depth pixel is deprojected once for both. The output holds the points and the aligned depth in place of the depth.
+* \param[in] align_to   stream type to be used as the target of the alignment and the texture of the points, not RS2_STREAM_DEPTH
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_align_pointcloud(rs2_stream align_to, rs2_error** error);
+
 /**
 * Creates Depth post-processing filter block. This block accepts depth frames, applies decimation filter and plots modified prames
 * Note that due to the modifiedframe size, the decimated frame repaces the original one
@@ -229,6 +377,32 @@ rs2_processing_block* rs2_create_disparity_transform_block(unsigned char transfo
 */
 rs2_processing_block* rs2_create_hole_filling_filter_block(rs2_error** error);
 
+/**
+* Creates Depth post-processing block running the recommended filters of stereo depth in one pass: decimation, spatial, temporal and hole filling
+* in the disparity domain. It produces the output of the sequence of these blocks with a single output frame
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_depth_filter_chain_block(rs2_error** error);
+
+/**
+* Retrieves a stage of a depth filter chain, to access its options. The returned block must be deleted with rs2_delete_processing_block
+* \param[in] block   the depth filter chain
+* \param[in] stage   RS2_EXTENSION_DECIMATION_FILTER, RS2_EXTENSION_SPATIAL_FILTER, RS2_EXTENSION_TEMPORAL_FILTER or RS2_EXTENSION_HOLE_FILLING_FILTER
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_get_depth_filter_chain_stage(rs2_processing_block* block, rs2_extension stage, rs2_error** error);
+
+/**
+* Restricts a pointcloud or an align block to regions of the depth image, for example the boxes of detected objects.
+* Only the depth pixels inside the regions are deprojected or aligned, the output frames keep the size of the image and hold no data outside them.
+* The GPU implementations ignore the regions
+* \param[in] block    the pointcloud or align block
+* \param[in] regions  regions in depth pixels, their bounds included
+* \param[in] count    number of regions, 0 processes the whole image again
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_processing_block_regions(rs2_processing_block* block, const rs2_pixel_region* regions, int count, rs2_error** error);
+
 /**
 * Creates a rates printer block. The printer prints the actual FPS of the invoked frame stream.
 * The block ignores reapiting frames and calculats the FPS only if the frame number of the relevant frame was changed.
@@ -265,6 +439,16 @@ rs2_processing_block* rs2_create_hdr_merge_processing_block(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error);
 
+/**
+* Creates a sequence_id_demux processing block.
+* The block delivers every frame of a sequence on a virtual stream of its sequence id, or of its emitter state (1 for on,
+* 0 for off) when the frames carry no sequence, so that the syncer matches the sequence ids as separate streams.
+* The virtual stream of key k has the stream type of its source and the stream index of the source plus 10 * k.
+* The output frames refer to the data of the input frames, without copies
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_sequence_id_demux(rs2_error** error);
+
 /**
 * Retrieve processing block specific information, like name.
 * \param[in]  block     The processing block
@@ -27,6 +27,19 @@ typedef enum rs2_playback_status
 
 const char* rs2_playback_status_to_string(rs2_playback_status status);
 
+/** \brief Compression the recorder applies to the images of a stream, on top of the file compression */
+typedef enum rs2_frame_compression
+{
+    RS2_FRAME_COMPRESSION_NONE, /**< The images are stored as they are */
+    RS2_FRAME_COMPRESSION_RVL,  /**< Lossless run length and variable length coding of 16 bit images, usually 3-5x on depth */
+    RS2_FRAME_COMPRESSION_LZ4,  /**< Lossless LZ4 compression of any image format */
+    RS2_FRAME_COMPRESSION_JPEG, /**< Lossy JPEG compression of RGB8, BGR8 and Y8 images, available when built with libjpeg-turbo */
+    RS2_FRAME_COMPRESSION_RVL_DELTA, /**< Lossless RVL of the difference of 16 bit images from the previous image, with a key image every 30 images for seeking. Much smaller than RVL on static scenes */
+    RS2_FRAME_COMPRESSION_COUNT
+} rs2_frame_compression;
+
+const char* rs2_frame_compression_to_string(rs2_frame_compression compression);
+
 typedef void (*rs2_playback_status_changed_callback_ptr)(rs2_playback_status);
 
 /**
@@ -71,6 +84,98 @@ void rs2_record_device_resume(const rs2_device* device, rs2_error** error);
 */
 const char* rs2_record_device_filename(const rs2_device* device, rs2_error** error);
 
+/**
+* Select what the recorder does with a frame that arrives while its write cache is full.
+* By default the frame is dropped. A blocking recorder holds the frame for up to a second until the file writer catches up,
+* back-pressuring the sensor that produced it.
+* \param[in]  device    A recording device
+* \param[in]  blocking  Non-zero to wait for the writer, zero to drop the frame
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_blocking_write(const rs2_device* device, int blocking, rs2_error** error);
+
+/**
+* Select the compression of the images of a stream.
+* The images are decompressed transparently on playback. Streams whose format the compression doesn't support are stored as they are.
+* \param[in]  device       A recording device
+* \param[in]  stream       The stream type the compression applies to
+* \param[in]  compression  The image compression
+* \param[out] error        If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_frame_compression(const rs2_device* device, rs2_stream stream, rs2_frame_compression compression, rs2_error** error);
+
+/**
+* Write the frames of every stream to a file of its own, each written and compressed by a thread of its own, for disks a single writer can't fill.
+* The file of a stream is named after the recording file and the stream, test.bag records the depth to test_Depth.bag.
+* The recording file keeps the description of the device, the options and the notifications, playing it plays all the files as one recording.
+* Usually set before the recording starts, the frames recorded after a change go to the newly selected files
+* \param[in]  device           A recording device
+* \param[in]  file_per_stream  Non-zero for a file per stream, zero for a single file
+* \param[out] error            If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_file_per_stream(const rs2_device* device, int file_per_stream, rs2_error** error);
+
+/**
+* Gets the number of frames the recorder wrote to the file
+* \param[in]  device    A recording device
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return The number of frames written
+*/
+unsigned long long rs2_record_device_get_written_frames(const rs2_device* device, rs2_error** error);
+
+/**
+* Gets the number of frames the recorder dropped because its write cache was full
+* \param[in]  device    A recording device
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return The number of frames dropped
+*/
+unsigned long long rs2_record_device_get_dropped_frames(const rs2_device* device, rs2_error** error);
+
+/**
+* Record only every Nth frame of a stream. The other frames are still delivered to the user, they are just not written to the file
+* \param[in]  device       A recording device
+* \param[in]  stream       The stream type the decimation applies to
+* \param[in]  every_nth    Record one frame out of every_nth frames, 1 records every frame
+* \param[out] error        If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_stream_decimation(const rs2_device* device, rs2_stream stream, int every_nth, rs2_error** error);
+
+/**
+* Record the output of a processing block (for example a decimation filter) instead of the frames of a stream.
+* The block is dedicated to the recorder from then on. Must be set before the stream is opened, so the file describes the processed stream
+* \param[in]  device       A recording device
+* \param[in]  stream       The stream type whose frames are processed
+* \param[in]  block        The processing block, or null to record the frames as they are
+* \param[out] error        If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_stream_processing(const rs2_device* device, rs2_stream stream, rs2_processing_block* block, rs2_error** error);
+
+/**
+* Record a stream only around triggers. The frames of the last pre_trigger_seconds are held in memory, and written to the file
+* together with the frames of the following post_trigger_seconds when rs2_record_device_trigger is called
+* \param[in]  device                A recording device
+* \param[in]  stream                The stream type recorded on trigger
+* \param[in]  pre_trigger_seconds   How long before the trigger frames are kept in memory
+* \param[in]  post_trigger_seconds  How long after the trigger frames are recorded
+* \param[out] error                 If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_set_stream_trigger(const rs2_device* device, rs2_stream stream, float pre_trigger_seconds, float post_trigger_seconds, rs2_error** error);
+
+/**
+* Write the frames held for the triggered streams to the file, and record their following post trigger seconds
+* \param[in]  device    A recording device
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_trigger(const rs2_device* device, rs2_error** error);
+
+/**
+* Record every frame of a stream again, removing its decimation, processing and trigger. Frames held for a trigger are discarded
+* \param[in]  device    A recording device
+* \param[in]  stream    The stream type
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_record_device_clear_stream_policy(const rs2_device* device, rs2_stream stream, rs2_error** error);
+
 /**
 * Creates a playback device to play the content of the given file
 * \param[in]  file      Path to the file to play
@@ -150,6 +255,41 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
  */
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error);
 
+/**
+ * Select how a non real time playback publishes its frames.
+ * With ordered delivery, the frames of all the streams are published one at a time in the order they were recorded,
+ * from the thread reading the file, so offline processing gets the same sequence of frames on every run.
+ * Decoding recorded compressed images is left to the first access of the frame data, so it runs on the threads processing the frames.
+ * By default each stream is published from a thread of its own. Has no effect in real time mode
+ * \param[in] device A playback device
+ * \param[in] ordered  Indicates if ordered delivery is requested, 0 means false, otherwise true
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_ordered_delivery(const rs2_device* device, int ordered, rs2_error** error);
+
+/**
+ * Play a playback device together with another one, on a single read thread and a single clock.
+ * The data of the joined devices is played in the order of its recorded system time, so the files recorded by several cameras
+ * at once play back in the order they were captured, paced against the same time base in real time mode, and published in
+ * that single order in non real time mode with ordered delivery. Joining a device already joined to others adds it to their playback.
+ * The devices are joined while stopped, each is still started, paused and stopped by its own sensors and calls, the playback speed
+ * is set alike on all of them
+ * \param[in] device A playback device
+ * \param[in] other  The playback device to play together with
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_join(const rs2_device* device, const rs2_device* other, rs2_error** error);
+
+/**
+ * Keep the last frames read from the file in memory, so seeking back to them, e.g. stepping back one frame at a time or scrubbing
+ * around the current time while paused, does not read and decode the file again.
+ * The cached frames are held by the playback and count as frames in use, the memory of the frames grows accordingly
+ * \param[in] device A playback device
+ * \param[in] frames Number of frames to keep, of all the streams together. 0 (the default) disables the cache
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_frame_cache_size(const rs2_device* device, int frames, rs2_error** error);
+
 /**
  * Register to receive callback from playback device upon its status changes
  *
@@ -98,6 +98,44 @@ typedef struct rs2_extrinsics
     float translation[3]; /**< Three-element translation vector, in meters */
 } rs2_extrinsics;
 
+/** \brief Reasons a frame of a stream did not reach the user. */
+typedef enum rs2_frame_drop_cause
+{
+    RS2_FRAME_DROP_CAUSE_FRAME_NUMBER_GAP , /**< Frames missing between the frame numbers of consecutive frames, lost before reaching the host */
+    RS2_FRAME_DROP_CAUSE_FRAME_POOL_FULL  , /**< The user held RS2_OPTION_FRAMES_QUEUE_SIZE frames of the sensor when the frame arrived */
+    RS2_FRAME_DROP_CAUSE_NOT_STREAMING    , /**< The frame arrived while the sensor was stopping */
+    RS2_FRAME_DROP_CAUSE_UNREQUESTED      , /**< The frame belongs to a stream that was not requested */
+    RS2_FRAME_DROP_CAUSE_QUEUE_FULL       , /**< The frame was replaced by a newer one in a full frame queue or in the queue of the pipeline */
+    RS2_FRAME_DROP_CAUSE_MEMORY_BUDGET    , /**< The buffer of the frame would have exceeded a memory budget, see rs2_set_memory_budget */
+    RS2_FRAME_DROP_CAUSE_COUNT              /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_frame_drop_cause;
+const char* rs2_frame_drop_cause_to_string(rs2_frame_drop_cause cause);
+
+/** \brief Counters of a stream of a sensor since the sensor was created, the rates are measured over the last second.
+    A stream converted from another one, as the infrared streams of the Y8I format, counts the frames it delivered only */
+typedef struct rs2_stream_metrics
+{
+    rs2_stream stream;                                      /**< Stream type */
+    int index;                                              /**< Stream index */
+    unsigned long long arrived;                             /**< Frames received from the backend */
+    unsigned long long delivered;                           /**< Frames given to the user callback */
+    unsigned long long dropped[RS2_FRAME_DROP_CAUSE_COUNT]; /**< Frames dropped, per cause */
+    float arrival_fps;                                      /**< Frames received per second */
+    float delivered_fps;                                    /**< Frames delivered per second */
+    double unpack_time_ms;                                  /**< Total time spent converting the received frames to the requested formats */
+    double max_unpack_time_ms;                              /**< Longest conversion of a frame */
+} rs2_stream_metrics;
+
+/** \brief Usage of the frame buffers of a sensor */
+typedef struct rs2_frame_pool_metrics
+{
+    unsigned long long hits;      /**< Buffers served from the recycled buffers */
+    unsigned long long misses;    /**< Buffers that had to be allocated */
+    unsigned long long evictions; /**< Recycled buffers released after the retention period */
+    unsigned int in_use;          /**< Frames currently held by the user */
+    unsigned int capacity;        /**< Frames the user may hold before new frames are dropped, 0 when unbounded */
+} rs2_frame_pool_metrics;
+
 /**
 * Deletes sensors list, any sensors created from this list will remain unaffected
 * \param[in] info_list list to delete
@@ -276,6 +314,38 @@ void rs2_set_notifications_callback(const rs2_sensor* sensor, rs2_notification_c
 */
 void rs2_set_notifications_callback_cpp(const rs2_sensor* sensor, rs2_notifications_callback* callback, rs2_error** error);
 
+/**
+* set custom allocator for the frame buffers produced by the specified sensor
+* buffers obtained from the allocator are not zero-initialized and may be recycled by the library for subsequent frames
+* must be called while the sensor is not streaming
+* \param[in] sensor      RealSense sensor
+* \param[in] allocate    function pointer returning a buffer of at least the requested size, or null on failure
+* \param[in] deallocate  function pointer releasing a buffer previously returned by allocate
+* \param[in] user        auxiliary data the user wishes to receive together with every allocator call
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user, rs2_error** error);
+
+/**
+* set custom allocator for the frame buffers produced by the specified sensor
+* \param[in] sensor     RealSense sensor
+* \param[in] allocator  allocator object created from c++ application. ownership over the allocator object is shared with every buffer it provided
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_allocator_cpp(const rs2_sensor* sensor, rs2_frame_allocator* allocator, rs2_error** error);
+
+/**
+* retrieve the frame counters of the streams of a sensor and the usage of its frame buffers
+* the counters keep growing until the sensor is destroyed, so they can be exported as monotonic counters
+* \param[in] sensor      RealSense sensor
+* \param[out] metrics    array receiving the counters of up to count streams, may be null when count is 0
+* \param[in] count       size of the metrics array
+* \param[out] pool       if non-null, receives the usage of the frame buffers of the sensor
+* \param[out] error      if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return                number of streams the sensor has counters for, may be larger than count
+*/
+int rs2_get_sensor_metrics(const rs2_sensor* sensor, rs2_stream_metrics* metrics, int count, rs2_frame_pool_metrics* pool, rs2_error** error);
+
 /**
 * retrieve description from notification handle
 * \param[in] notification      handle returned from a callback
@@ -566,6 +636,16 @@ int rs2_get_static_node(const rs2_sensor* sensor, const char* guid, rs2_vector *
 */
 int rs2_remove_static_node(const rs2_sensor* sensor, const char* guid, rs2_error** error);
 
+/**
+* Retrieve the latest pose received from the device, without going through a frame queue or callback
+* \param[in]  sensor    T2xx position-tracking sensor
+* \param[out] pose      The latest pose
+* \param[out] timestamp The timestamp of the pose, in milliseconds of the global time domain
+* \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               Non-zero if a pose was received since the sensor was started, otherwise 0
+*/
+int rs2_get_latest_pose(const rs2_sensor* sensor, rs2_pose* pose, double* timestamp, rs2_error** error);
+
 /** Load Wheel odometer settings from host to device
 * \param[in] odometry_config_buf   odometer configuration/calibration blob serialized from jsom file
 * \return true on success
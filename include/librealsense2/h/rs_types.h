@@ -22,6 +22,7 @@ typedef enum rs2_notification_category{
     RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR,                /**< Received unknown error from the device */
     RS2_NOTIFICATION_CATEGORY_FIRMWARE_UPDATE_RECOMMENDED,  /**< Current firmware version installed is not the latest available */
     RS2_NOTIFICATION_CATEGORY_POSE_RELOCALIZATION,          /**< A relocalization event has updated the pose provided by a pose sensor */
+    RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET_EXCEEDED,       /**< Frames are dropped because their buffers would exceed a memory budget of policy RS2_MEMORY_BUDGET_POLICY_FAIL */
     RS2_NOTIFICATION_CATEGORY_COUNT                         /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_notification_category;
 const char* rs2_notification_category_to_string(rs2_notification_category category);
@@ -119,6 +120,12 @@ typedef struct rs2_pixel
     int ij[2];
 } rs2_pixel;
 
+/** \brief Rectangle of pixels within 2D image, its bounds included */
+typedef struct rs2_pixel_region
+{
+    int min_x, min_y, max_x, max_y;
+} rs2_pixel_region;
+
 /** \brief 3D vector in Euclidean coordinate space */
 typedef struct rs2_vector
 {
@@ -244,6 +251,44 @@ typedef enum rs2_matchers
    RS2_MATCHER_COUNT
 }rs2_matchers;
 
+/** \brief Categories of the memory held by the library */
+typedef enum rs2_memory_category
+{
+    RS2_MEMORY_CATEGORY_FRAME_BUFFERS     , /**< Buffers of the frames held by the user, the queues and the processing blocks, and of the recycled frames */
+    RS2_MEMORY_CATEGORY_FRAME_POOL        , /**< Part of the frame buffers recycled in the frame pools, waiting for new frames */
+    RS2_MEMORY_CATEGORY_PROCESSING_CACHES , /**< Tables and frame history kept by the processing blocks, counted for the process only */
+    RS2_MEMORY_CATEGORY_COUNT               /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_memory_category;
+const char* rs2_memory_category_to_string(rs2_memory_category category);
+
+/** \brief Behaviors of the allocation of a frame that would exceed a memory budget */
+typedef enum rs2_memory_budget_policy
+{
+    RS2_MEMORY_BUDGET_POLICY_DROP  , /**< The frame is dropped at its source, after the recycled buffers of the source are released */
+    RS2_MEMORY_BUDGET_POLICY_BLOCK , /**< The source waits up to a second for frames to be released, then drops the frame */
+    RS2_MEMORY_BUDGET_POLICY_FAIL  , /**< The frame is dropped and the sensor raises RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET_EXCEEDED */
+    RS2_MEMORY_BUDGET_POLICY_COUNT   /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_memory_budget_policy;
+const char* rs2_memory_budget_policy_to_string(rs2_memory_budget_policy policy);
+
+/** \brief Layouts of the points packed out of a points frame, every point holds its vertex then its texture coordinates or its color */
+typedef enum rs2_points_format
+{
+    RS2_POINTS_FORMAT_FLOAT32  , /**< 20 bytes per point: x, y, z in meters and u, v, as floats like in the points frame */
+    RS2_POINTS_FORMAT_FLOAT16  , /**< 10 bytes per point: x, y, z in meters and u, v, as half floats */
+    RS2_POINTS_FORMAT_INT16_MM , /**< 10 bytes per point: x, y, z in millimeters as signed 16 bit and u, v scaled to 0-65535 as unsigned 16 bit, saturated */
+    RS2_POINTS_FORMAT_XYZRGB   , /**< 16 bytes per point: x, y, z in meters as floats and the color as 8 bit blue, green, red and a zero byte, the packed RGB of PCL. The points must be colored, see RS2_OPTION_POINTS_COLORS */
+    RS2_POINTS_FORMAT_COUNT      /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_points_format;
+const char* rs2_points_format_to_string(rs2_points_format format);
+
+/** \brief Bytes held by the library, per category */
+typedef struct rs2_memory_usage
+{
+    long long bytes[RS2_MEMORY_CATEGORY_COUNT];      /**< Bytes currently held */
+    long long peak_bytes[RS2_MEMORY_CATEGORY_COUNT]; /**< Largest number of bytes held since the process started, or since the device was created */
+} rs2_memory_usage;
+
 typedef struct rs2_device_info rs2_device_info;
 typedef struct rs2_device rs2_device;
 typedef struct rs2_error rs2_error;
@@ -259,6 +304,7 @@ typedef struct rs2_stream_profile_list rs2_stream_profile_list;
 typedef struct rs2_processing_block_list rs2_processing_block_list;
 typedef struct rs2_stream_profile rs2_stream_profile;
 typedef struct rs2_frame_callback rs2_frame_callback;
+typedef struct rs2_frame_allocator rs2_frame_allocator;
 typedef struct rs2_log_callback rs2_log_callback;
 typedef struct rs2_syncer rs2_syncer;
 typedef struct rs2_device_serializer rs2_device_serializer;
@@ -267,6 +313,7 @@ typedef struct rs2_processing_block rs2_processing_block;
 typedef struct rs2_frame_processor_callback rs2_frame_processor_callback;
 typedef struct rs2_playback_status_changed_callback rs2_playback_status_changed_callback;
 typedef struct rs2_update_progress_callback rs2_update_progress_callback;
+typedef struct rs2_calibration_done_callback rs2_calibration_done_callback;
 typedef struct rs2_context rs2_context;
 typedef struct rs2_device_hub rs2_device_hub;
 typedef struct rs2_sensor_list rs2_sensor_list;
@@ -287,6 +334,9 @@ typedef void (*rs2_devices_changed_callback_ptr)(rs2_device_list*, rs2_device_li
 typedef void (*rs2_frame_callback_ptr)(rs2_frame*, void*);
 typedef void (*rs2_frame_processor_callback_ptr)(rs2_frame*, rs2_source*, void*);
 typedef void(*rs2_update_progress_callback_ptr)(const float, void*);
+typedef void(*rs2_calibration_done_callback_ptr)(const unsigned char* calibration, int size, float health, const char* error_message, void*);
+typedef void* (*rs2_frame_allocate_ptr)(int size, void* user);
+typedef void (*rs2_frame_deallocate_ptr)(void* ptr, int size, void* user);
 
 typedef double      rs2_time_t;     /**< Timestamp format. units are milliseconds */
 typedef long long   rs2_metadata_type; /**< Metadata attribute type is defined as 64 bit signed integer*/
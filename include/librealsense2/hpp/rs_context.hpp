@@ -10,6 +10,19 @@
 
 namespace rs2
 {
+    /**
+    * Sets the CPUs and the scheduling of the threads of a role, for all the contexts of the process. Applies to the threads started after the call
+    * \param[in] role               Role of the threads
+    * \param[in] cpus               CPU indices the threads may run on, any CPU when empty
+    * \param[in] realtime_priority  0 for the default scheduling, 1 to 99 for real-time scheduling at that priority
+    */
+    inline void set_thread_policy(rs2_thread_role role, const std::vector<int>& cpus = {}, int realtime_priority = 0)
+    {
+        rs2_error* e = nullptr;
+        rs2_set_thread_policy(role, cpus.data(), static_cast<int>(cpus.size()), realtime_priority, &e);
+        error::handle(e);
+    }
+
     class event_information
     {
     public:
@@ -206,6 +219,28 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+        * limit the frame buffers of the devices of the context, 0 bytes for no limit, see rs2_set_memory_budget
+        */
+        void set_memory_budget(long long bytes, rs2_memory_budget_policy policy = RS2_MEMORY_BUDGET_POLICY_DROP) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_memory_budget(_context.get(), bytes, policy, &e);
+            rs2::error::handle(e);
+        }
+
+        /**
+        * bytes held by the library for the frames of the devices of the context
+        */
+        rs2_memory_usage get_memory_usage() const
+        {
+            rs2_error* e = nullptr;
+            rs2_memory_usage usage;
+            rs2_get_context_memory_usage(_context.get(), &usage, &e);
+            rs2::error::handle(e);
+            return usage;
+        }
+
         context(std::shared_ptr<rs2_context> ctx)
             : _context(ctx)
         {}
@@ -7,6 +7,8 @@
 #include "rs_types.hpp"
 #include "rs_sensor.hpp"
 #include <array>
+#include <exception>
+#include <thread>
 
 namespace rs2
 {
@@ -95,6 +97,40 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * bytes held by the library for the frames of the device and of the processing blocks of its sensors
+        */
+        rs2_memory_usage get_memory_usage() const
+        {
+            rs2_error* e = nullptr;
+            rs2_memory_usage usage;
+            rs2_get_device_memory_usage(_dev.get(), &usage, &e);
+            error::handle(e);
+            return usage;
+        }
+
+        /**
+        * NUMA node of the USB controller the device is attached to, -1 when unknown or on single node systems
+        */
+        int get_numa_node() const
+        {
+            rs2_error* e = nullptr;
+            auto node = rs2_get_device_numa_node(_dev.get(), &e);
+            error::handle(e);
+            return node;
+        }
+
+        /**
+        * map the frame buffers of the sensors of the device from a NUMA node, -1 for any node, and on huge pages
+        * must be called while the sensors are not streaming
+        */
+        void set_frame_memory_policy(int numa_node, bool huge_pages) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_memory_policy(_dev.get(), numa_node, huge_pages, &e);
+            error::handle(e);
+        }
+
         device& operator=(const std::shared_ptr<rs2_device> dev)
         {
             _dev.reset();
@@ -163,6 +199,22 @@ namespace rs2
         void release() override { delete this; }
     };
 
+    template<class T>
+    class calibration_done_callback : public rs2_calibration_done_callback
+    {
+        T _callback;
+
+    public:
+        explicit calibration_done_callback(T callback) : _callback(callback) {}
+
+        void on_calibration_done(const unsigned char* calibration, int size, float health, const char* error_message) override
+        {
+            _callback(std::vector<uint8_t>(calibration, calibration + size), health, std::string(error_message ? error_message : ""));
+        }
+
+        void release() override { delete this; }
+    };
+
     class updatable : public device
     {
     public:
@@ -282,6 +334,39 @@ namespace rs2
         }
     };
 
+    // Update several devices to the same firmware, each on its own thread. The callback is called
+    // from those threads with the index of the device and its progress, so it must be thread-safe.
+    // Returns when all the updates have ended; if any failed, the first error is then rethrown.
+    template<class T>
+    void update_devices(const std::vector<update_device>& devices, const std::vector<uint8_t>& fw_image, T callback)
+    {
+        std::vector<std::exception_ptr> errors(devices.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            threads.emplace_back([&, i]() {
+                try
+                {
+                    devices[i].update(fw_image, [&, i](float progress) { callback(i, progress); });
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        for (auto& t : threads)
+            t.join();
+        for (auto& error : errors)
+            if (error)
+                std::rethrow_exception(error);
+    }
+
+    inline void update_devices(const std::vector<update_device>& devices, const std::vector<uint8_t>& fw_image)
+    {
+        update_devices(devices, fw_image, [](size_t, float) {});
+    }
+
     typedef std::vector<uint8_t> calibration_table;
 
     class calibrated_device : public device
@@ -405,6 +490,25 @@ namespace rs2
             return results;
         }
 
+        /**
+        * Start on-chip calibration and return once its parameters are validated, the calibration runs on a thread of its own.
+        * The device only runs one calibration at a time.
+        * \param[in] json_content       Json string to configure the calibration, as in run_on_chip_calibration()
+        * \param[in] on_done            Called from the calibration thread as on_done(calibration_table, health, error_message),
+                                        error_message is empty when the calibration succeeded
+        * \param[in] on_progress        Optional callback to get progress notifications
+        * \param[in] timeout_ms         Timeout in ms
+        */
+        template<class T>
+        void run_on_chip_calibration_async(std::string json_content, T on_done, std::function<void(float)> on_progress = nullptr, int timeout_ms = 5000) const
+        {
+            rs2_error* e = nullptr;
+            rs2_run_on_chip_calibration_async_cpp(_dev.get(), json_content.data(), int(json_content.size()),
+                on_progress ? new update_progress_callback<std::function<void(float)>>(on_progress) : nullptr,
+                new calibration_done_callback<T>(std::move(on_done)), timeout_ms, &e);
+            error::handle(e);
+        }
+
         /**
         * This will adjust camera absolute distance to flat target. User needs to enter the known ground truth.
         * \param[in] ground_truth_mm     Ground truth in mm must be between 2500 - 2000000
@@ -489,6 +593,26 @@ namespace rs2
             return results;
         }
 
+        /**
+        * Start tare calibration and return once its parameters are validated, the calibration runs on a thread of its own.
+        * The device only runs one calibration at a time.
+        * \param[in] ground_truth_mm    Ground truth in mm must be between 2500 - 2000000
+        * \param[in] json_content       Json string to configure the calibration, as in run_tare_calibration()
+        * \param[in] on_done            Called from the calibration thread as on_done(calibration_table, health, error_message),
+                                        error_message is empty when the calibration succeeded
+        * \param[in] on_progress        Optional callback to get progress notifications
+        * \param[in] timeout_ms         Timeout in ms
+        */
+        template<class T>
+        void run_tare_calibration_async(float ground_truth_mm, std::string json_content, T on_done, std::function<void(float)> on_progress = nullptr, int timeout_ms = 5000) const
+        {
+            rs2_error* e = nullptr;
+            rs2_run_tare_calibration_async_cpp(_dev.get(), ground_truth_mm, json_content.data(), int(json_content.size()),
+                on_progress ? new update_progress_callback<std::function<void(float)>>(on_progress) : nullptr,
+                new calibration_done_callback<T>(std::move(on_done)), timeout_ms, &e);
+            error::handle(e);
+        }
+
         /**
         *  Read current calibration table from flash.
         * \return    Calibration table
@@ -9,6 +9,8 @@
 #include <cmath>
 #include <sstream>
 #include <cassert>
+#include <cstring>
+#include <array>
 #include "rs_processing.hpp"
 #include "rs_internal.hpp"
 #include <iostream>
@@ -87,8 +89,8 @@ namespace rs2
             std::vector<rs2::vertex> new_verts;
             std::vector<vec3d> normals;
             std::vector<std::array<uint8_t, 3>> new_tex;
-            std::map<int, int> idx_map;
-            std::map<int, std::vector<vec3d>> index_to_normals;
+            std::vector<int> idx_map(p.size(), -1); // index in new_verts, -1 for the dropped vertices
+            std::vector<vec3d> normal_sums;
 
             new_verts.reserve(p.size());
             if (use_texcoords) new_tex.reserve(p.size());
@@ -122,8 +124,7 @@ namespace rs2
                             && fabs(verts[a].z - verts[b].z) < threshold && fabs(verts[a].z - verts[c].z) < threshold
                             && fabs(verts[b].z - verts[d].z) < threshold && fabs(verts[c].z - verts[d].z) < threshold)
                         {
-                            if (idx_map.count(a) == 0 || idx_map.count(b) == 0 || idx_map.count(c) == 0 ||
-                                idx_map.count(d) == 0)
+                            if (idx_map[a] < 0 || idx_map[b] < 0 || idx_map[c] < 0 || idx_map[d] < 0)
                                 continue;
                             faces.push_back({ idx_map[a], idx_map[d], idx_map[b] });
                             faces.push_back({ idx_map[d], idx_map[a], idx_map[c] });
@@ -138,15 +139,13 @@ namespace rs2
                                 auto n1 = cross(point_d - point_a, point_b - point_a);
                                 auto n2 = cross(point_c - point_a, point_d - point_a);
 
-                                index_to_normals[idx_map[a]].push_back(n1);
-                                index_to_normals[idx_map[a]].push_back(n2);
+                                if (normal_sums.empty())
+                                    normal_sums.resize(new_verts.size(), { 0, 0, 0 });
 
-                                index_to_normals[idx_map[b]].push_back(n1);
-
-                                index_to_normals[idx_map[c]].push_back(n2);
-
-                                index_to_normals[idx_map[d]].push_back(n1);
-                                index_to_normals[idx_map[d]].push_back(n2);
+                                normal_sums[idx_map[a]] = normal_sums[idx_map[a]] + n1 + n2;
+                                normal_sums[idx_map[b]] = normal_sums[idx_map[b]] + n1;
+                                normal_sums[idx_map[c]] = normal_sums[idx_map[c]] + n2;
+                                normal_sums[idx_map[d]] = normal_sums[idx_map[d]] + n1 + n2;
                             }
                         }
                     }
@@ -155,20 +154,18 @@ namespace rs2
 
             if (mesh && use_normals)
             {
-                for (int i = 0; i < new_verts.size(); ++i)
+                normals.reserve(new_verts.size());
+                for (size_t i = 0; i < new_verts.size(); ++i)
                 {
-                    auto normals_vec = index_to_normals[i];
-                    vec3d sum = { 0, 0, 0 };
-                    for (auto& n : normals_vec)
-                        sum = sum + n;
-                    if (normals_vec.size() > 0)
+                    auto sum = normal_sums.empty() ? vec3d{ 0, 0, 0 } : normal_sums[i];
+                    if (sum.x || sum.y || sum.z)
                         normals.push_back((sum.normalize()));
                     else
                         normals.push_back({ 0, 0, 0 });
                 }
             }
 
-            std::ofstream out(fname);
+            std::ofstream out(fname, binary ? std::ios_base::binary : std::ios_base::out);
             out << "ply\n";
             if (binary)
                 out << "format binary_little_endian 1.0\n";
@@ -200,40 +197,34 @@ namespace rs2
 
             if (binary)
             {
-                out.close();
-                out.open(fname, std::ios_base::app | std::ios_base::binary);
-                for (int i = 0; i < new_verts.size(); ++i)
+                // Serialize the body into one buffer and write it at once, per-field writes dominate otherwise.
+                // We assume little endian architecture on your device
+                const size_t vertex_size = 3 * sizeof(float) + (mesh && use_normals ? 3 * sizeof(float) : 0)
+                    + (use_texcoords ? 3 * sizeof(uint8_t) : 0);
+                const size_t face_size = sizeof(uint8_t) + 3 * sizeof(int);
+                std::vector<char> body(new_verts.size() * vertex_size + (mesh ? faces.size() * face_size : 0));
+                auto dst = body.data();
+                auto append = [&dst](const void* src, size_t size) { memcpy(dst, src, size); dst += size; };
+
+                for (size_t i = 0; i < new_verts.size(); ++i)
                 {
-                    // we assume little endian architecture on your device
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].x)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].y)), sizeof(float));
-                    out.write(reinterpret_cast<const char*>(&(new_verts[i].z)), sizeof(float));
+                    append(&new_verts[i].x, 3 * sizeof(float));
 
                     if (mesh && use_normals)
-                    {
-                        out.write(reinterpret_cast<const char*>(&(normals[i].x)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].y)), sizeof(float));
-                        out.write(reinterpret_cast<const char*>(&(normals[i].z)), sizeof(float));
-                    }
+                        append(&normals[i].x, 3 * sizeof(float));
 
                     if (use_texcoords)
-                    {
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][0])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][1])), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(new_tex[i][2])), sizeof(uint8_t));
-                    }
+                        append(new_tex[i].data(), 3 * sizeof(uint8_t));
                 }
                 if (mesh)
                 {
-                    auto size = faces.size();
-                    for (int i = 0; i < size; ++i) {
-                        static const int three = 3;
-                        out.write(reinterpret_cast<const char*>(&three), sizeof(uint8_t));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][0])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][1])), sizeof(int));
-                        out.write(reinterpret_cast<const char*>(&(faces[i][2])), sizeof(int));
+                    const uint8_t three = 3;
+                    for (auto&& face : faces) {
+                        append(&three, sizeof(uint8_t));
+                        append(face.data(), 3 * sizeof(int));
                     }
                 }
+                out.write(body.data(), body.size());
             }
             else
             {
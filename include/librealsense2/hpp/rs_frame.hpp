@@ -483,6 +483,20 @@ namespace rs2
             return r;
         }
 
+        /** retrieve the stamps of the stages of the frame path the frame went through, see rs2::enable_frame_trace
+        * \return            the stamps, in the order they were recorded
+        */
+        std::vector<rs2_frame_trace_stamp> get_trace() const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_frame_trace_stamp> stamps(16);
+            auto count = rs2_get_frame_trace(frame_ref, stamps.data(), int(stamps.size()), &e);
+            error::handle(e);
+            if (count < int(stamps.size()))
+                stamps.resize(count);
+            return stamps;
+        }
+
         /** retrieve the current value of a single frame_metadata
         * \param[in] frame_metadata  the frame_metadata whose value should be retrieved
         * \return            the value of the frame_metadata
@@ -507,6 +521,25 @@ namespace rs2
             return r != 0;
         }
 
+        /** retrieve all the metadata attributes supported by the frame in one call
+        * \return            the supported frame_metadata attributes and their values
+        */
+        std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> get_all_frame_metadata() const
+        {
+            rs2_metadata_type values[RS2_FRAME_METADATA_COUNT];
+            int supported[RS2_FRAME_METADATA_COUNT];
+            rs2_error* e = nullptr;
+            auto count = rs2_get_all_frame_metadata(frame_ref, values, supported, RS2_FRAME_METADATA_COUNT, &e);
+            error::handle(e);
+
+            std::vector<std::pair<rs2_frame_metadata_value, rs2_metadata_type>> res;
+            res.reserve(count);
+            for (int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+                if (supported[i])
+                    res.emplace_back(rs2_frame_metadata_value(i), values[i]);
+            return res;
+        }
+
         /**
         * retrieve frame number (from frame handle)
         * \return               the frame number of the frame, in milliseconds since the device was started
@@ -519,6 +552,19 @@ namespace rs2
             return r;
         }
 
+        /**
+        * retrieve the data, number, timestamp, profile and (for video frames) dimensions of the frame in one call
+        * \return               the frame properties
+        */
+        rs2_frame_header get_header() const
+        {
+            rs2_frame_header header;
+            rs2_error* e = nullptr;
+            rs2_get_frame_header(frame_ref, &header, &e);
+            error::handle(e);
+            return header;
+        }
+
         /**
         * retrieve data size from frame handle
         * \return               the number of bytes in frame
@@ -774,6 +820,53 @@ namespace rs2
             return (const texture_coordinate*)res;
         }
 
+        /**
+        * Retrieve the points of regions of the depth image as a compact list, skipping the pixels with no depth
+        * \param[in] regions - regions in depth pixels, their bounds included
+        * \param[out] pixels - if not null, receives the depth pixel of each point
+        * \return the points of the regions
+        */
+        std::vector<vertex> get_vertices_in(const std::vector<rs2_pixel_region>& regions, std::vector<rs2_pixel>* pixels = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            auto count = rs2_get_frame_vertices_in_regions(get(), regions.data(), int(regions.size()), nullptr, nullptr, 0, &e);
+            error::handle(e);
+
+            std::vector<vertex> res(count);
+            if (pixels)
+                pixels->resize(count);
+            rs2_get_frame_vertices_in_regions(get(), regions.data(), int(regions.size()), (rs2_vertex*)res.data(),
+                pixels ? pixels->data() : nullptr, count, &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Pack the vertices and the texture coordinates or the colors in a compact format, to stream, store or upload them
+        * \param[in] format - layout of each point
+        * \param[in] valid_only - leave out the points with no depth and store the points densely
+        * \param[out] indices - if not null, receives the index of the pixel of each point
+        * \return the packed points
+        */
+        std::vector<uint8_t> pack(rs2_points_format format, bool valid_only = false, std::vector<int>* indices = nullptr) const
+        {
+            rs2_error* e = nullptr;
+            auto count = rs2_pack_points(get(), format, valid_only, nullptr, 0, nullptr, &e);
+            error::handle(e);
+
+            size_t point_size = 5 * sizeof(uint16_t);
+            if (format == RS2_POINTS_FORMAT_FLOAT32)
+                point_size = 5 * sizeof(float);
+            else if (format == RS2_POINTS_FORMAT_XYZRGB)
+                point_size = 3 * sizeof(float) + sizeof(uint32_t);
+            std::vector<uint8_t> res(count * point_size);
+            if (indices)
+                indices->resize(count);
+            rs2_pack_points(get(), format, valid_only, res.data(), int(res.size()), indices ? indices->data() : nullptr, &e);
+            error::handle(e);
+            return res;
+        }
+
         size_t size() const
         {
             return _size;
@@ -881,9 +974,52 @@ namespace rs2
         */
         rs2_vector get_motion_data() const
         {
+            auto count = get_samples_count();
             auto data = reinterpret_cast<const float*>(get_data());
+            if (count > 1)
+            {
+                data = reinterpret_cast<const float*>(reinterpret_cast<const double*>(get_data()) + count);
+                return rs2_vector{ data[0], data[count], data[2 * count] };
+            }
             return rs2_vector{ data[0], data[1], data[2] };
         }
+        /**
+        * Retrieve the number of samples of the frame, more than one when the sensor batches them
+        * \return number of samples
+        */
+        int get_samples_count() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_get_motion_samples_count(get(), &e);
+            error::handle(e);
+            return res;
+        }
+        /**
+        * Retrieve all the samples of the frame, the first one is the sample of get_motion_data
+        * \param[out] timestamps - if not null, receives the timestamp of each sample
+        * \return the motion data of the samples
+        */
+        std::vector<rs2_vector> get_motion_samples(std::vector<double>* timestamps = nullptr) const
+        {
+            auto count = get_samples_count();
+            if (count == 1)
+            {
+                if (timestamps)
+                    timestamps->assign(1, get_timestamp());
+                return { get_motion_data() };
+            }
+
+            auto t = reinterpret_cast<const double*>(get_data());
+            auto x = reinterpret_cast<const float*>(t + count);
+            auto y = x + count;
+            auto z = y + count;
+            std::vector<rs2_vector> res(count);
+            for (int i = 0; i < count; i++)
+                res[i] = rs2_vector{ x[i], y[i], z[i] };
+            if (timestamps)
+                timestamps->assign(t, t + count);
+            return res;
+        }
     };
 
     class pose_frame : public frame
@@ -1076,6 +1212,19 @@ namespace rs2
             return _size;
         }
 
+        /**
+        * Retrieve the headers of all the frames in the frameset in one call, without extracting each frame
+        * \return the header of each frame, in frameset order. Data pointers are valid while the frameset is referenced
+        */
+        std::vector<rs2_frame_header> get_headers() const
+        {
+            std::vector<rs2_frame_header> headers(size());
+            rs2_error* e = nullptr;
+            rs2_get_frameset_headers(get(), headers.data(), (int)headers.size(), &e);
+            error::handle(e);
+            return headers;
+        }
+
         /**
         * Template function, extract internal frame handles from the frameset and invoke the action function
         * \param[in] action - instance with () operator implemented will be invoke after frame extraction.
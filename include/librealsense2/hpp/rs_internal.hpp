@@ -148,6 +148,18 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Inject several video frames into the sensor in one call
+        *
+        * \param[in] frames  the parameters of each video frame, injected in order
+        */
+        void on_video_frames(const std::vector<rs2_software_video_frame>& frames)
+        {
+            rs2_error* e = nullptr;
+            rs2_software_sensor_on_video_frames(_sensor.get(), frames.data(), (int)frames.size(), &e);
+            error::handle(e);
+        }
+
         /**
         * Inject motion frame into the sensor
         *
@@ -519,6 +531,24 @@ namespace rs2
             return fw_log_pulling_status;
         }
 
+        std::vector<rs2::firmware_log_message> get_firmware_logs(size_t max_count, unsigned int timeout_ms = 0)
+        {
+            std::vector<rs2::firmware_log_message> msgs;
+            std::vector<rs2_firmware_log_message*> ptrs;
+            for (size_t i = 0; i < max_count; ++i)
+            {
+                msgs.push_back(create_message());
+                ptrs.push_back(msgs.back().get_message().get());
+            }
+
+            rs2_error* e = nullptr;
+            int count = rs2_get_fw_logs(_dev.get(), ptrs.data(), int(ptrs.size()), timeout_ms, &e);
+            error::handle(e);
+
+            msgs.erase(msgs.begin() + count, msgs.end());
+            return msgs;
+        }
+
         bool get_flash_log(rs2::firmware_log_message& msg) const
         {
             rs2_error* e = nullptr;
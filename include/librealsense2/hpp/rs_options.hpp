@@ -77,6 +77,20 @@ namespace rs2
             return res;
         }
 
+        /**
+        * read the values of several options in one pass
+        * \param[in] ids   options to read
+        * \return values of the options, NaN for the options that are not supported or failed to read
+        */
+        std::vector<float> get_options(const std::vector<rs2_option>& ids) const
+        {
+            rs2_error* e = nullptr;
+            std::vector<float> values(ids.size());
+            rs2_get_options_bulk(_options, ids.data(), values.data(), static_cast<int>(ids.size()), &e);
+            error::handle(e);
+            return values;
+        }
+
         /**
         * retrieve the available range of values of a supported option
         * \return option  range containing minimum and maximum values, step and default value
@@ -293,6 +293,33 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Limit the time the pipeline waits for the missing streams of a frameset.
+        * Once the oldest frame of a frameset waited budget_ms, the frameset is delivered without the streams that did not arrive.
+        * The budget is enforced when frames arrive.
+        *
+        * \param[in] budget_ms  The latency budget in milliseconds, 0 disables the limit
+        */
+        void set_sync_latency_budget(float budget_ms)
+        {
+            rs2_error* e = nullptr;
+            rs2_config_set_sync_latency_budget(_config.get(), budget_ms, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Call the callback of the pipeline on a dedicated thread, through a mailbox per stream of size frames,
+        * the oldest frame replaced when full. Applies to pipelines started with a callback.
+        *
+        * \param[in] size  The frames per mailbox, 1 delivers the latest frame only, 0 calls the callback on the syncer thread
+        */
+        void set_callback_mailbox_size(int size)
+        {
+            rs2_error* e = nullptr;
+            rs2_config_set_callback_mailbox_size(_config.get(), size, &e);
+            error::handle(e);
+        }
+
         /**
         * Resolve the configuration filters, to find a matching device and streams profiles.
         * The method resolves the user configuration filters for the device and streams, and combines them with the requirements
@@ -559,6 +586,32 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * Add a consumer queue, receiving every frames set that \c wait_for_frames() returns in addition to it.
+        * The frames are shared between the consumers without copies, each queue drops its oldest frames set when it is full
+        * without stalling the pipeline or the other consumers. The queue must be kept alive until it is removed.
+        *
+        * \param[in] queue   The consumer queue
+        */
+        void add_consumer(const frame_queue& queue)
+        {
+            rs2_error* e = nullptr;
+            rs2_pipeline_add_consumer(_pipeline.get(), std::shared_ptr<rs2_frame_queue>(queue).get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Remove a consumer queue added by \c add_consumer().
+        *
+        * \param[in] queue   The consumer queue
+        */
+        void remove_consumer(const frame_queue& queue)
+        {
+            rs2_error* e = nullptr;
+            rs2_pipeline_remove_consumer(_pipeline.get(), std::shared_ptr<rs2_frame_queue>(queue).get(), &e);
+            error::handle(e);
+        }
+
         /**
         * Return the active device and streams profiles, used by the pipeline.
         * The pipeline streams profiles are selected during \c start(). The method returns a valid result only when the pipeline is active -
@@ -579,6 +632,27 @@ namespace rs2
             return pipeline_profile(p);
         }
 
+        /**
+        * Retrieve the frame counters of the streams of the sensors used by the pipeline.
+        * The method is valid only between calls to \c start() and \c stop().
+        *
+        * \return counters of each stream that received or delivered frames
+        */
+        std::vector<rs2_stream_metrics> get_metrics() const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_stream_metrics> results(rs2_pipeline_get_metrics(_pipeline.get(), nullptr, 0, &e));
+            error::handle(e);
+            if (results.empty())
+                return results;
+
+            auto count = rs2_pipeline_get_metrics(_pipeline.get(), results.data(), int(results.size()), &e);
+            error::handle(e);
+            if (size_t(count) < results.size())
+                results.resize(count);
+            return results;
+        }
+
         operator std::shared_ptr<rs2_pipeline>() const
         {
             return _pipeline;
@@ -589,5 +663,83 @@ namespace rs2
         std::shared_ptr<rs2_pipeline> _pipeline;
         friend class config;
     };
+
+    /**
+    * Resolve the configs of several pipelines together, for devices that may share USB links.
+    * While the estimated payload of the streams on a link exceeds what the link carries, the most loaded device on it is given
+    * the next lower frame rate its requests leave unspecified, and then the next smaller resolution. The configs are updated to
+    * request the planned device and streams, so the pipelines started with them stream the returned profiles.
+    *
+    * \param[in] configs  The configs to resolve, selecting different devices
+    * \param[in] pipes    The pipeline of each config
+    * \param[out] fits    If non-null, receives false when a link remains oversubscribed with all the unspecified fields lowered
+    * \return             The resolved profile of each config
+    */
+    inline std::vector<pipeline_profile> resolve_bandwidth(const std::vector<config>& configs, const std::vector<pipeline>& pipes, bool* fits = nullptr)
+    {
+        if (configs.size() != pipes.size())
+            throw error("resolve_bandwidth needs a pipeline per config");
+
+        std::vector<rs2_config*> cfgs;
+        std::vector<rs2_pipeline*> pipelines;
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            cfgs.push_back(configs[i].get().get());
+            pipelines.push_back(std::shared_ptr<rs2_pipeline>(pipes[i]).get());
+        }
+
+        rs2_error* e = nullptr;
+        std::vector<rs2_pipeline_profile*> profiles(configs.size());
+        int res = rs2_config_resolve_bandwidth(cfgs.data(), pipelines.data(), int(cfgs.size()), profiles.data(), &e);
+        error::handle(e);
+        if (fits)
+            *fits = res != 0;
+
+        std::vector<pipeline_profile> results;
+        for (auto p : profiles)
+            results.emplace_back(std::shared_ptr<rs2_pipeline_profile>(p, rs2_delete_pipeline_profile));
+        return results;
+    }
+
+    /**
+    * Start several pipelines together, as the cameras of a rig, on up to max_parallel threads.
+    * The rig comes up in about the time of its slowest device instead of the sum of their times. The configs should select
+    * different devices with \c enable_device(). A failing start does not stop the others: the pipelines that started remain
+    * started, and the error of the first failing pipeline is thrown after the reports are filled.
+    *
+    * \param[in] pipes        The pipelines to start
+    * \param[in] configs      The config of each pipeline
+    * \param[in] max_parallel The most pipelines started at the same time, 0 to start them all at once
+    * \param[out] reports     If non-null, receives the outcome and start time of each pipeline
+    * \return                 The active profile of each pipeline
+    */
+    inline std::vector<pipeline_profile> start_pipelines(const std::vector<pipeline>& pipes, const std::vector<config>& configs,
+        int max_parallel = 0, std::vector<rs2_pipeline_start_report>* reports = nullptr)
+    {
+        if (configs.size() != pipes.size())
+            throw error("start_pipelines needs a config per pipeline");
+
+        std::vector<rs2_config*> cfgs;
+        std::vector<rs2_pipeline*> pipelines;
+        for (size_t i = 0; i < pipes.size(); ++i)
+        {
+            cfgs.push_back(configs[i].get().get());
+            pipelines.push_back(std::shared_ptr<rs2_pipeline>(pipes[i]).get());
+        }
+
+        rs2_error* e = nullptr;
+        std::vector<rs2_pipeline_profile*> profiles(pipes.size());
+        std::vector<rs2_pipeline_start_report> outcomes(pipes.size());
+        rs2_pipelines_start(pipelines.data(), cfgs.data(), int(pipes.size()), max_parallel, profiles.data(), outcomes.data(), &e);
+
+        // Own the profiles of the started pipelines before a failure is thrown
+        std::vector<pipeline_profile> results;
+        for (auto p : profiles)
+            results.push_back(p ? pipeline_profile(std::shared_ptr<rs2_pipeline_profile>(p, rs2_delete_pipeline_profile)) : pipeline_profile());
+        if (reports)
+            *reports = outcomes;
+        error::handle(e);
+        return results;
+    }
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
@@ -8,6 +8,8 @@
 #include "rs_frame.hpp"
 #include "rs_options.hpp"
 
+#include <algorithm>
+
 namespace rs2
 {
     /**
@@ -202,6 +204,35 @@ namespace rs2
             if (res) *output = f;
             return res > 0;
         }
+
+        /**
+        * dequeue the frames available in the queue, up to max_frames of them, without waiting
+        * \param[out] output - array of at least max_frames frames, receives the frames in the order they were enqueued
+        * \return number of frames stored to output
+        */
+        template<typename T>
+        typename std::enable_if<std::is_base_of<rs2::frame, T>::value, size_t>::type poll_for_frames(T* output, size_t max_frames) const
+        {
+            return dequeue_frames(output, max_frames, [this](rs2_frame** frame_refs, int count, bool, rs2_error** e)
+            {
+                return rs2_poll_for_frames(_queue.get(), frame_refs, count, e);
+            });
+        }
+
+        /**
+        * wait until a frame becomes available in the queue, then dequeue it together with the frames following it
+        * \param[out] output - array of at least max_frames frames, receives the frames in the order they were enqueued
+        * \return number of frames stored to output, 0 if no frame arrived in time
+        */
+        template<typename T>
+        typename std::enable_if<std::is_base_of<rs2::frame, T>::value, size_t>::type wait_for_frames(T* output, size_t max_frames, unsigned int timeout_ms = 5000) const
+        {
+            return dequeue_frames(output, max_frames, [this, timeout_ms](rs2_frame** frame_refs, int count, bool first, rs2_error** e)
+            {
+                return first ? rs2_wait_for_frames(_queue.get(), timeout_ms, frame_refs, count, e) : rs2_poll_for_frames(_queue.get(), frame_refs, count, e);
+            });
+        }
+
         /**
         * Does the same thing as enqueue function.
         */
@@ -215,18 +246,70 @@ namespace rs2
         */
         size_t capacity() const { return _capacity; }
 
+        /**
+        * Retrieve the frames waiting in the queue and the frames it dropped
+        * \return occupancy of the queue
+        */
+        rs2_frame_queue_metrics get_metrics() const
+        {
+            rs2_error* e = nullptr;
+            rs2_frame_queue_metrics metrics;
+            rs2_get_frame_queue_metrics(_queue.get(), &metrics, &e);
+            error::handle(e);
+            return metrics;
+        }
+
         /**
         * Return whether or not the queue calls keep on enqueued frames
         * \return keeping frames
         */
         bool keep_frames() const { return _keep; }
 
+        operator std::shared_ptr<rs2_frame_queue>() const { return _queue; }
+
     private:
+        // Dequeues in chunks of frame handles on the stack, only the first chunk waits
+        template<typename T, typename F>
+        static size_t dequeue_frames(T* output, size_t max_frames, F dequeue)
+        {
+            const size_t chunk_size = 64;
+            rs2_frame* frame_refs[chunk_size];
+            size_t count = 0;
+            while (count < max_frames)
+            {
+                auto requested = std::min(chunk_size, max_frames - count);
+                rs2_error* e = nullptr;
+                auto dequeued = static_cast<size_t>(dequeue(frame_refs, static_cast<int>(requested), count == 0, &e));
+                error::handle(e);
+                for (size_t i = 0; i < dequeued; i++)
+                {
+                    frame f{ frame_refs[i] };
+                    output[count++] = f;
+                }
+                if (dequeued < requested)
+                    break;
+            }
+            return count;
+        }
+
         std::shared_ptr<rs2_frame_queue> _queue;
         size_t _capacity;
         bool _keep;
     };
 
+    /**
+    * Configure the shared executor running the processing blocks set to asynchronous invocation
+    *
+    * \param[in] workers      number of worker threads, 0 selects the number of hardware threads
+    * \param[in] cpus         CPU indices the workers are pinned to, round-robin. Empty for no affinity
+    */
+    inline void configure_processing_executor(int workers, const std::vector<int>& cpus = {})
+    {
+        rs2_error* e = nullptr;
+        rs2_configure_processing_executor(workers, cpus.data(), static_cast<int>(cpus.size()), &e);
+        error::handle(e);
+    }
+
     /**
     * Define the processing block flow, inherit this class to generate your own processing_block. Please refer to the viewer class in examples.hpp for a detailed usage example.
     */
@@ -299,6 +382,32 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Run the block on the shared processing executor instead of inline on the invoking thread
+        * Frames given to the block are still processed one at a time, in the order they were invoked
+        *
+        * \param[in] async      true to invoke the block asynchronously
+        */
+        void set_async(bool async) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_async(get(), async ? 1 : 0, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Retrieve the frames processed by the block and the time it spent on them
+        * \return the counters of the block
+        */
+        rs2_processing_block_metrics get_metrics() const
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_block_metrics metrics;
+            rs2_get_processing_block_metrics(get(), &metrics, &e);
+            error::handle(e);
+            return metrics;
+        }
+
         operator rs2_options*() const { return (rs2_options*)get(); }
         rs2_processing_block* get() const { return _block.get(); }
 
@@ -351,7 +460,7 @@ namespace rs2
         */
         rs2::frame process(rs2::frame frame) const override
         {
-            invoke(frame);
+            invoke(std::move(frame));
             rs2::frame f;
             if (!_queue.poll_for_frame(&f))
                 throw std::runtime_error("Error occured during execution of the processing block! See the log for more info");
@@ -457,6 +566,19 @@ namespace rs2
             process(mapped);
         }
 
+        /**
+        * Compute the points of regions of the depth image only, for example the boxes of detected objects.
+        * The other points are zero, points::get_vertices_in returns the points of the regions as a compact list
+        *
+        * \param[in] regions - regions in depth pixels, their bounds included. An empty list processes the whole image again
+        */
+        void set_regions(const std::vector<rs2_pixel_region>& regions)
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_regions(get(), regions.data(), int(regions.size()), &e);
+            error::handle(e);
+        }
+
     protected:
         pointcloud(std::shared_ptr<rs2_processing_block> block) : filter(block, 1) {}
 
@@ -549,6 +671,149 @@ namespace rs2
         }
     };
 
+    class voxel_grid_filter : public filter
+    {
+    public:
+        /**
+        * Creates voxel grid filter
+        * Downsamples depth frames or points to a point per occupied voxel, the centroid of its points.
+        * The texture coordinates of the output points are the average of the voxel's, zero when the input is depth.
+        * The downsampling replaces computing the full pointcloud to discard most of it
+        *
+        * \param[in] voxel_size      Edge of the voxels in meters
+        */
+        voxel_grid_filter(float voxel_size = 0.01f)
+            : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_VOXEL_SIZE, voxel_size);
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_voxel_grid_filter(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class depth_to_scan : public filter
+    {
+    public:
+        /**
+        * Creates depth to scan filter
+        * Converts a band of depth rows, centered on the principal point, to a 2D scan: a single row of RS2_FORMAT_DISTANCE
+        * holding the nearest range in the horizontal plane per angle bin, in meters, zero for the bins with no depth in range.
+        * Only the pixels of the band are read, the depth is not deprojected
+        *
+        * \param[in] bins      Number of angle bins spanning the horizontal field of view of the depth, see get_angles
+        * \param[in] rows      Number of depth rows the scan is taken from
+        */
+        depth_to_scan(int bins = 640, int rows = 10)
+            : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_SCAN_BINS, float(bins));
+            set_option(RS2_OPTION_SCAN_ROWS, float(rows));
+        }
+
+        /**
+        * Angles of the bins of the scans of the depth of the given intrinsics, atan2(x, z) of the camera coordinates in radians
+        *
+        * \param[in] depth_intrinsics  Intrinsics of the depth stream
+        * \param[in] bins              Number of angle bins of the scan
+        * \param[out] angle_min        Angle of the first bin
+        * \param[out] angle_increment  Angle between two bins
+        */
+        static void get_angles(const rs2_intrinsics& depth_intrinsics, int bins, float& angle_min, float& angle_increment)
+        {
+            rs2_error* e = nullptr;
+            rs2_get_scan_angles(&depth_intrinsics, bins, &angle_min, &angle_increment, &e);
+            error::handle(e);
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_to_scan(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class median_filter : public filter
+    {
+    public:
+        /**
+        * Creates median filter
+        * Replaces every depth pixel by the median of the valid depth of its neighborhood, the pixels of no depth are
+        * ignored and stay holes
+        *
+        * \param[in] radius      Radius of the neighborhood, 1 for 3x3 and 2 for 5x5
+        */
+        median_filter(int radius = 1)
+            : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_FILTER_MAGNITUDE, float(radius));
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_median_filter(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class tensor_converter : public filter
+    {
+    public:
+        /**
+        * Creates tensor converter
+        * Converts color to the input tensor of a network, resized bilinearly, normalized to (value - mean) * scale and
+        * laid out as planar channels, NCHW with N = 1. The output frame is width wide and 3 * height high, the R, G and B
+        * planes one below the other, B, G and R when RS2_OPTION_TENSOR_BGR is set. Its data is the tensor: floats, or
+        * uint8 when RS2_OPTION_TENSOR_FLOAT is off
+        *
+        * \param[in] width      Width of the tensor
+        * \param[in] height     Height of the tensor
+        * \param[in] mean       Mean subtracted from the color values
+        * \param[in] scale      Factor the color values less the mean are multiplied by
+        */
+        tensor_converter(int width = 300, int height = 300, float mean = 0.f, float scale = 1.f)
+            : filter(init(), 1)
+        {
+            set_option(RS2_OPTION_TENSOR_WIDTH, float(width));
+            set_option(RS2_OPTION_TENSOR_HEIGHT, float(height));
+            set_option(RS2_OPTION_TENSOR_MEAN, mean);
+            set_option(RS2_OPTION_TENSOR_SCALE, scale);
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_tensor_converter(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
     class units_transform : public filter
     {
     public:
@@ -581,6 +846,9 @@ namespace rs2
         */
         asynchronous_syncer() : processing_block(init()) {}
 
+    protected:
+        asynchronous_syncer(std::shared_ptr<rs2_processing_block> block) : processing_block(block) {}
+
     private:
         std::shared_ptr<rs2_processing_block> init()
         {
@@ -653,11 +921,62 @@ namespace rs2
         {
             _sync.invoke(std::move(f));
         }
+
+        /**
+        * Limit the time a frame waits for the missing streams of its frameset
+        * Once the oldest frame of a frameset waited budget_ms, the frameset is delivered without the streams that did not arrive.
+        * The budget is enforced when frames arrive.
+        * \param[in] budget_ms     The latency budget in milliseconds, 0 disables the limit
+        */
+        void set_latency_budget(float budget_ms)
+        {
+            _sync.set_option(RS2_OPTION_SYNC_LATENCY_BUDGET, budget_ms);
+        }
+
+    protected:
+        syncer(asynchronous_syncer sync, int queue_size)
+            : _sync(std::move(sync)), _results(queue_size)
+        {
+            _sync.start(_results);
+        }
+
     private:
         asynchronous_syncer _sync;
         frame_queue _results;
     };
 
+    class asynchronous_multi_device_syncer : public asynchronous_syncer
+    {
+    public:
+        /**
+        * Real asynchronous syncer within multi_device_syncer class
+        */
+        asynchronous_multi_device_syncer(float tolerance_ms = 0.f) : asynchronous_syncer(init(tolerance_ms)) {}
+
+    private:
+        std::shared_ptr<rs2_processing_block> init(float tolerance_ms)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_multi_device_sync_processing_block(tolerance_ms, &e),
+                rs2_delete_processing_block);
+
+            error::handle(e);
+            return block;
+        }
+    };
+
+    class multi_device_syncer : public syncer
+    {
+    public:
+        /**
+        * Sync instance to match frames from the sensors of several devices on the host clock
+        * \param[in] tolerance_ms  Max difference between matched frames of different devices, 0 uses half of the frame period
+        */
+        multi_device_syncer(float tolerance_ms = 0.f, int queue_size = 1)
+            : syncer(asynchronous_multi_device_syncer(tolerance_ms), queue_size) {}
+    };
+
     /**
     Auxiliary processing block that performs image alignment using depth data and camera calibration
     */
@@ -675,6 +994,15 @@ namespace rs2
         */
         align(rs2_stream align_to) : filter(init(align_to), 1) {}
 
+        /**
+        Create align filter aligning the depth image to several other streams in one pass, for example to both color and infrared.
+        Each depth pixel is deprojected once for all the targets. The output frameset holds an aligned depth frame per target
+        found in the input frameset, in the order of the targets.
+
+        * \param[in] align_to      The stream types to which the depth should be aligned, none of them depth.
+        */
+        align(const std::vector<rs2_stream>& align_to) : filter(init(align_to), 1) {}
+
         using filter::process;
 
         /**
@@ -688,6 +1016,19 @@ namespace rs2
             return filter::process(frames);
         }
 
+        /**
+        * Align regions of the depth image only, for example the boxes of detected objects.
+        * The aligned frames hold no data outside the regions
+        *
+        * \param[in] regions - regions in depth pixels, their bounds included. An empty list aligns the whole image again
+        */
+        void set_regions(const std::vector<rs2_pixel_region>& regions)
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_regions(get(), regions.data(), int(regions.size()), &e);
+            error::handle(e);
+        }
+
     protected:
         align(std::shared_ptr<rs2_processing_block> block) : filter(block, 1) {}
 
@@ -703,6 +1044,68 @@ namespace rs2
 
             return block;
         }
+
+        std::shared_ptr<rs2_processing_block> init(const std::vector<rs2_stream>& align_to)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_align_to_streams(align_to.data(), int(align_to.size()), &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
+    class align_pointcloud : public filter
+    {
+    public:
+        /**
+        Create a filter aligning the depth to another stream and computing the pointcloud textured by it, from a single
+        deprojection of each depth pixel. It replaces running align and pointcloud on the same frameset.
+        The output frameset holds the points and the depth aligned to the other stream, in place of the depth.
+
+        * \param[in] align_to      The stream type to which the depth is aligned and which textures the points, not depth.
+        */
+        align_pointcloud(rs2_stream align_to) : filter(init(align_to), 1) {}
+
+        using filter::process;
+
+        /**
+        * Align the depth and compute the points of the given frames
+        *
+        * \param[in] frames      A set of frames holding a depth frame and a frame of the target stream
+        * \return The input frames with the points and the aligned depth
+        */
+        frameset process(frameset frames)
+        {
+            return filter::process(frames);
+        }
+
+        /**
+        * Compute the points and align the pixels of regions of the depth image only.
+        * The points and the aligned depth are zero outside the regions
+        *
+        * \param[in] regions - regions in depth pixels, their bounds included. An empty list processes the whole image again
+        */
+        void set_regions(const std::vector<rs2_pixel_region>& regions)
+        {
+            rs2_error* e = nullptr;
+            rs2_set_processing_block_regions(get(), regions.data(), int(regions.size()), &e);
+            error::handle(e);
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_block> init(rs2_stream align_to)
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_align_pointcloud(align_to, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
     };
 
     class colorizer : public filter
@@ -1077,6 +1480,44 @@ namespace rs2
         }
     };
 
+    class depth_filter_chain : public filter
+    {
+    public:
+        /**
+        * Create a block running the recommended depth filters in one pass: decimation, spatial, temporal and hole filling
+        * in the disparity domain. Its output is the output of the sequence of these filters
+        */
+        depth_filter_chain() : filter(init(), 1) {}
+
+        /**
+        * Retrieve a stage of the chain, to set its options
+        * \param[in] stage - RS2_EXTENSION_DECIMATION_FILTER, RS2_EXTENSION_SPATIAL_FILTER, RS2_EXTENSION_TEMPORAL_FILTER or RS2_EXTENSION_HOLE_FILLING_FILTER
+        */
+        processing_block get_stage(rs2_extension stage) const
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_get_depth_filter_chain_stage(_block.get(), stage, &e),
+                rs2_delete_processing_block);
+            error::handle(e);
+            return processing_block(block);
+        }
+
+    private:
+        friend class context;
+
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_depth_filter_chain_block(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
+
     class rates_printer : public filter
     {
     public:
@@ -1179,5 +1620,29 @@ namespace rs2
             return block;
         }
     };
+
+    class sequence_id_demux : public filter
+    {
+    public:
+        /**
+        * Create sequence_id_demux processing block
+        * Delivers the frames of a sequence on a virtual stream per sequence id, or per emitter state (1 for on, 0 for off)
+        * when the frames carry no sequence, the stream index of the source plus 10 times the key. The frames of a syncer
+        * fed by the block are matched per virtual stream. The output frames refer to the data of the input frames
+        */
+        sequence_id_demux() : filter(init(), 1) {}
+
+    private:
+        std::shared_ptr<rs2_processing_block> init()
+        {
+            rs2_error* e = nullptr;
+            auto block = std::shared_ptr<rs2_processing_block>(
+                rs2_create_sequence_id_demux(&e),
+                rs2_delete_processing_block);
+            error::handle(e);
+
+            return block;
+        }
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
@@ -6,6 +6,7 @@
 
 #include "rs_types.hpp"
 #include "rs_device.hpp"
+#include "rs_processing.hpp"
 
 namespace rs2
 {
@@ -126,6 +127,44 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Select how a non real time playback publishes its frames.
+        * With ordered delivery, the frames of all the streams are published one at a time in the order they were recorded,
+        * from the thread reading the file, so offline processing gets the same sequence of frames on every run.
+        * By default each stream is published from a thread of its own. Has no effect in real time mode
+        * \param[in] ordered  True to publish the frames in recording order
+        */
+        void set_ordered_delivery(bool ordered) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_ordered_delivery(_dev.get(), (ordered ? 1 : 0), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Play this device together with another playback device, on a single read thread and a single clock.
+        * The files are played in the order of their recorded system time, so the recordings of several cameras taken at once
+        * stay in step. The devices are joined while stopped
+        * \param[in] other  The playback device to play together with
+        */
+        void join(const playback& other) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_join(_dev.get(), other._dev.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Keep the last frames read in memory, so stepping back and scrubbing around the current time do not read the file again
+        * \param[in] frames  Number of frames to keep, of all the streams together, 0 disables the cache
+        */
+        void set_frame_cache_size(int frames) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_frame_cache_size(_dev.get(), frames, &e);
+            error::handle(e);
+        }
+
         /**
         * Set the playing speed
         * \param[in] speed  Indicates a multiplication of the speed to play (e.g: 1 = normal, 0.5 twice as slow)
@@ -266,6 +305,122 @@ namespace rs2
             error::handle(e);
             return filename;
         }
+
+        /**
+        * Select what the recorder does with a frame that arrives while its write cache is full
+        * \param[in] blocking  True to wait up to a second for the file writer, false to drop the frame
+        */
+        void set_blocking_write(bool blocking)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_blocking_write(_dev.get(), blocking, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Select the compression of the images recorded for a stream, the playback decompresses them transparently
+        * \param[in] stream       The stream type whose images are compressed
+        * \param[in] compression  RVL or LZ4 for depth, JPEG or LZ4 for color, NONE to record raw images
+        */
+        void set_frame_compression(rs2_stream stream, rs2_frame_compression compression)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_frame_compression(_dev.get(), stream, compression, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Write every stream to a file of its own, by a thread of its own. Playing the recording file plays all of them.
+        * The frames recorded after a change go to the newly selected files
+        * \param[in] file_per_stream  True for a file per stream, false for a single file
+        */
+        void set_file_per_stream(bool file_per_stream)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_file_per_stream(_dev.get(), file_per_stream, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Gets the number of frames the recorder wrote to the file
+        */
+        unsigned long long written_frames() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_record_device_get_written_frames(_dev.get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Gets the number of frames the recorder dropped because its write cache was full
+        */
+        unsigned long long dropped_frames() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_record_device_get_dropped_frames(_dev.get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Record only every Nth frame of a stream, the other frames are still raised to the user
+        * \param[in] stream     The stream type to decimate
+        * \param[in] every_nth  Record one frame out of every_nth frames, 1 records every frame
+        */
+        void set_stream_decimation(rs2_stream stream, int every_nth)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_stream_decimation(_dev.get(), stream, every_nth, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Record the output of a processing block instead of the frames of a stream, the block is dedicated to the recorder from then on.
+        * Must be set before the stream is opened
+        * \param[in] stream  The stream type whose frames are processed
+        * \param[in] block   The processing block, for example a decimation filter
+        */
+        void set_stream_processing(rs2_stream stream, const processing_block& block)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_stream_processing(_dev.get(), stream, block.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Record a stream only around triggers, holding its last pre_trigger_seconds of frames in memory until trigger() is called
+        * \param[in] stream                The stream type recorded on trigger
+        * \param[in] pre_trigger_seconds   How long before the trigger frames are kept
+        * \param[in] post_trigger_seconds  How long after the trigger frames are recorded
+        */
+        void set_stream_trigger(rs2_stream stream, float pre_trigger_seconds, float post_trigger_seconds)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_set_stream_trigger(_dev.get(), stream, pre_trigger_seconds, post_trigger_seconds, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Write the frames held for the triggered streams, and record their following post trigger seconds
+        */
+        void trigger()
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_trigger(_dev.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Record every frame of a stream again, discarding the frames held for a trigger
+        * \param[in] stream  The stream type
+        */
+        void clear_stream_policy(rs2_stream stream)
+        {
+            rs2_error* e = nullptr;
+            rs2_record_device_clear_stream_policy(_dev.get(), stream, &e);
+            error::handle(e);
+        }
     protected:
         explicit recorder(std::shared_ptr<rs2_device> dev) : device(dev)
         {
@@ -98,6 +98,28 @@ namespace rs2
         void release() override { delete this; }
     };
 
+    template<class A, class D>
+    class frame_allocator : public rs2_frame_allocator
+    {
+        A allocate_function;
+        D deallocate_function;
+    public:
+        explicit frame_allocator(A allocate, D deallocate)
+            : allocate_function(allocate), deallocate_function(deallocate) {}
+
+        void* allocate(size_t size) override
+        {
+            return allocate_function(size);
+        }
+
+        void deallocate(void* ptr, size_t size) override
+        {
+            deallocate_function(ptr, size);
+        }
+
+        void release() override { delete this; }
+    };
+
 
     class sensor : public options
     {
@@ -212,6 +234,53 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * provide the memory used for the frame buffers of this sensor, e.g. pinned or huge-page memory
+        * the allocator is invoked from internal threads and is kept alive until every buffer it provided is released
+        * \param[in] allocate     callable of the form void*(size_t size), returning null on failure
+        * \param[in] deallocate   callable of the form void(void* ptr, size_t size)
+        */
+        template<class A, class D>
+        void set_frame_allocator(A allocate, D deallocate) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_allocator_cpp(_sensor.get(),
+                new frame_allocator<A, D>(std::move(allocate), std::move(deallocate)), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Retrieves the frame counters of the streams of the sensor
+        * \return   counters of each stream that received or delivered frames
+        */
+        std::vector<rs2_stream_metrics> get_metrics() const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_stream_metrics> results(rs2_get_sensor_metrics(_sensor.get(), nullptr, 0, nullptr, &e));
+            error::handle(e);
+            if (results.empty())
+                return results;
+
+            auto count = rs2_get_sensor_metrics(_sensor.get(), results.data(), int(results.size()), nullptr, &e);
+            error::handle(e);
+            if (size_t(count) < results.size())
+                results.resize(count);
+            return results;
+        }
+
+        /**
+        * Retrieves the usage of the frame buffers of the sensor
+        * \return   counters of the frame buffers
+        */
+        rs2_frame_pool_metrics get_frame_pool_metrics() const
+        {
+            rs2_error* e = nullptr;
+            rs2_frame_pool_metrics pool;
+            rs2_get_sensor_metrics(_sensor.get(), nullptr, 0, &pool, &e);
+            error::handle(e);
+            return pool;
+        }
+
         /**
         * Retrieves the list of stream profiles supported by the sensor.
         * \return   list of stream profiles that given sensor can provide
@@ -615,6 +684,20 @@ namespace rs2
             return !!res;
         }
 
+        /**
+         * Retrieves the latest pose received from the device, without a frame queue or callback.
+         * \param[out] pose      the latest pose.
+         * \param[out] timestamp its timestamp, in milliseconds of the global time domain.
+         * \return true if a pose was received since the sensor was started.
+         */
+        bool get_latest_pose(rs2_pose& pose, double& timestamp) const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_get_latest_pose(_sensor.get(), &pose, &timestamp, &e);
+            error::handle(e);
+            return !!res;
+        }
+
         operator bool() const { return _sensor.get() != nullptr; }
         explicit pose_sensor(std::shared_ptr<rs2_sensor> dev) : pose_sensor(sensor(dev)) {}
     };
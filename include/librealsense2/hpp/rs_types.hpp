@@ -29,6 +29,14 @@ struct rs2_frame_callback
     virtual                                 ~rs2_frame_callback() {}
 };
 
+struct rs2_frame_allocator
+{
+    virtual void*                           allocate(size_t size) = 0;
+    virtual void                            deallocate(void* ptr, size_t size) = 0;
+    virtual void                            release() = 0;
+    virtual                                 ~rs2_frame_allocator() {}
+};
+
 struct rs2_frame_processor_callback
 {
     virtual void                            on_frame(rs2_frame * f, rs2_source * source) = 0;
@@ -87,6 +95,13 @@ struct rs2_update_progress_callback
     virtual                                 ~rs2_update_progress_callback() {}
 };
 
+struct rs2_calibration_done_callback
+{
+    virtual void                            on_calibration_done(const unsigned char* calibration, int size, float health, const char* error_message) = 0;
+    virtual void                            release() = 0;
+    virtual                                 ~rs2_calibration_done_callback() {}
+};
+
 namespace rs2
 {
     class error : public std::runtime_error
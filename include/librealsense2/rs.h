@@ -109,6 +109,13 @@ float rs2_depth_frame_get_distance(const rs2_frame* frame_ref, int x, int y, rs2
 */
 rs2_time_t rs2_get_time( rs2_error** error);
 
+/**
+* retrieve the memory held by the library in the whole process, to tell it apart from the memory of the application
+* \param[out] usage  receives the bytes held per category
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_memory_usage(rs2_memory_usage* usage, rs2_error** error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,47 @@ namespace rs2
         error::handle(e);
     }
 
+    // Stamps the frames with the times they reach the stages of the frame path, see frame::get_trace
+    inline void enable_frame_trace(bool enable)
+    {
+        rs2_error* e = nullptr;
+        rs2_enable_frame_trace(enable, &e);
+        error::handle(e);
+    }
+
+    // Enables the frame trace and writes the stamps of the released frames to a Chrome trace event file
+    inline void start_frame_trace_file(const char* file_path)
+    {
+        rs2_error* e = nullptr;
+        rs2_start_frame_trace_file(file_path, &e);
+        error::handle(e);
+    }
+
+    inline void stop_frame_trace_file()
+    {
+        rs2_error* e = nullptr;
+        rs2_stop_frame_trace_file(&e);
+        error::handle(e);
+    }
+
+    // Bytes held by the library in the whole process, see device::get_memory_usage for a single device
+    inline rs2_memory_usage get_memory_usage()
+    {
+        rs2_error* e = nullptr;
+        rs2_memory_usage usage;
+        rs2_get_memory_usage(&usage, &e);
+        error::handle(e);
+        return usage;
+    }
+
+    // Limits the frame buffers of the whole process, 0 bytes for no limit, see context::set_memory_budget for the devices of a context
+    inline void set_memory_budget(long long bytes, rs2_memory_budget_policy policy = RS2_MEMORY_BUDGET_POLICY_DROP)
+    {
+        rs2_error* e = nullptr;
+        rs2_set_memory_budget(nullptr, bytes, policy, &e);
+        error::handle(e);
+    }
+
     /*
         Interface to the log message data we expose.
     */
@@ -146,9 +187,12 @@ inline std::ostream & operator << (std::ostream & o, rs2_notification_category n
 inline std::ostream & operator << (std::ostream & o, rs2_sr300_visual_preset preset) { return o << rs2_sr300_visual_preset_to_string(preset); }
 inline std::ostream & operator << (std::ostream & o, rs2_exception_type exception_type) { return o << rs2_exception_type_to_string(exception_type); }
 inline std::ostream & operator << (std::ostream & o, rs2_playback_status status) { return o << rs2_playback_status_to_string(status); }
+inline std::ostream & operator << (std::ostream & o, rs2_frame_compression compression) { return o << rs2_frame_compression_to_string(compression); }
 inline std::ostream & operator << (std::ostream & o, rs2_l500_visual_preset preset) {return o << rs2_l500_visual_preset_to_string(preset);}
 inline std::ostream & operator << (std::ostream & o, rs2_sensor_mode mode) { return o << rs2_sensor_mode_to_string(mode); }
 inline std::ostream & operator << (std::ostream & o, rs2_calibration_type mode) { return o << rs2_calibration_type_to_string(mode); }
 inline std::ostream & operator << (std::ostream & o, rs2_calibration_status mode) { return o << rs2_calibration_status_to_string(mode); }
+inline std::ostream & operator << (std::ostream & o, rs2_memory_category category) { return o << rs2_memory_category_to_string(category); }
+inline std::ostream & operator << (std::ostream & o, rs2_thread_role role) { return o << rs2_thread_role_to_string(role); }
 
 #endif // LIBREALSENSE_RS2_HPP
@@ -228,4 +228,32 @@ static void rs2_project_color_pixel_to_depth_pixel(float to_pixel[2],
         }
     }
 }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Batch versions of the functions above, exported by the library. Pixels are arrays of (x, y) pairs and points arrays of (x, y, z) triplets.
+   The common distortion models are computed with SIMD instructions, several elements at a time */
+
+/* Same as rs2_deproject_pixel_to_point on count pixels and their depths */
+void rs2_deproject_pixels_to_points(float* points, const struct rs2_intrinsics* intrin, const float* pixels, const float* depths, int count, rs2_error** error);
+
+/* Same as rs2_project_point_to_pixel on count points */
+void rs2_project_points_to_pixels(float* pixels, const struct rs2_intrinsics* intrin, const float* points, int count, rs2_error** error);
+
+/* Same as rs2_project_color_pixel_to_depth_pixel on count color pixels. The depth pixels along the search lines are deprojected
+   from a table of the depth intrinsics computed once per resolution, a pixel with no valid depth along its line is mapped to (-1, -1) */
+void rs2_project_color_pixels_to_depth_pixels(float* to_pixels,
+    const uint16_t* data, float depth_scale,
+    float depth_min, float depth_max,
+    const struct rs2_intrinsics* depth_intrin,
+    const struct rs2_intrinsics* color_intrin,
+    const struct rs2_extrinsics* color_to_depth,
+    const struct rs2_extrinsics* depth_to_color,
+    const float* from_pixels, int count, rs2_error** error);
+
+#ifdef __cplusplus
+}
+#endif
 #endif
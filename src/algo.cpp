@@ -26,6 +26,16 @@ float auto_exposure_state::get_auto_exposure_step() const
     return step;
 }
 
+unsigned auto_exposure_state::get_auto_exposure_sample_rate() const
+{
+    return sample_rate;
+}
+
+unsigned auto_exposure_state::get_auto_exposure_skip_frames() const
+{
+    return skip_frames;
+}
+
 void auto_exposure_state::set_enable_auto_exposure(bool value)
 {
     is_auto_exposure = value;
@@ -46,11 +56,21 @@ void auto_exposure_state::set_auto_exposure_step(float value)
     step = value;
 }
 
+void auto_exposure_state::set_auto_exposure_sample_rate(unsigned value)
+{
+    sample_rate = std::max(value, 1u);
+}
+
+void auto_exposure_state::set_auto_exposure_skip_frames(unsigned value)
+{
+    skip_frames = value;
+}
+
 auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& exposure_option, const auto_exposure_state& auto_exposure_state)
     : _gain_option(gain_option), _exposure_option(exposure_option),
       _auto_exposure_algo(auto_exposure_state),
       _keep_alive(true), _data_queue(queue_size), _frames_counter(0),
-      _skip_frames(auto_exposure_state.skip_frames)
+      _skip_frames(auto_exposure_state.get_auto_exposure_skip_frames())
 {
     _exposure_thread = std::make_shared<std::thread>(
                 [this]()
@@ -137,7 +157,7 @@ auto_exposure_mechanism::~auto_exposure_mechanism()
 void auto_exposure_mechanism::update_auto_exposure_state(const auto_exposure_state& auto_exposure_state)
 {
     std::lock_guard<std::mutex> lk(_queue_mtx);
-    _skip_frames = auto_exposure_state.skip_frames;
+    _skip_frames = auto_exposure_state.get_auto_exposure_skip_frames();
     _auto_exposure_algo.update_options(auto_exposure_state);
 }
 
@@ -298,13 +318,51 @@ void auto_exposure_algorithm::im_hist(const uint8_t* data, const region_of_inter
 {
     std::lock_guard<std::recursive_mutex> lock(state_mutex);
 
-    for (int i = 0; i < 256; ++i)
-        h[i] = 0;
+    // Neighbouring pixels mostly fall in the same bin, counting them in separate banks keeps each increment
+    // from waiting on the store of the previous one
+    const int banks = 4;
+    uint32_t bank[banks][256] = {};
+    const int rate = static_cast<int>(state.get_auto_exposure_sample_rate());
 
     const uint8_t* rowData = data + (image_roi.min_y * rowStep);
-    for (int i = image_roi.min_y; i < image_roi.max_y; ++i, rowData += rowStep)
-        for (int j = image_roi.min_x; j < image_roi.max_x; j+=state.sample_rate)
-            ++h[rowData[j]];
+    for (int i = image_roi.min_y; i < image_roi.max_y; i += rate, rowData += rate * rowStep)
+    {
+        int j = image_roi.min_x;
+        if (rate == 1)
+        {
+            // The row is read 8 pixels per load, the pixels are taken out of the word with shifts
+            for (; j + 8 <= image_roi.max_x; j += 8)
+            {
+                uint64_t pixels;
+                memcpy(&pixels, rowData + j, sizeof(pixels));
+                ++bank[0][pixels & 0xff];
+                ++bank[1][(pixels >> 8) & 0xff];
+                ++bank[2][(pixels >> 16) & 0xff];
+                ++bank[3][(pixels >> 24) & 0xff];
+                ++bank[0][(pixels >> 32) & 0xff];
+                ++bank[1][(pixels >> 40) & 0xff];
+                ++bank[2][(pixels >> 48) & 0xff];
+                ++bank[3][pixels >> 56];
+            }
+        }
+        else
+        {
+            for (; j + 3 * rate < image_roi.max_x; j += 4 * rate)
+            {
+                ++bank[0][rowData[j]];
+                ++bank[1][rowData[j + rate]];
+                ++bank[2][rowData[j + 2 * rate]];
+                ++bank[3][rowData[j + 3 * rate]];
+            }
+        }
+        for (; j < image_roi.max_x; j += rate)
+            ++bank[0][rowData[j]];
+    }
+
+    // Subsampled counts are scaled back to the whole ROI, the scoring limits are pixel counts
+    const int scale = rate * rate;
+    for (int i = 0; i < 256; ++i)
+        h[i] = static_cast<int>(bank[0][i] + bank[1][i] + bank[2][i] + bank[3][i]) * scale;
 }
 
 void auto_exposure_algorithm::increase_exposure_target(float mult, float& target_exposure)
@@ -16,6 +16,8 @@
 namespace librealsense
 {
     static const float ae_step_default_value = 0.5f;
+    static const unsigned ae_sample_rate_default_value = 1;
+    static const unsigned ae_skip_frames_default_value = 2;
 
     enum class auto_exposure_modes {
         static_auto_exposure = 0,
@@ -30,27 +32,32 @@ namespace librealsense
             is_auto_exposure(true),
             mode(auto_exposure_modes::auto_exposure_hybrid),
             rate(60),
-            step(ae_step_default_value)
+            step(ae_step_default_value),
+            sample_rate(ae_sample_rate_default_value),
+            skip_frames(ae_skip_frames_default_value)
         {}
 
         bool get_enable_auto_exposure() const;
         auto_exposure_modes get_auto_exposure_mode() const;
         unsigned get_auto_exposure_antiflicker_rate() const;
         float get_auto_exposure_step() const;
+        unsigned get_auto_exposure_sample_rate() const;
+        unsigned get_auto_exposure_skip_frames() const;
 
         void set_enable_auto_exposure(bool value);
         void set_auto_exposure_mode(auto_exposure_modes value);
         void set_auto_exposure_antiflicker_rate(unsigned value);
         void set_auto_exposure_step(float value);
-
-        static const unsigned      sample_rate = 1;
-        static const unsigned      skip_frames = 2;
+        void set_auto_exposure_sample_rate(unsigned value);
+        void set_auto_exposure_skip_frames(unsigned value);
 
     private:
         bool                is_auto_exposure;
         auto_exposure_modes mode;
         unsigned            rate;
         float               step;
+        unsigned            sample_rate;    // Every sample_rate-th pixel of every sample_rate-th row is counted in the histogram
+        unsigned            skip_frames;    // Frames skipped between two evaluated frames
     };
 
 
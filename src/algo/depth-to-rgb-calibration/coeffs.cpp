@@ -702,11 +702,12 @@ namespace depth_to_rgb_calibration {
     {
         coeffs<p_matrix> res;
 
-        auto v = new_vertices;
+        auto& v = new_vertices;
         res.y_coeffs.resize(v.size());
         res.x_coeffs.resize(v.size());
 
-        for (auto i = 0; i < rc.size(); i++)
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < int(rc.size()); i++)
         {
             res.x_coeffs[i] = calculate_p_x_coeff(v[i], rc[i], xy[i], cal, p_mat);
             res.y_coeffs[i] = calculate_p_y_coeff(v[i], rc[i], xy[i], cal, p_mat);
@@ -48,6 +48,11 @@ namespace depth_to_rgb_calibration {
         auto cost_per_vertex_new = calc_cost_per_vertex(d_vals_new, z_data, yuy_data,
             [&](size_t i, double d_val, double weight, double vertex_cost) {});
 
+        return calc_cost_per_vertex_diff(cost_per_vertex_old, cost_per_vertex_new);
+    }
+
+    double calc_cost_per_vertex_diff(std::vector< double > const & cost_per_vertex_old, std::vector< double > const & cost_per_vertex_new)
+    {
         double diff = 0;
         auto num = 0;
         for (auto i = 0; i < cost_per_vertex_new.size(); i++)
@@ -76,7 +81,8 @@ namespace depth_to_rgb_calibration {
         const z_frame_data & z_data,
         const yuy2_frame_data & yuy_data,
         const std::vector< double2 > & uv,
-        std::vector< double > * p_interpolated_edges // = nullptr
+        std::vector< double > * p_interpolated_edges, // = nullptr
+        std::vector< double > * p_cost_per_vertex // = nullptr
     )
     {
         double cost = 0;
@@ -95,6 +101,8 @@ namespace depth_to_rgb_calibration {
             } );
         if( p_interpolated_edges )
             *p_interpolated_edges = d_vals;
+        if( p_cost_per_vertex )
+            *p_cost_per_vertex = std::move( cost_per_vertex );
         return N ? cost / N : 0.;
     }
 
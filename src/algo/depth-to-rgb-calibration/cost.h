@@ -18,6 +18,12 @@ namespace depth_to_rgb_calibration {
         yuy2_frame_data const & yuy_data,std::function< void( size_t i, double d_val, double weight, double vertex_cost ) > fn
     );
 
+    std::vector< double > calc_cost_per_vertex(
+        z_frame_data const & z_data,
+        yuy2_frame_data const & yuy_data,
+        const uvmap_t & uvmap
+    );
+
     double calc_cost_per_vertex_diff(
         z_frame_data const & z_data,
         yuy2_frame_data const & yuy_data,
@@ -25,11 +31,18 @@ namespace depth_to_rgb_calibration {
         const uvmap_t & uvmap_new
     );
 
+    // Same, from the costs per vertex, so a line search can compute the costs of its starting point once
+    double calc_cost_per_vertex_diff(
+        std::vector< double > const & cost_per_vertex_old,
+        std::vector< double > const & cost_per_vertex_new
+    );
+
     double calc_cost(
         const z_frame_data & z_data,
         const yuy2_frame_data & yuy_data,
         const uvmap_t & uvmap,
-        std::vector< double > * p_interpolated_edges = nullptr
+        std::vector< double > * p_interpolated_edges = nullptr,
+        std::vector< double > * p_cost_per_vertex = nullptr
     );
 
 
@@ -1387,8 +1387,8 @@ std::vector<double3> optimizer::subedges2vertices(z_frame_data& z_data, const rs
 static p_matrix calc_p_gradients(const z_frame_data & z_data, 
     const std::vector<double3>& new_vertices,
     const yuy2_frame_data & yuy_data, 
-    std::vector<double> interp_IDT_x, 
-    std::vector<double> interp_IDT_y,
+    const std::vector<double>& interp_IDT_x, 
+    const std::vector<double>& interp_IDT_y,
     const calib & cal,
     const p_matrix & p_mat,
     const std::vector<double>& rc, 
@@ -1396,11 +1396,13 @@ static p_matrix calc_p_gradients(const z_frame_data & z_data,
     data_collect * data = nullptr)
 {
     auto coefs = calc_p_coefs(z_data, new_vertices, yuy_data, cal, p_mat, rc, xy);
-    auto w = z_data.weights;
+    auto& w = z_data.weights;
 
     if (data)
         data->iteration_data_p.coeffs_p = coefs;
 
+    // The sums stay serial, in the order of the vertices, to keep the results independent of the threads
+
     p_matrix sums = { 0 };
     auto sum_of_valids = 0;
 
@@ -1436,7 +1438,7 @@ std::pair< std::vector<double2>, std::vector<double>> calc_rc(
     const p_matrix & p_mat
 )
 {
-    auto v = new_vertices;
+    auto& v = new_vertices;
 
     std::vector<double2> f1( z_data.vertices.size() );
     std::vector<double> r2( z_data.vertices.size() );
@@ -1456,7 +1458,8 @@ std::pair< std::vector<double2>, std::vector<double>> calc_rc(
         r[2], r[5], r[8], t[2] };
 */
     auto mat = p_mat.vals;
-    for( auto i = 0; i < z_data.vertices.size(); ++i )
+#pragma omp parallel for schedule(static)
+    for( int i = 0; i < int( z_data.vertices.size() ); ++i )
     {
         double x = v[i].x;
         double y = v[i].y;
@@ -1798,11 +1801,15 @@ optimization_params optimizer::back_tracking_line_search( optimization_params co
     auto uvmap_old = get_texture_map(new_vertices, old_calib, curr_params.curr_p_mat );
     //curr_params.cost = calc_cost( z_data, yuy_data, uvmap_old );
 
+    // The costs of the starting point are the same for all the steps, and the costs of each step come with its total
+    auto cost_per_vertex_old = calc_cost_per_vertex( _z, _yuy, uvmap_old );
+    std::vector< double > cost_per_vertex_new;
+
     calib new_calib = decompose( new_params.curr_p_mat, _original_calibration );
     auto uvmap_new = get_texture_map(new_vertices, new_calib, new_params.curr_p_mat );
-    new_params.cost = calc_cost( _z, _yuy, uvmap_new );
+    new_params.cost = calc_cost( _z, _yuy, uvmap_new, nullptr, &cost_per_vertex_new );
 
-    auto diff = calc_cost_per_vertex_diff( _z, _yuy, uvmap_old, uvmap_new );
+    auto diff = calc_cost_per_vertex_diff( cost_per_vertex_old, cost_per_vertex_new );
 
     auto iter_count = 0;
     while( diff >= step_size * t
@@ -1816,8 +1823,8 @@ optimization_params optimizer::back_tracking_line_search( optimization_params co
         
         new_calib = decompose( new_params.curr_p_mat, _original_calibration );
         uvmap_new = get_texture_map(new_vertices, new_calib, new_params.curr_p_mat);
-        new_params.cost = calc_cost( _z, _yuy, uvmap_new);
-        diff = calc_cost_per_vertex_diff( _z, _yuy, uvmap_old, uvmap_new );
+        new_params.cost = calc_cost( _z, _yuy, uvmap_new, nullptr, &cost_per_vertex_new );
+        diff = calc_cost_per_vertex_diff( cost_per_vertex_old, cost_per_vertex_new );
     }
 
     if(diff >= step_size * t )
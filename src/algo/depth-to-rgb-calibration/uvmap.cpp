@@ -59,7 +59,9 @@ namespace depth_to_rgb_calibration {
 
         std::vector< double2 > uv_map( points.size() );
 
-        for( auto i = 0; i < points.size(); ++i )
+        // Each vertex is independent, the results do not depend on the threads
+#pragma omp parallel for schedule(static)
+        for( int i = 0; i < int( points.size() ); ++i )
         {
             double2 uv;
             transform_point_to_uv( &uv.x, p_mat, &points[i].x );
@@ -82,7 +84,8 @@ namespace depth_to_rgb_calibration {
     {
         std::vector< double > res( uv.size() );
 
-        for( auto i = 0; i < uv.size(); i++ )
+#pragma omp parallel for schedule(static)
+        for( int i = 0; i < int( uv.size() ); i++ )
         {
             auto x = uv[i].x;
             auto x1 = floor( x );
@@ -46,6 +46,21 @@ Java_com_intel_realsense_librealsense_Frame_nGetData(JNIEnv *env, jclass type, j
     handle_error(env, e);
 }
 
+extern "C" JNIEXPORT jobject JNICALL
+Java_com_intel_realsense_librealsense_Frame_nGetDataBuffer(JNIEnv *env, jclass type, jlong handle) {
+    rs2_error *e = NULL;
+    auto frame = reinterpret_cast<const rs2_frame *>(handle);
+    auto data = rs2_get_frame_data(frame, &e);
+    handle_error(env, e);
+    if (e)
+        return NULL;
+    auto size = rs2_get_frame_data_size(frame, &e);
+    handle_error(env, e);
+    if (e)
+        return NULL;
+    return env->NewDirectByteBuffer(const_cast<void *>(data), size);
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_intel_realsense_librealsense_Points_nGetData(JNIEnv *env, jclass type, jlong handle,
@@ -25,25 +25,35 @@ namespace librealsense
 
     float3* points::get_vertices()
     {
-        get_frame_data(); // call GetData to ensure data is in main memory
+        // The vertices are computed before a deferred texture mapping, unless the mapping changes them
+        if (_mapping_changes_vertices)
+            get_frame_data();
         auto xyz = (float3*)data.data();
         return xyz;
     }
 
-    std::tuple<uint8_t, uint8_t, uint8_t> get_texcolor(const frame_holder& texture, float u, float v)
+    void points::defer_texture_mapping(std::function<void()> mapping, bool changes_vertices)
+    {
+        _mapping_changes_vertices = changes_vertices;
+        defer_processing(std::move(mapping));
+    }
+
+    std::tuple<uint8_t, uint8_t, uint8_t> get_texcolor(const video_frame* ptr, const uint8_t* texture_data, float u, float v)
     {
-        auto ptr = dynamic_cast<video_frame*>(texture.frame);
-        if (ptr == nullptr) {
-            throw librealsense::invalid_value_exception("frame must be video frame");
-        }
         const int w = ptr->get_width(), h = ptr->get_height();
         int x = std::min(std::max(int(u*w + .5f), 0), w - 1);
         int y = std::min(std::max(int(v*h + .5f), 0), h - 1);
         int idx = x * ptr->get_bpp() / 8 + y * ptr->get_stride();
-        const auto texture_data = reinterpret_cast<const uint8_t*>(ptr->get_frame_data());
         return std::make_tuple(texture_data[idx], texture_data[idx + 1], texture_data[idx + 2]);
     }
 
+    template<class T>
+    void append_binary(std::vector<char>& buffer, const T& value)
+    {
+        // we assume little endian architecture on your device
+        auto bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
 
     void points::export_to_ply(const std::string& fname, const frame_holder& texture)
     {
@@ -51,53 +61,83 @@ namespace librealsense
         auto video_stream_profile = dynamic_cast<video_stream_profile_interface*>(stream_profile);
         if (!video_stream_profile)
             throw librealsense::invalid_value_exception("stream must be video stream");
+
+        const video_frame* texture_frame = nullptr;
+        const uint8_t* texture_data = nullptr;
+        if (texture)
+        {
+            texture_frame = dynamic_cast<video_frame*>(texture.frame);
+            if (texture_frame == nullptr)
+                throw librealsense::invalid_value_exception("frame must be video frame");
+            texture_data = reinterpret_cast<const uint8_t*>(texture.frame->get_frame_data());
+        }
+
         const auto vertices = get_vertices();
         const auto texcoords = get_texture_coordinates();
-        std::vector<float3> new_vertices;
-        std::vector<std::tuple<uint8_t, uint8_t, uint8_t>> new_tex;
-        std::map<int, int> index2reducedIndex;
-
-        new_vertices.reserve(get_vertex_count());
-        new_tex.reserve(get_vertex_count());
-        assert(get_vertex_count());
-        for (size_t i = 0; i < get_vertex_count(); ++i)
+        const auto vertex_count = get_vertex_count();
+        assert(vertex_count);
+
+        // Index of each vertex in the exported list, -1 for the dropped (zero) ones
+        std::vector<int> index2reducedIndex(vertex_count, -1);
+        int exported_vertices = 0;
+
+        // The whole body is serialized into one buffer and written at once
+        const size_t vertex_size = 3 * sizeof(float) + (texture ? 3 * sizeof(uint8_t) : 0);
+        std::vector<char> body;
+        body.reserve(vertex_count * vertex_size);
+
+        for (size_t i = 0; i < vertex_count; ++i)
             if (fabs(vertices[i].x) >= MIN_DISTANCE || fabs(vertices[i].y) >= MIN_DISTANCE ||
                 fabs(vertices[i].z) >= MIN_DISTANCE)
             {
-                index2reducedIndex[i] = new_vertices.size();
-                new_vertices.push_back({ vertices[i].x,  -1*vertices[i].y, -1*vertices[i].z });
+                index2reducedIndex[i] = exported_vertices++;
+                append_binary(body, vertices[i].x);
+                append_binary(body, -1 * vertices[i].y);
+                append_binary(body, -1 * vertices[i].z);
                 if (texture)
                 {
-                    auto color = get_texcolor(texture, texcoords[i].x, texcoords[i].y);
-                    new_tex.push_back(color);
+                    uint8_t x, y, z;
+                    std::tie(x, y, z) = get_texcolor(texture_frame, texture_data, texcoords[i].x, texcoords[i].y);
+                    append_binary(body, x);
+                    append_binary(body, y);
+                    append_binary(body, z);
                 }
             }
 
         const auto threshold = 0.05f;
-        auto width = video_stream_profile->get_width();
-        std::vector<std::tuple<int, int, int>> faces;
+        const int width = video_stream_profile->get_width();
+        const int height = video_stream_profile->get_height();
+        size_t face_count = 0;
         for (int x = 0; x < width - 1; ++x) {
-            for (int y = 0; y < video_stream_profile->get_height() - 1; ++y) {
+            for (int y = 0; y < height - 1; ++y) {
                 auto a = y * width + x, b = y * width + x + 1, c = (y + 1)*width + x, d = (y + 1)*width + x + 1;
                 if (vertices[a].z && vertices[b].z && vertices[c].z && vertices[d].z
                     && abs(vertices[a].z - vertices[b].z) < threshold && abs(vertices[a].z - vertices[c].z) < threshold
                     && abs(vertices[b].z - vertices[d].z) < threshold && abs(vertices[c].z - vertices[d].z) < threshold)
                 {
-                    if (index2reducedIndex.count(a) == 0 || index2reducedIndex.count(b) == 0 || index2reducedIndex.count(c) == 0 ||
-                        index2reducedIndex.count(d) == 0)
+                    if (index2reducedIndex[a] < 0 || index2reducedIndex[b] < 0 || index2reducedIndex[c] < 0 ||
+                        index2reducedIndex[d] < 0)
                         continue;
 
-                    faces.emplace_back(index2reducedIndex[a], index2reducedIndex[d], index2reducedIndex[b]);
-                    faces.emplace_back(index2reducedIndex[d], index2reducedIndex[a], index2reducedIndex[c]);
+                    const uint8_t three = 3;
+                    append_binary(body, three);
+                    append_binary(body, index2reducedIndex[a]);
+                    append_binary(body, index2reducedIndex[d]);
+                    append_binary(body, index2reducedIndex[b]);
+                    append_binary(body, three);
+                    append_binary(body, index2reducedIndex[d]);
+                    append_binary(body, index2reducedIndex[a]);
+                    append_binary(body, index2reducedIndex[c]);
+                    face_count += 2;
                 }
             }
         }
 
-        std::ofstream out(fname);
+        std::ofstream out(fname, std::ios_base::binary);
         out << "ply\n";
         out << "format binary_little_endian 1.0\n";
         out << "comment pointcloud saved from Realsense Viewer\n";
-        out << "element vertex " << new_vertices.size() << "\n";
+        out << "element vertex " << exported_vertices << "\n";
         out << "property float" << sizeof(float) * 8 << " x\n";
         out << "property float" << sizeof(float) * 8 << " y\n";
         out << "property float" << sizeof(float) * 8 << " z\n";
@@ -107,41 +147,15 @@ namespace librealsense
             out << "property uchar green\n";
             out << "property uchar blue\n";
         }
-        out << "element face " << faces.size() << "\n";
+        out << "element face " << face_count << "\n";
         out << "property list uchar int vertex_indices\n";
         out << "end_header\n";
-        out.close();
-
-        out.open(fname, std::ios_base::app | std::ios_base::binary);
-        for (int i = 0; i < new_vertices.size(); ++i)
-        {
-            // we assume little endian architecture on your device
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].x)), sizeof(float));
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].y)), sizeof(float));
-            out.write(reinterpret_cast<const char*>(&(new_vertices[i].z)), sizeof(float));
-
-            if (texture)
-            {
-                uint8_t x, y, z;
-                std::tie(x, y, z) = new_tex[i];
-                out.write(reinterpret_cast<const char*>(&x), sizeof(uint8_t));
-                out.write(reinterpret_cast<const char*>(&y), sizeof(uint8_t));
-                out.write(reinterpret_cast<const char*>(&z), sizeof(uint8_t));
-            }
-        }
-        auto size = faces.size();
-        for (int i = 0; i < size; ++i) {
-            int three = 3;
-            out.write(reinterpret_cast<const char*>(&three), sizeof(uint8_t));
-            out.write(reinterpret_cast<const char*>(&(std::get<0>(faces[i]))), sizeof(int));
-            out.write(reinterpret_cast<const char*>(&(std::get<1>(faces[i]))), sizeof(int));
-            out.write(reinterpret_cast<const char*>(&(std::get<2>(faces[i]))), sizeof(int));
-        }
+        out.write(body.data(), body.size());
     }
 
     size_t points::get_vertex_count() const
     {
-        return data.size() / (sizeof(float3) + sizeof(int2));
+        return data.size() / (sizeof(float3) + sizeof(int2) + (additional_data.points_colors ? sizeof(uint32_t) : 0));
     }
 
     float2* points::get_texture_coordinates()
@@ -152,6 +166,126 @@ namespace librealsense
         return ijs;
     }
 
+    uint32_t* points::get_colors()
+    {
+        if (!additional_data.points_colors)
+            return nullptr;
+        return (uint32_t*)(get_texture_coordinates() + get_vertex_count());
+    }
+
+
+    // IEEE half float, rounded to the nearest
+    static uint16_t to_half(float value)
+    {
+        const uint32_t f32_infinity = 255 << 23;
+        const uint32_t f16_max = (127 + 16) << 23;
+        const uint32_t denorm_magic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+        uint32_t f;
+        memcpy(&f, &value, sizeof(f));
+        uint32_t sign = f & 0x80000000u;
+        f ^= sign;
+
+        uint16_t res;
+        if (f >= f16_max)
+            res = (f > f32_infinity) ? 0x7e00 : 0x7c00; // nan stays nan, the rest becomes infinity
+        else if (f < (113 << 23))
+        {
+            // subnormal half, the addition rounds the mantissa into place
+            float a, magic;
+            memcpy(&a, &f, sizeof(a));
+            memcpy(&magic, &denorm_magic, sizeof(magic));
+            a += magic;
+            memcpy(&f, &a, sizeof(f));
+            res = uint16_t(f - denorm_magic);
+        }
+        else
+        {
+            uint32_t mantissa_odd = (f >> 13) & 1;
+            f += (uint32_t(15 - 127) << 23) + 0xfff; // rebias the exponent and round
+            f += mantissa_odd;
+            res = uint16_t(f >> 13);
+        }
+        return res | uint16_t(sign >> 16);
+    }
+
+    static int16_t to_millimeters(float meters)
+    {
+        return int16_t(std::max(-32768.f, std::min(32767.f, std::round(meters * 1000.f))));
+    }
+
+    static uint16_t to_unorm16(float value)
+    {
+        return uint16_t(std::max(0.f, std::min(65535.f, std::round(value * 65535.f))));
+    }
+
+    int points::pack(rs2_points_format format, bool valid_only, void* buffer, size_t size, int* indices)
+    {
+        auto count = get_vertex_count();
+        auto xyz = get_vertices();
+        auto uv = get_texture_coordinates();
+        auto colors = get_colors();
+        if (format == RS2_POINTS_FORMAT_XYZRGB && !colors)
+            throw invalid_value_exception("The points have no colors, enable RS2_OPTION_POINTS_COLORS of the pointcloud");
+
+        size_t point_size = 5 * sizeof(uint16_t);
+        if (format == RS2_POINTS_FORMAT_FLOAT32)
+            point_size = 5 * sizeof(float);
+        else if (format == RS2_POINTS_FORMAT_XYZRGB)
+            point_size = sizeof(float3) + sizeof(uint32_t);
+        auto out = reinterpret_cast<uint8_t*>(buffer);
+
+        int res = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (valid_only && !xyz[i].z)
+                continue;
+
+            if (out)
+            {
+                if ((res + 1) * point_size > size)
+                    throw invalid_value_exception(to_string() << "The buffer of " << size << " bytes is too small for the points");
+
+                auto p = out + res * point_size;
+                switch (format)
+                {
+                case RS2_POINTS_FORMAT_FLOAT32:
+                {
+                    float values[5] = { xyz[i].x, xyz[i].y, xyz[i].z, uv[i].x, uv[i].y };
+                    memcpy(p, values, sizeof(values));
+                    break;
+                }
+                case RS2_POINTS_FORMAT_FLOAT16:
+                {
+                    uint16_t values[5] = { to_half(xyz[i].x), to_half(xyz[i].y), to_half(xyz[i].z), to_half(uv[i].x), to_half(uv[i].y) };
+                    memcpy(p, values, sizeof(values));
+                    break;
+                }
+                case RS2_POINTS_FORMAT_INT16_MM:
+                {
+                    int16_t v[3] = { to_millimeters(xyz[i].x), to_millimeters(xyz[i].y), to_millimeters(xyz[i].z) };
+                    uint16_t t[2] = { to_unorm16(uv[i].x), to_unorm16(uv[i].y) };
+                    memcpy(p, v, sizeof(v));
+                    memcpy(p + sizeof(v), t, sizeof(t));
+                    break;
+                }
+                case RS2_POINTS_FORMAT_XYZRGB:
+                {
+                    memcpy(p, &xyz[i], sizeof(float3));
+                    memcpy(p + sizeof(float3), &colors[i], sizeof(uint32_t));
+                    break;
+                }
+                default:
+                    throw invalid_value_exception(to_string() << "Unsupported points format " << format);
+                }
+
+                if (indices)
+                    indices[res] = int(i);
+            }
+            res++;
+        }
+        return res;
+    }
 
     std::shared_ptr<archive_interface> make_archive(rs2_extension type,
         std::atomic<uint32_t>* in_max_frame_queue_size,
@@ -192,6 +326,10 @@ namespace librealsense
         {
             unpublish();
             on_release();
+            _deferred.reset();
+            set_gpu_data(nullptr);
+            if (frame_trace::is_enabled() && is_frame_trace_file_open())
+                write_frame_trace(*this);
             owner->unpublish_frame(this);
         }
     }
@@ -200,14 +338,47 @@ namespace librealsense
     {
         if (!_kept.exchange(true))
         {
+            run_deferred_processing();
+
+            // A kept frame may be held indefinitely, take a copy of a borrowed capture buffer
+            // and hand the buffer back, otherwise the backend runs out of buffers to stream into
+            if (auto size = on_release.get_size())
+            {
+                auto src = static_cast<const byte*>(on_release.get_data());
+                data.assign(src, src + size);
+                on_release();
+            }
             owner->keep_frame(this);
         }
     }
 
+    void frame::defer_processing(std::function<void()> process)
+    {
+        _deferred = std::make_shared<deferred_processing>();
+        _deferred->process = std::move(process);
+    }
+
+    void frame::run_deferred_processing() const
+    {
+        if (!_deferred)
+            return;
+
+        // Concurrent readers wait until the data is ready
+        std::lock_guard<std::recursive_mutex> lock(_deferred->mutex);
+        if (_deferred->process)
+        {
+            auto process = std::move(_deferred->process);
+            _deferred->process = nullptr;
+            process();
+        }
+    }
+
     frame_interface* frame::publish(std::shared_ptr<archive_interface> new_owner)
     {
         owner = new_owner;
         _kept = false;
+        if (frame_trace::is_enabled())
+            additional_data.trace.add(RS2_FRAME_TRACE_STAGE_ARCHIVE_PUBLISH, nullptr, get_trace_time());
         return owner->publish_frame(this);
     }
 
@@ -224,7 +395,10 @@ namespace librealsense
                 << get_string(get_stream()->get_stream_type()) << " stream ");
 
         // Proceed to parse and extract the required data attribute
-        return it->second->get(*this);
+        if (frame_metadata < 0 || frame_metadata >= ::RS2_FRAME_METADATA_COUNT
+            || get_metadata_state(frame_metadata, *it->second) != metadata_parsed)
+            return it->second->get(*this);  // reports the error of the parser
+        return _metadata_values[frame_metadata];
     }
 
     bool frame::supports_frame_metadata(const rs2_frame_metadata_value& frame_metadata) const
@@ -237,16 +411,56 @@ namespace librealsense
         if (it == metadata_parsers.get()->end())          // Possible user error - md attribute is not supported by this frame type
             return false;
 
-        return it->second->supports(*this);
+        if (frame_metadata < 0 || frame_metadata >= ::RS2_FRAME_METADATA_COUNT)
+            return it->second->supports(*this);
+        auto state = get_metadata_state(frame_metadata, *it->second);
+        return state == metadata_parsed || state == metadata_failed;
+    }
+
+    frame::metadata_state frame::get_metadata_state(rs2_frame_metadata_value frame_metadata, const md_attribute_parser_base& parser) const
+    {
+        auto& state = _metadata_state[frame_metadata];
+        auto current = state.load(std::memory_order_acquire);
+        if (current != metadata_unknown)
+            return metadata_state(current);
+
+        // Parsed outside the lock, some parsers read other attributes of the same frame
+        metadata_state result = metadata_unsupported;
+        rs2_metadata_type value = 0;
+        if (parser.supports(*this))
+        {
+            try
+            {
+                value = parser.get(*this);
+                result = metadata_parsed;
+            }
+            catch (...)
+            {
+                result = metadata_failed;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_metadata_mutex);
+        if (state.load(std::memory_order_relaxed) == metadata_unknown)
+        {
+            _metadata_values[frame_metadata] = value;
+            state.store(result, std::memory_order_release);
+        }
+        return metadata_state(state.load(std::memory_order_relaxed));
     }
 
     int frame::get_frame_data_size() const
     {
+        if (auto size = on_release.get_size())
+            return static_cast<int>(size);
+
         return data.size();
     }
 
     const byte* frame::get_frame_data() const
     {
+        run_deferred_processing();
+
         const byte* frame_data = data.data();
 
         if (on_release.get_data())
@@ -5,6 +5,8 @@
 
 #include "types.h"
 #include "core/streaming.h"
+#include "frame-trace.h"
+#include "memory-counter.h"
 #include <atomic>
 #include <array>
 #include <math.h>
@@ -40,6 +42,9 @@ namespace librealsense
                                                  // if the recorder was configured to realtime mode or not
                                                  // if true, this will force any queue receiving this frame not to drop it
         uint32_t            raw_size = 0;   // The frame transmitted size (payload only)
+        uint32_t            motion_samples = 0; // Samples of a batched motion frame, 0 for a motion frame of a single sample
+        bool                points_colors = false; // A points frame holding the color of every point after the texture coordinates
+        frame_trace         trace;          // Stages of the frame path, recorded while the frame trace is enabled
 
         frame_additional_data() {}
 
@@ -69,6 +74,100 @@ namespace librealsense
         }
     };
 
+    /*
+        Allocator behind every frame buffer
+        Routes the storage to the user-provided rs2_frame_allocator when one was assigned to the owning archive,
+        and default-initializes new elements so growing a buffer does not zero-fill it.
+        The buffers are counted in the memory counter of the archive, the process-wide one when it has none
+    */
+    template<class T>
+    class frame_buffer_allocator
+    {
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+        template<class U> struct rebind { typedef frame_buffer_allocator<U> other; };
+
+        frame_buffer_allocator() = default;
+        explicit frame_buffer_allocator(frame_allocator_ptr user_allocator, std::shared_ptr<memory_counter> counter = nullptr)
+            : _user_allocator(std::move(user_allocator)), _counter(std::move(counter)) {}
+        template<class U>
+        frame_buffer_allocator(const frame_buffer_allocator<U>& other) : _user_allocator(other.get_user_allocator()), _counter(other.get_counter()) {}
+
+        // Throws memory_budget_exceeded when the buffer would exceed a memory budget
+        T* allocate(size_t n)
+        {
+            auto& counter = memory_counter::get(_counter);
+            counter.reserve_frame_buffers(n * sizeof(T));
+            try
+            {
+                T* ptr;
+                if (!_user_allocator)
+                    ptr = static_cast<T*>(::operator new(n * sizeof(T)));
+                else
+                {
+                    ptr = static_cast<T*>(_user_allocator->allocate(n * sizeof(T)));
+                    if (!ptr) throw std::bad_alloc();
+                }
+                return ptr;
+            }
+            catch (...)
+            {
+                counter.add(RS2_MEMORY_CATEGORY_FRAME_BUFFERS, -(long long)(n * sizeof(T)));
+                throw;
+            }
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+            memory_counter::get(_counter).add(RS2_MEMORY_CATEGORY_FRAME_BUFFERS, -(long long)(n * sizeof(T)));
+            if (_user_allocator) _user_allocator->deallocate(ptr, n * sizeof(T));
+            else ::operator delete(ptr);
+        }
+
+        template<class U>
+        void construct(U* ptr) { ::new((void*)ptr) U; }
+        template<class U, class... Args>
+        void construct(U* ptr, Args&&... args) { ::new((void*)ptr) U(std::forward<Args>(args)...); }
+
+        const frame_allocator_ptr& get_user_allocator() const { return _user_allocator; }
+        const std::shared_ptr<memory_counter>& get_counter() const { return _counter; }
+
+    private:
+        frame_allocator_ptr _user_allocator;
+        std::shared_ptr<memory_counter> _counter;
+    };
+
+    // Buffers are released by the allocator of the same user allocator and memory counter
+    template<class T, class U>
+    bool operator==(const frame_buffer_allocator<T>& a, const frame_buffer_allocator<U>& b)
+    {
+        return a.get_user_allocator() == b.get_user_allocator() && a.get_counter() == b.get_counter();
+    }
+    template<class T, class U>
+    bool operator!=(const frame_buffer_allocator<T>& a, const frame_buffer_allocator<U>& b) { return !(a == b); }
+
+    typedef std::vector<byte, frame_buffer_allocator<byte>> frame_buffer;
+
+    // Counters describing how well an archive recycles its frame buffers
+    struct frame_pool_stats
+    {
+        unsigned long long hits = 0;        // buffers served from the freelist
+        unsigned long long misses = 0;      // buffers that had to be allocated
+        unsigned long long evictions = 0;   // recycled buffers dropped after exceeding the retention period
+        uint32_t in_use = 0;                // published frames not yet released, of the archive closest to its limit
+        uint32_t capacity = 0;              // published frames allowed before new frames are dropped, 0 when unbounded
+
+        frame_pool_stats& operator+=(const frame_pool_stats& other)
+        {
+            hits += other.hits;
+            misses += other.misses;
+            evictions += other.evictions;
+            return *this;
+        }
+    };
+
     class archive_interface : public sensor_part
     {
     public:
@@ -80,6 +179,12 @@ namespace librealsense
 
         virtual void flush() = 0;
 
+        virtual void set_frame_allocator(frame_allocator_ptr allocator) = 0;
+        virtual void set_memory_counter(std::shared_ptr<memory_counter> counter) = 0;
+
+        virtual void set_freelist_retention(rs2_time_t retention_ms) = 0;
+        virtual frame_pool_stats get_pool_stats() const = 0;
+
         virtual frame_interface* publish_frame(frame_interface* frame) = 0;
         virtual void unpublish_frame(frame_interface* frame) = 0;
         virtual void keep_frame(frame_interface* frame) = 0;
@@ -95,10 +200,10 @@ namespace librealsense
     class LRS_EXTENSION_API frame : public frame_interface
     {
     public:
-        std::vector<byte> data;
+        frame_buffer data;
         frame_additional_data additional_data;
         std::shared_ptr<metadata_parser_map> metadata_parsers = nullptr;
-        explicit frame() : ref_count(0), owner(nullptr), on_release(),_kept(false) {}
+        explicit frame() : ref_count(0), owner(nullptr), on_release(),_kept(false) { reset_metadata(); }
         frame(const frame& r) = delete;
         frame(frame&& r)
             : ref_count(r.ref_count.exchange(0)), owner(r.owner), on_release(), _kept(r._kept.exchange(false))
@@ -116,10 +221,13 @@ namespace librealsense
             ref_count = r.ref_count.exchange(0);
             _kept = r._kept.exchange(false);
             on_release = std::move(r.on_release);
+            _deferred = std::move(r._deferred);
+            _gpu_data = std::move(r._gpu_data);
             additional_data = std::move(r.additional_data);
             r.owner.reset();
             if (owner) metadata_parsers = owner->get_md_parsers();
             if (r.metadata_parsers) metadata_parsers = std::move(r.metadata_parsers);
+            reset_metadata();
             return *this;
         }
 
@@ -130,7 +238,7 @@ namespace librealsense
         const byte* get_frame_data() const override;
         rs2_time_t get_frame_timestamp() const override;
         rs2_timestamp_domain get_frame_timestamp_domain() const override;
-        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; }
+        void set_timestamp(double new_ts) override { additional_data.timestamp = new_ts; reset_metadata(); }
         unsigned long long get_frame_number() const override;
         void set_timestamp_domain(rs2_timestamp_domain timestamp_domain) override
         {
@@ -154,8 +262,25 @@ namespace librealsense
         void attach_continuation(frame_continuation&& continuation) override { on_release = std::move(continuation); }
         void disable_continuation() override { on_release.reset(); }
 
+        // Postpones filling the frame data until it is first accessed or the frame is kept.
+        // Frames that are released unread are never processed. Must be set before the frame is handed out
+        void defer_processing(std::function<void()> process);
+
+        // Device resident copy of the frame data, shared by the CUDA processing blocks so that a chain of them
+        // uploads the frame once. Released with the frame
+        std::shared_ptr<void> get_gpu_data() const { return std::atomic_load(&_gpu_data); }
+        void set_gpu_data(std::shared_ptr<void> data) { std::atomic_store(&_gpu_data, std::move(data)); }
+
         archive_interface* get_owner() const override { return owner.get(); }
 
+        // Whether the caller holds the only reference to the frame and the frame holds its data in its own buffer,
+        // rather than in a buffer of the backend or along with a device copy, so that the data may be overwritten
+        bool is_writable() const
+        {
+            run_deferred_processing();
+            return ref_count.load() == 1 && !on_release.get_data() && !get_gpu_data();
+        }
+
         std::shared_ptr<sensor_interface> get_sensor() const override;
         void set_sensor(std::shared_ptr<sensor_interface> s) override;
 
@@ -170,11 +295,35 @@ namespace librealsense
         bool is_blocking() const override { return additional_data.is_blocking; }
 
     private:
+        struct deferred_processing
+        {
+            // Recursive, the processing may itself access the frame data
+            std::recursive_mutex mutex;
+            std::function<void()> process;
+        };
+
+        void run_deferred_processing() const;
+
+        // Each metadata attribute is parsed on its first access and kept with the frame,
+        // so that the callers reading it again or reading all the attributes do not run the parsers each time
+        enum metadata_state : uint8_t { metadata_unknown, metadata_parsed, metadata_unsupported, metadata_failed };
+        metadata_state get_metadata_state(rs2_frame_metadata_value frame_metadata, const md_attribute_parser_base& parser) const;
+        void reset_metadata()
+        {
+            for (auto& state : _metadata_state)
+                state.store(metadata_unknown, std::memory_order_relaxed);
+        }
+
         // TODO: check boost::intrusive_ptr or an alternative
         std::atomic<int> ref_count; // the reference count is on how many times this placeholder has been observed (not lifetime, not content)
         std::shared_ptr<archive_interface> owner; // pointer to the owner to be returned to by last observe
         std::weak_ptr<sensor_interface> sensor;
         frame_continuation on_release;
+        std::shared_ptr<deferred_processing> _deferred;
+        std::shared_ptr<void> _gpu_data;
+        mutable std::array<std::atomic<uint8_t>, ::RS2_FRAME_METADATA_COUNT> _metadata_state;
+        mutable std::array<rs2_metadata_type, ::RS2_FRAME_METADATA_COUNT> _metadata_values;
+        mutable std::mutex _metadata_mutex;
         bool _fixed = false;
         std::atomic_bool _kept;
         std::shared_ptr<stream_profile_interface> stream;
@@ -187,6 +336,17 @@ namespace librealsense
         void export_to_ply(const std::string& fname, const frame_holder& texture);
         size_t get_vertex_count() const;
         float2* get_texture_coordinates();
+        // The packed RGB of every point, or null unless the points were allocated with their colors
+        uint32_t* get_colors();
+        // Postpones the texture mapping until the texture coordinates or the frame data are first accessed, or the frame is kept,
+        // so that the frames used for their geometry only are never mapped. A mapping that changes the vertices,
+        // as the occlusion removal does, runs on the first access of the vertices as well
+        void defer_texture_mapping(std::function<void()> mapping, bool changes_vertices);
+        // Writes the points to buffer in a compact format, or only counts them when buffer is null, and returns their number
+        int pack(rs2_points_format format, bool valid_only, void* buffer, size_t size, int* indices);
+
+    private:
+        bool _mapping_changes_vertices = false;
     };
 
     MAP_EXTENSION(RS2_EXTENSION_POINTS, librealsense::points);
@@ -14,6 +14,9 @@ namespace librealsense
         virtual void write_calibration() const = 0;
         virtual std::vector<uint8_t> run_on_chip_calibration(int timeout_ms, std::string json, float* health, update_progress_callback_ptr progress_callback) = 0;
         virtual std::vector<uint8_t> run_tare_calibration( int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback) = 0;
+        // Return once the parameters are validated, the calibration runs on a thread of its own that reports the result to done_callback
+        virtual void run_on_chip_calibration_async(int timeout_ms, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback) = 0;
+        virtual void run_tare_calibration_async(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback) = 0;
         virtual std::vector<uint8_t> get_calibration_table() const = 0;
         virtual void set_calibration_table(const std::vector<uint8_t>& calibration) = 0;
         virtual void reset_to_factory_calibration() const = 0;
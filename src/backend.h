@@ -28,7 +28,12 @@
 
 
 const uint16_t MAX_RETRIES                = 100;
+#ifdef ZERO_COPY
+const uint8_t  DEFAULT_V4L2_FRAME_BUFFERS = 8;    // Frames hold on to the capture buffers until released
+#else
 const uint8_t  DEFAULT_V4L2_FRAME_BUFFERS = 4;
+#endif
+const uint8_t  MAX_V4L2_POLLER_THREADS    = 4;    // Threads servicing the streaming nodes of all the devices
 const uint16_t DELAY_FOR_RETRIES          = 50;
 
 const uint8_t MAX_META_DATA_SIZE          = 0xff; // UVC Metadata total length
@@ -335,6 +340,8 @@ namespace librealsense
             virtual void close() = 0;
             virtual void stop_capture() = 0;
             virtual void start_capture(hid_callback callback) = 0;
+            // Number of samples the backend lets accumulate before waking up to deliver them, 1 delivers each sample on arrival. Applies to the captures started afterwards
+            virtual void set_samples_per_wakeup(uint32_t samples) {}
             virtual std::vector<hid_sensor> get_sensors() = 0;
             virtual std::vector<uint8_t> get_custom_report_data(const std::string& custom_sensor_name,
                                                                 const std::string& report_name,
@@ -346,7 +353,12 @@ namespace librealsense
         class uvc_device
         {
         public:
+            // buffers is the number of frame buffers queued for the stream, 0 selects the backend default
             virtual void probe_and_commit(stream_profile profile, frame_callback callback, int buffers = DEFAULT_V4L2_FRAME_BUFFERS) = 0;
+            // Deliver only the most recent frame, dropping the frames queued ahead of it. Applies to the streams committed afterwards
+            virtual void set_latest_frame_only(bool latest_only) {}
+            // True when the frame buffer passed to the callback stays valid until its continuation is invoked
+            virtual bool retains_frame_buffers() const { return false; }
             virtual void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) = 0;
             virtual void start_callbacks() = 0;
             virtual void stop_callbacks() = 0;
@@ -389,6 +401,16 @@ namespace librealsense
                 _dev->probe_and_commit(profile, callback, buffers);
             }
 
+            void set_latest_frame_only(bool latest_only) override
+            {
+                _dev->set_latest_frame_only(latest_only);
+            }
+
+            bool retains_frame_buffers() const override
+            {
+                return _dev->retains_frame_buffers();
+            }
+
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override
             {
                 _dev->stream_on(error_handler);
@@ -658,6 +680,17 @@ namespace librealsense
                 _dev[dev_index]->probe_and_commit(profile, callback, buffers);
             }
 
+            void set_latest_frame_only(bool latest_only) override
+            {
+                for (auto& dev : _dev)
+                    dev->set_latest_frame_only(latest_only);
+            }
+
+            bool retains_frame_buffers() const override
+            {
+                return std::all_of(_dev.begin(), _dev.end(), [](const std::shared_ptr<uvc_device>& dev) { return dev->retains_frame_buffers(); });
+            }
+
 
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override
             {
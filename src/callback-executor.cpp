@@ -0,0 +1,125 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "callback-executor.h"
+#include "archive.h"
+#include "metrics.h"
+#include "thread-policy.h"
+
+namespace librealsense
+{
+    callback_executor::callback_executor(frame_callback_ptr callback, size_t mailbox_size)
+        : _mailboxes(std::make_shared<mailboxes>())
+    {
+        _mailboxes->callback = std::move(callback);
+        _mailboxes->mailbox_size = std::max<size_t>(mailbox_size, 1);
+
+        auto on_thread_start = thread_policy_hook(RS2_THREAD_ROLE_PROCESSING);
+        auto m = _mailboxes;
+        _thread = std::thread([m, on_thread_start]()
+        {
+            if (on_thread_start)
+                on_thread_start();
+            run(m);
+        });
+    }
+
+    callback_executor::~callback_executor()
+    {
+        stop();
+    }
+
+    void callback_executor::on_frame(rs2_frame* f)
+    {
+        frame_holder frame((frame_interface*)f);
+        if (!frame)
+            return;
+
+        int key = -1;
+        if (!dynamic_cast<composite_frame*>(frame.frame) && frame->get_stream())
+            key = frame->get_stream()->get_unique_id();
+
+        frame_holder dropped;
+        {
+            std::lock_guard<std::mutex> lock(_mailboxes->mutex);
+            if (_mailboxes->stopped)
+                return;
+
+            auto& count = _mailboxes->counts[key];
+            if (count >= _mailboxes->mailbox_size)
+            {
+                auto oldest = std::find_if(_mailboxes->frames.begin(), _mailboxes->frames.end(),
+                    [key](const std::pair<int, frame_holder>& item) { return item.first == key; });
+                dropped = std::move(oldest->second);
+                _mailboxes->frames.erase(oldest);
+                --count;
+            }
+            _mailboxes->frames.emplace_back(key, std::move(frame));
+            ++count;
+        }
+        _mailboxes->cv.notify_one();
+
+        // Released out of the lock, a frame may hold the last reference of a whole frameset
+        if (dropped)
+            count_dropped_frames(dropped.frame, RS2_FRAME_DROP_CAUSE_QUEUE_FULL);
+    }
+
+    void callback_executor::stop()
+    {
+        std::deque<std::pair<int, frame_holder>> dropped;
+        {
+            std::lock_guard<std::mutex> lock(_mailboxes->mutex);
+            _mailboxes->stopped = true;
+            dropped.swap(_mailboxes->frames);
+            _mailboxes->counts.clear();
+        }
+        _mailboxes->cv.notify_all();
+        dropped.clear();
+
+        if (!_thread.joinable())
+            return;
+        if (_thread.get_id() == std::this_thread::get_id())
+            _thread.detach();
+        else
+            _thread.join();
+    }
+
+    void callback_executor::run(std::shared_ptr<mailboxes> m)
+    {
+        std::unique_lock<std::mutex> lock(m->mutex);
+        while (true)
+        {
+            m->cv.wait(lock, [&]() { return m->stopped || !m->frames.empty(); });
+            if (m->stopped)
+                return;
+
+            auto item = std::move(m->frames.front());
+            m->frames.pop_front();
+            --m->counts[item.first];
+            lock.unlock();
+
+            try
+            {
+                frame_interface* ref = nullptr;
+                std::swap(item.second.frame, ref);
+                m->callback->on_frame((rs2_frame*)ref);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Exception was thrown during user callback: " << e.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR("Exception was thrown during user callback!");
+            }
+
+            lock.lock();
+        }
+    }
+
+    std::shared_ptr<callback_executor> make_callback_executor(frame_callback_ptr callback, size_t mailbox_size)
+    {
+        return std::shared_ptr<callback_executor>(new callback_executor(std::move(callback), mailbox_size),
+            [](callback_executor* executor) { executor->release(); });
+    }
+}
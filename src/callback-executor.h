@@ -0,0 +1,56 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "types.h"
+#include "core/streaming.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <thread>
+
+namespace librealsense
+{
+    /*
+        Calls a user callback on a dedicated thread, so that a slow callback never holds the capture threads or the syncer.
+        The frames wait in a mailbox per stream, the framesets in a mailbox of their own, of mailbox_size frames each:
+        a frame arriving at a full mailbox replaces the oldest frame of the mailbox, counted as RS2_FRAME_DROP_CAUSE_QUEUE_FULL.
+        With a mailbox of one frame, the callback receives the latest frame of every stream.
+        The frames are delivered in the order they arrived, one callback at a time
+    */
+    class callback_executor : public rs2_frame_callback
+    {
+    public:
+        callback_executor(frame_callback_ptr callback, size_t mailbox_size);
+        ~callback_executor();
+
+        void on_frame(rs2_frame* f) override;
+        void release() override { delete this; }
+
+        // Drops the frames waiting and waits for the callback running, unless called from the callback.
+        // No callback starts after it returns
+        void stop();
+
+    private:
+        struct mailboxes
+        {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<std::pair<int, frame_holder>> frames; // In arrival order, with the key of their mailbox
+            std::map<int, size_t> counts;
+            bool stopped = false;
+            frame_callback_ptr callback;
+            size_t mailbox_size;
+        };
+
+        static void run(std::shared_ptr<mailboxes> m);
+
+        // Shared with the thread, which outlives the executor when the callback stops it
+        std::shared_ptr<mailboxes> _mailboxes;
+        std::thread _thread;
+    };
+
+    std::shared_ptr<callback_executor> make_callback_executor(frame_callback_ptr callback, size_t mailbox_size);
+}
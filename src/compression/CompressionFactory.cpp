@@ -5,34 +5,46 @@
 #include "JpegCompression.h"
 #include "Lz4Compression.h"
 #include "RvlCompression.h"
+#ifdef RS_VIDEO_CODEC
+#include "VideoCompression.h"
+#endif
+
+#include <cstdlib>
 
 std::shared_ptr<ICompression> CompressionFactory::getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp)
 {
-    ZipMethod zipMeth;
-    if(t_streamType == RS2_STREAM_COLOR || t_streamType == RS2_STREAM_INFRARED)
-    {
-        zipMeth = ZipMethod::jpeg;
-    }
-    else if(t_streamType == RS2_STREAM_DEPTH)
-    {
-        zipMeth = ZipMethod::lz;
-    }
     if(!isCompressionSupported(t_format, t_streamType))
     {
         return nullptr;
     }
+    return getObject(getDefaultConfig(t_format, t_streamType, true), t_width, t_height, t_format, t_bpp);
+}
 
-    switch(zipMeth)
+std::shared_ptr<ICompression> CompressionFactory::getObject(const CompressionConfig& t_config, int t_width, int t_height, rs2_format t_format, int t_bpp, int t_fps)
+{
+    switch(t_config.zipMethod)
     {
     case ZipMethod::rvl:
         return std::make_shared<RvlCompression>(t_width, t_height, t_format, t_bpp);
         break;
     case ZipMethod::jpeg:
-        return std::make_shared<JpegCompression>(t_width, t_height, t_format, t_bpp);
+    {
+        auto compression = std::make_shared<JpegCompression>(t_width, t_height, t_format, t_bpp);
+        compression->setQuality(t_config.quality);
+        return compression;
         break;
+    }
     case ZipMethod::lz:
-        return std::make_shared<Lz4Compression>(t_width, t_height, t_format, t_bpp);
+        return std::make_shared<Lz4Compression>(t_width, t_height, t_format, t_bpp, t_config.keyInterval);
+        break;
+#ifdef RS_VIDEO_CODEC
+    case ZipMethod::h264:
+    case ZipMethod::h265:
+        return std::make_shared<VideoCompression>(t_width, t_height, t_format, t_bpp, t_config.zipMethod == ZipMethod::h265, t_config.bitrate, t_fps);
         break;
+#endif
+    case ZipMethod::none:
+        return nullptr;
     default:
         ERR << "unknown zip method";
         return nullptr;
@@ -58,3 +70,156 @@ bool CompressionFactory::isCompressionSupported(rs2_format t_format, rs2_stream
     }
     return true;
 }
+
+bool CompressionFactory::isCompressionSupported(const CompressionConfig& t_config, rs2_format t_format, rs2_stream t_streamType)
+{
+    switch(t_config.zipMethod)
+    {
+    case ZipMethod::none:
+        return true;
+    case ZipMethod::lz:
+        // the differences between frames are coded for 16 bit pixels
+        return t_config.keyInterval == 0 || (t_config.keyInterval > 0 && (t_format == RS2_FORMAT_Z16 || t_format == RS2_FORMAT_Y16));
+    case ZipMethod::rvl:
+        // RVL codes the differences between consecutive 16 bit pixels
+        return t_format == RS2_FORMAT_Z16 || t_format == RS2_FORMAT_Y16;
+    case ZipMethod::jpeg:
+        return t_config.quality >= 1 && t_config.quality <= 100 && t_config.bandwidth >= 0 && (t_streamType == RS2_STREAM_COLOR || t_streamType == RS2_STREAM_INFRARED) &&
+               (t_format == RS2_FORMAT_BGR8 || t_format == RS2_FORMAT_RGB8 || t_format == RS2_FORMAT_Y8 || t_format == RS2_FORMAT_YUYV || t_format == RS2_FORMAT_UYVY);
+#ifdef RS_VIDEO_CODEC
+    case ZipMethod::h264:
+    case ZipMethod::h265:
+        return t_config.bitrate >= 0 && t_streamType == RS2_STREAM_COLOR &&
+               (t_format == RS2_FORMAT_BGR8 || t_format == RS2_FORMAT_RGB8 || t_format == RS2_FORMAT_YUYV || t_format == RS2_FORMAT_UYVY);
+#endif
+    default:
+        return false;
+    }
+}
+
+CompressionConfig CompressionFactory::getDefaultConfig(rs2_format t_format, rs2_stream t_streamType, bool t_isEnabled)
+{
+    CompressionConfig config;
+    if(!t_isEnabled)
+    {
+        return config;
+    }
+
+    if(t_streamType == RS2_STREAM_COLOR || t_streamType == RS2_STREAM_INFRARED)
+    {
+        config.zipMethod = ZipMethod::jpeg;
+    }
+    else if(t_streamType == RS2_STREAM_DEPTH)
+    {
+        config.zipMethod = ZipMethod::lz;
+    }
+    if(!isCompressionSupported(config, t_format, t_streamType))
+    {
+        config.zipMethod = ZipMethod::none;
+    }
+    return config;
+}
+
+std::string CompressionFactory::getSupportedCodecs(rs2_format t_format, rs2_stream t_streamType)
+{
+    std::string codecs;
+    for(const char* codec : {"none", "lz4", "rvl", "jpeg", "adaptive:1", "h264", "h265"})
+    {
+        CompressionConfig config;
+        parseConfig(codec, config);
+        if(isCompressionSupported(config, t_format, t_streamType))
+        {
+            std::string name(codec);
+            codecs.append((codecs.empty() ? "" : ",") + name.substr(0, name.find(':')));
+        }
+    }
+    return codecs;
+}
+
+bool CompressionFactory::parseConfig(const std::string& t_str, CompressionConfig& t_config)
+{
+    CompressionConfig config;
+    std::string name = t_str.substr(0, t_str.find(':'));
+    std::string value = name.size() < t_str.size() ? t_str.substr(name.size() + 1) : "";
+    int number = 0;
+    if(!value.empty())
+    {
+        char* end = nullptr;
+        number = strtol(value.c_str(), &end, 10);
+        if(*end != '\0')
+        {
+            return false;
+        }
+    }
+
+    if(name == "none" && value.empty())
+    {
+        config.zipMethod = ZipMethod::none;
+    }
+    else if(name == "lz4")
+    {
+        config.zipMethod = ZipMethod::lz;
+        config.keyInterval = number;
+    }
+    else if(name == "rvl" && value.empty())
+    {
+        config.zipMethod = ZipMethod::rvl;
+    }
+    else if(name == "jpeg")
+    {
+        config.zipMethod = ZipMethod::jpeg;
+        if(!value.empty())
+        {
+            config.quality = number;
+        }
+    }
+    else if(name == "adaptive" && number > 0)
+    {
+        config.zipMethod = ZipMethod::jpeg;
+        config.bandwidth = number;
+    }
+    else if(name == "h264" || name == "h265")
+    {
+        config.zipMethod = name == "h264" ? ZipMethod::h264 : ZipMethod::h265;
+        config.bitrate = number;
+    }
+    else
+    {
+        return false;
+    }
+    t_config = config;
+    return true;
+}
+
+std::string CompressionFactory::configToString(const CompressionConfig& t_config)
+{
+    switch(t_config.zipMethod)
+    {
+    case ZipMethod::lz:
+        if(t_config.keyInterval > 0)
+        {
+            return "lz4:" + std::to_string(t_config.keyInterval);
+        }
+        return "lz4";
+    case ZipMethod::rvl:
+        return "rvl";
+    case ZipMethod::jpeg:
+        if(t_config.bandwidth > 0)
+        {
+            return "adaptive:" + std::to_string(t_config.bandwidth);
+        }
+        return "jpeg:" + std::to_string(t_config.quality);
+    case ZipMethod::h264:
+    case ZipMethod::h265:
+    {
+        std::string name = t_config.zipMethod == ZipMethod::h264 ? "h264" : "h265";
+        if(t_config.bitrate > 0)
+        {
+            return name + ":" + std::to_string(t_config.bitrate);
+        }
+        return name;
+    }
+    default:
+        return "none";
+    }
+}
@@ -4,7 +4,13 @@
 #pragma once
 
 #include "ICompression.h"
+
+#include <string>
+
 #define IS_COMPRESSION_ENABLED 1 // enabled by default
+#define JPEG_DEFAULT_QUALITY 75
+#define JPEG_MIN_ADAPTIVE_QUALITY 10
+#define VIDEO_DEFAULT_KEY_INTERVAL 30 // frames, the longest a client waits after a lost frame
 
 typedef enum ZipMethod
 {
@@ -12,12 +18,38 @@ typedef enum ZipMethod
     rvl,
     jpeg,
     lz,
+    h264,
+    h265,
+    none,
 } ZipMethod;
 
+// Codec of a stream, requested by the client in the SETUP of the stream and used by both sides.
+// The text form is "none", "lz4", "lz4:<key interval>", "rvl", "jpeg", "jpeg:<quality>", "adaptive:<kbps>", "h264", "h264:<kbps>", "h265"
+// or "h265:<kbps>", where adaptive is JPEG with the quality lowered while the compressed stream exceeds the bandwidth budget, and raised
+// back when it fits. With a key interval LZ4 codes the 16 bit frames as the difference from the previous frame, with a key frame every
+// interval frames. H.264 and H.265 are available when the library is built with BUILD_NETWORK_VIDEO_CODEC, see VideoCompression
+struct CompressionConfig
+{
+    ZipMethod zipMethod = ZipMethod::none;
+    int quality = JPEG_DEFAULT_QUALITY;
+    int bandwidth = 0; // kbps, adaptive when positive
+    int keyInterval = 0; // frames, LZ4 delta coding when positive
+    int bitrate = 0; // kbps of H.264 and H.265, from the resolution and the frame rate when 0
+};
+
 class CompressionFactory
 {
 public:
     static std::shared_ptr<ICompression> getObject(int t_width, int t_height, rs2_format t_format, rs2_stream t_streamType, int t_bpp);
+    // The frame rate sets the bitrate of the video codecs
+    static std::shared_ptr<ICompression> getObject(const CompressionConfig& t_config, int t_width, int t_height, rs2_format t_format, int t_bpp, int t_fps = 0);
     static bool isCompressionSupported(rs2_format t_format, rs2_stream t_streamType);
+    static bool isCompressionSupported(const CompressionConfig& t_config, rs2_format t_format, rs2_stream t_streamType);
+    // The codec used when the client does not choose one: JPEG for color and infrared, LZ4 for depth. H.264 and H.265 are only used when chosen
+    static CompressionConfig getDefaultConfig(rs2_format t_format, rs2_stream t_streamType, bool t_isEnabled);
+    // Comma separated names of the codecs of a stream, advertised in the SDP of the stream
+    static std::string getSupportedCodecs(rs2_format t_format, rs2_stream t_streamType);
+    static bool parseConfig(const std::string& t_str, CompressionConfig& t_config);
+    static std::string configToString(const CompressionConfig& t_config);
     static bool& getIsEnabled();
 };
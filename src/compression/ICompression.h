@@ -14,6 +14,10 @@ public:
         m_width(t_width),m_height(t_height), m_format(t_format), m_bpp(t_bpp) {};
     virtual int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf) = 0;
     virtual int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf) = 0;
+    // Quality of the lossy codecs, from 1 to 100, takes effect from the next compressed frame
+    virtual void setQuality(int t_quality) {}
+    // Codes the next frame without reference to the previous ones, for a client joining a stream coded from the previous frames
+    virtual void requestKeyFrame() {}
 
 protected:
     int m_width, m_height, m_bpp;
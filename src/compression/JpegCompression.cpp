@@ -3,6 +3,7 @@
 
 #include "JpegCompression.h"
 #include "jpeglib.h"
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
@@ -18,10 +19,11 @@ JpegCompression::JpegCompression(int t_width, int t_height, rs2_format t_format,
     jpeg_create_compress(&m_cinfo);
     jpeg_create_decompress(&m_dinfo);
     m_cinfo.input_components = m_bpp;
-    if(m_format == RS2_FORMAT_YUYV || m_format == RS2_FORMAT_UYVY)
+    m_isYUV422 = m_format == RS2_FORMAT_YUYV || m_format == RS2_FORMAT_UYVY;
+    if(m_isYUV422)
     {
         m_cinfo.in_color_space = JCS_YCbCr;
-        m_cinfo.input_components = 3; //yuyv and uyvy is 2 bpp, converted to yuv that is 3 bpp.
+        m_cinfo.input_components = 3; //yuyv and uyvy is 2 bpp, coded as 3 planes
     }
     else if(m_format == RS2_FORMAT_Y8)
     {
@@ -37,8 +39,41 @@ JpegCompression::JpegCompression(int t_width, int t_height, rs2_format t_format,
         ERR << "unsupported format " << t_format << " for JPEG compression";
     }
     m_rowBuffer = new unsigned char[m_cinfo.input_components * t_width];
-    m_destBuffer = (*m_cinfo.mem->alloc_sarray)((j_common_ptr)&m_cinfo, JPOOL_IMAGE, m_cinfo.input_components * t_width, 1);
+    m_destBuffer = (*m_dinfo.mem->alloc_sarray)((j_common_ptr)&m_dinfo, JPOOL_PERMANENT, m_cinfo.input_components * t_width, 1);
+    m_cinfo.image_width = m_width;
+    m_cinfo.image_height = m_height;
     jpeg_set_defaults(&m_cinfo);
+
+    if(m_isYUV422)
+    {
+        // the luma of a pixel pair is on both sides of its chroma in UYVY and before it in YUYV
+        m_yOffset = m_format == RS2_FORMAT_YUYV ? 0 : 1;
+        m_uOffset = m_format == RS2_FORMAT_YUYV ? 1 : 0;
+        m_vOffset = m_format == RS2_FORMAT_YUYV ? 3 : 2;
+
+        m_cinfo.raw_data_in = TRUE;
+        m_cinfo.comp_info[0].h_samp_factor = 2;
+        m_cinfo.comp_info[0].v_samp_factor = 1;
+        for(int component = 1; component < 3; component++)
+        {
+            m_cinfo.comp_info[component].h_samp_factor = 1;
+            m_cinfo.comp_info[component].v_samp_factor = 1;
+        }
+
+        // libjpeg reads and writes whole blocks, the planes are padded to 16 luma and 8 chroma pixels
+        m_lumaWidth = (t_width + 2 * DCTSIZE - 1) / (2 * DCTSIZE) * 2 * DCTSIZE;
+        m_chromaWidth = m_lumaWidth / 2;
+        for(int component = 0; component < 3; component++)
+        {
+            int width = component == 0 ? m_lumaWidth : m_chromaWidth;
+            m_planes[component].resize(width * DCTSIZE);
+            for(int line = 0; line < DCTSIZE; line++)
+            {
+                m_planeRows[component][line] = m_planes[component].data() + line * width;
+            }
+            m_planeArrays[component] = m_planeRows[component];
+        }
+    }
 }
 
 JpegCompression::~JpegCompression()
@@ -48,34 +83,60 @@ JpegCompression::~JpegCompression()
     jpeg_destroy_compress(&m_cinfo);
 }
 
-void JpegCompression::convertYUYVtoYUV(unsigned char** t_buffer)
+void JpegCompression::setQuality(int t_quality)
+{
+    jpeg_set_quality(&m_cinfo, t_quality, TRUE);
+}
+
+// Splits the 8 lines from t_firstLine in the planes, the lines past the frame repeat its last line
+void JpegCompression::splitYUV422(const unsigned char* t_buffer, int t_firstLine)
 {
-    for(int i = 0; i < m_cinfo.image_width; i += 2)
+    int pairs = m_width / 2;
+    for(int line = 0; line < DCTSIZE; line++)
     {
-        m_rowBuffer[i * 3] = (*t_buffer)[i * 2 + 0]; // Y
-        m_rowBuffer[i * 3 + 1] = (*t_buffer)[i * 2 + 1]; // U
-        m_rowBuffer[i * 3 + 2] = (*t_buffer)[i * 2 + 3]; // V
-        m_rowBuffer[i * 3 + 3] = (*t_buffer)[i * 2 + 2]; // Y
-        m_rowBuffer[i * 3 + 4] = (*t_buffer)[i * 2 + 1]; // U
-        m_rowBuffer[i * 3 + 5] = (*t_buffer)[i * 2 + 3]; // V
+        const unsigned char* src = t_buffer + std::min(t_firstLine + line, m_height - 1) * m_width * m_bpp;
+        unsigned char* y = m_planeRows[0][line];
+        unsigned char* u = m_planeRows[1][line];
+        unsigned char* v = m_planeRows[2][line];
+        for(int i = 0; i < pairs; i++)
+        {
+            y[i * 2] = src[i * 4 + m_yOffset];
+            y[i * 2 + 1] = src[i * 4 + m_yOffset + 2];
+            u[i] = src[i * 4 + m_uOffset];
+            v[i] = src[i * 4 + m_vOffset];
+        }
+        memset(y + pairs * 2, y[pairs * 2 - 1], m_lumaWidth - pairs * 2);
+        memset(u + pairs, u[pairs - 1], m_chromaWidth - pairs);
+        memset(v + pairs, v[pairs - 1], m_chromaWidth - pairs);
     }
-    m_row_pointer[0] = m_rowBuffer;
-    (*t_buffer) += m_cinfo.image_width * m_bpp;
 }
 
-void JpegCompression::convertUYVYtoYUV(unsigned char** t_buffer)
+void JpegCompression::mergeYUV422(unsigned char* t_uncompressBuff, int t_firstLine, int t_lines)
 {
-    for(int i = 0; i < m_cinfo.image_width; i += 2)
+    int pairs = m_width / 2;
+    for(int line = 0; line < t_lines && t_firstLine + line < m_height; line++)
     {
-        m_rowBuffer[i * 3] = (*t_buffer)[i * 2 + 1]; // Y
-        m_rowBuffer[i * 3 + 1] = (*t_buffer)[i * 2 + 0]; // U
-        m_rowBuffer[i * 3 + 2] = (*t_buffer)[i * 2 + 2]; // V
-        m_rowBuffer[i * 3 + 3] = (*t_buffer)[i * 2 + 3]; // Y
-        m_rowBuffer[i * 3 + 4] = (*t_buffer)[i * 2 + 0]; // U
-        m_rowBuffer[i * 3 + 5] = (*t_buffer)[i * 2 + 2]; // V
+        unsigned char* dst = t_uncompressBuff + (t_firstLine + line) * m_width * m_bpp;
+        const unsigned char* y = m_planeRows[0][line];
+        const unsigned char* u = m_planeRows[1][line];
+        const unsigned char* v = m_planeRows[2][line];
+        for(int i = 0; i < pairs; i++)
+        {
+            dst[i * 4 + m_yOffset] = y[i * 2];
+            dst[i * 4 + m_yOffset + 2] = y[i * 2 + 1];
+            dst[i * 4 + m_uOffset] = u[i];
+            dst[i * 4 + m_vOffset] = v[i];
+        }
     }
-    m_row_pointer[0] = m_rowBuffer;
-    (*t_buffer) += m_cinfo.image_width * m_bpp;
+}
+
+// Frames of the raw 4:2:2 sampling of this codec, the older servers sent YUYV with the default 4:2:0 sampling
+bool JpegCompression::isRawYUV422(const jpeg_decompress_struct& t_dinfo)
+{
+    return m_isYUV422 && t_dinfo.num_components == 3 && t_dinfo.jpeg_color_space == JCS_YCbCr && int(t_dinfo.image_width) == m_width &&
+           t_dinfo.comp_info[0].h_samp_factor == 2 && t_dinfo.comp_info[0].v_samp_factor == 1 &&
+           t_dinfo.comp_info[1].h_samp_factor == 1 && t_dinfo.comp_info[1].v_samp_factor == 1 &&
+           t_dinfo.comp_info[2].h_samp_factor == 1 && t_dinfo.comp_info[2].v_samp_factor == 1;
 }
 
 void JpegCompression::convertYUVtoYUYV(unsigned char** t_uncompressBuff)
@@ -127,27 +188,32 @@ void JpegCompression::convertRGBtoBGR(unsigned char** t_uncompressBuff)
 
 int JpegCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
 {
-    long unsigned int compressedSize = 0;
-    unsigned char* data = nullptr;
+    // the frame is coded after its size in the destination buffer, libjpeg allocates another buffer when it does not fit
+    unsigned char* destination = t_compressedBuf + sizeof(int);
+    unsigned char* data = destination;
+    long unsigned int compressedSize = t_size > int(sizeof(int)) ? t_size - sizeof(int) : 0;
+    if(compressedSize == 0)
+    {
+        ERR << "compression overflow, destination buffer is smaller than the compressed size";
+        return -1;
+    }
     jpeg_mem_dest(&m_cinfo, &data, &compressedSize);
-    m_cinfo.image_width = m_width;
-    m_cinfo.image_height = m_height;
     uint64_t row_stride = m_cinfo.image_width * m_cinfo.input_components;
     jpeg_start_compress(&m_cinfo, TRUE);
+    if(m_isYUV422)
+    {
+        while(m_cinfo.next_scanline < m_cinfo.image_height)
+        {
+            splitYUV422(t_buffer, m_cinfo.next_scanline);
+            jpeg_write_raw_data(&m_cinfo, m_planeArrays, DCTSIZE);
+        }
+    }
     while(m_cinfo.next_scanline < m_cinfo.image_height)
     {
         if(m_format == RS2_FORMAT_RGB8 || m_format == RS2_FORMAT_Y8)
         {
             m_row_pointer[0] = &t_buffer[m_cinfo.next_scanline * row_stride];
         }
-        else if(m_format == RS2_FORMAT_YUYV)
-        {
-            convertYUYVtoYUV(&t_buffer);
-        }
-        else if(m_format == RS2_FORMAT_UYVY)
-        {
-            convertUYVYtoYUV(&t_buffer);
-        }
         else if(m_format == RS2_FORMAT_BGR8)
         {
             convertBGRtoRGB(&t_buffer);
@@ -155,24 +221,24 @@ int JpegCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigne
         else
         {
             ERR << "unsupported format " << m_format << " for JPEG compression";
+            jpeg_abort_compress(&m_cinfo);
             return -1;
         }
         jpeg_write_scanlines(&m_cinfo, m_row_pointer, 1);
     }
     jpeg_finish_compress(&m_cinfo);
-    int compressWithHeaderSize = compressedSize + sizeof(int);
-    if(compressWithHeaderSize > t_size)
+    if(data != destination)
     {
+        free(data);
         ERR << "compression overflow, destination buffer is smaller than the compressed size";
         return -1;
     }
+    int compressWithHeaderSize = compressedSize + sizeof(int);
     memcpy(t_compressedBuf, &compressedSize, sizeof(int));
-    memcpy(t_compressedBuf + sizeof(int), data, compressedSize);
     if(m_compFrameCounter++ % 50 == 0)
     {
         INF << "frame " << m_compFrameCounter << "\tcolor\tcompression\tJPEG\t" << t_size << "\t/\t" << compressedSize;
     }
-    free(data);
     return compressWithHeaderSize;
 }
 
@@ -201,9 +267,10 @@ int JpegCompression::decompressBuffer(unsigned char* t_buffer, int t_compressedS
     {
         m_dinfo.out_color_space = JCS_RGB;
     }
-    else if(m_format == RS2_FORMAT_YUYV || m_format == RS2_FORMAT_UYVY)
+    else if(m_isYUV422)
     {
         m_dinfo.out_color_space = JCS_YCbCr;
+        m_dinfo.raw_data_out = isRawYUV422(m_dinfo) ? TRUE : FALSE;
     }
     else if(m_format == RS2_FORMAT_Y8)
     {
@@ -221,6 +288,21 @@ int JpegCompression::decompressBuffer(unsigned char* t_buffer, int t_compressedS
         return -1;
     }
     uint64_t row_stride = m_dinfo.output_width * m_dinfo.output_components;
+    if(m_dinfo.raw_data_out)
+    {
+        while(m_dinfo.output_scanline < m_dinfo.output_height)
+        {
+            int firstLine = m_dinfo.output_scanline;
+            int numLines = jpeg_read_raw_data(&m_dinfo, m_planeArrays, DCTSIZE);
+            if(numLines <= 0)
+            {
+                ERR << "jpeg_read_raw_data failed at " << numLines;
+                jpeg_abort_decompress(&m_dinfo);
+                return -1;
+            }
+            mergeYUV422(t_uncompressedBuf, firstLine, numLines);
+        }
+    }
     while(m_dinfo.output_scanline < m_dinfo.output_height)
     {
         int numLines = jpeg_read_scanlines(&m_dinfo, m_destBuffer, 1);
@@ -6,6 +6,7 @@
 #include "ICompression.h"
 #include "jpeglib.h"
 #include <time.h>
+#include <vector>
 
 class JpegCompression : public ICompression
 {
@@ -14,11 +15,15 @@ public:
     ~JpegCompression();
     int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    void setQuality(int t_quality);
 
 private:
-    void convertYUYVtoYUV(unsigned char** t_buffer);
+    // YUYV and UYVY are coded as raw 4:2:2 planes, the 8 lines of a row of blocks at a time,
+    // so libjpeg neither converts the colors nor resamples the chroma
+    void splitYUV422(const unsigned char* t_buffer, int t_firstLine);
+    void mergeYUV422(unsigned char* t_uncompressBuff, int t_firstLine, int t_lines);
+    bool isRawYUV422(const jpeg_decompress_struct& t_dinfo);
     void convertYUVtoYUYV(unsigned char** t_uncompressBuff);
-    void convertUYVYtoYUV(unsigned char** t_buffer);
     void convertYUVtoUYVY(unsigned char** t_uncompressBuff);
     void convertBGRtoRGB(unsigned char** t_buffer);
     void convertRGBtoBGR(unsigned char** t_uncompressBuff);
@@ -29,4 +34,10 @@ private:
     JSAMPROW m_row_pointer[1];
     JSAMPARRAY m_destBuffer;
     unsigned char* m_rowBuffer;
+    bool m_isYUV422;
+    int m_yOffset, m_uOffset, m_vOffset; // bytes of the components in a YUYV or UYVY pixel pair
+    int m_lumaWidth, m_chromaWidth;      // bytes of the lines of the planes, padded to whole blocks
+    std::vector<unsigned char> m_planes[3];
+    JSAMPROW m_planeRows[3][DCTSIZE];
+    JSAMPARRAY m_planeArrays[3];
 };
@@ -6,15 +6,37 @@
 #include <iostream>
 #include <ipDeviceCommon/Statistic.h>
 
-Lz4Compression::Lz4Compression(int t_width, int t_height, rs2_format t_format, int t_bpp)
+#define LZ4_ACCELERATION 1
+
+Lz4Compression::Lz4Compression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_keyInterval)
     :ICompression(t_width, t_height, t_format, t_bpp)
+    , m_keyInterval(t_bpp == 2 ? t_keyInterval : 0)
 {
+    LZ4_resetStream(&m_stream);
+    if(m_keyInterval > 0)
+    {
+        m_reference.resize(m_width * m_height);
+        m_planes.resize(m_width * m_height * sizeof(uint16_t));
+    }
 }
 
 int Lz4Compression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
 {
     const int maxDstSize = LZ4_compressBound(t_size);
-    const int compressedSize = LZ4_compress_default((const char*)t_buffer, (char*)t_compressedBuf + sizeof(int), t_size, maxDstSize);
+    int compressedSize = 0;
+    if(m_keyInterval > 0)
+    {
+        if(t_size != m_width * m_height * int(sizeof(uint16_t)))
+        {
+            ERR << "Frame size " << t_size << " does not match the stream resolution.";
+            return -1;
+        }
+        compressedSize = compressDelta((const uint16_t*)t_buffer, t_compressedBuf + sizeof(int), maxDstSize);
+    }
+    else
+    {
+        compressedSize = LZ4_compress_fast_extState(&m_stream, (const char*)t_buffer, (char*)t_compressedBuf + sizeof(int), t_size, maxDstSize, LZ4_ACCELERATION);
+    }
     if(compressedSize <= 0)
     {
         ERR << "Failure trying to compress the data.";
@@ -34,9 +56,45 @@ int Lz4Compression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned
     return compressWithHeaderSize;
 }
 
+int Lz4Compression::compressDelta(const uint16_t* t_pixels, unsigned char* t_compressedBuf, int t_maxSize)
+{
+    const int pixels = m_width * m_height;
+    const bool isKeyFrame = m_keyFrameRequested.exchange(false) || m_frame % m_keyInterval == 0;
+    unsigned char* low = m_planes.data();
+    unsigned char* high = low + pixels;
+    for(int i = 0; i < pixels; i++)
+    {
+        uint16_t delta = uint16_t(t_pixels[i] - (isKeyFrame ? 0 : m_reference[i]));
+        // zigzag, the small negative differences have small codes too
+        uint16_t code = uint16_t(delta << 1) ^ uint16_t(0 - (delta >> 15));
+        low[i] = uint8_t(code);
+        high[i] = uint8_t(code >> 8);
+    }
+    memcpy(m_reference.data(), t_pixels, pixels * sizeof(uint16_t));
+
+    DeltaHeader header = {m_frame, isKeyFrame ? m_frame : m_frame - 1};
+    memcpy(t_compressedBuf, &header, sizeof(header));
+    m_frame++;
+    int compressedSize = LZ4_compress_fast_extState(&m_stream, (const char*)m_planes.data(), (char*)t_compressedBuf + sizeof(header), int(m_planes.size()), t_maxSize - int(sizeof(header)), LZ4_ACCELERATION);
+    return compressedSize <= 0 ? compressedSize : compressedSize + int(sizeof(header));
+}
+
+void Lz4Compression::requestKeyFrame()
+{
+    m_keyFrameRequested = true;
+}
+
 int Lz4Compression::decompressBuffer(unsigned char* t_buffer, int t_compressedSize, unsigned char* t_uncompressedBuf)
 {
-    const int decompressed_size = LZ4_decompress_safe((const char*)t_buffer, (char*)t_uncompressedBuf, t_compressedSize, m_width * m_height * m_bpp);
+    int decompressed_size = 0;
+    if(m_keyInterval > 0)
+    {
+        decompressed_size = decompressDelta(t_buffer, t_compressedSize, (uint16_t*)t_uncompressedBuf);
+    }
+    else
+    {
+        decompressed_size = LZ4_decompress_safe((const char*)t_buffer, (char*)t_uncompressedBuf, t_compressedSize, m_width * m_height * m_bpp);
+    }
     if(decompressed_size < 0)
     {
         ERR << "Failure trying to decompress the frame.";
@@ -49,3 +107,44 @@ int Lz4Compression::decompressBuffer(unsigned char* t_buffer, int t_compressedSi
     }
     return decompressed_size;
 }
+
+int Lz4Compression::decompressDelta(unsigned char* t_buffer, int t_size, uint16_t* t_pixels)
+{
+    DeltaHeader header;
+    if(t_size < int(sizeof(header)))
+    {
+        return -1;
+    }
+    memcpy(&header, t_buffer, sizeof(header));
+    const bool isKeyFrame = header.m_reference == header.m_frame;
+    if(!isKeyFrame && (!m_hasReference || header.m_reference != m_frame))
+    {
+        // the referenced frame was lost, or the client joined the stream after it
+        if(m_hasReference)
+        {
+            WRN << "Depth frame " << header.m_frame << " references lost frame " << header.m_reference << ", waiting for a key frame.";
+        }
+        m_hasReference = false;
+        return -1;
+    }
+
+    const int pixels = m_width * m_height;
+    int planesSize = LZ4_decompress_safe((const char*)t_buffer + sizeof(header), (char*)m_planes.data(), t_size - int(sizeof(header)), int(m_planes.size()));
+    if(planesSize != int(m_planes.size()))
+    {
+        m_hasReference = false;
+        return -1;
+    }
+    const unsigned char* low = m_planes.data();
+    const unsigned char* high = low + pixels;
+    for(int i = 0; i < pixels; i++)
+    {
+        uint16_t code = uint16_t(low[i] | (high[i] << 8));
+        uint16_t delta = uint16_t(code >> 1) ^ uint16_t(0 - (code & 1));
+        t_pixels[i] = uint16_t((isKeyFrame ? 0 : m_reference[i]) + delta);
+    }
+    memcpy(m_reference.data(), t_pixels, pixels * sizeof(uint16_t));
+    m_frame = header.m_frame;
+    m_hasReference = true;
+    return pixels * int(sizeof(uint16_t));
+}
@@ -6,10 +6,38 @@
 #include "ICompression.h"
 #include <lz4.h>
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// LZ4 codes each frame alone, or with t_keyInterval > 0 the 16 bit frames are coded as the difference from the previous frame.
+// The zigzag differences are split in a plane of low bytes and a plane of high bytes before LZ4, so the pixels that did not
+// change or changed a little give long runs. Every t_keyInterval frames and when a client joins the stream a key frame is coded
+// from a zero frame, a client losing a frame drops the frames until the next key frame
 class Lz4Compression : public ICompression
 {
 public:
-    Lz4Compression(int t_width, int t_height, rs2_format t_format, int t_bpp);
+    Lz4Compression(int t_width, int t_height, rs2_format t_format, int t_bpp, int t_keyInterval = 0);
     int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    void requestKeyFrame();
+
+private:
+    // in front of the LZ4 data of the delta coded frames, a key frame references itself
+    struct DeltaHeader
+    {
+        uint32_t m_frame;
+        uint32_t m_reference;
+    };
+
+    int compressDelta(const uint16_t* t_pixels, unsigned char* t_compressedBuf, int t_maxSize);
+    int decompressDelta(unsigned char* t_buffer, int t_size, uint16_t* t_pixels);
+
+    LZ4_stream_t m_stream; // reused by the frames, LZ4 resets it without allocating
+    int m_keyInterval;
+    std::atomic<bool> m_keyFrameRequested{false};
+    uint32_t m_frame = 0; // next frame coded on the server, last frame decoded on the client
+    bool m_hasReference = false; // the decoder holds the frame referenced by the next delta frame
+    std::vector<uint16_t> m_reference; // previous frame, source on the server and decoded on the client
+    std::vector<unsigned char> m_planes;
 };
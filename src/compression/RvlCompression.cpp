@@ -2,94 +2,346 @@
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
 #include "RvlCompression.h"
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <ipDeviceCommon/Statistic.h>
 
-RvlCompression::RvlCompression(int t_width, int t_height, rs2_format t_format, int t_bpp)
-    :ICompression(t_width, t_height, t_format, t_bpp)
+#define RVL_MAX_THREADS 4
+#define RVL_MAX_STRIPES 64
+
+RvlStripeWorkers::RvlStripeWorkers(int t_threads)
+{
+    for(int i = 1; i < t_threads; i++)
+    {
+        m_threads.emplace_back(&RvlStripeWorkers::workerLoop, this, i);
+    }
+}
+
+RvlStripeWorkers::~RvlStripeWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_startCv.notify_all();
+    for(auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void RvlStripeWorkers::run(const std::function<void(int)>& t_task)
 {
+    if(m_threads.empty())
+    {
+        t_task(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &t_task;
+        m_pending = int(m_threads.size());
+        m_generation++;
+    }
+    m_startCv.notify_all();
+    t_task(0);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, [this] { return m_pending == 0; });
 }
 
-int RvlCompression::encodeVLE(int t_value)
+void RvlStripeWorkers::workerLoop(int t_stripe)
 {
-    do
-    {
-        int nibble = t_value & 0x7; // lower 3 bits
-        if(t_value >>= 3)
-            nibble |= 0x8; // more to come
-        m_word <<= 4;
-        m_word |= nibble;
-        if(++m_nibblesWritten == 8) // output word
+    unsigned generation = 0;
+    while(true)
+    {
+        const std::function<void(int)>* task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCv.wait(lock, [&] { return m_stop || m_generation != generation; });
+            if(m_stop)
+            {
+                return;
+            }
+            generation = m_generation;
+            task = m_task;
+        }
+        (*task)(t_stripe);
         {
-            *m_pBuffer++ = m_word;
-            m_nibblesWritten = 0;
-            m_word = 0;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(--m_pending == 0)
+            {
+                m_doneCv.notify_one();
+            }
         }
-    } while(t_value);
+    }
+}
 
-    return 0;
+namespace
+{
+    // The variable length code of a value is its 3 bit groups from the lsb, one per nibble, with the msb of the nibble set when more groups follow.
+    // The nibbles fill 32 bit words from the msb
+    // Codes of the values below 4096, up to 4 nibbles, in the order they are written
+    struct VleTable
+    {
+        uint16_t m_codes[4096];
+        uint8_t m_nibbles[4096];
+
+        VleTable()
+        {
+            for(uint32_t value = 0; value < 4096; value++)
+            {
+                uint32_t code = 0, rest = value;
+                int nibbles = 0;
+                do
+                {
+                    uint32_t nibble = rest & 0x7;
+                    if(rest >>= 3)
+                        nibble |= 0x8; // more to come
+                    code = (code << 4) | nibble;
+                    nibbles++;
+                } while(rest);
+                m_codes[value] = uint16_t(code);
+                m_nibbles[value] = uint8_t(nibbles);
+            }
+        }
+    };
+
+    const VleTable& getVleTable()
+    {
+        static const VleTable table;
+        return table;
+    }
+
+    struct VleWriter
+    {
+        uint32_t* m_out;
+        uint32_t m_word;
+        int m_nibbles;
+        const VleTable& m_table;
+
+        void put(uint32_t t_value)
+        {
+            if(t_value < 4096)
+            {
+                uint32_t code = m_table.m_codes[t_value];
+                int nibbles = m_table.m_nibbles[t_value];
+                if(m_nibbles + nibbles < 8)
+                {
+                    m_word = (m_word << 4 * nibbles) | code;
+                    m_nibbles += nibbles;
+                }
+                else
+                {
+                    // the word is at least half full, so none of the shifts is by 32 bits
+                    int first = 8 - m_nibbles;
+                    int rest = nibbles - first;
+                    *m_out++ = (m_word << 4 * first) | (code >> 4 * rest);
+                    m_word = code & ((1u << 4 * rest) - 1);
+                    m_nibbles = rest;
+                }
+                return;
+            }
+
+            do
+            {
+                uint32_t nibble = t_value & 0x7;
+                if(t_value >>= 3)
+                    nibble |= 0x8; // more to come
+                m_word = (m_word << 4) | nibble;
+                if(++m_nibbles == 8)
+                {
+                    *m_out++ = m_word;
+                    m_nibbles = 0;
+                    m_word = 0;
+                }
+            } while(t_value);
+        }
+
+        void flush()
+        {
+            if(m_nibbles) // last few values
+                *m_out++ = m_word << 4 * (8 - m_nibbles);
+        }
+    };
+
+    struct VleReader
+    {
+        const uint32_t* m_in;
+        const uint32_t* m_end;
+        uint32_t m_word;
+        int m_nibbles;
+        bool m_error;
+
+        uint32_t get()
+        {
+            uint32_t value = 0, nibble;
+            int shift = 0;
+            do
+            {
+                if(!m_nibbles)
+                {
+                    if(m_in == m_end || shift > 30)
+                    {
+                        m_error = true;
+                        return 0;
+                    }
+                    m_word = *m_in++;
+                    m_nibbles = 8;
+                }
+                nibble = m_word >> 28;
+                m_word <<= 4;
+                m_nibbles--;
+                value |= (nibble & 0x7) << shift;
+                shift += 3;
+            } while(nibble & 0x8);
+            return value;
+        }
+    };
+
+    uint64_t load4Pixels(const uint16_t* t_pixels)
+    {
+        uint64_t pixels;
+        memcpy(&pixels, t_pixels, sizeof(pixels));
+        return pixels;
+    }
+
+    // True when one of the 4 pixels packed in t_pixels is zero
+    bool hasZeroPixel(uint64_t t_pixels)
+    {
+        return ((t_pixels - 0x0001000100010001ull) & ~t_pixels & 0x8000800080008000ull) != 0;
+    }
 }
 
-int RvlCompression::decodeVLE()
+RvlCompression::RvlCompression(int t_width, int t_height, rs2_format t_format, int t_bpp)
+    : ICompression(t_width, t_height, t_format, t_bpp)
+    , m_workers(std::max(1, std::min<int>(RVL_MAX_THREADS, std::thread::hardware_concurrency())))
 {
-    unsigned int nibble;
-    int value = 0, bits = 29;
-    do
+    int pixels = t_width * t_height;
+    m_stripes.resize(m_workers.size());
+    for(int i = 0; i < m_workers.size(); i++)
     {
-        if(!m_nibblesWritten)
+        int count = getStripeBegin(i + 1, m_workers.size(), pixels) - getStripeBegin(i, m_workers.size(), pixels);
+        // the codes of a pixel, its delta and the run lengths that precede it, fit in 2 words
+        m_stripes[i].m_words.resize(2 * count + 2);
+        m_stripes[i].m_deltas.resize(count);
+    }
+}
+
+int RvlCompression::getStripeBegin(int t_stripe, int t_stripes, int t_pixels)
+{
+    return int((long long)t_pixels * t_stripe / t_stripes);
+}
+
+void RvlCompression::compressStripe(const uint16_t* t_pixels, int t_count, Stripe& t_stripe)
+{
+    VleWriter writer = {t_stripe.m_words.data(), 0, 0, getVleTable()};
+    uint32_t* deltas = t_stripe.m_deltas.data();
+    const uint16_t* p = t_pixels;
+    const uint16_t* end = t_pixels + t_count;
+    uint16_t previous = 0;
+    while(p != end)
+    {
+        // the runs are scanned 4 pixels at a time
+        const uint16_t* run = p;
+        while(end - p >= 4 && load4Pixels(p) == 0)
+            p += 4;
+        while(p != end && !*p)
+            p++;
+        writer.put(uint32_t(p - run));
+
+        run = p;
+        while(end - p >= 4 && !hasZeroPixel(load4Pixels(p)))
+            p += 4;
+        while(p != end && *p)
+            p++;
+        int nonzeros = int(p - run);
+        writer.put(nonzeros);
+        if(nonzeros)
         {
-            m_word = *m_pBuffer++; // load word
-            m_nibblesWritten = 8;
+            // Inside a run the previous nonzero pixel is the previous pixel, so the deltas are computed in a loop the compiler vectorizes
+            int delta = int(run[0]) - int(previous);
+            deltas[0] = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+            for(int i = 1; i < nonzeros; i++)
+            {
+                delta = int(run[i]) - int(run[i - 1]);
+                deltas[i] = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+            }
+            for(int i = 0; i < nonzeros; i++)
+                writer.put(deltas[i]);
+            previous = run[nonzeros - 1];
         }
-        nibble = m_word & 0xf0000000;
-        value |= (nibble << 1) >> bits;
-        m_word <<= 4;
-        m_nibblesWritten--;
-        bits -= 3;
-    } while(nibble & 0x80000000);
-    return value;
+    }
+    writer.flush();
+    t_stripe.m_size = int(writer.m_out - t_stripe.m_words.data());
 }
 
-int RvlCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+int RvlCompression::decompressStripe(const uint32_t* t_words, int t_size, uint16_t* t_pixels, int t_count)
 {
-    short* buffer2 = (short*)t_buffer;
-    int* pHead = m_pBuffer = (int*)t_compressedBuf + 1;
-    m_nibblesWritten = 0;
-    short* end = buffer2 + t_size / m_bpp;
-    short previous = 0;
-    while(buffer2 != end)
-    {
-        int zeros = 0, nonzeros = 0;
-        for(; (buffer2 != end) && !*buffer2; buffer2++, zeros++)
-            ;
-        encodeVLE(zeros);
-        for(short* p = buffer2; (p != end) && *p++; nonzeros++)
-            ;
-        encodeVLE(nonzeros);
-        for(int i = 0; i < nonzeros; i++)
+    VleReader reader = {t_words, t_words + t_size, 0, 0, false};
+    uint16_t* p = t_pixels;
+    uint16_t* end = t_pixels + t_count;
+    int previous = 0;
+    while(p != end)
+    {
+        uint32_t zeros = reader.get();
+        if(reader.m_error || zeros > uint32_t(end - p))
+            return -1;
+        memset(p, 0, zeros * sizeof(uint16_t));
+        p += zeros;
+
+        uint32_t nonzeros = reader.get();
+        if(reader.m_error || nonzeros > uint32_t(end - p))
+            return -1;
+        for(; nonzeros; nonzeros--)
         {
-            short current = *buffer2++;
-            int delta = current - previous;
-            int positive = (delta << 1) ^ (delta >> 31);
-            encodeVLE(positive);
-            previous = current;
+            uint32_t positive = reader.get();
+            int delta = int(positive >> 1) ^ -int(positive & 1);
+            previous += delta;
+            *p++ = uint16_t(previous);
         }
+        if(reader.m_error)
+            return -1;
+    }
+    return 0;
+}
+
+int RvlCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    const uint16_t* pixels = (const uint16_t*)t_buffer;
+    int pixelCount = std::min(t_size / int(sizeof(uint16_t)), m_width * m_height);
+    int stripes = int(m_stripes.size());
+    m_workers.run([&](int t_stripe) {
+        int begin = getStripeBegin(t_stripe, stripes, pixelCount);
+        compressStripe(pixels + begin, getStripeBegin(t_stripe + 1, stripes, pixelCount) - begin, m_stripes[t_stripe]);
+    });
+
+    int compressedSize = int(sizeof(uint32_t)) * (1 + stripes);
+    for(auto& stripe : m_stripes)
+    {
+        compressedSize += stripe.m_size * int(sizeof(uint32_t));
     }
-    if(m_nibblesWritten) // last few values
-        *m_pBuffer++ = m_word << 4 * (8 - m_nibblesWritten);
-    int compressedSize = int((char*)m_pBuffer - (char*)pHead);
     int compressWithHeaderSize = compressedSize + sizeof(compressedSize);
     if(compressWithHeaderSize > t_size)
     {
         ERR << "Compression overflow, destination buffer is smaller than the compressed size";
         return -1;
     }
-    memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
+
+    uint32_t* header = (uint32_t*)(t_compressedBuf + sizeof(compressedSize));
+    header[0] = stripes;
+    unsigned char* data = (unsigned char*)(header + 1 + stripes);
+    for(int i = 0; i < stripes; i++)
+    {
+        header[1 + i] = m_stripes[i].m_size * sizeof(uint32_t);
+        memcpy(data, m_stripes[i].m_words.data(), header[1 + i]);
+        data += header[1 + i];
+    }
     if(m_compFrameCounter++ % 50 == 0)
     {
-        INF << "frame " << m_compFrameCounter << "\tdepth\tcompression\tlz4\t" << t_size << "\t/\t" << compressedSize;
+        INF << "frame " << m_compFrameCounter << "\tdepth\tcompression\trvl\t" << t_size << "\t/\t" << compressedSize;
     }
     memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
     return compressWithHeaderSize;
@@ -97,33 +349,50 @@ int RvlCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned
 
 int RvlCompression::decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf)
 {
-    short* currentPtr = (short*)t_uncompressedBuf;
-    m_pBuffer = (int*)t_buffer + 1;
-    m_nibblesWritten = 0;
-    short current, previous = 0;
-    unsigned int compressedSize;
-    int numPixelsToDecode = t_size / 2;
-    while(numPixelsToDecode)
-    {
-        int zeros = decodeVLE();
-        numPixelsToDecode -= zeros;
-        for(; zeros; zeros--)
-            *currentPtr++ = 0;
-        int nonzeros = decodeVLE();
-        numPixelsToDecode -= nonzeros;
-        for(; nonzeros; nonzeros--)
+    int pixelCount = m_width * m_height;
+    const uint32_t* header = (const uint32_t*)t_buffer;
+    uint32_t stripes = t_size >= int(sizeof(uint32_t)) ? header[0] : 0;
+    if(stripes == 0 || stripes > RVL_MAX_STRIPES || (1 + stripes) * sizeof(uint32_t) > uint32_t(t_size))
+    {
+        ERR << "Corrupted RVL frame header";
+        return -1;
+    }
+
+    std::vector<const uint32_t*> stripeWords(stripes);
+    const unsigned char* data = (const unsigned char*)(header + 1 + stripes);
+    size_t available = t_size - (1 + stripes) * sizeof(uint32_t);
+    for(uint32_t i = 0; i < stripes; i++)
+    {
+        if(header[1 + i] % sizeof(uint32_t) || header[1 + i] > available)
         {
-            int positive = decodeVLE();
-            int delta = (positive >> 1) ^ -(positive & 1);
-            current = previous + delta;
-            *currentPtr++ = current;
-            previous = current;
+            ERR << "Corrupted RVL frame header";
+            return -1;
         }
+        stripeWords[i] = (const uint32_t*)data;
+        data += header[1 + i];
+        available -= header[1 + i];
     }
-    int uncompressedSize = int((char*)currentPtr - (char*)t_uncompressedBuf);
+
+    // The stripes may be more than the workers when the sender has more cores
+    std::vector<int> results(stripes);
+    int workers = m_workers.size();
+    m_workers.run([&](int t_worker) {
+        for(uint32_t i = t_worker; i < stripes; i += workers)
+        {
+            int begin = getStripeBegin(i, stripes, pixelCount);
+            results[i] = decompressStripe(stripeWords[i], header[1 + i] / sizeof(uint32_t), (uint16_t*)t_uncompressedBuf + begin, getStripeBegin(i + 1, stripes, pixelCount) - begin);
+        }
+    });
+    if(std::find(results.begin(), results.end(), -1) != results.end())
+    {
+        ERR << "Corrupted RVL frame";
+        return -1;
+    }
+
+    int uncompressedSize = pixelCount * sizeof(uint16_t);
     if(m_decompFrameCounter++ % 50 == 0)
     {
-        INF << "frame " << m_decompFrameCounter << "\tdepth\tcompression\tlz4\t" << compressedSize << "\t/\t" << uncompressedSize;
+        INF << "frame " << m_decompFrameCounter << "\tdepth\tdecompression\trvl\t" << t_size << "\t/\t" << uncompressedSize;
     }
     return uncompressedSize;
 }
@@ -5,6 +5,40 @@
 
 #include "ICompression.h"
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs the stripes of a frame on persistent threads, the calling thread codes the first stripe
+class RvlStripeWorkers
+{
+public:
+    RvlStripeWorkers(int t_threads);
+    ~RvlStripeWorkers();
+    int size()
+    {
+        return int(m_threads.size()) + 1;
+    }
+    // Calls t_task for the stripes 0 to size() - 1 and returns when all of them are done
+    void run(const std::function<void(int)>& t_task);
+
+private:
+    void workerLoop(int t_stripe);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_startCv, m_doneCv;
+    const std::function<void(int)>* m_task = nullptr;
+    unsigned m_generation = 0;
+    int m_pending = 0;
+    bool m_stop = false;
+};
+
+// RVL codes the runs of zero pixels and the zigzag deltas between the nonzero pixels with a 4 bit variable length code.
+// The frame is split in stripes coded independently on several threads, the compressed frame is
+// the stripe count, the size of each stripe in bytes and the stripes
 class RvlCompression : public ICompression
 {
 public:
@@ -13,7 +47,17 @@ public:
     int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
 
 private:
-    int encodeVLE(int value);
-    int decodeVLE();
-    int *m_pBuffer, m_word, m_nibblesWritten;
+    struct Stripe
+    {
+        std::vector<uint32_t> m_words;
+        std::vector<uint32_t> m_deltas;
+        int m_size; // words coded in the last frame
+    };
+
+    static int getStripeBegin(int t_stripe, int t_stripes, int t_pixels);
+    void compressStripe(const uint16_t* t_pixels, int t_count, Stripe& t_stripe);
+    int decompressStripe(const uint32_t* t_words, int t_size, uint16_t* t_pixels, int t_count);
+
+    RvlStripeWorkers m_workers;
+    std::vector<Stripe> m_stripes;
 };
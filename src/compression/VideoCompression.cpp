@@ -0,0 +1,356 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "VideoCompression.h"
+#include "CompressionFactory.h"
+
+extern "C"
+{
+#include <libavutil/opt.h>
+}
+
+#include <cstring>
+
+#define VIDEO_BITS_PER_PIXEL 0.1 // default bitrate, about 6 Mbps for 1080p at 30 fps
+#define VIDEO_DEFAULT_FPS 30
+
+static AVPixelFormat toPixelFormat(rs2_format t_format)
+{
+    switch(t_format)
+    {
+    case RS2_FORMAT_RGB8:
+        return AV_PIX_FMT_RGB24;
+    case RS2_FORMAT_BGR8:
+        return AV_PIX_FMT_BGR24;
+    case RS2_FORMAT_YUYV:
+        return AV_PIX_FMT_YUYV422;
+    case RS2_FORMAT_UYVY:
+        return AV_PIX_FMT_UYVY422;
+    default:
+        return AV_PIX_FMT_NONE;
+    }
+}
+
+static bool supportsPixelFormat(const AVCodec* t_codec, AVPixelFormat t_format)
+{
+    for(const AVPixelFormat* format = t_codec->pix_fmts; format && *format != AV_PIX_FMT_NONE; format++)
+    {
+        if(*format == t_format)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+VideoCompression::VideoCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, bool t_hevc, int t_bitrate, int t_fps)
+    : ICompression(t_width, t_height, t_format, t_bpp)
+    , m_hevc(t_hevc)
+    , m_fps(t_fps > 0 ? t_fps : VIDEO_DEFAULT_FPS)
+    , m_streamFormat(toPixelFormat(t_format))
+{
+    m_bitrate = t_bitrate > 0 ? t_bitrate : int(t_width * t_height * m_fps * VIDEO_BITS_PER_PIXEL / 1000);
+    if(m_streamFormat == AV_PIX_FMT_NONE)
+    {
+        ERR << "unsupported format " << t_format << " for video compression";
+    }
+}
+
+VideoCompression::~VideoCompression()
+{
+    closeEncoder();
+    avcodec_free_context(&m_decoder);
+    av_frame_free(&m_decodeFrame);
+    sws_freeContext(m_fromDecoder);
+}
+
+bool VideoCompression::openEncoder()
+{
+    static const char* h264[] = {"h264_v4l2m2m", "h264_nvenc", "h264_vaapi", "libx264"};
+    static const char* h265[] = {"hevc_v4l2m2m", "hevc_nvenc", "hevc_vaapi", "libx265"};
+    const char** names = m_hevc ? h265 : h264;
+    for(int i = 0; i < 4; i++)
+    {
+        const char* name = names[i];
+        if(openEncoder(name))
+        {
+            INF << "video compression with " << name << " at " << m_bitrate << " kbps";
+            return true;
+        }
+        closeEncoder();
+    }
+    ERR << "no " << (m_hevc ? "H.265" : "H.264") << " encoder could be opened";
+    return false;
+}
+
+bool VideoCompression::openEncoder(const char* t_name)
+{
+    const AVCodec* codec = avcodec_find_encoder_by_name(t_name);
+    if(!codec)
+    {
+        return false;
+    }
+    m_encoder = avcodec_alloc_context3(codec);
+    if(!m_encoder)
+    {
+        return false;
+    }
+
+    const bool isVaapi = strstr(t_name, "vaapi") != nullptr;
+    AVPixelFormat format = supportsPixelFormat(codec, AV_PIX_FMT_NV12) || isVaapi ? AV_PIX_FMT_NV12 : AV_PIX_FMT_YUV420P;
+    m_encoder->width = m_width;
+    m_encoder->height = m_height;
+    m_encoder->time_base = {1, m_fps};
+    m_encoder->framerate = {m_fps, 1};
+    m_encoder->pix_fmt = format;
+    m_encoder->gop_size = VIDEO_DEFAULT_KEY_INTERVAL;
+    m_encoder->max_b_frames = 0;
+    m_encoder->bit_rate = int64_t(m_bitrate) * 1000;
+    m_encoder->rc_max_rate = m_encoder->bit_rate;
+    // a buffer of a frame, a key frame is spread over the following frames instead of bursting
+    m_encoder->rc_buffer_size = int(m_encoder->bit_rate / m_fps);
+
+    // The options of the encoders that do not have them are ignored
+    av_opt_set(m_encoder->priv_data, "preset", strstr(t_name, "nvenc") ? "p1" : "ultrafast", 0);
+    av_opt_set(m_encoder->priv_data, "tune", strstr(t_name, "nvenc") ? "ull" : "zerolatency", 0);
+    av_opt_set(m_encoder->priv_data, "zerolatency", "1", 0);
+    av_opt_set(m_encoder->priv_data, "delay", "0", 0);
+    av_opt_set(m_encoder->priv_data, "forced-idr", "1", 0);
+    av_opt_set(m_encoder->priv_data, "async_depth", "1", 0);
+
+    if(isVaapi)
+    {
+        if(av_hwdevice_ctx_create(&m_hwDevice, AV_HWDEVICE_TYPE_VAAPI, nullptr, nullptr, 0) < 0)
+        {
+            return false;
+        }
+        AVBufferRef* frames = av_hwframe_ctx_alloc(m_hwDevice);
+        if(!frames)
+        {
+            return false;
+        }
+        AVHWFramesContext* framesContext = (AVHWFramesContext*)frames->data;
+        framesContext->format = AV_PIX_FMT_VAAPI;
+        framesContext->sw_format = AV_PIX_FMT_NV12;
+        framesContext->width = m_width;
+        framesContext->height = m_height;
+        framesContext->initial_pool_size = 4;
+        if(av_hwframe_ctx_init(frames) < 0)
+        {
+            av_buffer_unref(&frames);
+            return false;
+        }
+        m_encoder->pix_fmt = AV_PIX_FMT_VAAPI;
+        m_encoder->hw_frames_ctx = frames;
+        m_hwFrame = av_frame_alloc();
+    }
+
+    if(avcodec_open2(m_encoder, codec, nullptr) < 0)
+    {
+        return false;
+    }
+
+    m_encodeFrame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    if(!m_encodeFrame || !m_packet || (isVaapi && !m_hwFrame))
+    {
+        return false;
+    }
+    m_encodeFrame->format = format;
+    m_encodeFrame->width = m_width;
+    m_encodeFrame->height = m_height;
+    if(av_frame_get_buffer(m_encodeFrame, 0) < 0)
+    {
+        return false;
+    }
+    m_toEncoder = sws_getContext(m_width, m_height, m_streamFormat, m_width, m_height, format, SWS_POINT, nullptr, nullptr, nullptr);
+    return m_toEncoder != nullptr;
+}
+
+void VideoCompression::closeEncoder()
+{
+    avcodec_free_context(&m_encoder);
+    av_buffer_unref(&m_hwDevice);
+    av_frame_free(&m_encodeFrame);
+    av_frame_free(&m_hwFrame);
+    av_packet_free(&m_packet);
+    sws_freeContext(m_toEncoder);
+    m_toEncoder = nullptr;
+}
+
+void VideoCompression::requestKeyFrame()
+{
+    m_keyFrameRequested = true;
+}
+
+int VideoCompression::compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf)
+{
+    if(!m_encoder)
+    {
+        if(m_encoderFailed || m_streamFormat == AV_PIX_FMT_NONE)
+        {
+            return -1;
+        }
+        if(!openEncoder())
+        {
+            m_encoderFailed = true;
+            return -1;
+        }
+    }
+    if(t_size != m_width * m_height * m_bpp)
+    {
+        ERR << "Frame size " << t_size << " does not match the stream resolution.";
+        return -1;
+    }
+
+    if(av_frame_make_writable(m_encodeFrame) < 0)
+    {
+        return -1;
+    }
+    const uint8_t* source[] = {t_buffer};
+    const int sourceStride[] = {m_width * m_bpp};
+    sws_scale(m_toEncoder, source, sourceStride, 0, m_height, m_encodeFrame->data, m_encodeFrame->linesize);
+
+    AVFrame* frame = m_encodeFrame;
+    if(m_hwFrame)
+    {
+        av_frame_unref(m_hwFrame);
+        if(av_hwframe_get_buffer(m_encoder->hw_frames_ctx, m_hwFrame, 0) < 0 || av_hwframe_transfer_data(m_hwFrame, m_encodeFrame, 0) < 0)
+        {
+            ERR << "Failure trying to upload the frame to the encoder.";
+            return -1;
+        }
+        frame = m_hwFrame;
+    }
+    frame->pts = m_pts++;
+    frame->pict_type = m_keyFrameRequested.exchange(false) ? AV_PICTURE_TYPE_I : AV_PICTURE_TYPE_NONE;
+
+    int result = avcodec_send_frame(m_encoder, frame);
+    if(result >= 0)
+    {
+        result = avcodec_receive_packet(m_encoder, m_packet);
+    }
+    if(result == AVERROR(EAGAIN))
+    {
+        // the encoder holds the frame, its packet comes out with a following frame
+        return -1;
+    }
+    if(result < 0)
+    {
+        ERR << "Failure trying to compress the frame.";
+        return -1;
+    }
+
+    const bool isKeyFrame = (m_packet->flags & AV_PKT_FLAG_KEY) != 0;
+    int compressedSize = m_packet->size + int(sizeof(VideoHeader));
+    int compressWithHeaderSize = compressedSize + sizeof(compressedSize);
+    if(compressWithHeaderSize > t_size)
+    {
+        ERR << "Compression overflow, destination buffer is smaller than the compressed size.";
+        av_packet_unref(m_packet);
+        return -1;
+    }
+
+    // the packets are numbered, a packet of a frame held by the encoder comes with the following frame
+    VideoHeader header = {m_frame, isKeyFrame ? m_frame : m_frame - 1};
+    m_frame++;
+    memcpy(t_compressedBuf, &compressedSize, sizeof(compressedSize));
+    memcpy(t_compressedBuf + sizeof(compressedSize), &header, sizeof(header));
+    memcpy(t_compressedBuf + sizeof(compressedSize) + sizeof(header), m_packet->data, m_packet->size);
+    av_packet_unref(m_packet);
+
+    if(m_compFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_compFrameCounter << "\tcolor\tcompression\t" << (m_hevc ? "h265" : "h264") << "\t" << t_size << "\t/\t" << compressedSize;
+    }
+    return compressWithHeaderSize;
+}
+
+bool VideoCompression::openDecoder()
+{
+    const AVCodec* codec = avcodec_find_decoder(m_hevc ? AV_CODEC_ID_HEVC : AV_CODEC_ID_H264);
+    if(!codec)
+    {
+        ERR << "no " << (m_hevc ? "H.265" : "H.264") << " decoder";
+        return false;
+    }
+    m_decoder = avcodec_alloc_context3(codec);
+    if(!m_decoder)
+    {
+        return false;
+    }
+    // a frame out for every packet in, the threads split the slices of a frame instead of holding several frames
+    m_decoder->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    m_decoder->thread_type = FF_THREAD_SLICE;
+    if(avcodec_open2(m_decoder, codec, nullptr) < 0)
+    {
+        ERR << "Failure trying to open the decoder.";
+        avcodec_free_context(&m_decoder);
+        return false;
+    }
+    m_decodeFrame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    return m_decodeFrame && m_packet;
+}
+
+int VideoCompression::decompressBuffer(unsigned char* t_buffer, int t_compressedSize, unsigned char* t_uncompressedBuf)
+{
+    if(m_streamFormat == AV_PIX_FMT_NONE || (!m_decoder && !openDecoder()))
+    {
+        return -1;
+    }
+
+    VideoHeader header;
+    if(t_compressedSize < int(sizeof(header)))
+    {
+        return -1;
+    }
+    memcpy(&header, t_buffer, sizeof(header));
+    const bool isKeyFrame = header.m_reference == header.m_frame;
+    if(!isKeyFrame && (!m_hasReference || header.m_reference != m_frame))
+    {
+        // the referenced frame was lost, or the client joined the stream after it
+        if(m_hasReference)
+        {
+            WRN << "Color frame " << header.m_frame << " references lost frame " << header.m_reference << ", waiting for a key frame.";
+        }
+        m_hasReference = false;
+        return -1;
+    }
+
+    const int packetSize = t_compressedSize - int(sizeof(header));
+    m_packetBuffer.resize(packetSize + AV_INPUT_BUFFER_PADDING_SIZE);
+    memcpy(m_packetBuffer.data(), t_buffer + sizeof(header), packetSize);
+    memset(m_packetBuffer.data() + packetSize, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+    m_packet->data = m_packetBuffer.data();
+    m_packet->size = packetSize;
+    int result = avcodec_send_packet(m_decoder, m_packet);
+    if(result >= 0)
+    {
+        result = avcodec_receive_frame(m_decoder, m_decodeFrame);
+    }
+    if(result < 0 || m_decodeFrame->width != m_width || m_decodeFrame->height != m_height)
+    {
+        ERR << "Failure trying to decompress the frame.";
+        m_hasReference = false;
+        return -1;
+    }
+    m_frame = header.m_frame;
+    m_hasReference = true;
+
+    m_fromDecoder = sws_getCachedContext(m_fromDecoder, m_width, m_height, AVPixelFormat(m_decodeFrame->format), m_width, m_height, m_streamFormat, SWS_POINT, nullptr, nullptr, nullptr);
+    if(!m_fromDecoder)
+    {
+        return -1;
+    }
+    uint8_t* destination[] = {t_uncompressedBuf};
+    const int destinationStride[] = {m_width * m_bpp};
+    sws_scale(m_fromDecoder, m_decodeFrame->data, m_decodeFrame->linesize, 0, m_height, destination, destinationStride);
+    av_frame_unref(m_decodeFrame);
+
+    if(m_decompFrameCounter++ % 50 == 0)
+    {
+        INF << "frame " << m_decompFrameCounter << "\tcolor\tdecompression\t" << (m_hevc ? "h265" : "h264") << "\t" << t_compressedSize << "\t/\t" << m_width * m_height * m_bpp;
+    }
+    return m_width * m_height * m_bpp;
+}
@@ -0,0 +1,68 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "ICompression.h"
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavutil/hwcontext.h>
+#include <libswscale/swscale.h>
+}
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// H.264 or H.265 of the color streams through FFmpeg, for links too narrow for a JPEG per frame.
+// The server tries the hardware encoders first, V4L2 M2M, NVENC then VA-API, and falls back to libx264 or libx265.
+// The encoders are set for low latency: no B frames, no lookahead, a packet out for every frame in, so a frame is sent as soon as it
+// is captured. A key frame is coded every VIDEO_DEFAULT_KEY_INTERVAL frames and when a client joins the stream, a client losing a
+// frame drops the frames until the next key frame. The client decodes with the decoder of FFmpeg and converts back to the stream format
+class VideoCompression : public ICompression
+{
+public:
+    VideoCompression(int t_width, int t_height, rs2_format t_format, int t_bpp, bool t_hevc, int t_bitrate, int t_fps);
+    ~VideoCompression();
+    int compressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_compressedBuf);
+    int decompressBuffer(unsigned char* t_buffer, int t_size, unsigned char* t_uncompressedBuf);
+    void requestKeyFrame();
+
+private:
+    // in front of the coded frame, a key frame references itself
+    struct VideoHeader
+    {
+        uint32_t m_frame;
+        uint32_t m_reference;
+    };
+
+    // The encoder and the decoder are opened on first use, the server only encodes and the client only decodes
+    bool openEncoder();
+    bool openEncoder(const char* t_name);
+    bool openDecoder();
+    void closeEncoder();
+
+    bool m_hevc;
+    int m_bitrate; // kbps
+    int m_fps;
+    AVPixelFormat m_streamFormat;
+
+    AVCodecContext* m_encoder = nullptr;
+    AVBufferRef* m_hwDevice = nullptr; // VA-API, the frames are uploaded to the surfaces of the encoder
+    AVFrame* m_encodeFrame = nullptr;
+    AVFrame* m_hwFrame = nullptr;
+    AVPacket* m_packet = nullptr;
+    SwsContext* m_toEncoder = nullptr;
+    bool m_encoderFailed = false;
+    std::atomic<bool> m_keyFrameRequested{false};
+    int64_t m_pts = 0; // frames sent to the encoder
+    uint32_t m_frame = 0; // next packet coded on the server, last frame decoded on the client
+
+    AVCodecContext* m_decoder = nullptr;
+    AVFrame* m_decodeFrame = nullptr;
+    SwsContext* m_fromDecoder = nullptr;
+    std::vector<uint8_t> m_packetBuffer; // the decoder reads past the end of the packet, the padding is zeroed
+    bool m_hasReference = false; // the decoder holds the frame referenced by the next frame
+};
@@ -8,6 +8,13 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <unordered_map>
+#include <vector>
 
 const int QUEUE_MAX_SIZE = 10;
 // Simplest implementation of a blocking concurrent queue for thread messaging
@@ -21,6 +28,8 @@ class single_consumer_queue
 
     unsigned int _cap;
     bool _accepting;
+    std::atomic<unsigned long long> _dropped;
+    std::function<void(T&)> _on_drop;
 
     // flush mechanism is required to abort wait on cv
     // when need to stop
@@ -28,9 +37,16 @@ class single_consumer_queue
     std::atomic<bool> _was_flushed;
 public:
     explicit single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE)
-        : _queue(), _mutex(), _deq_cv(), _enq_cv(), _cap(cap), _accepting(true), _need_to_flush(false), _was_flushed(false)
+        : _queue(), _mutex(), _deq_cv(), _enq_cv(), _cap(cap), _accepting(true), _dropped(0), _need_to_flush(false), _was_flushed(false)
     {}
 
+    // Called on the enqueuing thread with each item dropped to make room for a newer one
+    void set_on_drop(std::function<void(T&)> on_drop)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _on_drop = std::move(on_drop);
+    }
+
     void enqueue(T&& item)
     {
         std::unique_lock<std::mutex> lock(_mutex);
@@ -39,6 +55,9 @@ public:
             _queue.push_back(std::move(item));
             if (_queue.size() > _cap)
             {
+                ++_dropped;
+                if (_on_drop)
+                    _on_drop(_queue.front());
                 _queue.pop_front();
             }
         }
@@ -82,6 +101,31 @@ public:
         return true;
     }
 
+    // Waits for the first item as dequeue does, then moves the items already queued as well, up to max, under a single lock.
+    // Returns the number of items moved
+    size_t dequeue_many(T* items, size_t max, unsigned int timeout_ms)
+    {
+        if (max == 0)
+            return 0;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _accepting = true;
+        _was_flushed = false;
+        const auto ready = [this]() { return (_queue.size() > 0) || _need_to_flush; };
+        if (!ready() && !_deq_cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready))
+        {
+            return 0;
+        }
+        return pop_many(items, max);
+    }
+
+    size_t try_dequeue_many(T* items, size_t max)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _accepting = true;
+        return pop_many(items, max);
+    }
+
     bool try_dequeue(T* item)
     {
         std::unique_lock<std::mutex> lock(_mutex);
@@ -137,15 +181,303 @@ public:
         std::unique_lock<std::mutex> lock(_mutex);
         return _queue.size();
     }
+
+    unsigned int capacity() const { return _cap; }
+    unsigned long long dropped() const { return _dropped; }
+
+private:
+    // called with the lock held
+    size_t pop_many(T* items, size_t max)
+    {
+        size_t count = 0;
+        for (; count < max && _queue.size() > 0; ++count)
+        {
+            items[count] = std::move(_queue.front());
+            _queue.pop_front();
+        }
+        if (count > 0)
+            _enq_cv.notify_all();
+        return count;
+    }
 };
 
+// Bounded lock-free alternative to single_consumer_queue, with the same drop-oldest (enqueue)
+// and blocking (blocking_enqueue) semantics but no peek()
+// Items live in a preallocated ring of sequenced cells (D. Vyukov's bounded MPMC queue), so the
+// producer of an overflowing queue can safely drop the oldest item itself.
+// Waiting consumers and producers spin for a while before parking on a condition variable,
+// and the other side only touches the mutex when somebody is actually parked
 template<class T>
+class lock_free_single_consumer_queue
+{
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T* get() { return reinterpret_cast<T*>(&storage); }
+    };
+
+    std::unique_ptr<cell[]> _buffer;
+    size_t _mask;
+    unsigned int _cap;
+    unsigned int _spin_count;
+
+    // Producer and consumer positions are kept on separate cache lines
+    char _pad0[64];
+    std::atomic<size_t> _enqueue_pos;
+    char _pad1[64];
+    std::atomic<size_t> _dequeue_pos;
+    char _pad2[64];
+
+    std::mutex _mutex;
+    std::condition_variable _deq_cv; // not empty signal
+    std::condition_variable _enq_cv; // not full signal
+    std::atomic<int> _deq_waiters;
+    std::atomic<int> _enq_waiters;
+
+    std::atomic<bool> _accepting;
+    std::atomic<bool> _need_to_flush;
+
+    std::atomic<unsigned long long> _dropped;
+    std::function<void(T&)> _on_drop; // set before the queue is shared with the producers
+
+    static size_t ring_size(unsigned int cap)
+    {
+        size_t size = 2;
+        while (size < cap) size <<= 1;
+        return size;
+    }
+
+    template<class F>
+    bool try_pop_with(F consume)
+    {
+        cell* c;
+        auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            c = &_buffer[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto dif = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (dif == 0)
+            {
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+                return false;
+            else
+                pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+        consume(*c->get());
+        c->get()->~T();
+        c->sequence.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(T&& item)
+    {
+        cell* c;
+        auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            c = &_buffer[pos & _mask];
+            auto seq = c->sequence.load(std::memory_order_acquire);
+            auto dif = (intptr_t)seq - (intptr_t)pos;
+            if (dif == 0)
+            {
+                if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (dif < 0)
+                return false;
+            else
+                pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+        new (&c->storage) T(std::move(item));
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T* item) { return try_pop_with([item](T& front) { *item = std::move(front); }); }
+    size_t pop_many(T* items, size_t max)
+    {
+        size_t count = 0;
+        while (count < max && try_pop(items + count))
+            ++count;
+        if (count > 0)
+            notify(_enq_cv, _enq_waiters);
+        return count;
+    }
+    bool drop_oldest() { return try_pop_with([](T&) {}); }
+    bool drop_oldest_on_overflow()
+    {
+        return try_pop_with([this](T& item) {
+            ++_dropped;
+            if (_on_drop)
+                _on_drop(item);
+        });
+    }
+
+    void notify(std::condition_variable& cv, std::atomic<int>& waiters)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load())
+        {
+            { std::lock_guard<std::mutex> lock(_mutex); }
+            cv.notify_all();
+        }
+    }
+
+    // Spin, then park until ready() holds or the timeout expires
+    template<class P>
+    bool wait(P ready, std::condition_variable& cv, std::atomic<int>& waiters, std::chrono::milliseconds timeout)
+    {
+        for (unsigned int i = 0; i < _spin_count; ++i)
+        {
+            if (ready()) return true;
+            std::this_thread::yield();
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        ++waiters;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto res = cv.wait_for(lock, timeout, ready);
+        --waiters;
+        return res;
+    }
+
+public:
+    explicit lock_free_single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE, unsigned int spin_count = 64)
+        : _buffer(new cell[ring_size(cap)]), _mask(ring_size(cap) - 1), _cap(cap), _spin_count(spin_count),
+          _enqueue_pos(0), _dequeue_pos(0), _deq_waiters(0), _enq_waiters(0), _accepting(true), _need_to_flush(false), _dropped(0)
+    {
+        for (size_t i = 0; i <= _mask; ++i)
+            _buffer[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    lock_free_single_consumer_queue(const lock_free_single_consumer_queue&) = delete;
+    lock_free_single_consumer_queue& operator=(const lock_free_single_consumer_queue&) = delete;
+
+    ~lock_free_single_consumer_queue()
+    {
+        while (drop_oldest()) {}
+    }
+
+    void enqueue(T&& item)
+    {
+        if (!_accepting)
+            return;
+
+        while (size() >= _cap && drop_oldest_on_overflow()) {}
+        while (!try_push(std::move(item)))
+            drop_oldest_on_overflow();
+        notify(_deq_cv, _deq_waiters);
+    }
+
+    void blocking_enqueue(T&& item)
+    {
+        if (!_accepting)
+            return;
+
+        for (;;)
+        {
+            wait([this]() { return size() < _cap || _need_to_flush; }, _enq_cv, _enq_waiters, std::chrono::hours(999999));
+            if (try_push(std::move(item)))
+                break;
+            if (_need_to_flush)
+            {
+                enqueue(std::move(item));
+                return;
+            }
+        }
+        notify(_deq_cv, _deq_waiters);
+    }
+
+    bool dequeue(T* item, unsigned int timeout_ms)
+    {
+        _accepting = true;
+        bool popped = false;
+        wait([&]() { return (popped = try_pop(item)) || _need_to_flush; },
+            _deq_cv, _deq_waiters, std::chrono::milliseconds(timeout_ms));
+        if (popped)
+            notify(_enq_cv, _enq_waiters);
+        return popped;
+    }
+
+    bool try_dequeue(T* item)
+    {
+        _accepting = true;
+        if (!try_pop(item))
+            return false;
+        notify(_enq_cv, _enq_waiters);
+        return true;
+    }
+
+    // Waits for the first item as dequeue does, then pops the items already queued as well, up to max, waking the producers once.
+    // Returns the number of items popped
+    size_t dequeue_many(T* items, size_t max, unsigned int timeout_ms)
+    {
+        if (max == 0)
+            return 0;
+
+        _accepting = true;
+        bool popped = false;
+        wait([&]() { return (popped = try_pop(items)) || _need_to_flush; },
+            _deq_cv, _deq_waiters, std::chrono::milliseconds(timeout_ms));
+        if (!popped)
+            return 0;
+
+        size_t count = 1;
+        while (count < max && try_pop(items + count))
+            ++count;
+        notify(_enq_cv, _enq_waiters);
+        return count;
+    }
+
+    size_t try_dequeue_many(T* items, size_t max)
+    {
+        _accepting = true;
+        return pop_many(items, max);
+    }
+
+    void clear()
+    {
+        _accepting = false;
+        _need_to_flush = true;
+
+        notify(_enq_cv, _enq_waiters);
+        while (drop_oldest()) {}
+        notify(_deq_cv, _deq_waiters);
+    }
+
+    void start()
+    {
+        _need_to_flush = false;
+        _accepting = true;
+    }
+
+    size_t size()
+    {
+        auto deq = _dequeue_pos.load();
+        auto enq = _enqueue_pos.load();
+        return enq > deq ? enq - deq : 0;
+    }
+
+    // Called on the enqueuing thread with each item dropped to make room for a newer one
+    void set_on_drop(std::function<void(T&)> on_drop) { _on_drop = std::move(on_drop); }
+
+    unsigned int capacity() const { return _cap; }
+    unsigned long long dropped() const { return _dropped; }
+};
+
+template<class T, class Q = single_consumer_queue<T>>
 class single_consumer_frame_queue
 {
-    single_consumer_queue<T> _queue;
+    Q _queue;
 
 public:
-    single_consumer_frame_queue<T>(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
+    single_consumer_frame_queue<T, Q>(unsigned int cap = QUEUE_MAX_SIZE) : _queue(cap) {}
 
     void enqueue(T&& item)
     {
@@ -170,6 +502,16 @@ public:
         return _queue.try_dequeue(item);
     }
 
+    size_t dequeue_many(T* items, size_t max, unsigned int timeout_ms)
+    {
+        return _queue.dequeue_many(items, max, timeout_ms);
+    }
+
+    size_t try_dequeue_many(T* items, size_t max)
+    {
+        return _queue.try_dequeue_many(items, max);
+    }
+
     void clear()
     {
         _queue.clear();
@@ -184,6 +526,123 @@ public:
     {
         return _queue.size();
     }
+
+    void set_on_drop(std::function<void(T&)> on_drop) { _queue.set_on_drop(std::move(on_drop)); }
+    unsigned int capacity() const { return _queue.capacity(); }
+    unsigned long long dropped() const { return _queue.dropped(); }
+};
+
+// Move-only callable, stored in place when it fits in Size bytes and moves without throwing, on the heap otherwise.
+// Spares the usual captures the allocation std::function makes for them
+template<class Signature, size_t Size = 64>
+class small_task;
+
+template<class R, class... Args, size_t Size>
+class small_task<R(Args...), Size>
+{
+public:
+    small_task() : _ops(nullptr) {}
+
+    template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, small_task>::value>::type>
+    small_task(F&& f) : _ops(nullptr)
+    {
+        typedef typename std::decay<F>::type callable;
+        construct<callable>(std::forward<F>(f), std::integral_constant<bool, fits_in_place<callable>()>());
+    }
+
+    small_task(small_task&& other) : _ops(other._ops)
+    {
+        if (_ops)
+        {
+            _ops->move(&other._storage, &_storage);
+            other._ops = nullptr;
+        }
+    }
+
+    small_task& operator=(small_task&& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            if (other._ops)
+            {
+                other._ops->move(&other._storage, &_storage);
+                _ops = other._ops;
+                other._ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    small_task(const small_task&) = delete;
+    small_task& operator=(const small_task&) = delete;
+
+    ~small_task() { reset(); }
+
+    R operator()(Args... args) { return _ops->invoke(&_storage, std::forward<Args>(args)...); }
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+private:
+    typedef typename std::aligned_storage<Size, alignof(std::max_align_t)>::type storage;
+
+    struct operations
+    {
+        R(*invoke)(void* storage, Args&&... args);
+        void(*move)(void* from, void* to); // leaves from destroyed
+        void(*destroy)(void* storage);
+    };
+
+    template<class F>
+    static constexpr bool fits_in_place()
+    {
+        return sizeof(F) <= Size && alignof(std::max_align_t) % alignof(F) == 0 && std::is_nothrow_move_constructible<F>::value;
+    }
+
+    template<class F>
+    struct in_place
+    {
+        static R invoke(void* s, Args&&... args) { return (*static_cast<F*>(s))(std::forward<Args>(args)...); }
+        static void move(void* from, void* to) { new (to) F(std::move(*static_cast<F*>(from))); destroy(from); }
+        static void destroy(void* s) { static_cast<F*>(s)->~F(); }
+    };
+
+    template<class F>
+    struct on_heap
+    {
+        static F*& get(void* s) { return *static_cast<F**>(s); }
+        static R invoke(void* s, Args&&... args) { return (*get(s))(std::forward<Args>(args)...); }
+        static void move(void* from, void* to) { new (to) F*(get(from)); }
+        static void destroy(void* s) { delete get(s); }
+    };
+
+    template<class F, class G>
+    void construct(G&& f, std::true_type)
+    {
+        static const operations ops = { &in_place<F>::invoke, &in_place<F>::move, &in_place<F>::destroy };
+        new (&_storage) F(std::forward<G>(f));
+        _ops = &ops;
+    }
+
+    template<class F, class G>
+    void construct(G&& f, std::false_type)
+    {
+        static const operations ops = { &on_heap<F>::invoke, &on_heap<F>::move, &on_heap<F>::destroy };
+        new (&_storage) F*(new F(std::forward<G>(f)));
+        _ops = &ops;
+    }
+
+    void reset()
+    {
+        if (_ops)
+        {
+            _ops->destroy(&_storage);
+            _ops = nullptr;
+        }
+    }
+
+    storage _storage;
+    const operations* _ops;
 };
 
 class dispatcher
@@ -209,18 +668,22 @@ public:
         dispatcher* _owner;
     };
 
-    dispatcher(unsigned int cap)
+    // on_thread_start runs first on the dispatcher's thread, the library names and schedules its threads with it
+    dispatcher(unsigned int cap, std::function<void()> on_thread_start = nullptr)
         : _queue(cap),
           _was_stopped(true),
           _was_flushed(false),
           _is_alive(true)
     {
-        _thread = std::thread([&]()
+        _thread = std::thread([this, on_thread_start]()
         {
+            if (on_thread_start)
+                on_thread_start();
+
             int timeout_ms = 5000;
             while (_is_alive)
             {
-                std::function<void(cancellable_timer)> item;
+                task item;
 
                 if (_queue.dequeue(&item, timeout_ms))
                 {
@@ -350,7 +813,9 @@ public:
 
 private:
     friend cancellable_timer;
-    single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
+    // The queued work, without an allocation per invoke for the captures that fit in place
+    typedef small_task<void(cancellable_timer)> task;
+    single_consumer_queue<task> _queue;
     std::thread _thread;
 
     std::atomic<bool> _was_stopped;
@@ -371,8 +836,8 @@ template<class T = std::function<void(dispatcher::cancellable_timer)>>
 class active_object
 {
 public:
-    active_object(T operation)
-        : _operation(std::move(operation)), _dispatcher(1), _stopped(true)
+    active_object(T operation, std::function<void()> on_thread_start = nullptr)
+        : _operation(std::move(operation)), _dispatcher(1, std::move(on_thread_start)), _stopped(true)
     {
     }
 
@@ -414,22 +879,202 @@ private:
     std::atomic<bool> _stopped;
 };
 
-class watchdog
+// Periodic timers sharing a single thread, on a hashed timing wheel: a timer waits in the slot of its next expiry
+// modulo the number of slots, with the number of turns left, so that adding, removing and firing a timer cost the same
+// for any number of timers. The thread sleeps until the next occupied slot, and for good when there are no timers.
+// The callbacks run one at a time on the thread of the wheel and must be short: blocking work, such as a transaction with
+// a device, is posted from the callback to a dispatcher of its owner
+class timer_wheel
 {
 public:
-    watchdog(std::function<void()> operation, uint64_t timeout_ms) :
-            _timeout_ms(timeout_ms), _operation(std::move(operation))
+    typedef unsigned long long timer_id;
+
+    explicit timer_wheel(std::function<void()> on_thread_start = nullptr, unsigned int tick_ms = 10, size_t slots = 256)
+        : _tick(std::chrono::milliseconds(tick_ms)), _slots(slots), _current(0), _next_id(1), _running(0), _alive(true)
     {
-        _watcher = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
+        _tick_time = std::chrono::steady_clock::now();
+        _thread = std::thread([this, on_thread_start]()
         {
-            if(cancellable_timer.try_sleep(_timeout_ms))
+            if (on_thread_start)
+                on_thread_start();
+            run();
+        });
+    }
+
+    ~timer_wheel()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _alive = false;
+        }
+        _cv.notify_all();
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    // The wheel of the process, started by its first user with the hook of that user and stopped after its last user
+    static std::shared_ptr<timer_wheel> get_shared(std::function<void()> on_thread_start = nullptr)
+    {
+        static std::mutex mutex;
+        static std::weak_ptr<timer_wheel> instance;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto wheel = instance.lock();
+        if (!wheel)
+        {
+            wheel = std::make_shared<timer_wheel>(std::move(on_thread_start));
+            instance = wheel;
+        }
+        return wheel;
+    }
+
+    // Calls callback delay_ms from now, then every period_ms, until the timer is removed
+    timer_id add(uint64_t delay_ms, uint64_t period_ms, std::function<void()> callback)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto id = _next_id++;
+        auto& t = _timers[id];
+        t.period = to_ticks(period_ms);
+        t.callback = std::move(callback);
+        schedule(id, t, to_ticks(delay_ms));
+        lock.unlock();
+        _cv.notify_all();
+        return id;
+    }
+
+    // Applied from the next expiry of the timer
+    void set_period(timer_id id, uint64_t period_ms)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _timers.find(id);
+        if (it != _timers.end())
+            it->second.period = to_ticks(period_ms);
+    }
+
+    // Once it returns, the callback of the timer is not running and is not called again, unless called from the callback
+    void remove(timer_id id)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _timers.erase(id);
+        if (std::this_thread::get_id() != _thread.get_id())
+            _cv.wait(lock, [&]() { return _running != id; });
+    }
+
+private:
+    struct timer
+    {
+        uint64_t period = 1;    // in ticks
+        uint64_t turns = 0;     // left before the timer expires in its slot
+        unsigned generation = 0;
+        std::function<void()> callback;
+    };
+
+    // A timer in a slot, left behind by a later schedule of the timer when the generations differ
+    struct entry
+    {
+        timer_id id;
+        unsigned generation;
+    };
+
+    uint64_t to_ticks(uint64_t ms) const
+    {
+        uint64_t tick_ms = std::chrono::duration_cast<std::chrono::milliseconds>(_tick).count();
+        return std::max<uint64_t>(1, (ms + tick_ms - 1) / tick_ms);
+    }
+
+    void schedule(timer_id id, timer& t, uint64_t ticks)
+    {
+        t.turns = (ticks - 1) / _slots.size();
+        _slots[(_current + ticks) % _slots.size()].push_back({ id, ++t.generation });
+    }
+
+    // Ticks to the next slot holding timers, none when there are no timers
+    size_t next_occupied() const
+    {
+        for (size_t i = 1; i <= _slots.size(); i++)
+            if (!_slots[(_current + i) % _slots.size()].empty())
+                return i;
+        return 0;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_alive)
+        {
+            auto ticks = next_occupied();
+            if (!ticks)
             {
-                if(!_kicked)
-                    _operation();
-                std::lock_guard<std::mutex> lk(_m);
-                _kicked = false;
+                _cv.wait(lock);
+                // The slots are relative to the current tick, which restarts from now when the wheel was idle
+                _tick_time = std::chrono::steady_clock::now();
+                continue;
             }
-        });
+            if (_cv.wait_until(lock, _tick_time + ticks * _tick) != std::cv_status::timeout)
+                continue; // A timer was added or the wheel is being destroyed, its next slot may be sooner
+
+            while (_alive && _tick_time + _tick <= std::chrono::steady_clock::now())
+            {
+                _tick_time += _tick;
+                _current = (_current + 1) % _slots.size();
+                expire(lock);
+            }
+        }
+    }
+
+    void expire(std::unique_lock<std::mutex>& lock)
+    {
+        std::vector<entry> entries;
+        entries.swap(_slots[_current]);
+        for (auto& e : entries)
+        {
+            auto it = _timers.find(e.id);
+            if (it == _timers.end() || it->second.generation != e.generation)
+                continue;
+            if (it->second.turns > 0)
+            {
+                it->second.turns--;
+                _slots[_current].push_back(e);
+                continue;
+            }
+
+            // Rescheduled before the call, so that the callback may remove its own timer
+            schedule(e.id, it->second, it->second.period);
+            auto callback = it->second.callback;
+            _running = e.id;
+            lock.unlock();
+            try
+            {
+                callback();
+            }
+            catch (...) {}
+            lock.lock();
+            _running = 0;
+            _cv.notify_all();
+        }
+    }
+
+    const std::chrono::steady_clock::duration _tick;
+    std::vector<std::vector<entry>> _slots;
+    size_t _current;
+    std::chrono::steady_clock::time_point _tick_time; // of the current slot
+    std::unordered_map<timer_id, timer> _timers;
+    timer_id _next_id;
+    timer_id _running; // whose callback is running, 0 for none
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _alive;
+    std::thread _thread;
+};
+
+// Calls operation when it was not kicked for timeout_ms, on the shared timer wheel
+class watchdog
+{
+public:
+    watchdog(std::function<void()> operation, uint64_t timeout_ms, std::function<void()> on_thread_start = nullptr) :
+            _timeout_ms(timeout_ms), _operation(std::move(operation)), _wheel(timer_wheel::get_shared(std::move(on_thread_start)))
+    {
     }
 
     ~watchdog()
@@ -438,17 +1083,59 @@ public:
             stop();
     }
 
-    void start() { std::lock_guard<std::mutex> lk(_m); _watcher->start(); _running = true; }
-    void stop() { { std::lock_guard<std::mutex> lk(_m); _running = false; } _watcher->stop(); }
+    void start()
+    {
+        std::lock_guard<std::mutex> lk(_m);
+        if (_running)
+            return;
+        _kicked = false;
+        _timer = _wheel->add(_timeout_ms, _timeout_ms, [this]() { on_timeout(); });
+        _running = true;
+    }
+
+    void stop()
+    {
+        timer_wheel::timer_id timer;
+        {
+            std::lock_guard<std::mutex> lk(_m);
+            _running = false;
+            timer = _timer;
+            _timer = 0;
+        }
+        if (timer)
+            _wheel->remove(timer);
+    }
+
     bool running() { std::lock_guard<std::mutex> lk(_m); return _running; }
-    void set_timeout(uint64_t timeout_ms) { std::lock_guard<std::mutex> lk(_m); _timeout_ms = timeout_ms; }
+
+    void set_timeout(uint64_t timeout_ms)
+    {
+        std::lock_guard<std::mutex> lk(_m);
+        _timeout_ms = timeout_ms;
+        if (_timer)
+            _wheel->set_period(_timer, timeout_ms);
+    }
+
     void kick() { std::lock_guard<std::mutex> lk(_m); _kicked = true; }
 
 private:
+    void on_timeout()
+    {
+        bool kicked;
+        {
+            std::lock_guard<std::mutex> lk(_m);
+            kicked = _kicked;
+            _kicked = false;
+        }
+        if (!kicked)
+            _operation();
+    }
+
     std::mutex _m;
     uint64_t _timeout_ms;
     bool _kicked = false;
     bool _running = false;
     std::function<void()> _operation;
-    std::shared_ptr<active_object<>> _watcher;
+    std::shared_ptr<timer_wheel> _wheel;
+    timer_wheel::timer_id _timer = 0;
 };
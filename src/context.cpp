@@ -8,11 +8,10 @@
 
 #include <array>
 #include <chrono>
-#include "l500/l500-depth.h"
-#include "ivcam/sr300.h"
+#include "device.h"
 #include "ds5/ds5-factory.h"
-#include "l500/l500-factory.h"
 #include "ds5/ds5-timestamp.h"
+#include "proc/color-formats-converter.h"
 #include "backend.h"
 #include "mock/recorder.h"
 #include <media/ros/ros_reader.h>
@@ -26,6 +25,14 @@
 #include "tm2/tm-info.h"
 #endif
 
+#ifdef WITH_L500
+#include "l500/l500-factory.h"
+#endif
+
+#ifdef WITH_SR300
+#include "ivcam/sr300.h"
+#endif
+
 template<unsigned... Is> struct seq{};
 template<unsigned N, unsigned... Is>
 struct gen_seq : gen_seq<N-1, N-1, Is...>{};
@@ -263,6 +270,7 @@ namespace librealsense
 
             color_ep->register_processing_block(processing_block_factory::create_pbf_vector<uyvy_converter>(RS2_FORMAT_UYVY, map_supported_color_formats(RS2_FORMAT_UYVY), RS2_STREAM_COLOR));
             color_ep->register_processing_block(processing_block_factory::create_pbf_vector<yuy2_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
+            color_ep->register_processing_block(processing_block_factory::create_multi_output_pbf<yuy2_multi_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
 
             raw_color_ep->try_register_pu(RS2_OPTION_BACKLIGHT_COMPENSATION);
             raw_color_ep->try_register_pu(RS2_OPTION_BRIGHTNESS);
@@ -324,17 +332,21 @@ namespace librealsense
             std::copy(begin(ds5_devices), end(ds5_devices), std::back_inserter(list));
         }
 
+#ifdef WITH_L500
         if( mask & RS2_PRODUCT_LINE_L500 )
         {
             auto l500_devices = l500_info::pick_l500_devices(ctx, devices);
             std::copy(begin(l500_devices), end(l500_devices), std::back_inserter(list));
         }
+#endif
 
+#ifdef WITH_SR300
         if (mask & RS2_PRODUCT_LINE_SR300)
         {
             auto sr300_devices = sr300_info::pick_sr300_devices(ctx, devices.uvc_devices, devices.usb_devices);
             std::copy(begin(sr300_devices), end(sr300_devices), std::back_inserter(list));
         }
+#endif
 
 #ifdef WITH_TRACKING
         if (mask & RS2_PRODUCT_LINE_T200)
@@ -449,13 +461,41 @@ namespace librealsense
 
     void context::set_devices_changed_callback(devices_changed_callback_ptr callback)
     {
+        std::lock_guard<std::mutex> lock(_device_watcher_mtx);
         _device_watcher->stop();
+        _device_watcher_running = false;
 
         _devices_changed_callback = std::move(callback);
         _device_watcher->start([this](platform::backend_device_group old, platform::backend_device_group curr)
         {
             on_device_changed(old, curr, _playback_devices, _playback_devices);
         });
+        _device_watcher_running = true;
+    }
+
+    void context::start_device_watcher()
+    {
+        std::lock_guard<std::mutex> lock(_device_watcher_mtx);
+        if (_device_watcher_running)
+            return;
+
+        _device_watcher->start([this](platform::backend_device_group old, platform::backend_device_group curr)
+        {
+            on_device_changed(old, curr, _playback_devices, _playback_devices);
+        });
+        _device_watcher_running = true;
+    }
+
+    void context::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_devices_changed_callbacks_mtx);
+            if (_devices_changed_callbacks.size())
+                return;
+        }
+        std::lock_guard<std::mutex> lock(_device_watcher_mtx);
+        _device_watcher->stop();
+        _device_watcher_running = false;
     }
 
     std::vector<platform::uvc_device_info> filter_by_product(const std::vector<platform::uvc_device_info>& devices, const std::set<uint16_t>& pid_list)
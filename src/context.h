@@ -7,6 +7,7 @@
 #include "backend.h"
 #include "mock/recorder.h"
 #include "core/streaming.h"
+#include "memory-counter.h"
 
 #include <vector>
 #include <media/playback/playback_device.h>
@@ -112,7 +113,7 @@ namespace librealsense
             rs2_recording_mode mode = RS2_RECORDING_MODE_COUNT,
             std::string min_api_version = "0.0.0");
 
-        void stop(){ if (!_devices_changed_callbacks.size()) _device_watcher->stop();}
+        void stop();
         ~context();
         std::vector<std::shared_ptr<device_info>> query_devices(int mask) const;
         const platform::backend& get_backend() const { return *_backend; }
@@ -120,6 +121,8 @@ namespace librealsense
         uint64_t register_internal_device_callback(devices_changed_callback_ptr callback);
         void unregister_internal_device_callback(uint64_t cb_id);
         void set_devices_changed_callback(devices_changed_callback_ptr callback);
+        // Starts watching the devices unless they are watched already, the internal callbacks are only raised while they are
+        void start_device_watcher();
 
         std::vector<std::shared_ptr<device_info>> create_devices(platform::backend_device_group devices,
             const std::map<std::string, std::weak_ptr<device_info>>& playback_devices, int mask) const;
@@ -129,6 +132,9 @@ namespace librealsense
 
         void add_software_device(std::shared_ptr<device_info> software_device);
 
+        // Counts the frame buffers of the devices of the context, and adds them to the process-wide counter
+        const std::shared_ptr<memory_counter>& get_memory_counter() const { return _memory; }
+
 #if WITH_TRACKING
         void unload_tracking_module();
 #endif
@@ -151,6 +157,9 @@ namespace librealsense
         std::map<int, std::weak_ptr<const stream_interface>> _streams;
         std::map<int, std::map<int, std::weak_ptr<lazy<rs2_extrinsics>>>> _extrinsics;
         std::mutex _streams_mutex, _devices_changed_callbacks_mtx;
+        std::mutex _device_watcher_mtx;
+        bool _device_watcher_running = false;
+        std::shared_ptr<memory_counter> _memory = std::make_shared<memory_counter>(memory_counter::global());
     };
 
     class readonly_device_info : public device_info
@@ -211,20 +211,41 @@ namespace librealsense
         lazy<bool> _rgb_exposure_gain_bind;
         lazy<bool> _amplitude_factor_support;
 
-        preset get_all() const;
+        // The values of the control groups last read from or written to the camera, they differ from the camera's
+        // only when other clients write the groups with raw commands
+        mutable std::map<EtAdvancedModeRegGroup, std::vector<uint8_t>> _last_known;
+        mutable std::mutex _last_known_mtx;
+
+        // With last_known set, the control groups are taken from the last known values rather than read from the camera
+        preset get_all(bool last_known = false) const;
         void set_all(const preset& p);
 
         std::vector<uint8_t> send_receive(const std::vector<uint8_t>& input) const;
 
+        // Writes the group unless it holds these values already, returns whether it was written.
+        // The firmware needs time to apply a write, the callers wait once after their last write
         template<class T>
-        void set(const T& strct, EtAdvancedModeRegGroup cmd) const
+        bool write(const T& strct, EtAdvancedModeRegGroup cmd) const
         {
             auto ptr = (uint8_t*)(&strct);
             std::vector<uint8_t> data(ptr, ptr + sizeof(T));
 
+            std::lock_guard<std::mutex> lock(_last_known_mtx);
+            auto it = _last_known.find(cmd);
+            if (it != _last_known.end() && it->second == data)
+                return false;
+
             assert_no_error(ds::fw_cmd::SET_ADV,
                 send_receive(encode_command(ds::fw_cmd::SET_ADV, static_cast<uint32_t>(cmd), 0, 0, 0, data)));
-            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            _last_known[cmd] = data;
+            return true;
+        }
+
+        template<class T>
+        void set(const T& strct, EtAdvancedModeRegGroup cmd) const
+        {
+            if (write(strct, cmd))
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
         }
 
         template<class T>
@@ -239,9 +260,38 @@ namespace librealsense
                 throw std::runtime_error("The camera returned invalid sized result!");
             }
             res = *reinterpret_cast<T*>(data.data());
+            if (mode == 0)
+            {
+                auto bytes = (uint8_t*)(&res);
+                std::lock_guard<std::mutex> lock(_last_known_mtx);
+                _last_known[cmd] = std::vector<uint8_t>(bytes, bytes + sizeof(T));
+            }
             return res;
         }
 
+        // The last known values of the group, read from the camera only when none are known
+        template<class T>
+        T get_last_known(EtAdvancedModeRegGroup cmd) const
+        {
+            {
+                std::lock_guard<std::mutex> lock(_last_known_mtx);
+                auto it = _last_known.find(cmd);
+                if (it != _last_known.end())
+                    return *reinterpret_cast<const T*>(it->second.data());
+            }
+            return get<T>(cmd);
+        }
+
+        template<class T>
+        void get_group(T* ptr, bool last_known) const
+        {
+            auto cmd = advanced_mode_traits<T>::group;
+            *ptr = last_known ? get_last_known<T>(cmd) : get<T>(cmd);
+        }
+
+        void invalidate_last_known(EtAdvancedModeRegGroup cmd) const;
+        void invalidate_last_known() const;
+
         static uint32_t pack(uint8_t c0, uint8_t c1, uint8_t c2, uint8_t c3);
 
         static std::vector<uint8_t> assert_no_error(ds::fw_cmd opcode, const std::vector<uint8_t>& results);
@@ -31,6 +31,8 @@ namespace librealsense
         virtual bool set_static_node(const std::string& guid, const float3& pos, const float4& orient_quat) const = 0;
         virtual bool get_static_node(const std::string& guid, float3& pos, float4& orient_quat) const = 0;
         virtual bool remove_static_node(const std::string& guid) const = 0;
+        // The last pose received while streaming, and its (global) timestamp; false if there is none yet
+        virtual bool get_latest_pose(rs2_pose& pose, double& timestamp) const = 0;
         virtual ~pose_sensor_interface() = default;
     };
     MAP_EXTENSION(RS2_EXTENSION_POSE_SENSOR, librealsense::pose_sensor_interface);
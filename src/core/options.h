@@ -3,6 +3,7 @@
 #pragma once
 
 #include <map>
+#include <atomic>
 #include "../include/librealsense2/h/rs_option.h"
 #include "extension.h"
 #include "types.h"
@@ -32,6 +33,18 @@ namespace librealsense
         virtual ~option() = default;
     };
 
+    // Generation of the option values cached for a sensor. Any change that may affect them bumps it,
+    // and each cached option of the sensor reads the device again on its next query (see cached_option)
+    class option_cache
+    {
+    public:
+        void invalidate() { ++_generation; }
+        unsigned long long get_generation() const { return _generation; }
+
+    private:
+        std::atomic<unsigned long long> _generation{ 0 };
+    };
+
     class options_interface : public recordable<options_interface>
     {
     public:
@@ -33,11 +33,15 @@ namespace librealsense
                                                        frame_interface* original,
                                                        rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) = 0;
 
-        virtual frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) = 0;
+        // The holders are moved out of the vector, which the caller may reuse for the next composite
+        virtual frame_interface* allocate_composite_frame(std::vector<frame_holder>&& frames) = 0;
 
+        // The points hold vertex_count vertices, or a vertex per pixel of the stream when it is negative, and the color of each vertex when colors is set
         virtual frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
             frame_interface* original, 
-            rs2_extension frame_type = RS2_EXTENSION_POINTS) = 0;
+            rs2_extension frame_type = RS2_EXTENSION_POINTS,
+            int vertex_count = -1,
+            bool colors = false) = 0;
 
         virtual void frame_ready(frame_holder result) = 0;
         virtual rs2_source* get_c_wrapper() = 0;
@@ -330,6 +330,9 @@ namespace librealsense
             virtual void write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) = 0;
             virtual void write_notification(const sensor_identifier& stream_id, const nanoseconds& timestamp, const notification& n) = 0;
             virtual const std::string& get_file_name() const = 0;
+            virtual void set_frame_compression(rs2_stream stream, rs2_frame_compression compression) = 0;
+            // Writes the frames of every stream to a file of their own, next to the file holding the description of the device
+            virtual void set_file_per_stream(bool file_per_stream) = 0;
             virtual ~writer() = default;
         };
 
@@ -346,6 +349,8 @@ namespace librealsense
             virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual const std::string& get_file_name() const = 0;
             virtual std::vector<std::shared_ptr<serialized_data>> fetch_last_frames(const nanoseconds& seek_time) = 0;
+            // Number of frames read last kept in memory, so reading them again does not read the file. 0 disables the cache
+            virtual void set_frame_cache_size(uint32_t frames) = 0;
         };
     }
 }
@@ -5,6 +5,7 @@
 #include "cuda-conversion.cuh"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include "rscuda_utils.cuh"
 /*
 // conversion to Y8 is currently not available in the API
@@ -36,262 +37,308 @@ __global__ void kernel_unpack_yuy2_y8_cuda(const uint8_t * src, uint8_t *dst, in
 }
 */
 
-__global__ void kernel_unpack_yuy2_y16_cuda(const uint8_t * src, uint8_t *dst, int superPixCount)
+__device__ void unpack_yuy2_y16_super_pixel(const uint8_t * src, uint8_t *dst, int i)
 {
-    int i = blockDim.x * blockIdx.x + threadIdx.x;
-    int stride = blockDim.x * gridDim.x;
-
-    if (i >= superPixCount)
-        return;
-
-    for (; i < superPixCount; i += stride) {
-
-        int idx = i * 4;
+    int idx = i * 4;
 
-        dst[idx] = 0;
-        dst[idx + 1] = src[idx + 0];
-        dst[idx + 2] = 0;
-        dst[idx + 3] = src[idx + 2];
-    }
+    dst[idx] = 0;
+    dst[idx + 1] = src[idx + 0];
+    dst[idx + 2] = 0;
+    dst[idx + 3] = src[idx + 2];
 }
 
 
-__global__ void kernel_unpack_yuy2_rgb8_cuda(const uint8_t * src, uint8_t *dst, int superPixCount)
+__device__ void unpack_yuy2_rgb8_super_pixel(const uint8_t * src, uint8_t *dst, int i)
 {
-    int i = blockDim.x * blockIdx.x + threadIdx.x;
-    int stride = blockDim.x * gridDim.x;
-
-    if (i >= superPixCount)
-        return;
-
-    for (; i < superPixCount; i += stride) {
-
-        int idx = i * 4;
+    int idx = i * 4;
 
-        uint8_t y0 = src[idx];
-        uint8_t u0 = src[idx + 1];
-        uint8_t y1 = src[idx + 2];
-        uint8_t v0 = src[idx + 3];
+    uint8_t y0 = src[idx];
+    uint8_t u0 = src[idx + 1];
+    uint8_t y1 = src[idx + 2];
+    uint8_t v0 = src[idx + 3];
 
-        int16_t c = y0 - 16;
-        int16_t d = u0 - 128;
-        int16_t e = v0 - 128;
+    int16_t c = y0 - 16;
+    int16_t d = u0 - 128;
+    int16_t e = v0 - 128;
 
-        int32_t t;
+    int32_t t;
 #define clamp(x)  ((t=(x)) > 255 ? 255 : t < 0 ? 0 : t)
 
-        int odx = i * 6;
+    int odx = i * 6;
 
-        dst[odx] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 2] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 2] = clamp((298 * c + 516 * d + 128) >> 8);
 
-        c = y1 - 16;
+    c = y1 - 16;
 
-        dst[odx + 3] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 4] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 5] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx + 3] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 4] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 5] = clamp((298 * c + 516 * d + 128) >> 8);
 
 #undef clamp
-
-    }
 }
 
-__global__ void kernel_unpack_yuy2_bgr8_cuda(const uint8_t * src, uint8_t *dst, int superPixCount)
+__device__ void unpack_yuy2_bgr8_super_pixel(const uint8_t * src, uint8_t *dst, int i)
 {
-    int i = blockDim.x * blockIdx.x + threadIdx.x;
-    int stride = blockDim.x * gridDim.x;
-
-    if (i >= superPixCount)
-        return;
-
-    for (; i < superPixCount; i += stride) {
-
-        int idx = i * 4;
+    int idx = i * 4;
 
-        uint8_t y0 = src[idx];
-        uint8_t u0 = src[idx + 1];
-        uint8_t y1 = src[idx + 2];
-        uint8_t v0 = src[idx + 3];
+    uint8_t y0 = src[idx];
+    uint8_t u0 = src[idx + 1];
+    uint8_t y1 = src[idx + 2];
+    uint8_t v0 = src[idx + 3];
 
-        int16_t c = y0 - 16;
-        int16_t d = u0 - 128;
-        int16_t e = v0 - 128;
+    int16_t c = y0 - 16;
+    int16_t d = u0 - 128;
+    int16_t e = v0 - 128;
 
-        int32_t t;
+    int32_t t;
 #define clamp(x)  ((t=(x)) > 255 ? 255 : t < 0 ? 0 : t)
 
-        int odx = i * 6;
+    int odx = i * 6;
 
-        dst[odx + 2] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx + 2] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx] = clamp((298 * c + 516 * d + 128) >> 8);
 
-        c = y1 - 16;
+    c = y1 - 16;
 
-        dst[odx + 5] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 4] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 3] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx + 5] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 4] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 3] = clamp((298 * c + 516 * d + 128) >> 8);
 
 #undef clamp
-    }
 }
 
 
-__global__ void kernel_unpack_yuy2_rgba8_cuda(const uint8_t * src, uint8_t *dst, int superPixCount)
+__device__ void unpack_yuy2_rgba8_super_pixel(const uint8_t * src, uint8_t *dst, int i)
 {
-    int i = blockDim.x * blockIdx.x + threadIdx.x;
-    int stride = blockDim.x * gridDim.x;
-
-    if (i >= superPixCount)
-        return;
-
-    for (; i < superPixCount; i += stride) {
-
-        int idx = i * 4;
+    int idx = i * 4;
 
-        uint8_t y0 = src[idx];
-        uint8_t u0 = src[idx + 1];
-        uint8_t y1 = src[idx + 2];
-        uint8_t v0 = src[idx + 3];
+    uint8_t y0 = src[idx];
+    uint8_t u0 = src[idx + 1];
+    uint8_t y1 = src[idx + 2];
+    uint8_t v0 = src[idx + 3];
 
-        int16_t c = y0 - 16;
-        int16_t d = u0 - 128;
-        int16_t e = v0 - 128;
+    int16_t c = y0 - 16;
+    int16_t d = u0 - 128;
+    int16_t e = v0 - 128;
 
-        int32_t t;
+    int32_t t;
 #define clamp(x)  ((t=(x)) > 255 ? 255 : t < 0 ? 0 : t)
 
-        int odx = i * 8;
+    int odx = i * 8;
 
-        dst[odx] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 2] = clamp((298 * c + 516 * d + 128) >> 8);
-        dst[odx + 3] = 255;
+    dst[odx] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 2] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx + 3] = 255;
 
-        c = y1 - 16;
+    c = y1 - 16;
 
-        dst[odx + 4] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 5] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 6] = clamp((298 * c + 516 * d + 128) >> 8);
-        dst[odx + 7] = 255;
+    dst[odx + 4] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 5] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 6] = clamp((298 * c + 516 * d + 128) >> 8);
+    dst[odx + 7] = 255;
 
 #undef clamp
-    }
 }
 
-__global__ void kernel_unpack_yuy2_bgra8_cuda(const uint8_t * src, uint8_t *dst, int superPixCount)
+__device__ void unpack_yuy2_bgra8_super_pixel(const uint8_t * src, uint8_t *dst, int i)
 {
-    int i = blockDim.x * blockIdx.x + threadIdx.x;
-    int stride = blockDim.x * gridDim.x;
+    int idx = i * 4;
 
-    if (i >= superPixCount)
-        return;
+    uint8_t y0 = src[idx];
+    uint8_t u0 = src[idx + 1];
+    uint8_t y1 = src[idx + 2];
+    uint8_t v0 = src[idx + 3];
 
-    for (; i < superPixCount; i += stride) {
+    int16_t c = y0 - 16;
+    int16_t d = u0 - 128;
+    int16_t e = v0 - 128;
 
-        int idx = i * 4;
+    int32_t t;
 
-        uint8_t y0 = src[idx];
-        uint8_t u0 = src[idx + 1];
-        uint8_t y1 = src[idx + 2];
-        uint8_t v0 = src[idx + 3];
+#define clamp(x)  ((t=(x)) > 255 ? 255 : t < 0 ? 0 : t)
 
-        int16_t c = y0 - 16;
-        int16_t d = u0 - 128;
-        int16_t e = v0 - 128;
+    int odx = i * 8;
 
-        int32_t t;
+    dst[odx + 3] = 255;
+    dst[odx + 2] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx] = clamp((298 * c + 516 * d + 128) >> 8);
 
-#define clamp(x)  ((t=(x)) > 255 ? 255 : t < 0 ? 0 : t)
+    c = y1 - 16;
 
-        int odx = i * 8;
+    dst[odx + 7] = 255;
+    dst[odx + 6] = clamp((298 * c + 409 * e + 128) >> 8);
+    dst[odx + 5] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
+    dst[odx + 4] = clamp((298 * c + 516 * d + 128) >> 8);
 
-        dst[odx + 3] = 255;
-        dst[odx + 2] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 1] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx] = clamp((298 * c + 516 * d + 128) >> 8);
+#undef clamp
+}
 
-        c = y1 - 16;
 
-        dst[odx + 7] = 255;
-        dst[odx + 6] = clamp((298 * c + 409 * e + 128) >> 8);
-        dst[odx + 5] = clamp((298 * c - 100 * d - 409 * e + 128) >> 8);
-        dst[odx + 4] = clamp((298 * c + 516 * d + 128) >> 8);
+// Each frame of the batch is a row of blocks, the blocks of a row stride over the super pixels of their frame
+template<rs2_format FORMAT>
+__global__ void kernel_unpack_yuy2_batch_cuda(rscuda::yuy2_batch batch)
+{
+    int f = blockIdx.y;
+    const uint8_t* src = batch.src[f];
+    uint8_t* dst = batch.dst[f];
+    int superPixCount = batch.n[f] / 2;
+    int stride = blockDim.x * gridDim.x;
 
-#undef clamp
+    for (int i = blockDim.x * blockIdx.x + threadIdx.x; i < superPixCount; i += stride)
+    {
+        switch (FORMAT)
+        {
+        case RS2_FORMAT_Y16: unpack_yuy2_y16_super_pixel(src, dst, i); break;
+        case RS2_FORMAT_RGB8: unpack_yuy2_rgb8_super_pixel(src, dst, i); break;
+        case RS2_FORMAT_BGR8: unpack_yuy2_bgr8_super_pixel(src, dst, i); break;
+        case RS2_FORMAT_RGBA8: unpack_yuy2_rgba8_super_pixel(src, dst, i); break;
+        case RS2_FORMAT_BGRA8: unpack_yuy2_bgra8_super_pixel(src, dst, i); break;
+        default: break;
+        }
     }
 }
 
-
-void rscuda::unpack_yuy2_cuda_helper(const uint8_t* h_src, uint8_t* h_dst, int n, rs2_format format)
+namespace
 {
-    /*    cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
+    // The conversions of a thread, a sensor's dispatcher in practice, run on a stream of their own so the cameras don't wait
+    // on each other's work as they would with a device wide synchronization.
+    // The device buffers are kept between frames and only reallocated for a larger frame, a cudaFree synchronizes the whole device
+    class conversion_context
+    {
+    public:
+        static const int MAX_BUFFERS = 3;
+
+        conversion_context()
+        {
+            auto result = cudaStreamCreate(&_stream);
+            assert(result == cudaSuccess);
+        }
+
+        ~conversion_context()
+        {
+            cudaStreamSynchronize(_stream);
+            cudaStreamDestroy(_stream);
+        }
+
+        cudaStream_t stream() const { return _stream; }
+
+        template<typename T>
+        T* buffer(int index, int elements)
+        {
+            auto& b = _buffers[index];
+            auto size = sizeof(T) * elements;
+            if (b.size < size)
+            {
+                b.data.reset();
+                b.data = rscuda::alloc_dev<uint8_t>(static_cast<int>(size));
+                b.size = size;
+            }
+            return reinterpret_cast<T*>(b.data.get());
+        }
+
+    private:
+        struct device_buffer
+        {
+            std::shared_ptr<uint8_t> data;
+            size_t size = 0;
+        };
+
+        cudaStream_t _stream;
+        device_buffer _buffers[MAX_BUFFERS];
+    };
+
+    conversion_context& get_conversion_context()
+    {
+        thread_local conversion_context context;
+        return context;
+    }
 
-        // How many super pixels do we have?
-    int superPix = n / 2;
-    std::shared_ptr<uint8_t> d_dst;
-    std::shared_ptr<uint8_t> d_src = alloc_dev<uint8_t>(superPix * 4);
+    int get_num_blocks(int count)
+    {
+        return (count + RS2_CUDA_THREADS_PER_BLOCK - 1) / RS2_CUDA_THREADS_PER_BLOCK;
+    }
 
-    auto result = cudaMemcpy(d_src.get(), h_src, superPix * sizeof(uint8_t) * 4, cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess);
+    int get_yuy2_bpp(rs2_format format)
+    {
+        switch (format)
+        {
+        // conversion to Y8 is currently not available in the API
+        case RS2_FORMAT_Y16: return 2;
+        case RS2_FORMAT_RGB8: return 3;
+        case RS2_FORMAT_BGR8: return 3;
+        case RS2_FORMAT_RGBA8: return 4;
+        case RS2_FORMAT_BGRA8: return 4;
+        default: assert(false); return 0;
+        }
+    }
+}
 
-    int numBlocks = superPix / RS2_CUDA_THREADS_PER_BLOCK;
-    int size;
+void rscuda::unpack_yuy2_cuda_batch(const yuy2_batch& batch, rs2_format format, cudaStream_t stream)
+{
+    assert(batch.count > 0 && batch.count <= yuy2_batch::MAX_FRAMES);
+
+    int max_n = 0;
+    for (int i = 0; i < batch.count; i++)
+        max_n = std::max(max_n, batch.n[i]);
+
+    dim3 blocks(get_num_blocks(max_n / 2), batch.count);
 
     switch (format)
     {
-        // conversion to Y8 is currently not available in the API
-        /*	case RS2_FORMAT_Y8:
-            size = 1;
-             d_dst = alloc_dev<uint8_t>(n * size);
-            kernel_unpack_yuy2_y8_cuda<<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>>(devSrc, devDst, superPix);
-            break;
-        */
     case RS2_FORMAT_Y16:
-        size = 2;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_y16_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel_unpack_yuy2_batch_cuda<RS2_FORMAT_Y16> <<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (batch);
         break;
     case RS2_FORMAT_RGB8:
-        size = 3;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_rgb8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel_unpack_yuy2_batch_cuda<RS2_FORMAT_RGB8> <<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (batch);
         break;
     case RS2_FORMAT_BGR8:
-        size = 3;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_bgr8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel_unpack_yuy2_batch_cuda<RS2_FORMAT_BGR8> <<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (batch);
         break;
     case RS2_FORMAT_RGBA8:
-        size = 4;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_rgba8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel_unpack_yuy2_batch_cuda<RS2_FORMAT_RGBA8> <<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (batch);
         break;
     case RS2_FORMAT_BGRA8:
-        size = 4;
-        d_dst = alloc_dev<uint8_t>(n * size);
-        kernel_unpack_yuy2_bgra8_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), superPix);
+        kernel_unpack_yuy2_batch_cuda<RS2_FORMAT_BGRA8> <<<blocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (batch);
         break;
     default:
         assert(false);
     }
-    result = cudaGetLastError();
+    auto result = cudaGetLastError();
     assert(result == cudaSuccess);
+}
+
+void rscuda::unpack_yuy2_cuda_async(const uint8_t* d_src, uint8_t* d_dst, int n, rs2_format format, cudaStream_t stream)
+{
+    yuy2_batch batch;
+    batch.src[0] = d_src;
+    batch.dst[0] = d_dst;
+    batch.n[0] = n;
+    batch.count = 1;
+    unpack_yuy2_cuda_batch(batch, format, stream);
+}
+
+void rscuda::unpack_yuy2_cuda_helper(const uint8_t* h_src, uint8_t* h_dst, int n, rs2_format format)
+{
+    auto& context = get_conversion_context();
+    auto stream = context.stream();
+    int size = get_yuy2_bpp(format);
 
-    cudaDeviceSynchronize();
+    auto d_src = context.buffer<uint8_t>(0, n * 2);
+    auto d_dst = context.buffer<uint8_t>(1, n * size);
 
-    result = cudaMemcpy(h_dst, d_dst.get(), n * sizeof(uint8_t) * size, cudaMemcpyDeviceToHost);
+    auto result = cudaMemcpyAsync(d_src, h_src, n * sizeof(uint8_t) * 2, cudaMemcpyHostToDevice, stream);
     assert(result == cudaSuccess);
 
-    /*	cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << "\n"; */
+    unpack_yuy2_cuda_async(d_src, d_dst, n, format, stream);
+
+    result = cudaMemcpyAsync(h_dst, d_dst, n * sizeof(uint8_t) * size, cudaMemcpyDeviceToHost, stream);
+    assert(result == cudaSuccess);
+    cudaStreamSynchronize(stream);
 }
 
 
@@ -308,38 +355,30 @@ __global__ void kernel_split_frame_y8_y8_from_y8i_cuda(uint8_t* a, uint8_t* b, i
 
 void rscuda::y8_y8_from_y8i_cuda_helper(uint8_t* const dest[], int count, const rscuda::y8i_pixel * source)
 {
-    /*    cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
+    auto& context = get_conversion_context();
+    auto stream = context.stream();
 
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
+    int numBlocks = get_num_blocks(count);
     uint8_t* a = dest[0];
     uint8_t* b = dest[1];
 
-    auto d_src = alloc_dev<rscuda::y8i_pixel>(count);
-    auto d_dst_0 = alloc_dev<uint8_t>(count);
-    auto d_dst_1 = alloc_dev<uint8_t>(count);
+    auto d_src = context.buffer<rscuda::y8i_pixel>(0, count);
+    auto d_dst_0 = context.buffer<uint8_t>(1, count);
+    auto d_dst_1 = context.buffer<uint8_t>(2, count);
 
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(rscuda::y8i_pixel), cudaMemcpyHostToDevice);
+    auto result = cudaMemcpyAsync(d_src, source, count * sizeof(rscuda::y8i_pixel), cudaMemcpyHostToDevice, stream);
     assert(result == cudaSuccess);
 
-    kernel_split_frame_y8_y8_from_y8i_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_dst_0.get(), d_dst_1.get(), count, d_src.get());
-    cudaDeviceSynchronize();
+    kernel_split_frame_y8_y8_from_y8i_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (d_dst_0, d_dst_1, count, d_src);
 
     result = cudaGetLastError();
     assert(result == cudaSuccess);
 
-    result = cudaMemcpy(a, d_dst_0.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(a, d_dst_0, count * sizeof(uint8_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-    result = cudaMemcpy(b, d_dst_1.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(b, d_dst_1, count * sizeof(uint8_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-
-    /*    cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    cudaStreamSynchronize(stream);
 }
 
 __global__ void kernel_split_frame_y16_y16_from_y12i_cuda(uint16_t* a, uint16_t* b, int count, const rscuda::y12i_pixel * source)
@@ -356,44 +395,30 @@ __global__ void kernel_split_frame_y16_y16_from_y12i_cuda(uint16_t* a, uint16_t*
 
 void rscuda::y16_y16_from_y12i_10_cuda_helper(uint8_t* const dest[], int count, const rscuda::y12i_pixel * source)
 {
-    /*
-        cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
+    auto& context = get_conversion_context();
+    auto stream = context.stream();
 
-    source = reinterpret_cast<const y12i_pixel*>(source);
-
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
+    int numBlocks = get_num_blocks(count);
     uint16_t* a = reinterpret_cast<uint16_t*>(dest[0]);
     uint16_t* b = reinterpret_cast<uint16_t*>(dest[1]);
 
-    auto d_src = alloc_dev<rscuda::y12i_pixel>(count);
-    auto d_dst_0 = alloc_dev<uint16_t>(count);
-    auto d_dst_1 = alloc_dev<uint16_t>(count);
-
+    auto d_src = context.buffer<rscuda::y12i_pixel>(0, count);
+    auto d_dst_0 = context.buffer<uint16_t>(1, count);
+    auto d_dst_1 = context.buffer<uint16_t>(2, count);
 
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(rscuda::y12i_pixel), cudaMemcpyHostToDevice);
+    auto result = cudaMemcpyAsync(d_src, source, count * sizeof(rscuda::y12i_pixel), cudaMemcpyHostToDevice, stream);
     assert(result == cudaSuccess);
 
-    kernel_split_frame_y16_y16_from_y12i_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>> (d_dst_0.get(), d_dst_1.get(), count, d_src.get());
-    cudaDeviceSynchronize();
+    kernel_split_frame_y16_y16_from_y12i_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (d_dst_0, d_dst_1, count, d_src);
 
     result = cudaGetLastError();
     assert(result == cudaSuccess);
 
-    result = cudaMemcpy(a, d_dst_0.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(a, d_dst_0, count * sizeof(uint16_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-    result = cudaMemcpy(b, d_dst_1.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(b, d_dst_1, count * sizeof(uint16_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-
-    /*
-    cudaEventRecord(stop);
-    cudaEventSynchronize(stop);
-    float milliseconds = 0;
-    cudaEventElapsedTime(&milliseconds, start, stop);
-    std::cout << milliseconds << std::endl;
-    */
+    cudaStreamSynchronize(stream);
 }
 
 
@@ -409,30 +434,22 @@ __global__ void kernel_z16_y8_from_sr300_inzi_cuda(const uint16_t* source, uint8
 
 void rscuda::unpack_z16_y8_from_sr300_inzi_cuda(uint8_t * const dest, const uint16_t * source, int count)
 {
-    /*  cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
+    auto& context = get_conversion_context();
+    auto stream = context.stream();
 
-    auto d_src = alloc_dev<uint16_t>(count);
-    auto d_dst = alloc_dev<uint8_t>(count);
+    auto d_src = context.buffer<uint16_t>(0, count);
+    auto d_dst = context.buffer<uint8_t>(1, count);
 
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
+    int numBlocks = get_num_blocks(count);
 
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
+    auto result = cudaMemcpyAsync(d_src, source, count * sizeof(uint16_t), cudaMemcpyHostToDevice, stream);
     assert(result == cudaSuccess);
 
-    kernel_z16_y8_from_sr300_inzi_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK >>> (d_src.get(), d_dst.get(), count);
-    cudaDeviceSynchronize();
+    kernel_z16_y8_from_sr300_inzi_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (d_src, d_dst, count);
 
-    result = cudaMemcpy(dest, d_dst.get(), count * sizeof(uint8_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(dest, d_dst, count * sizeof(uint8_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-
-    /*  cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    cudaStreamSynchronize(stream);
 }
 
 __global__ void kernel_z16_y16_from_sr300_inzi_cuda(uint16_t* const source, uint16_t* const dest, int count)
@@ -447,30 +464,22 @@ __global__ void kernel_z16_y16_from_sr300_inzi_cuda(uint16_t* const source, uint
 
 void rscuda::unpack_z16_y16_from_sr300_inzi_cuda(uint16_t * const dest, const uint16_t * source, int count)
 {
-    /*  cudaEvent_t start, stop;
-        cudaEventCreate(&start);
-        cudaEventCreate(&stop);
-        cudaEventRecord(start); */
+    auto& context = get_conversion_context();
+    auto stream = context.stream();
 
-    auto d_src = alloc_dev<uint16_t>(count);
-    auto d_dst = alloc_dev<uint16_t>(count);
+    auto d_src = context.buffer<uint16_t>(0, count);
+    auto d_dst = context.buffer<uint16_t>(1, count);
 
-    int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
+    int numBlocks = get_num_blocks(count);
 
-    auto result = cudaMemcpy(d_src.get(), source, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
+    auto result = cudaMemcpyAsync(d_src, source, count * sizeof(uint16_t), cudaMemcpyHostToDevice, stream);
     assert(result == cudaSuccess);
 
-    kernel_z16_y16_from_sr300_inzi_cuda << <numBlocks, RS2_CUDA_THREADS_PER_BLOCK >> > (d_src.get(), d_dst.get(), count);
-    cudaDeviceSynchronize();
+    kernel_z16_y16_from_sr300_inzi_cuda <<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>> (d_src, d_dst, count);
 
-    result = cudaMemcpy(dest, d_dst.get(), count * sizeof(uint16_t), cudaMemcpyDeviceToHost);
+    result = cudaMemcpyAsync(dest, d_dst, count * sizeof(uint16_t), cudaMemcpyDeviceToHost, stream);
     assert(result == cudaSuccess);
-
-    /*	cudaEventRecord(stop);
-        cudaEventSynchronize(stop);
-        float milliseconds = 0;
-        cudaEventElapsedTime(&milliseconds, start, stop);
-        std::cout << milliseconds << std::endl; */
+    cudaStreamSynchronize(stream);
 }
 
 #endif
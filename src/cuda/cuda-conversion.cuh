@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include "../../include/librealsense2/rs.h"
 #include "assert.h"
+#include <memory>
 //#include "../types.h"
 
 // CUDA headers
@@ -26,9 +27,29 @@ namespace rscuda
 {   
     struct y8i_pixel { uint8_t l; uint8_t r; };  
     struct y12i_pixel { uint8_t rl : 8, rh : 4, ll : 4, lh : 8; __host__ __device__ int l() const { return lh << 4 | ll; } __host__ __device__ int r() const { return rh << 8 | rl; } };
+
+    // The host side helpers below convert on a stream of the calling thread and keep their device buffers between calls,
+    // so the sensors of several cameras converting concurrently don't wait on each other's work or on device allocations
     void y8_y8_from_y8i_cuda_helper(uint8_t* const dest[], int count, const y8i_pixel * source);
     void y16_y16_from_y12i_10_cuda_helper(uint8_t* const dest[], int count, const rscuda::y12i_pixel * source);
     void unpack_yuy2_cuda_helper(const uint8_t* src, uint8_t* dst, int n, rs2_format format);
+
+    // Converts a YUY2 image of n pixels already on the device, the conversion is queued on the stream and not waited for
+    void unpack_yuy2_cuda_async(const uint8_t* d_src, uint8_t* d_dst, int n, rs2_format format, cudaStream_t stream);
+
+    // The frames of one batched conversion, of one camera each
+    struct yuy2_batch
+    {
+        static const int MAX_FRAMES = 8;
+
+        const uint8_t* src[MAX_FRAMES];
+        uint8_t* dst[MAX_FRAMES];
+        int n[MAX_FRAMES];
+        int count = 0;
+    };
+
+    // Converts all the frames of the batch, on the device, in a single kernel launch queued on the stream
+    void unpack_yuy2_cuda_batch(const yuy2_batch& batch, rs2_format format, cudaStream_t stream);
     
     template<rs2_format FORMAT> void unpack_yuy2_cuda(uint8_t * const d[], const uint8_t * s, int n)
     {
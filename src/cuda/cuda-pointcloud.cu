@@ -1,6 +1,7 @@
 #ifdef RS2_USE_CUDA
 
 #include "cuda-pointcloud.cuh"
+#include "rscuda_utils.cuh"
 #include <iostream>
 #include <chrono>
 
@@ -55,36 +56,18 @@ void kernel_deproject_depth_cuda(float * points, const rs2_intrinsics* intrin, c
 }
 
 
-void rscuda::deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale)
+void rscuda::pointcloud_cuda_helper::deproject_depth(float * d_points, const rs2_intrinsics & intrin, const uint16_t * d_depth, float depth_scale, cudaStream_t stream)
 {
     int count = intrin.height * intrin.width;
     int numBlocks = count / RS2_CUDA_THREADS_PER_BLOCK;
-    
-    float *dev_points = 0;	
-    uint16_t *dev_depth = 0;
-    rs2_intrinsics* dev_intrin = 0;
-    cudaError_t result;
-
-    result = cudaMalloc(&dev_points, count * sizeof(float) * 3);
-    assert(result == cudaSuccess);
-    result = cudaMalloc(&dev_depth, count * sizeof(uint16_t));
-    assert(result == cudaSuccess);
-    result = cudaMalloc(&dev_intrin, sizeof(rs2_intrinsics));
-    assert(result == cudaSuccess);
-       
-    result = cudaMemcpy(dev_depth, depth, count * sizeof(uint16_t), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess); 
-    result = cudaMemcpy(dev_intrin, &intrin, sizeof(rs2_intrinsics), cudaMemcpyHostToDevice);
-    assert(result == cudaSuccess); 
-     
-    kernel_deproject_depth_cuda<<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK>>>(dev_points, dev_intrin, dev_depth, depth_scale); 
 
-     result = cudaMemcpy(points, dev_points, count * sizeof(float) * 3, cudaMemcpyDeviceToHost);
-     assert(result == cudaSuccess);
+    if (!_d_intrinsics || memcmp(&_intrinsics, &intrin, sizeof(rs2_intrinsics)) != 0)
+    {
+        _d_intrinsics = make_device_copy(intrin);
+        _intrinsics = intrin;
+    }
 
-    cudaFree(dev_points);
-    cudaFree(dev_depth);
-    cudaFree(dev_intrin);
+    kernel_deproject_depth_cuda<<<numBlocks, RS2_CUDA_THREADS_PER_BLOCK, 0, stream>>>(d_points, _d_intrinsics.get(), d_depth, depth_scale);
 }
 
 #endif
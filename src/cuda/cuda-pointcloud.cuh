@@ -10,6 +10,7 @@
 #include "assert.h"
 #include "../../include/librealsense2/rsutil.h"
 #include <functional>
+#include <memory>
 
 // CUDA headers
 #include <cuda_runtime.h>
@@ -23,7 +24,17 @@
 
 namespace rscuda
 {
-    void deproject_depth_cuda(float * points, const rs2_intrinsics & intrin, const uint16_t * depth, float depth_scale);
+    // Keeps the device buffers of the points and the intrinsics between frames
+    class pointcloud_cuda_helper
+    {
+    public:
+        // The depth image is in device memory, the points are left in d_points, both on the device work queued on the stream
+        void deproject_depth(float * d_points, const rs2_intrinsics & intrin, const uint16_t * d_depth, float depth_scale, cudaStream_t stream);
+
+    private:
+        std::shared_ptr<rs2_intrinsics> _d_intrinsics;
+        rs2_intrinsics _intrinsics{};
+    };
 
 }
 
@@ -5,6 +5,7 @@
 #include "core/video.h"
 #include "core/motion.h"
 #include "device.h"
+#include "frame-memory.h"
 
 using namespace librealsense;
 
@@ -127,7 +128,8 @@ device::device(std::shared_ptr<context> ctx,
                const platform::backend_device_group group,
                bool device_changed_notifications)
     : _context(ctx), _group(group), _is_valid(true),
-      _device_changed_notifications(device_changed_notifications)
+      _device_changed_notifications(device_changed_notifications),
+      _memory(std::make_shared<memory_counter>(ctx ? ctx->get_memory_counter() : memory_counter::global()))
 {
     _profiles_tags = lazy<std::vector<tagged_profile>>([this]() { return get_profiles_tags(); });
 
@@ -179,6 +181,22 @@ int device::assign_sensor(const std::shared_ptr<sensor_interface>& sensor_base,
     }
 }
 
+int device::get_numa_node() const
+{
+    return librealsense::get_numa_node(_group);
+}
+
+void device::set_frame_memory_policy(int numa_node, bool huge_pages)
+{
+    // One allocator for the device, the synthetic sensors pass it on to their raw sensors and processing blocks
+    auto allocator = make_page_frame_allocator(numa_node, huge_pages);
+    for (auto&& s : _sensors)
+    {
+        if (auto sensor = std::dynamic_pointer_cast<sensor_base>(s))
+            sensor->set_frame_allocator(allocator);
+    }
+}
+
 size_t device::get_sensors_count() const
 {
     return static_cast<unsigned int>(_sensors.size());
@@ -269,11 +287,20 @@ std::vector<rs2_format> librealsense::device::map_supported_color_formats(rs2_fo
     {
     case RS2_FORMAT_YUYV:
         target_formats.push_back(RS2_FORMAT_YUYV);
+        target_formats.push_back(RS2_FORMAT_Y8);
         target_formats.push_back(RS2_FORMAT_Y16);
         break;
     case RS2_FORMAT_UYVY:
         target_formats.push_back(RS2_FORMAT_UYVY);
         break;
+    case RS2_FORMAT_MJPEG:
+#ifdef RS2_USE_JPEG_TURBO
+        target_formats.push_back(RS2_FORMAT_YUYV);
+#else
+        // The built-in decoder produces RGB8 only
+        target_formats = { RS2_FORMAT_RGB8 };
+#endif
+        break;
     default:
         LOG_ERROR("Format is not supported for mapping");
     }
@@ -78,6 +78,15 @@ namespace librealsense
 
         virtual bool contradicts(const stream_profile_interface* a, const std::vector<stream_profile>& others) const override;
 
+        // Counts the frame buffers of the sensors of the device, and adds them to the counter of its context
+        const std::shared_ptr<memory_counter>& get_memory_counter() const { return _memory; }
+
+        // NUMA node of the controller the device is attached to, -1 when unknown
+        int get_numa_node() const;
+
+        // Maps the frame buffers of all the sensors from numa_node and on huge pages, see make_page_frame_allocator
+        void set_frame_memory_policy(int numa_node, bool huge_pages);
+
     protected:
         int add_sensor(const std::shared_ptr<sensor_interface>& sensor_base);
         int assign_sensor(const std::shared_ptr<sensor_interface>& sensor_base, uint8_t idx);
@@ -98,5 +107,6 @@ namespace librealsense
         mutable std::mutex _device_changed_mtx;
         uint64_t _callback_id;
         lazy<std::vector<tagged_profile>> _profiles_tags;
+        std::shared_ptr<memory_counter> _memory;
     };
 }
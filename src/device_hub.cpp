@@ -9,7 +9,25 @@
 
 namespace librealsense
 {
-    typedef rs2::devices_changed_callback<std::function<void(rs2::event_information& info)>> hub_devices_changed_callback;
+    // Hands the devices of a change to the hub as the context enumerated them
+    class hub_devices_changed_callback : public rs2_devices_changed_callback
+    {
+    public:
+        typedef std::function<void(const std::vector<rs2_device_info>& removed, const std::vector<rs2_device_info>& added)> callback;
+
+        explicit hub_devices_changed_callback(callback on_changed) : _on_changed(on_changed) {}
+
+        void on_devices_changed(rs2_device_list* removed, rs2_device_list* added) override
+        {
+            std::unique_ptr<rs2_device_list> removed_list(removed), added_list(added);
+            _on_changed(removed->list, added->list);
+        }
+
+        void release() override { delete this; }
+
+    private:
+        callback _on_changed;
+    };
 
     std::vector<std::shared_ptr<device_info>> filter_by_vid(std::vector<std::shared_ptr<device_info>> devices , int vid)
     {
@@ -46,13 +64,28 @@ namespace librealsense
           _device_changes_callback_id(0),
           _register_device_notifications(register_device_notifications)
     {
-        _device_list = filter_by_vid(_ctx->query_devices(mask), _vid);
-
-        auto cb = new hub_devices_changed_callback([&,mask](rs2::event_information&)
+        // The list follows the changes the device watcher reports, rather than enumerating the devices again on every change
+        auto cb = new hub_devices_changed_callback([&, mask](const std::vector<rs2_device_info>& removed, const std::vector<rs2_device_info>& added)
                    {
                         std::unique_lock<std::mutex> lock(_mutex);
 
-                        _device_list = filter_by_vid(_ctx->query_devices(mask), _vid);
+                        for (auto&& r : removed)
+                        {
+                            _serials.erase(std::string(r.info->get_device_data()));
+                            _device_list.erase(std::remove_if(_device_list.begin(), _device_list.end(),
+                                [&](const std::shared_ptr<device_info>& d) { return *d == *r.info; }), _device_list.end());
+                        }
+
+                        for (auto&& a : added)
+                        {
+                            // The context reports the devices of all the product lines, only the added ones are matched against the mask
+                            auto devices = filter_by_vid(_ctx->create_devices(a.info->get_device_data(), {}, mask), _vid);
+                            for (auto&& d : devices)
+                            {
+                                if (std::none_of(_device_list.begin(), _device_list.end(), [&](const std::shared_ptr<device_info>& existing) { return *existing == *d; }))
+                                    _device_list.push_back(d);
+                            }
+                        }
 
                         // Current device will point to the first available device
                         _camera_index = 0;
@@ -63,6 +96,11 @@ namespace librealsense
                     });
 
         _device_changes_callback_id = _ctx->register_internal_device_callback({ cb, [](rs2_devices_changed_callback* p) { p->release(); } });
+        _ctx->start_device_watcher();
+
+        // Enumerated once the watcher runs, the devices connected meanwhile are not missed
+        std::unique_lock<std::mutex> lock(_mutex);
+        _device_list = filter_by_vid(_ctx->query_devices(mask), _vid);
     }
 
     device_hub::~device_hub()
@@ -80,6 +118,16 @@ namespace librealsense
         {
             // _camera_index is the curr device that the hub will expose
             auto d = _device_list[ (_camera_index + i) % _device_list.size()];
+            auto key = std::string(d->get_device_data());
+
+            // The devices of a known serial are not opened only to find out it is not the requested one
+            if (serial.size() > 0)
+            {
+                auto known = _serials.find(key);
+                if (known != _serials.end() && known->second != serial)
+                    continue;
+            }
+
             try
             {
                 auto dev = d->create_device(_register_device_notifications);
@@ -87,6 +135,7 @@ namespace librealsense
                 if(serial.size() > 0 )
                 {
                     auto new_serial = dev->get_info(RS2_CAMERA_INFO_SERIAL_NUMBER);
+                    _serials[key] = new_serial;
 
                     if(serial == new_serial)
                     {
@@ -124,7 +173,6 @@ namespace librealsense
         std::shared_ptr<device_interface> res = nullptr;
 
         // check if there is at least one device connected
-        _device_list = filter_by_vid(_ctx->query_devices(RS2_PRODUCT_LINE_ANY), _vid);
         if (_device_list.size() > 0)
         {
             res = create_device(serial, loop_through_devices);
@@ -51,6 +51,7 @@ namespace librealsense
         std::mutex _mutex;
         std::condition_variable _cv;
         std::vector<std::shared_ptr<device_info>> _device_list;
+        std::map<std::string, std::string> _serials; // serial numbers of the devices opened so far, by their backend data
         int _camera_index = 0;
         int _vid = 0;
         uint64_t _device_changes_callback_id;
@@ -46,6 +46,13 @@ namespace librealsense
             auto fw_ver = firmware_version(_depth_sensor.get_device().get_info(rs2_camera_info::RS2_CAMERA_INFO_FIRMWARE_VERSION));
             return (fw_ver >= firmware_version("5.11.9.0"));
         };
+
+        // The depth units option writes the depth table behind the advanced mode's back
+        if (_depth_sensor.supports_option(RS2_OPTION_DEPTH_UNITS))
+        {
+            if (auto depth_units = dynamic_cast<observable_option*>(&_depth_sensor.get_option(RS2_OPTION_DEPTH_UNITS)))
+                depth_units->add_observer([this](float) { invalidate_last_known(advanced_mode_traits<STDepthTableControl>::group); });
+        }
     }
 
     bool ds5_advanced_mode_base::is_enabled() const
@@ -57,13 +64,14 @@ namespace librealsense
     {
         send_receive(encode_command(ds::fw_cmd::EN_ADV, enable));
         send_receive(encode_command(ds::fw_cmd::HWRST));
+        invalidate_last_known();
     }
 
     void ds5_advanced_mode_base::apply_preset(const std::vector<platform::stream_profile>& configuration,
                                               rs2_rs400_visual_preset preset, uint16_t device_pid,
                                               const firmware_version& fw_version)
     {
-        auto p = get_all();
+        auto p = get_all(true);
         auto res = get_res_type(configuration.front().width, configuration.front().height);
 
         switch (preset)
@@ -683,28 +691,32 @@ namespace librealsense
         if (!is_enabled())
             throw wrong_api_call_sequence_exception(to_string() << "load_json(...) failed! Device is not in Advanced-Mode.");
 
-        auto p = get_all();
+        // Only the groups the json changes are written, the others are taken from the last known values rather than read
+        auto p = get_all(true);
         update_structs(json_content, p);
         set_all(p);
         _preset_opt->set(RS2_RS400_VISUAL_PRESET_CUSTOM);
     }
 
-    preset ds5_advanced_mode_base::get_all() const
+    preset ds5_advanced_mode_base::get_all(bool last_known) const
     {
         preset p;
-        get_depth_control_group(&p.depth_controls);
-        get_rsm(&p.rsm);
-        get_rau_support_vector_control(&p.rsvc);
-        get_color_control(&p.color_control);
-        get_rau_color_thresholds_control(&p.rctc);
-        get_slo_color_thresholds_control(&p.sctc);
-        get_slo_penalty_control(&p.spc);
-        get_hdad(&p.hdad);
-        get_color_correction(&p.cc);
-        get_depth_table_control(&p.depth_table);
-        get_ae_control(&p.ae);
-        get_census_radius(&p.census);
-        get_amp_factor(&p.amplitude_factor);
+        get_group(&p.depth_controls, last_known);
+        get_group(&p.rsm, last_known);
+        get_group(&p.rsvc, last_known);
+        get_group(&p.color_control, last_known);
+        get_group(&p.rctc, last_known);
+        get_group(&p.sctc, last_known);
+        get_group(&p.spc, last_known);
+        get_group(&p.hdad, last_known);
+        get_group(&p.cc, last_known);
+        get_group(&p.depth_table, last_known);
+        get_group(&p.ae, last_known);
+        get_group(&p.census, last_known);
+        if (*_amplitude_factor_support)
+            get_group(&p.amplitude_factor, last_known);
+        else
+            get_amp_factor(&p.amplitude_factor);
         get_laser_power(&p.laser_power);
         get_laser_state(&p.laser_state);
         get_depth_exposure(&p.depth_exposure);
@@ -729,24 +741,28 @@ namespace librealsense
 
     void ds5_advanced_mode_base::set_all(const preset& p)
     {
-        set(p.depth_controls, advanced_mode_traits<STDepthControlGroup>::group);
-        set(p.rsm           , advanced_mode_traits<STRsm>::group);
-        set(p.rsvc          , advanced_mode_traits<STRauSupportVectorControl>::group);
-        set(p.color_control , advanced_mode_traits<STColorControl>::group);
-        set(p.rctc          , advanced_mode_traits<STRauColorThresholdsControl>::group);
-        set(p.sctc          , advanced_mode_traits<STSloColorThresholdsControl>::group);
-        set(p.spc           , advanced_mode_traits<STSloPenaltyControl>::group);
-        set(p.hdad          , advanced_mode_traits<STHdad>::group);
+        // The groups are written back to back, skipping those holding these values already, and applied by the firmware at once
+        bool written = false;
+        written |= write(p.depth_controls, advanced_mode_traits<STDepthControlGroup>::group);
+        written |= write(p.rsm           , advanced_mode_traits<STRsm>::group);
+        written |= write(p.rsvc          , advanced_mode_traits<STRauSupportVectorControl>::group);
+        written |= write(p.color_control , advanced_mode_traits<STColorControl>::group);
+        written |= write(p.rctc          , advanced_mode_traits<STRauColorThresholdsControl>::group);
+        written |= write(p.sctc          , advanced_mode_traits<STSloColorThresholdsControl>::group);
+        written |= write(p.spc           , advanced_mode_traits<STSloPenaltyControl>::group);
+        written |= write(p.hdad          , advanced_mode_traits<STHdad>::group);
 
         // Setting auto-white-balance control before colorCorrection parameters
         set_depth_auto_white_balance(p.depth_auto_white_balance);
-        set(p.cc            , advanced_mode_traits<STColorCorrection>::group);
+        written |= write(p.cc            , advanced_mode_traits<STColorCorrection>::group);
 
-        set(p.depth_table   , advanced_mode_traits<STDepthTableControl>::group);
-        set(p.ae            , advanced_mode_traits<STAEControl>::group);
-        set(p.census        , advanced_mode_traits<STCensusRadius>::group);
+        written |= write(p.depth_table   , advanced_mode_traits<STDepthTableControl>::group);
+        written |= write(p.ae            , advanced_mode_traits<STAEControl>::group);
+        written |= write(p.census        , advanced_mode_traits<STCensusRadius>::group);
         if (*_amplitude_factor_support)
-            set(p.amplitude_factor, advanced_mode_traits<STAFactor>::group);
+            written |= write(p.amplitude_factor, advanced_mode_traits<STAFactor>::group);
+        if (written)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
 
         set_laser_state(p.laser_state);
         if (p.laser_state.was_set && p.laser_state.laser_state == 1) // 1 - on
@@ -782,6 +798,18 @@ namespace librealsense
         //set_color_power_line_frequency(p.color_power_line_frequency);
     }
 
+    void ds5_advanced_mode_base::invalidate_last_known(EtAdvancedModeRegGroup cmd) const
+    {
+        std::lock_guard<std::mutex> lock(_last_known_mtx);
+        _last_known.erase(cmd);
+    }
+
+    void ds5_advanced_mode_base::invalidate_last_known() const
+    {
+        std::lock_guard<std::mutex> lock(_last_known_mtx);
+        _last_known.clear();
+    }
+
     std::vector<uint8_t> ds5_advanced_mode_base::send_receive(const std::vector<uint8_t>& input) const
     {
         auto res = _hw_monitor->send(input);
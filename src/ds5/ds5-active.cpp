@@ -35,10 +35,11 @@ namespace librealsense
             auto emitter_enabled = std::make_shared<emitter_option>(raw_depth_ep);
             depth_ep.register_option(RS2_OPTION_EMITTER_ENABLED, emitter_enabled);
 
-            auto laser_power = std::make_shared<uvc_xu_option<uint16_t>>(raw_depth_ep,
+            auto laser_power = std::make_shared<cached_option>(std::make_shared<uvc_xu_option<uint16_t>>(raw_depth_ep,
                                                                          depth_xu,
                                                                          DS5_LASER_POWER,
-                                                                         "Manual laser power in mw. applicable only when laser power mode is set to Manual");
+                                                                         "Manual laser power in mw. applicable only when laser power mode is set to Manual"),
+                                                               raw_depth_ep.get_option_cache());
 
             depth_ep.register_option(RS2_OPTION_LASER_POWER,
                                      std::make_shared<auto_disabling_control>(
@@ -46,9 +47,9 @@ namespace librealsense
                                      emitter_enabled,
                                      std::vector<float>{0.f, 2.f}, 1.f));
 
-            depth_ep.register_option(RS2_OPTION_PROJECTOR_TEMPERATURE,
+            depth_ep.register_option(RS2_OPTION_PROJECTOR_TEMPERATURE, std::make_shared<cached_option>(
                 std::make_shared<asic_and_projector_temperature_options>(raw_depth_ep,
-                    RS2_OPTION_PROJECTOR_TEMPERATURE));
+                    RS2_OPTION_PROJECTOR_TEMPERATURE), raw_depth_ep.get_option_cache(), std::chrono::milliseconds(500)));
         }
         else
         {
@@ -124,9 +124,37 @@ namespace librealsense
     const int DEFAULT_SPEED = auto_calib_speed::speed_slow;
     const int DEFAULT_SCAN = scan_parameter::py_scan;
     const int DEFAULT_SAMPLING = data_sampling::polling;
+    const int CALIBRATION_POLL_INTERVAL_MS = 200;
+
+    struct auto_calibrated::calibration_job
+    {
+        bool tare;
+        int speed;
+        bool apply_preset;
+        command begin{ ds::AUTO_CALIB };
+        int check_status;
+        std::shared_ptr<ds5_advanced_mode_base> preset_recover;
+        DirectSearchCalibrationResult result;
+        int polls;
+    };
+
+    // Held by a calibration from its begin command to its result, so a second one doesn't interleave its commands
+    class calibration_guard
+    {
+    public:
+        explicit calibration_guard(std::atomic<bool>& running) : _running(running)
+        {
+            if (_running.exchange(true))
+                throw wrong_api_call_sequence_exception("A calibration is already running on this device");
+        }
+        ~calibration_guard() { _running = false; }
+
+    private:
+        std::atomic<bool>& _running;
+    };
 
     auto_calibrated::auto_calibrated(std::shared_ptr<hw_monitor>& hwm)
-        : _hw_monitor(hwm){}
+        : _hw_monitor(hwm), _calibration_running(false){}
 
     std::map<std::string, int> auto_calibrated::parse_json(std::string json_content)
     {
@@ -153,7 +181,7 @@ namespace librealsense
         }
     }
 
-    std::vector<uint8_t> auto_calibrated::run_on_chip_calibration(int timeout_ms, std::string json, float* health, update_progress_callback_ptr progress_callback)
+    std::shared_ptr<auto_calibrated::calibration_job> auto_calibrated::prepare_on_chip_calibration(std::string json)
     {
         int speed = DEFAULT_SPEED;
         int scan_parameter = DEFAULT_SCAN;
@@ -175,73 +203,16 @@ namespace librealsense
 
         param4 param{ (byte)scan_parameter, 0, (byte)data_sampling };
 
-        std::shared_ptr<ds5_advanced_mode_base> preset_recover;
-        if (speed == speed_white_wall && apply_preset)
-            preset_recover = change_preset();
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-
-        // Begin auto-calibration
-        _hw_monitor->send(command{ ds::AUTO_CALIB, auto_calib_begin, speed, 0, param.param_4});
-
-        DirectSearchCalibrationResult result{};
-
-        int count = 0;
-        bool done = false;
-
-        auto start = std::chrono::high_resolution_clock::now();
-        auto now = start;
-
-        // While not ready...
-        do
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
-
-            // Check calibration status
-            try
-            {
-                auto res = _hw_monitor->send(command{ ds::AUTO_CALIB, auto_calib_check_status });
-
-                if (res.size() < sizeof(DirectSearchCalibrationResult))
-                    throw std::runtime_error("Not enough data from CALIB_STATUS!");
-
-                result = *reinterpret_cast<DirectSearchCalibrationResult*>(res.data());
-                done = result.status != RS2_DSC_STATUS_RESULT_NOT_READY;
-            }
-            catch (const std::exception& ex)
-            {
-                LOG_WARNING(ex.what());
-            }
-            if (progress_callback)
-                progress_callback->on_update_progress(count++ * (2.f * speed)); //curently this number does not reflect the actual progress
-
-            now = std::chrono::high_resolution_clock::now();
-
-        } while (now - start < std::chrono::milliseconds(timeout_ms) && !done);
-
-
-        // If we exit due to timeout, report timeout
-        if (!done)
-        {
-            throw std::runtime_error("Operation timed-out!\n"
-                "Calibration state did not converged in time");
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-        auto status = (rs2_dsc_status)result.status;
-
-        // Handle errors from firmware
-        if (status != RS2_DSC_STATUS_SUCCESS)
-        {
-            handle_calibration_error(status);
-        }
-
-        auto res = get_calibration_results(health);
-        return res;
+        auto job = std::make_shared<calibration_job>();
+        job->tare = false;
+        job->speed = speed;
+        job->apply_preset = speed == speed_white_wall && apply_preset;
+        job->begin = command{ ds::AUTO_CALIB, auto_calib_begin, speed, 0, param.param_4 };
+        job->check_status = auto_calib_check_status;
+        return job;
     }
 
-    std::vector<uint8_t> auto_calibrated::run_tare_calibration(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback)
+    std::shared_ptr<auto_calibrated::calibration_job> auto_calibrated::prepare_tare_calibration(float ground_truth_mm, std::string json)
     {
         int average_step_count = DEFAULT_AVERAGE_STEP_COUNT;
         int step_count = DEFAULT_STEP_COUNT;
@@ -266,55 +237,84 @@ namespace librealsense
         LOG_INFO("run_tare_calibration with parameters: speed = " << speed << " average_step_count = " << average_step_count << " step_count = " << step_count << " accuracy = " << accuracy << " scan_parameter = " << scan_parameter << " data_sampling = " << data_sampling);
         check_tare_params(speed, scan_parameter, data_sampling, average_step_count, step_count, accuracy);
 
-        std::shared_ptr<ds5_advanced_mode_base> preset_recover;
-        if (apply_preset)
-            preset_recover = change_preset();
-
         auto param2 = (int)ground_truth_mm * 100;
 
         tare_calibration_params param3{ (byte)average_step_count, (byte)step_count, (byte)accuracy, 0};
 
         param4 param{ (byte)scan_parameter, 0, (byte)data_sampling };
 
-        _hw_monitor->send(command{ ds::AUTO_CALIB, tare_calib_begin, param2, param3.param3, param.param_4});
+        auto job = std::make_shared<calibration_job>();
+        job->tare = true;
+        job->speed = speed;
+        job->apply_preset = apply_preset != 0;
+        job->begin = command{ ds::AUTO_CALIB, tare_calib_begin, param2, param3.param3, param.param_4 };
+        job->check_status = tare_calib_check_status;
+        return job;
+    }
 
-        DirectSearchCalibrationResult result;
+    void auto_calibrated::begin_calibration(calibration_job& job)
+    {
+        if (job.apply_preset)
+            job.preset_recover = change_preset();
 
-        // While not ready...
-        int count = 0;
-        bool done = false;
+        if (!job.tare)
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        // Begin auto-calibration
+        _hw_monitor->send(job.begin);
 
-        auto start = std::chrono::high_resolution_clock::now();
-        auto now = start;
+        memset(&job.result, 0, sizeof(DirectSearchCalibrationResult));
+        job.polls = 0;
+    }
 
-        do
+    bool auto_calibrated::check_calibration_status(calibration_job& job)
+    {
+        // Check calibration status
+        try
         {
-            memset(&result, 0, sizeof(DirectSearchCalibrationResult));
+            auto res = _hw_monitor->send(command{ ds::AUTO_CALIB, job.check_status });
+            if (res.size() < sizeof(DirectSearchCalibrationResult))
+                throw std::runtime_error("Not enough data from CALIB_STATUS!");
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            job.result = *reinterpret_cast<DirectSearchCalibrationResult*>(res.data());
+            return job.result.status != RS2_DSC_STATUS_RESULT_NOT_READY;
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_WARNING(ex.what());
+        }
+        return false;
+    }
 
-            // Check calibration status
-            try
-            {
-                auto res = _hw_monitor->send(command{ ds::AUTO_CALIB, tare_calib_check_status });
-                if (res.size() < sizeof(DirectSearchCalibrationResult))
-                    throw std::runtime_error("Not enough data from CALIB_STATUS!");
+    std::vector<uint8_t> auto_calibrated::end_calibration(calibration_job& job, float* health)
+    {
+        if (!job.tare)
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-                result = *reinterpret_cast<DirectSearchCalibrationResult*>(res.data());
-                done = result.status != RS2_DSC_STATUS_RESULT_NOT_READY;
-            }
+        auto status = (rs2_dsc_status)job.result.status;
 
-            catch (const std::exception& ex)
-            {
-                LOG_WARNING(ex.what());
-            }
+        // Handle errors from firmware
+        if (status != RS2_DSC_STATUS_SUCCESS)
+        {
+            handle_calibration_error(status);
+        }
 
-            if (progress_callback)
-                progress_callback->on_update_progress(count++ * (2.f * speed)); //curently this number does not reflect the actual progress
+        return get_calibration_results(job.tare ? nullptr : health);
+    }
 
-            now = std::chrono::high_resolution_clock::now();
+    void auto_calibrated::wait_for_calibration(calibration_job& job, int timeout_ms, update_progress_callback_ptr progress_callback)
+    {
+        auto deadline = std::chrono::high_resolution_clock::now() + std::chrono::milliseconds(timeout_ms);
+        bool done = false;
 
-        } while (now - start < std::chrono::milliseconds(timeout_ms) && !done);
+        // While not ready...
+        do
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(CALIBRATION_POLL_INTERVAL_MS));
+            done = check_calibration_status(job);
+            if (progress_callback)
+                progress_callback->on_update_progress(job.polls++ * (2.f * job.speed)); //curently this number does not reflect the actual progress
+        } while (std::chrono::high_resolution_clock::now() < deadline && !done);
 
         // If we exit due to timeout, report timeout
         if (!done)
@@ -322,16 +322,72 @@ namespace librealsense
             throw std::runtime_error("Operation timed-out!\n"
                 "Calibration state did not converged in time");
         }
+    }
 
-        auto status = (rs2_dsc_status)result.status;
+    std::vector<uint8_t> auto_calibrated::run_on_chip_calibration(int timeout_ms, std::string json, float* health, update_progress_callback_ptr progress_callback)
+    {
+        auto job = prepare_on_chip_calibration(json);
+        calibration_guard guard(_calibration_running);
+        begin_calibration(*job);
+        wait_for_calibration(*job, timeout_ms, progress_callback);
+        return end_calibration(*job, health);
+    }
 
-        // Handle errors from firmware
-        if (status != RS2_DSC_STATUS_SUCCESS)
+    std::vector<uint8_t> auto_calibrated::run_tare_calibration(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback)
+    {
+        auto job = prepare_tare_calibration(ground_truth_mm, json);
+        calibration_guard guard(_calibration_running);
+        begin_calibration(*job);
+        wait_for_calibration(*job, timeout_ms, progress_callback);
+        return end_calibration(*job, nullptr);
+    }
+
+    void auto_calibrated::run_on_chip_calibration_async(int timeout_ms, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback)
+    {
+        run_calibration_async(prepare_on_chip_calibration(json), timeout_ms, progress_callback, done_callback);
+    }
+
+    void auto_calibrated::run_tare_calibration_async(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback)
+    {
+        run_calibration_async(prepare_tare_calibration(ground_truth_mm, json), timeout_ms, progress_callback, done_callback);
+    }
+
+    void auto_calibrated::run_calibration_async(std::shared_ptr<calibration_job> job, int timeout_ms, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback)
+    {
+        // The thread holds the device, which may be released by the application while it calibrates.
+        // It is detached since the device may be destroyed on it
+        auto dev = dynamic_cast<device_interface*>(this)->shared_from_this();
+        auto guard = std::make_shared<calibration_guard>(_calibration_running);
+
+        std::thread([this, dev, guard, job, timeout_ms, progress_callback, done_callback]() mutable
         {
-            handle_calibration_error(status);
-        }
+            std::vector<uint8_t> table;
+            float health = 0;
+            std::string error;
+            try
+            {
+                begin_calibration(*job);
+                wait_for_calibration(*job, timeout_ms, progress_callback);
+                table = end_calibration(*job, &health);
+            }
+            catch (const std::exception& e)
+            {
+                error = e.what();
+            }
+            catch (...)
+            {
+                error = "Unknown error during calibration";
+            }
 
-        return get_calibration_results();
+            // The preset is restored and the next calibration allowed before the application hears of the result
+            job.reset();
+            guard.reset();
+            if (done_callback)
+                done_callback->on_calibration_done(table.data(), static_cast<int>(table.size()), health, error.empty() ? nullptr : error.c_str());
+            progress_callback.reset();
+            done_callback.reset();
+            dev.reset();
+        }).detach();
     }
 
     std::shared_ptr<ds5_advanced_mode_base> auto_calibrated::change_preset()
@@ -15,11 +15,23 @@ namespace librealsense
         void write_calibration() const override;
         std::vector<uint8_t> run_on_chip_calibration(int timeout_ms, std::string json, float* health, update_progress_callback_ptr progress_callback) override;
         std::vector<uint8_t> run_tare_calibration(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback) override;
+        void run_on_chip_calibration_async(int timeout_ms, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback) override;
+        void run_tare_calibration_async(int timeout_ms, float ground_truth_mm, std::string json, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback) override;
         std::vector<uint8_t> get_calibration_table() const override;
         void set_calibration_table(const std::vector<uint8_t>& calibration) override;
         void reset_to_factory_calibration() const override;
 
     private:
+        // A calibration from its validated parameters to its result
+        struct calibration_job;
+        std::shared_ptr<calibration_job> prepare_on_chip_calibration(std::string json);
+        std::shared_ptr<calibration_job> prepare_tare_calibration(float ground_truth_mm, std::string json);
+        void begin_calibration(calibration_job& job);
+        bool check_calibration_status(calibration_job& job);
+        void wait_for_calibration(calibration_job& job, int timeout_ms, update_progress_callback_ptr progress_callback);
+        std::vector<uint8_t> end_calibration(calibration_job& job, float* health);
+        void run_calibration_async(std::shared_ptr<calibration_job> job, int timeout_ms, update_progress_callback_ptr progress_callback, calibration_done_callback_ptr done_callback);
+
         std::vector<uint8_t> get_calibration_results(float* health = nullptr) const;
         void handle_calibration_error(int status) const;
         std::map<std::string, int> parse_json(std::string json);
@@ -29,6 +41,7 @@ namespace librealsense
 
         std::vector<uint8_t> _curr_calibration;
         std::shared_ptr<hw_monitor>& _hw_monitor;
+        std::atomic<bool> _calibration_running;
     };
 
 }
@@ -77,6 +77,7 @@ namespace librealsense
             ds5_color_fourcc_to_rs2_format,
             ds5_color_fourcc_to_rs2_stream);
         color_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
+        color_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
 
         color_ep->register_info(RS2_CAMERA_INFO_PHYSICAL_PORT, color_devices_info.front().device_path);
 
@@ -182,11 +183,12 @@ namespace librealsense
 
         color_ep->register_processing_block(processing_block_factory::create_pbf_vector<uyvy_converter>(RS2_FORMAT_UYVY, map_supported_color_formats(RS2_FORMAT_UYVY), RS2_STREAM_COLOR));
         color_ep->register_processing_block(processing_block_factory::create_pbf_vector<yuy2_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
+        color_ep->register_processing_block(processing_block_factory::create_multi_output_pbf<yuy2_multi_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
         color_ep->register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_RAW16, RS2_STREAM_COLOR));
 
         if (color_devices_info.front().pid == ds::RS465_PID)
         {
-            color_ep->register_processing_block({ {RS2_FORMAT_MJPEG} }, { {RS2_FORMAT_RGB8, RS2_STREAM_COLOR} }, []() { return std::make_shared<mjpeg_converter>(RS2_FORMAT_RGB8); });
+            color_ep->register_processing_block(processing_block_factory::create_pbf_vector<mjpeg_converter>(RS2_FORMAT_MJPEG, map_supported_color_formats(RS2_FORMAT_MJPEG), RS2_STREAM_COLOR));
             color_ep->register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_MJPEG, RS2_STREAM_COLOR));
         }
 
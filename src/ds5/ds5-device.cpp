@@ -394,7 +394,7 @@ namespace librealsense
 
         void set_depth_scale(float val){ _depth_units = val; }
 
-        void init_hdr_config(const option_range& exposure_range, const option_range& gain_range)
+        void init_hdr_config(std::function<option_range()> exposure_range, std::function<option_range()> gain_range)
         {
             _hdr_cfg = std::make_shared<hdr_config>(*(_owner->_hw_monitor), get_raw_sensor(),
                 exposure_range, gain_range);
@@ -518,11 +518,9 @@ namespace librealsense
         return {};
     }
 
-    ds::d400_caps ds5_device::parse_device_capabilities(const uint16_t pid) const
+    ds::d400_caps ds5_device::parse_device_capabilities(const std::vector<uint8_t>& gvd_buf, const uint16_t pid) const
     {
         using namespace ds;
-        std::array<unsigned char,HW_MONITOR_BUFFER_SIZE> gvd_buf;
-        _hw_monitor->get_gvd(gvd_buf.size(), gvd_buf.data(), GVD);
 
         // Opaque retrieval
         d400_caps val{d400_caps::CAP_UNDEFINED};
@@ -577,6 +575,7 @@ namespace librealsense
         depth_ep->register_info(RS2_CAMERA_INFO_PHYSICAL_PORT, filter_by_mi(all_device_infos, 0).front().device_path);
 
         depth_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
+        depth_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
 
         depth_ep->register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_Y8, RS2_STREAM_INFRARED, 1));
         depth_ep->register_processing_block(processing_block_factory::create_id_pbf(RS2_FORMAT_Z16, RS2_STREAM_DEPTH));
@@ -658,7 +657,7 @@ namespace librealsense
 
         _recommended_fw_version = firmware_version(D4XX_RECOMMENDED_FIRMWARE_VERSION);
         if (_fw_version >= firmware_version("5.10.4.0"))
-            _device_capabilities = parse_device_capabilities(pid);
+            _device_capabilities = parse_device_capabilities(gvd_buff, pid);
 
         auto& depth_sensor = get_depth_sensor();
         auto& raw_depth_sensor = get_raw_depth_sensor();
@@ -700,12 +699,12 @@ namespace librealsense
 
         if ((pid == RS416_PID || pid == RS416_RGB_PID) && _fw_version >= firmware_version("5.12.0.1"))
         {
-            depth_sensor.register_option(RS2_OPTION_HARDWARE_PRESET,
+            depth_sensor.register_option(RS2_OPTION_HARDWARE_PRESET, std::make_shared<cached_option>(
                 std::make_shared<uvc_xu_option<uint8_t>>(raw_depth_sensor, depth_xu, DS5_HARDWARE_PRESET,
-                    "Hardware pipe configuration"));
-            depth_sensor.register_option(RS2_OPTION_LED_POWER,
+                    "Hardware pipe configuration"), raw_depth_sensor.get_option_cache()));
+            depth_sensor.register_option(RS2_OPTION_LED_POWER, std::make_shared<cached_option>(
                 std::make_shared<uvc_xu_option<uint16_t>>(raw_depth_sensor, depth_xu, DS5_LED_PWR,
-                    "Set the power level of the LED, with 0 meaning LED off"));
+                    "Set the power level of the LED, with 0 meaning LED off"), raw_depth_sensor.get_option_cache()));
         }
 
         //if ((pid == RS405_PID || pid == RS455_PID) && _fw_version >= firmware_version("5.12.4.0"))
@@ -717,7 +716,7 @@ namespace librealsense
 
         if (_fw_version >= firmware_version("5.6.3.0"))
         {
-            _is_locked = _hw_monitor->is_camera_locked(GVD, is_camera_locked_offset);
+            _is_locked = gvd_buff[is_camera_locked_offset] != 0;
 
 #ifdef HWM_OVER_XU
             //if hw_monitor was created by usb replace it with xu
@@ -735,9 +734,11 @@ namespace librealsense
 
         if (_fw_version >= firmware_version("5.5.8.0"))
         {
-            depth_sensor.register_option(RS2_OPTION_OUTPUT_TRIGGER_ENABLED,
+            depth_sensor.register_option(RS2_OPTION_OUTPUT_TRIGGER_ENABLED, std::make_shared<cached_option>(
                 std::make_shared<uvc_xu_option<uint8_t>>(raw_depth_sensor, depth_xu, DS5_EXT_TRIGGER,
-                    "Generate trigger from the camera to external device once per frame"));
+                    "Generate trigger from the camera to external device once per frame"), raw_depth_sensor.get_option_cache()));
+
+            // The error reporting control is read by the error polling, never cached
 
             auto error_control = std::make_shared<uvc_xu_option<uint8_t>>(raw_depth_sensor, depth_xu, DS5_ERROR_REPORTING, "Error reporting");
 
@@ -748,9 +749,9 @@ namespace librealsense
 
             depth_sensor.register_option(RS2_OPTION_ERROR_POLLING_ENABLED, std::make_shared<polling_errors_disable>(_polling_error_handler));
 
-            depth_sensor.register_option(RS2_OPTION_ASIC_TEMPERATURE,
+            depth_sensor.register_option(RS2_OPTION_ASIC_TEMPERATURE, std::make_shared<cached_option>(
                 std::make_shared<asic_and_projector_temperature_options>(raw_depth_sensor,
-                    RS2_OPTION_ASIC_TEMPERATURE));
+                    RS2_OPTION_ASIC_TEMPERATURE), raw_depth_sensor.get_option_cache(), std::chrono::milliseconds(500)));
         }
 
         // minimal firmware version in which hdr feature is supported
@@ -790,13 +791,18 @@ namespace librealsense
         std::shared_ptr<option> gain_option = nullptr;
 
         //EXPOSURE AND GAIN - preparing uvc options
-        auto uvc_xu_exposure_option = std::make_shared<uvc_xu_option<uint32_t>>(raw_depth_sensor,
+        // the exposure changes on its own under auto exposure
+        auto uvc_xu_exposure_option = std::make_shared<cached_option>(std::make_shared<uvc_xu_option<uint32_t>>(raw_depth_sensor,
             depth_xu,
             DS5_EXPOSURE,
-            "Depth Exposure (usec)");
-        option_range exposure_range = uvc_xu_exposure_option->get_range();
+            "Depth Exposure (usec)"), raw_depth_sensor.get_option_cache(), std::chrono::milliseconds(100));
         auto uvc_pu_gain_option = std::make_shared<uvc_pu_option>(raw_depth_sensor, RS2_OPTION_GAIN);
-        option_range gain_range = uvc_pu_gain_option->get_range();
+
+        // The ranges take several control transfers each and are needed by HDR only, they are queried on its first use
+        auto exposure_range_query = std::make_shared<lazy<option_range>>([uvc_xu_exposure_option]() { return uvc_xu_exposure_option->get_range(); });
+        auto gain_range_query = std::make_shared<lazy<option_range>>([uvc_pu_gain_option]() { return uvc_pu_gain_option->get_range(); });
+        auto exposure_range = [exposure_range_query]() { return **exposure_range_query; };
+        auto gain_range = [gain_range_query]() { return **gain_range_query; };
 
         // register HDR options
         //auto global_shutter_mask = d400_caps::CAP_GLOBAL_SHUTTER;
@@ -851,10 +857,10 @@ namespace librealsense
         depth_sensor.register_option(RS2_OPTION_GAIN, gain_option);
 
         //AUTO EXPOSURE
-        auto enable_auto_exposure = std::make_shared<uvc_xu_option<uint8_t>>(raw_depth_sensor,
+        auto enable_auto_exposure = std::make_shared<cached_option>(std::make_shared<uvc_xu_option<uint8_t>>(raw_depth_sensor,
             depth_xu,
             DS5_ENABLE_AUTO_EXPOSURE,
-            "Enable Auto Exposure");
+            "Enable Auto Exposure"), raw_depth_sensor.get_option_cache());
         depth_sensor.register_option(RS2_OPTION_ENABLE_AUTO_EXPOSURE, enable_auto_exposure);
 
         depth_sensor.register_option(RS2_OPTION_EXPOSURE,
@@ -1089,6 +1095,7 @@ namespace librealsense
         auto depth_ep = std::make_shared<ds5u_depth_sensor>(this, raw_depth_ep);
 
         depth_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
+        depth_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
 
         raw_depth_ep->register_xu(depth_xu); // make sure the XU is initialized every time we power the camera
 
@@ -1128,19 +1135,19 @@ namespace librealsense
             auto emitter_enabled = std::make_shared<emitter_option>(depth_ep);
             depth_ep.register_option(RS2_OPTION_EMITTER_ENABLED, emitter_enabled);
 
-            auto laser_power = std::make_shared<uvc_xu_option<uint16_t>>(depth_ep,
+            auto laser_power = std::make_shared<cached_option>(std::make_shared<uvc_xu_option<uint16_t>>(depth_ep,
                 depth_xu,
                 DS5_LASER_POWER,
-                "Manual laser power in mw. applicable only when laser power mode is set to Manual");
+                "Manual laser power in mw. applicable only when laser power mode is set to Manual"), depth_ep.get_option_cache());
             depth_ep.register_option(RS2_OPTION_LASER_POWER,
                 std::make_shared<auto_disabling_control>(
                     laser_power,
                     emitter_enabled,
                     std::vector<float>{0.f, 2.f}, 1.f));
 
-            depth_ep.register_option(RS2_OPTION_PROJECTOR_TEMPERATURE,
+            depth_ep.register_option(RS2_OPTION_PROJECTOR_TEMPERATURE, std::make_shared<cached_option>(
                 std::make_shared<asic_and_projector_temperature_options>(depth_ep,
-                    RS2_OPTION_PROJECTOR_TEMPERATURE));
+                    RS2_OPTION_PROJECTOR_TEMPERATURE), depth_ep.get_option_cache(), std::chrono::milliseconds(500)));
         }
     }
 
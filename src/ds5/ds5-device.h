@@ -72,7 +72,7 @@ namespace librealsense
 
         float get_stereo_baseline_mm() const;
 
-        ds::d400_caps  parse_device_capabilities(const uint16_t pid) const;
+        ds::d400_caps  parse_device_capabilities(const std::vector<uint8_t>& gvd_buf, const uint16_t pid) const;
 
         //TODO - add these to device class as pure virtual methods
         command get_firmware_logs_command() const;
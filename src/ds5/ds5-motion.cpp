@@ -215,6 +215,7 @@ namespace librealsense
         auto hid_ep = std::make_shared<ds5_hid_sensor>("Motion Module", raw_hid_ep, this, this);
 
         hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
+        hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
 
         // register pre-processing
         std::shared_ptr<enable_motion_correction> mm_correct_opt = nullptr;
@@ -283,6 +284,14 @@ namespace librealsense
                                 std::make_shared<auto_exposure_step_option>(auto_exposure,
                                                                             ae_state,
                                                                             option_range{ 0.1f, 1.0f, 0.1f, ae_step_default_value }));
+        ep->register_option(RS2_OPTION_AUTO_EXPOSURE_SAMPLE_RATE,
+                                std::make_shared<auto_exposure_sample_rate_option>(auto_exposure,
+                                                                                   ae_state,
+                                                                                   option_range{ 1, 8, 1, ae_sample_rate_default_value }));
+        ep->register_option(RS2_OPTION_AUTO_EXPOSURE_SKIP_FRAMES,
+                                std::make_shared<auto_exposure_skip_frames_option>(auto_exposure,
+                                                                                   ae_state,
+                                                                                   option_range{ 0, 30, 1, ae_skip_frames_default_value }));
         ep->register_option(RS2_OPTION_POWER_LINE_FREQUENCY,
                                 std::make_shared<auto_exposure_antiflicker_rate_option>(auto_exposure,
                                                                                         ae_state,
@@ -390,6 +399,7 @@ namespace librealsense
         auto fisheye_ep = std::make_shared<ds5_fisheye_sensor>(raw_fisheye_ep, this, this);
 
         fisheye_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
+        fisheye_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
         raw_fisheye_ep->register_xu(fisheye_xu); // make sure the XU is initialized everytime we power the camera
 
         if (_fw_version >= firmware_version("5.6.3.0")) // Create Auto Exposure controls from FW version 5.6.3.0
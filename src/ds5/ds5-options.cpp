@@ -282,6 +282,52 @@ namespace librealsense
         return static_cast<float>(_auto_exposure_state->get_auto_exposure_step());
     }
 
+    auto_exposure_sample_rate_option::auto_exposure_sample_rate_option(std::shared_ptr<auto_exposure_mechanism> auto_exposure,
+        std::shared_ptr<auto_exposure_state> auto_exposure_state,
+        const option_range& opt_range)
+        : option_base(opt_range),
+        _auto_exposure_state(auto_exposure_state),
+        _auto_exposure(auto_exposure)
+    {}
+
+    void auto_exposure_sample_rate_option::set(float value)
+    {
+        if (!is_valid(value))
+            throw invalid_value_exception(to_string() << "set(auto_exposure_sample_rate_option) failed! Given value " << value << " is out of range.");
+
+        _auto_exposure_state->set_auto_exposure_sample_rate(static_cast<unsigned>(value));
+        _auto_exposure->update_auto_exposure_state(*_auto_exposure_state);
+        _recording_function(*this);
+    }
+
+    float auto_exposure_sample_rate_option::query() const
+    {
+        return static_cast<float>(_auto_exposure_state->get_auto_exposure_sample_rate());
+    }
+
+    auto_exposure_skip_frames_option::auto_exposure_skip_frames_option(std::shared_ptr<auto_exposure_mechanism> auto_exposure,
+        std::shared_ptr<auto_exposure_state> auto_exposure_state,
+        const option_range& opt_range)
+        : option_base(opt_range),
+        _auto_exposure_state(auto_exposure_state),
+        _auto_exposure(auto_exposure)
+    {}
+
+    void auto_exposure_skip_frames_option::set(float value)
+    {
+        if (!is_valid(value))
+            throw invalid_value_exception(to_string() << "set(auto_exposure_skip_frames_option) failed! Given value " << value << " is out of range.");
+
+        _auto_exposure_state->set_auto_exposure_skip_frames(static_cast<unsigned>(value));
+        _auto_exposure->update_auto_exposure_state(*_auto_exposure_state);
+        _recording_function(*this);
+    }
+
+    float auto_exposure_skip_frames_option::query() const
+    {
+        return static_cast<float>(_auto_exposure_state->get_auto_exposure_skip_frames());
+    }
+
     auto_exposure_antiflicker_rate_option::auto_exposure_antiflicker_rate_option(std::shared_ptr<auto_exposure_mechanism> auto_exposure,
                                                                                  std::shared_ptr<auto_exposure_state> auto_exposure_state,
                                                                                  const option_range& opt_range,
@@ -586,7 +632,7 @@ namespace librealsense
 
     void hdr_option::set(float value)
     {
-        _hdr_cfg->set(_option, value, _range);
+        _hdr_cfg->set(_option, value, *_range);
         _record_action(*this);
     }
 
@@ -597,7 +643,7 @@ namespace librealsense
 
     option_range hdr_option::get_range() const
     {
-        return _range;
+        return *_range;
     }
 
     const char* hdr_option::get_value_description(float val) const
@@ -133,6 +133,52 @@ namespace librealsense
         std::shared_ptr<auto_exposure_mechanism>    _auto_exposure;
     };
 
+    class auto_exposure_sample_rate_option : public option_base
+    {
+    public:
+        auto_exposure_sample_rate_option(std::shared_ptr<auto_exposure_mechanism> auto_exposure,
+                                         std::shared_ptr<auto_exposure_state> auto_exposure_state,
+                                         const option_range& opt_range);
+
+        void set(float value) override;
+
+        float query() const override;
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Auto-Exposure histogram counts every Nth pixel of every Nth row";
+        }
+
+    private:
+        std::shared_ptr<auto_exposure_state>        _auto_exposure_state;
+        std::shared_ptr<auto_exposure_mechanism>    _auto_exposure;
+    };
+
+    class auto_exposure_skip_frames_option : public option_base
+    {
+    public:
+        auto_exposure_skip_frames_option(std::shared_ptr<auto_exposure_mechanism> auto_exposure,
+                                         std::shared_ptr<auto_exposure_state> auto_exposure_state,
+                                         const option_range& opt_range);
+
+        void set(float value) override;
+
+        float query() const override;
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Number of frames skipped between two Auto-Exposure evaluations";
+        }
+
+    private:
+        std::shared_ptr<auto_exposure_state>        _auto_exposure_state;
+        std::shared_ptr<auto_exposure_mechanism>    _auto_exposure;
+    };
+
     class auto_exposure_antiflicker_rate_option : public option_base
     {
     public:
@@ -306,10 +352,14 @@ namespace librealsense
     {
     public:
         hdr_option(std::shared_ptr<hdr_config> hdr_cfg, rs2_option option, option_range range)
-            : _hdr_cfg(hdr_cfg), _option(option), _range(range) {}
+            : _hdr_cfg(hdr_cfg), _option(option), _range([range]() { return range; }) {}
+
+        // Range queried from the device on first use
+        hdr_option(std::shared_ptr<hdr_config> hdr_cfg, rs2_option option, std::function<option_range()> range)
+            : _hdr_cfg(hdr_cfg), _option(option), _range(std::move(range)) {}
 
         hdr_option(std::shared_ptr<hdr_config> hdr_cfg, rs2_option option, option_range range, const std::map<float, std::string>& description_per_value)
-            : _hdr_cfg(hdr_cfg), _option(option), _range(range), _description_per_value(description_per_value) {}
+            : _hdr_cfg(hdr_cfg), _option(option), _range([range]() { return range; }), _description_per_value(description_per_value) {}
 
         virtual ~hdr_option() = default;
         virtual void set(float value) override;
@@ -324,7 +374,7 @@ namespace librealsense
         std::function<void(const option&)> _record_action = [](const option&) {};
         std::shared_ptr<hdr_config> _hdr_cfg;
         rs2_option _option;
-        option_range _range;
+        lazy<option_range> _range;
         const std::map<float, std::string> _description_per_value;
     };
 
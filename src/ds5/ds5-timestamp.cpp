@@ -23,9 +23,7 @@ namespace librealsense
 
     bool ds5_timestamp_reader_from_metadata::has_metadata(const std::shared_ptr<frame_interface>& frame)
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
-
-        auto f = std::dynamic_pointer_cast<librealsense::frame>(frame);
+        auto f = dynamic_cast<librealsense::frame*>(frame.get());
         if (!f)
         {
             LOG_ERROR("Frame is not valid. Failed to downcast to librealsense::frame.");
@@ -46,9 +44,7 @@ namespace librealsense
 
     rs2_time_t ds5_timestamp_reader_from_metadata::get_frame_timestamp(const std::shared_ptr<frame_interface>& frame)
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
-
-        auto f = std::dynamic_pointer_cast<librealsense::frame>(frame);
+        auto f = dynamic_cast<librealsense::frame*>(frame.get());
         if (!f)
         {
             LOG_ERROR("Frame is not valid. Failed to downcast to librealsense::frame.");
@@ -59,29 +55,25 @@ namespace librealsense
         if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
-        _has_metadata[pin_index] = has_metadata(frame);
+        bool frame_has_metadata = has_metadata(frame);
+        _has_metadata[pin_index].store(frame_has_metadata, std::memory_order_relaxed);
 
         auto md = (librealsense::metadata_intel_basic*)(f->additional_data.metadata_blob.data());
-        if(_has_metadata[pin_index] && md)
+        if(frame_has_metadata && md)
         {
             return (double)(md->header.timestamp)*TIMESTAMP_USEC_TO_MSEC;
         }
         else
         {
-            if (!one_time_note)
-            {
+            if (!one_time_note.exchange(true))
                 LOG_WARNING("UVC metadata payloads not available. Please refer to the installation chapter for details.");
-                one_time_note = true;
-            }
             return _backup_timestamp_reader->get_frame_timestamp(frame);
         }
     }
 
     unsigned long long ds5_timestamp_reader_from_metadata::get_frame_counter(const std::shared_ptr<frame_interface>& frame) const
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
-
-        auto f = std::dynamic_pointer_cast<librealsense::frame>(frame);
+        auto f = dynamic_cast<librealsense::frame*>(frame.get());
         if (!f)
         {
             LOG_ERROR("Frame is not valid. Failed to downcast to librealsense::frame.");
@@ -92,7 +84,7 @@ namespace librealsense
         if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
-        if(_has_metadata[pin_index] && f->additional_data.metadata_size > platform::uvc_header_size)
+        if(_has_metadata[pin_index].load(std::memory_order_relaxed) && f->additional_data.metadata_size > platform::uvc_header_size)
         {
             auto md = (librealsense::metadata_intel_basic*)(f->additional_data.metadata_blob.data());
             if (md->capture_valid())
@@ -104,7 +96,6 @@ namespace librealsense
 
     void ds5_timestamp_reader_from_metadata::reset()
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         one_time_note = false;
         for (auto i = 0; i < pins; ++i)
         {
@@ -114,12 +105,11 @@ namespace librealsense
 
     rs2_timestamp_domain ds5_timestamp_reader_from_metadata::get_frame_timestamp_domain(const std::shared_ptr<frame_interface>& frame) const
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         auto pin_index = 0;
         if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
-        return _has_metadata[pin_index] ? RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK :
+        return _has_metadata[pin_index].load(std::memory_order_relaxed) ? RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK :
                                           _backup_timestamp_reader->get_frame_timestamp_domain(frame);
     }
 
@@ -131,7 +121,6 @@ namespace librealsense
 
     void ds5_timestamp_reader::reset()
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         for (auto i = 0; i < pins; ++i)
         {
             counter[i] = 0;
@@ -140,18 +129,16 @@ namespace librealsense
 
     rs2_time_t ds5_timestamp_reader::get_frame_timestamp(const std::shared_ptr<frame_interface>& frame)
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         return _ts->get_time();
     }
 
     unsigned long long ds5_timestamp_reader::get_frame_counter(const std::shared_ptr<frame_interface>& frame) const
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         auto pin_index = 0;
         if (frame->get_stream()->get_format() == RS2_FORMAT_Z16)
             pin_index = 1;
 
-        return ++counter[pin_index];
+        return counter[pin_index].fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
     rs2_timestamp_domain ds5_timestamp_reader::get_frame_timestamp_domain(const std::shared_ptr<frame_interface>& frame) const
@@ -160,14 +147,13 @@ namespace librealsense
     }
 
     ds5_custom_hid_timestamp_reader::ds5_custom_hid_timestamp_reader()
+        : counter(sensors)
     {
-        counter.resize(sensors);
         reset();
     }
 
     void ds5_custom_hid_timestamp_reader::reset()
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         for (auto i = 0; i < sensors; ++i)
         {
             counter[i] = 0;
@@ -176,9 +162,8 @@ namespace librealsense
 
     rs2_time_t ds5_custom_hid_timestamp_reader::get_frame_timestamp(const std::shared_ptr<frame_interface>& frame)
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
         static const uint8_t timestamp_offset = 17;
-        auto f = std::dynamic_pointer_cast<librealsense::frame>(frame);
+        auto f = dynamic_cast<librealsense::frame*>(frame.get());
         if (!f)
         {
             LOG_ERROR("Frame is not valid. Failed to downcast to librealsense::frame.");
@@ -199,8 +184,7 @@ namespace librealsense
 
     unsigned long long ds5_custom_hid_timestamp_reader::get_frame_counter(const std::shared_ptr<frame_interface>& frame) const
     {
-        std::lock_guard<std::recursive_mutex> lock(_mtx);
-        return ++counter.front();
+        return counter.front().fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
     rs2_timestamp_domain ds5_custom_hid_timestamp_reader::get_frame_timestamp_domain(const std::shared_ptr<frame_interface>& frame) const
@@ -10,13 +10,14 @@
 
 namespace librealsense
 {
+    // The readers are called several times per frame, from the capture threads of the streams and from the syncer:
+    // their state is kept in atomics per pin so that none of the calls takes a lock
     class ds5_timestamp_reader_from_metadata : public frame_timestamp_reader
     {
        std::unique_ptr<frame_timestamp_reader> _backup_timestamp_reader;
        static const int pins = 2;
        std::vector<std::atomic<bool>> _has_metadata;
-       bool one_time_note;
-       mutable std::recursive_mutex _mtx;
+       std::atomic<bool> one_time_note;
 
     public:
         ds5_timestamp_reader_from_metadata(std::unique_ptr<frame_timestamp_reader> backup_timestamp_reader);
@@ -35,9 +36,8 @@ namespace librealsense
     class ds5_timestamp_reader : public frame_timestamp_reader
     {
         static const int pins = 2;
-        mutable std::vector<int64_t> counter;
+        mutable std::vector<std::atomic<int64_t>> counter;
         std::shared_ptr<platform::time_service> _ts;
-        mutable std::recursive_mutex _mtx;
     public:
         ds5_timestamp_reader(std::shared_ptr<platform::time_service> ts);
 
@@ -54,8 +54,7 @@ namespace librealsense
     {
         static const int sensors = 4; // TODO: implement frame-counter for each GPIO or
                                       //       reading counter field report
-        mutable std::vector<int64_t> counter;
-        mutable std::recursive_mutex _mtx;
+        mutable std::vector<std::atomic<int64_t>> counter;
     public:
         ds5_custom_hid_timestamp_reader();
 
@@ -6,7 +6,7 @@
 namespace librealsense
 {
     extrinsics_graph::extrinsics_graph()
-        : _locks_count(0)
+        : _cache(std::make_shared<extrinsics_cache>()), _locks_count(0)
     {
         _id = std::make_shared<lazy<rs2_extrinsics>>([]()
         {
@@ -43,6 +43,8 @@ namespace librealsense
 
         _extrinsics[from_idx][to_idx] = extr;
         _extrinsics[to_idx][from_idx] = std::shared_ptr<lazy<rs2_extrinsics>>(nullptr);
+
+        invalidate_cache();
     }
 
     void extrinsics_graph::register_extrinsics(const stream_interface & from, const stream_interface & to, rs2_extrinsics extr)
@@ -109,7 +111,10 @@ namespace librealsense
         }
 
         if (!invalid_ids.empty())
+        {
+            invalidate_cache();
             LOG_INFO("Found " << invalid_ids.size() << " unreachable streams, " << std::dec << counter << " extrinsics deleted");
+        }
     }
 
     int extrinsics_graph::find_stream_profile(const stream_interface& p, bool add_if_not_there)
@@ -129,8 +134,55 @@ namespace librealsense
 
     }
 
+    void extrinsics_graph::invalidate_cache()
+    {
+        std::atomic_store(&_cache, std::make_shared<const extrinsics_cache>());
+    }
+
+    bool extrinsics_graph::try_fetch_cached_extrinsics(const stream_interface& from, const stream_interface& to, rs2_extrinsics* extr) const
+    {
+        auto cache = std::atomic_load(&_cache);
+        auto it = cache->find({ &from, &to });
+        if (it == cache->end())
+            return false;
+
+        // The addresses may belong to streams created since the path was resolved
+        auto& resolved = it->second;
+        if (resolved.from.lock().get() != &from || resolved.to.lock().get() != &to)
+            return false;
+
+        std::vector<std::shared_ptr<lazy<rs2_extrinsics>>> edges;
+        for (auto&& hop : resolved.path)
+        {
+            auto edge = hop.edge.lock();
+            if (!edge || hop.next.expired())
+                return false;
+            edges.push_back(edge);
+        }
+
+        // Same composition as the search, from the last hop back to the first
+        for (auto i = resolved.path.size(); i-- > 0;)
+        {
+            auto local = resolved.path[i].inverse ? inverse(**edges[i]) : **edges[i];
+            if (i == resolved.path.size() - 1)
+                *extr = local;
+            else
+                *extr = from_pose(to_pose(*extr) * to_pose(local));
+        }
+        return true;
+    }
+
     bool extrinsics_graph::try_fetch_extrinsics(const stream_interface& from, const stream_interface& to, rs2_extrinsics* extr)
     {
+        if (&from == &to)
+        {
+            *extr = identity_matrix();
+            return true;
+        }
+
+        if (try_fetch_cached_extrinsics(from, to, extr))
+            return true;
+
         std::lock_guard<std::mutex> lock(_mutex);
         cleanup_extrinsics();
         auto from_idx = find_stream_profile(from);
@@ -143,10 +195,17 @@ namespace librealsense
         }
 
         std::set<int> visited;
-        return try_fetch_extrinsics(from_idx, to_idx, visited, extr);
+        std::vector<extrinsics_hop> path;
+        if (!try_fetch_extrinsics(from_idx, to_idx, visited, extr, path))
+            return false;
+
+        auto cache = std::make_shared<extrinsics_cache>(*std::atomic_load(&_cache));
+        (*cache)[{ &from, &to }] = { from.shared_from_this(), to.shared_from_this(), std::move(path) };
+        std::atomic_store(&_cache, std::shared_ptr<const extrinsics_cache>(cache));
+        return true;
     }
 
-    bool extrinsics_graph::try_fetch_extrinsics(int from, int to, std::set<int>& visited, rs2_extrinsics* extr)
+    bool extrinsics_graph::try_fetch_extrinsics(int from, int to, std::set<int>& visited, rs2_extrinsics* extr, std::vector<extrinsics_hop>& path)
     {
         if (visited.count(from)) return false;
 
@@ -164,6 +223,7 @@ namespace librealsense
                 else
                     *extr = inverse(back_edge->operator*());
 
+                path.push_back({ fwd_edge.get() ? fwd_edge : back_edge, !fwd_edge.get(), _streams[to] });
                 return true;
             }
             else
@@ -179,7 +239,7 @@ namespace librealsense
                     fwd_edge = fetch_edge(from, new_from);
 
                     if ((back_edge.get() || fwd_edge.get()) &&
-                        try_fetch_extrinsics(new_from, to, visited, extr))
+                        try_fetch_extrinsics(new_from, to, visited, extr, path))
                     {
                         const auto local = [&]() {
                             if (fwd_edge.get())
@@ -190,6 +250,7 @@ namespace librealsense
 
                         auto pose = to_pose(*extr) * to_pose(local);
                         *extr = from_pose(pose);
+                        path.insert(path.begin(), { fwd_edge.get() ? fwd_edge : back_edge, !fwd_edge.get(), _streams[new_from] });
                         return true;
                     }
                 }
@@ -45,14 +45,38 @@ namespace librealsense
         extrinsics_lock lock();
 
     private:
+        // An edge of a resolved path, evaluated inverted when only the opposite direction was registered.
+        // The path is no longer valid once the stream it leads to is released, as the graph would drop the edges
+        struct extrinsics_hop
+        {
+            std::weak_ptr<lazy<rs2_extrinsics>> edge;
+            bool inverse;
+            std::weak_ptr<const stream_interface> next;
+        };
+
+        // The path found between two streams. The edges are evaluated on every fetch, so the edges whose
+        // lazy<> value is reset or overridden in place need no invalidation
+        struct resolved_extrinsics
+        {
+            std::weak_ptr<const stream_interface> from;
+            std::weak_ptr<const stream_interface> to;
+            std::vector<extrinsics_hop> path;
+        };
+        typedef std::map<std::pair<const stream_interface*, const stream_interface*>, resolved_extrinsics> extrinsics_cache;
+
+        bool try_fetch_cached_extrinsics(const stream_interface& from, const stream_interface& to, rs2_extrinsics* extr) const;
+        void invalidate_cache();
+
         std::mutex _mutex;
+        // Replaced rather than modified, read with atomic_load without taking the mutex. Any change of the graph drops it
+        std::shared_ptr<const extrinsics_cache> _cache;
         std::shared_ptr<lazy<rs2_extrinsics>> _id;
         // Required by current implementation to hold the reference instead of the device for certain types. TODO
         std::vector<std::shared_ptr<lazy<rs2_extrinsics>>> _external_extrinsics;
 
     PRIVATE_TESTABLE:
         std::shared_ptr<lazy<rs2_extrinsics>> fetch_edge(int from, int to);
-        bool try_fetch_extrinsics(int from, int to, std::set<int>& visited, rs2_extrinsics* extr);
+        bool try_fetch_extrinsics(int from, int to, std::set<int>& visited, rs2_extrinsics* extr, std::vector<extrinsics_hop>& path);
         void cleanup_extrinsics();
         int find_stream_profile(const stream_interface& p, bool add_if_not_there = true);
 
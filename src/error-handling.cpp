@@ -12,10 +12,10 @@ namespace librealsense
         :_poll_intervals_ms(poll_intervals_ms),
         _option(option),
         _notifications_processor(processor),
-        _decoder(decoder)
+        _decoder(decoder),
+        _wheel(timer_wheel::get_shared(thread_policy_hook(RS2_THREAD_ROLE_MONITORING))),
+        _dispatcher(std::make_shared<dispatcher>(1, thread_policy_hook(RS2_THREAD_ROLE_MONITORING)))
     {
-        _active_object = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer cancellable_timer)
-            {  polling(cancellable_timer);  });
     }
 
     polling_error_handler::~polling_error_handler()
@@ -26,7 +26,8 @@ namespace librealsense
     polling_error_handler::polling_error_handler(const polling_error_handler& h)
     {
         _poll_intervals_ms = h._poll_intervals_ms;
-        _active_object = h._active_object;
+        _wheel = h._wheel;
+        _dispatcher = h._dispatcher;
         _option = h._option;
         _notifications_processor = h._notifications_processor;
         _decoder = h._decoder;
@@ -34,16 +35,34 @@ namespace librealsense
 
     void polling_error_handler::start()
     {
-        _active_object->start();
+        std::lock_guard<std::mutex> lock(_timer_mutex);
+        if (!_timer)
+        {
+            _dispatcher->start();
+            _timer = _wheel->add(_poll_intervals_ms, _poll_intervals_ms, [this]()
+            {
+                _dispatcher->invoke([this](dispatcher::cancellable_timer) { polling(); });
+            });
+        }
     }
     void polling_error_handler::stop()
     {
-        _active_object->stop();
+        timer_wheel::timer_id timer;
+        {
+            std::lock_guard<std::mutex> lock(_timer_mutex);
+            timer = _timer;
+            _timer = 0;
+        }
+        if (timer)
+        {
+            _wheel->remove(timer);
+            _dispatcher->stop();
+            LOG_DEBUG("Notification polling loop is being shut-down");
+        }
     }
 
-    void polling_error_handler::polling(dispatcher::cancellable_timer cancellable_timer)
+    void polling_error_handler::polling()
     {
-         if (cancellable_timer.try_sleep(_poll_intervals_ms))
          {
              try
              {
@@ -84,9 +103,5 @@ namespace librealsense
                  LOG_ERROR("Unknown error during polling error handler!");
              }
          }
-         else
-         {
-             LOG_DEBUG("Notification polling loop is being shut-down");
-         }
     }
 }
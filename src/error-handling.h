@@ -8,6 +8,8 @@
 
 namespace librealsense
 {
+    // Polls the last error of the device and raises it as a notification. The shared timer wheel only keeps the interval,
+    // the query of the device runs on the thread of the handler
     class polling_error_handler
     {
     public:
@@ -21,12 +23,15 @@ namespace librealsense
         void stop();
 
     private:
-        void polling(dispatcher::cancellable_timer cancellable_timer);
+        void polling();
 
         unsigned int _poll_intervals_ms;
         bool _silenced = false;
         std::weak_ptr<option> _option;
-        std::shared_ptr < active_object<> > _active_object;
+        std::shared_ptr<timer_wheel> _wheel;
+        timer_wheel::timer_id _timer = 0;
+        std::mutex _timer_mutex;
+        std::shared_ptr<dispatcher> _dispatcher;
         std::weak_ptr<notifications_processor> _notifications_processor;
         std::shared_ptr<notification_decoder> _decoder;
     };
@@ -22,7 +22,8 @@ class IRsRtsp
 {
 public:
     virtual std::vector<rs2_video_stream> getStreams() = 0;
-    virtual int addStream(rs2_video_stream t_stream, rtp_callback* t_frameCallBack) = 0;
+    // t_codec is the text form of a CompressionConfig, the stream uses the default codec of the server when empty
+    virtual int addStream(rs2_video_stream t_stream, rtp_callback* t_frameCallBack, const std::string& t_codec = "") = 0;
     virtual int start() = 0;
     virtual int stop() = 0;
     virtual int close() = 0;
@@ -30,4 +31,7 @@ public:
     virtual int setOption(const std::string& t_sensorName, rs2_option t_option, float t_value) = 0;
     virtual DeviceData getDeviceData() = 0;
     virtual std::vector<IpDeviceControlData> getControls() = 0;
+    // Transport of the streams set up next: RTP over the RTSP connection instead of UDP, and the kernel receive buffer of their sockets
+    // in bytes, 0 keeps the buffer of the system
+    virtual void setTransport(bool t_overTcp, unsigned t_receiveBufferSize) = 0;
 };
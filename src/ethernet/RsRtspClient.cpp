@@ -1,6 +1,7 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2020 Intel Corporation. All Rights Reserved.
 
+#include "GroupsockHelper.hh"
 #include "liveMedia.hh"
 
 #include "RsRtspClient.h"
@@ -15,7 +16,6 @@
 #include <vector>
 
 #define RTSP_CLIENT_VERBOSITY_LEVEL 0 // by default, print verbose output from each "RTSPClient"
-#define REQUEST_STREAMING_OVER_TCP 0
 
 // map for stream pysical sensor
 // key is generated by rs2_stream+index: depth=1,color=2,irl=3,irr=4
@@ -58,7 +58,7 @@ RsRTSPClient::RsRTSPClient(TaskScheduler *t_scheduler, UsageEnvironment *t_env,
 
 RsRTSPClient::~RsRTSPClient() {}
 
-std::string g_sdp[2];
+std::map<int, std::string> g_sdp;
 
 std::vector<rs2_video_stream> RsRTSPClient::getStreams()
 {
@@ -97,7 +97,7 @@ std::vector<rs2_video_stream> RsRTSPClient::getStreams()
     return this->m_supportedProfiles;
 }
 
-int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackObj)
+int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackObj, const std::string &t_codec)
 {
     long long int uniqueKey = getStreamProfileUniqueKey(t_stream);
     RsMediaSubsession *subsession = this->m_subsessionMap.find(uniqueKey)->second;
@@ -107,6 +107,25 @@ int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackO
         throw std::runtime_error(format_error_msg(__FUNCTION__, err));
     }
 
+    CompressionConfig compression = m_defaultCompression[uniqueKey];
+    if (!t_codec.empty())
+    {
+        // servers that do not advertise their codecs only stream with the default codec
+        std::string codecs = "," + m_supportedCodecs[uniqueKey] + ",";
+        if (!CompressionFactory::parseConfig(t_codec, compression) || codecs.find("," + t_codec.substr(0, t_codec.find(':')) + ",") == std::string::npos)
+        {
+            RsRtspReturnValue err = {RsRtspReturnCode::ERROR_GENERAL, "codec '" + t_codec + "' is not supported by the stream, supported codecs: " + m_supportedCodecs[uniqueKey]};
+            throw std::runtime_error(format_error_msg(__FUNCTION__, err));
+        }
+        // the video codecs decode where the library was built with them
+        if (!CompressionFactory::isCompressionSupported(compression, t_stream.fmt, t_stream.type))
+        {
+            RsRtspReturnValue err = {RsRtspReturnCode::ERROR_GENERAL, "codec '" + t_codec + "' cannot be decoded by this library"};
+            throw std::runtime_error(format_error_msg(__FUNCTION__, err));
+        }
+    }
+    m_setupCodec = CompressionFactory::configToString(compression);
+
     if (!subsession->initiate())
     {
         this->envir() << "Failed to initiate the subsession \n";
@@ -114,8 +133,22 @@ int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackO
         throw std::runtime_error(format_error_msg(__FUNCTION__, err));
     }
 
+    // The packets of a frame arrive in a burst, the socket buffer holds the packets of the large frames until the event loop reads them.
+    // Over TCP the packets arrive on the RTSP connection
+    bool overTcp = m_streamOverTcp;
+    unsigned receiveBufferSize = m_receiveBufferSize;
+    if (receiveBufferSize > 0)
+    {
+        int socketNum = overTcp ? this->socketNum() : subsession->rtpSource()->RTPgs()->socketNum();
+        unsigned newBufferSize = setReceiveBufferTo(this->envir(), socketNum, receiveBufferSize);
+        if (newBufferSize < receiveBufferSize)
+        {
+            this->envir() << "Socket receive buffer limited to " << newBufferSize << " bytes by the system, e.g. net.core.rmem_max\n";
+        }
+    }
+
     // Continue setting up this subsession, by sending a RTSP "SETUP" command:
-    unsigned res = this->sendSetupCommand(*subsession, this->continueAfterSETUP, False, REQUEST_STREAMING_OVER_TCP);
+    unsigned res = this->sendSetupCommand(*subsession, this->continueAfterSETUP, False, overTcp);
     // wait for continueAfterSETUP to finish
     std::unique_lock<std::mutex> lck(m_commandMtx);
     m_cv.wait_for(lck, std::chrono::seconds(RTSP_CLIENT_COMMANDS_TIMEOUT_SEC), [this] { return m_commandDone; });
@@ -132,7 +165,7 @@ int RsRTSPClient::addStream(rs2_video_stream t_stream, rtp_callback *t_callbackO
         throw std::runtime_error(format_error_msg(__FUNCTION__, m_lastReturnValue));
     }
 
-    subsession->sink = RsSink::createNew(this->envir(), *subsession, t_stream, m_memPool, this->url());
+    subsession->sink = RsSink::createNew(this->envir(), *subsession, t_stream, compression, m_memPool, this->url());
     // perhaps use your own custom "MediaSink" subclass instead
     if (subsession->sink == NULL)
     {
@@ -196,6 +229,8 @@ int RsRTSPClient::stop()
 
 int RsRTSPClient::close()
 {
+    // a client that did not get the description of its session, e.g. of a sensor the server does not have, has no session to tear down
+    if (this->m_scs.m_session != NULL)
     {
         unsigned res = this->sendTeardownCommand(*this->m_scs.m_session, this->continueAfterTEARDOWN);
         // wait for continueAfterTEARDOWN to finish
@@ -338,6 +373,12 @@ std::vector<IpDeviceControlData> RsRTSPClient::getControls()
     return controls;
 }
 
+void RsRTSPClient::setTransport(bool t_overTcp, unsigned t_receiveBufferSize)
+{
+    m_streamOverTcp = t_overTcp;
+    m_receiveBufferSize = t_receiveBufferSize;
+}
+
 void updateExtrinsicsMap(rs2_video_stream videoStream, std::string extrinsics_str)
 {
     std::istringstream extrinsics_stream(extrinsics_str);
@@ -458,7 +499,6 @@ void RsRTSPClient::continueAfterDESCRIBE(RTSPClient *rtspClient, int resultCode,
             videoStream.intrinsics.ppy = subsession->attrVal_int("ppy");
             videoStream.intrinsics.fx = subsession->attrVal_int("fx");
             videoStream.intrinsics.fy = subsession->attrVal_int("fy");
-            CompressionFactory::getIsEnabled() = subsession->attrVal_bool("compression");
             videoStream.intrinsics.model = (rs2_distortion)subsession->attrVal_int("model");
 
             for (size_t i = 0; i < 5; i++)
@@ -479,6 +519,8 @@ void RsRTSPClient::continueAfterDESCRIBE(RTSPClient *rtspClient, int resultCode,
             rsRtspClient->setDeviceData(deviceData);
 
             long long int uniqueKey = getStreamProfileUniqueKey(videoStream);
+            rsRtspClient->m_supportedCodecs[uniqueKey] = subsession->attrVal_str("codecs");
+            rsRtspClient->m_defaultCompression[uniqueKey] = CompressionFactory::getDefaultConfig(videoStream.fmt, videoStream.type, subsession->attrVal_bool("compression"));
             rsRtspClient->m_subsessionMap.insert(std::pair<long long int, RsMediaSubsession *>(uniqueKey, subsession));
             rsRtspClient->m_supportedProfiles.push_back(videoStream);
             subsession = iter.next();
@@ -606,19 +648,22 @@ void RsRTSPClient::continueAfterOPTIONS(RTSPClient *rtspClient, int resultCode,
     {
         std::lock_guard<std::mutex> lck(rsRtspClient->m_commandMtx);
         std::size_t foundBegin = resultStr.find_first_of("[");
+        std::size_t nameBegin = 0;
         IpDeviceControlData controlData;
-        int counter = 0;
         while (foundBegin != std::string::npos)
         {
 
             std::size_t foundEnd = resultStr.find_first_of("]", foundBegin + 1);
             std::string controlsPerSensor = resultStr.substr(foundBegin + 1, foundEnd - foundBegin);
+            // the options of each sensor follow its name, the sensors of the network device are the stereo module, the RGB camera and the motion module
+            std::string sensorName = resultStr.substr(nameBegin, foundBegin - nameBegin);
+            nameBegin = foundEnd + 1;
+            controlData.sensorId = sensorName.find(STEREO_SENSOR_NAME) != std::string::npos ? 0 : sensorName.find(RGB_SENSOR_NAME) != std::string::npos ? 1 : sensorName.find(MOTION_SENSOR_NAME) != std::string::npos ? 2 : -1;
             std::size_t pos = 0;
-            while ((pos = controlsPerSensor.find(';')) != std::string::npos)
+            while (controlData.sensorId != -1 && (pos = controlsPerSensor.find(';')) != std::string::npos)
             {
                 std::string controlStr = controlsPerSensor.substr(0, pos);
 
-                controlData.sensorId = counter == 0 ? 1 : 0;
                 int option_code;
                 int params_count = sscanf(controlStr.c_str(), "%d{%f,%f,%f,%f}", &option_code, &controlData.range.min, &controlData.range.max, &controlData.range.def, &controlData.range.step);
 
@@ -627,7 +672,6 @@ void RsRTSPClient::continueAfterOPTIONS(RTSPClient *rtspClient, int resultCode,
                 controls.push_back(controlData);
                 controlsPerSensor.erase(0, pos + 1);
             }
-            counter++;
             foundBegin = resultStr.find_first_of("[", foundBegin + 1);
         }
         rsRtspClient->m_commandDone = true;
@@ -749,6 +793,19 @@ Boolean RsRTSPClient::setRequestFields(RequestRecord *request, char *&cmdURL, Bo
         cmdURLWasAllocated = True; //use BaseUrl
         sprintf(cmdURL, "%s", "*");
     }
+    else if (strcmp(request->commandName(), "SETUP") == 0 && !m_setupCodec.empty())
+    {
+        Boolean result = RTSPClient::setRequestFields(request, cmdURL, cmdURLWasAllocated, protocolStr, extraHeaders, extraHeadersWereAllocated);
+        // the server compresses the stream with the codec of this header
+        std::string headers = std::string(extraHeaders) + RS_CODEC_HEADER + ": " + m_setupCodec + "\r\n";
+        if (extraHeadersWereAllocated)
+        {
+            delete[] extraHeaders;
+        }
+        extraHeaders = strDup(headers.c_str());
+        extraHeadersWereAllocated = True;
+        return result;
+    }
     else
     {
         return RTSPClient::setRequestFields(request, cmdURL, cmdURLWasAllocated, protocolStr, extraHeaders, extraHeadersWereAllocated);
@@ -14,6 +14,7 @@
 
 #include <librealsense2/hpp/rs_internal.hpp>
 
+#include <atomic>
 #include <condition_variable>
 #include <map>
 #include <vector>
@@ -37,7 +38,7 @@ public:
 
     // IcamOERtsp functions
     virtual std::vector<rs2_video_stream> getStreams();
-    virtual int addStream(rs2_video_stream t_stream, rtp_callback* t_frameCallBack);
+    virtual int addStream(rs2_video_stream t_stream, rtp_callback* t_frameCallBack, const std::string& t_codec = "");
     virtual int start();
     virtual int stop();
     virtual int close();
@@ -49,6 +50,7 @@ public:
         return m_deviceData;
     }
     virtual std::vector<IpDeviceControlData> getControls();
+    virtual void setTransport(bool t_overTcp, unsigned t_receiveBufferSize);
 
     static void continueAfterDESCRIBE(RTSPClient* rtspClient, int resultCode, char* resultString);
     static void continueAfterSETUP(RTSPClient* rtspClient, int resultCode, char* resultString);
@@ -83,6 +85,11 @@ private:
     bool isActiveSession = false; //this flag should affect the get/set param commands to run in context of specific session, currently value is always false
     std::vector<rs2_video_stream> m_supportedProfiles;
     std::map<long long int, RsMediaSubsession*> m_subsessionMap;
+    // codecs advertised by the server for each stream and the codec used when the application does not choose one
+    std::map<long long int, std::string> m_supportedCodecs;
+    std::map<long long int, CompressionConfig> m_defaultCompression;
+    // codec requested by the SETUP command in flight
+    std::string m_setupCodec;
     RsRtspReturnValue m_lastReturnValue;
     static int m_streamCounter;
     // TODO: should we have seperate mutex for each command?
@@ -98,4 +105,7 @@ private:
     std::mutex m_taskSchedulerMutex;
 
     int m_idx;
+
+    std::atomic<bool> m_streamOverTcp{false};
+    std::atomic<unsigned> m_receiveBufferSize{0};
 };
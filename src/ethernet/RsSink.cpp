@@ -11,19 +11,24 @@
 
 #define WRITE_FRAMES_TO_FILE 0
 
-RsSink* RsSink::createNew(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, MemoryPool* t_memPool, char const* t_streamId)
+RsSink* RsSink::createNew(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, const CompressionConfig& t_compression, MemoryPool* t_memPool, char const* t_streamId)
 {
-    return new RsSink(t_env, t_subsession, t_stream, t_memPool, t_streamId);
+    return new RsSink(t_env, t_subsession, t_stream, t_compression, t_memPool, t_streamId);
 }
 
-RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, MemoryPool* t_memPool, char const* t_streamId)
+RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, const CompressionConfig& t_compression, MemoryPool* t_memPool, char const* t_streamId)
     : MediaSink(t_env)
     , m_memPool(t_memPool)
     , m_subsession(t_subsession)
 {
     m_stream = t_stream;
     m_streamId = strDup(t_streamId);
+    // motion streams have no size and receive batches of samples
     m_bufferSize = t_stream.width * t_stream.height * t_stream.bpp + sizeof(RsFrameHeader);
+    if(t_stream.type == RS2_STREAM_GYRO || t_stream.type == RS2_STREAM_ACCEL)
+    {
+        m_bufferSize = RS_IMU_MAX_MESSAGE_SIZE;
+    }
     m_receiveBuffer = nullptr;
     m_to = nullptr;
     std::string urlStr = m_streamId;
@@ -47,11 +52,8 @@ RsSink::RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video
         fp = fopen("file_rgb.bin", "ab");
     }
     */
-    if(CompressionFactory::isCompressionSupported(m_stream.fmt, m_stream.type))
-    {
-        m_iCompress = CompressionFactory::getObject(m_stream.width, m_stream.height, m_stream.fmt, m_stream.type, m_stream.bpp);
-    }
-    else
+    m_iCompress = CompressionFactory::getObject(t_compression, m_stream.width, m_stream.height, m_stream.fmt, m_stream.bpp, m_stream.fps);
+    if(m_iCompress == nullptr)
     {
         INF << "compression is disabled or configured unsupported format to zip, run without compression";
     }
@@ -105,9 +107,9 @@ void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedByte
     {
         if(this->m_rtpCallback != NULL)
         {
-            if(CompressionFactory::isCompressionSupported(m_stream.fmt, m_stream.type) && m_iCompress != nullptr)
+            if(m_iCompress != nullptr)
             {
-                m_to = m_memPool->getNextMem();
+                m_to = m_memPool->getNextMem(m_bufferSize);
                 if(m_to == nullptr)
                 {
                     return;
@@ -119,6 +121,11 @@ void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedByte
                     memcpy(m_to + sizeof(RsNetworkHeader), m_receiveBuffer + sizeof(RsNetworkHeader), sizeof(RsMetadataHeader));
                     this->m_rtpCallback->on_frame((u_int8_t*)m_to + sizeof(RsNetworkHeader), decompressedSize + sizeof(RsMetadataHeader), t_presentationTime);
                 }
+                else
+                {
+                    m_memPool->returnMem(m_to);
+                    this->m_rtpCallback->on_corrupted_frame();
+                }
                 m_memPool->returnMem(m_receiveBuffer);
             }
             else
@@ -137,9 +144,24 @@ void RsSink::afterGettingFrame(unsigned t_frameSize, unsigned t_numTruncatedByte
     {
                 envir() << m_streamId << ":corrupted frame!!!: data size is " << header->data.frameSize << " frame size is " << t_frameSize << "\n";
                 m_memPool->returnMem(m_receiveBuffer);
+                if(this->m_rtpCallback != NULL)
+                {
+                    this->m_rtpCallback->on_corrupted_frame();
+                }
     }
     m_receiveBuffer = nullptr;
 
+    if(this->m_rtpCallback != NULL && m_subsession.rtpSource() != NULL)
+    {
+        RTPReceptionStatsDB::Iterator statsIterator(m_subsession.rtpSource()->receptionStatsDB());
+        RTPReceptionStats* stats = statsIterator.next(True);
+        if(stats != NULL)
+        {
+            // the jitter is in units of the RTP timestamp
+            this->m_rtpCallback->on_packets(stats->totNumPacketsReceived(), stats->totNumPacketsExpected(), stats->jitter() * 1000.0 / RTP_TIMESTAMP_FREQ);
+        }
+    }
+
     // Then continue, to request the next frame of data
     continuePlaying();
 }
@@ -150,20 +172,19 @@ Boolean RsSink::continuePlaying()
         return False; // sanity check (should not happen)
 
     // Request the next frame of data from our input source.  "afterGettingFrame()" will get called later, when it arrives:
-    m_receiveBuffer = m_memPool->getNextMem();
+    m_receiveBuffer = m_memPool->getNextMem(m_bufferSize);
     if(m_receiveBuffer == nullptr)
     {
         return false;
     }
 
+    // the functions of all the uids forward to afterGettingFrame, the streams of higher uids, e.g. the motion streams, use the first one
+    FramedSource::afterGettingFunc* afterGettingFunction = m_afterGettingFunctions.at(0);
     if(m_stream.uid >= 0 && m_stream.uid < m_afterGettingFunctions.size())
     {
-        fSource->getNextFrame(m_receiveBuffer, m_bufferSize, m_afterGettingFunctions.at(m_stream.uid), this, onSourceClosure, this);
-    }
-    else
-    {
-        return false;
+        afterGettingFunction = m_afterGettingFunctions.at(m_stream.uid);
     }
+    fSource->getNextFrame(m_receiveBuffer, m_bufferSize, afterGettingFunction, this, onSourceClosure, this);
 
     return True;
 }
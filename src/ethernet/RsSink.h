@@ -19,13 +19,14 @@ public:
     static RsSink* createNew(UsageEnvironment& t_env,
                              MediaSubsession& t_subsession,
                              rs2_video_stream t_stream, // identifies the kind of data that's being received
+                             const CompressionConfig& t_compression, // codec negotiated in the SETUP of the stream
                              MemoryPool* t_mempool,
                              char const* t_streamId = NULL); // identifies the stream itself (optional)
 
     void setCallback(rtp_callback* t_callback);
 
 private:
-    RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, MemoryPool* t_mempool, char const* t_streamId);
+    RsSink(UsageEnvironment& t_env, MediaSubsession& t_subsession, rs2_video_stream t_stream, const CompressionConfig& t_compression, MemoryPool* t_mempool, char const* t_streamId);
     // called only by "createNew()"
     virtual ~RsSink();
 
@@ -7,8 +7,11 @@
 #include "api.h"
 #include <librealsense2-net/rs_net.h>
 
+#include <algorithm>
 #include <chrono>
 #include <list>
+#include <mutex>
+#include <sstream>
 #include <thread>
 #include <iostream>
 #include <string>
@@ -17,7 +20,11 @@
 
 extern std::map<std::pair<int, int>, rs2_extrinsics> minimal_extrinsics_map;
 
-std::string sensors_str[] = {STEREO_SENSOR_NAME, RGB_SENSOR_NAME};
+std::string sensors_str[] = {STEREO_SENSOR_NAME, RGB_SENSOR_NAME, MOTION_SENSOR_NAME};
+
+// the ip devices by the software device they stream to, for the net device API functions
+std::mutex ip_devices_mutex;
+std::map<const librealsense::device_interface*, ip_device*> ip_devices;
 
 //WA for stop
 void ip_device::recover_rtsp_client(int sensor_index)
@@ -32,6 +39,18 @@ ip_device::~ip_device()
 {
     DBG << "Destroying ip_device";
     
+    {
+        std::lock_guard<std::mutex> lock(ip_devices_mutex);
+        for(auto it = ip_devices.begin(); it != ip_devices.end(); ++it)
+        {
+            if(it->second == this)
+            {
+                ip_devices.erase(it);
+                break;
+            }
+        }
+    }
+
     try
     {
         is_device_alive = false;
@@ -43,6 +62,8 @@ ip_device::~ip_device()
 
         for (int remote_sensor_index = 0; remote_sensor_index < NUM_OF_SENSORS; remote_sensor_index++)
         {
+            if (remote_sensors[remote_sensor_index] == nullptr)
+                continue;
             update_sensor_state(remote_sensor_index, {}, false);
             delete (remote_sensors[remote_sensor_index]);
         }
@@ -66,8 +87,44 @@ void ip_device::stop_sensor_streams(int sensor_index)
     remote_sensors[sensor_index]->active_streams_keys.clear();
 }
 
-ip_device::ip_device(rs2::software_device sw_device, std::string ip_address)
+// "depth=rvl,color=adaptive:20000" => {depth: "rvl", color: "adaptive:20000"}
+std::map<rs2_stream, std::string> parse_stream_codecs(const std::string& compression)
 {
+    std::map<rs2_stream, std::string> stream_codecs;
+    std::istringstream compression_stream(compression);
+    std::string entry;
+    while(std::getline(compression_stream, entry, ','))
+    {
+        size_t equal = entry.find('=');
+        std::string stream_name = entry.substr(0, equal);
+        std::string codec = equal != std::string::npos ? entry.substr(equal + 1) : "";
+        CompressionConfig config;
+        if(!CompressionFactory::parseConfig(codec, config))
+        {
+            throw std::runtime_error("invalid codec '" + codec + "' for stream '" + stream_name + "'");
+        }
+
+        int type = RS2_STREAM_ANY + 1;
+        for(; type < RS2_STREAM_COUNT; type++)
+        {
+            std::string name = rs2_stream_to_string(static_cast<rs2_stream>(type));
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            if(name == stream_name)
+                break;
+        }
+        if(type == RS2_STREAM_COUNT)
+        {
+            throw std::runtime_error("invalid stream '" + stream_name + "' in compression '" + compression + "'");
+        }
+        stream_codecs[static_cast<rs2_stream>(type)] = codec;
+    }
+    return stream_codecs;
+}
+
+ip_device::ip_device(rs2::software_device sw_device, std::string ip_address, std::string compression)
+{
+    stream_codecs = parse_stream_codecs(compression);
+
     int colon = ip_address.find(":");
     this->ip_address = ip_address.substr(0, colon); // 10.10.10.10:8554 => 10.10.10.10
     this->ip_port = 8554; // default RTSP port
@@ -123,46 +180,32 @@ bool ip_device::init_device_data(rs2::software_device sw_device)
         remote_sensors[sensor_id]->rtsp_client = RsRTSPClient::createNew(url.c_str(), "rs_network_device", 0, sensor_id);
         ((RsRTSPClient*)remote_sensors[sensor_id]->rtsp_client)->initFunc(&rs_rtp_stream::get_memory_pool());
 
-        rs2::software_sensor tmp_sensor = sw_device.add_sensor(sensor_name);
-
-        remote_sensors[sensor_id]->sw_sensor = std::make_shared<rs2::software_sensor>(tmp_sensor);
-
-        if(sensor_id == 1) //todo: remove hard coded
+        std::vector<rs2_video_stream> streams;
+        if(sensor_id == MOTION_SENSOR_INDEX)
         {
-            std::vector<IpDeviceControlData> controls = get_controls(sensor_id);
-            for(auto& control : controls)
+            try
+            {
+                streams = query_streams(sensor_id);
+            }
+            catch(const std::exception& e)
             {
+                INF << "Network device has no motion module: " << e.what();
+                remote_sensors[sensor_id]->rtsp_client->close();
+                delete remote_sensors[sensor_id];
+                remote_sensors[sensor_id] = nullptr;
+                continue;
+            }
+        }
 
-                float val = NAN;
+        rs2::software_sensor tmp_sensor = sw_device.add_sensor(sensor_name);
 
-                INF << "Init sensor " << control.sensorId << ", option '" << control.option << "', value " << control.range.def;
+        remote_sensors[sensor_id]->sw_sensor = std::make_shared<rs2::software_sensor>(tmp_sensor);
 
-                if(control.range.min == control.range.max)
-                {
-                    remote_sensors[control.sensorId]->sw_sensor->add_read_only_option(control.option, control.range.def);
-                }
-                else
-                {
-                    remote_sensors[control.sensorId]->sw_sensor->add_option(control.option, {control.range.min, control.range.max, control.range.def, control.range.step});
-                }
-                remote_sensors[control.sensorId]->sensors_option[control.option] = control.range.def;
-                try
-                {
-                    get_option_value(control.sensorId, control.option, val);
-                    if(val != control.range.def && val >= control.range.min && val <= control.range.max)
-                    {
-                        remote_sensors[control.sensorId]->sw_sensor->set_option(control.option, val);
-                    }
-                }
-                catch(const std::exception& e)
-                {
-                    ERR << e.what();
-                }
-            }
+        if(streams.empty())
+        {
+            streams = query_streams(sensor_id);
         }
 
-        auto streams = query_streams(sensor_id);
-
         DBG << "Init got " << streams.size() << " streams per sensor " << sensor_id;
 
         for(int stream_index = 0; stream_index < streams.size(); stream_index++)
@@ -171,19 +214,34 @@ bool ip_device::init_device_data(rs2::software_device sw_device)
             // just for readable code
             rs2_video_stream st = streams[stream_index];
             long long int stream_key = RsRTSPClient::getStreamProfileUniqueKey(st);
+            rs2::stream_profile stream_profile;
 
-            //check if default value per this stream type were picked
-            if(default_streams[std::make_pair(st.type, st.index)] == -1)
+            if(st.type == RS2_STREAM_GYRO || st.type == RS2_STREAM_ACCEL)
             {
-                if (st.width==DEFAULT_PROFILE_WIDTH && st.height==DEFAULT_PROFILE_HIGHT && st.fps==DEFAULT_PROFILE_FPS
-                    && (st.type != rs2_stream::RS2_STREAM_COLOR || st.fmt == DEFAULT_PROFILE_COLOR_FORMAT))
+                // the first motion stream of each type is the default one, the samples are sent without intrinsics
+                is_default = default_streams.emplace(std::make_pair(st.type, st.index), stream_index).second;
+                rs2_motion_stream motion_stream = {st.type, st.index, st.uid, st.fps, st.fmt, {}};
+                for(int axis = 0; axis < 3; axis++)
                 {
-                    default_streams[std::make_pair(st.type, st.index)] = stream_index;
-                    is_default=true;
+                    motion_stream.intrinsics.data[axis][axis] = 1;
                 }
+                stream_profile = remote_sensors[sensor_id]->sw_sensor->add_motion_stream(motion_stream, is_default);
             }
+            else
+            {
+                //check if default value per this stream type were picked
+                if(default_streams[std::make_pair(st.type, st.index)] == -1)
+                {
+                    if (st.width==DEFAULT_PROFILE_WIDTH && st.height==DEFAULT_PROFILE_HIGHT && st.fps==DEFAULT_PROFILE_FPS
+                        && (st.type != rs2_stream::RS2_STREAM_COLOR || st.fmt == DEFAULT_PROFILE_COLOR_FORMAT))
+                    {
+                        default_streams[std::make_pair(st.type, st.index)] = stream_index;
+                        is_default=true;
+                    }
+                }
 
-            auto stream_profile = remote_sensors[sensor_id]->sw_sensor->add_video_stream(st, is_default);
+                stream_profile = remote_sensors[sensor_id]->sw_sensor->add_video_stream(st, is_default);
+            }
             device_streams.push_back(stream_profile);
             streams_collection[stream_key] = std::make_shared<rs_rtp_stream>(st, stream_profile);
             memory_pool = &rs_rtp_stream::get_memory_pool();
@@ -191,6 +249,42 @@ bool ip_device::init_device_data(rs2::software_device sw_device)
         DBG << "Init done adding streams for sensor ID: " << sensor_id;
     }
 
+    // the server lists the options of all its sensors, they are added once all the sensors are created
+    std::vector<IpDeviceControlData> controls = get_controls(1); //todo: remove hard coded
+    for(auto& control : controls)
+    {
+        if(control.sensorId >= NUM_OF_SENSORS || remote_sensors[control.sensorId] == nullptr)
+        {
+            continue;
+        }
+
+        float val = NAN;
+
+        INF << "Init sensor " << control.sensorId << ", option '" << control.option << "', value " << control.range.def;
+
+        if(control.range.min == control.range.max)
+        {
+            remote_sensors[control.sensorId]->sw_sensor->add_read_only_option(control.option, control.range.def);
+        }
+        else
+        {
+            remote_sensors[control.sensorId]->sw_sensor->add_option(control.option, {control.range.min, control.range.max, control.range.def, control.range.step});
+        }
+        remote_sensors[control.sensorId]->sensors_option[control.option] = control.range.def;
+        try
+        {
+            get_option_value(control.sensorId, control.option, val);
+            if(val != control.range.def && val >= control.range.min && val <= control.range.max)
+            {
+                remote_sensors[control.sensorId]->sw_sensor->set_option(control.option, val);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            ERR << e.what();
+        }
+    }
+
     for(auto stream_profile_from : device_streams)
     {
         for(auto stream_profile_to : device_streams)
@@ -222,6 +316,9 @@ void ip_device::polling_state_loop()
             bool enabled;
             for(int i = 0; i < NUM_OF_SENSORS; i++)
             {
+                if(remote_sensors[i] == nullptr)
+                    continue;
+
                 //poll start/stop events
                 auto sw_sensor = remote_sensors[i]->sw_sensor.get();
    
@@ -298,15 +395,21 @@ void ip_device::get_option_value(int sensor_index, rs2_option opt, float& val)
     }
 }
 
-rs2_video_stream convert_stream_object(rs2::video_stream_profile sp)
+// motion streams are described with a zero size
+rs2_video_stream convert_stream_object(rs2::stream_profile sp)
 {
     rs2_video_stream retVal;
     retVal.fmt = sp.format();
     retVal.type = sp.stream_type();
     retVal.fps = sp.fps();
-    retVal.width = sp.width();
-    retVal.height = sp.height();
+    retVal.width = 0;
+    retVal.height = 0;
     retVal.index = sp.stream_index();
+    if(sp.is<rs2::video_stream_profile>())
+    {
+        retVal.width = sp.as<rs2::video_stream_profile>().width();
+        retVal.height = sp.as<rs2::video_stream_profile>().height();
+    }
 
     return retVal;
 }
@@ -326,19 +429,21 @@ void ip_device::update_sensor_state(int sensor_index, std::vector<rs2::stream_pr
         }
         return;
     }
+    remote_sensors[sensor_index]->rtsp_client->setTransport(rtp_over_tcp, receive_buffer_kb * 1024);
     for(size_t i = 0; i < updated_streams.size(); i++)
     {
-        rs2::video_stream_profile vst(updated_streams[i]);
-
-        long long int requested_stream_key = RsRTSPClient::getStreamProfileUniqueKey(convert_stream_object(vst));
+        long long int requested_stream_key = RsRTSPClient::getStreamProfileUniqueKey(convert_stream_object(updated_streams[i]));
 
         if(streams_collection.find(requested_stream_key) == streams_collection.end())
         {
             throw std::runtime_error("[update_sensor_state] stream key: " + std::to_string(requested_stream_key) + " is not found. closing device.");
         }
 
+        streams_collection[requested_stream_key].get()->reset_statistics();
         rtp_callbacks[requested_stream_key] = new rs_rtp_callback(streams_collection[requested_stream_key]);
-        remote_sensors[sensor_index]->rtsp_client->addStream(streams_collection[requested_stream_key].get()->m_rs_stream, rtp_callbacks[requested_stream_key]);
+        rs2_video_stream& requested_stream = streams_collection[requested_stream_key].get()->m_rs_stream;
+        auto codec = stream_codecs.find(requested_stream.type);
+        remote_sensors[sensor_index]->rtsp_client->addStream(requested_stream, rtp_callbacks[requested_stream_key], codec != stream_codecs.end() ? codec->second : "");
         inject_frames_thread[requested_stream_key] = std::thread(&ip_device::inject_frames_loop, this, streams_collection[requested_stream_key]);
         remote_sensors[sensor_index]->active_streams_keys.push_front(requested_stream_key);
     }
@@ -351,6 +456,8 @@ int stream_type_to_sensor_id(rs2_stream type)
 {
     if(type == RS2_STREAM_INFRARED || type == RS2_STREAM_DEPTH)
         return 0;
+    if(type == RS2_STREAM_GYRO || type == RS2_STREAM_ACCEL)
+        return MOTION_SENSOR_INDEX;
     return 1;
 }
 
@@ -367,23 +474,18 @@ void ip_device::inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream)
 
         while(rtp_stream.get()->is_enabled == true)
         {
-            if(rtp_stream.get()->queue_size() != 0)
+            Raw_Frame* frame = rtp_stream.get()->extract_frame(std::chrono::milliseconds(INJECT_FRAMES_WAIT_INTERVAL));
+            if(frame != nullptr)
             {
-                Raw_Frame* frame = rtp_stream.get()->extract_frame();
-                rtp_stream.get()->frame_data_buff.pixels = frame->m_buffer;
-
-                rtp_stream.get()->frame_data_buff.timestamp = frame->m_metadata->data.timestamp;
-
-                rtp_stream.get()->frame_data_buff.frame_number++;
-                rtp_stream.get()->frame_data_buff.domain = frame->m_metadata->data.timestampDomain;
-
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP, rtp_stream.get()->frame_data_buff.timestamp);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_ACTUAL_FPS, frame->m_metadata->data.actualFps);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_COUNTER, rtp_stream.get()->frame_data_buff.frame_number);
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE, 1);
-
-                remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count());
-                remote_sensors[sensor_id]->sw_sensor->on_video_frame(rtp_stream.get()->frame_data_buff);
+                std::lock_guard<std::mutex> lock(remote_sensors[sensor_id]->frame_lock);
+                if(type == RS2_STREAM_GYRO || type == RS2_STREAM_ACCEL)
+                {
+                    inject_motion_frames(rtp_stream, frame, sensor_id);
+                }
+                else
+                {
+                    inject_video_frame(rtp_stream, frame, sensor_id);
+                }
             }
         }
 
@@ -396,19 +498,165 @@ void ip_device::inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream)
     }
 }
 
+// Sets the metadata sent by the server with the frame, the frame counter and the time of arrival are the ones of the client
+void ip_device::set_frame_metadata(int sensor_id, Raw_Frame* frame)
+{
+    const auto& metadata = frame->m_metadata->data;
+    for(int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+    {
+        if((metadata.metadataMask & (uint64_t(1) << i)) && i != RS2_FRAME_METADATA_FRAME_COUNTER && i != RS2_FRAME_METADATA_TIME_OF_ARRIVAL)
+        {
+            remote_sensors[sensor_id]->sw_sensor->set_metadata(static_cast<rs2_frame_metadata_value>(i), metadata.metadata[i]);
+        }
+    }
+    remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void ip_device::inject_video_frame(std::shared_ptr<rs_rtp_stream> rtp_stream, Raw_Frame* frame, int sensor_id)
+{
+    rtp_stream.get()->frame_data_buff.pixels = frame->m_buffer;
+
+    rtp_stream.get()->frame_data_buff.timestamp = frame->m_metadata->data.timestamp;
+
+    rtp_stream.get()->frame_data_buff.frame_number++;
+    rtp_stream.get()->frame_data_buff.domain = frame->m_metadata->data.timestampDomain;
+
+    remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP, rtp_stream.get()->frame_data_buff.timestamp);
+    remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_ACTUAL_FPS, frame->m_metadata->data.actualFps);
+    remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_COUNTER, rtp_stream.get()->frame_data_buff.frame_number);
+    remote_sensors[sensor_id]->sw_sensor->set_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE, 1);
+    set_frame_metadata(sensor_id, frame);
+
+    // the pixels are wrapped by the software frame, which returns them to the memory pool
+    remote_sensors[sensor_id]->sw_sensor->on_video_frame(rtp_stream.get()->frame_data_buff);
+    delete frame;
+}
+
+// The samples of a batch are injected as motion frames with the metadata of the batch
+void ip_device::inject_motion_frames(std::shared_ptr<rs_rtp_stream> rtp_stream, Raw_Frame* frame, int sensor_id)
+{
+    set_frame_metadata(sensor_id, frame);
+
+    const RsImuSample* samples = reinterpret_cast<const RsImuSample*>(frame->m_buffer);
+    size_t count = (frame->m_size - sizeof(RsMetadataHeader)) / sizeof(RsImuSample);
+    for(size_t i = 0; i < count; i++)
+    {
+        float* data = new float[3];
+        memcpy(data, samples[i].data, sizeof(samples[i].data));
+
+        rs2_software_motion_frame motion_frame;
+        motion_frame.data = data;
+        motion_frame.deleter = [](void* p) { delete[] static_cast<float*>(p); };
+        motion_frame.timestamp = samples[i].timestamp;
+        motion_frame.domain = frame->m_metadata->data.timestampDomain;
+        motion_frame.frame_number = static_cast<int>(samples[i].frameCounter);
+        motion_frame.profile = rtp_stream.get()->get_stream_profile().get();
+        remote_sensors[sensor_id]->sw_sensor->on_motion_frame(motion_frame);
+    }
+
+    rs_rtp_stream::get_memory_pool().returnMem((unsigned char*)frame->m_buffer - sizeof(RsFrameHeader));
+    delete frame;
+}
+
+void ip_device::set_jitter_buffer(int delay_ms)
+{
+    for(auto& stream : streams_collection)
+    {
+        stream.second.get()->set_jitter_delay(delay_ms);
+    }
+}
+
+void ip_device::set_transport(bool over_tcp, int receive_buffer_kb)
+{
+    rtp_over_tcp = over_tcp;
+    this->receive_buffer_kb = receive_buffer_kb;
+}
+
+// The statistics of the profile of the stream that received a frame last
+rs2_net_stream_statistics ip_device::get_stream_statistics(rs2_stream type, int index)
+{
+    std::shared_ptr<rs_rtp_stream> last_stream;
+    for(auto& stream : streams_collection)
+    {
+        rs2_video_stream& rs_stream = stream.second.get()->m_rs_stream;
+        if(rs_stream.type == type && rs_stream.index == index &&
+           (last_stream == nullptr || stream.second.get()->last_arrival_time() > last_stream.get()->last_arrival_time()))
+        {
+            last_stream = stream.second;
+        }
+    }
+    if(last_stream == nullptr)
+    {
+        throw librealsense::invalid_value_exception(std::string("net device has no stream ") + rs2_stream_to_string(type) + " " + std::to_string(index));
+    }
+    return last_stream.get()->get_statistics();
+}
+
+ip_device* find_ip_device(const rs2_device* device)
+{
+    auto it = ip_devices.find(device->device.get());
+    if(it == ip_devices.end())
+    {
+        throw librealsense::invalid_value_exception("device is not a net device");
+    }
+    return it->second;
+}
+
+void rs2_net_device_set_jitter_buffer(const rs2_device* device, int delay_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(delay_ms, 0, 10000);
+
+    std::lock_guard<std::mutex> lock(ip_devices_mutex);
+    find_ip_device(device)->set_jitter_buffer(delay_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, delay_ms)
+
+void rs2_net_device_set_transport(const rs2_device* device, int over_tcp, int receive_buffer_kb, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(receive_buffer_kb, 0, 1024 * 1024);
+
+    std::lock_guard<std::mutex> lock(ip_devices_mutex);
+    find_ip_device(device)->set_transport(over_tcp != 0, receive_buffer_kb);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, over_tcp, receive_buffer_kb)
+
+void rs2_net_device_get_stream_statistics(const rs2_device* device, rs2_stream stream, int index, rs2_net_stream_statistics* statistics, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    VALIDATE_NOT_NULL(statistics);
+
+    std::lock_guard<std::mutex> lock(ip_devices_mutex);
+    *statistics = find_ip_device(device)->get_stream_statistics(stream, index);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, index, statistics)
+
 rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_error** error) BEGIN_API_CALL
+{
+    return rs2_create_net_device_with_compression(api_version, address, "", error);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, address)
+
+rs2_device* rs2_create_net_device_with_compression(int api_version, const char* address, const char* compression, rs2_error** error) BEGIN_API_CALL
 {
     verify_version_compatibility(api_version);
     VALIDATE_NOT_NULL(address);
+    VALIDATE_NOT_NULL(compression);
 
     std::string addr(address);
 
     // create sw device
     rs2::software_device sw_dev = rs2::software_device([](rs2_device*) {});
     // create IP instance
-    ip_device* ip_dev = new ip_device(sw_dev, addr);
+    ip_device* ip_dev = new ip_device(sw_dev, addr, compression);
     // set client destruction functioun
     sw_dev.set_destruction_callback([ip_dev] { delete ip_dev; });
+    {
+        std::lock_guard<std::mutex> lock(ip_devices_mutex);
+        ip_devices[sw_dev.get()->device.get()] = ip_dev;
+    }
     // register device info to sw device
     DeviceData data = ip_dev->remote_sensors[0]->rtsp_client->getDeviceData();
     sw_dev.update_info(RS2_CAMERA_INFO_NAME, data.name + " IP Device");
@@ -418,4 +666,4 @@ rs2_device* rs2_create_net_device(int api_version, const char* address, rs2_erro
 
     return sw_dev.get().get();
 }
-HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, address)
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, address, compression)
@@ -16,10 +16,16 @@
 
 #define MAX_ACTIVE_STREAMS 4
 
-#define NUM_OF_SENSORS 2
+#define NUM_OF_SENSORS 3
+
+// the motion module is optional, it is not created when the server does not stream it
+#define MOTION_SENSOR_INDEX 2
 
 #define POLLING_SW_DEVICE_STATE_INTERVAL 100
 
+// the inject threads wake up at least every interval to check that their stream is still enabled
+#define INJECT_FRAMES_WAIT_INTERVAL 10
+
 #define DEFAULT_PROFILE_FPS 15
 
 #define DEFAULT_PROFILE_WIDTH 424
@@ -32,11 +38,15 @@ class ip_device
 {
 
 public:
-    ip_device(rs2::software_device sw_device, std::string ip_address);
+    ip_device(rs2::software_device sw_device, std::string ip_address, std::string compression = "");
     ~ip_device();
 
     ip_sensor* remote_sensors[NUM_OF_SENSORS];
 
+    void set_jitter_buffer(int delay_ms);
+    void set_transport(bool over_tcp, int receive_buffer_kb);
+    rs2_net_stream_statistics get_stream_statistics(rs2_stream type, int index);
+
 private:
     bool is_device_alive;
 
@@ -53,6 +63,13 @@ private:
 
     std::map<long long int, rs_rtp_callback*> rtp_callbacks;
 
+    // codec requested for the streams of each type, the server default codec is used for the other streams
+    std::map<rs2_stream, std::string> stream_codecs;
+
+    // transport of the streams, applied when the streams of a sensor are set up
+    std::atomic<bool> rtp_over_tcp{false};
+    std::atomic<int> receive_buffer_kb{0};
+
     std::thread sw_device_status_check;
 
     bool init_device_data(rs2::software_device sw_device);
@@ -60,6 +77,9 @@ private:
     void polling_state_loop();
 
     void inject_frames_loop(std::shared_ptr<rs_rtp_stream> rtp_stream);
+    void inject_video_frame(std::shared_ptr<rs_rtp_stream> rtp_stream, Raw_Frame* frame, int sensor_id);
+    void inject_motion_frames(std::shared_ptr<rs_rtp_stream> rtp_stream, Raw_Frame* frame, int sensor_id);
+    void set_frame_metadata(int sensor_id, Raw_Frame* frame);
 
     void stop_sensor_streams(int sensor_id);
 
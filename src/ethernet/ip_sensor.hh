@@ -7,6 +7,7 @@
 #include <librealsense2/rs.hpp>
 
 #include <list>
+#include <mutex>
 
 // Holds ip sensor data.
 //     1. sw sensor
@@ -25,6 +26,9 @@ public:
 
     bool is_enabled;
 
+    // the metadata of the software sensor is shared by its streams, their frames are injected one at a time
+    std::mutex frame_lock;
+
     //TODO: get smart ptr from rtsp client creator
     IRsRtsp* rtsp_client;
 
@@ -10,4 +10,14 @@ void rs_rtp_callback::on_frame(unsigned char* buffer, ssize_t size, struct timev
     m_rtp_stream.get()->insert_frame(new Raw_Frame((char*)buffer, size, presentationTime));
 }
 
+void rs_rtp_callback::on_packets(unsigned received, unsigned expected, double jitter_ms)
+{
+    m_rtp_stream.get()->update_packets(received, expected, jitter_ms);
+}
+
+void rs_rtp_callback::on_corrupted_frame()
+{
+    m_rtp_stream.get()->drop_corrupted_frame();
+}
+
 rs_rtp_callback::~rs_rtp_callback() {}
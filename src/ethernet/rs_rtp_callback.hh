@@ -29,6 +29,8 @@ public:
     ~rs_rtp_callback();
 
     void on_frame(unsigned char* buffer, ssize_t size, struct timeval presentationTime);
+    void on_packets(unsigned received, unsigned expected, double jitter_ms);
+    void on_corrupted_frame();
 
     int arrived_frames()
     {
@@ -9,28 +9,43 @@
 #include "software-device.h"
 #include <librealsense2/rs.hpp>
 
+#include <librealsense2-net/rs_net.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+
 #include <NetdevLog.h>
 
 const int RTP_QUEUE_MAX_SIZE = 30;
 
+// The latencies are smoothed like the RTP interarrival jitter (RFC 3550), the bitrate is measured over a second
+const double RTP_STATISTICS_SMOOTHING = 1.0 / 16;
+const double RTP_BITRATE_PERIOD = 1000; // milliseconds
+const double RTP_MIN_TRANSIT_DRIFT = 1.0 / 256;
+
+// Frame received in a buffer of the memory pool, the software frame created from it owns the buffer
 struct Raw_Frame
 {
     Raw_Frame(char* buffer, int size, struct timeval timestamp)
         : m_metadata((RsMetadataHeader*)buffer)
         , m_buffer(buffer + sizeof(RsMetadataHeader))
         , m_size(size)
-        , m_timestamp(timestamp){};
+        , m_timestamp(timestamp)
+        , m_arrival_time(system_time_ms()){};
     Raw_Frame(const Raw_Frame&);
     Raw_Frame& operator=(const Raw_Frame&);
-    ~Raw_Frame()
+
+    static double system_time_ms()
     {
-        delete[] m_buffer;
-    };
+        return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
 
     RsMetadataHeader* m_metadata;
     char* m_buffer;
     unsigned int m_size;
     struct timeval m_timestamp;
+    double m_arrival_time; // system time in milliseconds
 };
 
 class rs_rtp_stream
@@ -60,48 +75,130 @@ public:
         return m_rs_stream.type;
     }
 
+    // The frames wait in the jitter buffer ordered by their sequence number, each frame is released
+    // jitter_delay milliseconds after the fastest transit seen, so a frame delayed by the network waits less
     void insert_frame(Raw_Frame* new_raw_frame)
     {
-        if(queue_size() > RTP_QUEUE_MAX_SIZE)
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        update_statistics(new_raw_frame);
+        uint32_t sequence_number = new_raw_frame->m_metadata->data.sequenceNumber;
+        if(frames_queue.size() > RTP_QUEUE_MAX_SIZE || (jitter_delay > 0 && released_frames && int32_t(sequence_number - next_sequence_number) < 0))
         {
-            ERR << "Queue is full. Dropping frame for: " << this->m_rs_stream.uid;
+            // with a jitter buffer, a frame behind the ones already released is too late to be delivered in order
+            ERR << "Queue is full or frame is late. Dropping frame for: " << this->m_rs_stream.uid;
+            statistics.frames_dropped++;
+            release_frame(new_raw_frame);
+            return;
         }
-        else
+        if(!frames_queue.empty() && int32_t(sequence_number - frames_queue.rbegin()->first) < 0)
+        {
+            statistics.frames_reordered++;
+        }
+        if(!frames_queue.emplace(sequence_number, new_raw_frame).second)
         {
-            std::lock_guard<std::mutex> lock(this->stream_lock);
-            frames_queue.push(new_raw_frame);
+            statistics.frames_dropped++;
+            release_frame(new_raw_frame);
+            return;
         }
+        frames_cv.notify_one();
     }
 
     // extrinsics between this stream to all other streams
     // the key is generated by RsRTSPClient::getStreamProfileUniqueKey function
     std::map<long long int, rs2_extrinsics> extrinsics_map;
 
-    Raw_Frame* extract_frame()
+    // Returns the next frame when its time in the jitter buffer is over, nullptr when no frame is ready within timeout
+    Raw_Frame* extract_frame(std::chrono::milliseconds timeout)
     {
-        std::lock_guard<std::mutex> lock(this->stream_lock);
-        Raw_Frame* frame = frames_queue.front();
-        frames_queue.pop();
-        return frame;
+        std::unique_lock<std::mutex> lock(this->stream_lock);
+        auto deadline = std::chrono::system_clock::now() + timeout;
+        while(true)
+        {
+            auto wake_time = deadline;
+            if(!frames_queue.empty())
+            {
+                Raw_Frame* frame = frames_queue.begin()->second;
+                auto release_time = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::duration<double, std::milli>(frame->m_arrival_time + get_hold_time(frame))));
+                if(release_time <= std::chrono::system_clock::now())
+                {
+                    frames_queue.erase(frames_queue.begin());
+                    next_sequence_number = frame->m_metadata->data.sequenceNumber + 1;
+                    released_frames = true;
+                    return frame;
+                }
+                wake_time = std::min(wake_time, release_time);
+            }
+            if(std::chrono::system_clock::now() >= deadline)
+            {
+                return nullptr;
+            }
+            frames_cv.wait_until(lock, wake_time);
+        }
     }
 
     void reset_queue()
     {
-        while(!frames_queue.empty())
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        for(auto& frame : frames_queue)
         {
-            Raw_Frame* frame = frames_queue.front();
-            get_memory_pool().returnMem((unsigned char*)frame->m_buffer - sizeof(RsFrameHeader));
-            frames_queue.pop();
+            release_frame(frame.second);
         }
+        frames_queue.clear();
         INF << "Frames queue cleaned for " << m_rs_stream.uid;
     }
 
+    // Starts the statistics and the sequence of the frames of a new streaming session
+    void reset_statistics()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistics = {};
+        released_frames = false;
+        received_frames = false;
+        min_transit = 0;
+        bitrate_bytes = 0;
+        bitrate_begin = 0;
+    }
+
     int queue_size()
     {
         std::lock_guard<std::mutex> lock(this->stream_lock);
         return frames_queue.size();
     }
 
+    void set_jitter_delay(int delay_ms)
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        jitter_delay = delay_ms;
+    }
+
+    void update_packets(unsigned received, unsigned expected, double jitter_ms)
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistics.packets_received = received;
+        statistics.packets_lost = expected > received ? expected - received : 0;
+        statistics.jitter_ms = jitter_ms;
+    }
+
+    void drop_corrupted_frame()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        statistics.frames_corrupted++;
+    }
+
+    rs2_net_stream_statistics get_statistics()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        return statistics;
+    }
+
+    // system time of the last frame received, 0 before the first frame
+    double last_arrival_time()
+    {
+        std::lock_guard<std::mutex> lock(this->stream_lock);
+        return received_frames ? last_arrival : 0;
+    }
+
     static MemoryPool& get_memory_pool()
     {
         static MemoryPool memory_pool_instance = MemoryPool();
@@ -120,11 +217,89 @@ private:
         get_memory_pool().returnMem((unsigned char*)p - sizeof(RsFrameHeader));
     }
 
+    static void release_frame(Raw_Frame* frame)
+    {
+        get_memory_pool().returnMem((unsigned char*)frame->m_buffer - sizeof(RsFrameHeader));
+        delete frame;
+    }
+
+    // the transit includes the offset between the clocks of the server and the client, only its variation counts
+    double get_hold_time(Raw_Frame* frame)
+    {
+        double transit = frame->m_arrival_time - frame->m_metadata->data.sendTime;
+        return std::max(0.0, jitter_delay - (transit - min_transit));
+    }
+
+    void update_statistics(Raw_Frame* frame)
+    {
+        const auto& metadata = frame->m_metadata->data;
+        double transit = frame->m_arrival_time - metadata.sendTime;
+        if(!received_frames)
+        {
+            min_transit = transit;
+            statistics.latency_ms = transit;
+            bitrate_begin = frame->m_arrival_time;
+        }
+        else
+        {
+            int32_t gap = int32_t(metadata.sequenceNumber - last_sequence_number);
+            if(gap > 1)
+            {
+                statistics.frames_lost += gap - 1;
+            }
+            else if(gap < 0 && statistics.frames_lost > 0)
+            {
+                // a frame counted as lost arrived out of order
+                statistics.frames_lost--;
+            }
+            // the minimum follows the transit slowly up, so that a longer route or a clock drift does not hold the frames for ever
+            min_transit = transit < min_transit ? transit : min_transit + (transit - min_transit) * RTP_MIN_TRANSIT_DRIFT;
+            statistics.latency_ms += (transit - statistics.latency_ms) * RTP_STATISTICS_SMOOTHING;
+        }
+        if(!received_frames || int32_t(metadata.sequenceNumber - last_sequence_number) > 0)
+        {
+            last_sequence_number = metadata.sequenceNumber;
+        }
+
+        if(metadata.metadataMask & (uint64_t(1) << RS2_FRAME_METADATA_TIME_OF_ARRIVAL))
+        {
+            double server_latency = metadata.sendTime - metadata.metadata[RS2_FRAME_METADATA_TIME_OF_ARRIVAL];
+            statistics.server_latency_ms += (server_latency - statistics.server_latency_ms) * (received_frames ? RTP_STATISTICS_SMOOTHING : 1);
+        }
+
+        bitrate_bytes += frame->m_size;
+        if(frame->m_arrival_time - bitrate_begin >= RTP_BITRATE_PERIOD)
+        {
+            statistics.bitrate_kbps = bitrate_bytes * 8 / (frame->m_arrival_time - bitrate_begin);
+            bitrate_bytes = 0;
+            bitrate_begin = frame->m_arrival_time;
+        }
+
+        statistics.frames_received++;
+        received_frames = true;
+        last_arrival = frame->m_arrival_time;
+    }
+
     rs2::stream_profile m_stream_profile;
 
     std::mutex stream_lock;
 
-    std::queue<Raw_Frame*> frames_queue;
+    std::condition_variable frames_cv;
+
+    // frames waiting in the jitter buffer ordered by sequence number
+    std::map<uint32_t, Raw_Frame*> frames_queue;
+
+    int jitter_delay = 0; // milliseconds
+    double min_transit = 0;
+    bool released_frames = false;
+    uint32_t next_sequence_number = 0;
+
+    rs2_net_stream_statistics statistics = {};
+    bool received_frames = false;
+    uint32_t last_sequence_number = 0;
+    double last_arrival = 0;
+    unsigned long long bitrate_bytes = 0;
+    double bitrate_begin = 0;
 
     std::vector<uint8_t> pixels_buff;
 };
@@ -13,4 +13,10 @@ class rtp_callback
 public:
     void virtual on_frame(unsigned char* buffer, ssize_t size, struct timeval presentationTime) = 0;
 
+    // reception statistics of the RTP packets of the stream since it started, reported after each frame
+    void virtual on_packets(unsigned received, unsigned expected, double jitter_ms) {}
+
+    // frame received with a size not matching its header or failing to decompress
+    void virtual on_corrupted_frame() {}
+
 };
@@ -12,52 +12,90 @@ namespace librealsense
         const command& fw_logs_command, const command& flash_logs_command) :
         device(ctx, group),
         _hw_monitor(hardware_monitor),
-        _fw_logs(),
+        _fw_logs(FW_LOGS_QUEUE_SIZE),
+        _poll_interval_ms(FW_LOGS_MIN_POLL_INTERVAL_MS),
         _flash_logs(),
         _flash_logs_initialized(false),
         _parser(nullptr),
         _fw_logs_command(fw_logs_command),
         _flash_logs_command(flash_logs_command) { }
 
-    bool firmware_logger_device::get_fw_log(fw_logs::fw_logs_binary_data& binary_data)
+    firmware_logger_device::~firmware_logger_device()
     {
-        bool result = false;
-        if (_fw_logs.empty())
-        {
-            get_fw_logs_from_hw_monitor();
-        }
+        std::lock_guard<std::mutex> lock(_fw_logs_collector_mtx);
+        if (_fw_logs_collector)
+            _fw_logs_collector->stop();
+    }
 
-        if (!_fw_logs.empty())
+    void firmware_logger_device::start_fw_logs_collector()
+    {
+        std::lock_guard<std::mutex> lock(_fw_logs_collector_mtx);
+        if (_fw_logs_collector)
+            return;
+
+        _fw_logs_collector = std::make_shared<active_object<>>([this](dispatcher::cancellable_timer t)
         {
-            fw_logs::fw_logs_binary_data data;
-            data = _fw_logs.front();
-            _fw_logs.pop();
-            binary_data = data;
-            result = true;
-        }
-        return result;
+            size_t pulled = 0;
+            try
+            {
+                pulled = get_fw_logs_from_hw_monitor();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_DEBUG("Pulling FW logs failed: " << e.what());
+            }
+            if (pulled)
+                _poll_interval_ms = FW_LOGS_MIN_POLL_INTERVAL_MS;
+            else
+                _poll_interval_ms = std::min(_poll_interval_ms * 2, unsigned(FW_LOGS_MAX_POLL_INTERVAL_MS));
+            t.try_sleep(_poll_interval_ms);
+        });
+        _fw_logs_collector->start();
     }
 
+    bool firmware_logger_device::get_fw_log(fw_logs::fw_logs_binary_data& binary_data)
+    {
+        start_fw_logs_collector();
+        return _fw_logs.try_dequeue(&binary_data);
+    }
 
-    void firmware_logger_device::get_fw_logs_from_hw_monitor()
+    size_t firmware_logger_device::get_fw_logs(std::vector<fw_logs::fw_logs_binary_data>& logs, size_t max_count, unsigned int timeout_ms)
+    {
+        start_fw_logs_collector();
+
+        size_t count = 0;
+        fw_logs::fw_logs_binary_data binary_data;
+        if (max_count == 0 || !_fw_logs.dequeue(&binary_data, timeout_ms))
+            return count;
+        do
+        {
+            logs.push_back(std::move(binary_data));
+            ++count;
+        } while (count < max_count && _fw_logs.try_dequeue(&binary_data));
+        return count;
+    }
+
+    size_t firmware_logger_device::get_fw_logs_from_hw_monitor()
     {
         auto res = _hw_monitor->send(_fw_logs_command);
         if (res.empty())
         {
-            return;
+            return 0;
         }
 
         auto beginOfLogIterator = res.begin();
+        size_t count = res.size() / fw_logs::BINARY_DATA_SIZE;
         // convert bytes to fw_logs_binary_data
-        for (int i = 0; i < res.size() / fw_logs::BINARY_DATA_SIZE; ++i)
+        for (size_t i = 0; i < count; ++i)
         {
             auto endOfLogIterator = beginOfLogIterator + fw_logs::BINARY_DATA_SIZE;
             std::vector<uint8_t> resultsForOneLog;
             resultsForOneLog.insert(resultsForOneLog.begin(), beginOfLogIterator, endOfLogIterator);
             fw_logs::fw_logs_binary_data binary_data{ resultsForOneLog };
-            _fw_logs.push(binary_data);
+            _fw_logs.enqueue(std::move(binary_data));
             beginOfLogIterator = endOfLogIterator;
         }
+        return count;
     }
 
     void firmware_logger_device::get_flash_logs_from_hw_monitor()
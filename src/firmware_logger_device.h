@@ -15,6 +15,8 @@ namespace librealsense
     {
     public:
         virtual bool get_fw_log(fw_logs::fw_logs_binary_data& binary_data) = 0;
+        // Appends up to max_count collected logs, waiting up to timeout_ms for the first one. Returns the number appended
+        virtual size_t get_fw_logs(std::vector<fw_logs::fw_logs_binary_data>& logs, size_t max_count, unsigned int timeout_ms) = 0;
         virtual bool get_flash_log(fw_logs::fw_logs_binary_data& binary_data) = 0;
         virtual bool init_parser(std::string xml_content) = 0;
         virtual bool parse_log(const fw_logs::fw_logs_binary_data* fw_log_msg, fw_logs::fw_log_data* parsed_msg) = 0;
@@ -28,8 +30,10 @@ namespace librealsense
         firmware_logger_device(std::shared_ptr<context> ctx, const platform::backend_device_group group,
             std::shared_ptr<hw_monitor> hardware_monitor,
             const command& fw_logs_command, const command& flash_logs_command);
+        ~firmware_logger_device();
 
         bool get_fw_log(fw_logs::fw_logs_binary_data& binary_data) override;
+        size_t get_fw_logs(std::vector<fw_logs::fw_logs_binary_data>& logs, size_t max_count, unsigned int timeout_ms) override;
         bool get_flash_log(fw_logs::fw_logs_binary_data& binary_data) override;
 
         bool init_parser(std::string xml_content) override;
@@ -40,8 +44,16 @@ namespace librealsense
             { _hw_monitor = hardware_monitor; }
 
     private:
-
-        void get_fw_logs_from_hw_monitor();
+        // The FW logs are pulled by a collector thread, started by the first request for them. It polls every
+        // FW_LOGS_MIN_POLL_INTERVAL_MS while the device has logs to send and doubles the interval up to
+        // FW_LOGS_MAX_POLL_INTERVAL_MS while it has none, so waiting for logs doesn't keep the hw_monitor busy
+        // ahead of the option and calibration commands
+        static const unsigned int FW_LOGS_MIN_POLL_INTERVAL_MS = 10;
+        static const unsigned int FW_LOGS_MAX_POLL_INTERVAL_MS = 1000;
+        static const unsigned int FW_LOGS_QUEUE_SIZE = 4096;
+
+        void start_fw_logs_collector();
+        size_t get_fw_logs_from_hw_monitor();
         void get_flash_logs_from_hw_monitor();
 
         command _fw_logs_command;
@@ -49,7 +61,10 @@ namespace librealsense
 
         std::shared_ptr<hw_monitor> _hw_monitor;
 
-        std::queue<fw_logs::fw_logs_binary_data> _fw_logs;
+        lock_free_single_consumer_queue<fw_logs::fw_logs_binary_data> _fw_logs;
+        std::shared_ptr<active_object<>> _fw_logs_collector;
+        std::mutex _fw_logs_collector_mtx;
+        unsigned int _poll_interval_ms;
         std::queue<fw_logs::fw_logs_binary_data> _flash_logs;
 
         bool _flash_logs_initialized;
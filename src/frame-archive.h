@@ -3,6 +3,10 @@
 #pragma once
 
 #include "archive.h"
+#include "profiler.h"
+
+#include <deque>
+#include <unordered_map>
 
 namespace librealsense
 {
@@ -12,61 +16,103 @@ namespace librealsense
     {
         std::atomic<uint32_t>* max_frame_queue_size;
         std::atomic<uint32_t> published_frames_count;
-        small_heap<T, RS2_USER_QUEUE_SIZE> published_frames;
+        segmented_heap<T, RS2_USER_QUEUE_SIZE, RS2_MAX_USER_QUEUE_SIZE / RS2_USER_QUEUE_SIZE> published_frames;
         std::shared_ptr<metadata_parser_map> _metadata_parsers = nullptr;
         callbacks_heap callback_inflight;
 
-        std::vector<T> freelist; // return frames here
+        // Recycled frames are bucketed by buffer size so a matching buffer is found in O(1)
+        // Each bucket keeps its frames in the order they were returned, oldest first
+        // Emptied buckets are kept while few sizes are in use, so that steady recycling does not allocate them again
+        std::unordered_map<size_t, std::deque<T>> freelist; // return frames here
+        static const size_t max_freelist_buckets = 16;
+        mutable std::mutex freelist_mutex;
+        rs2_time_t freelist_retention = 1000; // Recycled buffers older than this (ms) are released
+        frame_pool_stats pool_stats;
+        frame_buffer_allocator<byte> buffer_allocator; // source of new frame buffers
         std::atomic<bool> recycle_frames;
         int pending_frames = 0;
-        std::recursive_mutex mutex;
         std::shared_ptr<platform::time_service> _time_service;
 
+        std::shared_ptr<memory_counter> memory; // counts the frame buffers, the process-wide counter when null
+
         std::weak_ptr<sensor_interface> _sensor;
         std::shared_ptr<sensor_interface> get_sensor() const override { return _sensor.lock(); }
         void set_sensor(std::shared_ptr<sensor_interface> s) override { _sensor = s; }
 
+        // The recycled buffers are counted in the counter the buffer was allocated from
+        static void count_pooled(const T& f, long long sign)
+        {
+            memory_counter::get(f.data.get_allocator().get_counter()).add(RS2_MEMORY_CATEGORY_FRAME_POOL, sign * (long long)f.data.capacity());
+        }
+
+        void clear_freelist()
+        {
+            for (auto&& kvp : freelist)
+                for (auto&& f : kvp.second)
+                    count_pooled(f, -1);
+            freelist.clear();
+        }
+
         T alloc_frame(const size_t size, const frame_additional_data& additional_data, bool requires_memory)
         {
+            LRS_PROFILE_ZONE("frame_archive::alloc_frame");
             T backbuffer;
+            frame_buffer_allocator<byte> allocator;
             //const size_t size = modes[stream].get_image_size(stream);
             {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
+                std::lock_guard<std::mutex> guard(freelist_mutex);
+                allocator = buffer_allocator;
 
-                if (requires_memory)
+                // Discard buffers that have been in the freelist for longer than the retention period
+                for (auto it = begin(freelist); it != end(freelist);)
                 {
-                    // Attempt to obtain a buffer of the appropriate size from the freelist
-                    for (auto it = begin(freelist); it != end(freelist); ++it)
+                    auto& bucket = it->second;
+                    while (!bucket.empty() && additional_data.timestamp > bucket.front().additional_data.timestamp + freelist_retention)
                     {
-                        if (it->data.size() == size)
-                        {
-                            backbuffer = std::move(*it);
-                            freelist.erase(it);
-                            break;
-                        }
+                        count_pooled(bucket.front(), -1);
+                        bucket.pop_front();
+                        ++pool_stats.evictions;
                     }
+                    if (bucket.empty() && freelist.size() > max_freelist_buckets) it = freelist.erase(it);
+                    else ++it;
                 }
 
-                // Discard buffers that have been in the freelist for longer than 1s
-                for (auto it = begin(freelist); it != end(freelist);)
+                if (requires_memory)
                 {
-                    if (additional_data.timestamp > it->additional_data.timestamp + 1000) it = freelist.erase(it);
-                    else ++it;
+                    // Attempt to obtain a buffer of the appropriate size from the freelist,
+                    // preferring the most recently returned one as it is the likeliest to still be cached
+                    auto it = freelist.find(size);
+                    if (it != freelist.end() && !it->second.empty())
+                    {
+                        backbuffer = std::move(it->second.back());
+                        it->second.pop_back();
+                        count_pooled(backbuffer, -1);
+                        ++pool_stats.hits;
+                    }
+                    else
+                    {
+                        ++pool_stats.misses;
+                        // The recycled buffers of the archive are the first to go when a new one would exceed a memory budget
+                        if (memory_counter::get(allocator.get_counter()).exceeds_budget(size))
+                            clear_freelist();
+                    }
                 }
             }
 
             if (requires_memory)
             {
-                backbuffer.data.resize(size, 0); // TODO: Allow users to provide a custom allocator for frame buffers
+                if (backbuffer.data.get_allocator() != allocator)
+                    backbuffer.data = frame_buffer(allocator);
+                backbuffer.data.resize(size); // Contents are left uninitialized, producers overwrite the whole buffer
             }
             backbuffer.additional_data = additional_data;
             return backbuffer;
         }
 
+        // Publishing and unpublishing take no archive-wide lock: the published frames heap and the freelist
+        // have their own, and a frame being unpublished is no longer referenced by anyone else
         frame_interface* track_frame(T& f)
         {
-            std::unique_lock<std::recursive_mutex> lock(mutex);
-
             auto published_frame = f.publish(this->shared_from_this());
             if (published_frame)
             {
@@ -84,15 +130,17 @@ namespace librealsense
             {
                 auto f = (T*)frame;
                 log_frame_callback_end(f);
-                std::unique_lock<std::recursive_mutex> lock(mutex);
 
                 frame->keep();
 
-                if (recycle_frames)
+                // Frames that do not own memory have nothing worth recycling
+                if (recycle_frames && !f->data.empty())
                 {
-                    freelist.push_back(std::move(*f));
+                    std::lock_guard<std::mutex> guard(freelist_mutex);
+                    auto size = f->data.size();
+                    count_pooled(*f, 1);
+                    freelist[size].push_back(std::move(*f));
                 }
-                lock.unlock();
 
                 if (f->is_fixed())
                     published_frames.deallocate(f);
@@ -112,13 +160,18 @@ namespace librealsense
 
             unsigned int max_frames = *max_frame_queue_size;
 
-            if (published_frames_count >= max_frames
-                && max_frames)
+            // Reserve the slot atomically, concurrent publishers must not exceed the queue size together
+            auto count = published_frames_count.load();
+            do
             {
-                LOG_DEBUG("User didn't release frame resource.");
-                return nullptr;
-            }
-            auto new_frame = (max_frames ? published_frames.allocate() : new T());
+                if (count >= max_frames && max_frames)
+                {
+                    LOG_DEBUG("User didn't release frame resource.");
+                    return nullptr;
+                }
+            } while (!published_frames_count.compare_exchange_weak(count, count + 1));
+
+            auto new_frame = (max_frames ? published_frames.allocate(max_frames) : new T());
 
             if (new_frame)
             {
@@ -130,7 +183,6 @@ namespace librealsense
                 new_frame = new T();
             }
 
-            ++published_frames_count;
             *new_frame = std::move(*f);
 
             return new_frame;
@@ -166,7 +218,7 @@ namespace librealsense
             std::shared_ptr<platform::time_service> ts,
             std::shared_ptr<metadata_parser_map> parsers)
             : max_frame_queue_size(in_max_frame_queue_size),
-            recycle_frames(true), mutex(), _time_service(ts),
+            recycle_frames(true), _time_service(ts),
             _metadata_parsers(parsers)
         {
             published_frames_count = 0;
@@ -188,6 +240,36 @@ namespace librealsense
             return track_frame(frame);
         }
 
+        void set_frame_allocator(frame_allocator_ptr allocator) override
+        {
+            std::lock_guard<std::mutex> guard(freelist_mutex);
+            buffer_allocator = frame_buffer_allocator<byte>(std::move(allocator), memory);
+            clear_freelist();
+        }
+
+        void set_memory_counter(std::shared_ptr<memory_counter> counter) override
+        {
+            std::lock_guard<std::mutex> guard(freelist_mutex);
+            memory = std::move(counter);
+            buffer_allocator = frame_buffer_allocator<byte>(buffer_allocator.get_user_allocator(), memory);
+            clear_freelist();
+        }
+
+        void set_freelist_retention(rs2_time_t retention_ms) override
+        {
+            std::lock_guard<std::mutex> guard(freelist_mutex);
+            freelist_retention = retention_ms;
+        }
+
+        frame_pool_stats get_pool_stats() const override
+        {
+            std::lock_guard<std::mutex> guard(freelist_mutex);
+            auto stats = pool_stats;
+            stats.in_use = published_frames_count;
+            stats.capacity = *max_frame_queue_size;
+            return stats;
+        }
+
         void flush() override
         {
             published_frames.stop_allocation();
@@ -203,8 +285,10 @@ namespace librealsense
             callback_inflight.wait_until_empty();
 
             {
-                std::lock_guard<std::recursive_mutex> guard(mutex);
-                freelist.clear();
+                std::lock_guard<std::mutex> guard(freelist_mutex);
+                clear_freelist();
+                LOG_DEBUG("Frame pool 0x" << std::hex << this << std::dec << " hits: " << pool_stats.hits
+                    << ", misses: " << pool_stats.misses << ", evictions: " << pool_stats.evictions);
             }
 
             pending_frames = published_frames.get_size();
@@ -219,6 +303,11 @@ namespace librealsense
 
         ~frame_archive()
         {
+            {
+                std::lock_guard<std::mutex> guard(freelist_mutex);
+                clear_freelist();
+            }
+
             if (pending_frames > 0)
             {
                 LOG_DEBUG("All frames from stream 0x"
@@ -0,0 +1,183 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "frame-memory.h"
+
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <limits.h>
+#include <stdlib.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+#endif
+
+namespace librealsense
+{
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    static const int MAX_NUMA_NODES = 1024;
+
+    class page_frame_allocator : public rs2_frame_allocator
+    {
+    public:
+        page_frame_allocator(int numa_node, bool huge_pages) : _numa_node(numa_node), _huge_pages(huge_pages) {}
+
+        void* allocate(size_t size) override
+        {
+            auto huge = is_huge(size);
+            auto length = mapped_size(size);
+#ifdef _WIN32
+            auto node = _numa_node >= 0 ? DWORD(_numa_node) : NUMA_NO_PREFERRED_NODE;
+            void* ptr = nullptr;
+            // Large pages need the SeLockMemoryPrivilege, without it the buffer is mapped on regular pages
+            if (huge)
+                ptr = VirtualAllocExNuma(GetCurrentProcess(), nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node);
+            if (!ptr)
+                ptr = VirtualAllocExNuma(GetCurrentProcess(), nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+            return ptr;
+#else
+            void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+            if (huge)
+                ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+            if (ptr == MAP_FAILED)
+            {
+                // No huge pages reserved, the transparent huge pages are asked for instead
+                ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (ptr == MAP_FAILED)
+                    return nullptr;
+#ifdef MADV_HUGEPAGE
+                if (huge)
+                    madvise(ptr, length, MADV_HUGEPAGE);
+#endif
+            }
+            bind(ptr, length);
+            return ptr;
+#endif
+        }
+
+        void deallocate(void* ptr, size_t size) override
+        {
+#ifdef _WIN32
+            VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+            munmap(ptr, mapped_size(size));
+#endif
+        }
+
+        void release() override { delete this; }
+
+    private:
+        bool is_huge(size_t size) const { return _huge_pages && size >= HUGE_PAGE_SIZE / 2; }
+
+        // Huge page mappings are whole huge pages, the others whole regular pages
+        size_t mapped_size(size_t size) const
+        {
+            size_t page = HUGE_PAGE_SIZE;
+            if (!is_huge(size))
+            {
+#ifdef _WIN32
+                SYSTEM_INFO info;
+                GetSystemInfo(&info);
+                page = info.dwPageSize;
+#else
+                page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+            }
+            return (size + page - 1) / page * page;
+        }
+
+#ifndef _WIN32
+        // The pages are placed when first touched, binding the range before returning it places them all on the node
+        void bind(void* ptr, size_t length)
+        {
+            if (_numa_node < 0)
+                return;
+#if defined(__linux__) && defined(SYS_mbind)
+            const int MPOL_PREFERRED = 1; // falls back to the other nodes when the node is out of memory, rather than failing
+            const size_t BITS_PER_LONG = sizeof(unsigned long) * 8;
+            unsigned long nodemask[MAX_NUMA_NODES / BITS_PER_LONG] = {};
+            nodemask[_numa_node / BITS_PER_LONG] = 1UL << (_numa_node % BITS_PER_LONG);
+            if (syscall(SYS_mbind, ptr, length, MPOL_PREFERRED, nodemask, MAX_NUMA_NODES + 1, 0) != 0 && !_warned.exchange(true))
+                LOG_WARNING("Frame buffers could not be bound to NUMA node " << _numa_node << ", error " << errno);
+#else
+            if (!_warned.exchange(true))
+                LOG_WARNING("Binding frame buffers to NUMA nodes is not supported on this platform");
+#endif
+        }
+#endif
+
+        int _numa_node;
+        bool _huge_pages;
+        std::atomic<bool> _warned{ false };
+    };
+
+    frame_allocator_ptr make_page_frame_allocator(int numa_node, bool huge_pages)
+    {
+        if (numa_node >= MAX_NUMA_NODES)
+            throw invalid_value_exception(to_string() << "NUMA node " << numa_node << " is out of range");
+        return frame_allocator_ptr(new page_frame_allocator(numa_node, huge_pages), [](rs2_frame_allocator* p) { p->release(); });
+    }
+
+#ifdef __linux__
+    // The node is an attribute of the PCI device of the controller, one of the parents of the USB device in sysfs
+    static int read_numa_node(std::string path)
+    {
+        char real[PATH_MAX];
+        if (!realpath(path.c_str(), real))
+            return -1;
+        path = real;
+        while (path.size() > std::string("/sys/devices").size())
+        {
+            int node;
+            if (std::ifstream(path + "/numa_node") >> node)
+                return node;
+            path = path.substr(0, path.find_last_of('/'));
+        }
+        return -1;
+    }
+
+    // The unique ids of the USB devices are bus-port-address, and /sys/bus/usb/devices/bus-port links to the device
+    static std::string get_usb_sysfs_path(const std::string& unique_id)
+    {
+        auto address = unique_id.find_last_of('-');
+        if (address == std::string::npos || address == 0)
+            return "";
+        return "/sys/bus/usb/devices/" + unique_id.substr(0, address);
+    }
+#endif
+
+    int get_numa_node(const platform::backend_device_group& group)
+    {
+#ifdef __linux__
+        std::vector<std::string> paths;
+        for (auto&& uvc : group.uvc_devices)
+        {
+            paths.push_back(uvc.device_path);
+            paths.push_back(get_usb_sysfs_path(uvc.unique_id));
+        }
+        for (auto&& usb : group.usb_devices)
+            paths.push_back(get_usb_sysfs_path(usb.unique_id));
+        for (auto&& hid : group.hid_devices)
+            paths.push_back(hid.device_path);
+
+        for (auto&& path : paths)
+        {
+            if (path.find("/sys/") != 0)
+                continue;
+            auto node = read_numa_node(path);
+            if (node >= 0)
+                return node;
+        }
+#endif
+        return -1;
+    }
+}
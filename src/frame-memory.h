@@ -0,0 +1,21 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "backend.h"
+#include "types.h"
+
+namespace librealsense
+{
+    /*
+        Frame buffers mapped from the system rather than taken from the heap, so their placement is decided before the first touch.
+        The pages of a buffer are preferably taken from numa_node, when it is not negative, and the buffers of 1 MB and above are
+        mapped on 2 MB pages when huge_pages is set: explicit huge pages when the system reserved some, transparent ones otherwise.
+        Mapping is slower than the heap, but the frame pools recycle the buffers, so it happens when a stream starts, not per frame
+    */
+    frame_allocator_ptr make_page_frame_allocator(int numa_node, bool huge_pages);
+
+    // NUMA node of the controller a device of the group is attached to, -1 when unknown or when the system has a single node
+    int get_numa_node(const platform::backend_device_group& group);
+}
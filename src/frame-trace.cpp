@@ -0,0 +1,170 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "frame-trace.h"
+#include "archive.h"
+#include "types.h"
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+namespace librealsense
+{
+    std::atomic<bool> frame_trace::_enabled(false);
+
+    rs2_time_t get_trace_time()
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    void record_frame_trace(frame_interface* f, rs2_frame_trace_stage stage, const char* name)
+    {
+        auto time = get_trace_time();
+        if (auto composite = dynamic_cast<composite_frame*>(f))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                record_frame_trace(composite->get_frame(int(i)), stage, name);
+        }
+        else if (auto fr = dynamic_cast<frame*>(f))
+        {
+            fr->additional_data.trace.add(stage, name, time);
+        }
+    }
+
+    const char* get_trace_name(const std::string& name)
+    {
+        static std::mutex mutex;
+        static std::set<std::string> names; // the nodes of the set are never moved
+        std::lock_guard<std::mutex> lock(mutex);
+        return names.insert(name).first->c_str();
+    }
+
+    class frame_trace_file
+    {
+    public:
+        static frame_trace_file& get_instance()
+        {
+            static frame_trace_file instance;
+            return instance;
+        }
+
+        void start(const std::string& filename)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            close();
+            _file.open(filename, std::ios::out | std::ios::trunc);
+            if (!_file)
+                throw invalid_value_exception(to_string() << "cannot open frame trace file " << filename);
+            _file << "[";
+            _first_event = true;
+            _tracks.clear();
+            _open = true;
+        }
+
+        void stop()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            close();
+        }
+
+        bool is_open() const { return _open.load(std::memory_order_relaxed); }
+
+        void write(const frame& f)
+        {
+            auto& trace = f.additional_data.trace;
+            // the frames of a frameset write their own stamps
+            if (trace.size() == trace.inherited() || dynamic_cast<const composite_frame*>(&f))
+                return;
+
+            std::ostringstream events;
+            int track = 0;
+            std::string stream_name;
+            if (auto stream = f.get_stream())
+            {
+                track = stream->get_unique_id();
+                stream_name = to_string() << get_string(stream->get_stream_type()) << " " << stream->get_stream_index();
+            }
+            auto frame_number = f.additional_data.frame_number;
+            for (int i = trace.inherited(); i < trace.size(); i++)
+            {
+                auto& stamp = trace[i];
+                if (stamp.stage == RS2_FRAME_TRACE_STAGE_BLOCK_BEGIN)
+                    continue;
+
+                // a processing block is a slice from the stamp of the frame it received, the other stages are instants
+                int begin = -1;
+                if (stamp.stage == RS2_FRAME_TRACE_STAGE_BLOCK_END)
+                {
+                    for (begin = i - 1; begin >= 0; begin--)
+                        if (trace[begin].stage == RS2_FRAME_TRACE_STAGE_BLOCK_BEGIN && trace[begin].name == stamp.name)
+                            break;
+                }
+
+                events << ",\n{\"pid\":1,\"tid\":" << track << std::fixed << ",\"args\":{\"frame\":" << frame_number << "},";
+                if (begin >= 0)
+                {
+                    events << "\"ph\":\"X\",\"ts\":" << trace[begin].time * 1000 << ",\"dur\":" << (stamp.time - trace[begin].time) * 1000
+                        << ",\"name\":\"" << stamp.name << "\"}";
+                }
+                else
+                {
+                    events << "\"ph\":\"i\",\"s\":\"t\",\"ts\":" << stamp.time * 1000
+                        << ",\"name\":\"" << get_string(stamp.stage) << (*stamp.name ? " " : "") << stamp.name << "\"}";
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_open)
+                return;
+            if (_tracks.insert(track).second)
+            {
+                events << ",\n{\"pid\":1,\"tid\":" << track << ",\"ph\":\"M\",\"name\":\"thread_name\",\"args\":{\"name\":\""
+                    << (stream_name.empty() ? "Frames" : stream_name) << "\"}}";
+            }
+            auto text = events.str();
+            // the first event of the file is not preceded by a separator
+            _file << (_first_event ? text.substr(1) : text);
+            _first_event = false;
+        }
+
+    private:
+        void close()
+        {
+            if (!_open)
+                return;
+            _open = false;
+            _file << "\n]\n";
+            _file.close();
+        }
+
+        std::mutex _mutex;
+        std::ofstream _file;
+        std::atomic<bool> _open{ false };
+        bool _first_event = true;
+        std::set<int> _tracks;
+    };
+
+    void start_frame_trace_file(const std::string& filename)
+    {
+        frame_trace_file::get_instance().start(filename);
+        frame_trace::enable(true);
+    }
+
+    void stop_frame_trace_file()
+    {
+        frame_trace_file::get_instance().stop();
+    }
+
+    bool is_frame_trace_file_open()
+    {
+        return frame_trace_file::get_instance().is_open();
+    }
+
+    void write_frame_trace(const frame& f)
+    {
+        frame_trace_file::get_instance().write(f);
+    }
+}
@@ -0,0 +1,89 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_frame.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+
+namespace librealsense
+{
+    class frame_interface;
+    class frame;
+
+    /*
+        Times of the stages a frame went through on its way to the user, in the system clock of frame_additional_data::system_time.
+        A frame allocated by a processing block from another one starts with the stamps of the original frame,
+        the stamps after inherited() are the ones of the frame itself.
+        The stamps are recorded only while tracing is enabled, stamping a frame otherwise costs a relaxed load
+    */
+    class frame_trace
+    {
+    public:
+        static const int max_stamps = 16;
+
+        frame_trace() : _count(0) {}
+        frame_trace(const frame_trace& other) { *this = other; }
+        frame_trace& operator=(const frame_trace& other)
+        {
+            int count = other.size();
+            std::copy(other._stamps.begin(), other._stamps.begin() + count, _stamps.begin());
+            _count = count;
+            _inherited = other._inherited;
+            return *this;
+        }
+
+        // Called on the trace copied from the original frame to a frame derived from it
+        void derive() { _inherited = size(); }
+
+        // Several threads may stamp the frame handed to several consumers, the stamps after max_stamps are dropped
+        void add(rs2_frame_trace_stage stage, const char* name, rs2_time_t time)
+        {
+            auto index = _count.fetch_add(1);
+            if (index < max_stamps)
+                _stamps[index] = { stage, name ? name : "", time };
+        }
+
+        int size() const { return std::min(_count.load(), max_stamps); }
+        int inherited() const { return _inherited; }
+        const rs2_frame_trace_stamp& operator[](int index) const { return _stamps[index]; }
+
+        static bool is_enabled() { return _enabled.load(std::memory_order_relaxed); }
+        static void enable(bool enabled) { _enabled = enabled; }
+
+    private:
+        std::array<rs2_frame_trace_stamp, max_stamps> _stamps;
+        std::atomic<int> _count;
+        int _inherited = 0;
+
+        static std::atomic<bool> _enabled;
+    };
+
+    rs2_time_t get_trace_time();
+
+    // Stamps the frame, or each frame of a composite frame, with the current time
+    void record_frame_trace(frame_interface* f, rs2_frame_trace_stage stage, const char* name);
+
+    inline void trace_frame(frame_interface* f, rs2_frame_trace_stage stage, const char* name = nullptr)
+    {
+        if (frame_trace::is_enabled() && f)
+            record_frame_trace(f, stage, name);
+    }
+
+    // Name of a processing block as kept by the stamps, valid until the process exits
+    const char* get_trace_name(const std::string& name);
+
+    /*
+        Writes the stamps of the frames in the Chrome trace event format, read by chrome://tracing and Perfetto.
+        Each frame writes its own stamps when it is released: a processing block is a slice from the frame
+        it received to the frame it delivered, the other stages are instant events. The stream of a frame is its track
+    */
+    void start_frame_trace_file(const std::string& filename);
+    void stop_frame_trace_file();
+    bool is_frame_trace_file_open();
+    void write_frame_trace(const frame& f);
+}
@@ -1,9 +1,6 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 #include "fw-logs-parser.h"
-#include <regex>
-#include <sstream>
-#include "fw-string-formatter.h"
 #include "stdint.h"
 
 using namespace std;
@@ -14,10 +11,15 @@ namespace librealsense
     {
         fw_logs_parser::fw_logs_parser(string xml_content)
             : _fw_logs_formating_options(xml_content),
+            _formatter({}),
             _last_timestamp(0),
             _timestamp_factor(0.00001)
         {
             _fw_logs_formating_options.initialize_from_xml();
+            _formatter = fw_string_formatter(_fw_logs_formating_options.get_enums());
+
+            for (auto& event : _fw_logs_formating_options.get_events())
+                _events[event.first] = { event.second.num_of_params, fw_string_formatter::compile(event.second.line) };
         }
 
 
@@ -27,20 +29,39 @@ namespace librealsense
 
         fw_log_data fw_logs_parser::parse_fw_log(const fw_logs_binary_data* fw_log_msg) 
         {
-            fw_log_data log_data;
-
             if (!fw_log_msg || fw_log_msg->logs_buffer.size() == 0)
-                return log_data;
+                return fw_log_data();
 
-            log_data = fill_log_data(fw_log_msg);
+            return parse_fw_log(reinterpret_cast<const fw_logs::fw_log_binary*>(fw_log_msg->logs_buffer.data()));
+        }
 
-            //message
-            fw_string_formatter reg_exp(_fw_logs_formating_options.get_enums());
-            fw_log_event log_event_data;
-            _fw_logs_formating_options.get_event_data(log_data._event_id, &log_event_data);
+        std::vector<fw_log_data> fw_logs_parser::parse_fw_logs(const uint8_t* buffer, size_t size)
+        {
+            std::vector<fw_log_data> logs;
+            if (!buffer)
+                return logs;
+
+            logs.reserve(size / BINARY_DATA_SIZE);
+            for (size_t offset = 0; offset + BINARY_DATA_SIZE <= size; offset += BINARY_DATA_SIZE)
+                logs.push_back(parse_fw_log(reinterpret_cast<const fw_logs::fw_log_binary*>(buffer + offset)));
+            return logs;
+        }
+
+        fw_log_data fw_logs_parser::parse_fw_log(const fw_log_binary* log_binary)
+        {
+            fw_log_data log_data = fill_log_data(log_binary);
 
+            //message
             uint32_t params[3] = { log_data._p1, log_data._p2, log_data._p3 };
-            reg_exp.generate_message(log_event_data.line, log_event_data.num_of_params, params, &log_data._message);
+            auto event_it = _events.find(log_data._event_id);
+            if (event_it != _events.end())
+                _formatter.generate_message(event_it->second.format, event_it->second.num_of_params, params, &log_data._message);
+            else
+            {
+                fw_log_event log_event_data;
+                _fw_logs_formating_options.get_event_data(log_data._event_id, &log_event_data);
+                _formatter.generate_message(log_event_data.line, log_event_data.num_of_params, params, &log_data._message);
+            }
 
             //file_name
             _fw_logs_formating_options.get_file_name(log_data._file_id, &log_data._file_name);
@@ -51,12 +72,10 @@ namespace librealsense
             return log_data;
         }
 
-        fw_log_data fw_logs_parser::fill_log_data(const fw_logs_binary_data* fw_log_msg)
+        fw_log_data fw_logs_parser::fill_log_data(const fw_log_binary* log_binary)
         {
             fw_log_data log_data;
 
-            auto* log_binary = reinterpret_cast<const fw_logs::fw_log_binary*>(fw_log_msg->logs_buffer.data());
-
             //parse first DWORD
             log_data._magic_number = static_cast<uint32_t>(log_binary->dword1.bits.magic_number);
             log_data._severity = static_cast<uint32_t>(log_binary->dword1.bits.severity);
@@ -4,7 +4,9 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "fw-logs-formating-options.h"
+#include "fw-string-formatter.h"
 #include "fw-log-data.h"
 
 namespace librealsense
@@ -19,11 +21,24 @@ namespace librealsense
 
             fw_log_data parse_fw_log(const fw_logs_binary_data* fw_log_msg);
 
+            // Parse a buffer of consecutive binary logs (BINARY_DATA_SIZE bytes each); an incomplete
+            // log at the end of the buffer is ignored
+            std::vector<fw_log_data> parse_fw_logs(const uint8_t* buffer, size_t size);
+
 
         private:
-            fw_log_data fill_log_data(const fw_logs_binary_data* fw_log_msg);
+            struct compiled_event
+            {
+                size_t num_of_params;
+                fw_compiled_format format;
+            };
+
+            fw_log_data parse_fw_log(const fw_log_binary* log_binary);
+            fw_log_data fill_log_data(const fw_log_binary* log_binary);
 
             fw_logs_formating_options _fw_logs_formating_options;
+            fw_string_formatter _formatter;
+            std::unordered_map<int, compiled_event> _events;  // compiled once from the XML
             uint64_t _last_timestamp;
             const double _timestamp_factor;
         };
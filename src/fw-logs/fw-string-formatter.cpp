@@ -2,9 +2,10 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 #include "fw-string-formatter.h"
 #include "fw-logs-formating-options.h"
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
 #include <sstream>
-#include <iomanip>
 #include <iostream>
 
 using namespace std;
@@ -23,115 +24,138 @@ namespace librealsense
         {
         }
 
-        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest)
+        // Parses the parameter that starts at source[pos] == '{', returning its length or 0 if it is not one
+        static size_t parse_param(const string& source, size_t pos, fw_compiled_format::token* token)
         {
-            map<string, string> exp_replace_map;
-            map<string, int> enum_replace_map;
-
-            if (params == nullptr && num_of_params > 0) return false;
-
-            for (size_t i = 0; i < num_of_params; i++)
+            size_t i = pos + 1;
+            size_t param = 0;
+            auto const digits_start = i;
+            while (i < source.size() && isdigit(static_cast<unsigned char>(source[i])))
+                param = param * 10 + (source[i++] - '0');
+            if (i == digits_start || i == source.size())
+                return 0;
+
+            token->param = param;
+            if (source[i] == '}')
+                token->type = fw_compiled_format::decimal;
+            else if (source.compare(i, 3, ":x}") == 0)
             {
-                string regular_exp[4];
-                string replacement[4];
-                stringstream st_regular_exp[4];
-                stringstream st_replacement[4];
-
-                st_regular_exp[0] << "\\{\\b(" << i << ")\\}";
-                regular_exp[0] = st_regular_exp[0].str();
-
-                st_replacement[0] << params[i];
-                replacement[0] = st_replacement[0].str();
-
-                exp_replace_map[regular_exp[0]] = replacement[0];
-
-
-                st_regular_exp[1] << "\\{\\b(" << i << "):x\\}";
-                regular_exp[1] = st_regular_exp[1].str();
-
-                st_replacement[1] << hex << setw(2) << setfill('0') << params[i];
-                replacement[1] = st_replacement[1].str();
-
-                exp_replace_map[regular_exp[1]] = replacement[1];
-
-                st_regular_exp[2] << "\\{\\b(" << i << "):f\\}";
-                regular_exp[2] = st_regular_exp[2].str();
-                st_replacement[2] << params[i];
-                replacement[2] = st_replacement[2].str();
-                exp_replace_map[regular_exp[2]] = replacement[2];
-
-
-                st_regular_exp[3] << "\\{\\b(" << i << "),[a-zA-Z]+\\}";
-                regular_exp[3] = st_regular_exp[3].str();
-
-                enum_replace_map[regular_exp[3]] = params[i];
+                token->type = fw_compiled_format::hex;
+                i += 2;
+            }
+            else if (source.compare(i, 3, ":f}") == 0)
+            {
+                token->type = fw_compiled_format::decimal;
+                i += 2;
+            }
+            else if (source[i] == ',')
+            {
+                auto const name_start = ++i;
+                while (i < source.size() && isalpha(static_cast<unsigned char>(source[i])))
+                    ++i;
+                if (i == name_start || i == source.size() || source[i] != '}')
+                    return 0;
+                token->type = fw_compiled_format::enumerated;
+                token->enum_name = source.substr(name_start, i - name_start);
             }
+            else
+                return 0;
 
-            return replace_params(source, exp_replace_map, enum_replace_map, dest);
+            auto const length = i + 1 - pos;
+            token->text = source.substr(pos, length);
+            return length;
         }
 
-        bool fw_string_formatter::replace_params(const string& source, const map<string, string>& exp_replace_map, const map<string, int>& enum_replace_map, string* dest)
+        fw_compiled_format fw_string_formatter::compile(const string& source)
         {
-            string source_temp(source);
-
-            for (auto exp_replace_it = exp_replace_map.begin(); exp_replace_it != exp_replace_map.end(); exp_replace_it++)
+            fw_compiled_format format;
+            string text;
+            size_t pos = 0;
+            while (pos < source.size())
             {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                auto res = regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e, exp_replace_it->second);
-                source_temp = destTemp;
+                fw_compiled_format::token token;
+                size_t length = 0;
+                if (source[pos] == '{')
+                    length = parse_param(source, pos, &token);
+                if (!length)
+                {
+                    text += source[pos++];
+                    continue;
+                }
+                if (!text.empty())
+                {
+                    format.tokens.push_back({ fw_compiled_format::text, text, 0, "" });
+                    text.clear();
+                }
+                format.tokens.push_back(token);
+                pos += length;
             }
+            if (!text.empty())
+                format.tokens.push_back({ fw_compiled_format::text, text, 0, "" });
+            return format;
+        }
 
-            for (auto exp_replace_it = enum_replace_map.begin(); exp_replace_it != enum_replace_map.end(); exp_replace_it++)
-            {
-                string destTemp;
-                regex e(exp_replace_it->first);
-                std::smatch m;
-                std::regex_search(source_temp, m, std::regex(e));
-
-                string enum_name;
+        bool fw_string_formatter::generate_message(const string& source, size_t num_of_params, const uint32_t* params, string* dest) const
+        {
+            return generate_message(compile(source), num_of_params, params, dest);
+        }
 
-                string st_regular_exp = "[a-zA-Z]+";
-                regex e1(st_regular_exp);
+        bool fw_string_formatter::generate_message(const fw_compiled_format& format, size_t num_of_params, const uint32_t* params, string* dest) const
+        {
+            if (params == nullptr && num_of_params > 0) return false;
 
-                for (size_t exp = 0; exp < m.size(); exp++)
+            string message;
+            char buf[16];
+            for (auto& token : format.tokens)
+            {
+                // Parameters past the ones the event has are left as they are in the line
+                if (token.type == fw_compiled_format::text || token.param >= num_of_params)
                 {
-                    string str = m[exp];
-
-                    std::smatch m1;
-
-                    regex e2 = e1;
-                    std::regex_search(str, m1, std::regex(e2));
-
-                    for (size_t exp = 0; exp < m1.size(); exp++)
+                    message += token.text;
+                    continue;
+                }
+                auto const value = params[token.param];
+                switch (token.type)
+                {
+                case fw_compiled_format::decimal:
+                    snprintf(buf, sizeof(buf), "%u", value);
+                    message += buf;
+                    break;
+                case fw_compiled_format::hex:
+                    snprintf(buf, sizeof(buf), "%02x", value);
+                    message += buf;
+                    break;
+                case fw_compiled_format::enumerated:
+                {
+                    auto enum_it = _enums.find(token.enum_name);
+                    if (enum_it == _enums.end())
                     {
-                        enum_name = m1[exp];
-                        if (_enums.size() > 0 && _enums.find(enum_name) != _enums.end())
-                        {
-                            auto vec = _enums[enum_name];
-                            regex e3 = e;
-                            // Verify user's input is within the enumerated range
-                            int val = exp_replace_it->second;
-                            auto it = std::find_if(vec.begin(), vec.end(), [val](kvp& entry) { return entry.first == val; });
-                            if (it != vec.end())
-                            {
-                                regex_replace(back_inserter(destTemp), source_temp.begin(), source_temp.end(), e3, it->second);
-                            }
-                            else
-                            {
-                                stringstream s;
-                                s << "Protocol Error recognized!\nImproper log message received: " << source_temp
-                                    << ", invalid parameter: " << exp_replace_it->second << ".\n The range of supported values is \n";
-                                for_each(vec.begin(), vec.end(), [&s](kvp& entry) { s << entry.first << ":" << entry.second << " ,"; });
-                                std::cout << s.str().c_str() << std::endl;;
-                            }
-                            source_temp = destTemp;
-                        }
+                        message += token.text;
+                        break;
                     }
+                    auto& vec = enum_it->second;
+                    // Verify user's input is within the enumerated range
+                    int val = static_cast<int>(value);
+                    auto it = std::find_if(vec.begin(), vec.end(), [val](const kvp& entry) { return entry.first == val; });
+                    if (it != vec.end())
+                        message += it->second;
+                    else
+                    {
+                        stringstream s;
+                        s << "Protocol Error recognized!\nImproper log message received: " << token.text
+                            << ", invalid parameter: " << val << ".\n The range of supported values is \n";
+                        for_each(vec.begin(), vec.end(), [&s](const kvp& entry) { s << entry.first << ":" << entry.second << " ,"; });
+                        std::cout << s.str().c_str() << std::endl;
+                        message += token.text;
+                    }
+                    break;
+                }
+                default:
+                    break;
                 }
             }
 
-            *dest = source_temp;
+            *dest = std::move(message);
             return true;
         }
     }
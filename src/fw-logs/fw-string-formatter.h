@@ -11,17 +11,33 @@ namespace librealsense
 {
     namespace fw_logs
     {
+        // A format line split into its text and its parameters ({0}, {0:x}, {0:f}, {0,EnumName}), so
+        // a message can be generated without parsing the line again
+        struct fw_compiled_format
+        {
+            enum token_type { text, decimal, hex, enumerated };
+            struct token
+            {
+                token_type type;
+                std::string text;       // the text, or the parameter as it appears in the line
+                size_t param;           // index of the parameter
+                std::string enum_name;  // for enumerated parameters
+            };
+            std::vector<token> tokens;
+        };
+
         class fw_string_formatter
         {
         public:
             fw_string_formatter(std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> enums);
             ~fw_string_formatter(void);
 
-            bool generate_message(const std::string& source, size_t num_of_params, const uint32_t* params, std::string* dest);
+            static fw_compiled_format compile(const std::string& source);
 
-        private:
-            bool replace_params(const std::string& source, const std::map<std::string, std::string>& exp_replace_map, const std::map<std::string, int>& enum_replace_map, std::string* dest);
+            bool generate_message(const fw_compiled_format& format, size_t num_of_params, const uint32_t* params, std::string* dest) const;
+            bool generate_message(const std::string& source, size_t num_of_params, const uint32_t* params, std::string* dest) const;
 
+        private:
             std::unordered_map<std::string, std::vector<std::pair<int, std::string>>> _enums;
         };
     }
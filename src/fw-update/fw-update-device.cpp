@@ -13,6 +13,8 @@
 
 #define DEFAULT_TIMEOUT 100
 #define FW_UPDATE_INTERFACE_NUMBER 0
+#define DEFAULT_TRANSFER_SIZE 1024
+#define DFU_FUNCTIONAL_DESCRIPTOR 0x21
 namespace librealsense
 {
     std::string get_formatted_fw_version(uint32_t fw_last_version)
@@ -80,6 +82,7 @@ namespace librealsense
     bool update_device::wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout) const 
     {
         std::chrono::milliseconds elapsed_milliseconds;
+        std::chrono::milliseconds poll_interval(1);
         auto start = std::chrono::system_clock::now();
         do {
             dfu_status_payload status;
@@ -98,8 +101,10 @@ namespace librealsense
                 return false;
             }
 
-            // FW doesn't set the bwPollTimeout value, therefore it is wrong to use status.bwPollTimeout
-            std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_TIMEOUT));
+            // FW doesn't set the bwPollTimeout value, therefore it is wrong to use status.bwPollTimeout.
+            // A block is usually written within a few milliseconds, so we start polling fast and back off
+            std::this_thread::sleep_for(poll_interval);
+            poll_interval = std::min(poll_interval * 2, std::chrono::milliseconds(DEFAULT_TIMEOUT));
 
             auto curr = std::chrono::system_clock::now();
             elapsed_milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(curr - start);
@@ -119,6 +124,7 @@ namespace librealsense
                 detach(messenger);
 
             read_device_info(messenger);
+            _transfer_size = read_transfer_size();
         }
         else
         {
@@ -130,6 +136,21 @@ namespace librealsense
         }
     }
 
+    size_t update_device::read_transfer_size() const
+    {
+        // The DFU functional descriptor holds the largest block the bootloader accepts (wTransferSize)
+        for (auto&& desc : _usb_device->get_descriptors())
+        {
+            if (desc.type != DFU_FUNCTIONAL_DESCRIPTOR || desc.data.size() < 7)
+                continue;
+            size_t transfer_size = desc.data[5] | (desc.data[6] << 8);
+            LOG_DEBUG("DFU transfer size is: " << transfer_size);
+            // Blocks of the default size have always been accepted, even when less is advertised
+            return std::max(transfer_size, size_t(DEFAULT_TRANSFER_SIZE));
+        }
+        return DEFAULT_TRANSFER_SIZE;
+    }
+
     update_device::~update_device()
     {
 
@@ -139,10 +160,10 @@ namespace librealsense
     {
         auto messenger = _usb_device->open(FW_UPDATE_INTERFACE_NUMBER);
 
-        const size_t transfer_size = 1024;
+        const size_t transfer_size = _transfer_size;
 
         size_t remaining_bytes = fw_image_size;
-        uint16_t blocks_count = fw_image_size / transfer_size;
+        uint16_t blocks_count = uint16_t((fw_image_size + transfer_size - 1) / transfer_size);
         uint16_t block_number = 0;
 
         size_t offset = 0;
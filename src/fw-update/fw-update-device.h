@@ -143,6 +143,7 @@ namespace librealsense
         void detach(std::shared_ptr<platform::usb_messenger> messenger) const;
         bool wait_for_state(std::shared_ptr<platform::usb_messenger> messenger, const rs2_dfu_state state, size_t timeout = 1000) const;
         void read_device_info(std::shared_ptr<platform::usb_messenger> messenger);
+        size_t read_transfer_size() const;
 
 
         const std::shared_ptr<context> _context;
@@ -151,5 +152,6 @@ namespace librealsense
         std::string _highest_fw_version;
         std::string _last_fw_version;
         bool _is_dfu_locked = false;
+        size_t _transfer_size = 1024;  // bytes per DFU_DNLOAD block
     };
 }
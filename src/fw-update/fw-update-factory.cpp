@@ -7,20 +7,30 @@
 #include "ds5/ds5-private.h"
 #include "ds5/ds5-fw-update-device.h"
 #include "ivcam/sr300.h"
-#include "ivcam/sr300-fw-update-device.h"
 #include "l500/l500-private.h"
+
+#ifdef WITH_SR300
+#include "ivcam/sr300-fw-update-device.h"
+#endif
+
+#ifdef WITH_L500
 #include "l500/l500-fw-update-device.h"
+#endif
 
 namespace librealsense
 {
     int get_product_line(uint16_t pid, platform::usb_class cls)
     {
+#ifdef WITH_SR300
         if (SR300_RECOVERY == pid && platform::RS2_USB_CLASS_VENDOR_SPECIFIC == cls)
             return RS2_PRODUCT_LINE_SR300;
+#endif
         if(ds::RS_RECOVERY_PID == pid || ds::RS_USB2_RECOVERY_PID == pid)
             return RS2_PRODUCT_LINE_D400;
+#ifdef WITH_L500
         if (L500_RECOVERY_PID == pid)
             return RS2_PRODUCT_LINE_L500;
+#endif
         return 0;
     }
 
@@ -50,10 +60,14 @@ namespace librealsense
                     continue;
                 if (ds::RS_RECOVERY_PID == info.pid || ds::RS_USB2_RECOVERY_PID == info.pid)
                     return std::make_shared<ds_update_device>(ctx, register_device_notifications, usb);
+#ifdef WITH_SR300
                 if (SR300_RECOVERY == info.pid)
                     return std::make_shared<sr300_update_device>(ctx, register_device_notifications, usb);
+#endif
+#ifdef WITH_L500
                 if (L500_RECOVERY_PID == info.pid)
                     return std::make_shared<l500_update_device>(ctx, register_device_notifications, usb);
+#endif
             }
         }
         throw std::runtime_error(to_string() << "Failed to create FW update device, device id: " << _dfu.id);
@@ -84,6 +84,7 @@ void align_gl::align_z_to_other(rs2::video_frame& aligned,
     auto extr = prof.get_extrinsics_to(other_profile);
 
     render(p, depth, intr, extr, aligned_tex);
+    gf->get_gpu_section().start_readback();
 
     //aligned.get_data();
     aligned = _upload->process(aligned);
@@ -247,6 +248,7 @@ void align_gl::align_other_to_z(rs2::video_frame& aligned,
     auto intr = prof.as<video_stream_profile>().get_intrinsics();
     auto extr = prof.get_extrinsics_to(prof);
     render(p, other, intr, extr, output_rgb);
+    gf->get_gpu_section().start_readback();
 }
 
 align_gl::align_gl(rs2_stream to_stream) : align(to_stream, "Align (GLSL)")
@@ -51,6 +51,8 @@ namespace librealsense
                         uint32_t output_texture);
 
             rs2_extension select_extension(const rs2::frame& input) override;
+            bool supports_regions() const override { return false; }
+            bool deprojects_once() const override { return false; }
 
         private:
             int _enabled = 0;
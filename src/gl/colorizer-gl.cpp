@@ -335,6 +335,7 @@ namespace librealsense
                 glActiveTexture(GL_TEXTURE0 + shader.texture_slot());
 
                 _fbo->unbind();
+                gf->get_gpu_section().start_readback();
 
                 glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -565,6 +565,7 @@ void pointcloud_gl::get_texture_map(
         }
 
         glBindTexture(GL_TEXTURE_2D, 0);
+        gf->get_gpu_section().start_readback();
         if (!_depth_data.is<rs2::gl::gpu_frame>())
         {
             glDeleteTextures(1, &depth_texture);
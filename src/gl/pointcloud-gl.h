@@ -37,6 +37,8 @@ namespace librealsense
                 const rs2::frame& f) override;
 
             bool run__occlusion_filter(const rs2_extrinsics& extr) override;
+            bool supports_regions() const override { return false; }
+            bool supports_deferred_mapping() const override { return false; }
 
             std::shared_ptr<rs2::visualizer_2d> _projection_renderer;
             std::shared_ptr<rs2::visualizer_2d> _occu_renderer;
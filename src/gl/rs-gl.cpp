@@ -207,6 +207,13 @@ void rs2_gl_init_processing(int api_version, int use_glsl, rs2_error** error) BE
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, api_version, use_glsl)
 
+void rs2_gl_init_processing_headless(int api_version, int use_glsl, rs2_error** error) BEGIN_API_CALL
+{
+    verify_version_compatibility(api_version);
+    librealsense::gl::processing_lane::instance().init_headless(use_glsl > 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, api_version, use_glsl)
+
 void rs2_gl_init_processing_glfw(int api_version, GLFWwindow* share_with, 
                                  glfw_binding bindings, int use_glsl, rs2_error** error) BEGIN_API_CALL
 {
@@ -14,6 +14,10 @@
 
 #include <glad/glad.h>
 
+#ifdef RS2_GL_EGL
+#include <EGL/egl.h>
+#endif
+
 #include <iostream>
 #include <future>
 
@@ -127,6 +131,20 @@ namespace librealsense
         }
 
         void processing_lane::init(GLFWwindow* share_with, glfw_binding binding, bool use_glsl)
+        {
+            init(std::make_shared<context>(share_with, binding), use_glsl);
+        }
+
+        void processing_lane::init_headless(bool use_glsl)
+        {
+#ifdef RS2_GL_EGL
+            init(std::make_shared<egl_context>(), use_glsl);
+#else
+            throw not_implemented_exception("Headless GL processing requires building with BUILD_GLSL_EGL");
+#endif
+        }
+
+        void processing_lane::init(std::shared_ptr<context> ctx, bool use_glsl)
         {
             std::lock_guard<std::mutex> lock(_data.mutex);
 
@@ -135,7 +153,7 @@ namespace librealsense
             _data.active = true;
             _data.use_glsl = use_glsl;
 
-            _ctx = std::make_shared<context>(share_with, binding);
+            _ctx = ctx;
             auto session = _ctx->begin_session();
 
             for (auto&& obj : _data.objs)
@@ -167,6 +185,22 @@ namespace librealsense
             _ctx.reset();
         }
 
+        void gpu_section::release_readback()
+        {
+            if (readback_fence)
+            {
+                glDeleteSync((GLsync)readback_fence);
+                readback_fence = nullptr;
+            }
+            if (readback_pbo)
+            {
+                glDeleteBuffers(1, &readback_pbo);
+                readback_pbo = 0;
+                readback_size = 0;
+            }
+            readback_pending = false;
+        }
+
         void gpu_section::cleanup_gpu_resources()
         {
             if (backup_content)
@@ -174,6 +208,7 @@ namespace librealsense
                 backup = std::unique_ptr<uint8_t[]>(new uint8_t[get_frame_size()]);
                 fetch_frame(backup.get());
             }
+            release_readback();
             for (int i = 0; i < MAX_TEXTURES; i++)
             {
                 if (textures[i])
@@ -222,6 +257,7 @@ namespace librealsense
             {
                 loaded[i] = false;
             }
+            readback_pending = false;
         }
 
         void gpu_section::on_unpublish()
@@ -230,6 +266,7 @@ namespace librealsense
             {
                 loaded[i] = false;
             }
+            readback_pending = false;
         }
 
         void gpu_section::output_texture(int id, uint32_t* tex, texture_type type)
@@ -274,8 +311,78 @@ namespace librealsense
             return res;
         }
 
+        // Reads the loaded textures to ptr, or to the offset ptr of the bound pixel pack buffer
+        void gpu_section::read_textures(uint8_t* ptr)
+        {
+            for (int i = 0; i < MAX_TEXTURES; i++)
+            if (textures[i] && loaded[i])
+            {
+                auto& vis = get_texture_visualizer();
+                //rs2::visualizer_2d vis;
+                rs2::fbo fbo(width, height);
+                uint32_t res;
+                glGenTextures(1, &res);
+                glBindTexture(GL_TEXTURE_2D, res);
+
+                auto textype = gl_format_mapping(types[i]);
+                if (textype.size)
+                    glTexImage2D(GL_TEXTURE_2D, 0, textype.internal_format, 
+                        width, height, 0, textype.gl_format, textype.data_type, nullptr);
+
+                glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, res, 0);
+
+                fbo.bind();
+                glViewport(0, 0, width, height);
+                glClearColor(0, 0, 0, 1);
+                glClear(GL_COLOR_BUFFER_BIT);
+                vis.draw_texture(textures[i]);
+                glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+                if (textype.size)
+                {
+                    glReadPixels(0, 0, width, height, textype.gl_format, textype.data_type, ptr);
+                    ptr += width * height * textype.size;
+                }
+                
+                glDeleteTextures(1, &res);
+                
+                fbo.unbind();
+            }
+        }
+
+        void gpu_section::start_readback()
+        {
+            if (preloaded || !read_by_cpu || !*this) return;
+
+            perform_gl_action([&]{
+                auto size = get_frame_size();
+                if (readback_fence)
+                {
+                    glDeleteSync((GLsync)readback_fence);
+                    readback_fence = nullptr;
+                }
+                if (!readback_pbo)
+                    glGenBuffers(1, &readback_pbo);
+
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, readback_pbo);
+                if (readback_size != size)
+                {
+                    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+                    readback_size = size;
+                }
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                read_textures(nullptr);
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+                readback_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                glFlush();
+                readback_pending = true;
+            }, []{});
+        }
+
         void gpu_section::fetch_frame(void* to)
         {
+            read_by_cpu = true;
             if (preloaded) return;
 
             ensure_init();
@@ -287,44 +394,29 @@ namespace librealsense
             if (need_to_fetch)
             {
                 perform_gl_action([&]{
-                    auto ptr = (uint8_t*)to;
-
-                    for (int i = 0; i < MAX_TEXTURES; i++)
-                    if (textures[i] && loaded[i])
+                    if (readback_pending)
                     {
-                        auto& vis = get_texture_visualizer();
-                        //rs2::visualizer_2d vis;
-                        rs2::fbo fbo(width, height);
-                        uint32_t res;
-                        glGenTextures(1, &res);
-                        glBindTexture(GL_TEXTURE_2D, res);
-
-                        auto textype = gl_format_mapping(types[i]);
-                        if (textype.size)
-                            glTexImage2D(GL_TEXTURE_2D, 0, textype.internal_format, 
-                                width, height, 0, textype.gl_format, textype.data_type, nullptr);
-
-                        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, res, 0);
-
-                        fbo.bind();
-                        glViewport(0, 0, width, height);
-                        glClearColor(0, 0, 0, 1);
-                        glClear(GL_COLOR_BUFFER_BIT);
-                        vis.draw_texture(textures[i]);
-                        glReadBuffer(GL_COLOR_ATTACHMENT0);
-
-                        if (textype.size)
+                        // The copy was queued when the frame was rendered, it is usually done by now
+                        while (glClientWaitSync((GLsync)readback_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {}
+                        glDeleteSync((GLsync)readback_fence);
+                        readback_fence = nullptr;
+                        readback_pending = false;
+
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback_pbo);
+                        auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, readback_size, GL_MAP_READ_BIT);
+                        if (data)
                         {
-                            glReadPixels(0, 0, width, height, textype.gl_format, textype.data_type, ptr);
-                            ptr += width * height * textype.size;
+                            memcpy(to, data, readback_size);
+                            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+                            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                            preloaded = true;
+                            return;
                         }
-                        
-                        glDeleteTextures(1, &res);
-                        
-                        fbo.unbind();
-
-                        preloaded = true;
+                        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
                     }
+
+                    read_textures((uint8_t*)to);
+                    preloaded = true;
                 }, [&]{
                     memcpy(to, backup.get(), get_frame_size());
                 });
@@ -375,7 +467,100 @@ namespace librealsense
         context::~context()
         {
             _vis.reset();
-            _binding.glfwDestroyWindow(_ctx);
+            if (_ctx)
+                _binding.glfwDestroyWindow(_ctx);
+        }
+
+#ifdef RS2_GL_EGL
+        egl_context::egl_context()
+        {
+            auto display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            EGLint major, minor;
+            if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+                throw std::runtime_error("Could not initialize EGL display!");
+
+            const EGLint config_attribs[] = {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+                EGL_NONE };
+            EGLConfig config;
+            EGLint count = 0;
+            if (!eglChooseConfig(display, config_attribs, &config, 1, &count) || count < 1 || !eglBindAPI(EGL_OPENGL_API))
+            {
+                eglTerminate(display);
+                throw std::runtime_error("EGL display does not support offscreen OpenGL!");
+            }
+
+            // The blocks render to their own framebuffers, the surface only exists to make the context current
+            const EGLint pbuffer_attribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+            auto surface = eglCreatePbufferSurface(display, config, pbuffer_attribs);
+            auto ctx = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+            if (surface == EGL_NO_SURFACE || ctx == EGL_NO_CONTEXT)
+            {
+                if (ctx != EGL_NO_CONTEXT) eglDestroyContext(display, ctx);
+                if (surface != EGL_NO_SURFACE) eglDestroySurface(display, surface);
+                eglTerminate(display);
+                throw std::runtime_error("Could not initialize offscreen EGL context!");
+            }
+            _display = display;
+            _surface = surface;
+            _context = ctx;
+
+            auto curr_display = eglGetCurrentDisplay();
+            auto curr_draw = eglGetCurrentSurface(EGL_DRAW);
+            auto curr_read = eglGetCurrentSurface(EGL_READ);
+            auto curr = eglGetCurrentContext();
+            eglMakeCurrent(display, surface, surface, ctx);
+
+            if (glShaderSource == nullptr)
+            {
+                gladLoadGLLoader((GLADloadproc)eglGetProcAddress);
+            }
+
+            _vis = std::make_shared<rs2::visualizer_2d>();
+
+            if (curr != EGL_NO_CONTEXT)
+                eglMakeCurrent(curr_display, curr_draw, curr_read, curr);
+            else
+                eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+
+        std::shared_ptr<void> egl_context::begin_session()
+        {
+            auto curr = eglGetCurrentContext();
+            if (curr == _context) return nullptr;
+
+            _lock.lock();
+
+            auto curr_display = eglGetCurrentDisplay();
+            auto curr_draw = eglGetCurrentSurface(EGL_DRAW);
+            auto curr_read = eglGetCurrentSurface(EGL_READ);
+            eglMakeCurrent(_display, _surface, _surface, _context);
+            auto me = std::static_pointer_cast<egl_context>(shared_from_this());
+            return std::shared_ptr<void>(nullptr, [curr, curr_display, curr_draw, curr_read, me](void*){
+                if (curr != EGL_NO_CONTEXT)
+                    eglMakeCurrent(curr_display, curr_draw, curr_read, curr);
+                else
+                    eglMakeCurrent(me->_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                me->_lock.unlock();
+            });
+        }
+
+        egl_context::~egl_context()
+        {
+            {
+                // The visualizer releases its GL objects, which needs the context
+                auto curr = eglGetCurrentContext();
+                if (curr != _context)
+                    eglMakeCurrent(_display, _surface, _surface, _context);
+                _vis.reset();
+                eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            }
+            eglDestroyContext(_display, _context);
+            eglDestroySurface(_display, _surface);
+            eglTerminate(_display);
         }
+#endif
     }
 }
@@ -124,19 +124,43 @@ namespace librealsense
         public:
             context(GLFWwindow* share_with, glfw_binding binding);
 
-            std::shared_ptr<void> begin_session();
+            virtual std::shared_ptr<void> begin_session();
 
-            ~context();
+            virtual ~context();
 
             rs2::visualizer_2d& get_texture_visualizer() { return *_vis; }
 
-        private:
+        protected:
+            context() = default;
+
             std::shared_ptr<rs2::visualizer_2d> _vis;
-            GLFWwindow* _ctx;
+
+        private:
+            GLFWwindow* _ctx = nullptr;
             glfw_binding _binding;
             std::recursive_mutex _lock;
         };
 
+#ifdef RS2_GL_EGL
+        // Offscreen EGL context, for the processing on machines without a display.
+        // It is not shared with any window, so the textures of its frames are only usable by the processing blocks
+        class egl_context : public context
+        {
+        public:
+            egl_context();
+
+            std::shared_ptr<void> begin_session() override;
+
+            ~egl_context();
+
+        private:
+            void* _display = nullptr;
+            void* _surface = nullptr;
+            void* _context = nullptr;
+            std::recursive_mutex _lock;
+        };
+#endif
+
         struct lane
         {
             std::unordered_set<gpu_object*> objs;
@@ -216,6 +240,9 @@ namespace librealsense
 
             void init(GLFWwindow* share_with, glfw_binding binding, bool use_glsl);
 
+            // Runs the processing on an offscreen EGL context, available when built with BUILD_GLSL_EGL
+            void init_headless(bool use_glsl);
+
             void shutdown();
 
             bool is_active() const { return _data.active; }
@@ -225,6 +252,8 @@ namespace librealsense
             }
             bool glsl_enabled() const { return _data.use_glsl; }
         private:
+            void init(std::shared_ptr<context> ctx, bool use_glsl);
+
             lane _data;
             std::shared_ptr<context> _ctx;
         };
@@ -351,6 +380,11 @@ namespace librealsense
             void on_unpublish();
             void fetch_frame(void* to);
 
+            // Called by the blocks once the output textures are rendered. When the earlier content of the section
+            // was read from the CPU, copies the textures to a pixel buffer behind a fence, for fetch_frame to map
+            // after the GPU caught up. Sections only consumed on the GPU are never read back
+            void start_readback();
+
             bool input_texture(int id, uint32_t* tex);
             void output_texture(int id, uint32_t* tex, texture_type type);
 
@@ -374,7 +408,14 @@ namespace librealsense
             bool preloaded = false;
             bool initialized = false;
             std::unique_ptr<uint8_t[]> backup;
+            bool read_by_cpu = false;
+            bool readback_pending = false;
+            uint32_t readback_pbo = 0;
+            int readback_size = 0;
+            void* readback_fence = nullptr;
             void ensure_init();
+            void read_textures(uint8_t* ptr);
+            void release_readback();
         };
 
         class gpu_addon_interface
@@ -53,6 +53,13 @@ namespace librealsense
 
         void upload::cleanup_gpu_resources()
         {
+            for (int i = 0; i < UPLOAD_BUFFERS; i++)
+            {
+                if (_pbos[i])
+                    glDeleteBuffers(1, &_pbos[i]);
+                _pbos[i] = 0;
+                _pbo_sizes[i] = 0;
+            }
             _enabled = false;
         }
         void upload::create_gpu_resources()
@@ -60,6 +67,40 @@ namespace librealsense
             _enabled = true;
         }
 
+        // Uploads a frame of two bytes per pixel, the raw YUYV and Z16 are converted by the shaders of the blocks that use them.
+        // The frame is copied to a pixel unpack buffer, so the driver transfers it to the texture without blocking the caller
+        void upload::upload_texture(uint32_t texture, int width, int height, const void* data)
+        {
+            auto size = width * height * 2;
+            auto& pbo = _pbos[_pbo_index];
+            auto& pbo_size = _pbo_sizes[_pbo_index];
+            _pbo_index = (_pbo_index + 1) % UPLOAD_BUFFERS;
+
+            if (!pbo)
+                glGenBuffers(1, &pbo);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+            if (pbo_size != size)
+            {
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+                pbo_size = size;
+            }
+
+            // Invalidating the buffer lets the driver hand out fresh storage while the older upload from it is still pending
+            const void* pixels = data;
+            if (auto ptr = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT))
+            {
+                memcpy(ptr, data, size);
+                if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+                    pixels = nullptr; // offset in the bound buffer
+            }
+            if (pixels)
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, pixels);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
         rs2::frame upload::process_frame(const rs2::frame_source& source, const rs2::frame& f)
         {
             auto res = f;
@@ -80,8 +121,7 @@ namespace librealsense
 
                         uint32_t output_yuv;
                         gf->get_gpu_section().output_texture(0, &output_yuv, TEXTYPE_UINT16);
-                        glBindTexture(GL_TEXTURE_2D, output_yuv);
-                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, f.get_data());
+                        upload_texture(output_yuv, width, height, f.get_data());
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
                         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
@@ -130,8 +170,7 @@ namespace librealsense
 
                             uint32_t depth_texture;
                             gf->get_gpu_section().output_texture(0, &depth_texture, TEXTYPE_UINT16);
-                            glBindTexture(GL_TEXTURE_2D, depth_texture);
-                            glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, width, height, 0, GL_RG, GL_UNSIGNED_BYTE, f.get_data());
+                            upload_texture(depth_texture, width, height, depth_data);
                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
                             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
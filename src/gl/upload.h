@@ -35,6 +35,14 @@ namespace librealsense
 
             rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
         private:
+            void upload_texture(uint32_t texture, int width, int height, const void* data);
+
+            // Pixel unpack buffers the frames are copied to, used in turn so the copy of a frame does not wait for the upload of the previous one
+            static const int UPLOAD_BUFFERS = 3;
+            uint32_t _pbos[UPLOAD_BUFFERS] = {};
+            int _pbo_sizes[UPLOAD_BUFFERS] = {};
+            int _pbo_index = 0;
+
             std::vector<int> _hist;
             std::vector<float> _fhist;
             int* _hist_data;
@@ -197,6 +197,7 @@ rs2::frame yuy2rgb::process_frame(const rs2::frame_source& src, const rs2::frame
         _viz->draw_texture(yuy_texture);
 
         _fbo->unbind();
+        gf->get_gpu_section().start_readback();
 
         glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -7,6 +7,18 @@ using namespace std::chrono;
 
 namespace librealsense
 {
+    static const double max_device_time(pow(2, 32) * TIMESTAMP_USEC_TO_MSEC);
+
+    // The device clock wraps around, x is moved by a whole period when it is on the other side of the wrap than reference
+    static double unwrap(double x, double reference)
+    {
+        if ((reference - x) > max_device_time / 2)
+            return x + max_device_time;
+        if ((x - reference) > max_device_time / 2)
+            return x - max_device_time;
+        return x;
+    }
+
     CSample& CSample::operator-=(const CSample& other)
     {
         _x -= other._x;
@@ -117,16 +129,69 @@ namespace librealsense
 
     double CLinearCoefficients::calc_value(double x) const
     {
-        double a, b;
-        get_a_b(x, a, b);
-        double y(a * (x - _base_sample._x) + b + _base_sample._y);
-        LOG_DEBUG(__FUNCTION__ << ": " << x << " -> " << y << " with coefs:" << a << ", " << b << ", " << _base_sample._x << ", " << _base_sample._y);
+        return snapshot().calc_value(x);
+    }
+
+    linear_coefs_snapshot CLinearCoefficients::snapshot() const
+    {
+        linear_coefs_snapshot res;
+        res.last_x = _last_values.empty() ? _base_sample._x : _last_values.front()._x;
+        res.base_x = _base_sample._x;
+        res.base_y = _base_sample._y;
+        res.prev_a = _prev_a;
+        res.prev_b = _prev_b;
+        res.dest_a = _dest_a;
+        res.dest_b = _dest_b;
+        res.prev_time = _prev_time;
+        res.time_span_ms = _time_span_ms;
+        return res;
+    }
+
+    double linear_coefs_snapshot::calc_value(double x) const
+    {
+        // Same as moving the samples base past the wrap, as update_samples_base does, without modifying the coefficients
+        x = unwrap(x, last_x);
+        double a(dest_a), b(dest_b);
+        if (x - prev_time < time_span_ms)
+        {
+            double dt((x - prev_time) / time_span_ms);
+            a = dest_a * dt + prev_a * (1 - dt);
+            b = dest_b * dt + prev_b * (1 - dt);
+        }
+        double y(a * (x - base_x) + b + base_y);
+        LOG_DEBUG(__FUNCTION__ << ": " << x << " -> " << y << " with coefs:" << a << ", " << b << ", " << base_x << ", " << base_y);
         return y;
     }
 
+    void coefs_seqlock::store(const linear_coefs_snapshot& coefs)
+    {
+        auto values = reinterpret_cast<const double*>(&coefs);
+        auto seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < SIZE; i++)
+            _values[i].store(values[i], std::memory_order_relaxed);
+        _seq.store(seq + 2, std::memory_order_release);
+    }
+
+    linear_coefs_snapshot coefs_seqlock::load() const
+    {
+        linear_coefs_snapshot coefs;
+        auto values = reinterpret_cast<double*>(&coefs);
+        unsigned before, after;
+        do
+        {
+            before = _seq.load(std::memory_order_acquire);
+            for (size_t i = 0; i < SIZE; i++)
+                values[i] = _values[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _seq.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return coefs;
+    }
+
     bool CLinearCoefficients::update_samples_base(double x)
     {
-        static const double max_device_time(pow(2, 32) * TIMESTAMP_USEC_TO_MSEC);
         double base_x;
         if (_last_values.empty())
             return false;
@@ -160,11 +225,16 @@ namespace librealsense
         _coefs(15),
         _users_count(0),
         _is_ready(false),
+        _last_frame_hw_time(0),
         _min_command_delay(1000),
-        _active_object([this](dispatcher::cancellable_timer cancellable_timer)
-            {
-                polling(cancellable_timer);
-            })
+        _from_metadata_option(std::make_shared<global_time_from_metadata_option>()),
+        _from_metadata(false),
+        _has_frame_sample(false),
+        _frame_sample(0, 0),
+        _frame_interval_start(0),
+        _wheel(timer_wheel::get_shared(thread_policy_hook(RS2_THREAD_ROLE_MONITORING))),
+        _timer(0),
+        _dispatcher(1, thread_policy_hook(RS2_THREAD_ROLE_MONITORING))
     {
         //LOG_DEBUG("start new time_diff_keeper ");
     }
@@ -172,9 +242,17 @@ namespace librealsense
     void time_diff_keeper::start()
     {
         std::lock_guard<std::recursive_mutex> lock(_enable_mtx);
-        _users_count++;
+        if (_users_count++ == 0)
+            _from_metadata = _from_metadata_option->is_true();
         LOG_DEBUG("time_diff_keeper::start: _users_count = " << _users_count);
-        _active_object.start();
+        if (!_from_metadata && !_timer)
+        {
+            _dispatcher.start();
+            _timer = _wheel->add(0, _poll_intervals_ms, [this]()
+            {
+                _dispatcher.invoke([this](dispatcher::cancellable_timer) { polling(); });
+            });
+        }
     }
 
     void time_diff_keeper::stop()
@@ -188,15 +266,24 @@ namespace librealsense
         if (_users_count == 0)
         {
             LOG_DEBUG("time_diff_keeper::stop: stop object.");
-            _active_object.stop();
+            if (_timer)
+                _wheel->remove(_timer);
+            _timer = 0;
+            _dispatcher.stop();
+            std::lock_guard<std::recursive_mutex> read_lock(_read_mtx);
             _coefs.reset();
             _is_ready = false;
+            _last_frame_hw_time = 0;
+            std::lock_guard<std::mutex> sample_lock(_frame_sample_mtx);
+            _has_frame_sample = false;
         }
     }
 
     time_diff_keeper::~time_diff_keeper()
     {
-        _active_object.stop();
+        if (_timer)
+            _wheel->remove(_timer);
+        _dispatcher.stop();
     }
 
     bool time_diff_keeper::update_diff_time()
@@ -216,14 +303,7 @@ namespace librealsense
                 _coefs.add_const_y_coefs(command_delay - _min_command_delay);
                 _min_command_delay = command_delay;
             }
-            double system_time(system_time_finish - _min_command_delay);
-            if (_is_ready)
-            {
-                _coefs.update_samples_base(sample_hw_time);
-            }
-            CSample crnt_sample(sample_hw_time, system_time);
-            _coefs.add_value(crnt_sample);
-            _is_ready = true;
+            add_sample(sample_hw_time, system_time_finish - _min_command_delay);
             return true;
         }
         catch (const io_exception& ex)
@@ -245,28 +325,62 @@ namespace librealsense
         return false;
     }
 
-    void time_diff_keeper::polling(dispatcher::cancellable_timer cancellable_timer)
+    void time_diff_keeper::add_sample(double hw_time, double system_time)
     {
-        update_diff_time();
-        unsigned int time_to_sleep = _poll_intervals_ms + _coefs.is_full() * (9 * _poll_intervals_ms);
-        if (!cancellable_timer.try_sleep(time_to_sleep))
+        std::lock_guard<std::recursive_mutex> lock(_read_mtx);
+        if (_is_ready)
         {
-            LOG_DEBUG("Notification: time_diff_keeper polling loop is being shut-down");
+            _coefs.update_samples_base(hw_time);
+            // The readers only publish the time of the latest frame, the coefficients blend towards the new ones from it
+            double last_frame_hw_time = _last_frame_hw_time;
+            if (last_frame_hw_time)
+                _coefs.update_last_sample_time(unwrap(last_frame_hw_time, hw_time));
         }
+        CSample crnt_sample(hw_time, system_time);
+        _coefs.add_value(crnt_sample);
+        _published.store(_coefs.snapshot());
+        _is_ready = true;
     }
 
-    double time_diff_keeper::get_system_hw_time(double crnt_hw_time, bool& is_ready)
+    void time_diff_keeper::add_frame_sample(double hw_time, double system_time)
     {
-        std::lock_guard<std::recursive_mutex> lock(_read_mtx);
-        is_ready = _is_ready;
-        if (_is_ready)
+        // Never waits on the frame callbacks of the other streams, their frames give the samples then
+        std::unique_lock<std::mutex> lock(_frame_sample_mtx, std::try_to_lock);
+        if (!lock.owns_lock())
+            return;
+
+        // A frame arrives a transfer time after its timestamp, the shortest transfer of an interval is the closest to the device clock
+        if (!_has_frame_sample)
         {
-            _coefs.update_samples_base(crnt_hw_time);
-            _coefs.update_last_sample_time(crnt_hw_time);
-            return _coefs.calc_value(crnt_hw_time);
+            _has_frame_sample = true;
+            _frame_sample = CSample(hw_time, system_time);
+            _frame_interval_start = system_time;
         }
-        else
+        else if (system_time - hw_time < _frame_sample._y - _frame_sample._x)
+            _frame_sample = CSample(hw_time, system_time);
+
+        unsigned int interval = _poll_intervals_ms + _coefs.is_full() * (9 * _poll_intervals_ms);
+        if (system_time - _frame_interval_start < interval)
+            return;
+        add_sample(_frame_sample._x, _frame_sample._y);
+        _has_frame_sample = false;
+    }
+
+    void time_diff_keeper::polling()
+    {
+        update_diff_time();
+        // Sampled ten times less often once the regression window is full
+        unsigned int time_to_sleep = _poll_intervals_ms + _coefs.is_full() * (9 * _poll_intervals_ms);
+        _wheel->set_period(_timer, time_to_sleep);
+    }
+
+    double time_diff_keeper::get_system_hw_time(double crnt_hw_time, bool& is_ready)
+    {
+        is_ready = _is_ready;
+        if (!is_ready)
             return crnt_hw_time;
+        _last_frame_hw_time = crnt_hw_time;
+        return _published.load().calc_value(crnt_hw_time);
     }
 
     global_timestamp_reader::global_timestamp_reader(std::unique_ptr<frame_timestamp_reader> device_timestamp_reader,
@@ -287,7 +401,11 @@ namespace librealsense
         {
             auto sp = _time_diff_keeper.lock();
             if (sp)
+            {
+                if (sp->is_from_metadata())
+                    sp->add_frame_sample(frame_time, frame->get_frame_system_time());
                 frame_time = sp->get_system_hw_time(frame_time, _ts_is_ready);
+            }
             else
                 LOG_DEBUG("Notification: global_timestamp_reader - time_diff_keeper is being shut-down");
         }
@@ -6,6 +6,7 @@
 #include "sensor.h"
 #include "error-handling.h"
 #include <deque>
+#include <atomic>
 
 namespace librealsense
 {
@@ -17,6 +18,16 @@ namespace librealsense
         const char* get_description() const override { return "Enable/Disable global timestamp."; }
     };
 
+    class LRS_EXTENSION_API global_time_from_metadata_option : public bool_option
+    {
+    public:
+        global_time_from_metadata_option() : bool_option(false) {}
+        const char* get_description() const override
+        {
+            return "Derive the global timestamps from the frame timestamps and arrival times instead of polling the device clock. Applied when streaming starts";
+        }
+    };
+
     class CSample
     {
     public:
@@ -30,6 +41,33 @@ namespace librealsense
         double _y;
     };
 
+    // The regression a device time is converted with, copied out of CLinearCoefficients for the readers
+    struct linear_coefs_snapshot
+    {
+        double last_x;      // Device time of the most recent sample, the converted times are unwrapped around it
+        double base_x, base_y;
+        double prev_a, prev_b;
+        double dest_a, dest_b;
+        double prev_time, time_span_ms;
+
+        double calc_value(double x) const;
+    };
+
+    // Publishes the snapshots of a single writer to lock-free readers: a reader copies the snapshot again
+    // when the writer published while it was copying
+    class coefs_seqlock
+    {
+    public:
+        coefs_seqlock() : _seq(0) {}
+        void store(const linear_coefs_snapshot& coefs);
+        linear_coefs_snapshot load() const;
+
+    private:
+        static const size_t SIZE = sizeof(linear_coefs_snapshot) / sizeof(double);
+        std::atomic<unsigned> _seq;
+        std::atomic<double> _values[SIZE];
+    };
+
     class CLinearCoefficients
     {
     public:
@@ -41,6 +79,7 @@ namespace librealsense
         void update_last_sample_time(double x);
         double calc_value(double x) const;
         bool is_full() const;
+        linear_coefs_snapshot snapshot() const;
 
     private:
         void calc_linear_coefs();
@@ -65,22 +104,41 @@ namespace librealsense
         void start();   // must be called AFTER ALL initializations of _hw_monitor.
         void stop();
         ~time_diff_keeper();
+
+        // Lock-free, converts with the coefficients last published by the polling thread or the frame samples
         double get_system_hw_time(double crnt_hw_time, bool& is_ready);
 
+        // When the mapping is derived from the frames, the samples are taken from the frames of the shortest transfer
+        bool is_from_metadata() const { return _from_metadata; }
+        void add_frame_sample(double hw_time, double system_time);
+        std::shared_ptr<global_time_from_metadata_option> get_from_metadata_option() const { return _from_metadata_option; }
+
     private:
         bool update_diff_time();
-        void polling(dispatcher::cancellable_timer cancellable_timer);
+        void add_sample(double hw_time, double system_time);
+        void polling();
 
     private:
         global_time_interface* _device;
         unsigned int _poll_intervals_ms;
         int             _users_count;
-        active_object<> _active_object;
-        mutable std::recursive_mutex _read_mtx; // Watch only 1 reader at a time.
+        std::shared_ptr<timer_wheel> _wheel; // Times the polls of the device clock
+        std::atomic<timer_wheel::timer_id> _timer;
+        dispatcher _dispatcher; // Polls the device clock, off the thread of the wheel
+        mutable std::recursive_mutex _read_mtx; // Watch only 1 writer at a time.
         mutable std::recursive_mutex _enable_mtx; // Watch only 1 start/stop operation at a time.
         CLinearCoefficients _coefs;
+        coefs_seqlock _published;
         double _min_command_delay;
-        bool _is_ready;
+        std::atomic<bool> _is_ready;
+        std::atomic<double> _last_frame_hw_time;
+
+        std::shared_ptr<global_time_from_metadata_option> _from_metadata_option;
+        std::atomic<bool> _from_metadata;
+        std::mutex _frame_sample_mtx;
+        bool _has_frame_sample;
+        CSample _frame_sample;
+        double _frame_interval_start;
     };
 
     class global_timestamp_reader : public frame_timestamp_reader
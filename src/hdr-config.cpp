@@ -7,10 +7,11 @@
 namespace librealsense
 {
     hdr_config::hdr_config(hw_monitor& hwm, std::shared_ptr<sensor_base> depth_ep,
-        const option_range& exposure_range, const option_range& gain_range) :
+        std::function<option_range()> exposure_range, std::function<option_range()> gain_range) :
         _hwm(hwm),
         _sensor(depth_ep),
         _is_enabled(false),
+        _is_enabled_known(false),
         _is_config_in_process(false),
         _has_config_changed(false),
         _current_hdr_sequence_index(DEFAULT_CURRENT_HDR_SEQUENCE_INDEX),
@@ -18,14 +19,18 @@ namespace librealsense
         _emitter_on_off_to_be_restored(false),
         _id(DEFAULT_HDR_ID),
         _sequence_size(DEFAULT_HDR_SEQUENCE_SIZE),
-        _exposure_range(exposure_range),
-        _gain_range(gain_range),
+        _exposure_range(std::move(exposure_range)),
+        _gain_range(std::move(gain_range)),
         _use_workaround(true),
-        _pre_hdr_exposure(0.f)
+        _pre_hdr_exposure(0.f),
+        _sequence_params_initialized([this]() { return init_sequence_params(); })
     {
         _hdr_sequence_params.clear();
         _hdr_sequence_params.resize(DEFAULT_HDR_SEQUENCE_SIZE);
+    }
 
+    bool hdr_config::init_sequence_params()
+    {
         // restoring current HDR configuration if such subpreset is active
         command cmd(ds::GETSUBPRESET);
         bool existing_subpreset_restored = false;
@@ -43,16 +48,17 @@ namespace librealsense
         if (!existing_subpreset_restored)
         {
             // setting default config
-            float exposure_default_value = _exposure_range.def-1000.f; // D455 W/A
-            float gain_default_value = _gain_range.def;
+            float exposure_default_value = _exposure_range->def-1000.f; // D455 W/A
+            float gain_default_value = _gain_range->def;
             hdr_params params_0(0, exposure_default_value, gain_default_value);
             _hdr_sequence_params[0] = params_0;
 
-            float exposure_low_value = _exposure_range.min;
-            float gain_min_value = _gain_range.min;
+            float exposure_low_value = _exposure_range->min;
+            float gain_min_value = _gain_range->min;
             hdr_params params_1(1, exposure_low_value, gain_min_value);
             _hdr_sequence_params[1] = params_1;
         }
+        return true;
     }
 
     bool hdr_config::is_current_subpreset_hdr(const std::vector<byte>& current_subpreset) const
@@ -128,6 +134,8 @@ namespace librealsense
 
     float hdr_config::get(rs2_option option) const
     {
+        *_sequence_params_initialized;
+
         float rv = 0.f;
         switch (option)
         {
@@ -171,6 +179,8 @@ namespace librealsense
 
     void hdr_config::set(rs2_option option, float value, option_range range)
     {
+        *_sequence_params_initialized;
+
         if (value < range.min || value > range.max)
             throw invalid_value_exception(to_string() << "hdr_config::set(...) failed! value: " << value <<
                 " is out of the option range: [" << range.min << ", " << range.max << "].");
@@ -199,10 +209,12 @@ namespace librealsense
             throw invalid_value_exception("option is not an HDR option");
         }
 
-        // subpreset configuration change is immediately sent to firmware if HDR is already running
-        if (_is_enabled && _has_config_changed)
+        // subpreset configuration change is sent to firmware if HDR is already running, as a single command once
+        // the whole sequence is configured: the changes made while a sequence index is selected are sent when it returns to 0
+        if (_is_enabled && _has_config_changed && !_is_config_in_process)
         {
-            send_sub_preset_to_fw();
+            if (send_sub_preset_to_fw())
+                _has_config_changed = false;
         }
     }
 
@@ -213,8 +225,9 @@ namespace librealsense
 
     bool hdr_config::is_enabled() const
     {
-        // status in the firmware must be checked in case this is a new instance but the HDR in enabled in firmware
-        if (!_is_enabled)
+        // status in the firmware must be checked in case this is a new instance but the HDR in enabled in firmware,
+        // afterwards this instance is the one enabling and disabling it
+        if (!_is_enabled_known)
         {
             float rv = 0.f;
             command cmd(ds::GETSUBPRESETID);
@@ -231,6 +244,7 @@ namespace librealsense
             }
 
             _is_enabled = (rv == 1.f);
+            _is_enabled_known = true;
         }
 
         return _is_enabled;
@@ -238,9 +252,16 @@ namespace librealsense
 
     void hdr_config::set_enable_status(float value)
     {
+        _is_enabled_known = true;
         if (value)
         {
-            if (validate_config())
+            // already enabled, e.g. when the stream restarts: the options were already saved, the sub-preset is only sent again
+            if (_is_enabled)
+            {
+                _is_enabled = send_sub_preset_to_fw();
+                _has_config_changed = !_is_enabled;
+            }
+            else if (validate_config())
             {
                 // saving status of options that are not compatible with hdr,
                 // so that they could be reenabled after hdr disable
@@ -275,7 +296,7 @@ namespace librealsense
             {
                 // this sleep is needed to let the fw restore the manual exposure
                 std::this_thread::sleep_for(std::chrono::milliseconds(70));
-                if (_pre_hdr_exposure >= _exposure_range.min && _pre_hdr_exposure <= _exposure_range.max)
+                if (_pre_hdr_exposure >= _exposure_range->min && _pre_hdr_exposure <= _exposure_range->max)
                 {
                     try {
                         // the following statement is needed in order to get the UVC exposure 
@@ -445,7 +466,15 @@ namespace librealsense
 
         if (new_id != _id)
         {
+            _sequences_by_id[_id] = _hdr_sequence_params;
+            auto it = _sequences_by_id.find(new_id);
+            if (it != _sequences_by_id.end())
+            {
+                _hdr_sequence_params = it->second;
+                _sequence_size = _hdr_sequence_params.size();
+            }
             _id = new_id;
+            _has_config_changed = true;
         }
     }
 
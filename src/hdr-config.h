@@ -4,6 +4,7 @@ Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
 
 #pragma once
 
+#include <map>
 #include <vector>
 #include "hw-monitor.h"
 
@@ -30,8 +31,9 @@ namespace librealsense
     class hdr_config
     {
     public:
+        // The ranges and the sequence configured in the firmware are queried on the first use of HDR, not at device construction
         hdr_config(hw_monitor& hwm, std::shared_ptr<sensor_base> depth_ep,
-            const option_range& exposure_range, const option_range& gain_range);
+            std::function<option_range()> exposure_range, std::function<option_range()> gain_range);
 
 
         float get(rs2_option option) const;
@@ -41,6 +43,7 @@ namespace librealsense
         bool is_enabled() const;
 
     private:
+        bool init_sequence_params();
         bool is_hdr_id(int id) const;
         bool is_current_subpreset_hdr(const std::vector<byte>& current_subpreset) const;
         bool configure_hdr_as_in_fw(const std::vector<byte>& current_subpreset);
@@ -75,18 +78,22 @@ namespace librealsense
         int _id;
         size_t _sequence_size;
         std::vector<hdr_params> _hdr_sequence_params;
+        // The sequences configured under the other ids, selecting an id while HDR streams switches to its sequence in a single command
+        std::map<int, std::vector<hdr_params>> _sequences_by_id;
         int _current_hdr_sequence_index;
         mutable bool _is_enabled;
+        mutable bool _is_enabled_known;
         bool _is_config_in_process;
         bool _has_config_changed;
         bool _auto_exposure_to_be_restored;
         bool _emitter_on_off_to_be_restored;
         hw_monitor& _hwm;
         std::shared_ptr<sensor_base> _sensor;
-        option_range _exposure_range;
-        option_range _gain_range;
+        lazy<option_range> _exposure_range;
+        lazy<option_range> _gain_range;
         bool _use_workaround;
         float _pre_hdr_exposure;
+        lazy<bool> _sequence_params_initialized;
     };
 
 }
@@ -173,6 +173,82 @@ namespace librealsense
             newCommand.receivedCommandData + newCommand.receivedCommandDataLength);
     }
 
+    std::shared_future<std::vector<uint8_t>> hw_monitor::enqueue(command cmd, bool coalesce, response_callback callback) const
+    {
+        auto key = std::make_tuple(cmd.cmd, cmd.param1, cmd.param2, cmd.param3, cmd.param4, cmd.data);
+        std::shared_ptr<pending_command> pending;
+        {
+            std::lock_guard<std::mutex> lock(_queue_mutex);
+            if (coalesce)
+            {
+                auto it = _queued_reads.find(key);
+                if (it != _queued_reads.end())
+                {
+                    if (callback)
+                        it->second->callbacks.push_back(std::move(callback));
+                    return it->second->future;
+                }
+            }
+
+            if (!_queue)
+            {
+                _queue.reset(new dispatcher(HW_MONITOR_QUEUE_SIZE, thread_policy_hook(RS2_THREAD_ROLE_CONTROL)));
+                _queue->start();
+            }
+
+            pending = std::make_shared<pending_command>();
+            pending->future = pending->promise.get_future().share();
+            if (callback)
+                pending->callbacks.push_back(std::move(callback));
+            if (coalesce)
+                _queued_reads[key] = pending;
+        }
+
+        // A full queue holds the caller rather than dropping a command that someone waits for
+        _queue->invoke([this, cmd, key, pending, coalesce](dispatcher::cancellable_timer)
+        {
+            // From here on an identical read is queued anew, so it returns a value read after it was issued
+            if (coalesce)
+            {
+                std::lock_guard<std::mutex> lock(_queue_mutex);
+                auto it = _queued_reads.find(key);
+                if (it != _queued_reads.end() && it->second == pending)
+                    _queued_reads.erase(it);
+            }
+
+            std::vector<uint8_t> response;
+            std::exception_ptr error;
+            try
+            {
+                response = send(cmd);
+                pending->promise.set_value(response);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+                pending->promise.set_exception(error);
+            }
+
+            for (auto&& callback : pending->callbacks)
+            {
+                try
+                {
+                    callback(response, error);
+                }
+                catch (const std::exception& ex)
+                {
+                    LOG_ERROR("hw_monitor callback of command 0x" << std::hex << unsigned(cmd.cmd) << std::dec << " failed: " << ex.what());
+                }
+                catch (...)
+                {
+                    LOG_ERROR("hw_monitor callback of command 0x" << std::hex << unsigned(cmd.cmd) << std::dec << " failed");
+                }
+            }
+        }, true);
+
+        return pending->future;
+    }
+
     std::string hwmon_error_string( command const & cmd, hwmon_response e )
     {
         auto str = hwmon_error2str( e );
@@ -5,6 +5,8 @@
 
 #include "sensor.h"
 #include <mutex>
+#include <future>
+#include <tuple>
 #include "command_transfer.h"
 
 namespace librealsense
@@ -41,6 +43,7 @@ namespace librealsense
     const uint16_t  HW_MONITOR_BUFFER_SIZE          = 1024;
     const uint16_t  HW_MONITOR_DATA_SIZE_OFFSET     = 1020;
     const uint16_t  SIZE_OF_HW_MONITOR_HEADER       = 4;
+    const uint16_t  HW_MONITOR_QUEUE_SIZE           = 64;
 
     class uvc_sensor;
 
@@ -210,11 +213,12 @@ namespace librealsense
             });
             if (!token.get()) throw;
 
-            std::lock_guard<std::recursive_mutex> lock(_local_mtx);
+            // The device lock is taken first, as by the batches of lock_controls() that send commands under it
             return _uvc_sensor_base.invoke_powered([&]
                 (platform::uvc_device& dev)
                 {
                     std::lock_guard<platform::uvc_device> lock(dev);
+                    std::lock_guard<std::recursive_mutex> local_lock(_local_mtx);
                     return _command_transfer->send_receive(data, timeout_ms, require_response);
                 });
         }
@@ -315,7 +319,27 @@ namespace librealsense
         static void update_cmd_details(hwmon_cmd_details& details, size_t receivedCmdLen, unsigned char* outputBuffer);
         void send_hw_monitor_command(hwmon_cmd_details& details) const;
 
+    public:
+        typedef std::function<void(const std::vector<uint8_t>& response, std::exception_ptr error)> response_callback;
+
+    private:
+        // A command waiting in the queue of the command thread, with the callers sharing its response
+        struct pending_command
+        {
+            std::promise<std::vector<uint8_t>> promise;
+            std::shared_future<std::vector<uint8_t>> future;
+            std::vector<response_callback> callbacks;
+        };
+        typedef std::tuple<uint8_t, int, int, int, int, std::vector<uint8_t>> command_key;
+
+        std::shared_future<std::vector<uint8_t>> enqueue(command cmd, bool coalesce, response_callback callback) const;
+
         std::shared_ptr<locked_transfer> _locked_transfer;
+
+        // The command thread is started by the first asynchronous command, and stopped before the transfer is released
+        mutable std::mutex _queue_mutex;
+        mutable std::map<command_key, std::shared_ptr<pending_command>> _queued_reads;
+        mutable std::unique_ptr<dispatcher> _queue;
     public:
         explicit hw_monitor(std::shared_ptr<locked_transfer> locked_transfer)
             : _locked_transfer(std::move(locked_transfer))
@@ -323,6 +347,24 @@ namespace librealsense
 
         std::vector<uint8_t> send(std::vector<uint8_t> data) const;
         std::vector<uint8_t> send( command cmd, hwmon_response * = nullptr, bool locked_transfer = false ) const;
+
+        /*
+            Queue the command on the command thread of the monitor and return without waiting for the device.
+            The commands are sent one at a time in the order they were queued, between the commands of the synchronous callers,
+            which only wait for the command in flight. With coalesce, the command is taken as a read: an identical command that
+            is still waiting in the queue is sent once and its response is shared, the callers polling the same value cost a single transfer.
+            Failures are thrown by the future, commands still queued when the monitor is released are abandoned (broken promise)
+        */
+        std::shared_future<std::vector<uint8_t>> send_async(command cmd, bool coalesce = false) const
+        {
+            return enqueue(std::move(cmd), coalesce, nullptr);
+        }
+
+        // Same, calling the callback from the command thread with the response or the error of the command
+        void send_async(command cmd, response_callback callback, bool coalesce = false) const
+        {
+            enqueue(std::move(cmd), coalesce, std::move(callback));
+        }
         void get_gvd(size_t sz, unsigned char* gvd, uint8_t gvd_cmd) const;
         static std::string get_firmware_version_string(const std::vector<uint8_t>& buff, size_t index, size_t length = 4);
         static std::string get_module_serial_string(const std::vector<uint8_t>& buff, size_t index, size_t length = 6);
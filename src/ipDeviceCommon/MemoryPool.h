@@ -5,94 +5,133 @@
 
 #include <ipDeviceCommon/RsCommon.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <iostream>
-#include <mutex>
-#include <queue>
 
 #include "NetdevLog.h"
 
-#define POOL_SIZE 100
-
+// Buffers are recycled through lock free free lists, one per power of two size class.
+// The free lists are shared by all the pools, so a buffer can be returned to another pool than the one it came from,
+// as the rtp streams do. Each buffer carries its size class in a header in front of the returned address.
+// A class keeps at most MAX_RETAINED_BYTES of free buffers, and the free buffers are released with the last pool
 class MemoryPool
 {
-
 public:
     MemoryPool()
     {
-        // //alloc memory
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // for(int i = 0; i < POOL_SIZE; i++)
-        // {
-        //     unsigned char *mem = new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; //TODO:to use OutPacketBuffer::maxSize;
-        //     m_pool.push(mem);
-        // }
-        // lk.unlock();
+        getPoolCount()++;
     }
 
-    MemoryPool(const MemoryPool& obj)
+    MemoryPool(const MemoryPool&) : MemoryPool() {}
+
+    ~MemoryPool()
     {
-        m_pool = obj.m_pool;
+        if(--getPoolCount() == 0)
+        {
+            for(int sizeClass = 0; sizeClass < SIZE_CLASSES; ++sizeClass)
+            {
+                for(auto& slot : getFreeList(sizeClass))
+                {
+                    delete[] slot.exchange(nullptr, std::memory_order_acquire);
+                }
+            }
+        }
     }
 
-    MemoryPool& operator=(const MemoryPool&& obj)
+    // Returns a buffer of at least t_size bytes, e.g. sizeof(RsFrameHeader) plus the image size of the stream profile
+    unsigned char* getNextMem(size_t t_size)
     {
-        m_pool = obj.m_pool;
-        return *this;
+        int sizeClass = getSizeClass(t_size);
+        if(sizeClass < SIZE_CLASSES)
+        {
+            for(auto& slot : getFreeList(sizeClass))
+            {
+                if(unsigned char* mem = slot.exchange(nullptr, std::memory_order_acquire))
+                {
+                    return mem + BUFFER_HEADER_SIZE;
+                }
+            }
+        }
+
+        size_t size = sizeClass < SIZE_CLASSES ? getClassSize(sizeClass) : t_size;
+        unsigned char* mem = new unsigned char[BUFFER_HEADER_SIZE + size];
+        *reinterpret_cast<int*>(mem) = sizeClass;
+        return mem + BUFFER_HEADER_SIZE;
     }
 
-    unsigned char* getNextMem()
+    void returnMem(unsigned char* t_mem)
     {
-        // unsigned char* mem = nullptr;
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // if(!m_pool.empty())
-        // {
-        //     mem = m_pool.front();
-        //     m_pool.pop();
-        // }
-        // else
-        // {
-        //     ERR << "getNextMem: pool is empty";
-        // }
-        // lk.unlock();
-        // return mem;
-        return new unsigned char[sizeof(RsFrameHeader) + MAX_FRAME_SIZE]; 
+        if(t_mem == nullptr)
+        {
+            ERR << "returnMem: invalid address";
+            return;
+        }
+
+        unsigned char* mem = t_mem - BUFFER_HEADER_SIZE;
+        int sizeClass = *reinterpret_cast<int*>(mem);
+        if(sizeClass < SIZE_CLASSES)
+        {
+            FreeList& freeList = getFreeList(sizeClass);
+            for(int i = 0; i < getFreeListSize(sizeClass); ++i)
+            {
+                auto& slot = freeList[i];
+                unsigned char* expected = nullptr;
+                if(slot.compare_exchange_strong(expected, mem, std::memory_order_release, std::memory_order_relaxed))
+                {
+                    return;
+                }
+            }
+        }
+        delete[] mem;
     }
 
-    void returnMem(unsigned char* t_mem)
+private:
+    // Keeps the returned addresses aligned for any type
+    static const size_t BUFFER_HEADER_SIZE = 16;
+    static const int MIN_CLASS_SHIFT = 16;
+    static const int SIZE_CLASSES = 12;
+    // Buffers kept per size class, enough for the frames queued by a stream
+    static const int FREE_LIST_SIZE = 16;
+    // Bytes kept per size class. A stream returns a buffer about as often as it takes one, so a few large buffers are enough
+    // to recycle the frames of a high resolution stream
+    static const size_t MAX_RETAINED_BYTES = size_t(16) << 20;
+
+    typedef std::atomic<unsigned char*> FreeList[FREE_LIST_SIZE];
+
+    static size_t getClassSize(int t_sizeClass)
     {
-        // if(t_mem != nullptr)
-        // {
-        //     std::unique_lock<std::mutex> lk(m_mutex);
-        //     m_pool.push(t_mem);
-        //     lk.unlock();
-        // }
-        // else
-        // {
-        //     ERR << "returnMem: invalid address";
-        // }
-        delete[] t_mem;
+        return size_t(1) << (MIN_CLASS_SHIFT + t_sizeClass);
     }
 
-    ~MemoryPool()
+    // Smallest size class holding t_size bytes, SIZE_CLASSES for buffers larger than all the classes
+    static int getSizeClass(size_t t_size)
     {
-        // std::unique_lock<std::mutex> lk(m_mutex);
-        // while(!m_pool.empty())
-        // {
-        //     unsigned char* mem = m_pool.front();
-        //     m_pool.pop();
-        //     if(mem != nullptr)
-        //     {
-        //         delete mem;
-        //     }
-        //     else
-        //     {
-        //         ERR << "~memory_pool: invalid address";
-        //     }
-        // }
-        // lk.unlock();
+        int sizeClass = 0;
+        while(sizeClass < SIZE_CLASSES && getClassSize(sizeClass) < t_size)
+        {
+            ++sizeClass;
+        }
+        return sizeClass;
     }
 
-private:
-    std::queue<unsigned char*> m_pool;
-    std::mutex m_mutex;
+    // Slots of the free list of the class that may hold a buffer, the others stay empty
+    static int getFreeListSize(int t_sizeClass)
+    {
+        size_t buffers = MAX_RETAINED_BYTES / getClassSize(t_sizeClass);
+        return int(std::max<size_t>(1, std::min<size_t>(FREE_LIST_SIZE, buffers)));
+    }
+
+    static std::atomic<int>& getPoolCount()
+    {
+        static std::atomic<int> poolCount(0);
+        return poolCount;
+    }
+
+    static FreeList& getFreeList(int t_sizeClass)
+    {
+        static FreeList freeLists[SIZE_CLASSES] = {};
+        return freeLists[t_sizeClass];
+    }
 };
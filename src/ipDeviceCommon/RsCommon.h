@@ -17,15 +17,24 @@ union RsNetworkHeader { //IMPORTANT:: RsNetworkHeader should be alligned to 16 b
 };
 
 union RsMetadataHeader { //IMPORTANT:: RsNetworkHeader should be alligned to 16 bytes, this enables frame data to start on 16 bit alligned address
-    char maxHeaderSize[128];
+    char maxHeaderSize[512];
     struct 
     {
         double timestamp;
         long long frameCounter;
         int actualFps;
         rs2_timestamp_domain timestampDomain;
+        // set by the server source when the frame is sent: the system time in milliseconds and the frame count of the stream,
+        // the client measures the latency and the lost frames from them
+        double sendTime;
+        uint32_t sequenceNumber;
+        // metadata of the frame on the server, bit i of the mask is set when the value of the rs2_frame_metadata_value i is sent
+        uint64_t metadataMask;
+        long long metadata[RS2_FRAME_METADATA_COUNT];
     } data;
 }; 
+static_assert(RS2_FRAME_METADATA_COUNT <= 64, "the metadata mask of RsMetadataHeader holds 64 values");
+static_assert(sizeof(((RsMetadataHeader*)0)->data) <= sizeof(RsMetadataHeader), "the metadata values do not fit in RsMetadataHeader");
 
 struct RsFrameHeader
 {
@@ -33,6 +42,14 @@ struct RsFrameHeader
     RsMetadataHeader metadataHeader;
 };
 
+// Motion streams are sent in batches of samples, the frame of a batch is an array of RsImuSample
+struct RsImuSample
+{
+    double timestamp;
+    long long frameCounter;
+    float data[3];
+};
+
 struct IpDeviceControlData
 {
     int sensorId;
@@ -43,8 +60,10 @@ struct IpDeviceControlData
 const std::string STEREO_SENSOR_NAME("Stereo Module");
 const std::string RGB_SENSOR_NAME("RGB Camera");
 const std::string L500_SENSOR_NAME("L500 Depth Sensor");
+const std::string MOTION_SENSOR_NAME("Motion Module");
 const std::string RS_MEDIA_TYPE("RS_VIDEO");
 const std::string RS_PAYLOAD_FORMAT("RS_FORMAT");
+const std::string RS_CODEC_HEADER("Rs-Codec");
 const int MAX_WIDTH = 1280;
 const int MAX_HEIGHT = 720;
 const int MAX_BPP = 3;
@@ -52,5 +71,9 @@ const int MAX_FRAME_SIZE = MAX_WIDTH * MAX_HEIGHT * MAX_BPP;
 const int MAX_MESSAGE_SIZE = MAX_FRAME_SIZE + sizeof(RsFrameHeader);
 const unsigned int SDP_MAX_LINE_LENGHT = 4000;
 const unsigned int RTP_TIMESTAMP_FREQ = 90000;
+// A batch of motion samples is sent when it is full or when it spans the batch period
+const int RS_IMU_MAX_BATCH = 16;
+const double RS_IMU_BATCH_PERIOD = 10; // milliseconds
+const int RS_IMU_MAX_MESSAGE_SIZE = RS_IMU_MAX_BATCH * sizeof(RsImuSample) + sizeof(RsFrameHeader);
 
 #pragma pack(pop)
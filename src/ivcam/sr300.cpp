@@ -120,6 +120,7 @@ namespace librealsense
         // register processing blocks
         color_ep->register_processing_block(processing_block_factory::create_pbf_vector<uyvy_converter>(RS2_FORMAT_UYVY, map_supported_color_formats(RS2_FORMAT_UYVY), RS2_STREAM_COLOR));
         color_ep->register_processing_block(processing_block_factory::create_pbf_vector<yuy2_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
+        color_ep->register_processing_block(processing_block_factory::create_multi_output_pbf<yuy2_multi_converter>(RS2_FORMAT_YUYV, map_supported_color_formats(RS2_FORMAT_YUYV), RS2_STREAM_COLOR));
 
         // register options
         color_ep->register_pu(RS2_OPTION_BACKLIGHT_COMPENSATION);
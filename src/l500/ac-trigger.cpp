@@ -15,6 +15,11 @@
 #else 
 #include <sys/stat.h>  // mkdir
 #endif
+#ifdef __linux__
+#include <sys/resource.h>  // setpriority
+#include <sys/syscall.h>   // SYS_gettid
+#include <unistd.h>
+#endif
 
 
 template < class X > struct string_to {};
@@ -134,6 +139,19 @@ static double get_temp_diff_trigger()
         = env_var< int >( "RS2_AC_TEMP_DIFF", 5, []( int n ) { return n >= 0; } ).value();
     return d_temp;
 }
+static int get_cpu_budget_percent()
+{
+    // Percent of one core the algo may use while the camera streams (100 to not throttle)
+    static int percent = env_var< int >( "RS2_AC_CPU_BUDGET",
+                                         100,
+                                         []( int n ) { return n > 0 && n <= 100; } );
+    return percent;
+}
+static bool is_low_priority()
+{
+    static bool low = env_var< bool >( "RS2_AC_LOW_PRIORITY", false );
+    return low;
+}
 static std::chrono::seconds get_trigger_seconds()
 {
     auto n_seconds = env_var< int >( "RS2_AC_TRIGGER_SECONDS",
@@ -167,6 +185,55 @@ namespace librealsense {
 namespace ivcam2 {
 
 
+    // Lower the priority of the calling thread, so the streams get the CPU before the algo
+    static void lower_thread_priority()
+    {
+#ifdef _WIN32
+        if( ! SetThreadPriority( GetCurrentThread(), THREAD_PRIORITY_LOWEST ) )
+            AC_LOG( WARNING, "Failed to lower the priority of the algo thread" );
+#elif defined( __linux__ )
+        // On Linux, the nice value is per thread
+        if( setpriority( PRIO_PROCESS, (id_t)syscall( SYS_gettid ), 19 ) )
+            AC_LOG( WARNING, "Failed to lower the priority of the algo thread" );
+#else
+        AC_LOG( DEBUG, "Lowering the priority of the algo thread is not supported on this platform" );
+#endif
+    }
+
+
+    /*
+        Keeps the algo thread within a percentage of one core: called at each check point of the
+        algo, it sleeps in proportion to the time worked since the last call. The sleep is in
+        small steps so a stop() does not have to wait for it.
+    */
+    class cpu_budget
+    {
+        typedef std::chrono::high_resolution_clock clock;
+
+        int _percent;
+        clock::time_point _start;
+
+    public:
+        cpu_budget( int percent )
+            : _percent( percent )
+            , _start( clock::now() )
+        {
+        }
+
+        template< class Pred >
+        void yield( Pred should_stop )
+        {
+            if( _percent >= 100 )
+                return;
+            auto const worked = clock::now() - _start;
+            auto const until = clock::now() + worked * ( 100 - _percent ) / _percent;
+            while( clock::now() < until && ! should_stop() )
+                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+            _start = clock::now();
+        }
+    };
+
+
     static bool is_auto_trigger_possible()
     {
         if( get_trigger_seconds().count() )
@@ -946,6 +1013,10 @@ namespace ivcam2 {
             [&]() {
                 try
                 {
+                    if( is_low_priority() )
+                        lower_thread_priority();
+                    cpu_budget budget( get_cpu_budget_percent() );
+
                     AC_LOG( DEBUG, "Calibration algo has started ..." );
                     call_back( RS2_CALIBRATION_STARTED );
 
@@ -989,6 +1060,8 @@ namespace ivcam2 {
                             AC_LOG( DEBUG, "Stopping algo: not processing any more" );
                             throw std::runtime_error( "stopping algo: not processing any more" );
                         }
+                        // Spread the work so the streams do not drop frames while we run
+                        budget.yield( [&]() { return ! is_processing(); } );
                     };
                     algo::depth_to_rgb_calibration::optimizer::settings settings;
                     settings.is_manual_trigger = _calibration_type == calibration_type::MANUAL;
@@ -1220,7 +1293,7 @@ namespace ivcam2 {
 
         try
         {
-            res = hwm->send(command{ TEMPERATURES_GET });
+            res = hwm->send_async(command{ TEMPERATURES_GET }, true).get();
         }
         catch (std::exception const & e)
         {
@@ -69,6 +69,7 @@ namespace librealsense
         // options
         color_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
         color_ep->get_option(RS2_OPTION_GLOBAL_TIME_ENABLED).set(0);
+        color_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
         color_ep->register_pu(RS2_OPTION_BACKLIGHT_COMPENSATION);
         color_ep->register_pu(RS2_OPTION_BRIGHTNESS);
         color_ep->register_pu(RS2_OPTION_CONTRAST);
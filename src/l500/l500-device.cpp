@@ -152,6 +152,7 @@ namespace librealsense
 
         depth_ep->register_option( RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option );
         depth_ep->get_option( RS2_OPTION_GLOBAL_TIME_ENABLED ).set( 0 );
+        depth_ep->register_option( RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option() );
 
         // NOTE: _fw_version is not yet initialized! Any additional options should get added from configure_depth_options()!
         depth_ep->register_info(RS2_CAMERA_INFO_PHYSICAL_PORT, filter_by_mi(all_device_infos, 0).front().device_path);
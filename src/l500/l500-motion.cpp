@@ -115,6 +115,7 @@ namespace librealsense
 
         hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
         hid_ep->get_option(RS2_OPTION_GLOBAL_TIME_ENABLED).set(0);
+        hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_FROM_METADATA, _tf_keeper->get_from_metadata_option());
         hid_ep->register_option(RS2_OPTION_GLOBAL_TIME_ENABLED, enable_global_time_option);
 
         // register pre-processing
@@ -13,11 +13,27 @@ namespace librealsense
 
     float l500_hw_options::query() const
     {
-        return query(int(_resolution->query()));
+        auto mode = int(_resolution->query());
+        {
+            std::lock_guard<std::mutex> lock(_cache_mutex);
+            if (_cached && _cached_mode == mode)
+                return _cached_value;
+        }
+
+        auto value = query(mode);
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+        _cached = true;
+        _cached_mode = mode;
+        _cached_value = value;
+        return value;
     }
 
     void l500_hw_options::set(float value)
     {
+        {
+            std::lock_guard<std::mutex> lock(_cache_mutex);
+            _cached = false;
+        }
         _hw_monitor->send(command{ AMCSET, _type, (int)value });
     }
 
@@ -47,6 +47,12 @@ namespace librealsense
     private:
         float query(int width) const;
 
+        // The controls change only when set, the value read for the current sensor mode is kept until the next set
+        mutable std::mutex _cache_mutex;
+        mutable bool _cached = false;
+        mutable int _cached_mode = 0;
+        mutable float _cached_value = 0;
+
         l500_control _type;
         hw_monitor* _hw_monitor;
         option_range _range;
@@ -76,7 +76,8 @@ namespace librealsense
             if (!is_enabled())
                 throw wrong_api_call_sequence_exception("query option is allow only in streaming!");
 
-            auto res = _hw_monitor->send(command{ TEMPERATURES_GET });
+            // The temperatures are polled together, one transfer serves the options read at once
+            auto res = _hw_monitor->send_async(command{ TEMPERATURES_GET }, true).get();
 
             if (res.size() < sizeof(temperatures))
             {
@@ -42,6 +42,8 @@ namespace librealsense
                     _kill_handler_thread = 0;
                 }
                 _event_handler = std::thread([this]() {
+                    // The transfers of the streams complete, and their frame callbacks run, on this thread
+                    apply_thread_policy(RS2_THREAD_ROLE_CAPTURE);
                     while (!_kill_handler_thread)
                         libusb_handle_events_completed(_ctx, &_kill_handler_thread);
                 });
@@ -239,6 +239,7 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this, read_device_path_str](){
+                apply_thread_policy(RS2_THREAD_ROLE_CAPTURE);
                 const uint32_t channel_size = 24; // TODO: why 24?
                 std::vector<uint8_t> raw_data(channel_size * hid_buf_len);
 
@@ -434,7 +435,7 @@ namespace librealsense
               _sampling_frequency_name(""),
               _callback(nullptr),
               _is_capturing(false),
-              _pm_dispatcher(16)    // queue for async power management commands
+              _pm_dispatcher(16, thread_policy_hook(RS2_THREAD_ROLE_CONTROL))    // queue for async power management commands
         {
             init(frequency);
         }
@@ -508,11 +509,14 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                apply_thread_policy(RS2_THREAD_ROLE_CAPTURE);
                 const uint32_t channel_size = get_channel_size();
-                size_t raw_data_size = channel_size*hid_buf_len;
+                // Each read drains all the samples available, up to the whole IIO buffer
+                size_t raw_data_size = channel_size*_buffer_length;
 
                 std::vector<uint8_t> raw_data(raw_data_size);
                 auto metadata = has_metadata();
+                const hid_sensor sensor{ get_sensor_name() };
 
                 do {
                     fd_set fds;
@@ -552,13 +556,13 @@ namespace librealsense
                             continue;
                         }
 
-                        // TODO: code refactoring to reduce latency
+                        // The samples of a read arrived together, they share its time of arrival
+                        auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
                         for (auto i = 0; i < read_size / channel_size; ++i)
                         {
-                            auto now_ts = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
                             auto p_raw_data = raw_data.data() + channel_size * i;
                             sensor_data sens_data{};
-                            sens_data.sensor = hid_sensor{get_sensor_name()};
+                            sens_data.sensor = sensor;
 
                             auto hid_data_size = channel_size - (metadata ? HID_METADATA_SIZE : 0);
                             // Populate HID IMU data - Header
@@ -667,15 +671,34 @@ namespace librealsense
         }
 
         // Asynchronous power management
+        void iio_hid_sensor::set_watermark(uint32_t samples)
+        {
+            _watermark = std::max(samples, 1u);
+            // Room for the samples arriving while the previous watermark worth is delivered
+            _buffer_length = std::max(hid_buf_len, 2 * _watermark);
+        }
+
         void iio_hid_sensor::set_power(bool on)
         {
             auto path = _iio_device_path + "/buffer/enable";
+            auto length_path = _iio_device_path + "/buffer/length";
+            auto watermark_path = _iio_device_path + "/buffer/watermark";
+            auto length = _buffer_length;
+            auto watermark = _watermark;
 
             // Enqueue power management change
-            _pm_dispatcher.invoke([path,on](dispatcher::cancellable_timer /*t*/)
+            _pm_dispatcher.invoke([path, length_path, watermark_path, length, watermark, on](dispatcher::cancellable_timer /*t*/)
             {
                 //auto st = std::chrono::high_resolution_clock::now();
 
+                // The buffer is configured while disabled. Kernels predating the watermark attribute wake up per sample
+                if (on)
+                {
+                    write_fs_attribute(length_path, length);
+                    if (std::ifstream(watermark_path).good())
+                        write_fs_attribute(watermark_path, watermark);
+                }
+
                 if (!write_fs_attribute(path, on))
                 {
                     LOG_WARNING("HID set_power " << int(on) << " failed for " << path);
@@ -1032,6 +1055,7 @@ namespace librealsense
                 try{
                 for (auto& elem : _streaming_iio_sensors)
                 {
+                    elem->set_watermark(_samples_per_wakeup);
                     elem->start_capture(callback);
                     captured_sensors.push_back(elem);
                 }
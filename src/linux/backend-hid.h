@@ -143,6 +143,9 @@ namespace librealsense
 
             const std::string& get_sensor_name() const { return _sensor_name; }
 
+            // The IIO buffer watermark: the capture thread wakes up once this many samples are available
+            void set_watermark(uint32_t samples);
+
         private:
             void clear_buffer();
 
@@ -179,6 +182,8 @@ namespace librealsense
             std::string _sampling_frequency_name;
             std::list<hid_input*> _inputs;
             std::list<hid_input*> _channels;
+            uint32_t _watermark = 1;
+            uint32_t _buffer_length = hid_buf_len;
             hid_callback _callback;
             std::atomic<bool> _is_capturing;
             std::unique_ptr<std::thread> _hid_thread;
@@ -205,6 +210,8 @@ namespace librealsense
 
             void stop_capture();
 
+            void set_samples_per_wakeup(uint32_t samples) override { _samples_per_wakeup = samples; }
+
             std::vector<uint8_t> get_custom_report_data(const std::string& custom_sensor_name,
                                                         const std::string& report_name,
                                                         custom_sensor_report_field report_field);
@@ -220,6 +227,7 @@ namespace librealsense
             std::vector<std::unique_ptr<hid_custom_sensor>> _hid_custom_sensors;
             std::vector<iio_hid_sensor*> _streaming_iio_sensors;
             std::vector<hid_custom_sensor*> _streaming_custom_sensors;
+            uint32_t _samples_per_wakeup = 1;
             static constexpr const char* custom_id{"custom"};
         };
     }
@@ -7,6 +7,7 @@
 #include "types.h"
 #include "usb/usb-enumerator.h"
 #include "usb/usb-device.h"
+#include "profiler.h"
 
 #include <cassert>
 #include <cstdlib>
@@ -33,15 +34,25 @@
 #include <errno.h>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#ifdef SHM_DEVICE_LOCK
+#include <pthread.h>
+#endif
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <poll.h>
 #include <sys/sysmacros.h> // minor(...), major(...)
 #include <linux/usb/video.h>
 #include <linux/uvcvideo.h>
 #include <linux/videodev2.h>
 #include <regex>
 #include <list>
+#include <future>
+#include <mutex>
 
 #include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
 #include <signal.h>
 #pragma GCC diagnostic ignored "-Woverflow"
 
@@ -116,10 +127,23 @@ namespace librealsense
         std::map<std::string, std::recursive_mutex> named_mutex::_dev_mutex;
         std::map<std::string, int> named_mutex::_dev_mutex_cnt;
 
+#ifdef SHM_DEVICE_LOCK
+        struct shared_device_mutex
+        {
+            static const uint32_t initialized_magic = 0x4c525344; // "DSRL"
+
+            pthread_mutex_t mutex;
+            uint32_t magic;
+        };
+#endif
+
         named_mutex::named_mutex(const std::string& device_path, unsigned timeout)
             : _device_path(device_path),
               _timeout(timeout), // TODO: try to lock with timeout
               _fildes(-1),
+#ifdef SHM_DEVICE_LOCK
+              _shared_mutex(nullptr),
+#endif
               _object_lock_counter(0)
         {
             _init_mutex.lock();
@@ -129,12 +153,93 @@ namespace librealsense
                 _dev_mutex_cnt[_device_path] = 0;
             }
             _init_mutex.unlock();
+
+#ifdef SHM_DEVICE_LOCK
+            try
+            {
+                map_shared_mutex();
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_WARNING("Locking " << _device_path << " with a file lock, the shared mutex is unavailable: " << ex.what());
+            }
+#endif
         }
 
         named_mutex::~named_mutex()
         {
-            unlock();
+            try
+            {
+                unlock();
+            }
+            catch (...) {}
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (-1 != _fildes)
+                close(_fildes);
+#ifdef SHM_DEVICE_LOCK
+            if (_shared_mutex)
+                munmap(_shared_mutex, sizeof(shared_device_mutex));
+#endif
+        }
+
+        void named_mutex::open_device()
+        {
+            if (-1 == _fildes)
+            {
+                _fildes = open(_device_path.c_str(), O_RDWR, 0); //TODO: check
+                if (0 > _fildes)
+                    throw linux_backend_exception(to_string() << __FUNCTION__ << ": Cannot open '" << _device_path);
+            }
+        }
+
+#ifdef SHM_DEVICE_LOCK
+        // Maps the mutex of the device, named after its path, creating it on first use.
+        // The file lock of the device serializes the initialization between the processes
+        void named_mutex::map_shared_mutex()
+        {
+            auto name = "/librealsense" + _device_path;
+            std::replace(name.begin() + 1, name.end(), '/', '-');
+
+            open_device();
+            if (0 != lockf(_fildes, F_LOCK, 0))
+                throw linux_backend_exception(to_string() << __FUNCTION__ << ": Acquire failed");
+
+            void* base = MAP_FAILED;
+            auto fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+            if (-1 != fd)
+            {
+                fchmod(fd, 0666); // Regardless of the umask, for the processes of the other users
+                struct stat status;
+                if (0 == fstat(fd, &status) && (status.st_size >= off_t(sizeof(shared_device_mutex)) ||
+                    0 == ftruncate(fd, sizeof(shared_device_mutex))))
+                    base = mmap(nullptr, sizeof(shared_device_mutex), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                close(fd);
+            }
+
+            if (MAP_FAILED != base)
+            {
+                auto shared = static_cast<shared_device_mutex*>(base);
+                if (shared->magic != shared_device_mutex::initialized_magic)
+                {
+                    pthread_mutexattr_t attr;
+                    pthread_mutexattr_init(&attr);
+                    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+                    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+                    pthread_mutex_init(&shared->mutex, &attr);
+                    pthread_mutexattr_destroy(&attr);
+                    shared->magic = shared_device_mutex::initialized_magic;
+                }
+                _shared_mutex = &shared->mutex;
+            }
+
+            lockf(_fildes, F_ULOCK, 0);
+            close(_fildes);
+            _fildes = -1;
+            if (!_shared_mutex)
+                throw linux_backend_exception(to_string() << "cannot map shared memory " << name << ": " << strerror(errno));
         }
+#endif
 
         void named_mutex::lock()
         {
@@ -172,14 +277,29 @@ namespace librealsense
             _object_lock_counter += 1;
             if (_dev_mutex_cnt[_device_path] == 1)
             {
-                if (-1 == _fildes)
+#ifdef SHM_DEVICE_LOCK
+                if (_shared_mutex)
                 {
-                    _fildes = open(_device_path.c_str(), O_RDWR, 0); //TODO: check
-                    if(0 > _fildes)
+                    auto ret = pthread_mutex_lock(_shared_mutex);
+                    // The previous owner died holding the lock, the device has no state to recover
+                    if (EOWNERDEAD == ret)
+                        ret = pthread_mutex_consistent(_shared_mutex);
+                    if (0 != ret)
                     {
                         release();
-                        throw linux_backend_exception(to_string() << __FUNCTION__ << ": Cannot open '" << _device_path);
+                        throw linux_backend_exception(to_string() << __FUNCTION__ << ": Acquire failed");
                     }
+                    return;
+                }
+#endif
+                try
+                {
+                    open_device();
+                }
+                catch (...)
+                {
+                    release();
+                    throw;
                 }
 
                 auto ret = lockf(_fildes, F_LOCK, 0);
@@ -207,6 +327,14 @@ namespace librealsense
                 throw linux_backend_exception(to_string() << "Error: _dev_mutex_cnt[" << _device_path << "] < 0");
             }
 
+#ifdef SHM_DEVICE_LOCK
+            if ((_dev_mutex_cnt[_device_path] == 0) && _shared_mutex)
+            {
+                if (0 != pthread_mutex_unlock(_shared_mutex))
+                    err_msg = to_string() << "pthread_mutex_unlock(...) failed";
+            }
+            else
+#endif
             if ((_dev_mutex_cnt[_device_path] == 0) && (-1 != _fildes))
             {
                 auto ret = lockf(_fildes, F_ULOCK, 0);
@@ -502,6 +630,8 @@ namespace librealsense
             // Collect UVC nodes info to bundle metadata and video
             typedef std::pair<uvc_device_info,std::string> node_info;
             std::vector<node_info> uvc_nodes,uvc_devices;
+            std::vector<node_info> candidates;
+            std::vector<std::string> candidate_keys;
 
             while (dirent * entry = readdir(dir))
             {
@@ -592,9 +722,10 @@ namespace librealsense
                     info.device_path = std::string(buff);
                     info.unique_id = busnum + "-" + devpath + "-" + devnum;
                     info.conn_spec = usb_specification;
-                    info.uvc_capabilities = get_dev_capabilities(dev_name);
 
-                    uvc_nodes.emplace_back(info, dev_name);
+                    candidates.emplace_back(info, dev_name);
+                    // The device number of the node and the address of the device change when the device is plugged again
+                    candidate_keys.push_back(to_string() << dev_name << ':' << st.st_rdev << ':' << info.unique_id);
                 }
                 catch(const std::exception & e)
                 {
@@ -603,6 +734,45 @@ namespace librealsense
             }
             closedir(dir);
 
+            // Reading the capabilities opens the node, the slow part of the enumeration. They are kept for the nodes seen by the
+            // previous enumerations, and the new nodes are opened in parallel, so several cameras plugged at once are probed together
+            static std::mutex capabilities_mutex;
+            static std::map<std::string, uint32_t> capabilities_cache;
+
+            std::vector<std::future<uint32_t>> probes(candidates.size());
+            {
+                std::lock_guard<std::mutex> lock(capabilities_mutex);
+                for (size_t i = 0; i < candidates.size(); ++i)
+                {
+                    auto it = capabilities_cache.find(candidate_keys[i]);
+                    if (it != capabilities_cache.end())
+                        candidates[i].first.uvc_capabilities = it->second;
+                    else
+                        probes[i] = std::async(std::launch::async, get_dev_capabilities, candidates[i].second);
+                }
+            }
+
+            std::map<std::string, uint32_t> capabilities;
+            for (size_t i = 0; i < candidates.size(); ++i)
+            {
+                try
+                {
+                    if (probes[i].valid())
+                        candidates[i].first.uvc_capabilities = probes[i].get();
+                    capabilities[candidate_keys[i]] = candidates[i].first.uvc_capabilities;
+                    uvc_nodes.push_back(candidates[i]);
+                }
+                catch(const std::exception & e)
+                {
+                    LOG_INFO("Not a USB video device: " << e.what());
+                }
+            }
+            {
+                // the nodes no longer present are dropped
+                std::lock_guard<std::mutex> lock(capabilities_mutex);
+                capabilities_cache.swap(capabilities);
+            }
+
             // Matching video and metadata nodes
             // UVC nodes shall be traversed in ascending order for metadata nodes assignment ("dev/video1, Video2..
             // Replace lexicographic with numeric sort to ensure "video2" is listed before "video11"
@@ -669,16 +839,287 @@ namespace librealsense
             }
         }
 
+        // Registration ids 0 and 1 are reserved for the stop and wake descriptors
+        static const uint64_t poller_stop_id = 0;
+        static const uint64_t poller_wake_id = 1;
+
+        std::shared_ptr<v4l_poller> v4l_poller::get_instance()
+        {
+            static std::mutex instance_mutex;
+            static std::weak_ptr<v4l_poller> instance;
+
+            std::lock_guard<std::mutex> lock(instance_mutex);
+            auto poller = instance.lock();
+            if (!poller)
+            {
+                size_t threads = std::max(std::thread::hardware_concurrency(), 1u);
+                // The last reference may be released by a frame callback running on one of the polling threads, which the
+                // destructor cannot join. The poller is then destroyed on a thread of its own, once the callback returned
+                poller = std::shared_ptr<v4l_poller>(new v4l_poller(std::min(threads, size_t(MAX_V4L2_POLLER_THREADS))),
+                    [](v4l_poller* p)
+                    {
+                        if (p->is_polling_thread())
+                            std::thread([p]() { delete p; }).detach();
+                        else
+                            delete p;
+                    });
+                instance = poller;
+            }
+            return poller;
+        }
+
+        v4l_poller::v4l_poller(size_t threads)
+            : _alive(true), _next_id(poller_wake_id + 1)
+        {
+            _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll_fd < 0)
+                throw linux_backend_exception("v4l_poller: epoll_create1 failed");
+
+            // The stop descriptor is never drained, so that once signalled it wakes all the threads.
+            // The wake descriptor wakes a single thread to take the deadline of a new registration into account
+            _stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            _wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+            epoll_event stop_ev{};
+            stop_ev.events = EPOLLIN;
+            stop_ev.data.u64 = poller_stop_id;
+            epoll_event wake_ev{};
+            wake_ev.events = EPOLLIN | EPOLLONESHOT;
+            wake_ev.data.u64 = poller_wake_id;
+            if (_stop_fd < 0 || _wake_fd < 0 ||
+                epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _stop_fd, &stop_ev) < 0 ||
+                epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &wake_ev) < 0)
+            {
+                if (_stop_fd >= 0) ::close(_stop_fd);
+                if (_wake_fd >= 0) ::close(_wake_fd);
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l_poller: could not register the control descriptors");
+            }
+
+            for (size_t i = 0; i < threads; ++i)
+                _threads.emplace_back([this]()
+                {
+                    apply_thread_policy(RS2_THREAD_ROLE_CAPTURE);
+                    run();
+                });
+        }
+
+        v4l_poller::~v4l_poller()
+        {
+            _alive = false;
+            uint64_t signal = 1;
+            if (write(_stop_fd, &signal, sizeof(signal)) < 0)
+                LOG_ERROR("v4l_poller: could not signal the polling threads to stop");
+
+            for (auto&& t : _threads)
+                t.join();
+
+            ::close(_wake_fd);
+            ::close(_stop_fd);
+            ::close(_epoll_fd);
+        }
+
+        bool v4l_poller::is_polling_thread() const
+        {
+            for (auto&& t : _threads)
+                if (t.get_id() == std::this_thread::get_id())
+                    return true;
+            return false;
+        }
+
+        uint64_t v4l_poller::add(int fd, ready_handler on_ready, timeout_handler on_timeout, std::chrono::milliseconds timeout)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            auto reg = std::make_shared<registration>();
+            reg->id = _next_id++;
+            reg->fd = fd;
+            reg->on_ready = on_ready;
+            reg->on_timeout = on_timeout;
+            reg->timeout = timeout;
+            reg->deadline = std::chrono::steady_clock::now() + timeout;
+
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.u64 = reg->id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+                throw linux_backend_exception(to_string() << "v4l_poller: epoll_ctl(EPOLL_CTL_ADD) failed for fd " << fd);
+
+            _registrations[reg->id] = reg;
+
+            uint64_t signal = 1;
+            if (write(_wake_fd, &signal, sizeof(signal)) < 0)
+                LOG_WARNING("v4l_poller: could not wake a polling thread");
+
+            return reg->id;
+        }
+
+        void v4l_poller::remove(uint64_t id)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            auto it = _registrations.find(id);
+            if (it == _registrations.end())
+                return;
+
+            auto reg = it->second;
+            _registrations.erase(it);
+            reg->removed = true;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, reg->fd, nullptr) < 0)
+                LOG_WARNING("v4l_poller: epoll_ctl(EPOLL_CTL_DEL) failed for fd " << std::dec << reg->fd);
+
+            if (reg->thread != std::this_thread::get_id())
+                _cv.wait(lock, [&reg]() { return !reg->busy; });
+        }
+
+        void v4l_poller::run()
+        {
+            while (_alive)
+            {
+                int timeout_ms = -1;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    auto now = std::chrono::steady_clock::now();
+                    for (auto&& kvp : _registrations)
+                    {
+                        if (kvp.second->busy)
+                            continue;
+                        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(kvp.second->deadline - now).count();
+                        remaining = std::max<decltype(remaining)>(remaining, 0);
+                        if (timeout_ms < 0 || remaining < timeout_ms)
+                            timeout_ms = static_cast<int>(remaining);
+                    }
+                }
+
+                // A single event per call, so that the ready descriptors spread over the threads
+                epoll_event ev{};
+                auto val = epoll_wait(_epoll_fd, &ev, 1, timeout_ms);
+                if (!_alive)
+                    break;
+
+                if (val < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+
+                    LOG_ERROR("v4l_poller: epoll_wait failed, errno " << std::dec << errno);
+                    break;
+                }
+
+                if (val > 0 && ev.data.u64 == poller_wake_id)
+                {
+                    uint64_t signal;
+                    if (read(_wake_fd, &signal, sizeof(signal)) < 0 && errno != EAGAIN)
+                        LOG_WARNING("v4l_poller: could not read the wake descriptor");
+
+                    ev.events = EPOLLIN | EPOLLONESHOT;
+                    if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, _wake_fd, &ev) < 0)
+                        LOG_ERROR("v4l_poller: could not re-arm the wake descriptor");
+                }
+                else if (val > 0)
+                {
+                    std::shared_ptr<registration> reg;
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        auto it = _registrations.find(ev.data.u64);
+                        // Events of removed registrations are stale
+                        if (it != _registrations.end())
+                        {
+                            reg = it->second;
+                            if (reg->busy)
+                            {
+                                // The registration is running its timeout handler, which will handle the event as well
+                                reg->pending = true;
+                                reg = nullptr;
+                            }
+                            else
+                            {
+                                reg->busy = true;
+                                reg->thread = std::this_thread::get_id();
+                            }
+                        }
+                    }
+                    if (reg)
+                        dispatch(reg, true);
+                }
+
+                while (auto reg = expired_registration())
+                    dispatch(reg, false);
+            }
+        }
+
+        std::shared_ptr<v4l_poller::registration> v4l_poller::expired_registration()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto now = std::chrono::steady_clock::now();
+            for (auto&& kvp : _registrations)
+            {
+                auto& reg = kvp.second;
+                if (!reg->busy && reg->deadline <= now)
+                {
+                    reg->busy = true;
+                    reg->thread = std::this_thread::get_id();
+                    return reg;
+                }
+            }
+            return nullptr;
+        }
+
+        void v4l_poller::dispatch(std::shared_ptr<registration> reg, bool ready)
+        {
+            while (true)
+            {
+                bool keep = true;
+                if (ready)
+                    keep = reg->on_ready();
+                else
+                    reg->on_timeout();
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!keep && !reg->removed)
+                {
+                    _registrations.erase(reg->id);
+                    reg->removed = true;
+                    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, reg->fd, nullptr);
+                }
+
+                if (!reg->removed)
+                {
+                    if (reg->pending)
+                    {
+                        reg->pending = false;
+                        ready = true;
+                        continue;
+                    }
+
+                    reg->deadline = std::chrono::steady_clock::now() + reg->timeout;
+
+                    // One-shot descriptors are disarmed once reported and must be re-armed after handling
+                    if (ready)
+                    {
+                        epoll_event ev{};
+                        ev.events = EPOLLIN | EPOLLONESHOT;
+                        ev.data.u64 = reg->id;
+                        if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, reg->fd, &ev) < 0)
+                            LOG_ERROR("v4l_poller: could not re-arm fd " << std::dec << reg->fd);
+                    }
+                }
+
+                reg->busy = false;
+                reg->thread = std::thread::id();
+                _cv.notify_all();
+                return;
+            }
+        }
+
         v4l_uvc_device::v4l_uvc_device(const uvc_device_info& info, bool use_memory_map)
             : _name(""), _info(),
               _is_capturing(false),
               _is_alive(true),
               _is_started(false),
-              _thread(nullptr),
               _named_mtx(nullptr),
               _use_memory_map(use_memory_map),
-              _fd(-1),
-              _stop_pipe_fd{}
+              _fd(-1)
         {
             foreach_uvc_device([&info, this](const uvc_device_info& i, const std::string& name)
             {
@@ -699,11 +1140,8 @@ namespace librealsense
         v4l_uvc_device::~v4l_uvc_device()
         {
             _is_capturing = false;
-            if (_thread && _thread->joinable()) _thread->join();
-            for (auto&& fd : _fds)
-            {
-                try { if (fd) ::close(fd);} catch (...) {}
-            }
+            if (_poller) _poller->remove(_poller_id);
+            try { if (_fd > 0) ::close(_fd);} catch (...) {}
         }
 
         void v4l_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int buffers)
@@ -770,6 +1208,9 @@ namespace librealsense
                 if(xioctl(_fd, VIDIOC_S_PARM, &parm) < 0)
                     throw linux_backend_exception("xioctl(VIDIOC_S_PARM) failed");
 
+                if (!buffers)
+                    buffers = DEFAULT_V4L2_FRAME_BUFFERS;
+
                 // Init memory mapped IO
                 negotiate_kernel_buffers(static_cast<size_t>(buffers));
                 allocate_io_buffers(static_cast<size_t>(buffers));
@@ -796,7 +1237,14 @@ namespace librealsense
                 streamon();
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+                _poller = v4l_poller::get_instance();
+                _poller_id = _poller->add(_fd, [this]() { return poll(); }, [this]()
+                {
+                    LOG_WARNING("Frames didn't arrived within 5 seconds");
+                    librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+
+                    _error_handler(n);
+                }, std::chrono::milliseconds(5000));
             }
         }
 
@@ -810,11 +1258,9 @@ namespace librealsense
             _is_capturing = false;
             _is_started = false;
 
-            // Stop nn-demand frames polling
-            signal_stop();
-
-            _thread->join();
-            _thread.reset();
+            // Stop on-demand frames polling
+            _poller->remove(_poller_id);
+            _poller_id = 0;
 
             // Notify kernel
             streamoff();
@@ -858,186 +1304,141 @@ namespace librealsense
             return fourcc_buff;
         }
 
-        void v4l_uvc_device::signal_stop()
+        bool v4l_uvc_device::poll()
         {
-            char buff[1]={};
-            if (write(_stop_pipe_fd[1], buff, 1) < 0)
+            try
             {
-                 throw linux_backend_exception("Could not signal video capture thread to stop. Error write to pipe.");
+                if (_is_capturing)
+                    dequeue_frame();
+                return _is_capturing;
             }
-        }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR(ex.what());
 
-        void v4l_uvc_device::poll()
-        {
-             fd_set fds{};
-             FD_ZERO(&fds);
-             for (auto fd : _fds)
-             {
-                 FD_SET(fd, &fds);
-             }
+                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
 
-            struct timespec mono_time;
-            int ret = clock_gettime(CLOCK_MONOTONIC, &mono_time);
-            if (ret) throw linux_backend_exception("could not query time!");
+                _error_handler(n);
+                return false;
+            }
+        }
 
-            struct timeval expiration_time = { mono_time.tv_sec + 5, mono_time.tv_nsec / 1000 };
-            int val = 0;
-            do {
-                struct timeval remaining;
-                ret = clock_gettime(CLOCK_MONOTONIC, &mono_time);
-                if (ret) throw linux_backend_exception("could not query time!");
-
-                struct timeval current_time = { mono_time.tv_sec, mono_time.tv_nsec / 1000 };
-                timersub(&expiration_time, &current_time, &remaining);
-                if (timercmp(&current_time, &expiration_time, <)) {
-                    val = select(_max_fd + 1, &fds, nullptr, nullptr, &remaining);
-                }
-                else {
-                    val = 0;
-                }
-            } while (val < 0 && errno == EINTR);
+        void v4l_uvc_device::dequeue_frame()
+        {
+            LRS_PROFILE_ZONE("v4l_uvc_device::dequeue_frame");
+            bool md_extracted = false;
+            buffers_mgr buf_mgr(_use_memory_map);
+            // RAII to handle exceptions
+            std::unique_ptr<int, std::function<void(int*)> > md_poller(new int(0),
+                [this,&buf_mgr,&md_extracted](int* d)
+                {
+                    if (!md_extracted) acquire_metadata(buf_mgr);
+                    delete d;
+                });
 
-            if(val < 0)
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
             {
-                stop_data_capture();
+                LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
+                if(errno == EAGAIN)
+                    return;
+
+                throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
             }
-            else
+            LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
+
+            auto buffer = _buffers[buf.index];
+            buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+
+            if (_is_started)
             {
-                if(val > 0)
+                if(buf.bytesused == 0)
+                {
+                    LOG_INFO("Empty video frame arrived");
+                    return;
+                }
+
+                // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
+                // Drop partial and overflow frames (assumes D4XX metadata only)
+                bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
+                bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
+                bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
+                if (partial_frame || overflow_frame)
                 {
-                    if(FD_ISSET(_stop_pipe_fd[0], &fds) || FD_ISSET(_stop_pipe_fd[1], &fds))
+                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
+                    std::stringstream s;
+                    if (partial_frame)
                     {
-                        if(!_is_capturing)
+                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
+                            << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
+                        if (overflow_frame)
                         {
-                            LOG_INFO("V4L stream is closed");
-                            return;
-                        }
-                        else
-                        {
-                            LOG_ERROR("Stop pipe was signalled during streaming");
-                            return;
+                            s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
+                            LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
                         }
                     }
-                    else // Check and acquire data buffers from kernel
+                    else
                     {
-                        bool md_extracted = false;
-                        buffers_mgr buf_mgr(_use_memory_map);
-                        // RAII to handle exceptions
-                        std::unique_ptr<int, std::function<void(int*)> > md_poller(new int(0),
-                            [this,&buf_mgr,&md_extracted,&fds](int* d)
-                            {
-                                if (!md_extracted) acquire_metadata(buf_mgr,fds);
-                                delete d;
-                            });
+                        if (overflow_frame)
+                            s << "overflow video frame detected!\nSize " << buf.bytesused
+                                << ", payload size " << buffer->get_length_frame_only();
+                    }
+                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
 
-                        if(FD_ISSET(_fd, &fds))
-                        {
-                            FD_CLR(_fd,&fds);
-                            v4l2_buffer buf = {};
-                            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
-                            {
-                                LOG_DEBUG_V4L("Dequeued empty buf for fd " << std::dec << _fd);
-                                if(errno == EAGAIN)
-                                    return;
+                    _error_handler(n);
+                }
+                else
+                {
+                    auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
+                    timestamp = monotonic_to_realtime(timestamp);
 
-                                throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for fd: " << _fd);
-                            }
-                            LOG_DEBUG_V4L("Dequeued buf " << std::dec << buf.index << " for fd " << _fd << " seq " << buf.sequence);
+                    // Read metadata. For metadata note performs a blocking call to ensure video and metadata sync
+                    acquire_metadata(buf_mgr,compressed_format);
+                    md_extracted = true;
 
-                            auto buffer = _buffers[buf.index];
-                            buf_mgr.handle_buffer(e_video_buf,_fd, buf,buffer);
+                    // A newer frame is already waiting, drop this one. The buffers are requeued by buf_mgr
+                    if (_latest_frame_only && has_pending_frame())
+                    {
+                        LOG_DEBUG_V4L("Stale frame dropped, seq " << std::dec << buf.sequence << " for fd " << _fd);
+                        return;
+                    }
 
-                            if (_is_started)
-                            {
-                                if(buf.bytesused == 0)
-                                {
-                                    LOG_INFO("Empty video frame arrived");
-                                    return;
-                                }
+                    //if (val > 1)
+                    //    LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
+                    frame_object fo{ std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only()), buf_mgr.metadata_size(),
+                        buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
 
-                                // Relax the required frame size for compressed formats, i.e. MJPG, Z16H
-                                // Drop partial and overflow frames (assumes D4XX metadata only)
-                                bool compressed_format = val_in_range(_profile.format, { 0x4d4a5047U , 0x5a313648U});
-                                bool partial_frame = (!compressed_format && (buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE));
-                                bool overflow_frame = (buf.bytesused ==  buffer->get_length_frame_only() + MAX_META_DATA_SIZE);
-                                if (partial_frame || overflow_frame)
-                                {
-                                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
-                                    std::stringstream s;
-                                    if (partial_frame)
-                                    {
-                                        s << "Incomplete video frame detected!\nSize " << buf.bytesused
-                                            << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
-                                        if (overflow_frame)
-                                        {
-                                            s << ". Overflow detected: payload size " << buffer->get_length_frame_only();
-                                            LOG_ERROR("Corrupted UVC frame data, underflow and overflow reported:\n" << s.str().c_str());
-                                        }
-                                    }
-                                    else
-                                    {
-                                        if (overflow_frame)
-                                            s << "overflow video frame detected!\nSize " << buf.bytesused
-                                                << ", payload size " << buffer->get_length_frame_only();
-                                    }
-                                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
-
-                                    _error_handler(n);
-                                }
-                                else
-                                {
-                                    auto timestamp = (double)buf.timestamp.tv_sec*1000.f + (double)buf.timestamp.tv_usec/1000.f;
-                                    timestamp = monotonic_to_realtime(timestamp);
-
-                                    // Read metadata. For metadata note performs a blocking call to ensure video and metadata sync
-                                    acquire_metadata(buf_mgr,fds,compressed_format);
-                                    md_extracted = true;
-
-                                    //if (val > 1)
-                                    //    LOG_INFO("Frame buf ready, md size: " << std::dec << (int)buf_mgr.metadata_size() << " seq. id: " << buf.sequence);
-                                    frame_object fo{ std::min(buf.bytesused - buf_mgr.metadata_size(), buffer->get_length_frame_only()), buf_mgr.metadata_size(),
-                                        buffer->get_frame_start(), buf_mgr.metadata_start(), timestamp };
-
-                                    buffer->attach_buffer(buf);
-                                    buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
-
-                                    if (buf_mgr.verify_vd_md_sync())
-                                    {
-                                        //Invoke user callback and enqueue next frame
-                                        _callback(_profile, fo, [buf_mgr]() mutable {
-                                            buf_mgr.request_next_frame();
-                                        });
-                                    }
-                                    else
-                                    {
-                                        LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
-                                    }
-                                }
-                            }
-                            else
-                            {
-                                LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
-                            }
-                        }
-                        else
-                        {
-                            LOG_WARNING("FD_ISSET signal false - no data on video node sink");
-                        }
-                    }
-                }
-                else // (val==0)
-                {
-                    LOG_WARNING("Frames didn't arrived within 5 seconds");
-                    librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+                    buffer->attach_buffer(buf);
+                    buf_mgr.handle_buffer(e_video_buf,-1); // transfer new buffer request to the frame callback
 
-                    _error_handler(n);
+                    if (buf_mgr.verify_vd_md_sync())
+                    {
+                        //Invoke user callback and enqueue next frame
+                        _callback(_profile, fo, [buf_mgr]() mutable {
+                            buf_mgr.request_next_frame();
+                        });
+                    }
+                    else
+                    {
+                        LOG_WARNING("Video frame dropped, video and metadata buffers inconsistency");
+                    }
                 }
             }
+            else
+            {
+                LOG_INFO("Video frame arrived in idle mode."); // TODO - verification
+            }
         }
 
-        void v4l_uvc_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &, bool compressed_format)
+        bool v4l_uvc_device::has_pending_frame() const
+        {
+            pollfd pfd = { _fd, POLLIN, 0 };
+            return (::poll(&pfd, 1, 0) > 0) && (pfd.revents & POLLIN);
+        }
+
+        void v4l_uvc_device::acquire_metadata(buffers_mgr & buf_mgr, bool compressed_format)
         {
             if (has_metadata())
                 buf_mgr.set_md_from_video_node(compressed_format);
@@ -1340,25 +1741,6 @@ namespace librealsense
             }
         }
 
-        void v4l_uvc_device::capture_loop()
-        {
-            try
-            {
-                while(_is_capturing)
-                {
-                    poll();
-                }
-            }
-            catch (const std::exception& ex)
-            {
-                LOG_ERROR(ex.what());
-
-                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
-
-                _error_handler(n);
-            }
-        }
-
         bool v4l_uvc_device::has_metadata() const
         {
             return !_use_memory_map;
@@ -1406,14 +1788,6 @@ namespace librealsense
             if(_fd < 0)
                 throw linux_backend_exception(to_string() <<__FUNCTION__ << " Cannot open '" << _name);
 
-            if (pipe(_stop_pipe_fd) < 0)
-                throw linux_backend_exception(to_string() <<__FUNCTION__ << " Cannot create pipe!");
-
-            if (_fds.size())
-                throw linux_backend_exception(to_string() <<__FUNCTION__ << " Device descriptor is already allocated");
-
-            _fds.insert(_fds.end(),{_fd,_stop_pipe_fd[0],_stop_pipe_fd[1]});
-            _max_fd = *std::max_element(_fds.begin(),_fds.end());
 
             v4l2_capability cap = {};
             if(xioctl(_fd, VIDIOC_QUERYCAP, &cap) < 0)
@@ -1453,14 +1827,7 @@ namespace librealsense
             if(::close(_fd) < 0)
                 throw linux_backend_exception("v4l_uvc_device: close(_fd) failed");
 
-            if(::close(_stop_pipe_fd[0]) < 0)
-               throw linux_backend_exception("v4l_uvc_device: close(_stop_pipe_fd[0]) failed");
-            if(::close(_stop_pipe_fd[1]) < 0)
-               throw linux_backend_exception("v4l_uvc_device: close(_stop_pipe_fd[1]) failed");
-
             _fd = 0;
-            _stop_pipe_fd[0] = _stop_pipe_fd[1] = 0;
-            _fds.clear();
         }
 
         void v4l_uvc_device::set_format(stream_profile profile)
@@ -1528,6 +1895,8 @@ namespace librealsense
                 {
                     _md_buffers.push_back(std::make_shared<buffer>(_md_fd, LOCAL_V4L2_BUF_TYPE_META_CAPTURE, _use_memory_map, i));
                 }
+                _md_ring.assign(buffers, md_slot());
+                _unmatched_metadata = _unmatched_video = 0;
             }
             else
             {
@@ -1536,6 +1905,12 @@ namespace librealsense
                     _md_buffers[i]->detach_buffer();
                 }
                 _md_buffers.resize(0);
+
+                // The buffers held in the ring were reclaimed by the kernel on stream off
+                _md_ring.clear();
+                if (_unmatched_metadata || _unmatched_video)
+                    LOG_INFO("Metadata node " << _md_name << " unmatched buffers: " << std::dec << _unmatched_metadata
+                        << " metadata, " << _unmatched_video << " video");
             }
         }
 
@@ -1553,9 +1928,7 @@ namespace librealsense
             //The minimal video/metadata nodes syncer will be implemented by using two blocking calls:
             // 1. Obtain video node data.
             // 2. Obtain metadata
-            //     To revert to multiplexing mode uncomment the next line
-            // _fds.push_back(_md_fd);
-            _max_fd = *std::max_element(_fds.begin(),_fds.end());
+            //     To revert to multiplexing mode register _md_fd with the poller
 
             v4l2_capability cap = {};
             if(xioctl(_md_fd, VIDIOC_QUERYCAP, &cap) < 0)
@@ -1631,62 +2004,104 @@ namespace librealsense
             v4l_uvc_device::prepare_capture_buffers();
         }
 
-        // Retrieve metadata from a dedicated UVC node. For kernels 4.16+
-        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool)
+        void v4l_uvc_meta_device::requeue_metadata(v4l2_buffer& buf)
         {
-            // Metadata is calculated once per frame
-            if (buf_mgr.metadata_size())
-                return;
+            if (xioctl(_md_fd, VIDIOC_QBUF, &buf) < 0)
+                LOG_ERROR("xioctl(VIDIOC_QBUF) failed for metadata fd " << std::dec << _md_fd << " error: " << strerror(errno));
+        }
 
-            //Use blocking metadata node polling. Uncomment the next lines to revert to multiplexing I/O mode
-            //if(FD_ISSET(_md_fd, &fds))
+        void v4l_uvc_meta_device::dequeue_metadata()
+        {
+            // The node is opened non-blocking, the loop ends once the kernel has no more buffers ready
+            while (true)
             {
-                //FD_CLR(_md_fd,&fds);
                 v4l2_buffer buf{};
                 buf.type = LOCAL_V4L2_BUF_TYPE_META_CAPTURE;
                 buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-
-                // W/O multiplexing this will create a blocking call for metadata node
-                if(xioctl(_md_fd, VIDIOC_DQBUF, &buf) < 0)
+                if (xioctl(_md_fd, VIDIOC_DQBUF, &buf) < 0)
                 {
                     LOG_DEBUG_V4L("Dequeued empty buf for md fd " << std::dec << _md_fd);
                     return;
-
-                    //throw linux_backend_exception(to_string() << "xioctl(VIDIOC_DQBUF) failed for metadata fd: " << _md_fd);
                 }
                 LOG_DEBUG_V4L("Dequeued md buf " << std::dec << buf.index << " for fd " << _md_fd << " seq " << buf.sequence);
 
-                auto buffer = _md_buffers[buf.index];
-                buf_mgr.handle_buffer(e_metadata_buf,_md_fd, buf,buffer);
+                if (!_is_started || _md_ring.empty())
+                {
+                    LOG_INFO("Metadata frame arrived in idle mode.");
+                    requeue_metadata(buf);
+                    continue;
+                }
 
-                if (_is_started)
+                // A slot still taken holds an older sequence whose video buffer never came
+                auto& slot = _md_ring[buf.sequence % _md_ring.size()];
+                if (slot.valid)
                 {
-                    static const size_t uvc_md_start_offset = sizeof(uvc_meta_buffer::ns) + sizeof(uvc_meta_buffer::sof);
+                    ++_unmatched_metadata;
+                    requeue_metadata(slot.buf);
+                }
+                slot.buf = buf;
+                slot.valid = true;
+            }
+        }
 
-                    if (buf.bytesused > uvc_md_start_offset )
-                    {
-                        // The first uvc_md_start_offset bytes of metadata buffer are generated by host driver
-                        buf_mgr.set_md_attributes(buf.bytesused - uvc_md_start_offset,
-                                                    buffer->get_frame_start() + uvc_md_start_offset);
+        // Retrieve metadata from a dedicated UVC node. For kernels 4.16+
+        void v4l_uvc_meta_device::acquire_metadata(buffers_mgr & buf_mgr, bool)
+        {
+            // Metadata is calculated once per frame
+            if (buf_mgr.metadata_size())
+                return;
 
-                        buffer->attach_buffer(buf);
-                        buf_mgr.handle_buffer(e_metadata_buf,-1); // transfer new buffer request to the frame callback
-                    }
-                    else
-                    {
-                        // Zero-size buffers generate empty md. Non-zero partial bufs handled as errors
-                        if(buf.bytesused > 0)
-                        {
-                            std::stringstream s;
-                            s << "Invalid metadata payload, size " << buf.bytesused;
-                            LOG_WARNING(s.str());
-                            _error_handler({ RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()});
-                        }
-                    }
+            // The metadata node is read along with its video node rather than being registered with the poller.
+            // The metadata buffers wait in the ring for the video buffer of their sequence
+            dequeue_metadata();
+
+            auto sequence = buf_mgr.video_sequence();
+            if (sequence < 0 || _md_ring.empty())
+                return;
+
+            // The sequences below the one of the video buffer will not be matched anymore
+            for (auto& slot : _md_ring)
+            {
+                if (slot.valid && int64_t(slot.buf.sequence) < sequence)
+                {
+                    ++_unmatched_metadata;
+                    requeue_metadata(slot.buf);
+                    slot.valid = false;
                 }
-                else
+            }
+
+            auto& slot = _md_ring[sequence % _md_ring.size()];
+            if (!slot.valid || int64_t(slot.buf.sequence) != sequence)
+            {
+                ++_unmatched_video;
+                return;
+            }
+            auto buf = slot.buf;
+            slot.valid = false;
+
+            auto buffer = _md_buffers[buf.index];
+            buf_mgr.handle_buffer(e_metadata_buf,_md_fd, buf,buffer);
+
+            static const size_t uvc_md_start_offset = sizeof(uvc_meta_buffer::ns) + sizeof(uvc_meta_buffer::sof);
+
+            if (buf.bytesused > uvc_md_start_offset )
+            {
+                // The first uvc_md_start_offset bytes of metadata buffer are generated by host driver
+                buf_mgr.set_md_attributes(buf.bytesused - uvc_md_start_offset,
+                                            buffer->get_frame_start() + uvc_md_start_offset);
+
+                buffer->attach_buffer(buf);
+                buf_mgr.handle_buffer(e_metadata_buf,-1); // transfer new buffer request to the frame callback
+            }
+            else
+            {
+                // Zero-size buffers generate empty md. Non-zero partial bufs handled as errors
+                if(buf.bytesused > 0)
                 {
-                    LOG_INFO("Metadata frame arrived in idle mode.");
+                    std::stringstream s;
+                    s << "Invalid metadata payload, size " << buf.bytesused;
+                    LOG_WARNING(s.str());
+                    _error_handler({ RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()});
                 }
             }
         }
@@ -1752,9 +2167,173 @@ namespace librealsense
 
         std::shared_ptr<device_watcher> v4l_backend::create_device_watcher() const
         {
+            auto fd = netlink_device_watcher::open_socket();
+            if (fd >= 0)
+                return std::make_shared<netlink_device_watcher>(this, fd);
+
+            LOG_INFO("Hotplug events are not available (" << strerror(errno) << "), polling the devices instead");
             return std::make_shared<polling_device_watcher>(this);
         }
 
+        // Events of one plug arrive over some tens of milliseconds
+        static const int uevent_settle_ms = 200;
+        // udev may still be applying the rules of a node after the kernel events
+        static const int uevent_rescan_ms = 2000;
+
+        int netlink_device_watcher::open_socket()
+        {
+            auto fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+            if (fd < 0)
+                return -1;
+
+            sockaddr_nl addr = {};
+            addr.nl_family = AF_NETLINK;
+            addr.nl_groups = 1; // the events of the kernel
+            if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+            {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        netlink_device_watcher::netlink_device_watcher(const backend* backend_ref, int socket_fd)
+            : _backend(backend_ref), _socket(socket_fd), _stop_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+        {
+            if (_stop_fd < 0)
+            {
+                ::close(_socket);
+                throw linux_backend_exception("netlink_device_watcher: eventfd failed");
+            }
+        }
+
+        netlink_device_watcher::~netlink_device_watcher()
+        {
+            stop();
+            ::close(_stop_fd);
+            ::close(_socket);
+        }
+
+        void netlink_device_watcher::start(device_changed_callback callback)
+        {
+            stop();
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _callback = std::move(callback);
+            if (!_has_devices_data)
+            {
+                _devices_data = { _backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices() };
+                _has_devices_data = true;
+            }
+            _thread = std::thread([this]()
+            {
+                apply_thread_policy(RS2_THREAD_ROLE_MONITORING);
+                watch();
+            });
+        }
+
+        void netlink_device_watcher::stop()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_thread.joinable())
+                return;
+
+            uint64_t one = 1;
+            if (write(_stop_fd, &one, sizeof(one)) != sizeof(one))
+                LOG_ERROR("netlink_device_watcher: failed to signal the watcher thread to stop");
+            _thread.join();
+
+            uint64_t value;
+            while (read(_stop_fd, &value, sizeof(value)) > 0) {}
+        }
+
+        bool netlink_device_watcher::read_events()
+        {
+            bool relevant = false;
+            char buffer[8192];
+            while (true)
+            {
+                auto size = recv(_socket, buffer, sizeof(buffer) - 1, 0);
+                if (size < 0)
+                {
+                    // events were lost, they may have been ours
+                    if (errno == ENOBUFS)
+                    {
+                        relevant = true;
+                        continue;
+                    }
+                    break;
+                }
+                buffer[size] = 0;
+
+                // "action@devpath" followed by null terminated KEY=value properties
+                for (auto p = buffer; p < buffer + size; p += strlen(p) + 1)
+                {
+                    static const std::string subsystem = "SUBSYSTEM=";
+                    if (strncmp(p, subsystem.c_str(), subsystem.size()))
+                        continue;
+                    std::string value = p + subsystem.size();
+                    if (value == "usb" || value == "video4linux" || value == "iio")
+                        relevant = true;
+                }
+            }
+            return relevant;
+        }
+
+        void netlink_device_watcher::rescan()
+        {
+            backend_device_group curr(_backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices());
+            if (list_changed(_devices_data.uvc_devices, curr.uvc_devices) ||
+                list_changed(_devices_data.usb_devices, curr.usb_devices) ||
+                list_changed(_devices_data.hid_devices, curr.hid_devices))
+            {
+                _callback(_devices_data, curr);
+                _devices_data = curr;
+            }
+        }
+
+        void netlink_device_watcher::watch()
+        {
+            int timeout_ms = -1;
+            bool settled = true;
+            while (true)
+            {
+                pollfd fds[2] = { { _socket, POLLIN, 0 }, { _stop_fd, POLLIN, 0 } };
+                auto res = poll(fds, 2, timeout_ms);
+                if (res < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    LOG_ERROR("netlink_device_watcher: poll failed, errno " << errno);
+                    return;
+                }
+                if (fds[1].revents)
+                    return;
+
+                if (res == 0)
+                {
+                    try
+                    {
+                        rescan();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_ERROR("netlink_device_watcher: failed to enumerate the devices: " << e.what());
+                    }
+                    // the first pass after a burst schedules the late one, which ends the wait
+                    timeout_ms = settled ? -1 : uevent_rescan_ms;
+                    settled = true;
+                    continue;
+                }
+
+                if ((fds[0].revents & POLLIN) && read_events())
+                {
+                    timeout_ms = uevent_settle_ms;
+                    settled = false;
+                }
+            }
+        }
+
         std::shared_ptr<backend> create_backend()
         {
             return std::make_shared<v4l_backend>();
@@ -23,6 +23,9 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <map>
 
 #include <dirent.h>
 #include <fcntl.h>
@@ -33,6 +36,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <sys/ioctl.h>
+#include <sys/epoll.h>
 #include <linux/usb/video.h>
 #include <linux/uvcvideo.h>
 #include <linux/videodev2.h>
@@ -98,10 +102,18 @@ namespace librealsense
         private:
             void acquire();
             void release();
+            void open_device();
+#ifdef SHM_DEVICE_LOCK
+            void map_shared_mutex();
+#endif
 
             std::string _device_path;
             uint32_t _timeout;
             int _fildes;
+#ifdef SHM_DEVICE_LOCK
+            // Robust process-shared mutex of the device in shared memory, the file lock is used when it could not be mapped
+            pthread_mutex_t* _shared_mutex;
+#endif
             static std::recursive_mutex _init_mutex;
             static std::map<std::string, std::recursive_mutex> _dev_mutex;
             static std::map<std::string, int> _dev_mutex_cnt;
@@ -176,6 +188,9 @@ namespace librealsense
                     { _md_start = md_start; _md_size = md_size; }
             void    set_md_from_video_node(bool compressed);
             bool    verify_vd_md_sync() const;
+            // The sequence of the video buffer held, -1 when there is none
+            int64_t video_sequence() const
+                    { return (buffers[e_video_buf]._file_desc > 0) ? int64_t(buffers[e_video_buf]._dq_buf.sequence) : -1; }
 
         private:
             void*                               _md_start;  // marks the address of metadata blob
@@ -215,9 +230,65 @@ namespace librealsense
             std::array<kernel_buf_guard, e_max_kernel_buf_type> buffers;
         };
 
+        // Shared epoll reactor for the streaming nodes of all the connected devices.
+        // A small fixed pool of threads services every registered descriptor, instead of a polling thread per device.
+        // Each descriptor is handled by a single thread at a time (EPOLLONESHOT), preserving the per-device order of frames
+        class v4l_poller
+        {
+        public:
+            // Returns false to stop monitoring the descriptor
+            typedef std::function<bool()> ready_handler;
+            typedef std::function<void()> timeout_handler;
+
+            static std::shared_ptr<v4l_poller> get_instance();
+
+            explicit v4l_poller(size_t threads);
+            // Joins the polling threads, so it must not run on one of them
+            ~v4l_poller();
+
+            v4l_poller(const v4l_poller&) = delete;
+            v4l_poller& operator=(const v4l_poller&) = delete;
+
+            // on_timeout is invoked when the descriptor was not ready for the timeout period, and every period thereafter
+            uint64_t add(int fd, ready_handler on_ready, timeout_handler on_timeout, std::chrono::milliseconds timeout);
+
+            // Waits for a running handler of the registration to return, unless called from within the handler
+            void remove(uint64_t id);
+
+        private:
+            struct registration
+            {
+                uint64_t id;
+                int fd;
+                ready_handler on_ready;
+                timeout_handler on_timeout;
+                std::chrono::milliseconds timeout;
+                std::chrono::steady_clock::time_point deadline;
+                bool busy = false;
+                bool pending = false;
+                bool removed = false;
+                std::thread::id thread;
+            };
+
+            bool is_polling_thread() const;
+            void run();
+            void dispatch(std::shared_ptr<registration> reg, bool ready);
+            std::shared_ptr<registration> expired_registration();
+
+            int _epoll_fd = -1;
+            int _stop_fd = -1;
+            int _wake_fd = -1;
+            std::atomic<bool> _alive;
+            uint64_t _next_id = 1;
+            std::mutex _mutex;
+            std::condition_variable _cv;
+            std::map<uint64_t, std::shared_ptr<registration>> _registrations;
+            std::vector<std::thread> _threads;
+        };
+
         class v4l_uvc_interface
         {
-            virtual void capture_loop() = 0;
+            virtual bool poll() = 0;
 
             virtual bool has_metadata() const = 0;
 
@@ -231,7 +302,7 @@ namespace librealsense
             virtual void set_format(stream_profile profile) = 0;
             virtual void prepare_capture_buffers() = 0;
             virtual void stop_data_capture() = 0;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format) = 0;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr, bool compressed_format) = 0;
         };
 
         class v4l_uvc_device : public uvc_device, public v4l_uvc_interface
@@ -247,6 +318,8 @@ namespace librealsense
 
             void probe_and_commit(stream_profile profile, frame_callback callback, int buffers) override;
 
+            void set_latest_frame_only(bool latest_only) override { _latest_frame_only = latest_only; }
+
             void stream_on(std::function<void(const notification& n)> error_handler) override;
 
             void start_callbacks() override;
@@ -257,10 +330,6 @@ namespace librealsense
 
             std::string fourcc_to_string(uint32_t id) const;
 
-            void signal_stop();
-
-            void poll();
-
             void set_power_state(power_state state) override;
             power_state get_power_state() const override { return _state; }
 
@@ -286,7 +355,10 @@ namespace librealsense
         protected:
             static uint32_t get_cid(rs2_option option);
 
-            virtual void capture_loop() override;
+            // Invoked by the poller when the video node is ready, returns false when the capture cannot proceed
+            virtual bool poll() override;
+            void dequeue_frame();
+            bool has_pending_frame() const;
 
             virtual bool has_metadata() const override;
 
@@ -300,7 +372,7 @@ namespace librealsense
             virtual void set_format(stream_profile profile) override;
             virtual void prepare_capture_buffers() override;
             virtual void stop_data_capture() override;
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format = false) override;
+            virtual void acquire_metadata(buffers_mgr & buf_mgr, bool compressed_format = false) override;
 
             power_state _state = D3;
             std::string _name = "";
@@ -314,15 +386,14 @@ namespace librealsense
             std::atomic<bool> _is_capturing;
             std::atomic<bool> _is_alive;
             std::atomic<bool> _is_started;
-            std::unique_ptr<std::thread> _thread;
+            bool _latest_frame_only = false;
+            std::shared_ptr<v4l_poller> _poller;
+            uint64_t _poller_id = 0;
             std::unique_ptr<named_mutex> _named_mtx;
             bool _use_memory_map;
-            int _max_fd = 0;                    // specifies the maximal pipe number the polling process will monitor
-            std::vector<int>  _fds;             // list the file descriptors to be monitored during frames polling
 
         private:
             int _fd = 0;          // prevent unintentional abuse in derived class
-            int _stop_pipe_fd[2]; // write to _stop_pipe_fd[1] and read from _stop_pipe_fd[0]
 
         };
 
@@ -344,13 +415,59 @@ namespace librealsense
             void unmap_device_descriptor();
             void set_format(stream_profile profile);
             void prepare_capture_buffers();
-            virtual void acquire_metadata(buffers_mgr & buf_mgr,fd_set &fds, bool compressed_format=false);
+            virtual void acquire_metadata(buffers_mgr & buf_mgr, bool compressed_format=false);
+
+            // Dequeues all the metadata buffers ready into the ring, without waiting
+            void dequeue_metadata();
+            void requeue_metadata(v4l2_buffer& buf);
 
             int _md_fd = -1;
             std::string _md_name = "";
 
             std::vector<std::shared_ptr<buffer>> _md_buffers;
             stream_profile _md_profile;
+
+            // The metadata buffers dequeued ahead of their video buffers, at the sequence number modulo the ring size.
+            // Only the thread dequeuing the video frames accesses it
+            struct md_slot
+            {
+                bool valid = false;
+                v4l2_buffer buf{};
+            };
+            std::vector<md_slot> _md_ring;
+            unsigned long long _unmatched_metadata = 0;
+            unsigned long long _unmatched_video = 0;
+        };
+
+        // Reacts to the hotplug uevents of the kernel, read from the netlink socket udev listens to, instead of polling the devices.
+        // Once the events of a plug settle the devices are enumerated again, which only probes the nodes that were not seen before,
+        // and once more a little later for the nodes that udev was still setting up
+        class netlink_device_watcher : public device_watcher
+        {
+        public:
+            netlink_device_watcher(const backend* backend_ref, int socket_fd);
+            ~netlink_device_watcher();
+
+            // A socket receiving the uevents, or -1 when the process may not listen to them (some containers)
+            static int open_socket();
+
+            void start(device_changed_callback callback) override;
+            void stop() override;
+
+        private:
+            void watch();
+            bool read_events();
+            void rescan();
+
+            const backend* _backend;
+            int _socket;
+            int _stop_fd;
+            std::thread _thread;
+            std::mutex _mutex;
+
+            backend_device_group _devices_data;
+            bool _has_devices_data = false;
+            device_changed_callback _callback;
         };
 
         class v4l_backend : public backend
@@ -4,12 +4,198 @@
 #include "log.h"
 
 #include <fstream>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <unordered_map>
 
 #ifdef BUILD_EASYLOGGINGPP
 INITIALIZE_EASYLOGGINGPP
 
 namespace librealsense
 {
+    static const size_t LOG_QUEUE_SIZE = 8192;      // lines waiting for the writer, further lines are dropped
+    static const unsigned LOG_SITE_MAX_RATE = 200;  // messages per second of a single message site
+
+    struct async_log_writer::state
+    {
+        struct line
+        {
+            std::string text;
+            bool to_console;
+            bool to_file;
+        };
+
+        struct site
+        {
+            std::chrono::steady_clock::time_point window_start;
+            unsigned count = 0;
+            unsigned long long suppressed = 0;
+        };
+
+        std::mutex mutex;
+        std::condition_variable pending;    // wakes up the writer thread
+        std::condition_variable written;    // wakes up the flushing and stopping callers
+        std::deque<line> lines;
+        unsigned long long queued_count = 0;
+        unsigned long long written_count = 0;
+        unsigned long long dropped = 0;
+        bool dropped_to_console = false;
+        bool dropped_to_file = false;
+        bool running = false;
+        bool stopping = false;
+        std::unordered_map<size_t, site> sites;
+
+        std::mutex output_mutex;
+        std::ofstream file;
+        std::string filename;
+
+        void output(const line& l)
+        {
+            if (l.to_console)
+                std::cout << l.text;
+            if (l.to_file && file.is_open())
+                file << l.text;
+        }
+
+        void output(const std::deque<line>& batch)
+        {
+            std::lock_guard<std::mutex> lock(output_mutex);
+            for (auto&& l : batch)
+                output(l);
+            std::cout.flush();
+            if (file.is_open())
+                file.flush();
+        }
+
+        // Queues a line, with the mutex held
+        void push(line&& l)
+        {
+            if (lines.size() >= LOG_QUEUE_SIZE)
+            {
+                ++dropped;
+                dropped_to_console |= l.to_console;
+                dropped_to_file |= l.to_file;
+                return;
+            }
+            lines.push_back(std::move(l));
+            ++queued_count;
+        }
+
+        static void run(std::shared_ptr<state> s)
+        {
+            std::unique_lock<std::mutex> lock(s->mutex);
+            while (true)
+            {
+                s->pending.wait(lock, [&]() { return !s->lines.empty() || s->dropped || s->stopping; });
+                if (s->lines.empty() && !s->dropped)
+                    break;
+
+                std::deque<line> batch;
+                batch.swap(s->lines);
+                if (s->dropped)
+                {
+                    batch.push_back({ to_string() << s->dropped << " log lines were dropped, the log writer could not keep up\n",
+                        s->dropped_to_console, s->dropped_to_file });
+                    s->dropped = 0;
+                    s->dropped_to_console = s->dropped_to_file = false;
+                }
+                auto end = s->queued_count;
+
+                lock.unlock();
+                s->output(batch);
+                lock.lock();
+
+                s->written_count = end;
+                s->written.notify_all();
+            }
+            s->running = false;
+            s->written.notify_all();
+        }
+    };
+
+    async_log_writer::async_log_writer()
+        : _state(std::make_shared<state>())
+    {
+    }
+
+    void async_log_writer::set_file(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> lock(_state->output_mutex);
+        if (filename == _state->filename)
+            return;
+
+        if (_state->file.is_open())
+            _state->file.close();
+        _state->filename = filename;
+        if (!filename.empty())
+            _state->file.open(filename, std::ios::out | std::ios::app);
+    }
+
+    bool async_log_writer::admit(rs2_log_severity severity, const std::string& file, unsigned line, bool to_console, bool to_file)
+    {
+        if (severity >= RS2_LOG_SEVERITY_FATAL)
+            return true;
+
+        auto key = std::hash<std::string>()(file) * 31 + line;
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        auto& site = _state->sites[key];
+        if (now - site.window_start >= std::chrono::seconds(1))
+        {
+            if (site.suppressed)
+                _state->push({ to_string() << site.suppressed << " messages of " << file << ":" << line
+                    << " were suppressed in the last second\n", to_console, to_file });
+            site.window_start = now;
+            site.count = 0;
+            site.suppressed = 0;
+        }
+
+        if (++site.count <= LOG_SITE_MAX_RATE)
+            return true;
+        ++site.suppressed;
+        return false;
+    }
+
+    void async_log_writer::write(std::string&& text, bool to_console, bool to_file)
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        if (_state->stopping)
+        {
+            // Past the end of the writer thread, typically from the static destructors
+            lock.unlock();
+            std::deque<state::line> batch;
+            batch.push_back({ std::move(text), to_console, to_file });
+            _state->output(batch);
+            return;
+        }
+
+        _state->push({ std::move(text), to_console, to_file });
+        if (!_state->running)
+        {
+            _state->running = true;
+            std::thread(state::run, _state).detach();
+        }
+        _state->pending.notify_one();
+    }
+
+    void async_log_writer::flush()
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        auto end = _state->queued_count;
+        _state->written.wait(lock, [&]() { return _state->written_count >= end || !_state->running; });
+    }
+
+    void async_log_writer::stop()
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->stopping = true;
+        _state->pending.notify_one();
+
+        // The writer thread is detached rather than joined, joining in the destructors of a library being unloaded may deadlock
+        _state->written.wait_for(lock, std::chrono::seconds(1), [&]() { return !_state->running; });
+    }
+
     char log_name[] = "librealsense";
     static logger_type<log_name> logger;
 }
@@ -37,6 +37,33 @@ namespace librealsense
         }
     };
 
+    // Writes the log lines to the console and to the log file on a background thread, so that logging from the
+    // streaming threads does not wait on the disk. Each message site (file and line) is limited to a number of
+    // messages per second, the messages over the limit are dropped and their count is written instead
+    class async_log_writer
+    {
+    public:
+        async_log_writer();
+        ~async_log_writer() { stop(); }
+
+        // An empty name closes the file
+        void set_file(const std::string& filename);
+
+        // Whether the message site did not reach its rate limit, checked before the line is built
+        bool admit(rs2_log_severity severity, const std::string& file, unsigned line, bool to_console, bool to_file);
+        void write(std::string&& text, bool to_console, bool to_file);
+
+        // Waits until the lines written so far are out
+        void flush();
+
+        // Writes out the pending lines, the lines written after it are written on the calling thread
+        void stop();
+
+    private:
+        struct state;
+        std::shared_ptr<state> _state;
+    };
+
     template<char const * NAME>
     class logger_type
     {
@@ -51,6 +78,8 @@ namespace librealsense
         std::string filename;
         const std::string log_id = NAME;
 
+        std::shared_ptr<async_log_writer> writer = std::make_shared<async_log_writer>();
+
     public:
         static el::Level severity_to_level(rs2_log_severity severity)
         {
@@ -115,6 +144,7 @@ namespace librealsense
             }
 
             el::Loggers::reconfigureLogger(log_id, defaultConf);
+            writer->set_file(minimum_file_severity != RS2_LOG_SEVERITY_NONE ? filename : std::string());
         }
 
         void open_def() const
@@ -133,6 +163,11 @@ namespace librealsense
         logger_type()
             : filename(to_string() << datetime_string() << ".log")
         {
+            // The console and the file are written by the async writer instead of the default dispatcher of ELPP
+            el::Helpers::installLogDispatchCallback< async_dispatcher >( "async_dispatcher" );
+            el::Helpers::logDispatchCallback< async_dispatcher >( "async_dispatcher" )->writer = writer;
+            el::Helpers::uninstallLogDispatchCallback< el::base::DefaultLogDispatchCallback >( "DefaultLogDispatchCallback" );
+
             rs2_log_severity severity;
             if (try_get_log_severity(severity))
             {
@@ -144,6 +179,11 @@ namespace librealsense
             }
         }
 
+        ~logger_type()
+        {
+            writer->stop();
+        }
+
         static bool try_get_log_severity(rs2_log_severity& severity)
         {
             static const char* severity_var_name = "LRS_LOG_LEVEL";
@@ -210,6 +250,36 @@ namespace librealsense
             }
         };
 
+        // Hands the lines to the async writer, on the thread that logs them
+        class async_dispatcher : public el::LogDispatchCallback
+        {
+        public:
+            std::shared_ptr<async_log_writer> writer;
+
+        protected:
+            void handle( el::LogDispatchData const* data ) noexcept override
+            {
+                el::LogMessage const& msg = *data->logMessage();
+                if( !writer || data->dispatchAction() != el::base::DispatchAction::NormalLog )
+                    return;
+
+                auto config = msg.logger()->typedConfigurations();
+                bool to_console = config->toStandardOutput( msg.level() );
+                bool to_file = config->toFile( msg.level() );
+                if( ( !to_console && !to_file ) || !writer->admit( level_to_severity( msg.level() ), msg.file(), msg.line(), to_console, to_file ) )
+                    return;
+
+                try
+                {
+                    bool const append_new_line = true;
+                    writer->write( msg.logger()->logBuilder()->build( &msg, append_new_line ), to_console, to_file );
+                    if( msg.level() == el::Level::Fatal )
+                        writer->flush();
+                }
+                catch( ... ) {}
+            }
+        };
+
     public:
         void remove_callbacks()
         {
@@ -12,10 +12,13 @@
 using namespace librealsense;
 
 playback_device::playback_device(std::shared_ptr<context> ctx, std::shared_ptr<device_serializer::reader> serializer) :
-    m_read_thread([]() {return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max()); }),
+    m_read_thread(std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max())),
     m_context(ctx),
     m_is_started(false),
     m_is_paused(false),
+    m_clock(std::make_shared<playback_clock>()),
+    m_clock_offset(0),
+    m_clock_offset_known(false),
     m_sample_rate(1),
     m_real_time(true),
     m_prev_timestamp(0),
@@ -27,7 +30,7 @@ playback_device::playback_device(std::shared_ptr<context> ctx, std::shared_ptr<d
     }
 
     m_reader = serializer;
-    (*m_read_thread)->start();
+    m_read_thread->start();
 
     //Read header and build device from recorded device snapshot
     m_device_description = m_reader->query_device_description(nanoseconds(0));
@@ -55,7 +58,7 @@ std::map<uint32_t, std::shared_ptr<playback_sensor>> playback_device::create_pla
 
         sensor->started += [this](uint32_t id, frame_callback_ptr user_callback) -> void
         {
-            (*m_read_thread)->invoke([this, id, user_callback](dispatcher::cancellable_timer c)
+            m_read_thread->invoke([this, id, user_callback](dispatcher::cancellable_timer c)
             {
                 auto it = m_active_sensors.find(id);
                 if (it == m_active_sensors.end())
@@ -89,7 +92,7 @@ std::map<uint32_t, std::shared_ptr<playback_sensor>> playback_device::create_pla
             };
             if (invoke_required)
             {
-                (*m_read_thread)->invoke([action](dispatcher::cancellable_timer c) { action(); });
+                m_read_thread->invoke([action](dispatcher::cancellable_timer c) { action(); });
             }
             else
             {
@@ -99,7 +102,7 @@ std::map<uint32_t, std::shared_ptr<playback_sensor>> playback_device::create_pla
 
         sensor->opened += [this](const std::vector<device_serializer::stream_identifier>& filters) -> void
         {
-            (*m_read_thread)->invoke([this, filters](dispatcher::cancellable_timer c)
+            m_read_thread->invoke([this, filters](dispatcher::cancellable_timer c)
             {
                 m_reader->enable_stream(filters);
             });
@@ -107,7 +110,7 @@ std::map<uint32_t, std::shared_ptr<playback_sensor>> playback_device::create_pla
 
         sensor->closed += [this](const std::vector<device_serializer::stream_identifier>& filters) -> void
         {
-            (*m_read_thread)->invoke([this, filters](dispatcher::cancellable_timer c)
+            m_read_thread->invoke([this, filters](dispatcher::cancellable_timer c)
             {
                 m_reader->disable_stream(filters);
             });
@@ -144,20 +147,24 @@ rs2_extrinsics playback_device::calc_extrinsic(const rs2_extrinsics& from, const
 
 playback_device::~playback_device()
 {
-    (*m_read_thread)->invoke([this](dispatcher::cancellable_timer c)
+    m_read_thread->invoke([this](dispatcher::cancellable_timer c)
     {
         for (auto&& sensor : m_active_sensors)
         {
             if (sensor.second != nullptr)
                 sensor.second->stop();
         }
+        if (m_session)
+            m_session->remove(this);
     });
-    if((*m_read_thread)->flush() == false)
+    if(m_read_thread->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
         assert(0); //Detect this immediately in debug
     }
-    (*m_read_thread)->stop();
+    //The read thread of a session is stopped with the session, once its last device is gone
+    if (!m_session)
+        m_read_thread->stop();
 }
 
 std::shared_ptr<context> playback_device::get_context() const
@@ -207,7 +214,7 @@ void playback_device::set_frame_rate(double rate)
     {
         throw invalid_value_exception(to_string() << "Failed to set frame rate to " << std::to_string(rate) << ", value is less than 0");
     }
-    (*m_read_thread)->invoke([this, rate](dispatcher::cancellable_timer t)
+    m_read_thread->invoke([this, rate](dispatcher::cancellable_timer t)
     {
         LOG_INFO("Changing playback frame rate to: " << rate);
         m_sample_rate = rate;
@@ -218,10 +225,11 @@ void playback_device::set_frame_rate(double rate)
 void playback_device::seek_to_time(std::chrono::nanoseconds time)
 {
     LOG_INFO("Request to seek to: " << time.count());
-    (*m_read_thread)->invoke([this, time](dispatcher::cancellable_timer t)
+    m_read_thread->invoke([this, time](dispatcher::cancellable_timer t)
     {
         LOG_INFO("Seek to time: " << time.count());
         m_reader->seek_to_time(time);
+        m_next_data = nullptr;
         m_device_description = m_reader->query_device_description(time);
         update_extensions(m_device_description);
         m_prev_timestamp = time; //Updating prev timestamp to make get_position return true indication even when playbakc is paused
@@ -240,7 +248,7 @@ void playback_device::seek_to_time(std::chrono::nanoseconds time)
                         LOG_ERROR(error_msg);
                     }
                     //push frame to the sensor (see handle_frame definition for more details)
-                    m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time,
+                    m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time, false,
                         []() { return device_serializer::nanoseconds(0); },
                         []() { return false; },
                         [this, time]()
@@ -252,7 +260,7 @@ void playback_device::seek_to_time(std::chrono::nanoseconds time)
             }
         }
     });
-    if ((*m_read_thread)->flush() == false)
+    if (m_read_thread->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for seek_to_time, possible deadlock detected");
         assert(0); //Detect this immediately in debug
@@ -280,7 +288,7 @@ void playback_device::pause()
         Paused  ---->  pause()   set m_is_paused  to True  ----> Do nothing
         Stopped ---->  pause()   set m_is_paused  to True  ----> Do nothing
     */
-    (*m_read_thread)->invoke([this](dispatcher::cancellable_timer t)
+    m_read_thread->invoke([this](dispatcher::cancellable_timer t)
     {
         LOG_DEBUG("Playback pause invoked");
 
@@ -300,7 +308,7 @@ void playback_device::pause()
         LOG_DEBUG("Notifying RS2_PLAYBACK_STATUS_PAUSED");
         playback_status_changed(RS2_PLAYBACK_STATUS_PAUSED);
     });
-    if ((*m_read_thread)->flush() == false)
+    if (m_read_thread->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for pause, possible deadlock detected");
         assert(0); //Detect this immediately in debug
@@ -311,7 +319,7 @@ void playback_device::pause()
 void playback_device::resume()
 {
     LOG_DEBUG("Playback resume called");
-    (*m_read_thread)->invoke([this](dispatcher::cancellable_timer t)
+    m_read_thread->invoke([this](dispatcher::cancellable_timer t)
     {
         LOG_DEBUG("Playback resume invoked");
         if (m_is_paused == false)
@@ -322,6 +330,7 @@ void playback_device::resume()
             m_last_published_timestamp = device_serializer::nanoseconds(0);
         m_reader->reset();
         m_reader->seek_to_time(m_last_published_timestamp);
+        m_next_data = nullptr;
         while (m_last_published_timestamp != device_serializer::nanoseconds(0) && !m_reader->read_next_data()->is<serialized_frame>());
 
         m_is_paused = false;
@@ -329,7 +338,7 @@ void playback_device::resume()
 
         try_looping();
     });
-    if ((*m_read_thread)->flush() == false)
+    if (m_read_thread->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for resume, possible deadlock detected");
         assert(0); //Detect this immediately in debug
@@ -348,6 +357,65 @@ bool playback_device::is_real_time() const
     return m_real_time;
 }
 
+void playback_device::set_ordered_delivery(bool ordered)
+{
+    LOG_INFO("Set ordered delivery to " << ((ordered) ? "True" : "False"));
+    m_ordered_delivery = ordered;
+}
+
+void playback_device::set_frame_cache_size(uint32_t frames)
+{
+    LOG_INFO("Request to keep the last " << frames << " frames read");
+    m_read_thread->invoke([this, frames](dispatcher::cancellable_timer t)
+    {
+        m_reader->set_frame_cache_size(frames);
+    });
+}
+
+void playback_device::join(playback_device& other)
+{
+    LOG_INFO("Request to join the playback of " << get_file_name() << " to " << other.get_file_name());
+    if (&other == this)
+        return;
+    if (m_session && m_session == other.m_session)
+        return;
+    if (m_session && other.m_session)
+        throw wrong_api_call_sequence_exception("Both playback devices already play in other sessions");
+    if (m_is_started || other.m_is_started)
+        throw wrong_api_call_sequence_exception("Playback devices can be joined only while stopped");
+
+    auto session = other.m_session ? other.m_session : m_session ? m_session : std::make_shared<playback_session>();
+    other.set_session(session);
+    set_session(session);
+}
+
+void playback_device::set_session(std::shared_ptr<playback_session> session)
+{
+    if (m_session == session)
+        return;
+
+    //Whatever was queued on the own read thread runs before the device moves to the one of the session
+    if (m_read_thread->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+    m_read_thread->stop();
+
+    m_session = session;
+    m_read_thread = session->get_read_thread();
+    m_read_thread->invoke([this](dispatcher::cancellable_timer c)
+    {
+        m_clock = m_session->get_clock();
+        m_session->add(this);
+    });
+    if (m_read_thread->flush() == false)
+    {
+        LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
+        assert(0); //Detect this immediately in debug
+    }
+}
+
 platform::backend_device_group playback_device::get_device_data() const
 {
     return platform::backend_device_group({ platform::playback_device_info{ m_reader->get_file_name() } });
@@ -365,9 +433,9 @@ bool playback_device::is_valid() const
 
 void playback_device::update_time_base(device_serializer::nanoseconds base_timestamp)
 {
-    m_base_sys_time = std::chrono::high_resolution_clock::now();
-    m_base_timestamp = base_timestamp;
-    LOG_DEBUG("Updating Time Base... m_base_sys_time " << m_base_sys_time.time_since_epoch().count() << " m_base_timestamp " << m_base_timestamp.count());
+    m_clock->base_sys_time = std::chrono::high_resolution_clock::now();
+    m_clock->base_timestamp = base_timestamp + m_clock_offset;
+    LOG_DEBUG("Updating Time Base... m_base_sys_time " << m_clock->base_sys_time.time_since_epoch().count() << " m_base_timestamp " << m_clock->base_timestamp.count());
 }
 
 device_serializer::nanoseconds playback_device::calc_sleep_time(device_serializer::nanoseconds timestamp)
@@ -377,21 +445,21 @@ device_serializer::nanoseconds playback_device::calc_sleep_time(device_serialize
     //The time to sleep returned here equals to the difference between the file recording time
     // and the playback time.
     auto now = std::chrono::high_resolution_clock::now();
-    auto play_time = now - m_base_sys_time;
+    auto play_time = now - m_clock->base_sys_time;
 
     //Sometimes the first stream skip the first frame on the ros reader
     //and the second stream go back to the first frame so its timestamp is smaller then the base timestamp
     //in this case we need to restart the m_base_timestamp again
-    if(timestamp < m_base_timestamp)
+    if(timestamp + m_clock_offset < m_clock->base_timestamp)
     {
         update_time_base(timestamp);
     }
-    auto time_diff = timestamp - m_base_timestamp;
+    auto time_diff = timestamp + m_clock_offset - m_clock->base_timestamp;
     auto recorded_time = std::chrono::duration_cast<device_serializer::nanoseconds>(time_diff / m_sample_rate.load());
 
-    LOG_DEBUG("Time Now  : " << now.time_since_epoch().count() << " ,    Time When Started: " << m_base_sys_time.time_since_epoch().count() << " , Diff: " << play_time.count() << " == " << (play_time.count() * 1e-6) << "ms");
+    LOG_DEBUG("Time Now  : " << now.time_since_epoch().count() << " ,    Time When Started: " << m_clock->base_sys_time.time_since_epoch().count() << " , Diff: " << play_time.count() << " == " << (play_time.count() * 1e-6) << "ms");
     LOG_DEBUG("Original Recording Delta: " << time_diff.count() << " == " << (time_diff.count() * 1e-6) << "ms");
-    LOG_DEBUG("Frame Time: " << timestamp.count() << "  , First Frame: " << m_base_timestamp.count() << " ,  Diff: " << recorded_time.count() << " == " << (recorded_time.count() * 1e-6) << "ms");
+    LOG_DEBUG("Frame Time: " << timestamp.count() << "  , First Frame: " << m_clock->base_timestamp.count() << " ,  Diff: " << recorded_time.count() << " == " << (recorded_time.count() * 1e-6) << "ms");
 
     if(recorded_time < play_time)
     {
@@ -426,12 +494,12 @@ void playback_device::start()
 void playback_device::stop()
 {
     LOG_DEBUG("playback stop called");
-    (*m_read_thread)->invoke([this](dispatcher::cancellable_timer t)
+    m_read_thread->invoke([this](dispatcher::cancellable_timer t)
     {
         LOG_DEBUG("playback stop invoked");
         stop_internal();
     });
-    if ((*m_read_thread)->flush() == false)
+    if (m_read_thread->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
         assert(0); //Detect this immediately in debug
@@ -454,59 +522,97 @@ void playback_device::stop_internal()
         //sensor.second->flush_pending_frames();
     }
     m_reader->reset();
+    m_next_data = nullptr;
     m_prev_timestamp = std::chrono::nanoseconds(0);
     catch_up();
     playback_status_changed(RS2_PLAYBACK_STATUS_STOPPED);
 }
 
-template <typename T>
-void playback_device::do_loop(T action)
+bool playback_device::play_next()
 {
-    (*m_read_thread)->invoke([this, action](dispatcher::cancellable_timer c)
+    bool action_succeeded = false;
+    try
     {
-        bool action_succeeded = false;
-        try
-        {
-            action_succeeded = action();
-        }
-        catch(const std::exception& e)
-        {
-            LOG_ERROR("Failed to read next frame from file: " << e.what());
-            //TODO: notify user that playback unexpectedly ended
-            action_succeeded = false; //will make the scope_guard stop the sensors, must return.
-        }
+        LOG_DEBUG("Read action invoked");
+
+        //Read next data from the serializer, unless the session already read it ahead
+        auto data = m_next_data ? m_next_data : m_reader->read_next_data();
+        m_next_data = nullptr;
+        action_succeeded = play_data(data);
+    }
+    catch(const std::exception& e)
+    {
+        LOG_ERROR("Failed to read next frame from file: " << e.what());
+        //TODO: notify user that playback unexpectedly ended
+        action_succeeded = false; //will make the scope_guard stop the sensors, must return.
+    }
 
-        //On failure, exit thread
-        if(action_succeeded == false)
+    //On failure, exit thread
+    if(action_succeeded == false)
+    {
+        for (auto s : m_active_sensors)
+            s.second->flush_pending_frames();
+
+        //Go over the sensors and stop them
+        size_t active_sensors_count = m_active_sensors.size();
+        for (size_t i = 0; i<active_sensors_count; i++)
         {
-            for (auto s : m_active_sensors)
-                s.second->flush_pending_frames();
+            if (m_active_sensors.size() == 0)
+                break;
 
-            //Go over the sensors and stop them
-            size_t active_sensors_count = m_active_sensors.size();
-            for (size_t i = 0; i<active_sensors_count; i++)
-            {
-                if (m_active_sensors.size() == 0)
-                    break;
+            //NOTE: calling stop will remove the sensor from m_active_sensors
+            m_active_sensors.begin()->second->stop(false);
+        }
 
-                //NOTE: calling stop will remove the sensor from m_active_sensors
-                m_active_sensors.begin()->second->stop(false);
-            }
+        m_last_published_timestamp = device_serializer::nanoseconds(0);
 
-            m_last_published_timestamp = device_serializer::nanoseconds(0);
+        //After all sensors were stopped, stop_internal() is called and flags m_is_started as false
+        assert(m_is_started == false);
+    }
 
-            //After all sensors were stopped, stop_internal() is called and flags m_is_started as false
-            assert(m_is_started == false);
-        }
+    //Continue looping?
+    return is_playing();
+}
 
-        //Continue looping?
-        if (m_is_started == true && m_is_paused == false)
+void playback_device::do_loop()
+{
+    m_read_thread->invoke([this](dispatcher::cancellable_timer c)
+    {
+        if (play_next())
         {
-            do_loop(action);
+            do_loop();
         }
     });
 }
 
+device_serializer::nanoseconds playback_device::peek_session_time()
+{
+    if (!m_next_data)
+        m_next_data = m_reader->read_next_data();
+
+    //The end of the file is played first, so the device stops as soon as it is reached
+    if (m_next_data->is<serialized_end_of_file>())
+        return device_serializer::nanoseconds::min();
+
+    //The file timestamps start at the beginning of each file, the system time of the first frame places the file on the
+    // time line shared by the recordings of the session
+    if (!m_clock_offset_known)
+    {
+        if (auto frame = m_next_data->as<serialized_frame>())
+        {
+            m_clock_offset_known = true;
+            auto system_time = frame->frame ? frame->frame.frame->get_frame_system_time() : 0;
+            if (system_time > 0)
+            {
+                auto system_time_ns = std::chrono::duration_cast<device_serializer::nanoseconds>(std::chrono::duration<double, std::milli>(system_time));
+                m_clock_offset = system_time_ns - frame->get_timestamp();
+            }
+            LOG_DEBUG("Clock offset of " << get_file_name() << ": " << m_clock_offset.count());
+        }
+    }
+    return m_next_data->get_timestamp() + m_clock_offset;
+}
+
 bool playback_device::prefetch_done()
 {
     for (auto s : m_active_sensors)
@@ -533,85 +639,89 @@ void playback_device::try_looping()
         }
     }
 
-    auto read_action = [this]() -> bool
+    if (m_session)
     {
-        LOG_DEBUG("Read action invoked");
+        m_session->play();
+    }
+    else
+    {
+        do_loop();
+    }
+}
 
-        //Read next data from the serializer, on success: 'obj' will be a valid object that came from
-        // sensor number 'sensor_index' with a timestamp equal to 'timestamp'
-        std::shared_ptr<serialized_data> data = m_reader->read_next_data();
-        if (data->as<serialized_end_of_file>())
-        {
-            LOG_INFO("End of file reached");
-            return false;
-        }
+bool playback_device::play_data(std::shared_ptr<device_serializer::serialized_data> data)
+{
+    //'data' came from sensor number 'sensor_index' with a timestamp equal to 'timestamp'
+    if (data->as<serialized_end_of_file>())
+    {
+        LOG_INFO("End of file reached");
+        return false;
+    }
 
-        auto timestamp = data->get_timestamp();
-        m_prev_timestamp = timestamp;
-        //Objects with timestamp of 0 are non streams.
-        if (m_base_timestamp.count() == 0)
-        {
-            //As long as m_base_timestamp is 0, update it to object's timestamp.
-            //Once a streaming object arrive, the base will change from 0
-            update_time_base(timestamp);
-        }
+    auto timestamp = data->get_timestamp();
+    m_prev_timestamp = timestamp;
+    //Objects with timestamp of 0 are non streams.
+    if (m_clock->base_timestamp.count() == 0 && timestamp.count() != 0)
+    {
+        //As long as m_base_timestamp is 0, update it to object's timestamp.
+        //Once a streaming object arrive, the base will change from 0
+        update_time_base(timestamp);
+    }
 
-        //Calculate the duration for the reader to sleep (i.e wait for next frame)
-        if (m_real_time && prefetch_done())
+    //Calculate the duration for the reader to sleep (i.e wait for next frame)
+    if (m_real_time && prefetch_done())
+    {
+        auto sleep_time = calc_sleep_time(timestamp);
+        if (sleep_time.count() > 0)
         {
-            auto sleep_time = calc_sleep_time(timestamp);
-            if (sleep_time.count() > 0)
+            if (m_sample_rate > 0)
             {
-                if (m_sample_rate > 0)
-                {
-                    LOG_DEBUG("Sleeping for: " << (sleep_time.count() * 1e-6));
-                    std::this_thread::sleep_for(sleep_time);
-                }
+                LOG_DEBUG("Sleeping for: " << (sleep_time.count() * 1e-6));
+                std::this_thread::sleep_for(sleep_time);
             }
         }
+    }
 
-        if (auto frame = data->as<serialized_frame>())
+    if (auto frame = data->as<serialized_frame>())
+    {
+        frame->frame.frame->set_blocking(!m_real_time);
+        if (frame->stream_id.device_index != get_device_index() || frame->stream_id.sensor_index >= m_sensors.size())
         {
-            frame->frame.frame->set_blocking(!m_real_time);
-            if (frame->stream_id.device_index != get_device_index() || frame->stream_id.sensor_index >= m_sensors.size())
-            {
-                std::string error_msg = to_string() << "Unexpected sensor index while playing file (Read index = " << frame->stream_id.sensor_index << ")";
-                LOG_ERROR(error_msg);
-                throw invalid_value_exception(error_msg);
-            }
-            LOG_DEBUG("Dispatching frame " << frame->stream_id);
-
-            if (data->is<serialized_invalid_frame>())
-            {
-                LOG_WARNING("Bad frame from reader, ignoring");
-                return true;
-            }
-            //Dispatch frame to the relevant sensor (see handle_frame definition for more details)
-            m_active_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time,
-                [this, timestamp]() { return calc_sleep_time(timestamp); },
-                [this]() { return m_is_paused == true; },
-                [this, timestamp]()
-                {
-                    std::lock_guard<std::mutex> locker(m_last_published_timestamp_mutex);
-                    m_last_published_timestamp = timestamp;
-                });
-            return true;
+            std::string error_msg = to_string() << "Unexpected sensor index while playing file (Read index = " << frame->stream_id.sensor_index << ")";
+            LOG_ERROR(error_msg);
+            throw invalid_value_exception(error_msg);
         }
+        LOG_DEBUG("Dispatching frame " << frame->stream_id);
 
-        if (auto option_data = data->as<serialized_option>())
+        if (data->is<serialized_invalid_frame>())
         {
-            m_sensors.at(option_data->sensor_id.sensor_index)->update_option(option_data->option_id, option_data->option);
+            LOG_WARNING("Bad frame from reader, ignoring");
             return true;
         }
+        //Dispatch frame to the relevant sensor (see handle_frame definition for more details)
+        m_active_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time, m_ordered_delivery && !m_real_time,
+            [this, timestamp]() { return calc_sleep_time(timestamp); },
+            [this]() { return m_is_paused == true; },
+            [this, timestamp]()
+            {
+                std::lock_guard<std::mutex> locker(m_last_published_timestamp_mutex);
+                m_last_published_timestamp = timestamp;
+            });
+        return true;
+    }
 
-        if (auto notification_data = data->as<serialized_notification>())
-        {
-            m_sensors.at(notification_data->sensor_id.sensor_index)->raise_notification(notification_data->notif);
-            return true;
-        }
-        return false;
-    };
-    do_loop(read_action);
+    if (auto option_data = data->as<serialized_option>())
+    {
+        m_sensors.at(option_data->sensor_id.sensor_index)->update_option(option_data->option_id, option_data->option);
+        return true;
+    }
+
+    if (auto notification_data = data->as<serialized_notification>())
+    {
+        m_sensors.at(notification_data->sensor_id.sensor_index)->raise_notification(notification_data->notif);
+        return true;
+    }
+    return false;
 }
 
 const std::string& playback_device::get_file_name() const
@@ -625,7 +735,7 @@ uint64_t playback_device::get_position() const
 }
 void playback_device::catch_up()
 {
-    m_base_timestamp = std::chrono::microseconds(0);
+    m_clock->base_timestamp = std::chrono::microseconds(0);
     LOG_DEBUG("Catching up");
 }
 
@@ -11,6 +11,7 @@
 #include "concurrency.h"
 #include "sensor.h"
 #include "playback_sensor.h"
+#include "playback_session.h"
 
 namespace librealsense
 {
@@ -40,6 +41,9 @@ namespace librealsense
         void stop();
         void set_real_time(bool real_time);
         bool is_real_time() const;
+        void set_ordered_delivery(bool ordered);
+        void set_frame_cache_size(uint32_t frames);
+        void join(playback_device& other);
         const std::string& get_file_name() const;
         uint64_t get_position() const;
         signal<playback_device, rs2_playback_status> playback_status_changed;
@@ -58,13 +62,20 @@ namespace librealsense
         bool compress_while_record() const override { return true; }
         bool contradicts(const stream_profile_interface* a, const std::vector<stream_profile>& others) const override { return false; }
 
+        // Called by the session on the read thread
+        bool is_playing() const { return m_is_started && !m_is_paused; }
+        device_serializer::nanoseconds peek_session_time();
+        bool play_next();
+
     private:
         void update_time_base(device_serializer::nanoseconds base_timestamp);
         device_serializer::nanoseconds calc_sleep_time(device_serializer::nanoseconds  timestamp);
         void start();
         void stop_internal();
         void try_looping();
-        template <typename T> void do_loop(T op);
+        void do_loop();
+        bool play_data(std::shared_ptr<device_serializer::serialized_data> data);
+        void set_session(std::shared_ptr<playback_session> session);
         std::map<uint32_t, std::shared_ptr<playback_sensor>> create_playback_sensors(const device_serializer::device_snapshot& device_description);
         std::shared_ptr<stream_profile_interface> get_stream(const std::map<unsigned, std::shared_ptr<playback_sensor>>& sensors_map, device_serializer::stream_identifier stream_id);
         rs2_extrinsics calc_extrinsic(const rs2_extrinsics& from, const rs2_extrinsics& to);
@@ -75,18 +86,22 @@ namespace librealsense
         bool prefetch_done();
 
     private:
-        lazy<std::shared_ptr<dispatcher>> m_read_thread;
+        std::shared_ptr<dispatcher> m_read_thread;
+        std::shared_ptr<playback_session> m_session;
         std::shared_ptr<context> m_context;
         std::shared_ptr<device_serializer::reader> m_reader;
         device_serializer::device_snapshot m_device_description;
         std::atomic_bool m_is_started;
         std::atomic_bool m_is_paused;
-        std::chrono::high_resolution_clock::time_point m_base_sys_time; // !< System time when reading began (first frame was read)
-        device_serializer::nanoseconds m_base_timestamp; // !< Timestamp of the first frame that has a real timestamp (different than 0)
+        std::shared_ptr<playback_clock> m_clock;
+        std::shared_ptr<device_serializer::serialized_data> m_next_data; // !< Read ahead by the session to order the devices
+        device_serializer::nanoseconds m_clock_offset; // !< From the file timestamps to the clock of the session
+        bool m_clock_offset_known;
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_sensors;
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_active_sensors;
         std::atomic<double> m_sample_rate;
         std::atomic_bool m_real_time;
+        std::atomic_bool m_ordered_delivery{ false };
         device_serializer::nanoseconds m_prev_timestamp;
         std::vector<std::shared_ptr<lazy<rs2_extrinsics>>> m_extrinsics_fetchers;
         std::map<int, std::pair<uint32_t, rs2_extrinsics>> m_extrinsics_map;
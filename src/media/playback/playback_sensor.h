@@ -96,8 +96,10 @@ namespace librealsense
         //is_paused - check if the playback was paused while waiting for the frame publish time.
         //update_last_pushed_frame - lets the playback device know that a specific frame was published,
         // the playback device will use this info to determine which frames should be played next in a pause/resume scenario.
+        //is_ordered - publish the frame on the calling thread instead of the stream's dispatcher, so all the streams
+        // are published one at a time in the order they were read.
         template <class T, class K, class P>
-        void handle_frame(frame_holder frame, bool is_real_time, T calc_sleep, K is_paused, P update_last_pushed_frame)
+        void handle_frame(frame_holder frame, bool is_real_time, bool is_ordered, T calc_sleep, K is_paused, P update_last_pushed_frame)
         {
             if (frame == nullptr)
             {
@@ -111,6 +113,22 @@ namespace librealsense
                 frame->set_stream(m_streams[std::make_pair(type, index)]);
                 frame->set_sensor(shared_from_this());
                 auto stream_id = frame.frame->get_stream()->get_unique_id();
+                if (is_ordered)
+                {
+                    frame_callback_ptr user_callback;
+                    {
+                        std::lock_guard<std::mutex> l(m_mutex);
+                        user_callback = m_user_callback;
+                    }
+                    if (!user_callback || is_paused())
+                        return;
+
+                    frame_interface* pframe = nullptr;
+                    std::swap(frame.frame, pframe);
+                    user_callback->on_frame((rs2_frame*)pframe);
+                    update_last_pushed_frame();
+                    return;
+                }
                 //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
                 auto pf = std::make_shared<frame_holder>(std::move(frame));
 
@@ -0,0 +1,83 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <algorithm>
+#include <limits>
+#include "playback_session.h"
+#include "playback_device.h"
+
+using namespace librealsense;
+
+playback_session::playback_session() :
+    m_read_thread(std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max())),
+    m_clock(std::make_shared<playback_clock>()),
+    m_is_playing(false)
+{
+    m_read_thread->start();
+}
+
+playback_session::~playback_session()
+{
+    m_read_thread->stop();
+}
+
+void playback_session::add(playback_device* device)
+{
+    if (std::find(m_devices.begin(), m_devices.end(), device) == m_devices.end())
+        m_devices.push_back(device);
+}
+
+void playback_session::remove(playback_device* device)
+{
+    m_devices.erase(std::remove(m_devices.begin(), m_devices.end(), device), m_devices.end());
+}
+
+void playback_session::play()
+{
+    if (m_is_playing)
+        return;
+
+    m_is_playing = true;
+    loop();
+}
+
+void playback_session::loop()
+{
+    m_read_thread->invoke([this](dispatcher::cancellable_timer c)
+    {
+        playback_device* next = nullptr;
+        auto next_time = device_serializer::nanoseconds::max();
+        for (auto device : m_devices)
+        {
+            if (!device->is_playing())
+                continue;
+
+            device_serializer::nanoseconds time;
+            try
+            {
+                time = device->peek_session_time();
+            }
+            catch (const std::exception& e)
+            {
+                //Playing the device reads again and stops it on the same failure
+                LOG_ERROR("Failed to read next data from " << device->get_file_name() << ": " << e.what());
+                time = device_serializer::nanoseconds::min();
+            }
+
+            if (next == nullptr || time < next_time)
+            {
+                next = device;
+                next_time = time;
+            }
+        }
+
+        if (next == nullptr)
+        {
+            m_is_playing = false;
+            return;
+        }
+
+        next->play_next();
+        loop();
+    });
+}
@@ -0,0 +1,52 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <core/serialization.h>
+#include "concurrency.h"
+
+namespace librealsense
+{
+    class playback_device;
+
+    // Time base of the real time pacing, owned by a playback device or shared by the devices of a session
+    struct playback_clock
+    {
+        std::chrono::high_resolution_clock::time_point base_sys_time; // !< System time when reading began (first frame was read)
+        device_serializer::nanoseconds base_timestamp{ 0 }; // !< Timestamp of the first frame that has a real timestamp (different than 0)
+    };
+
+    /*
+        Plays several playback devices on a single read thread and a single clock.
+        Each pass of the loop plays the next data of the member whose next data is the earliest, the timestamps of the files
+        are placed on the recorded system time of their first frame, so the recordings of a rig of cameras are played in the
+        order they were captured. All the members are paced against the same time base in real time mode, and publish
+        their frames in that single order in non real time mode with ordered delivery.
+        The members, the loop and the clock are accessed on the read thread only
+    */
+    class playback_session
+    {
+    public:
+        playback_session();
+        ~playback_session();
+
+        std::shared_ptr<dispatcher> get_read_thread() const { return m_read_thread; }
+        std::shared_ptr<playback_clock> get_clock() const { return m_clock; }
+
+        void add(playback_device* device);
+        void remove(playback_device* device);
+        // Starts the loop unless it already runs, the loop ends once no member plays
+        void play();
+
+    private:
+        void loop();
+
+        std::shared_ptr<dispatcher> m_read_thread;
+        std::shared_ptr<playback_clock> m_clock;
+        std::vector<playback_device*> m_devices;
+        bool m_is_playing;
+    };
+}
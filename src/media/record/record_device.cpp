@@ -12,8 +12,13 @@ using namespace librealsense;
 librealsense::record_device::record_device(std::shared_ptr<librealsense::device_interface> device,
                                       std::shared_ptr<librealsense::device_serializer::writer> serializer):
     m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());}),
+    m_file_per_stream(false),
     m_is_recording(true),
-    m_record_pause_time(0)
+    m_record_pause_time(0),
+    m_cached_data_size(0),
+    m_blocking_write(false),
+    m_frames_written(0),
+    m_frames_dropped(0)
 {
     if (device == nullptr)
     {
@@ -60,6 +65,14 @@ librealsense::record_device::~record_device()
         s->on_extension_change -= m_on_extension_change_token;
         s->disable_recording();
     }
+    for (auto&& stream_thread : m_stream_write_threads)
+    {
+        if (stream_thread.second->flush() == false)
+        {
+            LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
+        }
+        stream_thread.second->stop();
+    }
     if ((*m_write_thread)->flush() == false)
     {
         LOG_ERROR("Error - timeout waiting for flush, possible deadlock detected");
@@ -124,53 +137,297 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
         initialize_recording();
     });
 
-    //TODO: restore: uint64_t data_size = frame.frame->get_frame_data_size();
-    uint64_t cached_data_size = m_cached_data_size; //TODO: restore: (+ data_size)
-    if (cached_data_size > MAX_CACHED_DATA_SIZE)
+    auto capture_time = get_capture_time();
+    auto stream = frame ? frame.frame->get_stream()->get_stream_type() : RS2_STREAM_ANY;
+    std::shared_ptr<processing_block_interface> processing;
+    std::shared_ptr<single_consumer_frame_queue<frame_holder>> processed;
+    if (frame)
+    {
+        std::lock_guard<std::mutex> lock(m_policies_mutex);
+        auto it = m_stream_policies.find(stream);
+        if (it != m_stream_policies.end())
+        {
+            auto& policy = it->second;
+            if (policy.arrived++ % policy.every_nth != 0)
+                return; //Not recorded, the frame was already raised to the user
+            processing = policy.processing;
+            processed = policy.processed;
+        }
+    }
+
+    if (!processing)
+    {
+        record_processed_frame(sensor_index, stream, std::move(frame), capture_time, on_error);
+        return;
+    }
+
+    // The frames of a stream arrive from a single sensor thread, so the block's outputs of this frame are the ones queued by the invoke
+    try
+    {
+        processing->invoke(std::move(frame));
+    }
+    catch (const std::exception& e)
+    {
+        on_error(to_string() << "Failed to process frame for recording. " << e.what());
+        return;
+    }
+    frame_holder output;
+    while (processed->try_dequeue(&output))
+    {
+        if (auto composite = As<composite_frame>(output.frame))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+            {
+                auto embedded = composite->get_frame(static_cast<int>(i));
+                embedded->acquire();
+                record_processed_frame(sensor_index, stream, frame_holder(embedded), capture_time, on_error);
+            }
+        }
+        else
+        {
+            record_processed_frame(sensor_index, stream, std::move(output), capture_time, on_error);
+        }
+    }
+}
+
+// Records a frame of the stream, or an output of its processing block
+void librealsense::record_device::record_processed_frame(size_t sensor_index, rs2_stream stream, frame_holder frame, std::chrono::nanoseconds capture_time, std::function<void(std::string const&)> on_error)
+{
+    if (frame)
+    {
+        std::lock_guard<std::mutex> lock(m_policies_mutex);
+        auto it = m_stream_policies.find(stream);
+        if (it != m_stream_policies.end())
+        {
+            auto& policy = it->second;
+            // The profile of processed frames is written in place of the live one, before the first of them
+            auto profile = frame.frame->get_stream();
+            if (policy.processing && m_processed_profiles.insert(profile->get_unique_id()).second)
+                write_stream_profile(sensor_index, profile, on_error);
+
+            if (policy.triggered && capture_time > policy.record_until)
+            {
+                // Held frames own a copy of their data, like the queued ones
+                frame.frame->keep();
+                policy.pre_trigger_frames.push_back({ sensor_index, capture_time, std::move(frame), on_error });
+                while (policy.pre_trigger_frames.front().capture_time < capture_time - policy.pre_trigger)
+                    policy.pre_trigger_frames.pop_front();
+                return;
+            }
+        }
+    }
+    enqueue_frame(sensor_index, std::move(frame), capture_time, true, on_error);
+}
+
+void librealsense::record_device::enqueue_frame(size_t sensor_index, frame_holder frame, std::chrono::nanoseconds capture_time, bool reserve, std::function<void(std::string const&)> on_error)
+{
+    // Frames held for a trigger are already in memory, they are queued without a reservation
+    uint64_t data_size = frame && reserve ? frame.frame->get_frame_data_size() : 0;
+    if (reserve && !reserve_cached_data(data_size))
     {
+        ++m_frames_dropped;
         LOG_WARNING("Recorder reached maximum cache size, frame dropped");
         on_error("Recorder reached maximum cache size, frame dropped");
         return;
     }
 
-    m_cached_data_size = cached_data_size;
-    auto capture_time = get_capture_time();
+    // Waiting frames own a copy of their data, so a slow disk doesn't hold the capture buffers
+    if (frame)
+        frame.frame->keep();
+
+    const uint32_t device_index = 0;
+    device_serializer::stream_identifier stream_id{ device_index, static_cast<uint32_t>(sensor_index), RS2_STREAM_ANY, 0 };
+    if (frame)
+    {
+        stream_id.stream_type = frame.frame->get_stream()->get_stream_type();
+        stream_id.stream_index = static_cast<uint32_t>(frame.frame->get_stream()->get_stream_index());
+    }
+
     //TODO: remove usage of shared pointer when frame_holder is copyable
     auto frame_holder_ptr = std::make_shared<frame_holder>();
     *frame_holder_ptr = std::move(frame);
-    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time/*, data_size*/, on_error](dispatcher::cancellable_timer t) {
+    get_write_thread(stream_id)->invoke([this, frame_holder_ptr, stream_id, capture_time, data_size, on_error](dispatcher::cancellable_timer t) {
         if (m_is_recording == false)
         {
+            release_cached_data(data_size);
             return; //Recording is paused
         }
         std::call_once(m_first_frame_flag, [&]()
         {
-            try
+            auto header = [this, on_error](dispatcher::cancellable_timer)
             {
-                write_header();
-            }
-            catch (const std::exception& e)
+                try
+                {
+                    write_header();
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Failed to write header. " << e.what());
+                    on_error(to_string() << "Failed to write header. " << e.what());
+                }
+            };
+            // The other writes to the file of the device run on the recorder's thread, the frames of the streams wait for the header there
+            if (get_write_thread(stream_id) != *m_write_thread)
             {
-                LOG_ERROR("Failed to write header. " << e.what());
-                on_error(to_string() << "Failed to write header. " << e.what());
+                (*m_write_thread)->invoke(header);
+                (*m_write_thread)->flush();
             }
+            else
+                header(t);
         });
 
         try
         {
-            const uint32_t device_index = 0;
-            auto stream_type = frame_holder_ptr->frame->get_stream()->get_stream_type();
-            auto stream_index = static_cast<uint32_t>(frame_holder_ptr->frame->get_stream()->get_stream_index());
-            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(*frame_holder_ptr));
-            //TODO: restore: std::lock_guard<std::mutex> locker(m_mutex);  m_cached_data_size -= data_size;
+            m_ros_writer->write_frame(stream_id, capture_time, std::move(*frame_holder_ptr));
+            ++m_frames_written;
         }
         catch(std::exception& e)
         {
             on_error(to_string() << "Failed to write frame. " << e.what());
         }
+        release_cached_data(data_size);
+    });
+}
+
+// The recorder's thread writes the description, the options and the notifications, and with a single file the frames too
+std::shared_ptr<dispatcher> librealsense::record_device::get_write_thread(const device_serializer::stream_identifier& stream_id)
+{
+    if (!m_file_per_stream)
+        return *m_write_thread;
+
+    std::lock_guard<std::mutex> lock(m_stream_write_threads_mutex);
+    auto& stream_thread = m_stream_write_threads[stream_id];
+    if (!stream_thread)
+    {
+        stream_thread = std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());
+        stream_thread->start();
+    }
+    return stream_thread;
+}
+
+void librealsense::record_device::set_file_per_stream(bool file_per_stream)
+{
+    m_ros_writer->set_file_per_stream(file_per_stream);
+    m_file_per_stream = file_per_stream;
+}
+
+void librealsense::record_device::write_stream_profile(size_t sensor_index, std::shared_ptr<stream_profile_interface> profile, std::function<void(std::string const&)> on_error)
+{
+    rs2_extension extension_type;
+    if (Is<video_stream_profile_interface>(profile))
+        extension_type = RS2_EXTENSION_VIDEO_PROFILE;
+    else if (Is<motion_stream_profile_interface>(profile))
+        extension_type = RS2_EXTENSION_MOTION_PROFILE;
+    else if (Is<pose_stream_profile_interface>(profile))
+        extension_type = RS2_EXTENSION_POSE_PROFILE;
+    else
+    {
+        LOG_WARNING("Unsupported processed stream " << profile->get_stream_type() << ", its profile is not recorded");
+        return;
+    }
+    std::shared_ptr<stream_profile_interface> snapshot;
+    profile->create_snapshot(snapshot);
+    auto capture_time = get_capture_time();
+    (*m_write_thread)->invoke([this, sensor_index, capture_time, extension_type, snapshot, on_error](dispatcher::cancellable_timer t)
+    {
+        try
+        {
+            const uint32_t device_index = 0;
+            m_ros_writer->write_snapshot({ device_index, static_cast<uint32_t>(sensor_index) }, capture_time, extension_type, std::dynamic_pointer_cast<extension_snapshot>(snapshot));
+        }
+        catch (const std::exception& e)
+        {
+            on_error(e.what());
+        }
     });
 }
 
+void librealsense::record_device::set_stream_decimation(rs2_stream stream, int every_nth)
+{
+    std::lock_guard<std::mutex> lock(m_policies_mutex);
+    auto& policy = m_stream_policies[stream];
+    policy.every_nth = every_nth;
+    policy.arrived = 0;
+}
+
+void librealsense::record_device::set_stream_processing(rs2_stream stream, std::shared_ptr<processing_block_interface> block)
+{
+    std::lock_guard<std::mutex> lock(m_policies_mutex);
+    if (m_described_streams.count(stream))
+        throw wrong_api_call_sequence_exception(to_string() << "The processing of " << stream << " must be set before the stream is opened");
+
+    auto& policy = m_stream_policies[stream];
+    policy.processing = block;
+    policy.processed = nullptr;
+    if (block)
+    {
+        auto processed = std::make_shared<single_consumer_frame_queue<frame_holder>>();
+        auto on_output = [processed](frame_interface* f) { processed->enqueue(frame_holder(f)); };
+        block->set_output_callback(std::make_shared<internal_frame_callback<decltype(on_output)>>(on_output));
+        policy.processed = processed;
+    }
+}
+
+void librealsense::record_device::set_stream_trigger(rs2_stream stream, std::chrono::nanoseconds pre_trigger, std::chrono::nanoseconds post_trigger)
+{
+    std::lock_guard<std::mutex> lock(m_policies_mutex);
+    auto& policy = m_stream_policies[stream];
+    policy.triggered = true;
+    policy.pre_trigger = pre_trigger;
+    policy.post_trigger = post_trigger;
+}
+
+void librealsense::record_device::trigger()
+{
+    auto now = get_capture_time();
+    std::lock_guard<std::mutex> lock(m_policies_mutex);
+    for (auto&& kvp : m_stream_policies)
+    {
+        auto& policy = kvp.second;
+        if (!policy.triggered)
+            continue;
+        // Queued under the lock, so frames arriving meanwhile are written after the held ones
+        for (auto&& held : policy.pre_trigger_frames)
+            enqueue_frame(held.sensor_index, std::move(held.frame), held.capture_time, false, held.on_error);
+        policy.pre_trigger_frames.clear();
+        policy.record_until = now + policy.post_trigger;
+    }
+}
+
+void librealsense::record_device::clear_stream_policy(rs2_stream stream)
+{
+    std::lock_guard<std::mutex> lock(m_policies_mutex);
+    auto it = m_stream_policies.find(stream);
+    if (it == m_stream_policies.end())
+        return;
+    if (it->second.processing && m_described_streams.count(stream))
+        throw wrong_api_call_sequence_exception(to_string() << "The processing of " << stream << " can't be removed after the stream is opened");
+    m_stream_policies.erase(it);
+}
+
+bool librealsense::record_device::reserve_cached_data(uint64_t data_size)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // A frame larger than the whole cache is accepted once the cache is empty
+    auto fits = [&]() { return m_cached_data_size == 0 || m_cached_data_size + data_size <= MAX_CACHED_DATA_SIZE; };
+    if (!fits())
+    {
+        if (!m_blocking_write || !m_cache_cv.wait_for(lock, std::chrono::milliseconds(MAX_BLOCKING_WRITE_MS), fits))
+            return false;
+    }
+    m_cached_data_size += data_size;
+    return true;
+}
+
+void librealsense::record_device::release_cached_data(uint64_t data_size)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cached_data_size -= data_size;
+    }
+    m_cache_cv.notify_all();
+}
+
 const std::string& librealsense::record_device::get_info(rs2_camera_info info) const
 {
     return m_device->get_info(info);
@@ -294,6 +551,16 @@ void record_device::write_sensor_extension_snapshot(size_t sensor_index,
     std::shared_ptr<extension_snapshot> snapshot,
     std::function<void(std::string const&)> on_error)
 {
+    if (auto profile = As<stream_profile_interface>(snapshot))
+    {
+        std::lock_guard<std::mutex> lock(m_policies_mutex);
+        auto stream = profile->get_stream_type();
+        m_described_streams.insert(stream);
+        auto it = m_stream_policies.find(stream);
+        if (it != m_stream_policies.end() && it->second.processing)
+            return; //The profile of the processed frames is written instead
+    }
+
     auto capture_time = get_capture_time();
     (*m_write_thread)->invoke([this, sensor_index, capture_time, ext, snapshot, on_error](dispatcher::cancellable_timer t)
     {
@@ -424,7 +691,6 @@ void record_device::initialize_recording()
 {
     //Expected to be called once when recording to file actually starts
     m_capture_time_base = std::chrono::high_resolution_clock::now();
-    m_cached_data_size = 0;
 }
 void record_device::stop_gracefully(to_string error_msg)
 {
@@ -9,6 +9,7 @@
 #include "archive.h"
 #include "concurrency.h"
 #include "sensor.h"
+#include "core/processing.h"
 #include "record_sensor.h"
 
 namespace librealsense
@@ -19,6 +20,8 @@ namespace librealsense
     {
     public:
         static const uint64_t MAX_CACHED_DATA_SIZE = 1920 * 1080 * 4 * 30; // ~1 sec of HD video @ 30 FPS
+        // Longest time a blocking write waits for the writer thread before the frame is dropped
+        static const int MAX_BLOCKING_WRITE_MS = 1000;
 
         record_device(std::shared_ptr<device_interface> device, std::shared_ptr<device_serializer::writer> serializer);
         virtual ~record_device();
@@ -39,6 +42,18 @@ namespace librealsense
         void pause_recording();
         void resume_recording();
         const std::string& get_filename() const;
+        // When set, a frame arriving while the cache is full waits for the writer thread instead of being dropped
+        void set_blocking_write(bool blocking) { m_blocking_write = blocking; }
+        uint64_t get_written_frames() const { return m_frames_written; }
+        uint64_t get_dropped_frames() const { return m_frames_dropped; }
+        void set_frame_compression(rs2_stream stream, rs2_frame_compression compression) { m_ros_writer->set_frame_compression(stream, compression); }
+        // Writes every stream to a file of its own on a thread of its own, so the streams are compressed and written in parallel
+        void set_file_per_stream(bool file_per_stream);
+        void set_stream_decimation(rs2_stream stream, int every_nth);
+        void set_stream_processing(rs2_stream stream, std::shared_ptr<processing_block_interface> block);
+        void set_stream_trigger(rs2_stream stream, std::chrono::nanoseconds pre_trigger, std::chrono::nanoseconds post_trigger);
+        void trigger();
+        void clear_stream_policy(rs2_stream stream);
         platform::backend_device_group get_device_data() const override;
         std::pair<uint32_t, rs2_extrinsics> get_extrinsics(const stream_interface& stream) const override;
         bool is_valid() const override;
@@ -49,12 +64,39 @@ namespace librealsense
         bool contradicts(const stream_profile_interface* a, const std::vector<stream_profile>& others) const override { return m_device->contradicts(a, others); }
 
     private:
+        // A frame held in memory until a trigger writes it
+        struct held_frame
+        {
+            size_t sensor_index;
+            std::chrono::nanoseconds capture_time;
+            frame_holder frame;
+            std::function<void(std::string const&)> on_error;
+        };
+
+        // How the frames of a stream are recorded, streams without a policy are recorded frame by frame
+        struct stream_policy
+        {
+            int every_nth = 1;
+            uint64_t arrived = 0;
+            std::shared_ptr<processing_block_interface> processing;
+            std::shared_ptr<single_consumer_frame_queue<frame_holder>> processed;
+            bool triggered = false;
+            std::chrono::nanoseconds pre_trigger{ 0 };
+            std::chrono::nanoseconds post_trigger{ 0 };
+            std::chrono::nanoseconds record_until{ -1 };
+            std::deque<held_frame> pre_trigger_frames;
+        };
+
         template <typename T> void write_device_extension_changes(const T& ext);
         template <rs2_extension E, typename P> bool extend_to_aux(std::shared_ptr<P> p, void** ext);
 
         void write_header();
         std::chrono::nanoseconds get_capture_time() const;
         void write_data(size_t sensor_index, frame_holder f, std::function<void(std::string const&)> on_error);
+        void record_processed_frame(size_t sensor_index, rs2_stream stream, frame_holder f, std::chrono::nanoseconds capture_time, std::function<void(std::string const&)> on_error);
+        void enqueue_frame(size_t sensor_index, frame_holder f, std::chrono::nanoseconds capture_time, bool reserve, std::function<void(std::string const&)> on_error);
+        std::shared_ptr<dispatcher> get_write_thread(const device_serializer::stream_identifier& stream_id);
+        void write_stream_profile(size_t sensor_index, std::shared_ptr<stream_profile_interface> profile, std::function<void(std::string const&)> on_error);
         void write_sensor_extension_snapshot(size_t sensor_index, rs2_extension ext, std::shared_ptr<extension_snapshot> snapshot, std::function<void(std::string const&)> on_error);
         void write_notification(size_t sensor_index, const notification& n);
         std::vector<std::shared_ptr<record_sensor>> create_record_sensors(std::shared_ptr<device_interface> m_device);
@@ -64,6 +106,9 @@ namespace librealsense
         std::vector<std::shared_ptr<record_sensor>> m_sensors;
 
         lazy<std::shared_ptr<dispatcher>> m_write_thread;
+        std::atomic<bool> m_file_per_stream;
+        std::mutex m_stream_write_threads_mutex;
+        std::map<device_serializer::stream_identifier, std::shared_ptr<dispatcher>> m_stream_write_threads; // frames of each stream, with a file per stream
         std::shared_ptr<device_serializer::writer> m_ros_writer;
 
         std::chrono::high_resolution_clock::time_point m_capture_time_base;
@@ -71,12 +116,22 @@ namespace librealsense
         std::chrono::high_resolution_clock::time_point m_time_of_pause;
 
         std::mutex m_mutex;
-        bool m_is_recording;
+        std::atomic<bool> m_is_recording;
         std::once_flag m_first_frame_flag;
         int m_on_notification_token;
         int m_on_frame_token;
         int m_on_extension_change_token;
-        uint64_t m_cached_data_size;
+        uint64_t m_cached_data_size; // guarded by m_mutex
+        std::condition_variable m_cache_cv;
+        std::atomic<bool> m_blocking_write;
+        std::atomic<uint64_t> m_frames_written;
+        std::atomic<uint64_t> m_frames_dropped;
+        bool reserve_cached_data(uint64_t data_size);
+        void release_cached_data(uint64_t data_size);
+        std::mutex m_policies_mutex;
+        std::map<rs2_stream, stream_policy> m_stream_policies; // guarded by m_policies_mutex
+        std::set<rs2_stream> m_described_streams; // streams whose profile was written, guarded by m_policies_mutex
+        std::set<int> m_processed_profiles; // unique ids of the processed profiles written, guarded by m_policies_mutex
         std::once_flag m_first_call_flag;
         void initialize_recording();
         void stop_gracefully(to_string error_msg);
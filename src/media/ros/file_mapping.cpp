@@ -0,0 +1,86 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "file_mapping.h"
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace librealsense
+{
+#ifdef _WIN32
+    file_mapping::file_mapping(const std::string& path)
+    {
+        auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw io_exception(to_string() << "Failed to open " << path << " for mapping, error " << GetLastError());
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || uint64_t(size.QuadPart) > (std::numeric_limits<size_t>::max)())
+        {
+            CloseHandle(file);
+            throw io_exception(to_string() << "File " << path << " does not fit the address space");
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        auto data = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+        if (!data)
+        {
+            auto error = GetLastError();
+            if (mapping) CloseHandle(mapping);
+            CloseHandle(file);
+            throw io_exception(to_string() << "Failed to map " << path << ", error " << error);
+        }
+
+        _file = file;
+        _mapping = mapping;
+        _data = static_cast<byte*>(data);
+        _size = static_cast<size_t>(size.QuadPart);
+    }
+
+    file_mapping::~file_mapping()
+    {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+    }
+#else
+    file_mapping::file_mapping(const std::string& path)
+    {
+        auto fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw io_exception(to_string() << "Failed to open " << path << " for mapping, error " << errno);
+
+        struct stat st;
+        if (fstat(fd, &st) < 0 || st.st_size <= 0 || uint64_t(st.st_size) > (std::numeric_limits<size_t>::max)())
+        {
+            close(fd);
+            throw io_exception(to_string() << "File " << path << " cannot be mapped");
+        }
+
+        auto size = static_cast<size_t>(st.st_size);
+        auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        auto error = errno;
+        // The mapping holds its own reference to the file
+        close(fd);
+        if (data == MAP_FAILED)
+            throw io_exception(to_string() << "Failed to map " << path << ", error " << error);
+
+        _data = static_cast<byte*>(data);
+        _size = size;
+    }
+
+    file_mapping::~file_mapping()
+    {
+        munmap(_data, _size);
+    }
+#endif
+}
@@ -0,0 +1,34 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+#include "types.h"
+
+namespace librealsense
+{
+    // Copy on write mapping of a whole file, frames read from the file can point into it instead of copying.
+    // Writes through the mapping stay private to the process and never reach the file
+    class file_mapping
+    {
+    public:
+        // Throws io_exception if the file cannot be mapped, e.g. when it does not fit the address space
+        explicit file_mapping(const std::string& path);
+        ~file_mapping();
+
+        file_mapping(const file_mapping&) = delete;
+        file_mapping& operator=(const file_mapping&) = delete;
+
+        const byte* data() const { return _data; }
+        size_t size() const { return _size; }
+
+    private:
+        byte* _data = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,490 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "frame_compression.h"
+#include <cstring>
+#include "../../../third-party/realsense-file/lz4/lz4.h"
+
+#ifdef RS2_USE_JPEG_TURBO
+#include <cstdio>
+#include <csetjmp>
+#include <jpeglib.h>
+#endif
+
+namespace librealsense
+{
+    static const char* CODEC_SEPARATOR = "; ";
+    static const int JPEG_QUALITY = 90;
+
+    // RVL (A. Wilson, "Fast Lossless Depth Image Compression", 2017): runs of zeros and of non zero pixels,
+    // the non zero pixels as zigzag deltas, all written as variable length values of 3 bit nibbles packed in 32 bit words
+    class rvl_encoder
+    {
+    public:
+        explicit rvl_encoder(std::vector<uint8_t>& dst) : _dst(dst) {}
+
+        void put(uint32_t value)
+        {
+            do
+            {
+                uint32_t nibble = value & 0x7;
+                if (value >>= 3)
+                    nibble |= 0x8;
+                _word = (_word << 4) | nibble;
+                if (++_nibbles == 8)
+                    flush();
+            } while (value);
+        }
+
+        void finish()
+        {
+            if (_nibbles)
+            {
+                _word <<= 4 * (8 - _nibbles);
+                flush();
+            }
+        }
+
+    private:
+        void flush()
+        {
+            uint8_t bytes[sizeof(_word)];
+            memcpy(bytes, &_word, sizeof(_word));
+            _dst.insert(_dst.end(), bytes, bytes + sizeof(_word));
+            _word = 0;
+            _nibbles = 0;
+        }
+
+        std::vector<uint8_t>& _dst;
+        uint32_t _word = 0;
+        int _nibbles = 0;
+    };
+
+    class rvl_decoder
+    {
+    public:
+        rvl_decoder(const byte* src, size_t size) : _src(src), _size(size) {}
+
+        uint32_t get()
+        {
+            uint32_t value = 0;
+            uint32_t nibble;
+            int shift = 0;
+            do
+            {
+                if (!_nibbles)
+                {
+                    if (_pos + sizeof(_word) > _size)
+                        throw io_exception("Corrupt RVL image, the data ended early");
+                    memcpy(&_word, _src + _pos, sizeof(_word));
+                    _pos += sizeof(_word);
+                    _nibbles = 8;
+                }
+                if (shift >= 32)
+                    throw io_exception("Corrupt RVL image, value out of range");
+                nibble = _word >> 28;
+                _word <<= 4;
+                --_nibbles;
+                value |= (nibble & 0x7) << shift;
+                shift += 3;
+            } while (nibble & 0x8);
+            return value;
+        }
+
+    private:
+        const byte* _src;
+        size_t _size;
+        size_t _pos = 0;
+        uint32_t _word = 0;
+        int _nibbles = 0;
+    };
+
+    static void compress_rvl(const uint16_t* src, size_t count, std::vector<uint8_t>& dst)
+    {
+        rvl_encoder encoder(dst);
+        uint16_t previous = 0;
+        size_t i = 0;
+        while (i < count)
+        {
+            uint32_t zeros = 0;
+            for (; i < count && !src[i]; ++i)
+                ++zeros;
+            encoder.put(zeros);
+
+            uint32_t nonzeros = 0;
+            while (i + nonzeros < count && src[i + nonzeros])
+                ++nonzeros;
+            encoder.put(nonzeros);
+
+            for (uint32_t k = 0; k < nonzeros; ++k)
+            {
+                auto current = src[i++];
+                int delta = int(current) - int(previous);
+                encoder.put((uint32_t(delta) << 1) ^ uint32_t(delta >> 31));
+                previous = current;
+            }
+        }
+        encoder.finish();
+    }
+
+    static void decompress_rvl(const byte* src, size_t size, uint16_t* dst, size_t count)
+    {
+        rvl_decoder decoder(src, size);
+        uint16_t previous = 0;
+        while (count)
+        {
+            auto zeros = decoder.get();
+            if (zeros > count)
+                throw io_exception("Corrupt RVL image, too many pixels");
+            std::fill(dst, dst + zeros, uint16_t(0));
+            dst += zeros;
+            count -= zeros;
+
+            auto nonzeros = decoder.get();
+            if (nonzeros > count)
+                throw io_exception("Corrupt RVL image, too many pixels");
+            for (uint32_t k = 0; k < nonzeros; ++k)
+            {
+                auto positive = int(decoder.get());
+                int delta = (positive >> 1) ^ -(positive & 1);
+                previous = uint16_t(previous + delta);
+                *dst++ = previous;
+            }
+            count -= nonzeros;
+        }
+    }
+
+    // RVL of the zigzag differences from the previous image, the unchanged pixels are the zero runs
+    static void compress_rvl_residual(const uint16_t* src, const uint16_t* previous, size_t count, std::vector<uint8_t>& dst)
+    {
+        rvl_encoder encoder(dst);
+        size_t i = 0;
+        while (i < count)
+        {
+            uint32_t unchanged = 0;
+            for (; i < count && src[i] == previous[i]; ++i)
+                ++unchanged;
+            encoder.put(unchanged);
+
+            uint32_t changed = 0;
+            while (i + changed < count && src[i + changed] != previous[i + changed])
+                ++changed;
+            encoder.put(changed);
+
+            for (uint32_t k = 0; k < changed; ++k, ++i)
+            {
+                int delta = int16_t(uint16_t(src[i] - previous[i]));
+                encoder.put((uint32_t(delta) << 1) ^ uint32_t(delta >> 31));
+            }
+        }
+        encoder.finish();
+    }
+
+    // Applies the differences to the previous image in place
+    static void decompress_rvl_residual(const byte* src, size_t size, uint16_t* dst, size_t count)
+    {
+        rvl_decoder decoder(src, size);
+        while (count)
+        {
+            auto unchanged = decoder.get();
+            if (unchanged > count)
+                throw io_exception("Corrupt RVL image, too many pixels");
+            dst += unchanged;
+            count -= unchanged;
+
+            auto changed = decoder.get();
+            if (changed > count)
+                throw io_exception("Corrupt RVL image, too many pixels");
+            for (uint32_t k = 0; k < changed; ++k)
+            {
+                auto positive = int(decoder.get());
+                int delta = (positive >> 1) ^ -(positive & 1);
+                *dst = uint16_t(*dst + delta);
+                ++dst;
+            }
+            count -= changed;
+        }
+    }
+
+#ifdef RS2_USE_JPEG_TURBO
+    struct jpeg_error_handler
+    {
+        jpeg_error_mgr mgr;
+        jmp_buf jump;
+    };
+
+    static void on_jpeg_error(j_common_ptr info)
+    {
+        char message[JMSG_LENGTH_MAX];
+        info->err->format_message(info, message);
+        LOG_ERROR("jpeg frame compression failed: " << message);
+        longjmp(reinterpret_cast<jpeg_error_handler*>(info->err)->jump, 1);
+    }
+
+    static void on_jpeg_message(j_common_ptr info) {}
+
+    static J_COLOR_SPACE to_jpeg_color_space(rs2_format format, int& components)
+    {
+        switch (format)
+        {
+        case RS2_FORMAT_RGB8: components = 3; return JCS_RGB;
+        case RS2_FORMAT_BGR8: components = 3; return JCS_EXT_BGR;
+        case RS2_FORMAT_Y8: components = 1; return JCS_GRAYSCALE;
+        default: components = 0; return JCS_UNKNOWN;
+        }
+    }
+
+    static void compress_jpeg(rs2_format format, const byte* src, uint32_t width, uint32_t height, uint32_t stride, std::vector<uint8_t>& dst)
+    {
+        int components;
+        auto color_space = to_jpeg_color_space(format, components);
+
+        jpeg_compress_struct info;
+        jpeg_error_handler err;
+        info.err = jpeg_std_error(&err.mgr);
+        err.mgr.error_exit = on_jpeg_error;
+        err.mgr.output_message = on_jpeg_message;
+
+        unsigned char* out = nullptr;
+        unsigned long out_size = 0;
+        jpeg_create_compress(&info);
+        if (setjmp(err.jump))
+        {
+            jpeg_destroy_compress(&info);
+            free(out);
+            throw io_exception("Failed to compress image to jpeg");
+        }
+
+        jpeg_mem_dest(&info, &out, &out_size);
+        info.image_width = width;
+        info.image_height = height;
+        info.input_components = components;
+        info.in_color_space = color_space;
+        jpeg_set_defaults(&info);
+        jpeg_set_quality(&info, JPEG_QUALITY, TRUE);
+        jpeg_start_compress(&info, TRUE);
+        while (info.next_scanline < info.image_height)
+        {
+            JSAMPROW row = const_cast<JSAMPROW>(src + info.next_scanline * stride);
+            jpeg_write_scanlines(&info, &row, 1);
+        }
+        jpeg_finish_compress(&info);
+        jpeg_destroy_compress(&info);
+
+        dst.assign(out, out + out_size);
+        free(out);
+    }
+
+    static void decompress_jpeg(rs2_format format, const byte* src, size_t size, uint32_t width, uint32_t height, uint32_t stride, byte* dst)
+    {
+        int components;
+        auto color_space = to_jpeg_color_space(format, components);
+
+        jpeg_decompress_struct info;
+        jpeg_error_handler err;
+        info.err = jpeg_std_error(&err.mgr);
+        err.mgr.error_exit = on_jpeg_error;
+        err.mgr.output_message = on_jpeg_message;
+
+        jpeg_create_decompress(&info);
+        if (setjmp(err.jump))
+        {
+            jpeg_destroy_decompress(&info);
+            throw io_exception("Failed to decompress jpeg image");
+        }
+
+        jpeg_mem_src(&info, const_cast<unsigned char*>(src), static_cast<unsigned long>(size));
+        jpeg_read_header(&info, TRUE);
+        info.out_color_space = color_space;
+        jpeg_start_decompress(&info);
+        if (info.output_width != width || info.output_height != height || info.output_components != components)
+        {
+            jpeg_destroy_decompress(&info);
+            throw io_exception("Corrupt jpeg image, unexpected dimensions");
+        }
+        while (info.output_scanline < info.output_height)
+        {
+            JSAMPROW row = dst + info.output_scanline * stride;
+            jpeg_read_scanlines(&info, &row, 1);
+        }
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+    }
+#endif
+
+    bool is_frame_compression_supported(rs2_frame_compression compression, rs2_format format)
+    {
+        switch (compression)
+        {
+        case RS2_FRAME_COMPRESSION_NONE:
+        case RS2_FRAME_COMPRESSION_LZ4:
+            return true;
+        case RS2_FRAME_COMPRESSION_RVL:
+        case RS2_FRAME_COMPRESSION_RVL_DELTA:
+            return format == RS2_FORMAT_Z16 || format == RS2_FORMAT_Y16;
+        case RS2_FRAME_COMPRESSION_JPEG:
+#ifdef RS2_USE_JPEG_TURBO
+            return format == RS2_FORMAT_RGB8 || format == RS2_FORMAT_BGR8 || format == RS2_FORMAT_Y8;
+#else
+            return false;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    void append_frame_compression(rs2_frame_compression compression, std::string& encoding)
+    {
+        switch (compression)
+        {
+        case RS2_FRAME_COMPRESSION_RVL: encoding += std::string(CODEC_SEPARATOR) + "rvl"; break;
+        case RS2_FRAME_COMPRESSION_LZ4: encoding += std::string(CODEC_SEPARATOR) + "lz4"; break;
+        case RS2_FRAME_COMPRESSION_JPEG: encoding += std::string(CODEC_SEPARATOR) + "jpeg"; break;
+        case RS2_FRAME_COMPRESSION_RVL_DELTA: encoding += std::string(CODEC_SEPARATOR) + "rvl-delta"; break;
+        default: break;
+        }
+    }
+
+    rs2_frame_compression parse_frame_compression(std::string& encoding)
+    {
+        auto pos = encoding.find(CODEC_SEPARATOR);
+        if (pos == std::string::npos)
+            return RS2_FRAME_COMPRESSION_NONE;
+
+        auto codec = encoding.substr(pos + strlen(CODEC_SEPARATOR));
+        encoding.resize(pos);
+        if (codec == "rvl") return RS2_FRAME_COMPRESSION_RVL;
+        if (codec == "lz4") return RS2_FRAME_COMPRESSION_LZ4;
+        if (codec == "jpeg") return RS2_FRAME_COMPRESSION_JPEG;
+        if (codec == "rvl-delta") return RS2_FRAME_COMPRESSION_RVL_DELTA;
+        throw io_exception(to_string() << "Unknown image compression \"" << codec << "\"");
+    }
+
+    void compress_frame(rs2_frame_compression compression, rs2_format format, const byte* src,
+        uint32_t width, uint32_t height, uint32_t stride, std::vector<uint8_t>& dst)
+    {
+        size_t size = size_t(stride) * height;
+        dst.clear();
+        switch (compression)
+        {
+        case RS2_FRAME_COMPRESSION_RVL:
+            // Depth is mostly smooth, about a byte per pixel is a good first guess
+            dst.reserve(size / 2);
+            compress_rvl(reinterpret_cast<const uint16_t*>(src), size / sizeof(uint16_t), dst);
+            break;
+        case RS2_FRAME_COMPRESSION_LZ4:
+        {
+            dst.resize(LZ4_compressBound(int(size)));
+            auto compressed = LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst.data()), int(size), int(dst.size()));
+            if (compressed <= 0)
+                throw io_exception("Failed to compress image with lz4");
+            dst.resize(compressed);
+            break;
+        }
+#ifdef RS2_USE_JPEG_TURBO
+        case RS2_FRAME_COMPRESSION_JPEG:
+            compress_jpeg(format, src, width, height, stride, dst);
+            break;
+#endif
+        case RS2_FRAME_COMPRESSION_RVL_DELTA:
+            throw invalid_value_exception("RVL delta images are coded with the previous images of the stream");
+        default:
+            dst.assign(src, src + size);
+            break;
+        }
+    }
+
+    void decompress_frame(rs2_frame_compression compression, rs2_format format, const byte* src, size_t size,
+        uint32_t width, uint32_t height, uint32_t stride, byte* dst)
+    {
+        size_t dst_size = size_t(stride) * height;
+        switch (compression)
+        {
+        case RS2_FRAME_COMPRESSION_RVL:
+            decompress_rvl(src, size, reinterpret_cast<uint16_t*>(dst), dst_size / sizeof(uint16_t));
+            break;
+        case RS2_FRAME_COMPRESSION_LZ4:
+            if (LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst), int(size), int(dst_size)) != int(dst_size))
+                throw io_exception("Corrupt lz4 image");
+            break;
+        case RS2_FRAME_COMPRESSION_RVL_DELTA:
+            throw io_exception("RVL delta images are decoded with the previous images of the stream");
+        case RS2_FRAME_COMPRESSION_JPEG:
+#ifdef RS2_USE_JPEG_TURBO
+            decompress_jpeg(format, src, size, width, height, stride, dst);
+            break;
+#else
+            throw io_exception("The file holds jpeg images, playing them requires a build with BUILD_WITH_JPEG_TURBO");
+#endif
+        default:
+            if (size != dst_size)
+                throw io_exception("Corrupt image, unexpected size");
+            librealsense::copy(dst, src, size);
+            break;
+        }
+    }
+
+    void rvl_delta_encoder::compress(const byte* src, uint32_t width, uint32_t height, uint32_t stride, std::vector<uint8_t>& dst)
+    {
+        auto pixels = reinterpret_cast<const uint16_t*>(src);
+        size_t count = size_t(stride) * height / sizeof(uint16_t);
+        bool key = _previous.empty() || _frame - _key >= KEY_INTERVAL
+            || width != _width || height != _height || stride != _stride;
+        if (key)
+            _key = _frame;
+
+        rvl_delta_header header{ _frame, _key };
+        dst.clear();
+        // A key image is about a byte per pixel, like RVL, a difference image is a fraction of that
+        dst.reserve(key ? count : count / 4);
+        auto header_bytes = reinterpret_cast<const uint8_t*>(&header);
+        dst.insert(dst.end(), header_bytes, header_bytes + sizeof(header));
+        if (key)
+            compress_rvl(pixels, count, dst);
+        else
+            compress_rvl_residual(pixels, _previous.data(), count, dst);
+
+        _previous.assign(pixels, pixels + count);
+        _width = width;
+        _height = height;
+        _stride = stride;
+        ++_frame;
+    }
+
+    rvl_delta_header rvl_delta_decoder::read_header(const byte* src, size_t size)
+    {
+        rvl_delta_header header;
+        if (size < sizeof(header))
+            throw io_exception("Corrupt RVL delta image, missing header");
+        memcpy(&header, src, sizeof(header));
+        if (header.key > header.frame)
+            throw io_exception("Corrupt RVL delta image, key image after the image");
+        return header;
+    }
+
+    bool rvl_delta_decoder::decompress(const byte* src, size_t size, uint32_t width, uint32_t height, uint32_t stride, byte* dst)
+    {
+        auto header = read_header(src, size);
+        size_t count = size_t(stride) * height / sizeof(uint16_t);
+        bool key = header.key == header.frame;
+        bool same = _has_reference && header.frame == _frame && _previous.size() == count;
+        if (!key && !same && (!_has_reference || header.frame != _frame + 1 || _previous.size() != count))
+            return false;
+
+        if (!same)
+        {
+            // A corrupt image leaves no reference, the following images wait for the next key image
+            _has_reference = false;
+            _previous.resize(count);
+            if (key)
+                decompress_rvl(src + sizeof(header), size - sizeof(header), _previous.data(), count);
+            else
+                decompress_rvl_residual(src + sizeof(header), size - sizeof(header), _previous.data(), count);
+            _frame = header.frame;
+            _has_reference = true;
+        }
+        if (dst)
+            librealsense::copy(dst, _previous.data(), count * sizeof(uint16_t));
+        return true;
+    }
+}
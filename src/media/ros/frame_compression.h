@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "types.h"
+
+namespace librealsense
+{
+    // Compression of the recorded images of a stream.
+    // The codec follows the image encoding in the sensor_msgs::Image encoding field, "mono16; rvl",
+    // the way the ROS compressed image transports tag their format. The image step still describes the raw image
+    bool is_frame_compression_supported(rs2_frame_compression compression, rs2_format format);
+
+    // Appends the codec to the encoding of a compressed image
+    void append_frame_compression(rs2_frame_compression compression, std::string& encoding);
+
+    // Strips the codec from the encoding of a recorded image, raw images return RS2_FRAME_COMPRESSION_NONE
+    rs2_frame_compression parse_frame_compression(std::string& encoding);
+
+    // Compresses the stateless codecs, RS2_FRAME_COMPRESSION_RVL_DELTA goes through rvl_delta_encoder
+    void compress_frame(rs2_frame_compression compression, rs2_format format, const byte* src,
+        uint32_t width, uint32_t height, uint32_t stride, std::vector<uint8_t>& dst);
+
+    // Decompresses into dst, which holds height * stride bytes. Throws io_exception on corrupt data
+    void decompress_frame(rs2_frame_compression compression, rs2_format format, const byte* src, size_t size,
+        uint32_t width, uint32_t height, uint32_t stride, byte* dst);
+
+    // RVL of the zigzag difference of a 16 bit image from the previous image of the stream, the pixels that did not change
+    // are runs of zeros. Every KEY_INTERVAL images, and when the resolution changes, a key image is coded on its own so playback
+    // can start decoding there after a seek. The compressed image starts with the number of the image and of its key image
+    struct rvl_delta_header
+    {
+        uint32_t frame;
+        uint32_t key; // equal to frame for a key image
+    };
+
+    class rvl_delta_encoder
+    {
+    public:
+        static const uint32_t KEY_INTERVAL = 30;
+
+        void compress(const byte* src, uint32_t width, uint32_t height, uint32_t stride, std::vector<uint8_t>& dst);
+
+        // The next image is a key image. The images keep their numbers, unique in the stream of a file
+        void reset() { _previous.clear(); }
+
+    private:
+        std::vector<uint16_t> _previous;
+        uint32_t _width = 0, _height = 0, _stride = 0;
+        uint32_t _frame = 0;
+        uint32_t _key = 0;
+    };
+
+    class rvl_delta_decoder
+    {
+    public:
+        static rvl_delta_header read_header(const byte* src, size_t size);
+
+        // Decodes an image referencing the last image decoded, or a key image. Returns false, without writing to dst,
+        // when the reference is missing. dst may be null to only advance the decoder. Throws io_exception on corrupt data
+        bool decompress(const byte* src, size_t size, uint32_t width, uint32_t height, uint32_t stride, byte* dst);
+
+        // Number of the last image decoded, valid when has_reference
+        uint32_t frame() const { return _frame; }
+        bool has_reference() const { return _has_reference; }
+
+    private:
+        std::vector<uint16_t> _previous;
+        uint32_t _frame = 0;
+        bool _has_reference = false;
+    };
+}
@@ -10,6 +10,7 @@
 #include "sensor_msgs/Image.h"
 #include "diagnostic_msgs/KeyValue.h"
 #include "std_msgs/UInt32.h"
+#include "std_msgs/UInt8MultiArray.h"
 #include "std_msgs/Float32.h"
 #include "std_msgs/Float32MultiArray.h"
 #include "std_msgs/String.h"
@@ -34,7 +35,8 @@ enum ros_file_versions
 {
     ROS_FILE_VERSION_2 = 2u,
     ROS_FILE_VERSION_3 = 3u,
-    ROS_FILE_WITH_RECOMMENDED_PROCESSING_BLOCKS = 4u
+    ROS_FILE_WITH_RECOMMENDED_PROCESSING_BLOCKS = 4u,
+    ROS_FILE_WITH_BINARY_METADATA = 5u
 };
 
 
@@ -188,6 +190,32 @@ namespace librealsense
     constexpr const char* FRAME_TIMESTAMP_MD_STR = "frame_timestamp";
     constexpr const char* TRACKER_CONFIDENCE_MD_STR = "Tracker Confidence";
 
+    /**
+    * Since ROS_FILE_WITH_BINARY_METADATA the metadata of a frame is a single std_msgs::UInt8MultiArray on the metadata topic,
+    * holding the system time (double) and the timestamp domain (uint32) followed by a (uint32 type, int64 value) pair per supported field.
+    * Pose frames still add their confidences, timestamp and number as diagnostic_msgs::KeyValue messages on the same topic
+    */
+    struct binary_metadata_record
+    {
+        static constexpr size_t header_size = sizeof(double) + sizeof(uint32_t);
+        static constexpr size_t field_size = sizeof(uint32_t) + sizeof(int64_t);
+
+        template <typename T>
+        static void append(std::vector<uint8_t>& record, T value)
+        {
+            auto bytes = reinterpret_cast<const uint8_t*>(&value);
+            record.insert(record.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        static T read(const uint8_t* ptr)
+        {
+            T value;
+            memcpy(&value, ptr, sizeof(T));
+            return value;
+        }
+    };
+
     class ros_topic
     {
     public:
@@ -243,6 +271,11 @@ namespace librealsense
         {
             return create_from({ "file_version" });
         }
+        // The files holding the frames of the streams of a recording written with a file per stream
+        static std::string file_shard_topic()
+        {
+            return create_from({ "file_shard" });
+        }
         static std::string device_info_topic(uint32_t device_id)
         {
             return create_from({ device_prefix(device_id),  "info" });
@@ -525,7 +558,7 @@ namespace librealsense
     */
     constexpr uint32_t get_file_version()
     {
-        return ROS_FILE_WITH_RECOMMENDED_PROCESSING_BLOCKS;
+        return ROS_FILE_WITH_BINARY_METADATA;
     }
 
     constexpr uint32_t get_minimum_supported_file_version()
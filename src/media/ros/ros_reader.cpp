@@ -31,6 +31,8 @@ namespace librealsense
         {
             reset(); //Note: calling a virtual function inside c'tor, safe while base function is pure virtual
             m_total_duration = get_file_duration(m_file, m_version);
+            for (auto&& shard : m_shards)
+                m_total_duration = std::max(m_total_duration, shard->query_duration());
         }
         catch (const std::exception& e)
         {
@@ -39,14 +41,141 @@ namespace librealsense
         }
     }
 
+    ros_reader::~ros_reader()
+    {
+        stop_prefetch();
+    }
+
     device_snapshot ros_reader::query_device_description(const nanoseconds& time)
     {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
         return read_device_description(time);
     }
 
     std::shared_ptr<serialized_data> ros_reader::read_next_data()
     {
-        if (m_samples_view == nullptr || m_samples_itrator == m_samples_view->end())
+        if (m_shards.empty())
+            return read_file_data();
+
+        // The earliest of the next data of this file and of the shards, the end of a file is later than any data
+        if (!m_file_next)
+            m_file_next = read_file_data();
+        auto next = &m_file_next;
+        for (size_t i = 0; i < m_shards.size(); ++i)
+        {
+            if (!m_shards_next[i])
+                m_shards_next[i] = m_shards[i]->read_next_data();
+            if (m_shards_next[i]->get_timestamp() < (*next)->get_timestamp())
+                next = &m_shards_next[i];
+        }
+        auto data = *next;
+        if (!data->is<serialized_end_of_file>())
+            next->reset();
+        return data;
+    }
+
+    std::shared_ptr<serialized_data> ros_reader::read_file_data()
+    {
+        if (m_samples_view == nullptr)
+        {
+            LOG_DEBUG("End of file reached");
+            return std::make_shared<serialized_end_of_file>();
+        }
+
+        if (!m_prefetch_thread.joinable())
+            m_prefetch_thread = std::thread([this]() { prefetch_messages(); });
+
+        prefetched_message next;
+        {
+            std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+            m_prefetch_cv.wait(lock, [this]() { return !m_prefetch_queue.empty(); });
+            next = std::move(m_prefetch_queue.front());
+            m_prefetch_queue.pop_front();
+        }
+        m_prefetch_cv.notify_all();
+
+        if (next.error)
+            std::rethrow_exception(next.error);
+        return next.data;
+    }
+
+    // Runs on the read-ahead thread, reading and decoding up to PREFETCH_DEPTH messages ahead of the playback
+    // so its file reads and decompression overlap the playback waiting for the frames' time.
+    // Anything that replaces the samples view stops it first, the file is shared with the other queries under m_file_mutex
+    void ros_reader::prefetch_messages()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_prefetch_mutex);
+                m_prefetch_cv.wait(lock, [this]() { return m_prefetch_stop || m_prefetch_queue.size() < PREFETCH_DEPTH; });
+                if (m_prefetch_stop)
+                    return;
+            }
+
+            prefetched_message next;
+            {
+                std::lock_guard<std::mutex> lock(m_file_mutex);
+                if (m_samples_itrator != m_samples_view->end())
+                {
+                    next.has_time = true;
+                    next.time = (*m_samples_itrator).getTime();
+                }
+                try
+                {
+                    next.data = read_next_message();
+                }
+                catch (...)
+                {
+                    next.error = std::current_exception();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+                m_prefetch_queue.push_back(std::move(next));
+            }
+            m_prefetch_cv.notify_all();
+        }
+    }
+
+    // Stops the read-ahead thread and drops what it read, next_time receives the time of the first message
+    // read_next_data did not return yet. Returns false when the samples view reached its end
+    bool ros_reader::stop_prefetch(rs2rosinternal::Time* next_time)
+    {
+        if (m_prefetch_thread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_prefetch_mutex);
+                m_prefetch_stop = true;
+            }
+            m_prefetch_cv.notify_all();
+            m_prefetch_thread.join();
+        }
+
+        bool has_next = false;
+        rs2rosinternal::Time time;
+        if (!m_prefetch_queue.empty())
+        {
+            has_next = m_prefetch_queue.front().has_time;
+            time = m_prefetch_queue.front().time;
+        }
+        else if (m_samples_view != nullptr && m_samples_itrator != m_samples_view->end())
+        {
+            has_next = true;
+            time = (*m_samples_itrator).getTime();
+        }
+        m_prefetch_queue.clear();
+        m_prefetch_stop = false;
+
+        if (has_next && next_time)
+            *next_time = time;
+        return has_next;
+    }
+
+    std::shared_ptr<serialized_data> ros_reader::read_next_message()
+    {
+        if (m_samples_itrator == m_samples_view->end())
         {
             LOG_DEBUG("End of file reached");
             return std::make_shared<serialized_end_of_file>();
@@ -96,6 +225,7 @@ namespace librealsense
         {
             throw invalid_value_exception(to_string() << "Requested time is out of playback length. (Requested = " << seek_time.count() << ", Duration = " << m_total_duration.count() << ")");
         }
+        stop_prefetch();
         auto seek_time_as_secs = std::chrono::duration_cast<std::chrono::duration<double>>(seek_time);
         auto seek_time_as_rostime = rs2rosinternal::Time(seek_time_as_secs.count());
 
@@ -109,36 +239,70 @@ namespace librealsense
             m_samples_view->addQuery(m_file, rosbag::TopicQuery(topic), seek_time_as_rostime);
         }
         m_samples_itrator = m_samples_view->begin();
+
+        m_file_next = nullptr;
+        for (size_t i = 0; i < m_shards.size(); ++i)
+        {
+            // A shard ending before the time has nothing left to play
+            if (seek_time <= m_shards[i]->query_duration())
+            {
+                m_shards[i]->seek_to_time(seek_time);
+                m_shards_next[i] = nullptr;
+            }
+            else
+                m_shards_next[i] = std::make_shared<serialized_end_of_file>();
+        }
+    }
+
+    // Times of the frames of a topic, in file order, read once from the bag index and kept for the following seeks.
+    // Topics that do not hold frames get an empty index
+    const std::vector<rs2rosinternal::Time>& ros_reader::get_frame_time_index(const std::string& topic) const
+    {
+        auto it = m_frame_time_index.find(topic);
+        if (it != m_frame_time_index.end())
+            return it->second;
+
+        auto& index = m_frame_time_index[topic];
+        rosbag::View view(m_file, rosbag::TopicQuery(topic));
+        for (auto&& m : view)
+        {
+            if (!m.isType<sensor_msgs::Image>() && !m.isType<sensor_msgs::Imu>())
+                break;
+            index.push_back(m.getTime());
+        }
+        return index;
     }
 
     std::vector<std::shared_ptr<serialized_data>> ros_reader::fetch_last_frames(const nanoseconds& seek_time)
     {
+        std::lock_guard<std::mutex> lock(m_file_mutex);
         std::vector<std::shared_ptr<serialized_data>> result;
-        rosbag::View view(m_file, FalseQuery());
         auto as_rostime = to_rostime(seek_time);
-        auto start_time = to_rostime(get_static_file_info_timestamp());
 
-        for (auto topic : m_enabled_streams_topics)
-        {
-            view.addQuery(m_file, rosbag::TopicQuery(topic), start_time, as_rostime);
-        }
-        std::map<device_serializer::stream_identifier, rs2rosinternal::Time> last_frames;
-        for (auto&& m : view)
+        for (auto&& topic : m_enabled_streams_topics)
         {
-            if (m.isType<sensor_msgs::Image>() || m.isType<sensor_msgs::Imu>())
+            auto& index = get_frame_time_index(topic);
+            auto last = std::upper_bound(index.begin(), index.end(), as_rostime);
+            if (last == index.begin())
+                continue;
+            auto last_time = *std::prev(last);
+            if (auto cached = find_cached_frame(std::make_pair(topic, last_time)))
             {
-                auto id = ros_topic::get_stream_identifier(m.getTopic());
-                last_frames[id] = m.getTime();
+                result.push_back(cached);
+                continue;
             }
-        }
-        for (auto&& kvp : last_frames)
-        {
-            auto topic = ros_topic::frame_data_topic(kvp.first);
-            rosbag::View view(m_file, rosbag::TopicQuery(topic), kvp.second, kvp.second);
+            rosbag::View view(m_file, rosbag::TopicQuery(topic), last_time, last_time);
             auto msg = view.begin();
+            if (msg == view.end())
+                continue;
             auto new_frame = create_frame(*msg);
             result.push_back(new_frame);
         }
+        for (auto&& shard : m_shards)
+        {
+            auto frames = shard->fetch_last_frames(seek_time);
+            result.insert(result.end(), frames.begin(), frames.end());
+        }
         return result;
     }
     nanoseconds ros_reader::query_duration() const
@@ -148,13 +312,66 @@ namespace librealsense
 
     void ros_reader::reset()
     {
+        stop_prefetch();
         m_file.close();
         m_file.open(m_file_path, rosbag::BagMode::Read);
         m_version = read_file_version(m_file);
         m_samples_view = nullptr;
-        m_frame_source = std::make_shared<frame_source>(m_version == 1 ? 128 : 32);
+        if (!m_file_mapping)
+        {
+            try
+            {
+                m_file_mapping = std::make_shared<file_mapping>(m_file_path);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_WARNING("Playback of " << m_file_path << " copies the recorded frames: " << e.what());
+            }
+        }
+        m_delta_decoders.clear();
+        m_frame_cache.clear();
+        m_frame_cache_index.clear();
+        m_frame_source = std::make_shared<frame_source>(get_frame_pool_size());
         m_frame_source->init(m_metadata_parser_map);
         m_initial_device_description = read_device_description(get_static_file_info_timestamp(), true);
+        open_shards();
+    }
+
+    // A recording written with a file per stream lists the files of the streams, next to this one. Their extrinsics complete the description
+    void ros_reader::open_shards()
+    {
+        m_shards.clear();
+        m_shards_next.clear();
+        m_file_next = nullptr;
+
+        auto separator = m_file_path.find_last_of("/\\");
+        auto directory = separator == std::string::npos ? std::string() : m_file_path.substr(0, separator + 1);
+        rosbag::View view(m_file, rosbag::TopicQuery(ros_topic::file_shard_topic()));
+        for (auto&& msg : view)
+        {
+            auto shard_msg = instantiate_msg<std_msgs::String>(msg);
+            try
+            {
+                m_shards.emplace_back(new ros_reader(directory + shard_msg->data, m_context));
+                m_shards.back()->set_frame_cache_size(m_frame_cache_size);
+                m_shards_next.emplace_back();
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("Playback of " << m_file_path << " skips the stream file " << shard_msg->data << ": " << e.what());
+            }
+        }
+        if (m_shards.empty())
+            return;
+
+        auto extrinsics = m_initial_device_description.get_extrinsics_map();
+        for (auto&& shard : m_shards)
+        {
+            for (auto&& stream_extrinsics : shard->m_initial_device_description.get_extrinsics_map())
+                extrinsics.insert(stream_extrinsics);
+        }
+        m_initial_device_description = device_snapshot(m_initial_device_description.get_device_extensions_snapshots(),
+            m_initial_device_description.get_sensors_snapshots(), extrinsics);
     }
 
     void ros_reader::enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids)
@@ -169,11 +386,7 @@ namespace librealsense
         }
         else //Already streaming
         {
-            if (m_samples_itrator != m_samples_view->end())
-            {
-                rosbag::MessageInstance sample_msg = *m_samples_itrator;
-                start_time = sample_msg.getTime();
-            }
+            stop_prefetch(&start_time);
         }
         auto currently_streaming = get_topics(m_samples_view);
         //empty the view
@@ -199,24 +412,23 @@ namespace librealsense
         }
         m_samples_itrator = m_samples_view->begin();
         m_enabled_streams_topics = get_topics(m_samples_view);
+        for (auto&& shard : m_shards)
+            shard->enable_stream(stream_ids);
     }
 
     void ros_reader::disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids)
     {
+        for (auto&& shard : m_shards)
+            shard->disable_stream(stream_ids);
         if (m_samples_view == nullptr)
         {
             return;
         }
         rs2rosinternal::Time curr_time;
-        if (m_samples_itrator == m_samples_view->end())
+        if (!stop_prefetch(&curr_time))
         {
             curr_time = m_samples_view->getEndTime();
         }
-        else
-        {
-            rosbag::MessageInstance sample_msg = *m_samples_itrator;
-            curr_time = sample_msg.getTime();
-        }
         auto currently_streaming = get_topics(m_samples_view);
         m_samples_view = std::unique_ptr<rosbag::View>(new rosbag::View(m_file, FalseQuery()));
         for (auto topic : currently_streaming)
@@ -241,11 +453,64 @@ namespace librealsense
         return m_file_path;
     }
 
+    void ros_reader::set_frame_cache_size(uint32_t frames)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_file_mutex);
+            m_frame_cache_size = frames;
+            trim_frame_cache();
+            m_frame_source->set_max_publish_list_size(get_frame_pool_size());
+        }
+        for (auto&& shard : m_shards)
+            shard->set_frame_cache_size(frames);
+    }
+
+    uint32_t ros_reader::get_frame_pool_size() const
+    {
+        return (m_version == 1 ? 128 : 32 + PREFETCH_DEPTH) + m_frame_cache_size;
+    }
+
+    std::shared_ptr<serialized_frame> ros_reader::find_cached_frame(const frame_cache_key& key)
+    {
+        auto it = m_frame_cache_index.find(key);
+        if (it == m_frame_cache_index.end())
+            return nullptr;
+
+        m_frame_cache.splice(m_frame_cache.begin(), m_frame_cache, it->second);
+        auto& cached = *it->second->second;
+        return std::make_shared<serialized_frame>(cached.get_timestamp(), cached.stream_id, cached.frame.clone());
+    }
+
+    void ros_reader::cache_frame(const frame_cache_key& key, const serialized_frame& frame)
+    {
+        if (m_frame_cache_size == 0 || m_frame_cache_index.count(key))
+            return;
+
+        m_frame_cache.emplace_front(key, std::make_shared<serialized_frame>(frame.get_timestamp(), frame.stream_id, frame.frame.clone()));
+        m_frame_cache_index[key] = m_frame_cache.begin();
+        trim_frame_cache();
+    }
+
+    void ros_reader::trim_frame_cache()
+    {
+        while (m_frame_cache.size() > m_frame_cache_size)
+        {
+            m_frame_cache_index.erase(m_frame_cache.back().first);
+            m_frame_cache.pop_back();
+        }
+    }
+
+    // Called under m_file_mutex
     std::shared_ptr<serialized_frame> ros_reader::create_frame(const rosbag::MessageInstance& msg)
     {
         auto next_msg_topic = msg.getTopic();
         auto next_msg_time = msg.getTime();
 
+        // A cached frame is not decoded again, the next image coded as a difference from it is decoded from its key image
+        auto cache_key = std::make_pair(next_msg_topic, next_msg_time);
+        if (auto cached = find_cached_frame(cache_key))
+            return cached;
+
         nanoseconds timestamp = to_nanoseconds(next_msg_time);
         stream_identifier stream_id;
         if (m_version == legacy_file_format::file_version())
@@ -280,7 +545,9 @@ namespace librealsense
         {
             return std::make_shared<serialized_invalid_frame>(timestamp, stream_id);
         }
-        return std::make_shared<serialized_frame>(timestamp, stream_id, std::move(frame));
+        auto result = std::make_shared<serialized_frame>(timestamp, stream_id, std::move(frame));
+        cache_frame(cache_key, *result);
+        return result;
     }
 
     nanoseconds ros_reader::get_file_duration(const rosbag::Bag& file, uint32_t version)
@@ -291,6 +558,8 @@ namespace librealsense
         else
             query = FrameQuery();
         rosbag::View all_frames_view(file, query);
+        if (all_frames_view.size() == 0)
+            return nanoseconds(0);
         auto streaming_duration = all_frames_view.getEndTime() - all_frames_view.getBeginTime();
         return nanoseconds(streaming_duration.toNSec());
     }
@@ -354,8 +623,45 @@ namespace librealsense
         std::map<std::string, std::string> remaining;
         rosbag::View frame_metadata_view(bag, rosbag::TopicQuery(topic), msg.getTime(), msg.getTime());
 
+        auto add_to_blob = [&additional_data, &total_md_size](rs2_frame_metadata_value type, rs2_metadata_type md)
+        {
+            auto size_of_enum = sizeof(rs2_frame_metadata_value);
+            auto size_of_data = sizeof(rs2_metadata_type);
+            if (total_md_size + size_of_enum + size_of_data > 255)
+            {
+                return; //stop adding metadata to frame
+            }
+            memcpy(additional_data.metadata_blob.data() + total_md_size, &type, size_of_enum);
+            total_md_size += static_cast<uint32_t>(size_of_enum);
+            memcpy(additional_data.metadata_blob.data() + total_md_size, &md, size_of_data);
+            total_md_size += static_cast<uint32_t>(size_of_data);
+        };
+
         for (auto message_instance : frame_metadata_view)
         {
+            if (message_instance.isType<std_msgs::UInt8MultiArray>())
+            {
+                //Version 5 and above, the frame metadata is a single binary record
+                auto record_msg = instantiate_msg<std_msgs::UInt8MultiArray>(message_instance);
+                auto& record = record_msg->data;
+                if (record.size() < binary_metadata_record::header_size)
+                {
+                    LOG_WARNING("Invalid metadata record of " << record.size() << " bytes on " << topic);
+                    continue;
+                }
+                auto ptr = record.data();
+                additional_data.system_time = binary_metadata_record::read<double>(ptr);
+                additional_data.timestamp_domain = static_cast<rs2_timestamp_domain>(binary_metadata_record::read<uint32_t>(ptr + sizeof(double)));
+                for (size_t offset = binary_metadata_record::header_size; offset + binary_metadata_record::field_size <= record.size(); offset += binary_metadata_record::field_size)
+                {
+                    auto type = binary_metadata_record::read<uint32_t>(ptr + offset);
+                    if (type >= RS2_FRAME_METADATA_COUNT)
+                        continue;
+                    add_to_blob(static_cast<rs2_frame_metadata_value>(type), binary_metadata_record::read<int64_t>(ptr + offset + sizeof(uint32_t)));
+                }
+                continue;
+            }
+
             auto key_val_msg = instantiate_msg<diagnostic_msgs::KeyValue>(message_instance);
             if (key_val_msg->key == TIMESTAMP_DOMAIN_MD_STR)
             {
@@ -385,26 +691,72 @@ namespace librealsense
                     remaining[key_val_msg->key] = key_val_msg->value;
                     continue;
                 }
-                auto size_of_enum = sizeof(rs2_frame_metadata_value);
-                auto size_of_data = sizeof(rs2_metadata_type);
-                if (total_md_size + size_of_enum + size_of_data > 255)
-                {
-                    continue; //stop adding metadata to frame
-                }
-                memcpy(additional_data.metadata_blob.data() + total_md_size, &type, size_of_enum);
-                total_md_size += static_cast<uint32_t>(size_of_enum);
-                memcpy(additional_data.metadata_blob.data() + total_md_size, &md, size_of_data);
-                total_md_size += static_cast<uint32_t>(size_of_data);
+                add_to_blob(type, md);
             }
         }
         additional_data.metadata_size = total_md_size;
         return remaining;
     }
 
+    // Parses the fields of a sensor_msgs::Image stored as is in the mapped file, leaving out the data which stays in the mapping.
+    // Returns false when the message is not in the mapping, e.g. it is in a compressed chunk, and has to be instantiated
+    bool ros_reader::read_mapped_image(const rosbag::MessageInstance &image_data, sensor_msgs::Image& image, const byte*& pixels, uint32_t& pixels_size) const
+    {
+        uint64_t offset;
+        uint32_t size;
+        if (!m_file_mapping || !image_data.getDataFileOffset(offset, size) || offset > m_file_mapping->size() || size > m_file_mapping->size() - offset)
+            return false;
+
+        auto ptr = m_file_mapping->data() + offset;
+        auto end = ptr + size;
+        auto read = [&ptr, end](void* dst, size_t count)
+        {
+            if (size_t(end - ptr) < count)
+                return false;
+            memcpy(dst, ptr, count);
+            ptr += count;
+            return true;
+        };
+        auto read_string = [&ptr, end, &read](std::string& str)
+        {
+            uint32_t length;
+            if (!read(&length, sizeof(length)) || size_t(end - ptr) < length)
+                return false;
+            str.assign(reinterpret_cast<const char*>(ptr), length);
+            ptr += length;
+            return true;
+        };
+
+        if (!read(&image.header.seq, sizeof(uint32_t)) || !read(&image.header.stamp.sec, sizeof(uint32_t)) || !read(&image.header.stamp.nsec, sizeof(uint32_t))
+            || !read_string(image.header.frame_id) || !read(&image.height, sizeof(uint32_t)) || !read(&image.width, sizeof(uint32_t))
+            || !read_string(image.encoding) || !read(&image.is_bigendian, sizeof(uint8_t)) || !read(&image.step, sizeof(uint32_t))
+            || !read(&pixels_size, sizeof(uint32_t)) || size_t(end - ptr) < pixels_size)
+        {
+            LOG_WARNING("Unexpected layout of image message on " << image_data.getTopic() << ", reading it without the file mapping");
+            return false;
+        }
+        pixels = ptr;
+        return true;
+    }
+
     frame_holder ros_reader::create_image_from_message(const rosbag::MessageInstance &image_data) const
     {
         LOG_DEBUG("Trying to create an image frame from message");
-        auto msg = instantiate_msg<sensor_msgs::Image>(image_data);
+        // Images of uncompressed chunks are used straight from the file mapping, the frames keep the mapping alive
+        sensor_msgs::Image mapped_image;
+        sensor_msgs::ImageConstPtr instantiated_image;
+        const sensor_msgs::Image* msg = &mapped_image;
+        const byte* pixels = nullptr;
+        uint32_t pixels_size = 0;
+        bool mapped = read_mapped_image(image_data, mapped_image, pixels, pixels_size);
+        if (!mapped)
+        {
+            instantiated_image = instantiate_msg<sensor_msgs::Image>(image_data);
+            msg = instantiated_image.get();
+            pixels = msg->data.data();
+            pixels_size = static_cast<uint32_t>(msg->data.size());
+        }
+
         frame_additional_data additional_data{};
         std::chrono::duration<double, std::milli> timestamp_ms(std::chrono::duration<double>(msg->header.stamp.toSec()));
         additional_data.timestamp = timestamp_ms.count();
@@ -426,8 +778,17 @@ namespace librealsense
             get_frame_metadata(m_file, info_topic, stream_id, image_data, additional_data);
         }
 
+        auto encoding = msg->encoding;
+        auto compression = parse_frame_compression(encoding);
+        // The image of a message can start at any offset of the file, and the processing blocks expect the frame data to be
+        // aligned for their SIMD loads: only an aligned image is played straight from the mapping, the others are copied
+        bool zero_copy = mapped && compression == RS2_FRAME_COMPRESSION_NONE && reinterpret_cast<uintptr_t>(pixels) % 16 == 0;
+        size_t frame_size = 0;
+        if (!zero_copy)
+            frame_size = compression == RS2_FRAME_COMPRESSION_NONE ? pixels_size : size_t(msg->step) * msg->height;
+
         frame_interface* frame = m_frame_source->alloc_frame((stream_id.stream_type == RS2_STREAM_DEPTH) ? RS2_EXTENSION_DEPTH_FRAME : RS2_EXTENSION_VIDEO_FRAME,
-            msg->data.size(), additional_data, true);
+            frame_size, additional_data, !zero_copy);
         if (frame == nullptr)
         {
             LOG_WARNING("Failed to allocate new frame");
@@ -436,19 +797,105 @@ namespace librealsense
         librealsense::video_frame* video_frame = static_cast<librealsense::video_frame*>(frame);
         video_frame->assign(msg->width, msg->height, msg->step, msg->step / msg->width * 8);
         rs2_format stream_format;
-        convert(msg->encoding, stream_format);
+        convert(encoding, stream_format);
         //attaching a temp stream to the frame. Playback sensor should assign the real stream
         frame->set_stream(std::make_shared<video_stream_profile>(platform::stream_profile{}));
         frame->get_stream()->set_format(stream_format);
         frame->get_stream()->set_stream_index(int(stream_id.stream_index));
         frame->get_stream()->set_stream_type(stream_id.stream_type);
-        video_frame->data = std::move(msg->data);
         librealsense::frame_holder fh{ video_frame };
+        if (zero_copy)
+        {
+            auto mapping = m_file_mapping;
+            video_frame->attach_continuation(frame_continuation([mapping]() {}, pixels, pixels_size));
+        }
+        else if (compression == RS2_FRAME_COMPRESSION_NONE)
+            librealsense::copy(video_frame->data.data(), pixels, pixels_size);
+        else if (compression == RS2_FRAME_COMPRESSION_RVL_DELTA)
+        {
+            try
+            {
+                decode_delta_image(image_data, *msg, pixels, pixels_size, video_frame->data.data());
+            }
+            catch (const std::exception& e)
+            {
+                // The image is decoded before the frame is delivered, a corrupt one is dropped rather than played as valid data
+                LOG_ERROR("Failed to decode recorded image, dropping the frame: " << e.what());
+                return nullptr;
+            }
+        }
+        else
+        {
+            // Decoded on the first access of the frame data, by the thread processing the frame rather than the one reading the file.
+            // The pending decode holds the compressed image until it runs or the frame is released.
+            // By then the frame was delivered and can no longer be dropped: a corrupt image reads as zeros, no depth for a depth frame
+            std::shared_ptr<const void> source = mapped ? std::shared_ptr<const void>(m_file_mapping) : std::shared_ptr<const void>(instantiated_image);
+            auto dest = video_frame->data.data();
+            auto dest_size = video_frame->data.size();
+            auto width = msg->width;
+            auto height = msg->height;
+            auto step = msg->step;
+            video_frame->defer_processing([source, compression, stream_format, pixels, pixels_size, width, height, step, dest, dest_size]()
+            {
+                try
+                {
+                    decompress_frame(compression, stream_format, pixels, pixels_size, width, height, step, dest);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Failed to decode recorded image: " << e.what());
+                    memset(dest, 0, dest_size);
+                }
+            });
+        }
         LOG_DEBUG("Created image frame: " << stream_id << " " << video_frame->get_width() << "x" << video_frame->get_height() << " " << stream_format);
 
         return fh;
     }
 
+    // The images coded as differences from the previous image are decoded in file order as they are read, not deferred like the
+    // other codecs. An image whose reference was not decoded, after a seek or when the stream is enabled midway, is decoded
+    // from its key image on: the images from the key image are consecutive messages of the topic, the time index finds them
+    void ros_reader::decode_delta_image(const rosbag::MessageInstance &image_data, const sensor_msgs::Image& image, const byte* pixels, uint32_t pixels_size, byte* dst) const
+    {
+        auto& topic = image_data.getTopic();
+        auto& decoder = m_delta_decoders[topic];
+        if (decoder.decompress(pixels, pixels_size, image.width, image.height, image.step, dst))
+            return;
+
+        auto header = rvl_delta_decoder::read_header(pixels, pixels_size);
+        auto& index = get_frame_time_index(topic);
+        auto position = size_t(std::lower_bound(index.begin(), index.end(), image_data.getTime()) - index.begin());
+        auto distance = header.frame - header.key;
+        if (position >= index.size() || position < distance)
+            throw io_exception(to_string() << "The key image of image " << header.frame << " is not in the file");
+
+        LOG_DEBUG("Decoding " << topic << " from key image " << header.key << " to " << header.frame);
+        rosbag::View view(m_file, rosbag::TopicQuery(topic), index[position - distance], index[position - 1]);
+        for (auto&& msg : view)
+        {
+            sensor_msgs::Image mapped_image;
+            sensor_msgs::ImageConstPtr instantiated_image;
+            const sensor_msgs::Image* previous = &mapped_image;
+            const byte* previous_pixels = nullptr;
+            uint32_t previous_size = 0;
+            if (!read_mapped_image(msg, mapped_image, previous_pixels, previous_size))
+            {
+                instantiated_image = instantiate_msg<sensor_msgs::Image>(msg);
+                previous = instantiated_image.get();
+                previous_pixels = previous->data.data();
+                previous_size = static_cast<uint32_t>(previous->data.size());
+            }
+            auto encoding = previous->encoding;
+            if (parse_frame_compression(encoding) != RS2_FRAME_COMPRESSION_RVL_DELTA)
+                break;
+            decoder.decompress(previous_pixels, previous_size, previous->width, previous->height, previous->step, nullptr);
+        }
+
+        if (!decoder.decompress(pixels, pixels_size, image.width, image.height, image.step, dst))
+            throw io_exception(to_string() << "Missing the images from key image " << header.key << " to image " << header.frame);
+    }
+
     frame_holder ros_reader::create_motion_sample(const rosbag::MessageInstance &motion_data) const
     {
         LOG_DEBUG("Trying to create a motion frame from message");
@@ -944,6 +1391,7 @@ namespace librealsense
             throw io_exception("Unrecognized sensor name" + sensor_name);
         }
 
+#ifdef WITH_SR300
         if (is_sr300_PID(int_pid))
         {
             if (is_depth_sensor(sensor_name))
@@ -956,7 +1404,9 @@ namespace librealsense
             }
             throw io_exception("Unrecognized sensor name");
         }
+#endif
 
+#ifdef WITH_L500
         if (is_l500_PID(int_pid))
         {
             if (is_depth_sensor(sensor_name))
@@ -965,6 +1415,7 @@ namespace librealsense
             }
             throw io_exception("Unrecognized sensor name");
         }
+#endif
         //Unrecognized sensor
         return std::make_shared<recommended_proccesing_blocks_snapshot>(processing_blocks{});
     }
@@ -1420,8 +1871,10 @@ namespace librealsense
             return std::make_shared<ExtensionToType<RS2_EXTENSION_TEMPORAL_FILTER>::type>();
         case RS2_EXTENSION_HOLE_FILLING_FILTER:
             return std::make_shared<ExtensionToType<RS2_EXTENSION_HOLE_FILLING_FILTER>::type>();
+#ifdef WITH_L500
         case RS2_EXTENSION_ZERO_ORDER_FILTER:
             return std::make_shared<ExtensionToType<RS2_EXTENSION_ZERO_ORDER_FILTER>::type>();
+#endif
         case RS2_EXTENSION_DEPTH_HUFFMAN_DECODER:
             return std::make_shared<ExtensionToType<RS2_EXTENSION_DEPTH_HUFFMAN_DECODER>::type>();
         default:
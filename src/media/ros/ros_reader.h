@@ -2,9 +2,15 @@
 // Copyright(c) 2017 Intel Corporation. All Rights Reserved.
 
 #pragma once
+#include <thread>
+#include <deque>
+#include <list>
+#include <condition_variable>
 #include <core/serialization.h>
 #include "rosbag/view.h"
 #include "ros_file_format.h"
+#include "frame_compression.h"
+#include "file_mapping.h"
 
 namespace librealsense
 {
@@ -14,6 +20,7 @@ namespace librealsense
     {
     public:
         ros_reader(const std::string& file, const std::shared_ptr<context>& ctx);
+        ~ros_reader() override;
         device_snapshot query_device_description(const nanoseconds& time) override;
         std::shared_ptr<serialized_data> read_next_data() override;
         void seek_to_time(const nanoseconds& seek_time) override;
@@ -23,8 +30,19 @@ namespace librealsense
         virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
         const std::string& get_file_name() const override;
+        void set_frame_cache_size(uint32_t frames) override;
 
     private:
+        // Messages the read-ahead thread reads before read_next_data asks for them
+        static const size_t PREFETCH_DEPTH = 8;
+
+        struct prefetched_message
+        {
+            std::shared_ptr<serialized_data> data;
+            std::exception_ptr error;
+            bool has_time = false;
+            rs2rosinternal::Time time;
+        };
 
         template <typename ROS_TYPE>
         static typename ROS_TYPE::ConstPtr instantiate_msg(const rosbag::MessageInstance& msg)
@@ -42,6 +60,18 @@ namespace librealsense
         }
 
         std::shared_ptr<serialized_frame> create_frame(const rosbag::MessageInstance& msg);
+
+        typedef std::pair<std::string, rs2rosinternal::Time> frame_cache_key;
+        std::shared_ptr<serialized_frame> find_cached_frame(const frame_cache_key& key);
+        void cache_frame(const frame_cache_key& key, const serialized_frame& frame);
+        void trim_frame_cache();
+        uint32_t get_frame_pool_size() const;
+        std::shared_ptr<serialized_data> read_file_data();
+        void open_shards();
+        std::shared_ptr<serialized_data> read_next_message();
+        void prefetch_messages();
+        bool stop_prefetch(rs2rosinternal::Time* next_time = nullptr);
+        const std::vector<rs2rosinternal::Time>& get_frame_time_index(const std::string& topic) const;
         static nanoseconds get_file_duration(const rosbag::Bag& file, uint32_t version);
         static void get_legacy_frame_metadata(const rosbag::Bag& bag,
             const device_serializer::stream_identifier& stream_id,
@@ -69,6 +99,8 @@ namespace librealsense
             const rosbag::MessageInstance &msg,
             frame_additional_data& additional_data);
         frame_holder create_image_from_message(const rosbag::MessageInstance &image_data) const;
+        bool read_mapped_image(const rosbag::MessageInstance &image_data, sensor_msgs::Image& image, const byte*& pixels, uint32_t& pixels_size) const;
+        void decode_delta_image(const rosbag::MessageInstance &image_data, const sensor_msgs::Image& image, const byte* pixels, uint32_t pixels_size, byte* dst) const;
         frame_holder create_motion_sample(const rosbag::MessageInstance &motion_data) const;
         static inline float3 to_float3(const geometry_msgs::Vector3& v);
         static inline float4 to_float4(const geometry_msgs::Quaternion& q);
@@ -143,5 +175,24 @@ namespace librealsense
         std::vector<std::string>                m_enabled_streams_topics;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
+        mutable std::map<std::string, std::vector<rs2rosinternal::Time>> m_frame_time_index;
+        mutable std::map<std::string, rvl_delta_decoder> m_delta_decoders;
+        std::shared_ptr<file_mapping>           m_file_mapping;
+        std::mutex                              m_file_mutex;
+        std::thread                             m_prefetch_thread;
+        std::mutex                              m_prefetch_mutex;
+        std::condition_variable                 m_prefetch_cv;
+        std::deque<prefetched_message>          m_prefetch_queue;
+        bool                                    m_prefetch_stop = false;
+        // The files of the streams of a recording written with a file per stream, read in parallel and merged in time order
+        std::vector<std::unique_ptr<ros_reader>> m_shards;
+        std::vector<std::shared_ptr<serialized_data>> m_shards_next; // next data of every shard, null when not read yet
+        std::shared_ptr<serialized_data>        m_file_next;
+        // The frames read last, most recent first, by topic and time. Stepping back and scrubbing around them are served from memory
+        // instead of reading and decoding the file again, the frames coded as differences from a key image above all.
+        // Accessed under m_file_mutex, the frames it holds are added to the frames of the source
+        std::list<std::pair<frame_cache_key, std::shared_ptr<serialized_frame>>> m_frame_cache;
+        std::map<frame_cache_key, std::list<std::pair<frame_cache_key, std::shared_ptr<serialized_frame>>>::iterator> m_frame_cache_index;
+        uint32_t                                m_frame_cache_size = 0;
     };
 }
@@ -17,10 +17,15 @@ namespace librealsense
 {
     using namespace device_serializer;
 
-    ros_writer::ros_writer(const std::string& file, bool compress_while_record) : m_file_path(file)
+    ros_writer::ros_writer(const std::string& file, bool compress_while_record) :
+        m_file_path(file),
+        m_compress_while_record(compress_while_record),
+        m_file_per_stream(false)
     {
         LOG_INFO("Compression while record is set to " << (compress_while_record ? "ON" : "OFF"));
         m_bag.open(file, rosbag::BagMode::Write);
+        // The default 768KB chunks hold about one VGA depth frame, larger chunks batch several frames per disk write
+        m_bag.setChunkThreshold(CHUNK_THRESHOLD);
         if (compress_while_record)
         {
             m_bag.setCompression(rosbag::CompressionType::LZ4);
@@ -30,6 +35,7 @@ namespace librealsense
 
     void ros_writer::write_device_description(const librealsense::device_snapshot& device_description)
     {
+        m_device_description = device_description;
         for (auto&& device_extension_snapshot : device_description.get_device_extensions_snapshots().get_snapshots())
         {
             write_extension_snapshot(get_device_index(), get_static_file_info_timestamp(), device_extension_snapshot.first, device_extension_snapshot.second);
@@ -46,6 +52,14 @@ namespace librealsense
 
     void ros_writer::write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame)
     {
+        if (m_file_per_stream)
+        {
+            get_stream_writer(stream_id)->write_frame(stream_id, timestamp, std::move(frame));
+            return;
+        }
+        // The frames of a stream switching files may still be written by the thread of its previous file
+        std::lock_guard<std::mutex> lock(m_frames_mutex);
+
         if (Is<video_frame>(frame.frame))
         {
             write_video_frame(stream_id, timestamp, std::move(frame));
@@ -80,6 +94,56 @@ namespace librealsense
         return m_file_path;
     }
 
+    void ros_writer::set_frame_compression(rs2_stream stream, rs2_frame_compression compression)
+    {
+        if (compression == RS2_FRAME_COMPRESSION_JPEG && !is_frame_compression_supported(compression, RS2_FORMAT_RGB8))
+            throw not_implemented_exception("jpeg frame compression requires a build with BUILD_WITH_JPEG_TURBO");
+
+        {
+            std::lock_guard<std::mutex> lock(m_frame_compression_mutex);
+            m_frame_compression[stream] = compression;
+        }
+        std::lock_guard<std::mutex> lock(m_stream_writers_mutex);
+        for (auto&& stream_writer : m_stream_writers)
+            stream_writer.second->set_frame_compression(stream, compression);
+    }
+
+    void ros_writer::set_file_per_stream(bool file_per_stream)
+    {
+        m_file_per_stream = file_per_stream;
+    }
+
+    // The file of a stream is created with its first frame, named after the file of the device: test.bag records the depth
+    // to test_Depth.bag and the second infrared stream to test_Infrared_2.bag. It holds the description of the device, the
+    // frames of the stream and their extrinsics, and is listed in the file of the device so playback opens the files as one recording
+    std::shared_ptr<ros_writer> ros_writer::get_stream_writer(const stream_identifier& stream_id)
+    {
+        std::lock_guard<std::mutex> lock(m_stream_writers_mutex);
+        auto it = m_stream_writers.find(stream_id);
+        if (it != m_stream_writers.end())
+            return it->second;
+
+        auto separator = m_file_path.find_last_of("/\\");
+        auto dot = m_file_path.find_last_of('.');
+        if (dot == std::string::npos || (separator != std::string::npos && dot < separator))
+            dot = m_file_path.size();
+        std::string file = to_string() << m_file_path.substr(0, dot) << "_" << get_string(stream_id.stream_type)
+            << (stream_id.stream_index ? "_" + std::to_string(stream_id.stream_index) : "") << ".bag";
+
+        auto stream_writer = std::make_shared<ros_writer>(file, m_compress_while_record);
+        stream_writer->write_device_description(m_device_description);
+        {
+            std::lock_guard<std::mutex> compression_lock(m_frame_compression_mutex);
+            stream_writer->m_frame_compression = m_frame_compression;
+        }
+
+        std_msgs::String shard_msg;
+        shard_msg.data = separator == std::string::npos ? file : file.substr(separator + 1);
+        write_message(ros_topic::file_shard_topic(), get_static_file_info_timestamp(), shard_msg);
+        m_stream_writers[stream_id] = stream_writer;
+        return stream_writer;
+    }
+
     void ros_writer::write_file_version()
     {
         std_msgs::UInt32 msg;
@@ -89,29 +153,23 @@ namespace librealsense
 
     void ros_writer::write_frame_metadata(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame)
     {
-        auto metadata_topic = ros_topic::frame_metadata_topic(stream_id);
-        diagnostic_msgs::KeyValue system_time;
-        system_time.key = SYSTEM_TIME_MD_STR;
-        system_time.value = std::to_string(frame->get_frame_system_time());
-        write_message(metadata_topic, timestamp, system_time);
-
-        diagnostic_msgs::KeyValue timestamp_domain;
-        timestamp_domain.key = TIMESTAMP_DOMAIN_MD_STR;
-        timestamp_domain.value = librealsense::get_string(frame->get_frame_timestamp_domain());
-        write_message(metadata_topic, timestamp, timestamp_domain);
+        // One binary record per frame instead of a string message per field keeps the recording cost and the bag index small
+        std_msgs::UInt8MultiArray md_msg;
+        auto& record = md_msg.data;
+        record.reserve(binary_metadata_record::header_size + RS2_FRAME_METADATA_COUNT * binary_metadata_record::field_size);
+        binary_metadata_record::append<double>(record, frame->get_frame_system_time());
+        binary_metadata_record::append<uint32_t>(record, frame->get_frame_timestamp_domain());
 
         for (int i = 0; i < static_cast<rs2_frame_metadata_value>(rs2_frame_metadata_value::RS2_FRAME_METADATA_COUNT); i++)
         {
             rs2_frame_metadata_value type = static_cast<rs2_frame_metadata_value>(i);
             if (frame->supports_frame_metadata(type))
             {
-                auto md = frame->get_frame_metadata(type);
-                diagnostic_msgs::KeyValue md_msg;
-                md_msg.key = librealsense::get_string(type);
-                md_msg.value = std::to_string(md);
-                write_message(metadata_topic, timestamp, md_msg);
+                binary_metadata_record::append<uint32_t>(record, type);
+                binary_metadata_record::append<int64_t>(record, frame->get_frame_metadata(type));
             }
         }
+        write_message(ros_topic::frame_metadata_topic(stream_id), timestamp, md_msg);
     }
 
     void ros_writer::write_extrinsics(const stream_identifier& stream_id, frame_interface* frame)
@@ -178,11 +236,39 @@ namespace librealsense
         image.width = static_cast<uint32_t>(vid_frame->get_width());
         image.height = static_cast<uint32_t>(vid_frame->get_height());
         image.step = static_cast<uint32_t>(vid_frame->get_stride());
-        convert(vid_frame->get_stream()->get_format(), image.encoding);
+        auto format = vid_frame->get_stream()->get_format();
+        convert(format, image.encoding);
         image.is_bigendian = is_big_endian();
         auto size = vid_frame->get_stride() * vid_frame->get_height();
         auto p_data = vid_frame->get_frame_data();
-        image.data.assign(p_data, p_data + size);
+
+        auto compression = RS2_FRAME_COMPRESSION_NONE;
+        {
+            std::lock_guard<std::mutex> lock(m_frame_compression_mutex);
+            auto it = m_frame_compression.find(stream_id.stream_type);
+            if (it != m_frame_compression.end() && is_frame_compression_supported(it->second, format))
+                compression = it->second;
+        }
+        if (compression != RS2_FRAME_COMPRESSION_RVL_DELTA)
+        {
+            auto it = m_delta_encoders.find(stream_id);
+            if (it != m_delta_encoders.end())
+                it->second.reset();
+        }
+        if (compression == RS2_FRAME_COMPRESSION_RVL_DELTA)
+        {
+            m_delta_encoders[stream_id].compress(p_data, image.width, image.height, image.step, image.data);
+            append_frame_compression(compression, image.encoding);
+        }
+        else if (compression != RS2_FRAME_COMPRESSION_NONE)
+        {
+            compress_frame(compression, format, p_data, image.width, image.height, image.step, image.data);
+            append_frame_compression(compression, image.encoding);
+        }
+        else
+        {
+            image.data.assign(p_data, p_data + size);
+        }
         image.header.seq = static_cast<uint32_t>(vid_frame->get_frame_number());
         std::chrono::duration<double, std::milli> timestamp_ms(vid_frame->get_frame_timestamp());
         image.header.stamp = rs2rosinternal::Time(std::chrono::duration<double>(timestamp_ms).count());
@@ -546,7 +632,9 @@ namespace librealsense
         RETURN_IF_EXTENSION(block, RS2_EXTENSION_SPATIAL_FILTER);
         RETURN_IF_EXTENSION(block, RS2_EXTENSION_TEMPORAL_FILTER);
         RETURN_IF_EXTENSION(block, RS2_EXTENSION_HOLE_FILLING_FILTER);
+#ifdef WITH_L500
         RETURN_IF_EXTENSION(block, RS2_EXTENSION_ZERO_ORDER_FILTER);
+#endif
         RETURN_IF_EXTENSION(block, RS2_EXTENSION_DEPTH_HUFFMAN_DECODER);
 
 #undef RETURN_IF_EXTENSION
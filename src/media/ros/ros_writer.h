@@ -4,6 +4,7 @@
 #pragma once
 #include "rosbag/bag.h"
 #include "ros_file_format.h"
+#include "frame_compression.h"
 
 namespace librealsense
 {
@@ -12,14 +13,19 @@ namespace librealsense
     class ros_writer: public writer
     {
     public:
+        static const uint32_t CHUNK_THRESHOLD = 8 * 1024 * 1024;
+
         explicit ros_writer(const std::string& file, bool compress_while_record);
         void write_device_description(const librealsense::device_snapshot& device_description) override;
         void write_frame(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_holder&& frame) override;
         void write_snapshot(uint32_t device_index, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
         void write_snapshot(const sensor_identifier& sensor_id, const nanoseconds& timestamp, rs2_extension type, const std::shared_ptr<extension_snapshot>& snapshot) override;
         const std::string& get_file_name() const override;
+        void set_frame_compression(rs2_stream stream, rs2_frame_compression compression) override;
+        void set_file_per_stream(bool file_per_stream) override;
 
     private:
+        std::shared_ptr<ros_writer> get_stream_writer(const stream_identifier& stream_id);
         void write_file_version();
         void write_frame_metadata(const stream_identifier& stream_id, const nanoseconds& timestamp, frame_interface* frame);
         void write_extrinsics(const stream_identifier& stream_id, frame_interface* frame);
@@ -63,6 +69,7 @@ namespace librealsense
         {
             try
             {
+                std::lock_guard<std::mutex> lock(m_bag_mutex);
                 m_bag.write(topic, to_rostime(time), msg);
                 LOG_DEBUG("Recorded: \"" << topic << "\" . TS: " << time.count());
             }
@@ -75,7 +82,18 @@ namespace librealsense
         static uint8_t is_big_endian();
         std::map<stream_identifier, geometry_msgs::Transform> m_extrinsics_msgs;
         std::string m_file_path;
+        bool m_compress_while_record;
+        std::mutex m_bag_mutex; // with a file per stream, the threads writing the frames add the stream files to this one
         rosbag::Bag m_bag;
         std::map<uint32_t, std::set<rs2_option>> m_written_options_descriptions;
+        std::mutex m_frame_compression_mutex;
+        std::map<rs2_stream, rs2_frame_compression> m_frame_compression;
+        // Per recorded stream coded with RS2_FRAME_COMPRESSION_RVL_DELTA, used by the writing thread only
+        std::map<stream_identifier, rvl_delta_encoder> m_delta_encoders;
+        std::atomic<bool> m_file_per_stream;
+        std::mutex m_frames_mutex;
+        device_snapshot m_device_description; // written to the stream files too, so each of them plays on its own
+        std::mutex m_stream_writers_mutex;
+        std::map<stream_identifier, std::shared_ptr<ros_writer>> m_stream_writers;
     };
 }
@@ -0,0 +1,14 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "memory-counter.h"
+
+namespace librealsense
+{
+    const std::shared_ptr<memory_counter>& memory_counter::global()
+    {
+        // never destroyed, frames may be released by static destructors
+        static auto instance = new std::shared_ptr<memory_counter>(std::make_shared<memory_counter>());
+        return *instance;
+    }
+}
@@ -0,0 +1,207 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace librealsense
+{
+    // Thrown by the allocation of a frame buffer exceeding a memory budget
+    class memory_budget_exceeded : public std::bad_alloc
+    {
+    public:
+        explicit memory_budget_exceeded(rs2_memory_budget_policy policy) : _policy(policy) {}
+        const char* what() const noexcept override { return "Frame buffer allocation exceeds the memory budget"; }
+        rs2_memory_budget_policy get_policy() const { return _policy; }
+
+    private:
+        rs2_memory_budget_policy _policy;
+    };
+
+    /*
+        Bytes held by the library, per category. Each device counts the frame buffers of its sensors and of the processing blocks
+        running inside them, and adds them to the counter of its context, which adds them to the process-wide counter. The process-wide
+        counter also holds the frames of the blocks created by the user and the processing caches. The counters are always on, they
+        change when a buffer is allocated or released, not for each frame.
+        A counter may cap the frame buffers of its own and of its children with a budget, reserved atomically at every level so that
+        concurrent allocations never exceed it together
+    */
+    class memory_counter
+    {
+    public:
+        // Longest wait of the allocations for a budget blocking them
+        static const int budget_wait_ms = 1000;
+
+        explicit memory_counter(std::shared_ptr<memory_counter> parent = nullptr)
+            : _parent(std::move(parent)), _budget(0), _policy(RS2_MEMORY_BUDGET_POLICY_DROP), _waiters(0)
+        {
+            for (auto& b : _bytes) b = 0;
+            for (auto& p : _peak) p = 0;
+        }
+
+        void add(rs2_memory_category category, long long bytes)
+        {
+            auto current = _bytes[category].fetch_add(bytes) + bytes;
+            update_peak(category, current);
+            if (bytes < 0 && category == RS2_MEMORY_CATEGORY_FRAME_BUFFERS)
+                notify_release();
+            if (_parent)
+                _parent->add(category, bytes);
+        }
+
+        // Caps the frame buffers of this counter and of its children, 0 for no cap. The buffers already held are kept
+        void set_budget(long long bytes, rs2_memory_budget_policy policy)
+        {
+            _policy = policy;
+            _budget = bytes;
+            notify_release();
+        }
+
+        // Whether new frame buffers of bytes would exceed the budget of this counter or of a parent right now
+        bool exceeds_budget(long long bytes) const
+        {
+            auto budget = _budget.load(std::memory_order_relaxed);
+            if (budget > 0 && _bytes[RS2_MEMORY_CATEGORY_FRAME_BUFFERS].load(std::memory_order_relaxed) + bytes > budget)
+                return true;
+            return _parent && _parent->exceeds_budget(bytes);
+        }
+
+        // Counts new frame buffers of bytes within the budgets of this counter and of its parents. When a budget would be exceeded,
+        // waits up to budget_wait_ms for buffers to be released if its policy blocks, then throws memory_budget_exceeded
+        void reserve_frame_buffers(long long bytes)
+        {
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(budget_wait_ms);
+            while (auto exceeded = try_reserve(bytes))
+            {
+                auto policy = exceeded->_policy.load();
+                if (policy != RS2_MEMORY_BUDGET_POLICY_BLOCK || !exceeded->wait_for_release(bytes, deadline))
+                    throw memory_budget_exceeded(policy);
+            }
+        }
+
+        rs2_memory_usage get() const
+        {
+            rs2_memory_usage usage;
+            for (int i = 0; i < RS2_MEMORY_CATEGORY_COUNT; i++)
+            {
+                usage.bytes[i] = _bytes[i].load();
+                usage.peak_bytes[i] = _peak[i].load();
+            }
+            return usage;
+        }
+
+        // Counter of the whole process, the parent of the device counters
+        static const std::shared_ptr<memory_counter>& global();
+
+        // The counter to use for a null counter pointer
+        static memory_counter& get(const std::shared_ptr<memory_counter>& counter) { return counter ? *counter : *global(); }
+
+    private:
+        void update_peak(rs2_memory_category category, long long current)
+        {
+            auto peak = _peak[category].load(std::memory_order_relaxed);
+            while (current > peak && !_peak[category].compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+        }
+
+        // Null when the bytes were counted at every level, otherwise the counter whose budget they would exceed
+        memory_counter* try_reserve(long long bytes)
+        {
+            auto& current = _bytes[RS2_MEMORY_CATEGORY_FRAME_BUFFERS];
+            auto budget = _budget.load();
+            auto value = current.load();
+            do
+            {
+                if (budget > 0 && value + bytes > budget)
+                    return this;
+            } while (!current.compare_exchange_weak(value, value + bytes));
+            update_peak(RS2_MEMORY_CATEGORY_FRAME_BUFFERS, value + bytes);
+
+            if (_parent)
+            {
+                if (auto exceeded = _parent->try_reserve(bytes))
+                {
+                    current.fetch_sub(bytes);
+                    notify_release();
+                    return exceeded;
+                }
+            }
+            return nullptr;
+        }
+
+        void notify_release()
+        {
+            if (_waiters.load())
+            {
+                std::lock_guard<std::mutex> lock(_release_mutex);
+                _release.notify_all();
+            }
+        }
+
+        // False when the bytes still do not fit at the deadline
+        bool wait_for_release(long long bytes, std::chrono::steady_clock::time_point deadline)
+        {
+            std::unique_lock<std::mutex> lock(_release_mutex);
+            ++_waiters;
+            auto fits = _release.wait_until(lock, deadline, [&]()
+            {
+                auto budget = _budget.load();
+                return budget <= 0 || _bytes[RS2_MEMORY_CATEGORY_FRAME_BUFFERS].load() + bytes <= budget;
+            });
+            --_waiters;
+            return fits;
+        }
+
+        std::shared_ptr<memory_counter> _parent;
+        std::atomic<long long> _bytes[RS2_MEMORY_CATEGORY_COUNT];
+        std::atomic<long long> _peak[RS2_MEMORY_CATEGORY_COUNT];
+
+        std::atomic<long long> _budget; // of the frame buffers, 0 for none
+        std::atomic<rs2_memory_budget_policy> _policy;
+        std::atomic<int> _waiters;
+        std::mutex _release_mutex;
+        std::condition_variable _release;
+    };
+
+    // Standard allocator counting its memory as RS2_MEMORY_CATEGORY_PROCESSING_CACHES of the process,
+    // for the tables and the frame history kept by the processing blocks
+    template<class T>
+    class cache_allocator
+    {
+    public:
+        typedef T value_type;
+
+        cache_allocator() = default;
+        template<class U>
+        cache_allocator(const cache_allocator<U>&) {}
+
+        T* allocate(size_t n)
+        {
+            auto ptr = static_cast<T*>(::operator new(n * sizeof(T)));
+            memory_counter::global()->add(RS2_MEMORY_CATEGORY_PROCESSING_CACHES, n * sizeof(T));
+            return ptr;
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+            memory_counter::global()->add(RS2_MEMORY_CATEGORY_PROCESSING_CACHES, -(long long)(n * sizeof(T)));
+            ::operator delete(ptr);
+        }
+    };
+
+    template<class T, class U>
+    bool operator==(const cache_allocator<T>&, const cache_allocator<U>&) { return true; }
+    template<class T, class U>
+    bool operator!=(const cache_allocator<T>&, const cache_allocator<U>&) { return false; }
+
+    template<class T>
+    using cache_vector = std::vector<T, cache_allocator<T>>;
+}
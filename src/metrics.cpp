@@ -0,0 +1,115 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "metrics.h"
+#include "sensor.h"
+
+#include <algorithm>
+
+namespace librealsense
+{
+    void stream_metrics::rate::add(clock::time_point now)
+    {
+        if (!window_count && fps == 0)
+            window_start = now;
+        ++window_count;
+
+        auto elapsed = std::chrono::duration<float>(now - window_start).count();
+        if (elapsed >= 1.f)
+        {
+            fps = window_count / elapsed;
+            window_start = now;
+            window_count = 0;
+        }
+    }
+
+    float stream_metrics::rate::get(clock::time_point now) const
+    {
+        // a stream that stopped is reported as such, not at its last rate
+        if (now - window_start > std::chrono::seconds(2))
+            return 0;
+        return fps;
+    }
+
+    stream_metrics::counters& stream_metrics::get_counters(const stream_profile_interface& profile)
+    {
+        auto key = std::make_pair(profile.get_stream_type(), profile.get_stream_index());
+        auto it = _streams.find(key);
+        if (it == _streams.end())
+        {
+            counters c;
+            c.values = {};
+            c.values.stream = key.first;
+            c.values.index = key.second;
+            it = _streams.emplace(key, c).first;
+        }
+        return it->second;
+    }
+
+    void stream_metrics::on_arrival(const stream_profile_interface& profile, unsigned long long frame_number)
+    {
+        auto now = clock::now();
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& c = get_counters(profile);
+        ++c.values.arrived;
+        c.arrival.add(now);
+
+        // the frame numbers restart with the stream
+        if (c.last_frame_number && frame_number > c.last_frame_number + 1)
+            c.values.dropped[RS2_FRAME_DROP_CAUSE_FRAME_NUMBER_GAP] += frame_number - c.last_frame_number - 1;
+        c.last_frame_number = frame_number;
+    }
+
+    void stream_metrics::on_delivery(const stream_profile_interface& profile)
+    {
+        auto now = clock::now();
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& c = get_counters(profile);
+        ++c.values.delivered;
+        c.delivery.add(now);
+    }
+
+    void stream_metrics::on_drop(const stream_profile_interface& profile, rs2_frame_drop_cause cause)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++get_counters(profile).values.dropped[cause];
+    }
+
+    void stream_metrics::on_unpack(const stream_profile_interface& profile, double duration_ms)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& values = get_counters(profile).values;
+        values.unpack_time_ms += duration_ms;
+        values.max_unpack_time_ms = std::max(values.max_unpack_time_ms, duration_ms);
+    }
+
+    std::vector<rs2_stream_metrics> stream_metrics::get() const
+    {
+        auto now = clock::now();
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<rs2_stream_metrics> res;
+        for (auto&& kvp : _streams)
+        {
+            auto values = kvp.second.values;
+            values.arrival_fps = kvp.second.arrival.get(now);
+            values.delivered_fps = kvp.second.delivery.get(now);
+            res.push_back(values);
+        }
+        return res;
+    }
+
+    void count_dropped_frames(frame_interface* f, rs2_frame_drop_cause cause)
+    {
+        if (auto composite = dynamic_cast<composite_frame*>(f))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                count_dropped_frames(composite->get_frame(int(i)), cause);
+            return;
+        }
+
+        if (!f || !f->get_stream())
+            return;
+        if (auto sensor = std::dynamic_pointer_cast<sensor_base>(f->get_sensor()))
+            sensor->get_metrics().on_drop(*f->get_stream(), cause);
+    }
+}
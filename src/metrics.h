@@ -0,0 +1,60 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_sensor.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    class stream_profile_interface;
+    class frame_interface;
+
+    // Counters of the frames of the streams of a sensor on their way from the backend to the user.
+    // The raw sensor of a synthetic sensor counts into the metrics of the synthetic sensor, so both ends of the path are in one place
+    class stream_metrics
+    {
+    public:
+        void on_arrival(const stream_profile_interface& profile, unsigned long long frame_number);
+        void on_delivery(const stream_profile_interface& profile);
+        void on_drop(const stream_profile_interface& profile, rs2_frame_drop_cause cause);
+        void on_unpack(const stream_profile_interface& profile, double duration_ms);
+
+        std::vector<rs2_stream_metrics> get() const;
+
+    private:
+        typedef std::chrono::steady_clock clock;
+
+        // Events per second over the last full second, older than two seconds when no event arrived since
+        struct rate
+        {
+            clock::time_point window_start;
+            unsigned long long window_count = 0;
+            float fps = 0;
+
+            void add(clock::time_point now);
+            float get(clock::time_point now) const;
+        };
+
+        struct counters
+        {
+            rs2_stream_metrics values;
+            rate arrival;
+            rate delivery;
+            unsigned long long last_frame_number = 0;
+        };
+
+        counters& get_counters(const stream_profile_interface& profile);
+
+        mutable std::mutex _mutex;
+        std::map<std::pair<rs2_stream, int>, counters> _streams;
+    };
+
+    // Counts the frames of a frameset dropped by a queue in the metrics of the sensors that produced them
+    void count_dropped_frames(frame_interface* f, rs2_frame_drop_cause cause);
+}
@@ -18,6 +18,10 @@
 
 #include "../tm2/tm-boot.h"
 
+#ifdef RS2_WITH_WINUSB_STREAMING
+#include "../win7/rsusb-backend-windows.h"
+#endif
+
 namespace librealsense
 {
     namespace platform
@@ -48,6 +52,15 @@ namespace librealsense
 
         std::shared_ptr<backend> create_backend()
         {
+#ifdef RS2_WITH_WINUSB_STREAMING
+            // Streams UVC over WinUSB, without the Media Foundation pipeline, for devices bound to the WinUSB driver
+            auto selected = getenv("RS2_BACKEND");
+            if (selected && std::string(selected) == "rsusb")
+            {
+                LOG_INFO("Using the RS USB backend, selected by RS2_BACKEND");
+                return std::make_shared<rs_backend_windows>();
+            }
+#endif
             return std::make_shared<wmf_backend>();
         }
 
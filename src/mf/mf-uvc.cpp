@@ -182,6 +182,8 @@ namespace librealsense
 
                 if (sample)
                 {
+                    // The sample is held with its buffer: samples of the reader's pool are recycled once released
+                    CComPtr<IMFSample> held_sample = sample;
                     CComPtr<IMFMediaBuffer> buffer = nullptr;
                     if (SUCCEEDED(sample->GetBufferByIndex(0, &buffer)))
                     {
@@ -201,7 +203,8 @@ namespace librealsense
                                 auto profile = stream.profile;
                                 frame_object f{ current_length, metadata_size, byte_buffer, metadata, monotonic_to_realtime(llTimestamp/10000.f) };
 
-                                auto continuation = [buffer, this]()
+                                // The frame may refer to the locked buffer until it is released
+                                auto continuation = [buffer, held_sample]()
                                 {
                                     buffer->Unlock();
                                 };
@@ -950,10 +953,10 @@ namespace librealsense
             return results;
         }
 
-        void wmf_uvc_device::play_profile(stream_profile profile, frame_callback callback)
+        void wmf_uvc_device::play_profile(stream_profile profile, frame_callback callback, int buffers)
         {
             bool profile_found = false;
-            foreach_profile([this, profile, callback, &profile_found](const mf_profile& mfp, CComPtr<IMFMediaType> media_type, bool& quit)
+            foreach_profile([this, profile, callback, buffers, &profile_found](const mf_profile& mfp, CComPtr<IMFMediaType> media_type, bool& quit)
             {
                 if (mfp.profile.format != profile.format &&
                     (fourcc_map.count(mfp.profile.format) == 0 ||
@@ -989,7 +992,10 @@ namespace librealsense
                                 }
 
                                 _readsample_result = S_OK;
-                                CHECK_HR(_reader->ReadSample(mfp.index, 0, nullptr, nullptr, nullptr, nullptr));
+                                // Each completed read issues the next one, so the number of requests queued here
+                                // is the number of samples the reader keeps in flight for the stream
+                                for (int i = 0; i < std::max(buffers, 1); ++i)
+                                    CHECK_HR(_reader->ReadSample(mfp.index, 0, nullptr, nullptr, nullptr, nullptr));
 
                                 const auto timeout_ms = RS2_DEFAULT_TIMEOUT;
                                 if (_has_started.wait(timeout_ms))
@@ -1016,13 +1022,14 @@ namespace librealsense
                 throw std::runtime_error("Stream profile not found!");
         }
 
-        void wmf_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int /*buffers*/)
+        void wmf_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int buffers)
         {
             if (_streaming)
                 throw std::runtime_error("Device is already streaming!");
 
             _profiles.push_back(profile);
             _frame_callbacks.push_back(callback);
+            _frame_buffers.push_back(buffers);
         }
 
         IAMVideoProcAmp* wmf_uvc_device::get_video_proc() const
@@ -1057,7 +1064,7 @@ namespace librealsense
             {
                 for (uint32_t i = 0; i < _profiles.size(); ++i)
                 {
-                    play_profile(_profiles[i], _frame_callbacks[i]);
+                    play_profile(_profiles[i], _frame_callbacks[i], _frame_buffers[i]);
                 }
 
                 _streaming = true;
@@ -1070,6 +1077,7 @@ namespace librealsense
 
                 _profiles.clear();
                 _frame_callbacks.clear();
+                _frame_buffers.clear();
 
                 throw;
             }
@@ -1101,6 +1109,7 @@ namespace librealsense
             {
                 _profiles.erase(_profiles.begin() + pos);
                 _frame_callbacks.erase(_frame_callbacks.begin() + pos);
+                _frame_buffers.erase(_frame_buffers.begin() + pos);
             }
 
             if (_profiles.empty())
@@ -76,6 +76,7 @@ namespace librealsense
             ~wmf_uvc_device();
 
             void probe_and_commit(stream_profile profile, frame_callback callback, int buffers) override;
+            bool retains_frame_buffers() const override { return true; }
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override;
             void start_callbacks() override;
             void stop_callbacks() override;
@@ -107,7 +108,7 @@ namespace librealsense
         private:
             friend class source_reader_callback;
 
-            void play_profile(stream_profile profile, frame_callback callback);
+            void play_profile(stream_profile profile, frame_callback callback, int buffers);
             void stop_stream_cleanup(const stream_profile& profile, std::vector<profile_and_callback>::iterator& elem);
             void flush(int sIndex);
             void check_connection() const;
@@ -148,6 +149,7 @@ namespace librealsense
             std::string                             _device_serial;
             std::vector<stream_profile>             _profiles;
             std::vector<frame_callback>             _frame_callbacks;
+            std::vector<int>                        _frame_buffers;
             bool                                    _streaming = false;
             std::atomic<bool>                       _is_started = false;
             std::wstring                            _device_id;
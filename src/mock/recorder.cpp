@@ -652,7 +652,7 @@ namespace librealsense
 
         void record_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int buffers)
         {
-            _owner->try_record([this, callback, profile](recording* rec, lookup_key k)
+            _owner->try_record([this, callback, profile, buffers](recording* rec, lookup_key k)
             {
                 _source->probe_and_commit(profile, [this, callback](stream_profile p, frame_object f, std::function<void()> continuation)
                 {
@@ -685,7 +685,7 @@ namespace librealsense
                         c.param6 = static_cast<int>(f.metadata_size);
                         callback(p, f, continuation);
                     }, _entity_id, call_type::uvc_frame);
-                });
+                }, buffers);
 
                 vector<stream_profile> ps{ profile };
                 rec->save_stream_profiles(ps, k);
@@ -693,6 +693,16 @@ namespace librealsense
             }, _entity_id, call_type::uvc_probe_commit);
         }
 
+        void record_uvc_device::set_latest_frame_only(bool latest_only)
+        {
+            _source->set_latest_frame_only(latest_only);
+        }
+
+        bool record_uvc_device::retains_frame_buffers() const
+        {
+            return _source->retains_frame_buffers();
+        }
+
         void record_uvc_device::stream_on(std::function<void(const notification& n)> error_handler)
         {
             _owner->try_record([&](recording* rec, lookup_key k)
@@ -923,6 +933,11 @@ namespace librealsense
             }, _entity_id, call_type::hid_stop_capture);
         }
 
+        void record_hid_device::set_samples_per_wakeup(uint32_t samples)
+        {
+            _source->set_samples_per_wakeup(samples);
+        }
+
         void record_hid_device::start_capture(hid_callback callback)
         {
             _owner->try_record([this, callback](recording* rec, lookup_key k)
@@ -1550,8 +1565,7 @@ namespace librealsense
                                 auto p = get_profile(c_ptr);
                                 if(p == pair.first)
                                 {
-                                    vector<uint8_t> frame_blob;
-                                    vector<uint8_t> metadata_blob;
+                                    const vector<uint8_t>* frame_blob;
 
                                     if (prev_frame_ts > 0 &&
                                         c_ptr->timestamp > prev_frame_ts &&
@@ -1564,21 +1578,25 @@ namespace librealsense
 
                                     if (c_ptr->param3 == 0) // frame was not saved
                                     {
-                                        frame_blob = vector<uint8_t>(c_ptr->param4, 0);
+                                        _blank_frame.resize(c_ptr->param4);
+                                        frame_blob = &_blank_frame;
                                     }
                                     else if (c_ptr->param3 == 1)// frame was saved
                                     {
-                                        frame_blob = _rec->load_blob(c_ptr->param2);
+                                        frame_blob = &_rec->get_blob(c_ptr->param2);
                                     }
                                     else
                                     {
-                                        frame_blob = _compression.decode(_rec->load_blob(c_ptr->param2));
+                                        auto it = _decoded_frames.find(c_ptr->param2);
+                                        if (it == _decoded_frames.end())
+                                            it = _decoded_frames.emplace(c_ptr->param2, _compression.decode(_rec->get_blob(c_ptr->param2))).first;
+                                        frame_blob = &it->second;
                                     }
 
-                                    metadata_blob = _rec->load_blob(c_ptr->param5);
-                                    frame_object fo{ frame_blob.size(),
+                                    auto&& metadata_blob = _rec->get_blob(c_ptr->param5);
+                                    frame_object fo{ frame_blob->size(),
                                                 static_cast<uint8_t>(metadata_blob.size()), // Metadata is limited to 0xff bytes by design
-                                                frame_blob.data(),metadata_blob.data() };
+                                                frame_blob->data(),metadata_blob.data() };
 
 
                                     pair.second(p, fo, []() {});
@@ -293,6 +293,12 @@ namespace librealsense
                 return blobs[id];
             }
 
+            // The blobs are not modified once loaded, playback reads the frames in place rather than copying them
+            const std::vector<uint8_t>& get_blob(int id) const
+            {
+                return blobs[id];
+            }
+
             call& find_call(call_type t, int entity_id, std::function<bool(const call& c)> history_match_validation = [](const call& c) {return true; });
             call* cycle_calls(call_type call_type, int id);
             call* pick_next_call(int id = 0);
@@ -328,6 +334,8 @@ namespace librealsense
         {
         public:
             void probe_and_commit(stream_profile profile, frame_callback callback, int buffers) override;
+            void set_latest_frame_only(bool latest_only) override;
+            bool retains_frame_buffers() const override;
             void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n) {}) override;
             void start_callbacks() override;
             void stop_callbacks() override;
@@ -369,6 +377,7 @@ namespace librealsense
             void close() override;
             void stop_capture() override;
             void start_capture(hid_callback callback) override;
+            void set_samples_per_wakeup(uint32_t samples) override;
             std::vector<hid_sensor> get_sensors() override;
             std::vector<uint8_t> get_custom_report_data(const std::string& custom_sensor_name,
                 const std::string& report_name,
@@ -543,6 +552,10 @@ namespace librealsense
             configurations _commitments;
             std::mutex _callback_mutex;
             compression_algorithm _compression;
+
+            // Playback cycles through the recorded frames, the frames are decoded once and zero frames are allocated once
+            std::map<int, std::vector<uint8_t>> _decoded_frames;
+            std::vector<uint8_t> _blank_frame;
         };
 
 
@@ -141,6 +141,44 @@ std::vector<uint8_t> librealsense::command_transfer_over_xu::send_receive(const
         });
 }
 
+void librealsense::cached_option::set(float value)
+{
+    try
+    {
+        _proxy->set(value);
+    }
+    catch (...)
+    {
+        // a failed write may still have changed the value
+        _cache->invalidate();
+        throw;
+    }
+    _cache->invalidate();
+    _recording_function(*this);
+}
+
+float librealsense::cached_option::query() const
+{
+    auto now = std::chrono::steady_clock::now();
+    auto generation = _cache->get_generation();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_valid && _generation == generation &&
+            (_max_age == std::chrono::milliseconds::zero() || now - _read_time < _max_age))
+            return _value;
+    }
+
+    auto value = _proxy->query();
+
+    // kept with the generation seen before the read, a change during the read makes the next query read again
+    std::lock_guard<std::mutex> lock(_mutex);
+    _valid = true;
+    _value = value;
+    _generation = generation;
+    _read_time = now;
+    return value;
+}
+
 librealsense::polling_errors_disable::~polling_errors_disable()
 {
     if (auto handler = _polling_error_handler.lock())
@@ -543,6 +543,31 @@ namespace librealsense
         std::function<void(const option&)> _recording_function = [](const option&) {};
     };
 
+    /** \brief cached_option keeps the value last read from the device, for options polled faster than they change.
+    * The value is read again after a set of any cached option of the sensor, a notification or a change of the streaming state.
+    * An option the device changes on its own (auto exposure, temperatures) is given a max age, after which it is read again */
+    class cached_option : public proxy_option
+    {
+    public:
+        cached_option(std::shared_ptr<option> proxy, std::shared_ptr<option_cache> cache,
+            std::chrono::milliseconds max_age = std::chrono::milliseconds::zero())
+            : proxy_option(std::move(proxy)), _cache(std::move(cache)), _max_age(max_age)
+        {}
+
+        void set(float value) override;
+        float query() const override;
+
+    private:
+        std::shared_ptr<option_cache> _cache;
+        std::chrono::milliseconds _max_age;
+
+        mutable std::mutex _mutex;
+        mutable bool _valid = false;
+        mutable float _value = 0;
+        mutable unsigned long long _generation = 0;
+        mutable std::chrono::steady_clock::time_point _read_time;
+    };
+
     /** \brief auto_disabling_control class provided a control
     * that disable auto-control when changing the auto disabling control value */
    class auto_disabling_control : public proxy_option
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include "stream.h"
 #include "aggregator.h"
+#include "metrics.h"
 
 namespace librealsense
 {
@@ -11,11 +12,13 @@ namespace librealsense
     {
         aggregator::aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync) :
             processing_block("aggregator"),
-            _queue(new single_consumer_frame_queue<frame_holder>(1)),
+            _queue(new single_consumer_frame_queue<frame_holder, lock_free_single_consumer_queue<frame_holder>>(1)),
             _streams_to_aggregate_ids(streams_to_aggregate),
             _streams_to_sync_ids(streams_to_sync),
             _accepting(true)
         {
+            _queue->set_on_drop([](frame_holder& f) { count_dropped_frames(f.frame, RS2_FRAME_DROP_CAUSE_QUEUE_FULL); });
+
             auto processing_callback = [&](frame_holder frame, synthetic_source_interface* source)
             {
                 handle_frame(std::move(frame), source);
@@ -76,6 +79,8 @@ namespace librealsense
                 // for async pipeline usage - provide only the synchronized frames to the user via callback
                 source->frame_ready(async_fref.clone());
 
+                publish(sync_fref);
+
                 // for sync pipeline usage - push the aggregated to the output queue
                 _queue->enqueue(sync_fref.clone());
             }
@@ -96,12 +101,48 @@ namespace librealsense
                         LOG_ERROR("Failed to allocate composite frame");
                         return;
                     }
+                    publish(sync_fref);
+
                     // for sync pipeline usage - push the aggregated to the output queue
                     _queue->enqueue(sync_fref.clone());
                 }
             }
         }
 
+        void aggregator::publish(frame_holder& frameset)
+        {
+            for (auto&& c : _consumers)
+            {
+                try
+                {
+                    auto f = frameset.clone();
+                    frame_interface* ref = nullptr;
+                    std::swap(f.frame, ref);
+                    c.second->on_frame((rs2_frame*)ref);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_ERROR("Exception was thrown during pipeline consumer callback: " + std::string(e.what()));
+                }
+                catch (...)
+                {
+                    LOG_ERROR("Exception was thrown during pipeline consumer callback!");
+                }
+            }
+        }
+
+        void aggregator::add_consumer(const void* key, frame_callback_ptr consumer)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _consumers[key] = consumer;
+        }
+
+        void aggregator::remove_consumer(const void* key)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _consumers.erase(key);
+        }
+
         bool aggregator::dequeue(frame_holder* item, unsigned int timeout_ms)
         {
             return _queue->dequeue(item, timeout_ms);
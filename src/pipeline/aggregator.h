@@ -15,15 +15,21 @@ namespace librealsense
         {
             std::mutex _mutex;
             std::map<stream_id, frame_holder> _last_set;
-            std::unique_ptr<single_consumer_frame_queue<frame_holder>> _queue;
+            std::unique_ptr<single_consumer_frame_queue<frame_holder, lock_free_single_consumer_queue<frame_holder>>> _queue;
             std::vector<int> _streams_to_aggregate_ids;
             std::vector<int> _streams_to_sync_ids;
             std::atomic<bool> _accepting;
+            std::map<const void*, frame_callback_ptr> _consumers;
             void handle_frame(frame_holder frame, synthetic_source_interface* source);
+            void publish(frame_holder& frameset);
         public:
             aggregator(const std::vector<int>& streams_to_aggregate, const std::vector<int>& streams_to_sync);
             bool dequeue(frame_holder* item, unsigned int timeout_ms);
             bool try_dequeue(frame_holder* item);
+            // Each consumer receives the framesets of wait_for_frames, referencing the same frames as the other consumers.
+            // Consumers are called on the streaming thread and are expected to hand the frameset over without blocking
+            void add_consumer(const void* key, frame_callback_ptr consumer);
+            void remove_consumer(const void* key);
             void start();
             void stop();
         };
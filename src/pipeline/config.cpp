@@ -1,13 +1,19 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
+#include <set>
+
 #include "config.h"
 #include "pipeline.h"
+#include "image.h"
 
 namespace librealsense
 {
     namespace pipeline
     {
+        std::mutex config::_resolve_cache_mtx;
+        std::map<std::string, std::vector<stream_profile>> config::_resolve_cache;
+
         config::config()
         {
             //empty
@@ -90,7 +96,88 @@ namespace librealsense
             _resolved_profile.reset();
         }
 
+        void config::set_sync_latency_budget(float budget_ms)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _sync_latency_budget_ms = budget_ms;
+        }
+
+        void config::set_callback_mailbox_size(int size)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _callback_mailbox_size = size;
+        }
+
+        std::string config::get_resolve_cache_key(std::shared_ptr<device_interface> dev) const
+        {
+            // Playback devices are resolved from their file
+            if (!_device_request.filename.empty() || !dev->supports_info(RS2_CAMERA_INFO_SERIAL_NUMBER))
+                return "";
+
+            std::stringstream key;
+            key << dev->get_info(RS2_CAMERA_INFO_SERIAL_NUMBER);
+            if (dev->supports_info(RS2_CAMERA_INFO_FIRMWARE_VERSION))
+                key << "/" << dev->get_info(RS2_CAMERA_INFO_FIRMWARE_VERSION);
+            if (_enable_all_streams)
+                key << "/all";
+            for (auto&& req : _stream_requests)
+            {
+                auto&& r = req.second;
+                key << "/" << r.stream << "," << r.index << "," << r.width << "," << r.height << "," << r.format << "," << r.fps;
+            }
+            return key.str();
+        }
+
         std::shared_ptr<profile> config::resolve(std::shared_ptr<device_interface> dev)
+        {
+            auto key = get_resolve_cache_key(dev);
+            if (key.empty())
+                return resolve_requests(dev);
+
+            std::vector<stream_profile> cached;
+            {
+                std::lock_guard<std::mutex> lock(_resolve_cache_mtx);
+                auto it = _resolve_cache.find(key);
+                if (it != _resolve_cache.end())
+                    cached = it->second;
+            }
+
+            if (!cached.empty())
+            {
+                try
+                {
+                    util::config config;
+                    for (auto&& r : cached)
+                        config.enable_stream(r.stream, r.index, r.width, r.height, r.format, r.fps);
+                    return std::make_shared<profile>(dev, config, _device_request.record_output);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_DEBUG("Cached stream selection can not be resolved, resolving the requests. " << e.what());
+                }
+            }
+
+            auto resolved = resolve_requests(dev);
+
+            std::vector<stream_profile> selected;
+            for (auto&& p : resolved->get_active_streams())
+            {
+                stream_profile r(p->get_format(), p->get_stream_type(), p->get_stream_index(), 0, 0, p->get_framerate());
+                if (auto vp = As<video_stream_profile_interface>(p))
+                {
+                    r.width = vp->get_width();
+                    r.height = vp->get_height();
+                }
+                selected.push_back(r);
+            }
+            {
+                std::lock_guard<std::mutex> lock(_resolve_cache_mtx);
+                _resolve_cache[key] = std::move(selected);
+            }
+            return resolved;
+        }
+
+        std::shared_ptr<profile> config::resolve_requests(std::shared_ptr<device_interface> dev)
         {
             util::config config;
 
@@ -263,6 +350,281 @@ namespace librealsense
             return default_profiles;
         }
 
+        namespace
+        {
+            // The bits per pixel of a stream on the wire, the color formats the host converts to are transferred as YUYV
+            int get_transfer_bpp(rs2_format format)
+            {
+                switch (format)
+                {
+                case RS2_FORMAT_RGB8:
+                case RS2_FORMAT_BGR8:
+                case RS2_FORMAT_RGBA8:
+                case RS2_FORMAT_BGRA8:
+                    return 16;
+                default:
+                    return get_image_bpp(format);
+                }
+            }
+
+            // Estimated payload of the video streams in Mbps, motion streams take a negligible share of a link
+            double get_bandwidth(const stream_profiles& streams)
+            {
+                double mbps = 0;
+                for (auto&& p : streams)
+                {
+                    if (auto vp = As<video_stream_profile_interface>(p))
+                        mbps += double(vp->get_width()) * vp->get_height() * get_transfer_bpp(p->get_format()) * p->get_framerate() / 1e6;
+                }
+                return mbps;
+            }
+
+            struct usb_link
+            {
+                std::string device;
+                std::string id;
+                double capacity_mbps = 0;
+            };
+
+            // The unique ids of the Linux backend are bus-port-address, so the devices of a bus share its link. Elsewhere each device
+            // is taken as alone on its link. The capacities are the shares of the signaling rates video transfers reach in practice
+            usb_link get_usb_link(std::shared_ptr<device_interface> dev)
+            {
+                usb_link link;
+                platform::usb_spec spec = platform::usb_undefined;
+                auto group = dev->get_device_data();
+                for (auto&& uvc : group.uvc_devices)
+                {
+                    if (!uvc.unique_id.empty())
+                    {
+                        link.device = uvc.unique_id;
+                        spec = uvc.conn_spec;
+                        break;
+                    }
+                }
+                if (link.device.empty())
+                {
+                    for (auto&& usb : group.usb_devices)
+                    {
+                        if (!usb.unique_id.empty())
+                        {
+                            link.device = usb.unique_id;
+                            spec = usb.conn_spec;
+                            break;
+                        }
+                    }
+                }
+
+                switch (spec)
+                {
+                case platform::usb1_type:
+                case platform::usb1_1_type: link.capacity_mbps = 12 * 0.8; break;
+                case platform::usb2_type:
+                case platform::usb2_1_type: link.capacity_mbps = 480 * 0.6; break;
+                case platform::usb3_type: link.capacity_mbps = 5000 * 0.65; break;
+                case platform::usb3_1_type: link.capacity_mbps = 10000 * 0.65; break;
+                case platform::usb3_2_type: link.capacity_mbps = 20000 * 0.65; break;
+                default: return link; // Not a USB device, or a link of unknown speed the planner leaves alone
+                }
+
+                auto bus = link.device.find('-');
+                if (bus != std::string::npos && link.device.find('-', bus + 1) != std::string::npos)
+                    link.id = "bus " + link.device.substr(0, bus);
+                else
+                    link.id = "device " + link.device;
+                return link;
+            }
+        }
+
+        std::shared_ptr<profile> config::lower_bandwidth(std::shared_ptr<device_interface> dev, std::shared_ptr<profile> current,
+                                                         std::map<std::pair<rs2_stream, int>, stream_profile>& pins)
+        {
+            std::lock_guard<std::mutex> lock(_mtx);
+
+            // The selected streams and the fields the requests left open, the default and all-streams selections are open but for the format
+            std::map<std::pair<rs2_stream, int>, stream_profile> selected;
+            std::set<std::pair<rs2_stream, int>> open_fps, open_resolution;
+            for (auto&& p : current->get_active_streams())
+            {
+                std::pair<rs2_stream, int> key{ p->get_stream_type(), p->get_stream_index() };
+                stream_profile s(p->get_format(), key.first, key.second, 0, 0, p->get_framerate());
+                if (auto vp = As<video_stream_profile_interface>(p))
+                {
+                    s.width = vp->get_width();
+                    s.height = vp->get_height();
+                    auto req = _stream_requests.find(key);
+                    if (req == _stream_requests.end() || req->second.fps == 0)
+                        open_fps.insert(key);
+                    if (req == _stream_requests.end() || req->second.width == 0 || req->second.height == 0)
+                        open_resolution.insert(key);
+                }
+                selected[key] = s;
+            }
+
+            stream_profiles available;
+            for (size_t i = 0; i < dev->get_sensors_count(); ++i)
+            {
+                auto profiles = dev->get_sensor(i).get_stream_profiles();
+                available.insert(available.end(), profiles.begin(), profiles.end());
+            }
+
+            auto try_resolve = [&](const std::map<std::pair<rs2_stream, int>, stream_profile>& streams) -> std::shared_ptr<profile>
+            {
+                config trial(*this);
+                trial._enable_all_streams = false;
+                trial._stream_requests = streams;
+                try
+                {
+                    auto resolved = trial.resolve(dev);
+                    pins = streams;
+                    return resolved;
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_DEBUG("Lowered stream selection can not be resolved. " << e.what());
+                    return nullptr;
+                }
+            };
+
+            // Frame rates first, they keep the field of view the application asked for
+            uint32_t top = 0;
+            for (auto&& key : open_fps)
+                top = std::max(top, selected[key].fps);
+            std::set<uint32_t, std::greater<uint32_t>> rates;
+            for (auto&& p : available)
+            {
+                std::pair<rs2_stream, int> key{ p->get_stream_type(), p->get_stream_index() };
+                if (open_fps.count(key) && p->get_format() == selected[key].format && p->get_framerate() < top)
+                    rates.insert(p->get_framerate());
+            }
+            for (auto fps : rates)
+            {
+                auto streams = selected;
+                for (auto&& key : open_fps)
+                    streams[key].fps = std::min(streams[key].fps, fps);
+                if (auto lowered = try_resolve(streams))
+                    return lowered;
+            }
+
+            // Then the next smaller resolution of each stream, at its frame rate
+            auto streams = selected;
+            bool smaller = false;
+            for (auto&& key : open_resolution)
+            {
+                auto&& s = streams[key];
+                uint64_t area = uint64_t(s.width) * s.height, best = 0;
+                for (auto&& p : available)
+                {
+                    auto vp = As<video_stream_profile_interface>(p);
+                    if (!vp || p->get_stream_type() != key.first || p->get_stream_index() != key.second ||
+                        p->get_format() != s.format || p->get_framerate() != s.fps)
+                        continue;
+                    auto a = uint64_t(vp->get_width()) * vp->get_height();
+                    if (a < area && a > best)
+                    {
+                        best = a;
+                        s.width = vp->get_width();
+                        s.height = vp->get_height();
+                    }
+                }
+                smaller |= best > 0;
+            }
+            return smaller ? try_resolve(streams) : nullptr;
+        }
+
+        bool config::resolve_bandwidth(const std::vector<std::pair<std::shared_ptr<config>, std::shared_ptr<pipeline>>>& requests,
+                                       std::vector<std::shared_ptr<profile>>& profiles)
+        {
+            struct plan
+            {
+                std::shared_ptr<device_interface> dev;
+                std::shared_ptr<profile> resolved;
+                std::map<std::pair<rs2_stream, int>, stream_profile> pins;
+                usb_link link;
+                double load;
+                bool exhausted;
+            };
+
+            std::vector<plan> plans;
+            for (auto&& r : requests)
+            {
+                plan p;
+                p.resolved = r.first->resolve(r.second);
+                p.dev = p.resolved->get_device();
+                p.link = get_usb_link(p.dev);
+                p.load = get_bandwidth(p.resolved->get_active_streams());
+                p.exhausted = false;
+                for (auto&& other : plans)
+                {
+                    if (!p.link.device.empty() && other.link.device == p.link.device)
+                        throw invalid_value_exception(to_string() << "Configs " << plans.size() << " and " << (&other - plans.data())
+                            << " resolved to the same device, select the devices with enable_device()");
+                }
+                plans.push_back(p);
+            }
+
+            while (true)
+            {
+                std::map<std::string, double> loads;
+                for (auto&& p : plans)
+                    loads[p.link.id] += p.load;
+
+                plan* target = nullptr;
+                for (auto&& p : plans)
+                {
+                    if (!p.exhausted && !p.link.id.empty() && loads[p.link.id] > p.link.capacity_mbps && (!target || p.load > target->load))
+                        target = &p;
+                }
+                if (!target)
+                    break;
+
+                auto lowered = requests[target - plans.data()].first->lower_bandwidth(target->dev, target->resolved, target->pins);
+                if (!lowered)
+                {
+                    target->exhausted = true;
+                    continue;
+                }
+                auto load = get_bandwidth(lowered->get_active_streams());
+                LOG_INFO("USB " << target->link.id << " is oversubscribed, lowered the streams of config " << (target - plans.data())
+                    << " from " << target->load << " to " << load << " Mbps");
+                target->resolved = lowered;
+                target->load = load;
+            }
+
+            bool fits = true;
+            std::map<std::string, double> loads;
+            for (auto&& p : plans)
+                loads[p.link.id] += p.load;
+            for (auto&& p : plans)
+            {
+                if (!p.link.id.empty() && loads[p.link.id] > p.link.capacity_mbps)
+                {
+                    LOG_WARNING("USB " << p.link.id << " remains oversubscribed, the streams take an estimated " << loads[p.link.id]
+                        << " Mbps of " << p.link.capacity_mbps << " Mbps, frames will be dropped");
+                    loads[p.link.id] = 0; // warn once per link
+                    fits = false;
+                }
+            }
+
+            profiles.clear();
+            for (size_t i = 0; i < plans.size(); ++i)
+            {
+                auto&& cfg = requests[i].first;
+                auto&& p = plans[i];
+                std::lock_guard<std::mutex> lock(cfg->_mtx);
+                if (!p.pins.empty())
+                {
+                    cfg->_stream_requests = p.pins;
+                    cfg->_enable_all_streams = false;
+                }
+                if (cfg->_device_request.filename.empty() && p.dev->supports_info(RS2_CAMERA_INFO_SERIAL_NUMBER))
+                    cfg->_device_request.serial = p.dev->get_info(RS2_CAMERA_INFO_SERIAL_NUMBER);
+                cfg->_resolved_profile = p.resolved;
+                profiles.push_back(p.resolved);
+            }
+            return fits;
+        }
+
         bool config::get_repeat_playback() {
             return _playback_loop;
         }
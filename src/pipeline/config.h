@@ -26,10 +26,21 @@ namespace librealsense
             void enable_record_to_file(const std::string& file);
             void disable_stream(rs2_stream stream, int index = -1);
             void disable_all_streams();
+            void set_sync_latency_budget(float budget_ms);
+            float get_sync_latency_budget() const { return _sync_latency_budget_ms; }
+            void set_callback_mailbox_size(int size);
+            int get_callback_mailbox_size() const { return _callback_mailbox_size; }
             std::shared_ptr<profile> resolve(std::shared_ptr<pipeline> pipe, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(0));
             bool can_resolve(std::shared_ptr<pipeline> pipe);
             bool get_repeat_playback();
 
+            // Resolves the configs of pipelines whose devices may share USB links. While a link is oversubscribed, the most loaded
+            // device on it is given the next lower frame rate its requests leave open, then the next smaller resolution.
+            // The configs are pinned to the planned devices and streams, so the pipelines start with them.
+            // Returns false when a link remains oversubscribed with every open field lowered
+            static bool resolve_bandwidth(const std::vector<std::pair<std::shared_ptr<config>, std::shared_ptr<pipeline>>>& requests,
+                                          std::vector<std::shared_ptr<profile>>& profiles);
+
             //Non top level API
             std::shared_ptr<profile> get_cached_resolved_profile();
 
@@ -41,6 +52,8 @@ namespace librealsense
                 _stream_requests = other._stream_requests;
                 _resolved_profile = nullptr;
                 _playback_loop = other._playback_loop;
+                _sync_latency_budget_ms = other._sync_latency_budget_ms;
+                _callback_mailbox_size = other._callback_mailbox_size;
             }
         private:
             struct device_request
@@ -53,6 +66,15 @@ namespace librealsense
             std::shared_ptr<device_interface> resolve_device_requests(std::shared_ptr<pipeline> pipe, const std::chrono::milliseconds& timeout);
             stream_profiles get_default_configuration(std::shared_ptr<device_interface> dev);
             std::shared_ptr<profile> resolve(std::shared_ptr<device_interface> dev);
+            std::shared_ptr<profile> resolve_requests(std::shared_ptr<device_interface> dev);
+            std::string get_resolve_cache_key(std::shared_ptr<device_interface> dev) const;
+            std::shared_ptr<profile> lower_bandwidth(std::shared_ptr<device_interface> dev, std::shared_ptr<profile> current,
+                                                     std::map<std::pair<rs2_stream, int>, stream_profile>& pins);
+
+            // The fully specified streams previous resolutions selected, by device serial, firmware and requests.
+            // Shared by all configs, so restarting a pipeline or reconnecting a device skips the profile matching
+            static std::mutex _resolve_cache_mtx;
+            static std::map<std::string, std::vector<stream_profile>> _resolve_cache;
 
             device_request _device_request;
             std::map<std::pair<rs2_stream, int>, stream_profile> _stream_requests;
@@ -60,6 +82,8 @@ namespace librealsense
             bool _enable_all_streams = false;
             std::shared_ptr<profile> _resolved_profile;
             bool _playback_loop;
+            float _sync_latency_budget_ms = 0.f;
+            int _callback_mailbox_size = 0;
         };
     }
 }
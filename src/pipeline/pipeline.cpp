@@ -2,6 +2,8 @@
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
 #include "pipeline.h"
 #include "stream.h"
 #include "media/record/record_device.h"
@@ -13,7 +15,7 @@ namespace librealsense
     {
         pipeline::pipeline(std::shared_ptr<librealsense::context> ctx) :
             _ctx(ctx),
-            _dispatcher(10),
+            _dispatcher(10, thread_policy_hook(RS2_THREAD_ROLE_CONTROL)),
             _hub(ctx, RS2_PRODUCT_LINE_ANY_INTEL),
             _synced_streams({ RS2_STREAM_COLOR, RS2_STREAM_DEPTH, RS2_STREAM_INFRARED, RS2_STREAM_FISHEYE })
         {}
@@ -40,6 +42,42 @@ namespace librealsense
             return unsafe_get_active_profile();
         }
 
+        std::vector<start_report> pipeline::start_all(const std::vector<std::pair<std::shared_ptr<pipeline>, std::shared_ptr<config>>>& requests,
+            size_t max_parallel)
+        {
+            std::vector<start_report> reports(requests.size());
+            std::atomic<size_t> next(0);
+            auto run = [&]()
+            {
+                for (auto i = next++; i < requests.size(); i = next++)
+                {
+                    auto started = std::chrono::steady_clock::now();
+                    try
+                    {
+                        reports[i].active_profile = requests[i].first->start(requests[i].second);
+                    }
+                    catch (...)
+                    {
+                        reports[i].error = std::current_exception();
+                    }
+                    reports[i].duration = std::chrono::steady_clock::now() - started;
+                }
+            };
+
+            auto workers = requests.size();
+            if (max_parallel > 0)
+                workers = std::min(workers, max_parallel);
+
+            // The calling thread is one of the workers
+            std::vector<std::thread> threads;
+            for (size_t i = 1; i < workers; ++i)
+                threads.emplace_back(run);
+            run();
+            for (auto&& t : threads)
+                t.join();
+            return reports;
+        }
+
         std::shared_ptr<profile> pipeline::get_active_profile() const
         {
             std::lock_guard<std::mutex> lock(_mtx);
@@ -84,7 +122,14 @@ namespace librealsense
             assert(profile);
             assert(profile->_multistream.get_profiles().size() > 0);
 
+            if (_streams_callback && conf->get_callback_mailbox_size() > 0)
+            {
+                _callback_executor = make_callback_executor(_streams_callback, conf->get_callback_mailbox_size());
+                _streams_callback = _callback_executor;
+            }
+
             auto synced_streams_ids = on_start(profile);
+            _syncer->get_option(RS2_OPTION_SYNC_LATENCY_BUDGET).set(conf->get_sync_latency_budget());
 
             frame_callback_ptr callbacks = get_callback(synced_streams_ids);
 
@@ -109,9 +154,13 @@ namespace librealsense
                 };
             }
 
+            // The sensors of a live device are opened and started concurrently, each open issues its own
+            // USB control transfers. Playback and record devices serialize the sensors through their file
+            auto parallel = !As<librealsense::playback_device>(dev) && !As<librealsense::record_device>(dev);
+
             _dispatcher.start();
-            profile->_multistream.open();
-            profile->_multistream.start(callbacks);
+            profile->_multistream.open(parallel);
+            profile->_multistream.start(callbacks, parallel);
             _active_profile = profile;
             _prev_conf = std::make_shared<config>(*conf);
         }
@@ -140,6 +189,8 @@ namespace librealsense
                     }
                     _active_profile->_multistream.stop();
                     _active_profile->_multistream.close();
+                    if (_callback_executor)
+                        _callback_executor->stop();
                     _dispatcher.stop();
                 }
                 catch (...)
@@ -151,6 +202,7 @@ namespace librealsense
                 _active_profile.reset();
                 _prev_conf.reset();
                 _streams_callback.reset();
+                _callback_executor.reset();
             }
         }
 
@@ -184,7 +236,12 @@ namespace librealsense
             }
 
             _syncer = std::unique_ptr<syncer_process_unit>(new syncer_process_unit());
-            _aggregator = std::unique_ptr<aggregator>(new aggregator(_streams_to_aggregate_ids, _streams_to_sync_ids));
+            {
+                std::lock_guard<std::mutex> lock(_consumers_mtx);
+                _aggregator = std::unique_ptr<aggregator>(new aggregator(_streams_to_aggregate_ids, _streams_to_sync_ids));
+                for (auto&& c : _consumers)
+                    _aggregator->add_consumer(c.first, c.second);
+            }
 
             if (_streams_callback)
                 _aggregator->set_output_callback(_streams_callback);
@@ -223,6 +280,22 @@ namespace librealsense
             return rv;
         }
 
+        void pipeline::add_consumer(const void* key, frame_callback_ptr consumer)
+        {
+            std::lock_guard<std::mutex> lock(_consumers_mtx);
+            _consumers[key] = consumer;
+            if (_aggregator)
+                _aggregator->add_consumer(key, consumer);
+        }
+
+        void pipeline::remove_consumer(const void* key)
+        {
+            std::lock_guard<std::mutex> lock(_consumers_mtx);
+            _consumers.erase(key);
+            if (_aggregator)
+                _aggregator->remove_consumer(key);
+        }
+
         frame_holder pipeline::wait_for_frames(unsigned int timeout_ms)
         {
             std::lock_guard<std::mutex> lock(_mtx);
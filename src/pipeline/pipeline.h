@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <exception>
 #include <map>
 #include <utility>
 
@@ -12,11 +14,20 @@
 #include "config.h"
 #include "resolver.h"
 #include "aggregator.h"
+#include "callback-executor.h"
 
 namespace librealsense
 {
     namespace pipeline
     {
+        // Outcome of starting one pipeline of start_all
+        struct start_report
+        {
+            std::shared_ptr<profile> active_profile; // null when the start failed
+            std::exception_ptr error;
+            std::chrono::duration<double, std::milli> duration{ 0 };
+        };
+
         class pipeline : public std::enable_shared_from_this<pipeline>
         {
         public:
@@ -29,6 +40,16 @@ namespace librealsense
             frame_holder wait_for_frames(unsigned int timeout_ms);
             bool poll_for_frames(frame_holder* frame);
             bool try_wait_for_frames(frame_holder* frame, unsigned int timeout_ms);
+            // Consumers receive every frameset of wait_for_frames in addition to it, see aggregator::add_consumer.
+            // They are kept across stop() and start()
+            void add_consumer(const void* key, frame_callback_ptr consumer);
+            void remove_consumer(const void* key);
+
+            // Starts each pipeline with its config on up to max_parallel threads, a thread per pipeline when 0. The opening of a
+            // device waits mostly on its USB control transfers, so starting the devices of a rig together brings it up in about the
+            // time of its slowest device. A failing start does not stop the others, its report holds the error
+            static std::vector<start_report> start_all(const std::vector<std::pair<std::shared_ptr<pipeline>, std::shared_ptr<config>>>& requests,
+                size_t max_parallel);
 
             //Non top level API
             std::shared_ptr<device_interface> wait_for_device(const std::chrono::milliseconds& timeout = std::chrono::hours::max(),
@@ -57,7 +78,12 @@ namespace librealsense
             std::unique_ptr<syncer_process_unit> _syncer;
             std::unique_ptr<aggregator> _aggregator;
 
+            // Not guarded by _mtx, which wait_for_frames holds while waiting
+            std::mutex _consumers_mtx;
+            std::map<const void*, frame_callback_ptr> _consumers;
+
             frame_callback_ptr _streams_callback;
+            std::shared_ptr<callback_executor> _callback_executor; // Calls the user callback, when the config sets a mailbox
             std::vector<rs2_stream> _synced_streams;
         };
     }
@@ -9,6 +9,8 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <thread>
+#include <exception>
 #include "sensor.h"
 #include "types.h"
 #include "stream.h"
@@ -133,19 +135,54 @@ namespace librealsense
                             _results(std::move(results))
                 {}
 
-                void open()
+                // With parallel set, the sensors are opened concurrently and the sensors that were opened are closed again
+                // if any of them fails
+                void open(bool parallel = false)
                 {
-                    for (auto && kvp : _dev_to_profiles) {
-                        auto&& sub = _results.at(kvp.first);
-                        sub->open(kvp.second);
+                    if (!parallel)
+                    {
+                        for (auto && kvp : _dev_to_profiles) {
+                            auto&& sub = _results.at(kvp.first);
+                            sub->open(kvp.second);
+                        }
+                        return;
+                    }
+
+                    std::vector<std::pair<int, stream_profiles>> requests(_dev_to_profiles.begin(), _dev_to_profiles.end());
+                    std::vector<char> opened(requests.size(), false);
+                    auto error = for_each_parallel(requests.size(), [&](size_t i)
+                    {
+                        _results.at(requests[i].first)->open(requests[i].second);
+                        opened[i] = true;
+                    });
+                    if (error)
+                    {
+                        for (size_t i = 0; i < requests.size(); ++i)
+                        {
+                            if (!opened[i]) continue;
+                            try { _results.at(requests[i].first)->close(); }
+                            catch (...) {}
+                        }
+                        std::rethrow_exception(error);
                     }
                 }
 
                 template<class T>
-                void start(T callback)
+                void start(T callback, bool parallel = false)
                 {
+                    if (!parallel)
+                    {
+                        for (auto&& sensor : _results)
+                            sensor.second->start(callback);
+                        return;
+                    }
+
+                    std::vector<sensor_interface*> sensors;
                     for (auto&& sensor : _results)
-                        sensor.second->start(callback);
+                        sensors.push_back(sensor.second);
+                    auto error = for_each_parallel(sensors.size(), [&](size_t i) { sensors[i]->start(callback); });
+                    if (error)
+                        std::rethrow_exception(error);
                 }
 
                 void stop()
@@ -171,6 +208,31 @@ namespace librealsense
             private:
                 friend class config;
 
+                // Runs f(0)..f(count - 1) on a thread each, the calling thread takes the first one.
+                // Returns the first exception thrown, once all of them are done
+                template<class F>
+                static std::exception_ptr for_each_parallel(size_t count, F f)
+                {
+                    std::vector<std::exception_ptr> errors(count);
+                    auto run = [&](size_t i)
+                    {
+                        try { f(i); }
+                        catch (...) { errors[i] = std::current_exception(); }
+                    };
+
+                    std::vector<std::thread> threads;
+                    for (size_t i = 1; i < count; ++i)
+                        threads.emplace_back(run, i);
+                    if (count)
+                        run(0);
+                    for (auto&& t : threads)
+                        t.join();
+
+                    for (auto&& e : errors)
+                        if (e) return e;
+                    return nullptr;
+                }
+
                 std::map<index_type, std::shared_ptr<stream_profile_interface>> _profiles;
                 std::map<index_type, sensor_interface*> _devices;
                 std::map<int, sensor_interface*> _results;
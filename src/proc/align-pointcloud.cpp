@@ -0,0 +1,196 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rs.hpp"
+#include "../include/librealsense2/rsutil.h"
+#include "proc/align-pointcloud.h"
+#include "proc/align.h"
+#include "proc/occlusion-filter.h"
+#include "proc/projection.h"
+
+#include <algorithm>
+
+namespace librealsense
+{
+    align_pointcloud::align_pointcloud(rs2_stream to_stream)
+        : pointcloud("Align and Pointcloud")
+    {
+        if (to_stream == RS2_STREAM_DEPTH || to_stream == RS2_STREAM_ANY)
+            throw invalid_value_exception("align and pointcloud requires a target stream other than depth");
+        _stream_filter.stream = to_stream;
+    }
+
+    void align_pointcloud::preprocess()
+    {
+        // The tables hold the undistorted rays of the models deprojecting without iterations, the others are deprojected per pixel
+        auto& intrin = *_depth_intrinsics;
+        if (intrin.model == RS2_DISTORTION_KANNALA_BRANDT4 || intrin.model == RS2_DISTORTION_FTHETA)
+        {
+            _centers = _top_left = _bottom_right = nullptr;
+            return;
+        }
+        _centers = deprojection_cache::get_instance().get(intrin);
+        _top_left = deprojection_cache::get_instance().get(intrin, -0.5f);
+        _bottom_right = deprojection_cache::get_instance().get(intrin, 0.5f);
+    }
+
+    bool align_pointcloud::should_process(const rs2::frame& frame)
+    {
+        if (!frame)
+            return false;
+
+        // Only the framesets holding both the depth and the target are processed, there is nothing to align single frames to
+        auto set = frame.as<rs2::frameset>();
+        if (!set)
+            return false;
+        return set.first_or_default(_stream_filter.stream, _stream_filter.format) && set.first_or_default(RS2_STREAM_DEPTH, RS2_FORMAT_Z16);
+    }
+
+    rs2::video_frame align_pointcloud::allocate_aligned_depth(const rs2::frame_source& source, const rs2::video_frame& depth, const rs2::video_frame& other)
+    {
+        if (!_aligned_profile || _aligned_from.get() != depth.get_profile().get() || _aligned_to.get() != other.get_profile().get())
+        {
+            auto from_profile = depth.get_profile().as<rs2::video_stream_profile>();
+            auto to_profile = other.get_profile().as<rs2::video_stream_profile>();
+            _aligned_profile = make_aligned_profile(from_profile, to_profile);
+            _aligned_from = from_profile;
+            _aligned_to = to_profile;
+        }
+
+        auto bpp = depth.get_bytes_per_pixel();
+        return source.allocate_video_frame(*_aligned_profile, depth, bpp,
+            other.get_width(), other.get_height(), other.get_width() * bpp, RS2_EXTENSION_DEPTH_FRAME);
+    }
+
+    void align_pointcloud::deproject_and_align(rs2::points output, rs2::video_frame& aligned, const rs2::depth_frame& depth,
+        const pixel_regions::spans* spans)
+    {
+        auto& depth_intrin = *_depth_intrinsics;
+        auto& other_intrin = *_other_intrinsics;
+        auto& depth_to_other = *_extrinsics;
+        auto depth_scale = *_depth_units;
+        const int width = depth_intrin.width;
+        const int size = width * depth_intrin.height;
+
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+        auto vertices = (float3*)output.get_vertices();
+        auto tex_ptr = (float2*)output.get_texture_coordinates();
+        auto pixels_ptr = _pixels_map.data();
+        auto out_z = reinterpret_cast<uint16_t*>(const_cast<void*>(aligned.get_data()));
+        memset(out_z, 0, other_intrin.width * other_intrin.height * sizeof(uint16_t));
+        if (spans)
+        {
+            memset(vertices, 0, size * sizeof(float3));
+            memset(tex_ptr, 0, size * sizeof(float2));
+            memset(pixels_ptr, 0, size * sizeof(float2));
+        }
+
+        auto centers = _centers, top_left = _top_left, bottom_right = _bottom_right;
+
+        // Iterate over the pixels of the depth image, by line or by span
+        int count = spans ? int(spans->size()) : depth_intrin.height;
+#pragma omp parallel
+        {
+            // The center and the corners of the pixels of a line, transformed to the other stream then projected at once
+            std::vector<float3> points(3 * width);
+            std::vector<float2> pixels(3 * width);
+
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < count; ++i)
+            {
+                int y = spans ? (*spans)[i].y : i;
+                int begin = spans ? (*spans)[i].begin : 0;
+                int end = spans ? (*spans)[i].end : width;
+                int n = end - begin;
+                int first = y * width + begin;
+
+                for (int j = 0; j < n; ++j)
+                {
+                    int index = first + j;
+                    float d = depth_scale * z_pixels[index];
+                    float3 center, corners[2];
+                    if (centers)
+                    {
+                        center = { centers->x[index] * d, centers->y[index] * d, d };
+                        corners[0] = { top_left->x[index] * d, top_left->y[index] * d, d };
+                        corners[1] = { bottom_right->x[index] * d, bottom_right->y[index] * d, d };
+                    }
+                    else
+                    {
+                        int x = begin + j;
+                        const float pixel[] = { float(x), float(y) }, tl[] = { x - 0.5f, y - 0.5f }, br[] = { x + 0.5f, y + 0.5f };
+                        rs2_deproject_pixel_to_point(&center.x, &depth_intrin, pixel, d);
+                        rs2_deproject_pixel_to_point(&corners[0].x, &depth_intrin, tl, d);
+                        rs2_deproject_pixel_to_point(&corners[1].x, &depth_intrin, br, d);
+                    }
+                    vertices[index] = center;
+                    rs2_transform_point_to_point(&points[j].x, &depth_to_other, &center.x);
+                    rs2_transform_point_to_point(&points[n + j].x, &depth_to_other, &corners[0].x);
+                    rs2_transform_point_to_point(&points[2 * n + j].x, &depth_to_other, &corners[1].x);
+                }
+
+                project_points_to_pixels(&pixels[0].x, other_intrin, &points[0].x, 3 * n);
+
+                for (int j = 0; j < n; ++j)
+                {
+                    int index = first + j;
+                    auto z = z_pixels[index];
+                    // Without depth there is no point, no texture and nothing to align
+                    if (!z)
+                    {
+                        tex_ptr[index] = { 0.f, 0.f };
+                        pixels_ptr[index] = { 0.f, 0.f };
+                        continue;
+                    }
+
+                    pixels_ptr[index] = pixels[j];
+                    tex_ptr[index] = { pixels[j].x / other_intrin.width, pixels[j].y / other_intrin.height };
+
+                    const int other_x0 = static_cast<int>(pixels[n + j].x + 0.5f);
+                    const int other_y0 = static_cast<int>(pixels[n + j].y + 0.5f);
+                    const int other_x1 = static_cast<int>(pixels[2 * n + j].x + 0.5f);
+                    const int other_y1 = static_cast<int>(pixels[2 * n + j].y + 0.5f);
+                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
+                        continue;
+
+                    // The nearest depth wins where several depth pixels cover the same pixel of the other stream
+                    for (int oy = other_y0; oy <= other_y1; ++oy)
+                    {
+                        for (int ox = other_x0; ox <= other_x1; ++ox)
+                        {
+                            auto& out = out_z[oy * other_intrin.width + ox];
+                            out = out ? std::min(out, z) : z;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    rs2::frame align_pointcloud::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        std::lock_guard<std::mutex> lock(_mapping_mutex);
+
+        auto composite = f.as<rs2::frameset>();
+        auto other = composite.first(_stream_filter.stream).as<rs2::video_frame>();
+        inspect_other_frame(other);
+
+        auto depth = composite.first(RS2_STREAM_DEPTH, RS2_FORMAT_Z16).as<rs2::depth_frame>();
+        inspect_depth_frame(depth);
+
+        // Without the calibration to the other stream there is only the untextured pointcloud
+        if (!_extrinsics || !_other_intrinsics)
+            return process_depth_frame(source, depth);
+
+        auto res = allocate_points(source, depth);
+        auto pframe = (librealsense::points*)(res.get());
+        auto aligned = allocate_aligned_depth(source, depth, other);
+
+        auto spans = _regions.get(_depth_intrinsics->width, _depth_intrinsics->height);
+        deproject_and_align(res, aligned, depth, spans.get());
+
+        filter_occlusions(pframe, depth, *_extrinsics, *_depth_units);
+
+        return source.allocate_composite_frame({ res, aligned });
+    }
+}
@@ -0,0 +1,36 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "pointcloud.h"
+#include "deprojection-cache.h"
+
+namespace librealsense
+{
+    // Aligns the depth to another stream and computes the pointcloud textured by it in the same pass:
+    // each depth pixel is deprojected once, its vertex gives the texture coordinates and its corners the aligned depth.
+    // The output frameset holds the points and the depth aligned to the other stream, in place of the depth
+    class LRS_EXTENSION_API align_pointcloud : public pointcloud
+    {
+    public:
+        align_pointcloud(rs2_stream to_stream);
+
+        void preprocess() override;
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        rs2::video_frame allocate_aligned_depth(const rs2::frame_source& source, const rs2::video_frame& depth, const rs2::video_frame& other);
+        void deproject_and_align(rs2::points points, rs2::video_frame& aligned, const rs2::depth_frame& depth,
+            const pixel_regions::spans* spans);
+
+        // Rays of the centers, top-left and bottom-right corners of the depth pixels
+        std::shared_ptr<const deprojection_table> _centers, _top_left, _bottom_right;
+
+        rs2::stream_profile _aligned_from, _aligned_to;
+        std::shared_ptr<rs2::video_stream_profile> _aligned_profile;
+    };
+}
@@ -10,50 +10,70 @@
 #include "environment.h"
 #include "align.h"
 #include "stream.h"
+#include "option.h"
+
+#include <algorithm>
 
 namespace librealsense
 {
     template<int N> struct bytes { byte b[N]; };
 
+    // Aligns the depth image with several other images at once, the corners of each depth pixel are deprojected
+    // once and projected onto every other image. transfer_pixel takes the index of the other image first.
+    // Spans restricts the alignment to the pixels of the depth image they cover, when not null
     template<class GET_DEPTH, class TRANSFER_PIXEL>
-    void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
-        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel)
+    void align_images_to_others(const rs2_intrinsics& depth_intrin, const std::vector<rs2_extrinsics>& depth_to_others,
+        const std::vector<rs2_intrinsics>& others_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel,
+        const pixel_regions::spans* spans = nullptr)
     {
-        // Iterate over the pixels of the depth image
+        const int others = int(others_intrin.size());
+
+        // Iterate over the pixels of the depth image, by line or by span
+        int count = spans ? int(spans->size()) : depth_intrin.height;
 #pragma omp parallel for schedule(dynamic)
-        for (int depth_y = 0; depth_y < depth_intrin.height; ++depth_y)
+        for (int i = 0; i < count; ++i)
         {
-            int depth_pixel_index = depth_y * depth_intrin.width;
-            for (int depth_x = 0; depth_x < depth_intrin.width; ++depth_x, ++depth_pixel_index)
+            int depth_y = spans ? (*spans)[i].y : i;
+            int begin = spans ? (*spans)[i].begin : 0;
+            int end = spans ? (*spans)[i].end : depth_intrin.width;
+            int depth_pixel_index = depth_y * depth_intrin.width + begin;
+            for (int depth_x = begin; depth_x < end; ++depth_x, ++depth_pixel_index)
             {
                 // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
                 if (float depth = get_depth(depth_pixel_index))
                 {
-                    // Map the top-left corner of the depth pixel onto the other image
-                    float depth_pixel[2] = { depth_x - 0.5f, depth_y - 0.5f }, depth_point[3], other_point[3], other_pixel[2];
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    // Map the bottom-right corner of the depth pixel onto the other image
-                    depth_pixel[0] = depth_x + 0.5f; depth_pixel[1] = depth_y + 0.5f;
-                    rs2_deproject_pixel_to_point(depth_point, &depth_intrin, depth_pixel, depth);
-                    rs2_transform_point_to_point(other_point, &depth_to_other, depth_point);
-                    rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
-                    const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
-                    const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
-
-                    if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
-                        continue;
-
-                    // Transfer between the depth pixels and the pixels inside the rectangle on the other image
-                    for (int y = other_y0; y <= other_y1; ++y)
+                    // The top-left and bottom-right corners of the depth pixel
+                    float top_left[2] = { depth_x - 0.5f, depth_y - 0.5f }, bottom_right[2] = { depth_x + 0.5f, depth_y + 0.5f };
+                    float top_left_point[3], bottom_right_point[3];
+                    rs2_deproject_pixel_to_point(top_left_point, &depth_intrin, top_left, depth);
+                    rs2_deproject_pixel_to_point(bottom_right_point, &depth_intrin, bottom_right, depth);
+
+                    for (int k = 0; k < others; ++k)
                     {
-                        for (int x = other_x0; x <= other_x1; ++x)
+                        auto& other_intrin = others_intrin[k];
+                        float other_point[3], other_pixel[2];
+
+                        // Map the corners of the depth pixel onto the other image
+                        rs2_transform_point_to_point(other_point, &depth_to_others[k], top_left_point);
+                        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+                        const int other_x0 = static_cast<int>(other_pixel[0] + 0.5f);
+                        const int other_y0 = static_cast<int>(other_pixel[1] + 0.5f);
+
+                        rs2_transform_point_to_point(other_point, &depth_to_others[k], bottom_right_point);
+                        rs2_project_point_to_pixel(other_pixel, &other_intrin, other_point);
+                        const int other_x1 = static_cast<int>(other_pixel[0] + 0.5f);
+                        const int other_y1 = static_cast<int>(other_pixel[1] + 0.5f);
+
+                        if (other_x0 < 0 || other_y0 < 0 || other_x1 >= other_intrin.width || other_y1 >= other_intrin.height)
+                            continue;
+
+                        // Transfer between the depth pixels and the pixels inside the rectangle on the other image
+                        for (int y = other_y0; y <= other_y1; ++y)
                         {
-                            transfer_pixel(depth_pixel_index, y * other_intrin.width + x);
+                            for (int x = other_x0; x <= other_x1; ++x)
+                            {
+                                transfer_pixel(k, depth_pixel_index, y * other_intrin.width + x);
+                            }
                         }
                     }
                 }
@@ -61,9 +81,49 @@ namespace librealsense
         }
     }
 
+    template<class GET_DEPTH, class TRANSFER_PIXEL>
+    void align_images(const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other,
+        const rs2_intrinsics& other_intrin, GET_DEPTH get_depth, TRANSFER_PIXEL transfer_pixel,
+        const pixel_regions::spans* spans = nullptr)
+    {
+        align_images_to_others(depth_intrin, { depth_to_other }, { other_intrin }, get_depth,
+            [&transfer_pixel](int, int depth_pixel_index, int other_pixel_index) { transfer_pixel(depth_pixel_index, other_pixel_index); },
+            spans);
+    }
+
     align::align(rs2_stream to_stream) : align(to_stream, "Align")
     {}
 
+    align::align(std::vector<rs2_stream> to_streams) : align(to_streams, "Align")
+    {}
+
+    align::align(std::vector<rs2_stream> to_streams, const char* name)
+        : generic_processing_block(name), _depth_scale(0), _output_downsample(1)
+    {
+        if (to_streams.empty())
+            throw invalid_value_exception("align requires a target stream");
+        if (to_streams.size() > 1 && std::find(to_streams.begin(), to_streams.end(), RS2_STREAM_DEPTH) != to_streams.end())
+            throw invalid_value_exception("align to depth aligns all the other streams, it takes no other target");
+
+        _to_stream_type = to_streams.front();
+        _to_stream_types = std::move(to_streams);
+
+        auto output_downsample = std::make_shared<ptr_option<int>>(1, 8, 1, 1, &_output_downsample, "Output resolution divider");
+        output_downsample->on_set([this, output_downsample](float val)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            if (!output_downsample->is_valid(val))
+                throw invalid_value_exception(to_string()
+                    << "Unsupported output downsample factor " << val << " is out of range.");
+
+            // The aligned profiles are made again at the new resolution
+            _output_downsample = static_cast<int>(val);
+            _align_stream_unique_ids.clear();
+        });
+        register_option(RS2_OPTION_ALIGN_OUTPUT_DOWNSAMPLE, output_downsample);
+    }
+
     void align::align_z_to_other(rs2::video_frame& aligned, 
         const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
     {
@@ -87,37 +147,40 @@ namespace librealsense
             out_z[other_pixel_index] = out_z[other_pixel_index] ?
                 std::min((int)out_z[other_pixel_index], (int)z_pixels[z_pixel_index]) :
                 z_pixels[z_pixel_index];
-        });
+        }, _spans.get());
     }
 
     template<int N, class GET_DEPTH>
-    void align_other_to_depth_bytes(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels)
+    void align_other_to_depth_bytes(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics& depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels,
+        const pixel_regions::spans* spans)
     {
         auto in_other = (const bytes<N> *)(other_pixels);
         auto out_other = (bytes<N> *)(other_aligned_to_depth);
         align_images(depth_intrin, depth_to_other, other_intrin, get_depth,
-            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; });
+            [out_other, in_other](int depth_pixel_index, int other_pixel_index) { out_other[depth_pixel_index] = in_other[other_pixel_index]; },
+            spans);
     }
 
     template<class GET_DEPTH>
-    void align_other_to_depth(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels, rs2_format other_format)
+    void align_other_to_depth(byte* other_aligned_to_depth, GET_DEPTH get_depth, const rs2_intrinsics& depth_intrin, const rs2_extrinsics & depth_to_other, const rs2_intrinsics& other_intrin, const byte* other_pixels, rs2_format other_format,
+        const pixel_regions::spans* spans = nullptr)
     {
         switch (other_format)
         {
         case RS2_FORMAT_Y8:
-            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<1>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, spans);
             break;
         case RS2_FORMAT_Y16:
         case RS2_FORMAT_Z16:
-            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<2>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, spans);
             break;
         case RS2_FORMAT_RGB8:
         case RS2_FORMAT_BGR8:
-            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<3>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, spans);
             break;
         case RS2_FORMAT_RGBA8:
         case RS2_FORMAT_BGRA8:
-            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels);
+            align_other_to_depth_bytes<4>(other_aligned_to_depth, get_depth, depth_intrin, depth_to_other, other_intrin, other_pixels, spans);
             break;
         default:
             assert(false); // NOTE: rs2_align_other_to_depth_bytes<2>(...) is not appropriate for RS2_FORMAT_YUYV/RS2_FORMAT_RAW10 images, no logic prevents U/V channels from being written to one another
@@ -141,7 +204,92 @@ namespace librealsense
         auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
 
         align_other_to_depth(aligned_data, [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
-            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format());
+            z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format(), _spans.get());
+    }
+
+    void align::align_z_to_others(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth,
+        const std::vector<rs2::video_stream_profile>& other_profiles, float z_scale)
+    {
+        auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+        auto z_intrin = depth_profile.get_intrinsics();
+
+        std::vector<rs2_intrinsics> others_intrin;
+        std::vector<rs2_extrinsics> z_to_others;
+        std::vector<uint16_t*> out_z;
+        for (size_t k = 0; k < aligned.size(); ++k)
+        {
+            auto aligned_data = reinterpret_cast<uint16_t*>(const_cast<void*>(aligned[k].get_data()));
+            auto aligned_profile = aligned[k].get_profile().as<rs2::video_stream_profile>();
+            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned[k].get_bytes_per_pixel());
+
+            out_z.push_back(aligned_data);
+            others_intrin.push_back(other_profiles[k].get_intrinsics());
+            z_to_others.push_back(depth_profile.get_extrinsics_to(other_profiles[k]));
+        }
+
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+
+        align_images_to_others(z_intrin, z_to_others, others_intrin,
+            [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
+            [&out_z, z_pixels](int k, int z_pixel_index, int other_pixel_index)
+        {
+            auto out = out_z[k];
+            out[other_pixel_index] = out[other_pixel_index] ?
+                std::min((int)out[other_pixel_index], (int)z_pixels[z_pixel_index]) :
+                z_pixels[z_pixel_index];
+        }, _spans.get());
+    }
+
+    // Bytes transferred per pixel of the formats align_other_to_depth supports, 0 for the others
+    static int aligned_pixel_size(rs2_format format)
+    {
+        switch (format)
+        {
+        case RS2_FORMAT_Y8: return 1;
+        case RS2_FORMAT_Y16:
+        case RS2_FORMAT_Z16: return 2;
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_BGR8: return 3;
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGRA8: return 4;
+        default: return 0;
+        }
+    }
+
+    void align::align_others_to_z(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth,
+        const std::vector<rs2::video_frame>& others, float z_scale)
+    {
+        auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+        auto z_intrin = depth_profile.get_intrinsics();
+
+        std::vector<rs2_intrinsics> others_intrin;
+        std::vector<rs2_extrinsics> z_to_others;
+        std::vector<byte*> out_other;
+        std::vector<const byte*> in_other;
+        std::vector<int> pixel_size;
+        for (size_t k = 0; k < aligned.size(); ++k)
+        {
+            auto aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned[k].get_data()));
+            auto aligned_profile = aligned[k].get_profile().as<rs2::video_stream_profile>();
+            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned[k].get_bytes_per_pixel());
+
+            auto other_profile = others[k].get_profile().as<rs2::video_stream_profile>();
+            out_other.push_back(aligned_data);
+            in_other.push_back(reinterpret_cast<const byte*>(others[k].get_data()));
+            pixel_size.push_back(aligned_pixel_size(other_profile.format()));
+            others_intrin.push_back(other_profile.get_intrinsics());
+            z_to_others.push_back(depth_profile.get_extrinsics_to(other_profile));
+        }
+
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+
+        align_images_to_others(z_intrin, z_to_others, others_intrin,
+            [z_pixels, z_scale](int z_pixel_index) { return z_scale * z_pixels[z_pixel_index]; },
+            [&out_other, &in_other, &pixel_size](int k, int z_pixel_index, int other_pixel_index)
+        {
+            auto n = pixel_size[k];
+            memcpy(out_other[k] + z_pixel_index * n, in_other[k] + other_pixel_index * n, n);
+        }, _spans.get());
     }
 
     std::shared_ptr<rs2::video_stream_profile> align::create_aligned_profile(
@@ -154,6 +302,19 @@ namespace librealsense
         {
             return it->second;
         }
+        // Aligning to depth outputs the depth resolution
+        auto downsample = to_profile.stream_type() == RS2_STREAM_DEPTH ? 1 : _output_downsample;
+        auto aligned_profile = make_aligned_profile(original_profile, to_profile, downsample);
+        _align_stream_unique_ids[from_to] = aligned_profile;
+        reset_cache(original_profile.stream_type(), to_profile.stream_type());
+        return aligned_profile;
+    }
+
+    std::shared_ptr<rs2::video_stream_profile> make_aligned_profile(
+        rs2::video_stream_profile& original_profile,
+        rs2::video_stream_profile& to_profile,
+        int downsample)
+    {
         auto aligned_profile = std::make_shared<rs2::video_stream_profile>(original_profile.clone(original_profile.stream_type(), original_profile.stream_index(), original_profile.format()));
         aligned_profile->get()->profile->set_framerate(original_profile.fps());
         if (auto original_video_profile = As<video_stream_profile_interface>(original_profile.get()->profile))
@@ -162,17 +323,23 @@ namespace librealsense
             {
                 if (auto aligned_video_profile = As<video_stream_profile_interface>(aligned_profile->get()->profile))
                 {
-                    aligned_video_profile->set_dims(to_video_profile->get_width(), to_video_profile->get_height());
+                    auto width = to_video_profile->get_width() / downsample;
+                    auto height = to_video_profile->get_height() / downsample;
+                    aligned_video_profile->set_dims(width, height);
+                    // The pixel centers of the downsampled image are at the centers of the blocks of the target pixels,
+                    // the distortion coefficients apply to normalized coordinates and do not change
                     auto aligned_intrinsics = to_video_profile->get_intrinsics();
-                    aligned_intrinsics.width = to_video_profile->get_width();
-                    aligned_intrinsics.height = to_video_profile->get_height();
+                    aligned_intrinsics.width = width;
+                    aligned_intrinsics.height = height;
+                    aligned_intrinsics.fx /= downsample;
+                    aligned_intrinsics.fy /= downsample;
+                    aligned_intrinsics.ppx = (aligned_intrinsics.ppx + 0.5f) / downsample - 0.5f;
+                    aligned_intrinsics.ppy = (aligned_intrinsics.ppy + 0.5f) / downsample - 0.5f;
                     aligned_video_profile->set_intrinsics([aligned_intrinsics]() { return aligned_intrinsics; });
                     aligned_profile->register_extrinsics_to(to_profile, { { 1,0,0,0,1,0,0,0,1 },{ 0,0,0 } });
                 }
             }
         }
-        _align_stream_unique_ids[from_to] = aligned_profile;
-        reset_cache(original_profile.stream_type(), to_profile.stream_type());
         return aligned_profile;
     }
 
@@ -192,7 +359,8 @@ namespace librealsense
 
         //process composite frame only if it contains both a depth frame and the requested texture frame
         bool has_tex = false, has_depth = false;
-        set.foreach_rs([this, &has_tex](const rs2::frame& frame) { if (frame.get_profile().stream_type() == _to_stream_type) has_tex = true; });
+        set.foreach_rs([this, &has_tex](const rs2::frame& frame)
+            { if (std::find(_to_stream_types.begin(), _to_stream_types.end(), frame.get_profile().stream_type()) != _to_stream_types.end()) has_tex = true; });
         set.foreach_rs([&has_depth](const rs2::frame& frame)
             { if (frame.get_profile().stream_type() == RS2_STREAM_DEPTH && frame.get_profile().format() == RS2_FORMAT_Z16) has_depth = true; });
         if (!has_tex || !has_depth)
@@ -223,9 +391,9 @@ namespace librealsense
             *aligned_profile,
             from,
             from_bytes_per_pixel,
-            to.get_width(),
-            to.get_height(),
-            to.get_width() * from_bytes_per_pixel,
+            aligned_profile->width(),
+            aligned_profile->height(),
+            aligned_profile->width() * from_bytes_per_pixel,
             ext);
         return rv;
     }
@@ -237,14 +405,56 @@ namespace librealsense
 
         auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
 
+        // The regions skip the pixels outside them on the generic implementation
+        auto depth_profile = to_profile.stream_type() == RS2_STREAM_DEPTH ? to_profile : from_profile;
+        _spans = supports_regions() ? _regions.get(depth_profile.width(), depth_profile.height()) : nullptr;
+
         if (to_profile.stream_type() == RS2_STREAM_DEPTH)
         {
-            align_other_to_z(aligned, to, from, _depth_scale);
+            if (_spans)
+                align::align_other_to_z(aligned, to, from, _depth_scale);
+            else
+                align_other_to_z(aligned, to, from, _depth_scale);
         }
         else
         {
-            align_z_to_other(aligned, from, to_profile, _depth_scale);
+            // The aligned profile has the downsampled intrinsics of the target and identity extrinsics to it
+            auto other_profile = _output_downsample > 1 ? aligned_profile : to_profile;
+            if (_spans)
+                align::align_z_to_other(aligned, from, other_profile, _depth_scale);
+            else
+                align_z_to_other(aligned, from, other_profile, _depth_scale);
+        }
+    }
+
+    void align::align_depth_to_targets(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth, const std::vector<rs2::frame>& targets)
+    {
+        _spans = supports_regions() ? _regions.get(depth.get_width(), depth.get_height()) : nullptr;
+        if (targets.size() > 1 && (_spans || deprojects_once()))
+        {
+            std::vector<rs2::video_stream_profile> to_profiles;
+            for (size_t k = 0; k < targets.size(); ++k)
+                to_profiles.push_back((_output_downsample > 1 ? aligned[k].get_profile() : targets[k].get_profile()).as<rs2::video_stream_profile>());
+            align::align_z_to_others(aligned, depth, to_profiles, _depth_scale);
+            return;
+        }
+
+        for (size_t k = 0; k < targets.size(); ++k)
+            align_frames(aligned[k], depth, targets[k]);
+    }
+
+    void align::align_others_to_depth(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth, const std::vector<rs2::frame>& others)
+    {
+        _spans = supports_regions() ? _regions.get(depth.get_width(), depth.get_height()) : nullptr;
+        if (others.size() > 1 && (_spans || deprojects_once()))
+        {
+            std::vector<rs2::video_frame> other_frames(others.begin(), others.end());
+            align::align_others_to_z(aligned, depth, other_frames, _depth_scale);
+            return;
         }
+
+        for (size_t k = 0; k < others.size(); ++k)
+            align_frames(aligned[k], others[k], depth);
     }
 
     rs2::frame align::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -261,24 +471,31 @@ namespace librealsense
         if (_to_stream_type == RS2_STREAM_DEPTH)
             frames.foreach_rs([&other_frames](const rs2::frame& f) {if ((f.get_profile().stream_type() != RS2_STREAM_DEPTH) && f.is<rs2::video_frame>()) other_frames.push_back(f); });
         else
-            frames.foreach_rs([this, &other_frames](const rs2::frame& f) {if (f.get_profile().stream_type() == _to_stream_type) other_frames.push_back(f); });
+        {
+            // The first frame of each of the targets
+            for (auto type : _to_stream_types)
+            {
+                rs2::frame to;
+                frames.foreach_rs([type, &to](const rs2::frame& f) { if (!to && f.get_profile().stream_type() == type) to = f; });
+                if (to)
+                    other_frames.push_back(to);
+            }
+        }
 
+        std::vector<rs2::video_frame> aligned_frames;
         if (_to_stream_type == RS2_STREAM_DEPTH)
         {
             for (auto from : other_frames)
-            {
-                auto aligned_frame = allocate_aligned_frame(source, from, depth);
-                align_frames(aligned_frame, from, depth);
-                output_frames.push_back(aligned_frame);
-            }
+                aligned_frames.push_back(allocate_aligned_frame(source, from, depth));
+            align_others_to_depth(aligned_frames, depth, other_frames);
         }
         else
         {
-            auto to = other_frames.front();
-            auto aligned_frame = allocate_aligned_frame(source, depth, to);
-            align_frames(aligned_frame, depth, to);
-            output_frames.push_back(aligned_frame);
+            for (auto to : other_frames)
+                aligned_frames.push_back(allocate_aligned_frame(source, depth, to));
+            align_depth_to_targets(aligned_frames, depth, other_frames);
         }
+        output_frames.assign(aligned_frames.begin(), aligned_frames.end());
 
         auto new_composite = source.allocate_composite_frame(std::move(output_frames));
         return new_composite;
@@ -9,20 +9,36 @@
 #include "proc/synthetic-stream.h"
 #include "image.h"
 #include "source.h"
+#include "pixel-regions.h"
 
 namespace librealsense
 {
+    // Profile of the frames of original_profile aligned to to_profile, with the resolution and intrinsics of to_profile
+    // divided by downsample, and identity extrinsics to it
+    std::shared_ptr<rs2::video_stream_profile> make_aligned_profile(
+        rs2::video_stream_profile& original_profile,
+        rs2::video_stream_profile& to_profile,
+        int downsample = 1);
+
     class LRS_EXTENSION_API align : public generic_processing_block
     {
     public:
         align(rs2_stream to_stream);
 
+        // Aligns the depth to each of the streams, which are not depth, in one block. The output holds an aligned depth frame
+        // per target present in the frameset, in the order of the targets
+        align(std::vector<rs2_stream> to_streams);
+
+        // Regions of the depth image to align, the pixels outside them get no aligned data
+        pixel_regions& get_regions() { return _regions; }
+
     protected:
         align(rs2_stream to_stream, const char* name)
-            : generic_processing_block(name), 
-              _to_stream_type(to_stream), _depth_scale(0)
+            : align(std::vector<rs2_stream>{ to_stream }, name)
         {}
 
+        align(std::vector<rs2_stream> to_streams, const char* name);
+
         bool should_process(const rs2::frame& frame) override;
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
@@ -38,19 +54,47 @@ namespace librealsense
                                       const rs2::video_frame& other, 
                                       float z_scale);
 
+        // Same as align_z_to_other for several targets, each depth pixel is deprojected once for all of them
+        void align_z_to_others(std::vector<rs2::video_frame>& aligned,
+                               const rs2::video_frame& depth,
+                               const std::vector<rs2::video_stream_profile>& other_profiles,
+                               float z_scale);
+
+        // Same as align_other_to_z for several streams, each depth pixel is deprojected once for all of them
+        void align_others_to_z(std::vector<rs2::video_frame>& aligned,
+                               const rs2::video_frame& depth,
+                               const std::vector<rs2::video_frame>& others,
+                               float z_scale);
+
         virtual rs2_extension select_extension(const rs2::frame& input);
 
+        // The GPU implementations align the whole image
+        virtual bool supports_regions() const { return true; }
+
+        // The SIMD and GPU implementations deproject from the cached tables inside their kernels,
+        // they align to several streams one stream at a time
+        virtual bool deprojects_once() const { return true; }
+
         std::shared_ptr<rs2::video_stream_profile> create_aligned_profile(
             rs2::video_stream_profile& original_profile,
             rs2::video_stream_profile& to_profile);
 
         rs2_stream _to_stream_type;
+        std::vector<rs2_stream> _to_stream_types;
         std::map<std::pair<stream_profile_interface*, stream_profile_interface*>, std::shared_ptr<rs2::video_stream_profile>> _align_stream_unique_ids;
         rs2::stream_profile _source_stream_profile;
         float _depth_scale;
+        // The depth aligned to another stream is output at the resolution of the other divided by this factor
+        int _output_downsample;
+
+        pixel_regions _regions;
+        // The spans of the regions for the frame being aligned, null for the whole image
+        std::shared_ptr<const pixel_regions::spans> _spans;
 
     private:
         rs2::video_frame allocate_aligned_frame(const rs2::frame_source& source, const rs2::video_frame& from, const rs2::video_frame& to);
         void align_frames(rs2::video_frame& aligned, const rs2::video_frame& from, const rs2::video_frame& to);
+        void align_depth_to_targets(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth, const std::vector<rs2::frame>& targets);
+        void align_others_to_depth(std::vector<rs2::video_frame>& aligned, const rs2::video_frame& depth, const std::vector<rs2::frame>& others);
     };
 }
@@ -13,10 +13,22 @@
 
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
+#include "proc/cuda/cuda-frame.h"
 #endif
 #ifdef __SSSE3__
 #include <tmmintrin.h> // For SSSE3 intrinsics
 #endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+#ifdef RS2_USE_JPEG_TURBO
+#include <cstdio>
+#include <csetjmp>
+#include <jpeglib.h>
+#ifndef JCS_EXTENSIONS
+#error "BUILD_WITH_JPEG_TURBO requires libjpeg-turbo"
+#endif
+#endif
 
 #if defined (ANDROID) || (defined (__linux__) && !defined (__x86_64__))
 
@@ -46,6 +58,74 @@ bool has_avx()
 
 namespace librealsense 
 {
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    // clamp((298 * c + k * x + 128) >> 8) for 8 pixels, with the same rounding as the generic code
+    inline uint8x8_t yuv_to_channel_neon(int16x8_t c, int16x8_t x, int16_t k)
+    {
+        auto lo = vmlal_n_s16(vmull_n_s16(vget_low_s16(c), 298), vget_low_s16(x), k);
+        auto hi = vmlal_n_s16(vmull_n_s16(vget_high_s16(c), 298), vget_high_s16(x), k);
+        return vqmovn_u16(vcombine_u16(vqrshrun_n_s32(lo, 8), vqrshrun_n_s32(hi, 8)));
+    }
+
+    // clamp((298 * c + k1 * x1 + k2 * x2 + 128) >> 8) for 8 pixels
+    inline uint8x8_t yuv_to_channel_neon(int16x8_t c, int16x8_t x1, int16_t k1, int16x8_t x2, int16_t k2)
+    {
+        auto lo = vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_low_s16(c), 298), vget_low_s16(x1), k1), vget_low_s16(x2), k2);
+        auto hi = vmlal_n_s16(vmlal_n_s16(vmull_n_s16(vget_high_s16(c), 298), vget_high_s16(x1), k1), vget_high_s16(x2), k2);
+        return vqmovn_u16(vcombine_u16(vqrshrun_n_s32(lo, 8), vqrshrun_n_s32(hi, 8)));
+    }
+
+    // Unpacks YUY2 (Y0 U Y1 V) or UYVY (U Y0 V Y1) into Y8/Y16/RGB8/RGBA8/BGR8/BGRA8, 16 pixels per iteration.
+    // The results are identical to the generic code
+    template<rs2_format FORMAT, bool UYVY> void unpack_yuv422_neon(byte * const d[], const byte * s, int n)
+    {
+#pragma omp parallel for
+        for (int i = 0; i < n / 16; i++)
+        {
+            // Deinterleave 16 pixels, the even and odd pixels of each pair share the same U and V
+            auto in = vld4_u8(s + i * 32);
+            auto y_even = UYVY ? in.val[1] : in.val[0];
+            auto y_odd = UYVY ? in.val[3] : in.val[2];
+            auto u = UYVY ? in.val[0] : in.val[1];
+            auto v = UYVY ? in.val[2] : in.val[3];
+
+            if (FORMAT == RS2_FORMAT_Y8)
+            {
+                vst2_u8(d[0] + i * 16, uint8x8x2_t{ { y_even, y_odd } });
+                continue;
+            }
+
+            if (FORMAT == RS2_FORMAT_Y16)
+            {
+                // Y16 is little-endian.  We output Y << 8.
+                vst2q_u16(reinterpret_cast<uint16_t*>(d[0]) + i * 16, uint16x8x2_t{ { vshll_n_u8(y_even, 8), vshll_n_u8(y_odd, 8) } });
+                continue;
+            }
+
+            auto c_even = vreinterpretq_s16_u16(vsubl_u8(y_even, vdup_n_u8(16)));
+            auto c_odd = vreinterpretq_s16_u16(vsubl_u8(y_odd, vdup_n_u8(16)));
+            auto dd = vreinterpretq_s16_u16(vsubl_u8(u, vdup_n_u8(128)));
+            auto e = vreinterpretq_s16_u16(vsubl_u8(v, vdup_n_u8(128)));
+
+            // Compute R, G, B values of the even and odd pixels and restore the pixel order
+            auto r = vzip_u8(yuv_to_channel_neon(c_even, e, 409), yuv_to_channel_neon(c_odd, e, 409));
+            auto g = vzip_u8(yuv_to_channel_neon(c_even, dd, -100, e, -208), yuv_to_channel_neon(c_odd, dd, -100, e, -208));
+            auto b = vzip_u8(yuv_to_channel_neon(c_even, dd, 516), yuv_to_channel_neon(c_odd, dd, 516));
+
+            auto r16 = vcombine_u8(r.val[0], r.val[1]);
+            auto g16 = vcombine_u8(g.val[0], g.val[1]);
+            auto b16 = vcombine_u8(b.val[0], b.val[1]);
+            auto a16 = vdupq_n_u8(255);
+
+            // Store 16 pixels at once, interleaved by the store
+            if (FORMAT == RS2_FORMAT_RGB8) vst3q_u8(d[0] + i * 48, uint8x16x3_t{ { r16, g16, b16 } });
+            if (FORMAT == RS2_FORMAT_BGR8) vst3q_u8(d[0] + i * 48, uint8x16x3_t{ { b16, g16, r16 } });
+            if (FORMAT == RS2_FORMAT_RGBA8) vst4q_u8(d[0] + i * 64, uint8x16x4_t{ { r16, g16, b16, a16 } });
+            if (FORMAT == RS2_FORMAT_BGRA8) vst4q_u8(d[0] + i * 64, uint8x16x4_t{ { b16, g16, r16, a16 } });
+        }
+    }
+#endif
+
     /////////////////////////////
     // YUY2 unpacking routines //
     /////////////////////////////
@@ -219,6 +299,8 @@ namespace librealsense
                 }
             }
         }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        unpack_yuv422_neon<FORMAT, false>(d, s, n);
 #else  // Generic code for when SSSE3 is not available.
         auto src = reinterpret_cast<const uint8_t *>(s);
         auto dst = reinterpret_cast<uint8_t *>(d[0]);
@@ -382,6 +464,32 @@ namespace librealsense
         }
     }
 
+    // Unpacks YUY2 into several formats, strip by strip: each strip is unpacked into every format while its raw pixels
+    // are still in the cache, so the raw frame is read from memory once whatever the number of formats
+    void unpack_yuy2_multi(const std::vector<rs2_format>& dst_formats, byte * const d[], const byte * s, int w, int h)
+    {
+        auto n = w * h;
+#ifdef RS2_USE_CUDA
+        // The device unpacks the whole frame at once
+        for (size_t i = 0; i < dst_formats.size(); i++)
+            unpack_yuy2(dst_formats[i], RS2_STREAM_COLOR, &d[i], s, w, h, 0);
+        return;
+#endif
+        // 16 KB of YUY2 per strip, a multiple of the 16 pixels the unpacking routines process at once
+        const int STRIP_PIXELS = 8192;
+
+#pragma omp parallel for
+        for (int offset = 0; offset < n; offset += STRIP_PIXELS)
+        {
+            auto count = std::min(STRIP_PIXELS, n - offset);
+            for (size_t i = 0; i < dst_formats.size(); i++)
+            {
+                byte* dst[1] = { d[i] + offset * (get_image_bpp(dst_formats[i]) / 8) };
+                unpack_yuy2(dst_formats[i], RS2_STREAM_COLOR, dst, s + offset * 2, count, 1, 0);
+            }
+        }
+    }
+
 
     /////////////////////////////
     // UYVY unpacking routines //
@@ -519,6 +627,8 @@ namespace librealsense
                 }
             }
         }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        unpack_yuv422_neon<FORMAT, true>(d, s, n);
 #else  // Generic code for when SSSE3 is not available.
         auto src = reinterpret_cast<const uint8_t *>(s);
         auto dst = reinterpret_cast<uint8_t *>(d[0]);
@@ -652,8 +762,154 @@ namespace librealsense
     /////////////////////////////
     // MJPEG unpacking routines //
     /////////////////////////////
-    void unpack_mjpeg(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
+#ifdef RS2_USE_JPEG_TURBO
+    struct jpeg_error_handler
+    {
+        jpeg_error_mgr mgr;
+        jmp_buf jump;
+    };
+
+    static void on_jpeg_error(j_common_ptr info)
+    {
+        char message[JMSG_LENGTH_MAX];
+        info->err->format_message(info, message);
+        LOG_ERROR("jpeg decode failed: " << message);
+        longjmp(reinterpret_cast<jpeg_error_handler*>(info->err)->jump, 1);
+    }
+
+    static void on_jpeg_message(j_common_ptr info) {}
+
+    // Packs rows of YCbCr pixels to YUYV, the chroma of each pair is taken from its first pixel
+    static void pack_yuyv(byte * dest, const JSAMPLE * y, int y_step, const JSAMPLE * cb, const JSAMPLE * cr, int c_step, int width)
+    {
+        for (int x = 0; x < width; x += 2)
+        {
+            *dest++ = y[0];
+            *dest++ = *cb;
+            *dest++ = y[y_step];
+            *dest++ = *cr;
+            y += 2 * y_step;
+            cb += c_step;
+            cr += c_step;
+        }
+    }
+
+    static void read_mjpeg_yuyv(jpeg_decompress_struct & info, byte * dest, int width, int height)
+    {
+        auto stride = width * 2;
+        auto comp = info.comp_info;
+        bool h2v1 = info.jpeg_color_space == JCS_YCbCr && info.num_components == 3 &&
+            comp[0].h_samp_factor == 2 && comp[0].v_samp_factor == 1 &&
+            comp[1].h_samp_factor == 1 && comp[1].v_samp_factor == 1 &&
+            comp[2].h_samp_factor == 1 && comp[2].v_samp_factor == 1;
+
+        if (h2v1)
+        {
+            // 4:2:2 streams already hold YUYV, so the planes are read as they are without upsampling or color conversion
+            info.raw_data_out = TRUE;
+            jpeg_start_decompress(&info);
+
+            JSAMPARRAY planes[3];
+            for (int i = 0; i < 3; ++i)
+                planes[i] = (*info.mem->alloc_sarray)(reinterpret_cast<j_common_ptr>(&info), JPOOL_IMAGE, comp[i].width_in_blocks * DCTSIZE, DCTSIZE);
+
+            while (info.output_scanline < info.output_height)
+            {
+                int first = info.output_scanline;
+                jpeg_read_raw_data(&info, planes, DCTSIZE);
+                for (int r = 0; r < DCTSIZE && first + r < height; ++r)
+                    pack_yuyv(dest + (first + r) * stride, planes[0][r], 1, planes[1][r], planes[2][r], 1, width);
+            }
+        }
+        else
+        {
+            info.out_color_space = JCS_YCbCr;
+            jpeg_start_decompress(&info);
+
+            auto row = (*info.mem->alloc_sarray)(reinterpret_cast<j_common_ptr>(&info), JPOOL_IMAGE, width * 3, 1);
+            while (info.output_scanline < info.output_height)
+            {
+                int first = info.output_scanline;
+                jpeg_read_scanlines(&info, row, 1);
+                pack_yuyv(dest + first * stride, row[0], 3, row[0] + 1, row[0] + 2, 6, width);
+            }
+        }
+    }
+
+    // Decodes straight into the output frame, the decoder converts to the target format on the way
+    static bool unpack_mjpeg_turbo(rs2_format dst_format, byte * dest, const byte * source, int width, int height, int actual_size)
+    {
+        jpeg_decompress_struct info;
+        jpeg_error_handler error;
+        info.err = jpeg_std_error(&error.mgr);
+        error.mgr.error_exit = on_jpeg_error;
+        error.mgr.output_message = on_jpeg_message;
+
+        // Nothing that needs destruction may live in this scope, the decoder errors jump back here
+        if (setjmp(error.jump))
+        {
+            jpeg_destroy_decompress(&info);
+            return false;
+        }
+
+        jpeg_create_decompress(&info);
+        jpeg_mem_src(&info, const_cast<unsigned char*>(source), actual_size);
+        jpeg_read_header(&info, TRUE);
+
+        if (int(info.image_width) != width || int(info.image_height) != height || (width & 1))
+        {
+            LOG_ERROR("jpeg decode failed: unexpected image size " << info.image_width << "x" << info.image_height);
+            jpeg_destroy_decompress(&info);
+            return false;
+        }
+
+        if (dst_format == RS2_FORMAT_YUYV)
+        {
+            read_mjpeg_yuyv(info, dest, width, height);
+        }
+        else
+        {
+            switch (dst_format)
+            {
+            case RS2_FORMAT_RGB8: info.out_color_space = JCS_EXT_RGB; break;
+            case RS2_FORMAT_BGR8: info.out_color_space = JCS_EXT_BGR; break;
+            case RS2_FORMAT_RGBA8: info.out_color_space = JCS_EXT_RGBA; break;
+            case RS2_FORMAT_BGRA8: info.out_color_space = JCS_EXT_BGRA; break;
+            default:
+                LOG_ERROR("Unsupported format for MJPEG conversion.");
+                jpeg_destroy_decompress(&info);
+                return false;
+            }
+            jpeg_start_decompress(&info);
+
+            auto stride = width * info.output_components;
+            while (info.output_scanline < info.output_height)
+            {
+                JSAMPROW rows[DCTSIZE];
+                int count = std::min<int>(DCTSIZE, info.output_height - info.output_scanline);
+                for (int r = 0; r < count; ++r)
+                    rows[r] = dest + (info.output_scanline + r) * stride;
+                jpeg_read_scanlines(&info, rows, count);
+            }
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+        return true;
+    }
+#endif
+
+    void unpack_mjpeg(rs2_format dst_format, byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
     {
+#ifdef RS2_USE_JPEG_TURBO
+        unpack_mjpeg_turbo(dst_format, dest[0], source, width, height, actual_size);
+#else
+        if (dst_format != RS2_FORMAT_RGB8)
+        {
+            LOG_ERROR("Unsupported format for MJPEG conversion.");
+            return;
+        }
+
         int w, h, bpp;
         auto uncompressed_rgb = stbi_load_from_memory(source, actual_size, &w, &h, &bpp, false);
         if (uncompressed_rgb)
@@ -664,6 +920,7 @@ namespace librealsense
         }
         else
             LOG_ERROR("jpeg decode failed");
+#endif
     }
 
     /////////////////////////////
@@ -682,11 +939,77 @@ namespace librealsense
         }
     }
 
+    yuy2_converter::yuy2_converter(const char* name, rs2_format target_format) :
+        color_converter(name, target_format)
+    {
+#ifdef RS2_USE_CUDA
+        // The converted frames are allocated in pinned memory, so their download is a direct DMA
+        if (target_format != RS2_FORMAT_Y8)
+            set_frame_allocator(make_pinned_frame_allocator());
+#endif
+    }
+
     void yuy2_converter::process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
     {
         unpack_yuy2(_target_format, _target_stream, dest, source, width, height, actual_size);
     }
 
+#ifdef RS2_USE_CUDA
+    rs2::frame yuy2_converter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        // Y8 has no CUDA kernel
+        if (_target_format == RS2_FORMAT_Y8)
+            return color_converter::process_frame(source, f);
+
+        // The converted image stays on the device for the next CUDA block and is downloaded on the first host access
+        auto ret = prepare_frame(source, f);
+        auto vf = ret.as<rs2::video_frame>();
+        auto n = vf.get_width() * vf.get_height();
+        auto d_src = _cuda.get_gpu_data(f);
+        auto d_dst = alloc_gpu_data(vf.get_data_size());
+        rscuda::unpack_yuy2_cuda_async(d_src.get(), d_dst.get(), n, _target_format, _cuda.compute_stream());
+        _cuda.set_gpu_data(ret, d_dst);
+        return ret;
+    }
+#endif
+
+    yuy2_multi_converter::yuy2_multi_converter(const std::vector<rs2_format>& target_formats) :
+        stream_filter_processing_block("YUY Multi-Format Converter"), _target_formats(target_formats)
+    {
+        _stream_filter.format = RS2_FORMAT_YUYV;
+    }
+
+    rs2::frame yuy2_multi_converter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto p = f.get_profile();
+        if (p.get() != _source_stream_profile.get())
+        {
+            _source_stream_profile = p;
+            _target_stream_profiles.clear();
+            for (auto format : _target_formats)
+                _target_stream_profiles.push_back(p.clone(p.stream_type(), p.stream_index(), format));
+        }
+
+        auto vf = f.as<rs2::video_frame>();
+        auto width = vf.get_width();
+        auto height = vf.get_height();
+
+        std::vector<rs2::frame> outputs;
+        std::vector<byte*> dests;
+        for (size_t i = 0; i < _target_formats.size(); i++)
+        {
+            auto bpp = get_image_bpp(_target_formats[i]) / 8;
+            auto out = source.allocate_video_frame(_target_stream_profiles[i], f, bpp, width, height, width * bpp, RS2_EXTENSION_VIDEO_FRAME);
+            if (!out)
+                return {};
+            dests.push_back((byte*)out.get_data());
+            outputs.push_back(out);
+        }
+
+        unpack_yuy2_multi(_target_formats, dests.data(), static_cast<const byte*>(f.get_data()), width, height);
+        return source.allocate_composite_frame(outputs);
+    }
+
     void uyvy_converter::process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
     {
         unpack_uyvyc(_target_format, _target_stream, dest, source, width, height, actual_size);
@@ -694,7 +1017,7 @@ namespace librealsense
 
     void mjpeg_converter::process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
     {
-        unpack_mjpeg(dest, source, width, height, actual_size, input_size);
+        unpack_mjpeg(_target_format, dest, source, width, height, actual_size, input_size);
     }
 
     void bgr_to_rgb::process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size)
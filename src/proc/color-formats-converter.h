@@ -4,6 +4,7 @@
 #pragma once
 
 #include "synthetic-stream.h"
+#include "proc/cuda/cuda-frame.h"
 
 namespace librealsense
 {
@@ -21,9 +22,32 @@ namespace librealsense
             yuy2_converter("YUY Converter", target_format) {};
 
     protected:
-        yuy2_converter(const char* name, rs2_format target_format) :
-            color_converter(name, target_format) {};
+        yuy2_converter(const char* name, rs2_format target_format);
+#ifdef RS2_USE_CUDA
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+#endif
         void process_function(byte * const dest[], const byte * source, int width, int height, int actual_size, int input_size) override;
+
+#ifdef RS2_USE_CUDA
+    private:
+        cuda_context _cuda;
+#endif
+    };
+
+    // Unpacks each YUY2 frame into several formats in one pass over the raw frame, for the requests of several formats
+    // of the same stream. The frames of the formats are output together in a composite frame
+    class LRS_EXTENSION_API yuy2_multi_converter : public stream_filter_processing_block
+    {
+    public:
+        yuy2_multi_converter(const std::vector<rs2_format>& target_formats);
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        std::vector<rs2_format> _target_formats;
+        rs2::stream_profile _source_stream_profile;
+        std::vector<rs2::stream_profile> _target_stream_profiles;
     };
 
     class LRS_EXTENSION_API uyvy_converter : public color_converter
@@ -143,7 +143,7 @@ namespace librealsense
          _min(0.f), _max(6.f), _equalize(true), 
          _target_stream_profile(), _histogram()
     {
-        _histogram = std::vector<int>(MAX_DEPTH, 0);
+        _histogram = cache_vector<int>(MAX_DEPTH, 0);
         _hist_data = _histogram.data();
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -222,6 +222,19 @@ namespace librealsense
         register_option(RS2_OPTION_HISTOGRAM_EQUALIZATION_ENABLED, hist_opt);
     }
 
+    void colorizer::make_rgb_data_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height)
+    {
+        auto lut = _lut.data();
+        auto pixels = width * height;
+        if (!pixels)
+            return;
+
+        // Every entry is copied as 4 bytes, the extra byte being overwritten by the next pixel
+        for (auto i = 0; i < pixels - 1; ++i)
+            memcpy(rgb_data + i * 3, lut + depth_data[i] * 4, 4);
+        memcpy(rgb_data + (pixels - 1) * 3, lut + depth_data[pixels - 1] * 4, 3);
+    }
+
     bool colorizer::should_process(const rs2::frame& frame)
     {
         if (!frame || frame.is<rs2::frameset>())
@@ -266,7 +279,16 @@ namespace librealsense
             {
                 auto depth_data = reinterpret_cast<const uint16_t*>(depth.get_data());
                 update_histogram(_hist_data, depth_data, w, h);
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+
+                // Only the depth values present in the frame need an entry: the cumulative histogram
+                // grows from the first of them and reaches the pixels count at the last one
+                auto hist_end = _hist_data + MAX_DEPTH;
+                auto first = std::upper_bound(_hist_data + 1, hist_end, 0);
+                auto last = std::lower_bound(_hist_data + 1, hist_end, _hist_data[MAX_DEPTH - 1]);
+                update_lut(int(first - _hist_data), int(last - _hist_data), coloring_function);
+                _lut_valid = false;
+
+                make_rgb_data_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -298,7 +320,19 @@ namespace librealsense
                 auto coloring_function = [&, this](float data) {
                     return (data * _depth_units - min) / (max - min);
                 };
-                make_rgb_data<uint16_t>(depth_data, rgb_data, w, h, coloring_function);
+
+                if (!_lut_valid || _lut_min != min || _lut_max != max ||
+                    _lut_depth_units != _depth_units || _lut_map_index != _map_index)
+                {
+                    update_lut(1, MAX_DEPTH - 1, coloring_function);
+                    _lut_min = min;
+                    _lut_max = max;
+                    _lut_depth_units = _depth_units;
+                    _lut_map_index = _map_index;
+                    _lut_valid = true;
+                }
+
+                make_rgb_data_lut(depth_data, rgb_data, w, h);
             }
         };
 
@@ -5,6 +5,9 @@
 
 #include <map>
 #include <vector>
+#include <algorithm>
+
+#include "memory-counter.h"
 
 namespace rs2
 {
@@ -134,6 +137,23 @@ namespace librealsense {
             }
         }
 
+        // Fills the lookup table entries of the depth values [first, last]
+        template<typename F>
+        void update_lut(int first, int last, F coloring_func)
+        {
+            auto cm = _maps[_map_index];
+            _lut.resize(MAX_DEPTH * 4);
+            for (auto d = std::max(first, 1); d <= last; ++d)
+            {
+                auto c = cm->get(coloring_func(static_cast<float>(d)));
+                _lut[d * 4 + 0] = (uint8_t)c.x;
+                _lut[d * 4 + 1] = (uint8_t)c.y;
+                _lut[d * 4 + 2] = (uint8_t)c.z;
+            }
+        }
+
+        void make_rgb_data_lut(const uint16_t* depth_data, uint8_t* rgb_data, int width, int height);
+
         template<typename T, typename F>
         void colorize_pixel(uint8_t* rgb_data, int idx, color_map* cm, T data, F coloring_func)
         {
@@ -159,7 +179,7 @@ namespace librealsense {
         std::vector<color_map*> _maps;
         int _map_index = 0;
 
-        std::vector<int> _histogram;
+        cache_vector<int> _histogram;
         int* _hist_data;
 
         int _preset = 0;
@@ -168,5 +188,14 @@ namespace librealsense {
 
         float   _depth_units = 0.f;
         float   _d2d_convert_factor = 0.f;
+
+        // Z16 to RGB8 lookup table, 4 bytes per depth value (zero stays black). For fixed ranges it is only
+        // rebuilt when the range, the color map or the depth units change, equalization refills it per frame
+        cache_vector<uint8_t> _lut;
+        bool    _lut_valid = false;
+        float   _lut_min = 0.f;
+        float   _lut_max = 0.f;
+        float   _lut_depth_units = 0.f;
+        int     _lut_map_index = -1;
     };
 }
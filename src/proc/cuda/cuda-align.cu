@@ -135,14 +135,11 @@ __global__  void kernel_replace_to_zero(uint16_t* aligned_out, const rs2_intrins
         aligned_out[other_pixel_index] = 0;
 }
 
-void align_cuda_helper::align_other_to_depth(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
+void align_cuda_helper::align_other_to_depth(unsigned char* d_aligned_out, const uint16_t* d_depth_in,
     float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-    const rs2_intrinsics& h_other_intrin, const unsigned char* h_other_in, rs2_format other_format, int other_bytes_per_pixel)
+    const rs2_intrinsics& h_other_intrin, const unsigned char* d_other_in, rs2_format other_format, int other_bytes_per_pixel, cudaStream_t stream)
 {
     int depth_pixel_count = h_depth_intrin.width * h_depth_intrin.height;
-    int other_pixel_count = h_other_intrin.width * h_other_intrin.height;
-    int depth_size = depth_pixel_count * 2;
-    int other_size = other_pixel_count * other_bytes_per_pixel;
     int aligned_pixel_count = depth_pixel_count;
     int aligned_size = aligned_pixel_count * other_bytes_per_pixel;
 
@@ -151,15 +148,7 @@ void align_cuda_helper::align_other_to_depth(unsigned char* h_aligned_out, const
     if (!_d_other_intrinsics) _d_other_intrinsics = make_device_copy(h_other_intrin);
     if (!_d_depth_other_extrinsics) _d_depth_other_extrinsics = make_device_copy(h_depth_to_other);
 
-    if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(aligned_pixel_count);
-    cudaMemcpy(_d_depth_in.get(), h_depth_in, depth_size, cudaMemcpyHostToDevice);
-
-    if (!_d_other_in) _d_other_in = alloc_dev<unsigned char>(other_size);
-    cudaMemcpy(_d_other_in.get(), h_other_in, other_size, cudaMemcpyHostToDevice);
-
-    if (!_d_aligned_out)
-        _d_aligned_out = alloc_dev<unsigned char>(aligned_size);
-    cudaMemset(_d_aligned_out.get(), 0, aligned_size);
+    cudaMemsetAsync(d_aligned_out, 0, aligned_size, stream);
 
     if (!_d_pixel_map) _d_pixel_map = alloc_dev<int2>(depth_pixel_count * 2);
 
@@ -168,31 +157,26 @@ void align_cuda_helper::align_other_to_depth(unsigned char* h_aligned_out, const
     dim3 depth_blocks(calc_block_size(h_depth_intrin.width, threads.x), calc_block_size(h_depth_intrin.height, threads.y));
     dim3 mapping_blocks(depth_blocks.x, depth_blocks.y, 2);
 
-    kernel_map_depth_to_other <<<mapping_blocks,threads>>> (_d_pixel_map.get(), _d_depth_in.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get(),
+    kernel_map_depth_to_other <<<mapping_blocks, threads, 0, stream>>> (_d_pixel_map.get(), d_depth_in, _d_depth_intrinsics.get(), _d_other_intrinsics.get(),
         _d_depth_other_extrinsics.get(), depth_scale);
 
     switch (other_bytes_per_pixel)
     {
-    case 1: kernel_other_to_depth<1> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 2: kernel_other_to_depth<2> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 3: kernel_other_to_depth<3> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
-    case 4: kernel_other_to_depth<4> <<<depth_blocks,threads>>> (_d_aligned_out.get(), _d_other_in.get(), _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 1: kernel_other_to_depth<1> <<<depth_blocks, threads, 0, stream>>> (d_aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 2: kernel_other_to_depth<2> <<<depth_blocks, threads, 0, stream>>> (d_aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 3: kernel_other_to_depth<3> <<<depth_blocks, threads, 0, stream>>> (d_aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
+    case 4: kernel_other_to_depth<4> <<<depth_blocks, threads, 0, stream>>> (d_aligned_out, d_other_in, _d_pixel_map.get(), _d_depth_intrinsics.get(), _d_other_intrinsics.get()); break;
     }
-
-    cudaDeviceSynchronize();
-
-    cudaMemcpy(h_aligned_out, _d_aligned_out.get(), aligned_size, cudaMemcpyDeviceToHost);
 }
 
-void align_cuda_helper::align_depth_to_other(unsigned char* h_aligned_out, const uint16_t* h_depth_in,
+void align_cuda_helper::align_depth_to_other(unsigned char* d_aligned_out, const uint16_t* d_depth_in,
     float depth_scale, const rs2_intrinsics& h_depth_intrin, const rs2_extrinsics& h_depth_to_other,
-    const rs2_intrinsics& h_other_intrin)
+    const rs2_intrinsics& h_other_intrin, cudaStream_t stream)
 {
     int depth_pixel_count = h_depth_intrin.width * h_depth_intrin.height;
     int other_pixel_count = h_other_intrin.width * h_other_intrin.height;
     int aligned_pixel_count = other_pixel_count;
 
-    int depth_byte_size = depth_pixel_count * 2;
     int aligned_byte_size = aligned_pixel_count * 2;
 
     // allocate and copy objects to cuda device memory
@@ -200,11 +184,7 @@ void align_cuda_helper::align_depth_to_other(unsigned char* h_aligned_out, const
     if (!_d_other_intrinsics) _d_other_intrinsics = make_device_copy(h_other_intrin);
     if (!_d_depth_other_extrinsics) _d_depth_other_extrinsics = make_device_copy(h_depth_to_other);
 
-    if (!_d_depth_in) _d_depth_in = alloc_dev<uint16_t>(depth_pixel_count);
-    cudaMemcpy(_d_depth_in.get(), h_depth_in, depth_byte_size, cudaMemcpyHostToDevice);
-
-    if (!_d_aligned_out) _d_aligned_out = alloc_dev<unsigned char>(aligned_byte_size);
-    cudaMemset(_d_aligned_out.get(), 0xff, aligned_byte_size);
+    cudaMemsetAsync(d_aligned_out, 0xff, aligned_byte_size, stream);
 
     if (!_d_pixel_map) _d_pixel_map = alloc_dev<int2>(depth_pixel_count * 2);
 
@@ -214,17 +194,13 @@ void align_cuda_helper::align_depth_to_other(unsigned char* h_aligned_out, const
     dim3 other_blocks(calc_block_size(h_other_intrin.width, threads.x), calc_block_size(h_other_intrin.height, threads.y));
     dim3 mapping_blocks(depth_blocks.x, depth_blocks.y, 2);
 
-    kernel_map_depth_to_other <<<mapping_blocks,threads>>> (_d_pixel_map.get(), _d_depth_in.get(), _d_depth_intrinsics.get(),
+    kernel_map_depth_to_other <<<mapping_blocks, threads, 0, stream>>> (_d_pixel_map.get(), d_depth_in, _d_depth_intrinsics.get(),
         _d_other_intrinsics.get(), _d_depth_other_extrinsics.get(), depth_scale);
 
-    kernel_depth_to_other <<<depth_blocks,threads>>> ((uint16_t*)_d_aligned_out.get(), _d_depth_in.get(), _d_pixel_map.get(),
+    kernel_depth_to_other <<<depth_blocks, threads, 0, stream>>> ((uint16_t*)d_aligned_out, d_depth_in, _d_pixel_map.get(),
         _d_depth_intrinsics.get(), _d_other_intrinsics.get());
 
-    kernel_replace_to_zero <<<other_blocks, threads>>> ((uint16_t*)_d_aligned_out.get(), _d_other_intrinsics.get());
-
-    cudaDeviceSynchronize();
-
-    cudaMemcpy(h_aligned_out, _d_aligned_out.get(), aligned_pixel_count * 2, cudaMemcpyDeviceToHost);
+    kernel_replace_to_zero <<<other_blocks, threads, 0, stream>>> ((uint16_t*)d_aligned_out, _d_other_intrinsics.get());
 }
 
 #endif //RS2_USE_CUDA
@@ -5,6 +5,7 @@
 
 #include "proc/align.h"
 #include "cuda-align.cuh"
+#include "cuda-frame.h"
 #include <memory>
 #include <stdint.h>
 
@@ -13,19 +14,26 @@ namespace librealsense
     class align_cuda : public align
     {
     public:
-        align_cuda(rs2_stream align_to) : align(align_to, "Align (CUDA)") {}
+        // The aligned frames are allocated in pinned memory, so their download is a direct DMA
+        align_cuda(std::vector<rs2_stream> align_to) : align(align_to, "Align (CUDA)")
+        {
+            set_frame_allocator(make_pinned_frame_allocator());
+        }
 
     protected:
+        bool deprojects_once() const override { return false; }
+
         void reset_cache(rs2_stream from, rs2_stream to) override
         {
             aligners[std::tuple<rs2_stream, rs2_stream>(from, to)] = align_cuda_helper();
         }
 
+        // The inputs are used from the device when a CUDA block produced them, and the aligned frame stays on the device
+        // until its host data is accessed
         void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override
         {
-            byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
             auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+            auto aligned_data = alloc_gpu_data(aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
 
             auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
 
@@ -33,17 +41,18 @@ namespace librealsense
             auto other_intrin = other_profile.get_intrinsics();
             auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-            auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+            auto z_pixels = _cuda.get_gpu_data(depth);
             auto& aligner = aligners[std::tuple<rs2_stream, rs2_stream>(RS2_STREAM_DEPTH, other_profile.stream_type())];
-            aligner.align_depth_to_other(aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin);
+            aligner.align_depth_to_other(aligned_data.get(), reinterpret_cast<const uint16_t*>(z_pixels.get()), z_scale, z_intrin, z_to_other, other_intrin,
+                _cuda.compute_stream());
+            _cuda.set_gpu_data(aligned, aligned_data);
         }
 
         void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override
         {
-            byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
             auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
-            memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
-            
+            auto aligned_data = alloc_gpu_data(aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+
             auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
             auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
 
@@ -51,16 +60,19 @@ namespace librealsense
             auto other_intrin = other_profile.get_intrinsics();
             auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
 
-            auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
-            auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
+            auto z_pixels = _cuda.get_gpu_data(depth);
+            auto other_pixels = _cuda.get_gpu_data(other);
 
             auto& aligner = aligners[std::tuple<rs2_stream, rs2_stream>(other_profile.stream_type(), RS2_STREAM_DEPTH)];
-            aligner.align_other_to_depth(
-                aligned_data, z_pixels, z_scale, z_intrin, z_to_other, other_intrin, other_pixels, other_profile.format(), other.get_bytes_per_pixel());
+            aligner.align_other_to_depth(aligned_data.get(), reinterpret_cast<const uint16_t*>(z_pixels.get()), z_scale, z_intrin, z_to_other,
+                other_intrin, other_pixels.get(), other_profile.format(), other.get_bytes_per_pixel(), _cuda.compute_stream());
+            _cuda.set_gpu_data(aligned, aligned_data);
         }
 
     private:
         std::map<std::tuple<rs2_stream, rs2_stream>, align_cuda_helper> aligners;
+        // The frames are queued on the device without waiting, the next frame is uploaded while the kernels of this one run
+        cuda_context _cuda;
     };
 }
 #endif // RS2_USE_CUDA
@@ -0,0 +1,266 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#ifdef RS2_USE_CUDA
+
+#include "proc/cuda/cuda-frame.h"
+#include "archive.h"
+
+#include <cuda_runtime.h>
+
+#ifdef _MSC_VER
+// Add library dependencies if using VS
+#pragma comment(lib, "cudart_static")
+#endif
+
+namespace librealsense
+{
+    // What a frame holds as its device data, the event is recorded after the work writing the buffer
+    struct gpu_frame_data
+    {
+        std::shared_ptr<uint8_t> data;
+        std::shared_ptr<CUevent_st> ready;
+    };
+
+    static void check(cudaError_t res, const char* call)
+    {
+        if (res != cudaSuccess)
+            throw backend_exception(to_string() << call << " failed: " << cudaGetErrorString(res), RS2_EXCEPTION_TYPE_BACKEND);
+    }
+
+    static frame* to_frame(const rs2::frame& f)
+    {
+        auto fr = dynamic_cast<frame*>((frame_interface*)f.get());
+        if (!fr)
+            throw invalid_value_exception("frame does not support device data");
+        return fr;
+    }
+
+    static std::shared_ptr<CUevent_st> create_event()
+    {
+        cudaEvent_t event;
+        check(cudaEventCreateWithFlags(&event, cudaEventDisableTiming), "cudaEventCreateWithFlags");
+        return std::shared_ptr<CUevent_st>(event, [](cudaEvent_t e) { cudaEventDestroy(e); });
+    }
+
+    static bool is_pinned(const void* ptr)
+    {
+        cudaPointerAttributes attributes;
+        if (cudaPointerGetAttributes(&attributes, ptr) != cudaSuccess)
+        {
+            cudaGetLastError(); // Pageable memory unknown to CUDA is reported as an error by older runtimes
+            return false;
+        }
+        return attributes.type == cudaMemoryTypeHost;
+    }
+
+    // Device buffers are recycled rather than freed, cudaFree waits for the whole device and would serialize the blocks.
+    // A buffer returns to the pool once nothing references it, the contexts reference the buffers their queued work uses
+    class gpu_buffer_pool : public std::enable_shared_from_this<gpu_buffer_pool>
+    {
+    public:
+        static const size_t MAX_FREE_BUFFERS_PER_SIZE = 16;
+
+        static std::shared_ptr<gpu_buffer_pool> instance()
+        {
+            static auto pool = std::make_shared<gpu_buffer_pool>();
+            return pool;
+        }
+
+        std::shared_ptr<uint8_t> allocate(size_t size)
+        {
+            uint8_t* data = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _free.find(size);
+                if (it != _free.end())
+                {
+                    data = it->second;
+                    _free.erase(it);
+                }
+            }
+            if (!data)
+                check(cudaMalloc(&data, size), "cudaMalloc");
+
+            auto pool = shared_from_this();
+            return std::shared_ptr<uint8_t>(data, [pool, size](uint8_t* p) { pool->release(p, size); });
+        }
+
+    private:
+        void release(uint8_t* data, size_t size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_free.count(size) < MAX_FREE_BUFFERS_PER_SIZE)
+                {
+                    _free.emplace(size, data);
+                    return;
+                }
+            }
+            cudaFree(data);
+        }
+
+        std::mutex _mutex;
+        std::multimap<size_t, uint8_t*> _free;
+    };
+
+    std::shared_ptr<uint8_t> alloc_gpu_data(size_t size)
+    {
+        return gpu_buffer_pool::instance()->allocate(size);
+    }
+
+    class pinned_frame_allocator : public rs2_frame_allocator
+    {
+    public:
+        void* allocate(size_t size) override
+        {
+            void* ptr;
+            if (cudaMallocHost(&ptr, size) != cudaSuccess)
+                return nullptr;
+            return ptr;
+        }
+        void deallocate(void* ptr, size_t) override { cudaFreeHost(ptr); }
+        void release() override { delete this; }
+    };
+
+    std::shared_ptr<rs2_frame_allocator> make_pinned_frame_allocator()
+    {
+        return std::shared_ptr<rs2_frame_allocator>(new pinned_frame_allocator(), [](rs2_frame_allocator* p) { p->release(); });
+    }
+
+    struct cuda_context::impl
+    {
+        // Uploads of pageable frames go through these in turns, a buffer is refilled once the copy out of it completed
+        struct staging
+        {
+            uint8_t* host = nullptr;
+            size_t size = 0;
+            std::shared_ptr<CUevent_st> copied;
+        };
+
+        impl()
+        {
+            // Blocking streams, so the one-time copies of the helpers on the default stream complete before the kernels use them
+            check(cudaStreamCreate(&compute), "cudaStreamCreate");
+            check(cudaStreamCreate(&copy), "cudaStreamCreate");
+            for (auto&& s : uploads)
+                s.copied = create_event();
+        }
+
+        ~impl()
+        {
+            cudaStreamSynchronize(compute);
+            cudaStreamSynchronize(copy);
+            for (auto&& s : uploads)
+                cudaFreeHost(s.host);
+            cudaStreamDestroy(compute);
+            cudaStreamDestroy(copy);
+        }
+
+        void upload(uint8_t* d_dst, const void* src, size_t size)
+        {
+            if (is_pinned(src))
+            {
+                // The frame may be released once this returns, so the DMA straight from it is waited for
+                check(cudaMemcpyAsync(d_dst, src, size, cudaMemcpyHostToDevice, copy), "cudaMemcpyAsync");
+                check(cudaStreamSynchronize(copy), "cudaStreamSynchronize");
+                return;
+            }
+
+            auto& s = uploads[next_upload++ % uploads.size()];
+            check(cudaEventSynchronize(s.copied.get()), "cudaEventSynchronize");
+            if (s.size < size)
+            {
+                cudaFreeHost(s.host);
+                s.host = nullptr;
+                s.size = 0;
+                check(cudaMallocHost(&s.host, size), "cudaMallocHost");
+                s.size = size;
+            }
+            memcpy(s.host, src, size);
+            check(cudaMemcpyAsync(d_dst, s.host, size, cudaMemcpyHostToDevice, copy), "cudaMemcpyAsync");
+            check(cudaEventRecord(s.copied.get(), copy), "cudaEventRecord");
+            check(cudaStreamWaitEvent(compute, s.copied.get(), 0), "cudaStreamWaitEvent");
+        }
+
+        // Releases the buffers of the work the device completed
+        void retire_completed()
+        {
+            while (!in_flight.empty() && cudaEventQuery(in_flight.front().first.get()) == cudaSuccess)
+                in_flight.pop_front();
+        }
+
+        cudaStream_t compute = nullptr;
+        cudaStream_t copy = nullptr;
+        std::array<staging, 2> uploads;
+        size_t next_upload = 0;
+
+        // Buffers used by the work queued on the compute stream, held until the event recorded after that work
+        std::vector<std::shared_ptr<uint8_t>> used;
+        std::deque<std::pair<std::shared_ptr<CUevent_st>, std::vector<std::shared_ptr<uint8_t>>>> in_flight;
+    };
+
+    cuda_context::cuda_context() : _impl(std::make_shared<impl>()) {}
+
+    CUstream_st* cuda_context::compute_stream() const
+    {
+        return _impl->compute;
+    }
+
+    std::shared_ptr<uint8_t> cuda_context::get_gpu_data(const rs2::frame& f)
+    {
+        _impl->retire_completed();
+
+        auto fr = to_frame(f);
+        if (auto attached = std::static_pointer_cast<gpu_frame_data>(fr->get_gpu_data()))
+        {
+            if (attached->ready)
+                check(cudaStreamWaitEvent(_impl->compute, attached->ready.get(), 0), "cudaStreamWaitEvent");
+            _impl->used.push_back(attached->data);
+            return attached->data;
+        }
+
+        auto size = static_cast<size_t>(fr->get_frame_data_size());
+        auto data = alloc_gpu_data(size);
+        _impl->upload(data.get(), fr->get_frame_data(), size);
+
+        // Concurrent consumers may both upload, the frame keeps one of the copies
+        auto ready = create_event();
+        check(cudaEventRecord(ready.get(), _impl->copy), "cudaEventRecord");
+        fr->set_gpu_data(std::make_shared<gpu_frame_data>(gpu_frame_data{ data, ready }));
+        _impl->used.push_back(data);
+        return data;
+    }
+
+    void cuda_context::set_gpu_data(const rs2::frame& f, std::shared_ptr<uint8_t> data)
+    {
+        auto fr = to_frame(f);
+        auto host = const_cast<byte*>(fr->get_frame_data());
+        auto size = static_cast<size_t>(fr->get_frame_data_size());
+
+        auto ready = create_event();
+        check(cudaEventRecord(ready.get(), _impl->compute), "cudaEventRecord");
+        fr->set_gpu_data(std::make_shared<gpu_frame_data>(gpu_frame_data{ data, ready }));
+        _impl->used.push_back(data);
+        _impl->in_flight.emplace_back(ready, std::move(_impl->used));
+        _impl->used.clear();
+
+        // The context outlives the block while frames it produced wait for their download
+        auto ctx = _impl;
+        fr->defer_processing([ctx, data, ready, host, size]()
+        {
+            cudaStreamWaitEvent(ctx->copy, ready.get(), 0);
+            cudaMemcpyAsync(host, data.get(), size, cudaMemcpyDeviceToHost, ctx->copy);
+            cudaStreamSynchronize(ctx->copy);
+        });
+    }
+
+    void cuda_context::download(void* dst, const void* d_src, size_t size)
+    {
+        check(cudaMemcpyAsync(dst, d_src, size, cudaMemcpyDeviceToHost, _impl->compute), "cudaMemcpyAsync");
+        check(cudaStreamSynchronize(_impl->compute), "cudaStreamSynchronize");
+        _impl->in_flight.clear();
+        _impl->used.clear();
+    }
+}
+#endif // RS2_USE_CUDA
@@ -0,0 +1,54 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#ifdef RS2_USE_CUDA
+
+#include "../include/librealsense2/hpp/rs_frame.hpp"
+#include <memory>
+#include <stdint.h>
+
+struct CUstream_st;
+
+// Device resident frames let the CUDA processing blocks run chained on the GPU.
+// A block producing a frame on the device attaches the device buffer to it and the host copy
+// is only downloaded when the host data is accessed, a block consuming a frame uses the attached buffer
+// and uploads the host data only when the frame was produced on the host.
+namespace librealsense
+{
+    // Allocates a device buffer of size bytes
+    std::shared_ptr<uint8_t> alloc_gpu_data(size_t size);
+
+    // Frame allocator of page-locked host memory, the device copies to and from the frames of a block using it
+    // are DMA transfers that don't go through the driver's staging buffers
+    std::shared_ptr<rs2_frame_allocator> make_pinned_frame_allocator();
+
+    // The CUDA streams and the pinned upload staging of a processing block.
+    // The block's uploads, kernels and downloads are queued without waiting on the device: uploads run on a copy stream
+    // while the kernels of the previous frame still run on the compute stream, and blocks don't serialize against each other
+    // Not thread safe, a block processes its frames one at a time
+    class cuda_context
+    {
+    public:
+        cuda_context();
+
+        // The stream the block launches its kernels on
+        CUstream_st* compute_stream() const;
+
+        // Returns the device copy of the frame data, uploading and attaching it to the frame on first use.
+        // The compute stream waits for the upload, or for the block that produced the frame on the device
+        std::shared_ptr<uint8_t> get_gpu_data(const rs2::frame& f);
+
+        // Makes the device buffer written on the compute stream the content of the frame, consumers wait for the kernels queued so far
+        // and the host data is downloaded on its first access
+        void set_gpu_data(const rs2::frame& f, std::shared_ptr<uint8_t> data);
+
+        // Copies size bytes written on the compute stream to the host and waits for them
+        void download(void* dst, const void* d_src, size_t size);
+
+    private:
+        struct impl;
+        std::shared_ptr<impl> _impl;
+    };
+}
+#endif // RS2_USE_CUDA
@@ -2,13 +2,15 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 #include "proc/cuda/cuda-pointcloud.h"
 
-#ifdef RS2_USE_CUDA
-#include "../../cuda/cuda-pointcloud.cuh"
-#endif
-
 namespace librealsense
 {
-    pointcloud_cuda::pointcloud_cuda() : pointcloud("Pointcloud (CUDA)") {}
+    pointcloud_cuda::pointcloud_cuda() : pointcloud("Pointcloud (CUDA)")
+    {
+#ifdef RS2_USE_CUDA
+        // The points are downloaded straight into the pinned frames
+        set_frame_allocator(make_pinned_frame_allocator());
+#endif
+    }
 
     const float3 * pointcloud_cuda::depth_to_points(
         rs2::points output,
@@ -17,9 +19,19 @@ namespace librealsense
         float depth_scale)
     {
         auto image = output.get_vertices();
-        auto depth_data = (uint16_t*)depth_frame.get_data();
 #ifdef RS2_USE_CUDA
-        rscuda::deproject_depth_cuda((float*)image, depth_intrinsics, depth_data, depth_scale);
+        auto points_size = size_t(depth_intrinsics.width) * depth_intrinsics.height * sizeof(float3);
+        if (points_size != _points_size)
+        {
+            _d_points = alloc_gpu_data(points_size);
+            _points_size = points_size;
+        }
+
+        // Uses the device copy of the depth when a CUDA block produced it or already uploaded it
+        auto depth_data = _cuda.get_gpu_data(depth_frame);
+        _helper.deproject_depth(reinterpret_cast<float*>(_d_points.get()), depth_intrinsics, reinterpret_cast<const uint16_t*>(depth_data.get()), depth_scale,
+            _cuda.compute_stream());
+        _cuda.download((void*)image, _d_points.get(), points_size);
 #endif
         return (float3*)image;
     }
@@ -4,6 +4,11 @@
 #pragma once
 #include "../pointcloud.h"
 
+#ifdef RS2_USE_CUDA
+#include "../../cuda/cuda-pointcloud.cuh"
+#include "cuda-frame.h"
+#endif
+
 namespace librealsense
 {
     class pointcloud_cuda : public pointcloud
@@ -16,5 +21,12 @@ namespace librealsense
             const rs2_intrinsics &depth_intrinsics,
             const rs2::depth_frame& depth_frame,
             float depth_scale) override;
+
+#ifdef RS2_USE_CUDA
+        rscuda::pointcloud_cuda_helper _helper;
+        std::shared_ptr<uint8_t> _d_points;
+        size_t _points_size = 0;
+        cuda_context _cuda;
+#endif
     };
 }
@@ -13,6 +13,10 @@
 #include "proc/synthetic-stream.h"
 #include "proc/decimation-filter.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 
 #define PIX_SORT(a,b) { if ((a)>(b)) PIX_SWAP((a),(b)); }
 #define PIX_SWAP(a,b) { pixelvalue temp=(a);(a)=(b);(b)=temp; }
@@ -199,6 +203,143 @@ namespace librealsense
     const uint8_t decimation_default_val = 2;
     const uint8_t decimation_step = 1;    // Linear decimation
 
+#ifdef __SSSE3__
+    // Compare-exchange of eight lanes. Pixels are biased by 0x8000 so that the signed SSE2 min/max order unsigned values
+    static inline void sort_z16(__m128i& a, __m128i& b)
+    {
+        __m128i t = _mm_min_epi16(a, b);
+        b = _mm_max_epi16(a, b);
+        a = t;
+    }
+
+    /*
+    ** decimate_median_z16()
+    Computes eight consecutive outputs for scale 2 and 3, one per lane. The windows are sorted in full with a
+    sorting network, zeros going first, so the median of the non-zero members (the one below the middle for
+    even counts, as in opt_med4/opt_med6/opt_med8) sits at index (kernel + zeros - 1) / 2
+    **/
+    static void decimate_median_z16(const uint16_t* block_start, size_t width_in, size_t scale, size_t blocks, uint16_t* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(-0x8000);
+
+        // Shuffle masks gathering sample 'k' of eight consecutive windows from the 'scale' registers holding a row
+        __m128i gather[3][3];
+        for (size_t k = 0; k < scale; k++)
+        {
+            for (size_t r = 0; r < scale; r++)
+            {
+                alignas(16) int8_t mask[16];
+                for (size_t i = 0; i < 8; i++)
+                {
+                    auto w = scale * i + k;
+                    bool here = (w / 8 == r);
+                    mask[2 * i] = here ? int8_t(2 * (w % 8)) : int8_t(-128);
+                    mask[2 * i + 1] = here ? int8_t(2 * (w % 8) + 1) : int8_t(-128);
+                }
+                gather[k][r] = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+            }
+        }
+
+        __m128i v[9];
+        for (size_t b = 0; b < blocks; b++)
+        {
+            __m128i zeros = zero;
+            for (size_t n = 0; n < scale; n++)
+            {
+                auto row = reinterpret_cast<const __m128i*>(block_start + n * width_in + b * 8 * scale);
+                __m128i regs[3];
+                for (size_t r = 0; r < scale; r++)
+                    regs[r] = _mm_loadu_si128(row + r);
+
+                for (size_t k = 0; k < scale; k++)
+                {
+                    __m128i s = _mm_shuffle_epi8(regs[0], gather[k][0]);
+                    for (size_t r = 1; r < scale; r++)
+                        s = _mm_or_si128(s, _mm_shuffle_epi8(regs[r], gather[k][r]));
+                    zeros = _mm_sub_epi16(zeros, _mm_cmpeq_epi16(s, zero));
+                    v[n * scale + k] = _mm_xor_si128(s, bias);
+                }
+            }
+
+            __m128i res;
+            if (scale == 2)
+            {
+                sort_z16(v[0], v[1]); sort_z16(v[2], v[3]);
+                sort_z16(v[0], v[2]); sort_z16(v[1], v[3]);
+                sort_z16(v[1], v[2]);
+
+                res = v[1];
+                for (int idx = 2; idx < 4; idx++)
+                {
+                    // index (3 + zeros) / 2
+                    __m128i take = _mm_cmpgt_epi16(zeros, _mm_set1_epi16(short(2 * idx - 4)));
+                    res = _mm_or_si128(_mm_and_si128(take, v[idx]), _mm_andnot_si128(take, res));
+                }
+            }
+            else
+            {
+                sort_z16(v[0], v[3]); sort_z16(v[1], v[7]); sort_z16(v[2], v[5]); sort_z16(v[4], v[8]);
+                sort_z16(v[0], v[7]); sort_z16(v[2], v[4]); sort_z16(v[3], v[8]); sort_z16(v[5], v[6]);
+                sort_z16(v[0], v[2]); sort_z16(v[1], v[3]); sort_z16(v[4], v[5]); sort_z16(v[7], v[8]);
+                sort_z16(v[1], v[4]); sort_z16(v[3], v[6]); sort_z16(v[5], v[7]);
+                sort_z16(v[0], v[1]); sort_z16(v[2], v[4]); sort_z16(v[3], v[5]); sort_z16(v[6], v[8]);
+                sort_z16(v[2], v[3]); sort_z16(v[4], v[5]); sort_z16(v[6], v[7]);
+                sort_z16(v[1], v[2]); sort_z16(v[3], v[4]); sort_z16(v[5], v[6]);
+
+                res = v[4];
+                for (int idx = 5; idx < 9; idx++)
+                {
+                    // index (8 + zeros) / 2
+                    __m128i take = _mm_cmpgt_epi16(zeros, _mm_set1_epi16(short(2 * idx - 9)));
+                    res = _mm_or_si128(_mm_and_si128(take, v[idx]), _mm_andnot_si128(take, res));
+                }
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + b * 8), _mm_xor_si128(res, bias));
+        }
+    }
+
+    /*
+    ** decimate_mean_z16()
+    Computes four consecutive outputs for scale 4, the mean of the non-zero members of each window.
+    The sums stay below 2^24 and the quotients are at least 1/16 away from the next integer,
+    so the truncated float division matches the integer one
+    **/
+    static void decimate_mean_z16(const uint16_t* block_start, size_t width_in, size_t blocks, uint16_t* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+
+        for (size_t b = 0; b < blocks; b++)
+        {
+            __m128i sum = zero;
+            __m128i counter = zero;
+            for (size_t n = 0; n < 4; n++)
+            {
+                auto row = reinterpret_cast<const __m128i*>(block_start + n * width_in + b * 16);
+                __m128i r0 = _mm_loadu_si128(row);
+                __m128i r1 = _mm_loadu_si128(row + 1);
+
+                __m128i s0 = _mm_hadd_epi32(_mm_unpacklo_epi16(r0, zero), _mm_unpackhi_epi16(r0, zero));
+                __m128i s1 = _mm_hadd_epi32(_mm_unpacklo_epi16(r1, zero), _mm_unpackhi_epi16(r1, zero));
+                sum = _mm_add_epi32(sum, _mm_hadd_epi32(s0, s1));
+
+                __m128i c0 = _mm_madd_epi16(_mm_andnot_si128(_mm_cmpeq_epi16(r0, zero), one), one);
+                __m128i c1 = _mm_madd_epi16(_mm_andnot_si128(_mm_cmpeq_epi16(r1, zero), one), one);
+                counter = _mm_add_epi32(counter, _mm_hadd_epi32(c0, c1));
+            }
+
+            __m128i mean = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(sum), _mm_cvtepi32_ps(counter)));
+            mean = _mm_andnot_si128(_mm_cmpeq_epi32(counter, zero), mean);
+
+            const __m128i bias = _mm_set1_epi32(0x8000);
+            __m128i packed = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(mean, bias), zero), _mm_set1_epi16(-0x8000));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + b * 4), packed);
+        }
+    }
+#endif
+
     decimation_filter::decimation_filter() :
         stream_filter_processing_block("Decimation Filter"),
         _decimation_factor(decimation_default_val),
@@ -357,127 +498,160 @@ namespace librealsense
     void decimation_filter::decimate_depth(const uint16_t * frame_data_in, uint16_t * frame_data_out,
         size_t width_in, size_t height_in, size_t scale)
     {
-        // Use median filtering
-        std::vector<uint16_t> working_kernel(_kernel_size);
-        auto wk_begin = working_kernel.data();
-        auto wk_itr = wk_begin;
-        std::vector<uint16_t*> pixel_raws(scale);
-        uint16_t* block_start = const_cast<uint16_t*>(frame_data_in);
+        const int real_height = _real_height;
 
         if (scale == 2 || scale == 3)
         {
-            for (int j = 0; j < _real_height; j++)
+            // Use median filtering
+#pragma omp parallel
             {
-                uint16_t *p{};
-                // Mark the beginning of each of the N lines that the filter will run upon
-                for (size_t i = 0; i < pixel_raws.size(); i++)
-                    pixel_raws[i] = block_start + (width_in*i);
-
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
+                std::vector<uint16_t> working_kernel(_kernel_size);
+                auto wk_begin = working_kernel.data();
+                auto wk_itr = wk_begin;
+                std::vector<uint16_t*> pixel_raws(scale);
+
+                // The output rows are independent
+#pragma omp for schedule(static)
+                for (int j = 0; j < real_height; j++)
                 {
-                    wk_itr = wk_begin;
-                    // extract data the kernel to process
-                    for (size_t n = 0; n < scale; ++n)
+                    uint16_t* block_start = const_cast<uint16_t*>(frame_data_in) + width_in * scale * j;
+                    uint16_t* out = frame_data_out + _padded_width * j;
+                    size_t first = 0;
+
+#ifdef __SSSE3__
+                    size_t blocks = _real_width / 8;
+                    decimate_median_z16(block_start, width_in, scale, blocks, out);
+                    first = blocks * 8;
+                    out += first;
+#endif
+
+                    uint16_t *p{};
+                    // Mark the beginning of each of the N lines that the filter will run upon
+                    for (size_t i = 0; i < pixel_raws.size(); i++)
+                        pixel_raws[i] = block_start + (width_in*i);
+
+                    for (size_t i = first, chunk_offset = first * scale; i < _real_width; i++)
                     {
-                        p = pixel_raws[n] + chunk_offset;
-                        for (size_t m = 0; m < scale; ++m)
+                        wk_itr = wk_begin;
+                        // extract data the kernel to process
+                        for (size_t n = 0; n < scale; ++n)
                         {
-                            if (*(p + m))
-                                *wk_itr++ = *(p + m);
+                            p = pixel_raws[n] + chunk_offset;
+                            for (size_t m = 0; m < scale; ++m)
+                            {
+                                if (*(p + m))
+                                    *wk_itr++ = *(p + m);
+                            }
                         }
-                    }
 
-                    // For even-size kernels pick the member one below the middle
-                    auto ks = (int)(wk_itr - wk_begin);
-                    if (ks == 0)
-                        *frame_data_out++ = 0;
-                    else
-                    {
-                        switch (ks)
+                        // For even-size kernels pick the member one below the middle
+                        auto ks = (int)(wk_itr - wk_begin);
+                        if (ks == 0)
+                            *out++ = 0;
+                        else
                         {
-                        case 1:
-                            *frame_data_out++ = working_kernel[0];
-                            break;
-                        case 2:
-                            *frame_data_out++ = PIX_MIN(working_kernel[0], working_kernel[1]);
-                            break;
-                        case 3:
-                            *frame_data_out++ = opt_med3<uint16_t>(working_kernel.data());
-                            break;
-                        case 4:
-                            *frame_data_out++ = opt_med4<uint16_t>(working_kernel.data());
-                            break;
-                        case 5:
-                            *frame_data_out++ = opt_med5<uint16_t>(working_kernel.data());
-                            break;
-                        case 6:
-                            *frame_data_out++ = opt_med6<uint16_t>(working_kernel.data());
-                            break;
-                        case 7:
-                            *frame_data_out++ = opt_med7<uint16_t>(working_kernel.data());
-                            break;
-                        case 8:
-                            *frame_data_out++ = opt_med8<uint16_t>(working_kernel.data());
-                            break;
-                        case 9:
-                            *frame_data_out++ = opt_med9<uint16_t>(working_kernel.data());
-                            break;
+                            switch (ks)
+                            {
+                            case 1:
+                                *out++ = working_kernel[0];
+                                break;
+                            case 2:
+                                *out++ = PIX_MIN(working_kernel[0], working_kernel[1]);
+                                break;
+                            case 3:
+                                *out++ = opt_med3<uint16_t>(working_kernel.data());
+                                break;
+                            case 4:
+                                *out++ = opt_med4<uint16_t>(working_kernel.data());
+                                break;
+                            case 5:
+                                *out++ = opt_med5<uint16_t>(working_kernel.data());
+                                break;
+                            case 6:
+                                *out++ = opt_med6<uint16_t>(working_kernel.data());
+                                break;
+                            case 7:
+                                *out++ = opt_med7<uint16_t>(working_kernel.data());
+                                break;
+                            case 8:
+                                *out++ = opt_med8<uint16_t>(working_kernel.data());
+                                break;
+                            case 9:
+                                *out++ = opt_med9<uint16_t>(working_kernel.data());
+                                break;
+                            }
                         }
+
+                        chunk_offset += scale;
                     }
 
-                    chunk_offset += scale;
+                    // Fill-in the padded colums with zeros
+                    for (int j = _real_width; j < _padded_width; j++)
+                        *out++ = 0;
                 }
-
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
-                    *frame_data_out++ = 0;
-
-                // Skip N lines to the beginnig of the next processing segment
-                block_start += width_in * scale;
             }
         }
         else
         {
-            for (int j = 0; j < _real_height; j++)
+#pragma omp parallel
             {
-                uint16_t *p{};
-                // Mark the beginning of each of the N lines that the filter will run upon
-                for (size_t i = 0; i < pixel_raws.size(); i++)
-                    pixel_raws[i] = block_start + (width_in*i);
+                std::vector<uint16_t*> pixel_raws(scale);
 
-                for (size_t i = 0, chunk_offset = 0; i < _real_width; i++)
+                // The output rows are independent
+#pragma omp for schedule(static)
+                for (int j = 0; j < real_height; j++)
                 {
-                    int sum = 0;
-                    int counter = 0;
+                    uint16_t* block_start = const_cast<uint16_t*>(frame_data_in) + width_in * scale * j;
+                    uint16_t* out = frame_data_out + _padded_width * j;
+                    size_t first = 0;
 
-                    // extract data the kernel to process
-                    for (size_t n = 0; n < scale; ++n)
+#ifdef __SSSE3__
+                    if (scale == 4)
                     {
-                        p = pixel_raws[n] + chunk_offset;
-                        for (size_t m = 0; m < scale; ++m)
+                        size_t blocks = _real_width / 4;
+                        decimate_mean_z16(block_start, width_in, blocks, out);
+                        first = blocks * 4;
+                        out += first;
+                    }
+#endif
+
+                    uint16_t *p{};
+                    // Mark the beginning of each of the N lines that the filter will run upon
+                    for (size_t i = 0; i < pixel_raws.size(); i++)
+                        pixel_raws[i] = block_start + (width_in*i);
+
+                    for (size_t i = first, chunk_offset = first * scale; i < _real_width; i++)
+                    {
+                        int sum = 0;
+                        int counter = 0;
+
+                        // extract data the kernel to process
+                        for (size_t n = 0; n < scale; ++n)
                         {
-                            if (*(p + m))
+                            p = pixel_raws[n] + chunk_offset;
+                            for (size_t m = 0; m < scale; ++m)
                             {
-                                sum += p[m];
-                                ++counter;
+                                if (*(p + m))
+                                {
+                                    sum += p[m];
+                                    ++counter;
+                                }
                             }
                         }
+
+                        *out++ = (counter == 0 ? 0 : sum / counter);
+                        chunk_offset += scale;
                     }
 
-                    *frame_data_out++ = (counter == 0 ? 0 : sum / counter);
-                    chunk_offset += scale;
+                    // Fill-in the padded colums with zeros
+                    for (int j = _real_width; j < _padded_width; j++)
+                        *out++ = 0;
                 }
-
-                // Fill-in the padded colums with zeros
-                for (int j = _real_width; j < _padded_width; j++)
-                    *frame_data_out++ = 0;
-
-                // Skip N lines to the beginnig of the next processing segment
-                block_start += width_in * scale;
             }
         }
 
         // Fill-in the padded rows with zeros
+        frame_data_out += _padded_width * real_height;
         for (auto v = _real_height; v < _padded_height; ++v)
         {
             for (auto u = 0; u < _padded_width; ++u)
@@ -0,0 +1,79 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "proc/deprojection-cache.h"
+
+#include <tuple>
+
+namespace librealsense
+{
+    static std::shared_ptr<deprojection_table> make_deprojection_table(const rs2_intrinsics& intrin, float offset)
+    {
+        auto table = std::make_shared<deprojection_table>();
+        table->x.resize(intrin.width * intrin.height);
+        table->y.resize(intrin.width * intrin.height);
+
+        for (int h = 0; h < intrin.height; ++h)
+        {
+            for (int w = 0; w < intrin.width; ++w)
+            {
+                const float pixel[] = { (float)w + offset, (float)h + offset };
+
+                float x = (pixel[0] - intrin.ppx) / intrin.fx;
+                float y = (pixel[1] - intrin.ppy) / intrin.fy;
+
+                if (intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
+                {
+                    float r2 = x * x + y * y;
+                    float f = 1 + intrin.coeffs[0] * r2 + intrin.coeffs[1] * r2*r2 + intrin.coeffs[4] * r2*r2*r2;
+                    float ux = x * f + 2 * intrin.coeffs[2] * x*y + intrin.coeffs[3] * (r2 + 2 * x*x);
+                    float uy = y * f + 2 * intrin.coeffs[3] * x*y + intrin.coeffs[2] * (r2 + 2 * y*y);
+                    x = ux;
+                    y = uy;
+                }
+
+                table->x[h*intrin.width + w] = x;
+                table->y[h*intrin.width + w] = y;
+            }
+        }
+        return table;
+    }
+
+    bool deprojection_cache::key::operator<(const key& other) const
+    {
+        auto& a = intrin;
+        auto& b = other.intrin;
+        return std::tie(a.width, a.height, a.ppx, a.ppy, a.fx, a.fy, a.model,
+                        a.coeffs[0], a.coeffs[1], a.coeffs[2], a.coeffs[3], a.coeffs[4], offset)
+             < std::tie(b.width, b.height, b.ppx, b.ppy, b.fx, b.fy, b.model,
+                        b.coeffs[0], b.coeffs[1], b.coeffs[2], b.coeffs[3], b.coeffs[4], other.offset);
+    }
+
+    deprojection_cache& deprojection_cache::get_instance()
+    {
+        static deprojection_cache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const deprojection_table> deprojection_cache::get(const rs2_intrinsics& intrin, float offset)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        key k{ intrin, offset };
+        if (auto table = _tables[k].lock())
+            return table;
+
+        // Drop the tables no longer in use before adding a new one
+        for (auto it = _tables.begin(); it != _tables.end();)
+        {
+            if (it->second.expired())
+                it = _tables.erase(it);
+            else
+                ++it;
+        }
+
+        std::shared_ptr<const deprojection_table> table = make_deprojection_table(intrin, offset);
+        _tables[k] = table;
+        return table;
+    }
+}
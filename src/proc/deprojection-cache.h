@@ -0,0 +1,50 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+#include "memory-counter.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    // Undistorted coordinates on the z = 1 plane of every pixel of an image
+    struct deprojection_table
+    {
+        cache_vector<float> x;
+        cache_vector<float> y;
+    };
+
+    // Process-wide store of deprojection tables, keyed by intrinsics (resolution, distortion model
+    // and coefficients) and by the sub-pixel offset the table is sampled at.
+    // Processing blocks working on the same stream share one table, which is released with its last user
+    class deprojection_cache
+    {
+    public:
+        static deprojection_cache& get_instance();
+
+        std::shared_ptr<const deprojection_table> get(const rs2_intrinsics& intrin, float offset = 0.f);
+
+        deprojection_cache(const deprojection_cache&) = delete;
+        deprojection_cache& operator=(const deprojection_cache&) = delete;
+
+    private:
+        deprojection_cache() = default;
+
+        struct key
+        {
+            rs2_intrinsics intrin;
+            float offset;
+
+            bool operator<(const key& other) const;
+        };
+
+        std::mutex _mutex;
+        std::map<key, std::weak_ptr<const deprojection_table>> _tables;
+    };
+}
@@ -0,0 +1,129 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "option.h"
+#include "context.h"
+#include "proc/synthetic-stream.h"
+#include "proc/decimation-filter.h"
+#include "proc/disparity-transform.h"
+#include "proc/spatial-filter.h"
+#include "proc/temporal-filter.h"
+#include "proc/hole-filling-filter.h"
+#include "proc/depth-filter-chain.h"
+
+namespace librealsense
+{
+    depth_filter_chain::depth_filter_chain() :
+        stream_filter_processing_block("Depth Filter Chain"),
+        _decimation(std::make_shared<decimation_filter>()),
+        _spatial(std::make_shared<spatial_filter>()),
+        _temporal(std::make_shared<temporal_filter>()),
+        _hole_filling(std::make_shared<hole_filling_filter>()),
+        _stereoscopic_depth(false),
+        _d2d_convert_factor(0)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+    }
+
+    std::shared_ptr<processing_block> depth_filter_chain::get_stage(rs2_extension stage) const
+    {
+        switch (stage)
+        {
+        case RS2_EXTENSION_DECIMATION_FILTER: return _decimation;
+        case RS2_EXTENSION_SPATIAL_FILTER: return _spatial;
+        case RS2_EXTENSION_TEMPORAL_FILTER: return _temporal;
+        case RS2_EXTENSION_HOLE_FILLING_FILTER: return _hole_filling;
+        default:
+            throw invalid_value_exception(to_string() << get_string(stage) << " is not a stage of the depth filter chain");
+        }
+    }
+
+    void depth_filter_chain::update_configuration(const rs2::frame& f)
+    {
+        if (f.get_profile().get() != _source_stream_profile.get())
+        {
+            _source_stream_profile = f.get_profile();
+
+            auto info = disparity_info::update_info_from_frame(f);
+            _stereoscopic_depth = info.stereoscopic_depth && info.d2d_convert_factor > 0;
+            _d2d_convert_factor = info.d2d_convert_factor;
+        }
+    }
+
+    template<typename T>
+    void depth_filter_chain::run_filters(T* data, size_t width, size_t height, rs2_extension extension_type)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_spatial->_mutex);
+            _spatial->configure(width, height, extension_type);
+            _spatial->smooth<T>(data);
+        }
+        {
+            std::lock_guard<std::mutex> lock(_temporal->_mutex);
+            _temporal->configure(width, height, extension_type);
+            _temporal->temp_jw_smooth<T>(data, _temporal->_last_frame.data(), _temporal->_history.data());
+        }
+        {
+            std::lock_guard<std::mutex> lock(_hole_filling->_mutex);
+            _hole_filling->configure(width, height, extension_type);
+            _hole_filling->apply_hole_filling<T>(data);
+        }
+    }
+
+    rs2::frame depth_filter_chain::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        update_configuration(f);
+
+        auto src = f.as<rs2::video_frame>();
+        size_t width, height;
+        rs2::stream_profile target_profile;
+        {
+            std::lock_guard<std::mutex> lock(_decimation->_mutex);
+            _decimation->update_output_profile(f);
+            width = _decimation->_padded_width;
+            height = _decimation->_padded_height;
+            target_profile = _decimation->_target_stream_profile;
+
+            _depth.resize(width * height);
+            _decimation->decimate_depth(static_cast<const uint16_t*>(src.get_data()), _depth.data(),
+                src.get_width(), src.get_height(), _decimation->_patch_size);
+
+            // the decimation fills the padded columns, the padded rows are cleared here
+            std::fill(_depth.begin() + _decimation->_real_height * width, _depth.end(), uint16_t(0));
+        }
+
+        auto tgt = source.allocate_video_frame(target_profile, f, sizeof(uint16_t), int(width), int(height),
+            int(width * sizeof(uint16_t)), RS2_EXTENSION_DEPTH_FRAME);
+        if (!tgt)
+            return f;
+        auto out = static_cast<uint16_t*>(const_cast<void*>(tgt.get_data()));
+        const int pixels = static_cast<int>(width * height);
+
+        if (!_stereoscopic_depth)
+        {
+            run_filters(_depth.data(), width, height, RS2_EXTENSION_DEPTH_FRAME);
+            memcpy(out, _depth.data(), pixels * sizeof(uint16_t));
+            return tgt;
+        }
+
+        // The conversions of disparity_transform, fused with the first and the last passes over the frame
+        _disparity.resize(width * height);
+        const float factor = _d2d_convert_factor;
+        auto depth = _depth.data();
+        auto disparity = _disparity.data();
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < pixels; i++)
+            disparity[i] = depth[i] ? factor / depth[i] : 0.f;
+
+        run_filters(disparity, width, height, RS2_EXTENSION_DISPARITY_FRAME);
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < pixels; i++)
+            out[i] = std::isnormal(disparity[i]) ? static_cast<uint16_t>(factor / disparity[i] + 0.5f) : 0;
+
+        return tgt;
+    }
+}
@@ -0,0 +1,47 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+// The recommended post-processing sequence of stereo depth - decimation, depth to disparity, spatial, temporal, hole filling
+// and disparity to depth - run as a single block. The filters work in place on buffers of the block, so the sequence
+// allocates one output frame and converts between the depth and the disparity domains in the passes it already makes
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "memory-counter.h"
+
+namespace librealsense
+{
+    class decimation_filter;
+    class spatial_filter;
+    class temporal_filter;
+    class hole_filling_filter;
+
+    class depth_filter_chain : public stream_filter_processing_block
+    {
+    public:
+        depth_filter_chain();
+
+        // The filter of a stage, selected by its extension. The stage filters hold the options of the chain
+        std::shared_ptr<processing_block> get_stage(rs2_extension stage) const;
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        template<typename T>
+        void run_filters(T* data, size_t width, size_t height, rs2_extension extension_type);
+
+        std::shared_ptr<decimation_filter>      _decimation;
+        std::shared_ptr<spatial_filter>         _spatial;
+        std::shared_ptr<temporal_filter>        _temporal;
+        std::shared_ptr<hole_filling_filter>    _hole_filling;
+
+        rs2::stream_profile     _source_stream_profile;
+        bool                    _stereoscopic_depth;
+        float                   _d2d_convert_factor;
+        cache_vector<uint16_t>  _depth;         // the decimated depth
+        cache_vector<float>     _disparity;     // the working buffer of the filters in the disparity domain
+    };
+}
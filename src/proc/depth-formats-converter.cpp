@@ -8,6 +8,13 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
 
 namespace librealsense
 {
@@ -84,11 +91,55 @@ namespace librealsense
         librealsense::copy(dest[0], source, size_t(5.0 * (count / 4.0)));
     }
 
+    // Unpacks the leading pixels with the widest kernel available and returns their number, a multiple of 4
+    static int unpack_y10bpack_simd(uint16_t * dest, const byte * source, int count)
+    {
+        int i = 0;
+#if defined(__SSSE3__) || (defined(__ARM_NEON) && defined(__aarch64__))
+        // 2 macro-pixels of 5 bytes, every word gets the 8 msb in its high byte and the shared byte in its low byte.
+        // The shared byte is then multiplied to move the 2 lsb of each pixel to bits 6 and 7
+        const uint8_t split[16] = { 4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8 };
+        const uint16_t shift[8] = { 64, 16, 4, 1, 64, 16, 4, 1 };
+#endif
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return unpack_y16_from_y10bpack_avx2(dest, source, count);
+
+        const auto shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(split));
+        const auto mul = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shift));
+        const auto high = _mm_set1_epi16(int16_t(0xff00));
+        const auto low = _mm_set1_epi16(0x00c0);
+
+        // Every 10 bytes are loaded as 16, the last 8 pixels are left to the scalar loop to stay in bounds
+        for (; i + 8 + 8 <= count; i += 8)
+        {
+            auto v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i / 4 * 5)), shuffle);
+            auto lsb = _mm_and_si128(_mm_mullo_epi16(_mm_andnot_si128(high, v), mul), low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_or_si128(_mm_and_si128(v, high), lsb));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto shuffle = vld1q_u8(split);
+        const auto mul = vld1q_u16(shift);
+        const auto high = vdupq_n_u16(0xff00);
+        const auto low = vdupq_n_u16(0x00c0);
+
+        for (; i + 8 + 8 <= count; i += 8)
+        {
+            auto v = vreinterpretq_u16_u8(vqtbl1q_u8(vld1q_u8(source + i / 4 * 5), shuffle));
+            auto lsb = vandq_u16(vmulq_u16(vbicq_u16(v, high), mul), low);
+            vst1q_u16(dest + i, vorrq_u16(vandq_u16(v, high), lsb));
+        }
+#endif
+        return i;
+    }
+
     void unpack_y10bpack(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
-        auto count = width * height / 4; // num of pixels
-        uint8_t  * from = (uint8_t*)(source);
-        uint16_t * to = (uint16_t*)(dest[0]);
+        auto done = unpack_y10bpack_simd(reinterpret_cast<uint16_t*>(dest[0]), source, width * height);
+        auto count = (width * height - done) / 4; // num of pixels
+        uint8_t  * from = (uint8_t*)(source) + done / 4 * 5;
+        uint16_t * to = (uint16_t*)(dest[0]) + done;
 
         // Put the 10 bit into the msb of uint16_t
         for (int i = 0; i < count; i++, from += 5) // traverse macro-pixels
@@ -0,0 +1,128 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "../include/librealsense2/rsutil.h"
+
+#include "proc/synthetic-stream.h"
+#include "proc/deprojection-cache.h"
+#include "proc/depth-to-scan.h"
+#include "core/video.h"
+#include "option.h"
+#include "context.h"
+
+#include <cmath>
+
+namespace librealsense
+{
+    void get_scan_angles(const rs2_intrinsics& depth_intrin, int bins, float* angle_min, float* angle_increment)
+    {
+        const float left[] = { -0.5f, depth_intrin.ppy }, right[] = { depth_intrin.width - 0.5f, depth_intrin.ppy };
+        float left_point[3], right_point[3];
+        rs2_deproject_pixel_to_point(left_point, &depth_intrin, left, 1.f);
+        rs2_deproject_pixel_to_point(right_point, &depth_intrin, right, 1.f);
+
+        *angle_min = std::atan2(left_point[0], left_point[2]);
+        *angle_increment = (std::atan2(right_point[0], right_point[2]) - *angle_min) / bins;
+    }
+
+    depth_to_scan::depth_to_scan()
+        : stream_filter_processing_block("Depth to Scan"), _bins(640), _rows(10), _min_range(0.1f), _max_range(10.f),
+        _configured_bins(0), _configured_rows(0), _first_row(0)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        register_option(RS2_OPTION_SCAN_BINS, std::make_shared<ptr_option<int>>(16, 4096, 1, 640, &_bins, "Number of angle bins of the scan"));
+        register_option(RS2_OPTION_SCAN_ROWS, std::make_shared<ptr_option<int>>(1, 256, 1, 10, &_rows, "Number of depth rows the scan is taken from"));
+        register_option(RS2_OPTION_MIN_DISTANCE, std::make_shared<ptr_option<float>>(0.f, 16.f, 0.1f, 0.1f, &_min_range, "Min range in meters"));
+        register_option(RS2_OPTION_MAX_DISTANCE, std::make_shared<ptr_option<float>>(0.f, 65.f, 0.1f, 10.f, &_max_range, "Max range in meters"));
+    }
+
+    void depth_to_scan::update_configuration(const rs2::frame& f)
+    {
+        if (f.get_profile().get() == _source_profile.get() && _bins == _configured_bins && _rows == _configured_rows)
+            return;
+
+        _source_profile = f.get_profile();
+        _configured_bins = _bins;
+        _configured_rows = _rows;
+
+        auto video = _source_profile.as<rs2::video_stream_profile>();
+        auto intrin = video.get_intrinsics();
+        auto bins = _configured_bins;
+        auto rows = std::min(_configured_rows, intrin.height);
+        _first_row = std::max(0, std::min(int(intrin.ppy + 0.5f) - rows / 2, intrin.height - rows));
+
+        float angle_min, angle_increment;
+        get_scan_angles(intrin, bins, &angle_min, &angle_increment);
+
+        // The tables hold the undistorted rays of the models deprojecting without iterations, the others are deprojected per pixel
+        std::shared_ptr<const deprojection_table> rays;
+        if (intrin.model != RS2_DISTORTION_KANNALA_BRANDT4 && intrin.model != RS2_DISTORTION_FTHETA)
+            rays = deprojection_cache::get_instance().get(intrin);
+
+        _pixel_bins.resize(rows * intrin.width);
+        _range_factors.resize(rows * intrin.width);
+        for (int y = 0, i = 0; y < rows; ++y)
+        {
+            for (int x = 0; x < intrin.width; ++x, ++i)
+            {
+                float ray_x;
+                if (rays)
+                    ray_x = rays->x[(_first_row + y) * intrin.width + x];
+                else
+                {
+                    const float pixel[] = { float(x), float(_first_row + y) };
+                    float point[3];
+                    rs2_deproject_pixel_to_point(point, &intrin, pixel, 1.f);
+                    ray_x = point[0];
+                }
+
+                // The point of depth z is at z * ray_x, so z * sqrt(ray_x^2 + 1) from the camera in the horizontal plane
+                auto bin = int(std::floor((std::atan(ray_x) - angle_min) / angle_increment));
+                _pixel_bins[i] = bin >= 0 && bin < bins ? bin : -1;
+                _range_factors[i] = std::sqrt(ray_x * ray_x + 1.f);
+            }
+        }
+
+        // A row of bins, with the calibration of the depth
+        _target_profile = std::make_shared<rs2::video_stream_profile>(
+            _source_profile.clone(RS2_STREAM_DEPTH, _source_profile.stream_index(), RS2_FORMAT_DISTANCE));
+        if (auto target = As<video_stream_profile_interface>(_target_profile->get()->profile))
+            target->set_dims(bins, 1);
+    }
+
+    rs2::frame depth_to_scan::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        update_configuration(f);
+
+        auto depth = f.as<rs2::depth_frame>();
+        auto width = depth.get_width();
+        auto bins = _configured_bins;
+        auto rows = int(_pixel_bins.size()) / width;
+        auto units = ((librealsense::depth_frame*)depth.get())->get_units();
+
+        auto res = source.allocate_video_frame(*_target_profile, f, sizeof(float), bins, 1, bins * sizeof(float), RS2_EXTENSION_VIDEO_FRAME);
+        auto scan = reinterpret_cast<float*>(const_cast<void*>(res.get_data()));
+        memset(scan, 0, bins * sizeof(float));
+
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data()) + _first_row * width;
+        auto pixel_bins = _pixel_bins.data();
+        auto factors = _range_factors.data();
+        for (int i = 0; i < rows * width; ++i)
+        {
+            auto z = z_pixels[i];
+            auto bin = pixel_bins[i];
+            if (!z || bin < 0)
+                continue;
+
+            auto range = units * z * factors[i];
+            if (range < _min_range || range > _max_range)
+                continue;
+            scan[bin] = scan[bin] ? std::min(scan[bin], range) : range;
+        }
+        return res;
+    }
+}
@@ -0,0 +1,44 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    // Angle of the first bin and angle between bins of a scan of the depth of depth_intrin, in radians.
+    // The bins span the angles of the left to the right edge of the image at the principal point row,
+    // an angle is atan2(x, z) of the camera coordinates, growing to the right
+    void get_scan_angles(const rs2_intrinsics& depth_intrin, int bins, float* angle_min, float* angle_increment);
+
+    // Converts a band of depth rows to a 2D scan: the nearest range in the horizontal plane per angle bin.
+    // The bin and the horizontal range factor of every pixel of the band are computed once, from the deprojection tables.
+    // The output is a single row of RS2_FORMAT_DISTANCE, in meters, zero for the bins with no depth in range
+    class depth_to_scan : public stream_filter_processing_block
+    {
+    public:
+        depth_to_scan();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        int _bins;
+        int _rows;
+        float _min_range;
+        float _max_range;
+
+        rs2::stream_profile _source_profile;
+        std::shared_ptr<rs2::video_stream_profile> _target_profile;
+        int _configured_bins;
+        int _configured_rows;
+
+        // First row of the band, then the bin and the factor from depth to horizontal range of every pixel of the band
+        int _first_row;
+        cache_vector<int> _pixel_bins;
+        cache_vector<float> _range_factors;
+    };
+}
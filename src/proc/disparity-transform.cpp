@@ -13,6 +13,14 @@
 #include "software-device.h"
 #include "environment.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 namespace librealsense
 {
     disparity_transform::disparity_transform(bool transform_to_disparity):
@@ -121,6 +129,92 @@ namespace librealsense
         }
     }
 
+    int disparity_transform::convert_simd(const uint16_t* depth, float* disparity, int count) const
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return depth_to_disparity_avx2(disparity, depth, _d2d_convert_factor, count);
+
+        const auto factor = _mm_set1_ps(_d2d_convert_factor);
+        const auto zero = _mm_setzero_si128();
+        const auto zero_ps = _mm_setzero_ps();
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+            auto lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(d, zero));
+            auto hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(d, zero));
+            // no depth gives no disparity
+            _mm_storeu_ps(disparity + i, _mm_and_ps(_mm_div_ps(factor, lo), _mm_cmpneq_ps(lo, zero_ps)));
+            _mm_storeu_ps(disparity + i + 4, _mm_and_ps(_mm_div_ps(factor, hi), _mm_cmpneq_ps(hi, zero_ps)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto factor = vdupq_n_f32(_d2d_convert_factor);
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = vld1q_u16(depth + i);
+            auto lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(d)));
+            auto hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(d)));
+            auto valid_lo = vtstq_u32(vmovl_u16(vget_low_u16(d)), vmovl_u16(vget_low_u16(d)));
+            auto valid_hi = vtstq_u32(vmovl_u16(vget_high_u16(d)), vmovl_u16(vget_high_u16(d)));
+            vst1q_f32(disparity + i, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(factor, lo)), valid_lo)));
+            vst1q_f32(disparity + i + 4, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(factor, hi)), valid_hi)));
+        }
+#endif
+        return i;
+    }
+
+    int disparity_transform::convert_simd(const float* disparity, uint16_t* depth, int count) const
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return disparity_to_depth_avx2(depth, disparity, _d2d_convert_factor, count);
+
+        const auto factor = _mm_set1_ps(_d2d_convert_factor);
+        const auto abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+        const auto smallest = _mm_set1_ps(std::numeric_limits<float>::min());
+        const auto largest = _mm_set1_ps(std::numeric_limits<float>::max());
+        const auto round = _mm_set1_ps(0.5f);
+        const auto bias = _mm_set1_epi32(0x8000);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v[2];
+            for (int k = 0; k < 2; k++)
+            {
+                auto d = _mm_loadu_ps(disparity + i + k * 4);
+                auto a = _mm_and_ps(d, abs_mask);
+                auto normal = _mm_and_ps(_mm_cmpge_ps(a, smallest), _mm_cmple_ps(a, largest));
+                auto z = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(factor, d), round));
+                // biased to pack the unsigned values with a signed saturation
+                v[k] = _mm_sub_epi32(_mm_and_si128(z, _mm_castps_si128(normal)), bias);
+            }
+            auto packed = _mm_xor_si128(_mm_packs_epi32(v[0], v[1]), _mm_set1_epi16(int16_t(0x8000)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(depth + i), packed);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto factor = vdupq_n_f32(_d2d_convert_factor);
+        const auto smallest = vdupq_n_f32(std::numeric_limits<float>::min());
+        const auto largest = vdupq_n_f32(std::numeric_limits<float>::max());
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x4_t v[2];
+            for (int k = 0; k < 2; k++)
+            {
+                auto d = vld1q_f32(disparity + i + k * 4);
+                auto a = vabsq_f32(d);
+                auto normal = vandq_u32(vcgeq_f32(a, smallest), vcleq_f32(a, largest));
+                auto z = vcvtq_u32_f32(vaddq_f32(vdivq_f32(factor, d), vdupq_n_f32(0.5f)));
+                v[k] = vqmovn_u32(vandq_u32(z, normal));
+            }
+            vst1q_u16(depth + i, vcombine_u16(v[0], v[1]));
+        }
+#endif
+        return i;
+    }
+
     rs2::frame disparity_transform::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
         return source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_width*_bpp),
@@ -33,20 +33,22 @@ namespace librealsense
             bool fp = (std::is_floating_point<Tin>::value);
             const float round = fp ? 0.5f : 0.f;
 
+            auto count = int(_width * _height);
             float input{};
-            //TODO SSE optimize
-            for (auto i = 0; i < _height; i++)
-                for (auto j = 0; j < _width; j++)
-                {
-                    input = *in;
-                    if (std::isnormal(input))
-                        *out++ = static_cast<Tout>((_d2d_convert_factor / input)+round);
-                    else
-                        *out++ = 0;
-                    in++;
-                }
+            for (auto i = convert_simd(in, out, count); i < count; i++)
+            {
+                input = in[i];
+                if (std::isnormal(input))
+                    out[i] = static_cast<Tout>((_d2d_convert_factor / input)+round);
+                else
+                    out[i] = 0;
+            }
         }
 
+        // Vectorized conversions, return the number of pixels converted
+        int convert_simd(const uint16_t* depth, float* disparity, int count) const;
+        int convert_simd(const float* disparity, uint16_t* depth, int count) const;
+
     private:
         void    update_transformation_profile(const rs2::frame& f);
 
@@ -3,12 +3,122 @@
 
 #include "hdr-merge.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 namespace librealsense
 {
+    // pixels merged by each thread at a time
+    const int MERGE_CHUNK_SIZE = 1 << 15;
+
+    // The merge kernels return the number of pixels merged, the caller merges the remaining ones.
+    // An infrared value is valid inside (low, high)
+    static int merge_depth_simd(uint16_t* dest, const uint16_t* d0, const uint16_t* d1, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return merge_depth_avx2(dest, d0, d1, count);
+
+        const auto zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i));
+            auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i));
+            auto first_empty = _mm_cmpeq_epi16(a, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_or_si128(a, _mm_and_si128(first_empty, b)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 8 <= count; i += 8)
+        {
+            auto a = vld1q_u16(d0 + i);
+            auto b = vld1q_u16(d1 + i);
+            vst1q_u16(dest + i, vbslq_u16(vceqzq_u16(a), b, a));
+        }
+#endif
+        return i;
+    }
+
+#ifdef __SSSE3__
+    // Mask of the pixels not to take: no depth, or infrared out of (low, high)
+    static inline __m128i hdr_invalid_mask(__m128i depth, __m128i ir, __m128i low, __m128i high)
+    {
+        const auto zero = _mm_setzero_si128();
+        auto under = _mm_cmpeq_epi16(_mm_subs_epu16(ir, low), zero);
+        auto over = _mm_cmpeq_epi16(_mm_subs_epu16(high, ir), zero);
+        return _mm_or_si128(_mm_or_si128(under, over), _mm_cmpeq_epi16(depth, zero));
+    }
+
+    static inline __m128i hdr_merge_pixels(__m128i a, __m128i b, __m128i ir_a, __m128i ir_b, __m128i low, __m128i high)
+    {
+        auto bad_a = hdr_invalid_mask(a, ir_a, low, high);
+        auto bad_b = hdr_invalid_mask(b, ir_b, low, high);
+        return _mm_or_si128(_mm_andnot_si128(bad_a, a), _mm_and_si128(bad_a, _mm_andnot_si128(bad_b, b)));
+    }
+
+    static inline __m128i load_ir(const uint8_t* ir)
+    {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ir)), _mm_setzero_si128());
+    }
+
+    static inline __m128i load_ir(const uint16_t* ir)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ir));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static inline uint16x8_t hdr_valid_mask(uint16x8_t depth, uint16x8_t ir, uint16x8_t low, uint16x8_t high)
+    {
+        return vandq_u16(vandq_u16(vcgtq_u16(ir, low), vcltq_u16(ir, high)), vtstq_u16(depth, depth));
+    }
+
+    static inline uint16x8_t load_ir(const uint8_t* ir) { return vmovl_u8(vld1_u8(ir)); }
+    static inline uint16x8_t load_ir(const uint16_t* ir) { return vld1q_u16(ir); }
+#endif
+
+    template <typename T>
+    static int merge_depth_using_ir_simd(uint16_t* dest, const uint16_t* d0, const uint16_t* d1,
+        const T* i0, const T* i1, uint16_t low, uint16_t high, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return merge_depth_using_ir_avx2(dest, d0, d1, i0, i1, low, high, count);
+
+        const auto lo = _mm_set1_epi16(int16_t(low));
+        const auto hi = _mm_set1_epi16(int16_t(high));
+        for (; i + 8 <= count; i += 8)
+        {
+            auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d0 + i));
+            auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d1 + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), hdr_merge_pixels(a, b, load_ir(i0 + i), load_ir(i1 + i), lo, hi));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto lo = vdupq_n_u16(low);
+        const auto hi = vdupq_n_u16(high);
+        for (; i + 8 <= count; i += 8)
+        {
+            auto a = vld1q_u16(d0 + i);
+            auto b = vld1q_u16(d1 + i);
+            auto valid_a = hdr_valid_mask(a, load_ir(i0 + i), lo, hi);
+            auto valid_b = hdr_valid_mask(b, load_ir(i1 + i), lo, hi);
+            vst1q_u16(dest + i, vbslq_u16(valid_a, a, vandq_u16(valid_b, b)));
+        }
+#endif
+        return i;
+    }
+
     hdr_merge::hdr_merge()
         : generic_processing_block("HDR Merge"),
         _previous_depth_frame_counter(0),
-        _frames_without_requested_metadata_counter(0)
+        _frames_without_requested_metadata_counter(0),
+        _framesets_count(0)
     {}
 
     // processing only framesets
@@ -82,21 +192,22 @@ namespace librealsense
         // saving frame of sequence id 0
         // so that the merging with be deterministic - always done with frame n and n+1
         // with frame n as basis
-        if (_framesets.size() == depth_seq_id)
+        if (_framesets_count == depth_seq_id)
         {
-            _framesets[depth_seq_id] = fs;
+            _framesets[_framesets_count++] = fs;
         }
 
         // discard merged frame if not relevant
         discard_depth_merged_frame_if_needed(f);
 
         // 3. check if size of this vector is at least 2 (if not - return latest merge frame)
-        if (_framesets.size() >= 2)
+        if (_framesets_count >= 2)
         {
             // 4. pop out both framesets from the vector
-            rs2::frameset fs_0 = _framesets[0];
-            rs2::frameset fs_1 = _framesets[1];
-            _framesets.clear();
+            rs2::frameset fs_0 = std::move(_framesets[0]);
+            rs2::frameset fs_1 = std::move(_framesets[1]);
+            _framesets = {};
+            _framesets_count = 0;
 
             bool use_ir = false;
             if (check_frames_mergeability(fs_0, fs_1, use_ir))
@@ -196,8 +307,7 @@ namespace librealsense
 
             ptr->set_sensor(orig->get_sensor());
 
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-
+            // every pixel is written by the merge
             int width_height_product = width * height;
 
             if (use_ir)
@@ -225,16 +335,55 @@ namespace librealsense
         return first_fs;
     }
 
+    template <typename T>
+    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
+        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const
+    {
+        auto i0 = (const T*)first_ir.get_data();
+        auto i1 = (const T*)second_ir.get_data();
+
+        auto format = first_ir.get_profile().format();
+        auto low = uint16_t(format == RS2_FORMAT_Y8 ? IR_UNDER_SATURATED_VALUE_Y8 : IR_UNDER_SATURATED_VALUE_Y16);
+        auto high = uint16_t(format == RS2_FORMAT_Y8 ? IR_OVER_SATURATED_VALUE_Y8 : IR_OVER_SATURATED_VALUE_Y16);
+
+        int chunks = (width_height_prod + MERGE_CHUNK_SIZE - 1) / MERGE_CHUNK_SIZE;
+#pragma omp parallel for schedule(static)
+        for (int c = 0; c < chunks; c++)
+        {
+            int begin = c * MERGE_CHUNK_SIZE;
+            int end = std::min(width_height_prod, begin + MERGE_CHUNK_SIZE);
+            int i = begin + merge_depth_using_ir_simd<T>(new_data + begin, d0 + begin, d1 + begin,
+                i0 + begin, i1 + begin, low, high, end - begin);
+            for (; i < end; i++)
+            {
+                if (is_infrared_valid<T>(i0[i], format) && d0[i])
+                    new_data[i] = d0[i];
+                else if (is_infrared_valid<T>(i1[i], format) && d1[i])
+                    new_data[i] = d1[i];
+                else
+                    new_data[i] = 0;
+            }
+        }
+    }
+
     void hdr_merge::merge_frames_using_only_depth(uint16_t* new_data, uint16_t* d0, uint16_t* d1, int width_height_prod) const
     {
-        for (int i = 0; i < width_height_prod; i++)
+        int chunks = (width_height_prod + MERGE_CHUNK_SIZE - 1) / MERGE_CHUNK_SIZE;
+#pragma omp parallel for schedule(static)
+        for (int c = 0; c < chunks; c++)
         {
-            if (d0[i])
-                new_data[i] = d0[i];
-            else if (d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
+            int begin = c * MERGE_CHUNK_SIZE;
+            int end = std::min(width_height_prod, begin + MERGE_CHUNK_SIZE);
+            int i = begin + merge_depth_simd(new_data + begin, d0 + begin, d1 + begin, end - begin);
+            for (; i < end; i++)
+            {
+                if (d0[i])
+                    new_data[i] = d0[i];
+                else if (d1[i])
+                    new_data[i] = d1[i];
+                else
+                    new_data[i] = 0;
+            }
         }
     }
 
@@ -7,6 +7,8 @@ Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
 #include "synthetic-stream.h"
 #include "option.h"
 
+#include <array>
+
 namespace librealsense
 {
     class hdr_merge : public generic_processing_block
@@ -46,31 +48,13 @@ namespace librealsense
 
         unsigned long long _previous_depth_frame_counter;
         int _frames_without_requested_metadata_counter;
-        std::map<int, rs2::frameset> _framesets;
+        // the framesets of the current sequence, filled in the order of their sequence id
+        std::array<rs2::frameset, 2> _framesets;
+        int _framesets_count;
         rs2::frame _depth_merged_frame;
     };
     MAP_EXTENSION(RS2_EXTENSION_HDR_MERGE, librealsense::hdr_merge);
 
-    template <typename T>
-    void hdr_merge::merge_frames_using_ir(uint16_t* new_data, uint16_t* d0, uint16_t* d1,
-        const rs2::video_frame& first_ir, const rs2::video_frame& second_ir, int width_height_prod) const
-    {
-        auto i0 = (T*)first_ir.get_data();
-        auto i1 = (T*)second_ir.get_data();
-
-        auto format = first_ir.get_profile().format();
-
-        for (int i = 0; i < width_height_prod; i++)
-        {
-            if (is_infrared_valid<T>(i0[i], format) && d0[i])
-                new_data[i] = d0[i];
-            else if (is_infrared_valid<T>(i1[i], format) && d1[i])
-                new_data[i] = d1[i];
-            else
-                new_data[i] = 0;
-        }
-    }
-
     template <typename T>
     bool hdr_merge::is_infrared_valid(T ir_value, rs2_format ir_format) const
     {
@@ -11,6 +11,13 @@
 #include "proc/synthetic-stream.h"
 #include "proc/hole-filling-filter.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 namespace librealsense
 {
     // The holes filling mode
@@ -75,19 +82,27 @@ namespace librealsense
             _source_stream_profile = f.get_profile();
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width * _bpp;
-            _current_frm_size_pixels = _width * _height;
-
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
         }
     }
 
+    void hole_filling_filter::configure(size_t width, size_t height, rs2_extension extension_type)
+    {
+        _extension_type = extension_type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width * _bpp;
+        _current_frm_size_pixels = _width * _height;
+    }
+
     rs2::frame hole_filling_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
+        // The filling runs in place, on the input frame when no one else holds it
+        if (auto tgt = reuse_input_frame(f, _target_stream_profile))
+            return tgt;
+
         // Allocate and copy the content of the input data to the target
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
 
@@ -95,4 +110,69 @@ namespace librealsense
         return tgt;
     }
 
+    size_t hole_filling_filter::farest_around_simd(const uint16_t* row, size_t width, uint16_t* around)
+    {
+        const uint16_t* up = row - width;
+        const uint16_t* down = row + width;
+        size_t i = 1;
+
+#ifdef __SSSE3__
+        // max(a, b) = subs(a, b) + b, SSSE3 has no unsigned 16-bit max
+        for (; i + 8 <= width; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i - 1));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i - 1));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i));
+            __m128i ab = _mm_add_epi16(_mm_subs_epu16(a, b), b);
+            __m128i cd = _mm_add_epi16(_mm_subs_epu16(c, d), d);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(around + i), _mm_add_epi16(_mm_subs_epu16(ab, cd), cd));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 8 <= width; i += 8)
+        {
+            uint16x8_t ab = vmaxq_u16(vld1q_u16(up + i), vld1q_u16(up + i - 1));
+            uint16x8_t cd = vmaxq_u16(vld1q_u16(down + i - 1), vld1q_u16(down + i));
+            vst1q_u16(around + i, vmaxq_u16(ab, cd));
+        }
+#endif
+        return i;
+    }
+
+    size_t hole_filling_filter::nearest_around_simd(const uint16_t* row, size_t width, uint16_t* around)
+    {
+        const uint16_t* up = row - width;
+        const uint16_t* down = row + width;
+        size_t i = 1;
+
+        // The empty pixels are skipped by taking the minimum of the values minus one, which wraps the empty pixels to the maximum
+#ifdef __SSSE3__
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= width; i += 8)
+        {
+            __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i));
+            __m128i a = _mm_sub_epi16(top, one);
+            __m128i b = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(up + i - 1)), one);
+            __m128i c = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i - 1)), one);
+            __m128i d = _mm_sub_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(down + i)), one);
+            // min(a, b) = a - subs(a, b)
+            __m128i ab = _mm_sub_epi16(a, _mm_subs_epu16(a, b));
+            __m128i cd = _mm_sub_epi16(c, _mm_subs_epu16(c, d));
+            __m128i res = _mm_add_epi16(_mm_sub_epi16(ab, _mm_subs_epu16(ab, cd)), one);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(around + i), _mm_andnot_si128(_mm_cmpeq_epi16(top, zero), res));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const uint16x8_t one = vdupq_n_u16(1);
+        for (; i + 8 <= width; i += 8)
+        {
+            uint16x8_t top = vld1q_u16(up + i);
+            uint16x8_t ab = vminq_u16(vsubq_u16(top, one), vsubq_u16(vld1q_u16(up + i - 1), one));
+            uint16x8_t cd = vminq_u16(vsubq_u16(vld1q_u16(down + i - 1), one), vsubq_u16(vld1q_u16(down + i), one));
+            uint16x8_t res = vaddq_u16(vminq_u16(ab, cd), one);
+            vst1q_u16(around + i, vbicq_u16(res, vceqzq_u16(top)));
+        }
+#endif
+        return i;
+    }
 }
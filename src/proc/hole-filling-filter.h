@@ -19,7 +19,11 @@ namespace librealsense
         hole_filling_filter();
 
     protected:
+        friend class depth_filter_chain;
+
         void update_configuration(const rs2::frame& f);
+        // Sets the dimensions and the domain the filling works on
+        void configure(size_t width, size_t height, rs2_extension extension_type);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
@@ -70,92 +74,84 @@ namespace librealsense
             }
         }
 
+        // The filling of a pixel depends on its left neighbour, which may have been filled just before it, and on the pixels of the rows
+        // above and below, which are final and untouched respectively. The pixels above and below are reduced for the whole row first,
+        // into 'around', with SIMD for depth, and the scan along the row then only compares the holes with their left neighbour
         template<typename T>
         inline void holes_fill_farest(T* image_data, size_t width, size_t height, size_t stride)
         {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
+            std::vector<T> around(width);
+            for (size_t j = 1; j + 1 < height; ++j)
             {
-                ++p;
-                for (int i = 1; i < width; ++i)
-                {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
-
-                        q = p - width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
+                T* p = image_data + j * width;
+                const T* up = p - width;
+                const T* down = p + width;
 
-                        q = p - 1;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        q = p + width - 1;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        q = p + width;
-                        if (*q > tmp)
-                            tmp = *q;
-
-                        *p = tmp;
-                    }
-
-                    p++;
+                for (size_t i = farest_around_simd(p, width, around.data()); i < width; ++i)
+                {
+                    T tmp = up[i];
+                    if (up[i - 1] > tmp)
+                        tmp = up[i - 1];
+                    if (down[i - 1] > tmp)
+                        tmp = down[i - 1];
+                    if (down[i] > tmp)
+                        tmp = down[i];
+                    around[i] = tmp;
                 }
+
+                for (size_t i = 1; i < width; ++i)
+                    if (is_empty(p[i]))
+                        p[i] = (p[i - 1] > around[i]) ? p[i - 1] : around[i];
             }
         }
 
         template<typename T>
         inline void holes_fill_nearest(T* image_data, size_t width, size_t height, size_t stride)
         {
-            std::function<bool(T*)> fp_oper = [](T* ptr) { return !*((int *)ptr); };
-            std::function<bool(T*)> uint_oper = [](T* ptr) { return !(*ptr); };
-            auto empty = (std::is_floating_point<T>::value) ? fp_oper : uint_oper;
-
-            T tmp = 0;
-            T * p = image_data + width;
-            T * q = nullptr;
-            for (int j = 1; j < height - 1; ++j)
+            // A hole with an empty pixel above it is left empty
+            std::vector<T> around(width);
+            for (size_t j = 1; j + 1 < height; ++j)
             {
-                ++p;
-                for (int i = 1; i < width; ++i)
-                {
-                    if (empty(p))
-                    {
-                        tmp = *(p - width);
-
-                        q = p - width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p + width - 1;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        q = p + width;
-                        if (!empty(q) && (*q < tmp))
-                            tmp = *q;
-
-                        *p = tmp;
-                    }
+                T* p = image_data + j * width;
+                const T* up = p - width;
+                const T* down = p + width;
 
-                    p++;
+                for (size_t i = nearest_around_simd(p, width, around.data()); i < width; ++i)
+                {
+                    T tmp = up[i];
+                    if (!is_empty(up[i - 1]) && (up[i - 1] < tmp))
+                        tmp = up[i - 1];
+                    if (!is_empty(down[i - 1]) && (down[i - 1] < tmp))
+                        tmp = down[i - 1];
+                    if (!is_empty(down[i]) && (down[i] < tmp))
+                        tmp = down[i];
+                    around[i] = tmp;
                 }
+
+                for (size_t i = 1; i < width; ++i)
+                    if (is_empty(p[i]))
+                        p[i] = (!is_empty(p[i - 1]) && (p[i - 1] < around[i])) ? p[i - 1] : around[i];
             }
         }
 
+        template<typename T>
+        static bool is_empty(T val) { return !val; }
+        static bool is_empty(float val)
+        {
+            int bits;
+            memcpy(&bits, &val, sizeof(bits));
+            return !bits;
+        }
+
+        // Vectorized reductions of the pixels above and below the row, for depth. They return the index of the first pixel
+        // left to the scalar code, 1 when there is no vectorized version
+        template<typename T>
+        size_t farest_around_simd(const T* row, size_t width, T* around) { return 1; }
+        template<typename T>
+        size_t nearest_around_simd(const T* row, size_t width, T* around) { return 1; }
+        size_t farest_around_simd(const uint16_t* row, size_t width, uint16_t* around);
+        size_t nearest_around_simd(const uint16_t* row, size_t width, uint16_t* around);
+
     private:
 
         size_t                  _width, _height, _stride;
@@ -0,0 +1,185 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "proc/image-transform.h"
+#include "../include/librealsense2/rsutil.h"
+
+using namespace librealsense;
+
+template<int N> struct bytes { byte b[N]; };
+
+bool is_special_resolution(const rs2_intrinsics& depth, const rs2_intrinsics& to)
+{
+    if ((depth.width == 640 && depth.height == 240 && to.width == 320 && to.height == 180) ||
+        (depth.width == 640 && depth.height == 480 && to.width == 640 && to.height == 360))
+        return true;
+    return false;
+}
+
+image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
+    :_depth(from),
+    _depth_scale(depth_scale),
+    _pixel_top_left_int(from.width*from.height),
+    _pixel_bottom_right_int(from.width*from.height)
+{
+}
+
+void image_transform::pre_compute_x_y_map_corners()
+{
+    _pre_compute_map_top_left = deprojection_cache::get_instance().get(_depth, -0.5f);
+    _pre_compute_map_bottom_right = deprojection_cache::get_instance().get(_depth, 0.5f);
+}
+
+void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, int bpp, const rs2_intrinsics& depth, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
+{
+    switch (to.model)
+    {
+    case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
+        align_depth_to_other(z_pixels, dest, depth, to, from_to_other, RS2_DISTORTION_MODIFIED_BROWN_CONRADY);
+        break;
+    default:
+        align_depth_to_other(z_pixels, dest, depth, to, from_to_other, RS2_DISTORTION_NONE);
+        break;
+    }
+}
+
+void image_transform::move_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, const rs2_intrinsics& to,
+    const cache_vector<librealsense::int2>& pixel_top_left_int,
+    const cache_vector<librealsense::int2>& pixel_bottom_right_int)
+{
+    for (int y = 0; y < _depth.height; ++y)
+    {
+        for (int x = 0; x < _depth.width; ++x)
+        {
+            auto depth_pixel_index = y * _depth.width + x;
+            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+            if (z_pixels[depth_pixel_index])
+            {
+                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                {
+                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                    {
+                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
+                            continue;
+                        auto other_ind = other_y * to.width + other_x;
+
+                        dest[other_ind] = dest[other_ind] ? std::min(dest[other_ind], z_pixels[depth_pixel_index]) : z_pixels[depth_pixel_index];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void image_transform::align_other_to_depth(const uint16_t* z_pixels, const byte* source, byte* dest, int bpp, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
+{
+    switch (to.model)
+    {
+    case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
+    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
+        align_other_to_depth(z_pixels, source, dest, bpp, to, from_to_other, RS2_DISTORTION_MODIFIED_BROWN_CONRADY);
+        break;
+    default:
+        align_other_to_depth(z_pixels, source, dest, bpp, to, from_to_other, RS2_DISTORTION_NONE);
+        break;
+    }
+}
+
+void image_transform::align_depth_to_other(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other, rs2_distortion dist)
+{
+    get_texture_map(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_top_left->x.data(),
+        _pre_compute_map_top_left->y.data(), _pixel_top_left_int.data(), to, from_to_other, dist);
+
+    float fov[2];
+    rs2_fov(&depth, fov);
+    float2 pixels_per_angle_depth = { (float)depth.width / fov[0], (float)depth.height / fov[1] };
+
+    rs2_fov(&to, fov);
+    float2 pixels_per_angle_target = { (float)to.width / fov[0], (float)to.height / fov[1] };
+
+    if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
+    {
+        get_texture_map(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_bottom_right->x.data(),
+            _pre_compute_map_bottom_right->y.data(), _pixel_bottom_right_int.data(), to, from_to_other, dist);
+
+        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
+    }
+    else
+    {
+        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_top_left_int);
+    }
+
+}
+
+void image_transform::align_other_to_depth(const uint16_t * z_pixels, const byte * source, byte * dest, int bpp, const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other, rs2_distortion dist)
+{
+    get_texture_map(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_top_left->x.data(),
+        _pre_compute_map_top_left->y.data(), _pixel_top_left_int.data(), to, from_to_other, dist);
+
+    auto bottom_right = &_pixel_top_left_int;
+    if (to.height < _depth.height && to.width < _depth.width)
+    {
+        get_texture_map(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_bottom_right->x.data(),
+            _pre_compute_map_bottom_right->y.data(), _pixel_bottom_right_int.data(), to, from_to_other, dist);
+
+        bottom_right = &_pixel_bottom_right_int;
+    }
+
+    switch (bpp)
+    {
+    case 1:
+        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<1>*>(source), reinterpret_cast<bytes<1>*>(dest), to,
+            _pixel_top_left_int, *bottom_right);
+        break;
+    case 2:
+        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<2>*>(source), reinterpret_cast<bytes<2>*>(dest), to,
+            _pixel_top_left_int, *bottom_right);
+        break;
+    case 3:
+        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<3>*>(source), reinterpret_cast<bytes<3>*>(dest), to,
+            _pixel_top_left_int, *bottom_right);
+        break;
+    case 4:
+        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<4>*>(source), reinterpret_cast<bytes<4>*>(dest), to,
+            _pixel_top_left_int, *bottom_right);
+        break;
+    default:
+        break;
+    }
+}
+
+template<class T >
+void image_transform::move_other_to_depth(const uint16_t* z_pixels,
+    const T* source,
+    T* dest, const rs2_intrinsics& to,
+    const cache_vector<librealsense::int2>& pixel_top_left_int,
+    const cache_vector<librealsense::int2>& pixel_bottom_right_int)
+{
+    // Iterate over the pixels of the depth image
+    for (int y = 0; y < _depth.height; ++y)
+    {
+        for (int x = 0; x < _depth.width; ++x)
+        {
+            auto depth_pixel_index = y * _depth.width + x;
+            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
+            if (z_pixels[depth_pixel_index])
+            {
+                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
+                {
+                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
+                    {
+                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
+                            continue;
+                        auto other_ind = other_y * to.width + other_x;
+
+                        dest[depth_pixel_index] = source[other_ind];
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2019 Intel Corporation. All Rights Reserved. */
+#pragma once
+
+#include "proc/align.h"
+#include "proc/deprojection-cache.h"
+
+namespace librealsense
+{
+    // Table based depth alignment shared by the SIMD align implementations.
+    // Every depth pixel is projected into the other stream using the cached deprojection
+    // tables, the derived classes provide the (vectorized) projection kernel.
+    class image_transform
+    {
+    public:
+
+        image_transform(const rs2_intrinsics& from,
+            float depth_scale);
+
+        virtual ~image_transform() = default;
+
+        void align_depth_to_other(const uint16_t* z_pixels,
+            uint16_t* dest, int bpp,
+            const rs2_intrinsics& depth,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other);
+
+        void align_other_to_depth(const uint16_t* z_pixels,
+            const byte* source,
+            byte* dest, int bpp, const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other);
+
+        void pre_compute_x_y_map_corners();
+
+    protected:
+
+        // Projects the depth pixels deprojected through (pre_compute_x, pre_compute_y) to the
+        // rounded pixel coordinates of the other stream, pixels with no depth are mapped to (0,0).
+        // dist is either RS2_DISTORTION_MODIFIED_BROWN_CONRADY or RS2_DISTORTION_NONE
+        virtual void get_texture_map(const uint16_t* z_pixels,
+            float depth_scale,
+            const unsigned int size,
+            const float* pre_compute_x, const float* pre_compute_y,
+            int2* pixels,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            rs2_distortion dist) = 0;
+
+    private:
+
+        const rs2_intrinsics _depth;
+        float _depth_scale;
+
+        std::shared_ptr<const deprojection_table> _pre_compute_map_top_left;
+        std::shared_ptr<const deprojection_table> _pre_compute_map_bottom_right;
+
+        cache_vector<int2> _pixel_top_left_int;
+        cache_vector<int2> _pixel_bottom_right_int;
+
+        void align_depth_to_other(const uint16_t* z_pixels,
+            uint16_t* dest, const rs2_intrinsics& depth,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            rs2_distortion dist);
+
+        void align_other_to_depth(const uint16_t* z_pixels,
+            const byte* source,
+            byte* dest, int bpp, const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            rs2_distortion dist);
+
+        void move_depth_to_other(const uint16_t* z_pixels,
+            uint16_t* dest, const rs2_intrinsics& to,
+            const cache_vector<int2>& pixel_top_left_int,
+            const cache_vector<int2>& pixel_bottom_right_int);
+
+        template<class T >
+        void move_other_to_depth(const uint16_t* z_pixels,
+            const T* source,
+            T* dest, const rs2_intrinsics& to,
+            const cache_vector<int2>& pixel_top_left_int,
+            const cache_vector<int2>& pixel_bottom_right_int);
+
+    };
+}
@@ -0,0 +1,204 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+
+#include "proc/synthetic-stream.h"
+#include "proc/median-filter.h"
+#include "option.h"
+
+#include <algorithm>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
+namespace librealsense
+{
+    // The radius of the neighborhood, 1 for 3x3 and 2 for 5x5
+    const uint8_t median_radius_min = 1;
+    const uint8_t median_radius_max = 2;
+    const uint8_t median_radius_def = 1;
+    const uint8_t median_radius_step = 1;
+
+    typedef std::vector<std::pair<uint8_t, uint8_t>> comparators;
+
+    // The comparators of Batcher's merge exchange sort of n values (Knuth, TAOCP vol. 3, algorithm 5.2.2M),
+    // less the ones that do not lead to the middle position: the network leaves the median there
+    static comparators make_median_network(int n)
+    {
+        comparators sort;
+        int t = 0;
+        while ((1 << t) < n)
+            t++;
+        for (int p = 1 << (t - 1); p > 0; p >>= 1)
+        {
+            int q = 1 << (t - 1), r = 0, d = p;
+            while (true)
+            {
+                for (int i = 0; i < n - d; i++)
+                    if ((i & p) == r)
+                        sort.push_back({ uint8_t(i), uint8_t(i + d) });
+                if (q == p)
+                    break;
+                d = q - p;
+                q >>= 1;
+                r = p;
+            }
+        }
+
+        std::vector<bool> needed(n, false);
+        needed[n / 2] = true;
+        comparators median;
+        for (auto it = sort.rbegin(); it != sort.rend(); ++it)
+        {
+            if (needed[it->first] || needed[it->second])
+            {
+                needed[it->first] = needed[it->second] = true;
+                median.push_back(*it);
+            }
+        }
+        std::reverse(median.begin(), median.end());
+        return median;
+    }
+
+    static const comparators& median_network(int radius)
+    {
+        static const comparators median_3x3 = make_median_network(9);
+        static const comparators median_5x5 = make_median_network(25);
+        return radius == 1 ? median_3x3 : median_5x5;
+    }
+
+    // Median of the valid pixels of the neighborhood clipped to the image, the lower of the two middle ones for an even count
+    template<typename T>
+    static T median_pixel(const T* src, int width, int height, int x, int y, int radius, T* values)
+    {
+        if (!(src[y * width + x] > 0))
+            return 0;
+        int n = 0;
+        for (int v = std::max(0, y - radius); v <= std::min(height - 1, y + radius); v++)
+            for (int u = std::max(0, x - radius); u <= std::min(width - 1, x + radius); u++)
+                if (src[v * width + u] > 0)
+                    values[n++] = src[v * width + u];
+        std::nth_element(values, values + (n - 1) / 2, values + n);
+        return values[(n - 1) / 2];
+    }
+
+    template<typename T>
+    static void median_row(const T* src, T* dst, int width, int height, int y, int first, int last, int radius)
+    {
+        T values[25];
+        for (int x = first; x < last; x++)
+            dst[y * width + x] = median_pixel(src, width, height, x, y, radius, values);
+    }
+
+#ifdef __SSSE3__
+    // Medians of eight Z16 pixels of a row, the neighborhood lies within the image.
+    // The values are biased to the signed range of the SSE2 min and max. Each lane replaces its holes alternately by the
+    // lowest and the highest value, which leaves the median of the valid values in the middle
+    static inline void median_z16(const uint16_t* src, uint16_t* dst, int width, int radius, const comparators& network)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i bias = _mm_set1_epi16(-0x8000);
+        const __m128i lowest = _mm_set1_epi16(-0x8000);
+        const __m128i highest = _mm_set1_epi16(0x7fff);
+
+        __m128i v[25];
+        __m128i parity = zero;
+        int n = 0;
+        for (int dy = -radius; dy <= radius; dy++)
+        {
+            for (int dx = -radius; dx <= radius; dx++, n++)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + dy * width + dx));
+                __m128i hole = _mm_cmpeq_epi16(a, zero);
+                __m128i fill = _mm_or_si128(_mm_and_si128(parity, highest), _mm_andnot_si128(parity, lowest));
+                v[n] = _mm_or_si128(_mm_and_si128(hole, fill), _mm_andnot_si128(hole, _mm_xor_si128(a, bias)));
+                parity = _mm_xor_si128(parity, hole);
+            }
+        }
+
+        for (auto& c : network)
+        {
+            __m128i lo = _mm_min_epi16(v[c.first], v[c.second]);
+            v[c.second] = _mm_max_epi16(v[c.first], v[c.second]);
+            v[c.first] = lo;
+        }
+
+        __m128i center = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_andnot_si128(center, _mm_xor_si128(v[n / 2], bias)));
+    }
+#endif
+
+    static void median_filter_z16(const uint16_t* src, uint16_t* dst, int width, int height, int radius)
+    {
+        auto& network = median_network(radius);
+#pragma omp parallel for schedule(dynamic)
+        for (int y = 0; y < height; y++)
+        {
+            int x = 0;
+#ifdef __SSSE3__
+            if (y >= radius && y < height - radius && width >= 2 * radius + 8)
+            {
+                median_row(src, dst, width, height, y, 0, radius, radius);
+                for (x = radius; x + 8 <= width - radius; x += 8)
+                    median_z16(src + y * width + x, dst + y * width + x, width, radius, network);
+            }
+#endif
+            median_row(src, dst, width, height, y, x, width, radius);
+        }
+    }
+
+    static void median_filter_disparity(const float* src, float* dst, int width, int height, int radius)
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (int y = 0; y < height; y++)
+            median_row(src, dst, width, height, y, 0, width, radius);
+    }
+
+    median_filter::median_filter()
+        : depth_processing_block("Median Filter"), _radius(median_radius_def), _extension_type(RS2_EXTENSION_DEPTH_FRAME)
+    {
+        _stream_filter.stream = RS2_STREAM_DEPTH;
+        _stream_filter.format = RS2_FORMAT_Z16;
+
+        auto radius = std::make_shared<ptr_option<uint8_t>>(
+            median_radius_min,
+            median_radius_max,
+            median_radius_step,
+            median_radius_def,
+            &_radius, "Radius of the neighborhood");
+        radius->set_description(1, "3x3");
+        radius->set_description(2, "5x5");
+        register_option(RS2_OPTION_FILTER_MAGNITUDE, radius);
+    }
+
+    void median_filter::update_configuration(const rs2::frame& f)
+    {
+        if (f.get_profile().get() == _source_stream_profile.get())
+            return;
+
+        _source_stream_profile = f.get_profile();
+        _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
+        _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
+    }
+
+    rs2::frame median_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        update_configuration(f);
+
+        auto vf = f.as<rs2::video_frame>();
+        int width = vf.get_width();
+        int height = vf.get_height();
+        int bpp = vf.get_bytes_per_pixel();
+        auto tgt = source.allocate_video_frame(_target_stream_profile, f, bpp, width, height, width * bpp, _extension_type);
+
+        auto dst = const_cast<void*>(tgt.get_data());
+        if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
+            median_filter_disparity(static_cast<const float*>(f.get_data()), static_cast<float*>(dst), width, height, _radius);
+        else
+            median_filter_z16(static_cast<const uint16_t*>(f.get_data()), static_cast<uint16_t*>(dst), width, height, _radius);
+        return tgt;
+    }
+}
@@ -0,0 +1,29 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    // Median of the 3x3 or 5x5 neighborhood of every depth pixel, the pixels of no depth are ignored and stay holes.
+    // The medians of Z16 depth are selected by a sorting network applied to eight pixels at once
+    class median_filter : public depth_processing_block
+    {
+    public:
+        median_filter();
+
+    protected:
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        uint8_t _radius;
+
+        rs2::stream_profile _source_stream_profile;
+        rs2::stream_profile _target_stream_profile;
+        rs2_extension _extension_type;
+    };
+}
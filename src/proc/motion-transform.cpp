@@ -6,8 +6,18 @@
 #include "synthetic-stream.h"
 #include "motion-transform.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace librealsense
 {
+    static constexpr float gravity = 9.80665f;          // Standard Gravitation Acceleration
+    static constexpr double accelerator_transform_factor = 0.001*gravity;
+    static const double gyro_transform_factor = deg2rad(0.1);
+
     template<rs2_format FORMAT> void copy_hid_axes(byte * const dest[], const byte * source, double factor)
     {
         using namespace librealsense;
@@ -22,9 +32,6 @@ namespace librealsense
     // Librealsense output format: floating point 32bit. units m/s^2,
     template<rs2_format FORMAT> void unpack_accel_axes(byte * const dest[], const byte * source, int width, int height, int output_size)
     {
-        static constexpr float gravity = 9.80665f;          // Standard Gravitation Acceleration
-        static constexpr double accelerator_transform_factor = 0.001*gravity;
-
         copy_hid_axes<FORMAT>(dest, source, accelerator_transform_factor);
     }
 
@@ -32,8 +39,6 @@ namespace librealsense
     // Librealsense output format: floating point 32bit. units rad/sec,
     template<rs2_format FORMAT> void unpack_gyro_axes(byte * const dest[], const byte * source, int width, int height, int output_size)
     {
-        static const double gyro_transform_factor = deg2rad(0.1);
-
         copy_hid_axes<FORMAT>(dest, source, gyro_transform_factor);
     }
 
@@ -66,8 +71,58 @@ namespace librealsense
         }
     }
 
+    // Computes m * v - bias for the samples of the arrays of the axes, in place
+    static void transform_motion_samples(float* x, float* y, float* z, size_t count, const float3x3& m, const float3& bias)
+    {
+        size_t i = 0;
+#ifdef __SSSE3__
+        const __m128 mxx = _mm_set1_ps(m.x.x), mxy = _mm_set1_ps(m.x.y), mxz = _mm_set1_ps(m.x.z);
+        const __m128 myx = _mm_set1_ps(m.y.x), myy = _mm_set1_ps(m.y.y), myz = _mm_set1_ps(m.y.z);
+        const __m128 mzx = _mm_set1_ps(m.z.x), mzy = _mm_set1_ps(m.z.y), mzz = _mm_set1_ps(m.z.z);
+        const __m128 bx = _mm_set1_ps(bias.x), by = _mm_set1_ps(bias.y), bz = _mm_set1_ps(bias.z);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 vx = _mm_loadu_ps(x + i);
+            __m128 vy = _mm_loadu_ps(y + i);
+            __m128 vz = _mm_loadu_ps(z + i);
+            _mm_storeu_ps(x + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(mxx, vx), _mm_mul_ps(myx, vy)), _mm_mul_ps(mzx, vz)), bx));
+            _mm_storeu_ps(y + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(mxy, vx), _mm_mul_ps(myy, vy)), _mm_mul_ps(mzy, vz)), by));
+            _mm_storeu_ps(z + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(mxz, vx), _mm_mul_ps(myz, vy)), _mm_mul_ps(mzz, vz)), bz));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const float32x4_t mxx = vdupq_n_f32(m.x.x), mxy = vdupq_n_f32(m.x.y), mxz = vdupq_n_f32(m.x.z);
+        const float32x4_t myx = vdupq_n_f32(m.y.x), myy = vdupq_n_f32(m.y.y), myz = vdupq_n_f32(m.y.z);
+        const float32x4_t mzx = vdupq_n_f32(m.z.x), mzy = vdupq_n_f32(m.z.y), mzz = vdupq_n_f32(m.z.z);
+        const float32x4_t bx = vdupq_n_f32(bias.x), by = vdupq_n_f32(bias.y), bz = vdupq_n_f32(bias.z);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t vx = vld1q_f32(x + i);
+            float32x4_t vy = vld1q_f32(y + i);
+            float32x4_t vz = vld1q_f32(z + i);
+            vst1q_f32(x + i, vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(mxx, vx), vmulq_f32(myx, vy)), vmulq_f32(mzx, vz)), bx));
+            vst1q_f32(y + i, vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(mxy, vx), vmulq_f32(myy, vy)), vmulq_f32(mzy, vz)), by));
+            vst1q_f32(z + i, vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(mxz, vx), vmulq_f32(myz, vy)), vmulq_f32(mzz, vz)), bz));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            auto res = m * float3{ x[i], y[i], z[i] } - bias;
+            x[i] = res.x;
+            y[i] = res.y;
+            z[i] = res.z;
+        }
+    }
+
     rs2::frame motion_transform::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
+        auto raw = dynamic_cast<frame*>((frame_interface*)f.get());
+        if (raw && raw->additional_data.motion_samples)
+        {
+            auto ret = prepare_frame(source, f);
+            correct_motion_samples(&ret, reinterpret_cast<const hid_batched_sample*>(f.get_data()), raw->additional_data.motion_samples);
+            return ret;
+        }
+
         auto&& ret = functional_processing_block::process_frame(source, f);
         correct_motion(&ret);
 
@@ -97,13 +152,52 @@ namespace librealsense
         }
     }
 
+    // A batched frame holds the timestamps of its samples, then the arrays of their x, y and z axes.
+    // The alignment, the units and the correction are composed into one transform applied to all the samples
+    void motion_transform::correct_motion_samples(rs2::frame* f, const hid_batched_sample* samples, size_t count)
+    {
+        auto timestamps = (double*)(f->get_data());
+        auto x = reinterpret_cast<float*>(timestamps + count);
+        auto y = x + count;
+        auto z = y + count;
+
+        auto m = _imu2depth_cs_alignment_matrix;
+        float3 bias{ 0, 0, 0 };
+        if (_mm_correct_opt && _mm_correct_opt->query() > 0.f)
+        {
+            auto&& s = f->get_profile().stream_type();
+            if (s == RS2_STREAM_ACCEL)
+            {
+                m = _accel_sensitivity * m;
+                bias = _accel_bias;
+            }
+            if (s == RS2_STREAM_GYRO)
+            {
+                m = _gyro_sensitivity * m;
+                bias = _gyro_bias;
+            }
+        }
+        m = { m.x * _samples_factor, m.y * _samples_factor, m.z * _samples_factor };
+
+        for (size_t i = 0; i < count; i++)
+        {
+            timestamps[i] = samples[i].timestamp;
+            x[i] = samples[i].data.x;
+            y[i] = samples[i].data.y;
+            z[i] = samples[i].data.z;
+        }
+        transform_motion_samples(x, y, z, count, m, bias);
+    }
+
     acceleration_transform::acceleration_transform(std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
         : acceleration_transform("Acceleration Transform", mm_calib, mm_correct_opt)
     {}
 
     acceleration_transform::acceleration_transform(const char * name, std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
         : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_ACCEL, mm_calib, mm_correct_opt)
-    {}
+    {
+        _samples_factor = float(accelerator_transform_factor);
+    }
 
     void acceleration_transform::process_function(byte * const dest[], const byte * source, int width, int height, int output_size, int actual_size)
     {
@@ -116,7 +210,9 @@ namespace librealsense
 
     gyroscope_transform::gyroscope_transform(const char * name, std::shared_ptr<mm_calib_handler> mm_calib, std::shared_ptr<enable_motion_correction> mm_correct_opt)
         : motion_transform(name, RS2_FORMAT_MOTION_XYZ32F, RS2_STREAM_GYRO, mm_calib, mm_correct_opt)
-    {}
+    {
+        _samples_factor = float(gyro_transform_factor);
+    }
 
     void gyroscope_transform::process_function(byte * const dest[], const byte * source, int width, int height, int output_size, int actual_size)
     {
@@ -22,8 +22,11 @@ namespace librealsense
             std::shared_ptr<enable_motion_correction> mm_correct_opt);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        float _samples_factor = 1.f; // Units of the raw samples, for the batched frames
+
     private:
         void correct_motion(rs2::frame* f);
+        void correct_motion_samples(rs2::frame* f, const hid_batched_sample* samples, size_t count);
 
         std::shared_ptr<enable_motion_correction> _mm_correct_opt = nullptr;
         float3x3            _accel_sensitivity;
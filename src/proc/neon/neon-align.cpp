@@ -0,0 +1,201 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+#include "neon-align.h"
+#include <arm_neon.h> // For NEON intrinsics
+#include <algorithm>
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+
+#include "core/video.h"
+#include "proc/synthetic-stream.h"
+#include "environment.h"
+#include "stream.h"
+
+using namespace librealsense;
+
+template<rs2_distortion dist>
+inline void distort_x_y_neon(float32x4_t& x, float32x4_t& y, const float32x4_t* c) {}
+
+template<>
+inline void distort_x_y_neon<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(float32x4_t& x, float32x4_t& y, const float32x4_t* c)
+{
+    auto one = vdupq_n_f32(1);
+    auto two = vdupq_n_f32(2);
+
+    auto r2 = vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y));
+    auto r3 = vaddq_f32(vmulq_f32(c[1], vmulq_f32(r2, r2)), vmulq_f32(c[4], vmulq_f32(r2, vmulq_f32(r2, r2))));
+    auto f = vaddq_f32(one, vaddq_f32(vmulq_f32(c[0], r2), r3));
+
+    auto x_f = vmulq_f32(x, f);
+    auto y_f = vmulq_f32(y, f);
+
+    auto r4 = vmulq_f32(c[3], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(x_f, x_f))));
+    auto d_x = vaddq_f32(x_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[2], vmulq_f32(x_f, y_f))), r4));
+
+    // Matches the SSE kernels term for term
+    auto d_y = vaddq_f32(y_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[3], vmulq_f32(x_f, y_f))), r4));
+
+    x = d_x;
+    y = d_y;
+}
+
+template<rs2_distortion dist>
+inline void get_texture_map_neon(const uint16_t * depth,
+    float depth_scale,
+    const unsigned int size,
+    const float * pre_compute_x, const float * pre_compute_y,
+    int2 * pixels,
+    const rs2_intrinsics& to,
+    const rs2_extrinsics& from_to_other)
+{
+    auto scale = vdupq_n_f32(depth_scale);
+
+    auto res = reinterpret_cast<int32_t*>(pixels);
+
+    float32x4_t r[9];
+    float32x4_t t[3];
+    float32x4_t c[5];
+
+    for (int i = 0; i < 9; ++i)
+    {
+        r[i] = vdupq_n_f32(from_to_other.rotation[i]);
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        t[i] = vdupq_n_f32(from_to_other.translation[i]);
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        c[i] = vdupq_n_f32(to.coeffs[i]);
+    }
+    auto zero = vdupq_n_f32(0);
+    auto half = vdupq_n_f32(0.5);
+    auto fx = vdupq_n_f32(to.fx);
+    auto fy = vdupq_n_f32(to.fy);
+    auto ppx = vdupq_n_f32(to.ppx);
+    auto ppy = vdupq_n_f32(to.ppy);
+
+    // The last pixels are padded to a full vector, pixels past the end are not stored
+    for (unsigned int i = 0; i < size; i += 4)
+    {
+        float32x4_t x, y;
+        uint16x4_t d;
+        if (i + 4 <= size)
+        {
+            x = vld1q_f32(pre_compute_x + i);
+            y = vld1q_f32(pre_compute_y + i);
+            d = vld1_u16(depth + i);
+        }
+        else
+        {
+            float tail_x[4] = {}, tail_y[4] = {};
+            uint16_t tail_d[4] = {};
+            std::copy(pre_compute_x + i, pre_compute_x + size, tail_x);
+            std::copy(pre_compute_y + i, pre_compute_y + size, tail_y);
+            std::copy(depth + i, depth + size, tail_d);
+            x = vld1q_f32(tail_x);
+            y = vld1q_f32(tail_y);
+            d = vld1_u16(tail_d);
+        }
+
+        //zero extend the 4 depth pixels to 32 bit and convert to float
+        auto z = vmulq_f32(vcvtq_f32_u32(vmovl_u16(d)), scale);
+
+        auto px = vmulq_f32(z, x);
+        auto py = vmulq_f32(z, y);
+
+        auto p_x = vaddq_f32(vmulq_f32(r[0], px), vaddq_f32(vmulq_f32(r[3], py), vaddq_f32(vmulq_f32(r[6], z), t[0])));
+        auto p_y = vaddq_f32(vmulq_f32(r[1], px), vaddq_f32(vmulq_f32(r[4], py), vaddq_f32(vmulq_f32(r[7], z), t[1])));
+        auto p_z = vaddq_f32(vmulq_f32(r[2], px), vaddq_f32(vmulq_f32(r[5], py), vaddq_f32(vmulq_f32(r[8], z), t[2])));
+
+        p_x = vdivq_f32(p_x, p_z);
+        p_y = vdivq_f32(p_y, p_z);
+
+        distort_x_y_neon<dist>(p_x, p_y, c);
+
+        //zero the x and y if z is zero
+        auto cmp = vmvnq_u32(vceqq_f32(z, zero));
+        auto u_round = vandq_u32(vreinterpretq_u32_f32(vaddq_f32(vaddq_f32(vmulq_f32(p_x, fx), ppx), half)), cmp);
+        auto v_round = vandq_u32(vreinterpretq_u32_f32(vaddq_f32(vaddq_f32(vmulq_f32(p_y, fy), ppy), half)), cmp);
+
+        //round to nearest even like _mm_cvtps_epi32, and store interleaved u0 v0 u1 v1 ...
+        int32x4x2_t uv;
+        uv.val[0] = vcvtnq_s32_f32(vreinterpretq_f32_u32(u_round));
+        uv.val[1] = vcvtnq_s32_f32(vreinterpretq_f32_u32(v_round));
+        if (i + 4 <= size)
+        {
+            vst2q_s32(res + 2 * i, uv);
+        }
+        else
+        {
+            int32_t tail[8];
+            vst2q_s32(tail, uv);
+            std::copy(tail, tail + 2 * (size - i), res + 2 * i);
+        }
+    }
+}
+
+void image_transform_neon::get_texture_map(const uint16_t* z_pixels, float depth_scale, const unsigned int size,
+    const float* pre_compute_x, const float* pre_compute_y, int2* pixels,
+    const rs2_intrinsics& to, const rs2_extrinsics& from_to_other, rs2_distortion dist)
+{
+    if (dist == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
+        get_texture_map_neon<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels, to, from_to_other);
+    else
+        get_texture_map_neon<RS2_DISTORTION_NONE>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels, to, from_to_other);
+}
+
+void align_neon::reset_cache(rs2_stream from, rs2_stream to)
+{
+    _stream_transform = nullptr;
+}
+
+void align_neon::align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale)
+{
+    byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
+    auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
+    memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+
+    auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+
+    auto z_intrin = depth_profile.get_intrinsics();
+    auto other_intrin = other_profile.get_intrinsics();
+    auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
+
+    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+
+    if (_stream_transform == nullptr)
+    {
+        _stream_transform = std::make_shared<image_transform_neon>(z_intrin, z_scale);
+        _stream_transform->pre_compute_x_y_map_corners();
+    }
+    _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
+}
+
+void align_neon::align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale)
+{
+    byte* aligned_data = reinterpret_cast<byte*>(const_cast<void*>(aligned.get_data()));
+    auto aligned_profile = aligned.get_profile().as<rs2::video_stream_profile>();
+    memset(aligned_data, 0, aligned_profile.height() * aligned_profile.width() * aligned.get_bytes_per_pixel());
+
+    auto depth_profile = depth.get_profile().as<rs2::video_stream_profile>();
+    auto other_profile = other.get_profile().as<rs2::video_stream_profile>();
+
+    auto z_intrin = depth_profile.get_intrinsics();
+    auto other_intrin = other_profile.get_intrinsics();
+    auto z_to_other = depth_profile.get_extrinsics_to(other_profile);
+
+    auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+    auto other_pixels = reinterpret_cast<const byte*>(other.get_data());
+
+    if (_stream_transform == nullptr)
+    {
+        _stream_transform = std::make_shared<image_transform_neon>(z_intrin, z_scale);
+        _stream_transform->pre_compute_x_y_map_corners();
+    }
+
+    _stream_transform->align_other_to_depth(z_pixels, other_pixels, aligned_data, other.get_bytes_per_pixel(), other_intrin, z_to_other);
+}
+#endif // __ARM_NEON && __aarch64__
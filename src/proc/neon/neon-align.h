@@ -0,0 +1,46 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2019 Intel Corporation. All Rights Reserved. */
+#pragma once
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+#include "proc/align.h"
+#include "proc/image-transform.h"
+
+namespace librealsense
+{
+    class image_transform_neon : public image_transform
+    {
+    public:
+        image_transform_neon(const rs2_intrinsics& from, float depth_scale)
+            : image_transform(from, depth_scale) {}
+
+    protected:
+        void get_texture_map(const uint16_t* z_pixels,
+            float depth_scale,
+            const unsigned int size,
+            const float* pre_compute_x, const float* pre_compute_y,
+            int2* pixels,
+            const rs2_intrinsics& to,
+            const rs2_extrinsics& from_to_other,
+            rs2_distortion dist) override;
+    };
+
+    class align_neon : public align
+    {
+    public:
+        align_neon(std::vector<rs2_stream> to_streams) : align(to_streams, "Align (NEON)") {}
+
+    protected:
+        void reset_cache(rs2_stream from, rs2_stream to) override;
+
+        bool deprojects_once() const override { return false; }
+
+        void align_z_to_other(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_stream_profile& other_profile, float z_scale) override;
+
+        void align_other_to_z(rs2::video_frame& aligned, const rs2::video_frame& depth, const rs2::video_frame& other, float z_scale) override;
+
+    private:
+        std::shared_ptr<image_transform> _stream_transform;
+    };
+}
+#endif // __ARM_NEON && __aarch64__
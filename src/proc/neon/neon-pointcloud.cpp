@@ -0,0 +1,189 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rs.hpp"
+#include "../include/librealsense2/rsutil.h"
+
+#include "proc/synthetic-stream.h"
+#include "environment.h"
+#include "proc/occlusion-filter.h"
+#include "proc/neon/neon-pointcloud.h"
+#include "option.h"
+#include "context.h"
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h> // For NEON intrinsics
+#include <algorithm>
+
+#endif
+
+namespace librealsense
+{
+    pointcloud_neon::pointcloud_neon() : pointcloud("Pointcloud (NEON)") {}
+
+    void pointcloud_neon::preprocess()
+    {
+        _pre_compute_map = deprojection_cache::get_instance().get(*_depth_intrinsics);
+    }
+
+    const float3* pointcloud_neon::depth_to_points(rs2::points output,
+            const rs2_intrinsics &depth_intrinsics,
+            const rs2::depth_frame& depth_frame,
+            float depth_scale)
+    {
+#if defined(__ARM_NEON) && defined(__aarch64__)
+
+        auto depth_image = (const uint16_t*)depth_frame.get_data();
+
+        const float* mapx = _pre_compute_map->x.data();
+        const float* mapy = _pre_compute_map->y.data();
+
+        uint32_t size = depth_intrinsics.height * depth_intrinsics.width;
+
+        auto point = (float*)output.get_vertices();
+
+        auto scale = vdupq_n_f32(depth_scale);
+
+        uint32_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            //zero extend the 4 depth pixels to 32 bit and convert to float
+            auto depth = vmulq_f32(vcvtq_f32_u32(vmovl_u16(vld1_u16(depth_image + i))), scale);
+
+            //store 4 points of x y z, interleaved by the store
+            float32x4x3_t xyz;
+            xyz.val[0] = vmulq_f32(depth, vld1q_f32(mapx + i));
+            xyz.val[1] = vmulq_f32(depth, vld1q_f32(mapy + i));
+            xyz.val[2] = depth;
+            vst3q_f32(point + 3 * i, xyz);
+        }
+        for (; i < size; ++i)
+        {
+            float depth = depth_image[i] * depth_scale;
+            point[3 * i] = depth * mapx[i];
+            point[3 * i + 1] = depth * mapy[i];
+            point[3 * i + 2] = depth;
+        }
+#endif
+        return (float3*)output.get_vertices();
+    }
+
+    void pointcloud_neon::get_texture_map(rs2::points output,
+        const float3* points,
+        const unsigned int width,
+        const unsigned int height,
+        const rs2_intrinsics &other_intrinsics,
+        const rs2_extrinsics& extr,
+        float2* pixels_ptr)
+    {
+        auto tex_ptr = (float2*)output.get_texture_coordinates();
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+        auto point = reinterpret_cast<const float*>(points);
+        auto res = reinterpret_cast<float*>(tex_ptr);
+        auto res1 = reinterpret_cast<float*>(pixels_ptr);
+
+        float32x4_t r[9];
+        float32x4_t t[3];
+        float32x4_t c[5];
+
+        for (int i = 0; i < 9; ++i)
+        {
+            r[i] = vdupq_n_f32(extr.rotation[i]);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            t[i] = vdupq_n_f32(extr.translation[i]);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            c[i] = vdupq_n_f32(other_intrinsics.coeffs[i]);
+        }
+
+        auto fx = vdupq_n_f32(other_intrinsics.fx);
+        auto fy = vdupq_n_f32(other_intrinsics.fy);
+        auto ppx = vdupq_n_f32(other_intrinsics.ppx);
+        auto ppy = vdupq_n_f32(other_intrinsics.ppy);
+        auto w = vdupq_n_f32(float(other_intrinsics.width));
+        auto h = vdupq_n_f32(float(other_intrinsics.height));
+        auto zero = vdupq_n_f32(0);
+        auto one = vdupq_n_f32(1);
+        auto two = vdupq_n_f32(2);
+
+        // Same as the SSE version, the distortion is applied to the inverse brown conrady model only
+        bool distort = other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+
+        // The last points are padded to a full vector, pixels past the end are not stored
+        const unsigned int size = height * width;
+        for (unsigned int i = 0; i < size; i += 4)
+        {
+            float32x4x3_t xyz;
+            if (i + 4 <= size)
+            {
+                //load 4 points (x,y,z), deinterleaved by the load
+                xyz = vld3q_f32(point + 3 * i);
+            }
+            else
+            {
+                float tail[12] = {};
+                std::copy(point + 3 * i, point + 3 * size, tail);
+                xyz = vld3q_f32(tail);
+            }
+            auto x = xyz.val[0];
+            auto y = xyz.val[1];
+            auto z = xyz.val[2];
+
+            auto p_x = vaddq_f32(vmulq_f32(r[0], x), vaddq_f32(vmulq_f32(r[3], y), vaddq_f32(vmulq_f32(r[6], z), t[0])));
+            auto p_y = vaddq_f32(vmulq_f32(r[1], x), vaddq_f32(vmulq_f32(r[4], y), vaddq_f32(vmulq_f32(r[7], z), t[1])));
+            auto p_z = vaddq_f32(vmulq_f32(r[2], x), vaddq_f32(vmulq_f32(r[5], y), vaddq_f32(vmulq_f32(r[8], z), t[2])));
+
+            p_x = vdivq_f32(p_x, p_z);
+            p_y = vdivq_f32(p_y, p_z);
+
+            if (distort)
+            {
+                auto r2 = vaddq_f32(vmulq_f32(p_x, p_x), vmulq_f32(p_y, p_y));
+                auto r3 = vaddq_f32(vmulq_f32(c[1], vmulq_f32(r2, r2)), vmulq_f32(c[4], vmulq_f32(r2, vmulq_f32(r2, r2))));
+                auto f = vaddq_f32(one, vaddq_f32(vmulq_f32(c[0], r2), r3));
+
+                auto x_f = vmulq_f32(p_x, f);
+                auto y_f = vmulq_f32(p_y, f);
+
+                auto r4 = vmulq_f32(c[3], vaddq_f32(r2, vmulq_f32(two, vmulq_f32(x_f, x_f))));
+                p_x = vaddq_f32(x_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[2], vmulq_f32(x_f, y_f))), r4));
+                p_y = vaddq_f32(y_f, vaddq_f32(vmulq_f32(two, vmulq_f32(c[3], vmulq_f32(x_f, y_f))), r4));
+            }
+
+            //TODO: add handle to RS2_DISTORTION_FTHETA
+
+            //zero the x and y if z is zero
+            auto cmp = vmvnq_u32(vceqq_f32(z, zero));
+            float32x4x2_t pixel;
+            pixel.val[0] = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vaddq_f32(vmulq_f32(p_x, fx), ppx)), cmp));
+            pixel.val[1] = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vaddq_f32(vmulq_f32(p_y, fy), ppy)), cmp));
+
+            //normalize x and y
+            float32x4x2_t tex;
+            tex.val[0] = vdivq_f32(pixel.val[0], w);
+            tex.val[1] = vdivq_f32(pixel.val[1], h);
+
+            //store the x y pairs, interleaved by the store
+            if (i + 4 <= size)
+            {
+                vst2q_f32(res1 + 2 * i, pixel);
+                vst2q_f32(res + 2 * i, tex);
+            }
+            else
+            {
+                float tail[8];
+                vst2q_f32(tail, pixel);
+                std::copy(tail, tail + 2 * (size - i), res1 + 2 * i);
+                vst2q_f32(tail, tex);
+                std::copy(tail, tail + 2 * (size - i), res + 2 * i);
+            }
+        }
+#endif
+
+    }
+}
@@ -22,7 +22,7 @@ namespace librealsense
         _texels_depth.resize(_texels_intrinsics.value().width*_texels_intrinsics.value().height);
     }
 
-   void occlusion_filter::process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const
+   void occlusion_filter::process(float3* points, float2* uv_map, const cache_vector<float2> & pix_coord, const rs2::depth_frame& depth) const
     {
         switch (_occlusion_filter)
         {
@@ -63,8 +63,9 @@ namespace librealsense
 
        return res;
    }
+   // The tile buffer is resized to the tile of the image and reused by the next calls
    template<size_t SIZE>
-   void rotate_image_optimized(byte* dest[], const byte* source, int width, int height)
+   void rotate_image_optimized(byte* dest[], const byte* source, int width, int height, cache_vector<byte>& tile)
    {
 
        auto width_out = height;
@@ -73,9 +74,8 @@ namespace librealsense
        auto out = dest[0];
        auto buffer_size = maxDivisorRange(height, width, 1, ROTATION_BUFFER_SIZE); 
 
-       byte** buffer = new byte * [buffer_size];
-       for (int i = 0; i < buffer_size; ++i)
-           buffer[i] = new byte[buffer_size * SIZE];
+       tile.resize(buffer_size * buffer_size * SIZE);
+       auto buffer = [&](int row) { return tile.data() + row * buffer_size * SIZE; };
 
 
        for (int i = 0; i <= height - buffer_size; i = i + buffer_size)
@@ -87,24 +87,17 @@ namespace librealsense
                    for (int jj = 0; jj < buffer_size; ++jj)
                    {
                        auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                       memcpy((void*)&(buffer[(buffer_size-1 - jj)][(buffer_size-1 - ii) * SIZE]), &source[source_index], SIZE);
+                       memcpy((void*)(buffer(buffer_size-1 - jj) + (buffer_size-1 - ii) * SIZE), &source[source_index], SIZE);
                    }
                }
 
                for (int ii = 0; ii < buffer_size; ++ii)
                {
                    auto out_index = (((height_out - buffer_size - j + 1) * width_out) - i - buffer_size + (ii)*width_out);
-                   memcpy(&out[(out_index)*SIZE], (buffer[ii]), buffer_size * SIZE);
+                   memcpy(&out[(out_index)*SIZE], buffer(ii), buffer_size * SIZE);
                }
            }
        }
-
-       for (int i = 0; i < buffer_size; ++i)
-       {
-           delete[] buffer[i];
-       }
-       delete[] buffer;
- 
    }
     // IMPORTANT! This implementation is based on the assumption that the RGB sensor is positioned strictly to the left of the depth sensor.
     // namely D415/D435 and SR300. The implementation WILL NOT work properly for different setups
@@ -114,27 +107,26 @@ namespace librealsense
     // -  The occlusion is designated as U coordinate for a given pixel is less than the U coordinate of the predecessing pixel.
     // -  The UV mapping for the occluded pixel is reset to (0,0). Later on the (0,0) coordinate in the texture map is overwritten
     //    with a invalidation color such as black/magenta according to the purpose (production/debugging)
-   void occlusion_filter::monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2>& pix_coord, const rs2::depth_frame& depth) const
+   void occlusion_filter::monotonic_heuristic_invalidation(float3* points, float2* uv_map, const cache_vector<float2>& pix_coord, const rs2::depth_frame& depth) const
    {
        float occZTh = 0.1f; //meters
        int occDilationSz = 1;
        auto points_width = _depth_intrinsics->width;
        auto points_height = _depth_intrinsics->height;
-       auto pixels_ptr = pix_coord.data();
-       auto points_ptr = points;
-       auto uv_map_ptr = uv_map;
-       float maxInLine = -1;
-       float maxZ = 0;
 
        if (_occlusion_scanning == horizontal)
        {
-           for( size_t y = 0; y < points_height; ++y )
+           // the lines are independent
+#pragma omp parallel for schedule(static)
+           for( int y = 0; y < points_height; ++y )
            {
-               maxInLine = -1;
-               maxZ = 0;
+               auto pixels_ptr = pix_coord.data() + y * points_width;
+               auto points_ptr = points + y * points_width;
+               float maxInLine = -1;
+               float maxZ = 0;
                int occDilationLeft = 0;
 
-               for( size_t x = 0; x < points_width; ++x )
+               for( int x = 0; x < points_width; ++x )
                {
                    if( points_ptr->z )
                    {
@@ -157,7 +149,6 @@ namespace librealsense
                        }
                    }
                    ++points_ptr;
-                   ++uv_map_ptr;
                    ++pixels_ptr;
                }
            }
@@ -166,16 +157,23 @@ namespace librealsense
        {
            auto rotated_depth_width = _depth_intrinsics->height;
            auto rotated_depth_height = _depth_intrinsics->width;
-           auto depth_ptr = (byte*)(depth.get_data());
-           std::vector< byte > alloc( depth.get_bytes_per_pixel() * points_width * points_height );
+           // one more pixel, compared with the last one
+           _rotated_depth.resize(points_width * points_height + 1);
+           _rotated_depth.back() = 0;
            byte* depth_planes[1];
-           depth_planes[0] = alloc.data();
+           depth_planes[0] = reinterpret_cast<byte*>(_rotated_depth.data());
 
-           rotate_image_optimized<2>(depth_planes, (const byte*)(depth.get_data()), points_width, points_height);
+           rotate_image_optimized<2>(depth_planes, (const byte*)(depth.get_data()), points_width, points_height, _rotation_buffer);
+
+           const uint16_t* diff_depth_ptr = _rotated_depth.data();
+           const float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
+           const int scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
 
            // scan depth frame after rotation: check if there is a noticed jump between adjacen pixels in Z-axis (depth), it means there could be occlusion.
            // save suspected points and run occlusion-invalidation vertical scan only on them
            // after rotation : height = points_width , width = points_height
+           // every line of the rotated depth is a column of the points, so the lines are independent
+#pragma omp parallel for schedule(static)
            for (int i = 0; i < rotated_depth_height; i++)
            {
                for (int j = 0; j < rotated_depth_width; j++)
@@ -186,18 +184,15 @@ namespace librealsense
                    auto index = (j + (rotated_depth_width * i));
                    auto uv_index = ((rotated_depth_height - i - 1) + (rotated_depth_width - j - 1) * rotated_depth_height);
                    auto index_right = index + 1;
-                   uint16_t* diff_depth_ptr = (uint16_t*)depth_planes[0];
                    uint16_t diff_right = abs((uint16_t)(*(diff_depth_ptr + index)) - (uint16_t)(*(diff_depth_ptr + index_right)));
-                   float scaled_threshold = DEPTH_OCCLUSION_THRESHOLD / _depth_units;
                    if (diff_right > scaled_threshold)
                    {
-                       points_ptr = points + uv_index;
-                       uv_map_ptr = uv_map + uv_index;
-                       auto scan_win_size = maxDivisorRange(rotated_depth_height, rotated_depth_width, 1, VERTICAL_SCAN_WINDOW_SIZE);
+                       auto points_ptr = points + uv_index;
+                       auto uv_map_ptr = uv_map + uv_index;
 
                        if (j >= scan_win_size) {
-                           maxInLine = (uv_map_ptr - 1 * points_width)->y;
-                           for (size_t y = 0; y <= scan_win_size; ++y)
+                           float maxInLine = (uv_map_ptr - 1 * points_width)->y;
+                           for (int y = 0; y <= scan_win_size; ++y)
                            {
                                if (((uv_map_ptr + y * points_width)->y < maxInLine))
                                {
@@ -224,7 +219,7 @@ namespace librealsense
     // Algo intermediate data:
     // Vector of depth values (floats) in size of the mapped texture (different from depth width*height) where
     // each (i,j) cell holds the minimal Z among all the depth pixels that are mapped to the specific texel
-    void occlusion_filter::comprehensive_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord) const
+    void occlusion_filter::comprehensive_invalidation(float3* points, float2* uv_map, const cache_vector<float2> & pix_coord) const
     {
         auto depth_points = points;
         auto mapped_pix = pix_coord.data();
@@ -260,13 +255,13 @@ namespace librealsense
             }
         }
 
-        mapped_pix = pix_coord.data();
-        depth_points = points;
-        auto uv_ptr = uv_map;
-
-        // Pass2 -invalidate depth texels with occlusion traits
-        for (size_t i = 0; i < points_height; i++)
+        // Pass2 -invalidate depth texels with occlusion traits, the lines only read the texels and are independent
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < int(points_height); i++)
         {
+            auto mapped_pix = pix_coord.data() + i * points_width;
+            auto depth_points = points + i * points_width;
+            auto uv_ptr = uv_map + i * points_width;
             for (size_t j = 0; j < points_width; j++)
             {
                 if ((depth_points->z > 0.0001f) &&
@@ -4,6 +4,7 @@
 #pragma once
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "proc/rotation-transform.h"
+#include "memory-counter.h"
 
 #define ROTATION_BUFFER_SIZE 32 // minimum limit that could be divided by all resolutions
 #define VERTICAL_SCAN_WINDOW_SIZE 16
@@ -32,7 +33,7 @@ namespace librealsense
 
         bool active(void) const { return (occlusion_none != _occlusion_filter); }
 
-        void process(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
+        void process(float3* points, float2* uv_map, const cache_vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
 
         void set_mode(uint8_t filter_type) { _occlusion_filter = (occlusion_rect_type)filter_type; }
         void set_scanning(uint8_t scanning) { _occlusion_scanning = (occlusion_scanning_type)scanning; }
@@ -57,12 +58,14 @@ namespace librealsense
 
         friend class pointcloud;
 
-        void monotonic_heuristic_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
-        void comprehensive_invalidation(float3* points, float2* uv_map, const std::vector<float2> & pix_coord) const;
+        void monotonic_heuristic_invalidation(float3* points, float2* uv_map, const cache_vector<float2> & pix_coord, const rs2::depth_frame& depth) const;
+        void comprehensive_invalidation(float3* points, float2* uv_map, const cache_vector<float2> & pix_coord) const;
 
         optional_value<rs2_intrinsics>              _depth_intrinsics;
         optional_value<rs2_intrinsics>              _texels_intrinsics;
-        mutable std::vector<float>                  _texels_depth; // Temporal translation table of (mapped_x*mapped_y) holds the minimal depth value among all depth pixels mapped to that texel
+        mutable cache_vector<float>                 _texels_depth; // Temporal translation table of (mapped_x*mapped_y) holds the minimal depth value among all depth pixels mapped to that texel
+        mutable cache_vector<uint16_t>              _rotated_depth; // Depth rotated for the vertical scan, kept between frames
+        mutable cache_vector<byte>                  _rotation_buffer; // Tile of the depth rotation
         occlusion_rect_type                         _occlusion_filter;
         occlusion_scanning_type                     _occlusion_scanning;
         float                                       _depth_units;
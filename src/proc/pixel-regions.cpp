@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "pixel-regions.h"
+#include "types.h"
+
+#include <algorithm>
+
+namespace librealsense
+{
+    void pixel_regions::set(const rs2_pixel_region* regions, int count)
+    {
+        std::vector<rs2_pixel_region> res(regions, regions + count);
+        for (auto&& r : res)
+        {
+            if (r.min_x > r.max_x || r.min_y > r.max_y)
+                throw invalid_value_exception(to_string() << "Invalid region (" << r.min_x << ", " << r.min_y
+                    << ") - (" << r.max_x << ", " << r.max_y << ")");
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _regions = std::move(res);
+        _spans.reset();
+    }
+
+    std::shared_ptr<const pixel_regions::spans> pixel_regions::get(int width, int height) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_regions.empty())
+            return nullptr;
+
+        if (!_spans || _width != width || _height != height)
+        {
+            _spans = std::make_shared<spans>(to_spans(_regions, width, height));
+            _width = width;
+            _height = height;
+        }
+        return _spans;
+    }
+
+    pixel_regions::spans pixel_regions::to_spans(const std::vector<rs2_pixel_region>& regions, int width, int height)
+    {
+        spans res;
+        int min_y = height, max_y = -1;
+        for (auto&& r : regions)
+        {
+            min_y = std::min(min_y, std::max(r.min_y, 0));
+            max_y = std::max(max_y, std::min(r.max_y, height - 1));
+        }
+
+        std::vector<std::pair<int, int>> line;
+        for (int y = min_y; y <= max_y; y++)
+        {
+            line.clear();
+            for (auto&& r : regions)
+            {
+                auto begin = std::max(r.min_x, 0);
+                auto end = std::min(r.max_x + 1, width);
+                if (y >= r.min_y && y <= r.max_y && begin < end)
+                    line.emplace_back(begin, end);
+            }
+            std::sort(line.begin(), line.end());
+
+            // overlapping or adjacent regions make one span
+            for (auto&& s : line)
+            {
+                if (!res.empty() && res.back().y == y && s.first <= res.back().end)
+                    res.back().end = std::max(res.back().end, s.second);
+                else
+                    res.push_back({ y, s.first, s.second });
+            }
+        }
+        return res;
+    }
+}
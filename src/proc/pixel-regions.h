@@ -0,0 +1,41 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    // Rectangles of an image the pointcloud and the align blocks are restricted to, set by the user while the block runs.
+    // They are processed as the spans of the lines they cover, without overlaps
+    class pixel_regions
+    {
+    public:
+        // [begin, end) of line y
+        struct span
+        {
+            int y, begin, end;
+        };
+        typedef std::vector<span> spans;
+
+        // No region processes the whole image
+        void set(const rs2_pixel_region* regions, int count);
+
+        // The spans of the regions clipped to an image, null when no region is set
+        std::shared_ptr<const spans> get(int width, int height) const;
+
+        // The spans of regions clipped to an image, ordered by line
+        static spans to_spans(const std::vector<rs2_pixel_region>& regions, int width, int height);
+
+    private:
+        mutable std::mutex _mutex;
+        std::vector<rs2_pixel_region> _regions;
+        mutable std::shared_ptr<const spans> _spans;
+        mutable int _width = 0, _height = 0;
+    };
+}
@@ -19,6 +19,8 @@
 #endif
 #ifdef __SSSE3__
 #include "proc/sse/sse-pointcloud.h"
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include "proc/neon/neon-pointcloud.h"
 #endif
 
 namespace librealsense
@@ -44,6 +46,26 @@ namespace librealsense
         return (float3*)image;
     }
 
+    void pointcloud::depth_to_points_in(rs2::points output, const pixel_regions::spans& spans,
+        const rs2_intrinsics& depth_intrinsics, const rs2::depth_frame& depth_frame, float depth_scale)
+    {
+        auto points = (float3*)output.get_vertices();
+        auto depth = (const uint16_t*)depth_frame.get_data();
+        memset(points, 0, depth_intrinsics.width * depth_intrinsics.height * sizeof(float3));
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < int(spans.size()); i++)
+        {
+            auto& s = spans[i];
+            auto index = s.y * depth_intrinsics.width + s.begin;
+            for (int x = s.begin; x < s.end; ++x, ++index)
+            {
+                const float pixel[] = { (float)x, (float)s.y };
+                rs2_deproject_pixel_to_point(&points[index].x, &depth_intrinsics, pixel, depth_scale * depth[index]);
+            }
+        }
+    }
+
     float3 transform(const rs2_extrinsics *extrin, const float3 &point) { float3 p = {}; rs2_transform_point_to_point(&p.x, extrin, &point.x); return p; }
     float2 project(const rs2_intrinsics *intrin, const float3 & point) { float2 pixel = {}; rs2_project_point_to_pixel(&pixel.x, intrin, &point.x); return pixel; }
     float2 pixel_to_texcoord(const rs2_intrinsics *intrin, const float2 & pixel) { return{ pixel.x / (intrin->width), pixel.y / (intrin->height) }; }
@@ -244,9 +266,41 @@ namespace librealsense
         }
     }
 
+    void pointcloud::get_texture_map_in(rs2::points output, const pixel_regions::spans& spans, const rs2_intrinsics& depth_intrinsics,
+        const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, float2* pixels_ptr)
+    {
+        auto points = (const float3*)output.get_vertices();
+        auto tex_ptr = (float2*)output.get_texture_coordinates();
+        auto width = depth_intrinsics.width;
+        auto size = width * depth_intrinsics.height;
+        memset(tex_ptr, 0, size * sizeof(float2));
+        memset(pixels_ptr, 0, size * sizeof(float2));
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < int(spans.size()); i++)
+        {
+            auto& s = spans[i];
+            for (int index = s.y * width + s.begin; index < s.y * width + s.end; ++index)
+            {
+                if (points[index].z)
+                {
+                    auto trans = transform(&extr, points[index]);
+                    pixels_ptr[index] = project(&other_intrinsics, trans);
+                    tex_ptr[index] = pixel_to_texcoord(&other_intrinsics, pixels_ptr[index]);
+                }
+            }
+        }
+    }
+
     rs2::points pointcloud::allocate_points(const rs2::frame_source& source, const rs2::frame& depth)
     {
-        return source.allocate_points(_output_stream, depth);
+        if (!_colors)
+            return source.allocate_points(_output_stream, depth);
+
+        auto profile = std::dynamic_pointer_cast<stream_profile_interface>(_output_stream.get()->profile->shared_from_this());
+        rs2::frame res{ (rs2_frame*)_source_wrapper.allocate_points(profile, (frame_interface*)depth.get(),
+            RS2_EXTENSION_POINTS, -1, true) };
+        return res.as<rs2::points>();
     }
 
     rs2::frame pointcloud::process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth)
@@ -254,42 +308,125 @@ namespace librealsense
         auto res = allocate_points(source, depth);
         auto pframe = (librealsense::points*)(res.get());
 
-        const float3* points = depth_to_points(res, *_depth_intrinsics, depth, *_depth_units);
+        // The regions skip the pixels outside them on the generic implementation
+        auto spans = supports_regions() ? _regions.get(_depth_intrinsics->width, _depth_intrinsics->height) : nullptr;
+        const float3* points = nullptr;
+        if (spans)
+        {
+            depth_to_points_in(res, *spans, *_depth_intrinsics, depth, *_depth_units);
+            points = (const float3*)res.get_vertices();
+        }
+        else
+            points = depth_to_points(res, *_depth_intrinsics, depth, *_depth_units);
+
+        if (!_extrinsics || !_other_intrinsics)
+        {
+            sample_colors(pframe, rs2::frame());
+            return res;
+        }
 
-        auto vid_frame = depth.as<rs2::video_frame>();
+        texture_mapping mapping = { *_depth_intrinsics, *_other_intrinsics, *_extrinsics, *_depth_units, spans, _texture };
+        if (!supports_deferred_mapping())
+        {
+            map_texture(pframe, points, depth, mapping);
+            return res;
+        }
+
+        // The frame holds the depth and the block until it is mapped or released
+        auto self = shared_from_this();
+        rs2::depth_frame depth_frame = depth;
+        pframe->defer_texture_mapping([self, pframe, points, depth_frame, mapping]()
+        {
+            std::lock_guard<std::mutex> lock(self->_mapping_mutex);
+            self->map_texture(pframe, points, depth_frame, mapping);
+        }, run__occlusion_filter(mapping.extrinsics));
+        return res;
+    }
+
+    void pointcloud::map_texture(librealsense::points* pframe, const float3* points, const rs2::depth_frame& depth, const texture_mapping& mapping)
+    {
+        // The block may have moved on to another calibration since the frame was computed
+        auto& depth_intrin = mapping.depth_intrinsics;
+        _pixels_map.resize(depth_intrin.width * depth_intrin.height);
+        _occlusion_filter->set_depth_intrinsics(depth_intrin);
+        _occlusion_filter->set_texel_intrinsics(mapping.other_intrinsics);
 
         // Pixels calculated in the mapped texture. Used in post-processing filters
         float2* pixels_ptr = _pixels_map.data();
-        rs2_intrinsics mapped_intr;
-        rs2_extrinsics extr;
-        bool map_texture = false;
+        pframe->acquire();
+        rs2::points output{ (rs2_frame*)pframe };
+        if (mapping.spans)
+            get_texture_map_in(output, *mapping.spans, depth_intrin, mapping.other_intrinsics, mapping.extrinsics, pixels_ptr);
+        else
+            get_texture_map(output, points, depth_intrin.width, depth_intrin.height,
+                mapping.other_intrinsics, mapping.extrinsics, pixels_ptr);
+
+        filter_occlusions(pframe, depth, mapping.extrinsics, mapping.depth_units);
+        sample_colors(pframe, mapping.texture);
+    }
+
+    void pointcloud::sample_colors(librealsense::points* pframe, const rs2::frame& texture)
+    {
+        auto colors = pframe->get_colors();
+        if (!colors)
+            return;
+
+        auto count = int(pframe->get_vertex_count());
+        auto video = texture.as<rs2::video_frame>();
+        // Offsets of the red, green and blue bytes in a texel of the formats sampled, the others leave the points black
+        int r = 0, g = 0, b = 0, bpp = 0;
+        if (video)
         {
-            if (_extrinsics && _other_intrinsics)
+            switch (video.get_profile().format())
             {
-                mapped_intr = *_other_intrinsics;
-                extr = *_extrinsics;
-                map_texture = true;
+            case RS2_FORMAT_RGB8: r = 0; g = 1; b = 2; bpp = 3; break;
+            case RS2_FORMAT_BGR8: r = 2; g = 1; b = 0; bpp = 3; break;
+            case RS2_FORMAT_RGBA8: r = 0; g = 1; b = 2; bpp = 4; break;
+            case RS2_FORMAT_BGRA8: r = 2; g = 1; b = 0; bpp = 4; break;
+            case RS2_FORMAT_Y8: bpp = 1; break;
+            default: break;
             }
         }
-
-        if (map_texture)
+        if (!bpp)
         {
-            auto height = vid_frame.get_height();
-            auto width = vid_frame.get_width();
+            memset(colors, 0, count * sizeof(uint32_t));
+            return;
+        }
 
-            get_texture_map(res, points, width, height, mapped_intr, extr, pixels_ptr);
+        // The nearest texel of the texture coordinates, which the occlusion removal left to the visible points
+        auto points = pframe->get_vertices();
+        auto uv = pframe->get_texture_coordinates();
+        auto width = video.get_width();
+        auto height = video.get_height();
+        auto stride = video.get_stride_in_bytes();
+        auto texels = (const uint8_t*)video.get_data();
 
-            if (run__occlusion_filter(extr))
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < count; i++)
+        {
+            uint32_t color = 0;
+            auto x = int(std::floor(uv[i].x * width + 0.5f));
+            auto y = int(std::floor(uv[i].y * height + 0.5f));
+            if (points[i].z && x >= 0 && y >= 0 && x < width && y < height)
             {
-                if (_occlusion_filter->find_scanning_direction(extr) == vertical)
-                {
-                    _occlusion_filter->set_scanning(static_cast<uint8_t>(vertical));
-                    _occlusion_filter->_depth_units = _depth_units.value();
-                }
-                _occlusion_filter->process(pframe->get_vertices(), pframe->get_texture_coordinates(), _pixels_map, depth);
+                auto texel = texels + y * stride + x * bpp;
+                color = (uint32_t(texel[r]) << 16) | (uint32_t(texel[g]) << 8) | uint32_t(texel[b]);
             }
+            colors[i] = color;
+        }
+    }
+
+    void pointcloud::filter_occlusions(librealsense::points* pframe, const rs2::depth_frame& depth, const rs2_extrinsics& extr, float depth_units)
+    {
+        if (run__occlusion_filter(extr))
+        {
+            if (_occlusion_filter->find_scanning_direction(extr) == vertical)
+            {
+                _occlusion_filter->set_scanning(static_cast<uint8_t>(vertical));
+                _occlusion_filter->_depth_units = depth_units;
+            }
+            _occlusion_filter->process(pframe->get_vertices(), pframe->get_texture_coordinates(), _pixels_map, depth);
         }
-        return res;
     }
 
     pointcloud::pointcloud()
@@ -319,6 +456,9 @@ namespace librealsense
         occlusion_invalidation->set_description(1.f, "Off");
         occlusion_invalidation->set_description(2.f, "On");
         register_option(RS2_OPTION_FILTER_MAGNITUDE, occlusion_invalidation);
+
+        register_option(RS2_OPTION_POINTS_COLORS, std::make_shared<ptr_option<bool>>(false, true, true, false, &_colors,
+            "Sample the color of every point from the texture, to pack the points as XYZRGB"));
     }
 
     bool pointcloud::should_process(const rs2::frame& frame)
@@ -364,11 +504,14 @@ namespace librealsense
 
     rs2::frame pointcloud::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
+        std::lock_guard<std::mutex> lock(_mapping_mutex);
+
         rs2::frame rv;
         if (auto composite = f.as<rs2::frameset>())
         {
             auto texture = composite.first(_stream_filter.stream);
             inspect_other_frame(texture);
+            _texture = _colors ? texture : rs2::frame();
 
             auto depth = composite.first(RS2_STREAM_DEPTH, RS2_FORMAT_Z16);
             inspect_depth_frame(depth);
@@ -384,6 +527,7 @@ namespace librealsense
             if (f.get_profile().stream_type() == _stream_filter.stream && f.get_profile().format() == _stream_filter.format)
             {
                 inspect_other_frame(f);
+                _texture = _colors ? f : rs2::frame();
             }
         }
         return rv;
@@ -396,6 +540,8 @@ namespace librealsense
         #else
         #ifdef __SSSE3__
             return std::make_shared<librealsense::pointcloud_sse>();
+        #elif defined(__ARM_NEON) && defined(__aarch64__)
+            return std::make_shared<librealsense::pointcloud_neon>();
         #else
             return std::make_shared<librealsense::pointcloud>();
         #endif
@@ -3,12 +3,13 @@
 
 #pragma once
 #include "synthetic-stream.h"
+#include "pixel-regions.h"
 
 namespace librealsense
 {
     class occlusion_filter;
 
-    class LRS_EXTENSION_API pointcloud : public stream_filter_processing_block
+    class LRS_EXTENSION_API pointcloud : public stream_filter_processing_block, public std::enable_shared_from_this<pointcloud>
     {
     public:
         static std::shared_ptr<pointcloud> create();
@@ -32,6 +33,9 @@ namespace librealsense
         virtual void preprocess() {}
         virtual bool run__occlusion_filter(const rs2_extrinsics& extr);
 
+        // Regions of the depth image the points are computed for, the other points are zero
+        pixel_regions& get_regions() { return _regions; }
+
     protected:
         pointcloud(const char* name);
 
@@ -45,17 +49,52 @@ namespace librealsense
         std::shared_ptr<occlusion_filter>      _occlusion_filter;
 
         // Intermediate translation table of (depth_x*depth_y) with actual texel coordinates per depth pixel
-        std::vector<float2>                    _pixels_map;
+        cache_vector<float2>                   _pixels_map;
 
         rs2::stream_profile _output_stream;
         rs2::frame _other_stream;
         rs2::frame _depth_stream;
+        // The latest texture frame, kept while the colors of the points are sampled
+        rs2::frame _texture;
+        bool _colors = false;
 
         void inspect_depth_frame(const rs2::frame& depth);
         void inspect_other_frame(const rs2::frame& other);
         rs2::frame process_depth_frame(const rs2::frame_source& source, const rs2::depth_frame& depth);
+        // Removes the texture of the points occluded from the other stream, pixels_map holding their pixels on it
+        void filter_occlusions(librealsense::points* pframe, const rs2::depth_frame& depth, const rs2_extrinsics& extr, float depth_units);
         void set_extrinsics();
 
+        // The calibration a frame is textured with, kept with the frame when its texture mapping is deferred
+        struct texture_mapping
+        {
+            rs2_intrinsics depth_intrinsics;
+            rs2_intrinsics other_intrinsics;
+            rs2_extrinsics extrinsics;
+            float depth_units;
+            std::shared_ptr<const pixel_regions::spans> spans;
+            rs2::frame texture;
+        };
+        // Computes the texture coordinates of the points then removes the occluded ones, _mapping_mutex must be held
+        void map_texture(librealsense::points* pframe, const float3* points, const rs2::depth_frame& depth, const texture_mapping& mapping);
+        // Writes the texel of every point to the colors of the frame, if it has them
+        void sample_colors(librealsense::points* pframe, const rs2::frame& texture);
+
+        // The GPU implementations process the whole image
+        virtual bool supports_regions() const { return true; }
+        // The GPU implementations map the texture in their own context, as the frame is computed
+        virtual bool supports_deferred_mapping() const { return true; }
+        void depth_to_points_in(rs2::points output, const pixel_regions::spans& spans,
+            const rs2_intrinsics& depth_intrinsics, const rs2::depth_frame& depth_frame, float depth_scale);
+        void get_texture_map_in(rs2::points output, const pixel_regions::spans& spans, const rs2_intrinsics& depth_intrinsics,
+            const rs2_intrinsics& other_intrinsics, const rs2_extrinsics& extr, float2* pixels_ptr);
+
+        pixel_regions _regions;
+
+        // Held while processing and while mapping a texture: the deferred mappings run on the threads accessing the frames
+        // and share the occlusion filter and the pixels map with the block
+        std::mutex _mapping_mutex;
+
         stream_filter _prev_stream_filter;
         std::shared_ptr< pointcloud > _registered_auto_calib_cb;
     };
@@ -4,6 +4,7 @@
 #include "processing-blocks-factory.h"
 
 #include "sse/sse-align.h"
+#include "neon/neon-align.h"
 #include "cuda/cuda-align.h"
 
 #include "stream.h"
@@ -11,33 +12,65 @@
 namespace librealsense
 {
 #ifdef RS2_USE_CUDA
-    std::shared_ptr<librealsense::align> create_align(rs2_stream align_to)
+    std::shared_ptr<librealsense::align> create_align(std::vector<rs2_stream> align_to)
     {
         return std::make_shared<librealsense::align_cuda>(align_to);
     }
 #else
 #ifdef __SSSE3__
-    std::shared_ptr<librealsense::align> create_align(rs2_stream align_to)
+    std::shared_ptr<librealsense::align> create_align(std::vector<rs2_stream> align_to)
     {
         return std::make_shared<librealsense::align_sse>(align_to);
     }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    std::shared_ptr<librealsense::align> create_align(std::vector<rs2_stream> align_to)
+    {
+        return std::make_shared<librealsense::align_neon>(align_to);
+    }
 #else // No optimizations
-    std::shared_ptr<librealsense::align> create_align(rs2_stream align_to)
+    std::shared_ptr<librealsense::align> create_align(std::vector<rs2_stream> align_to)
     {
         return std::make_shared<librealsense::align>(align_to);
     }
-#endif // __SSSE3__
+#endif // __SSSE3__, __ARM_NEON
 #endif // RS2_USE_CUDA
 
     processing_block_factory::processing_block_factory(const std::vector<stream_profile>& from, const std::vector<stream_profile>& to, std::function<std::shared_ptr<processing_block>(void)> generate_func) :
         _source_info(from), _target_info(to), generate_processing_block(generate_func)
     {}
 
+    processing_block_factory::processing_block_factory(const std::vector<stream_profile>& from, const std::vector<stream_profile>& to, std::function<std::shared_ptr<processing_block>(const std::vector<rs2_format>&)> generate_func) :
+        _source_info(from), _target_info(to), generate_multi_output_block(generate_func)
+    {}
+
     std::shared_ptr<processing_block> processing_block_factory::generate()
     {
+        if (generate_multi_output_block)
+        {
+            std::vector<rs2_format> formats;
+            for (auto&& t : _target_info)
+                formats.push_back(t.format);
+            return generate_multi_output_block(formats);
+        }
         return generate_processing_block();
     }
 
+    std::shared_ptr<processing_block> processing_block_factory::generate(const stream_profiles& requests)
+    {
+        if (!generate_multi_output_block)
+            return generate_processing_block();
+
+        // Only the requested formats are produced
+        std::vector<rs2_format> formats;
+        for (auto&& req : requests)
+        {
+            auto format = req->get_format();
+            if (std::find(formats.begin(), formats.end(), format) == formats.end())
+                formats.push_back(format);
+        }
+        return generate_multi_output_block(formats);
+    }
+
     processing_block_factory processing_block_factory::create_id_pbf(rs2_format format, rs2_stream stream, int idx)
     {
         processing_block_factory id_pbf = {
@@ -12,7 +12,7 @@
 
 namespace librealsense
 {
-    std::shared_ptr<librealsense::align> create_align(rs2_stream align_to);
+    std::shared_ptr<librealsense::align> create_align(std::vector<rs2_stream> align_to);
 
     class processing_block_factory
     {
@@ -23,11 +23,18 @@ namespace librealsense
             const std::vector<stream_profile>& to,
             std::function<std::shared_ptr<processing_block>(void)> generate_func);
 
+        // Factory of a block producing several of its targets from one pass over the source,
+        // the block is generated for the formats of the requests it was picked for
+        processing_block_factory(const std::vector<stream_profile>& from,
+            const std::vector<stream_profile>& to,
+            std::function<std::shared_ptr<processing_block>(const std::vector<rs2_format>&)> generate_func);
+
         bool operator==(const processing_block_factory& rhs) const;
 
         std::vector<stream_profile> get_source_info() const { return _source_info; }
         std::vector<stream_profile> get_target_info() const { return _target_info; }
         std::shared_ptr<processing_block> generate();
+        std::shared_ptr<processing_block> generate(const stream_profiles& requests);
         
         static processing_block_factory create_id_pbf(rs2_format format, rs2_stream stream, int idx = 0);
         template<typename T, typename Fn>
@@ -58,6 +65,20 @@ namespace librealsense
                 } );
         }
 
+        // A single block unpacking src into any of the dst formats at once, for requests of several formats of the same stream
+        template<typename T>
+        static processing_block_factory create_multi_output_pbf(rs2_format src, const std::vector<rs2_format>& dst, rs2_stream stream)
+        {
+            std::vector<stream_profile> targets;
+            for (auto d : dst)
+            {
+                // the raw format is passed through by the identity block
+                if (d != src)
+                    targets.push_back({ d, stream });
+            }
+            return { { {src} }, targets, [](const std::vector<rs2_format>& formats) { return std::make_shared<T>(formats); } };
+        }
+
         stream_profiles find_satisfied_requests(const stream_profiles& sp, const stream_profiles& supported_profiles) const;
         bool has_source(const std::shared_ptr<stream_profile_interface>& source) const;
 
@@ -65,5 +86,6 @@ namespace librealsense
         std::vector<stream_profile> _source_info;
         std::vector<stream_profile> _target_info;
         std::function<std::shared_ptr<processing_block>(void)> generate_processing_block;
+        std::function<std::shared_ptr<processing_block>(const std::vector<rs2_format>&)> generate_multi_output_block;
     };
 }
@@ -0,0 +1,245 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/rsutil.h"
+#include "proc/projection.h"
+#include "proc/deprojection-cache.h"
+
+#include <vector>
+
+#ifdef __SSSE3__
+
+#include <tmmintrin.h> // For SSSE3 intrinsics
+
+#endif
+
+namespace librealsense
+{
+#ifdef __SSSE3__
+    // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) to (x0 x1 x2 x3) (y0 y1 y2 y3) (z0 z1 z2 z3)
+    static inline void load_points(const float* points, __m128& x, __m128& y, __m128& z)
+    {
+        auto a = _mm_loadu_ps(points);
+        auto b = _mm_loadu_ps(points + 4);
+        auto c = _mm_loadu_ps(points + 8);
+
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    }
+
+    static inline void store_points(float* points, const __m128& x, const __m128& y, const __m128& z)
+    {
+        auto xy_lo = _mm_unpacklo_ps(x, y);
+        auto xy_hi = _mm_unpackhi_ps(x, y);
+
+        _mm_storeu_ps(points, _mm_shuffle_ps(xy_lo, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+        _mm_storeu_ps(points + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy_hi, _MM_SHUFFLE(1, 0, 2, 0)));
+        _mm_storeu_ps(points + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, xy_hi, _MM_SHUFFLE(3, 2, 2, 2)), _mm_shuffle_ps(xy_hi, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    // (x0 y0 x1 y1) (x2 y2 x3 y3) to (x0 x1 x2 x3) (y0 y1 y2 y3)
+    static inline void load_pixels(const float* pixels, __m128& x, __m128& y)
+    {
+        auto a = _mm_loadu_ps(pixels);
+        auto b = _mm_loadu_ps(pixels + 4);
+        x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    static inline void store_pixels(float* pixels, const __m128& x, const __m128& y)
+    {
+        _mm_storeu_ps(pixels, _mm_unpacklo_ps(x, y));
+        _mm_storeu_ps(pixels + 4, _mm_unpackhi_ps(x, y));
+    }
+
+    // The radial factor is applied to xr, yr and the tangential terms are computed from x, y,
+    // which are the same for the Brown-Conrady models and the scaled coordinates for the modified one
+    static inline void distort(const __m128& x, const __m128& y, bool tangential_of_scaled, const float coeffs[5], __m128& dx, __m128& dy)
+    {
+        auto one = _mm_set_ps1(1);
+        auto two = _mm_set_ps1(2);
+        auto k1 = _mm_set_ps1(coeffs[0]);
+        auto k2 = _mm_set_ps1(coeffs[1]);
+        auto p1 = _mm_set_ps1(coeffs[2]);
+        auto p2 = _mm_set_ps1(coeffs[3]);
+        auto k3 = _mm_set_ps1(coeffs[4]);
+
+        auto r2 = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+        auto r4 = _mm_mul_ps(r2, r2);
+        auto f = _mm_add_ps(one, _mm_add_ps(_mm_mul_ps(k1, r2), _mm_add_ps(_mm_mul_ps(k2, r4), _mm_mul_ps(k3, _mm_mul_ps(r4, r2)))));
+
+        auto xf = _mm_mul_ps(x, f);
+        auto yf = _mm_mul_ps(y, f);
+        auto tx = tangential_of_scaled ? xf : x;
+        auto ty = tangential_of_scaled ? yf : y;
+
+        auto txy = _mm_mul_ps(two, _mm_mul_ps(tx, ty));
+        dx = _mm_add_ps(xf, _mm_add_ps(_mm_mul_ps(p1, txy), _mm_mul_ps(p2, _mm_add_ps(r2, _mm_mul_ps(two, _mm_mul_ps(tx, tx))))));
+        dy = _mm_add_ps(yf, _mm_add_ps(_mm_mul_ps(p2, txy), _mm_mul_ps(p1, _mm_add_ps(r2, _mm_mul_ps(two, _mm_mul_ps(ty, ty))))));
+    }
+
+    // Returns the number of pixels deprojected, the caller deprojects the remaining pixels
+    static int deproject_pixels_to_points_sse(float* points, const rs2_intrinsics& intrin, const float* pixels, const float* depths, int count)
+    {
+        if (intrin.model == RS2_DISTORTION_FTHETA || intrin.model == RS2_DISTORTION_KANNALA_BRANDT4
+            || intrin.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
+            return 0;
+
+        auto ppx = _mm_set_ps1(intrin.ppx);
+        auto ppy = _mm_set_ps1(intrin.ppy);
+        auto fx = _mm_set_ps1(intrin.fx);
+        auto fy = _mm_set_ps1(intrin.fy);
+        auto inverse = intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 px, py;
+            load_pixels(pixels + i * 2, px, py);
+            auto x = _mm_div_ps(_mm_sub_ps(px, ppx), fx);
+            auto y = _mm_div_ps(_mm_sub_ps(py, ppy), fy);
+            if (inverse)
+                distort(x, y, false, intrin.coeffs, x, y);
+
+            auto depth = _mm_loadu_ps(depths + i);
+            store_points(points + i * 3, _mm_mul_ps(depth, x), _mm_mul_ps(depth, y), depth);
+        }
+        return i;
+    }
+
+    // Returns the number of points projected, the caller projects the remaining points
+    static int project_points_to_pixels_sse(float* pixels, const rs2_intrinsics& intrin, const float* points, int count)
+    {
+        if (intrin.model == RS2_DISTORTION_FTHETA || intrin.model == RS2_DISTORTION_KANNALA_BRANDT4)
+            return 0;
+
+        auto ppx = _mm_set_ps1(intrin.ppx);
+        auto ppy = _mm_set_ps1(intrin.ppy);
+        auto fx = _mm_set_ps1(intrin.fx);
+        auto fy = _mm_set_ps1(intrin.fy);
+        auto modified = intrin.model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY || intrin.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+        auto brown = intrin.model == RS2_DISTORTION_BROWN_CONRADY;
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 px, py, pz;
+            load_points(points + i * 3, px, py, pz);
+            auto x = _mm_div_ps(px, pz);
+            auto y = _mm_div_ps(py, pz);
+            if (modified || brown)
+                distort(x, y, modified, intrin.coeffs, x, y);
+
+            store_pixels(pixels + i * 2, _mm_add_ps(_mm_mul_ps(x, fx), ppx), _mm_add_ps(_mm_mul_ps(y, fy), ppy));
+        }
+        return i;
+    }
+#endif
+
+    void deproject_pixels_to_points(float* points, const rs2_intrinsics& intrin, const float* pixels, const float* depths, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        i = deproject_pixels_to_points_sse(points, intrin, pixels, depths, count);
+#endif
+        for (; i < count; ++i)
+            rs2_deproject_pixel_to_point(points + i * 3, &intrin, pixels + i * 2, depths[i]);
+    }
+
+    void project_points_to_pixels(float* pixels, const rs2_intrinsics& intrin, const float* points, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        i = project_points_to_pixels_sse(pixels, intrin, points, count);
+#endif
+        for (; i < count; ++i)
+            rs2_project_point_to_pixel(pixels + i * 2, &intrin, points + i * 3);
+    }
+
+    void project_color_pixels_to_depth_pixels(float* to_pixels,
+        const uint16_t* data, float depth_scale,
+        float depth_min, float depth_max,
+        const rs2_intrinsics& depth_intrin,
+        const rs2_intrinsics& color_intrin,
+        const rs2_extrinsics& color_to_depth,
+        const rs2_extrinsics& depth_to_color,
+        const float* from_pixels, int count)
+    {
+        // The table holds the undistorted rays of the models rs2_deproject_pixel_to_point inverts in closed form
+        std::shared_ptr<const deprojection_table> table;
+        if (depth_intrin.model != RS2_DISTORTION_FTHETA && depth_intrin.model != RS2_DISTORTION_KANNALA_BRANDT4)
+            table = deprojection_cache::get_instance().get(depth_intrin);
+
+        std::vector<float> candidates, points, projected;
+        for (int i = 0; i < count; ++i)
+        {
+            auto from_pixel = from_pixels + i * 2;
+            auto to_pixel = to_pixels + i * 2;
+            to_pixel[0] = to_pixel[1] = -1;
+
+            // The deprojection is linear in the depth, both ends of the line come from the ray at depth 1
+            float ray[3], min_point[3], max_point[3], transformed_point[3];
+            rs2_deproject_pixel_to_point(ray, &color_intrin, from_pixel, 1.f);
+            for (int j = 0; j < 3; ++j)
+            {
+                min_point[j] = ray[j] * depth_min;
+                max_point[j] = ray[j] * depth_max;
+            }
+
+            float start_pixel[2], end_pixel[2];
+            rs2_transform_point_to_point(transformed_point, &color_to_depth, min_point);
+            rs2_project_point_to_pixel(start_pixel, &depth_intrin, transformed_point);
+            adjust_2D_point_to_boundary(start_pixel, depth_intrin.width, depth_intrin.height);
+            rs2_transform_point_to_point(transformed_point, &color_to_depth, max_point);
+            rs2_project_point_to_pixel(end_pixel, &depth_intrin, transformed_point);
+            adjust_2D_point_to_boundary(end_pixel, depth_intrin.width, depth_intrin.height);
+
+            // The valid depth pixels of the line, as color points
+            candidates.clear();
+            points.clear();
+            for (float p[2] = { start_pixel[0], start_pixel[1] }; is_pixel_in_line(p, start_pixel, end_pixel); next_pixel_in_line(p, start_pixel, end_pixel))
+            {
+                int x = (int)p[0], y = (int)p[1];
+                if (x < 0 || y < 0 || x >= depth_intrin.width || y >= depth_intrin.height)
+                    continue;
+                auto index = y * depth_intrin.width + x;
+                float depth = depth_scale * data[index];
+                if (depth == 0)
+                    continue;
+
+                float point[3];
+                if (table)
+                {
+                    point[0] = depth * table->x[index];
+                    point[1] = depth * table->y[index];
+                    point[2] = depth;
+                }
+                else
+                    rs2_deproject_pixel_to_point(point, &depth_intrin, p, depth);
+
+                rs2_transform_point_to_point(transformed_point, &depth_to_color, point);
+                points.insert(points.end(), transformed_point, transformed_point + 3);
+                candidates.insert(candidates.end(), p, p + 2);
+            }
+
+            int size = static_cast<int>(candidates.size() / 2);
+            projected.resize(candidates.size());
+            project_points_to_pixels(projected.data(), color_intrin, points.data(), size);
+
+            float min_dist = -1;
+            for (int j = 0; j < size; ++j)
+            {
+                auto dx = projected[j * 2] - from_pixel[0];
+                auto dy = projected[j * 2 + 1] - from_pixel[1];
+                auto dist = dx * dx + dy * dy;
+                if (dist < min_dist || min_dist < 0)
+                {
+                    min_dist = dist;
+                    to_pixel[0] = candidates[j * 2];
+                    to_pixel[1] = candidates[j * 2 + 1];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,34 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+#include "../include/librealsense2/h/rs_sensor.h"
+
+#include <stdint.h>
+
+// Batch versions of the rsutil.h projections, for callers mapping many pixels per frame.
+// The pixels are (x, y) pairs and the points (x, y, z) triplets, packed in arrays of count elements.
+// The distortion models the SSE kernels support are computed 4 elements at a time, the others and the remainder
+// go through the rsutil.h functions, so the results match them.
+namespace librealsense
+{
+    // Same as rs2_deproject_pixel_to_point on each of the pixels and depths
+    void deproject_pixels_to_points(float* points, const rs2_intrinsics& intrin, const float* pixels, const float* depths, int count);
+
+    // Same as rs2_project_point_to_pixel on each of the points
+    void project_points_to_pixels(float* pixels, const rs2_intrinsics& intrin, const float* points, int count);
+
+    // Same as rs2_project_color_pixel_to_depth_pixel on each of the color pixels. The depth pixels along the search lines are
+    // deprojected from the cached table of the depth intrinsics and the candidates of a line projected at once.
+    // A pixel with no valid depth along its line is mapped to (-1, -1)
+    void project_color_pixels_to_depth_pixels(float* to_pixels,
+        const uint16_t* data, float depth_scale,
+        float depth_min, float depth_max,
+        const rs2_intrinsics& depth_intrin,
+        const rs2_intrinsics& color_intrin,
+        const rs2_extrinsics& color_to_depth,
+        const rs2_extrinsics& depth_to_color,
+        const float* from_pixels, int count);
+}
@@ -9,80 +9,184 @@
 #include "image.h"
 #include "stream.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
     //// Unpacking routines ////
-    template<size_t SIZE>
-    void rotate_image_optimized(byte * const dest[], const byte * source, int width, int height, int actual_size)
+
+    // The rotation moves the pixel (x, y) of the source to the column (height - 1 - y) of the row (width - 1 - x) of the target.
+    // The image is rotated in tiles of 8x8 pixels, with the pixels of the partial tiles at the edges moved one by one
+    template<class Tile, class Pixel>
+    static void rotate_tiles(int width, int height, const Tile& tile, const Pixel& pixel)
     {
-        auto width_out = height;
-        auto height_out = width;
+        const int tiles_width = width / 8 * 8;
+        const int tiles_height = height / 8 * 8;
 
-        auto out = dest[0];
-        byte buffer[8][8 * SIZE]; // = { 0 };
-        for (int i = 0; i <= height - 8; i = i + 8)
+#pragma omp parallel for schedule(static)
+        for (int y = 0; y < tiles_height; y += 8)
         {
-            for (int j = 0; j <= width - 8; j = j + 8)
-            {
-                for (int ii = 0; ii < 8; ++ii)
-                {
-                    for (int jj = 0; jj < 8; ++jj)
-                    {
-                        auto source_index = ((j + jj) + (width * (i + ii))) * SIZE;
-                        memcpy((void*)(&buffer[7 - jj][(7 - ii) * SIZE]), &source[source_index], SIZE);
-                    }
-                }
+            for (int x = 0; x < tiles_width; x += 8)
+                tile(x, y);
+            for (int yy = y; yy < y + 8; ++yy)
+                for (int x = tiles_width; x < width; ++x)
+                    pixel(x, yy);
+        }
 
-                for (int ii = 0; ii < 8; ++ii)
-                {
-                    auto out_index = (((height_out - 8 - j + 1) * width_out) - i - 8 + (ii)* width_out);
-                    memcpy(&out[(out_index)* SIZE], &(buffer[ii]), 8 * SIZE);
-                }
-            }
+        for (int y = tiles_height; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                pixel(x, y);
+    }
+
+#ifdef __SSSE3__
+    // Transposes 8 rows of 8 bytes held in the low halves of a, each result holds two columns of the tile
+    static inline void transpose_8x8_epi8(const __m128i (&a)[8], __m128i (&columns)[4])
+    {
+        __m128i t0 = _mm_unpacklo_epi8(a[0], a[1]);
+        __m128i t1 = _mm_unpacklo_epi8(a[2], a[3]);
+        __m128i t2 = _mm_unpacklo_epi8(a[4], a[5]);
+        __m128i t3 = _mm_unpacklo_epi8(a[6], a[7]);
+        __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+        __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+        __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+        __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+        columns[0] = _mm_unpacklo_epi32(u0, u2);
+        columns[1] = _mm_unpackhi_epi32(u0, u2);
+        columns[2] = _mm_unpacklo_epi32(u1, u3);
+        columns[3] = _mm_unpackhi_epi32(u1, u3);
+    }
+
+    // Loads the tile at (x, y) from its last row up, so the columns come out mirrored as the rotation requires
+    static inline void load_rotated_8x8_epi8(const byte* source, int width, int x, int y, __m128i (&columns)[4])
+    {
+        __m128i a[8];
+        for (int k = 0; k < 8; ++k)
+            a[k] = _mm_loadl_epi64((const __m128i*)(source + (y + 7 - k) * width + x));
+        transpose_8x8_epi8(a, columns);
+    }
+
+    static inline void rotate_tile_epi8(byte* out, const byte* source, int width, int height, int x, int y)
+    {
+        __m128i columns[4];
+        load_rotated_8x8_epi8(source, width, x, y, columns);
+        auto dst = out + (width - 1 - x) * height + height - 8 - y;
+        for (int k = 0; k < 4; ++k)
+        {
+            _mm_storel_epi64((__m128i*)(dst - (2 * k) * height), columns[k]);
+            _mm_storel_epi64((__m128i*)(dst - (2 * k + 1) * height), _mm_unpackhi_epi64(columns[k], columns[k]));
         }
     }
 
+    static inline void rotate_tile_epi16(byte* out, const byte* source, int width, int height, int x, int y)
+    {
+        auto src = reinterpret_cast<const uint16_t*>(source);
+        __m128i a[8];
+        for (int k = 0; k < 8; ++k)
+            a[k] = _mm_loadu_si128((const __m128i*)(src + (y + 7 - k) * width + x));
+
+        __m128i t0 = _mm_unpacklo_epi16(a[0], a[1]);
+        __m128i t1 = _mm_unpackhi_epi16(a[0], a[1]);
+        __m128i t2 = _mm_unpacklo_epi16(a[2], a[3]);
+        __m128i t3 = _mm_unpackhi_epi16(a[2], a[3]);
+        __m128i t4 = _mm_unpacklo_epi16(a[4], a[5]);
+        __m128i t5 = _mm_unpackhi_epi16(a[4], a[5]);
+        __m128i t6 = _mm_unpacklo_epi16(a[6], a[7]);
+        __m128i t7 = _mm_unpackhi_epi16(a[6], a[7]);
+        __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+        __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+        __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+        __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+        __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+        __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+        __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+        __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+        __m128i columns[8] = {
+            _mm_unpacklo_epi64(u0, u4), _mm_unpackhi_epi64(u0, u4),
+            _mm_unpacklo_epi64(u1, u5), _mm_unpackhi_epi64(u1, u5),
+            _mm_unpacklo_epi64(u2, u6), _mm_unpackhi_epi64(u2, u6),
+            _mm_unpacklo_epi64(u3, u7), _mm_unpackhi_epi64(u3, u7) };
+
+        auto dst = reinterpret_cast<uint16_t*>(out) + (width - 1 - x) * height + height - 8 - y;
+        for (int k = 0; k < 8; ++k)
+            _mm_storeu_si128((__m128i*)(dst - k * height), columns[k]);
+    }
+#endif
+
     template<size_t SIZE>
-    void rotate_image(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    static inline void rotate_pixel(byte* out, const byte* source, int width, int height, int x, int y)
     {
-        auto width_out = height;
-        auto height_out = width;
+        memcpy(&out[((width - 1 - x) * height + height - 1 - y) * SIZE], &source[(y * width + x) * SIZE], SIZE);
+    }
 
+    template<size_t SIZE>
+    static inline void rotate_tile(byte* out, const byte* source, int width, int height, int x, int y)
+    {
+#ifdef __SSSE3__
+        if (SIZE == 1)
+            return rotate_tile_epi8(out, source, width, height, x, y);
+        if (SIZE == 2)
+            return rotate_tile_epi16(out, source, width, height, x, y);
+#endif
+        // the rows of the rotated tile are gathered, then written whole
+        byte buffer[8][8 * SIZE];
+        for (int ii = 0; ii < 8; ++ii)
+            for (int jj = 0; jj < 8; ++jj)
+                memcpy(&buffer[jj][(7 - ii) * SIZE], &source[((y + ii) * width + x + jj) * SIZE], SIZE);
+        for (int k = 0; k < 8; ++k)
+            memcpy(&out[((width - 1 - x - k) * height + height - 8 - y) * SIZE], buffer[k], 8 * SIZE);
+    }
+
+    template<size_t SIZE>
+    void rotate_image_optimized(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    {
         auto out = dest[0];
-        for (int i = 0; i < height; ++i)
-        {
-            auto row_offset = i * width;
-            for (int j = 0; j < width; ++j)
-            {
-                auto out_index = (((height_out - j) * width_out) - i - 1) * SIZE;
-                librealsense::copy((void*)(&out[out_index]), &(source[(row_offset + j) * SIZE]), SIZE);
-            }
-        }
+        rotate_tiles(width, height,
+            [=](int x, int y) { rotate_tile<SIZE>(out, source, width, height, x, y); },
+            [=](int x, int y) { rotate_pixel<SIZE>(out, source, width, height, x, y); });
     }
 
-    void rotate_confidence(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    // Each byte of the source holds two pixels of 4 bits, that are rotated to two consecutive rows of the 8 bits target.
+    // The width is given in bytes, the target has twice the rows of the rotated bytes
+    static inline void rotate_confidence_pixel(byte* out, const byte* source, int width, int height, int x, int y)
     {
-#pragma pack (push, 1)
-        struct lsb_msb
-        {
-            unsigned lsb : 4;
-            unsigned msb : 4;
-        };
-#pragma pack(pop)
+        auto val = source[y * width + x];
+        auto out_index = 2 * (width - 1 - x) * height + height - 1 - y;
+        out[out_index] = byte(val << 4);
+        out[out_index + height] = byte(val & 0xf0);
+    }
 
-        rotate_image<1>(dest, source, width, height, actual_size);
+    void rotate_confidence(byte * const dest[], const byte * source, int width, int height, int actual_size)
+    {
         auto out = dest[0];
-        for (int i = (width - 1), out_i = ((width - 1) * 2); i >= 0; --i, out_i -= 2)
-        {
-            auto row_offset = i * height;
-            for (int j = 0; j < height; ++j)
+        rotate_tiles(width, height,
+            [=](int x, int y)
             {
-                auto val = *(reinterpret_cast<const lsb_msb*>(&out[(row_offset + j)]));
-                auto out_index = out_i * height + j;
-                out[out_index] = val.lsb << 4;
-                out[out_index + height] = val.msb << 4;
-            }
-        }
+#ifdef __SSSE3__
+                const __m128i high_nibble = _mm_set1_epi8(char(0xf0));
+                __m128i columns[4];
+                load_rotated_8x8_epi8(source, width, x, y, columns);
+                auto dst = out + 2 * (width - 1 - x) * height + height - 8 - y;
+                for (int k = 0; k < 4; ++k)
+                {
+                    // the low nibbles go to the first of the two rows of each column
+                    __m128i low = _mm_and_si128(_mm_slli_epi16(columns[k], 4), high_nibble);
+                    __m128i high = _mm_and_si128(columns[k], high_nibble);
+                    auto even = dst - (4 * k) * height;
+                    auto odd = dst - (4 * k + 2) * height;
+                    _mm_storel_epi64((__m128i*)even, low);
+                    _mm_storel_epi64((__m128i*)(even + height), high);
+                    _mm_storel_epi64((__m128i*)odd, _mm_unpackhi_epi64(low, low));
+                    _mm_storel_epi64((__m128i*)(odd + height), _mm_unpackhi_epi64(high, high));
+                }
+#else
+                for (int yy = y; yy < y + 8; ++yy)
+                    for (int xx = x; xx < x + 8; ++xx)
+                        rotate_confidence_pixel(out, source, width, height, xx, yy);
+#endif
+            },
+            [=](int x, int y) { rotate_confidence_pixel(out, source, width, height, x, y); });
     }
 
     //// Processing routines////
@@ -0,0 +1,78 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "sequence_id_demux.h"
+#include "context.h"
+
+namespace librealsense
+{
+    // Offset of the stream index of a virtual stream per sequence key, IR 1 of sequence id 1 is delivered as IR 11
+    const int sequence_index_step = 10;
+
+    sequence_id_demux::sequence_id_demux()
+        : generic_processing_block("Demux By Sequence id")
+    {
+    }
+
+    // processing only simple video frames (not framesets) of a sequence
+    bool sequence_id_demux::should_process(const rs2::frame& frame)
+    {
+        if (!frame || frame.is<rs2::frameset>() || !frame.is<rs2::video_frame>())
+            return false;
+        return get_sequence_key(frame) >= 0;
+    }
+
+    // The sequence id of an HDR sequence, otherwise 1 for the frames of emitter on and 0 for the frames of emitter off
+    int sequence_id_demux::get_sequence_key(const rs2::frame& f) const
+    {
+        if (f.supports_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE) && f.supports_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID) &&
+            f.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_SIZE) > 0)
+            return static_cast<int>(f.get_frame_metadata(RS2_FRAME_METADATA_SEQUENCE_ID));
+        if (f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE))
+            return f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_EMITTER_MODE) ? 1 : 0;
+        if (f.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_LASER_POWER_MODE))
+            return f.get_frame_metadata(RS2_FRAME_METADATA_FRAME_LASER_POWER_MODE) ? 1 : 0;
+        return -1;
+    }
+
+    std::shared_ptr<stream_profile_interface> sequence_id_demux::get_virtual_profile(const rs2::frame& f, int key)
+    {
+        auto source_profile = f.get_profile();
+        auto& profile = _virtual_profiles[std::make_pair(source_profile.unique_id(), key)];
+        if (!profile)
+            profile = source_profile.clone(source_profile.stream_type(), source_profile.stream_index() + key * sequence_index_step,
+                source_profile.format());
+        return std::dynamic_pointer_cast<stream_profile_interface>(profile.get()->profile->shared_from_this());
+    }
+
+    rs2::frame sequence_id_demux::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto original = (frame_interface*)f.get();
+        auto of = dynamic_cast<video_frame*>(original);
+        if (!of)
+            return f;
+
+        rs2_extension type = RS2_EXTENSION_VIDEO_FRAME;
+        if (f.is<rs2::disparity_frame>())
+            type = RS2_EXTENSION_DISPARITY_FRAME;
+        else if (f.is<rs2::depth_frame>())
+            type = RS2_EXTENSION_DEPTH_FRAME;
+
+        frame_additional_data data = of->additional_data;
+        data.trace.derive();
+        auto res = _source.alloc_frame(type, 0, data, false);
+        if (!res)
+            throw wrong_api_call_sequence_exception("Out of frame resources!");
+
+        auto vf = dynamic_cast<video_frame*>(res);
+        vf->metadata_parsers = of->metadata_parsers;
+        vf->assign(of->get_width(), of->get_height(), of->get_stride(), of->get_bpp());
+        vf->set_sensor(original->get_sensor());
+        res->set_stream(get_virtual_profile(f, get_sequence_key(f)));
+
+        // The output refers to the data of the input frame, which it holds until it is released
+        rs2::frame input = f;
+        res->attach_continuation(frame_continuation([input]() {}, of->get_frame_data(), of->get_frame_data_size()));
+        return rs2::frame((rs2_frame*)res);
+    }
+}
@@ -0,0 +1,31 @@
+/* License: Apache 2.0. See LICENSE file in root directory.
+Copyright(c) 2020 Intel Corporation. All Rights Reserved. */
+
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "option.h"
+
+namespace librealsense
+{
+    // Splits a stream into virtual streams by the sequence id of the frames, or by the emitter state when the frames
+    // carry no sequence, so that the syncer matches the halves of an interleaved stream as streams of their own.
+    // The output frames refer to the data of the input frames instead of copying it
+    class sequence_id_demux : public generic_processing_block
+    {
+    public:
+        sequence_id_demux();
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        int get_sequence_key(const rs2::frame& f) const;
+        std::shared_ptr<stream_profile_interface> get_virtual_profile(const rs2::frame& f, int key);
+
+        // key is pair of unique id of the source stream and sequence key
+        std::map<std::pair<int, int>, rs2::stream_profile> _virtual_profiles;
+    };
+}
@@ -11,6 +11,10 @@
 #include "proc/hole-filling-filter.h"
 #include "proc/spatial-filter.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
     enum spatial_holes_filling_types : uint8_t
@@ -48,6 +52,156 @@ namespace librealsense
     const uint8_t holes_fill_step = 1;
     const uint8_t holes_fill_def = sp_hf_disabled;
 
+    // Width (in pixels) of the column bands the vertical depth pass is split into
+    const int vertical_band_width = 128;
+
+    enum spatial_filter_modes : uint8_t
+    {
+        sp_mode_domain_transform,
+        sp_mode_guided,
+        sp_mode_max_value
+    };
+
+    // The radius of the box windows of the guided mode
+    const uint8_t guided_radius_min = 1;
+    const uint8_t guided_radius_max = 32;
+    const uint8_t guided_radius_def = 4;
+    const uint8_t guided_radius_step = 1;
+
+    // Sums, in place, every plane over the boxes of (2 * radius + 1) pixels around each pixel, clipped at the image borders.
+    // The sums are separable: a running sum along the rows, then one along the columns of bands of columns
+    static void box_sums(float* planes, float* rows, int count, int width, int height, int radius)
+    {
+        const int size = width * height;
+
+#pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < count * height; ++i)
+        {
+            const float* in = planes + size_t(i) * width;
+            float* out = rows + size_t(i) * width;
+            double sum = 0;
+            for (int x = 0; x < std::min(radius, width); ++x)
+                sum += in[x];
+            for (int x = 0; x < width; ++x)
+            {
+                if (x + radius < width)
+                    sum += in[x + radius];
+                out[x] = float(sum);
+                if (x - radius >= 0)
+                    sum -= in[x - radius];
+            }
+        }
+
+        const int bands = (width + vertical_band_width - 1) / vertical_band_width;
+#pragma omp parallel
+        {
+            double sums[vertical_band_width];
+
+#pragma omp for schedule(dynamic)
+            for (int i = 0; i < count * bands; ++i)
+            {
+                const int first = (i % bands) * vertical_band_width;
+                const int n = std::min(vertical_band_width, width - first);
+                const float* in = rows + size_t(i / bands) * size + first;
+                float* out = planes + size_t(i / bands) * size + first;
+
+                // The column loops run over independent sums and are left to the compiler to vectorize
+                for (int u = 0; u < n; ++u)
+                    sums[u] = 0;
+                for (int y = 0; y < std::min(radius, height); ++y)
+                    for (int u = 0; u < n; ++u)
+                        sums[u] += in[y * width + u];
+                for (int y = 0; y < height; ++y)
+                {
+                    if (y + radius < height)
+                        for (int u = 0; u < n; ++u)
+                            sums[u] += in[(y + radius) * width + u];
+                    for (int u = 0; u < n; ++u)
+                        out[y * width + u] = float(sums[u]);
+                    if (y - radius >= 0)
+                        for (int u = 0; u < n; ++u)
+                            sums[u] -= in[(y - radius) * width + u];
+                }
+            }
+        }
+    }
+
+#ifdef __SSSE3__
+    // Helpers operating on eight Z16 pixels at a time
+    static inline __m128i select_z16(__m128i mask, __m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    static inline __m128i nonzero_z16(__m128i a)
+    {
+        return _mm_xor_si128(_mm_cmpeq_epi16(a, _mm_setzero_si128()), _mm_set1_epi16(-1));
+    }
+
+    static inline __m128i absdiff_z16(__m128i a, __m128i b)
+    {
+        return _mm_or_si128(_mm_subs_epu16(a, b), _mm_subs_epu16(b, a));
+    }
+
+    // a * wa + b * wb, rounded the same way as the scalar implementation
+    static inline __m128i weighted_z16(__m128i a, __m128i b, __m128 wa, __m128 wb)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128 round = _mm_set1_ps(0.5f);
+        __m128 lo = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(a, zero)), wa),
+                                          _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(b, zero)), wb)), round);
+        __m128 hi = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(a, zero)), wa),
+                                          _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(b, zero)), wb)), round);
+
+        // Unsigned saturation (packus_epi32) requires SSE4.1, so bias into the signed range instead
+        const __m128i bias = _mm_set1_epi32(0x8000);
+        __m128i packed = _mm_packs_epi32(_mm_sub_epi32(_mm_cvttps_epi32(lo), bias), _mm_sub_epi32(_mm_cvttps_epi32(hi), bias));
+        return _mm_xor_si128(packed, _mm_set1_epi16(-0x8000));
+    }
+
+    // In-place transposition of an 8x8 block of Z16 pixels
+    static inline void transpose_z16(__m128i* r)
+    {
+        __m128i b0 = _mm_unpacklo_epi16(r[0], r[1]), b1 = _mm_unpackhi_epi16(r[0], r[1]);
+        __m128i b2 = _mm_unpacklo_epi16(r[2], r[3]), b3 = _mm_unpackhi_epi16(r[2], r[3]);
+        __m128i b4 = _mm_unpacklo_epi16(r[4], r[5]), b5 = _mm_unpackhi_epi16(r[4], r[5]);
+        __m128i b6 = _mm_unpacklo_epi16(r[6], r[7]), b7 = _mm_unpackhi_epi16(r[6], r[7]);
+        __m128i c0 = _mm_unpacklo_epi32(b0, b2), c1 = _mm_unpackhi_epi32(b0, b2);
+        __m128i c2 = _mm_unpacklo_epi32(b1, b3), c3 = _mm_unpackhi_epi32(b1, b3);
+        __m128i c4 = _mm_unpacklo_epi32(b4, b6), c5 = _mm_unpackhi_epi32(b4, b6);
+        __m128i c6 = _mm_unpacklo_epi32(b5, b7), c7 = _mm_unpackhi_epi32(b5, b7);
+        r[0] = _mm_unpacklo_epi64(c0, c4); r[1] = _mm_unpackhi_epi64(c0, c4);
+        r[2] = _mm_unpacklo_epi64(c1, c5); r[3] = _mm_unpackhi_epi64(c1, c5);
+        r[4] = _mm_unpacklo_epi64(c2, c6); r[5] = _mm_unpackhi_epi64(c2, c6);
+        r[6] = _mm_unpacklo_epi64(c3, c7); r[7] = _mm_unpackhi_epi64(c3, c7);
+    }
+
+    // Moves eight image rows into a buffer holding each column as eight consecutive pixels, or back when 'to_rows' is set
+    static void transpose_rows_z16(uint16_t* rows, int width, uint16_t* columns, bool to_rows)
+    {
+        __m128i block[8];
+        int u = 0;
+        for (; u + 8 <= width; u += 8)
+        {
+            for (int r = 0; r < 8; r++)
+                block[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(to_rows ? columns + (u + r) * 8 : rows + r * width + u));
+            transpose_z16(block);
+            for (int r = 0; r < 8; r++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(to_rows ? rows + r * width + u : columns + (u + r) * 8), block[r]);
+        }
+        for (; u < width; u++)
+        {
+            for (int r = 0; r < 8; r++)
+            {
+                if (to_rows)
+                    rows[r * width + u] = columns[u * 8 + r];
+                else
+                    columns[u * 8 + r] = rows[r * width + u];
+            }
+        }
+    }
+#endif
+
     spatial_filter::spatial_filter() :
         depth_processing_block("Spatial Filter"),
         _spatial_alpha_param(alpha_default_val),
@@ -60,7 +214,10 @@ namespace librealsense
         _focal_lenght_mm(0.f),
         _stereo_baseline_mm(0.f),
         _holes_filling_mode(holes_fill_def),
-        _holes_filling_radius(0)
+        _holes_filling_radius(0),
+        _spatial_mode(sp_mode_domain_transform),
+        _guided_radius(guided_radius_def),
+        _ir_guided(0)
     {
         _stream_filter.stream = RS2_STREAM_DEPTH;
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -141,24 +298,92 @@ namespace librealsense
             }
         });
 
+        auto spatial_filter_mode = std::make_shared<ptr_option<uint8_t>>(
+            sp_mode_domain_transform,
+            sp_mode_max_value - 1,
+            1,
+            sp_mode_domain_transform,
+            &_spatial_mode, "Smoothing mode");
+        spatial_filter_mode->set_description(sp_mode_domain_transform, "Domain Transform");
+        spatial_filter_mode->set_description(sp_mode_guided, "Guided Filter");
+
+        auto guided_radius = std::make_shared<ptr_option<uint8_t>>(
+            guided_radius_min,
+            guided_radius_max,
+            guided_radius_step,
+            guided_radius_def,
+            &_guided_radius, "Radius of the guided filter windows");
+
+        auto ir_guided = std::make_shared<ptr_option<uint8_t>>(0, 1, 1, 0,
+            &_ir_guided, "Guide the guided filter by the infrared of the frameset");
+
         register_option(RS2_OPTION_FILTER_SMOOTH_ALPHA, spatial_filter_alpha);
         register_option(RS2_OPTION_FILTER_SMOOTH_DELTA, spatial_filter_delta);
         register_option(RS2_OPTION_FILTER_MAGNITUDE, spatial_filter_iterations);
         register_option(RS2_OPTION_HOLES_FILL, holes_filling_mode);
+        register_option(RS2_OPTION_SPATIAL_FILTER_MODE, spatial_filter_mode);
+        register_option(RS2_OPTION_SPATIAL_FILTER_RADIUS, guided_radius);
+        register_option(RS2_OPTION_SPATIAL_FILTER_IR_GUIDED, ir_guided);
+    }
+
+    // The infrared frame of a frameset that can guide its depth frame
+    static rs2::frame find_guide(const rs2::frameset& set, const rs2::frame& depth)
+    {
+        auto vf = depth.as<rs2::video_frame>();
+        rs2::frame guide;
+        set.foreach_rs([&guide, &vf](const rs2::frame& f) {
+            auto ir = f.as<rs2::video_frame>();
+            if (!guide && ir && ir.get_profile().stream_type() == RS2_STREAM_INFRARED && ir.get_profile().format() == RS2_FORMAT_Y8
+                && ir.get_width() == vf.get_width() && ir.get_height() == vf.get_height())
+                guide = ir;
+        });
+        return guide;
+    }
+
+    // The depth of a frameset that the filter would process alone
+    rs2::frame spatial_filter::find_depth(const rs2::frameset& set)
+    {
+        rs2::frame depth;
+        set.foreach_rs([this, &depth](const rs2::frame& f) {
+            if (!depth && depth_processing_block::should_process(f))
+                depth = f;
+        });
+        return depth;
+    }
+
+    bool spatial_filter::should_process(const rs2::frame& frame)
+    {
+        // In the infrared guided mode a frameset is processed at once, its depth guided by its infrared
+        if (auto set = frame.as<rs2::frameset>())
+        {
+            if (_spatial_mode != sp_mode_guided || !_ir_guided)
+                return false;
+            auto depth = find_depth(set);
+            return depth && find_guide(set, depth);
+        }
+        return depth_processing_block::should_process(frame);
     }
 
     rs2::frame spatial_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
     {
         rs2::frame tgt;
+        rs2::frame depth = f;
+        rs2::frame guide;
+        if (auto set = f.as<rs2::frameset>())
+        {
+            depth = find_depth(set);
+            guide = find_guide(set, depth);
+        }
 
-        update_configuration(f);
-        tgt = prepare_target_frame(f, source);
+        update_configuration(depth);
+        tgt = prepare_target_frame(depth, source);
 
-        // Spatial domain transform edge-preserving filter
+        // Spatial domain transform or guided edge-preserving filter, the guided filter guides the depth by itself without infrared
+        auto guide_data = guide ? reinterpret_cast<const uint8_t*>(guide.get_data()) : nullptr;
         if (_extension_type == RS2_EXTENSION_DISPARITY_FRAME)
-            dxf_smooth<float>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            smooth<float>(const_cast<void*>(tgt.get_data()), guide_data);
         else
-            dxf_smooth<uint16_t>(const_cast<void*>(tgt.get_data()), _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+            smooth<uint16_t>(const_cast<void*>(tgt.get_data()), guide_data);
 
         return tgt;
     }
@@ -170,14 +395,9 @@ namespace librealsense
             _source_stream_profile = f.get_profile();
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
             _focal_lenght_mm = vp.get_intrinsics().fx;
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width * _bpp;
-            _current_frm_size_pixels = _width * _height;
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
 
             // Check if the new frame originated from stereo-based depth sensor
             // retrieve the stereo baseline parameter
@@ -212,13 +432,28 @@ namespace librealsense
                     _stereo_baseline_mm = dss->get_stereo_baseline_mm();
             }
 
-            _spatial_edge_threshold = _spatial_delta_param;// (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ?
-                                                           // (_focal_lenght_mm * _stereo_baseline_mm) / float(_spatial_delta_param) : _spatial_delta_param;
         }
     }
 
+    void spatial_filter::configure(size_t width, size_t height, rs2_extension extension_type)
+    {
+        _extension_type = extension_type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width * _bpp;
+        _current_frm_size_pixels = _width * _height;
+
+        _spatial_edge_threshold = _spatial_delta_param;// (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ?
+                                                       // (_focal_lenght_mm * _stereo_baseline_mm) / float(_spatial_delta_param) : _spatial_delta_param;
+    }
+
     rs2::frame spatial_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
+        // The filter runs in place, on the input frame when no one else holds it
+        if (auto tgt = reuse_input_frame(f, _target_stream_profile))
+            return tgt;
+
         // Allocate and copy the content of the original Depth data to the target
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, int(_bpp), int(_width), int(_height), int(_stride), _extension_type);
 
@@ -226,13 +461,239 @@ namespace librealsense
         return tgt;
     }
 
+    void spatial_filter::guided_smooth(void * image_data, bool fp, const uint8_t* guide)
+    {
+        const int width = int(_width);
+        const int height = int(_height);
+        const int size = width * height;
+        const int radius = _guided_radius;
+        // The variations of the guide within the threshold are smoothed, in depth levels or in infrared levels when guided by infrared
+        const float eps = _spatial_edge_threshold * _spatial_edge_threshold;
+
+        auto depth = [image_data, fp](int i) {
+            return fp ? reinterpret_cast<const float*>(image_data)[i] : float(reinterpret_cast<const uint16_t*>(image_data)[i]);
+        };
+
+        // The statistics of the valid pixels: their count, the sums of the guide, the depth, the guide squared and the guide times the depth.
+        // The depth guiding itself needs only the first three
+        const int count = guide ? 5 : 3;
+        _guided_planes.resize(size_t(count) * size);
+        _guided_box_rows.resize(size_t(count) * size);
+        float* w = _guided_planes.data();
+        float* wi = w + size;
+        float* wp = guide ? wi + size : wi;
+        float* wii = guide ? wp + size : wi + size;
+        float* wip = guide ? wii + size : wii;
+
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < size; ++i)
+        {
+            float p = depth(i);
+            float valid = p > 0 ? 1.f : 0.f;
+            float g = guide ? float(guide[i]) : p;
+            w[i] = valid;
+            wi[i] = valid * g;
+            wp[i] = valid * p;
+            wii[i] = valid * g * g;
+            wip[i] = valid * g * p;
+        }
+
+        box_sums(w, _guided_box_rows.data(), count, width, height, radius);
+
+        // The linear coefficients of every window, weighted by its count of valid pixels
+        float* a = wi;
+        float* b = guide ? wp : wii;
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < size; ++i)
+        {
+            float n = w[i];
+            if (n < 0.5f)
+            {
+                w[i] = a[i] = b[i] = 0.f;
+                continue;
+            }
+            float mean_i = wi[i] / n;
+            float mean_p = wp[i] / n;
+            float var = std::max(0.f, wii[i] / n - mean_i * mean_i);
+            float cov = wip[i] / n - mean_i * mean_p;
+            float coef = cov / (var + eps);
+            a[i] = coef * n;
+            b[i] = (mean_p - coef * mean_i) * n;
+        }
+
+        box_sums(w, _guided_box_rows.data(), 3, width, height, radius);
+
+        // The depth is the average of the linear models of the windows covering it, the holes are kept
+        float* sum_a = wi;
+        float* sum_b = wi + size;
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < size; ++i)
+        {
+            float p = depth(i);
+            if (!(p > 0) || w[i] <= 0.f)
+                continue;
+            float g = guide ? float(guide[i]) : p;
+            float q = (sum_a[i] * g + sum_b[i]) / w[i];
+            if (fp)
+                reinterpret_cast<float*>(image_data)[i] = q;
+            else
+                reinterpret_cast<uint16_t*>(image_data)[i] = static_cast<uint16_t>(std::min(65535.f, std::max(1.f, q + 0.5f)));
+        }
+    }
+
+    void spatial_filter::recursive_filter_horizontal_z16(uint16_t * image_data, float alpha, float deltaZ)
+    {
+        const int width = int(_width);
+        const int height = int(_height);
+        int simd_rows = 0;
+
+#ifdef __SSSE3__
+        // Eight rows are filtered at once: each row group is transposed so that every column becomes a single
+        // vector with one lane per row, and the recursion then advances along the columns
+        const __m128 wa = _mm_set1_ps(alpha);
+        const __m128 wb = _mm_set1_ps(1.f - alpha);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi16(1);
+        const __m128i delta_z = _mm_set1_epi16(static_cast<short>(static_cast<uint16_t>(deltaZ)));
+        const __m128i radius = _mm_set1_epi16(_holes_filling_radius);
+        const int groups = height / 8;
+        simd_rows = groups * 8;
+
+#pragma omp parallel
+        {
+            std::vector<uint16_t> buffer(width * 8);
+            auto columns = buffer.data();
+
+#pragma omp for schedule(static)
+            for (int g = 0; g < groups; g++)
+            {
+                uint16_t* rows = image_data + g * 8 * width;
+                transpose_rows_z16(rows, width, columns, false);
+
+                // left to right
+                __m128i val0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns));
+                __m128i fill = zero;
+                for (int u = 1; u < width - 1; u++)
+                {
+                    auto col = reinterpret_cast<__m128i*>(columns + u * 8);
+                    __m128i val1 = _mm_loadu_si128(col);
+                    __m128i valid0 = nonzero_z16(val0);
+                    __m128i valid1 = nonzero_z16(val1);
+                    __m128i both = _mm_and_si128(valid0, valid1);
+                    __m128i diff = absdiff_z16(val1, val0);
+                    __m128i smooth = _mm_and_si128(_mm_and_si128(both, nonzero_z16(diff)),
+                                                   _mm_cmpeq_epi16(_mm_subs_epu16(diff, delta_z), zero));
+                    val1 = select_z16(smooth, weighted_z16(val1, val0, wa, wb), val1);
+                    fill = _mm_andnot_si128(both, fill);
+                    if (_holes_filling_radius)
+                    {
+                        __m128i hole = _mm_andnot_si128(valid1, valid0);
+                        __m128i next_fill = _mm_adds_epu16(fill, one);
+                        fill = select_z16(hole, next_fill, fill);
+                        val1 = select_z16(_mm_and_si128(hole, nonzero_z16(_mm_subs_epu16(radius, next_fill))), val0, val1);
+                    }
+                    _mm_storeu_si128(col, val1);
+                    val0 = val1;
+                }
+
+                // right to left
+                __m128i val1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + (width - 1) * 8));
+                fill = zero;
+                for (int u = width - 2; u >= 0; u--)
+                {
+                    auto col = reinterpret_cast<__m128i*>(columns + u * 8);
+                    __m128i val0 = _mm_loadu_si128(col);
+                    __m128i valid1 = nonzero_z16(val1);
+                    __m128i valid0 = nonzero_z16(_mm_subs_epu16(val0, one));
+                    __m128i both = _mm_and_si128(valid0, valid1);
+                    __m128i diff = absdiff_z16(val1, val0);
+                    __m128i smooth = _mm_and_si128(both, _mm_cmpeq_epi16(_mm_subs_epu16(diff, delta_z), zero));
+                    val0 = select_z16(smooth, weighted_z16(val0, val1, wa, wb), val0);
+                    fill = _mm_andnot_si128(both, fill);
+                    if (_holes_filling_radius)
+                    {
+                        __m128i hole = _mm_andnot_si128(valid0, valid1);
+                        __m128i next_fill = _mm_adds_epu16(fill, one);
+                        fill = select_z16(hole, next_fill, fill);
+                        val0 = select_z16(_mm_and_si128(hole, nonzero_z16(_mm_subs_epu16(radius, next_fill))), val1, val0);
+                    }
+                    _mm_storeu_si128(col, val0);
+                    val1 = val0;
+                }
+
+                transpose_rows_z16(rows, width, columns, true);
+            }
+        }
+#endif
+        // Remaining rows
+        recursive_filter_horizontal<uint16_t>(image_data, alpha, deltaZ, simd_rows, height);
+    }
+
+    void spatial_filter::recursive_filter_vertical_z16(uint16_t * image_data, float alpha, float deltaZ)
+    {
+        const int width = int(_width);
+        const int height = int(_height);
+        const int bands = (width + vertical_band_width - 1) / vertical_band_width;
+
+        // Each band of columns is swept top to bottom and back; the pixels of a row within a band are independent
+#pragma omp parallel for schedule(static)
+        for (int b = 0; b < bands; b++)
+        {
+            const int first_col = b * vertical_band_width;
+            const int last_col = std::min(width, first_col + vertical_band_width);
+            int simd_end = first_col;
+
+#ifdef __SSSE3__
+            const __m128 wa = _mm_set1_ps(alpha);
+            const __m128 wb = _mm_set1_ps(1.f - alpha);
+            const __m128i delta_z = _mm_set1_epi16(static_cast<short>(static_cast<uint16_t>(deltaZ)));
+            simd_end = first_col + (last_col - first_col) / 8 * 8;
+
+            // top to bottom
+            for (int v = 1; v < height; v++)
+            {
+                const uint16_t* prev = image_data + (v - 1) * width;
+                uint16_t* cur = image_data + v * width;
+                for (int u = first_col; u < simd_end; u += 8)
+                {
+                    __m128i im0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + u));
+                    __m128i imw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + u));
+                    __m128i smooth = nonzero_z16(_mm_subs_epu16(delta_z, absdiff_z16(im0, imw)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(cur + u), select_z16(smooth, weighted_z16(imw, im0, wa, wb), imw));
+                }
+            }
+
+            // bottom to top
+            for (int v = height - 2; v >= 0; v--)
+            {
+                uint16_t* cur = image_data + v * width;
+                const uint16_t* next = cur + width;
+                for (int u = first_col; u < simd_end; u += 8)
+                {
+                    __m128i im0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + u));
+                    __m128i imw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(next + u));
+                    __m128i smooth = _mm_and_si128(_mm_and_si128(nonzero_z16(im0), nonzero_z16(imw)),
+                                                   nonzero_z16(_mm_subs_epu16(delta_z, absdiff_z16(im0, imw))));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(cur + u), select_z16(smooth, weighted_z16(im0, imw, wa, wb), im0));
+                }
+            }
+#endif
+            // Remaining columns of the band
+            if (simd_end < last_col)
+                recursive_filter_vertical<uint16_t>(image_data, alpha, deltaZ, simd_end, last_col);
+        }
+    }
+
     void spatial_filter::recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ)
     {
         float *image = reinterpret_cast<float*>(image_data);
+        const int height = int(_height);
 
-        int v, u;
+        // The rows are independent
+#pragma omp parallel for schedule(static)
+        for (int v = 0; v < height; v++) {
+            int u;
 
-        for (v = 0; v < _height;) {
             // left to right
             float *im = image + v * _width;
             float state = *im;
@@ -349,20 +810,20 @@ namespace librealsense
                     innovation = *im;
                 }
             }
-        DoneRL:
-            v++;
+        DoneRL:;
         }
     }
 
     void spatial_filter::recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ)
     {
         float *image = reinterpret_cast<float*>(image_data);
-
-        int v, u;
+        const int width = int(_width);
 
         // we'll do one column at a time, top to bottom, bottom to top, left to right,
-
-        for (u = 0; u < _width;) {
+        // the columns are independent
+#pragma omp parallel for schedule(static)
+        for (int u = 0; u < width; u++) {
+            int v;
 
             float *im = image + u;
             float state = im[0];
@@ -480,8 +941,7 @@ namespace librealsense
                     innovation = *im;
                 }
             }
-        DoneBT:
-            u++;
+        DoneBT:;
         }
     }
 }
@@ -3,6 +3,8 @@
 //// In-place Domain Transform Edge-preserving filter based on
 // http://inf.ufrgs.br/~eslgastal/DomainTransform/Gastal_Oliveira_SIGGRAPH2011_Domain_Transform.pdf
 // The filter also allows to apply holes filling extention that due to implementation constrains can be applied horizontally only
+// The guided mode replaces it with a guided filter (He et al., Guided Image Filtering) built on box sums,
+// its cost does not depend on the radius
 
 #pragma once
 
@@ -12,6 +14,7 @@
 
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "memory-counter.h"
 
 namespace librealsense
 {
@@ -21,11 +24,31 @@ namespace librealsense
         spatial_filter();
 
     protected:
+        friend class depth_filter_chain;
+
         void    update_configuration(const rs2::frame& f);
+        // Sets the dimensions and the domain the filter passes work on
+        void    configure(size_t width, size_t height, rs2_extension extension_type);
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame find_depth(const rs2::frameset& set);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
+        // Smooths the frame with the selected mode, guide is the infrared image guiding the guided mode, the depth guides itself when null
+        template <typename T>
+        void smooth(void *frame_data, const uint8_t* guide = nullptr)
+        {
+            if (_spatial_mode)
+                guided_smooth(frame_data, std::is_floating_point<T>::value, guide);
+            else
+                dxf_smooth<T>(frame_data, _spatial_alpha_param, _spatial_edge_threshold, _spatial_iterations);
+        }
+
+        // Guided filter of radius _guided_radius, the depth variations within the edge threshold are smoothed and the larger ones kept.
+        // The pixels of no depth are neither smoothed nor counted in the statistics of their neighbors
+        void guided_smooth(void * image_data, bool fp, const uint8_t* guide);
+
         template <typename T>
         void dxf_smooth(void *frame_data, float alpha, float delta, int iterations)
         {
@@ -41,8 +64,8 @@ namespace librealsense
                 }
                 else
                 {
-                    recursive_filter_horizontal<T>(frame_data, alpha, delta);
-                    recursive_filter_vertical<T>(frame_data, alpha, delta);
+                    recursive_filter_horizontal_z16(static_cast<uint16_t*>(frame_data), alpha, delta);
+                    recursive_filter_vertical_z16(static_cast<uint16_t*>(frame_data), alpha, delta);
                 }
             }
 
@@ -55,8 +78,14 @@ namespace librealsense
         void recursive_filter_horizontal_fp(void * image_data, float alpha, float deltaZ);
         void recursive_filter_vertical_fp(void * image_data, float alpha, float deltaZ);
 
+        // Depth (Z16) passes. Rows (horizontal) and columns (vertical) are independent, so the frame is split
+        // into row groups / column bands that are filtered in SIMD lanes and, with OpenMP, on multiple threads
+        void recursive_filter_horizontal_z16(uint16_t * image_data, float alpha, float deltaZ);
+        void recursive_filter_vertical_z16(uint16_t * image_data, float alpha, float deltaZ);
+
+        // Scalar passes over the rows [first_row, last_row) and the columns [first_col, last_col) respectively
         template <typename T>
-        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ)
+        void  recursive_filter_horizontal(void * image_data, float alpha, float deltaZ, size_t first_row, size_t last_row)
         {
             size_t v{}, u{};
 
@@ -72,7 +101,7 @@ namespace librealsense
             auto image = reinterpret_cast<T*>(image_data);
             size_t cur_fill = 0;
 
-            for (v = 0; v < _height; v++)
+            for (v = first_row; v < last_row; v++)
             {
                 // left to right
                 T *im = image + v * _width;
@@ -151,7 +180,7 @@ namespace librealsense
         }
 
         template <typename T>
-        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ)
+        void recursive_filter_vertical(void * image_data, float alpha, float deltaZ, size_t first_col, size_t last_col)
         {
             size_t v{}, u{};
 
@@ -175,7 +204,8 @@ namespace librealsense
             T imw{};
             for (v = 1; v < _height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (v - 1) * _width + first_col;
+                for (u = first_col; u < last_col; u++)
                 {
                     im0 = im[0];
                     imw = im[_width];
@@ -194,10 +224,10 @@ namespace librealsense
             }
 
             // bottom to top
-            im = image + (_height - 2) * _width;
-            for (v = 1; v < _height; v++, im -= (_width * 2))
+            for (v = 1; v < _height; v++)
             {
-                for (u = 0; u < _width; u++)
+                im = image + (_height - 1 - v) * _width + first_col;
+                for (u = first_col; u < last_col; u++)
                 {
                     im0 = im[0];
                     imw = im[_width];
@@ -280,6 +310,11 @@ namespace librealsense
         float                   _stereo_baseline_mm;
         uint8_t                 _holes_filling_mode;
         uint8_t                 _holes_filling_radius;
+        uint8_t                 _spatial_mode;
+        uint8_t                 _guided_radius;
+        uint8_t                 _ir_guided;
+        cache_vector<float>     _guided_planes;             // Planes of the guided filter statistics, then of their box sums
+        cache_vector<float>     _guided_box_rows;           // Horizontal box sums of a plane
     };
     MAP_EXTENSION(RS2_EXTENSION_SPATIAL_FILTER, librealsense::spatial_filter);
 }
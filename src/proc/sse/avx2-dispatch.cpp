@@ -0,0 +1,65 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "avx2-kernels.h"
+
+#ifdef __SSSE3__
+
+#ifdef RS2_USE_AVX2_KERNELS
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace librealsense
+{
+#ifdef RS2_USE_AVX2_KERNELS
+
+    static void cpuid(unsigned int info[4], unsigned int leaf)
+    {
+#ifdef _MSC_VER
+        __cpuidex(reinterpret_cast<int*>(info), leaf, 0);
+#else
+        __cpuid_count(leaf, 0, info[0], info[1], info[2], info[3]);
+#endif
+    }
+
+    static unsigned long long xgetbv(unsigned int index)
+    {
+#ifdef _MSC_VER
+        return _xgetbv(index);
+#else
+        unsigned int eax, edx;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+        return ((unsigned long long)edx << 32) | eax;
+#endif
+    }
+
+    bool has_avx2()
+    {
+        unsigned int info[4];
+        cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        // AVX and OSXSAVE, and the OS has to save the YMM registers on context switch
+        cpuid(info, 1);
+        if ((info[2] & (1u << 27)) == 0 || (info[2] & (1u << 28)) == 0)
+            return false;
+        if ((xgetbv(0) & 6) != 6)
+            return false;
+
+        cpuid(info, 7);
+        return (info[1] & (1u << 5)) != 0;
+    }
+
+#else // RS2_USE_AVX2_KERNELS
+
+    bool has_avx2() { return false; }
+
+#endif // RS2_USE_AVX2_KERNELS
+}
+
+#endif // __SSSE3__
@@ -0,0 +1,521 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2019 Intel Corporation. All Rights Reserved.
+
+#include "avx2-kernels.h"
+
+#include <limits>
+
+#ifdef __SSSE3__
+
+#ifdef __AVX2__
+#include <immintrin.h> // For AVX2 intrinsics
+#endif
+
+namespace librealsense
+{
+#ifdef __AVX2__
+
+    template<rs2_distortion dist>
+    inline void distort_x_y_avx2(__m256& x, __m256& y, const __m256* c) {}
+
+    template<>
+    inline void distort_x_y_avx2<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(__m256& x, __m256& y, const __m256* c)
+    {
+        auto one = _mm256_set1_ps(1);
+        auto two = _mm256_set1_ps(2);
+
+        auto r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        auto r3 = _mm256_add_ps(_mm256_mul_ps(c[1], _mm256_mul_ps(r2, r2)), _mm256_mul_ps(c[4], _mm256_mul_ps(r2, _mm256_mul_ps(r2, r2))));
+        auto f = _mm256_add_ps(one, _mm256_add_ps(_mm256_mul_ps(c[0], r2), r3));
+
+        auto x_f = _mm256_mul_ps(x, f);
+        auto y_f = _mm256_mul_ps(y, f);
+
+        auto r4 = _mm256_mul_ps(c[3], _mm256_add_ps(r2, _mm256_mul_ps(two, _mm256_mul_ps(x_f, x_f))));
+        auto d_x = _mm256_add_ps(x_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[2], _mm256_mul_ps(x_f, y_f))), r4));
+
+        // Matches the SSE kernels term for term
+        auto d_y = _mm256_add_ps(y_f, _mm256_add_ps(_mm256_mul_ps(two, _mm256_mul_ps(c[3], _mm256_mul_ps(x_f, y_f))), r4));
+
+        x = d_x;
+        y = d_y;
+    }
+
+    template<rs2_distortion dist>
+    void get_texture_map_avx2(const uint16_t* depth,
+        float depth_scale,
+        const unsigned int size,
+        const float* pre_compute_x, const float* pre_compute_y,
+        byte* pixels_ptr_int,
+        const rs2_intrinsics& to,
+        const rs2_extrinsics& from_to_other)
+    {
+        auto scale = _mm256_set1_ps(depth_scale);
+
+        auto res = reinterpret_cast<__m256i*>(pixels_ptr_int);
+
+        __m256 r[9];
+        __m256 t[3];
+        __m256 c[5];
+
+        for (int i = 0; i < 9; ++i)
+        {
+            r[i] = _mm256_set1_ps(from_to_other.rotation[i]);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            t[i] = _mm256_set1_ps(from_to_other.translation[i]);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            c[i] = _mm256_set1_ps(to.coeffs[i]);
+        }
+        auto zero = _mm256_set1_ps(0);
+        auto half = _mm256_set1_ps(0.5);
+        auto fx = _mm256_set1_ps(to.fx);
+        auto fy = _mm256_set1_ps(to.fy);
+        auto ppx = _mm256_set1_ps(to.ppx);
+        auto ppy = _mm256_set1_ps(to.ppy);
+
+        for (unsigned int i = 0; i < size; i += 8)
+        {
+            auto x = _mm256_loadu_ps(pre_compute_x + i);
+            auto y = _mm256_loadu_ps(pre_compute_y + i);
+
+            //zero extend the 8 depth pixels to 32 bit and convert to float
+            auto d = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*)(depth + i)));
+            auto z = _mm256_mul_ps(_mm256_cvtepi32_ps(d), scale);
+
+            auto px = _mm256_mul_ps(z, x);
+            auto py = _mm256_mul_ps(z, y);
+
+            auto p_x = _mm256_add_ps(_mm256_mul_ps(r[0], px), _mm256_add_ps(_mm256_mul_ps(r[3], py), _mm256_add_ps(_mm256_mul_ps(r[6], z), t[0])));
+            auto p_y = _mm256_add_ps(_mm256_mul_ps(r[1], px), _mm256_add_ps(_mm256_mul_ps(r[4], py), _mm256_add_ps(_mm256_mul_ps(r[7], z), t[1])));
+            auto p_z = _mm256_add_ps(_mm256_mul_ps(r[2], px), _mm256_add_ps(_mm256_mul_ps(r[5], py), _mm256_add_ps(_mm256_mul_ps(r[8], z), t[2])));
+
+            p_x = _mm256_div_ps(p_x, p_z);
+            p_y = _mm256_div_ps(p_y, p_z);
+
+            distort_x_y_avx2<dist>(p_x, p_y, c);
+
+            //zero the x and y if z is zero
+            auto cmp = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            auto u_round = _mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p_x, fx), ppx), half), cmp);
+            auto v_round = _mm256_and_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(p_y, fy), ppy), half), cmp);
+
+            auto u = _mm256_cvtps_epi32(u_round);
+            auto v = _mm256_cvtps_epi32(v_round);
+
+            //interleave to u0 v0 u1 v1 ... u7 v7
+            auto uv_lo = _mm256_unpacklo_epi32(u, v);       // u0 v0 u1 v1 | u4 v4 u5 v5
+            auto uv_hi = _mm256_unpackhi_epi32(u, v);       // u2 v2 u3 v3 | u6 v6 u7 v7
+
+            _mm256_storeu_si256(&res[0], _mm256_permute2x128_si256(uv_lo, uv_hi, 0x20));
+            _mm256_storeu_si256(&res[1], _mm256_permute2x128_si256(uv_lo, uv_hi, 0x31));
+            res += 2;
+        }
+    }
+
+    void project_points_avx2(const float* point,
+        const unsigned int size,
+        const rs2_intrinsics& other_intrinsics,
+        const rs2_extrinsics& extr,
+        float* res1,
+        float* res)
+    {
+        __m256 r[9];
+        __m256 t[3];
+        __m256 c[5];
+
+        for (int i = 0; i < 9; ++i)
+        {
+            r[i] = _mm256_set1_ps(extr.rotation[i]);
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+            t[i] = _mm256_set1_ps(extr.translation[i]);
+        }
+        for (int i = 0; i < 5; ++i)
+        {
+            c[i] = _mm256_set1_ps(other_intrinsics.coeffs[i]);
+        }
+
+        auto fx = _mm256_set1_ps(other_intrinsics.fx);
+        auto fy = _mm256_set1_ps(other_intrinsics.fy);
+        auto ppx = _mm256_set1_ps(other_intrinsics.ppx);
+        auto ppy = _mm256_set1_ps(other_intrinsics.ppy);
+        auto w = _mm256_set1_ps(float(other_intrinsics.width));
+        auto h = _mm256_set1_ps(float(other_intrinsics.height));
+        auto zero = _mm256_set1_ps(0);
+
+        // The SSE kernel applies the distortion to the inverse brown conrady model only
+        bool distort = other_intrinsics.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY;
+
+        for (unsigned int i = 0; i < size * 3; i += 24)
+        {
+            //load 8 points (x,y,z), points 0-3 to the low lanes and points 4-7 to the high lanes
+            auto l1 = _mm256_loadu_ps(point + i);
+            auto l2 = _mm256_loadu_ps(point + i + 8);
+            auto l3 = _mm256_loadu_ps(point + i + 16);
+
+            auto xyz1 = _mm256_permute2f128_ps(l1, l2, 0x30);
+            auto xyz2 = _mm256_permute2f128_ps(l1, l3, 0x21);
+            auto xyz3 = _mm256_permute2f128_ps(l2, l3, 0x30);
+
+            //gather x,y,z
+            auto yz = _mm256_shuffle_ps(xyz1, xyz2, _MM_SHUFFLE(1, 0, 2, 1));
+            auto xy = _mm256_shuffle_ps(xyz2, xyz3, _MM_SHUFFLE(2, 1, 3, 2));
+
+            auto x = _mm256_shuffle_ps(xyz1, xy, _MM_SHUFFLE(2, 0, 3, 0));
+            auto y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+            auto z = _mm256_shuffle_ps(yz, xyz3, _MM_SHUFFLE(3, 0, 3, 1));
+
+            auto p_x = _mm256_add_ps(_mm256_mul_ps(r[0], x), _mm256_add_ps(_mm256_mul_ps(r[3], y), _mm256_add_ps(_mm256_mul_ps(r[6], z), t[0])));
+            auto p_y = _mm256_add_ps(_mm256_mul_ps(r[1], x), _mm256_add_ps(_mm256_mul_ps(r[4], y), _mm256_add_ps(_mm256_mul_ps(r[7], z), t[1])));
+            auto p_z = _mm256_add_ps(_mm256_mul_ps(r[2], x), _mm256_add_ps(_mm256_mul_ps(r[5], y), _mm256_add_ps(_mm256_mul_ps(r[8], z), t[2])));
+
+            p_x = _mm256_div_ps(p_x, p_z);
+            p_y = _mm256_div_ps(p_y, p_z);
+
+            if (distort)
+                distort_x_y_avx2<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(p_x, p_y, c);
+
+            //zero the x and y if z is zero
+            auto cmp = _mm256_cmp_ps(z, zero, _CMP_NEQ_UQ);
+            p_x = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_x, fx), ppx), cmp);
+            p_y = _mm256_and_ps(_mm256_add_ps(_mm256_mul_ps(p_y, fy), ppy), cmp);
+
+            //scattering of the x y before normalize and store in pixels
+            auto xx_yy01 = _mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 0, 2, 0));
+            auto xx_yy23 = _mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(3, 1, 3, 1));
+
+            auto xyxy1 = _mm256_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(2, 0, 2, 0));
+            auto xyxy2 = _mm256_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm256_storeu_ps(res1, _mm256_permute2f128_ps(xyxy1, xyxy2, 0x20));
+            _mm256_storeu_ps(res1 + 8, _mm256_permute2f128_ps(xyxy1, xyxy2, 0x31));
+            res1 += 16;
+
+            //normalize x and y
+            p_x = _mm256_div_ps(p_x, w);
+            p_y = _mm256_div_ps(p_y, h);
+
+            //scattering of the x y after normalize and store in tex_coords
+            xx_yy01 = _mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 0, 2, 0));
+            xx_yy23 = _mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(3, 1, 3, 1));
+
+            xyxy1 = _mm256_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(2, 0, 2, 0));
+            xyxy2 = _mm256_shuffle_ps(xx_yy01, xx_yy23, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm256_storeu_ps(res, _mm256_permute2f128_ps(xyxy1, xyxy2, 0x20));
+            _mm256_storeu_ps(res + 8, _mm256_permute2f128_ps(xyxy1, xyxy2, 0x31));
+            res += 16;
+        }
+    }
+
+    int unpack_y8_y8_from_y8i_avx2(byte* left, byte* right, const byte* source, int count)
+    {
+        // Gathers the left bytes into the low half and the right bytes into the high half of each lane
+        const auto split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                            0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+        int i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            auto a = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 2 * i)), split);
+            auto b = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 2 * i + 32)), split);
+
+            // l0-7 l16-23 | l8-15 l24-31, reordered to l0-31
+            auto l = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xD8);
+            auto r = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xD8);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), l);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i), r);
+        }
+        return i;
+    }
+
+    int unpack_y16_y16_from_y12i_10_avx2(uint16_t* left, uint16_t* right, const byte* source, int count)
+    {
+        // Each lane holds 4 pixels of 3 bytes, gathered to the 4 right words followed by the 4 left words
+        const auto split = _mm256_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11,
+                                            0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+        const auto mask = _mm256_set1_epi16(0x0fff);
+
+        int i = 0;
+        // Every lane is loaded as 16 bytes out of 12, the last 2 pixels are left to the caller to stay in bounds
+        for (; i + 16 + 2 <= count; i += 16)
+        {
+            auto in = source + 3 * i;
+            auto a = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), 1);
+            auto b = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 24))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 36)), 1);
+            a = _mm256_shuffle_epi8(a, split);
+            b = _mm256_shuffle_epi8(b, split);
+
+            auto r = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(_mm256_and_si256(a, mask), _mm256_and_si256(b, mask)), 0xD8);
+            auto l = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(_mm256_srli_epi16(a, 4), _mm256_srli_epi16(b, 4)), 0xD8);
+
+            l = _mm256_or_si256(_mm256_slli_epi16(l, 6), _mm256_srli_epi16(l, 4));
+            r = _mm256_or_si256(_mm256_slli_epi16(r, 6), _mm256_srli_epi16(r, 4));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i), l);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i), r);
+        }
+        return i;
+    }
+
+    int unpack_y16_from_y10bpack_avx2(uint16_t* dest, const byte* source, int count)
+    {
+        // Each lane holds 2 macro-pixels of 5 bytes, every word gets the 8 msb in its high byte and the shared byte in its low byte
+        const auto split = _mm256_setr_epi8(4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8,
+                                            4, 0, 4, 1, 4, 2, 4, 3, 9, 5, 9, 6, 9, 7, 9, 8);
+        // Moves the 2 lsb of each pixel to bits 6 and 7
+        const auto shift = _mm256_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1, 64, 16, 4, 1);
+        const auto high = _mm256_set1_epi16(int16_t(0xff00));
+        const auto low = _mm256_set1_epi16(0x00c0);
+
+        int i = 0;
+        // Every lane is loaded as 16 bytes out of 10, the last 8 pixels are left to the caller to stay in bounds
+        for (; i + 16 + 8 <= count; i += 16)
+        {
+            auto in = source + i / 4 * 5;
+            auto v = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 10)), 1);
+            v = _mm256_shuffle_epi8(v, split);
+
+            auto lsb = _mm256_and_si256(_mm256_mullo_epi16(_mm256_andnot_si256(high, v), shift), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_or_si256(_mm256_and_si256(v, high), lsb));
+        }
+        return i;
+    }
+
+    int merge_depth_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1, int count)
+    {
+        const auto zero = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d0 + i));
+            auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d1 + i));
+            auto first_empty = _mm256_cmpeq_epi16(a, zero);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_or_si256(a, _mm256_and_si256(first_empty, b)));
+        }
+        return i;
+    }
+
+    // Mask of the pixels not to take: no depth, or infrared out of (low, high)
+    static inline __m256i hdr_invalid_mask(__m256i depth, __m256i ir, __m256i low, __m256i high)
+    {
+        const auto zero = _mm256_setzero_si256();
+        auto under = _mm256_cmpeq_epi16(_mm256_subs_epu16(ir, low), zero);
+        auto over = _mm256_cmpeq_epi16(_mm256_subs_epu16(high, ir), zero);
+        return _mm256_or_si256(_mm256_or_si256(under, over), _mm256_cmpeq_epi16(depth, zero));
+    }
+
+    static inline __m256i hdr_merge_pixels(__m256i a, __m256i b, __m256i ir_a, __m256i ir_b, __m256i low, __m256i high)
+    {
+        auto bad_a = hdr_invalid_mask(a, ir_a, low, high);
+        auto bad_b = hdr_invalid_mask(b, ir_b, low, high);
+        return _mm256_or_si256(_mm256_andnot_si256(bad_a, a), _mm256_and_si256(bad_a, _mm256_andnot_si256(bad_b, b)));
+    }
+
+    int merge_depth_using_ir_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1,
+        const uint8_t* i0, const uint8_t* i1, uint16_t low, uint16_t high, int count)
+    {
+        const auto lo = _mm256_set1_epi16(int16_t(low));
+        const auto hi = _mm256_set1_epi16(int16_t(high));
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d0 + i));
+            auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d1 + i));
+            auto ir_a = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(i0 + i)));
+            auto ir_b = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(i1 + i)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), hdr_merge_pixels(a, b, ir_a, ir_b, lo, hi));
+        }
+        return i;
+    }
+
+    int merge_depth_using_ir_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1,
+        const uint16_t* i0, const uint16_t* i1, uint16_t low, uint16_t high, int count)
+    {
+        const auto lo = _mm256_set1_epi16(int16_t(low));
+        const auto hi = _mm256_set1_epi16(int16_t(high));
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d0 + i));
+            auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d1 + i));
+            auto ir_a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i0 + i));
+            auto ir_b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(i1 + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), hdr_merge_pixels(a, b, ir_a, ir_b, lo, hi));
+        }
+        return i;
+    }
+
+    // 16 depth pixels to two registers of 8 floats
+    static inline void load_depth_ps(const uint16_t* depth, __m256& lo, __m256& hi)
+    {
+        auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth));
+        lo = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(d)));
+        hi = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(d, 1)));
+    }
+
+    int threshold_depth_avx2(uint16_t* dest, const uint16_t* depth, float units, float min_dist, float max_dist, int count)
+    {
+        const auto u = _mm256_set1_ps(units);
+        const auto mn = _mm256_set1_ps(min_dist);
+        const auto mx = _mm256_set1_ps(max_dist);
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256 lo, hi;
+            load_depth_ps(depth + i, lo, hi);
+            lo = _mm256_mul_ps(lo, u);
+            hi = _mm256_mul_ps(hi, u);
+            auto keep_lo = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(lo, mn, _CMP_GE_OQ), _mm256_cmp_ps(lo, mx, _CMP_LE_OQ)));
+            auto keep_hi = _mm256_castps_si256(_mm256_and_ps(_mm256_cmp_ps(hi, mn, _CMP_GE_OQ), _mm256_cmp_ps(hi, mx, _CMP_LE_OQ)));
+            auto keep = _mm256_permute4x64_epi64(_mm256_packs_epi32(keep_lo, keep_hi), 0xD8);
+            auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_and_si256(d, keep));
+        }
+        return i;
+    }
+
+    int depth_to_meters_avx2(float* dest, const uint16_t* depth, float units, int count)
+    {
+        const auto u = _mm256_set1_ps(units);
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256 lo, hi;
+            load_depth_ps(depth + i, lo, hi);
+            _mm256_storeu_ps(dest + i, _mm256_mul_ps(lo, u));
+            _mm256_storeu_ps(dest + i + 8, _mm256_mul_ps(hi, u));
+        }
+        return i;
+    }
+
+    int depth_to_disparity_avx2(float* dest, const uint16_t* depth, float factor, int count)
+    {
+        const auto f = _mm256_set1_ps(factor);
+        const auto zero = _mm256_setzero_ps();
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256 lo, hi;
+            load_depth_ps(depth + i, lo, hi);
+            // no depth gives no disparity
+            _mm256_storeu_ps(dest + i, _mm256_and_ps(_mm256_div_ps(f, lo), _mm256_cmp_ps(lo, zero, _CMP_NEQ_OQ)));
+            _mm256_storeu_ps(dest + i + 8, _mm256_and_ps(_mm256_div_ps(f, hi), _mm256_cmp_ps(hi, zero, _CMP_NEQ_OQ)));
+        }
+        return i;
+    }
+
+    // The depth of 8 disparities, zero when the disparity is not a normal number
+    static inline __m256i disparity_to_depth_epi32(const float* disparity, __m256 factor)
+    {
+        const auto abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        const auto smallest = _mm256_set1_ps(std::numeric_limits<float>::min());
+        const auto largest = _mm256_set1_ps(std::numeric_limits<float>::max());
+        const auto round = _mm256_set1_ps(0.5f);
+
+        auto d = _mm256_loadu_ps(disparity);
+        auto a = _mm256_and_ps(d, abs_mask);
+        auto normal = _mm256_and_ps(_mm256_cmp_ps(a, smallest, _CMP_GE_OQ), _mm256_cmp_ps(a, largest, _CMP_LE_OQ));
+        auto v = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_div_ps(factor, d), round));
+        return _mm256_and_si256(v, _mm256_castps_si256(normal));
+    }
+
+    int disparity_to_depth_avx2(uint16_t* dest, const float* disparity, float factor, int count)
+    {
+        const auto f = _mm256_set1_ps(factor);
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            auto lo = disparity_to_depth_epi32(disparity + i, f);
+            auto hi = disparity_to_depth_epi32(disparity + i + 8, f);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8));
+        }
+        return i;
+    }
+
+    int zero_order_invalidation_avx2(uint16_t* depth_out, uint8_t* confidence_out, const uint16_t* depth, const uint8_t* ir,
+        const uint8_t* confidence, const float* ray_x, const float* ray_norm, float units_mm, float baseline,
+        int ir_limit, float rtd_min, float rtd_max, int count)
+    {
+        const auto units = _mm256_set1_ps(units_mm);
+        const auto b2 = _mm256_set1_ps(2 * baseline);
+        const auto bb = _mm256_set1_ps(baseline * baseline);
+        const auto mn = _mm256_set1_ps(rtd_min);
+        const auto mx = _mm256_set1_ps(rtd_max);
+        const auto fzero = _mm256_setzero_ps();
+        const auto limit = _mm256_set1_epi16(static_cast<short>(ir_limit));
+        const auto zero = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256 z[2];
+            load_depth_ps(depth + i, z[0], z[1]);
+
+            __m256 in_range[2];
+            for (int k = 0; k < 2; k++)
+            {
+                z[k] = _mm256_mul_ps(z[k], units);
+                auto dist = _mm256_mul_ps(z[k], _mm256_loadu_ps(ray_norm + i + 8 * k));
+                auto back = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(dist, dist), bb), _mm256_mul_ps(_mm256_mul_ps(z[k], b2), _mm256_loadu_ps(ray_x + i + 8 * k)));
+                auto rtd = _mm256_add_ps(dist, _mm256_sqrt_ps(_mm256_max_ps(back, fzero)));
+                in_range[k] = _mm256_and_ps(_mm256_cmp_ps(rtd, mn, _CMP_GT_OQ), _mm256_cmp_ps(rtd, mx, _CMP_LT_OQ));
+            }
+
+            auto d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(depth + i));
+            auto ir16 = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ir + i)));
+            auto zo = _mm256_permute4x64_epi64(_mm256_packs_epi32(_mm256_castps_si256(in_range[0]), _mm256_castps_si256(in_range[1])), 0xD8);
+            zo = _mm256_and_si256(zo, _mm256_cmpgt_epi16(limit, ir16));
+            zo = _mm256_andnot_si256(_mm256_cmpeq_epi16(d, zero), zo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(depth_out + i), _mm256_andnot_si256(zo, d));
+
+            if (confidence)
+            {
+                auto zo8 = _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packs_epi16(zo, zo), 0xD8));
+                auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(confidence + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(confidence_out + i), _mm_andnot_si128(zo8, c));
+            }
+        }
+        return i;
+    }
+
+#else // __AVX2__
+
+    int unpack_y8_y8_from_y8i_avx2(byte*, byte*, const byte*, int) { return 0; }
+    int unpack_y16_y16_from_y12i_10_avx2(uint16_t*, uint16_t*, const byte*, int) { return 0; }
+    int unpack_y16_from_y10bpack_avx2(uint16_t*, const byte*, int) { return 0; }
+
+    int merge_depth_avx2(uint16_t*, const uint16_t*, const uint16_t*, int) { return 0; }
+    int merge_depth_using_ir_avx2(uint16_t*, const uint16_t*, const uint16_t*,
+        const uint8_t*, const uint8_t*, uint16_t, uint16_t, int) { return 0; }
+    int merge_depth_using_ir_avx2(uint16_t*, const uint16_t*, const uint16_t*,
+        const uint16_t*, const uint16_t*, uint16_t, uint16_t, int) { return 0; }
+
+    int threshold_depth_avx2(uint16_t*, const uint16_t*, float, float, float, int) { return 0; }
+    int depth_to_meters_avx2(float*, const uint16_t*, float, int) { return 0; }
+    int depth_to_disparity_avx2(float*, const uint16_t*, float, int) { return 0; }
+    int disparity_to_depth_avx2(uint16_t*, const float*, float, int) { return 0; }
+    int zero_order_invalidation_avx2(uint16_t*, uint8_t*, const uint16_t*, const uint8_t*, const uint8_t*,
+        const float*, const float*, float, float, int, float, float, int) { return 0; }
+
+    template<rs2_distortion dist>
+    void get_texture_map_avx2(const uint16_t*, float, const unsigned int, const float*, const float*,
+        byte*, const rs2_intrinsics&, const rs2_extrinsics&) {}
+
+    void project_points_avx2(const float*, const unsigned int, const rs2_intrinsics&, const rs2_extrinsics&, float*, float*) {}
+
+#endif // __AVX2__
+
+    template void get_texture_map_avx2<RS2_DISTORTION_NONE>(const uint16_t*, float, const unsigned int,
+        const float*, const float*, byte*, const rs2_intrinsics&, const rs2_extrinsics&);
+    template void get_texture_map_avx2<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(const uint16_t*, float, const unsigned int,
+        const float*, const float*, byte*, const rs2_intrinsics&, const rs2_extrinsics&);
+}
+#endif // __SSSE3__
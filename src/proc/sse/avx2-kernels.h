@@ -0,0 +1,77 @@
+/* License: Apache 2.0. See LICENSE file in root directory. */
+/* Copyright(c) 2019 Intel Corporation. All Rights Reserved. */
+#pragma once
+#ifdef __SSSE3__
+
+#include "../include/librealsense2/h/rs_types.h"
+#include "../include/librealsense2/h/rs_sensor.h"
+#include <stdint.h>
+
+// Not types.h: the globals defined in its headers would be initialized by AVX2 code in avx2-kernels.cpp, when the library loads
+typedef unsigned char byte;
+
+// AVX2 versions of the SSE align and pointcloud projection kernels, processing 8 pixels per iteration,
+// and of the infrared unpacking kernels.
+// They are compiled in a separate translation unit with -mavx2 and must only be called when has_avx2() is true. has_avx2() is
+// in avx2-dispatch.cpp, built for the baseline CPU, since the check must not run AVX instructions itself.
+// The results are identical to the SSE kernels. The pointcloud deprojection is bound by the memory bandwidth and stays on SSE.
+namespace librealsense
+{
+    // True when the AVX2 kernels were built and the CPU and OS support AVX2
+    bool has_avx2();
+
+    // Same as get_texture_map_sse in sse-align.cpp
+    template<rs2_distortion dist>
+    void get_texture_map_avx2(const uint16_t* depth,
+        float depth_scale,
+        const unsigned int size,
+        const float* pre_compute_x, const float* pre_compute_y,
+        byte* pixels_ptr_int,
+        const rs2_intrinsics& to,
+        const rs2_extrinsics& from_to_other);
+
+    // Same as pointcloud_sse::get_texture_map, writes size pairs of pixels and texture coordinates
+    void project_points_avx2(const float* points,
+        const unsigned int size,
+        const rs2_intrinsics& other_intrinsics,
+        const rs2_extrinsics& extr,
+        float* pixels,
+        float* tex_coords);
+
+    // The unpack kernels below return the number of pixels written, the caller converts the remaining pixels
+
+    // Y8I to separate left and right Y8 images
+    int unpack_y8_y8_from_y8i_avx2(byte* left, byte* right, const byte* source, int count);
+
+    // Y12I to separate left and right Y16 images, same conversion as unpack_y16_y16_from_y12i_10
+    int unpack_y16_y16_from_y12i_10_avx2(uint16_t* left, uint16_t* right, const byte* source, int count);
+
+    // Y10BPACK to Y16, with the 10 bits in the msb
+    int unpack_y16_from_y10bpack_avx2(uint16_t* dest, const byte* source, int count);
+
+    // The HDR merge kernels return the number of pixels merged, the caller merges the remaining pixels.
+    // A pixel takes the first depth when it is valid, then the second one, and an infrared value is valid inside (low, high)
+    int merge_depth_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1, int count);
+    int merge_depth_using_ir_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1,
+        const uint8_t* i0, const uint8_t* i1, uint16_t low, uint16_t high, int count);
+    int merge_depth_using_ir_avx2(uint16_t* dest, const uint16_t* d0, const uint16_t* d1,
+        const uint16_t* i0, const uint16_t* i1, uint16_t low, uint16_t high, int count);
+
+    // The depth conversion kernels return the number of pixels converted, the caller converts the remaining pixels
+
+    // Same as the threshold filter, dest may be the source
+    int threshold_depth_avx2(uint16_t* dest, const uint16_t* depth, float units, float min_dist, float max_dist, int count);
+
+    // Depth units to meters
+    int depth_to_meters_avx2(float* dest, const uint16_t* depth, float units, int count);
+
+    // Same as disparity_transform::convert, in both directions
+    int depth_to_disparity_avx2(float* dest, const uint16_t* depth, float factor, int count);
+    int disparity_to_depth_avx2(uint16_t* dest, const float* disparity, float factor, int count);
+
+    // Same as detect_zero_order in zero-order.cpp, returns the number of pixels invalidated, the confidence is optional
+    int zero_order_invalidation_avx2(uint16_t* depth_out, uint8_t* confidence_out, const uint16_t* depth, const uint8_t* ir,
+        const uint8_t* confidence, const float* ray_x, const float* ray_norm, float units_mm, float baseline,
+        int ir_limit, float rtd_min, float rtd_max, int count);
+}
+#endif // __SSSE3__
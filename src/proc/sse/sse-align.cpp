@@ -3,10 +3,10 @@
 #ifdef __SSSE3__
 
 #include "sse-align.h"
+#include "avx2-kernels.h"
 #include <tmmintrin.h> // For SSE3 intrinsic used in unpack_yuy2_sse
 #include "../include/librealsense2/hpp/rs_sensor.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
-#include "../include/librealsense2/rsutil.h"
 
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
@@ -15,16 +15,6 @@
 
 using namespace librealsense;
 
-template<int N> struct bytes { byte b[N]; };
-
-bool is_special_resolution(const rs2_intrinsics& depth, const rs2_intrinsics& to)
-{
-    if ((depth.width == 640 && depth.height == 240 && to.width == 320 && to.height == 180) ||
-        (depth.width == 640 && depth.height == 480 && to.width == 640 && to.height == 360))
-        return true;
-    return false;
-}
-
 template<rs2_distortion dist>
 inline void distorte_x_y(const __m128 & x, const __m128 & y, __m128 * distorted_x, __m128 * distorted_y, const rs2_intrinsics& to)
 {
@@ -113,7 +103,7 @@ inline void get_texture_map_sse(const uint16_t * depth,
         auto y1 = _mm_load_ps(mapy + i + 4);
 
 
-        __m128i d = _mm_load_si128((__m128i const*)(depth + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
+        __m128i d = _mm_loadu_si128((__m128i const*)(depth + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
 
                                                                         //split the depth pixel to 2 registers of 4 floats each
         __m128i d0 = _mm_shuffle_epi8(d, mask0);        // 00 00 d3 d3 00 00 d2 d2 00 00 d1 d1 00 00 d0 d0
@@ -194,206 +184,26 @@ inline void get_texture_map_sse(const uint16_t * depth,
     }
 }
 
-image_transform::image_transform(const rs2_intrinsics& from, float depth_scale)
-    :_depth(from),
-    _depth_scale(depth_scale),
-    _pixel_top_left_int(from.width*from.height),
-    _pixel_bottom_right_int(from.width*from.height)
+void image_transform_sse::get_texture_map(const uint16_t* z_pixels, float depth_scale, const unsigned int size,
+    const float* pre_compute_x, const float* pre_compute_y, int2* pixels,
+    const rs2_intrinsics& to, const rs2_extrinsics& from_to_other, rs2_distortion dist)
 {
-}
-
-void image_transform::pre_compute_x_y_map_corners()
-{
-    pre_compute_x_y_map(_pre_compute_map_x_top_left, _pre_compute_map_y_top_left, -0.5f);
-    pre_compute_x_y_map(_pre_compute_map_x_bottom_right, _pre_compute_map_y_bottom_right, 0.5f);
-}
+    static const bool do_avx2 = has_avx2();
 
-void image_transform::pre_compute_x_y_map(std::vector<float>& pre_compute_map_x,
-    std::vector<float>& pre_compute_map_y,
-    float offset)
-{
-    pre_compute_map_x.resize(_depth.width*_depth.height);
-    pre_compute_map_y.resize(_depth.width*_depth.height);
-
-    for (int h = 0; h < _depth.height; ++h)
+    auto pixels_ptr_int = reinterpret_cast<byte*>(pixels);
+    if (dist == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
     {
-        for (int w = 0; w < _depth.width; ++w)
-        {
-            const float pixel[] = { (float)w + offset, (float)h + offset };
-
-            float x = (pixel[0] - _depth.ppx) / _depth.fx;
-            float y = (pixel[1] - _depth.ppy) / _depth.fy;
-
-            if (_depth.model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
-            {
-                float r2 = x * x + y * y;
-                float f = 1 + _depth.coeffs[0] * r2 + _depth.coeffs[1] * r2*r2 + _depth.coeffs[4] * r2*r2*r2;
-                float ux = x * f + 2 * _depth.coeffs[2] * x*y + _depth.coeffs[3] * (r2 + 2 * x*x);
-                float uy = y * f + 2 * _depth.coeffs[3] * x*y + _depth.coeffs[2] * (r2 + 2 * y*y);
-                x = ux;
-                y = uy;
-            }
-
-            pre_compute_map_x[h*_depth.width + w] = x;
-            pre_compute_map_y[h*_depth.width + w] = y;
-        }
-    }
-}
-
-void image_transform::align_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, int bpp, const rs2_intrinsics& depth, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
-{
-    switch (to.model)
-    {
-    case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
-        align_depth_to_other_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, dest, depth, to, from_to_other);
-        break;
-    default:
-        align_depth_to_other_sse(z_pixels, dest, depth, to, from_to_other);
-        break;
-    }
-}
-
-inline void image_transform::move_depth_to_other(const uint16_t* z_pixels, uint16_t* dest, const rs2_intrinsics& to,
-    const std::vector<librealsense::int2>& pixel_top_left_int,
-    const std::vector<librealsense::int2>& pixel_bottom_right_int)
-{
-    for (int y = 0; y < _depth.height; ++y)
-    {
-        for (int x = 0; x < _depth.width; ++x)
-        {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
-            {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
-                {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[other_ind] = dest[other_ind] ? std::min(dest[other_ind], z_pixels[depth_pixel_index]) : z_pixels[depth_pixel_index];
-                    }
-                }
-            }
-        }
-    }
-}
-
-void image_transform::align_other_to_depth(const uint16_t* z_pixels, const byte* source, byte* dest, int bpp, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
-{
-    switch (to.model)
-    {
-    case RS2_DISTORTION_MODIFIED_BROWN_CONRADY:
-    case RS2_DISTORTION_INVERSE_BROWN_CONRADY:
-        align_other_to_depth_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, source, dest, bpp, to, from_to_other);
-        break;
-    default:
-        align_other_to_depth_sse(z_pixels, source, dest, bpp, to, from_to_other);
-        break;
-    }
-}
-
-
-template<rs2_distortion dist>
-inline void image_transform::align_depth_to_other_sse(const uint16_t * z_pixels, uint16_t * dest, const rs2_intrinsics& depth, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
-{
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (byte*)_pixel_top_left_int.data(), to, from_to_other);
-
-    float fov[2];
-    rs2_fov(&depth, fov);
-    float2 pixels_per_angle_depth = { (float)depth.width / fov[0], (float)depth.height / fov[1] };
-
-    rs2_fov(&to, fov);
-    float2 pixels_per_angle_target = { (float)to.width / fov[0], (float)to.height / fov[1] };
-
-    if (pixels_per_angle_depth.x < pixels_per_angle_target.x || pixels_per_angle_depth.y < pixels_per_angle_target.y || is_special_resolution(depth, to))
-    {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (byte*)_pixel_bottom_right_int.data(), to, from_to_other);
-
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_bottom_right_int);
+        if (do_avx2)
+            get_texture_map_avx2<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels_ptr_int, to, from_to_other);
+        else
+            get_texture_map_sse<RS2_DISTORTION_MODIFIED_BROWN_CONRADY>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels_ptr_int, to, from_to_other);
     }
     else
     {
-        move_depth_to_other(z_pixels, dest, to, _pixel_top_left_int, _pixel_top_left_int);
-    }
-
-}
-
-template<rs2_distortion dist>
-inline void image_transform::align_other_to_depth_sse(const uint16_t * z_pixels, const byte * source, byte * dest, int bpp, const rs2_intrinsics& to,
-    const rs2_extrinsics& from_to_other)
-{
-    get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_top_left.data(),
-        _pre_compute_map_y_top_left.data(), (byte*)_pixel_top_left_int.data(), to, from_to_other);
-
-    std::vector<int2>& bottom_right = _pixel_top_left_int;
-    if (to.height < _depth.height && to.width < _depth.width)
-    {
-        get_texture_map_sse<dist>(z_pixels, _depth_scale, _depth.height*_depth.width, _pre_compute_map_x_bottom_right.data(),
-            _pre_compute_map_y_bottom_right.data(), (byte*)_pixel_bottom_right_int.data(), to, from_to_other);
-
-        bottom_right = _pixel_bottom_right_int;
-    }
-
-    switch (bpp)
-    {
-    case 1:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<1>*>(source), reinterpret_cast<bytes<1>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 2:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<2>*>(source), reinterpret_cast<bytes<2>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 3:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<3>*>(source), reinterpret_cast<bytes<3>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    case 4:
-        move_other_to_depth(z_pixels, reinterpret_cast<const bytes<4>*>(source), reinterpret_cast<bytes<4>*>(dest), to,
-            _pixel_top_left_int, bottom_right);
-        break;
-    default:
-        break;
-    }
-}
-
-template<class T >
-void image_transform::move_other_to_depth(const uint16_t* z_pixels,
-    const T* source,
-    T* dest, const rs2_intrinsics& to,
-    const std::vector<librealsense::int2>& pixel_top_left_int,
-    const std::vector<librealsense::int2>& pixel_bottom_right_int)
-{
-    // Iterate over the pixels of the depth image
-    for (int y = 0; y < _depth.height; ++y)
-    {
-        for (int x = 0; x < _depth.width; ++x)
-        {
-            auto depth_pixel_index = y * _depth.width + x;
-            // Skip over depth pixels with the value of zero, we have no depth data so we will not write anything into our aligned images
-            if (z_pixels[depth_pixel_index])
-            {
-                for (int other_y = pixel_top_left_int[depth_pixel_index].y; other_y <= pixel_bottom_right_int[depth_pixel_index].y; ++other_y)
-                {
-                    for (int other_x = pixel_top_left_int[depth_pixel_index].x; other_x <= pixel_bottom_right_int[depth_pixel_index].x; ++other_x)
-                    {
-                        if (other_x < 0 || other_y < 0 || other_x >= to.width || other_y >= to.height)
-                            continue;
-                        auto other_ind = other_y * to.width + other_x;
-
-                        dest[depth_pixel_index] = source[other_ind];
-                    }
-                }
-            }
-        }
+        if (do_avx2)
+            get_texture_map_avx2<RS2_DISTORTION_NONE>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels_ptr_int, to, from_to_other);
+        else
+            get_texture_map_sse<RS2_DISTORTION_NONE>(z_pixels, depth_scale, size, pre_compute_x, pre_compute_y, pixels_ptr_int, to, from_to_other);
     }
 }
 
@@ -418,7 +228,7 @@ void align_sse::align_z_to_other(rs2::video_frame& aligned, const rs2::video_fra
 
     if (_stream_transform == nullptr)
     {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
+        _stream_transform = std::make_shared<image_transform_sse>(z_intrin, z_scale);
         _stream_transform->pre_compute_x_y_map_corners();
     }
     _stream_transform->align_depth_to_other(z_pixels, reinterpret_cast<uint16_t*>(aligned_data), 2, z_intrin, other_intrin, z_to_other);
@@ -442,7 +252,7 @@ void align_sse::align_other_to_z(rs2::video_frame& aligned, const rs2::video_fra
 
     if (_stream_transform == nullptr)
     {
-        _stream_transform = std::make_shared<image_transform>(z_intrin, z_scale);
+        _stream_transform = std::make_shared<image_transform_sse>(z_intrin, z_scale);
         _stream_transform->pre_compute_x_y_map_corners();
     }
 
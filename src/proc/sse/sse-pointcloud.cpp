@@ -8,6 +8,7 @@
 #include "environment.h"
 #include "proc/occlusion-filter.h"
 #include "proc/sse/sse-pointcloud.h"
+#include "proc/sse/avx2-kernels.h"
 #include "option.h"
 #include "environment.h"
 #include "context.h"
@@ -26,33 +27,7 @@ namespace librealsense
 
     void pointcloud_sse::preprocess()
     {
-        _pre_compute_map_x.resize(_depth_intrinsics->width*_depth_intrinsics->height);
-        _pre_compute_map_y.resize(_depth_intrinsics->width*_depth_intrinsics->height);
-
-        for (int h = 0; h < _depth_intrinsics->height; ++h)
-        {
-            for (int w = 0; w < _depth_intrinsics->width; ++w)
-            {
-                const float pixel[] = { (float)w, (float)h };
-
-                float x = (pixel[0] - _depth_intrinsics->ppx) / _depth_intrinsics->fx;
-                float y = (pixel[1] - _depth_intrinsics->ppy) / _depth_intrinsics->fy;
-
-
-                if (_depth_intrinsics->model == RS2_DISTORTION_INVERSE_BROWN_CONRADY)
-                {
-                    float r2 = x * x + y * y;
-                    float f = 1 + _depth_intrinsics->coeffs[0] * r2 + _depth_intrinsics->coeffs[1] * r2*r2 + _depth_intrinsics->coeffs[4] * r2*r2*r2;
-                    float ux = x * f + 2 * _depth_intrinsics->coeffs[2] * x*y + _depth_intrinsics->coeffs[3] * (r2 + 2 * x*x);
-                    float uy = y * f + 2 * _depth_intrinsics->coeffs[3] * x*y + _depth_intrinsics->coeffs[2] * (r2 + 2 * y*y);
-                    x = ux;
-                    y = uy;
-                }
-
-                _pre_compute_map_x[h*_depth_intrinsics->width + w] = x;
-                _pre_compute_map_y[h*_depth_intrinsics->width + w] = y;
-            }
-        }
+        _pre_compute_map = deprojection_cache::get_instance().get(*_depth_intrinsics);
     }
 
     const float3* pointcloud_sse::depth_to_points(rs2::points output,
@@ -64,8 +39,8 @@ namespace librealsense
 
         auto depth_image = (const uint16_t*)depth_frame.get_data();
 
-        float* pre_compute_x = _pre_compute_map_x.data();
-        float* pre_compute_y = _pre_compute_map_y.data();
+        const float* pre_compute_x = _pre_compute_map->x.data();
+        const float* pre_compute_y = _pre_compute_map->y.data();
 
         uint32_t size = depth_intrinsics.height * depth_intrinsics.width;
 
@@ -90,7 +65,7 @@ namespace librealsense
             auto y0 = _mm_load_ps(mapy + i);
             auto y1 = _mm_load_ps(mapy + i + 4);
 
-            __m128i d = _mm_load_si128((__m128i const*)(depth_image + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
+            __m128i d = _mm_loadu_si128((__m128i const*)(depth_image + i));        //d7 d7 d6 d6 d5 d5 d4 d4 d3 d3 d2 d2 d1 d1 d0 d0
 
                                                                             //split the depth pixel to 2 registers of 4 floats each
             __m128i d0 = _mm_shuffle_epi8(d, mask0);        // 00 00 d3 d3 00 00 d2 d2 00 00 d1 d1 00 00 d0 d0
@@ -154,6 +129,13 @@ namespace librealsense
         auto res = reinterpret_cast<float*>(tex_ptr);
         auto res1 = reinterpret_cast<float*>(pixels_ptr);
 
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+        {
+            project_points_avx2(point, height*width, other_intrinsics, extr, res1, res);
+            return;
+        }
+
         __m128 r[9];
         __m128 t[3];
         __m128 c[5];
@@ -185,9 +167,9 @@ namespace librealsense
         for (auto i = 0UL; i < height*width * 3; i += 12)
         {
             //load 4 points (x,y,z)
-            auto xyz1 = _mm_load_ps(point + i);
-            auto xyz2 = _mm_load_ps(point + i + 4);
-            auto xyz3 = _mm_load_ps(point + i + 8);
+            auto xyz1 = _mm_loadu_ps(point + i);
+            auto xyz2 = _mm_loadu_ps(point + i + 4);
+            auto xyz3 = _mm_loadu_ps(point + i + 8);
 
 
             //gather x,y,z
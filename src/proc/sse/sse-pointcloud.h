@@ -3,6 +3,7 @@
 
 #pragma once
 #include "../pointcloud.h"
+#include "../deprojection-cache.h"
 
 namespace librealsense
 {
@@ -26,9 +27,6 @@ namespace librealsense
             const rs2_extrinsics& extr,
             float2* pixels_ptr) override;
 
-        std::vector<float> _pre_compute_map_x;
-        std::vector<float> _pre_compute_map_y;
-
-        void pre_compute_x_y_map();
+        std::shared_ptr<const deprojection_table> _pre_compute_map;
     };
 }
@@ -6,26 +6,23 @@
 #include "sync.h"
 #include "proc/synthetic-stream.h"
 #include "proc/syncer-processing-block.h"
+#include "environment.h"
 
 
 namespace librealsense
 {
-    syncer_process_unit::syncer_process_unit( std::initializer_list< bool_option::ptr > enable_opts )
-        : processing_block("syncer"), _matcher((new timestamp_composite_matcher({})))
+    syncer_process_unit::syncer_process_unit( std::initializer_list< bool_option::ptr > enable_opts,
+        std::unique_ptr< timestamp_composite_matcher > matcher )
+        : processing_block("syncer"), _matcher(matcher ? std::move(matcher) : std::unique_ptr<timestamp_composite_matcher>(new timestamp_composite_matcher({})))
         , _enable_opts( enable_opts.begin(), enable_opts.end() )
     {
+        register_option(RS2_OPTION_SYNC_LATENCY_BUDGET, std::make_shared<ptr_option<float>>(0.f, 1000.f, 1.f, 0.f, &_latency_budget_ms,
+            "Longest time in milliseconds a frame waits for the missing streams before a partial frameset is emitted, 0 waits as long as the sync heuristics require"));
+
         _matcher->set_callback([this](frame_holder f, syncronization_environment env)
         {
-            std::stringstream ss;
-            ss << "SYNCED: ";
-            auto composite = dynamic_cast<composite_frame*>(f.frame);
-            for (int i = 0; i < composite->get_embedded_frames_count(); i++)
-            {
-                auto matched = composite->get_frame(i);
-                ss << matched->get_stream()->get_stream_type() << " " << matched->get_frame_number() << ", "<<std::fixed<< matched->get_frame_timestamp()<<" ";
-            }
-
-            LOG_DEBUG(ss.str());
+            LOG_DEBUG("SYNCED: " << frame_log{ f.frame });
+            trace_frame(f.frame, RS2_FRAME_TRACE_STAGE_SYNCER_EMIT);
             env.matches.enqueue(std::move(f));
         });
 
@@ -53,15 +50,17 @@ namespace librealsense
                 return;
             }
 
-            single_consumer_frame_queue<frame_holder> matches;
+            // The matches are delivered after the lock is released, the ring lives on the stack of the calling thread
+            matcher_frames matches;
 
             {
                 std::lock_guard<std::mutex> lock(_mutex);
-                _matcher->dispatch(std::move(frame), { source, matches });
+                auto now = environment::get_instance().get_time_service()->get_time();
+                _matcher->dispatch(std::move(frame), { source, matches, now, _latency_budget_ms });
             }
 
             frame_holder f;
-            while (matches.try_dequeue(&f))
+            while (matches.dequeue(&f))
                 get_source().frame_ready(std::move(f));
 
         };
@@ -69,4 +68,10 @@ namespace librealsense
         set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
             new internal_frame_processor_callback<decltype(f)>(f)));
     }
+
+    std::shared_ptr< syncer_process_unit > syncer_process_unit::create_multi_device( double tolerance_ms )
+    {
+        std::unique_ptr< timestamp_composite_matcher > matcher( new global_timestamp_composite_matcher( {}, tolerance_ms ) );
+        return std::make_shared< syncer_process_unit >( std::initializer_list< bool_option::ptr >{}, std::move( matcher ) );
+    }
 }
@@ -19,11 +19,15 @@ namespace librealsense
     class syncer_process_unit : public processing_block
     {
     public:
-        syncer_process_unit( std::initializer_list< bool_option::ptr > enable_opts );
+        syncer_process_unit( std::initializer_list< bool_option::ptr > enable_opts,
+            std::unique_ptr< timestamp_composite_matcher > matcher = nullptr );
 
         syncer_process_unit( bool_option::ptr is_enabled_opt = nullptr )
             : syncer_process_unit( { is_enabled_opt } ) {}
 
+        // Syncs the frames of several devices on the host clock, see global_timestamp_composite_matcher
+        static std::shared_ptr< syncer_process_unit > create_multi_device( double tolerance_ms );
+
         void add_enabling_option( bool_option::ptr is_enabled_opt )
         {
             _enable_opts.push_back( is_enabled_opt );
@@ -36,5 +40,6 @@ namespace librealsense
     private:
         std::unique_ptr<timestamp_composite_matcher> _matcher;
         std::vector< std::weak_ptr<bool_option> > _enable_opts;
+        float _latency_budget_ms = 0.f;
     };
 }
@@ -6,11 +6,108 @@
 #include "core/video.h"
 #include "option.h"
 #include "context.h"
+#include "archive.h"
 #include "stream.h"
 #include "types.h"
+#include "profiler.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 namespace librealsense
 {
+    processing_executor& processing_executor::get_instance()
+    {
+        static processing_executor instance;
+        return instance;
+    }
+
+    processing_executor::~processing_executor()
+    {
+        stop_workers();
+    }
+
+    void processing_executor::configure(unsigned int workers, const std::vector<int>& cpus)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto&& worker : _workers)
+                if (worker.get_id() == std::this_thread::get_id())
+                    throw wrong_api_call_sequence_exception("The processing executor cannot be configured from a block running on it");
+        }
+        stop_workers();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _workers_count = workers;
+        _cpus = cpus;
+    }
+
+    void processing_executor::post(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_workers.empty())
+                start_workers();
+            _tasks.push_back(std::move(task));
+        }
+        _cv.notify_one();
+    }
+
+    void processing_executor::start_workers()
+    {
+        auto count = _workers_count ? _workers_count : std::max(1u, std::thread::hardware_concurrency());
+        _stopping = false;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            auto cpu = _cpus.empty() ? -1 : _cpus[i % _cpus.size()];
+            _workers.emplace_back([this, cpu]()
+            {
+                // The CPUs given to configure() take precedence over the CPUs of the processing role
+                apply_thread_policy(RS2_THREAD_ROLE_PROCESSING);
+                if (cpu >= 0)
+                {
+#ifdef __linux__
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    CPU_SET(cpu, &set);
+                    if (sched_setaffinity(0, sizeof(set), &set))
+                        LOG_WARNING("Failed to pin processing worker to CPU " << cpu);
+#else
+                    LOG_WARNING("Processing worker CPU affinity is not supported on this platform");
+#endif
+                }
+
+                std::unique_lock<std::mutex> lock(_mutex);
+                while (true)
+                {
+                    _cv.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                    if (_tasks.empty())
+                        return;
+
+                    auto task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                    lock.unlock();
+                    task();
+                    lock.lock();
+                }
+            });
+        }
+    }
+
+    void processing_executor::stop_workers()
+    {
+        std::vector<std::thread> workers;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+            workers.swap(_workers);
+        }
+        _cv.notify_all();
+        for (auto&& worker : workers)
+            worker.join();
+    }
+
     void processing_block::set_processing_callback(frame_processor_callback_ptr callback)
     {
         std::lock_guard<std::mutex> lock(_mutex);
@@ -23,24 +120,77 @@ namespace librealsense
     }
 
     processing_block::processing_block(const char* name) :
-        _source_wrapper(_source)
+        _source_wrapper(_source), _trace_name(get_trace_name(name))
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
         register_info(RS2_CAMERA_INFO_NAME, name);
         _source.init(std::shared_ptr<metadata_parser_map>());
+        _source_wrapper.set_trace_name(_trace_name);
+    }
+
+    void processing_block::set_async(bool async)
+    {
+        _async = async;
+        if (!async)
+        {
+            // Let any frame that is already queued finish before the block is used inline again
+            std::unique_lock<std::mutex> lock(_pending_mutex);
+            _pending_cv.wait(lock, [this]() { return !_draining; });
+        }
     }
 
     void processing_block::invoke(frame_holder f)
     {
+        if (_async)
+        {
+            std::lock_guard<std::mutex> lock(_pending_mutex);
+            _pending.push_back(std::move(f));
+            if (!_draining)
+            {
+                _draining = true;
+                processing_executor::get_instance().post([this]() { drain_pending(); });
+            }
+            return;
+        }
+
+        process(std::move(f));
+    }
+
+    void processing_block::drain_pending()
+    {
+        std::unique_lock<std::mutex> lock(_pending_mutex);
+        while (!_pending.empty())
+        {
+            auto f = std::move(_pending.front());
+            _pending.pop_front();
+            lock.unlock();
+            process(std::move(f));
+            lock.lock();
+        }
+        _draining = false;
+        _pending_cv.notify_all();
+    }
+
+    void processing_block::process(frame_holder f)
+    {
+        LRS_PROFILE_ZONE_NAMED("processing_block::invoke", _trace_name);
         auto callback = _source.begin_callback();
         try
         {
             if (_callback)
             {
+                trace_frame(f.frame, RS2_FRAME_TRACE_STAGE_BLOCK_BEGIN, _trace_name);
                 frame_interface* ptr = nullptr;
                 std::swap(f.frame, ptr);
 
+                processing_timer timer;
                 _callback->on_frame((rs2_frame*)ptr, _source_wrapper.get_c_wrapper());
+                auto elapsed = timer.get_elapsed_ms();
+
+                std::lock_guard<std::mutex> lock(_metrics_mutex);
+                ++_metrics.frames;
+                _metrics.total_time_ms += elapsed;
+                _metrics.max_time_ms = std::max(_metrics.max_time_ms, elapsed);
             }
         }
         catch (std::exception const & e)
@@ -53,6 +203,12 @@ namespace librealsense
         }
     }
 
+    rs2_processing_block_metrics processing_block::get_metrics() const
+    {
+        std::lock_guard<std::mutex> lock(_metrics_mutex);
+        return _metrics;
+    }
+
     generic_processing_block::generic_processing_block(const char* name)
         : processing_block(name)
     {
@@ -60,33 +216,48 @@ namespace librealsense
         {
             std::lock_guard<std::mutex> lock(_mutex);
 
-            std::vector<rs2::frame> frames_to_process;
-
-            frames_to_process.push_back(f);
-            if (auto composite = f.as<rs2::frameset>())
-                for (auto f : composite)
-                    frames_to_process.push_back(f);
-
             std::vector<rs2::frame> results;
-            for (auto f : frames_to_process)
+            auto add_result = [&results](const rs2::frame& res)
+            {
+                if (auto composite = res.as<rs2::frameset>())
+                {
+                    for (auto f : composite)
+                        if (f)
+                            results.push_back(f);
+                }
+                else
+                {
+                    results.push_back(res);
+                }
+            };
+
+            if (!f.is<rs2::frameset>())
             {
+                // A single frame is processed without taking other references to it, see reuse_input_frame
                 if (should_process(f))
+                    if (auto res = process_frame(source, f))
+                        add_result(res);
+            }
+            else
+            {
+                std::vector<rs2::frame> frames_to_process;
+
+                frames_to_process.push_back(f);
+                if (auto composite = f.as<rs2::frameset>())
+                    for (auto f : composite)
+                        frames_to_process.push_back(f);
+
+                for (auto f : frames_to_process)
                 {
-                    auto res = process_frame(source, f);
-                    if (!res) continue;
-                    if (auto composite = res.as<rs2::frameset>())
+                    if (should_process(f))
                     {
-                        for (auto f : composite)
-                            if (f)
-                                results.push_back(f);
+                        auto res = process_frame(source, f);
+                        if (!res) continue;
+                        add_result(res);
+                        //if frame was processed as frameset, don't process single frames
+                        if (f.is<rs2::frameset>())
+                            break;
                     }
-                    else
-                    {
-                        results.push_back(res);
-                    }
-                    //if frame was processed as frameset, don't process single frames
-                    if (f.is<rs2::frameset>())
-                        break;
                 }
             }
 
@@ -99,6 +270,20 @@ namespace librealsense
         processing_block::set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(callback));
     }
 
+    rs2::frame generic_processing_block::reuse_input_frame(const rs2::frame& f, const rs2::stream_profile& target_profile) const
+    {
+        auto fr = dynamic_cast<frame*>((frame_interface*)f.get());
+        if (!fr || !fr->is_writable())
+            return rs2::frame{};
+
+        auto target = std::dynamic_pointer_cast<stream_profile_interface>(target_profile.get()->profile->shared_from_this());
+        if (!target)
+            return rs2::frame{};
+
+        fr->set_stream(target);
+        return f;
+    }
+
     rs2::frame generic_processing_block::prepare_output(const rs2::frame_source& source, rs2::frame input, std::vector<rs2::frame> results)
     {
         // this function prepares the processing block output frame(s) by the following heuristic:
@@ -242,10 +427,29 @@ namespace librealsense
             if (f.supports_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE))
                 raw_size = static_cast<int>(f.get_frame_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE));
         }
+        auto dest = (byte*)ret.get_data();
+        auto actual_size = height * width * _target_bpp;
+
+        if (vf && _deferred_processing)
+        {
+            if (auto target = dynamic_cast<frame*>((frame_interface*)ret.get()))
+            {
+                // The pending conversion holds the source frame and the block until it runs or the target is released
+                auto self = shared_from_this();
+                rs2::frame source_frame = f;
+                target->defer_processing([self, source_frame, dest, width, height, actual_size, raw_size]()
+                {
+                    byte* planes[1] = { dest };
+                    self->process_function(planes, static_cast<const byte*>(source_frame.get_data()), width, height, actual_size, raw_size);
+                });
+                return ret;
+            }
+        }
+
         byte* planes[1];
-        planes[0] = (byte*)ret.get_data();
+        planes[0] = dest;
 
-        process_function(planes, static_cast<const byte*>(f.get_data()), width, height, height * width * _target_bpp, raw_size);
+        process_function(planes, static_cast<const byte*>(f.get_data()), width, height, actual_size, raw_size);
 
         return ret;
     }
@@ -311,12 +515,37 @@ namespace librealsense
         return _stream_filter.match(frame);
     }
 
+    // Time spent by the thread in frame_ready() since the innermost processing_timer was created
+    static thread_local double downstream_ms = 0;
+
+    processing_timer::processing_timer()
+        : _start(std::chrono::high_resolution_clock::now()), _outer_downstream_ms(downstream_ms)
+    {
+        downstream_ms = 0;
+    }
+
+    processing_timer::~processing_timer()
+    {
+        // the time of this scope is already counted by the frame_ready() of the outer timer, if it runs inside one
+        downstream_ms = _outer_downstream_ms;
+    }
+
+    double processing_timer::get_elapsed_ms() const
+    {
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _start).count();
+        return std::max(0., elapsed - downstream_ms);
+    }
+
     void synthetic_source::frame_ready(frame_holder result)
     {
+        trace_frame(result.frame, RS2_FRAME_TRACE_STAGE_BLOCK_END, _trace_name);
+        auto start = std::chrono::high_resolution_clock::now();
         _actual_source.invoke_callback(std::move(result));
+        downstream_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
     }
 
-    frame_interface* synthetic_source::allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original, rs2_extension frame_type)
+    frame_interface* synthetic_source::allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original, rs2_extension frame_type,
+        int vertex_count, bool colors)
     {
         auto vid_stream = dynamic_cast<video_stream_profile_interface*>(stream.get());
         if (vid_stream)
@@ -328,8 +557,17 @@ namespace librealsense
             data.metadata_size = 0;
             data.system_time = _actual_source.get_time();
             data.is_blocking = original->is_blocking();
+            data.points_colors = colors;
+            if (auto of = dynamic_cast<frame*>(original))
+            {
+                data.trace = of->additional_data.trace;
+                data.trace.derive();
+            }
 
-            auto res = _actual_source.alloc_frame(frame_type, vid_stream->get_width() * vid_stream->get_height() * sizeof(float) * 5, data, true);
+            if (vertex_count < 0)
+                vertex_count = vid_stream->get_width() * vid_stream->get_height();
+            auto point_size = sizeof(float) * 5 + (colors ? sizeof(uint32_t) : 0);
+            auto res = _actual_source.alloc_frame(frame_type, vertex_count * point_size, data, true);
             if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
             res->set_sensor(original->get_sensor());
             res->set_stream(stream);
@@ -390,6 +628,7 @@ namespace librealsense
 
         auto of = dynamic_cast<frame*>(original);
         frame_additional_data data = of->additional_data;
+        data.trace.derive();
         auto res = _actual_source.alloc_frame(frame_type, stride * height, data, true);
         if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
         vf = dynamic_cast<video_frame*>(res);
@@ -413,6 +652,7 @@ namespace librealsense
     {
         auto of = dynamic_cast<frame*>(original);
         frame_additional_data data = of->additional_data;
+        data.trace.derive();
         auto res = _actual_source.alloc_frame(frame_type, of->get_frame_data_size(), data, true);
         if (!res) throw wrong_api_call_sequence_exception("Out of frame resources!");
         auto mf = dynamic_cast<motion_frame*>(res);
@@ -451,7 +691,7 @@ namespace librealsense
         }
     }
 
-    frame_interface* synthetic_source::allocate_composite_frame(std::vector<frame_holder> holders)
+    frame_interface* synthetic_source::allocate_composite_frame(std::vector<frame_holder>&& holders)
     {
         frame_additional_data d{};
 
@@ -520,6 +760,7 @@ namespace librealsense
 
     void composite_processing_block::add(std::shared_ptr<processing_block> block)
     {
+        block->set_async(_async);
         _processing_blocks.push_back(block);
 
         const auto&& supported_options = block->get_supported_options();
@@ -554,6 +795,22 @@ namespace librealsense
         _processing_blocks.front()->invoke(std::move(frames));
     }
 
+    composite_processing_block::~composite_processing_block()
+    {
+        // The blocks of the chain are whole here, their queued frames finish before they are released
+        for (auto&& block : _processing_blocks)
+            block->stop();
+        _source.flush();
+    }
+
+    void composite_processing_block::set_async(bool async)
+    {
+        // Each stage of the chain runs as its own block, so consecutive frames are pipelined across the workers
+        _async = async;
+        for (auto&& block : _processing_blocks)
+            block->set_async(async);
+    }
+
     interleaved_functional_processing_block::interleaved_functional_processing_block(const char* name,
         rs2_format source_format,
         rs2_format left_target_format,
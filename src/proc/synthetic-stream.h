@@ -9,8 +9,52 @@
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 #include "../include/librealsense2/hpp/rs_processing.hpp"
 
+#include <deque>
+
 namespace librealsense
 {
+    // Shared pool of worker threads running the processing blocks that were switched to asynchronous invocation
+    // Workers are started lazily on the first posted task
+    class processing_executor
+    {
+    public:
+        static processing_executor& get_instance();
+
+        // workers == 0 selects the number of hardware threads. Workers are pinned to cpus round-robin, when given.
+        // Joins the running workers, so it cannot be called from a processing block running on them
+        void configure(unsigned int workers, const std::vector<int>& cpus);
+        void post(std::function<void()> task);
+
+        ~processing_executor();
+
+    private:
+        processing_executor() = default;
+        void start_workers();
+        void stop_workers();
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<std::function<void()>> _tasks;
+        std::vector<std::thread> _workers;
+        unsigned int _workers_count = 0;
+        std::vector<int> _cpus;
+        bool _stopping = false;
+    };
+
+    // Time spent by the thread since the timer was created, minus the time spent in the frame_ready() calls made meanwhile.
+    // Timing a processing block with it excludes the blocks and callbacks downstream of it, which run inside frame_ready()
+    class processing_timer
+    {
+    public:
+        processing_timer();
+        ~processing_timer();
+        double get_elapsed_ms() const;
+
+    private:
+        std::chrono::high_resolution_clock::time_point _start;
+        double _outer_downstream_ms;
+    };
+
     class synthetic_source : public synthetic_source_interface
     {
     public:
@@ -31,18 +75,22 @@ namespace librealsense
             frame_interface* original,
             rs2_extension frame_type = RS2_EXTENSION_MOTION_FRAME) override;
 
-        frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) override;
+        frame_interface* allocate_composite_frame(std::vector<frame_holder>&& frames) override;
 
         frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, 
-            frame_interface* original, rs2_extension frame_type = RS2_EXTENSION_POINTS) override;
+            frame_interface* original, rs2_extension frame_type = RS2_EXTENSION_POINTS, int vertex_count = -1, bool colors = false) override;
 
         void frame_ready(frame_holder result) override;
 
         rs2_source* get_c_wrapper() override { return _c_wrapper.get(); }
 
+        // Name of the processing block in the frame trace, stamped on the frames it delivers
+        void set_trace_name(const char* name) { _trace_name = name; }
+
     private:
         frame_source & _actual_source;
         std::shared_ptr<rs2_source> _c_wrapper;
+        const char* _trace_name = nullptr;
     };
 
     class LRS_EXTENSION_API processing_block : public processing_block_interface, public options_container, public info_container
@@ -54,13 +102,40 @@ namespace librealsense
         void set_output_callback(frame_callback_ptr callback) override;
         void invoke(frame_holder frames) override;
         synthetic_source_interface& get_source() override { return _source_wrapper; }
+        void set_frame_allocator(frame_allocator_ptr allocator) { _source.set_frame_allocator(std::move(allocator)); }
+        void set_memory_counter(std::shared_ptr<memory_counter> counter) { _source.set_memory_counter(std::move(counter)); }
+
+        // When asynchronous, invoke() queues the frame and returns, and the block runs on the processing_executor.
+        // The frames given to a block are always processed one at a time, in the order they were invoked
+        virtual void set_async(bool async);
+        bool is_async() const { return _async; }
+
+        // Finishes the frames queued for the executor and returns the block to inline invocation. The owner of an asynchronous
+        // block stops it before releasing it: by the time ~processing_block runs, the members of the derived blocks that the
+        // queued frames use are gone
+        void stop() { set_async(false); }
+
+        rs2_processing_block_metrics get_metrics() const;
 
         virtual ~processing_block() { _source.flush(); }
     protected:
+        void process(frame_holder frames);
+        void drain_pending();
+
         frame_source _source;
         std::mutex _mutex;
         frame_processor_callback_ptr _callback;
         synthetic_source _source_wrapper;
+        const char* _trace_name;
+
+        std::atomic<bool> _async{ false };
+        std::mutex _pending_mutex;
+        std::condition_variable _pending_cv;
+        std::deque<frame_holder> _pending;
+        bool _draining = false;
+
+        mutable std::mutex _metrics_mutex;
+        rs2_processing_block_metrics _metrics = {};
     };
 
     class LRS_EXTENSION_API generic_processing_block : public processing_block
@@ -72,6 +147,11 @@ namespace librealsense
     protected:
         virtual rs2::frame prepare_output(const rs2::frame_source& source, rs2::frame input, std::vector<rs2::frame> results);
 
+        // The input frame moved to the target profile, for a block to write its output over the input, when the block holds
+        // the only reference to a single input frame. An empty frame otherwise, and the block allocates its output frame.
+        // The target profile must have the format and the dimensions of the input
+        rs2::frame reuse_input_frame(const rs2::frame& f, const rs2::stream_profile& target_profile) const;
+
         virtual bool should_process(const rs2::frame& frame) = 0;
         virtual rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) = 0;
     };
@@ -139,11 +219,16 @@ namespace librealsense
     };
 
     // process frames with a given function
-    class LRS_EXTENSION_API functional_processing_block : public stream_filter_processing_block
+    class LRS_EXTENSION_API functional_processing_block : public stream_filter_processing_block,
+        public std::enable_shared_from_this<functional_processing_block>
     {
     public:
         functional_processing_block(const char* name, rs2_format target_format, rs2_stream target_stream = RS2_STREAM_ANY, rs2_extension extension_type = RS2_EXTENSION_VIDEO_FRAME);
 
+        // Converts video frames on their first access instead of on arrival, see frame::defer_processing.
+        // The block must be owned by a shared_ptr, which the pending frames hold
+        void set_deferred_processing(bool deferred) { _deferred_processing = deferred; }
+
     protected:
         virtual void init_profiles_info(const rs2::frame* f);
         rs2::frame process_frame(const rs2::frame_source & source, const rs2::frame & f) override;
@@ -156,6 +241,7 @@ namespace librealsense
         rs2_stream _target_stream;
         rs2_extension _extension_type;
         int _target_bpp = 0;
+        std::atomic_bool _deferred_processing{ false };
     };
 
     // process interleaved frames with a given function
@@ -245,12 +331,13 @@ namespace librealsense
 
         composite_processing_block();
         composite_processing_block(const char* name);
-        virtual ~composite_processing_block() { _source.flush(); };
+        virtual ~composite_processing_block();
 
         processing_block& get(rs2_option option);
         void add(std::shared_ptr<processing_block> block);
         void set_output_callback(frame_callback_ptr callback) override;
         void invoke(frame_holder frames) override;
+        void set_async(bool async) override;
 
     protected:
         std::vector<std::shared_ptr<processing_block>> _processing_blocks;
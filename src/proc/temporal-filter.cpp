@@ -10,6 +10,10 @@
 #include "proc/synthetic-stream.h"
 #include "proc/temporal-filter.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
 namespace librealsense
 {
     const size_t PERSISTENCE_MAP_NUM = 9;
@@ -122,6 +126,100 @@ namespace librealsense
         return tgt;
     }
 
+    int temporal_filter::temp_jw_smooth_z16(uint16_t* frame, uint16_t* last_frame, uint8_t* history)
+    {
+        int blocks = 0;
+
+#ifdef __SSSE3__
+        const uint8_t mask = 1 << _cur_frame_index;
+
+        // Pack the history values that are credible in the current phase into a 256-bit map, so that
+        // sixteen history bytes can be classified with a couple of byte shuffles
+        alignas(16) uint8_t credible[32] = {};
+        for (int i = 0; i < 256; i++)
+            if (_persistence_map[i] & mask)
+                credible[i >> 3] |= 1 << (i & 7);
+
+        const __m128i credible_lo = _mm_load_si128(reinterpret_cast<const __m128i*>(credible));
+        const __m128i credible_hi = _mm_load_si128(reinterpret_cast<const __m128i*>(credible + 16));
+        const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+        const __m128i seven = _mm_set1_epi8(7);
+        const __m128i fifteen = _mm_set1_epi8(15);
+        const __m128i index_mask = _mm_set1_epi8(0x1f);
+        const __m128i phase = _mm_set1_epi8(static_cast<char>(mask));
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(-1);
+        const __m128i delta_z = _mm_set1_epi16(_delta_param);
+        const __m128 alpha = _mm_set1_ps(_alpha_param);
+        const __m128 one_minus_alpha = _mm_set1_ps(_one_minus_alpha);
+
+        blocks = static_cast<int>(_current_frm_size_pixels / 16);
+
+#pragma omp parallel for schedule(static)
+        for (int b = 0; b < blocks; b++)
+        {
+            auto cur_ptr = reinterpret_cast<__m128i*>(frame + b * 16);
+            auto prev_ptr = reinterpret_cast<__m128i*>(last_frame + b * 16);
+            auto hist_ptr = reinterpret_cast<__m128i*>(history + b * 16);
+
+            __m128i hist = _mm_loadu_si128(hist_ptr);
+
+            // credible[hist >> 3] & (1 << (hist & 7)) for every history byte
+            __m128i index = _mm_and_si128(_mm_srli_epi16(hist, 3), index_mask);
+            __m128i upper = _mm_cmpgt_epi8(index, fifteen);
+            __m128i word = _mm_or_si128(_mm_and_si128(upper, _mm_shuffle_epi8(credible_hi, index)),
+                                        _mm_andnot_si128(upper, _mm_shuffle_epi8(credible_lo, index)));
+            __m128i bit = _mm_shuffle_epi8(bits, _mm_and_si128(hist, seven));
+            __m128i is_credible = _mm_cmpeq_epi8(_mm_and_si128(word, bit), bit);
+
+            __m128i agree_bytes[2], cur_bytes[2];
+            for (int h = 0; h < 2; h++)
+            {
+                __m128i cur = _mm_loadu_si128(cur_ptr + h);
+                __m128i prev = _mm_loadu_si128(prev_ptr + h);
+
+                __m128i cur_valid = _mm_xor_si128(_mm_cmpeq_epi16(cur, zero), ones);
+                __m128i prev_valid = _mm_xor_si128(_mm_cmpeq_epi16(prev, zero), ones);
+                __m128i diff = _mm_or_si128(_mm_subs_epu16(cur, prev), _mm_subs_epu16(prev, cur));
+                __m128i agree = _mm_and_si128(_mm_and_si128(cur_valid, prev_valid),
+                                              _mm_xor_si128(_mm_cmpeq_epi16(_mm_subs_epu16(delta_z, diff), zero), ones));
+
+                // alpha * cur + (1 - alpha) * prev, truncated as in the scalar implementation
+                __m128 lo = _mm_add_ps(_mm_mul_ps(alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(cur, zero))),
+                                       _mm_mul_ps(one_minus_alpha, _mm_cvtepi32_ps(_mm_unpacklo_epi16(prev, zero))));
+                __m128 hi = _mm_add_ps(_mm_mul_ps(alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(cur, zero))),
+                                       _mm_mul_ps(one_minus_alpha, _mm_cvtepi32_ps(_mm_unpackhi_epi16(prev, zero))));
+                const __m128i bias = _mm_set1_epi32(0x8000);
+                __m128i filtered = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(_mm_cvttps_epi32(lo), bias),
+                                                                 _mm_sub_epi32(_mm_cvttps_epi32(hi), bias)), _mm_set1_epi16(-0x8000));
+
+                // Holes are filled from the last frame when the pixel history is credible enough
+                __m128i credible_words = h ? _mm_unpackhi_epi8(is_credible, is_credible) : _mm_unpacklo_epi8(is_credible, is_credible);
+                __m128i fill = _mm_andnot_si128(cur_valid, _mm_and_si128(prev_valid, credible_words));
+
+                __m128i out = _mm_or_si128(_mm_and_si128(agree, filtered), _mm_andnot_si128(agree, cur));
+                out = _mm_or_si128(out, _mm_and_si128(fill, prev));
+                __m128i last = _mm_or_si128(_mm_and_si128(agree, filtered),
+                                            _mm_andnot_si128(agree, _mm_or_si128(_mm_and_si128(cur_valid, cur), _mm_andnot_si128(cur_valid, prev))));
+
+                _mm_storeu_si128(cur_ptr + h, out);
+                _mm_storeu_si128(prev_ptr + h, last);
+
+                agree_bytes[h] = agree;
+                cur_bytes[h] = cur_valid;
+            }
+
+            // agreeing pixels add the current phase, other valid pixels restart the history, holes clear it
+            __m128i agree = _mm_packs_epi16(agree_bytes[0], agree_bytes[1]);
+            __m128i cur_valid = _mm_packs_epi16(cur_bytes[0], cur_bytes[1]);
+            __m128i updated = _mm_or_si128(_mm_and_si128(agree, _mm_or_si128(hist, phase)),
+                                           _mm_andnot_si128(agree, _mm_and_si128(cur_valid, phase)));
+            updated = _mm_or_si128(updated, _mm_andnot_si128(cur_valid, _mm_andnot_si128(phase, hist)));
+            _mm_storeu_si128(hist_ptr, updated);
+        }
+#endif
+        return blocks * 16;
+    }
 
     void temporal_filter::on_set_persistence_control(uint8_t val)
     {
@@ -159,25 +257,39 @@ namespace librealsense
             _target_stream_profile = _source_stream_profile.clone(RS2_STREAM_DEPTH, 0, _source_stream_profile.format());
 
             //TODO - reject any frame other than depth/disparity
-            _extension_type = f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME;
-            _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
             auto vp = _target_stream_profile.as<rs2::video_stream_profile>();
-            _width = vp.width();
-            _height = vp.height();
-            _stride = _width*_bpp;
-            _current_frm_size_pixels = _width * _height;
 
-            _last_frame.clear();
-            _last_frame.resize(_current_frm_size_pixels*_bpp);
+            // a new profile restarts the history, even with the same dimensions
+            _width = 0;
+            configure(vp.width(), vp.height(), f.is<rs2::disparity_frame>() ? RS2_EXTENSION_DISPARITY_FRAME : RS2_EXTENSION_DEPTH_FRAME);
+        }
+    }
+
+    void temporal_filter::configure(size_t width, size_t height, rs2_extension extension_type)
+    {
+        if (width == _width && height == _height && extension_type == _extension_type && !_last_frame.empty())
+            return;
 
-            _history.clear();
-            _history.resize(_current_frm_size_pixels*_bpp);
+        _extension_type = extension_type;
+        _bpp = (_extension_type == RS2_EXTENSION_DISPARITY_FRAME) ? sizeof(float) : sizeof(uint16_t);
+        _width = width;
+        _height = height;
+        _stride = _width*_bpp;
+        _current_frm_size_pixels = _width * _height;
 
-        }
+        _last_frame.clear();
+        _last_frame.resize(_current_frm_size_pixels*_bpp);
+
+        _history.clear();
+        _history.resize(_current_frm_size_pixels*_bpp);
     }
 
     rs2::frame temporal_filter::prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source)
     {
+        // The filter runs in place, on the input frame when no one else holds it
+        if (auto tgt = reuse_input_frame(f, _target_stream_profile))
+            return tgt;
+
         // Allocate and copy the content of the original Depth data to the target
         rs2::frame tgt = source.allocate_video_frame(_target_stream_profile, f, (int)_bpp, (int)_width, (int)_height, (int)_stride, _extension_type);
 
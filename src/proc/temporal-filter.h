@@ -3,6 +3,7 @@
 
 #pragma once
 #include "types.h"
+#include "memory-counter.h"
 
 namespace librealsense
 {
@@ -14,7 +15,11 @@ namespace librealsense
         temporal_filter();
 
     protected:
+        friend class depth_filter_chain;
+
         void    update_configuration(const rs2::frame& f);
+        // Sets the dimensions and the domain of the frames, a change restarts the history
+        void    configure(size_t width, size_t height, rs2_extension extension_type);
         rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
 
         rs2::frame prepare_target_frame(const rs2::frame& f, const rs2::frame_source& source);
@@ -33,8 +38,15 @@ namespace librealsense
 
             unsigned char mask = 1 << _cur_frame_index;
 
+            // Depth frames are processed in SIMD blocks, the remaining pixels are handled below
+            int first = 0;
+            if (!fp)
+                first = temp_jw_smooth_z16(reinterpret_cast<uint16_t*>(frame_data), reinterpret_cast<uint16_t*>(_last_frame_data), history);
+
             // pass one -- go through image and update all
-            for (size_t i = 0; i < _current_frm_size_pixels; i++)
+            const int pixels = static_cast<int>(_current_frm_size_pixels);
+#pragma omp parallel for schedule(static)
+            for (int i = first; i < pixels; i++)
             {
                 T cur_val = frame[i];
                 T prev_val = _last_frame[i];
@@ -83,6 +95,9 @@ namespace librealsense
             _cur_frame_index = (_cur_frame_index + 1) % 8;  // at end of cycle
         }
 
+        // Vectorized pass over Z16 frames. Returns the number of leading pixels that were processed
+        int temp_jw_smooth_z16(uint16_t* frame, uint16_t* last_frame, uint8_t* history);
+
     private:
         void on_set_persistence_control(uint8_t val);
         void on_set_alpha(float val);
@@ -100,8 +115,8 @@ namespace librealsense
         size_t                  _current_frm_size_pixels;
         rs2::stream_profile     _source_stream_profile;
         rs2::stream_profile     _target_stream_profile;
-        std::vector<uint8_t>    _last_frame;                // Hold the last frame received for the current profile
-        std::vector<uint8_t>    _history;                   // represents the history over the last 8 frames, 1 bit per frame
+        cache_vector<uint8_t>   _last_frame;                // Hold the last frame received for the current profile
+        cache_vector<uint8_t>   _history;                   // represents the history over the last 8 frames, 1 bit per frame
         uint8_t                 _cur_frame_index;
         // encodes whether a particular 8 bit history is good enough for all 8 phases of storage
         std::array<uint8_t, PRESISTENCY_LUT_SIZE> _persistence_map;
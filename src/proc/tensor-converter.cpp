@@ -0,0 +1,203 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+
+#include "proc/synthetic-stream.h"
+#include "proc/tensor-converter.h"
+#include "core/video.h"
+#include "option.h"
+#include "context.h"
+
+#include <cmath>
+
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#endif
+
+namespace librealsense
+{
+    // Input pixel and weight pairs of a bilinear resize of n input pixels to m, the centers of the pixels being aligned
+    static void resize_weights(int n, int m, cache_vector<int>& p0, cache_vector<int>& p1, cache_vector<float>& w)
+    {
+        p0.resize(m);
+        p1.resize(m);
+        w.resize(m);
+        const float ratio = float(n) / m;
+        for (int i = 0; i < m; i++)
+        {
+            float p = std::min(std::max((i + 0.5f) * ratio - 0.5f, 0.f), float(n - 1));
+            p0[i] = int(p);
+            p1[i] = std::min(p0[i] + 1, n - 1);
+            w[i] = p - p0[i];
+        }
+    }
+
+    // Resizes a row of the output channels of an input row to width floats per channel
+    static inline void resize_row(const uint8_t* src, int bpp, const int* channels, int width,
+        const int* x0, const int* x1, const float* wx, float* dst)
+    {
+        for (int c = 0; c < 3; c++)
+        {
+            auto s = src + channels[c];
+            auto d = dst + c * width;
+            for (int x = 0; x < width; x++)
+            {
+                float a = s[x0[x] * bpp], b = s[x1[x] * bpp];
+                d[x] = a + (b - a) * wx[x];
+            }
+        }
+    }
+
+    // Blends two resized rows by w and normalizes them to (value - mean) * scale
+    template<typename T>
+    static inline void blend_row(const float* a, const float* b, float w, float mean, float scale, int count, T* dst);
+
+    template<>
+    inline void blend_row<float>(const float* a, const float* b, float w, float mean, float scale, int count, float* dst)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        const __m128 mw = _mm_set1_ps(w), mmean = _mm_set1_ps(mean), mscale = _mm_set1_ps(scale);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 va = _mm_loadu_ps(a + i), vb = _mm_loadu_ps(b + i);
+            __m128 v = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), mw));
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_sub_ps(v, mmean), mscale));
+        }
+#endif
+        for (; i < count; i++)
+            dst[i] = (a[i] + (b[i] - a[i]) * w - mean) * scale;
+    }
+
+    template<>
+    inline void blend_row<uint8_t>(const float* a, const float* b, float w, float mean, float scale, int count, uint8_t* dst)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        const __m128 mw = _mm_set1_ps(w), mmean = _mm_set1_ps(mean), mscale = _mm_set1_ps(scale);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v[2];
+            for (int k = 0; k < 2; k++)
+            {
+                __m128 va = _mm_loadu_ps(a + i + 4 * k), vb = _mm_loadu_ps(b + i + 4 * k);
+                __m128 blended = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), mw));
+                v[k] = _mm_cvtps_epi32(_mm_mul_ps(_mm_sub_ps(blended, mmean), mscale));
+            }
+            // Saturated to 0..255 by the packs
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_setzero_si128());
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), packed);
+        }
+#endif
+        for (; i < count; i++)
+        {
+            float v = std::nearbyint((a[i] + (b[i] - a[i]) * w - mean) * scale);
+            dst[i] = uint8_t(std::min(std::max(v, 0.f), 255.f));
+        }
+    }
+
+    template<typename T>
+    static void convert(const uint8_t* src, int src_stride, int bpp, const int* channels, int width, int height,
+        const int* x0, const int* x1, const float* wx, const int* y0, const int* y1, const float* wy,
+        float mean, float scale, T* dst)
+    {
+#pragma omp parallel
+        {
+            // The two resized input rows of an output row, three channels each
+            std::vector<float> rows(6 * width);
+            auto above = rows.data(), below = rows.data() + 3 * width;
+
+#pragma omp for schedule(dynamic)
+            for (int y = 0; y < height; y++)
+            {
+                resize_row(src + y0[y] * src_stride, bpp, channels, width, x0, x1, wx, above);
+                resize_row(src + y1[y] * src_stride, bpp, channels, width, x0, x1, wx, below);
+                for (int c = 0; c < 3; c++)
+                    blend_row(above + c * width, below + c * width, wy[y], mean, scale, width, dst + (c * height + y) * width);
+            }
+        }
+    }
+
+    tensor_converter::tensor_converter()
+        : stream_filter_processing_block("Tensor Converter"), _width(300), _height(300), _mean(0.f), _scale(1.f),
+        _float_tensor(1), _bgr(0), _configured_width(0), _configured_height(0), _configured_float_tensor(0)
+    {
+        _stream_filter.stream = RS2_STREAM_COLOR;
+        _stream_filter.format = RS2_FORMAT_ANY;
+
+        register_option(RS2_OPTION_TENSOR_WIDTH, std::make_shared<ptr_option<int>>(1, 4096, 1, 300, &_width, "Width of the tensor"));
+        register_option(RS2_OPTION_TENSOR_HEIGHT, std::make_shared<ptr_option<int>>(1, 4096, 1, 300, &_height, "Height of the tensor"));
+        register_option(RS2_OPTION_TENSOR_MEAN, std::make_shared<ptr_option<float>>(0.f, 255.f, 0.5f, 0.f, &_mean, "Mean subtracted from the color values"));
+        register_option(RS2_OPTION_TENSOR_SCALE, std::make_shared<ptr_option<float>>(0.f, 255.f, 0.0001f, 1.f, &_scale, "Factor of the color values less the mean"));
+
+        auto float_tensor = std::make_shared<ptr_option<uint8_t>>(0, 1, 1, 1, &_float_tensor, "Type of the tensor");
+        float_tensor->set_description(0, "uint8");
+        float_tensor->set_description(1, "float");
+        register_option(RS2_OPTION_TENSOR_FLOAT, float_tensor);
+
+        auto bgr = std::make_shared<ptr_option<uint8_t>>(0, 1, 1, 0, &_bgr, "Order of the channels of the tensor");
+        bgr->set_description(0, "RGB");
+        bgr->set_description(1, "BGR");
+        register_option(RS2_OPTION_TENSOR_BGR, bgr);
+    }
+
+    bool tensor_converter::should_process(const rs2::frame& frame)
+    {
+        if (!stream_filter_processing_block::should_process(frame))
+            return false;
+        auto format = frame.get_profile().format();
+        return format == RS2_FORMAT_RGB8 || format == RS2_FORMAT_BGR8 || format == RS2_FORMAT_RGBA8 || format == RS2_FORMAT_BGRA8;
+    }
+
+    void tensor_converter::update_configuration(const rs2::frame& f)
+    {
+        if (f.get_profile().get() == _source_profile.get() &&
+            _width == _configured_width && _height == _configured_height && _float_tensor == _configured_float_tensor)
+            return;
+
+        _source_profile = f.get_profile();
+        _configured_width = _width;
+        _configured_height = _height;
+        _configured_float_tensor = _float_tensor;
+
+        auto video = f.as<rs2::video_frame>();
+        resize_weights(video.get_width(), _configured_width, _x0, _x1, _wx);
+        resize_weights(video.get_height(), _configured_height, _y0, _y1, _wy);
+
+        // The planes one below the other
+        _target_profile = std::make_shared<rs2::video_stream_profile>(_source_profile.clone(RS2_STREAM_COLOR,
+            _source_profile.stream_index(), _configured_float_tensor ? RS2_FORMAT_DISTANCE : RS2_FORMAT_Y8));
+        if (auto target = As<video_stream_profile_interface>(_target_profile->get()->profile))
+            target->set_dims(_configured_width, 3 * _configured_height);
+    }
+
+    rs2::frame tensor_converter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        update_configuration(f);
+
+        auto video = f.as<rs2::video_frame>();
+        auto format = video.get_profile().format();
+        int bpp = video.get_bytes_per_pixel();
+        bool bgr_input = format == RS2_FORMAT_BGR8 || format == RS2_FORMAT_BGRA8;
+        // The offset in an input pixel of every output channel
+        int channels[3] = { 0, 1, 2 };
+        if (bgr_input != (_bgr != 0))
+            std::swap(channels[0], channels[2]);
+
+        int width = _configured_width, height = _configured_height;
+        int element = _configured_float_tensor ? sizeof(float) : sizeof(uint8_t);
+        auto res = source.allocate_video_frame(*_target_profile, f, element, width, 3 * height, width * element, RS2_EXTENSION_VIDEO_FRAME);
+        auto dst = const_cast<void*>(res.get_data());
+
+        auto src = static_cast<const uint8_t*>(video.get_data());
+        if (_configured_float_tensor)
+            convert(src, video.get_stride_in_bytes(), bpp, channels, width, height,
+                _x0.data(), _x1.data(), _wx.data(), _y0.data(), _y1.data(), _wy.data(), _mean, _scale, static_cast<float*>(dst));
+        else
+            convert(src, video.get_stride_in_bytes(), bpp, channels, width, height,
+                _x0.data(), _x1.data(), _wx.data(), _y0.data(), _y1.data(), _wy.data(), _mean, _scale, static_cast<uint8_t*>(dst));
+        return res;
+    }
+}
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+
+namespace librealsense
+{
+    // Converts color to the input tensor of a network: resized bilinearly to the target size, normalized to
+    // (value - mean) * scale and laid out as planar channels (NCHW with N = 1), of float or of uint8.
+    // The output is a video frame of the target width and of three times the target height, the R, G and B planes
+    // (or B, G and R) one below the other, of RS2_FORMAT_DISTANCE for float and of RS2_FORMAT_Y8 for uint8.
+    // Every output row is resized, normalized and stored in a single pass over two input rows
+    class tensor_converter : public stream_filter_processing_block
+    {
+    public:
+        tensor_converter();
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        void update_configuration(const rs2::frame& f);
+
+        int _width;
+        int _height;
+        float _mean;
+        float _scale;
+        uint8_t _float_tensor;
+        uint8_t _bgr;
+
+        rs2::stream_profile _source_profile;
+        std::shared_ptr<rs2::video_stream_profile> _target_profile;
+        int _configured_width;
+        int _configured_height;
+        uint8_t _configured_float_tensor;
+
+        // Left and right input pixels and the weight of the right one of every output column, likewise for the rows
+        cache_vector<int> _x0;
+        cache_vector<int> _x1;
+        cache_vector<float> _wx;
+        cache_vector<int> _y0;
+        cache_vector<int> _y1;
+        cache_vector<float> _wy;
+    };
+}
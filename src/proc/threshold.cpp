@@ -11,8 +11,58 @@
 #include "threshold.h"
 #include "image.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 namespace librealsense
 {
+    // Keeps the depth in [min_dist, max_dist] meters and clears the rest, dest may be the input
+    static void threshold_depth(uint16_t* dest, const uint16_t* depth, float units, float min_dist, float max_dist, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = threshold_depth_avx2(dest, depth, units, min_dist, max_dist, count);
+
+        const auto u = _mm_set1_ps(units);
+        const auto mn = _mm_set1_ps(min_dist);
+        const auto mx = _mm_set1_ps(max_dist);
+        const auto zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+            auto lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(d, zero)), u);
+            auto hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(d, zero)), u);
+            auto keep_lo = _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(lo, mn), _mm_cmple_ps(lo, mx)));
+            auto keep_hi = _mm_castps_si128(_mm_and_ps(_mm_cmpge_ps(hi, mn), _mm_cmple_ps(hi, mx)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_and_si128(d, _mm_packs_epi32(keep_lo, keep_hi)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto mn = vdupq_n_f32(min_dist);
+        const auto mx = vdupq_n_f32(max_dist);
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = vld1q_u16(depth + i);
+            auto lo = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(d))), units);
+            auto hi = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(d))), units);
+            auto keep_lo = vmovn_u32(vandq_u32(vcgeq_f32(lo, mn), vcleq_f32(lo, mx)));
+            auto keep_hi = vmovn_u32(vandq_u32(vcgeq_f32(hi, mn), vcleq_f32(hi, mx)));
+            vst1q_u16(dest + i, vandq_u16(d, vcombine_u16(keep_lo, keep_hi)));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            auto dist = units * depth[i];
+            dest[i] = (dist >= min_dist && dist <= max_dist) ? depth[i] : 0;
+        }
+    }
+
     threshold::threshold() : stream_filter_processing_block("Threshold Filter"),_min(0.1f), _max(4.f)
     {
         _stream_filter.format = RS2_FORMAT_Z16;
@@ -43,6 +93,16 @@ namespace librealsense
             _target_stream_profile = f.get_profile().clone(RS2_STREAM_DEPTH, 0, RS2_FORMAT_Z16);
         }
 
+        // The out of range depth is cleared in place when no one else holds the input frame
+        if (auto tgt = reuse_input_frame(f, _target_stream_profile))
+        {
+            auto vf = tgt.as<rs2::depth_frame>();
+            auto pixels = vf.get_width() * vf.get_height();
+            auto depth_data = (uint16_t*)vf.get_data();
+            threshold_depth(depth_data, depth_data, vf.get_units(), _min, _max, pixels);
+            return tgt;
+        }
+
         auto vf = f.as<rs2::depth_frame>();
         auto width = vf.get_width();
         auto height = vf.get_height();
@@ -58,14 +118,7 @@ namespace librealsense
             auto new_data = (uint16_t*)ptr->get_frame_data();
 
             ptr->set_sensor(orig->get_sensor());
-            auto du = orig->get_units();
-
-            memset(new_data, 0, width * height * sizeof(uint16_t));
-            for (int i = 0; i < width * height; i++)
-            {
-                auto dist = du * depth_data[i];
-                if (dist >= _min && dist <= _max) new_data[i] = depth_data[i];
-            }
+            threshold_depth(new_data, depth_data, orig->get_units(), _min, _max, width * height);
 
             return new_f;
         }
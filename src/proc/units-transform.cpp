@@ -8,8 +8,44 @@
 #include "environment.h"
 #include "units-transform.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 namespace librealsense
 {
+    static void depth_to_meters(float* dest, const uint16_t* depth, float units, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = depth_to_meters_avx2(dest, depth, units, count);
+
+        const auto u = _mm_set1_ps(units);
+        const auto zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(d, zero)), u));
+            _mm_storeu_ps(dest + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(d, zero)), u));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = vld1q_u16(depth + i);
+            vst1q_f32(dest + i, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(d))), units));
+            vst1q_f32(dest + i + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(d))), units));
+        }
+#endif
+        for (; i < count; i++)
+            dest[i] = units * depth[i];
+    }
+
     units_transform::units_transform() : stream_filter_processing_block("Units Transform")
     {
         _stream_filter.format = RS2_FORMAT_DISTANCE;
@@ -64,12 +100,7 @@ namespace librealsense
 
             ptr->set_sensor(orig->get_sensor());
 
-            memset(new_data, 0, _width * _height * sizeof(float));
-            for (int i = 0; i < _width * _height; i++)
-            {
-                float dist = *_depth_units * depth_data[i];
-                new_data[i] = dist;
-            }
+            depth_to_meters(new_data, depth_data, *_depth_units, int(_width * _height));
 
             return new_f;
         }
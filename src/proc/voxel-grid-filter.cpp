@@ -0,0 +1,292 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "../include/librealsense2/hpp/rs_sensor.hpp"
+#include "../include/librealsense2/hpp/rs_processing.hpp"
+#include "../include/librealsense2/rsutil.h"
+
+#include "proc/synthetic-stream.h"
+#include "proc/voxel-grid-filter.h"
+#include "core/video.h"
+#include "option.h"
+#include "archive.h"
+#include "context.h"
+
+#include <cmath>
+
+namespace librealsense
+{
+    // The voxel indices are packed in 21 bits per axis, biased to be positive
+    static const int AXIS_BITS = 21;
+    static const int64_t AXIS_BIAS = int64_t(1) << (AXIS_BITS - 1);
+    static const uint64_t INVALID_KEY = ~uint64_t(0);
+
+    static const int PARTITION_BITS = 6;
+    static const int PARTITIONS = 1 << PARTITION_BITS;
+    // Points hashed and scattered together, the partition counts of a chunk are kept per chunk
+    static const int CHUNK_SIZE = 4096;
+
+    static inline uint64_t hash_key(uint64_t key) { return key * 0x9E3779B97F4A7C15ull; }
+
+    static inline uint64_t voxel_key(const float3& p, float inv_size)
+    {
+        // The comparisons fail on the points of no depth and on the NaNs
+        if (!(p.z > 0))
+            return INVALID_KEY;
+        float i[3] = { std::floor(p.x * inv_size), std::floor(p.y * inv_size), std::floor(p.z * inv_size) };
+        uint64_t key = 0;
+        for (int a = 0; a < 3; a++)
+        {
+            if (!(i[a] >= -AXIS_BIAS && i[a] < AXIS_BIAS))
+                return INVALID_KEY;
+            key = (key << AXIS_BITS) | uint64_t(int64_t(i[a]) + AXIS_BIAS);
+        }
+        return key;
+    }
+
+    voxel_grid_filter::voxel_grid_filter()
+        : stream_filter_processing_block("Voxel Grid Filter"), _voxel_size(0.01f), _depth_intrinsics(), _partitions(PARTITIONS)
+    {
+        auto voxel_size = std::make_shared<ptr_option<float>>(0.001f, 1.f, 0.001f, 0.01f, &_voxel_size, "Edge of the voxels in meters");
+        register_option(RS2_OPTION_VOXEL_SIZE, voxel_size);
+    }
+
+    bool voxel_grid_filter::should_process(const rs2::frame& frame)
+    {
+        if (!frame)
+            return false;
+
+        // A frameset is processed once, from its points when it has some and from its depth otherwise
+        if (auto set = frame.as<rs2::frameset>())
+        {
+            bool has_input = false;
+            set.foreach_rs([&has_input](const rs2::frame& f) {
+                if (f.is<rs2::points>() || (f.get_profile().stream_type() == RS2_STREAM_DEPTH && f.get_profile().format() == RS2_FORMAT_Z16))
+                    has_input = true;
+            });
+            return has_input;
+        }
+        return frame.is<rs2::points>() || (frame.get_profile().stream_type() == RS2_STREAM_DEPTH && frame.get_profile().format() == RS2_FORMAT_Z16);
+    }
+
+    const float3* voxel_grid_filter::get_points(const rs2::frame& f, const float2*& tex)
+    {
+        if (auto points = f.as<rs2::points>())
+        {
+            tex = (const float2*)points.get_texture_coordinates();
+            return (const float3*)points.get_vertices();
+        }
+
+        tex = nullptr;
+        auto depth = f.as<rs2::depth_frame>();
+        if (_depth_profile.get() != depth.get_profile().get())
+        {
+            _depth_profile = depth.get_profile();
+            _depth_intrinsics = _depth_profile.as<rs2::video_stream_profile>().get_intrinsics();
+            // The tables hold the undistorted rays of the models deprojecting without iterations, the others are deprojected per pixel
+            if (_depth_intrinsics.model == RS2_DISTORTION_KANNALA_BRANDT4 || _depth_intrinsics.model == RS2_DISTORTION_FTHETA)
+                _rays = nullptr;
+            else
+                _rays = deprojection_cache::get_instance().get(_depth_intrinsics);
+            _depth_points.resize(_depth_intrinsics.width * _depth_intrinsics.height);
+        }
+
+        auto& intrin = _depth_intrinsics;
+        auto z_pixels = reinterpret_cast<const uint16_t*>(depth.get_data());
+        auto units = ((librealsense::depth_frame*)depth.get())->get_units();
+        auto rays = _rays.get();
+        auto out = _depth_points.data();
+#pragma omp parallel for schedule(dynamic)
+        for (int y = 0; y < intrin.height; ++y)
+        {
+            for (int x = 0, index = y * intrin.width; x < intrin.width; ++x, ++index)
+            {
+                float d = units * z_pixels[index];
+                if (rays)
+                    out[index] = { rays->x[index] * d, rays->y[index] * d, d };
+                else
+                {
+                    const float pixel[] = { float(x), float(y) };
+                    rs2_deproject_pixel_to_point(&out[index].x, &intrin, pixel, d);
+                }
+            }
+        }
+        return out;
+    }
+
+    void voxel_grid_filter::hash_points(const float3* points, int count)
+    {
+        const float inv_size = 1.f / _voxel_size;
+        const int chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        _keys.resize(count);
+        _parts.resize(count);
+        _chunk_offsets.assign(chunks * PARTITIONS, 0);
+
+        auto keys = _keys.data();
+        auto parts = _parts.data();
+        auto offsets = _chunk_offsets.data();
+
+        // The key and the partition of every point, counted per chunk
+#pragma omp parallel for schedule(dynamic)
+        for (int c = 0; c < chunks; ++c)
+        {
+            auto chunk_counts = offsets + c * PARTITIONS;
+            for (int i = c * CHUNK_SIZE; i < std::min(count, (c + 1) * CHUNK_SIZE); ++i)
+            {
+                keys[i] = voxel_key(points[i], inv_size);
+                if (keys[i] == INVALID_KEY)
+                    continue;
+                parts[i] = uint8_t(hash_key(keys[i]) >> (64 - PARTITION_BITS));
+                chunk_counts[parts[i]]++;
+            }
+        }
+
+        // The counts become the positions each chunk scatters the points of a partition from,
+        // the points of a partition are ordered as in the input
+        int position = 0;
+        for (int p = 0; p < PARTITIONS; ++p)
+        {
+            for (int c = 0; c < chunks; ++c)
+            {
+                auto n = offsets[c * PARTITIONS + p];
+                offsets[c * PARTITIONS + p] = position;
+                position += n;
+            }
+        }
+        _order.resize(position);
+
+        auto order = _order.data();
+#pragma omp parallel for schedule(dynamic)
+        for (int c = 0; c < chunks; ++c)
+        {
+            auto chunk_offsets = offsets + c * PARTITIONS;
+            for (int i = c * CHUNK_SIZE; i < std::min(count, (c + 1) * CHUNK_SIZE); ++i)
+            {
+                if (keys[i] != INVALID_KEY)
+                    order[chunk_offsets[parts[i]]++] = i;
+            }
+        }
+    }
+
+    void voxel_grid_filter::accumulate(const float3* points, const float2* tex)
+    {
+        const int chunks = int(_chunk_offsets.size()) / PARTITIONS;
+        auto offsets = _chunk_offsets.data();
+        auto keys = _keys.data();
+        auto order = _order.data();
+
+#pragma omp parallel for schedule(dynamic)
+        for (int p = 0; p < PARTITIONS; ++p)
+        {
+            // After the scatter the offsets of the last chunk end the partitions
+            int begin = p && chunks ? offsets[(chunks - 1) * PARTITIONS + p - 1] : 0;
+            int end = chunks ? offsets[(chunks - 1) * PARTITIONS + p] : 0;
+
+            auto& part = _partitions[p];
+            part.keys.clear();
+            part.sums.clear();
+            part.tex_sums.clear();
+            part.counts.clear();
+
+            // Twice as many slots as points at the most keeps the probe sequences short
+            size_t capacity = 16;
+            while (capacity < size_t(end - begin) * 2)
+                capacity *= 2;
+            const uint64_t mask = capacity - 1;
+            part.slots.assign(capacity, -1);
+
+            for (int o = begin; o < end; ++o)
+            {
+                auto i = order[o];
+                auto key = keys[i];
+                auto h = hash_key(key);
+                auto slot = (h ^ (h >> 29)) & mask;
+                while (part.slots[slot] >= 0 && part.keys[part.slots[slot]] != key)
+                    slot = (slot + 1) & mask;
+
+                auto v = part.slots[slot];
+                if (v < 0)
+                {
+                    v = part.slots[slot] = int(part.keys.size());
+                    part.keys.push_back(key);
+                    part.sums.push_back({ 0, 0, 0 });
+                    part.tex_sums.push_back({ 0, 0 });
+                    part.counts.push_back(0);
+                }
+                auto& sum = part.sums[v];
+                sum.x += points[i].x;
+                sum.y += points[i].y;
+                sum.z += points[i].z;
+                if (tex)
+                {
+                    part.tex_sums[v].x += tex[i].x;
+                    part.tex_sums[v].y += tex[i].y;
+                }
+                part.counts[v]++;
+            }
+        }
+    }
+
+    rs2::frame voxel_grid_filter::allocate_output(const rs2::frame& f, size_t count)
+    {
+        if (_source_profile.get() != f.get_profile().get())
+        {
+            _source_profile = f.get_profile();
+            _target_profile = f.is<rs2::points>() ? _source_profile :
+                _source_profile.clone(RS2_STREAM_DEPTH, _source_profile.stream_index(), RS2_FORMAT_XYZ32F);
+        }
+
+        auto profile = std::dynamic_pointer_cast<stream_profile_interface>(_target_profile.get()->profile->shared_from_this());
+        auto frame_ref = _source_wrapper.allocate_points(profile, (frame_interface*)f.get(), RS2_EXTENSION_POINTS, int(count));
+        rs2::frame res{ (rs2_frame*)frame_ref };
+        return res;
+    }
+
+    rs2::frame voxel_grid_filter::process_frame(const rs2::frame_source& source, const rs2::frame& f)
+    {
+        auto input = f;
+        if (auto set = f.as<rs2::frameset>())
+        {
+            rs2::frame depth;
+            input = rs2::frame{};
+            set.foreach_rs([&input, &depth](const rs2::frame& frame) {
+                if (!input && frame.is<rs2::points>())
+                    input = frame;
+                if (!depth && frame.get_profile().stream_type() == RS2_STREAM_DEPTH && frame.get_profile().format() == RS2_FORMAT_Z16)
+                    depth = frame;
+            });
+            if (!input)
+                input = depth;
+        }
+
+        const float2* tex = nullptr;
+        auto points = get_points(input, tex);
+        auto count = input.is<rs2::points>() ? int(input.as<rs2::points>().size()) : int(_depth_points.size());
+
+        hash_points(points, count);
+        accumulate(points, tex);
+
+        // The voxels are output partition after partition, each partition in the order its voxels were first seen
+        std::vector<int> first(PARTITIONS + 1, 0);
+        for (int p = 0; p < PARTITIONS; ++p)
+            first[p + 1] = first[p] + int(_partitions[p].keys.size());
+
+        auto res = allocate_output(input, first[PARTITIONS]);
+        auto pframe = (librealsense::points*)res.get();
+        auto vertices = pframe->get_vertices();
+        auto tex_out = pframe->get_texture_coordinates();
+
+#pragma omp parallel for schedule(dynamic)
+        for (int p = 0; p < PARTITIONS; ++p)
+        {
+            auto& part = _partitions[p];
+            for (int v = 0; v < int(part.keys.size()); ++v)
+            {
+                float n = float(part.counts[v]);
+                vertices[first[p] + v] = { part.sums[v].x / n, part.sums[v].y / n, part.sums[v].z / n };
+                tex_out[first[p] + v] = { part.tex_sums[v].x / n, part.tex_sums[v].y / n };
+            }
+        }
+        return res;
+    }
+}
@@ -0,0 +1,57 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "synthetic-stream.h"
+#include "deprojection-cache.h"
+
+namespace librealsense
+{
+    // Downsamples the depth, or the points of a pointcloud, to a point per occupied voxel of a regular grid.
+    // The output points are the centroids of the voxels and hold the average texture coordinates of their points.
+    // The points are hashed into partitions of the grid, each accumulated into its own table by a single thread
+    class voxel_grid_filter : public stream_filter_processing_block
+    {
+    public:
+        voxel_grid_filter();
+
+    protected:
+        bool should_process(const rs2::frame& frame) override;
+        rs2::frame process_frame(const rs2::frame_source& source, const rs2::frame& f) override;
+
+    private:
+        // The voxels a partition of the grid accumulates into, the slots of its open addressing table index them
+        struct partition
+        {
+            cache_vector<int> slots;
+            cache_vector<uint64_t> keys;
+            cache_vector<float3> sums;
+            cache_vector<float2> tex_sums;
+            cache_vector<int> counts;
+        };
+
+        const float3* get_points(const rs2::frame& f, const float2*& tex);
+        void hash_points(const float3* points, int count);
+        void accumulate(const float3* points, const float2* tex);
+        rs2::frame allocate_output(const rs2::frame& f, size_t count);
+
+        float _voxel_size;
+
+        // Deprojected depth, when the input is a depth frame
+        rs2::stream_profile _depth_profile;
+        rs2_intrinsics _depth_intrinsics;
+        std::shared_ptr<const deprojection_table> _rays;
+        cache_vector<float3> _depth_points;
+
+        // Voxel key and partition of every point, then the points ordered by partition
+        cache_vector<uint64_t> _keys;
+        cache_vector<uint8_t> _parts;
+        cache_vector<int> _chunk_offsets;
+        cache_vector<int> _order;
+        std::vector<partition> _partitions;
+
+        rs2::stream_profile _source_profile;
+        rs2::stream_profile _target_profile;
+    };
+}
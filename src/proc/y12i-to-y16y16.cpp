@@ -6,17 +6,76 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
 
 namespace librealsense
 {
     struct y12i_pixel { uint8_t rl : 8, rh : 4, ll : 4, lh : 8; int l() const { return lh << 4 | ll; } int r() const { return rh << 8 | rl; } };
+
+    // Unpacks the leading pixels with the widest kernel available and returns their number
+    static int unpack_y16_y16_from_y12i_10_simd(uint16_t * left, uint16_t * right, const byte * source, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return unpack_y16_y16_from_y12i_10_avx2(left, right, source, count);
+
+        // 4 pixels of 3 bytes, gathered to the 4 right words followed by the 4 left words
+        const auto split = _mm_setr_epi8(0, 1, 3, 4, 6, 7, 9, 10, 1, 2, 4, 5, 7, 8, 10, 11);
+        const auto mask = _mm_set1_epi16(0x0fff);
+
+        // Every 12 bytes are loaded as 16, the last 2 pixels are left to the scalar loop to stay in bounds
+        for (; i + 8 + 2 <= count; i += 8)
+        {
+            auto a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 3 * i)), split);
+            auto b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 3 * i + 12)), split);
+
+            auto r = _mm_unpacklo_epi64(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+            auto l = _mm_unpackhi_epi64(_mm_srli_epi16(a, 4), _mm_srli_epi16(b, 4));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i), _mm_or_si128(_mm_slli_epi16(l, 6), _mm_srli_epi16(l, 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i), _mm_or_si128(_mm_slli_epi16(r, 6), _mm_srli_epi16(r, 4)));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto nibble = vdupq_n_u8(0x0f);
+        for (; i + 16 <= count; i += 16)
+        {
+            auto in = vld3q_u8(source + 3 * i);
+            auto rh = vandq_u8(in.val[1], nibble);
+            auto ll = vshrq_n_u8(in.val[1], 4);
+
+            uint16x8_t r[2], l[2];
+            r[0] = vorrq_u16(vmovl_u8(vget_low_u8(in.val[0])), vshlq_n_u16(vmovl_u8(vget_low_u8(rh)), 8));
+            r[1] = vorrq_u16(vmovl_u8(vget_high_u8(in.val[0])), vshlq_n_u16(vmovl_u8(vget_high_u8(rh)), 8));
+            l[0] = vorrq_u16(vmovl_u8(vget_low_u8(ll)), vshlq_n_u16(vmovl_u8(vget_low_u8(in.val[2])), 4));
+            l[1] = vorrq_u16(vmovl_u8(vget_high_u8(ll)), vshlq_n_u16(vmovl_u8(vget_high_u8(in.val[2])), 4));
+
+            for (int k = 0; k < 2; ++k)
+            {
+                vst1q_u16(left + i + 8 * k, vorrq_u16(vshlq_n_u16(l[k], 6), vshrq_n_u16(l[k], 4)));
+                vst1q_u16(right + i + 8 * k, vorrq_u16(vshlq_n_u16(r[k], 6), vshrq_n_u16(r[k], 4)));
+            }
+        }
+#endif
+        return i;
+    }
+
     void unpack_y16_y16_from_y12i_10(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
         auto count = width * height;
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y16_y16_from_y12i_cuda(dest, count, reinterpret_cast<const y12i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y12i_pixel*>(source),
+        auto done = unpack_y16_y16_from_y12i_10_simd(reinterpret_cast<uint16_t*>(dest[0]), reinterpret_cast<uint16_t*>(dest[1]), source, count);
+        byte * const rest[] = { dest[0] + 2 * done, dest[1] + 2 * done };
+        split_frame(rest, count - done, reinterpret_cast<const y12i_pixel*>(source) + done,
             [](const y12i_pixel & p) -> uint16_t { return p.l() << 6 | p.l() >> 4; },  // We want to convert 10-bit data to 16-bit data
             [](const y12i_pixel & p) -> uint16_t { return p.r() << 6 | p.r() >> 4; }); // Multiply by 64 1/16 to efficiently approximate 65535/1023
 #endif
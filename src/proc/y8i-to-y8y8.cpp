@@ -8,17 +8,55 @@
 #ifdef RS2_USE_CUDA
 #include "cuda/cuda-conversion.cuh"
 #endif
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
 
 namespace librealsense
 {
     struct y8i_pixel { uint8_t l, r; };
+
+    // Unpacks the leading pixels with the widest kernel available and returns their number
+    static int unpack_y8_y8_from_y8i_simd(byte * left, byte * right, const byte * source, int count)
+    {
+        int i = 0;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            return unpack_y8_y8_from_y8i_avx2(left, right, source, count);
+
+        const auto split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+        for (; i + 16 <= count; i += 16)
+        {
+            auto a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * i)), split);
+            auto b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 2 * i + 16)), split);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i), _mm_unpacklo_epi64(a, b));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i), _mm_unpackhi_epi64(a, b));
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        for (; i + 16 <= count; i += 16)
+        {
+            auto lr = vld2q_u8(source + 2 * i);
+            vst1q_u8(left + i, lr.val[0]);
+            vst1q_u8(right + i, lr.val[1]);
+        }
+#endif
+        return i;
+    }
+
     void unpack_y8_y8_from_y8i(byte * const dest[], const byte * source, int width, int height, int actual_size)
     {
         auto count = width * height;
 #ifdef RS2_USE_CUDA
         rscuda::split_frame_y8_y8_from_y8i_cuda(dest, count, reinterpret_cast<const y8i_pixel *>(source));
 #else
-        split_frame(dest, count, reinterpret_cast<const y8i_pixel*>(source),
+        auto done = unpack_y8_y8_from_y8i_simd(dest[0], dest[1], source, count);
+        byte * const rest[] = { dest[0] + done, dest[1] + done };
+        split_frame(rest, count - done, reinterpret_cast<const y8i_pixel*>(source) + done,
             [](const y8i_pixel & p) -> uint8_t { return p.l; },
             [](const y8i_pixel & p) -> uint8_t { return p.r; });
 #endif
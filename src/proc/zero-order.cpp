@@ -2,9 +2,20 @@
 // Copyright(c) 2019 Intel Corporation. All Rights Reserved.
 
 #include "zero-order.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #include "l500/l500-depth.h"
 
+#ifdef __SSSE3__
+#include <tmmintrin.h> // For SSSE3 intrinsics
+#include "sse/avx2-kernels.h"
+#endif
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h> // For NEON intrinsics
+#endif
+
 const double METER_TO_MM = 1000;
 
 namespace librealsense
@@ -22,26 +33,25 @@ namespace librealsense
         RS2_OPTION_FILTER_ZO_THRESHOLD_SCALE = static_cast<rs2_option>(RS2_OPTION_COUNT + 8) /**< threshold scale used by zero order filter */
     };
 
-    double get_pixel_rtd(const rs2::vertex& v, int baseline)
+    // The point of a pixel at z mm is z * (ray_x, ray_y, 1), the round trip distance only needs ray_x and the length of the ray
+    struct zero_order_geometry
     {
-        auto x = (double)v.x*METER_TO_MM;
-        auto y = (double)v.y*METER_TO_MM;
-        auto z = (double)v.z*METER_TO_MM;
-       
-        auto rtd = sqrt(x*x + y*y + z*z) + sqrt((x - baseline) *(x - baseline) + y*y + z*z);
-        return v.z ? rtd : 0;
-    }
+        const float* ray_x;
+        const float* ray_norm;
+        float units_mm;
+        float baseline;
+    };
 
-    void z2rtd(const rs2::vertex* vertices, double* rtd, const rs2_intrinsics& intrinsics, int baseline)
+    // Round trip distance in mm of a pixel at z mm, whose undistorted ray is (x, y, 1) of length norm: from the emitter at the origin
+    // to the point, and back to the receiver at the baseline on the x axis
+    static inline float get_pixel_rtd(float z, float x, float norm, float baseline)
     {
-        for (auto i = 0;i < intrinsics.height*intrinsics.width; i++)
-        {
-            rtd[i] = get_pixel_rtd(vertices[i], baseline);           
-        }
+        auto dist = z * norm;
+        return dist + std::sqrt(std::max(0.f, dist * dist - 2 * baseline * z * x + baseline * baseline));
     }
-    
-    template<typename T>
-    std::vector <T> get_zo_point_values(const T* frame_data_in, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
+
+    template<typename T, class F>
+    std::vector <T> get_zo_point_values(F value, const rs2_intrinsics& intrinsics, int zo_point_x, int zo_point_y, int patch_r)
     {
         std::vector<T> values;
         values.reserve((patch_r + 2ULL) *(patch_r + 2ULL));
@@ -50,7 +60,7 @@ namespace librealsense
         {
             for (auto j = (zo_point_x - 1 - patch_r); j <= (zo_point_x + patch_r) && i < intrinsics.width; j++)
             {
-                values.push_back(frame_data_in[i*intrinsics.width + j]);
+                values.push_back(value(i*intrinsics.width + j));
             }
         }
 
@@ -72,17 +82,22 @@ namespace librealsense
         return 0;
     }
 
-    bool try_get_zo_rtd_ir_point_values(const double* rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, 
+    // The round trip distance of the patch around the zero order point is computed from the depth, the rest of the image
+    // is only compared against it
+    bool try_get_zo_rtd_ir_point_values(const zero_order_geometry& geometry, const uint16_t* depth_data_in, const uint8_t* ir_data,
         const rs2_intrinsics& intrinsics, const zero_order_options& options, int zo_point_x, int zo_point_y,
-        double *rtd_zo_value, uint8_t* ir_zo_data)
+        float *rtd_zo_value, uint8_t* ir_zo_data)
     {
         if (zo_point_x - options.patch_size < 0 || zo_point_x + options.patch_size >= intrinsics.width ||
             zo_point_y - options.patch_size < 0 || zo_point_y + options.patch_size >= intrinsics.height)
             return false;
 
-        auto values_rtd = get_zo_point_values(rtd, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_ir = get_zo_point_values(ir_data, intrinsics, zo_point_x, zo_point_y, options.patch_size);
-        auto values_z = get_zo_point_values(depth_data_in, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_rtd = get_zo_point_values<float>([&](int i)
+        {
+            return depth_data_in[i] ? get_pixel_rtd(depth_data_in[i] * geometry.units_mm, geometry.ray_x[i], geometry.ray_norm[i], geometry.baseline) : 0.f;
+        }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_ir = get_zo_point_values<uint8_t>([&](int i) { return ir_data[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
+        auto values_z = get_zo_point_values<uint16_t>([&](int i) { return depth_data_in[i]; }, intrinsics, zo_point_x, zo_point_y, options.patch_size);
 
         for (auto i = 0; i < values_rtd.size(); i++)
         {
@@ -93,7 +108,7 @@ namespace librealsense
             }       
         }
 
-        values_rtd.erase(std::remove_if(values_rtd.begin(), values_rtd.end(), [](double val)
+        values_rtd.erase(std::remove_if(values_rtd.begin(), values_rtd.end(), [](float val)
         {
             return val == 0;
         }), values_rtd.end());
@@ -112,55 +127,128 @@ namespace librealsense
         return true;
     }
 
-    template<class T>
-    void detect_zero_order(const double * rtd, const uint16_t* depth_data_in, const uint8_t* ir_data, T zero_pixel,
-       const rs2_intrinsics& intrinsics, const zero_order_options& options,
-       double zo_value, uint8_t iro_value)
+    // Clears the depth and the confidence of the pixels lit by the zero order: valid depth, infrared below the limit and a round
+    // trip distance close to the one of the zero order point. The confidence is optional
+    static void detect_zero_order(uint16_t* depth_out, uint8_t* confidence_out, const uint16_t* depth, const uint8_t* ir,
+        const uint8_t* confidence, const zero_order_geometry& geometry, int ir_limit, float rtd_min, float rtd_max, int count)
     {
-        const double ir_dynamic_range = 256.0;
+        int i = 0;
+        auto ray_x = geometry.ray_x;
+        auto ray_norm = geometry.ray_norm;
+#ifdef __SSSE3__
+        static const bool do_avx2 = has_avx2();
+        if (do_avx2)
+            i = zero_order_invalidation_avx2(depth_out, confidence_out, depth, ir, confidence, ray_x, ray_norm,
+                geometry.units_mm, geometry.baseline, ir_limit, rtd_min, rtd_max, count);
+
+        const auto units = _mm_set1_ps(geometry.units_mm);
+        const auto b2 = _mm_set1_ps(2 * geometry.baseline);
+        const auto bb = _mm_set1_ps(geometry.baseline * geometry.baseline);
+        const auto mn = _mm_set1_ps(rtd_min);
+        const auto mx = _mm_set1_ps(rtd_max);
+        const auto fzero = _mm_setzero_ps();
+        const auto limit = _mm_set1_epi16(static_cast<short>(ir_limit));
+        const auto zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(depth + i));
+            auto ir16 = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(ir + i)), zero);
+
+            __m128 in_range[2];
+            for (int k = 0; k < 2; k++)
+            {
+                auto z = _mm_mul_ps(_mm_cvtepi32_ps(k ? _mm_unpackhi_epi16(d, zero) : _mm_unpacklo_epi16(d, zero)), units);
+                auto dist = _mm_mul_ps(z, _mm_loadu_ps(ray_norm + i + 4 * k));
+                auto back = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(dist, dist), bb), _mm_mul_ps(_mm_mul_ps(z, b2), _mm_loadu_ps(ray_x + i + 4 * k)));
+                auto rtd = _mm_add_ps(dist, _mm_sqrt_ps(_mm_max_ps(back, fzero)));
+                in_range[k] = _mm_and_ps(_mm_cmpgt_ps(rtd, mn), _mm_cmplt_ps(rtd, mx));
+            }
 
-        double r = std::exp((ir_dynamic_range / 2.0 + options.threshold_offset - iro_value) / (double)options.threshold_scale);
+            auto zo = _mm_packs_epi32(_mm_castps_si128(in_range[0]), _mm_castps_si128(in_range[1]));
+            zo = _mm_and_si128(zo, _mm_cmplt_epi16(ir16, limit));
+            zo = _mm_andnot_si128(_mm_cmpeq_epi16(d, zero), zo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(depth_out + i), _mm_andnot_si128(zo, d));
 
-        double res = (1.0 + r);
-        double i_threshold_relative = options.ir_threshold / res;
-        for (auto i = 0; i < intrinsics.height*intrinsics.width; i++)
+            if (confidence)
+            {
+                auto c = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(confidence + i));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(confidence_out + i), _mm_andnot_si128(_mm_packs_epi16(zo, zo), c));
+            }
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto b2 = vdupq_n_f32(2 * geometry.baseline);
+        const auto bb = vdupq_n_f32(geometry.baseline * geometry.baseline);
+        const auto mn = vdupq_n_f32(rtd_min);
+        const auto mx = vdupq_n_f32(rtd_max);
+        const auto fzero = vdupq_n_f32(0.f);
+        const auto limit = vdupq_n_u16(static_cast<uint16_t>(ir_limit));
+        for (; i + 8 <= count; i += 8)
         {
-            double rtd_val = rtd[i];
-            uint8_t ir_val = ir_data[i];
+            auto d = vld1q_u16(depth + i);
+            auto ir16 = vmovl_u8(vld1_u8(ir + i));
+
+            uint16x4_t in_range[2];
+            for (int k = 0; k < 2; k++)
+            {
+                auto z = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(k ? vget_high_u16(d) : vget_low_u16(d))), geometry.units_mm);
+                auto dist = vmulq_f32(z, vld1q_f32(ray_norm + i + 4 * k));
+                auto back = vsubq_f32(vaddq_f32(vmulq_f32(dist, dist), bb), vmulq_f32(vmulq_f32(z, b2), vld1q_f32(ray_x + i + 4 * k)));
+                auto rtd = vaddq_f32(dist, vsqrtq_f32(vmaxq_f32(back, fzero)));
+                in_range[k] = vmovn_u32(vandq_u32(vcgtq_f32(rtd, mn), vcltq_f32(rtd, mx)));
+            }
 
-            bool zero = (depth_data_in[i] > 0) && 
-                        (ir_val < i_threshold_relative) &&
-                        (rtd_val > (zo_value - options.rtd_low_threshold)) && 
-                        (rtd_val < (zo_value + options.rtd_high_threshold));
+            auto zo = vandq_u16(vcombine_u16(in_range[0], in_range[1]), vandq_u16(vcltq_u16(ir16, limit), vtstq_u16(d, d)));
+            vst1q_u16(depth_out + i, vbicq_u16(d, zo));
+
+            if (confidence)
+                vst1_u8(confidence_out + i, vbic_u8(vld1_u8(confidence + i), vmovn_u16(zo)));
+        }
+#endif
+        for (; i < count; i++)
+        {
+            bool zero = false;
+            if (depth[i] > 0 && ir[i] < ir_limit)
+            {
+                auto rtd = get_pixel_rtd(depth[i] * geometry.units_mm, ray_x[i], ray_norm[i], geometry.baseline);
+                zero = rtd > rtd_min && rtd < rtd_max;
+            }
 
-            zero_pixel(i, zero);
+            depth_out[i] = zero ? 0 : depth[i];
+            if (confidence)
+                confidence_out[i] = zero ? 0 : confidence[i];
         }
     }
 
-    template<class T>
-    bool zero_order_invalidation(const uint16_t * depth_data_in, const uint8_t * ir_data, T zero_pixel,
-        const rs2::vertex* vertices,
-        rs2_intrinsics intrinsics,
+    bool zero_order_invalidation(const uint16_t * depth_data_in, const uint8_t * ir_data, const uint8_t * confidence_data_in,
+        uint16_t * depth_output, uint8_t * confidence_output,
+        const zero_order_geometry& geometry,
+        const rs2_intrinsics& intrinsics,
         const zero_order_options& options, int zo_point_x, int zo_point_y)
     {
-        std::vector<double> rtd(size_t(intrinsics.height)*intrinsics.width);
-        z2rtd(vertices, rtd.data(), intrinsics, int(options.baseline));
-        double rtd_zo_value; 
+        float rtd_zo_value;
         uint8_t ir_zo_value;
 
-        if (try_get_zo_rtd_ir_point_values(rtd.data(), depth_data_in, ir_data, intrinsics, 
-            options,zo_point_x, zo_point_y, &rtd_zo_value, &ir_zo_value))
-        {
-            detect_zero_order(rtd.data(), depth_data_in, ir_data, zero_pixel, intrinsics,
-                options, rtd_zo_value, ir_zo_value);
-            return true;
-        }
-        return false;
+        if (!try_get_zo_rtd_ir_point_values(geometry, depth_data_in, ir_data, intrinsics,
+            options, zo_point_x, zo_point_y, &rtd_zo_value, &ir_zo_value))
+            return false;
+
+        const double ir_dynamic_range = 256.0;
+
+        double r = std::exp((ir_dynamic_range / 2.0 + options.threshold_offset - ir_zo_value) / (double)options.threshold_scale);
+
+        double res = (1.0 + r);
+        double i_threshold_relative = options.ir_threshold / res;
+        // the infrared is an integer, below the threshold is below the threshold rounded up
+        int ir_limit = int(std::ceil(i_threshold_relative));
+
+        detect_zero_order(depth_output, confidence_output, depth_data_in, ir_data, confidence_data_in, geometry, ir_limit,
+            rtd_zo_value - options.rtd_low_threshold, rtd_zo_value + options.rtd_high_threshold, intrinsics.width * intrinsics.height);
+        return true;
     }
 
     zero_order::zero_order(std::shared_ptr<bool_option> is_enabled_opt)
-       : generic_processing_block("Zero Order Fix"), _first_frame(true), _is_enabled_opt(is_enabled_opt),
-        _resolutions_depth { 0 }
+       : generic_processing_block("Zero Order Fix"), _geometry_intrinsics{}, _zo_point{ 0, 0 }, _first_frame(true),
+        _is_enabled_opt(is_enabled_opt), _resolutions_depth { 0 }
     {
         auto ir_threshold = std::make_shared<ptr_option<uint8_t>>(
             0,
@@ -375,8 +463,30 @@ namespace librealsense
 
     std::pair<int, int> zero_order::get_zo_point(const rs2::frame& frame)
     {
-        auto intrinsics = try_read_intrinsics(frame);
-        return { intrinsics.zo.x, intrinsics.zo.y };
+        auto profile = frame.get_profile();
+        if (profile.get() != _zo_profile.get())
+        {
+            auto intrinsics = try_read_intrinsics(frame);
+            _zo_point = { intrinsics.zo.x, intrinsics.zo.y };
+            _zo_profile = profile;
+        }
+        return _zo_point;
+    }
+
+    void zero_order::update_geometry(const rs2_intrinsics& intrinsics)
+    {
+        if (_deprojection && !std::memcmp(&intrinsics, &_geometry_intrinsics, sizeof(intrinsics)))
+            return;
+
+        _deprojection = deprojection_cache::get_instance().get(intrinsics);
+        _ray_norm.resize(_deprojection->x.size());
+        for (size_t i = 0; i < _ray_norm.size(); i++)
+        {
+            auto x = _deprojection->x[i];
+            auto y = _deprojection->y[i];
+            _ray_norm[i] = std::sqrt(x * x + y * y + 1);
+        }
+        _geometry_intrinsics = intrinsics;
     }
 
     rs2::frame zero_order::process_frame(const rs2::frame_source& source, const rs2::frame& f)
@@ -418,8 +528,6 @@ namespace librealsense
         auto ir_frame = data.get_infrared_frame();
         auto confidence_frame = data.first_or_default(RS2_STREAM_CONFIDENCE);
 
-        auto points = _pc.calculate(depth_frame);
-
         auto depth_out = source.allocate_video_frame(_target_profile_depth, depth_frame, 0, 0, 0, 0, RS2_EXTENSION_DEPTH_FRAME);
 
         rs2::frame confidence_out;
@@ -436,27 +544,27 @@ namespace librealsense
         auto depth_intrinsics = depth_frame.get_profile().as<rs2::video_stream_profile>().get_intrinsics();
 
         auto depth_output = (uint16_t*)depth_out.get_data();
-        uint8_t* confidence_output;
+        uint8_t* confidence_output = nullptr;
+        const uint8_t* confidence_data = nullptr;
 
         if (confidence_frame)
         {
             confidence_output = (uint8_t*)confidence_out.get_data();
+            confidence_data = (const uint8_t*)confidence_frame.get_data();
         }
 
         auto zo = get_zo_point(depth_frame);
 
+        update_geometry(depth_intrinsics);
+        zero_order_geometry geometry{ _deprojection->x.data(), _ray_norm.data(),
+            float(depth_frame.get_units() * METER_TO_MM), float(int(_options.baseline)) };
+
         if (zero_order_invalidation((const uint16_t*)depth_frame.get_data(),
             (const uint8_t*)ir_frame.get_data(),
-            [&](int index, bool zero) 
-        {
-            depth_output[index] = zero ? 0 : ((uint16_t*)depth_frame.get_data())[index];
-
-            if (confidence_frame)
-            {
-                confidence_output[index] = zero ? 0 : ((uint8_t*)confidence_frame.get_data())[index];
-            }
-        },
-            points.get_vertices(),
+            confidence_data,
+            depth_output,
+            confidence_output,
+            geometry,
             depth_intrinsics,
             _options, zo.first, zo.second))
         {
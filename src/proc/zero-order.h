@@ -7,6 +7,7 @@
 #include "synthetic-stream.h"
 #include "option.h"
 #include "l500/l500-private.h"
+#include "deprojection-cache.h"
 
 #define IR_THRESHOLD 120
 #define RTD_THRESHOLD 50
@@ -68,7 +69,15 @@ namespace librealsense
         rs2::stream_profile         _source_profile_confidence;
         rs2::stream_profile         _target_profile_confidence;
 
-        rs2::pointcloud             _pc;
+        // Geometry of the depth intrinsics, kept between frames: the undistorted ray of every pixel and the length of its (x, y, 1)
+        void update_geometry(const rs2_intrinsics& intrinsics);
+        rs2_intrinsics                              _geometry_intrinsics;
+        std::shared_ptr<const deprojection_table>   _deprojection;
+        cache_vector<float>                         _ray_norm;
+
+        // The zero order point of the last depth profile, reading it from the sensor per frame is costly
+        rs2::stream_profile         _zo_profile;
+        std::pair<int, int>         _zo_point;
 
         bool                        _first_frame;
 
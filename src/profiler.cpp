@@ -0,0 +1,28 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "profiler.h"
+
+#if defined(RS2_PROFILER_PERFETTO)
+
+PERFETTO_TRACK_EVENT_STATIC_STORAGE();
+
+namespace librealsense
+{
+    namespace profiler
+    {
+        // Connects the library to the tracing service of the system once it is loaded
+        static struct perfetto_registration
+        {
+            perfetto_registration()
+            {
+                perfetto::TracingInitArgs args;
+                args.backends = perfetto::kSystemBackend;
+                perfetto::Tracing::Initialize(args);
+                perfetto::TrackEvent::Register();
+            }
+        } registration;
+    }
+}
+
+#endif
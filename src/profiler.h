@@ -0,0 +1,72 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+/*
+    Zones and thread names for an external profiler, selected at build time with BUILD_WITH_PROFILER.
+    LRS_PROFILE_ZONE(name) times the rest of the scope under a literal name; LRS_PROFILE_ZONE_NAMED(name, text) also
+    carries a name known at runtime, which must outlive the process, as the processing blocks' trace names do.
+    Without a profiler the macros compile to nothing
+*/
+#if defined(RS2_PROFILER_TRACY)
+
+#include <cstring>
+#include <tracy/Tracy.hpp>
+
+#define LRS_PROFILE_ZONE(name) ZoneScopedN(name)
+#define LRS_PROFILE_ZONE_NAMED(name, text) ZoneScopedN(name); ZoneText(text, std::strlen(text))
+#define LRS_PROFILE_THREAD_NAME(name) tracy::SetThreadName(name)
+
+#elif defined(RS2_PROFILER_ITT)
+
+#include <ittnotify.h>
+
+namespace librealsense
+{
+    namespace profiler
+    {
+        inline __itt_domain* get_itt_domain()
+        {
+            static __itt_domain* domain = __itt_domain_create("librealsense");
+            return domain;
+        }
+
+        class itt_zone
+        {
+        public:
+            explicit itt_zone(__itt_string_handle* name) { __itt_task_begin(get_itt_domain(), __itt_null, __itt_null, name); }
+            ~itt_zone() { __itt_task_end(get_itt_domain()); }
+        };
+    }
+}
+
+#define LRS_PROFILE_CONCAT_INNER(a, b) a##b
+#define LRS_PROFILE_CONCAT(a, b) LRS_PROFILE_CONCAT_INNER(a, b)
+#define LRS_PROFILE_ZONE(name) \
+    static __itt_string_handle* LRS_PROFILE_CONCAT(lrs_itt_name_, __LINE__) = __itt_string_handle_create(name); \
+    librealsense::profiler::itt_zone LRS_PROFILE_CONCAT(lrs_itt_zone_, __LINE__)(LRS_PROFILE_CONCAT(lrs_itt_name_, __LINE__))
+// ITT keeps a single handle per string, created on first use
+#define LRS_PROFILE_ZONE_NAMED(name, text) \
+    librealsense::profiler::itt_zone LRS_PROFILE_CONCAT(lrs_itt_zone_, __LINE__)(__itt_string_handle_create(text))
+#define LRS_PROFILE_THREAD_NAME(name) __itt_thread_set_name(name)
+
+#elif defined(RS2_PROFILER_PERFETTO)
+
+#include <perfetto.h>
+
+// The events of the library are in the librealsense category, recorded by the system tracing service
+PERFETTO_DEFINE_CATEGORIES(perfetto::Category("librealsense").SetDescription("Frame path of librealsense"));
+
+#define LRS_PROFILE_ZONE(name) TRACE_EVENT("librealsense", name)
+#define LRS_PROFILE_ZONE_NAMED(name, text) TRACE_EVENT("librealsense", perfetto::DynamicString{ text })
+// Perfetto reads the thread names of the system
+#define LRS_PROFILE_THREAD_NAME(name) ((void)0)
+
+#else
+
+#define LRS_PROFILE_ZONE(name) ((void)0)
+#define LRS_PROFILE_ZONE_NAMED(name, text) ((void)0)
+#define LRS_PROFILE_THREAD_NAME(name) ((void)0)
+
+#endif
@@ -21,7 +21,13 @@
 #include "proc/processing-blocks-factory.h"
 #include "proc/colorizer.h"
 #include "proc/pointcloud.h"
+#include "proc/align.h"
+#include "proc/align-pointcloud.h"
 #include "proc/threshold.h"
+#include "proc/voxel-grid-filter.h"
+#include "proc/depth-to-scan.h"
+#include "proc/median-filter.h"
+#include "proc/tensor-converter.h"
 #include "proc/units-transform.h"
 #include "proc/disparity-transform.h"
 #include "proc/syncer-processing-block.h"
@@ -29,10 +35,14 @@
 #include "proc/spatial-filter.h"
 #include "proc/zero-order.h"
 #include "proc/hole-filling-filter.h"
+#include "proc/depth-filter-chain.h"
 #include "proc/color-formats-converter.h"
 #include "proc/rates-printer.h"
 #include "proc/hdr-merge.h"
 #include "proc/sequence_id_filter.h"
+#include "proc/sequence_id_demux.h"
+#include "proc/projection.h"
+#include "../include/librealsense2/rsutil.h"
 #include "media/playback/playback_device.h"
 #include "stream.h"
 #include "../include/librealsense2/h/rs_types.h"
@@ -47,6 +57,7 @@
 #include "firmware_logger_device.h"
 #include "device-calibration.h"
 #include "calibrated-sensor.h"
+#include "thread-policy.h"
 ////////////////////////
 // API implementation //
 ////////////////////////
@@ -110,9 +121,10 @@ struct rs2_frame_queue
     explicit rs2_frame_queue(int cap)
         : queue(cap)
     {
+        queue.set_on_drop([](librealsense::frame_holder& f) { librealsense::count_dropped_frames(f.frame, RS2_FRAME_DROP_CAUSE_QUEUE_FULL); });
     }
 
-    single_consumer_frame_queue<librealsense::frame_holder> queue;
+    single_consumer_frame_queue<librealsense::frame_holder, lock_free_single_consumer_queue<librealsense::frame_holder>> queue;
 };
 
 struct rs2_sensor_list
@@ -152,6 +164,8 @@ NOEXCEPT_RETURN(nullptr, what, name, args, type)
 
 void notifications_processor::raise_notification(const notification n)
 {
+    if (_on_raise)
+        _on_raise();
     _dispatcher.invoke([this, n](dispatcher::cancellable_timer ct)
     {
         std::lock_guard<std::mutex> lock(_callback_mutex);
@@ -168,6 +182,23 @@ rs2_context* rs2_create_context(int api_version, rs2_error** error) BEGIN_API_CA
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version)
 
+void rs2_set_thread_policy(rs2_thread_role role, const int* cpus, int cpus_count, int realtime_priority, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(role);
+    VALIDATE_RANGE(cpus_count, 0, 1024);
+    VALIDATE_RANGE(realtime_priority, 0, 99);
+    if (cpus_count) VALIDATE_NOT_NULL(cpus);
+    librealsense::thread_policy policy;
+    for (int i = 0; i < cpus_count; i++)
+    {
+        VALIDATE_RANGE(cpus[i], 0, 1023);
+        policy.cpus.push_back(cpus[i]);
+    }
+    policy.realtime_priority = realtime_priority;
+    librealsense::set_thread_policy(role, policy);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, role, cpus, cpus_count, realtime_priority)
+
 void rs2_delete_context(rs2_context* context) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(context);
@@ -631,6 +662,37 @@ void rs2_set_option(const rs2_options* options, rs2_option option, float value,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, options, option, value)
 
+int rs2_get_options_bulk(const rs2_options* options, const rs2_option* ids, float* values, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(options);
+    VALIDATE_NOT_NULL(ids);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+
+    std::shared_ptr<void> locked;
+    if (auto sensor = dynamic_cast<sensor_base*>(options->options))
+        locked = sensor->lock_controls();
+
+    int read = 0;
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = std::numeric_limits<float>::quiet_NaN();
+        if (!options->options->supports_option(ids[i]))
+            continue;
+        try
+        {
+            values[i] = options->options->get_option(ids[i]).query();
+            read++;
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_DEBUG("Failed to read " << get_string(ids[i]) << ": " << ex.what());
+        }
+    }
+    return read;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, options, ids, values, count)
+
 rs2_options_list* rs2_get_options_list(const rs2_options* options, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(options);
@@ -801,6 +863,52 @@ void rs2_set_notifications_callback_cpp(const rs2_sensor* sensor, rs2_notificati
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, callback)
 
+void rs2_set_frame_allocator(const rs2_sensor* sensor, rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(allocate);
+    VALIDATE_NOT_NULL(deallocate);
+    auto sensor_base = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sensor_base)
+        throw librealsense::not_implemented_exception("Custom frame allocators are not supported by this sensor");
+    librealsense::frame_allocator_ptr allocator(
+        new librealsense::frame_allocator_fptr(allocate, deallocate, user),
+        [](rs2_frame_allocator* p) { delete p; });
+    sensor_base->set_frame_allocator(std::move(allocator));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, allocate, deallocate, user)
+
+void rs2_set_frame_allocator_cpp(const rs2_sensor* sensor, rs2_frame_allocator* allocator, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(allocator);
+    auto sensor_base = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sensor_base)
+        throw librealsense::not_implemented_exception("Custom frame allocators are not supported by this sensor");
+    sensor_base->set_frame_allocator({ allocator, [](rs2_frame_allocator* p) { p->release(); } });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, allocator)
+
+int rs2_get_sensor_metrics(const rs2_sensor* sensor, rs2_stream_metrics* metrics, int count, rs2_frame_pool_metrics* pool, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_RANGE(count, 0, 1024);
+    if (count) VALIDATE_NOT_NULL(metrics);
+    auto sensor_base = dynamic_cast<librealsense::sensor_base*>(sensor->sensor);
+    if (!sensor_base)
+        throw librealsense::not_implemented_exception("Metrics are not supported by this sensor");
+
+    auto streams = sensor_base->get_metrics().get();
+    std::copy_n(streams.begin(), std::min(int(streams.size()), count), metrics);
+    if (pool)
+    {
+        auto stats = sensor_base->get_pool_stats();
+        *pool = { stats.hits, stats.misses, stats.evictions, stats.in_use, stats.capacity };
+    }
+    return int(streams.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, metrics, count, pool)
+
 void rs2_software_device_set_destruction_callback_cpp(const rs2_device* dev, rs2_software_device_destruction_callback* callback, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(dev);
@@ -833,6 +941,33 @@ int rs2_supports_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame, frame_metadata)
 
+int rs2_get_all_frame_metadata(const rs2_frame* frame, rs2_metadata_type* values, int* supported, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(values);
+    VALIDATE_NOT_NULL(supported);
+    VALIDATE_RANGE(count, 0, ::RS2_FRAME_METADATA_COUNT);
+    auto f = (frame_interface*)frame;
+    int res = 0;
+    for (int i = 0; i < count; i++)
+    {
+        auto id = rs2_frame_metadata_value(i);
+        values[i] = 0;
+        supported[i] = 0;
+        if (!f->supports_frame_metadata(id))
+            continue;
+        try
+        {
+            values[i] = f->get_frame_metadata(id);
+            supported[i] = 1;
+            res++;
+        }
+        catch (...) {}
+    }
+    return res;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, values, supported, count)
+
 rs2_metadata_type rs2_get_frame_metadata(const rs2_frame* frame, rs2_frame_metadata_value frame_metadata, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -980,6 +1115,48 @@ unsigned long long rs2_get_frame_number(const rs2_frame* frame, rs2_error** erro
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
 
+static void fill_frame_header(frame_interface* f, rs2_frame_header* header)
+{
+    header->data = f->get_frame_data();
+    header->data_size = f->get_frame_data_size();
+    header->frame_number = f->get_frame_number();
+    header->timestamp = f->get_frame_timestamp();
+    header->timestamp_domain = f->get_frame_timestamp_domain();
+    if (auto profile = f->get_stream())
+    {
+        header->profile = profile->get_c_wrapper();
+        header->stream = profile->get_stream_type();
+        header->stream_index = profile->get_stream_index();
+        header->format = profile->get_format();
+    }
+    else
+    {
+        header->profile = nullptr;
+        header->stream = RS2_STREAM_ANY;
+        header->stream_index = 0;
+        header->format = RS2_FORMAT_ANY;
+    }
+    if (auto vf = VALIDATE_INTERFACE_NO_THROW(f, librealsense::video_frame))
+    {
+        header->width = vf->get_width();
+        header->height = vf->get_height();
+        header->stride_in_bytes = vf->get_stride();
+        header->bits_per_pixel = vf->get_bpp();
+    }
+    else
+    {
+        header->width = header->height = header->stride_in_bytes = header->bits_per_pixel = 0;
+    }
+}
+
+void rs2_get_frame_header(const rs2_frame* frame, rs2_frame_header* header, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_NOT_NULL(header);
+    fill_frame_header((frame_interface*)frame, header);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, frame, header)
+
 void rs2_release_frame(rs2_frame* frame) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -1039,6 +1216,7 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
         throw std::runtime_error("Frame did not arrive in time!");
     }
 
+    trace_frame(fh.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
     return (rs2_frame*)result;
@@ -1052,6 +1230,7 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
     librealsense::frame_holder fh;
     if (queue->queue.try_dequeue(&fh))
     {
+        trace_frame(fh.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
         *output_frame = (rs2_frame*)result;
@@ -1072,6 +1251,7 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
         return false;
     }
 
+    trace_frame(fh.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
     frame_interface* result = nullptr;
     std::swap(result, fh.frame);
     *output_frame = (rs2_frame*)result;
@@ -1079,6 +1259,54 @@ int rs2_try_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frame)
 
+// Moves the frames dequeued in chunks of a buffer on the stack to the array of the caller, only the first chunk waits
+template<class F>
+static int dequeue_frames(rs2_frame** output_frames, int max_frames, F dequeue)
+{
+    const int chunk_size = 64;
+    librealsense::frame_holder chunk[chunk_size];
+    int count = 0;
+    while (count < max_frames)
+    {
+        auto requested = std::min(chunk_size, max_frames - count);
+        auto dequeued = static_cast<int>(dequeue(chunk, requested, count == 0));
+        for (int i = 0; i < dequeued; i++)
+        {
+            trace_frame(chunk[i].frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
+            frame_interface* result = nullptr;
+            std::swap(result, chunk[i].frame);
+            output_frames[count++] = (rs2_frame*)result;
+        }
+        if (dequeued < requested)
+            break;
+    }
+    return count;
+}
+
+int rs2_poll_for_frames(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(output_frames);
+    VALIDATE_RANGE(max_frames, 0, std::numeric_limits<int>::max());
+    return dequeue_frames(output_frames, max_frames, [&](librealsense::frame_holder* frames, int count, bool)
+    {
+        return queue->queue.try_dequeue_many(frames, count);
+    });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frames, max_frames)
+
+int rs2_wait_for_frames(rs2_frame_queue* queue, unsigned int timeout_ms, rs2_frame** output_frames, int max_frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(output_frames);
+    VALIDATE_RANGE(max_frames, 0, std::numeric_limits<int>::max());
+    return dequeue_frames(output_frames, max_frames, [&](librealsense::frame_holder* frames, int count, bool first)
+    {
+        return first ? queue->queue.dequeue_many(frames, count, timeout_ms) : queue->queue.try_dequeue_many(frames, count);
+    });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, queue, timeout_ms, output_frames, max_frames)
+
 void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -1090,6 +1318,14 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
 }
 NOEXCEPT_RETURN(, frame, queue)
 
+void rs2_get_frame_queue_metrics(rs2_frame_queue* queue, rs2_frame_queue_metrics* metrics, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(metrics);
+    *metrics = { unsigned(queue->queue.size()), queue->queue.capacity(), queue->queue.dropped() };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, queue, metrics)
+
 void rs2_flush_queue(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -1170,6 +1406,38 @@ void rs2_hardware_reset(const rs2_device* device, rs2_error** error) BEGIN_API_C
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_get_device_memory_usage(const rs2_device* device, rs2_memory_usage* usage, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(usage);
+    auto dev = std::dynamic_pointer_cast<librealsense::device>(device->device);
+    if (!dev)
+        throw not_implemented_exception("This device does not count its memory");
+    *usage = dev->get_memory_counter()->get();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, usage)
+
+int rs2_get_device_numa_node(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto dev = std::dynamic_pointer_cast<librealsense::device>(device->device);
+    if (!dev)
+        return -1;
+    return dev->get_numa_node();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, device)
+
+void rs2_set_frame_memory_policy(const rs2_device* device, int numa_node, int huge_pages, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(numa_node, -1, 1023);
+    auto dev = std::dynamic_pointer_cast<librealsense::device>(device->device);
+    if (!dev)
+        throw not_implemented_exception("The frame memory of this device is not configurable");
+    dev->set_frame_memory_policy(numa_node, huge_pages != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, numa_node, huge_pages)
+
 // Verify  and provide API version encoded as integer value
 int rs2_get_api_version(rs2_error** error) BEGIN_API_CALL
 {
@@ -1255,11 +1523,18 @@ const char* rs2_distortion_to_string(rs2_distortion distortion)
 const char* rs2_option_to_string(rs2_option option)                                       { return librealsense::get_string(option);       }
 const char* rs2_camera_info_to_string(rs2_camera_info info)                               { return librealsense::get_string(info);         }
 const char* rs2_timestamp_domain_to_string(rs2_timestamp_domain info)                     { return librealsense::get_string(info);         }
+const char* rs2_frame_drop_cause_to_string(rs2_frame_drop_cause cause)                    { return librealsense::get_string(cause);        }
+const char* rs2_frame_trace_stage_to_string(rs2_frame_trace_stage stage)                  { return librealsense::get_string(stage);        }
+const char* rs2_memory_category_to_string(rs2_memory_category category)                   { return librealsense::get_string(category);     }
+const char* rs2_memory_budget_policy_to_string(rs2_memory_budget_policy policy)           { return librealsense::get_string(policy);       }
+const char* rs2_thread_role_to_string(rs2_thread_role role)                                 { return librealsense::get_string(role);         }
+const char* rs2_points_format_to_string(rs2_points_format format)                         { return librealsense::get_string(format);       }
 const char* rs2_notification_category_to_string(rs2_notification_category category)       { return librealsense::get_string(category);     }
 const char* rs2_sr300_visual_preset_to_string(rs2_sr300_visual_preset preset)             { return librealsense::get_string(preset);       }
 const char* rs2_log_severity_to_string(rs2_log_severity severity)                         { return librealsense::get_string(severity);     }
 const char* rs2_exception_type_to_string(rs2_exception_type type)                         { return librealsense::get_string(type);         }
 const char* rs2_playback_status_to_string(rs2_playback_status status)                     { return librealsense::get_string(status);       }
+const char* rs2_frame_compression_to_string(rs2_frame_compression compression)             { return librealsense::get_string(compression);  }
 const char* rs2_extension_type_to_string(rs2_extension type)                              { return librealsense::get_string(type);         }
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata)               { return librealsense::get_string(metadata);     }
 const char* rs2_extension_to_string(rs2_extension type)                                   { return rs2_extension_type_to_string(type);     }
@@ -1462,7 +1737,9 @@ int rs2_is_processing_block_extendable_to(const rs2_processing_block* f, rs2_ext
     case RS2_EXTENSION_SPATIAL_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::spatial_filter) != nullptr;
     case RS2_EXTENSION_TEMPORAL_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::temporal_filter) != nullptr;
     case RS2_EXTENSION_HOLE_FILLING_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::hole_filling_filter) != nullptr;
+#ifdef WITH_L500
     case RS2_EXTENSION_ZERO_ORDER_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::zero_order) != nullptr;
+#endif
     case RS2_EXTENSION_DEPTH_HUFFMAN_DECODER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::depth_decompression_huffman) != nullptr;
     case RS2_EXTENSION_HDR_MERGE: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::hdr_merge) != nullptr;
     case RS2_EXTENSION_SEQUENCE_ID_FILTER: return VALIDATE_INTERFACE_NO_THROW((processing_block_interface*)(f->block.get()), librealsense::sequence_id_filter) != nullptr;
@@ -1525,6 +1802,23 @@ void rs2_context_unload_tracking_module(rs2_context* ctx, rs2_error** error) BEG
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, ctx)
 
+void rs2_set_memory_budget(rs2_context* ctx, long long bytes, rs2_memory_budget_policy policy, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(policy);
+    VALIDATE_RANGE(bytes, 0, std::numeric_limits<long long>::max());
+    auto& counter = ctx ? ctx->ctx->get_memory_counter() : memory_counter::global();
+    counter->set_budget(bytes, policy);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, ctx, bytes, policy)
+
+void rs2_get_context_memory_usage(const rs2_context* ctx, rs2_memory_usage* usage, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(ctx);
+    VALIDATE_NOT_NULL(usage);
+    *usage = ctx->ctx->get_memory_counter()->get();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, ctx, usage)
+
 const char* rs2_playback_device_get_file_path(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1582,6 +1876,33 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_playback_device_set_ordered_delivery(const rs2_device* device, int ordered, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_ordered_delivery(ordered != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device)
+
+void rs2_playback_device_join(const rs2_device* device, const rs2_device* other, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(other);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    auto other_playback = VALIDATE_INTERFACE(other->device, librealsense::playback_device);
+    playback->join(*other_playback);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, other)
+
+void rs2_playback_device_set_frame_cache_size(const rs2_device* device, int frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(frames, 0, 4096);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_frame_cache_size(static_cast<uint32_t>(frames));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, frames)
+
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1672,6 +1993,97 @@ const char* rs2_record_device_filename(const rs2_device* device, rs2_error** err
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device)
 
+void rs2_record_device_set_blocking_write(const rs2_device* device, int blocking, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_blocking_write(blocking != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, blocking)
+
+void rs2_record_device_set_frame_compression(const rs2_device* device, rs2_stream stream, rs2_frame_compression compression, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    VALIDATE_ENUM(compression);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_frame_compression(stream, compression);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, compression)
+
+void rs2_record_device_set_file_per_stream(const rs2_device* device, int file_per_stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_file_per_stream(file_per_stream != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, file_per_stream)
+
+unsigned long long rs2_record_device_get_written_frames(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    return record_device->get_written_frames();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device)
+
+unsigned long long rs2_record_device_get_dropped_frames(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    return record_device->get_dropped_frames();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device)
+
+void rs2_record_device_set_stream_decimation(const rs2_device* device, rs2_stream stream, int every_nth, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    VALIDATE_RANGE(every_nth, 1, std::numeric_limits<int>::max());
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_stream_decimation(stream, every_nth);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, every_nth)
+
+void rs2_record_device_set_stream_processing(const rs2_device* device, rs2_stream stream, rs2_processing_block* block, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_stream_processing(stream, block ? block->block : nullptr);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, block)
+
+void rs2_record_device_set_stream_trigger(const rs2_device* device, rs2_stream stream, float pre_trigger_seconds, float post_trigger_seconds, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    VALIDATE_RANGE(pre_trigger_seconds, 0.f, std::numeric_limits<float>::max());
+    VALIDATE_RANGE(post_trigger_seconds, 0.f, std::numeric_limits<float>::max());
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->set_stream_trigger(stream,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float>(pre_trigger_seconds)),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float>(post_trigger_seconds)));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, pre_trigger_seconds, post_trigger_seconds)
+
+void rs2_record_device_trigger(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->trigger();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device)
+
+void rs2_record_device_clear_stream_policy(const rs2_device* device, rs2_stream stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_ENUM(stream);
+    auto record_device = VALIDATE_INTERFACE(device->device, librealsense::record_device);
+    record_device->clear_stream_policy(stream);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream)
+
 
 rs2_frame* rs2_allocate_synthetic_video_frame(rs2_source* source, const rs2_stream_profile* new_stream, rs2_frame* original,
     int new_bpp, int new_width, int new_height, int new_stride, rs2_extension frame_type, rs2_error** error) BEGIN_API_CALL
@@ -1748,6 +2160,7 @@ rs2_frame* rs2_pipeline_wait_for_frames(rs2_pipeline* pipe, unsigned int timeout
     VALIDATE_NOT_NULL(pipe);
 
     auto f = pipe->pipeline->wait_for_frames(timeout_ms);
+    trace_frame(f.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
     auto frame = f.frame;
     f.frame = nullptr;
     return (rs2_frame*)(frame);
@@ -1762,6 +2175,7 @@ int rs2_pipeline_poll_for_frames(rs2_pipeline * pipe, rs2_frame** output_frame,
     librealsense::frame_holder fh;
     if (pipe->pipeline->poll_for_frames(&fh))
     {
+        trace_frame(fh.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
         *output_frame = (rs2_frame*)result;
@@ -1779,6 +2193,7 @@ int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_fram
     librealsense::frame_holder fh;
     if (pipe->pipeline->try_wait_for_frames(&fh, timeout_ms))
     {
+        trace_frame(fh.frame, RS2_FRAME_TRACE_STAGE_USER_DEQUEUE);
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
         *output_frame = (rs2_frame*)result;
@@ -1788,6 +2203,24 @@ int rs2_pipeline_try_wait_for_frames(rs2_pipeline* pipe, rs2_frame** output_fram
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, output_frame)
 
+void rs2_pipeline_add_consumer(rs2_pipeline* pipe, rs2_frame_queue* queue, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_NOT_NULL(queue);
+    librealsense::frame_callback_ptr callback(
+        new librealsense::frame_callback(rs2_enqueue_frame, queue));
+    pipe->pipeline->add_consumer(queue, move(callback));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pipe, queue)
+
+void rs2_pipeline_remove_consumer(rs2_pipeline* pipe, rs2_frame_queue* queue, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_NOT_NULL(queue);
+    pipe->pipeline->remove_consumer(queue);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pipe, queue)
+
 void rs2_delete_pipeline(rs2_pipeline* pipe) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(pipe);
@@ -1811,6 +2244,47 @@ rs2_pipeline_profile* rs2_pipeline_start_with_config(rs2_pipeline* pipe, rs2_con
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, pipe, config)
 
+void rs2_pipelines_start(rs2_pipeline** pipes, rs2_config** configs, int count, int max_parallel,
+    rs2_pipeline_profile** profiles, rs2_pipeline_start_report* reports, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipes);
+    VALIDATE_NOT_NULL(configs);
+    VALIDATE_NOT_NULL(profiles);
+    VALIDATE_RANGE(count, 1, std::numeric_limits<int>::max());
+    VALIDATE_RANGE(max_parallel, 0, std::numeric_limits<int>::max());
+
+    std::vector<std::pair<std::shared_ptr<pipeline::pipeline>, std::shared_ptr<pipeline::config>>> requests;
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_NOT_NULL(pipes[i]);
+        requests.emplace_back(pipes[i]->pipeline, configs[i] ? configs[i]->config : std::make_shared<pipeline::config>());
+    }
+
+    auto results = pipeline::pipeline::start_all(requests, max_parallel);
+
+    std::exception_ptr first_error;
+    for (int i = 0; i < count; ++i)
+    {
+        profiles[i] = results[i].active_profile ? new rs2_pipeline_profile{ results[i].active_profile } : nullptr;
+        if (reports)
+        {
+            reports[i].started = results[i].active_profile ? 1 : 0;
+            reports[i].duration_ms = results[i].duration.count();
+        }
+        if (results[i].error)
+        {
+            try { std::rethrow_exception(results[i].error); }
+            catch (const std::exception& e) { LOG_ERROR("Pipeline " << i << " failed to start: " << e.what()); }
+            catch (...) { LOG_ERROR("Pipeline " << i << " failed to start"); }
+            if (!first_error)
+                first_error = results[i].error;
+        }
+    }
+    if (first_error)
+        std::rethrow_exception(first_error);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pipes, configs, count, max_parallel, profiles, reports)
+
 rs2_pipeline_profile* rs2_pipeline_start_with_callback(rs2_pipeline* pipe, rs2_frame_callback_ptr on_frame, void* user, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(pipe);
@@ -1857,6 +2331,27 @@ rs2_pipeline_profile* rs2_pipeline_get_active_profile(rs2_pipeline* pipe, rs2_er
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, pipe)
 
+int rs2_pipeline_get_metrics(rs2_pipeline* pipe, rs2_stream_metrics* metrics, int count, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_RANGE(count, 0, 1024);
+    if (count) VALIDATE_NOT_NULL(metrics);
+
+    std::vector<rs2_stream_metrics> streams;
+    auto dev = pipe->pipeline->get_active_profile()->get_device();
+    for (size_t i = 0; i < dev->get_sensors_count(); i++)
+    {
+        if (auto sensor = dynamic_cast<librealsense::sensor_base*>(&dev->get_sensor(i)))
+        {
+            auto sensor_streams = sensor->get_metrics().get();
+            streams.insert(streams.end(), sensor_streams.begin(), sensor_streams.end());
+        }
+    }
+    std::copy_n(streams.begin(), std::min(int(streams.size()), count), metrics);
+    return int(streams.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, metrics, count)
+
 rs2_device* rs2_pipeline_profile_get_device(rs2_pipeline_profile* profile, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(profile);
@@ -1976,6 +2471,22 @@ void rs2_config_disable_all_streams(rs2_config* config, rs2_error ** error) BEGI
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, config)
 
+void rs2_config_set_sync_latency_budget(rs2_config* config, float budget_ms, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_RANGE(budget_ms, 0.f, 1000.f);
+    config->config->set_sync_latency_budget(budget_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config, budget_ms)
+
+void rs2_config_set_callback_mailbox_size(rs2_config* config, int size, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_RANGE(size, 0, 16);
+    config->config->set_callback_mailbox_size(size);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config, size)
+
 rs2_pipeline_profile* rs2_config_resolve(rs2_config* config, rs2_pipeline* pipe, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(config);
@@ -1992,6 +2503,29 @@ int rs2_config_can_resolve(rs2_config* config, rs2_pipeline* pipe, rs2_error **
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, config, pipe)
 
+int rs2_config_resolve_bandwidth(rs2_config** configs, rs2_pipeline** pipes, int count, rs2_pipeline_profile** profiles, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(configs);
+    VALIDATE_NOT_NULL(pipes);
+    VALIDATE_NOT_NULL(profiles);
+    VALIDATE_RANGE(count, 1, std::numeric_limits<int>::max());
+
+    std::vector<std::pair<std::shared_ptr<librealsense::pipeline::config>, std::shared_ptr<librealsense::pipeline::pipeline>>> requests;
+    for (int i = 0; i < count; ++i)
+    {
+        VALIDATE_NOT_NULL(configs[i]);
+        VALIDATE_NOT_NULL(pipes[i]);
+        requests.emplace_back(configs[i]->config, pipes[i]->pipeline);
+    }
+
+    std::vector<std::shared_ptr<librealsense::pipeline::profile>> resolved;
+    auto fits = librealsense::pipeline::config::resolve_bandwidth(requests, resolved);
+    for (int i = 0; i < count; ++i)
+        profiles[i] = new rs2_pipeline_profile{ resolved[i] };
+    return fits ? 1 : 0;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, configs, pipes, count, profiles)
+
 rs2_processing_block* rs2_create_processing_block(rs2_frame_processor_callback* proc, rs2_error** error) BEGIN_API_CALL
 {
     auto block = std::make_shared<librealsense::processing_block>("Custom processing block");
@@ -2039,6 +2573,15 @@ rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error) BEGIN_
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(tolerance_ms, 0.f, 1000.f);
+    auto block = librealsense::syncer_process_unit::create_multi_device(tolerance_ms);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, tolerance_ms)
+
 void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
@@ -2079,10 +2622,45 @@ void rs2_delete_processing_block(rs2_processing_block* block) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
 
+    // Frames still queued for an asynchronous block must be done while the derived block is whole
+    if (auto pb = dynamic_cast<librealsense::processing_block*>(block->block.get()))
+        pb->stop();
     delete block;
 }
 NOEXCEPT_RETURN(, block)
 
+void rs2_set_processing_block_async(rs2_processing_block* block, int async, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    auto pb = dynamic_cast<librealsense::processing_block*>(block->block.get());
+    if (!pb)
+        throw librealsense::not_implemented_exception("Asynchronous invocation is not supported by this processing block");
+    pb->set_async(async != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, async)
+
+void rs2_configure_processing_executor(int workers, const int* cpus, int cpus_count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(workers, 0, 1024);
+    VALIDATE_RANGE(cpus_count, 0, 1024);
+    if (cpus_count) VALIDATE_NOT_NULL(cpus);
+    std::vector<int> cpu_list;
+    if (cpus_count) cpu_list.assign(cpus, cpus + cpus_count);
+    librealsense::processing_executor::get_instance().configure(workers, cpu_list);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, workers, cpus, cpus_count)
+
+void rs2_get_processing_block_metrics(const rs2_processing_block* block, rs2_processing_block_metrics* metrics, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    VALIDATE_NOT_NULL(metrics);
+    auto pb = std::dynamic_pointer_cast<librealsense::processing_block>(block->block);
+    if (!pb)
+        throw librealsense::not_implemented_exception("Metrics are not supported by this processing block");
+    *metrics = pb->get_metrics();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, metrics)
+
 rs2_frame* rs2_extract_frame(rs2_frame* composite, int index, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(composite);
@@ -2123,6 +2701,25 @@ int rs2_embedded_frames_count(rs2_frame* composite, rs2_error** error) BEGIN_API
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, composite)
 
+int rs2_get_frameset_headers(const rs2_frame* composite, rs2_frame_header* headers, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(composite);
+    VALIDATE_NOT_NULL(headers);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+
+    auto cf = VALIDATE_INTERFACE((frame_interface*)composite, librealsense::composite_frame);
+
+    auto size = static_cast<int>(cf->get_embedded_frames_count());
+    auto frames = cf->get_frames();
+    for (int i = 0; i < std::min(size, count); i++)
+    {
+        VALIDATE_NOT_NULL(frames[i]);
+        fill_frame_header(frames[i], &headers[i]);
+    }
+    return size;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, composite, headers, count)
+
 rs2_vertex* rs2_get_frame_vertices(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -2156,6 +2753,63 @@ int rs2_get_frame_points_count(const rs2_frame* frame, rs2_error** error) BEGIN_
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
 
+int rs2_get_motion_samples_count(const rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    auto motion = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::motion_frame);
+    return std::max(1, static_cast<int>(motion->additional_data.motion_samples));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame)
+
+int rs2_get_frame_vertices_in_regions(const rs2_frame* frame, const rs2_pixel_region* regions, int count,
+    rs2_vertex* vertices, rs2_pixel* pixels, int capacity, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    VALIDATE_RANGE(capacity, 0, std::numeric_limits<int>::max());
+    if (count)
+        VALIDATE_NOT_NULL(regions);
+    if (capacity)
+        VALIDATE_NOT_NULL(vertices);
+    auto points = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::points);
+    auto profile = As<video_stream_profile_interface>(points->get_stream().get());
+    if (!profile)
+        throw std::runtime_error("The points frame has no image size");
+
+    auto width = int(profile->get_width());
+    auto spans = pixel_regions::to_spans({ regions, regions + count }, width, int(profile->get_height()));
+    auto in = points->get_vertices();
+    int res = 0;
+    for (auto&& s : spans)
+    {
+        for (int x = s.begin; x < s.end; x++)
+        {
+            auto& p = in[s.y * width + x];
+            if (!p.z)
+                continue;
+            if (res < capacity)
+            {
+                vertices[res] = { { p.x, p.y, p.z } };
+                if (pixels)
+                    pixels[res] = { { x, s.y } };
+            }
+            res++;
+        }
+    }
+    return res;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, regions, count, vertices, pixels, capacity)
+
+int rs2_pack_points(const rs2_frame* frame, rs2_points_format format, int valid_only, void* buffer, int size, int* indices, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_ENUM(format);
+    VALIDATE_RANGE(size, 0, std::numeric_limits<int>::max());
+    auto points = VALIDATE_INTERFACE((frame_interface*)frame, librealsense::points);
+    return points->pack(format, valid_only != 0, buffer, size, indices);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, format, valid_only, buffer, size, indices)
+
 rs2_processing_block* rs2_create_pointcloud(rs2_error** error) BEGIN_API_CALL
 {
     return new rs2_processing_block { pointcloud::create() };
@@ -2174,6 +2828,41 @@ rs2_processing_block* rs2_create_threshold(rs2_error** error) BEGIN_API_CALL
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_voxel_grid_filter(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_block { std::make_shared<voxel_grid_filter>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_depth_to_scan(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_block { std::make_shared<depth_to_scan>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+void rs2_get_scan_angles(const rs2_intrinsics* depth_intrinsics, int bins, float* angle_min, float* angle_increment, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(depth_intrinsics);
+    VALIDATE_RANGE(bins, 1, std::numeric_limits<int>::max());
+    VALIDATE_NOT_NULL(angle_min);
+    VALIDATE_NOT_NULL(angle_increment);
+
+    get_scan_angles(*depth_intrinsics, bins, angle_min, angle_increment);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, depth_intrinsics, bins, angle_min, angle_increment)
+
+rs2_processing_block* rs2_create_median_filter(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_block { std::make_shared<median_filter>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_create_tensor_converter(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_block { std::make_shared<tensor_converter>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 rs2_processing_block* rs2_create_units_transform(rs2_error** error) BEGIN_API_CALL
 {
     return new rs2_processing_block { std::make_shared<units_transform>() };
@@ -2184,7 +2873,30 @@ rs2_processing_block* rs2_create_align(rs2_stream align_to, rs2_error** error) B
 {
     VALIDATE_ENUM(align_to);
 
-    auto block = create_align(align_to);
+    auto block = create_align({ align_to });
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, align_to)
+
+rs2_processing_block* rs2_create_align_to_streams(const rs2_stream* align_to, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(align_to);
+    VALIDATE_RANGE(count, 1, RS2_STREAM_COUNT);
+    for (int i = 0; i < count; ++i)
+        VALIDATE_ENUM(align_to[i]);
+
+    auto block = create_align(std::vector<rs2_stream>(align_to, align_to + count));
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, align_to, count)
+
+rs2_processing_block* rs2_create_align_pointcloud(rs2_stream align_to, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(align_to);
+
+    auto block = std::make_shared<librealsense::align_pointcloud>(align_to);
 
     return new rs2_processing_block{ block };
 }
@@ -2241,6 +2953,42 @@ rs2_processing_block* rs2_create_hole_filling_filter_block(rs2_error** error) BE
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_depth_filter_chain_block(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::depth_filter_chain>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+rs2_processing_block* rs2_get_depth_filter_chain_stage(rs2_processing_block* block, rs2_extension stage, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    VALIDATE_ENUM(stage);
+    auto chain = std::dynamic_pointer_cast<librealsense::depth_filter_chain>(block->block);
+    if (!chain)
+        throw std::runtime_error("The block is not a depth filter chain");
+
+    return new rs2_processing_block{ chain->get_stage(stage) };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, block, stage)
+
+void rs2_set_processing_block_regions(rs2_processing_block* block, const rs2_pixel_region* regions, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    if (count)
+        VALIDATE_NOT_NULL(regions);
+
+    if (auto pc = std::dynamic_pointer_cast<librealsense::pointcloud>(block->block))
+        pc->get_regions().set(regions, count);
+    else if (auto al = std::dynamic_pointer_cast<librealsense::align>(block->block))
+        al->get_regions().set(regions, count);
+    else
+        throw std::runtime_error("The block is not a pointcloud or an align block");
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, regions, count)
+
 rs2_processing_block* rs2_create_rates_printer_block(rs2_error** error) BEGIN_API_CALL
 {
     auto block = std::make_shared<librealsense::rates_printer>();
@@ -2251,9 +2999,13 @@ NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
 rs2_processing_block* rs2_create_zero_order_invalidation_block(rs2_error** error) BEGIN_API_CALL
 {
+#ifdef WITH_L500
     auto block = std::make_shared<librealsense::zero_order>();
 
     return new rs2_processing_block{ block };
+#else
+    throw not_implemented_exception("The zero order processing block requires building with BUILD_WITH_L500");
+#endif
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
@@ -2281,6 +3033,14 @@ rs2_processing_block* rs2_create_sequence_id_filter(rs2_error** error) BEGIN_API
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_sequence_id_demux(rs2_error** error) BEGIN_API_CALL
+{
+    auto block = std::make_shared<librealsense::sequence_id_demux>();
+
+    return new rs2_processing_block{ block };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
 float rs2_get_depth_scale(rs2_sensor* sensor, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2331,6 +3091,42 @@ float rs2_depth_stereo_frame_get_baseline(const rs2_frame* frame_ref, rs2_error*
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
 
+void rs2_enable_frame_trace(int enable, rs2_error** error) BEGIN_API_CALL
+{
+    frame_trace::enable(enable != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, enable)
+
+int rs2_get_frame_trace(const rs2_frame* frame, rs2_frame_trace_stamp* stamps, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    if (count > 0)
+        VALIDATE_NOT_NULL(stamps);
+
+    auto f = dynamic_cast<librealsense::frame*>((frame_interface*)frame);
+    if (!f)
+        throw invalid_value_exception("the frame does not keep a frame trace");
+    auto& trace = f->additional_data.trace;
+    for (int i = 0; i < std::min(count, trace.size()); i++)
+        stamps[i] = trace[i];
+    return trace.size();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame, stamps, count)
+
+void rs2_start_frame_trace_file(const char* filename, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(filename);
+    start_frame_trace_file(filename);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, filename)
+
+void rs2_stop_frame_trace_file(rs2_error** error) BEGIN_API_CALL
+{
+    stop_frame_trace_file();
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN()
+
 void rs2_pose_frame_get_pose_data(const rs2_frame* frame, rs2_pose* pose, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -2367,6 +3163,13 @@ rs2_time_t rs2_get_time(rs2_error** error) BEGIN_API_CALL
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(0)
 
+void rs2_get_memory_usage(rs2_memory_usage* usage, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(usage);
+    *usage = memory_counter::global()->get();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, usage)
+
 rs2_device* rs2_create_software_device(rs2_error** error) BEGIN_API_CALL
 {
     auto dev = std::make_shared<software_device>();
@@ -2421,6 +3224,18 @@ void rs2_software_sensor_on_video_frame(rs2_sensor* sensor, rs2_software_video_f
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frame.pixels)
 
+void rs2_software_sensor_on_video_frames(rs2_sensor* sensor, const rs2_software_video_frame* frames, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(frames);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    auto bs = VALIDATE_INTERFACE(sensor->sensor, librealsense::software_sensor);
+    for (int i = 0; i < count; i++)
+        VALIDATE_NOT_NULL(frames[i].profile);
+    bs->on_video_frames(frames, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, frames, count)
+
 void rs2_software_sensor_on_motion_frame(rs2_sensor* sensor, rs2_software_motion_frame frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -2830,6 +3645,17 @@ int rs2_remove_static_node(const rs2_sensor* sensor, const char* guid, rs2_error
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, guid)
 
+int rs2_get_latest_pose(const rs2_sensor* sensor, rs2_pose* pose, double* timestamp, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(pose);
+    VALIDATE_NOT_NULL(timestamp);
+    auto pose_snr = VALIDATE_INTERFACE(sensor->sensor, librealsense::pose_sensor_interface);
+
+    return int(pose_snr->get_latest_pose(*pose, *timestamp));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, sensor, pose, timestamp)
+
 int rs2_load_wheel_odometry_config(const rs2_sensor* sensor, const unsigned char* odometry_blob, unsigned int blob_size, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -3088,6 +3914,92 @@ const rs2_raw_data_buffer* rs2_run_tare_calibration(rs2_device* device, float gr
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device)
 
+void rs2_run_on_chip_calibration_async_cpp(rs2_device* device, const void* json_content, int content_size, rs2_update_progress_callback* progress_callback, rs2_calibration_done_callback* done_callback, int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callbacks before anything can throw
+    librealsense::update_progress_callback_ptr progress_cb;
+    if (progress_callback)
+        progress_cb.reset(progress_callback, [](rs2_update_progress_callback* p) { p->release(); });
+    librealsense::calibration_done_callback_ptr done_cb(done_callback, [](rs2_calibration_done_callback* p) { p->release(); });
+
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(done_callback);
+
+    if (content_size > 0)
+        VALIDATE_NOT_NULL(json_content);
+
+    auto auto_calib = VALIDATE_INTERFACE(device->device, librealsense::auto_calibrated_interface);
+
+    std::string json((char*)json_content, (char*)json_content + content_size);
+    auto_calib->run_on_chip_calibration_async(timeout_ms, json, progress_cb, done_cb);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, done_callback)
+
+void rs2_run_on_chip_calibration_async(rs2_device* device, const void* json_content, int content_size, rs2_update_progress_callback_ptr progress_callback, rs2_calibration_done_callback_ptr done_callback, void* user, int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(done_callback);
+
+    if (content_size > 0)
+        VALIDATE_NOT_NULL(json_content);
+
+    auto auto_calib = VALIDATE_INTERFACE(device->device, librealsense::auto_calibrated_interface);
+
+    std::string json((char*)json_content, (char*)json_content + content_size);
+
+    librealsense::update_progress_callback_ptr progress_cb;
+    if (progress_callback)
+        progress_cb.reset(new librealsense::update_progress_callback(progress_callback, user), [](update_progress_callback* p) { delete p; });
+    librealsense::calibration_done_callback_ptr done_cb(new librealsense::calibration_done_callback(done_callback, user),
+        [](calibration_done_callback* p) { delete p; });
+
+    auto_calib->run_on_chip_calibration_async(timeout_ms, json, progress_cb, done_cb);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, done_callback)
+
+void rs2_run_tare_calibration_async_cpp(rs2_device* device, float ground_truth_mm, const void* json_content, int content_size, rs2_update_progress_callback* progress_callback, rs2_calibration_done_callback* done_callback, int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    // Take ownership of the callbacks before anything can throw
+    librealsense::update_progress_callback_ptr progress_cb;
+    if (progress_callback)
+        progress_cb.reset(progress_callback, [](rs2_update_progress_callback* p) { p->release(); });
+    librealsense::calibration_done_callback_ptr done_cb(done_callback, [](rs2_calibration_done_callback* p) { p->release(); });
+
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(done_callback);
+
+    if (content_size > 0)
+        VALIDATE_NOT_NULL(json_content);
+
+    auto auto_calib = VALIDATE_INTERFACE(device->device, librealsense::auto_calibrated_interface);
+
+    std::string json((char*)json_content, (char*)json_content + content_size);
+    auto_calib->run_tare_calibration_async(timeout_ms, ground_truth_mm, json, progress_cb, done_cb);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, ground_truth_mm, done_callback)
+
+void rs2_run_tare_calibration_async(rs2_device* device, float ground_truth_mm, const void* json_content, int content_size, rs2_update_progress_callback_ptr progress_callback, rs2_calibration_done_callback_ptr done_callback, void* user, int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(done_callback);
+
+    if (content_size > 0)
+        VALIDATE_NOT_NULL(json_content);
+
+    auto auto_calib = VALIDATE_INTERFACE(device->device, librealsense::auto_calibrated_interface);
+
+    std::string json((char*)json_content, (char*)json_content + content_size);
+
+    librealsense::update_progress_callback_ptr progress_cb;
+    if (progress_callback)
+        progress_cb.reset(new librealsense::update_progress_callback(progress_callback, user), [](update_progress_callback* p) { delete p; });
+    librealsense::calibration_done_callback_ptr done_cb(new librealsense::calibration_done_callback(done_callback, user),
+        [](calibration_done_callback* p) { delete p; });
+
+    auto_calib->run_tare_calibration_async(timeout_ms, ground_truth_mm, json, progress_cb, done_cb);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, ground_truth_mm, done_callback)
+
 const rs2_raw_data_buffer* rs2_get_calibration_table(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -3152,6 +4064,23 @@ int rs2_get_fw_log(rs2_device* dev, rs2_firmware_log_message* fw_log_msg, rs2_er
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, dev, fw_log_msg)
 
+int rs2_get_fw_logs(rs2_device* dev, rs2_firmware_log_message** fw_log_msgs, int count, unsigned int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(dev);
+    VALIDATE_NOT_NULL(fw_log_msgs);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    auto fw_loggerable = VALIDATE_INTERFACE(dev->device, librealsense::firmware_logger_extensions);
+    for (int i = 0; i < count; ++i)
+        VALIDATE_NOT_NULL(fw_log_msgs[i]);
+
+    std::vector<fw_logs::fw_logs_binary_data> logs;
+    auto pulled = fw_loggerable->get_fw_logs(logs, count, timeout_ms);
+    for (size_t i = 0; i < pulled; ++i)
+        *(fw_log_msgs[i]->firmware_log_binary_data) = std::move(logs[i]);
+    return static_cast<int>(pulled);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, dev, fw_log_msgs, count, timeout_ms)
+
 int rs2_get_flash_log(rs2_device* dev, rs2_firmware_log_message* fw_log_msg, rs2_error** error)BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(dev);
@@ -3337,5 +4266,52 @@ rs2_raw_data_buffer* rs2_terminal_parse_response(rs2_terminal_parser* terminal_p
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, terminal_parser, command, response)
 
+void rs2_deproject_pixels_to_points(float* points, const rs2_intrinsics* intrin, const float* pixels, const float* depths, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(points);
+    VALIDATE_NOT_NULL(intrin);
+    VALIDATE_NOT_NULL(pixels);
+    VALIDATE_NOT_NULL(depths);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    if (intrin->model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
+        throw librealsense::invalid_value_exception("cannot deproject from a forward-distorted image");
 
+    librealsense::deproject_pixels_to_points(points, *intrin, pixels, depths, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, points, intrin, pixels, depths, count)
 
+void rs2_project_points_to_pixels(float* pixels, const rs2_intrinsics* intrin, const float* points, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pixels);
+    VALIDATE_NOT_NULL(intrin);
+    VALIDATE_NOT_NULL(points);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+
+    librealsense::project_points_to_pixels(pixels, *intrin, points, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pixels, intrin, points, count)
+
+void rs2_project_color_pixels_to_depth_pixels(float* to_pixels,
+    const uint16_t* data, float depth_scale,
+    float depth_min, float depth_max,
+    const rs2_intrinsics* depth_intrin,
+    const rs2_intrinsics* color_intrin,
+    const rs2_extrinsics* color_to_depth,
+    const rs2_extrinsics* depth_to_color,
+    const float* from_pixels, int count, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(to_pixels);
+    VALIDATE_NOT_NULL(data);
+    VALIDATE_NOT_NULL(depth_intrin);
+    VALIDATE_NOT_NULL(color_intrin);
+    VALIDATE_NOT_NULL(color_to_depth);
+    VALIDATE_NOT_NULL(depth_to_color);
+    VALIDATE_NOT_NULL(from_pixels);
+    VALIDATE_RANGE(count, 0, std::numeric_limits<int>::max());
+    if (color_intrin->model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY || depth_intrin->model == RS2_DISTORTION_MODIFIED_BROWN_CONRADY)
+        throw librealsense::invalid_value_exception("cannot deproject from a forward-distorted image");
+
+    librealsense::project_color_pixels_to_depth_pixels(to_pixels, data, depth_scale, depth_min, depth_max,
+        *depth_intrin, *color_intrin, *color_to_depth, *depth_to_color, from_pixels, count);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, to_pixels, data, depth_scale, depth_min, depth_max, depth_intrin, color_intrin, from_pixels, count)
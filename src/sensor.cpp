@@ -16,6 +16,8 @@
 #include "proc/decimation-filter.h"
 #include "proc/depth-decompress.h"
 #include "global_timestamp_reader.h"
+#include "callback-executor.h"
+#include "profiler.h"
 
 namespace librealsense
 {
@@ -31,6 +33,8 @@ namespace librealsense
         _notifications_processor(std::shared_ptr<notifications_processor>(new notifications_processor())),
         _on_open(nullptr),
         _metadata_parsers(std::make_shared<metadata_parser_map>()),
+        _metrics(std::make_shared<stream_metrics>()),
+        _option_cache(std::make_shared<option_cache>()),
         _owner(dev),
         _profiles([this]() {
         auto profiles = this->init_stream_profiles();
@@ -39,6 +43,17 @@ namespace librealsense
     })
     {
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
+        register_option(RS2_OPTION_FRAME_POOL_RETENTION, _source.get_freelist_retention_option());
+        if (dev)
+            _source.set_memory_counter(dev->get_memory_counter());
+
+        // A notification may come with a change the options do not see, such as the laser power reduced by the device
+        std::weak_ptr<option_cache> cache = _option_cache;
+        _notifications_processor->set_on_raise([cache]()
+        {
+            if (auto strong = cache.lock())
+                strong->invalidate();
+        });
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
 
@@ -102,6 +117,13 @@ namespace librealsense
         return _source.set_callback(callback);
     }
 
+    void sensor_base::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        if (is_streaming())
+            throw wrong_api_call_sequence_exception("set_frame_allocator(...) failed. Sensor is streaming!");
+        _source.set_frame_allocator(std::move(allocator));
+    }
+
     bool sensor_base::is_streaming() const
     {
         return _is_streaming;
@@ -172,6 +194,35 @@ namespace librealsense
     {
         on_before_streaming_changes(streaming);
     }
+    frame_holder sensor_base::alloc_frame(const stream_profile_interface& profile, rs2_extension type, size_t size,
+        const frame_additional_data& additional_data, bool requires_memory)
+    {
+        try
+        {
+            frame_holder fh = _source.alloc_frame(type, size, additional_data, requires_memory);
+            if (!fh)
+            {
+                _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_FRAME_POOL_FULL);
+                LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+            }
+            else
+                _over_budget = false;
+            return fh;
+        }
+        catch (const memory_budget_exceeded& e)
+        {
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_MEMORY_BUDGET);
+            LOG_DEBUG("Dropped frame. " << e.what());
+            if (e.get_policy() == RS2_MEMORY_BUDGET_POLICY_FAIL && !_over_budget.exchange(true))
+            {
+                notification n{ RS2_NOTIFICATION_CATEGORY_MEMORY_BUDGET_EXCEEDED, 0, RS2_LOG_SEVERITY_ERROR,
+                    to_string() << "Frames of " << get_string(profile.get_stream_type()) << " are dropped, their buffers would exceed the memory budget" };
+                _notifications_processor->raise_notification(n);
+            }
+            return {};
+        }
+    }
+
     void sensor_base::set_active_streams(const stream_profiles& requests)
     {
         std::lock_guard<std::mutex> lock(_active_profile_mutex);
@@ -188,6 +239,7 @@ namespace librealsense
     void sensor_base::set_source_owner(sensor_base* owner)
     {
         _source_owner = owner;
+        _metrics = owner->_metrics;
     }
 
     stream_profiles sensor_base::get_stream_profiles(int tag) const
@@ -247,9 +299,8 @@ namespace librealsense
     {
         auto system_time = environment::get_instance().get_time_service()->get_time();
         auto fr = std::make_shared<frame>();
-        byte* pix = (byte*)fo.pixels;
-        std::vector<byte> pixels(pix, pix + fo.frame_size);
-        fr->data = pixels;
+        // The frame only feeds the timestamp readers, refer to the backend buffer instead of copying it
+        fr->attach_continuation(frame_continuation([]() {}, fo.pixels, fo.frame_size));
         fr->set_stream(profile);
 
         // generate additional data
@@ -263,6 +314,8 @@ namespace librealsense
             last_frame_number,
             false,
             fo.frame_size);
+        if (frame_trace::is_enabled())
+            additional_data.trace.add(RS2_FRAME_TRACE_STAGE_BACKEND_DEQUEUE, nullptr, system_time);
         fr->additional_data = additional_data;
 
         // update additional data
@@ -287,6 +340,9 @@ namespace librealsense
 
             if (_is_opened)
                 uvc_sensor::close();
+
+            std::lock_guard<std::mutex> lock(_configure_lock);
+            release_standby();
         }
         catch (...)
         {
@@ -302,13 +358,34 @@ namespace librealsense
         else if (_is_opened)
             throw wrong_api_call_sequence_exception("open(...) failed. UVC device is already opened!");
 
+        // The streams left in standby resume as they are when the same profiles are requested again
+        if (!_standby_requests.empty())
+        {
+            if (_standby_requests == requests)
+            {
+                _standby_requests.clear();
+                _timestamp_reader->reset();
+                _is_opened = true;
+                if (Is<librealsense::global_time_interface>(_owner))
+                {
+                    As<librealsense::global_time_interface>(_owner)->enable_time_diff_keeper(true);
+                }
+                set_active_streams(requests);
+                return;
+            }
+            release_standby();
+        }
+
         auto on = std::unique_ptr<power>(new power(std::dynamic_pointer_cast<uvc_sensor>(shared_from_this())));
+        _option_cache->invalidate();
 
         _source.init(_metadata_parsers);
         _source.set_sensor(_source_owner->shared_from_this());
 
         std::vector<platform::stream_profile> commited;
 
+        _device->set_latest_frame_only(_latest_frame_only);
+
         for (auto&& req_profile : requests)
         {
             auto&& req_profile_base = std::dynamic_pointer_cast<stream_profile_base>(req_profile);
@@ -316,19 +393,31 @@ namespace librealsense
             {
                 unsigned long long last_frame_number = 0;
                 rs2_time_t last_timestamp = 0;
+                // Frames of the stream to skip before the next one is delivered
+                int skip = 0;
+                const int decimation = _frame_decimation;
+                // Formats that need no unpacking refer to the backend buffer instead of copying it, when the backend keeps it valid
+                const bool adopt_buffers = _device->retains_frame_buffers() &&
+                    val_in_range(req_profile_base->get_format(), { RS2_FORMAT_Z16, RS2_FORMAT_Y8, RS2_FORMAT_Y16 });
                 _device->probe_and_commit(req_profile_base->get_backend_profile(),
-                    [this, req_profile_base, req_profile, last_frame_number, last_timestamp](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
+                    [this, req_profile_base, req_profile, last_frame_number, last_timestamp, skip, decimation, adopt_buffers](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
                 {
+                    LRS_PROFILE_ZONE("uvc_sensor::on_frame");
                     const auto&& system_time = environment::get_instance().get_time_service()->get_time();
                     const auto&& fr = generate_frame_from_data(f, _timestamp_reader.get(), last_timestamp, last_frame_number, req_profile_base);
-                    const auto&& requires_processing = true; // TODO - Ariel add option
                     const auto&& timestamp_domain = _timestamp_reader->get_frame_timestamp_domain(fr);
                     const auto&& bpp = get_image_bpp(req_profile_base->get_format());
                     auto&& frame_counter = fr->additional_data.frame_number;
                     auto&& timestamp = fr->additional_data.timestamp;
+                    // The frames of the streams left in standby are returned to the backend as they arrive
+                    if (!this->is_opened())
+                        return;
+
+                    _metrics->on_arrival(*req_profile_base, frame_counter);
 
                     if (!this->is_streaming())
                     {
+                        _metrics->on_drop(*req_profile_base, RS2_FRAME_DROP_CAUSE_NOT_STREAMING);
                         LOG_WARNING("Frame received with streaming inactive,"
                             << librealsense::get_string(req_profile_base->get_stream_type())
                             << req_profile_base->get_stream_index()
@@ -336,7 +425,7 @@ namespace librealsense
                         return;
                     }
 
-                    frame_continuation release_and_enqueue(continuation, f.pixels);
+                    frame_continuation release_and_enqueue(continuation, f.pixels, f.frame_size);
 
                     LOG_DEBUG("FrameAccepted," << librealsense::get_string(req_profile_base->get_stream_type())
                         << ",Counter," << std::dec << fr->additional_data.frame_number
@@ -350,24 +439,37 @@ namespace librealsense
                     last_frame_number = frame_counter;
                     last_timestamp = timestamp;
 
+                    // Decimated frames are returned to the backend without being allocated, copied or unpacked
+                    if (skip > 0)
+                    {
+                        skip--;
+                        return;
+                    }
+                    skip = decimation - 1;
+
                     const auto&& vsp = As<video_stream_profile, stream_profile_interface>(req_profile);
                     int width = vsp ? vsp->get_width() : 0;
                     int height = vsp ? vsp->get_height() : 0;
 
-                    frame_holder fh = _source.alloc_frame(stream_to_frame_types(req_profile_base->get_stream_type()), width * height * bpp / 8, fr->additional_data, requires_processing);
+#ifdef ZERO_COPY
+                    // The frame refers to the capture buffer, which is returned to the backend once the frame is released
+                    const auto&& requires_processing = false;
+#else
+                    // Short frames are copied so that the frame never reads past the end of the backend buffer
+                    const auto&& requires_processing = !adopt_buffers || f.frame_size < size_t(width * height * bpp / 8);
+#endif
+                    frame_holder fh = alloc_frame(*req_profile_base, stream_to_frame_types(req_profile_base->get_stream_type()), width * height * bpp / 8, fr->additional_data, requires_processing);
                     if (fh.frame)
                     {
-                        memcpy((void*)fh->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
+                        if (requires_processing)
+                            memcpy((void*)fh->get_frame_data(), f.pixels, sizeof(byte)*f.frame_size);
                         auto&& video = (video_frame*)fh.frame;
                         video->assign(width, height, width * bpp / 8, bpp);
                         video->set_timestamp_domain(timestamp_domain);
                         fh->set_stream(req_profile_base);
                     }
                     else
-                    {
-                        LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                         return;
-                    }
 
                     if (!requires_processing)
                     {
@@ -378,7 +480,7 @@ namespace librealsense
                     {
                         _source.invoke_callback(std::move(fh));
                     }
-                });
+                }, _capture_buffers);
             }
             catch (...)
             {
@@ -440,6 +542,23 @@ namespace librealsense
         else if (!_is_opened)
             throw wrong_api_call_sequence_exception("close() failed. UVC device was not opened!");
 
+        // In standby the streams stay configured, with their buffers and the power of the device, for the next open
+        if (_standby)
+            _standby_requests = get_active_streams();
+        else
+            close_streams();
+
+        if (Is<librealsense::global_time_interface>(_owner))
+        {
+            As<librealsense::global_time_interface>(_owner)->enable_time_diff_keeper(false);
+        }
+        _is_opened = false;
+        _option_cache->invalidate();
+        set_active_streams({});
+    }
+
+    void uvc_sensor::close_streams()
+    {
         for (auto&& profile : _internal_config)
         {
             try // Handle disconnect event
@@ -449,13 +568,16 @@ namespace librealsense
             catch (...) {}
         }
         reset_streaming();
-        if (Is<librealsense::global_time_interface>(_owner))
-        {
-            As<librealsense::global_time_interface>(_owner)->enable_time_diff_keeper(false);
-        }
         _power.reset();
-        _is_opened = false;
-        set_active_streams({});
+    }
+
+    void uvc_sensor::release_standby()
+    {
+        if (_standby_requests.empty())
+            return;
+
+        _standby_requests.clear();
+        close_streams();
     }
 
     void uvc_sensor::register_xu(platform::extension_unit xu)
@@ -662,6 +784,9 @@ namespace librealsense
         _hid_device->register_profiles(profiles_vector);
         for (auto&& elem : _hid_device->get_sensors())
             _hid_sensors.push_back(elem);
+
+        register_option(RS2_OPTION_MOTION_BATCH_SIZE, std::make_shared<ptr_option<int>>(1, 64, 1, 1, &_batch_size,
+            "Number of motion samples delivered in each motion frame, see rs2_get_motion_samples_count. Applied when streaming starts"));
     }
 
     hid_sensor::~hid_sensor()
@@ -773,9 +898,24 @@ namespace librealsense
 
         unsigned long long last_frame_number = 0;
         rs2_time_t last_timestamp = 0;
+
+        // The entries are made here, the backend threads of the sensors only touch their own
+        std::map<std::string, motion_batch> batches;
+        auto batch_size = size_t(_batch_size);
+        if (batch_size > 1)
+        {
+            for (auto&& kvp : _configured_profiles)
+            {
+                auto stream = kvp.second->get_stream_type();
+                if (stream == RS2_STREAM_ACCEL || stream == RS2_STREAM_GYRO)
+                    batches[kvp.first].samples.reserve(batch_size);
+            }
+        }
         raise_on_before_streaming_changes(true); //Required to be just before actual start allow recording to work
 
-        _hid_device->start_capture([this, last_frame_number, last_timestamp](const platform::sensor_data& sensor_data) mutable
+        // A batch is delivered once complete, so the backend need not wake up for each of its samples
+        _hid_device->set_samples_per_wakeup(uint32_t(batch_size));
+        _hid_device->start_capture([this, last_frame_number, last_timestamp, batches, batch_size](const platform::sensor_data& sensor_data) mutable
         {
             const auto&& system_time = environment::get_instance().get_time_service()->get_time();
             auto timestamp_reader = _hid_iio_timestamp_reader.get();
@@ -793,6 +933,8 @@ namespace librealsense
 
                 if (!_is_configured_stream[custom_stream_type])
                 {
+                    if (request)
+                        _metrics->on_drop(*request, RS2_FRAME_DROP_CAUSE_UNREQUESTED);
                     LOG_DEBUG("Unrequested " << rs2_stream_to_string(custom_stream_type) << " frame was dropped.");
                     return;
                 }
@@ -804,6 +946,7 @@ namespace librealsense
             if (!this->is_streaming())
             {
                 auto stream_type = request->get_stream_type();
+                _metrics->on_drop(*request, RS2_FRAME_DROP_CAUSE_NOT_STREAMING);
                 LOG_INFO("HID Frame received when Streaming is not active,"
                     << get_string(stream_type)
                     << ",Arrived," << std::fixed << system_time);
@@ -815,6 +958,7 @@ namespace librealsense
             const auto&& timestamp_domain = timestamp_reader->get_frame_timestamp_domain(fr);
             auto&& timestamp = fr->additional_data.timestamp;
             const auto&& bpp = get_image_bpp(request->get_format());
+            _metrics->on_arrival(*request, frame_counter);
             auto&& data_size = sensor_data.fo.frame_size;
 
             LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type())
@@ -827,13 +971,41 @@ namespace librealsense
 
             last_frame_number = frame_counter;
             last_timestamp = timestamp;
-            frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
-            memcpy((void*)frame->get_frame_data(), fr->data.data(), sizeof(byte)*fr->data.size());
-            if (!frame)
+
+            auto batch = batches.find(sensor_name);
+            if (batch != batches.end() && data_size >= sizeof(hid_data))
             {
-                LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+                auto&& samples = batch->second.samples;
+                if (samples.empty())
+                    batch->second.additional_data = fr->additional_data;
+
+                hid_batched_sample sample;
+                memcpy(&sample.data, sensor_data.fo.pixels, sizeof(hid_data));
+                sample.timestamp = timestamp;
+                samples.push_back(sample);
+                if (samples.size() < batch_size)
+                    return;
+
+                auto&& additional_data = batch->second.additional_data;
+                additional_data.motion_samples = uint32_t(samples.size());
+                frame_holder frame = alloc_frame(*request, RS2_EXTENSION_MOTION_FRAME, samples.size() * sizeof(hid_batched_sample), additional_data, true);
+                if (!frame)
+                {
+                    samples.clear();
+                    return;
+                }
+                memcpy((void*)frame->get_frame_data(), samples.data(), samples.size() * sizeof(hid_batched_sample));
+                samples.clear();
+                frame->set_stream(request);
+                frame->set_timestamp_domain(timestamp_domain);
+                _source.invoke_callback(std::move(frame));
                 return;
             }
+
+            frame_holder frame = alloc_frame(*request, RS2_EXTENSION_MOTION_FRAME, data_size, fr->additional_data, true);
+            if (!frame)
+                return;
+            memcpy((void*)frame->get_frame_data(), sensor_data.fo.pixels, sizeof(byte)*data_size);
             frame->set_stream(request);
             frame->set_timestamp_domain(timestamp_domain);
             _source.invoke_callback(std::move(frame));
@@ -924,6 +1096,28 @@ namespace librealsense
     {
         register_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP, make_additional_data_parser(&frame_additional_data::backend_timestamp));
         register_metadata(RS2_FRAME_METADATA_RAW_FRAME_SIZE, make_additional_data_parser(&frame_additional_data::raw_size));
+
+        auto capture_buffers = std::make_shared<ptr_option<int>>(0, 32, 1, 0, &_capture_buffers,
+            "Number of frame buffers the backend queues for each stream, 0 selects the backend default. Applied when the streams are opened");
+        capture_buffers->set_description(0, "Default");
+        register_option(RS2_OPTION_CAPTURE_BUFFERS, capture_buffers);
+
+        register_option(RS2_OPTION_LATEST_FRAME_ONLY, std::make_shared<ptr_option<bool>>(false, true, true, false, &_latest_frame_only,
+            "Deliver only the most recent frame, dropping the frames that became stale while waiting in the backend. Applied when the streams are opened"));
+
+        register_option(RS2_OPTION_FRAME_DECIMATION, std::make_shared<ptr_option<int>>(1, 30, 1, 1, &_frame_decimation,
+            "Deliver every Nth frame of each stream, before the frames are allocated and unpacked. Applied when the streams are opened"));
+
+        auto standby = std::make_shared<ptr_option<bool>>(false, true, true, false, &_standby,
+            "Keep the streams configured on close, with their buffers allocated, so that opening the same streams again resumes them at once. Applied when the streams are closed");
+        standby->on_set([this](float value)
+        {
+            if (value)
+                return;
+            std::lock_guard<std::mutex> lock(_configure_lock);
+            release_standby();
+        });
+        register_option(RS2_OPTION_STANDBY, standby);
     }
 
     iio_hid_timestamp_reader::iio_hid_timestamp_reader()
@@ -1024,6 +1218,27 @@ namespace librealsense
         auto& raw_fourcc_to_rs2_stream_map = _raw_sensor->get_fourcc_to_rs2_stream_map();
         _fourcc_to_rs2_stream = std::make_shared<std::map<uint32_t, rs2_stream>>(fourcc_to_rs2_stream_map);
         raw_fourcc_to_rs2_stream_map = _fourcc_to_rs2_stream;
+
+        // The options of the sensor are cached with the raw sensor, that executes them
+        std::weak_ptr<option_cache> cache = _raw_sensor->get_option_cache();
+        _notifications_processor->set_on_raise([cache]()
+        {
+            if (auto strong = cache.lock())
+                strong->invalidate();
+        });
+
+        // The backend buffering, the decimation, the standby and the motion batches are configured on the raw sensor
+        for (auto id : { RS2_OPTION_CAPTURE_BUFFERS, RS2_OPTION_LATEST_FRAME_ONLY, RS2_OPTION_FRAME_DECIMATION, RS2_OPTION_STANDBY, RS2_OPTION_MOTION_BATCH_SIZE })
+        {
+            if (_raw_sensor->supports_option(id))
+                sensor_base::register_option(id, std::shared_ptr<option>(_raw_sensor, &_raw_sensor->get_option(id)));
+        }
+
+        sensor_base::register_option(RS2_OPTION_DEFERRED_CONVERSION, std::make_shared<ptr_option<bool>>(false, true, true, false, &_deferred_conversion,
+            "Convert the frames on their first data access, frames dropped unread are never converted. Applied when streaming starts"));
+        sensor_base::register_option(RS2_OPTION_CALLBACK_MAILBOX_SIZE, std::make_shared<ptr_option<int>>(0, 16, 1, 0, &_callback_mailbox_size,
+            "Call the frame callback on a dedicated thread, the frames waiting in a mailbox per stream of this many frames, the oldest replaced when full. "
+            "0 calls it on the capture threads. Applied when streaming starts"));
     }
 
     synthetic_sensor::~synthetic_sensor()
@@ -1219,25 +1434,32 @@ namespace librealsense
         // Find and retrieve best fitting processing block to the given requests, and the requests which were the best fit.
 
         // For video stream, the best fitting processing block is defined as the processing block which its sources
-        // covers the maximum amount of requests.
+        // covers the maximum amount of requests, so that the requests of several formats of the same stream are unpacked
+        // in one pass over the raw frame when a multi-output block is registered for them.
+        // Among the blocks covering as many requests, the one with the fewest sources and then the fewest targets is the cheapest.
 
         stream_profiles best_match_requests;
         std::shared_ptr<processing_block_factory> best_match_processing_block_factory;
 
         int max_satisfied_req = 0;
-        int best_source_size = 0;
+        size_t best_source_size = 0;
+        size_t best_target_size = 0;
         int satisfied_count = 0;
 
         for (auto&& pbf : _pb_factories)
         {
             auto satisfied_req = pbf->find_satisfied_requests(requests, _pbf_supported_profiles[pbf.get()]);
             satisfied_count = satisfied_req.size();
+            auto source_size = pbf->get_source_info().size();
+            auto target_size = pbf->get_target_info().size();
             if (satisfied_count > max_satisfied_req
-                || (satisfied_count == max_satisfied_req
-                    && pbf->get_source_info().size() < best_source_size))
+                || (satisfied_count == max_satisfied_req && satisfied_count > 0
+                    && (source_size < best_source_size
+                        || (source_size == best_source_size && target_size < best_target_size))))
             {
                 max_satisfied_req = satisfied_count;
-                best_source_size = pbf->get_source_info().size();
+                best_source_size = source_size;
+                best_target_size = target_size;
                 best_match_processing_block_factory = pbf;
                 best_match_requests = satisfied_req;
             }
@@ -1320,7 +1542,8 @@ namespace librealsense
 
             // Retrieve source profile from cached map and generate the relevant processing block.
             std::unordered_set<std::shared_ptr<stream_profile_interface>> current_resolved_reqs;
-            auto best_pb = best_pbf->generate();
+            auto best_pb = best_pbf->generate(best_reqs);
+            best_pb->set_frame_allocator(_source.get_frame_allocator());
             register_processing_block_options(*best_pb);
             for (auto&& req : best_reqs)
             {
@@ -1420,10 +1643,28 @@ namespace librealsense
 
         // Set the post-processing callback as the user callback.
         // This callback might be modified by other object.
+        if (_callback_mailbox_size > 0)
+        {
+            _callback_executor = make_callback_executor(callback, _callback_mailbox_size);
+            callback = _callback_executor;
+        }
         set_frames_callback(callback);
 
+        // Hands a frame of a requested profile to the user
+        auto deliver = [this](frame_interface* fr)
+        {
+            auto&& cached_profile = filter_frame_by_requests(fr);
+            if (!cached_profile)
+                return;
+
+            fr->set_stream(cached_profile);
+            _metrics->on_delivery(*cached_profile);
+            fr->acquire();
+            _post_process_callback->on_frame((rs2_frame*)fr);
+        };
+
         // After processing callback
-        const auto&& output_cb = make_callback([&](frame_holder f) {
+        const auto&& output_cb = make_callback([this, deliver](frame_holder f) {
             std::vector<frame_interface*> processed_frames;
             processed_frames.push_back(f.frame);
 
@@ -1440,44 +1681,51 @@ namespace librealsense
             for (auto&& fr : processed_frames)
             {
                 if (!dynamic_cast<composite_frame*>(fr))
-                {
-                    auto&& cached_profile = filter_frame_by_requests(fr);
-
-                    if (cached_profile)
-                    {
-                        fr->set_stream(cached_profile);
-                    }
-                    else
-                        continue;
-
-                    fr->acquire();
-                    _post_process_callback->on_frame((rs2_frame*)fr);
-                }
+                    deliver(fr);
             }
         });
 
         // Set callbacks for all of the relevant processing blocks
+        _passthrough_profiles.clear();
         for (auto&& pb_entry : _profiles_to_processing_block)
         {
             auto&& pbs = pb_entry.second;
+
+            // A native format requested as is is delivered straight from the raw sensor, without the hops through the identity block
+            if (pbs.size() == 1 && std::dynamic_pointer_cast<identity_processing_block>(*pbs.begin()))
+                _passthrough_profiles.insert(pb_entry.first);
+
             for (auto&& pb : pbs)
                 if (pb)
                 {
                     pb->set_output_callback(output_cb);
+                    if (_owner)
+                        pb->set_memory_counter(_owner->get_memory_counter());
+                    if (auto fpb = std::dynamic_pointer_cast<functional_processing_block>(pb))
+                        fpb->set_deferred_processing(_deferred_conversion);
                 }
         }
 
         // Invoke processing blocks callback
-        const auto&& process_cb = make_callback([&, this](frame_holder f) {
+        const auto&& process_cb = make_callback([this, deliver](frame_holder f) {
             if (!f)
                 return;
 
-            auto&& pbs = _profiles_to_processing_block[f->get_stream()];
+            auto&& raw_profile = f->get_stream();
+            if (_passthrough_profiles.count(raw_profile))
+            {
+                deliver(f.frame);
+                return;
+            }
+
+            auto&& pbs = _profiles_to_processing_block[raw_profile];
+            processing_timer timer;
             for (auto&& pb : pbs)
             {
                 f->acquire();
                 pb->invoke(f.frame);
             }
+            _metrics->on_unpack(*raw_profile, timer.get_elapsed_ms());
         });
 
         // Call the processing block on the frame
@@ -1488,6 +1736,11 @@ namespace librealsense
     {
         std::lock_guard<std::mutex> lock(_synthetic_configure_lock);
         _raw_sensor->stop();
+        if (_callback_executor)
+        {
+            _callback_executor->stop();
+            _callback_executor.reset();
+        }
     }
 
     void synthetic_sensor::register_processing_block(const std::vector<stream_profile>& from,
@@ -1520,6 +1773,18 @@ namespace librealsense
         _post_process_callback = callback;
     }
 
+    void synthetic_sensor::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        std::lock_guard<std::mutex> lock(_synthetic_configure_lock);
+        sensor_base::set_frame_allocator(allocator);
+        _raw_sensor->set_frame_allocator(allocator);
+        for (auto&& entry : _profiles_to_processing_block)
+        {
+            for (auto&& pb : entry.second)
+                pb->set_frame_allocator(allocator);
+        }
+    }
+
     void synthetic_sensor::register_notifications_callback(notifications_callback_ptr callback)
     {
         sensor_base::register_notifications_callback(callback);
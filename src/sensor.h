@@ -20,6 +20,7 @@
 #include "core/roi.h"
 #include "core/options.h"
 #include "source.h"
+#include "metrics.h"
 #include "core/extension.h"
 #include "proc/processing-blocks-factory.h"
 #include "proc/identity-processing-block.h"
@@ -28,6 +29,7 @@ namespace librealsense
 {
     class device;
     class option;
+    class callback_executor;
 
     typedef std::function<void(std::vector<platform::stream_profile>)> on_open;
 
@@ -61,6 +63,7 @@ namespace librealsense
         virtual std::shared_ptr<notifications_processor> get_notifications_processor() const;
         virtual frame_callback_ptr get_frames_callback() const override;
         virtual void set_frames_callback(frame_callback_ptr callback) override;
+        virtual void set_frame_allocator(frame_allocator_ptr allocator);
         bool is_streaming() const override;
         virtual bool is_opened() const;
         virtual void register_metadata(rs2_frame_metadata_value metadata, std::shared_ptr<md_attribute_parser_base> metadata_parser) const;
@@ -85,10 +88,27 @@ namespace librealsense
         rs2_format fourcc_to_rs2_format(uint32_t format) const;
         rs2_stream fourcc_to_rs2_stream(uint32_t fourcc_format) const;
 
+        // Shared with the raw sensor once the sensor becomes its source owner
+        stream_metrics& get_metrics() const { return *_metrics; }
+        virtual frame_pool_stats get_pool_stats() const { return _source.get_pool_stats(); }
+
+        // Generation of the cached option values of the sensor, see cached_option
+        virtual std::shared_ptr<option_cache> get_option_cache() const { return _option_cache; }
+        // Keeps the device powered while the returned token is held, so a series of control transfers powers it once
+        virtual std::shared_ptr<void> keep_powered() { return nullptr; }
+        // Keeps the device powered and holds its cross-process lock while the returned token is held,
+        // so a series of control transfers takes the lock once
+        virtual std::shared_ptr<void> lock_controls() { return keep_powered(); }
+
     protected:
         void raise_on_before_streaming_changes(bool streaming);
         void set_active_streams(const stream_profiles& requests);
 
+        // A new frame of the source, null when the frame is dropped: when the user holds too many frames of the sensor or when
+        // the buffer of the frame would exceed a memory budget. The drop is counted in the metrics of profile
+        frame_holder alloc_frame(const stream_profile_interface& profile, rs2_extension type, size_t size,
+            const frame_additional_data& additional_data, bool requires_memory);
+
         void assign_stream(const std::shared_ptr<stream_interface>& stream,
                            std::shared_ptr<stream_profile_interface> target) const;
 
@@ -108,6 +128,9 @@ namespace librealsense
 
         sensor_base* _source_owner = nullptr;
         frame_source _source;
+        std::shared_ptr<stream_metrics> _metrics;
+        std::atomic<bool> _over_budget{ false }; // Notified once per run of frames over a budget that fails them
+        std::shared_ptr<option_cache> _option_cache;
         device* _owner;
         std::vector<platform::stream_profile> _uvc_profiles;
 
@@ -214,8 +237,13 @@ namespace librealsense
         void register_processing_block(const std::vector<processing_block_factory>& pbfs);
 
         std::shared_ptr<sensor_base> get_raw_sensor() const { return _raw_sensor; };
+        frame_pool_stats get_pool_stats() const override { return _raw_sensor->get_pool_stats(); }
+        std::shared_ptr<option_cache> get_option_cache() const override { return _raw_sensor->get_option_cache(); }
+        std::shared_ptr<void> keep_powered() override { return _raw_sensor->keep_powered(); }
+        std::shared_ptr<void> lock_controls() override { return _raw_sensor->lock_controls(); }
         frame_callback_ptr get_frames_callback() const override;
         void set_frames_callback(frame_callback_ptr callback) override;
+        void set_frame_allocator(frame_allocator_ptr allocator) override;
         void register_notifications_callback(notifications_callback_ptr callback) override;
         int register_before_streaming_changes_callback(std::function<void(bool)> callback) override;
         void unregister_before_start_callback(int token) override;
@@ -244,10 +272,14 @@ namespace librealsense
         std::vector<std::shared_ptr<processing_block_factory>> _pb_factories;
         std::unordered_map<processing_block_factory*, stream_profiles> _pbf_supported_profiles;
         std::unordered_map<std::shared_ptr<stream_profile_interface>, std::unordered_set<std::shared_ptr<processing_block>>> _profiles_to_processing_block;
+        std::unordered_set<std::shared_ptr<stream_profile_interface>> _passthrough_profiles; // raw profiles delivered without processing
         std::unordered_map<std::shared_ptr<stream_profile_interface>, stream_profiles> _source_to_target_profiles_map;
         std::unordered_map<stream_profile, stream_profiles> _target_to_source_profiles_map;
         std::unordered_map<rs2_format, stream_profiles> _cached_requests;
         std::vector<rs2_option> _cached_processing_blocks_options;
+        bool _deferred_conversion = false;
+        int _callback_mailbox_size = 0;
+        std::shared_ptr<callback_executor> _callback_executor; // Calls the user callback while streaming, when there is a mailbox
     };
 
     class iio_hid_timestamp_reader : public frame_timestamp_reader
@@ -308,6 +340,14 @@ namespace librealsense
         std::vector<platform::hid_sensor> _hid_sensors;
         std::unique_ptr<frame_timestamp_reader> _hid_iio_timestamp_reader;
         std::unique_ptr<frame_timestamp_reader> _custom_hid_timestamp_reader;
+        int _batch_size = 1;
+
+        // Samples of a stream waiting for their batch to fill, the frame takes the data of the first one
+        struct motion_batch
+        {
+            std::vector<hid_batched_sample> samples;
+            frame_additional_data additional_data;
+        };
 
         stream_profiles get_sensor_profiles(std::string sensor_name) const;
 
@@ -346,6 +386,19 @@ namespace librealsense
             return action(*_device);
         }
 
+        std::shared_ptr<void> keep_powered() override
+        {
+            return std::make_shared<power>(std::dynamic_pointer_cast<uvc_sensor>(shared_from_this()));
+        }
+
+        std::shared_ptr<void> lock_controls() override
+        {
+            auto powered = keep_powered();
+            auto device = _device;
+            device->lock();
+            return std::shared_ptr<void>(nullptr, [powered, device](void*) { device->unlock(); });
+        }
+
     protected:
         stream_profiles init_stream_profiles() override;
         rs2_extension stream_to_frame_types(rs2_stream stream) const;
@@ -354,6 +407,8 @@ namespace librealsense
         void acquire_power();
         void release_power();
         void reset_streaming();
+        void close_streams();
+        void release_standby();
 
         struct power
         {
@@ -389,6 +444,12 @@ namespace librealsense
         std::vector<platform::extension_unit> _xus;
         std::unique_ptr<power> _power;
         std::unique_ptr<frame_timestamp_reader> _timestamp_reader;
+        int _capture_buffers = 0;
+        bool _latest_frame_only = false;
+        int _frame_decimation = 1;
+        bool _standby = false;
+        // The requests of the streams left configured by close() in standby, empty when none are
+        stream_profiles _standby_requests;
     };
 
     processing_blocks get_color_recommended_proccesing_blocks();
@@ -0,0 +1,269 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "shm_device.hh"
+
+#include "api.h"
+#include <librealsense2-shm/rs_shm.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <set>
+
+#include <NetdevLog.h>
+
+// The rings opened by the devices of the process, a ring stays mapped until the frames wrapping its slots are released
+struct mapped_ring
+{
+    std::shared_ptr<shm_ring> ring;
+    int held_frames;
+    bool is_closed;
+};
+
+std::mutex mapped_rings_mutex;
+std::list<mapped_ring> mapped_rings;
+
+// deleter of the software frames, called when the last reference to the frame is released
+void release_slot(void* data)
+{
+    std::lock_guard<std::mutex> lock(mapped_rings_mutex);
+    for(auto it = mapped_rings.begin(); it != mapped_rings.end(); ++it)
+    {
+        if(it->ring->contains(data))
+        {
+            it->ring->release(it->ring->slot_of(data));
+            if(--it->held_frames == 0 && it->is_closed)
+            {
+                mapped_rings.erase(it);
+            }
+            return;
+        }
+    }
+    ERR << "Released frame is not in a frame ring";
+}
+
+shm_device::shm_device(rs2::software_device sw_device, std::string name)
+    : ring(shm_ring::open(name))
+    , is_device_alive(true)
+{
+    shm_ring_header& header = ring->header();
+    std::vector<std::string> sensor_names;
+    std::set<std::pair<rs2_stream, int>> default_streams;
+    for(uint32_t i = 0; i < header.stream_count; i++)
+    {
+        shm_stream_descriptor& stream = header.streams[i];
+        std::string sensor_name(stream.sensor_name, strnlen(stream.sensor_name, SHM_MAX_SENSOR_NAME));
+        auto sensor = std::find(sensor_names.begin(), sensor_names.end(), sensor_name);
+        if(sensor == sensor_names.end())
+        {
+            sensor_names.push_back(sensor_name);
+            sw_sensors.push_back(std::make_shared<rs2::software_sensor>(sw_device.add_sensor(sensor_name)));
+            sensor = sensor_names.end() - 1;
+        }
+        int sensor_id = int(sensor - sensor_names.begin());
+
+        // the first profile of each stream is the default one
+        rs2::stream_profile profile;
+        if(stream.is_motion)
+        {
+            bool is_default = default_streams.emplace(stream.motion.type, stream.motion.index).second;
+            profile = sw_sensors[sensor_id]->add_motion_stream(stream.motion, is_default);
+        }
+        else
+        {
+            bool is_default = default_streams.emplace(stream.video.type, stream.video.index).second;
+            profile = sw_sensors[sensor_id]->add_video_stream(stream.video, is_default);
+        }
+        stream_profiles.push_back(profile);
+        stream_sensors.push_back(sensor_id);
+    }
+    active_streams.resize(stream_profiles.size(), false);
+
+    for(size_t i = 0; i < stream_profiles.size(); i++)
+    {
+        for(size_t j = 0; j < stream_profiles.size(); j++)
+        {
+            stream_profiles[i].register_extrinsics_to(stream_profiles[j], header.extrinsics[i][j]);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mapped_rings_mutex);
+        mapped_rings.push_back({ring, 0, false});
+    }
+
+    // the frames published before the device was created are not streamed
+    last_sequence = header.last_sequence.load();
+    consumer_thread = std::thread(&shm_device::consume_frames_loop, this);
+}
+
+shm_device::~shm_device()
+{
+    DBG << "Destroying shm_device";
+
+    is_device_alive = false;
+    if(consumer_thread.joinable())
+    {
+        consumer_thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mapped_rings_mutex);
+    for(auto it = mapped_rings.begin(); it != mapped_rings.end(); ++it)
+    {
+        if(it->ring == ring)
+        {
+            it->is_closed = true;
+            if(it->held_frames == 0)
+            {
+                mapped_rings.erase(it);
+            }
+            break;
+        }
+    }
+}
+
+void shm_device::update_active_streams()
+{
+    std::fill(active_streams.begin(), active_streams.end(), false);
+    for(size_t sensor_id = 0; sensor_id < sw_sensors.size(); sensor_id++)
+    {
+        for(auto& active_profile : sw_sensors[sensor_id]->get_active_streams())
+        {
+            for(size_t i = 0; i < stream_profiles.size(); i++)
+            {
+                if(stream_sensors[i] == int(sensor_id) && stream_profiles[i].unique_id() == active_profile.unique_id())
+                {
+                    active_streams[i] = true;
+                }
+            }
+        }
+    }
+}
+
+void shm_device::consume_frames_loop()
+{
+    auto next_state_check = std::chrono::steady_clock::now();
+    std::vector<std::pair<uint64_t, uint32_t>> published_frames;
+    while(is_device_alive)
+    {
+        try
+        {
+            if(std::chrono::steady_clock::now() >= next_state_check)
+            {
+                update_active_streams();
+                next_state_check += std::chrono::milliseconds(SHM_POLLING_SW_DEVICE_STATE_INTERVAL);
+            }
+
+            uint64_t published_sequence = ring->header().last_sequence.load();
+            if(published_sequence == last_sequence)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(SHM_POLLING_RING_INTERVAL));
+                continue;
+            }
+
+            // the frames published since the last poll, the ones already overwritten are lost for this client
+            published_frames.clear();
+            for(uint32_t i = 0; i < ring->header().slot_count; i++)
+            {
+                uint64_t sequence = ring->slot(i).sequence.load();
+                if(sequence > last_sequence && sequence <= published_sequence)
+                {
+                    published_frames.emplace_back(sequence, i);
+                }
+            }
+            std::sort(published_frames.begin(), published_frames.end());
+            last_sequence = published_sequence;
+
+            for(auto& frame : published_frames)
+            {
+                if(!ring->acquire(frame.second, frame.first))
+                {
+                    continue;
+                }
+                uint32_t stream = ring->slot(frame.second).stream;
+                if(stream >= active_streams.size() || !active_streams[stream])
+                {
+                    ring->release(frame.second);
+                    continue;
+                }
+                inject_frame(frame.second);
+            }
+        }
+        catch(const std::exception& e)
+        {
+            ERR << e.what();
+        }
+    }
+}
+
+// Sets the metadata of the frame and injects it, the software frame wraps the slot referenced by the caller
+void shm_device::inject_frame(uint32_t slot_index)
+{
+    shm_slot_header& slot = ring->slot(slot_index);
+    const auto& metadata = slot.metadata.data;
+    auto& sw_sensor = sw_sensors[stream_sensors[slot.stream]];
+    for(int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+    {
+        if(metadata.metadataMask & (uint64_t(1) << i))
+        {
+            sw_sensor->set_metadata(static_cast<rs2_frame_metadata_value>(i), metadata.metadata[i]);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mapped_rings_mutex);
+        for(auto& mapped : mapped_rings)
+        {
+            if(mapped.ring == ring)
+            {
+                mapped.held_frames++;
+            }
+        }
+    }
+
+    const shm_stream_descriptor& stream = ring->header().streams[slot.stream];
+    if(stream.is_motion)
+    {
+        rs2_software_motion_frame motion_frame;
+        motion_frame.data = ring->slot_data(slot_index);
+        motion_frame.deleter = release_slot;
+        motion_frame.timestamp = metadata.timestamp;
+        motion_frame.domain = metadata.timestampDomain;
+        motion_frame.frame_number = static_cast<int>(metadata.frameCounter);
+        motion_frame.profile = stream_profiles[slot.stream].get();
+        sw_sensor->on_motion_frame(motion_frame);
+    }
+    else
+    {
+        rs2_software_video_frame video_frame;
+        video_frame.pixels = ring->slot_data(slot_index);
+        video_frame.deleter = release_slot;
+        video_frame.stride = slot.stride != 0 ? slot.stride : stream.video.width * stream.video.bpp;
+        video_frame.bpp = stream.video.bpp;
+        video_frame.timestamp = metadata.timestamp;
+        video_frame.domain = metadata.timestampDomain;
+        video_frame.frame_number = static_cast<int>(metadata.frameCounter);
+        video_frame.profile = stream_profiles[slot.stream].get();
+        sw_sensor->on_video_frame(video_frame);
+    }
+}
+
+rs2_device* rs2_create_shm_device(int api_version, const char* name, rs2_error** error) BEGIN_API_CALL
+{
+    verify_version_compatibility(api_version);
+    VALIDATE_NOT_NULL(name);
+
+    // create sw device
+    rs2::software_device sw_dev = rs2::software_device([](rs2_device*) {});
+    // create shm instance
+    shm_device* shm_dev = new shm_device(sw_dev, name);
+    // set client destruction functioun
+    sw_dev.set_destruction_callback([shm_dev] { delete shm_dev; });
+    sw_dev.update_info(RS2_CAMERA_INFO_NAME, std::string(name) + " Shared Memory Device");
+
+    return sw_dev.get().get();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, name)
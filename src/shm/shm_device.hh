@@ -0,0 +1,47 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "shm_ring.hh"
+
+#include <librealsense2/hpp/rs_internal.hpp>
+#include <librealsense2/rs.hpp>
+
+#include <atomic>
+#include <thread>
+
+// the consumer thread sleeps this long when no frame is waiting in the ring
+#define SHM_POLLING_RING_INTERVAL 1 // milliseconds
+
+// the consumer thread checks the started streams of the sensors every interval
+#define SHM_POLLING_SW_DEVICE_STATE_INTERVAL 100 // milliseconds
+
+// Software device streaming the frames of a shared memory server.
+// The frames wrap the slots of the ring, the slot of a frame is released when the frame is released
+class shm_device
+{
+public:
+    shm_device(rs2::software_device sw_device, std::string name);
+    ~shm_device();
+
+private:
+    void consume_frames_loop();
+    void update_active_streams();
+    void inject_frame(uint32_t slot_index);
+
+    std::shared_ptr<shm_ring> ring;
+
+    std::vector<std::shared_ptr<rs2::software_sensor>> sw_sensors;
+
+    // per stream of the ring: its profile, its sensor, and whether the sensor streams it
+    std::vector<rs2::stream_profile> stream_profiles;
+    std::vector<int> stream_sensors;
+    std::vector<bool> active_streams;
+
+    uint64_t last_sequence;
+
+    std::atomic<bool> is_device_alive;
+
+    std::thread consumer_thread;
+};
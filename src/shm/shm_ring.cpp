@@ -0,0 +1,237 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "shm_ring.hh"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <NetdevLog.h>
+
+// "camera" => "/librealsense-camera" on POSIX, "Local\librealsense-camera" on Windows
+std::string get_region_name(const std::string& name)
+{
+#ifdef _WIN32
+    return "Local\\librealsense-" + name;
+#else
+    return "/librealsense-" + name;
+#endif
+}
+
+shm_ring::shm_ring(const std::string& name, bool is_owner)
+    : m_name(get_region_name(name))
+    , m_is_owner(is_owner)
+{
+}
+
+shm_ring::~shm_ring()
+{
+#ifdef _WIN32
+    if(m_base != nullptr)
+        UnmapViewOfFile(m_base);
+    if(m_handle != nullptr)
+        CloseHandle(m_handle);
+#else
+    if(m_base != nullptr)
+        munmap(m_base, m_size);
+    if(m_fd != -1)
+        close(m_fd);
+    // the clients keep their mapping, a new server creates a new region
+    if(m_is_owner)
+        shm_unlink(m_name.c_str());
+#endif
+}
+
+// Maps the whole region, its size is the one of the existing region when it is opened
+void shm_ring::map(size_t size, bool create)
+{
+#ifdef _WIN32
+    if(create)
+    {
+        m_handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, DWORD(uint64_t(size) >> 32), DWORD(size & 0xffffffff), m_name.c_str());
+    }
+    else
+    {
+        m_handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, m_name.c_str());
+    }
+    if(m_handle == NULL)
+    {
+        m_handle = nullptr;
+        throw std::runtime_error("cannot open shared memory " + m_name + ", error " + std::to_string(GetLastError()));
+    }
+    m_base = static_cast<unsigned char*>(MapViewOfFile(m_handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if(m_base == nullptr)
+    {
+        throw std::runtime_error("cannot map shared memory " + m_name + ", error " + std::to_string(GetLastError()));
+    }
+    MEMORY_BASIC_INFORMATION info;
+    VirtualQuery(m_base, &info, sizeof(info));
+    m_size = info.RegionSize;
+#else
+    if(create)
+    {
+        shm_unlink(m_name.c_str());
+        m_fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+        if(m_fd != -1 && ftruncate(m_fd, size) != 0)
+        {
+            throw std::runtime_error("cannot size shared memory " + m_name + ": " + strerror(errno));
+        }
+    }
+    else
+    {
+        m_fd = shm_open(m_name.c_str(), O_RDWR, 0);
+    }
+    if(m_fd == -1)
+    {
+        throw std::runtime_error("cannot open shared memory " + m_name + ": " + strerror(errno));
+    }
+    struct stat status;
+    if(fstat(m_fd, &status) != 0)
+    {
+        throw std::runtime_error("cannot read the size of shared memory " + m_name + ": " + strerror(errno));
+    }
+    m_size = status.st_size;
+    void* base = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if(base == MAP_FAILED)
+    {
+        throw std::runtime_error("cannot map shared memory " + m_name + ": " + strerror(errno));
+    }
+    m_base = static_cast<unsigned char*>(base);
+#endif
+    if(m_size < sizeof(shm_ring_header))
+    {
+        throw std::runtime_error("shared memory " + m_name + " is too small for a frame ring");
+    }
+}
+
+std::shared_ptr<shm_ring> shm_ring::create(const std::string& name, uint32_t slot_count, uint32_t slot_size,
+                                           const std::vector<shm_stream_descriptor>& streams, const std::vector<std::vector<rs2_extrinsics>>& extrinsics)
+{
+    if(streams.empty() || streams.size() > SHM_MAX_STREAMS)
+    {
+        throw std::runtime_error("shared memory ring needs 1 to " + std::to_string(SHM_MAX_STREAMS) + " streams");
+    }
+
+    std::shared_ptr<shm_ring> ring(new shm_ring(name, true));
+    slot_size = uint32_t(sizeof(shm_slot_header) + (slot_size + alignof(shm_slot_header) - 1) / alignof(shm_slot_header) * alignof(shm_slot_header));
+    ring->map(get_slots_offset() + size_t(slot_count) * slot_size, true);
+
+    shm_ring_header& header = ring->header();
+    header.version = SHM_RING_VERSION;
+    header.slot_count = slot_count;
+    header.slot_size = slot_size;
+    header.stream_count = uint32_t(streams.size());
+    for(size_t i = 0; i < streams.size(); i++)
+    {
+        header.streams[i] = streams[i];
+        for(size_t j = 0; j < streams.size(); j++)
+        {
+            header.extrinsics[i][j] = extrinsics[i][j];
+        }
+    }
+    new(&header.last_sequence) std::atomic<uint64_t>(0);
+    for(uint32_t i = 0; i < slot_count; i++)
+    {
+        shm_slot_header& slot = ring->slot(i);
+        new(&slot.sequence) std::atomic<uint64_t>(0);
+        new(&slot.ref_count) std::atomic<uint32_t>(0);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    header.magic = SHM_RING_MAGIC;
+    return ring;
+}
+
+std::shared_ptr<shm_ring> shm_ring::open(const std::string& name)
+{
+    std::shared_ptr<shm_ring> ring(new shm_ring(name, false));
+    ring->map(0, false);
+
+    shm_ring_header& header = ring->header();
+    if(header.magic != SHM_RING_MAGIC)
+    {
+        throw std::runtime_error("shared memory " + ring->m_name + " is not a ready frame ring");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(header.version != SHM_RING_VERSION)
+    {
+        throw std::runtime_error("frame ring " + ring->m_name + " has version " + std::to_string(header.version) + ", expected " + std::to_string(SHM_RING_VERSION));
+    }
+    if(ring->m_size < get_slots_offset() + size_t(header.slot_count) * header.slot_size || header.stream_count > SHM_MAX_STREAMS)
+    {
+        throw std::runtime_error("frame ring " + ring->m_name + " is corrupted");
+    }
+    return ring;
+}
+
+int shm_ring::begin_write()
+{
+    uint32_t slot_count = header().slot_count;
+    double now = system_time_ms();
+    for(uint32_t i = 0; i < slot_count; i++)
+    {
+        uint32_t index = (m_next_slot + i) % slot_count;
+        shm_slot_header& slot = this->slot(index);
+        // the slot is taken before its references are checked, a client referencing it now sees the sequence changed
+        uint64_t sequence = slot.sequence.exchange(0);
+        if(slot.ref_count.load() != 0 && sequence != 0 && now - slot.publish_time > SHM_SLOT_HOLD_TIMEOUT)
+        {
+            WRN << "Frame ring slot " << index << " is referenced for " << now - slot.publish_time << " ms, taking it back";
+            slot.ref_count.store(0);
+        }
+        if(slot.ref_count.load() == 0)
+        {
+            m_next_slot = index + 1;
+            return int(index);
+        }
+        slot.sequence.store(sequence);
+    }
+    return -1;
+}
+
+void shm_ring::end_write(int index)
+{
+    shm_slot_header& slot = this->slot(uint32_t(index));
+    slot.publish_time = system_time_ms();
+    uint64_t sequence = header().last_sequence.load() + 1;
+    slot.sequence.store(sequence);
+    header().last_sequence.store(sequence);
+}
+
+bool shm_ring::acquire(uint32_t index, uint64_t sequence)
+{
+    shm_slot_header& slot = this->slot(index);
+    slot.ref_count.fetch_add(1);
+    if(slot.sequence.load() != sequence)
+    {
+        slot.ref_count.fetch_sub(1);
+        return false;
+    }
+    return true;
+}
+
+void shm_ring::release(uint32_t index)
+{
+    shm_slot_header& slot = this->slot(index);
+    uint32_t ref_count = slot.ref_count.load();
+    // the server may have taken back the slot of a client assumed dead
+    while(ref_count != 0 && !slot.ref_count.compare_exchange_weak(ref_count, ref_count - 1))
+    {
+    }
+}
+
+double shm_ring::system_time_ms()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,132 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <ipDeviceCommon/RsCommon.h>
+#include <librealsense2/h/rs_internal.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SHM_RING_MAGIC 0x4d485352 // "RSHM"
+
+#define SHM_RING_VERSION 1
+
+#define SHM_MAX_STREAMS 16
+
+#define SHM_MAX_SENSOR_NAME 64
+
+#define SHM_DEFAULT_SLOT_COUNT 16
+
+// a slot still referenced this long after its frame was published is taken back by the server, its client is assumed dead
+#define SHM_SLOT_HOLD_TIMEOUT 5000 // milliseconds
+
+// the frames are in the shared memory of all the processes, the slot counters must not depend on a per process lock
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "the shared memory ring needs lock free atomics");
+
+// Stream published by the server, the client device adds a profile of the same sensor name for each one
+struct shm_stream_descriptor
+{
+    char sensor_name[SHM_MAX_SENSOR_NAME];
+    int32_t is_motion;
+    rs2_video_stream video;   // for the video streams
+    rs2_motion_stream motion; // for the motion streams
+};
+
+struct shm_ring_header
+{
+    uint32_t magic; // written last by the server, once the ring is ready
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size; // bytes, including the slot header
+    uint32_t stream_count;
+    shm_stream_descriptor streams[SHM_MAX_STREAMS];
+    rs2_extrinsics extrinsics[SHM_MAX_STREAMS][SHM_MAX_STREAMS];
+    std::atomic<uint64_t> last_sequence; // sequence of the last published frame, the first frame is 1
+};
+
+// A slot holds one frame. The server writes a slot only when no client references it, a client references a slot
+// and then checks that its sequence did not change: either the server sees the reference, or the client sees the slot taken
+struct alignas(64) shm_slot_header
+{
+    std::atomic<uint64_t> sequence; // 0 while the slot is free or written
+    std::atomic<uint32_t> ref_count; // frames of the clients wrapping the slot
+    uint32_t stream;                 // index in the stream table
+    uint32_t size;                   // bytes of frame data
+    uint32_t stride;                 // bytes per line of the video frames
+    double publish_time;             // system time in milliseconds
+    RsMetadataHeader metadata;
+};
+
+// Named shared memory region holding the ring: the header, then the slots
+class shm_ring
+{
+public:
+    // Creates the ring of a server, an existing ring of the same name, e.g. left by a server that crashed, is replaced
+    static std::shared_ptr<shm_ring> create(const std::string& name, uint32_t slot_count, uint32_t slot_size,
+                                            const std::vector<shm_stream_descriptor>& streams, const std::vector<std::vector<rs2_extrinsics>>& extrinsics);
+    // Opens the ring of a running server
+    static std::shared_ptr<shm_ring> open(const std::string& name);
+    ~shm_ring();
+
+    shm_ring_header& header()
+    {
+        return *reinterpret_cast<shm_ring_header*>(m_base);
+    }
+
+    shm_slot_header& slot(uint32_t index)
+    {
+        return *reinterpret_cast<shm_slot_header*>(m_base + get_slots_offset() + size_t(index) * header().slot_size);
+    }
+
+    unsigned char* slot_data(uint32_t index)
+    {
+        return reinterpret_cast<unsigned char*>(&slot(index)) + sizeof(shm_slot_header);
+    }
+
+    bool contains(const void* data) const
+    {
+        return data >= m_base && data < m_base + m_size;
+    }
+
+    uint32_t slot_of(const void* data)
+    {
+        return uint32_t((static_cast<const unsigned char*>(data) - m_base - get_slots_offset()) / header().slot_size);
+    }
+
+    // Server: takes a slot no client references, -1 when all of them are referenced
+    int begin_write();
+    // Server: publishes the frame written in the slot
+    void end_write(int index);
+
+    // Client: references the slot if it still holds the frame of the sequence
+    bool acquire(uint32_t index, uint64_t sequence);
+    void release(uint32_t index);
+
+    static double system_time_ms();
+
+private:
+    shm_ring(const std::string& name, bool is_owner);
+
+    static size_t get_slots_offset()
+    {
+        return (sizeof(shm_ring_header) + alignof(shm_slot_header) - 1) / alignof(shm_slot_header) * alignof(shm_slot_header);
+    }
+
+    void map(size_t size, bool create);
+
+    std::string m_name;
+    bool m_is_owner;
+    unsigned char* m_base = nullptr;
+    size_t m_size = 0;
+    uint32_t m_next_slot = 0; // server cursor
+#ifdef _WIN32
+    void* m_handle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
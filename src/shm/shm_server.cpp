@@ -0,0 +1,241 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "shm_server.hh"
+
+#include "api.h"
+#include <librealsense2-shm/rs_shm.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include <NetdevLog.h>
+
+shm_server::shm_server(std::string name, int slot_count)
+    : m_name(name)
+    , m_slot_count(slot_count)
+{
+    if(slot_count < 2)
+    {
+        throw std::runtime_error("shared memory server needs at least 2 slots");
+    }
+}
+
+void shm_server::add_stream(const std::string& sensor_name, rs2::stream_profile profile)
+{
+    if(m_ring != nullptr)
+    {
+        throw std::runtime_error("streams cannot be added to a started shared memory server");
+    }
+    if(m_streams.size() == SHM_MAX_STREAMS)
+    {
+        throw std::runtime_error("shared memory server streams up to " + std::to_string(SHM_MAX_STREAMS) + " streams");
+    }
+    if(sensor_name.size() >= SHM_MAX_SENSOR_NAME)
+    {
+        throw std::runtime_error("sensor name '" + sensor_name + "' is too long");
+    }
+
+    shm_stream_descriptor stream = {};
+    strncpy(stream.sensor_name, sensor_name.c_str(), SHM_MAX_SENSOR_NAME - 1);
+    if(auto video = profile.as<rs2::video_stream_profile>())
+    {
+        stream.video = {video.stream_type(), video.stream_index(), video.unique_id(), video.width(), video.height(), video.fps(), 0, video.format(), {}};
+        switch(video.format())
+        {
+        case RS2_FORMAT_Z16:
+        case RS2_FORMAT_Y16:
+        case RS2_FORMAT_YUYV:
+        case RS2_FORMAT_UYVY:
+            stream.video.bpp = 2;
+            break;
+        case RS2_FORMAT_RGB8:
+        case RS2_FORMAT_BGR8:
+            stream.video.bpp = 3;
+            break;
+        case RS2_FORMAT_RGBA8:
+        case RS2_FORMAT_BGRA8:
+            stream.video.bpp = 4;
+            break;
+        default:
+            stream.video.bpp = 1;
+        }
+        try
+        {
+            stream.video.intrinsics = video.get_intrinsics();
+        }
+        catch(const std::exception& e)
+        {
+            WRN << "No intrinsics for stream " << video.stream_name() << ": " << e.what();
+        }
+    }
+    else if(auto motion = profile.as<rs2::motion_stream_profile>())
+    {
+        stream.is_motion = 1;
+        stream.motion = {motion.stream_type(), motion.stream_index(), motion.unique_id(), motion.fps(), motion.format(), {}};
+        try
+        {
+            stream.motion.intrinsics = motion.get_motion_intrinsics();
+        }
+        catch(const std::exception&)
+        {
+            for(int axis = 0; axis < 3; axis++)
+            {
+                stream.motion.intrinsics.data[axis][axis] = 1;
+            }
+        }
+    }
+    else
+    {
+        throw std::runtime_error("shared memory server streams video and motion streams only");
+    }
+
+    m_stream_of_profile[profile.unique_id()] = uint32_t(m_streams.size());
+    m_streams.push_back(stream);
+    m_profiles.push_back(profile);
+}
+
+void shm_server::start()
+{
+    if(m_ring != nullptr)
+    {
+        return;
+    }
+
+    uint32_t slot_size = 0;
+    std::vector<std::vector<rs2_extrinsics>> extrinsics(m_profiles.size(), std::vector<rs2_extrinsics>(m_profiles.size()));
+    for(size_t i = 0; i < m_streams.size(); i++)
+    {
+        const rs2_video_stream& video = m_streams[i].video;
+        uint32_t size = m_streams[i].is_motion ? 3 * sizeof(float) : video.width * video.height * video.bpp;
+        slot_size = std::max(slot_size, size);
+        for(size_t j = 0; j < m_streams.size(); j++)
+        {
+            extrinsics[i][j] = {{1, 0, 0, 0, 1, 0, 0, 0, 1}, {0, 0, 0}};
+            try
+            {
+                extrinsics[i][j] = m_profiles[i].get_extrinsics_to(m_profiles[j]);
+            }
+            catch(const std::exception&)
+            {
+            }
+        }
+    }
+
+    m_ring = shm_ring::create(m_name, m_slot_count, slot_size, m_streams, extrinsics);
+    INF << "Shared memory server '" << m_name << "' started with " << m_streams.size() << " streams";
+}
+
+void shm_server::publish(rs2::frame frame)
+{
+    if(auto frameset = frame.as<rs2::frameset>())
+    {
+        for(auto f : frameset)
+        {
+            publish(f);
+        }
+        return;
+    }
+    if(m_ring == nullptr)
+    {
+        throw std::runtime_error("shared memory server is not started");
+    }
+
+    auto stream = m_stream_of_profile.find(frame.get_profile().unique_id());
+    if(stream == m_stream_of_profile.end())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_publish_mutex);
+    int index = m_ring->begin_write();
+    if(index == -1)
+    {
+        if(m_dropped_frames++ % 100 == 0)
+        {
+            WRN << "Frame ring '" << m_name << "' has no free slot, " << m_dropped_frames << " frames dropped";
+        }
+        return;
+    }
+
+    shm_slot_header& slot = m_ring->slot(uint32_t(index));
+    uint32_t size = std::min(uint32_t(frame.get_data_size()), m_ring->header().slot_size - uint32_t(sizeof(shm_slot_header)));
+    memcpy(m_ring->slot_data(uint32_t(index)), frame.get_data(), size);
+    slot.stream = stream->second;
+    slot.size = size;
+    slot.stride = 0;
+    if(auto video = frame.as<rs2::video_frame>())
+    {
+        slot.stride = video.get_stride_in_bytes();
+    }
+
+    auto& metadata = slot.metadata.data;
+    metadata.timestamp = frame.get_timestamp();
+    metadata.timestampDomain = frame.get_frame_timestamp_domain();
+    metadata.frameCounter = frame.get_frame_number();
+    metadata.actualFps = frame.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS) ? int(frame.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS)) : 0;
+    metadata.metadataMask = 0;
+    for(int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
+    {
+        rs2_frame_metadata_value attribute = static_cast<rs2_frame_metadata_value>(i);
+        if(frame.supports_frame_metadata(attribute))
+        {
+            metadata.metadataMask |= uint64_t(1) << i;
+            metadata.metadata[i] = frame.get_frame_metadata(attribute);
+        }
+    }
+
+    m_ring->end_write(index);
+}
+
+struct rs2_shm_server
+{
+    std::shared_ptr<shm_server> server;
+};
+
+rs2_shm_server* rs2_create_shm_server(int api_version, const char* name, int slot_count, rs2_error** error) BEGIN_API_CALL
+{
+    verify_version_compatibility(api_version);
+    VALIDATE_NOT_NULL(name);
+    VALIDATE_RANGE(slot_count, 2, 1024);
+
+    return new rs2_shm_server{std::make_shared<shm_server>(name, slot_count)};
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, api_version, name, slot_count)
+
+void rs2_delete_shm_server(rs2_shm_server* server) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(server);
+    delete server;
+}
+NOEXCEPT_RETURN(, server)
+
+void rs2_shm_server_add_stream(rs2_shm_server* server, const char* sensor_name, const rs2_stream_profile* profile, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(server);
+    VALIDATE_NOT_NULL(sensor_name);
+    VALIDATE_NOT_NULL(profile);
+
+    server->server->add_stream(sensor_name, rs2::stream_profile(profile));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, server, sensor_name, profile)
+
+void rs2_shm_server_start(rs2_shm_server* server, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(server);
+    server->server->start();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, server)
+
+void rs2_shm_server_publish(rs2_shm_server* server, rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(server);
+    VALIDATE_NOT_NULL(frame);
+
+    // the frame stays owned by the caller
+    rs2_error* e = nullptr;
+    rs2_frame_add_ref(frame, &e);
+    rs2::error::handle(e);
+    server->server->publish(rs2::frame(frame));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, server, frame)
@@ -0,0 +1,37 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "shm_ring.hh"
+
+#include <librealsense2/rs.hpp>
+
+#include <map>
+#include <mutex>
+
+// Publishes the frames of the streams of a device in a shared memory ring, the server copies each frame once
+// and the clients of all the processes wrap the frames of the ring without copying them
+class shm_server
+{
+public:
+    shm_server(std::string name, int slot_count);
+
+    // The streams are added before the server starts, a sensor is identified by its name
+    void add_stream(const std::string& sensor_name, rs2::stream_profile profile);
+    // Creates the ring, the clients can open it from now on
+    void start();
+    // Copies the frame to a free slot of the ring, the frames of the streams not added are ignored.
+    // A frame is dropped when the clients reference all the slots
+    void publish(rs2::frame frame);
+
+private:
+    std::string m_name;
+    int m_slot_count;
+    std::vector<shm_stream_descriptor> m_streams;
+    std::vector<rs2::stream_profile> m_profiles;
+    std::map<int, uint32_t> m_stream_of_profile; // unique id of the profile => stream index
+    std::shared_ptr<shm_ring> m_ring;
+    std::mutex m_publish_mutex; // the callbacks of several sensors publish to the ring
+    unsigned long long m_dropped_frames = 0;
+};
@@ -230,6 +230,11 @@ namespace librealsense
             throw wrong_api_call_sequence_exception("start_streaming(...) failed. Software device was not opened!");
         _source.get_published_size_option()->set(0);
         _source.init(_metadata_parsers);
+        {
+            // Extrinsics registered since the last session apply to the streams of this one
+            std::lock_guard<std::mutex> lock(_registered_lock);
+            _registered_extrinsics.clear();
+        }
         _source.set_sensor(this->shared_from_this());
         _source.set_callback(callback);
         _is_streaming = true;
@@ -251,34 +256,63 @@ namespace librealsense
     void software_sensor::set_metadata(rs2_frame_metadata_value key, rs2_metadata_type value)
     {
         _metadata_map[key] = value;
-    }
 
-    void software_sensor::on_video_frame(rs2_software_video_frame software_frame)
-    {
-        if (!_is_streaming) {
-            software_frame.deleter(software_frame.pixels);
-            return;
-        }
-        
-        frame_additional_data data;
-        data.timestamp = software_frame.timestamp;
-        data.timestamp_domain = software_frame.domain;
-        data.frame_number = software_frame.frame_number;
-
-        data.metadata_size = 0;
+        // The blob attached to every injected frame is serialized here, once per change
+        _metadata_size = 0;
         for (auto i : _metadata_map)
         {
             auto size_of_enum = sizeof(rs2_frame_metadata_value);
             auto size_of_data = sizeof(rs2_metadata_type);
-            if (data.metadata_size + size_of_enum + size_of_data > 255)
+            if (_metadata_size + size_of_enum + size_of_data > MAX_META_DATA_SIZE)
             {
                 continue; //stop adding metadata to frame
             }
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
+            memcpy(_metadata_blob.data() + _metadata_size, &i.first, size_of_enum);
+            _metadata_size += static_cast<uint32_t>(size_of_enum);
+            memcpy(_metadata_blob.data() + _metadata_size, &i.second, size_of_data);
+            _metadata_size += static_cast<uint32_t>(size_of_data);
+        }
+    }
+
+    frame_additional_data software_sensor::prepare_additional_data(rs2_time_t timestamp, rs2_timestamp_domain domain, unsigned long long frame_number) const
+    {
+        frame_additional_data data;
+        data.timestamp = timestamp;
+        data.timestamp_domain = domain;
+        data.frame_number = frame_number;
+        data.metadata_size = _metadata_size;
+        memcpy(data.metadata_blob.data(), _metadata_blob.data(), _metadata_size);
+        return data;
+    }
+
+    void software_sensor::register_extrinsic_once(const stream_interface& stream)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_registered_lock);
+            if (!_registered_extrinsics.insert(stream.get_unique_id()).second)
+                return;
         }
+        auto sd = dynamic_cast<software_device*>(_owner);
+        sd->register_extrinsic(stream);
+    }
+
+    void software_sensor::on_video_frames(const rs2_software_video_frame* frames, int count)
+    {
+        for (int i = 0; i < count; i++)
+            on_video_frame(frames[i]);
+    }
+
+    void software_sensor::on_video_frame(rs2_software_video_frame software_frame)
+    {
+        auto&& profile = *software_frame.profile->profile;
+        _metrics->on_arrival(profile, software_frame.frame_number);
+        if (!_is_streaming) {
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_NOT_STREAMING);
+            software_frame.deleter(software_frame.pixels);
+            return;
+        }
+
+        auto data = prepare_additional_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number);
 
         rs2_extension extension = software_frame.profile->profile->get_stream_type() == RS2_STREAM_DEPTH ?
             RS2_EXTENSION_DEPTH_FRAME : RS2_EXTENSION_VIDEO_FRAME;
@@ -286,7 +320,9 @@ namespace librealsense
         auto frame = _source.alloc_frame(extension, 0, data, false);
         if (!frame)
         {
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_FRAME_POOL_FULL);
             LOG_WARNING("Dropped video frame. alloc_frame(...) returned nullptr");
+            software_frame.deleter(software_frame.pixels);
             return;
         }
         auto vid_profile = dynamic_cast<video_stream_profile_interface*>(software_frame.profile->profile);
@@ -298,74 +334,66 @@ namespace librealsense
             software_frame.deleter(software_frame.pixels);
         }, software_frame.pixels });
 
-        auto sd = dynamic_cast<software_device*>(_owner);
-        sd->register_extrinsic(*vid_profile);
+        register_extrinsic_once(*vid_profile);
+        _metrics->on_delivery(profile);
         _source.invoke_callback(frame);
     }
 
     void software_sensor::on_motion_frame(rs2_software_motion_frame software_frame)
     {
-        if (!_is_streaming) return;
-
-        frame_additional_data data;
-        data.timestamp = software_frame.timestamp;
-        data.timestamp_domain = software_frame.domain;
-        data.frame_number = software_frame.frame_number;
-
-        data.metadata_size = 0;
-        for (auto i : _metadata_map)
+        auto&& profile = *software_frame.profile->profile;
+        _metrics->on_arrival(profile, software_frame.frame_number);
+        if (!_is_streaming)
         {
-            auto size_of_enum = sizeof(rs2_frame_metadata_value);
-            auto size_of_data = sizeof(rs2_metadata_type);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_NOT_STREAMING);
+            software_frame.deleter(software_frame.data);
+            return;
         }
 
+        auto data = prepare_additional_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number);
+
         auto frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, 0, data, false);
         if (!frame)
         {
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_FRAME_POOL_FULL);
             LOG_WARNING("Dropped motion frame. alloc_frame(...) returned nullptr");
+            software_frame.deleter(software_frame.data);
             return;
         }
         frame->set_stream(std::dynamic_pointer_cast<stream_profile_interface>(software_frame.profile->profile->shared_from_this()));
         frame->attach_continuation(frame_continuation{ [=]() {
             software_frame.deleter(software_frame.data);
         }, software_frame.data });
+        _metrics->on_delivery(profile);
         _source.invoke_callback(frame);
     }
 
     void software_sensor::on_pose_frame(rs2_software_pose_frame software_frame)
     {
-        if (!_is_streaming) return;
-
-        frame_additional_data data;
-        data.timestamp = software_frame.timestamp;
-        data.timestamp_domain = software_frame.domain;
-        data.frame_number = software_frame.frame_number;
-
-        data.metadata_size = 0;
-        for (auto i : _metadata_map)
+        auto&& profile = *software_frame.profile->profile;
+        _metrics->on_arrival(profile, software_frame.frame_number);
+        if (!_is_streaming)
         {
-            auto size_of_enum = sizeof(rs2_frame_metadata_value);
-            auto size_of_data = sizeof(rs2_metadata_type);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.first, size_of_enum);
-            data.metadata_size += static_cast<uint32_t>(size_of_enum);
-            memcpy(data.metadata_blob.data() + data.metadata_size, &i.second, size_of_data);
-            data.metadata_size += static_cast<uint32_t>(size_of_data);
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_NOT_STREAMING);
+            software_frame.deleter(software_frame.data);
+            return;
         }
 
+        auto data = prepare_additional_data(software_frame.timestamp, software_frame.domain, software_frame.frame_number);
+
         auto frame = _source.alloc_frame(RS2_EXTENSION_POSE_FRAME, 0, data, false);
         if (!frame)
         {
+            _metrics->on_drop(profile, RS2_FRAME_DROP_CAUSE_FRAME_POOL_FULL);
             LOG_WARNING("Dropped pose frame. alloc_frame(...) returned nullptr");
+            software_frame.deleter(software_frame.data);
             return;
         }
         frame->set_stream(std::dynamic_pointer_cast<stream_profile_interface>(software_frame.profile->profile->shared_from_this()));
         frame->attach_continuation(frame_continuation{ [=]() {
             software_frame.deleter(software_frame.data);
         }, software_frame.data });
+        _metrics->on_delivery(profile);
         _source.invoke_callback(frame);
     }
 
@@ -106,6 +106,7 @@ namespace librealsense
         void stop() override;
 
         void on_video_frame(rs2_software_video_frame frame);
+        void on_video_frames(const rs2_software_video_frame* frames, int count);
         void on_motion_frame(rs2_software_motion_frame frame);
         void on_pose_frame(rs2_software_pose_frame frame);
         void on_notification(rs2_software_notification notif);
@@ -117,8 +118,17 @@ namespace librealsense
         friend class software_device;
         stream_profiles _profiles;
         std::map<rs2_frame_metadata_value, rs2_metadata_type> _metadata_map;
+        std::array<uint8_t, MAX_META_DATA_SIZE> _metadata_blob;
+        uint32_t _metadata_size = 0;
         int _unique_id;
 
+        // The streams whose extrinsics were registered with the device, by profile unique id
+        std::mutex _registered_lock;
+        std::set<int> _registered_extrinsics;
+
+        frame_additional_data prepare_additional_data(rs2_time_t timestamp, rs2_timestamp_domain domain, unsigned long long frame_number) const;
+        void register_extrinsic_once(const stream_interface& stream);
+
         class stereo_extension : public depth_stereo_sensor
         {
         public:
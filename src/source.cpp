@@ -38,67 +38,184 @@ namespace librealsense
 
     std::shared_ptr<option> frame_source::get_published_size_option()
     {
-        return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, 32, 1, 16 });
+        return std::make_shared<frame_queue_size>(&_max_publish_list_size, option_range{ 0, RS2_MAX_USER_QUEUE_SIZE, 1, 16 });
+    }
+
+    class frame_pool_retention : public option_base
+    {
+    public:
+        frame_pool_retention(frame_source* source, const option_range& opt_range)
+            : option_base(opt_range),
+              _source(source)
+        {}
+
+        void set(float value) override
+        {
+            if (!is_valid(value))
+                throw invalid_value_exception(to_string() << "set(frame_pool_retention) failed! Given value " << value << " is out of range.");
+
+            _source->set_freelist_retention(value);
+            _recording_function(*this);
+        }
+
+        float query() const override { return static_cast<float>(_source->get_freelist_retention()); }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Time in milliseconds a released frame buffer is kept for reuse before it is freed. Longer retention avoids allocations when the frame rate drops, at the cost of memory held while idle";
+        }
+    private:
+        frame_source* _source;
+    };
+
+    std::shared_ptr<option> frame_source::get_freelist_retention_option()
+    {
+        return std::make_shared<frame_pool_retention>(this, option_range{ 0, 10000, 1, 1000 });
     }
 
     frame_source::frame_source(uint32_t max_publish_list_size)
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(max_publish_list_size),
               _ts(environment::get_instance().get_time_service())
-    {}
+    {
+        for (auto&& archive : _archive_cache)
+            archive = nullptr;
+    }
 
     void frame_source::init(std::shared_ptr<metadata_parser_map> metadata_parsers)
     {
         std::lock_guard<std::mutex> lock(_callback_mutex);
-
-        std::vector<rs2_extension> supported { RS2_EXTENSION_VIDEO_FRAME,
-                                               RS2_EXTENSION_COMPOSITE_FRAME,
-                                               RS2_EXTENSION_POINTS,
-                                               RS2_EXTENSION_DEPTH_FRAME,
-                                               RS2_EXTENSION_DISPARITY_FRAME,
-                                               RS2_EXTENSION_MOTION_FRAME,
-                                               RS2_EXTENSION_POSE_FRAME };
-
-        for (auto type : supported)
-        {
-            _archive[type] = make_archive(type, &_max_publish_list_size, _ts, metadata_parsers);
-        }
-
         _metadata_parsers = metadata_parsers;
+        _initialized = true;
     }
 
     callback_invocation_holder frame_source::begin_callback()
     {
-        return _archive[RS2_EXTENSION_VIDEO_FRAME]->begin_callback();
-//        return _archive[RS2_EXTENSION_DEPTH_FRAME]->begin_callback();
+        return { _callback_inflight.allocate(), &_callback_inflight };
     }
 
     void frame_source::reset()
     {
         std::lock_guard<std::mutex> lock(_callback_mutex);
         _callback.reset();
-        for (auto&& kvp : _archive)
-        {
-            kvp.second.reset();
-        }
+        for (auto&& archive : _archive_cache)
+            archive = nullptr;
+        _archive.clear();
         _metadata_parsers.reset();
+        _initialized = false;
     }
 
-    frame_interface* frame_source::alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const
+    void frame_source::configure(const std::shared_ptr<archive_interface>& archive) const
+    {
+        if (_frame_allocator)
+            archive->set_frame_allocator(_frame_allocator);
+        if (_memory_counter)
+            archive->set_memory_counter(_memory_counter);
+        archive->set_freelist_retention(_freelist_retention);
+        if (auto sensor = _sensor.lock())
+            archive->set_sensor(sensor);
+    }
+
+    archive_interface* frame_source::get_archive(rs2_extension type) const
     {
+        if (type < 0 || type >= RS2_EXTENSION_COUNT)
+            throw wrong_api_call_sequence_exception("Requested frame type is not supported!");
+        if (auto archive = _archive_cache[type].load(std::memory_order_acquire))
+            return archive;
+
+        std::lock_guard<std::mutex> lock(_callback_mutex);
         auto it = _archive.find(type);
-        if (it == _archive.end()) throw wrong_api_call_sequence_exception("Requested frame type is not supported!");
-        return it->second->alloc_and_track(size, additional_data, requires_memory);
+        if (it != _archive.end())
+            return it->second.get();
+        if (!_initialized)
+            throw wrong_api_call_sequence_exception("Requested frame type is not supported!");
+
+        // Throws for the types with no archive
+        auto archive = make_archive(type, const_cast<std::atomic<uint32_t>*>(&_max_publish_list_size), _ts, _metadata_parsers);
+        configure(archive);
+        _archive[type] = archive;
+        _archive_cache[type].store(archive.get(), std::memory_order_release);
+        return archive.get();
+    }
+
+    frame_interface* frame_source::alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const
+    {
+        return get_archive(type)->alloc_and_track(size, additional_data, requires_memory);
     }
 
     void frame_source::set_sensor(const std::shared_ptr<sensor_interface>& s)
     {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _sensor = s;
         for (auto&& a : _archive)
         {
             a.second->set_sensor(s);
         }
     }
 
+    void frame_source::set_frame_allocator(frame_allocator_ptr allocator)
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _frame_allocator = allocator;
+        for (auto&& kvp : _archive)
+        {
+            if (kvp.second)
+                kvp.second->set_frame_allocator(allocator);
+        }
+    }
+
+    void frame_source::set_memory_counter(std::shared_ptr<memory_counter> counter)
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _memory_counter = counter;
+        for (auto&& kvp : _archive)
+        {
+            if (kvp.second)
+                kvp.second->set_memory_counter(counter);
+        }
+    }
+
+    frame_allocator_ptr frame_source::get_frame_allocator() const
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        return _frame_allocator;
+    }
+
+    void frame_source::set_freelist_retention(rs2_time_t retention_ms)
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        _freelist_retention = retention_ms;
+        for (auto&& kvp : _archive)
+        {
+            if (kvp.second)
+                kvp.second->set_freelist_retention(retention_ms);
+        }
+    }
+
+    rs2_time_t frame_source::get_freelist_retention() const
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        return _freelist_retention;
+    }
+
+    frame_pool_stats frame_source::get_pool_stats() const
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        frame_pool_stats stats;
+        for (auto&& kvp : _archive)
+        {
+            if (!kvp.second)
+                continue;
+            auto archive_stats = kvp.second->get_pool_stats();
+            stats += archive_stats;
+            stats.in_use = std::max(stats.in_use, archive_stats.in_use);
+            stats.capacity = archive_stats.capacity;
+        }
+        return stats;
+    }
+
     void frame_source::set_callback(frame_callback_ptr callback)
     {
         std::lock_guard<std::mutex> lock(_callback_mutex);
@@ -138,11 +255,18 @@ namespace librealsense
 
     void frame_source::flush() const
     {
-        for (auto&& kvp : _archive)
+        // The callbacks being waited for may still create archives
+        _callback_inflight.stop_allocation();
+        _callback_inflight.wait_until_empty();
+
+        std::vector<std::shared_ptr<archive_interface>> archives;
         {
-            if (kvp.second)
-                kvp.second->flush();
+            std::lock_guard<std::mutex> lock(_callback_mutex);
+            for (auto&& kvp : _archive)
+                archives.push_back(kvp.second);
         }
+        for (auto&& archive : archives)
+            archive->flush();
     }
 }
 
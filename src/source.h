@@ -13,6 +13,8 @@ namespace librealsense
 {
     class option;
 
+    // The archive of a frame extension is created by its first frame: a source only pays for the types it outputs.
+    // The archives created are looked up without a lock
     class LRS_EXTENSION_API frame_source
     {
     public:
@@ -44,21 +46,47 @@ namespace librealsense
         template<class T>
         void add_extension(rs2_extension ex)
         {
-            _archive[ex] = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers);
+            std::lock_guard<std::mutex> lock(_callback_mutex);
+            auto archive = std::make_shared<frame_archive<T>>(&_max_publish_list_size, _ts, _metadata_parsers);
+            configure(archive);
+            _archive[ex] = archive;
+            _archive_cache[ex] = archive.get();
         }
 
         void set_max_publish_list_size(int qsize) {_max_publish_list_size = qsize; }
 
+        void set_frame_allocator(frame_allocator_ptr allocator);
+        frame_allocator_ptr get_frame_allocator() const;
+
+        // Counter of the frame buffers of the archives, the process-wide counter by default
+        void set_memory_counter(std::shared_ptr<memory_counter> counter);
+
+        void set_freelist_retention(rs2_time_t retention_ms);
+        rs2_time_t get_freelist_retention() const;
+        std::shared_ptr<option> get_freelist_retention_option();
+        frame_pool_stats get_pool_stats() const;
+
     private:
         friend class syncer_process_unit;
 
+        void configure(const std::shared_ptr<archive_interface>& archive) const;
+        archive_interface* get_archive(rs2_extension type) const;
+
         mutable std::mutex _callback_mutex;
 
-        std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
+        // The archives by extension, created on first use
+        mutable std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
+        mutable std::atomic<archive_interface*> _archive_cache[RS2_EXTENSION_COUNT];
+        bool _initialized = false;
+        std::weak_ptr<sensor_interface> _sensor;
+        mutable callbacks_heap _callback_inflight;
 
         std::atomic<uint32_t> _max_publish_list_size;
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
         std::shared_ptr<metadata_parser_map> _metadata_parsers;
+        frame_allocator_ptr _frame_allocator;
+        std::shared_ptr<memory_counter> _memory_counter;
+        rs2_time_t _freelist_retention = 1000;
     };
 }
@@ -4,15 +4,15 @@
 #include "proc/synthetic-stream.h"
 #include "sync.h"
 #include "environment.h"
+#include "profiler.h"
 
 namespace librealsense
 {
     const int MAX_GAP = 1000;
 
-    std::string frame_to_string(frame_holder& f)
+    std::ostream& operator<<(std::ostream& s, const frame_log& f)
     {
-        std::ostringstream s;
-        auto composite = dynamic_cast<composite_frame*>(f.frame);
+        auto composite = dynamic_cast<const composite_frame*>(f.frame);
         if(composite)
         {
             for (int i = 0; i < composite->get_embedded_frames_count(); i++)
@@ -23,13 +23,96 @@ namespace librealsense
         }
         else
         {
-            s << f->get_stream()->get_stream_type();
-            s << " " << f->get_stream()->get_unique_id();
-            s << " " << f->get_frame_number();
-            s << " " << std::fixed << (double)f->get_frame_timestamp();
+            s << f.frame->get_stream()->get_stream_type();
+            s << " " << f.frame->get_stream()->get_unique_id();
+            s << " " << f.frame->get_frame_number();
+            s << " " << std::fixed << (double)f.frame->get_frame_timestamp();
             s << " ";
         }
-        return s.str();
+        return s;
+    }
+
+    // Prints the frames at the head of the queues of the matchers into a log message
+    struct queued_frames_log
+    {
+        std::map<matcher*, matcher_frames>& queues;
+        const std::vector<matcher*>& matchers;
+    };
+
+    std::ostream& operator<<(std::ostream& s, const queued_frames_log& q)
+    {
+        for (auto m : q.matchers)
+        {
+            frame_holder* f;
+            if (q.queues[m].peek(&f))
+                s << frame_log{ f->frame };
+        }
+        return s;
+    }
+
+    // Prints the streams of a missing matcher into a log message
+    struct missing_streams_log
+    {
+        const matcher* missing;
+        double next_expected;
+    };
+
+    std::ostream& operator<<(std::ostream& s, const missing_streams_log& m)
+    {
+        for (auto&& stream : m.missing->get_streams())
+            s << stream << " next expected " << std::fixed << m.next_expected << " ";
+        return s;
+    }
+
+    void matcher_frames::enqueue(frame_holder&& f, double arrival_time)
+    {
+        if (!_accepting)
+            return;
+
+        if (_size == _frames.size())
+        {
+            _frames[_head] = frame_holder();
+            _head = (_head + 1) % _frames.size();
+            --_size;
+        }
+        auto tail = (_head + _size) % _frames.size();
+        _frames[tail] = std::move(f);
+        _arrival_times[tail] = arrival_time;
+        ++_size;
+    }
+
+    bool matcher_frames::peek(frame_holder** f, double* arrival_time)
+    {
+        if (!_size)
+            return false;
+
+        *f = &_frames[_head];
+        if (arrival_time)
+            *arrival_time = _arrival_times[_head];
+        return true;
+    }
+
+    bool matcher_frames::dequeue(frame_holder* f)
+    {
+        _accepting = true;
+        if (!_size)
+            return false;
+
+        *f = std::move(_frames[_head]);
+        _head = (_head + 1) % _frames.size();
+        --_size;
+        return true;
+    }
+
+    void matcher_frames::clear()
+    {
+        _accepting = false;
+        while (_size)
+        {
+            _frames[_head] = frame_holder();
+            _head = (_head + 1) % _frames.size();
+            --_size;
+        }
     }
 
     matcher::matcher(std::vector<stream_id> streams_id)
@@ -98,9 +181,7 @@ namespace librealsense
 
     void identity_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<_name<<"--> "<< f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", "<<std::fixed<< f->get_frame_timestamp()<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG(_name << "--> " << f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", " << std::fixed << f->get_frame_timestamp());
 
         sync(std::move(f), env);
     }
@@ -142,9 +223,8 @@ namespace librealsense
 
     void composite_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<"DISPATCH "<<_name<<"--> "<< frame_to_string(f) <<"\n";
-        LOG_DEBUG(s.str());
+        LRS_PROFILE_ZONE("composite_matcher::dispatch");
+        LOG_DEBUG("DISPATCH " << _name << "--> " << frame_log{ f.frame });
 
         clean_inactive_streams(f);
         auto matcher = find_matcher(f);
@@ -248,37 +328,31 @@ namespace librealsense
     }
 
 
-    std::string composite_matcher::frames_to_string(std::vector<librealsense::matcher*> matchers)
+    std::string composite_matcher::frames_to_string(const std::vector<librealsense::matcher*>& matchers)
     {
-        std::string str;
-        for (auto m : matchers)
-        {
-            frame_holder* f;
-            if(_frames_queue[m].peek(&f))
-                str += frame_to_string(*f);
-        }
-        return str;
+        std::ostringstream s;
+        s << queued_frames_log{ _frames_queue, matchers };
+        return s.str();
     }
 
     void composite_matcher::sync(frame_holder f, syncronization_environment env)
     {
-        std::ostringstream s;
-        s <<"SYNC "<<_name<<"--> "<< frame_to_string(f)<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG("SYNC " << _name << "--> " << frame_log{ f.frame });
 
-        update_next_expected(f);
         auto matcher = find_matcher(f);
-        _frames_queue[matcher.get()].enqueue(std::move(f));
+        update_next_expected(matcher, f);
+        _frames_queue[matcher.get()].enqueue(std::move(f), env.arrival_time);
 
-        std::vector<frame_holder*> frames_arrived;
-        std::vector<librealsense::matcher*> frames_arrived_matchers;
-        std::vector<librealsense::matcher*> synced_frames;
-        std::vector<librealsense::matcher*> missing_streams;
+        auto& frames_arrived = _frames_arrived;
+        auto& frames_arrived_matchers = _frames_arrived_matchers;
+        auto& synced_frames = _synced_frames;
+        auto& missing_streams = _missing_streams;
+        auto& match = _match;
 
         do
         {
-            std::stringstream s;
             auto old_frames = false;
+            auto oldest_arrival = env.arrival_time;
 
             synced_frames.clear();
             missing_streams.clear();
@@ -329,70 +403,74 @@ namespace librealsense
                 }
             }
 
+            for (auto index : synced_frames)
+            {
+                frame_holder* frame;
+                double arrival_time;
+                if (_frames_queue[index].peek(&frame, &arrival_time))
+                    oldest_arrival = std::min(oldest_arrival, arrival_time);
+            }
+
             if (!old_frames)
             {
+                // The deadline is checked when frames arrive, the syncer has no thread of its own
+                auto deadline_passed = env.latency_budget_ms > 0 &&
+                    environment::get_instance().get_time_service()->get_time() - oldest_arrival >= env.latency_budget_ms;
+
                 for (auto i : missing_streams)
                 {
-                    if (!skip_missing_stream(synced_frames, i))
+                    if (deadline_passed)
                     {
-                        s <<  _name<<" "<<frames_to_string(synced_frames )<<" Wait for missing stream: ";
-
-                        for (auto&& stream : i->get_streams())
-                            s << stream<<" next expected "<<std::fixed<< _next_expected[i];
+                        LOG_DEBUG(_name << " " << queued_frames_log{ _frames_queue, synced_frames } << " Latency budget exceeded, skipped missing stream: "
+                            << missing_streams_log{ i, _next_expected[i] });
+                    }
+                    else if (!skip_missing_stream(synced_frames, i))
+                    {
+                        LOG_DEBUG(_name << " " << queued_frames_log{ _frames_queue, synced_frames } << " Wait for missing stream: "
+                            << missing_streams_log{ i, _next_expected[i] });
                         synced_frames.clear();
-                        LOG_DEBUG(s.str());
                         break;
                     }
                     else
                     {
-                        std::stringstream s;
-                        s << _name << " " << frames_to_string(synced_frames) << " Skipped missing stream: ";
-                        for (auto&& stream : i->get_streams())
-                            s << stream << " next expected " << std::fixed << _next_expected[i]<<" ";
-                        LOG_DEBUG(s.str());
+                        LOG_DEBUG(_name << " " << queued_frames_log{ _frames_queue, synced_frames } << " Skipped missing stream: "
+                            << missing_streams_log{ i, _next_expected[i] });
                     }
 
                 }
             }
-            else
-            {
-                s << _name << " old frames: ";
-            }
             if (synced_frames.size())
             {
-                std::vector<frame_holder> match;
-                match.reserve(synced_frames.size());
+                match.clear();
 
                 for (auto index : synced_frames)
                 {
                     frame_holder frame;
-                    int timeout_ms = 5000;
-                    _frames_queue[index].dequeue(&frame, timeout_ms);
+                    _frames_queue[index].dequeue(&frame);
                     if (old_frames)
                     {
-                        s  << "--> " << frame_to_string(frame) << "\n";
+                        LOG_DEBUG(_name << " old frames: --> " << frame_log{ frame.frame });
                     }
                     match.push_back(std::move(frame));
                 }
 
-                if (old_frames)
-                {
-                    LOG_DEBUG(s.str());
-                }
-
                 std::sort(match.begin(), match.end(), [](const frame_holder& f1, const frame_holder& f2)
                 {
                     return ((frame_interface*)f1)->get_stream()->get_unique_id() > ((frame_interface*)f2)->get_stream()->get_unique_id();
                 });
 
 
+                // Only the holders are moved out, the storage of match is kept for the next frameset
                 frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+                match.clear();
                 if (composite.frame)
                 {
-                    s <<"SYNCED "<<_name<<"--> "<< frame_to_string(composite)<<"\n";
+                    LOG_DEBUG("SYNCED " << _name << "--> " << frame_log{ composite.frame });
 
                     auto cb = begin_callback();
-                    _callback(std::move(composite), env);
+                    auto composite_env = env;
+                    composite_env.arrival_time = oldest_arrival;
+                    _callback(std::move(composite), composite_env);
                 }
             }
         } while (synced_frames.size() > 0);
@@ -419,17 +497,11 @@ namespace librealsense
     void frame_number_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
         std::vector<stream_id> inactive_matchers;
-        for(auto m: _matchers)
+        for(auto&& m: _matchers)
         {
             if (_last_arrived[m.second.get()] && (fabs((long long)f->get_frame_number() - (long long)_last_arrived[m.second.get()])) > 5)
             {
-                std::stringstream s;
-                s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
-                {
-                    s << stream << " ";
-                }
-                LOG_DEBUG(s.str());
+                LOG_DEBUG("clean inactive stream in " << _name << m.second->get_name());
 
                 inactive_matchers.push_back(m.first);
                 m.second->set_active(false);
@@ -442,7 +514,7 @@ namespace librealsense
         }
     }
 
-    bool frame_number_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool frame_number_composite_matcher::skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)
     {
         frame_holder* synced_frame;
 
@@ -460,10 +532,9 @@ namespace librealsense
         return false;
     }
 
-    void frame_number_composite_matcher::update_next_expected(const frame_holder& f)
+    void frame_number_composite_matcher::update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f)
     {
-        auto matcher = find_matcher(f);
-        _next_expected[matcher.get()] = f.frame->get_frame_number()+1.;
+        _next_expected[m.get()] = f.frame->get_frame_number()+1.;
     }
 
     std::pair<double, double> extract_timestamps(frame_holder & a, frame_holder & b)
@@ -481,6 +552,11 @@ namespace librealsense
         :composite_matcher(matchers, "TS: ")
     {
     }
+
+    timestamp_composite_matcher::timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name)
+        :composite_matcher(matchers, name)
+    {
+    }
     bool timestamp_composite_matcher::are_equivalent(frame_holder & a, frame_holder & b)
     {
         auto a_fps = get_fps(a);
@@ -523,20 +599,19 @@ namespace librealsense
         {
             fps = (uint32_t)f.frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
         }
-        LOG_DEBUG("fps " <<fps<<" "<< frame_to_string(const_cast<frame_holder&>(f)));
+        LOG_DEBUG("fps " << fps << " " << frame_log{ f.frame });
         return fps?fps:f.frame->get_stream()->get_framerate();
     }
 
-    void timestamp_composite_matcher::update_next_expected(const frame_holder & f)
+    void timestamp_composite_matcher::update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder & f)
     {
         auto fps = get_fps(f);
         auto gap = 1000.f / (float)fps;
 
-        auto matcher = find_matcher(f);
-
-        _next_expected[matcher.get()] = f.frame->get_frame_timestamp() + gap;
-        _next_expected_domain[matcher.get()] = f.frame->get_frame_timestamp_domain();
-        LOG_DEBUG(_name << frame_to_string(const_cast<frame_holder&>(f))<<"fps " <<fps<<" gap " <<gap<<" next_expected: "<< _next_expected[matcher.get()]);
+        auto& next_expected = _next_expected[m.get()];
+        next_expected = f.frame->get_frame_timestamp() + gap;
+        _next_expected_domain[m.get()] = f.frame->get_frame_timestamp_domain();
+        LOG_DEBUG(_name << frame_log{ f.frame } << "fps " << fps << " gap " << gap << " next_expected: " << next_expected);
 
     }
 
@@ -546,19 +621,13 @@ namespace librealsense
             return;
         std::vector<stream_id> dead_matchers;
         auto now = environment::get_instance().get_time_service()->get_time();
-        for(auto m: _matchers)
+        for(auto&& m: _matchers)
         {
             auto threshold = _fps[m.second.get()] ? (1000 / _fps[m.second.get()]) * 5 : 500; //if frame of a specific stream didn't arrive for time equivalence to 5 frames duration
                                                                                              //this stream will be marked as "not active" in order to not stack the other streams
             if(_last_arrived[m.second.get()] && (now - _last_arrived[m.second.get()]) > threshold)
             {
-                std::stringstream s;
-                s << "clean inactive stream in "<<_name;
-                for (auto stream : m.second->get_streams_types())
-                {
-                    s << stream << " ";
-                }
-                LOG_DEBUG(s.str());
+                LOG_DEBUG("clean inactive stream in " << _name << m.second->get_name());
 
                 dead_matchers.push_back(m.first);
                 m.second->set_active(false);
@@ -572,7 +641,7 @@ namespace librealsense
         }
     }
 
-    bool timestamp_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool timestamp_composite_matcher::skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)
     {
         if(!missing->get_active())
             return true;
@@ -608,12 +677,78 @@ namespace librealsense
         return abs(a - b) < ((float)gap / (float)2) ;
     }
 
+    global_timestamp_composite_matcher::global_timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, double tolerance_ms)
+        :timestamp_composite_matcher(matchers, "GTS: "), _tolerance_ms(tolerance_ms)
+    {
+    }
+
+    double global_timestamp_composite_matcher::get_host_time(const frame_holder& f) const
+    {
+        if (f.frame->get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME)
+            return f.frame->get_frame_timestamp();
+        if (f.frame->supports_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL))
+            return (double)f.frame->get_frame_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL);
+        return f.frame->get_frame_timestamp();
+    }
+
+    bool global_timestamp_composite_matcher::are_equivalent(frame_holder& a, frame_holder& b)
+    {
+        auto min_fps = std::min(get_fps(a), get_fps(b));
+        return are_equivalent(get_host_time(a), get_host_time(b), min_fps);
+    }
+
+    bool global_timestamp_composite_matcher::is_smaller_than(frame_holder& a, frame_holder& b)
+    {
+        if (!a || !b)
+            return false;
+
+        return get_host_time(a) < get_host_time(b);
+    }
+
+    void global_timestamp_composite_matcher::update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f)
+    {
+        auto fps = get_fps(f);
+        auto gap = 1000.f / (float)fps;
+
+        auto& next_expected = _next_expected[m.get()];
+        next_expected = get_host_time(f) + gap;
+        _next_expected_domain[m.get()] = RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME;
+        LOG_DEBUG(_name << frame_log{ f.frame } << "fps " << fps << " gap " << gap << " next_expected: " << next_expected);
+    }
+
+    bool global_timestamp_composite_matcher::skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)
+    {
+        if (!missing->get_active())
+            return true;
+
+        frame_holder* synced_frame;
+        _frames_queue[synced[0]].peek(&synced_frame);
+
+        auto next_expected = _next_expected[missing];
+        auto synced_time = get_host_time(*synced_frame);
+        auto fps = get_fps(*synced_frame);
+
+        // Same as the device matcher, wait for a stream whose next frame is late by less than 10 frames
+        auto gap = 1000.f / (float)fps;
+        if (synced_time > next_expected && std::abs(synced_time - next_expected) < gap * 10)
+            return false;
+
+        return !are_equivalent(synced_time, next_expected, fps);
+    }
+
+    bool global_timestamp_composite_matcher::are_equivalent(double a, double b, int fps)
+    {
+        if (_tolerance_ms > 0)
+            return std::abs(a - b) < _tolerance_ms;
+        return timestamp_composite_matcher::are_equivalent(a, b, fps);
+    }
+
     composite_identity_matcher::composite_identity_matcher(std::vector<std::shared_ptr<matcher>> matchers) :composite_matcher(matchers, "CI: ")
     {}
 
     void composite_identity_matcher::sync(frame_holder f, syncronization_environment env)
     {
-        LOG_DEBUG("by_pass_composite_matcher: " << _name << " " << frame_to_string(f));
+        LOG_DEBUG("by_pass_composite_matcher: " << _name << " " << frame_log{ f.frame });
         _callback(std::move(f), env);
     }
 }
@@ -7,6 +7,7 @@
 #include "archive.h"
 
 #include <stdint.h>
+#include <array>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -52,13 +53,46 @@ namespace librealsense
     };
     //sync_lock::ref = 0;
 
+    // Prints a frame or the frames of a composite frame into a log message, the frame is formatted only when the message is logged
+    struct frame_log
+    {
+        const frame_interface* frame;
+    };
+    std::ostream& operator<<(std::ostream& s, const frame_log& f);
+
+    // Fixed capacity ring of frames that never allocates. It is not thread safe, the matchers access it under the syncer lock.
+    // When full the oldest frame is dropped
+    class matcher_frames
+    {
+    public:
+        // arrival_time is the host time the frame reached the syncer, reported back by peek()
+        void enqueue(frame_holder&& f, double arrival_time = 0);
+        bool peek(frame_holder** f, double* arrival_time = nullptr);
+        bool dequeue(frame_holder* f);
+        // Drops the waiting frames, the frames that arrive later are dropped as well until start() is called
+        void clear();
+        void start() { _accepting = true; }
+        size_t size() const { return _size; }
+
+    private:
+        std::array<frame_holder, QUEUE_MAX_SIZE> _frames;
+        std::array<double, QUEUE_MAX_SIZE> _arrival_times;
+        size_t _head = 0;
+        size_t _size = 0;
+        bool _accepting = true;
+    };
+
     class synthetic_source_interface;
 
     struct syncronization_environment
     {
         synthetic_source_interface* source;
         //sync_lock& lock_ref;
-        single_consumer_frame_queue<frame_holder>& matches;
+        matcher_frames& matches;
+        // Host time the frame (or the oldest frame of a composite) reached the syncer
+        double arrival_time;
+        // When positive, a partial frameset is emitted once its oldest frame waited that long for the missing streams
+        double latency_budget_ms;
     };
 
     typedef int stream_id;
@@ -117,22 +151,30 @@ namespace librealsense
 
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) = 0;
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) = 0;
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) = 0;
+        virtual bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) = 0;
         virtual void clean_inactive_streams(frame_holder& f) = 0;
         virtual void update_last_arrived(frame_holder& f, matcher* m) = 0;
 
         void dispatch(frame_holder f, syncronization_environment env) override;
-        std::string frames_to_string(std::vector<librealsense::matcher*> matchers);
+        std::string frames_to_string(const std::vector<librealsense::matcher*>& matchers);
         void sync(frame_holder f, syncronization_environment env) override;
         std::shared_ptr<matcher> find_matcher(const frame_holder& f);
 
     protected:
-        virtual void update_next_expected(const frame_holder& f) = 0;
+        virtual void update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f) = 0;
 
-        std::map<matcher*, single_consumer_frame_queue<frame_holder>> _frames_queue;
+        std::map<matcher*, matcher_frames> _frames_queue;
         std::map<stream_id, std::shared_ptr<matcher>> _matchers;
         std::map<matcher*, double> _next_expected;
         std::map<matcher*, rs2_timestamp_domain> _next_expected_domain;
+
+    private:
+        // Working sets of sync, kept between the calls so that matching does not allocate
+        std::vector<frame_holder*> _frames_arrived;
+        std::vector<matcher*> _frames_arrived_matchers;
+        std::vector<matcher*> _synced_frames;
+        std::vector<matcher*> _missing_streams;
+        std::vector<frame_holder> _match;
     };
 
     // composite matcher that does not synchronize between any frames, and instead just passes them on to callback
@@ -144,12 +186,12 @@ namespace librealsense
         void sync(frame_holder f, syncronization_environment env) override;
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) override { return false; }
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) override { return false; }
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override { return false; }
+        virtual bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override { return false; }
         virtual void clean_inactive_streams(frame_holder& f) override {}
         virtual void update_last_arrived(frame_holder& f, matcher* m) override {}
 
     protected:
-        virtual void update_next_expected(const frame_holder& f) override {}
+        virtual void update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f) override {}
     };
 
     class frame_number_composite_matcher : public composite_matcher
@@ -159,9 +201,9 @@ namespace librealsense
         virtual void update_last_arrived(frame_holder& f, matcher* m) override;
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
+        bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override;
         void clean_inactive_streams(frame_holder& f) override;
-        void update_next_expected(const frame_holder& f) override;
+        void update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f) override;
 
     private:
          std::map<matcher*,unsigned long long> _last_arrived;
@@ -175,14 +217,39 @@ namespace librealsense
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
         virtual void update_last_arrived(frame_holder& f, matcher* m) override;
         void clean_inactive_streams(frame_holder& f) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
-        void update_next_expected(const frame_holder & f) override;
+        bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override;
+        void update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder & f) override;
+
+    protected:
+        timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, std::string name);
 
-    private:
         unsigned int get_fps(const frame_holder & f);
-        bool are_equivalent(double a, double b, int fps);
+        virtual bool are_equivalent(double a, double b, int fps);
+
+    private:
         std::map<matcher*, double> _last_arrived;
         std::map<matcher*, unsigned int> _fps;
 
     };
+
+    // Matches the frames of several devices on the host clock. The frames are compared on their global timestamps,
+    // the host time mapped by the global_timestamp_reader linear fit, and on their arrival time when global time is disabled.
+    // Frames within tolerance_ms are matched, a tolerance of 0 keeps half a frame period of the slower stream
+    class global_timestamp_composite_matcher : public timestamp_composite_matcher
+    {
+    public:
+        global_timestamp_composite_matcher(std::vector<std::shared_ptr<matcher>> matchers, double tolerance_ms);
+        bool are_equivalent(frame_holder& a, frame_holder& b) override;
+        bool is_smaller_than(frame_holder& a, frame_holder& b) override;
+        bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override;
+        void update_next_expected(const std::shared_ptr<matcher>& m, const frame_holder& f) override;
+
+    protected:
+        bool are_equivalent(double a, double b, int fps) override;
+
+    private:
+        double get_host_time(const frame_holder& f) const;
+
+        double _tolerance_ms;
+    };
 }
@@ -0,0 +1,115 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include "thread-policy.h"
+#include "types.h"
+#include "profiler.h"
+
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace librealsense
+{
+    static std::mutex& policies_mutex()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    static thread_policy* policies()
+    {
+        static thread_policy p[RS2_THREAD_ROLE_COUNT];
+        return p;
+    }
+
+    void set_thread_policy(rs2_thread_role role, const thread_policy& policy)
+    {
+        std::lock_guard<std::mutex> lock(policies_mutex());
+        policies()[role] = policy;
+    }
+
+    thread_policy get_thread_policy(rs2_thread_role role)
+    {
+        std::lock_guard<std::mutex> lock(policies_mutex());
+        return policies()[role];
+    }
+
+    static const char* get_thread_name(rs2_thread_role role)
+    {
+        // At most 15 characters, the limit of Linux
+        switch (role)
+        {
+        case RS2_THREAD_ROLE_CAPTURE: return "rs-capture";
+        case RS2_THREAD_ROLE_PROCESSING: return "rs-processing";
+        case RS2_THREAD_ROLE_CONTROL: return "rs-control";
+        case RS2_THREAD_ROLE_MONITORING: return "rs-monitor";
+        default: return "rs";
+        }
+    }
+
+    void apply_thread_policy(rs2_thread_role role)
+    {
+        auto policy = get_thread_policy(role);
+        LRS_PROFILE_THREAD_NAME(get_thread_name(role));
+
+#if defined(__linux__)
+        pthread_setname_np(pthread_self(), get_thread_name(role));
+
+        if (!policy.cpus.empty())
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (auto cpu : policy.cpus)
+                CPU_SET(cpu, &set);
+            // The calling thread, sched_setaffinity is also available on Android
+            if (sched_setaffinity(0, sizeof(set), &set))
+                LOG_WARNING("Failed to set the CPU affinity of a " << role << " thread");
+        }
+
+        if (policy.realtime_priority > 0)
+        {
+            sched_param param = {};
+            param.sched_priority = policy.realtime_priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+                LOG_WARNING("Failed to set the real-time priority of a " << role << " thread, SCHED_FIFO needs CAP_SYS_NICE");
+        }
+#elif defined(_WIN32)
+        if (!policy.cpus.empty())
+        {
+            DWORD_PTR mask = 0;
+            for (auto cpu : policy.cpus)
+                if (cpu < int(sizeof(mask) * 8))
+                    mask |= DWORD_PTR(1) << cpu;
+            if (!SetThreadAffinityMask(GetCurrentThread(), mask))
+                LOG_WARNING("Failed to set the CPU affinity of a " << role << " thread");
+        }
+
+        if (policy.realtime_priority > 0)
+        {
+            auto priority = policy.realtime_priority >= 50 ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+            if (!SetThreadPriority(GetCurrentThread(), priority))
+                LOG_WARNING("Failed to raise the priority of a " << role << " thread");
+        }
+#else
+#if defined(__APPLE__)
+        pthread_setname_np(get_thread_name(role));
+#endif
+        if (!policy.cpus.empty())
+            LOG_WARNING("Thread CPU affinity is not supported on this platform");
+
+        if (policy.realtime_priority > 0)
+        {
+            sched_param param = {};
+            param.sched_priority = policy.realtime_priority;
+            if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param))
+                LOG_WARNING("Failed to set the real-time priority of a " << role << " thread");
+        }
+#endif
+    }
+}
@@ -0,0 +1,35 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_context.h"
+
+#include <functional>
+#include <vector>
+
+namespace librealsense
+{
+    /*
+        CPUs and scheduling of the threads of a role, process-wide. The library's threads apply the policy of their role
+        when they start, so a policy set with rs2_set_thread_policy applies to the threads started afterwards.
+        The dispatchers and active objects take the hook returned by thread_policy_hook, as concurrency.h is also
+        compiled into the tools, which don't link the library internals
+    */
+    struct thread_policy
+    {
+        std::vector<int> cpus;      // any CPU when empty
+        int realtime_priority = 0;  // default scheduling when 0
+    };
+
+    void set_thread_policy(rs2_thread_role role, const thread_policy& policy);
+    thread_policy get_thread_policy(rs2_thread_role role);
+
+    // Names the calling thread after its role and applies the policy of the role to it
+    void apply_thread_policy(rs2_thread_role role);
+
+    inline std::function<void()> thread_policy_hook(rs2_thread_role role)
+    {
+        return [role]() { apply_thread_policy(role); };
+    }
+}
@@ -604,6 +604,15 @@ namespace librealsense
                     throw invalid_value_exception("Invalid profile configuration - pose stream only supports index 0");
                 LOG_DEBUG("Pose output enabled");
                 _pose_output_enabled = true;
+                // Looked up once, rather than for every pose message
+                for (auto&& p : get_stream_profiles())
+                {
+                    if (p->get_stream_type() == RS2_STREAM_POSE && p->get_stream_index() == 0)
+                    {
+                        _pose_profile = p;
+                        break;
+                    }
+                }
                 continue;
             }
 
@@ -701,6 +710,7 @@ namespace librealsense
         //reset active profiles
         _active_raw_streams.clear();
         _pose_output_enabled = false;
+        _pose_profile.reset();
 
         _is_opened = false;
         set_active_streams({});
@@ -811,6 +821,11 @@ namespace librealsense
         else if (!_is_opened)
             throw wrong_api_call_sequence_exception("start_streaming(...) failed. T265 device was not opened!");
 
+        {
+            std::lock_guard<std::mutex> pose_lock(_latest_pose_lock);
+            _has_latest_pose = false;
+        }
+
         start_interrupt();
         start_stream();
 
@@ -1092,25 +1107,29 @@ namespace librealsense
 
         frame_additional_data additional_data(ts.device_ts.count(), frame_num++, ts.arrival_ts.count(), sizeof(frame_md), (uint8_t*)&frame_md, ts.global_ts.count(), 0, 0, false);
 
-        // Find the frame stream profile
-        std::shared_ptr<stream_profile_interface> profile = nullptr;
-        auto profiles = get_stream_profiles();
-        for (auto&& p : profiles)
+        // Keep the latest pose for get_latest_pose(), without waiting for the frame to go through the dispatcher
         {
-            if (p->get_stream_type() == RS2_STREAM_POSE &&
-                p->get_stream_index() == 0) // TODO: no reason to retrieve this every time
-            {
-                profile = p;
-                break;
-            }
-        }
+            std::lock_guard<std::mutex> lock(_latest_pose_lock);
+            _latest_pose.translation = { pose.flX, pose.flY, pose.flZ };
+            _latest_pose.velocity = { pose.flVx, pose.flVy, pose.flVz };
+            _latest_pose.acceleration = { pose.flAx, pose.flAy, pose.flAz };
+            _latest_pose.rotation = { pose.flQi, pose.flQj, pose.flQk, pose.flQr };
+            _latest_pose.angular_velocity = { pose.flVAX, pose.flVAY, pose.flVAZ };
+            _latest_pose.angular_acceleration = { pose.flAAX, pose.flAAY, pose.flAAZ };
+            _latest_pose.tracker_confidence = pose.dwTrackerConfidence;
+            _latest_pose.mapper_confidence = pose.dwMapperConfidence;
+            _latest_pose_timestamp = ts.global_ts.count();
+            _has_latest_pose = true;
+        }
+
+        auto profile = _pose_profile;
         if (profile == nullptr)
         {
             LOG_WARNING("Dropped frame. No valid profile");
             return;
         }
 
-        frame_holder frame = _source.alloc_frame(RS2_EXTENSION_POSE_FRAME, sizeof(librealsense::pose_frame::pose_info), additional_data, true);
+        frame_holder frame = alloc_frame(*profile, RS2_EXTENSION_POSE_FRAME, sizeof(librealsense::pose_frame::pose_info), additional_data, true);
         if (frame.frame)
         {
             auto pose_frame = static_cast<librealsense::pose_frame*>(frame.frame);
@@ -1129,10 +1148,7 @@ namespace librealsense
             info->mapper_confidence = pose.dwMapperConfidence;
         }
         else
-        {
-            LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
             return;
-        }
         dispatch_threaded(std::move(frame));
     }
 
@@ -1222,7 +1238,7 @@ namespace librealsense
         last_ts = ts;
 
         //TODO - extension_type param assumes not depth
-        frame_holder frame = _source.alloc_frame(RS2_EXTENSION_VIDEO_FRAME, height * stride, additional_data, true);
+        frame_holder frame = alloc_frame(*profile, RS2_EXTENSION_VIDEO_FRAME, height * stride, additional_data, true);
         if (frame.frame)
         {
             auto video = (video_frame*)(frame.frame);
@@ -1234,10 +1250,7 @@ namespace librealsense
             video->data.assign(message->metadata.bFrameData, message->metadata.bFrameData + (height * stride));
         }
         else
-        {
-            LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
             return;
-        }
         dispatch_threaded(std::move(frame));
     }
 
@@ -1526,7 +1539,7 @@ namespace librealsense
             return;
         }
 
-        frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, 3 * sizeof(float), additional_data, true);
+        frame_holder frame = alloc_frame(*profile, RS2_EXTENSION_MOTION_FRAME, 3 * sizeof(float), additional_data, true);
         if (frame.frame)
         {
             auto motion_frame = static_cast<librealsense::motion_frame*>(frame.frame);
@@ -1539,10 +1552,7 @@ namespace librealsense
             data[2] = imu_data[2];
         }
         else
-        {
-            LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
             return;
-        }
         dispatch_threaded(std::move(frame));
     }
 
@@ -1794,6 +1804,16 @@ namespace librealsense
         return true;
     }
 
+    bool tm2_sensor::get_latest_pose(rs2_pose& pose, double& timestamp) const
+    {
+        std::lock_guard<std::mutex> lock(_latest_pose_lock);
+        if (!_has_latest_pose)
+            return false;
+        pose = _latest_pose;
+        timestamp = _latest_pose_timestamp;
+        return true;
+    }
+
     bool tm2_sensor::load_wheel_odometery_config(const std::vector<uint8_t>& odometry_config_buf) const
     {
         std::vector<uint8_t> buf;
@@ -115,6 +115,7 @@ namespace librealsense
         bool set_static_node(const std::string& guid, const float3& pos, const float4& orient_quat) const override;
         bool get_static_node(const std::string& guid, float3& pos, float4& orient_quat) const override;
         bool remove_static_node(const std::string& guid) const override;
+        bool get_latest_pose(rs2_pose& pose, double& timestamp) const override;
 
         // Wheel odometer
         bool load_wheel_odometery_config(const std::vector<uint8_t>& odometry_config_buf) const override;
@@ -163,6 +164,13 @@ namespace librealsense
         std::vector<t265::supported_raw_stream_libtm_message> _supported_raw_streams;
         std::vector<t265::supported_raw_stream_libtm_message> _active_raw_streams;
         bool _pose_output_enabled{false};
+        std::shared_ptr<stream_profile_interface> _pose_profile;
+
+        // The latest pose, written on the interrupt thread before the frame is dispatched
+        mutable std::mutex _latest_pose_lock;
+        rs2_pose _latest_pose;
+        double _latest_pose_timestamp = 0;
+        bool _has_latest_pose = false;
         tm2_device * _device;
 
         void print_logs(const std::unique_ptr<t265::bulk_message_response_get_and_clear_event_log> & log);
@@ -330,6 +330,21 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_frame_compression value)
+    {
+#define CASE(X) STRCASE(FRAME_COMPRESSION, X)
+        switch (value)
+        {
+            CASE(NONE)
+            CASE(RVL)
+            CASE(LZ4)
+            CASE(JPEG)
+            CASE(RVL_DELTA)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_log_severity value)
     {
 #define CASE(X) STRCASE(LOG_SEVERITY, X)
@@ -431,6 +446,32 @@ namespace librealsense
             CASE(SEQUENCE_NAME)
             CASE(SEQUENCE_SIZE)
             CASE(SEQUENCE_ID)
+            CASE(CAPTURE_BUFFERS)
+            CASE(LATEST_FRAME_ONLY)
+            CASE(DEFERRED_CONVERSION)
+            CASE(SYNC_LATENCY_BUDGET)
+            CASE(MOTION_BATCH_SIZE)
+            CASE(GLOBAL_TIME_FROM_METADATA)
+            CASE(AUTO_EXPOSURE_SAMPLE_RATE)
+            CASE(AUTO_EXPOSURE_SKIP_FRAMES)
+            CASE(VOXEL_SIZE)
+            CASE(SCAN_BINS)
+            CASE(SCAN_ROWS)
+            CASE(ALIGN_OUTPUT_DOWNSAMPLE)
+            CASE(SPATIAL_FILTER_MODE)
+            CASE(SPATIAL_FILTER_RADIUS)
+            CASE(SPATIAL_FILTER_IR_GUIDED)
+            CASE(TENSOR_WIDTH)
+            CASE(TENSOR_HEIGHT)
+            CASE(TENSOR_MEAN)
+            CASE(TENSOR_SCALE)
+            CASE(TENSOR_FLOAT)
+            CASE(TENSOR_BGR)
+            CASE(FRAME_DECIMATION)
+            CASE(STANDBY)
+            CASE(CALLBACK_MAILBOX_SIZE)
+            CASE(POINTS_COLORS)
+            CASE(FRAME_POOL_RETENTION)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -574,6 +615,92 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_frame_drop_cause value)
+    {
+#define CASE(X) STRCASE(FRAME_DROP_CAUSE, X)
+        switch (value)
+        {
+            CASE(FRAME_NUMBER_GAP)
+            CASE(FRAME_POOL_FULL)
+            CASE(NOT_STREAMING)
+            CASE(UNREQUESTED)
+            CASE(QUEUE_FULL)
+            CASE(MEMORY_BUDGET)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_memory_category value)
+    {
+#define CASE(X) STRCASE(MEMORY_CATEGORY, X)
+        switch (value)
+        {
+            CASE(FRAME_BUFFERS)
+            CASE(FRAME_POOL)
+            CASE(PROCESSING_CACHES)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_memory_budget_policy value)
+    {
+#define CASE(X) STRCASE(MEMORY_BUDGET_POLICY, X)
+        switch (value)
+        {
+            CASE(DROP)
+            CASE(BLOCK)
+            CASE(FAIL)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_thread_role value)
+    {
+#define CASE(X) STRCASE(THREAD_ROLE, X)
+        switch (value)
+        {
+            CASE(CAPTURE)
+            CASE(PROCESSING)
+            CASE(CONTROL)
+            CASE(MONITORING)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_points_format value)
+    {
+#define CASE(X) STRCASE(POINTS_FORMAT, X)
+        switch (value)
+        {
+            CASE(FLOAT32)
+            CASE(FLOAT16)
+            CASE(INT16_MM)
+            CASE(XYZRGB)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_frame_trace_stage value)
+    {
+#define CASE(X) STRCASE(FRAME_TRACE_STAGE, X)
+        switch (value)
+        {
+            CASE(BACKEND_DEQUEUE)
+            CASE(ARCHIVE_PUBLISH)
+            CASE(BLOCK_BEGIN)
+            CASE(BLOCK_END)
+            CASE(SYNCER_EMIT)
+            CASE(USER_DEQUEUE)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_notification_category value)
     {
 #define CASE(X) STRCASE(NOTIFICATION_CATEGORY, X)
@@ -586,6 +713,7 @@ namespace librealsense
             CASE(UNKNOWN_ERROR)
             CASE(FIRMWARE_UPDATE_RECOMMENDED)
             CASE(POSE_RELOCALIZATION)
+            CASE(MEMORY_BUDGET_EXCEEDED)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
 #undef CASE
@@ -772,7 +900,7 @@ namespace librealsense
     }
 
     notifications_processor::notifications_processor()
-        :_dispatcher(10), _callback(nullptr , [](rs2_notifications_callback*) {})
+        :_dispatcher(10, thread_policy_hook(RS2_THREAD_ROLE_CONTROL)), _callback(nullptr , [](rs2_notifications_callback*) {})
     {
     }
 
@@ -44,6 +44,7 @@
 #include <iomanip>
 #include "backend.h"
 #include "concurrency.h"
+#include "thread-policy.h"
 
 #if BUILD_EASYLOGGINGPP
 #include "../third-party/easyloggingpp/src/easylogging++.h"
@@ -51,7 +52,8 @@
 
 typedef unsigned char byte;
 
-const int RS2_USER_QUEUE_SIZE = 128;
+const int RS2_USER_QUEUE_SIZE = 128;          // published frames per heap segment
+const int RS2_MAX_USER_QUEUE_SIZE = 2048;     // upper bound of RS2_OPTION_FRAMES_QUEUE_SIZE
 
 // Usage of non-standard C++ PI derivatives is prohibitive, use local definitions
 static const double pi = std::acos(-1);
@@ -87,6 +89,13 @@ namespace librealsense
         byte reserved3[2];
     };
 
+    // Sample of a batched motion frame, as the hid sensor stores it
+    struct hid_batched_sample
+    {
+        hid_data data;
+        double timestamp;
+    };
+
 #pragma pack(pop)
 
     static const double TIMESTAMP_USEC_TO_MSEC = 0.001;
@@ -544,12 +553,19 @@ namespace librealsense
     RS2_ENUM_HELPERS(rs2_camera_info, CAMERA_INFO)
     RS2_ENUM_HELPERS(rs2_frame_metadata_value, FRAME_METADATA)
     RS2_ENUM_HELPERS(rs2_timestamp_domain, TIMESTAMP_DOMAIN)
+    RS2_ENUM_HELPERS(rs2_frame_drop_cause, FRAME_DROP_CAUSE)
+    RS2_ENUM_HELPERS(rs2_frame_trace_stage, FRAME_TRACE_STAGE)
+    RS2_ENUM_HELPERS(rs2_memory_category, MEMORY_CATEGORY)
+    RS2_ENUM_HELPERS(rs2_memory_budget_policy, MEMORY_BUDGET_POLICY)
+    RS2_ENUM_HELPERS(rs2_thread_role, THREAD_ROLE)
+    RS2_ENUM_HELPERS(rs2_points_format, POINTS_FORMAT)
     RS2_ENUM_HELPERS(rs2_sr300_visual_preset, SR300_VISUAL_PRESET)
     RS2_ENUM_HELPERS(rs2_extension, EXTENSION)
     RS2_ENUM_HELPERS(rs2_exception_type, EXCEPTION_TYPE)
     RS2_ENUM_HELPERS(rs2_log_severity, LOG_SEVERITY)
     RS2_ENUM_HELPERS(rs2_notification_category, NOTIFICATION_CATEGORY)
     RS2_ENUM_HELPERS(rs2_playback_status, PLAYBACK_STATUS)
+    RS2_ENUM_HELPERS(rs2_frame_compression, FRAME_COMPRESSION)
     RS2_ENUM_HELPERS(rs2_matchers, MATCHER)
     RS2_ENUM_HELPERS(rs2_sensor_mode, SENSOR_MODE)
     RS2_ENUM_HELPERS(rs2_l500_visual_preset, L500_VISUAL_PRESET)
@@ -1064,13 +1080,50 @@ namespace librealsense
         void release() { delete this; }
     };
 
+    class calibration_done_callback : public rs2_calibration_done_callback
+    {
+        rs2_calibration_done_callback_ptr _nptr;
+        void* _client_data;
+    public:
+        calibration_done_callback(rs2_calibration_done_callback_ptr on_calibration_done, void* client_data = NULL)
+        : _nptr(on_calibration_done), _client_data(client_data){}
+
+        void on_calibration_done(const unsigned char* calibration, int size, float health, const char* error_message) override {
+            if (_nptr)
+            {
+                try { _nptr(calibration, size, health, error_message, _client_data); }
+                catch (...)
+                {
+                    LOG_ERROR("Received an exception from calibration done callback!");
+                }
+            }
+        }
+        void release() override { delete this; }
+    };
+
+    class frame_allocator_fptr : public rs2_frame_allocator
+    {
+        rs2_frame_allocate_ptr _allocate;
+        rs2_frame_deallocate_ptr _deallocate;
+        void* _user;
+    public:
+        frame_allocator_fptr(rs2_frame_allocate_ptr allocate, rs2_frame_deallocate_ptr deallocate, void* user)
+            : _allocate(allocate), _deallocate(deallocate), _user(user) {}
+
+        void* allocate(size_t size) override { return _allocate(static_cast<int>(size), _user); }
+        void deallocate(void* ptr, size_t size) override { _deallocate(ptr, static_cast<int>(size), _user); }
+        void release() override { delete this; }
+    };
+
     typedef std::shared_ptr<rs2_frame_callback> frame_callback_ptr;
+    typedef std::shared_ptr<rs2_frame_allocator> frame_allocator_ptr;
     typedef std::shared_ptr<rs2_frame_processor_callback> frame_processor_callback_ptr;
     typedef std::shared_ptr<rs2_notifications_callback> notifications_callback_ptr;
     typedef std::shared_ptr<rs2_calibration_change_callback> calibration_change_callback_ptr;
     typedef std::shared_ptr<rs2_software_device_destruction_callback> software_device_destruction_callback_ptr;
     typedef std::shared_ptr<rs2_devices_changed_callback> devices_changed_callback_ptr;
     typedef std::shared_ptr<rs2_update_progress_callback> update_progress_callback_ptr;
+    typedef std::shared_ptr<rs2_calibration_done_callback> calibration_done_callback_ptr;
 
     using internal_callback = std::function<void(rs2_device_list* removed, rs2_device_list* added)>;
     class devices_changed_callback_internal : public rs2_devices_changed_callback
@@ -1125,8 +1178,11 @@ namespace librealsense
         void set_callback(notifications_callback_ptr callback);
         notifications_callback_ptr get_callback() const;
         void raise_notification(const notification);
+        // Called from the thread raising each notification, before the notification is dispatched to the user callback
+        void set_on_raise(std::function<void()> on_raise) { _on_raise = std::move(on_raise); }
 
     private:
+        std::function<void()> _on_raise;
         notifications_callback_ptr _callback;
         std::mutex _callback_mutex;
         dispatcher _dispatcher;
@@ -1240,6 +1296,81 @@ namespace librealsense
 
         bool is_empty() const { return size == 0; }
         int get_size() const { return size; }
+        bool owns(const T * item) const { return item >= buffer && item < buffer + C; }
+    };
+
+    // Grows by small_heap segments of C items, up to S segments, as the requested capacity rises.
+    // Segments are never released before the heap itself, so handed out items stay valid
+    template<class T, int C, int S>
+    class segmented_heap
+    {
+        std::vector<std::unique_ptr<small_heap<T, C>>> segments;
+        std::atomic<int> segment_count;
+        std::mutex grow_mutex;
+        bool keep_allocating = true;
+
+        bool grow(int segments_needed, int capacity)
+        {
+            std::lock_guard<std::mutex> lock(grow_mutex);
+            auto count = segment_count.load();
+            if (count >= segments_needed) return true;
+            if (!keep_allocating || count >= S || count * C >= capacity) return false;
+
+            segments.emplace_back(new small_heap<T, C>());
+            segment_count.store(count + 1, std::memory_order_release);
+            return true;
+        }
+
+    public:
+        static const int CAPACITY = C * S;
+
+        segmented_heap() : segment_count(0)
+        {
+            segments.reserve(S);
+            grow(1, C);
+        }
+
+        T * allocate(int capacity)
+        {
+            for (auto i = 0; ; i++)
+            {
+                if (i >= segment_count.load(std::memory_order_acquire) && !grow(i + 1, capacity))
+                    return nullptr;
+                if (auto item = segments[i]->allocate())
+                    return item;
+            }
+        }
+
+        void deallocate(T * item)
+        {
+            auto count = segment_count.load(std::memory_order_acquire);
+            for (auto i = 0; i < count; i++)
+            {
+                if (segments[i]->owns(item))
+                {
+                    segments[i]->deallocate(item);
+                    return;
+                }
+            }
+            throw invalid_value_exception("Trying to return item to a heap that didn't allocate it!");
+        }
+
+        void stop_allocation()
+        {
+            std::lock_guard<std::mutex> lock(grow_mutex);
+            keep_allocating = false;
+            for (auto&& segment : segments)
+                segment->stop_allocation();
+        }
+
+        int get_size() const
+        {
+            auto count = segment_count.load(std::memory_order_acquire);
+            auto size = 0;
+            for (auto i = 0; i < count; i++)
+                size += segments[i]->get_size();
+            return size;
+        }
     };
 
     struct uvc_device_info
@@ -1441,6 +1572,7 @@ namespace librealsense
     {
         std::function<void()> continuation;
         const void* protected_data = nullptr;
+        size_t protected_size = 0;
 
         frame_continuation(const frame_continuation &) = delete;
         frame_continuation & operator=(const frame_continuation &) = delete;
@@ -1449,11 +1581,15 @@ namespace librealsense
 
         explicit frame_continuation(std::function<void()> continuation, const void* protected_data) : continuation(continuation), protected_data(protected_data) {}
 
+        // protected_size marks the protected data as the frame content, e.g. a capture buffer used without copy
+        explicit frame_continuation(std::function<void()> continuation, const void* protected_data, size_t protected_size)
+            : continuation(continuation), protected_data(protected_data), protected_size(protected_size) {}
 
-        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data)
+        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data), protected_size(other.protected_size)
         {
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
         }
 
         void operator()()
@@ -1461,23 +1597,28 @@ namespace librealsense
             continuation();
             continuation = []() {};
             protected_data = nullptr;
+            protected_size = 0;
         }
 
         void reset()
         {
             protected_data = nullptr;
+            protected_size = 0;
             continuation = [](){};
         }
 
         const void* get_data() const { return protected_data; }
+        size_t get_size() const { return protected_size; }
 
         frame_continuation & operator=(frame_continuation && other)
         {
             continuation();
             protected_data = other.protected_data;
+            protected_size = other.protected_size;
             continuation = other.continuation;
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.protected_size = 0;
             return *this;
         }
 
@@ -1538,9 +1679,6 @@ namespace librealsense
             polling(cancellable_timer);
         }), _devices_data()
         {
-            _devices_data = {   _backend->query_uvc_devices(),
-                                _backend->query_usb_devices(),
-                                _backend->query_hid_devices() };
         }
 
         ~polling_device_watcher()
@@ -1571,6 +1709,15 @@ namespace librealsense
         {
             stop();
             _callback = std::move(callback);
+
+            // The devices are enumerated when watching starts rather than with the context, which is created far more often than watched
+            if (!_has_devices_data)
+            {
+                _devices_data = {   _backend->query_uvc_devices(),
+                                    _backend->query_usb_devices(),
+                                    _backend->query_hid_devices() };
+                _has_devices_data = true;
+            }
             _active_object.start();
         }
 
@@ -1588,6 +1735,7 @@ namespace librealsense
         const platform::backend* _backend;
 
         platform::backend_device_group _devices_data;
+        bool _has_devices_data = false;
         platform::device_changed_callback _callback;
 
     };
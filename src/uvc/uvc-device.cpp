@@ -13,6 +13,8 @@
 const int CONTROL_TRANSFER_TIMEOUT = 100;
 const int INTERRUPT_BUFFER_SIZE = 1024;
 const int FIRST_FRAME_MILLISECONDS_TIMEOUT = 2000;
+const int UVC_REQUESTS_WINDOW_MS = 50;
+const int MAX_UVC_REQUEST_COUNT = 8;
 
 class lock_singleton
 {
@@ -78,7 +80,7 @@ namespace librealsense
         rs_uvc_device::rs_uvc_device(const rs_usb_device& usb_device, const uvc_device_info &info, uint8_t usb_request_count) :
                 _usb_device(usb_device),
                 _info(info),
-                _action_dispatcher(10),
+                _action_dispatcher(10, thread_policy_hook(RS2_THREAD_ROLE_CONTROL)),
                 _usb_request_count(usb_request_count)
         {
             _parser = std::make_shared<uvc_parser>(usb_device, info);
@@ -103,6 +105,7 @@ namespace librealsense
 
             _profiles.push_back(profile);
             _frame_callbacks.push_back(callback);
+            _frame_buffers.push_back(buffers);
         }
 
         void rs_uvc_device::stream_on(std::function<void(const notification& n)> error_handler)
@@ -117,7 +120,7 @@ namespace librealsense
 
             try {
                 for (uint32_t i = 0; i < _profiles.size(); ++i) {
-                    play_profile(_profiles[i], _frame_callbacks[i]);
+                    play_profile(_profiles[i], _frame_callbacks[i], _frame_buffers[i]);
                 }
             }
             catch (...) {
@@ -127,6 +130,7 @@ namespace librealsense
 
                 _profiles.clear();
                 _frame_callbacks.clear();
+                _frame_buffers.clear();
 
                 throw;
             }
@@ -418,7 +422,7 @@ namespace librealsense
             return translated_value;
         }
 
-        void rs_uvc_device::play_profile(stream_profile profile, frame_callback callback) {
+        void rs_uvc_device::play_profile(stream_profile profile, frame_callback callback, int buffers) {
             bool foundFormat = false;
 
             uvc_format_t selected_format{};
@@ -451,7 +455,16 @@ namespace librealsense
             if(sts != RS2_USB_STATUS_SUCCESS)
                 throw std::runtime_error("Failed to start streaming!");
 
-            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, _usb_request_count };
+            // The frames queue between the USB requests and the user callback holds the stream buffers
+            int queue_size = backend_frames_archive::CAPACITY;
+            if (buffers > 0 && buffers < queue_size)
+                queue_size = buffers;
+            // Keep enough transfers in flight to cover the frames of UVC_REQUESTS_WINDOW_MS, a shallow ring drops frames at high rates
+            int request_count = (profile.fps * UVC_REQUESTS_WINDOW_MS + 999) / 1000;
+            request_count = std::max<int>(_usb_request_count, std::min(request_count, MAX_UVC_REQUEST_COUNT));
+
+            uvc_streamer_context usc = { profile, callback, ctrl, _usb_device, _messenger, static_cast<uint8_t>(request_count),
+                                         static_cast<uint8_t>(queue_size), _latest_frame_only };
 
             auto streamer = std::make_shared<uvc_streamer>(usc);
             _streamers.push_back(streamer);
@@ -477,6 +490,7 @@ namespace librealsense
             if (pos != _profiles.size()) {
                 _profiles.erase(_profiles.begin() + pos);
                 _frame_callbacks.erase(_frame_callbacks.begin() + pos);
+                _frame_buffers.erase(_frame_buffers.begin() + pos);
             }
         }
 
@@ -40,6 +40,8 @@ namespace librealsense
             virtual ~rs_uvc_device();
 
             virtual void probe_and_commit(stream_profile profile, frame_callback callback, int buffers = DEFAULT_V4L2_FRAME_BUFFERS) override;
+            virtual void set_latest_frame_only(bool latest_only) override { _latest_frame_only = latest_only; }
+            virtual bool retains_frame_buffers() const override { return true; }
             virtual void stream_on(std::function<void(const notification& n)> error_handler = [](const notification& n){}) override;
             virtual void start_callbacks() override;
             virtual void stop_callbacks() override;
@@ -79,7 +81,7 @@ namespace librealsense
             bool uvc_set_ctrl(uint8_t unit, uint8_t ctrl, void *data, int len);
 
             int32_t rs2_value_translate(uvc_req_code action, rs2_option option, int32_t value) const;
-            void play_profile(stream_profile profile, frame_callback callback);
+            void play_profile(stream_profile profile, frame_callback callback, int buffers);
             void stop_stream_cleanup(const stream_profile& profile, std::vector<profile_and_callback>::iterator& elem);
             void check_connection() const;
 
@@ -97,6 +99,8 @@ namespace librealsense
             std::string                             _location;
             std::vector<stream_profile>             _profiles;
             std::vector<frame_callback>             _frame_callbacks;
+            std::vector<int>                        _frame_buffers;
+            bool                                    _latest_frame_only = false;
 
             rs_usb_device                           _usb_device = nullptr;
             rs_usb_messenger                        _messenger;
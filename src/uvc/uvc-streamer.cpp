@@ -3,6 +3,7 @@
 
 #include "uvc-streamer.h"
 #include "../backend.h"
+#include "../profiler.h"
 
 const int UVC_PAYLOAD_MAX_HEADER_LENGTH         = 1024;
 const int DEQUEUE_MILLISECONDS_TIMEOUT          = 50;
@@ -17,7 +18,7 @@ namespace librealsense
     namespace platform
     {
         uvc_streamer::uvc_streamer(uvc_streamer_context context) :
-            _context(context), _action_dispatcher(10)
+            _context(context), _action_dispatcher(10, thread_policy_hook(RS2_THREAD_ROLE_CONTROL)), _queue(context.queue_size)
         {
             auto inf = context.usb_device->get_interface(context.control->bInterfaceNumber);
             if (inf == nullptr)
@@ -91,10 +92,23 @@ namespace librealsense
                 backend_frame_ptr fp(nullptr, [](backend_frame *) {});
                 if (_queue.dequeue(&fp, DEQUEUE_MILLISECONDS_TIMEOUT))
                 {
+                    // Skip to the newest frame, the stale frames are released back to the archive
+                    if (_context.latest_frame_only)
+                        while (_queue.try_dequeue(&fp)) {}
+
+
                     if(_publish_frames && running())
-                        _context.user_cb(_context.profile, fp->fo, []() mutable {});
+                    {
+                        LRS_PROFILE_ZONE("uvc_streamer::dispatch");
+                        // The frame may keep referring to the backend buffer after the callback returns,
+                        // so the buffer is returned to the archive once the continuation is invoked.
+                        // The deleter holds the archive, which therefore outlives the streamer while frames are in use
+                        auto archive = _frames_archive;
+                        std::shared_ptr<backend_frame> frame(fp.release(), [archive](backend_frame* ptr) { cleanup_frame(ptr); });
+                        _context.user_cb(_context.profile, frame->fo, [frame]() mutable { frame.reset(); });
+                    }
                 }
-            });
+            }, thread_policy_hook(RS2_THREAD_ROLE_CAPTURE));
 
             _watchdog = std::make_shared<watchdog>([this]()
              {
@@ -107,36 +121,36 @@ namespace librealsense
                        _context.messenger->reset_endpoint(_read_endpoint, ENDPOINT_RESET_MILLISECONDS_TIMEOUT);
                        _frame_arrived = false;
                    });
-             }, _watchdog_timeout);
+             }, _watchdog_timeout, thread_policy_hook(RS2_THREAD_ROLE_MONITORING));
 
             _watchdog->start();
 
+            // Completions are handled on the USB events thread, so that the transfer is resubmitted right away.
+            // The filled buffer is swapped with the one of a free backend frame rather than copied.
+            // stop() cancels the callback first, which waits for a running completion to return
             _request_callback = std::make_shared<usb_request_callback>([this](platform::rs_usb_request r)
             {
-                _action_dispatcher.invoke([this, r](dispatcher::cancellable_timer)
-                {
-                    if(!_running)
-                      return;
+                if(!_running)
+                  return;
 
-                    auto al = r->get_actual_length();
-                    // Relax the frame size constrain for compressed streams
-                    bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
-                    if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+                auto al = r->get_actual_length();
+                // Relax the frame size constrain for compressed streams
+                bool is_compressed = val_in_range(_context.profile.format, { 0x4d4a5047U , 0x5a313648U}); // MJPEG, Z16H
+                if(al > 0L && ((al == r->get_buffer().data()[0] + _context.control->dwMaxVideoFrameSize) || is_compressed ))
+                {
+                    auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
+                    if(f)
                     {
-                        auto f = backend_frame_ptr(_frames_archive->allocate(), &cleanup_frame);
-                        if(f)
-                        {
-                            _frame_arrived = true;
-                            _watchdog->kick();
-                            memcpy(f->pixels.data(), r->get_buffer().data(), r->get_buffer().size());
-                            uvc_process_bulk_payload(std::move(f), r->get_actual_length(), _queue);
-                        }
+                        _frame_arrived = true;
+                        _watchdog->kick();
+                        r->swap_buffer(f->pixels);
+                        uvc_process_bulk_payload(std::move(f), al, _queue);
                     }
+                }
 
-                    auto sts = _context.messenger->submit_request(r);
-                    if(sts != platform::RS2_USB_STATUS_SUCCESS)
-                        LOG_ERROR("failed to submit UVC request, error: " << sts);
-                });
+                auto sts = _context.messenger->submit_request(r);
+                if(sts != platform::RS2_USB_STATUS_SUCCESS)
+                    LOG_ERROR("failed to submit UVC request, error: " << sts);
             });
 
             _requests = std::vector<rs_usb_request>(_context.request_count);
@@ -194,8 +208,7 @@ namespace librealsense
 
                 _requests.clear();
 
-                _frames_archive->wait_until_empty();
-
+                // Not waiting for the archive to drain: frames still held by the user return their buffers on release
                 _context.messenger->reset_endpoint(_read_endpoint, RS2_USB_ENDPOINT_DIRECTION_READ);
 
                 _publish_frame_thread->stop();
@@ -26,6 +26,8 @@ namespace librealsense
             rs_usb_device usb_device;
             rs_usb_messenger messenger;
             uint8_t request_count;
+            uint8_t queue_size;
+            bool latest_frame_only;
         };
 
         class uvc_streamer
@@ -438,4 +438,4 @@ typedef void(*cleanup_ptr)(backend_frame *);
 
 // Unique_ptr is used as the simplest RAII, with static deleter
 typedef std::unique_ptr<backend_frame, cleanup_ptr> backend_frame_ptr;
-typedef single_consumer_queue<backend_frame_ptr> backend_frames_queue;
+typedef lock_free_single_consumer_queue<backend_frame_ptr> backend_frames_queue;
@@ -9,10 +9,12 @@ namespace librealsense
 {
     namespace platform
     {
+#ifndef RS2_USE_WMF_BACKEND // Otherwise the Media Foundation backend creates this one when selected at runtime
         std::shared_ptr<backend> create_backend()
         {
             return std::make_shared<rs_backend_windows>();
         }
+#endif
 
         std::shared_ptr<device_watcher> rs_backend_windows::create_device_watcher() const
         {
@@ -223,6 +223,7 @@ private:
 
     rs2rosinternal::Header readMessageDataHeader(IndexEntry const& index_entry);
     uint32_t    readMessageDataSize(IndexEntry const& index_entry) const;
+    bool        readMessageDataFileOffset(IndexEntry const& index_entry, uint64_t& offset, uint32_t& size) const;
 
     template<typename Stream>
     void readMessageDataIntoStream(IndexEntry const& index_entry, Stream& stream) const;
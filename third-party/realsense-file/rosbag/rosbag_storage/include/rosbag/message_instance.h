@@ -93,6 +93,12 @@ public:
     //! Size of serialized message
     uint32_t size() const;
 
+    //! Position of the serialized message in the bag file
+    /*!
+     * returns false if the message is not stored as is, e.g. in a compressed chunk
+     */
+    bool getDataFileOffset(uint64_t& offset, uint32_t& size) const;
+
 private:
     MessageInstance(ConnectionInfo const* connection_info, IndexEntry const& index, Bag const& bag);
 
@@ -921,6 +921,40 @@ uint32_t Bag::readMessageDataSize(IndexEntry const& index_entry) const {
     }
 }
 
+// Locates the serialized message in the file without reading it. Only the messages of the
+// uncompressed chunks of a version 2.0 bag are stored as is, returns false for any other message
+bool Bag::readMessageDataFileOffset(IndexEntry const& index_entry, uint64_t& offset, uint32_t& size) const {
+    if (version_ != 200 || curr_chunk_info_.pos == index_entry.chunk_pos)
+        return false;
+
+    seek(index_entry.chunk_pos);
+    ChunkHeader chunk_header;
+    readChunkHeader(chunk_header);
+    if (chunk_header.compression != COMPRESSION_NONE)
+        return false;
+
+    seek(file_.getOffset() + index_entry.offset);
+    rs2rosinternal::Header header;
+    uint32_t data_size;
+    uint8_t op;
+    do {
+        if (!readHeader(header) || !readDataLength(data_size))
+            throw BagFormatException("Error reading header");
+
+        readField(*header.getValues(), OP_FIELD_NAME, true, &op);
+        if (op == OP_MSG_DEF || op == OP_CONNECTION)
+            seek(data_size, std::ios::cur);
+    }
+    while (op == OP_MSG_DEF || op == OP_CONNECTION);
+
+    if (op != OP_MSG_DATA)
+        throw BagFormatException("Expected MSG_DATA op not found");
+
+    offset = file_.getOffset();
+    size = data_size;
+    return true;
+}
+
 void Bag::writeChunkInfoRecords() {
     foreach(ChunkInfo const& chunk_info, chunks_) {
         // Write the chunk info header
@@ -62,4 +62,8 @@ uint32_t MessageInstance::size() const {
     return bag_->readMessageDataSize(index_entry_);
 }
 
+bool MessageInstance::getDataFileOffset(uint64_t& offset, uint32_t& size) const {
+    return bag_->readMessageDataFileOffset(index_entry_, offset, size);
+}
+
 } // namespace rosbag
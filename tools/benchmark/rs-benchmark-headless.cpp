@@ -0,0 +1,544 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace chrono;
+using namespace TCLAP;
+
+// The allocations of the process, the library allocates through the replaced operator new
+// except on Windows, where each module has its own
+static atomic<unsigned long long> allocations(0);
+
+#ifndef _WIN32
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { free(p); }
+#define ALLOCATIONS_COUNTED true
+#else
+#define ALLOCATIONS_COUNTED false
+#endif
+
+string get_cpu()
+{
+#if defined __linux__ || defined(__linux__)
+    string line;
+    ifstream finfo("/proc/cpuinfo");
+    while (getline(finfo, line))
+    {
+        stringstream str(line);
+        string itype;
+        string info;
+        if (getline(str, itype, ':') && getline(str, info) && (itype.substr(0, 10) == "model name" || itype.substr(0, 5) == "Model"))
+        {
+            return info.substr(info.find_first_not_of(' '));
+        }
+    }
+#endif
+    return "unknown";
+}
+
+string get_architecture()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return "x86_64";
+#elif defined(__i386__) || defined(_M_IX86)
+    return "x86";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return "arm64";
+#elif defined(__arm__) || defined(_M_ARM)
+    return "arm";
+#else
+    return "unknown";
+#endif
+}
+
+string json_string(const string& str)
+{
+    string res = "\"";
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\') res += '\\';
+        if (c >= 0 && c < ' ') continue;
+        res += c;
+    }
+    return res + "\"";
+}
+
+// Frames of one resolution, the depth and color frames of a frameset share their frame number
+struct frame_set
+{
+    int width, height;
+    string source;
+    vector<rs2::frameset> frames;
+};
+
+// Software device streaming synthetic depth, YUYV color and Y8 infrared frames. The depth is a tilted floor with
+// a box on it, noise and holes, so the filters find edges, holes and temporal changes as in real scenes
+class synthetic_camera
+{
+public:
+    synthetic_camera(int width, int height)
+        : _width(width), _height(height)
+    {
+        rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, width * 0.9f, width * 0.9f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+        _depth_sensor = make_shared<rs2::software_sensor>(_device.add_sensor("Stereo Module"));
+        _color_sensor = make_shared<rs2::software_sensor>(_device.add_sensor("RGB Camera"));
+        _depth_sensor->add_read_only_option(RS2_OPTION_DEPTH_UNITS, 0.001f);
+        _depth_sensor->add_read_only_option(RS2_OPTION_STEREO_BASELINE, 50.f);
+        _depth = _depth_sensor->add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        _infrared = _depth_sensor->add_video_stream({ RS2_STREAM_INFRARED, 1, 1, width, height, 30, 1, RS2_FORMAT_Y8, intrinsics });
+        intrinsics.ppx += 4;
+        _color = _color_sensor->add_video_stream({ RS2_STREAM_COLOR, 0, 2, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics });
+        _depth.register_extrinsics_to(_infrared, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } });
+        _depth.register_extrinsics_to(_color, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0, 0 } });
+        _device.create_matcher(RS2_MATCHER_DLR_C);
+    }
+
+    frame_set capture(int count)
+    {
+        frame_set result = { _width, _height, "synthetic" };
+        rs2::syncer sync;
+        _depth_sensor->open({ _depth, _infrared });
+        _color_sensor->open(_color);
+        _depth_sensor->start(sync);
+        _color_sensor->start(sync);
+
+        mt19937 rng(7);
+        normal_distribution<float> noise(0.f, 2.f);
+        for (int i = 0; i < count; i++)
+        {
+            // the buffers stay referenced by the frames of the set
+            auto depth = make_shared<vector<uint16_t>>(_width * _height);
+            auto infrared = make_shared<vector<uint8_t>>(_width * _height);
+            auto color = make_shared<vector<uint8_t>>(_width * _height * 2);
+            for (int y = 0; y < _height; y++)
+            {
+                for (int x = 0; x < _width; x++)
+                {
+                    bool box = abs(x - _width / 2 - i) < _width / 6 && abs(y - _height / 2) < _height / 5;
+                    float z = box ? 900.f : 3000.f - 1500.f * y / _height;
+                    bool hole = (x * 7 + y * 13 + i) % 97 == 0 || x < _width / 20;
+                    (*depth)[y * _width + x] = hole ? 0 : uint16_t(z + noise(rng));
+                    (*infrared)[y * _width + x] = uint8_t((x ^ y) + i);
+                    (*color)[(y * _width + x) * 2] = uint8_t(x + y);
+                    (*color)[(y * _width + x) * 2 + 1] = uint8_t(128 + (x & 15) - (y & 15));
+                }
+            }
+            _buffers.push_back(depth);
+            _buffers.push_back(infrared);
+            _buffers.push_back(color);
+
+            double timestamp = i * 33.3;
+            _depth_sensor->on_video_frame({ depth->data(), [](void*) {}, _width * 2, 2, timestamp, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, _depth });
+            _depth_sensor->on_video_frame({ infrared->data(), [](void*) {}, _width, 1, timestamp, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, _infrared });
+            _color_sensor->on_video_frame({ color->data(), [](void*) {}, _width * 2, 2, timestamp, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, i, _color });
+
+            rs2::frameset fs;
+            while (sync.try_wait_for_frames(&fs, 100))
+            {
+                fs.keep();
+                if (fs.size() == 3)
+                    result.frames.push_back(fs);
+            }
+        }
+
+        _depth_sensor->stop();
+        _color_sensor->stop();
+        _depth_sensor->close();
+        _color_sensor->close();
+        return result;
+    }
+
+private:
+    int _width, _height;
+    rs2::software_device _device;
+    shared_ptr<rs2::software_sensor> _depth_sensor, _color_sensor;
+    rs2::stream_profile _depth, _infrared, _color;
+    vector<shared_ptr<void>> _buffers;
+};
+
+// Frames of a recording, played back as fast as they are read
+frame_set read_recording(const string& file, int count)
+{
+    rs2::pipeline pipe;
+    rs2::config cfg;
+    cfg.enable_device_from_file(file, false);
+    auto profile = pipe.start(cfg);
+    profile.get_device().as<rs2::playback>().set_real_time(false);
+
+    frame_set result = { 0, 0, file };
+    rs2::frameset fs;
+    while (int(result.frames.size()) < count && pipe.try_wait_for_frames(&fs, 1000))
+    {
+        if (!fs.get_depth_frame())
+            continue;
+        fs.keep();
+        result.width = fs.get_depth_frame().get_width();
+        result.height = fs.get_depth_frame().get_height();
+        result.frames.push_back(fs);
+    }
+    pipe.stop();
+    return result;
+}
+
+// The first frames of the first connected camera, the default profile for each stream that is available
+frame_set read_camera(int count)
+{
+    rs2::pipeline pipe;
+    rs2::config cfg;
+    cfg.enable_stream(RS2_STREAM_DEPTH);
+    cfg.enable_stream(RS2_STREAM_INFRARED);
+    cfg.enable_stream(RS2_STREAM_COLOR, RS2_FORMAT_YUYV);
+    if (!cfg.can_resolve(pipe))
+    {
+        cfg.disable_all_streams();
+        cfg.enable_stream(RS2_STREAM_DEPTH);
+    }
+    pipe.start(cfg);
+
+    frame_set result = { 0, 0, "camera" };
+    rs2::frameset fs;
+    // skip the first frames, while the auto-exposure settles
+    for (int i = 0; i < 30; i++)
+        pipe.try_wait_for_frames(&fs, 1000);
+    while (int(result.frames.size()) < count && pipe.try_wait_for_frames(&fs, 1000))
+    {
+        if (!fs.get_depth_frame())
+            continue;
+        fs.keep();
+        result.width = fs.get_depth_frame().get_width();
+        result.height = fs.get_depth_frame().get_height();
+        result.frames.push_back(fs);
+    }
+    pipe.stop();
+    return result;
+}
+
+// Whether the frames hold what the block processes
+bool has_input(const frame_set& set, rs2_stream input)
+{
+    for (auto&& fs : set.frames)
+    {
+        if (input == RS2_STREAM_ANY ? (fs.get_depth_frame() && fs.get_color_frame()) : bool(fs.first_or_default(input)))
+            return true;
+    }
+    return false;
+}
+
+struct benchmark
+{
+    string name;
+    rs2_stream input; // the stream given to the block, RS2_STREAM_ANY gives the frameset
+    function<rs2::frame(rs2::frame)> process;
+};
+
+vector<benchmark> get_benchmarks()
+{
+    auto decimation = make_shared<rs2::decimation_filter>();
+    auto spatial = make_shared<rs2::spatial_filter>();
+    auto temporal = make_shared<rs2::temporal_filter>();
+    auto hole_filling = make_shared<rs2::hole_filling_filter>();
+    auto threshold = make_shared<rs2::threshold_filter>();
+    auto to_disparity = make_shared<rs2::disparity_transform>(true);
+    auto units = make_shared<rs2::units_transform>();
+    auto colorizer = make_shared<rs2::colorizer>();
+    auto pointcloud = make_shared<rs2::pointcloud>();
+    auto textured_pointcloud = make_shared<rs2::pointcloud>();
+    auto align_to_color = make_shared<rs2::align>(RS2_STREAM_COLOR);
+    auto align_to_depth = make_shared<rs2::align>(RS2_STREAM_DEPTH);
+    auto yuy_decoder = make_shared<rs2::yuy_decoder>();
+
+    return {
+        { "decimation_filter", RS2_STREAM_DEPTH, [=](rs2::frame f) { return decimation->process(f); } },
+        { "spatial_filter", RS2_STREAM_DEPTH, [=](rs2::frame f) { return spatial->process(f); } },
+        { "temporal_filter", RS2_STREAM_DEPTH, [=](rs2::frame f) { return temporal->process(f); } },
+        { "hole_filling_filter", RS2_STREAM_DEPTH, [=](rs2::frame f) { return hole_filling->process(f); } },
+        { "threshold_filter", RS2_STREAM_DEPTH, [=](rs2::frame f) { return threshold->process(f); } },
+        { "disparity_transform", RS2_STREAM_DEPTH, [=](rs2::frame f) { return to_disparity->process(f); } },
+        { "units_transform", RS2_STREAM_DEPTH, [=](rs2::frame f) { return units->process(f); } },
+        { "colorizer", RS2_STREAM_DEPTH, [=](rs2::frame f) { return colorizer->process(f); } },
+        { "pointcloud", RS2_STREAM_DEPTH, [=](rs2::frame f) { return pointcloud->calculate(f); } },
+        { "pointcloud_textured", RS2_STREAM_ANY, [=](rs2::frame f) {
+            auto fs = f.as<rs2::frameset>();
+            textured_pointcloud->map_to(fs.get_color_frame());
+            return textured_pointcloud->calculate(fs.get_depth_frame());
+        } },
+        { "align_to_color", RS2_STREAM_ANY, [=](rs2::frame f) { return align_to_color->process(f.as<rs2::frameset>()); } },
+        { "align_to_depth", RS2_STREAM_ANY, [=](rs2::frame f) { return align_to_depth->process(f.as<rs2::frameset>()); } },
+        { "yuy_decoder", RS2_STREAM_COLOR, [=](rs2::frame f) { return yuy_decoder->process(f); } },
+    };
+}
+
+struct result
+{
+    string name;
+    int width, height;
+    string source;
+    int frames;
+    double median_ns, mean_ns, p95_ns, min_ns;
+    double allocations;
+};
+
+result run(benchmark& b, const frame_set& set, int warmup, int count)
+{
+    vector<rs2::frame> inputs;
+    for (auto&& fs : set.frames)
+    {
+        rs2::frame f = fs;
+        if (b.input != RS2_STREAM_ANY)
+            f = fs.first_or_default(b.input);
+        if (f)
+            inputs.push_back(f);
+    }
+    if (inputs.empty())
+        throw runtime_error("no " + string(rs2_stream_to_string(b.input)) + " frames in " + set.source);
+
+    vector<double> times;
+    unsigned long long allocated = 0;
+    for (int i = 0; i < warmup + count; i++)
+    {
+        auto& f = inputs[i % inputs.size()];
+        auto before = allocations.load();
+        auto start = high_resolution_clock::now();
+        {
+            // the output is released inside the measure, as a streaming application does
+            auto output = b.process(f);
+        }
+        auto end = high_resolution_clock::now();
+        if (i < warmup)
+            continue;
+        allocated += allocations.load() - before;
+        times.push_back(duration<double, nano>(end - start).count());
+    }
+
+    sort(times.begin(), times.end());
+    result r = { b.name, set.width, set.height, set.source, count };
+    r.median_ns = times[times.size() / 2];
+    r.mean_ns = accumulate(times.begin(), times.end(), 0.0) / times.size();
+    r.p95_ns = times[min(times.size() - 1, size_t(times.size() * 0.95))];
+    r.min_ns = times.front();
+    r.allocations = double(allocated) / count;
+    return r;
+}
+
+// Streams depth and color through the sensors, the format conversions, the syncer and align to color.
+// When replaying, the backend feeds the recorded USB frames as fast as they are read, in a loop, so the time
+// between framesets is the throughput of the capture path. When recording, the camera paces the frames
+result run_capture(rs2::context ctx, const string& source, int warmup, int count)
+{
+    rs2::pipeline pipe(ctx);
+    rs2::config cfg;
+    cfg.enable_stream(RS2_STREAM_DEPTH);
+    cfg.enable_stream(RS2_STREAM_COLOR, RS2_FORMAT_RGB8);
+    if (!cfg.can_resolve(pipe))
+    {
+        cfg.disable_all_streams();
+        cfg.enable_stream(RS2_STREAM_DEPTH);
+    }
+    pipe.start(cfg);
+    rs2::align align_to_color(RS2_STREAM_COLOR);
+
+    result r = { "capture", 0, 0, source, 0 };
+    vector<double> times;
+    unsigned long long allocated = 0;
+    rs2::frameset fs;
+    auto start = high_resolution_clock::now();
+    auto before = allocations.load();
+    for (int i = 0; i < warmup + count; i++)
+    {
+        if (!pipe.try_wait_for_frames(&fs, 5000))
+            break;
+        {
+            auto output = fs.get_color_frame() ? rs2::frame(align_to_color.process(fs)) : rs2::frame(fs);
+        }
+        auto end = high_resolution_clock::now();
+        auto allocs = allocations.load();
+        if (i >= warmup)
+        {
+            times.push_back(duration<double, nano>(end - start).count());
+            allocated += allocs - before;
+        }
+        r.width = fs.get_depth_frame().get_width();
+        r.height = fs.get_depth_frame().get_height();
+        start = end;
+        before = allocs;
+    }
+    pipe.stop();
+
+    if (times.empty())
+        throw runtime_error("no frames received from " + source);
+
+    sort(times.begin(), times.end());
+    r.frames = int(times.size());
+    r.median_ns = times[times.size() / 2];
+    r.mean_ns = accumulate(times.begin(), times.end(), 0.0) / times.size();
+    r.p95_ns = times[min(times.size() - 1, size_t(times.size() * 0.95))];
+    r.min_ns = times.front();
+    r.allocations = double(allocated) / times.size();
+    return r;
+}
+
+void write_json(ostream& out, const vector<result>& results)
+{
+    out << "{\n";
+    out << "  \"librealsense\": " << json_string(RS2_API_VERSION_STR) << ",\n";
+    out << "  \"cpu\": " << json_string(get_cpu()) << ",\n";
+    out << "  \"architecture\": " << json_string(get_architecture()) << ",\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& r = results[i];
+        double mp = double(r.width) * r.height * 1e-6;
+        out << (i ? ",\n" : "\n") << "    { \"block\": " << json_string(r.name)
+            << ", \"width\": " << r.width << ", \"height\": " << r.height << ", \"source\": " << json_string(r.source)
+            << ", \"frames\": " << r.frames << fixed
+            << ", \"ns_per_frame\": " << setprecision(0) << r.median_ns
+            << ", \"mean_ns\": " << r.mean_ns << ", \"p95_ns\": " << r.p95_ns << ", \"min_ns\": " << r.min_ns
+            << ", \"mpixels_per_second\": " << setprecision(2) << mp / (r.median_ns * 1e-9)
+            << ", \"allocations_per_frame\": ";
+        if (ALLOCATIONS_COUNTED)
+            out << r.allocations;
+        else
+            out << "null";
+        out << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-benchmark-headless tool, times the processing blocks on synthetic or recorded frames and writes JSON", ' ', RS2_API_VERSION_STR);
+    MultiArg<string> resolutions("r", "resolution", "Resolution of the synthetic frames, WIDTHxHEIGHT, 640x480, 848x480 and 1280x720 by default", false, "string");
+    ValueArg<string> file("f", "file", "Recording to read the frames from, instead of the synthetic frames", false, "", "string");
+    SwitchArg camera("c", "camera", "Read the frames from the first connected camera, instead of the synthetic frames", false);
+    ValueArg<int> frames("n", "frames", "Frames timed per block and resolution", false, 100, "int");
+    ValueArg<int> warmup("w", "warmup", "Frames processed before the timed ones", false, 10, "int");
+    ValueArg<string> filter("b", "block", "Run the blocks whose name contains the string", false, "", "string");
+    ValueArg<string> output("o", "output", "JSON file to write, standard output by default", false, "", "string");
+    ValueArg<string> save_capture("s", "save-capture", "Record the USB frames and calls of a capture of the first connected camera into the file", false, "", "string");
+    ValueArg<string> replay_capture("p", "replay-capture", "Time the capture path replaying a file recorded with -s, no camera needed", false, "", "string");
+    cmd.add(resolutions);
+    cmd.add(file);
+    cmd.add(camera);
+    cmd.add(save_capture);
+    cmd.add(replay_capture);
+    cmd.add(frames);
+    cmd.add(warmup);
+    cmd.add(filter);
+    cmd.add(output);
+    cmd.parse(argc, argv);
+
+    // a set of distinct frames is cycled through, enough for the temporal filter to see changes
+    const int distinct_frames = 16;
+    vector<frame_set> sets;
+    vector<result> results;
+    if (save_capture.isSet())
+    {
+        // the replay makes the same calls, so it runs with the same -n and -w
+        rs2::recording_context ctx(save_capture.getValue(), "capture", RS2_RECORDING_MODE_BEST_QUALITY);
+        results.push_back(run_capture(ctx, "camera", warmup.getValue(), frames.getValue()));
+    }
+    else if (replay_capture.isSet())
+    {
+        rs2::mock_context ctx(replay_capture.getValue(), "capture");
+        results.push_back(run_capture(ctx, replay_capture.getValue(), warmup.getValue(), frames.getValue()));
+    }
+    else if (file.isSet())
+    {
+        sets.push_back(read_recording(file.getValue(), distinct_frames));
+        if (sets.back().frames.empty())
+            throw runtime_error("no depth frames in " + file.getValue());
+    }
+    else if (camera.isSet())
+    {
+        sets.push_back(read_camera(distinct_frames));
+        if (sets.back().frames.empty())
+            throw runtime_error("no depth frames received from the camera");
+    }
+    else
+    {
+        auto sizes = resolutions.getValue();
+        if (sizes.empty())
+            sizes = { "640x480", "848x480", "1280x720" };
+        for (auto&& size : sizes)
+        {
+            int width = 0, height = 0;
+            char x = 0;
+            stringstream ss(size);
+            if (!(ss >> width >> x >> height) || x != 'x' || width <= 0 || height <= 0)
+                throw runtime_error("invalid resolution " + size);
+            sets.push_back(synthetic_camera(width, height).capture(distinct_frames));
+        }
+    }
+
+    for (auto&& set : sets)
+    {
+        // new blocks for each resolution, the filters keep state of the previous frames
+        for (auto&& b : get_benchmarks())
+        {
+            if (b.name.find(filter.getValue()) == string::npos)
+                continue;
+            // recordings and cameras do not necessarily stream color
+            if (!has_input(set, b.input))
+            {
+                cerr << b.name << " skipped, no input frames in " << set.source << endl;
+                continue;
+            }
+            cerr << b.name << " " << set.width << "x" << set.height << endl;
+            results.push_back(run(b, set, warmup.getValue(), frames.getValue()));
+        }
+    }
+
+    if (output.isSet())
+    {
+        ofstream out(output.getValue());
+        if (!out)
+            throw runtime_error("cannot write " + output.getValue());
+        write_json(out, results);
+    }
+    else
+    {
+        write_json(cout, results);
+    }
+    return EXIT_SUCCESS;
+}
+catch (const rs2::error& e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
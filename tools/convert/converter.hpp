@@ -7,8 +7,14 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
 #include <string>
 #include <sstream>
+#include <iostream>
+#include <algorithm>
 
 #include "librealsense2/rs.hpp"
 
@@ -41,15 +47,77 @@ namespace rs2 {
 
             typedef unsigned long long frame_number_t;
 
+            // Fixed set of threads shared by all converters. post() blocks while the backlog is full,
+            // so the playback does not run ahead of the encoders and exhaust its frame queue
+            class worker_pool {
+                std::vector<std::thread> _threads;
+                std::deque<std::function<void()>> _jobs;
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                size_t _maxJobs;
+                bool _stopping = false;
+
+            public:
+                explicit worker_pool(size_t threads)
+                    : _maxJobs(std::max<size_t>(threads, 1))
+                {
+                    for (size_t i = 0; i < std::max<size_t>(threads, 1); ++i) {
+                        _threads.emplace_back([this] {
+                            std::unique_lock<std::mutex> lock(_mutex);
+                            while (true) {
+                                _cv.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+                                if (_jobs.empty()) {
+                                    return;
+                                }
+
+                                auto job = std::move(_jobs.front());
+                                _jobs.pop_front();
+                                _cv.notify_all();
+
+                                lock.unlock();
+                                job();
+                                lock.lock();
+                            }
+                        });
+                    }
+                }
+
+                ~worker_pool()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _stopping = true;
+                    }
+                    _cv.notify_all();
+
+                    for_each(_threads.begin(), _threads.end(),
+                        [] (std::thread& t) {
+                            t.join();
+                        });
+                }
+
+                void post(std::function<void()> job)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this] { return _jobs.size() < _maxJobs; });
+                    _jobs.push_back(std::move(job));
+                    _cv.notify_all();
+                }
+            };
+
             class converter_base {
             protected:
-                std::thread _worker;
-                std::vector<std::thread> _subWorkers;
+                std::shared_ptr<worker_pool> _pool;
+                std::mutex _mutex;
+                std::condition_variable _idle;
+                int _pending = 0;
                 std::unordered_map<int, std::unordered_set<frame_number_t>> _framesMap;
 
             protected:
                 bool frames_map_get_and_set(rs2_stream streamType, frame_number_t frameNumber)
                 {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
                     if (_framesMap.find(streamType) == _framesMap.end()) {
                         _framesMap.emplace(streamType, std::unordered_set<frame_number_t>());
                     }
@@ -64,32 +132,48 @@ namespace rs2 {
                     return result;
                 }
 
+                // Runs the job on the worker pool, or right away when no pool was set
                 template <typename F> void start_worker(const F& f)
                 {
-                    _worker = std::thread(f);
-                }
-
-                template <typename F> void add_sub_worker(const F& f)
-                {
-                    _subWorkers.emplace_back(f);
-                }
+                    F job(f);
+                    if (!_pool) {
+                        job();
+                        return;
+                    }
 
-                void wait_sub_workers()
-                {
-                    for_each(_subWorkers.begin(), _subWorkers.end(),
-                        [] (std::thread& t) {
-                            t.join();
-                        });
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        ++_pending;
+                    }
 
-                    _subWorkers.clear();
+                    _pool->post([this, job]() mutable {
+                        try {
+                            job();
+                        }
+                        catch (const std::exception& e) {
+                            std::cerr << name() << ": " << e.what() << std::endl;
+                        }
+
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        if (--_pending == 0) {
+                            _idle.notify_all();
+                        }
+                    });
                 }
 
             public:
                 virtual void convert(rs2::frame& frame) = 0;
                 virtual std::string name() const = 0;
 
+                void set_worker_pool(std::shared_ptr<worker_pool> pool)
+                {
+                    _pool = pool;
+                }
+
                 virtual std::string get_statistics()
                 {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
                     std::stringstream result;
                     result << name() << '\n';
 
@@ -104,9 +188,11 @@ namespace rs2 {
                     return (result.str());
                 }
 
+                // Blocks until all the jobs this converter started are done
                 void wait()
                 {
-                    _worker.join();
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _idle.wait(lock, [this] { return _pending == 0; });
                 }
             };
 
@@ -84,7 +84,7 @@ namespace rs2 {
                     }
 
                     start_worker(
-                        [this, &frame] {
+                        [this, frame] {
                             rs2::depth_frame depthframe = frame.as<rs2::depth_frame>();
 
                             std::stringstream filename;
@@ -102,28 +102,23 @@ namespace rs2 {
                             std::string filenameS = filename.str();
                             std::string metadataS = metadata_file.str();
 
-                            add_sub_worker(
-                                [filenameS, metadataS, depthframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
+                            std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
 
-                                    if (fs) {
-                                        uint8_t buffer[4];
+                            if (fs) {
+                                uint8_t buffer[4];
 
-                                        for (int y = 0; y < depthframe.get_height(); y++) {
-                                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                                fs.write(
-                                                    static_cast<const char *>(to_ieee754_32(depthframe.get_distance(x, y), buffer))
-                                                    , sizeof buffer);
-                                            }
-                                        }
-
-                                        fs.flush();
+                                for (int y = 0; y < depthframe.get_height(); y++) {
+                                    for (int x = 0; x < depthframe.get_width(); x++) {
+                                        fs.write(
+                                            static_cast<const char *>(to_ieee754_32(depthframe.get_distance(x, y), buffer))
+                                            , sizeof buffer);
                                     }
+                                }
 
-                                    metadata_to_txtfile(depthframe, metadataS);
-                            });
+                                fs.flush();
+                            }
 
-                            wait_sub_workers();
+                            metadata_to_txtfile(depthframe, metadataS);
                     });
                 }
             };
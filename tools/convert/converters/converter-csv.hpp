@@ -44,7 +44,7 @@ namespace rs2 {
                     }
 
                     start_worker(
-                        [this, &frame] {
+                        [this, frame] {
                             auto depthframe = frame.as<rs2::depth_frame>();
 
                             std::stringstream filename;
@@ -62,29 +62,24 @@ namespace rs2 {
                             std::string filenameS = filename.str();
                             std::string metadataS = metadata_file.str();
 
-                            add_sub_worker(
-                                [filenameS, metadataS, depthframe] {
-                                    std::ofstream fs(filenameS, std::ios::trunc);
+                            std::ofstream fs(filenameS, std::ios::trunc);
 
-                                    if (fs) {
-                                        for (int y = 0; y < depthframe.get_height(); y++) {
-                                            auto delim = "";
+                            if (fs) {
+                                for (int y = 0; y < depthframe.get_height(); y++) {
+                                    auto delim = "";
 
-                                            for (int x = 0; x < depthframe.get_width(); x++) {
-                                                fs << delim << depthframe.get_distance(x, y);
-                                                delim = ",";
-                                            }
-
-                                            fs << '\n';
-                                        }
-
-                                        fs.flush();
+                                    for (int x = 0; x < depthframe.get_width(); x++) {
+                                        fs << delim << depthframe.get_distance(x, y);
+                                        delim = ",";
                                     }
 
-                                    metadata_to_txtfile(depthframe, metadataS);
-                            });
+                                    fs << '\n';
+                                }
+
+                                fs.flush();
+                            }
 
-                            wait_sub_workers();
+                            metadata_to_txtfile(depthframe, metadataS);
                     });
                 }
             };
@@ -31,7 +31,7 @@ namespace rs2 {
                 {
                     rs2::pointcloud pc;
                     start_worker(
-                        [this, &frame, pc]() mutable {
+                        [this, frame, pc]() mutable {
                             auto frameset = frame.as<rs2::frameset>();
                             auto frameDepth = frameset.get_depth_frame();
                             auto frameColor = frameset.get_color_frame();
@@ -20,6 +20,7 @@ namespace rs2 {
                 rs2_stream _streamType;
                 std::string _filePath;
                 rs2::colorizer _colorizer;
+                std::mutex _colorizerMutex;
 
             public:
                 converter_png(const std::string& filePath, rs2_stream streamType = rs2_stream::RS2_STREAM_ANY)
@@ -45,10 +46,11 @@ namespace rs2 {
                     }
 
                     start_worker(
-                        [this, &frame] {
+                        [this, frame] {
                             rs2::video_frame videoframe = frame.as<rs2::video_frame>();
 
                             if (videoframe.get_profile().stream_type() == rs2_stream::RS2_STREAM_DEPTH) {
+                                std::lock_guard<std::mutex> lock(_colorizerMutex);
                                 videoframe = _colorizer.process(videoframe);
                             }
 
@@ -67,21 +69,16 @@ namespace rs2 {
                             std::string filenameS = filename.str();
                             std::string metadataS = metadata_file.str();
 
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    stbi_write_png(
-                                        filenameS.c_str()
-                                        , videoframe.get_width()
-                                        , videoframe.get_height()
-                                        , videoframe.get_bytes_per_pixel()
-                                        , videoframe.get_data()
-                                        , videoframe.get_stride_in_bytes()
-                                    );
-
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
+                            stbi_write_png(
+                                filenameS.c_str()
+                                , videoframe.get_width()
+                                , videoframe.get_height()
+                                , videoframe.get_bytes_per_pixel()
+                                , videoframe.get_data()
+                                , videoframe.get_stride_in_bytes()
+                            );
+
+                            metadata_to_txtfile(videoframe, metadataS);
                     });
                 }
             };
@@ -43,7 +43,7 @@ namespace rs2 {
                     }
 
                     start_worker(
-                        [this, &frame] {
+                        [this, frame] {
                             rs2::video_frame videoframe = frame.as<rs2::video_frame>();
 
                             std::stringstream filename;
@@ -61,22 +61,17 @@ namespace rs2 {
                             std::string filenameS = filename.str();
                             std::string metadataS = metadata_file.str();
 
-                            add_sub_worker(
-                                [filenameS, metadataS, videoframe] {
-                                    std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
+                            std::ofstream fs(filenameS, std::ios::binary | std::ios::trunc);
 
-                                    if (fs) {
-                                        fs.write(
-                                            static_cast<const char *>(videoframe.get_data())
-                                            , videoframe.get_stride_in_bytes() * videoframe.get_height());
+                            if (fs) {
+                                fs.write(
+                                    static_cast<const char *>(videoframe.get_data())
+                                    , videoframe.get_stride_in_bytes() * videoframe.get_height());
 
-                                        fs.flush();
-                                    }
+                                fs.flush();
+                            }
 
-                                    metadata_to_txtfile(videoframe, metadataS);
-                            });
-
-                            wait_sub_workers();
+                            metadata_to_txtfile(videoframe, metadataS);
                     });
                 }
             };
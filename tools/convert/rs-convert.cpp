@@ -14,12 +14,55 @@
 #include "converters/converter-bin.hpp"
 
 #include <mutex>
+#include <atomic>
+#include <chrono>
 
 
 using namespace std;
 using namespace TCLAP;
 
 
+// Part of the file to convert, as playback positions in nanoseconds
+struct play_range
+{
+    uint64_t begin;
+    uint64_t end;
+
+    int percent(uint64_t position) const
+    {
+        if (end <= begin || position <= begin) {
+            return 0;
+        }
+        return static_cast<int>((position - begin) * 100. / (end - begin));
+    }
+};
+
+static uint64_t to_position(double seconds)
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::duration<double>(seconds)).count());
+}
+
+static play_range get_range(rs2::playback& playback, double startTime, double endTime)
+{
+    uint64_t duration = playback.get_duration().count();
+    play_range range{ min(to_position(startTime), duration), duration };
+    if (endTime > 0) {
+        range.end = min(to_position(endTime), duration);
+    }
+    return range;
+}
+
+// Seeks to the beginning of the requested range instead of decoding up to it.
+// Frames delivered before the seek completed are not converted
+static void seek_to_start(rs2::playback& playback, double startTime, std::atomic<bool>& inRange)
+{
+    if (startTime > 0) {
+        playback.seek(chrono::nanoseconds(to_position(startTime)));
+    }
+    inRange = true;
+}
+
+
 int main(int argc, char** argv) try
 {
     rs2::log_to_file(RS2_LOG_SEVERITY_WARN);
@@ -34,6 +77,10 @@ int main(int argc, char** argv) try
     ValueArg<string> outputFilenameBin("b", "output-bin", "output BIN (depth matrix) file(s) path", false, "", "bin-path");
     SwitchArg switchDepth("d", "depth", "convert depth frames (default - all supported)", false);
     SwitchArg switchColor("c", "color", "convert color frames (default - all supported)", false);
+    ValueArg<double> startTime("s", "start", "convert frames starting at this position, in seconds", false, 0, "seconds");
+    ValueArg<double> endTime("e", "end", "convert frames up to this position, in seconds (default - end of file)", false, 0, "seconds");
+    ValueArg<int> threadCount("t", "threads", "number of conversion threads", false,
+        static_cast<int>(std::max(1u, std::min(thread::hardware_concurrency(), 8u))), "threads");
 
     cmd.add(inputFilename);
     cmd.add(outputFilenamePng);
@@ -43,8 +90,19 @@ int main(int argc, char** argv) try
     cmd.add(outputFilenameBin);
     cmd.add(switchDepth);
     cmd.add(switchColor);
+    cmd.add(startTime);
+    cmd.add(endTime);
+    cmd.add(threadCount);
     cmd.parse(argc, argv);
 
+    if (endTime.isSet() && endTime.getValue() <= startTime.getValue()) {
+        throw runtime_error("end time must be later than start time");
+    }
+
+    // The pool holds one job per thread in its backlog, so the frames in flight stay
+    // well below the playback frame queue. Raise RS2_OPTION_FRAMES_QUEUE_SIZE along with -t
+    auto pool = make_shared<rs2::tools::converter::worker_pool>(max(threadCount.getValue(), 1));
+
     vector<shared_ptr<rs2::tools::converter::converter_base>> converters;
     shared_ptr<rs2::tools::converter::converter_ply> plyconverter;
 
@@ -83,6 +141,11 @@ int main(int argc, char** argv) try
         throw runtime_error("output not defined");
     }
 
+    for_each(converters.begin(), converters.end(),
+        [&pool](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+        converter->set_worker_pool(pool);
+    });
+
 
     //in order to convert frames into ply we need synced depth and color frames, 
     //therefore we use pipeline
@@ -96,6 +159,7 @@ int main(int argc, char** argv) try
 
         plyconverter = make_shared<rs2::tools::converter::converter_ply>(
             outputFilenamePly.getValue());
+        plyconverter->set_worker_pool(pool);
 
         rs2::config cfg;
         cfg.enable_device_from_file(inputFilename.getValue());
@@ -105,7 +169,10 @@ int main(int argc, char** argv) try
         rs2::playback playback = device.as<rs2::playback>();
         playback.set_real_time(false);
 
-        auto duration = playback.get_duration();
+        std::atomic<bool> inRange(false);
+        seek_to_start(playback, startTime.getValue(), inRange);
+
+        auto range = get_range(playback, startTime.getValue(), endTime.getValue());
         int progress = 0;
         auto frameNumber = 0ULL;
 
@@ -114,7 +181,7 @@ int main(int argc, char** argv) try
 
         while (pipe->try_wait_for_frames(&frameset, 1000))
         {
-            int posP = static_cast<int>(posLast * 100. / duration.count());
+            int posP = range.percent(posLast);
 
             if (posP > progress) {
                 progress = posP;
@@ -123,14 +190,15 @@ int main(int argc, char** argv) try
 
             frameNumber = frameset[0].get_frame_number();
             plyconverter->convert(frameset);
-            plyconverter->wait();
 
             const uint64_t posCurr = playback.get_position();
-            if (static_cast<int64_t>(posCurr - posLast) < 0) {
+            if (static_cast<int64_t>(posCurr - posLast) < 0 || posCurr >= range.end) {
                 break;
             }
             posLast = posCurr;
         }
+
+        plyconverter->wait();
     }
 
     // for every converter other than ply,
@@ -142,10 +210,10 @@ int main(int argc, char** argv) try
         playback.set_real_time(false);
         std::vector<rs2::sensor> sensors = playback.query_sensors();
         std::mutex mutex;
+        std::atomic<bool> inRange(false);
 
-        auto duration = playback.get_duration();
+        auto range = get_range(playback, startTime.getValue(), endTime.getValue());
         int progress = 0;
-        uint64_t posLast = playback.get_position();
 
         for (auto sensor : sensors) {
             if (!sensor.get_stream_profiles().size())
@@ -156,27 +224,29 @@ int main(int argc, char** argv) try
             sensor.open(sensor.get_stream_profiles());
             sensor.start([&](rs2::frame frame)
             {
+                if (!inRange) {
+                    return;
+                }
+
                 std::lock_guard<std::mutex> lock(mutex);
                 for_each(converters.begin(), converters.end(),
                     [&frame](shared_ptr<rs2::tools::converter::converter_base>& converter) {
                     converter->convert(frame);
                 });
-
-                for_each(converters.begin(), converters.end(),
-                    [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
-                    converter->wait();
-                });
             });
 
         }
 
+        seek_to_start(playback, startTime.getValue(), inRange);
+        uint64_t posLast = playback.get_position();
+
         //we need to clear the output of ply progress ("100%") before writing
         //the progress of the other converters in the same line
         cout << "\r    \r";
 
         while (true)
         {
-            int posP = static_cast<int>(posLast * 100. / duration.count());
+            int posP = range.percent(posLast);
 
             if (posP > progress) {
                 progress = posP;
@@ -184,12 +254,13 @@ int main(int argc, char** argv) try
             }
 
             const uint64_t posCurr = playback.get_position();
-            if (static_cast<int64_t>(posCurr - posLast) < 0) {
+            if (static_cast<int64_t>(posCurr - posLast) < 0 || posCurr >= range.end) {
                 break;
             }
             posLast = posCurr;
         }
 
+        inRange = false;
         for (auto sensor : sensors) {
             if (!sensor.get_stream_profiles().size())
             {
@@ -198,6 +269,11 @@ int main(int argc, char** argv) try
             sensor.stop();
             sensor.close();
         }
+
+        for_each(converters.begin(), converters.end(),
+            [](shared_ptr<rs2::tools::converter::converter_base>& converter) {
+            converter->wait();
+        });
     }
 
     cout << endl;
@@ -97,21 +97,91 @@ void data_collector::parse_and_configure(ValueArg<string>& config_file)
     }
 }
 
+void data_collector::start_writer(const string& out_filename, bool binary)
+{
+    _binary = binary;
+    if (_binary)
+    {
+        _binary_file.open(out_filename, std::ios::binary | std::ios::trunc);
+        if (!_binary_file.is_open())
+            throw runtime_error(stringify() << "Cannot open the requested output file " << out_filename << ", please check permissions");
+
+        const uint32_t header[] = { 0x43445352 /* "RSDC" */, BINARY_FORMAT_VERSION, uint32_t(sizeof(binary_record)) };
+        _binary_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    // The writer wakes up periodically instead of being signalled, so the capture path never touches a lock
+    _writing = true;
+    _writer = std::thread([this]()
+    {
+        while (_writing)
+        {
+            drain_capture_buffers();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+}
+
+void data_collector::drain_capture_buffers()
+{
+    for (auto&& kv : capture_buffers)
+    {
+        if (_binary)
+        {
+            kv.second->drain([this](const frame_record& rec)
+            {
+                binary_record out{ uint32_t(rec._stream_type), rec._stream_idx, rec._frame_number,
+                    rec._ts, rec._arrival_time, uint32_t(rec._domain), uint32_t(rec.specific_attributes()), {} };
+                std::copy(rec._params.begin(), rec._params.end(), out.params);
+                _binary_file.write(reinterpret_cast<const char*>(&out), sizeof(out));
+                _records_written++;
+            });
+        }
+        else
+        {
+            auto& records = data_collection[kv.first];
+            kv.second->drain([&records](const frame_record& rec) { records.push_back(rec); });
+        }
+    }
+}
+
 void data_collector::save_data_to_file(const string& out_filename)
 {
-    if (!data_collection.size())
-        throw runtime_error(stringify() << "No data collected, aborting");
+    if (_writer.joinable())
+    {
+        _writing = false;
+        _writer.join();
+    }
+    drain_capture_buffers();
 
     // Report amount of frames collected
     std::vector<uint64_t> frames_per_stream;
-    for (const auto& kv : data_collection)
-        frames_per_stream.emplace_back(kv.second.size());
+    uint64_t dropped = 0;
+    for (const auto& kv : capture_buffers)
+    {
+        if (kv.second->pushed())
+            frames_per_stream.emplace_back(kv.second->pushed());
+        dropped += kv.second->dropped();
+    }
+
+    if (!frames_per_stream.size())
+        throw runtime_error(stringify() << "No data collected, aborting");
 
     std::sort(frames_per_stream.begin(), frames_per_stream.end());
     std::cout << "\nData collection accomplished with ["
         << frames_per_stream.front() << "-" << frames_per_stream.back()
-        << "] frames recorded per stream\nSerializing captured results to "
-        << out_filename << std::endl;
+        << "] frames recorded per stream";
+    if (dropped)
+        std::cout << ", " << dropped << " frames discarded while the capture buffers were full";
+
+    if (_binary)
+    {
+        _binary_file.close();
+        std::cout << "\n" << _records_written << " records written to " << out_filename << std::endl;
+        return;
+    }
+
+    std::cout << "\nSerializing captured results to " << out_filename << std::endl;
 
     // Serialize and store data into csv-like format
     ofstream csv(out_filename);
@@ -124,6 +194,9 @@ void data_collector::save_data_to_file(const string& out_filename)
 
     for (const auto& elem : data_collection)
     {
+        if (!elem.second.size())
+            continue;
+
         csv << "\n\nStream Type,Index,F#,HW Timestamp (ms),Host Timestamp(ms)"
             << (val_in_range(elem.first.first, { RS2_STREAM_GYRO,RS2_STREAM_ACCEL }) ? ",3DOF_x,3DOF_y,3DOF_z" : "")
             << (val_in_range(elem.first.first, { RS2_STREAM_POSE }) ? ",t_x,t_y,t_z,r_x,r_y,r_z,r_w" : "")
@@ -138,8 +211,11 @@ void data_collector::collect_frame_attributes(rs2::frame f, std::chrono::time_po
 {
     auto arrival_time = std::chrono::duration<double, std::milli>(chrono::high_resolution_clock::now() - start_time);
     auto stream_uid = std::make_pair(f.get_profile().stream_type(), f.get_profile().stream_index());
+    auto buffer = capture_buffers.find(stream_uid);
+    if (buffer == capture_buffers.end())
+        return;
 
-    if (data_collection[stream_uid].size() < _max_frames)
+    if (buffer->second->pushed() < _max_frames)
     {
         frame_record rec{ f.get_frame_number(),
             f.get_timestamp(),
@@ -162,7 +238,7 @@ void data_collector::collect_frame_attributes(rs2::frame f, std::chrono::time_po
                     pose.rotation.x,pose.rotation.y,pose.rotation.z,pose.rotation.w };
         }
 
-        data_collection[stream_uid].emplace_back(rec);
+        buffer->second->push(rec);
     }
 }
 
@@ -179,11 +255,16 @@ bool data_collector::collecting(std::chrono::time_point<std::chrono::high_resolu
     }
 
     bool collected_enough_frames = true;
+    bool any_frames = false;
+    for (auto&& kv : capture_buffers)
+        any_frames |= kv.second->pushed() > 0;
+
     for (auto&& profile : selected_stream_profiles)
     {
         auto key = std::make_pair(profile.stream_type(), profile.stream_index());
-        if (!data_collection.size() || (data_collection.find(key) != data_collection.end() &&
-            (data_collection[key].size() && data_collection[key].size() < _max_frames)))
+        auto buffer = capture_buffers.find(key);
+        auto frames = buffer != capture_buffers.end() ? buffer->second->pushed() : 0;
+        if (!any_frames || (frames && frames < _max_frames))
         {
             collected_enough_frames = false;
             break;
@@ -270,6 +351,9 @@ bool data_collector::configure_sensors()
         if (matches.size())
         {
             std::copy(matches.begin(), matches.end(), std::back_inserter(selected_stream_profiles));
+            for (auto&& profile : matches)
+                capture_buffers[std::make_pair(profile.stream_type(), profile.stream_index())] =
+                    std::make_shared<capture_buffer<frame_record>>(CAPTURE_BUFFER_RECORDS);
             sensor.open(matches);
             active_sensors.emplace_back(sensor);
             matches.clear();
@@ -291,11 +375,13 @@ int main(int argc, char** argv) try
     ValueArg<int>    max_frames("m", "MaxFrames_Number", "Maximum number of frames-per-stream to receive", false, 100, "");
     ValueArg<string> out_file("f", "FullFilePath", "the file where the data will be saved to", false, "", "");
     ValueArg<string> config_file("c", "ConfigurationFile", "Specify file path with the requested configuration", false, "", "");
+    SwitchArg        binary_out("b", "BinaryOutput", "Stream the records to a binary file while collecting, instead of CSV at the end", false);
 
     cmd.add(timeout);
     cmd.add(max_frames);
     cmd.add(out_file);
     cmd.add(config_file);
+    cmd.add(binary_out);
     cmd.parse(argc, argv);
 
     std::cout << "Running rs-data-collect: ";
@@ -332,7 +418,8 @@ int main(int argc, char** argv) try
 
         dc.parse_and_configure(config_file);
 
-        //data_collection buffer;
+        dc.start_writer(output_file, binary_out.getValue());
+
         auto start_time = chrono::high_resolution_clock::now();
 
         // Start streaming
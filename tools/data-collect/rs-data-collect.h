@@ -29,6 +29,11 @@ GYRO,1,1,200,MOTION_XYZ32F
 #include <fstream>
 #include <sstream>
 #include <map>
+#include <array>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
 
 
 using namespace std;
@@ -38,6 +43,8 @@ namespace rs_data_collect
 {
     const uint64_t  DEF_FRAMES_NUMBER = 100;
     const std::string DEF_OUTPUT_FILE_NAME("frames_data.csv");
+    const size_t    CAPTURE_BUFFER_RECORDS = 1 << 16;   // Per stream, several seconds of the fastest IMU/pose rates
+    const uint32_t  BINARY_FORMAT_VERSION = 1;
 
     // Split string into token,  trim unreadable characters
     inline std::vector<std::string> tokenize(std::string line, char separator)
@@ -167,6 +174,67 @@ namespace rs_data_collect
         e_stream_index
     };
 
+    // Single-producer/single-consumer ring buffer. The sensor callback pushes records without locks or allocations,
+    // the writer thread drains them. Records arriving while the ring is full are counted and discarded
+    template<class T>
+    class capture_buffer
+    {
+    public:
+        explicit capture_buffer(size_t capacity) : _records(capacity + 1), _head(0), _tail(0), _pushed(0), _dropped(0) {}
+
+        bool push(const T& rec)
+        {
+            auto head = _head.load(std::memory_order_relaxed);
+            auto next = (head + 1) % _records.size();
+            if (next == _tail.load(std::memory_order_acquire))
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _records[head] = rec;
+            _head.store(next, std::memory_order_release);
+            _pushed.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Hands the pending records to f in arrival order, returns their number
+        template<class F> size_t drain(F f)
+        {
+            auto tail = _tail.load(std::memory_order_relaxed);
+            auto head = _head.load(std::memory_order_acquire);
+            size_t count = 0;
+            for (; tail != head; tail = (tail + 1) % _records.size(), ++count)
+                f(_records[tail]);
+            _tail.store(tail, std::memory_order_release);
+            return count;
+        }
+
+        uint64_t pushed() const { return _pushed.load(std::memory_order_relaxed); }
+        uint64_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    private:
+        std::vector<T>          _records;
+        std::atomic<size_t>     _head;
+        std::atomic<size_t>     _tail;
+        std::atomic<uint64_t>   _pushed;
+        std::atomic<uint64_t>   _dropped;
+    };
+
+    // Record layout of the binary output, preceded by the "RSDC" tag, the format version and the record size (uint32 each)
+    struct binary_record
+    {
+        uint32_t    stream_type;
+        int32_t     stream_index;
+        uint64_t    frame_number;
+        double      hw_timestamp;       // msec
+        double      host_timestamp;     // msec, relative to start streaming
+        uint32_t    timestamp_domain;
+        uint32_t    params_count;       // Valid entries in params: 3 for IMU, 7 for pose (translation, rotation)
+        double      params[7];
+    };
+    static_assert(sizeof(binary_record) == 96, "binary_record must not be padded");
+
     enum application_stop : uint8_t {
         stop_on_frame_num,
         stop_on_timeout,
@@ -183,6 +251,7 @@ namespace rs_data_collect
         data_collector(const data_collector&);
 
         void parse_and_configure(ValueArg<string>& config_file);
+        void start_writer(const string& out_filename, bool binary);
         void save_data_to_file(const string& out_filename);
         void collect_frame_attributes(rs2::frame f, std::chrono::time_point<std::chrono::high_resolution_clock> start_time);
         bool collecting(std::chrono::time_point<std::chrono::high_resolution_clock> start_time);
@@ -191,6 +260,8 @@ namespace rs_data_collect
 
         struct frame_record
         {
+            frame_record() : frame_record(0, 0., 0., RS2_TIMESTAMP_DOMAIN_COUNT, RS2_STREAM_ANY, 0) {}
+
             frame_record(unsigned long long frame_number, double frame_ts, double host_ts,
                        rs2_timestamp_domain domain, rs2_stream stream_type,int stream_index,
                        double _p1=0., double _p2=0., double _p3=0.,
@@ -204,6 +275,16 @@ namespace rs_data_collect
             _params({_p1,_p2,_p3,_p4,_p5,_p6,_p7})
             {};
 
+            size_t specific_attributes() const
+            {
+                // IMU and Pose frame hold the sample data in addition to the frame's header attributes
+                if (val_in_range(_stream_type,{RS2_STREAM_GYRO,RS2_STREAM_ACCEL}))
+                    return 3;
+                if (val_in_range(_stream_type,{RS2_STREAM_POSE}))
+                    return 7;
+                return 0;
+            }
+
             std::string to_string() const
             {
                 std::stringstream ss;
@@ -212,14 +293,7 @@ namespace rs_data_collect
                     << _stream_idx << "," << _frame_number << ","
                     << std::fixed << std::setprecision(3) << _ts << "," << _arrival_time;
 
-                // IMU and Pose frame hold the sample data in addition to the frame's header attributes
-                size_t specific_attributes = 0;
-                if (val_in_range(_stream_type,{RS2_STREAM_GYRO,RS2_STREAM_ACCEL}))
-                    specific_attributes = 3;
-                if (val_in_range(_stream_type,{RS2_STREAM_POSE}))
-                    specific_attributes = 7;
-
-                for (auto i=0; i<specific_attributes; i++)
+                for (size_t i=0; i<specific_attributes(); i++)
                     ss << "," << _params[i];
 
                 return ss.str().c_str();
@@ -236,8 +310,18 @@ namespace rs_data_collect
 
     private:
 
+        typedef std::pair<rs2_stream, int> stream_key;
+
         std::shared_ptr<rs2::device>        _dev;
-        std::map<std::pair<rs2_stream, int>, std::vector<frame_record>> data_collection;
+        // Filled from the sensor callbacks, the map itself is only modified before streaming starts
+        std::map<stream_key, std::shared_ptr<capture_buffer<frame_record>>> capture_buffers;
+        // Drained records kept for the CSV output, which is grouped per stream
+        std::map<stream_key, std::vector<frame_record>> data_collection;
+        std::thread                         _writer;
+        std::atomic<bool>                   _writing{ false };
+        bool                                _binary = false;
+        std::ofstream                       _binary_file;
+        uint64_t                            _records_written = 0;
         std::vector<stream_request>         requests_to_go, user_requests;
         std::vector<rs2::sensor>            active_sensors;
         std::vector<rs2::stream_profile>    selected_stream_profiles;
@@ -250,5 +334,8 @@ namespace rs_data_collect
 
         // Assign the user configuration to the selected device
         bool configure_sensors();
+
+        // Moves the captured records out of the capture buffers, into the binary file or data_collection
+        void drain_capture_buffers();
     };
 }
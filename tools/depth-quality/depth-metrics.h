@@ -7,6 +7,8 @@
 #include <vector>
 #include <mutex>
 #include <array>
+#include <thread>
+#include <algorithm>
 #include <imgui.h>
 #include <librealsense2/rsutil.h>
 #include <librealsense2/rs.hpp>
@@ -54,32 +56,144 @@ namespace rs2
             bool record,
             std::vector<single_metric_data>& samples)>;
 
+        // The depth quality metrics of one frame, see the readme for the algorithms
+        struct depth_metrics
+        {
+            float fill_rate = 0;                // % of valid pixels in the ROI
+            bool plane_fit = false;             // The metrics below are calculated only with a plane fit
+            bool has_z_accuracy = false;        // Requires the ground truth
+            float z_accuracy = 0;               // % of the ground truth
+            float plane_fit_rms_mm = 0;
+            float plane_fit_rms = 0;            // % of the distance
+            float subpixel_rms = 0;             // pixels
+        };
+
+        inline depth_metrics calculate_metrics(
+            const std::vector<rs2::float3>& points,
+            const plane p,
+            const rs2::region_of_interest roi,
+            const float baseline_mm,
+            const float focal_length_pixels,
+            const int ground_truth_mm,
+            const bool plane_fit,
+            const float plane_fit_to_ground_truth_mm,
+            const float distance_mm,
+            const float depth_units)
+        {
+            static const float TO_MM = 1000.f;
+            static const float TO_PERCENT = 100.f;
+
+            depth_metrics result;
+
+            // Calculate fill rate relative to the ROI
+            result.fill_rate = points.size() / float((roi.max_x - roi.min_x)*(roi.max_y - roi.min_y)) * TO_PERCENT;
+
+            if (!plane_fit) return result;
+            result.plane_fit = true;
+
+            const float bf_factor = baseline_mm * focal_length_pixels * depth_units; // also convert point units from mm to meter
+
+            std::vector<rs2::float3> points_set = points;
+            std::vector<float> gt_errors;
+            double total_sq_disparity_diff = 0;
+            double plane_fit_err_sqr_sum = 0;
+
+            // Remove outliers [below 0.5% and above 99.5%), only the partition matters so there is no need to sort
+            auto by_z = [](const rs2::float3& a, const rs2::float3& b) { return a.z < b.z; };
+            size_t outliers = points_set.size() / 200;
+            std::nth_element(points_set.begin(), points_set.begin() + outliers, points_set.end(), by_z);
+            std::nth_element(points_set.begin() + outliers, points_set.end() - outliers, points_set.end(), by_z);
+            points_set.erase(points_set.end() - outliers, points_set.end()); // crop max 0.5% of the dataset
+            points_set.erase(points_set.begin(), points_set.begin() + outliers); // crop min 0.5% of the dataset
+
+            if (ground_truth_mm) gt_errors.reserve(points_set.size());
+
+            // Convert Z values into Depth values by aligning the Fitted plane with the Ground Truth (GT) plane
+            // Calculate distance and disparity of Z values to the fitted plane.
+            // Use the rotated plane fit to calculate GT errors
+            for (auto& point : points_set)
+            {
+                // Find distance from point to the reconstructed plane
+                auto dist2plane = p.a*point.x + p.b*point.y + p.c*point.z + p.d;
+                // Project the point to plane in 3D and find distance to the intersection point
+                rs2::float3 plane_intersect = { float(point.x - dist2plane*p.a),
+                                                float(point.y - dist2plane*p.b),
+                                                float(point.z - dist2plane*p.c) };
+
+                // Accumulate distance, disparity and store gt- error
+                double distance = dist2plane * TO_MM;
+                double disparity = bf_factor / point.length() - bf_factor / plane_intersect.length();
+                plane_fit_err_sqr_sum += distance * distance;
+                total_sq_disparity_diff += disparity * disparity;
+                // The negative dist2plane represents a point closer to the camera than the fitted plane
+                if (ground_truth_mm) gt_errors.push_back(plane_fit_to_ground_truth_mm + (dist2plane * TO_MM));
+            }
+
+            // Z accuracy metric only when Ground Truth is available
+            if (ground_truth_mm && gt_errors.size())
+            {
+                std::nth_element(begin(gt_errors), begin(gt_errors) + gt_errors.size() / 2, end(gt_errors));
+                auto gt_median = gt_errors[gt_errors.size() / 2];
+                result.has_z_accuracy = true;
+                result.z_accuracy = TO_PERCENT * (gt_median / ground_truth_mm);
+            }
+
+            // Calculate Sub-pixel RMS for Stereo-based Depth sensors
+            result.subpixel_rms = static_cast<float>(std::sqrt(total_sq_disparity_diff / points_set.size()));
+
+            // Calculate Plane Fit RMS  (Spatial Noise) mm
+            result.plane_fit_rms_mm = static_cast<float>(std::sqrt(plane_fit_err_sqr_sum / points_set.size()));
+            result.plane_fit_rms = TO_PERCENT * (result.plane_fit_rms_mm / distance_mm);
+
+            return result;
+        }
+
         inline plane plane_from_point_and_normal(const rs2::float3& point, const rs2::float3& normal)
         {
             return{ normal.x, normal.y, normal.z, -(normal.x*point.x + normal.y*point.y + normal.z*point.z) };
         }
 
-        //Based on: http://www.ilikebigbits.com/blog/2015/3/2/plane-from-points
-        inline plane plane_from_points(const std::vector<rs2::float3> points)
+        // Running sums of the points and their products, enough to fit a plane without revisiting the points.
+        // Partial sums gathered on separate threads are combined with merge()
+        struct plane_fit_accumulator
         {
-            if (points.size() < 3) throw std::runtime_error("Not enough points to calculate plane");
-
-            rs2::float3 sum = { 0,0,0 };
-            for (auto point : points) sum = sum + point;
+            double n = 0, x = 0, y = 0, z = 0;
+            double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
 
-            rs2::float3 centroid = sum / float(points.size());
+            void add(const rs2::float3& p)
+            {
+                n++;
+                x += p.x; y += p.y; z += p.z;
+                xx += double(p.x) * p.x; xy += double(p.x) * p.y; xz += double(p.x) * p.z;
+                yy += double(p.y) * p.y; yz += double(p.y) * p.z; zz += double(p.z) * p.z;
+            }
 
-            double xx = 0, xy = 0, xz = 0, yy = 0, yz = 0, zz = 0;
-            for (auto point : points) {
-                rs2::float3 temp = point - centroid;
-                xx += temp.x * temp.x;
-                xy += temp.x * temp.y;
-                xz += temp.x * temp.z;
-                yy += temp.y * temp.y;
-                yz += temp.y * temp.z;
-                zz += temp.z * temp.z;
+            void merge(const plane_fit_accumulator& o)
+            {
+                n += o.n;
+                x += o.x; y += o.y; z += o.z;
+                xx += o.xx; xy += o.xy; xz += o.xz;
+                yy += o.yy; yz += o.yz; zz += o.zz;
             }
 
+            plane fit() const;
+        };
+
+        //Based on: http://www.ilikebigbits.com/blog/2015/3/2/plane-from-points
+        inline plane plane_fit_accumulator::fit() const
+        {
+            if (n < 3) throw std::runtime_error("Not enough points to calculate plane");
+
+            rs2::float3 centroid = { float(x / n), float(y / n), float(z / n) };
+
+            // Covariance of the points around the centroid
+            double xx = this->xx - x * x / n;
+            double xy = this->xy - x * y / n;
+            double xz = this->xz - x * z / n;
+            double yy = this->yy - y * y / n;
+            double yz = this->yz - y * z / n;
+            double zz = this->zz - z * z / n;
+
             double det_x = yy*zz - yz*yz;
             double det_y = xx*zz - xz*xz;
             double det_z = xx*yy - xy*xy;
@@ -110,6 +224,13 @@ namespace rs2
             return plane_from_point_and_normal(centroid, dir.normalize());
         }
 
+        inline plane plane_from_points(const std::vector<rs2::float3>& points)
+        {
+            plane_fit_accumulator acc;
+            for (auto&& point : points) acc.add(point);
+            return acc.fit();
+        }
+
         inline double evaluate_pixel(const plane& p, const rs2_intrinsics* intrin, float x, float y, float distance, float3& output)
         {
             float pixel[2] = { x, y };
@@ -153,35 +274,81 @@ namespace rs2
 
             snapshot_metrics result{ w, h, roi, {} };
 
-            std::mutex m;
-
-            std::vector<rs2::float3> roi_pixels;
+            // Without undistortion the deprojection is separable: x depends on the column only, y on the row only
+            const bool separable = intrin->model != RS2_DISTORTION_INVERSE_BROWN_CONRADY &&
+                intrin->model != RS2_DISTORTION_KANNALA_BRANDT4 && intrin->model != RS2_DISTORTION_FTHETA;
+            std::vector<float> col_factor(std::max(roi.max_x - roi.min_x, 0));
+            for (int x = roi.min_x; x < roi.max_x; ++x)
+                col_factor[x - roi.min_x] = (x - intrin->ppx) / intrin->fx;
+
+            // The ROI rows are split between threads, each deprojecting into its own points and sums
+            const int rows = std::max(roi.max_y - roi.min_y, 0);
+            const int min_rows_per_worker = 64;
+            const int workers = std::max(1, std::min<int>(std::thread::hardware_concurrency(), rows / min_rows_per_worker));
+            std::vector<std::vector<rs2::float3>> worker_points(workers);
+            std::vector<plane_fit_accumulator> worker_sums(workers);
+
+            auto deproject_rows = [&](int worker)
+            {
+                const int first = roi.min_y + rows * worker / workers;
+                const int last = roi.min_y + rows * (worker + 1) / workers;
+                auto& points = worker_points[worker];
+                auto& sums = worker_sums[worker];
+                points.reserve(size_t(last - first) * col_factor.size());
 
-//#pragma omp parallel for - TODO optimization envisaged
-            for (int y = roi.min_y; y < roi.max_y; ++y)
-                for (int x = roi.min_x; x < roi.max_x; ++x)
+                for (int y = first; y < last; ++y)
                 {
-                    auto depth_raw = pixels[y*w + x];
-
-                    if (depth_raw)
+                    const float row_factor = (y - intrin->ppy) / intrin->fy;
+                    const uint16_t* row = pixels + y * w;
+                    for (int x = roi.min_x; x < roi.max_x; ++x)
                     {
+                        auto depth_raw = row[x];
+                        if (!depth_raw) continue;
+
                         // units is float
-                        float pixel[2] = { float(x), float(y) };
-                        float point[3];
                         auto distance = depth_raw * units;
-
-                        rs2_deproject_pixel_to_point(point, intrin, pixel, distance);
-
-                        std::lock_guard<std::mutex> lock(m);
-                        roi_pixels.push_back({ point[0], point[1], point[2] });
+                        rs2::float3 point;
+                        if (separable)
+                        {
+                            point = { col_factor[x - roi.min_x] * distance, row_factor * distance, distance };
+                        }
+                        else
+                        {
+                            float pixel[2] = { float(x), float(y) };
+                            rs2_deproject_pixel_to_point(&point.x, intrin, pixel, distance);
+                        }
+
+                        points.push_back(point);
+                        sums.add(point);
                     }
                 }
+            };
+
+            std::vector<std::thread> threads;
+            for (int i = 1; i < workers; ++i)
+                threads.emplace_back(deproject_rows, i);
+            deproject_rows(0);
+            for (auto&& t : threads)
+                t.join();
+
+            plane_fit_accumulator sums;
+            size_t total_points = 0;
+            for (int i = 0; i < workers; ++i)
+            {
+                sums.merge(worker_sums[i]);
+                total_points += worker_points[i].size();
+            }
 
-            if (roi_pixels.size() < 3) { // Not enough pixels in RoI to fit a plane
+            if (total_points < 3) { // Not enough pixels in RoI to fit a plane
                 return result;
             }
 
-            plane p = plane_from_points(roi_pixels);
+            std::vector<rs2::float3> roi_pixels = std::move(worker_points[0]);
+            roi_pixels.reserve(total_points);
+            for (int i = 1; i < workers; ++i)
+                roi_pixels.insert(roi_pixels.end(), worker_points[i].begin(), worker_points[i].end());
+
+            plane p = sums.fit();
 
             if (p == plane{ 0, 0, 0, 0 }) { // The points in RoI don't span a valid plane
                 return result;
@@ -0,0 +1,221 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+#include "depth-metrics.h"
+
+using namespace std;
+using namespace TCLAP;
+using namespace rs2::depth_quality;
+
+string json_string(const string& str)
+{
+    string res = "\"";
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\') res += '\\';
+        if (c >= 0 && c < ' ') continue;
+        res += c;
+    }
+    return res + "\"";
+}
+
+// Values of one metric over the analyzed frames
+struct metric_values
+{
+    vector<float> values;
+
+    void write_json(ostream& out) const
+    {
+        if (values.empty())
+        {
+            out << "null";
+            return;
+        }
+        auto sorted = values;
+        sort(sorted.begin(), sorted.end());
+        auto mean = accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+        out << fixed << setprecision(4)
+            << "{ \"frames\": " << sorted.size()
+            << ", \"mean\": " << mean
+            << ", \"median\": " << sorted[sorted.size() / 2]
+            << ", \"p95\": " << sorted[min(sorted.size() - 1, size_t(sorted.size() * 0.95))]
+            << ", \"min\": " << sorted.front()
+            << ", \"max\": " << sorted.back() << " }";
+    }
+};
+
+// Same as the depth quality tool, the distance between the left and the right imager
+float get_baseline_mm(const rs2::sensor& sensor)
+{
+    auto profiles = sensor.get_stream_profiles();
+    auto right = find_if(profiles.begin(), profiles.end(), [](rs2::stream_profile& p)
+    { return (p.stream_index() == 2) && (p.stream_type() == RS2_STREAM_INFRARED); });
+    auto depth = find_if(profiles.begin(), profiles.end(), [](rs2::stream_profile& p)
+    { return (p.stream_index() == 0) && (p.stream_type() == RS2_STREAM_DEPTH); });
+    if (right == profiles.end() || depth == profiles.end())
+        return -1.f;
+
+    try
+    {
+        return fabs(depth->get_extrinsics_to(*right).translation[0]) * 1000;
+    }
+    catch (...)
+    {
+        return -1.f;
+    }
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-depth-quality-headless tool, computes the depth quality metrics of a camera or a recording and writes JSON", ' ', RS2_API_VERSION_STR);
+    ValueArg<string> file("f", "file", "Recording to analyze, instead of the first connected camera", false, "", "string");
+    ValueArg<string> resolution("r", "resolution", "Depth resolution of the camera, WIDTHxHEIGHT, the default profile otherwise", false, "", "string");
+    ValueArg<int> fps("p", "fps", "Depth frame rate of the camera, the default profile otherwise", false, 0, "int");
+    ValueArg<int> frames("n", "frames", "Frames to analyze", false, 100, "int");
+    ValueArg<int> skip("s", "skip", "Frames skipped before the analyzed ones, while auto-exposure settles", false, 30, "int");
+    ValueArg<float> roi("i", "roi", "ROI size as a fraction of the frame width and height, centered", false, 0.4f, "float");
+    ValueArg<int> ground_truth("g", "ground-truth", "Distance to the target in mm, enables the Z accuracy metric", false, 0, "int");
+    ValueArg<string> output("o", "output", "JSON file to write, standard output by default", false, "", "string");
+    cmd.add(file);
+    cmd.add(resolution);
+    cmd.add(fps);
+    cmd.add(frames);
+    cmd.add(skip);
+    cmd.add(roi);
+    cmd.add(ground_truth);
+    cmd.add(output);
+    cmd.parse(argc, argv);
+
+    if (roi.getValue() <= 0.f || roi.getValue() > 1.f)
+        throw runtime_error("the ROI fraction must be in (0, 1]");
+
+    rs2::pipeline pipe;
+    rs2::config cfg;
+    int width = 0, height = 0;
+    if (resolution.isSet())
+    {
+        char x = 0;
+        stringstream ss(resolution.getValue());
+        if (!(ss >> width >> x >> height) || x != 'x' || width <= 0 || height <= 0)
+            throw runtime_error("invalid resolution " + resolution.getValue());
+    }
+    if (file.isSet())
+        cfg.enable_device_from_file(file.getValue(), false);
+    cfg.enable_stream(RS2_STREAM_DEPTH, 0, width, height, RS2_FORMAT_Z16, fps.getValue());
+
+    auto profile = pipe.start(cfg);
+    auto device = profile.get_device();
+    if (auto playback = device.as<rs2::playback>())
+        playback.set_real_time(false);
+
+    auto depth_sensor = device.first<rs2::depth_sensor>();
+    auto depth_profile = profile.get_stream(RS2_STREAM_DEPTH).as<rs2::video_stream_profile>();
+    auto intrin = depth_profile.get_intrinsics();
+    auto units = depth_sensor.get_depth_scale();
+    auto baseline_mm = get_baseline_mm(depth_sensor);
+    auto fraction = roi.getValue();
+    rs2::region_of_interest region = { int(intrin.width * (0.5f - 0.5f * fraction)),
+        int(intrin.height * (0.5f - 0.5f * fraction)),
+        int(intrin.width * (0.5f + 0.5f * fraction)),
+        int(intrin.height * (0.5f + 0.5f * fraction)) };
+
+    metric_values fill_rate, z_accuracy, plane_fit_rms, plane_fit_rms_mm, subpixel_rms, distance, angle;
+    auto callback = [&](const std::vector<rs2::float3>& points, const rs2::plane p, const rs2::region_of_interest roi,
+        const float baseline_mm, const float focal_length_pixels, const int ground_truth_mm, const bool plane_fit,
+        const float plane_fit_to_ground_truth_mm, const float distance_mm, bool record, std::vector<single_metric_data>& samples)
+    {
+        auto m = calculate_metrics(points, p, roi, baseline_mm, focal_length_pixels, ground_truth_mm, plane_fit,
+            plane_fit_to_ground_truth_mm, distance_mm, units);
+        fill_rate.values.push_back(m.fill_rate);
+        if (!m.plane_fit) return;
+        if (m.has_z_accuracy) z_accuracy.values.push_back(m.z_accuracy);
+        plane_fit_rms.values.push_back(m.plane_fit_rms);
+        plane_fit_rms_mm.values.push_back(m.plane_fit_rms_mm);
+        subpixel_rms.values.push_back(m.subpixel_rms);
+    };
+
+    int analyzed = 0, received = 0;
+    rs2::frameset fs;
+    std::vector<single_metric_data> samples;
+    while (analyzed < frames.getValue() && pipe.try_wait_for_frames(&fs, 5000))
+    {
+        if (received++ < skip.getValue() && !file.isSet())
+            continue;
+
+        auto depth = fs.get_depth_frame();
+        if (!depth)
+            continue;
+
+        auto result = analyze_depth_image(depth, units, baseline_mm, &intrin, region, ground_truth.getValue(), true,
+            samples, false, callback);
+        if (!(result.p == rs2::plane{ 0, 0, 0, 0 }))
+        {
+            distance.values.push_back(result.distance);
+            angle.values.push_back(result.angle);
+        }
+        analyzed++;
+    }
+    pipe.stop();
+
+    if (!analyzed)
+        throw runtime_error("no depth frames received");
+
+    auto write_json = [&](ostream& out)
+    {
+        out << "{\n";
+        out << "  \"librealsense\": " << json_string(RS2_API_VERSION_STR) << ",\n";
+        out << "  \"device\": " << json_string(device.supports(RS2_CAMERA_INFO_NAME) ? device.get_info(RS2_CAMERA_INFO_NAME) : "") << ",\n";
+        out << "  \"serial\": " << json_string(device.supports(RS2_CAMERA_INFO_SERIAL_NUMBER) ? device.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) : "") << ",\n";
+        out << "  \"source\": " << json_string(file.isSet() ? file.getValue() : "camera") << ",\n";
+        out << "  \"width\": " << intrin.width << ", \"height\": " << intrin.height << ", \"fps\": " << depth_profile.fps() << ",\n";
+        out << "  \"roi\": [" << region.min_x << ", " << region.min_y << ", " << region.max_x << ", " << region.max_y << "],\n";
+        out << "  \"ground_truth_mm\": " << ground_truth.getValue() << ",\n";
+        out << "  \"frames\": " << analyzed << ",\n";
+        out << "  \"metrics\": {\n";
+        out << "    \"fill_rate_percent\": "; fill_rate.write_json(out); out << ",\n";
+        out << "    \"z_accuracy_percent\": "; z_accuracy.write_json(out); out << ",\n";
+        out << "    \"plane_fit_rms_percent\": "; plane_fit_rms.write_json(out); out << ",\n";
+        out << "    \"plane_fit_rms_mm\": "; plane_fit_rms_mm.write_json(out); out << ",\n";
+        out << "    \"subpixel_rms_pixels\": "; subpixel_rms.write_json(out); out << ",\n";
+        out << "    \"distance_mm\": "; distance.write_json(out); out << ",\n";
+        out << "    \"angle_degrees\": "; angle.write_json(out); out << "\n";
+        out << "  }\n}\n";
+    };
+
+    if (output.isSet())
+    {
+        ofstream out(output.getValue());
+        if (!out)
+            throw runtime_error("cannot write " + output.getValue());
+        write_json(out);
+    }
+    else
+    {
+        write_json(cout);
+    }
+    return EXIT_SUCCESS;
+}
+catch (const rs2::error& e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
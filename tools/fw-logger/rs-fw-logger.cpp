@@ -99,17 +99,19 @@ int main(int argc, char* argv[])
                     should_loop_end = true;
                     break;
                 }
-                auto log_message = fw_log_device.create_message();
-                bool result = false;
+                std::vector<rs2::firmware_log_message> log_messages;
                 if (are_flash_logs_requested)
                 {
-                    result = fw_log_device.get_flash_log(log_message);
+                    auto log_message = fw_log_device.create_message();
+                    if (fw_log_device.get_flash_log(log_message))
+                        log_messages.push_back(log_message);
                 }
                 else
                 {
-                    result = fw_log_device.get_firmware_log(log_message);
+                    // The library polls the device in the background, waiting here doesn't hold the hw monitor
+                    log_messages = fw_log_device.get_firmware_logs(64, 100);
                 }
-                if (result)
+                for (auto&& log_message : log_messages)
                 {
                     std::vector<string> fw_log_lines;
                     if (using_parser)
@@ -138,7 +140,7 @@ int main(int argc, char* argv[])
                     for (auto& line : fw_log_lines)
                         cout << line << endl;
                 }
-                else
+                if (log_messages.empty())
                 {
                     if (are_flash_logs_requested)
                     {
@@ -0,0 +1,279 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <librealsense2/rs.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tclap/CmdLine.h"
+
+using namespace std;
+using namespace TCLAP;
+
+// The stages of the latency of a frame, from the start of the exposure to the user callback
+enum stage
+{
+    exposure,   // the exposure itself
+    readout,    // from the end of the exposure to the start of the transfer, on the device
+    transfer,   // from the start of the transfer to the frame completed by the kernel driver
+    queueing,   // from the kernel driver to the arrival in the library
+    processing, // from the arrival to the last processing block or the syncer
+    delivery,   // from the processing to the user callback
+    total,      // from the start of the exposure to the user callback
+    stage_count
+};
+
+static const char* stage_names[stage_count] = { "exposure", "readout", "transfer", "queueing", "processing", "delivery", "total" };
+
+static const double unknown = numeric_limits<double>::quiet_NaN();
+
+struct sample
+{
+    unsigned long long frame_number;
+    double stages[stage_count];
+};
+
+static double now_ms()
+{
+    return chrono::duration<double, milli>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static double metadata(const rs2::frame& f, rs2_frame_metadata_value value)
+{
+    return f.supports_frame_metadata(value) ? double(f.get_frame_metadata(value)) : unknown;
+}
+
+/*
+    All the times are in milliseconds of the host system clock: the time of arrival, the backend timestamp and the
+    frame trace are taken in it, the frame timestamp is mapped to it when the global time is enabled.
+    The device timestamps are placed on the host clock relative to the frame timestamp, which is the start of the transfer
+*/
+static sample measure(const rs2::frame& f, double callback_time)
+{
+    sample s;
+    s.frame_number = f.get_frame_number();
+    fill(begin(s.stages), end(s.stages), unknown);
+
+    auto exposure_us = metadata(f, RS2_FRAME_METADATA_ACTUAL_EXPOSURE);
+    auto sensor_us = metadata(f, RS2_FRAME_METADATA_SENSOR_TIMESTAMP);
+    auto frame_us = metadata(f, RS2_FRAME_METADATA_FRAME_TIMESTAMP);
+    auto backend = metadata(f, RS2_FRAME_METADATA_BACKEND_TIMESTAMP);
+    auto arrival = metadata(f, RS2_FRAME_METADATA_TIME_OF_ARRIVAL);
+
+    double processed = unknown;
+    for (auto&& stamp : f.get_trace())
+    {
+        // The dequeue stamp is the arrival, at a finer resolution than the metadata
+        if (stamp.stage == RS2_FRAME_TRACE_STAGE_BACKEND_DEQUEUE)
+            arrival = stamp.time;
+        if (stamp.stage == RS2_FRAME_TRACE_STAGE_BLOCK_END || stamp.stage == RS2_FRAME_TRACE_STAGE_SYNCER_EMIT)
+            processed = std::isnan(processed) ? stamp.time : max(processed, stamp.time);
+    }
+
+    double transfer_start = unknown;
+    if (f.get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_GLOBAL_TIME && !std::isnan(frame_us))
+        transfer_start = f.get_timestamp();
+
+    double exposure_start = unknown;
+    if (!std::isnan(exposure_us))
+    {
+        s.stages[exposure] = exposure_us / 1000.;
+        if (!std::isnan(sensor_us) && !std::isnan(frame_us))
+        {
+            // The sensor timestamp is the middle of the exposure
+            s.stages[readout] = (frame_us - sensor_us) / 1000. - s.stages[exposure] / 2;
+            exposure_start = transfer_start - s.stages[readout] - s.stages[exposure];
+        }
+    }
+
+    s.stages[transfer] = backend - transfer_start;
+    s.stages[queueing] = arrival - backend;
+    if (!std::isnan(processed))
+    {
+        s.stages[processing] = processed - arrival;
+        s.stages[delivery] = callback_time - processed;
+    }
+    else
+    {
+        s.stages[processing] = 0;
+        s.stages[delivery] = callback_time - arrival;
+    }
+    s.stages[total] = callback_time - exposure_start;
+    return s;
+}
+
+static double percentile(const vector<double>& sorted, double p)
+{
+    auto index = size_t(ceil(p / 100. * sorted.size()));
+    return sorted[min(sorted.size() - 1, index ? index - 1 : 0)];
+}
+
+static void report(const string& stream, const vector<sample>& samples)
+{
+    cout << stream << ", " << samples.size() << " frames\n";
+    cout << "    " << left << setw(12) << "stage" << right
+         << setw(10) << "mean" << setw(10) << "p50" << setw(10) << "p90" << setw(10) << "p99" << setw(10) << "max" << "   (ms)\n";
+    for (int i = 0; i < stage_count; i++)
+    {
+        vector<double> values;
+        for (auto&& s : samples)
+            if (!std::isnan(s.stages[i]))
+                values.push_back(s.stages[i]);
+
+        cout << "    " << left << setw(12) << stage_names[i] << right << fixed << setprecision(2);
+        if (values.empty())
+        {
+            cout << setw(10) << "n/a" << "\n";
+            continue;
+        }
+        sort(values.begin(), values.end());
+        double mean = 0;
+        for (auto v : values)
+            mean += v;
+        mean /= values.size();
+        cout << setw(10) << mean << setw(10) << percentile(values, 50) << setw(10) << percentile(values, 90)
+             << setw(10) << percentile(values, 99) << setw(10) << values.back();
+        if (values.size() < samples.size())
+            cout << "   (" << values.size() << " frames)";
+        cout << "\n";
+    }
+    cout << "\n";
+}
+
+int main(int argc, char** argv) try
+{
+    CmdLine cmd("librealsense rs-latency tool, decomposes the latency from the exposure to the user callback per stream", ' ', RS2_API_VERSION_STR);
+
+    ValueArg<int> duration("t", "time", "Seconds to measure", false, 10, "int");
+    ValueArg<int> warmup("w", "warmup", "Seconds streamed before the measurement, while the auto exposure and the global time settle", false, 3, "int");
+    ValueArg<string> serial("s", "serial", "Serial number of the device, the first one by default", false, "", "string");
+    SwitchArg all_streams("a", "all", "Enable all the streams of the device, instead of the default ones", false);
+    ValueArg<string> output("o", "output", "CSV file of the stages of every frame", false, "", "string");
+
+    cmd.add(duration);
+    cmd.add(warmup);
+    cmd.add(serial);
+    cmd.add(all_streams);
+    cmd.add(output);
+    cmd.parse(argc, argv);
+
+    rs2::context ctx;
+    auto devices = ctx.query_devices();
+    rs2::device dev;
+    for (auto&& d : devices)
+    {
+        if (serial.getValue().empty() || d.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) == serial.getValue())
+        {
+            dev = d;
+            break;
+        }
+    }
+    if (!dev)
+    {
+        cerr << "No device found" << endl;
+        return EXIT_FAILURE;
+    }
+
+    // The frame timestamps are mapped to the host clock, and the frames stamped along their path
+    for (auto&& sensor : dev.query_sensors())
+        if (sensor.supports(RS2_OPTION_GLOBAL_TIME_ENABLED))
+            sensor.set_option(RS2_OPTION_GLOBAL_TIME_ENABLED, 1.f);
+    rs2::enable_frame_trace(true);
+
+    rs2::config cfg;
+    cfg.enable_device(dev.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER));
+    if (all_streams.getValue())
+        cfg.enable_all_streams();
+
+    mutex samples_mutex;
+    map<string, vector<sample>> samples;
+    bool measuring = false;
+
+    auto on_frame = [&](const rs2::frame& f, double callback_time)
+    {
+        auto s = measure(f, callback_time);
+        auto profile = f.get_profile();
+        stringstream name;
+        name << rs2_stream_to_string(profile.stream_type());
+        if (profile.stream_index())
+            name << " " << profile.stream_index();
+        name << " " << rs2_format_to_string(profile.format());
+
+        lock_guard<mutex> lock(samples_mutex);
+        if (measuring)
+            samples[name.str()].push_back(s);
+    };
+
+    rs2::pipeline pipe(ctx);
+    pipe.start(cfg, [&](rs2::frame f)
+    {
+        auto callback_time = now_ms();
+        if (auto fs = f.as<rs2::frameset>())
+        {
+            for (auto&& sub : fs)
+                on_frame(sub, callback_time);
+        }
+        else
+            on_frame(f, callback_time);
+    });
+
+    cout << "Streaming from " << dev.get_info(RS2_CAMERA_INFO_NAME) << " " << dev.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) << "..." << endl;
+    this_thread::sleep_for(chrono::seconds(warmup.getValue()));
+    {
+        lock_guard<mutex> lock(samples_mutex);
+        measuring = true;
+    }
+    this_thread::sleep_for(chrono::seconds(duration.getValue()));
+    pipe.stop();
+
+    cout << "\n";
+    for (auto&& kvp : samples)
+        report(kvp.first, kvp.second);
+
+    if (!output.getValue().empty())
+    {
+        ofstream csv(output.getValue());
+        csv << "stream,frame";
+        for (auto name : stage_names)
+            csv << "," << name;
+        csv << "\n" << setprecision(3) << fixed;
+        for (auto&& kvp : samples)
+        {
+            for (auto&& s : kvp.second)
+            {
+                csv << kvp.first << "," << s.frame_number;
+                for (auto v : s.stages)
+                {
+                    csv << ",";
+                    if (!std::isnan(v))
+                        csv << v;
+                }
+                csv << "\n";
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const rs2::error& e)
+{
+    cerr << "RealSense error calling " << e.get_failed_function() << "(" << e.get_failed_args() << "):\n    " << e.what() << endl;
+    return EXIT_FAILURE;
+}
+catch (const exception& e)
+{
+    cerr << e.what() << endl;
+    return EXIT_FAILURE;
+}
@@ -4,6 +4,8 @@
 #include <librealsense2/rs.hpp>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <sstream>
 #include <thread>
 #include <mutex>
 #include <stdio.h>
@@ -12,50 +14,177 @@
 #include <thread>
 #include <string.h>
 #include <chrono>
+#include <map>
 #include "tclap/CmdLine.h"
 
 using namespace TCLAP;
 
+// Frames seen per stream, gaps in the frame numbers are frames the device side dropped
+struct stream_stats
+{
+    std::string name;
+    unsigned long long frames = 0;
+    unsigned long long missing = 0;
+    unsigned long long last_number = 0;
+};
+
+static std::string segment_name(const std::string& file, int index, bool split)
+{
+    if (!split)
+        return file;
+
+    auto dot = file.find_last_of('.');
+    auto base = dot == std::string::npos ? file : file.substr(0, dot);
+    auto ext = dot == std::string::npos ? std::string(".bag") : file.substr(dot);
+    std::stringstream ss;
+    ss << base << "_" << std::setfill('0') << std::setw(3) << index << ext;
+    return ss.str();
+}
+
+static unsigned long long file_size(const std::string& file)
+{
+    std::ifstream f(file, std::ios::binary | std::ios::ate);
+    auto size = f ? static_cast<long long>(f.tellg()) : 0;
+    return size > 0 ? static_cast<unsigned long long>(size) : 0;
+}
+
+// Size of the recording, with a file per stream the sum of the file of the device and of the files of the streams
+static unsigned long long recording_size(const std::string& file, const rs2::pipeline_profile& profile, bool per_stream)
+{
+    auto size = file_size(file);
+    if (!per_stream)
+        return size;
+
+    auto dot = file.find_last_of('.');
+    auto base = dot == std::string::npos ? file : file.substr(0, dot);
+    for (auto&& stream : profile.get_streams())
+    {
+        std::stringstream ss;
+        ss << base << "_" << rs2_stream_to_string(stream.stream_type());
+        if (stream.stream_index())
+            ss << "_" << stream.stream_index();
+        ss << ".bag";
+        size += file_size(ss.str());
+    }
+    return size;
+}
+
 int main(int argc, char * argv[]) try
 {
     // Parse command line arguments
     CmdLine cmd("librealsense rs-record example tool", ' ');
     ValueArg<int>    time("t", "Time", "Amount of time to record (in seconds)", false, 10, "");
     ValueArg<std::string> out_file("f", "FullFilePath", "the file where the data will be saved to", false, "test.bag", "");
+    ValueArg<int>    split_time("s", "SplitTime", "Start a new file every X seconds (0 - single file)", false, 0, "");
+    ValueArg<int>    split_size("m", "SplitSize", "Start a new file once the current one reaches X MB (0 - no limit)", false, 0, "");
+    SwitchArg        blocking("b", "Blocking", "Wait for the file writer when its cache is full instead of dropping frames", false);
+    SwitchArg        compress("c", "Compress", "Compress depth (RVL) and color (LZ4) images", false);
+    SwitchArg        delta("d", "Delta", "With -c, code each depth image as the difference from the previous one", false);
+    SwitchArg        per_stream("p", "FilePerStream", "Write every stream to a file of its own, in parallel", false);
 
     cmd.add(time);
     cmd.add(out_file);
+    cmd.add(split_time);
+    cmd.add(split_size);
+    cmd.add(blocking);
+    cmd.add(compress);
+    cmd.add(delta);
+    cmd.add(per_stream);
     cmd.parse(argc, argv);
 
-    rs2::pipeline pipe;
-    rs2::config cfg;
-    cfg.enable_record_to_file(out_file.getValue());
+    const bool split = split_time.getValue() > 0 || split_size.getValue() > 0;
+    const auto total = std::chrono::seconds(time.getValue());
+    const auto segment_time = split_time.getValue() > 0 ? std::chrono::seconds(split_time.getValue()) : total;
+    const unsigned long long segment_bytes = static_cast<unsigned long long>(split_size.getValue()) * 1024 * 1024;
 
     std::mutex m;
+    std::map<int, stream_stats> streams;
+    auto count = [&](const rs2::frame& f)
+    {
+        auto& s = streams[f.get_profile().unique_id()];
+        if (s.name.empty())
+            s.name = f.get_profile().stream_name();
+        auto number = f.get_frame_number();
+        if (s.frames && number > s.last_number + 1)
+            s.missing += number - s.last_number - 1;
+        s.last_number = number;
+        s.frames++;
+    };
     auto callback = [&](const rs2::frame& frame)
     {
         std::lock_guard<std::mutex> lock(m);
-        auto t = std::chrono::system_clock::now();
-        static auto tk = t;
-        static auto t0 = t;
-        if (t - tk >= std::chrono::seconds(1)) {
-            std::cout << "\r" << std::setprecision(3) << std::fixed
-                      << "Recording t = "  << std::chrono::duration_cast<std::chrono::seconds>(t-t0).count() << "s" << std::flush;
-            tk = t;
-        }
+        if (auto fs = frame.as<rs2::frameset>())
+            for (auto&& f : fs)
+                count(f);
+        else
+            count(frame);
     };
 
-    rs2::pipeline_profile profiles = pipe.start(cfg, callback);
+    auto t0 = std::chrono::system_clock::now();
+    for (int index = 0; std::chrono::system_clock::now() - t0 < total; ++index)
+    {
+        auto file = segment_name(out_file.getValue(), index, split);
+
+        rs2::pipeline pipe;
+        rs2::config cfg;
+        cfg.enable_record_to_file(file);
+
+        rs2::pipeline_profile profiles = pipe.start(cfg, callback);
+        auto recorder = profiles.get_device().as<rs2::recorder>();
+        if (recorder)
+        {
+            recorder.set_blocking_write(blocking.getValue());
+            recorder.set_file_per_stream(per_stream.getValue());
+            if (compress.getValue())
+            {
+                recorder.set_frame_compression(RS2_STREAM_DEPTH, delta.getValue() ? RS2_FRAME_COMPRESSION_RVL_DELTA : RS2_FRAME_COMPRESSION_RVL);
+                recorder.set_frame_compression(RS2_STREAM_COLOR, RS2_FRAME_COMPRESSION_LZ4);
+            }
+        }
+
+        auto start = std::chrono::system_clock::now();
+        auto tk = start;
+        unsigned long long size = 0, size_k = 0;
+        while (true)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            auto t = std::chrono::system_clock::now();
+            if (t - t0 > total || t - start >= segment_time || (segment_bytes && size >= segment_bytes))
+                break;
+
+            if (t - tk >= std::chrono::seconds(1))
+            {
+                size = recording_size(file, profiles, per_stream.getValue());
+                auto rate = (size - std::min(size, size_k)) / std::chrono::duration<double>(t - tk).count();
+                std::cout << "\r" << std::setprecision(1) << std::fixed
+                          << "Recording t = " << std::chrono::duration_cast<std::chrono::seconds>(t - t0).count() << "s"
+                          << ", " << size / (1024. * 1024.) << " MB at " << rate / (1024. * 1024.) << " MB/s";
+                if (recorder)
+                    std::cout << ", dropped " << recorder.dropped_frames();
+                std::cout << "    " << std::flush;
+                tk = t;
+                size_k = size;
+            }
+        }
 
-    auto t = std::chrono::system_clock::now();
-    auto t0 = t;
-    while(t - t0 <= std::chrono::seconds(time.getValue())) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        t = std::chrono::system_clock::now();
+        unsigned long long written = 0, dropped = 0;
+        if (recorder)
+        {
+            written = recorder.written_frames();
+            dropped = recorder.dropped_frames();
+        }
+        pipe.stop();
+
+        std::cout << "\n" << file << ": " << written << " frames written, " << dropped << " dropped by the writer" << std::endl;
     }
-    std::cout << "\nFinished" << std::endl;
 
-    pipe.stop();
+    std::cout << "Finished" << std::endl;
+    std::lock_guard<std::mutex> lock(m);
+    for (auto&& s : streams)
+    {
+        std::cout << "  " << std::left << std::setw(12) << s.second.name << std::right
+                  << s.second.frames << " frames, " << s.second.missing << " missing" << std::endl;
+    }
 
     return EXIT_SUCCESS;
 }
@@ -14,6 +14,7 @@
 #include "../../third-party/realsense-file/rosbag/msgs/sensor_msgs/Image.h"
 #include "../../third-party/realsense-file/rosbag/msgs/diagnostic_msgs/KeyValue.h"
 #include "../../third-party/realsense-file/rosbag/msgs/std_msgs/UInt32.h"
+#include "../../third-party/realsense-file/rosbag/msgs/std_msgs/UInt8MultiArray.h"
 #include "../../third-party/realsense-file/rosbag/msgs/std_msgs/String.h"
 #include "../../third-party/realsense-file/rosbag/msgs/std_msgs/Float32.h"
 #include "../../third-party/realsense-file/rosbag/msgs/realsense_msgs/StreamInfo.h"
@@ -114,6 +115,10 @@ namespace rosbag_inspector
         {
             os << "Value : " << data->data << std::endl;
         }
+        else if (auto data = try_instantiate<std_msgs::UInt8MultiArray>(m))
+        {
+            os << "Size  : " << data->data.size() << " bytes" << std::endl;
+        }
         else if (auto data = try_instantiate<diagnostic_msgs::KeyValue>(m))
         {
             auto kvp = data;
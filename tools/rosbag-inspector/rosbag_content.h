@@ -4,6 +4,7 @@
 #pragma once
 
 #include <string>
+#include <memory>
 
 #include "../../third-party/realsense-file/rosbag/rosbag_storage/include/rosbag/bag.h"
 #include "../../third-party/realsense-file/rosbag/rosbag_storage/include/rosbag/view.h"
@@ -26,17 +27,30 @@ namespace rosbag_inspector
         uint64_t uncompressed;
     };
 
+    struct topic_info
+    {
+        std::string message_type; // of the first connection, in case the topic has several
+        uint32_t messages = 0;
+    };
+
     struct rosbag_content
     {
         rosbag_content(const std::string& file)
         {
             bag.open(file);
 
+            // The topics and message counts come from the connection records and the chunk indexes,
+            // that the bag reads when opened, no message is read until it is displayed
             rosbag::View entire_bag_view(bag);
-
-            for (auto&& m : entire_bag_view)
+            for (auto&& connection : entire_bag_view.getConnections())
             {
-                topics_to_message_types[m.getTopic()].push_back(m.getDataType());
+                auto& topic = topics[connection->topic];
+                if (topic.message_type.empty())
+                    topic.message_type = connection->datatype;
+            }
+            for (auto&& topic : topics)
+            {
+                topic.second.messages = get_messages(topic.first).size();
             }
 
             path = bag.getFileName();
@@ -64,10 +78,11 @@ namespace rosbag_inspector
             version = other.version;
             size = other.size;
             compression_info = other.compression_info;
-            topics_to_message_types = other.topics_to_message_types;
+            topics = other.topics;
         }
         rosbag_content(rosbag_content&& other)
         {
+            other.views.clear();
             other.bag.close();
             bag.open(other.path);
             cache = other.cache;
@@ -77,7 +92,7 @@ namespace rosbag_inspector
             version = other.version;
             size = other.size;
             compression_info = other.compression_info;
-            topics_to_message_types = other.topics_to_message_types;
+            topics = other.topics;
 
             other.cache.clear();
             other.file_duration = std::chrono::nanoseconds::zero();
@@ -88,7 +103,16 @@ namespace rosbag_inspector
             other.compression_info.compressed = 0;
             other.compression_info.uncompressed = 0;
             other.compression_info.compression_type = "";
-            other.topics_to_message_types.clear();
+            other.topics.clear();
+        }
+
+        // The messages of a topic, the view is created on first use and kept since it indexes the whole bag
+        rosbag::View& get_messages(const std::string& topic)
+        {
+            auto& view = views[topic];
+            if (!view)
+                view = std::make_shared<rosbag::View>(bag, rosbag::TopicQuery(topic));
+            return *view;
         }
         std::string instanciate_and_cache(const rosbag::MessageInstance& m, uint64_t count)
         {
@@ -119,7 +143,8 @@ namespace rosbag_inspector
         std::string version;
         double size;
         rosbag_inspector::compression_info compression_info;
-        std::map<std::string, std::vector<std::string>> topics_to_message_types;
+        std::map<std::string, topic_info> topics;
         rosbag::Bag bag;
+        std::map<std::string, std::shared_ptr<rosbag::View>> views; // refer to bag, never copied
     };
 }
@@ -240,21 +240,21 @@ void draw_bag_content(rosbag_content& bag, int flags)
     ImGui::Text("\t%s", std::string(tmpstringstream() << std::left << std::setw(20) << "compressed: " << bag.compression_info.uncompressed).c_str());
     if (ImGui::CollapsingHeader("Topics"))
     {
-        for (auto&& topic_to_message_type : bag.topics_to_message_types)
+        for (auto&& topic_info : bag.topics)
         {
-            std::string topic = topic_to_message_type.first;
-            std::vector<std::string> messages_types = topic_to_message_type.second;
+            std::string topic = topic_info.first;
+            auto messages_count = topic_info.second.messages;
             std::ostringstream oss;
             int max_topic_len = 100;
             oss << std::left << std::setw(max_topic_len) << topic
-                << " " << std::left << std::setw(10) << messages_types.size() << std::setw(6) << std::string(" msg") + (messages_types.size() > 1 ? "s" : "")
-                << ": " << std::left << std::setw(40) << messages_types.front() << std::endl;
+                << " " << std::left << std::setw(10) << messages_count << std::setw(6) << std::string(" msg") + (messages_count > 1 ? "s" : "")
+                << ": " << std::left << std::setw(40) << topic_info.second.message_type << std::endl;
             std::string line = oss.str();
             auto pos = ImGui::GetCursorPos();
             ImGui::SetCursorPos({ pos.x + 20, pos.y });
             if (ImGui::CollapsingHeader(line.c_str()))
             {
-                rosbag::View messages(bag.bag, rosbag::TopicQuery(topic));
+                auto& messages = bag.get_messages(topic);
                 uint64_t count = 0;
                 constexpr uint64_t num_next_items_to_show = 10;
                 num_topics_to_show[topic] = std::max(num_topics_to_show[topic], num_next_items_to_show);
@@ -275,7 +275,7 @@ void draw_bag_content(rosbag_content& bag, int flags)
                     ImGui::Separator();
                     if (count >= max)
                     {
-                        int left = messages.size() - max;
+                        int left = static_cast<int>(messages_count - max);
                         if (left > 0)
                         {
                             ImGui::Text("... %d more messages", left);
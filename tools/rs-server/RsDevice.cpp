@@ -11,49 +11,77 @@ int RsDevice::getPhysicalSensorUniqueKey(rs2_stream stream_type, int sensors_ind
     return stream_type * 10 + sensors_index;
 }
 
-RsDevice::RsDevice(UsageEnvironment* t_env)
-    : env(t_env)
+RsDevice::RsDevice(UsageEnvironment* t_env, rs2::device t_device)
+    : m_device(t_device)
+    , env(t_env)
 {
-    //get LRS device
-    // The context represents the current platform with respect to connected devices
+    //get RS sensors
+    for(auto& sensor : m_device.query_sensors())
+    {
+        m_sensors.push_back(RsSensor(env, sensor, m_device));
+    }
+}
 
-    bool found = false;
+std::vector<std::shared_ptr<RsDevice>> RsDevice::createDevices(UsageEnvironment* t_env, const std::vector<std::string>& t_serials)
+{
+    //get LRS devices
+    // The context represents the current platform with respect to connected devices
+    std::vector<rs2::device> found;
     bool first = true;
-    do
+    while(true)
     {
+        found.clear();
         rs2::context ctx;
         rs2::device_list devices = ctx.query_devices();
-        rs2::device dev;
-        if(devices.size())
+        try
         {
-            try
+            if(t_serials.empty())
             {
-                m_device = devices[0]; // Only one device is supported
-                *env << "RealSense Device Connected\n";
-
-                found = true;
+                for(auto&& dev : devices)
+                {
+                    found.push_back(dev);
+                }
             }
-            catch(const std::exception& e)
+            else
             {
-                std::cerr << e.what() << '\n';
+                for(auto& serial : t_serials)
+                {
+                    for(auto&& dev : devices)
+                    {
+                        if(dev.supports(RS2_CAMERA_INFO_SERIAL_NUMBER) && serial == dev.get_info(RS2_CAMERA_INFO_SERIAL_NUMBER))
+                        {
+                            found.push_back(dev);
+                            break;
+                        }
+                    }
+                }
             }
         }
-        if(!found)
+        catch(const std::exception& e)
         {
-            if(first)
-            {
-                std::cerr << "Waiting for Device..." << std::endl;
-                first = false;
-            }
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            std::cerr << e.what() << '\n';
+            found.clear();
         }
-    } while(!found);
 
-    //get RS sensors
-    for(auto& sensor : m_device.query_sensors())
+        if(!found.empty() && (t_serials.empty() || found.size() == t_serials.size()))
+        {
+            break;
+        }
+        if(first)
+        {
+            std::cerr << "Waiting for Device..." << std::endl;
+            first = false;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+
+    std::vector<std::shared_ptr<RsDevice>> rsDevices;
+    for(auto& dev : found)
     {
-        m_sensors.push_back(RsSensor(env, sensor, m_device));
+        *t_env << "RealSense Device Connected\n";
+        rsDevices.push_back(std::make_shared<RsDevice>(t_env, dev));
     }
+    return rsDevices;
 }
 
 RsDevice::~RsDevice()
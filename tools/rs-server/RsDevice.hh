@@ -7,12 +7,17 @@
 #include "RsUsageEnvironment.h"
 #include "RsSensor.hh"
 #include <map>
+#include <memory>
+#include <string>
+#include <vector>
 
 class RsDevice
 {
 public:
-    RsDevice(UsageEnvironment* t_env);
+    RsDevice(UsageEnvironment* t_env, rs2::device t_device);
     ~RsDevice();
+    // Waits for the cameras of the serial numbers, in their order, or for at least one camera and takes all the connected ones
+    static std::vector<std::shared_ptr<RsDevice>> createDevices(UsageEnvironment* t_env, const std::vector<std::string>& t_serials);
     std::vector<RsSensor>& getSensors()
     {
         return m_sensors;
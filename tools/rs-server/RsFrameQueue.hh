@@ -0,0 +1,88 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "RsStreamPacing.hh"
+#include <ipDeviceCommon/RsCommon.h>
+#include <librealsense2/rs.hpp>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+// Frame waiting to be sent.
+// A compressed frame is written by the sensor callback after its RsFrameHeader in a buffer of the memory pool, and the source copies
+// the buffer to the RTP sink as is. The librealsense frame is only kept for the streams sent uncompressed
+struct RsFramePacket
+{
+    rs2::frame frame;
+    std::shared_ptr<unsigned char> data;
+    unsigned size = 0; // bytes of data
+};
+
+// Fills the header of a frame of t_dataSize bytes
+void fillFrameHeader(const rs2::frame& t_frame, unsigned t_dataSize, RsFrameHeader& t_header);
+
+// Queue of the packets of a stream between the sensor callback and the RTP source, copies share the same queue and pacing.
+// The oldest packet is dropped when the queue is full
+class RsFrameQueue
+{
+public:
+    RsFrameQueue(size_t t_capacity = 1)
+        : m_queue(std::make_shared<Queue>())
+    {
+        m_queue->m_capacity = t_capacity;
+    }
+
+    void enqueue(RsFramePacket t_packet)
+    {
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        if(m_queue->m_packets.size() >= m_queue->m_capacity)
+        {
+            m_queue->m_packets.pop_front();
+        }
+        m_queue->m_packets.push_back(std::move(t_packet));
+    }
+
+    bool pollForPacket(RsFramePacket& t_packet)
+    {
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        if(m_queue->m_packets.empty())
+        {
+            return false;
+        }
+        t_packet = std::move(m_queue->m_packets.front());
+        m_queue->m_packets.pop_front();
+        return true;
+    }
+
+    size_t size()
+    {
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        return m_queue->m_packets.size();
+    }
+
+    // Emptied when the stream stops, the next clients start without congestion
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_queue->m_mutex);
+        m_queue->m_packets.clear();
+        m_queue->m_pacing.reset();
+    }
+
+    RsStreamPacing& getPacing()
+    {
+        return m_queue->m_pacing;
+    }
+
+private:
+    struct Queue
+    {
+        std::mutex m_mutex;
+        std::deque<RsFramePacket> m_packets;
+        size_t m_capacity;
+        RsStreamPacing m_pacing;
+    };
+    std::shared_ptr<Queue> m_queue;
+};
@@ -13,6 +13,7 @@
 #include "librealsense2/hpp/rs_options.hpp"
 #include <ipDeviceCommon/RsCommon.h>
 #include "RsUsageEnvironment.h"
+#include <compression/CompressionFactory.h>
 
 // RTSPServer implementation
 
@@ -32,6 +33,20 @@ RsRTSPServer::RsRTSPServer(UsageEnvironment& t_env, std::shared_ptr<RsDevice> t_
 
 RsRTSPServer::~RsRTSPServer() {}
 
+// Value of a header of the request, empty when the request does not have it
+std::string getRequestHeader(char const* t_fullRequestStr, const std::string& t_header)
+{
+    std::string request(t_fullRequestStr);
+    std::size_t begin = request.find("\r\n" + t_header + ":");
+    if(begin == std::string::npos)
+    {
+        return "";
+    }
+    begin = request.find_first_not_of(' ', begin + t_header.size() + 3);
+    std::size_t end = request.find("\r\n", begin);
+    return begin == std::string::npos ? "" : request.substr(begin, end - begin);
+}
+
 std::string getOptionString(rs2_option t_opt, float t_min, float t_max, float t_def, float t_step)
 {
     std::ostringstream oss;
@@ -70,13 +85,6 @@ RsRTSPServer::RsRTSPClientConnection ::RsRTSPClientConnection(RsRTSPServer& t_ou
 
 RsRTSPServer::RsRTSPClientConnection::~RsRTSPClientConnection() {}
 
-void RsRTSPServer::RsRTSPClientConnection::handleCmd_DESCRIBE(char const* urlPreSuffix, char const* urlSuffix, char const* fullRequestStr) {
-    fOurRTSPServer.closeAllClientSessionsForServerMediaSession(STEREO_SENSOR_NAME.c_str());
-    fOurRTSPServer.closeAllClientSessionsForServerMediaSession(RGB_SENSOR_NAME.c_str());
-    
-    RTSPServer::RTSPClientConnection::handleCmd_DESCRIBE(urlPreSuffix, urlSuffix, fullRequestStr);
-}
-
 void RsRTSPServer::RsRTSPClientConnection::handleCmd_GET_PARAMETER(char const* t_fullRequestStr)
 {
     std::ostringstream oss;
@@ -155,12 +163,13 @@ void RsRTSPServer::RsRTSPClientConnection::handleCmd_SET_PARAMETER(char const* t
 
 RsRTSPServer::RsRTSPClientSession ::RsRTSPClientSession(RTSPServer& t_ourServer, u_int32_t t_sessionId)
     : RTSPClientSession(t_ourServer, t_sessionId)
+    , m_isPlaying(false)
 {}
 
 RsRTSPServer::RsRTSPClientSession::~RsRTSPClientSession() {
     try
     {
-        closeRsCamera();
+        releaseStreams();
     }
     catch(const std::exception& e)
     {
@@ -173,7 +182,7 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_TEARDOWN(RTSPClientConnection*
     envir() << "TEARDOWN \n";
     try
     {
-        closeRsCamera();
+        releaseStreams();
     }
     catch(const std::exception& e)
     {
@@ -285,8 +294,28 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SETUP(RTSPServer::RTSPClientCo
         {
             if(strcmp(subsession->trackId(), t_urlSuffix) == 0)
             {
-                long long int profileKey = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getStreamProfileKey(((RsServerMediaSubsession*)(subsession))->getStreamProfile());
-                m_streamProfiles[profileKey] = ((RsServerMediaSubsession*)(subsession))->getFrameQueue();
+                RsSensor& sensor = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor();
+                rs2::stream_profile streamProfile = ((RsServerMediaSubsession*)(subsession))->getStreamProfile();
+                long long int profileKey = sensor.getStreamProfileKey(streamProfile);
+                // The client chooses the codec of each stream, older clients use the default codec
+                CompressionConfig compression = CompressionFactory::getDefaultConfig(streamProfile.format(), streamProfile.stream_type(), CompressionFactory::getIsEnabled());
+                std::string codec = getRequestHeader(t_fullRequestStr, RS_CODEC_HEADER);
+                if(!codec.empty() && !(CompressionFactory::parseConfig(codec, compression) && CompressionFactory::isCompressionSupported(compression, streamProfile.format(), streamProfile.stream_type())))
+                {
+                    envir() << "SETUP: unsupported codec '" << codec.c_str() << "'\n";
+                    setRTSPResponse(t_ourClientConnection, "415 Unsupported Codec");
+                    return;
+                }
+                envir() << "SETUP: codec '" << CompressionFactory::configToString(compression).c_str() << "'\n";
+                if(m_streamProfiles.find(profileKey) == m_streamProfiles.end())
+                {
+                    if(!static_cast<RsServerMediaSession*>(fOurServerMediaSession)->addStreamClient(profileKey, compression))
+                    {
+                        setRTSPResponse(t_ourClientConnection, "415 Unsupported Codec");
+                        return;
+                    }
+                    m_streamProfiles[profileKey] = ((RsServerMediaSubsession*)(subsession))->getFrameQueue();
+                }
                 break; // success
             }
         }
@@ -295,30 +324,30 @@ void RsRTSPServer::RsRTSPClientSession::handleCmd_SETUP(RTSPServer::RTSPClientCo
 
 void RsRTSPServer::RsRTSPClientSession::openRsCamera()
 {
-    static_cast<RsServerMediaSession*>(fOurServerMediaSession)->openRsCamera(m_streamProfiles);
+    if(!m_isPlaying)
+    {
+        static_cast<RsServerMediaSession*>(fOurServerMediaSession)->openRsCamera(m_streamProfiles);
+        m_isPlaying = true;
+    }
 }
 
 void RsRTSPServer::RsRTSPClientSession::closeRsCamera()
 {
-    ((RsServerMediaSession*)fOurServerMediaSession)->closeRsCamera();
-    for(int i = 0; i < fNumStreamStates; ++i)
+    if(m_isPlaying)
     {
-        if(fStreamStates[i].subsession != NULL)
-        {
-            long long int profile_key = static_cast<RsServerMediaSession*>(fOurServerMediaSession)->getRsSensor().getStreamProfileKey(((RsServerMediaSubsession*)(fStreamStates[i].subsession))->getStreamProfile());
-            emptyStreamProfileQueue(profile_key);
-        }
+        m_isPlaying = false;
+        static_cast<RsServerMediaSession*>(fOurServerMediaSession)->closeRsCamera();
     }
 }
 
-void RsRTSPServer::RsRTSPClientSession::emptyStreamProfileQueue(long long int profile_key)
+void RsRTSPServer::RsRTSPClientSession::releaseStreams()
 {
-    rs2::frame f;
-    if(m_streamProfiles.find(profile_key) != m_streamProfiles.end())
+    closeRsCamera();
+    for(const auto& streamProfile : m_streamProfiles)
     {
-        while(m_streamProfiles[profile_key].poll_for_frame(&f))
-            ;
+        static_cast<RsServerMediaSession*>(fOurServerMediaSession)->removeStreamClient(streamProfile.first);
     }
+    m_streamProfiles.clear();
 }
 
 GenericMediaServer::ClientConnection* RsRTSPServer::createNewClientConnection(int clientSocket, struct sockaddr_in clientAddr)
@@ -19,6 +19,8 @@ protected:
     virtual ~RsRTSPServer();
     char const* allowedCommandNames();
 
+    // Several clients may play the same streams, the frames are coded once and each RTP packet is sent to all of them
+
     std::map<std::string, std::vector<RsOption>> m_supportedOptions;
     std::string m_supportedOptionsStr;
     std::shared_ptr<RsDevice> m_device;
@@ -33,7 +35,6 @@ public:
         virtual ~RsRTSPClientConnection();
         virtual void handleCmd_GET_PARAMETER(char const* fullRequestStr);
         virtual void handleCmd_SET_PARAMETER(char const* fullRequestStr);
-        virtual void handleCmd_DESCRIBE(char const* urlPreSuffix, char const* urlSuffix, char const* fullRequestStr);
 
         RsRTSPServer& m_fOurRsRTSPServer;
 
@@ -60,10 +61,12 @@ public:
 
         void openRsCamera();
         void closeRsCamera();
-        void emptyStreamProfileQueue(long long int t_profile_key);
+        // Closes the camera for this client and releases its streams
+        void releaseStreams();
 
     private:
-        std::unordered_map<long long int, rs2::frame_queue> m_streamProfiles;
+        std::unordered_map<long long int, RsFrameQueue> m_streamProfiles;
+        bool m_isPlaying;
     };
 
 protected:
@@ -72,9 +75,6 @@ protected:
 protected:
     virtual ClientSession* createNewClientSession(u_int32_t t_sessionId);
 
-private:
-    int openRsCamera(RsSensor t_sensor, std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles);
-
 private:
     friend class RsRTSPClientConnection;
     friend class RsRTSPClientSession;
@@ -6,6 +6,7 @@
 #include "compression/CompressionFactory.h"
 #include "string.h"
 #include <BasicUsageEnvironment.hh>
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 #include <thread>
@@ -17,31 +18,48 @@ RsSensor::RsSensor(UsageEnvironment* t_env, rs2::sensor t_sensor, rs2::device t_
 {
     for(rs2::stream_profile streamProfile : m_sensor.get_stream_profiles())
     {
-        if(streamProfile.is<rs2::video_stream_profile>())
+        if(streamProfile.is<rs2::video_stream_profile>() || streamProfile.is<rs2::motion_stream_profile>())
         {
             //make a map with all the sensor's stream profiles
-            m_streamProfiles.emplace(getStreamProfileKey(streamProfile), streamProfile.as<rs2::video_stream_profile>());
+            m_streamProfiles.emplace(getStreamProfileKey(streamProfile), streamProfile);
             m_prevSample.emplace(getStreamProfileKey(streamProfile), std::chrono::high_resolution_clock::now());
         }
     }
     m_memPool = new MemoryPool();
 }
 
-int RsSensor::open(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues)
+int RsSensor::open(std::unordered_map<long long int, RsFrameQueue>& t_streamProfilesQueues)
 {
     std::vector<rs2::stream_profile> requestedStreamProfiles;
+    m_iCompress.clear();
+    m_adaptiveQuality.clear();
+    m_congestionQuality.clear();
+    m_imuBatches.clear();
     for(auto streamProfile : t_streamProfilesQueues)
     {
         //make a vector of all requested stream profiles
         long long int streamProfileKey = streamProfile.first;
-        requestedStreamProfiles.push_back(m_streamProfiles.at(streamProfileKey));
-        if(CompressionFactory::isCompressionSupported(m_streamProfiles.at(streamProfileKey).format(), m_streamProfiles.at(streamProfileKey).stream_type()))
+        rs2::stream_profile sp = m_streamProfiles.at(streamProfileKey);
+        requestedStreamProfiles.push_back(sp);
+        if(sp.is<rs2::motion_stream_profile>())
         {
-            rs2::video_stream_profile vsp = m_streamProfiles.at(streamProfileKey);
-            std::shared_ptr<ICompression> compressPtr = CompressionFactory::getObject(vsp.width(), vsp.height(), vsp.format(), vsp.stream_type(), RsSensor::getStreamProfileBpp(vsp.format()));
-            if(compressPtr != nullptr)
+            // motion samples are sent in batches, uncompressed
+            m_imuBatches[streamProfileKey] = RsImuBatch();
+            continue;
+        }
+        rs2::video_stream_profile vsp = sp.as<rs2::video_stream_profile>();
+        CompressionConfig compression = getStreamCompression(streamProfileKey);
+        std::shared_ptr<ICompression> compressPtr = CompressionFactory::getObject(compression, vsp.width(), vsp.height(), vsp.format(), RsSensor::getStreamProfileBpp(vsp.format()), vsp.fps());
+        if(compressPtr != nullptr)
+        {
+            m_iCompress.insert(std::pair<long long int, std::shared_ptr<ICompression>>(streamProfileKey, compressPtr));
+            if(compression.zipMethod == ZipMethod::jpeg)
             {
-                m_iCompress.insert(std::pair<long long int, std::shared_ptr<ICompression>>(streamProfileKey, compressPtr));
+                m_congestionQuality[streamProfileKey] = {compression.quality, 0};
+                if(compression.bandwidth > 0)
+                {
+                    m_adaptiveQuality[streamProfileKey] = {compression.quality, compression.quality, compression.bandwidth, 0, std::chrono::high_resolution_clock::now()};
+                }
             }
         }
         else
@@ -53,6 +71,111 @@ int RsSensor::open(std::unordered_map<long long int, rs2::frame_queue>& t_stream
     return EXIT_SUCCESS;
 }
 
+void RsSensor::setStreamCompression(long long int t_streamProfileKey, const CompressionConfig& t_compression)
+{
+    m_compressionConfigs[t_streamProfileKey] = t_compression;
+}
+
+CompressionConfig RsSensor::getStreamCompression(long long int t_streamProfileKey)
+{
+    auto config = m_compressionConfigs.find(t_streamProfileKey);
+    if(config != m_compressionConfigs.end())
+    {
+        return config->second;
+    }
+    rs2::stream_profile sp = m_streamProfiles.at(t_streamProfileKey);
+    return CompressionFactory::getDefaultConfig(sp.format(), sp.stream_type(), CompressionFactory::getIsEnabled());
+}
+
+void RsSensor::requestKeyFrames()
+{
+    for(auto& compress : m_iCompress)
+    {
+        compress.second->requestKeyFrame();
+    }
+}
+
+void RsSensor::adaptQuality(RsAdaptiveQuality& t_adaptiveQuality, ICompression& t_compression, int t_frameSize)
+{
+    const double window = 0.5; // seconds
+    const int step = 5;
+
+    t_adaptiveQuality.m_windowBytes += t_frameSize;
+    std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(now - t_adaptiveQuality.m_windowStart).count();
+    if(elapsed < window)
+    {
+        return;
+    }
+
+    double kbps = t_adaptiveQuality.m_windowBytes * 8 / 1000.0 / elapsed;
+    int quality = t_adaptiveQuality.m_quality;
+    if(kbps > t_adaptiveQuality.m_bandwidth)
+    {
+        quality = std::max(JPEG_MIN_ADAPTIVE_QUALITY, quality - step);
+    }
+    else if(kbps < 0.8 * t_adaptiveQuality.m_bandwidth)
+    {
+        quality = std::min(t_adaptiveQuality.m_maxQuality, quality + step);
+    }
+    if(quality != t_adaptiveQuality.m_quality)
+    {
+        t_compression.setQuality(quality);
+        t_adaptiveQuality.m_quality = quality;
+    }
+    t_adaptiveQuality.m_windowBytes = 0;
+    t_adaptiveQuality.m_windowStart = now;
+}
+
+int RsSensor::applyCongestion(long long int t_profileKey, RsCongestionQuality& t_congestion, int t_level)
+{
+    if(t_level != t_congestion.m_level)
+    {
+        int quality = std::max(JPEG_MIN_ADAPTIVE_QUALITY, t_congestion.m_quality - t_level * RS_PACING_QUALITY_STEP);
+        auto adaptiveQuality = m_adaptiveQuality.find(t_profileKey);
+        if(adaptiveQuality != m_adaptiveQuality.end())
+        {
+            // the bandwidth budget adapts the quality under the cap of the congestion
+            adaptiveQuality->second.m_maxQuality = quality;
+            quality = std::min(quality, adaptiveQuality->second.m_quality);
+            adaptiveQuality->second.m_quality = quality;
+        }
+        m_iCompress.at(t_profileKey)->setQuality(quality);
+        t_congestion.m_level = t_level;
+    }
+    return (t_congestion.m_quality - JPEG_MIN_ADAPTIVE_QUALITY + RS_PACING_QUALITY_STEP - 1) / RS_PACING_QUALITY_STEP;
+}
+
+void RsSensor::addImuSample(RsImuBatch& t_batch, const rs2::frame& t_frame, RsFrameQueue& t_queue)
+{
+    if(t_batch.m_count == 0)
+    {
+        MemoryPool* memPool = m_memPool;
+        t_batch.m_data = std::shared_ptr<unsigned char>(memPool->getNextMem(RS_IMU_MAX_MESSAGE_SIZE), [memPool](unsigned char* t_buff) { memPool->returnMem(t_buff); });
+        t_batch.m_firstTimestamp = t_frame.get_timestamp();
+    }
+
+    RsImuSample& sample = reinterpret_cast<RsImuSample*>(t_batch.m_data.get() + sizeof(RsFrameHeader))[t_batch.m_count++];
+    sample.timestamp = t_frame.get_timestamp();
+    sample.frameCounter = t_frame.get_frame_number();
+    memset(sample.data, 0, sizeof(sample.data));
+    memcpy(sample.data, t_frame.get_data(), std::min(sizeof(sample.data), size_t(t_frame.get_data_size())));
+
+    if(t_batch.m_count == RS_IMU_MAX_BATCH || sample.timestamp - t_batch.m_firstTimestamp >= RS_IMU_BATCH_PERIOD)
+    {
+        // the header of the batch carries the metadata of its last sample
+        RsFrameHeader header;
+        unsigned dataSize = t_batch.m_count * sizeof(RsImuSample);
+        fillFrameHeader(t_frame, dataSize, header);
+        memcpy(t_batch.m_data.get(), &header, sizeof(header));
+        RsFramePacket packet;
+        packet.data = std::move(t_batch.m_data);
+        packet.size = sizeof(RsFrameHeader) + dataSize;
+        t_queue.enqueue(std::move(packet));
+        t_batch.m_count = 0;
+    }
+}
+
 int RsSensor::close()
 {
     m_sensor.close();
@@ -65,29 +188,68 @@ int RsSensor::stop()
     return EXIT_SUCCESS;
 }
 
-int RsSensor::start(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues)
+int RsSensor::start(std::unordered_map<long long int, RsFrameQueue>& t_streamProfilesQueues)
 {
     auto callback = [&](const rs2::frame& frame) {
         long long int profileKey = getStreamProfileKey(frame.get_profile());
         //check if profile exists in map:
-        if(t_streamProfilesQueues.find(profileKey) != t_streamProfilesQueues.end())
+        auto queue = t_streamProfilesQueues.find(profileKey);
+        if(queue != t_streamProfilesQueues.end())
         {
             std::chrono::high_resolution_clock::time_point curSample = std::chrono::high_resolution_clock::now();
+            auto imuBatch = m_imuBatches.find(profileKey);
+            if(imuBatch != m_imuBatches.end())
+            {
+                addImuSample(imuBatch->second, frame, queue->second);
+                m_prevSample[profileKey] = curSample;
+                return;
+            }
+            // a congested stream lowers its quality, then drops frames before they are coded
+            RsStreamPacing& pacing = queue->second.getPacing();
+            int qualityLevels = 0;
+            auto congestionQuality = m_congestionQuality.find(profileKey);
+            if(congestionQuality != m_congestionQuality.end())
+            {
+                qualityLevels = applyCongestion(profileKey, congestionQuality->second, pacing.getLevel());
+            }
+            if(!pacing.keepFrame(qualityLevels))
+            {
+                m_prevSample[profileKey] = curSample;
+                return;
+            }
             std::chrono::duration<double> timeSpan = std::chrono::duration_cast<std::chrono::duration<double>>(curSample - m_prevSample[profileKey]);
-            if(CompressionFactory::isCompressionSupported(frame.get_profile().format(), frame.get_profile().stream_type()))
+            RsFramePacket packet;
+            auto compress = m_iCompress.find(profileKey);
+            if(compress != m_iCompress.end())
             {
-                unsigned char* buff = m_memPool->getNextMem();
-                int frameSize = m_iCompress.at(profileKey)->compressBuffer((unsigned char*)frame.get_data(), frame.get_data_size(), buff);
+                // Room for the header and the worst case of the codecs, which may expand incompressible frames.
+                // The codecs write the compressed size in front of the data, where the header is then written
+                MemoryPool* memPool = m_memPool;
+                unsigned char* buff = memPool->getNextMem(sizeof(RsFrameHeader) + 2 * frame.get_data_size());
+                int frameSize = compress->second->compressBuffer((unsigned char*)frame.get_data(), frame.get_data_size(), buff + sizeof(RsFrameHeader) - sizeof(int));
                 if(frameSize == -1)
                 {
-                    m_memPool->returnMem(buff);
+                    memPool->returnMem(buff);
                     return;
                 }
-                memcpy((unsigned char*)frame.get_data(), buff, frameSize);
-                m_memPool->returnMem(buff);
+                auto adaptiveQuality = m_adaptiveQuality.find(profileKey);
+                if(adaptiveQuality != m_adaptiveQuality.end())
+                {
+                    adaptQuality(adaptiveQuality->second, *compress->second, frameSize);
+                }
+                RsFrameHeader header;
+                fillFrameHeader(frame, frameSize - sizeof(int), header);
+                memcpy(buff, &header, sizeof(header));
+                packet.data = std::shared_ptr<unsigned char>(buff, [memPool](unsigned char* t_buff) { memPool->returnMem(t_buff); });
+                packet.size = sizeof(RsFrameHeader) + frameSize - sizeof(int);
+            }
+            else
+            {
+                packet.frame = frame;
+                packet.frame.keep();
             }
             //push frame to its queue
-            t_streamProfilesQueues[profileKey].enqueue(frame);
+            queue->second.enqueue(std::move(packet));
             m_prevSample[profileKey] = curSample;
         }
     };
@@ -3,7 +3,8 @@
 
 #pragma once
 
-#include "compression/ICompression.h"
+#include "RsFrameQueue.hh"
+#include "compression/CompressionFactory.h"
 #include <chrono>
 #include <ipDeviceCommon/MemoryPool.h>
 #include <librealsense2/hpp/rs_types.hpp>
@@ -16,19 +17,50 @@ typedef struct RsOption
     rs2::option_range m_range;
 } RsOption;
 
+// JPEG quality of a stream in adaptive mode, lowered while the measured bitrate of the compressed frames exceeds the bandwidth budget
+typedef struct RsAdaptiveQuality
+{
+    int m_quality;
+    int m_maxQuality;
+    int m_bandwidth;
+    size_t m_windowBytes;
+    std::chrono::high_resolution_clock::time_point m_windowStart;
+} RsAdaptiveQuality;
+
+// JPEG quality of a stream lowered by the congestion of its clients, before its frames are dropped
+typedef struct RsCongestionQuality
+{
+    int m_quality; // chosen by the client
+    int m_level; // congestion level applied to the codec
+} RsCongestionQuality;
+
+// Motion samples of a stream waiting to be sent together, the buffer holds the header of the batch followed by the samples
+typedef struct RsImuBatch
+{
+    std::shared_ptr<unsigned char> m_data;
+    int m_count = 0;
+    double m_firstTimestamp = 0;
+} RsImuBatch;
+
 class RsSensor
 {
 public:
     RsSensor(UsageEnvironment* t_env, rs2::sensor t_sensor, rs2::device t_device);
-    int open(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues);
-    int start(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfilesQueues);
+    int open(std::unordered_map<long long int, RsFrameQueue>& t_streamProfilesQueues);
+    int start(std::unordered_map<long long int, RsFrameQueue>& t_streamProfilesQueues);
+    // Codec of the stream from the next open, the default codec is used for the streams without one
+    void setStreamCompression(long long int t_streamProfileKey, const CompressionConfig& t_compression);
+    CompressionConfig getStreamCompression(long long int t_streamProfileKey);
+    // The streams coded from the previous frames send a key frame next, for a client joining them
+    void requestKeyFrames();
     int close();
     int stop();
     rs2::sensor& getRsSensor()
     {
         return m_sensor;
     }
-    std::unordered_map<long long int, rs2::video_stream_profile> getStreamProfiles()
+    // Video and motion stream profiles of the sensor
+    std::unordered_map<long long int, rs2::stream_profile> getStreamProfiles()
     {
         return m_streamProfiles;
     }
@@ -42,10 +74,19 @@ public:
     std::vector<RsOption> getSupportedOptions();
 
 private:
+    void adaptQuality(RsAdaptiveQuality& t_adaptiveQuality, ICompression& t_compression, int t_frameSize);
+    // Caps the quality of the stream for the congestion level, returns the levels the quality can take before frames are dropped
+    int applyCongestion(long long int t_profileKey, RsCongestionQuality& t_congestion, int t_level);
+    void addImuSample(RsImuBatch& t_batch, const rs2::frame& t_frame, RsFrameQueue& t_queue);
+
     UsageEnvironment* env;
     rs2::sensor m_sensor;
-    std::unordered_map<long long int, rs2::video_stream_profile> m_streamProfiles;
+    std::unordered_map<long long int, rs2::stream_profile> m_streamProfiles;
     std::unordered_map<long long int, std::shared_ptr<ICompression>> m_iCompress;
+    std::unordered_map<long long int, CompressionConfig> m_compressionConfigs;
+    std::unordered_map<long long int, RsAdaptiveQuality> m_adaptiveQuality;
+    std::unordered_map<long long int, RsCongestionQuality> m_congestionQuality;
+    std::unordered_map<long long int, RsImuBatch> m_imuBatches;
     rs2::device m_device;
     MemoryPool* m_memPool;
     std::unordered_map<long long int, std::chrono::high_resolution_clock::time_point> m_prevSample;
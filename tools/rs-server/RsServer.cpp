@@ -20,14 +20,12 @@
 
 using namespace TCLAP;
 
+// Every camera is served by an RTSP server of its own, on consecutive ports from the first one, all of them on the same event loop
 struct server
 {
-    rs2::device selected_device;
-    RsRTSPServer* rtspServer;
+    std::vector<RsRTSPServer*> rtspServers;
     UsageEnvironment* env;
-    std::shared_ptr<RsDevice> rsDevice;
-    std::vector<rs2::video_stream_profile> supported_stream_profiles; // streams for extrinsics map creation
-    std::vector<RsSensor> sensors;
+    std::vector<std::shared_ptr<RsDevice>> rsDevices;
     TaskScheduler* scheduler;
     unsigned int port = 8554;
 
@@ -41,11 +39,17 @@ struct server
 
         SwitchArg arg_enable_compression("c", "enable-compression", "Enable video compression");
         ValueArg<std::string> arg_address("i", "interface-address", "Address of the interface to bind on", false, "", "string");
-        ValueArg<unsigned int> arg_port("p", "port", "RTSP port to listen on", false, 8554, "integer");
+        ValueArg<unsigned int> arg_port("p", "port", "RTSP port to listen on, the next cameras are served on the next ports", false, 8554, "integer");
+        MultiArg<std::string> arg_serials("s", "serial", "Serial number of a camera to serve, in the order of the ports. All the connected cameras by default", false, "string");
+        ValueArg<unsigned int> arg_pacing_rate("r", "pacing-rate", "Maximal rate of each stream in kbps, the packets of a frame are spread at this rate instead of sent in a burst", false, 0, "integer");
+        ValueArg<unsigned int> arg_send_buffer("b", "send-buffer", "Send buffer of the socket of each stream in KB", false, 0, "integer");
 
         cmd.add(arg_enable_compression);
         cmd.add(arg_address);
         cmd.add(arg_port);
+        cmd.add(arg_serials);
+        cmd.add(arg_pacing_rate);
+        cmd.add(arg_send_buffer);
 
         cmd.parse(argc, argv);
 
@@ -64,6 +68,9 @@ struct server
         {
             port = arg_port.getValue();
         }
+
+        RsServerMediaSubsession::getPacingRate() = arg_pacing_rate.getValue();
+        RsServerMediaSubsession::getSendBufferSize() = arg_send_buffer.getValue();
         
         OutPacketBuffer::increaseMaxSizeTo(MAX_MESSAGE_SIZE);
         
@@ -71,20 +78,32 @@ struct server
         scheduler = BasicTaskScheduler::createNew();
         env = RSUsageEnvironment::createNew(*scheduler);
 
-        rsDevice = std::make_shared<RsDevice>(env);
-        rtspServer = RsRTSPServer::createNew(*env, rsDevice, port);
-
-        if(rtspServer == NULL)
+        rsDevices = RsDevice::createDevices(env, arg_serials.getValue());
+        for(size_t i = 0; i < rsDevices.size(); i++)
         {
-            *env << "Failed to create RTSP server: " << env->getResultMsg() << "\n";
-            exit(1);
+            RsRTSPServer* rtspServer = RsRTSPServer::createNew(*env, rsDevices[i], port + i);
+            if(rtspServer == NULL)
+            {
+                *env << "Failed to create RTSP server: " << env->getResultMsg() << "\n";
+                exit(1);
+            }
+            rtspServers.push_back(rtspServer);
+
+            *env << "Serving camera " << rsDevices[i]->getDevice().get_info(RS2_CAMERA_INFO_SERIAL_NUMBER) << " on port " << port + i << "\n";
+            addDevice(rsDevices[i], rtspServer);
         }
 
-        sensors = rsDevice.get()->getSensors();
+        env->taskScheduler().doEventLoop(); // does not return
+    }
+
+    void addDevice(std::shared_ptr<RsDevice> rsDevice, RsRTSPServer* rtspServer)
+    {
+        std::vector<rs2::stream_profile> supported_stream_profiles; // streams for extrinsics map creation
+        std::vector<RsSensor> sensors = rsDevice.get()->getSensors();
         for(auto sensor : sensors)
         {
             RsServerMediaSession* sms;
-            if(sensor.getSensorName().compare(STEREO_SENSOR_NAME) == 0 || sensor.getSensorName().compare(RGB_SENSOR_NAME) == 0)
+            if(sensor.getSensorName().compare(STEREO_SENSOR_NAME) == 0 || sensor.getSensorName().compare(RGB_SENSOR_NAME) == 0 || sensor.getSensorName().compare(MOTION_SENSOR_NAME) == 0)
             {
                 sms = RsServerMediaSession::createNew(*env, sensor, sensor.getSensorName().data(), "", "Session streamed by \"realsense streamer\"", False);
             }
@@ -95,7 +114,14 @@ struct server
 
             for(auto stream_profile : sensor.getStreamProfiles())
             {
-                rs2::video_stream_profile stream = stream_profile.second;
+                if(stream_profile.second.is<rs2::motion_stream_profile>())
+                {
+                    // gyro and accel samples are sent in batches
+                    sms->addSubsession(RsServerMediaSubsession::createNew(*env, stream_profile.second, rsDevice));
+                    supported_stream_profiles.push_back(stream_profile.second);
+                    continue;
+                }
+                rs2::video_stream_profile stream = stream_profile.second.as<rs2::video_stream_profile>();
                 if(stream.format() == RS2_FORMAT_BGR8 
                 || stream.format() == RS2_FORMAT_RGB8 
                 || stream.format() == RS2_FORMAT_Z16 
@@ -190,7 +216,7 @@ struct server
                 *env << "Ignoring stream: format: " << stream.format() << " width: " << stream.width() << " height: " << stream.height() << " fps: " << stream.fps() << "\n";
             }
 
-            calculate_extrinsics();
+            calculate_extrinsics(rsDevice, supported_stream_profiles);
 
             rtspServer->addServerMediaSession(sms);
             char* url = rtspServer->rtspURL(sms);
@@ -201,11 +227,9 @@ struct server
 
             delete[] url;
         }
-
-        env->taskScheduler().doEventLoop(); // does not return
     }
 
-    void calculate_extrinsics()
+    void calculate_extrinsics(std::shared_ptr<RsDevice> rsDevice, const std::vector<rs2::stream_profile>& supported_stream_profiles)
     {
         for(auto stream_profile_from : supported_stream_profiles)
         {
@@ -221,7 +245,10 @@ struct server
 
     void sigint_handler(int sig)
     {
-        Medium::close(rtspServer);
+        for(auto rtspServer : rtspServers)
+        {
+            Medium::close(rtspServer);
+        }
         env->reclaim();
         env = NULL;
         delete scheduler;
@@ -3,6 +3,8 @@
 
 #include "RsServerMediaSession.h"
 
+#include <stdexcept>
+
 // ServerMediaSession
 
 RsServerMediaSession* RsServerMediaSession ::createNew(UsageEnvironment& t_env, RsSensor& t_sensor, char const* t_streamName, char const* t_info, char const* t_description, Boolean t_isSSM, char const* t_miscSDPLines)
@@ -13,30 +15,73 @@ RsServerMediaSession* RsServerMediaSession ::createNew(UsageEnvironment& t_env,
 RsServerMediaSession::RsServerMediaSession(UsageEnvironment& t_env, RsSensor& t_sensor, char const* t_streamName, char const* t_info, char const* t_description, Boolean t_isSSM, char const* t_miscSDPLines)
     : ServerMediaSession(t_env, t_streamName, t_info, t_description, t_isSSM, t_miscSDPLines)
     , m_rsSensor(t_sensor)
-    , m_isActive(false)
+    , m_playingClients(0)
 {}
 
 RsServerMediaSession::~RsServerMediaSession() {}
 
-void RsServerMediaSession::openRsCamera(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles)
+bool RsServerMediaSession::addStreamClient(long long int t_streamProfileKey, const CompressionConfig& t_compression)
+{
+    int& clients = m_streamClients[t_streamProfileKey];
+    if(clients > 0)
+    {
+        CompressionConfig current = m_rsSensor.getStreamCompression(t_streamProfileKey);
+        if(current.zipMethod != t_compression.zipMethod || current.quality != t_compression.quality || current.bandwidth != t_compression.bandwidth || current.bitrate != t_compression.bitrate)
+        {
+            envir() << "stream is sent with codec '" << CompressionFactory::configToString(current).c_str() << "' to other clients\n";
+            return false;
+        }
+    }
+    else
+    {
+        m_rsSensor.setStreamCompression(t_streamProfileKey, t_compression);
+    }
+    ++clients;
+    return true;
+}
+
+void RsServerMediaSession::removeStreamClient(long long int t_streamProfileKey)
+{
+    auto clients = m_streamClients.find(t_streamProfileKey);
+    if(clients != m_streamClients.end() && --clients->second <= 0)
+    {
+        m_streamClients.erase(clients);
+    }
+}
+
+void RsServerMediaSession::openRsCamera(const std::unordered_map<long long int, RsFrameQueue>& t_streamProfiles)
 {
-    if(m_isActive)
+    if(m_playingClients > 0)
     {
-        envir() << "sensor is already open, closing sensor and than open again...\n";
-        closeRsCamera();
+        for(const auto& streamProfile : t_streamProfiles)
+        {
+            if(m_streamProfiles.find(streamProfile.first) == m_streamProfiles.end())
+            {
+                throw std::runtime_error("sensor is streaming other profiles to another client");
+            }
+        }
+        envir() << "sensor is already streaming, joining " << m_playingClients << " other clients\n";
+        m_rsSensor.requestKeyFrames();
+        ++m_playingClients;
+        return;
     }
-    m_rsSensor.open(t_streamProfiles);
-    m_rsSensor.start(t_streamProfiles);
-    m_isActive = true;
+    m_streamProfiles = t_streamProfiles;
+    m_rsSensor.open(m_streamProfiles);
+    m_rsSensor.start(m_streamProfiles);
+    m_playingClients = 1;
 }
 
 void RsServerMediaSession::closeRsCamera()
 {
-    if(m_isActive)
+    if(m_playingClients > 0 && --m_playingClients == 0)
     {
         m_rsSensor.getRsSensor().stop();
         m_rsSensor.getRsSensor().close();
-        m_isActive = false;
+        for(auto& streamProfile : m_streamProfiles)
+        {
+            streamProfile.second.clear();
+        }
+        m_streamProfiles.clear();
     }
 }
 
@@ -11,7 +11,13 @@ class RsServerMediaSession : public ServerMediaSession
 public:
     static RsServerMediaSession* createNew(UsageEnvironment& t_env, RsSensor& t_sensor, char const* t_streamName = NULL, char const* t_info = NULL, char const* t_description = NULL, Boolean t_isSSM = False, char const* t_miscSDPLines = NULL);
     RsSensor& getRsSensor();
-    void openRsCamera(std::unordered_map<long long int, rs2::frame_queue>& t_streamProfiles);
+    // Registers a client session that set up the stream. The first client chooses the codec of the stream,
+    // the frames are coded once and sent to all the clients, so the next clients must use the same codec
+    bool addStreamClient(long long int t_streamProfileKey, const CompressionConfig& t_compression);
+    void removeStreamClient(long long int t_streamProfileKey);
+    // The first playing client opens the sensor with its streams, the next clients join if the sensor streams all their streams
+    void openRsCamera(const std::unordered_map<long long int, RsFrameQueue>& t_streamProfiles);
+    // The sensor is closed when its last playing client leaves
     void closeRsCamera();
 
 protected:
@@ -20,5 +26,8 @@ protected:
 
 private:
     RsSensor m_rsSensor;
-    bool m_isActive;
+    // streams of the open sensor, the frame callback of the sensor holds a reference to it
+    std::unordered_map<long long int, RsFrameQueue> m_streamProfiles;
+    std::unordered_map<long long int, int> m_streamClients;
+    int m_playingClients;
 };
@@ -5,41 +5,74 @@
 #include "RsCommon.h"
 #include "RsServerMediaSession.h"
 #include "RsSimpleRTPSink.h"
+#include <GroupsockHelper.hh>
+#include <sys/socket.h>
 
 #define CAPACITY 100
 
-RsServerMediaSubsession* RsServerMediaSubsession::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice)
+RsServerMediaSubsession* RsServerMediaSubsession::createNew(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, std::shared_ptr<RsDevice> rsDevice)
 {
-    return new RsServerMediaSubsession(t_env, t_videoStreamProfile, rsDevice);
+    return new RsServerMediaSubsession(t_env, t_streamProfile, rsDevice);
 }
 
-RsServerMediaSubsession ::RsServerMediaSubsession(UsageEnvironment& env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> device)
-    : OnDemandServerMediaSubsession(env, false)
-    , m_videoStreamProfile(t_videoStreamProfile)
+RsServerMediaSubsession ::RsServerMediaSubsession(UsageEnvironment& env, rs2::stream_profile& t_streamProfile, std::shared_ptr<RsDevice> device)
+    : OnDemandServerMediaSubsession(env, true) // the source and RTP sink of the stream are shared by all the clients
+    , m_streamProfile(t_streamProfile)
 {
-    m_frameQueue = rs2::frame_queue(CAPACITY, true);
+    m_frameQueue = RsFrameQueue(CAPACITY);
     m_rsDevice = device;
 }
 
 RsServerMediaSubsession::~RsServerMediaSubsession() {}
 
-rs2::frame_queue& RsServerMediaSubsession::getFrameQueue()
+RsFrameQueue& RsServerMediaSubsession::getFrameQueue()
 {
     return m_frameQueue;
 }
 
-rs2::video_stream_profile RsServerMediaSubsession::getStreamProfile()
+rs2::stream_profile RsServerMediaSubsession::getStreamProfile()
 {
-    return m_videoStreamProfile;
+    return m_streamProfile;
+}
+
+unsigned& RsServerMediaSubsession::getPacingRate()
+{
+    static unsigned pacingRate = 0;
+    return pacingRate;
+}
+
+unsigned& RsServerMediaSubsession::getSendBufferSize()
+{
+    static unsigned sendBufferSize = 0;
+    return sendBufferSize;
 }
 
 FramedSource* RsServerMediaSubsession::createNewStreamSource(unsigned /*t_clientSessionId*/, unsigned& t_estBitrate)
 {
     t_estBitrate = 20000;
-    return RsDeviceSource::createNew(envir(), m_videoStreamProfile, m_frameQueue);
+    return RsDeviceSource::createNew(envir(), m_streamProfile, m_frameQueue);
 }
 
 RTPSink* RsServerMediaSubsession ::createNewRTPSink(Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadTypeIfDynamic, FramedSource* /*t_inputSource*/)
 {
-    return RsSimpleRTPSink::createNew(envir(), t_rtpGroupsock, 96 + m_videoStreamProfile.stream_type(), RTP_TIMESTAMP_FREQ, RS_MEDIA_TYPE.c_str(), RS_PAYLOAD_FORMAT.c_str(), m_videoStreamProfile, m_rsDevice);
+    // the batches of motion samples are smaller than a packet, each of them is sent in its own packet for the client to split them
+    Boolean allowMultipleFramesPerPacket = !m_streamProfile.is<rs2::motion_stream_profile>();
+
+    // The packets of a frame are sent back to back, a large frame leaves in a burst that overflows the buffers of the switches and of
+    // the receiver. The kernel spreads the packets of the socket at the pacing rate, with the fq queueing discipline on the interface.
+    // The streams sent over TCP share the RTSP connection and are paced by TCP
+    int socketNum = t_rtpGroupsock->socketNum();
+    unsigned sendBufferSize = getSendBufferSize() * 1024;
+    if(sendBufferSize > 0 && increaseSendBufferTo(envir(), socketNum, sendBufferSize) < sendBufferSize)
+    {
+        envir() << "Socket send buffer limited by the system, e.g. net.core.wmem_max\n";
+    }
+#ifdef SO_MAX_PACING_RATE
+    unsigned pacingRate = getPacingRate() * 1000 / 8; // bytes per second
+    if(pacingRate > 0 && setsockopt(socketNum, SOL_SOCKET, SO_MAX_PACING_RATE, &pacingRate, sizeof(pacingRate)) < 0)
+    {
+        envir() << "Failed to set the pacing rate of the stream socket\n";
+    }
+#endif
+    return RsSimpleRTPSink::createNew(envir(), t_rtpGroupsock, 96 + m_streamProfile.stream_type(), RTP_TIMESTAMP_FREQ, RS_MEDIA_TYPE.c_str(), RS_PAYLOAD_FORMAT.c_str(), m_streamProfile, m_rsDevice, m_frameQueue, 1, allowMultipleFramesPerPacket);
 }
\ No newline at end of file
@@ -15,18 +15,21 @@
 class RsServerMediaSubsession : public OnDemandServerMediaSubsession
 {
 public:
-    static RsServerMediaSubsession* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, std::shared_ptr<RsDevice> rsDevice);
-    rs2::frame_queue& getFrameQueue();
-    rs2::video_stream_profile getStreamProfile();
+    static RsServerMediaSubsession* createNew(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, std::shared_ptr<RsDevice> rsDevice);
+    RsFrameQueue& getFrameQueue();
+    rs2::stream_profile getStreamProfile();
+    // Kernel pacing rate of the RTP socket of each stream in kbps and its send buffer in KB, 0 keeps the setting of the system
+    static unsigned& getPacingRate();
+    static unsigned& getSendBufferSize();
 
 protected:
-    RsServerMediaSubsession(UsageEnvironment& t_env, rs2::video_stream_profile& t_video_stream_profile, std::shared_ptr<RsDevice> device);
+    RsServerMediaSubsession(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, std::shared_ptr<RsDevice> device);
     virtual ~RsServerMediaSubsession();
     virtual FramedSource* createNewStreamSource(unsigned t_clientSessionId, unsigned& t_estBitrate);
     virtual RTPSink* createNewRTPSink(Groupsock* t_rtpGroupsock, unsigned char t_rtpPayloadTypeIfDynamic, FramedSource* t_inputSource);
 
 private:
-    rs2::video_stream_profile m_videoStreamProfile;
-    rs2::frame_queue m_frameQueue;
+    rs2::stream_profile m_streamProfile;
+    RsFrameQueue m_frameQueue;
     std::shared_ptr<RsDevice> m_rsDevice;
 };
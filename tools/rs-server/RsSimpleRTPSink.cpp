@@ -15,14 +15,15 @@ RsSimpleRTPSink* RsSimpleRTPSink::createNew(UsageEnvironment& t_env,
                                             unsigned t_rtpTimestampFrequency,
                                             char const* t_sdpMediaTypeString,
                                             char const* t_rtpPayloadFormatName,
-                                            rs2::video_stream_profile& t_videoStream,
+                                            rs2::stream_profile& t_stream,
                                             std::shared_ptr<RsDevice> device,
+                                            RsFrameQueue& t_queue,
                                             unsigned t_numChannels,
                                             Boolean t_allowMultipleFramesPerPacket,
                                             Boolean t_doNormalMBitRule)
 {
     CompressionFactory::getIsEnabled() = IS_COMPRESSION_ENABLED;
-    return new RsSimpleRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_videoStream, device, t_numChannels, t_allowMultipleFramesPerPacket, t_doNormalMBitRule);
+    return new RsSimpleRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_stream, device, t_queue, t_numChannels, t_allowMultipleFramesPerPacket, t_doNormalMBitRule);
 }
 
 std::string getSdpLineForField(const char* t_name, int t_val)
@@ -60,7 +61,7 @@ std::string extrinsics_to_string(rs2_extrinsics extrinsics)
     return str;
 }
 
-std::string get_extrinsics_string_per_stream(std::shared_ptr<RsDevice> device, rs2::video_stream_profile stream)
+std::string get_extrinsics_string_per_stream(std::shared_ptr<RsDevice> device, rs2::stream_profile stream)
 {
 
     if(device == nullptr)
@@ -85,33 +86,41 @@ std::string get_extrinsics_string_per_stream(std::shared_ptr<RsDevice> device, r
     return str;
 }
 
-std::string getSdpLineForVideoStream(rs2::video_stream_profile& t_videoStream, std::shared_ptr<RsDevice> device)
+// Motion streams are described with a zero size and without intrinsics
+std::string getSdpLineForStream(rs2::stream_profile& t_stream, std::shared_ptr<RsDevice> device)
 {
     std::string str;
-    str.append(getSdpLineForField("width", t_videoStream.width()));
-    str.append(getSdpLineForField("height", t_videoStream.height()));
-    str.append(getSdpLineForField("format", t_videoStream.format()));
-    str.append(getSdpLineForField("uid", t_videoStream.unique_id()));
-    str.append(getSdpLineForField("fps", t_videoStream.fps()));
-    str.append(getSdpLineForField("stream_index", t_videoStream.stream_index()));
-    str.append(getSdpLineForField("stream_type", t_videoStream.stream_type()));
-    str.append(getSdpLineForField("bpp", RsSensor::getStreamProfileBpp(t_videoStream.format())));
+    bool isVideo = t_stream.is<rs2::video_stream_profile>();
+    rs2_intrinsics intrinsics = {};
+    if(isVideo)
+    {
+        intrinsics = t_stream.as<rs2::video_stream_profile>().get_intrinsics();
+    }
+    str.append(getSdpLineForField("width", intrinsics.width));
+    str.append(getSdpLineForField("height", intrinsics.height));
+    str.append(getSdpLineForField("format", t_stream.format()));
+    str.append(getSdpLineForField("uid", t_stream.unique_id()));
+    str.append(getSdpLineForField("fps", t_stream.fps()));
+    str.append(getSdpLineForField("stream_index", t_stream.stream_index()));
+    str.append(getSdpLineForField("stream_type", t_stream.stream_type()));
+    str.append(getSdpLineForField("bpp", RsSensor::getStreamProfileBpp(t_stream.format())));
     str.append(getSdpLineForField("cam_serial_num", device.get()->getDevice().get_info(RS2_CAMERA_INFO_SERIAL_NUMBER)));
     str.append(getSdpLineForField("usb_type", device.get()->getDevice().get_info(RS2_CAMERA_INFO_USB_TYPE_DESCRIPTOR)));
     str.append(getSdpLineForField("compression", CompressionFactory::getIsEnabled()));
+    str.append(getSdpLineForField("codecs", CompressionFactory::getSupportedCodecs(t_stream.format(), t_stream.stream_type()).c_str()));
 
-    str.append(getSdpLineForField("ppx", t_videoStream.get_intrinsics().ppx));
-    str.append(getSdpLineForField("ppy", t_videoStream.get_intrinsics().ppy));
-    str.append(getSdpLineForField("fx", t_videoStream.get_intrinsics().fx));
-    str.append(getSdpLineForField("fy", t_videoStream.get_intrinsics().fy));
-    str.append(getSdpLineForField("model", t_videoStream.get_intrinsics().model));
+    str.append(getSdpLineForField("ppx", intrinsics.ppx));
+    str.append(getSdpLineForField("ppy", intrinsics.ppy));
+    str.append(getSdpLineForField("fx", intrinsics.fx));
+    str.append(getSdpLineForField("fy", intrinsics.fy));
+    str.append(getSdpLineForField("model", intrinsics.model));
 
     for(size_t i = 0; i < 5; i++)
     {
-        str.append(getSdpLineForField("coeff_" + i, t_videoStream.get_intrinsics().coeffs[i]));
+        str.append(getSdpLineForField("coeff_" + i, intrinsics.coeffs[i]));
     }
 
-    str.append(getSdpLineForField("extrinsics", get_extrinsics_string_per_stream(device, t_videoStream).c_str()));
+    str.append(getSdpLineForField("extrinsics", get_extrinsics_string_per_stream(device, t_stream).c_str()));
 
     std::string name = device.get()->getDevice().get_info(RS2_CAMERA_INFO_NAME);
     // We don't want to sent spaces over SDP , replace all spaces with '^'
@@ -127,18 +136,61 @@ RsSimpleRTPSink ::RsSimpleRTPSink(UsageEnvironment& t_env,
                                   unsigned t_rtpTimestampFrequency,
                                   char const* t_sdpMediaTypeString,
                                   char const* t_rtpPayloadFormatName,
-                                  rs2::video_stream_profile& t_videoStream,
+                                  rs2::stream_profile& t_stream,
                                   std::shared_ptr<RsDevice> device,
+                                  RsFrameQueue& t_queue,
                                   unsigned t_numChannels,
                                   Boolean t_allowMultipleFramesPerPacket,
                                   Boolean t_doNormalMBitRule)
     : SimpleRTPSink(t_env, t_RTPgs, t_rtpPayloadFormat, t_rtpTimestampFrequency, t_sdpMediaTypeString, t_rtpPayloadFormatName, t_numChannels, t_allowMultipleFramesPerPacket, t_doNormalMBitRule)
+    , m_frameQueue(t_queue)
 {
     // Then use this 'config' string to construct our "a=fmtp:" SDP line:
     unsigned fmtpSDPLineMaxSize = SDP_MAX_LINE_LENGHT;
     m_fFmtpSDPLine = new char[fmtpSDPLineMaxSize];
-    std::string sdpStr = getSdpLineForVideoStream(t_videoStream, device);
+    std::string sdpStr = getSdpLineForStream(t_stream, device);
     sprintf(m_fFmtpSDPLine, "a=fmtp:%d;%s\r\n", rtpPayloadType(), sdpStr.c_str());
+
+    m_pacingTask = envir().taskScheduler().scheduleDelayedTask(RS_PACING_INTERVAL_MS * 1000, (TaskFunc*)updatePacing, this);
+}
+
+RsSimpleRTPSink::~RsSimpleRTPSink()
+{
+    envir().taskScheduler().unscheduleDelayedTask(m_pacingTask);
+    delete[] m_fFmtpSDPLine;
+}
+
+void RsSimpleRTPSink::updatePacing(RsSimpleRTPSink* t_sink)
+{
+    t_sink->handleUpdatePacing();
+}
+
+void RsSimpleRTPSink::handleUpdatePacing()
+{
+    // The fraction lost of a receiver report covers the packets since the previous report of the client
+    double lossRatio = -1;
+    RTPTransmissionStatsDB::Iterator clients(transmissionStatsDB());
+    RTPTransmissionStats* stats;
+    while((stats = clients.next()) != NULL)
+    {
+        u_int32_t& reportedPacket = m_reportedPackets[stats->SSRC()];
+        if(stats->lastPacketNumReceived() == reportedPacket)
+        {
+            continue;
+        }
+        reportedPacket = stats->lastPacketNumReceived();
+        lossRatio = std::max(lossRatio, stats->packetLossRatio() / 256.0);
+    }
+
+    RsStreamPacing& pacing = m_frameQueue.getPacing();
+    int level = pacing.getLevel();
+    pacing.update(m_frameQueue.size(), lossRatio);
+    if(pacing.getLevel() != level)
+    {
+        envir() << "stream " << rtpPayloadType() << ": congestion level " << pacing.getLevel() << "\n";
+    }
+
+    m_pacingTask = envir().taskScheduler().scheduleDelayedTask(RS_PACING_INTERVAL_MS * 1000, (TaskFunc*)updatePacing, this);
 }
 
 char const* RsSimpleRTPSink::auxSDPLine()
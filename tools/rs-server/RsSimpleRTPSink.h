@@ -4,9 +4,12 @@
 #pragma once
 
 #include "RsDevice.hh"
+#include "RsFrameQueue.hh"
 #include "liveMedia.hh"
 #include <librealsense2/hpp/rs_internal.hpp>
 
+#include <map>
+
 class RsSimpleRTPSink : public SimpleRTPSink
 {
 public:
@@ -16,8 +19,9 @@ public:
                                       unsigned rtpTimestampFrequency,
                                       char const* sdpMediaTypeString,
                                       char const* rtpPayloadFormatName,
-                                      rs2::video_stream_profile& video_stream,
+                                      rs2::stream_profile& stream,
                                       std::shared_ptr<RsDevice> device,
+                                      RsFrameQueue& queue,
                                       unsigned numChannels = 1,
                                       Boolean allowMultipleFramesPerPacket = True,
                                       Boolean doNormalMBitRule = True);
@@ -29,13 +33,24 @@ protected:
                     unsigned rtpTimestampFrequency,
                     char const* sdpMediaTypeString,
                     char const* rtpPayloadFormatName,
-                    rs2::video_stream_profile& video_stream,
+                    rs2::stream_profile& stream,
                     std::shared_ptr<RsDevice> device,
+                    RsFrameQueue& queue,
                     unsigned numChannels = 1,
                     Boolean allowMultipleFramesPerPacket = True,
                     Boolean doNormalMBitRule = True);
+    virtual ~RsSimpleRTPSink();
 
 private:
+    // Updates the pacing of the stream from its queue and the receiver reports of its clients, every RS_PACING_INTERVAL_MS
+    static void updatePacing(RsSimpleRTPSink* t_sink);
+    void handleUpdatePacing();
+
     char* m_fFmtpSDPLine;
     virtual char const* auxSDPLine(); // for the "a=fmtp:" SDP line
+
+    RsFrameQueue m_frameQueue;
+    TaskToken m_pacingTask;
+    // last packet reported by each client, by its SSRC, a client is only accounted for when it sent a new report
+    std::map<u_int32_t, u_int32_t> m_reportedPackets;
 };
@@ -6,21 +6,22 @@
 #include "RsStatistics.h"
 #include <GroupsockHelper.hh>
 #include <cassert>
+#include <chrono>
 #include <compression/CompressionFactory.h>
 #include <ipDeviceCommon/RsCommon.h>
 #include <ipDeviceCommon/Statistic.h>
 #include <librealsense2/h/rs_sensor.h>
 
-RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+RsDeviceSource* RsDeviceSource::createNew(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, RsFrameQueue& t_queue)
 {
-    return new RsDeviceSource(t_env, t_videoStreamProfile, t_queue);
+    return new RsDeviceSource(t_env, t_streamProfile, t_queue);
 }
 
-RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue)
+RsDeviceSource::RsDeviceSource(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, RsFrameQueue& t_queue)
     : FramedSource(t_env)
 {
     m_framesQueue = &t_queue;
-    m_streamProfile = &t_videoStreamProfile;
+    m_streamProfile = &t_streamProfile;
 }
 
 RsDeviceSource::~RsDeviceSource() {}
@@ -29,17 +30,16 @@ void RsDeviceSource::doGetNextFrame()
 {
     // This function is called (by our 'downstream' object) when it asks for new data.
 
-    rs2::frame frame;
+    RsFramePacket packet;
     try
     {
-        if(!m_framesQueue->poll_for_frame(&frame))
+        if(!m_framesQueue->pollForPacket(packet))
         {
             nextTask() = envir().taskScheduler().scheduleDelayedTask(0, (TaskFunc*)waitForFrame, this);
         }
         else
         {
-            frame.keep();
-            deliverRSFrame(&frame);
+            deliverRSFrame(packet);
         }
     }
     catch(const std::exception& e)
@@ -51,17 +51,16 @@ void RsDeviceSource::doGetNextFrame()
 void RsDeviceSource::handleWaitForFrame()
 {
     // If a new frame of data is immediately available to be delivered, then do this now:
-    rs2::frame frame;
+    RsFramePacket packet;
     try
     {
-        if(!(getFramesQueue()->poll_for_frame(&frame)))
+        if(!(getFramesQueue()->pollForPacket(packet)))
         {
             nextTask() = envir().taskScheduler().scheduleDelayedTask(0, (TaskFunc*)RsDeviceSource::waitForFrame, this);
         }
         else
         {
-            frame.keep();
-            deliverRSFrame(&frame);
+            deliverRSFrame(packet);
         }
     }
     catch(const std::exception& e)
@@ -76,59 +75,73 @@ void RsDeviceSource::waitForFrame(RsDeviceSource* t_deviceSource)
     t_deviceSource->handleWaitForFrame();
 }
 
-void RsDeviceSource::deliverRSFrame(rs2::frame* t_frame)
+void fillFrameHeader(const rs2::frame& t_frame, unsigned t_dataSize, RsFrameHeader& t_header)
 {
-    if(!isCurrentlyAwaitingData())
+    t_header.networkHeader.data.frameSize = t_dataSize + sizeof(RsMetadataHeader);
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
     {
-        envir() << "isCurrentlyAwaitingData returned false\n";
-        return; // we're not ready for the data yet
-    }
-
-    unsigned newFrameSize = t_frame->get_data_size();
-
-    gettimeofday(&fPresentationTime, NULL); // If you have a more accurate time - e.g., from an encoder - then use that instead.
-    RsFrameHeader header;
-    unsigned char* data;
-    if(CompressionFactory::isCompressionSupported(t_frame->get_profile().format(), t_frame->get_profile().stream_type()))
-    {
-        fFrameSize = ((int*)t_frame->get_data())[0];
-        data = (unsigned char*)t_frame->get_data() + sizeof(int);
+        t_header.metadataHeader.data.timestamp = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
     }
     else
     {
-        fFrameSize = t_frame->get_data_size();
-        data = (unsigned char*)t_frame->get_data();
+        t_header.metadataHeader.data.timestamp = t_frame.get_timestamp();
     }
-    memmove(fTo + sizeof(RsFrameHeader), data, fFrameSize);
-    fFrameSize += sizeof(RsMetadataHeader);
-    header.networkHeader.data.frameSize = fFrameSize;
-    fFrameSize += sizeof(RsNetworkHeader);
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP))
+
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
     {
-        header.metadataHeader.data.timestamp = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_TIMESTAMP) / 1000;
+        t_header.metadataHeader.data.frameCounter = t_frame.get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
     }
     else
     {
-        header.metadataHeader.data.timestamp = t_frame->get_timestamp();
+        t_header.metadataHeader.data.frameCounter = t_frame.get_frame_number();
     }
 
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER))
+    if(t_frame.supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
     {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_metadata(RS2_FRAME_METADATA_FRAME_COUNTER);
+        t_header.metadataHeader.data.actualFps = t_frame.get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
     }
-    else
+
+    t_header.metadataHeader.data.timestampDomain = t_frame.get_frame_timestamp_domain();
+
+    t_header.metadataHeader.data.metadataMask = 0;
+    for(int i = 0; i < RS2_FRAME_METADATA_COUNT; i++)
     {
-        header.metadataHeader.data.frameCounter = t_frame->get_frame_number();
+        rs2_frame_metadata_value attribute = static_cast<rs2_frame_metadata_value>(i);
+        if(t_frame.supports_frame_metadata(attribute))
+        {
+            t_header.metadataHeader.data.metadataMask |= uint64_t(1) << i;
+            t_header.metadataHeader.data.metadata[i] = t_frame.get_frame_metadata(attribute);
+        }
     }
+}
 
-    if(t_frame->supports_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS))
+void RsDeviceSource::deliverRSFrame(RsFramePacket& t_packet)
+{
+    if(!isCurrentlyAwaitingData())
     {
-        header.metadataHeader.data.actualFps = t_frame->get_frame_metadata(RS2_FRAME_METADATA_ACTUAL_FPS);
+        envir() << "isCurrentlyAwaitingData returned false\n";
+        return; // we're not ready for the data yet
     }
 
-    header.metadataHeader.data.timestampDomain = t_frame->get_frame_timestamp_domain();
-
-    memmove(fTo, &header, sizeof(header));
+    gettimeofday(&fPresentationTime, NULL); // If you have a more accurate time - e.g., from an encoder - then use that instead.
+    if(t_packet.data != nullptr)
+    {
+        // compressed frames come with their header
+        fFrameSize = t_packet.size;
+        memcpy(fTo, t_packet.data.get(), fFrameSize);
+    }
+    else
+    {
+        RsFrameHeader header;
+        fFrameSize = t_packet.frame.get_data_size();
+        memcpy(fTo + sizeof(RsFrameHeader), t_packet.frame.get_data(), fFrameSize);
+        fillFrameHeader(t_packet.frame, fFrameSize, header);
+        memcpy(fTo, &header, sizeof(header));
+        fFrameSize += sizeof(RsFrameHeader);
+    }
+    RsMetadataHeader* metadataHeader = (RsMetadataHeader*)(fTo + sizeof(RsNetworkHeader));
+    metadataHeader->data.sendTime = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+    metadataHeader->data.sequenceNumber = m_sequenceNumber++;
 
     // After delivering the data, inform the reader that it is now available:
     FramedSource::afterGetting(this);
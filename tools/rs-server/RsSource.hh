@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DeviceSource.hh"
+#include "RsFrameQueue.hh"
 
 #include <condition_variable>
 #include <mutex>
@@ -12,23 +13,24 @@
 class RsDeviceSource : public FramedSource
 {
 public:
-    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    static RsDeviceSource* createNew(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, RsFrameQueue& t_queue);
     void handleWaitForFrame();
     static void waitForFrame(RsDeviceSource* t_deviceSource);
 
 protected:
-    RsDeviceSource(UsageEnvironment& t_env, rs2::video_stream_profile& t_videoStreamProfile, rs2::frame_queue& t_queue);
+    RsDeviceSource(UsageEnvironment& t_env, rs2::stream_profile& t_streamProfile, RsFrameQueue& t_queue);
     virtual ~RsDeviceSource();
 
 private:
     virtual void doGetNextFrame();
-    rs2::frame_queue* getFramesQueue()
+    RsFrameQueue* getFramesQueue()
     {
         return m_framesQueue;
     };
-    void deliverRSFrame(rs2::frame* t_frame);
+    void deliverRSFrame(RsFramePacket& t_packet);
 
 private:
-    rs2::frame_queue* m_framesQueue;
-    rs2::video_stream_profile* m_streamProfile;
+    RsFrameQueue* m_framesQueue;
+    rs2::stream_profile* m_streamProfile;
+    uint32_t m_sequenceNumber = 0;
 };
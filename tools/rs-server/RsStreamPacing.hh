@@ -0,0 +1,76 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+// The pacing of a stream is updated on the event loop every interval
+const unsigned RS_PACING_INTERVAL_MS = 500;
+const int RS_PACING_MAX_LEVEL = 8;
+// The stream is congested when more packets than this wait to be sent, or when a client lost more than the high ratio of the packets.
+// It is calm when at most one packet waits and no client lost more than the low ratio
+const size_t RS_PACING_QUEUE_HIGH = 3;
+const double RS_PACING_LOSS_HIGH = 0.05;
+const double RS_PACING_LOSS_LOW = 0.01;
+// A level of congestion is left after this many calm updates in a row
+const int RS_PACING_CALM_UPDATES = 4;
+// JPEG quality taken off the stream by each level of congestion
+const int RS_PACING_QUALITY_STEP = 10;
+
+// Congestion level of a stream, shared by the clients playing it since the stream is coded once and sent to all of them.
+// The event loop raises the level while the packets pile up in the queue of the stream or a client reports losses in its RTCP
+// receiver reports, and lowers it back once the stream is calm. The sensor callback lowers the quality of the lossy codecs first,
+// then keeps one frame of every level + 1, dropping the frames before they are coded so the coded streams keep their references
+class RsStreamPacing
+{
+public:
+    // Called on the event loop with the packets waiting in the queue and the worst fraction of packets lost by a client since the
+    // previous update, negative when no client reported since then
+    void update(size_t t_queueDepth, double t_lossRatio)
+    {
+        int level = m_level;
+        if(t_queueDepth > RS_PACING_QUEUE_HIGH || t_lossRatio > RS_PACING_LOSS_HIGH)
+        {
+            m_level = std::min(RS_PACING_MAX_LEVEL, level + 1);
+            m_calmUpdates = 0;
+        }
+        else if(t_queueDepth <= 1 && t_lossRatio <= RS_PACING_LOSS_LOW)
+        {
+            if(++m_calmUpdates >= RS_PACING_CALM_UPDATES)
+            {
+                m_level = std::max(0, level - 1);
+                m_calmUpdates = 0;
+            }
+        }
+        else
+        {
+            m_calmUpdates = 0;
+        }
+    }
+
+    // Called by the sensor callback for every frame, the levels taken by lowering the quality of the stream do not drop frames
+    bool keepFrame(int t_qualityLevels)
+    {
+        int dropLevels = std::max(0, m_level - t_qualityLevels);
+        return m_frames++ % (dropLevels + 1) == 0;
+    }
+
+    int getLevel() const
+    {
+        return m_level;
+    }
+
+    void reset()
+    {
+        m_level = 0;
+        m_calmUpdates = 0;
+    }
+
+private:
+    std::atomic<int> m_level{0};
+    unsigned m_frames = 0; // sensor callback
+    int m_calmUpdates = 0; // event loop
+};
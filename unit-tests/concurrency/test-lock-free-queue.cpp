@@ -0,0 +1,128 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+// With static linkage, ELPP is initialized by librealsense, so doing it here will
+// create errors. When we're using the shared .so/.dll, the two are separate and we have
+// to initialize ours if we want to use the APIs!
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+// Let Catch define its own main() function
+#define CATCH_CONFIG_MAIN
+#include "../catch.h"
+
+//#cmake:add-file ../../src/concurrency.h
+#include <concurrency.h>
+
+#include <memory>
+#include <vector>
+
+
+TEST_CASE( "lock-free queue drops oldest when full", "[concurrency]" )
+{
+    lock_free_single_consumer_queue< std::unique_ptr< int > > q( 3 );
+    for( int i = 0; i < 10; ++i )
+        q.enqueue( std::unique_ptr< int >( new int( i ) ) );
+
+    CHECK( q.size() == 3 );
+    std::unique_ptr< int > item;
+    for( int i = 7; i < 10; ++i )
+    {
+        REQUIRE( q.try_dequeue( &item ) );
+        CHECK( *item == i );
+    }
+    CHECK( ! q.try_dequeue( &item ) );
+    CHECK( ! q.dequeue( &item, 10 ) );
+}
+
+TEST_CASE( "lock-free queue blocking enqueue keeps every item in order", "[concurrency]" )
+{
+    lock_free_single_consumer_queue< std::unique_ptr< int > > q( 4 );
+    const int n = 10000;
+    std::thread producer( [&]() {
+        for( int i = 0; i < n; ++i )
+            q.blocking_enqueue( std::unique_ptr< int >( new int( i ) ) );
+    } );
+
+    int expected = 0;
+    std::unique_ptr< int > item;
+    while( expected < n && q.dequeue( &item, 1000 ) )
+    {
+        REQUIRE( *item == expected );
+        ++expected;
+    }
+    producer.join();
+    CHECK( expected == n );
+}
+
+TEST_CASE( "lock-free queue clear aborts waiting and rejects new items", "[concurrency]" )
+{
+    lock_free_single_consumer_queue< std::unique_ptr< int > > q( 2 );
+    q.enqueue( std::unique_ptr< int >( new int( 1 ) ) );
+    q.clear();
+    CHECK( q.size() == 0 );
+
+    q.enqueue( std::unique_ptr< int >( new int( 2 ) ) );
+    CHECK( q.size() == 0 );
+
+    q.start();
+    q.enqueue( std::unique_ptr< int >( new int( 3 ) ) );
+    std::unique_ptr< int > item;
+    REQUIRE( q.dequeue( &item, 10 ) );
+    CHECK( *item == 3 );
+}
+
+template< class Q >
+void check_dequeue_many()
+{
+    Q q( 8 );
+    std::unique_ptr< int > items[5];
+    CHECK( q.try_dequeue_many( items, 5 ) == 0 );
+    CHECK( q.dequeue_many( items, 5, 10 ) == 0 );
+
+    for( int i = 0; i < 7; ++i )
+        q.enqueue( std::unique_ptr< int >( new int( i ) ) );
+
+    REQUIRE( q.dequeue_many( items, 5, 10 ) == 5 );
+    for( int i = 0; i < 5; ++i )
+        CHECK( *items[i] == i );
+
+    REQUIRE( q.try_dequeue_many( items, 5 ) == 2 );
+    CHECK( *items[0] == 5 );
+    CHECK( *items[1] == 6 );
+    CHECK( q.size() == 0 );
+}
+
+TEST_CASE( "queues dequeue many items in order", "[concurrency]" )
+{
+    check_dequeue_many< lock_free_single_consumer_queue< std::unique_ptr< int > > >();
+    check_dequeue_many< single_consumer_queue< std::unique_ptr< int > > >();
+}
+
+TEST_CASE( "lock-free queue dequeue many wakes a blocked producer", "[concurrency]" )
+{
+    lock_free_single_consumer_queue< std::unique_ptr< int > > q( 4 );
+    const int n = 10000;
+    std::thread producer( [&]() {
+        for( int i = 0; i < n; ++i )
+            q.blocking_enqueue( std::unique_ptr< int >( new int( i ) ) );
+    } );
+
+    int expected = 0;
+    std::unique_ptr< int > items[3];
+    while( expected < n )
+    {
+        auto count = q.dequeue_many( items, 3, 1000 );
+        if( ! count )
+            break;
+        for( size_t i = 0; i < count; ++i )
+        {
+            REQUIRE( *items[i] == expected );
+            ++expected;
+        }
+    }
+    producer.join();
+    CHECK( expected == n );
+}
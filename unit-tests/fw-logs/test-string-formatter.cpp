@@ -0,0 +1,55 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+// With static linkage, ELPP is initialized by librealsense, so doing it here will
+// create errors. When we're using the shared .so/.dll, the two are separate and we have
+// to initialize ours if we want to use the APIs!
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+// Let Catch define its own main() function
+#define CATCH_CONFIG_MAIN
+#include "../catch.h"
+
+//#cmake:add-file ../../src/fw-logs/fw-string-formatter.h
+//#cmake:add-file ../../src/fw-logs/fw-string-formatter.cpp
+#include <fw-logs/fw-string-formatter.h>
+#include <fw-logs/fw-logs-formating-options.h>
+
+using namespace librealsense::fw_logs;
+
+
+static std::string format( std::string const & line, size_t num_of_params, std::vector< uint32_t > params )
+{
+    std::unordered_map< std::string, std::vector< kvp > > enums;
+    enums["State"] = { { 0, "Idle" }, { 1, "Streaming" } };
+    fw_string_formatter formatter( enums );
+
+    std::string message;
+    REQUIRE( formatter.generate_message( fw_string_formatter::compile( line ), num_of_params, params.data(), &message ) );
+    return message;
+}
+
+
+TEST_CASE( "fw log parameters are replaced", "[fw-logs]" )
+{
+    CHECK( format( "P1 = {0}, P2 = 0x{1:x}, P3 = {2:f}", 3, { 12, 10, 7 } ) == "P1 = 12, P2 = 0x0a, P3 = 7" );
+    CHECK( format( "{0}{0}", 1, { 5 } ) == "55" );
+    CHECK( format( "no params", 0, {} ) == "no params" );
+}
+
+TEST_CASE( "fw log enums are replaced by their names", "[fw-logs]" )
+{
+    CHECK( format( "state is {0,State}", 1, { 1 } ) == "state is Streaming" );
+    // Unknown enums and values outside the enum are left as they are
+    CHECK( format( "state is {0,Mode}", 1, { 1 } ) == "state is {0,Mode}" );
+    CHECK( format( "state is {0,State}", 1, { 9 } ) == "state is {0,State}" );
+}
+
+TEST_CASE( "fw log text that is not a parameter is kept", "[fw-logs]" )
+{
+    CHECK( format( "{1} of {0}", 1, { 3 } ) == "{1} of 3" );
+    CHECK( format( "{x} {} {0 {0:y} {", 1, { 3 } ) == "{x} {} {0 {0:y} {" );
+}
@@ -0,0 +1,304 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+// With static linkage, ELPP is initialized by librealsense, so doing it here will
+// create errors. When we're using the shared .so/.dll, the two are separate and we have
+// to initialize ours if we want to use the APIs!
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+// Let Catch define its own main() function
+#define CATCH_CONFIG_MAIN
+#include "../catch.h"
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times the key paths of the library on the frames of the resource recording and compares the nanoseconds per frame
+// against a baseline of a previous run on the same machine:
+//     RS2_PERF_OUTPUT=<file>      writes the results of this run, to be used as the baseline of the next releases
+//     RS2_PERF_BASELINE=<file>    fails the paths slower than the baseline times the tolerance
+//     RS2_PERF_TOLERANCE=<ratio>  1.25 by default
+// Without a baseline the times are only reported. Only release builds give meaningful times.
+
+static const int WARMUP = 10;
+static const int ITERATIONS = 100;
+
+class perf_results
+{
+public:
+    perf_results()
+    {
+        if (auto tolerance = std::getenv("RS2_PERF_TOLERANCE"))
+            _tolerance = std::stod(tolerance);
+        if (auto baseline = std::getenv("RS2_PERF_BASELINE"))
+        {
+            std::ifstream in(baseline);
+            REQUIRE(in);
+            std::string name;
+            double ns;
+            while (in >> name >> ns)
+                _baseline[name] = ns;
+        }
+    }
+
+    ~perf_results()
+    {
+        if (auto output = std::getenv("RS2_PERF_OUTPUT"))
+        {
+            std::ofstream out(output);
+            for (auto&& r : _results)
+                out << r.first << " " << r.second << "\n";
+        }
+    }
+
+    void check(const std::string& name, double ns)
+    {
+        _results[name] = ns;
+        WARN(name << ": " << ns << " ns/frame");
+
+        auto it = _baseline.find(name);
+        if (it == _baseline.end())
+            return;
+        INFO(name << " took " << ns << " ns/frame, baseline " << it->second << " ns/frame, tolerance x" << _tolerance);
+        CHECK(ns <= it->second * _tolerance);
+    }
+
+private:
+    double _tolerance = 1.25;
+    std::map<std::string, double> _baseline;
+    std::map<std::string, double> _results;
+};
+
+static perf_results& get_results()
+{
+    static perf_results results;
+    return results;
+}
+
+// Median nanoseconds per call, the medians are stable under the occasional preemption that the means are not
+static double median_ns(std::function<void(int)> f)
+{
+    std::vector<double> times;
+    for (int i = 0; i < WARMUP + ITERATIONS; i++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        f(i);
+        auto end = std::chrono::high_resolution_clock::now();
+        if (i >= WARMUP)
+            times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+static std::string get_resource(const std::string& name)
+{
+    std::string file = __FILE__;
+    auto dir = file.substr(0, file.find_last_of("/\\") + 1);
+    return dir + "../resources/" + name;
+}
+
+// The depth and color frames of the resource recording, read once for all the tests
+static rs2::frameset get_frames()
+{
+    static rs2::frameset frames;
+    if (frames)
+        return frames;
+
+    rs2::pipeline pipe;
+    rs2::config cfg;
+    cfg.enable_device_from_file(get_resource("single_depth_color_640x480.bag"), false);
+    auto profile = pipe.start(cfg);
+    profile.get_device().as<rs2::playback>().set_real_time(false);
+
+    rs2::frameset fs;
+    while (pipe.try_wait_for_frames(&fs, 1000))
+    {
+        if (fs.get_depth_frame() && fs.get_color_frame())
+        {
+            fs.keep();
+            frames = fs;
+            break;
+        }
+    }
+    pipe.stop();
+    REQUIRE(frames);
+    return frames;
+}
+
+static void check_filter(const std::string& name, rs2::filter& filter, rs2::frame input)
+{
+    get_results().check(name, median_ns([&](int) { auto output = filter.process(input); }));
+}
+
+TEST_CASE("depth filters throughput", "[perf]")
+{
+    auto depth = get_frames().get_depth_frame();
+
+    rs2::decimation_filter decimation;
+    rs2::spatial_filter spatial;
+    rs2::temporal_filter temporal;
+    rs2::hole_filling_filter hole_filling;
+    rs2::disparity_transform to_disparity(true);
+    rs2::colorizer colorizer;
+
+    check_filter("decimation_filter", decimation, depth);
+    check_filter("spatial_filter", spatial, depth);
+    check_filter("temporal_filter", temporal, depth);
+    check_filter("hole_filling_filter", hole_filling, depth);
+    check_filter("disparity_transform", to_disparity, depth);
+    check_filter("colorizer", colorizer, depth);
+
+    rs2::spatial_filter guided;
+    guided.set_option(RS2_OPTION_SPATIAL_FILTER_MODE, 1);
+    check_filter("spatial_filter_guided", guided, depth);
+
+    rs2::median_filter median_3x3(1), median_5x5(2);
+    check_filter("median_filter_3x3", median_3x3, depth);
+    check_filter("median_filter_5x5", median_5x5, depth);
+}
+
+TEST_CASE("align and pointcloud throughput", "[perf]")
+{
+    auto frames = get_frames();
+
+    rs2::align align_to_color(RS2_STREAM_COLOR);
+    rs2::align align_to_depth(RS2_STREAM_DEPTH);
+    get_results().check("align_to_color", median_ns([&](int) { auto output = align_to_color.process(frames); }));
+    get_results().check("align_to_depth", median_ns([&](int) { auto output = align_to_depth.process(frames); }));
+
+    rs2::pointcloud pc;
+    auto depth = frames.get_depth_frame();
+    auto color = frames.get_color_frame();
+    get_results().check("pointcloud", median_ns([&](int) { auto output = pc.calculate(depth); }));
+    // The texture coordinates are computed on their first access
+    get_results().check("pointcloud_textured", median_ns([&](int) {
+        pc.map_to(color);
+        auto output = pc.calculate(depth);
+        output.get_texture_coordinates();
+    }));
+
+    rs2::voxel_grid_filter voxel_grid;
+    check_filter("voxel_grid_filter", voxel_grid, depth);
+
+    rs2::depth_to_scan scan;
+    check_filter("depth_to_scan", scan, depth);
+
+    rs2::tensor_converter to_tensor(300, 300, 127.5f, 0.007843f), to_tensor_uint8;
+    to_tensor_uint8.set_option(RS2_OPTION_TENSOR_FLOAT, 0);
+    check_filter("tensor_converter", to_tensor, color);
+    check_filter("tensor_converter_uint8", to_tensor_uint8, color);
+}
+
+// Software device of the resolution of the recording, streaming Z16 depth and YUYV color
+class software_camera
+{
+public:
+    software_camera(int width, int height) : _width(width), _height(height),
+        _depth_pixels(width * height), _color_pixels(width * height * 2)
+    {
+        rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, width * 0.9f, width * 0.9f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+        _depth_sensor = std::make_shared<rs2::software_sensor>(_device.add_sensor("Stereo Module"));
+        _color_sensor = std::make_shared<rs2::software_sensor>(_device.add_sensor("RGB Camera"));
+        _depth = _depth_sensor->add_video_stream({ RS2_STREAM_DEPTH, 0, 0, width, height, 30, 2, RS2_FORMAT_Z16, intrinsics });
+        _color = _color_sensor->add_video_stream({ RS2_STREAM_COLOR, 0, 1, width, height, 30, 2, RS2_FORMAT_YUYV, intrinsics });
+        _depth.register_extrinsics_to(_color, { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0, 0, 0 } });
+        _device.create_matcher(RS2_MATCHER_DEFAULT);
+        for (size_t i = 0; i < _color_pixels.size(); i++)
+            _color_pixels[i] = uint8_t(i * 7);
+    }
+
+    template<class T>
+    void start(T callback)
+    {
+        _depth_sensor->open(_depth);
+        _color_sensor->open(_color);
+        _depth_sensor->start(callback);
+        _color_sensor->start(callback);
+    }
+
+    void stop()
+    {
+        _depth_sensor->stop();
+        _color_sensor->stop();
+        _depth_sensor->close();
+        _color_sensor->close();
+    }
+
+    void publish_depth(int number)
+    {
+        _depth_sensor->on_video_frame({ _depth_pixels.data(), [](void*) {}, _width * 2, 2, number * 33.3, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, number, _depth });
+    }
+
+    void publish_color(int number)
+    {
+        _color_sensor->on_video_frame({ _color_pixels.data(), [](void*) {}, _width * 2, 2, number * 33.3, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, number, _color });
+    }
+
+private:
+    int _width, _height;
+    std::vector<uint16_t> _depth_pixels;
+    std::vector<uint8_t> _color_pixels;
+    rs2::software_device _device;
+    std::shared_ptr<rs2::software_sensor> _depth_sensor, _color_sensor;
+    rs2::stream_profile _depth, _color;
+};
+
+TEST_CASE("unpack, sync and allocation throughput", "[perf]")
+{
+    auto depth = get_frames().get_depth_frame();
+    software_camera camera(depth.get_width(), depth.get_height());
+
+    SECTION("yuy_decoder")
+    {
+        rs2::frame_queue queue(1, true);
+        camera.start(queue);
+        camera.publish_color(0);
+        rs2::frame color;
+        REQUIRE(queue.try_wait_for_frame(&color, 1000));
+        camera.stop();
+
+        rs2::yuy_decoder decoder;
+        check_filter("yuy_decoder", decoder, color);
+    }
+
+    SECTION("syncer")
+    {
+        // a frameset per depth and color frame pair, from the sensors to the application
+        rs2::syncer sync;
+        camera.start(sync);
+        get_results().check("syncer", median_ns([&](int i) {
+            camera.publish_depth(i);
+            camera.publish_color(i);
+            rs2::frameset fs;
+            sync.try_wait_for_frames(&fs, 1000);
+        }));
+        camera.stop();
+    }
+
+    SECTION("frame_allocation")
+    {
+        // the output frames are released before the next is allocated, as a streaming block's are
+        rs2::filter allocator([](rs2::frame f, rs2::frame_source& source)
+        {
+            auto vf = f.as<rs2::video_frame>();
+            source.frame_ready(source.allocate_video_frame(f.get_profile(), f, vf.get_bytes_per_pixel(),
+                vf.get_width(), vf.get_height(), vf.get_stride_in_bytes(), RS2_EXTENSION_DEPTH_FRAME));
+        });
+        check_filter("frame_allocation", allocator, depth);
+    }
+}
@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp>
+#include <librealsense2/hpp/rs_internal.hpp>
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+// With static linkage, ELPP is initialized by librealsense, so doing it here will
+// create errors. When we're using the shared .so/.dll, the two are separate and we have
+// to initialize ours if we want to use the APIs!
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+// Let Catch define its own main() function
+#define CATCH_CONFIG_MAIN
+#include "../catch.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+
+/* A software sensor streaming a single video stream, to run the processing blocks on frames made up by a test */
+class synthetic_stream
+{
+public:
+    synthetic_stream( rs2_stream stream, rs2_format format, int width, int height, int bpp, float focal = 0 )
+        : _width( width ), _height( height ), _bpp( bpp ), _queue( 1, true )
+    {
+        if( !focal )
+            focal = width * 0.9f;
+        rs2_intrinsics intrinsics = { width, height, width / 2.f, height / 2.f, focal, focal, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+        _sensor = std::make_shared< rs2::software_sensor >( _device.add_sensor( "Synthetic" ) );
+        if( format == RS2_FORMAT_Z16 )
+            _sensor->add_read_only_option( RS2_OPTION_DEPTH_UNITS, 0.001f );
+        _profile = _sensor->add_video_stream( { stream, 0, 0, width, height, 30, bpp, format, intrinsics } );
+        _sensor->open( _profile );
+        _sensor->start( _queue );
+    }
+
+    ~synthetic_stream()
+    {
+        _sensor->stop();
+        _sensor->close();
+    }
+
+    const rs2::stream_profile & get_profile() const { return _profile; }
+
+    /* The frame of the given pixels, copied so that the frame may outlive them */
+    template< class T >
+    rs2::frame make_frame( const std::vector< T > & pixels )
+    {
+        REQUIRE( pixels.size() * sizeof( T ) == size_t( _width * _height * _bpp ) );
+        auto data = new uint8_t[pixels.size() * sizeof( T )];
+        std::memcpy( data, pixels.data(), pixels.size() * sizeof( T ) );
+        _sensor->on_video_frame( { data, []( void * p ) { delete[] static_cast< uint8_t * >( p ); },
+                                   _width * _bpp, _bpp, _number * 33.3, RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, _number, _profile } );
+        _number++;
+
+        rs2::frame f;
+        REQUIRE( _queue.try_wait_for_frame( &f, 1000 ) );
+        return f;
+    }
+
+private:
+    int _width, _height, _bpp;
+    int _number = 0;
+    rs2::software_device _device;
+    std::shared_ptr< rs2::software_sensor > _sensor;
+    rs2::stream_profile _profile;
+    rs2::frame_queue _queue;
+};
@@ -0,0 +1,80 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#include <easylogging++.h>
+#ifdef BUILD_SHARED_LIBS
+// With static linkage, ELPP is initialized by librealsense, so doing it here will
+// create errors. When we're using the shared .so/.dll, the two are separate and we have
+// to initialize ours if we want to use the APIs!
+INITIALIZE_EASYLOGGINGPP
+#endif
+
+// Let Catch define its own main() function
+#define CATCH_CONFIG_MAIN
+#include "../catch.h"
+
+//#cmake:add-file ../../src/proc/deprojection-cache.h
+//#cmake:add-file ../../src/proc/deprojection-cache.cpp
+#include <proc/deprojection-cache.h>
+
+using namespace librealsense;
+
+static rs2_intrinsics make_intrinsics(int width, int height)
+{
+    rs2_intrinsics intrin = { width, height, width / 2.f, height / 2.f, 400.f, 400.f, RS2_DISTORTION_BROWN_CONRADY, { 0, 0, 0, 0, 0 } };
+    return intrin;
+}
+
+TEST_CASE("deprojection tables are shared per intrinsics and offset", "[deprojection-cache]")
+{
+    auto& cache = deprojection_cache::get_instance();
+    auto intrin = make_intrinsics(64, 48);
+
+    auto a = cache.get(intrin);
+    auto b = cache.get(intrin);
+    CHECK(a == b);
+
+    auto corner = cache.get(intrin, 0.5f);
+    CHECK(corner != a);
+
+    auto other = intrin;
+    other.coeffs[0] = 0.1f;
+    CHECK(cache.get(other) != a);
+
+    other = make_intrinsics(32, 24);
+    auto smaller = cache.get(other);
+    CHECK(smaller != a);
+    CHECK(smaller->x.size() == 32 * 24);
+}
+
+TEST_CASE("deprojection table values", "[deprojection-cache]")
+{
+    auto intrin = make_intrinsics(16, 8);
+    auto table = deprojection_cache::get_instance().get(intrin, -0.5f);
+
+    REQUIRE(table->x.size() == 16 * 8);
+    REQUIRE(table->y.size() == 16 * 8);
+    for (int h = 0; h < intrin.height; ++h)
+    {
+        for (int w = 0; w < intrin.width; ++w)
+        {
+            CHECK(table->x[h * intrin.width + w] == (w - 0.5f - intrin.ppx) / intrin.fx);
+            CHECK(table->y[h * intrin.width + w] == (h - 0.5f - intrin.ppy) / intrin.fy);
+        }
+    }
+}
+
+TEST_CASE("deprojection tables are released with their last user", "[deprojection-cache]")
+{
+    auto& cache = deprojection_cache::get_instance();
+    auto intrin = make_intrinsics(20, 10);
+
+    std::weak_ptr<const deprojection_table> weak = cache.get(intrin);
+    CHECK(weak.expired());
+
+    auto table = cache.get(intrin);
+    weak = table;
+    CHECK(cache.get(intrin) == table);
+    table.reset();
+    CHECK(weak.expired());
+}
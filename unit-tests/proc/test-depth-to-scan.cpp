@@ -0,0 +1,96 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <algorithm>
+#include <cmath>
+
+static const int width = 16, height = 12, bins = 16, rows = 2;
+
+// The nearest range in [min_range, max_range] per angle bin of the rows of the band, from the ray of each pixel
+static std::vector< float > reference_scan( const std::vector< uint16_t > & pixels, const rs2_intrinsics & intrin,
+                                            float min_range, float max_range )
+{
+    float angle_min, angle_increment;
+    rs2::depth_to_scan::get_angles( intrin, bins, angle_min, angle_increment );
+
+    std::vector< float > scan( bins, 0.f );
+    int first_row = int( intrin.ppy + 0.5f ) - rows / 2;
+    for( int y = first_row; y < first_row + rows; y++ )
+    {
+        for( int x = 0; x < width; x++ )
+        {
+            float ray_x = ( float( x ) - intrin.ppx ) / intrin.fx;
+            int bin = int( std::floor( ( std::atan( ray_x ) - angle_min ) / angle_increment ) );
+            auto z = pixels[y * width + x];
+            if( !z || bin < 0 || bin >= bins )
+                continue;
+            float range = 0.001f * z * std::sqrt( ray_x * ray_x + 1.f );
+            if( range < min_range || range > max_range )
+                continue;
+            scan[bin] = scan[bin] ? std::min( scan[bin], range ) : range;
+        }
+    }
+    return scan;
+}
+
+static void check_scan( rs2::depth_to_scan & to_scan, synthetic_stream & stream, const std::vector< uint16_t > & pixels,
+                        float min_range, float max_range )
+{
+    auto intrin = stream.get_profile().as< rs2::video_stream_profile >().get_intrinsics();
+    auto expected = reference_scan( pixels, intrin, min_range, max_range );
+
+    auto scan = to_scan.process( stream.make_frame( pixels ) ).as< rs2::video_frame >();
+    REQUIRE( scan );
+    REQUIRE( scan.get_profile().format() == RS2_FORMAT_DISTANCE );
+    REQUIRE( scan.get_width() == bins );
+    REQUIRE( scan.get_height() == 1 );
+
+    auto ranges = static_cast< const float * >( scan.get_data() );
+    for( int b = 0; b < bins; b++ )
+    {
+        INFO( "bin " << b );
+        CHECK( ranges[b] == Approx( expected[b] ).epsilon( 1e-5 ) );
+    }
+}
+
+TEST_CASE( "depth to scan keeps the nearest range of the band per angle bin", "[depth-to-scan]" )
+{
+    synthetic_stream stream( RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, 2 );
+    rs2::depth_to_scan to_scan( bins, rows );
+
+    // A wall at 2 m, with a hole in the band, an obstacle at 0.5 m in the band and a nearer one above the band
+    std::vector< uint16_t > pixels( width * height, 2000 );
+    pixels[5 * width + 2] = 0;
+    pixels[5 * width + 11] = 500;
+    pixels[0 * width + 7] = 300;
+    pixels[11 * width + 8] = 300;
+
+    SECTION( "the rows out of the band are ignored" )
+    {
+        check_scan( to_scan, stream, pixels, 0.1f, 10.f );
+
+        // The scan is the same without the obstacles out of the band
+        std::vector< uint16_t > without = pixels;
+        without[0 * width + 7] = without[11 * width + 8] = 2000;
+        auto with_scan = to_scan.process( stream.make_frame( pixels ) ).as< rs2::video_frame >();
+        auto without_scan = to_scan.process( stream.make_frame( without ) ).as< rs2::video_frame >();
+        auto with_ranges = static_cast< const float * >( with_scan.get_data() );
+        auto without_ranges = static_cast< const float * >( without_scan.get_data() );
+        CHECK( std::equal( with_ranges, with_ranges + bins, without_ranges ) );
+    }
+
+    SECTION( "the ranges out of the limits are ignored" )
+    {
+        // The obstacle in the band is nearer than the min range, the bin sees the wall behind it in the other row
+        to_scan.set_option( RS2_OPTION_MIN_DISTANCE, 1.f );
+        check_scan( to_scan, stream, pixels, 1.f, 10.f );
+
+        // The wall is farther than the max range, only the obstacle is left
+        to_scan.set_option( RS2_OPTION_MIN_DISTANCE, 0.1f );
+        to_scan.set_option( RS2_OPTION_MAX_DISTANCE, 1.f );
+        check_scan( to_scan, stream, pixels, 0.1f, 1.f );
+    }
+}
@@ -0,0 +1,73 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+// Median of the valid pixels of the neighborhood clipped to the image, the lower of the two middle ones for an even
+// count, and a hole where the pixel is a hole: the filter computes it with SSE inside the image and pixel by pixel
+// along the borders
+static uint16_t reference_median( const std::vector< uint16_t > & src, int width, int height, int x, int y, int radius )
+{
+    if( !src[y * width + x] )
+        return 0;
+    std::vector< uint16_t > values;
+    for( int v = std::max( 0, y - radius ); v <= std::min( height - 1, y + radius ); v++ )
+        for( int u = std::max( 0, x - radius ); u <= std::min( width - 1, x + radius ); u++ )
+            if( src[v * width + u] )
+                values.push_back( src[v * width + u] );
+    std::sort( values.begin(), values.end() );
+    return values[( values.size() - 1 ) / 2];
+}
+
+static void check_median( int width, int height, int radius, unsigned seed )
+{
+    // Depths over the whole 16 bits, with a fifth of holes
+    std::mt19937 gen( seed );
+    std::uniform_int_distribution< int > depth( 1, 0xffff );
+    std::uniform_int_distribution< int > hole( 0, 4 );
+    std::vector< uint16_t > pixels( width * height );
+    for( auto & p : pixels )
+        p = hole( gen ) ? uint16_t( depth( gen ) ) : 0;
+
+    synthetic_stream stream( RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, 2 );
+    rs2::median_filter median( radius );
+    auto output = median.process( stream.make_frame( pixels ) ).as< rs2::video_frame >();
+    REQUIRE( output );
+    REQUIRE( output.get_width() == width );
+    REQUIRE( output.get_height() == height );
+
+    auto filtered = static_cast< const uint16_t * >( output.get_data() );
+    int mismatches = 0;
+    std::string first;
+    for( int y = 0; y < height; y++ )
+    {
+        for( int x = 0; x < width; x++ )
+        {
+            auto expected = reference_median( pixels, width, height, x, y, radius );
+            if( filtered[y * width + x] != expected && !mismatches++ )
+                first = "(" + std::to_string( x ) + ", " + std::to_string( y ) + "): " + std::to_string( filtered[y * width + x] )
+                      + " instead of " + std::to_string( expected );
+        }
+    }
+    INFO( width << "x" << height << ", first mismatch at " << first );
+    CHECK( mismatches == 0 );
+}
+
+TEST_CASE( "median filter matches the median of the valid neighbors", "[median-filter]" )
+{
+    for( int radius = 1; radius <= 2; radius++ )
+    {
+        SECTION( "radius " + std::to_string( radius ) )
+        {
+            // Widths that leave a tail after the last eight pixels, and an image too narrow for the SSE path
+            check_median( 64, 48, radius, 1 );
+            check_median( 37, 23, radius, 2 );
+            check_median( 9, 7, radius, 3 );
+        }
+    }
+}
@@ -0,0 +1,110 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <librealsense2/rsutil.h>
+
+static const int width = 16, height = 12;
+
+// The texture coordinates of the vertices projected to the texture of the given calibration, zero for no depth
+static std::vector< rs2::texture_coordinate > project_vertices( const rs2::points & points, const rs2_intrinsics & intrin,
+                                                                const rs2_extrinsics & extrin )
+{
+    std::vector< rs2::texture_coordinate > tex( points.size(), rs2::texture_coordinate{ 0, 0 } );
+    auto vertices = points.get_vertices();
+    for( size_t i = 0; i < points.size(); i++ )
+    {
+        if( !vertices[i].z )
+            continue;
+        float point[3], pixel[2];
+        rs2_transform_point_to_point( point, &extrin, &vertices[i].x );
+        rs2_project_point_to_pixel( pixel, &intrin, point );
+        tex[i] = { pixel[0] / intrin.width, pixel[1] / intrin.height };
+    }
+    return tex;
+}
+
+static void check_texture( const rs2::points & points, const std::vector< rs2::texture_coordinate > & expected )
+{
+    REQUIRE( points.size() == expected.size() );
+    auto tex = points.get_texture_coordinates();
+    for( size_t i = 0; i < points.size(); i++ )
+    {
+        INFO( "point " << i );
+        CHECK( tex[i].u == Approx( expected[i].u ).margin( 1e-5 ) );
+        CHECK( tex[i].v == Approx( expected[i].v ).margin( 1e-5 ) );
+    }
+}
+
+TEST_CASE( "pointcloud texture coordinates computed on first access", "[pointcloud]" )
+{
+    // Two textures of different calibrations to map the same depth to
+    synthetic_stream depth_stream( RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, 2 );
+    synthetic_stream near_stream( RS2_STREAM_COLOR, RS2_FORMAT_RGB8, width, height, 3 );
+    synthetic_stream far_stream( RS2_STREAM_COLOR, RS2_FORMAT_RGB8, 24, 18, 3, 20.f );
+
+    const rs2_extrinsics to_near = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { 0.015f, 0, 0 } };
+    const rs2_extrinsics to_far = { { 1, 0, 0, 0, 1, 0, 0, 0, 1 }, { -0.05f, 0.01f, 0.002f } };
+    rs2::stream_profile depth_profile = depth_stream.get_profile();
+    depth_profile.register_extrinsics_to( near_stream.get_profile(), to_near );
+    depth_profile.register_extrinsics_to( far_stream.get_profile(), to_far );
+
+    auto near_intrinsics = near_stream.get_profile().as< rs2::video_stream_profile >().get_intrinsics();
+    auto far_intrinsics = far_stream.get_profile().as< rs2::video_stream_profile >().get_intrinsics();
+
+    // A slanted wall with holes
+    std::vector< uint16_t > pixels( width * height );
+    for( int y = 0; y < height; y++ )
+        for( int x = 0; x < width; x++ )
+            pixels[y * width + x] = ( x * 3 + y ) % 7 == 0 ? 0 : uint16_t( 1200 + 20 * x + 5 * y );
+
+    auto depth = depth_stream.make_frame( pixels );
+    auto near_color = near_stream.make_frame( std::vector< uint8_t >( width * height * 3, 128 ) );
+    auto far_color = far_stream.make_frame( std::vector< uint8_t >( 24 * 18 * 3, 128 ) );
+
+    rs2::pointcloud pc;
+
+    SECTION( "the projection of the calibration the points were computed with" )
+    {
+        pc.set_option( RS2_OPTION_FILTER_MAGNITUDE, 1 ); // No occlusion removal, the coordinates are the projections
+
+        pc.map_to( near_color );
+        auto near_points = pc.calculate( depth );
+        pc.map_to( far_color );
+        auto far_points = pc.calculate( depth );
+
+        // The points computed for the near texture are mapped after the block moved on to the far texture
+        check_texture( near_points, project_vertices( near_points, near_intrinsics, to_near ) );
+        check_texture( far_points, project_vertices( far_points, far_intrinsics, to_far ) );
+
+        // Mapping again to a texture seen before
+        pc.map_to( near_color );
+        auto again = pc.calculate( depth );
+        check_texture( again, project_vertices( again, near_intrinsics, to_near ) );
+    }
+
+    SECTION( "the same whether accessed at once or after map_to changed" )
+    {
+        // With the occlusion removal of the default
+        pc.map_to( far_color );
+        auto at_once = pc.calculate( depth );
+        auto at_once_tex = at_once.get_texture_coordinates();
+        std::vector< rs2::texture_coordinate > expected( at_once_tex, at_once_tex + at_once.size() );
+
+        auto later = pc.calculate( depth );
+        pc.map_to( near_color );
+        auto other = pc.calculate( depth );
+        other.get_texture_coordinates();
+
+        auto later_tex = later.get_texture_coordinates();
+        REQUIRE( later.size() == expected.size() );
+        for( size_t i = 0; i < later.size(); i++ )
+        {
+            INFO( "point " << i );
+            CHECK( later_tex[i].u == expected[i].u );
+            CHECK( later_tex[i].v == expected[i].v );
+        }
+    }
+}
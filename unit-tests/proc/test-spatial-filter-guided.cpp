@@ -0,0 +1,73 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+
+static const int width = 48, height = 32;
+
+static std::vector< uint16_t > guided_filter( const std::vector< uint16_t > & pixels )
+{
+    synthetic_stream stream( RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, 2 );
+    rs2::spatial_filter guided;
+    guided.set_option( RS2_OPTION_SPATIAL_FILTER_MODE, 1 );
+
+    auto output = guided.process( stream.make_frame( pixels ) ).as< rs2::video_frame >();
+    REQUIRE( output );
+    REQUIRE( output.get_width() == width );
+    REQUIRE( output.get_height() == height );
+    auto data = static_cast< const uint16_t * >( output.get_data() );
+    return std::vector< uint16_t >( data, data + width * height );
+}
+
+static double deviation( const std::vector< uint16_t > & pixels, double mean )
+{
+    double sum = 0;
+    for( auto p : pixels )
+        sum += ( p - mean ) * ( p - mean );
+    return std::sqrt( sum / pixels.size() );
+}
+
+TEST_CASE( "guided spatial filter", "[spatial-filter]" )
+{
+    SECTION( "keeps a constant image and its holes" )
+    {
+        std::vector< uint16_t > pixels( width * height, 1500 );
+        for( int i = 0; i < width * height; i += 7 )
+            pixels[i] = 0;
+
+        CHECK( guided_filter( pixels ) == pixels );
+    }
+
+    SECTION( "keeps an edge larger than the threshold" )
+    {
+        // A step of 2 m, far above the default threshold of 20 depth levels, along a column and on the image borders
+        std::vector< uint16_t > pixels( width * height );
+        for( int y = 0; y < height; y++ )
+            for( int x = 0; x < width; x++ )
+                pixels[y * width + x] = x < width / 3 ? 1000 : 3000;
+
+        auto filtered = guided_filter( pixels );
+        int moved = 0;
+        for( int i = 0; i < width * height; i++ )
+            if( std::abs( int( filtered[i] ) - int( pixels[i] ) ) > 1 )
+                moved++;
+        CHECK( moved == 0 );
+    }
+
+    SECTION( "smooths the variations within the threshold" )
+    {
+        std::mt19937 gen( 1 );
+        std::uniform_int_distribution< int > noise( -5, 5 );
+        std::vector< uint16_t > pixels( width * height );
+        for( auto & p : pixels )
+            p = uint16_t( 2000 + noise( gen ) );
+
+        auto filtered = guided_filter( pixels );
+        CHECK( deviation( filtered, 2000 ) < deviation( pixels, 2000 ) / 2 );
+    }
+}
@@ -0,0 +1,108 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+static const int width = 8, height = 4;
+
+// The channels of the color of a pixel, linear in x and y so that the bilinear resize keeps them exact
+static float red( float x, float y ) { return 10 * x + 1; }
+static float green( float x, float y ) { return 20 * y + 2; }
+static float blue( float x, float y ) { return 200 - 3 * x - 5 * y; }
+
+static std::vector< uint8_t > make_color( bool bgr )
+{
+    std::vector< uint8_t > pixels( width * height * 3 );
+    for( int y = 0; y < height; y++ )
+    {
+        for( int x = 0; x < width; x++ )
+        {
+            auto p = &pixels[( y * width + x ) * 3];
+            p[bgr ? 2 : 0] = uint8_t( red( float( x ), float( y ) ) );
+            p[1] = uint8_t( green( float( x ), float( y ) ) );
+            p[bgr ? 0 : 2] = uint8_t( blue( float( x ), float( y ) ) );
+        }
+    }
+    return pixels;
+}
+
+// Checks the planes of the tensor one below the other, in the given order, each (value - mean) * scale
+template< class T >
+static void check_tensor( rs2::frame tensor, int tensor_width, int tensor_height, bool bgr, float mean, float scale )
+{
+    auto video = tensor.as< rs2::video_frame >();
+    REQUIRE( video );
+    REQUIRE( video.get_width() == tensor_width );
+    REQUIRE( video.get_height() == 3 * tensor_height );
+    REQUIRE( video.get_bytes_per_pixel() == int( sizeof( T ) ) );
+
+    float ( *channels[3] )( float, float ) = { red, green, blue };
+    if( bgr )
+        std::swap( channels[0], channels[2] );
+
+    // The center of an output pixel in input pixels
+    const float rx = float( width ) / tensor_width, ry = float( height ) / tensor_height;
+    auto data = static_cast< const T * >( video.get_data() );
+    for( int c = 0; c < 3; c++ )
+    {
+        for( int y = 0; y < tensor_height; y++ )
+        {
+            for( int x = 0; x < tensor_width; x++ )
+            {
+                INFO( "channel " << c << " at (" << x << ", " << y << ")" );
+                float value = ( channels[c]( ( x + 0.5f ) * rx - 0.5f, ( y + 0.5f ) * ry - 0.5f ) - mean ) * scale;
+                if( std::is_same< T, uint8_t >::value )
+                    value = std::min( std::max( std::nearbyint( value ), 0.f ), 255.f );
+                CHECK( float( data[( c * tensor_height + y ) * tensor_width + x] ) == Approx( value ).margin( 1e-4 ) );
+            }
+        }
+    }
+}
+
+TEST_CASE( "tensor converter lays out normalized NCHW planes", "[tensor-converter]" )
+{
+    synthetic_stream rgb( RS2_STREAM_COLOR, RS2_FORMAT_RGB8, width, height, 3 );
+    auto color = rgb.make_frame( make_color( false ) );
+
+    SECTION( "RGB planes, mean and scale" )
+    {
+        rs2::tensor_converter to_tensor( width, height, 127.5f, 0.0078125f );
+        check_tensor< float >( to_tensor.process( color ), width, height, false, 127.5f, 0.0078125f );
+    }
+
+    SECTION( "BGR planes" )
+    {
+        rs2::tensor_converter to_tensor( width, height, 127.5f, 0.0078125f );
+        to_tensor.set_option( RS2_OPTION_TENSOR_BGR, 1 );
+        check_tensor< float >( to_tensor.process( color ), width, height, true, 127.5f, 0.0078125f );
+    }
+
+    SECTION( "BGR input to RGB and BGR planes" )
+    {
+        synthetic_stream bgr( RS2_STREAM_COLOR, RS2_FORMAT_BGR8, width, height, 3 );
+        auto bgr_color = bgr.make_frame( make_color( true ) );
+
+        rs2::tensor_converter to_tensor( width, height );
+        check_tensor< float >( to_tensor.process( bgr_color ), width, height, false, 0.f, 1.f );
+        to_tensor.set_option( RS2_OPTION_TENSOR_BGR, 1 );
+        check_tensor< float >( to_tensor.process( bgr_color ), width, height, true, 0.f, 1.f );
+    }
+
+    SECTION( "uint8 planes are rounded and saturated" )
+    {
+        rs2::tensor_converter to_tensor( width, height, 50.f, 2.f );
+        to_tensor.set_option( RS2_OPTION_TENSOR_FLOAT, 0 );
+        check_tensor< uint8_t >( to_tensor.process( color ), width, height, false, 50.f, 2.f );
+    }
+
+    SECTION( "resized bilinearly" )
+    {
+        rs2::tensor_converter to_tensor( width / 2, height / 2 );
+        check_tensor< float >( to_tensor.process( color ), width / 2, height / 2, false, 0.f, 1.f );
+    }
+}
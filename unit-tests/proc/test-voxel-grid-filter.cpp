@@ -0,0 +1,75 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+//#cmake:add-file proc-common.h
+#include "proc-common.h"
+
+#include <librealsense2/rsutil.h>
+
+#include <array>
+#include <cmath>
+#include <map>
+
+struct voxel
+{
+    float sum[3] = { 0, 0, 0 };
+    int count = 0;
+};
+
+typedef std::array< int, 3 > voxel_index;
+
+static voxel_index index_of( const float * p, float size )
+{
+    return { { int( std::floor( p[0] / size ) ), int( std::floor( p[1] / size ) ), int( std::floor( p[2] / size ) ) } };
+}
+
+TEST_CASE( "voxel grid filter outputs the centroid of every occupied voxel", "[voxel-grid-filter]" )
+{
+    const int width = 16, height = 12;
+    const float size = 0.05f;
+
+    // Two walls with holes, the walls in the middle of a voxel in depth and the pixels away from the edges of the voxels.
+    // The row and the column of the principal point, on an edge, are holes
+    std::vector< uint16_t > pixels( width * height );
+    for( int y = 0; y < height; y++ )
+        for( int x = 0; x < width; x++ )
+            pixels[y * width + x] = ( x + y ) % 5 == 0 || x == width / 2 || y == height / 2 ? 0 : x < width / 2 ? 1025 : 2075;
+
+    synthetic_stream stream( RS2_STREAM_DEPTH, RS2_FORMAT_Z16, width, height, 2 );
+    auto intrinsics = stream.get_profile().as< rs2::video_stream_profile >().get_intrinsics();
+
+    std::map< voxel_index, voxel > expected;
+    for( int y = 0; y < height; y++ )
+    {
+        for( int x = 0; x < width; x++ )
+        {
+            if( !pixels[y * width + x] )
+                continue;
+            float pixel[] = { float( x ), float( y ) }, point[3];
+            rs2_deproject_pixel_to_point( point, &intrinsics, pixel, pixels[y * width + x] * 0.001f );
+            auto & v = expected[index_of( point, size )];
+            for( int a = 0; a < 3; a++ )
+                v.sum[a] += point[a];
+            v.count++;
+        }
+    }
+
+    rs2::voxel_grid_filter voxel_grid( size );
+    auto points = voxel_grid.process( stream.make_frame( pixels ) ).as< rs2::points >();
+    REQUIRE( points );
+    REQUIRE( points.size() == expected.size() );
+
+    auto vertices = points.get_vertices();
+    std::map< voxel_index, int > seen;
+    for( size_t i = 0; i < points.size(); i++ )
+    {
+        const float * centroid = &vertices[i].x;
+        auto index = index_of( centroid, size );
+        REQUIRE( expected.count( index ) );
+        CHECK( ++seen[index] == 1 );
+
+        auto & v = expected[index];
+        for( int a = 0; a < 3; a++ )
+            CHECK( centroid[a] == Approx( v.sum[a] / v.count ).epsilon( 1e-4 ).margin( 1e-6 ) );
+    }
+}
@@ -1,5 +1,8 @@
 package com.intel.realsense.librealsense;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
 public class Frame extends LrsClass implements Cloneable{
 
     Frame(long handle){
@@ -32,6 +35,11 @@ public class Frame extends LrsClass implements Cloneable{
         nGetData(mHandle, data);
     }
 
+    // A read-only view of the frame data, without copying it. Valid only until the frame is closed
+    public ByteBuffer getDataBuffer() {
+        return nGetDataBuffer(mHandle).asReadOnlyBuffer().order(ByteOrder.nativeOrder());
+    }
+
     public int getNumber(){
         return nGetNumber(mHandle);
     }
@@ -77,6 +85,7 @@ public class Frame extends LrsClass implements Cloneable{
     protected static native long nGetStreamProfile(long handle);
     private static native int nGetDataSize(long handle);
     private static native void nGetData(long handle, byte[] data);
+    private static native ByteBuffer nGetDataBuffer(long handle);
     private static native int nGetNumber(long handle);
     private static native double nGetTimestamp(long handle);
     private static native int nGetTimestampDomain(long handle);
@@ -47,15 +47,8 @@ public class GLVideoFrame extends GLFrame {
             return;
 
         try(VideoFrame vf = mFrame.as(Extension.VIDEO_FRAME)) {
-            int size = vf.getStride() * vf.getHeight();
-            if(mBuffer == null || mBuffer.array().length != size){
-                mBuffer = ByteBuffer.allocate(size);
-                mBuffer.order(ByteOrder.LITTLE_ENDIAN);
-            }
-            mFrame.getData(mBuffer.array());
-            mBuffer.rewind();
-
-            upload(vf, mBuffer, mGlTexture.get(0));
+            // The frame stays open while uploading, so the texture is read from its data directly
+            upload(vf, mFrame.getDataBuffer(), mGlTexture.get(0));
             Rect r = adjustRatio(rect);
             draw(r, mGlTexture.get(0));
         }
@@ -80,7 +80,33 @@ public enum Option {
     HDR_ENABLED(76),
     SEQUENCE_NAME(77),
     SEQUENCE_SIZE(78),
-    SEQUENCE_ID(79);
+    SEQUENCE_ID(79),
+    CAPTURE_BUFFERS(80),
+    LATEST_FRAME_ONLY(81),
+    DEFERRED_CONVERSION(82),
+    SYNC_LATENCY_BUDGET(83),
+    MOTION_BATCH_SIZE(84),
+    GLOBAL_TIME_FROM_METADATA(85),
+    AUTO_EXPOSURE_SAMPLE_RATE(86),
+    AUTO_EXPOSURE_SKIP_FRAMES(87),
+    VOXEL_SIZE(88),
+    SCAN_BINS(89),
+    SCAN_ROWS(90),
+    ALIGN_OUTPUT_DOWNSAMPLE(91),
+    SPATIAL_FILTER_MODE(92),
+    SPATIAL_FILTER_RADIUS(93),
+    SPATIAL_FILTER_IR_GUIDED(94),
+    TENSOR_WIDTH(95),
+    TENSOR_HEIGHT(96),
+    TENSOR_MEAN(97),
+    TENSOR_SCALE(98),
+    TENSOR_FLOAT(99),
+    TENSOR_BGR(100),
+    FRAME_DECIMATION(101),
+    STANDBY(102),
+    CALLBACK_MAILBOX_SIZE(103),
+    POINTS_COLORS(104),
+    FRAME_POOL_RETENTION(105);
     private final int mValue;
 
     private Option(int value) { mValue = value; }
@@ -91,21 +91,41 @@ namespace Intel.RealSense
         public T FirstOrDefault<T>(Stream stream, Format format = Format.Any)
             where T : Frame
         {
-            return FirstOrDefault(stream, format)?.Cast<T>();
+            return FirstOrDefault<T>(stream, format, -1);
         }
 
         public Frame FirstOrDefault(Stream stream, Format format = Format.Any)
         {
+            return FirstOrDefault<Frame>(stream, format, -1);
+        }
+
+        /// <summary>
+        /// Retrieve the first frame of a stream, without allocating the frames it skips or their profiles
+        /// </summary>
+        /// <typeparam name="T"><see cref="Frame"/> type or subclass</typeparam>
+        /// <param name="stream">stream type of frame to be retrieved</param>
+        /// <param name="format">format type of frame to be retrieved, <see cref="Format.Any"/> for any format</param>
+        /// <param name="index">stream index of frame to be retrieved, negative for any index</param>
+        /// <returns>first found frame, or null</returns>
+        private T FirstOrDefault<T>(Stream stream, Format format, int index)
+            where T : Frame
+        {
+            object error;
             for (int i = 0; i < count; i++)
             {
-                var frame = this[i];
-                using (var fp = frame.Profile)
-                    if (fp.Stream == stream && (format == Format.Any || fp.Format == format))
-                    {
-                        return frame;
-                    }
+                var ptr = NativeMethods.rs2_extract_frame(Handle, i, out error);
+                var profile = NativeMethods.rs2_get_frame_stream_profile(ptr, out error);
 
-                frame.Dispose();
+                Stream s;
+                Format f;
+                int idx, uniqueId, framerate;
+                NativeMethods.rs2_get_stream_profile_data(profile, out s, out f, out idx, out uniqueId, out framerate, out error);
+                if (s == stream && (format == Format.Any || f == format) && (index < 0 || idx == index))
+                {
+                    return Frame.Create<T>(ptr);
+                }
+
+                NativeMethods.rs2_release_frame(ptr);
             }
 
             return null;
@@ -216,13 +236,7 @@ namespace Intel.RealSense
         {
             get
             {
-                return FirstOrDefault<Frame>(f =>
-                {
-                    using (var p = f.Profile)
-                    {
-                        return p.Stream == stream && p.Index == index;
-                    }
-                });
+                return FirstOrDefault<Frame>(stream, Format.Any, index);
             }
         }
 
@@ -230,13 +244,7 @@ namespace Intel.RealSense
         {
             get
             {
-                return FirstOrDefault<Frame>(f =>
-                {
-                    using (var p = f.Profile)
-                    {
-                        return p.Stream == stream && p.Format == format && p.Index == index;
-                    }
-                });
+                return FirstOrDefault<Frame>(stream, format, index);
             }
         }
 
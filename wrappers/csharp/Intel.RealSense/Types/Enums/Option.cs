@@ -249,6 +249,84 @@ namespace Intel.RealSense
         SequenceSize = 78,
 
         /// <summary>Subpreset sequence id - for D400 SKUs</summary>
-        SequenceId = 79
+        SequenceId = 79,
+
+        /// <summary>Number of frame buffers the backend queues for each stream, 0 selects the backend default</summary>
+        CaptureBuffers = 80,
+
+        /// <summary>Deliver only the most recent frame, dropping stale frames (ON = 1, OFF = 0)</summary>
+        LatestFrameOnly = 81,
+
+        /// <summary>Convert the frames on their first data access, frames dropped unread are never converted (ON = 1, OFF = 0)</summary>
+        DeferredConversion = 82,
+
+        /// <summary>Syncer only: longest time in milliseconds a frame waits for the missing streams before a partial frameset is emitted</summary>
+        SyncLatencyBudget = 83,
+
+        /// <summary>Number of motion samples delivered in each motion frame, applied when streaming starts</summary>
+        MotionBatchSize = 84,
+
+        /// <summary>Derive the global timestamps from the frame timestamps and arrival times instead of polling the device clock (ON = 1, OFF = 0)</summary>
+        GlobalTimeFromMetadata = 85,
+
+        /// <summary>Software Auto-Exposure: only every Nth pixel of every Nth row is counted in the histogram</summary>
+        AutoExposureSampleRate = 86,
+
+        /// <summary>Software Auto-Exposure: number of frames skipped between two evaluated frames</summary>
+        AutoExposureSkipFrames = 87,
+
+        /// <summary>Voxel grid filter: edge of the voxels in meters</summary>
+        VoxelSize = 88,
+
+        /// <summary>Depth to scan: number of angle bins spanning the horizontal field of view of the depth</summary>
+        ScanBins = 89,
+
+        /// <summary>Depth to scan: number of depth rows, centered on the principal point, the scan is taken from</summary>
+        ScanRows = 90,
+
+        /// <summary>Align: the aligned depth is output at the resolution of the other stream divided by this factor</summary>
+        AlignOutputDownsample = 91,
+
+        /// <summary>Spatial filter: 0 - domain transform filter, 1 - guided filter</summary>
+        SpatialFilterMode = 92,
+
+        /// <summary>Spatial filter: radius of the windows of the guided filter, in pixels</summary>
+        SpatialFilterRadius = 93,
+
+        /// <summary>Spatial filter: the guided filter of a frameset holding infrared is guided by the infrared (ON = 1, OFF = 0)</summary>
+        SpatialFilterIrGuided = 94,
+
+        /// <summary>Tensor converter: width of the tensor the color is resized to</summary>
+        TensorWidth = 95,
+
+        /// <summary>Tensor converter: height of the tensor the color is resized to</summary>
+        TensorHeight = 96,
+
+        /// <summary>Tensor converter: mean subtracted from the color values, before the scale</summary>
+        TensorMean = 97,
+
+        /// <summary>Tensor converter: factor the color values less the mean are multiplied by</summary>
+        TensorScale = 98,
+
+        /// <summary>Tensor converter: 0 - tensor of uint8, saturated, 1 - tensor of float</summary>
+        TensorFloat = 99,
+
+        /// <summary>Tensor converter: 0 - planes ordered R, G, B, 1 - planes ordered B, G, R</summary>
+        TensorBgr = 100,
+
+        /// <summary>Deliver every Nth frame of each stream of the sensor, the others are dropped before they are unpacked</summary>
+        FrameDecimation = 101,
+
+        /// <summary>Keep the streams of the sensor configured when it is closed, so reopening the same profiles resumes them (ON = 1, OFF = 0)</summary>
+        Standby = 102,
+
+        /// <summary>Call the frame callback on a dedicated thread through a mailbox of this many frames per stream, 0 calls it on the capture threads</summary>
+        CallbackMailboxSize = 103,
+
+        /// <summary>Sample the color of the texture of every point while mapping it, for the XYZRGB points format (ON = 1, OFF = 0)</summary>
+        PointsColors = 104,
+
+        /// <summary>Time in milliseconds a released frame buffer of the sensor is kept for reuse by its next frames of the same size before it is freed</summary>
+        FramePoolRetention = 105
     }
 }
@@ -1124,11 +1124,37 @@ const internal = {
 
   // The callback method called from native side
   errorCallback: function(error) {
+    throw this.nativeError(error);
+  },
+
+  // The Error of the error info of a native call
+  nativeError: function(error) {
     let msg = 'error native function ' + error.nativeFunction + ': ' + error.description;
     if (error.recoverable) {
-      throw new Error(msg);
+      return new Error(msg);
     }
-    throw new UnrecoverableError(msg);
+    return new UnrecoverableError(msg);
+  },
+
+  // Wait for a frameset on a native pipeline or syncer without blocking the main thread
+  waitForFramesAsync: function(cxxObj, frameSet, timeout, funcName) {
+    return new Promise((resolve, reject) => {
+      frameSet.release();
+      const started = cxxObj.waitForFramesAsync(frameSet.cxxFrameSet, timeout,
+          (received, error) => {
+        if (error) {
+          reject(this.nativeError(error));
+        } else if (received) {
+          frameSet.__update();
+          resolve(frameSet);
+        } else {
+          resolve(undefined);
+        }
+      });
+      if (!started) {
+        reject(new Error(funcName + ' is already waiting for frames'));
+      }
+    });
   },
 
   addContext: function(c) {
@@ -2029,6 +2055,8 @@ class Frame {
    * if the frame is from the depth stream, the return value is Uint16Array;
    * if the frame is from the XYZ32F or MOTION_XYZ32F stream, the return value is Float32Array;
    * for other cases, return value is Uint8Array.
+   * The array is a view of the frame memory, without a copy. It keeps the memory alive until
+   * it is garbage collected, even after the frame is released
    */
   get data() {
     if (this.typedArray) return this.typedArray;
@@ -2197,22 +2225,18 @@ class Points extends Frame {
    * Get an array of 3D vertices.
    * The coordinate system is: X right, Y up, Z away from the camera. Units: Meters
    *
+   * The array is a view of the frame memory, it keeps the memory alive until it is garbage
+   * collected, even after the frame is released
+   *
    * @return {Float32Array|undefined}
    */
   get vertices() {
     if (this.verticesArray) return this.verticesArray;
 
     if (this.cxxFrame.canGetPoints()) {
-      const newLength = this.cxxFrame.getVerticesBufferLen();
-      if (!this.verticesData || newLength !== this.verticesData.byteLength) {
-        this.verticesData = new ArrayBuffer(newLength);
-      }
-      if (this.cxxFrame.writeVertices(this.verticesData)) {
-        this.verticesArray = new Float32Array(this.verticesData);
-        return this.verticesArray;
-      }
+      this.verticesArray = this.cxxFrame.getVertices();
     }
-    return undefined;
+    return this.verticesArray;
   }
 
   release() {
@@ -2248,22 +2272,17 @@ class Points extends Frame {
    * Get an array of texture coordinates per vertex
    * Each coordinate represent a (u,v) pair within [0,1] range, to be mapped to texture image
    *
+   * The array is a view of the frame memory, like {@link Points#vertices}
+   *
    * @return {Int32Array|undefined}
    */
   get textureCoordinates() {
     if (this.verticesCoordArray) return this.verticesCoordArray;
 
     if (this.cxxFrame.canGetPoints()) {
-      const newLength = this.cxxFrame.getTexCoordBufferLen();
-      if (!this.textureCoordData || newLength !== this.textureCoordData.byteLength) {
-        this.textureCoordData = new ArrayBuffer(newLength);
-      }
-      if (this.cxxFrame.writeTextureCoordinates(this.textureCoordData)) {
-        this.verticesCoordArray = new Int32Array(this.textureCoordData);
-        return this.verticesCoordArray;
-      }
+      this.verticesCoordArray = this.cxxFrame.getTextureCoordinates();
     }
-    return undefined;
+    return this.verticesCoordArray;
   }
 
   /**
@@ -2719,6 +2738,24 @@ class Pipeline {
     return undefined;
   }
 
+  /**
+   * Wait until a new set of frames becomes available, without blocking the calling thread.
+   * The wait runs on the libuv thread pool, the frames are the ones
+   * {@link Pipeline#waitForFrames} would return. The returned FrameSet is the
+   * {@link Pipeline#latestFrame} object, refilled by each wait, and a single wait can be pending
+   * at a time.
+   *
+   * @param {Integer} timeout - max time to wait, in milliseconds, default to 5000 ms
+   * @return {Promise<FrameSet|undefined>} a Promise of a FrameSet object or Undefined, it is
+   * rejected on the errors {@link Pipeline#waitForFrames} would throw
+   */
+  waitForFramesAsync(timeout = 5000) {
+    const funcName = 'Pipeline.waitForFramesAsync()';
+    checkArgumentLength(0, 1, arguments.length, funcName);
+    checkArgumentType(arguments, 'number', 0, funcName);
+    return internal.waitForFramesAsync(this.cxxPipeline, this.frameSet, timeout, funcName);
+  }
+
   get latestFrame() {
     return this.frameSet;
   }
@@ -3057,6 +3094,19 @@ class Syncer {
     return undefined;
   }
 
+  /*
+   * Wait until coherent set of frames becomes available, without blocking the calling thread
+   * @param {Number} timeout Max time in milliseconds to wait until the Promise is rejected
+   * @return {Promise<Frame[]|undefined>} a Promise of the set of coherent frames or undefined
+   * if no frames. A single wait can be pending at a time.
+   */
+  waitForFramesAsync(timeout = 5000) {
+    const funcName = 'Syncer.waitForFramesAsync()';
+    checkArgumentLength(0, 1, arguments.length, funcName);
+    checkArgumentType(arguments, 'number', 0, funcName);
+    return internal.waitForFramesAsync(this.cxxSyncer, this.frameSet, timeout, funcName);
+  }
+
   /**
    * Check if a coherent set of frames is available, if yes return them
    * @return {Frame[]|undefined} an array of frames if available and undefined if not.
@@ -8,6 +8,7 @@
 #include <librealsense2/hpp/rs_types.hpp>
 #include <nan.h>
 
+#include <functional>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -140,17 +141,18 @@ class ErrorUtil {
     if (!err) return;
 
     auto function = std::string(rs2_get_failed_function(err));
-    auto type = rs2_get_librealsense_exception_type(err);
     auto msg = std::string(rs2_get_error_message(err));
-    bool recoverable = false;
-
-    if (type == RS2_EXCEPTION_TYPE_INVALID_VALUE ||
-        type == RS2_EXCEPTION_TYPE_WRONG_API_CALL_SEQUENCE ||
-        type == RS2_EXCEPTION_TYPE_NOT_IMPLEMENTED) {
-      recoverable = true;
-    }
+    singleton_->MarkError(IsRecoverable(err), msg, function);
+  }
 
-    singleton_->MarkError(recoverable, msg, function);
+  // Error object of a native call made off the main thread, it is handed to
+  // the js callback of the call rather than to the js error callback
+  static v8::Local<v8::Object> GetJSErrorObject(rs2_error* err) {
+    ErrorInfo error_info;
+    error_info.Update(true, IsRecoverable(err),
+        std::string(rs2_get_error_message(err)),
+        std::string(rs2_get_failed_function(err)));
+    return error_info.GetJSObject();
   }
 
   static void ResetError() {
@@ -165,6 +167,13 @@ class ErrorUtil {
   }
 
  private:
+  static bool IsRecoverable(rs2_error* err) {
+    auto type = rs2_get_librealsense_exception_type(err);
+    return type == RS2_EXCEPTION_TYPE_INVALID_VALUE ||
+        type == RS2_EXCEPTION_TYPE_WRONG_API_CALL_SEQUENCE ||
+        type == RS2_EXCEPTION_TYPE_NOT_IMPLEMENTED;
+  }
+
   // Save detailed error info to the js object
   void MarkError(bool recoverable, std::string description,
       std::string native_function) {
@@ -626,6 +635,52 @@ class RSStreamProfile : public Nan::ObjectWrap {
 
 Nan::Persistent<v8::Function> RSStreamProfile::constructor_;
 
+// An ArrayBuffer over the memory of a frame, without a copy. The buffer holds
+// a reference to the frame, released when the buffer is garbage collected, so
+// the memory outlives the JavaScript Frame object it was taken from.
+class FrameArrayBuffer {
+ public:
+  static v8::Local<v8::ArrayBuffer> New(rs2_frame* frame, const void* data,
+      size_t length) {
+    rs2_error* error = nullptr;
+    rs2_frame_add_ref(frame, &error);
+    if (error) {
+      // The frame can't be referenced, hand out a copy of its memory instead
+      rs2_free_error(error);
+      auto copy = malloc(length);
+      memcpy(copy, data, length);
+      return v8::ArrayBuffer::New(v8::Isolate::GetCurrent(), copy, length,
+          v8::ArrayBufferCreationMode::kInternalized);
+    }
+
+    auto array_buffer = v8::ArrayBuffer::New(v8::Isolate::GetCurrent(),
+        const_cast<void*>(data), length,
+        v8::ArrayBufferCreationMode::kExternalized);
+    auto holder = new FrameArrayBuffer(frame, length);
+    holder->buffer_.Reset(array_buffer);
+    holder->buffer_.SetWeak(holder, Release,
+        Nan::WeakCallbackType::kParameter);
+    Nan::AdjustExternalMemory(static_cast<int>(length));
+    return array_buffer;
+  }
+
+ private:
+  FrameArrayBuffer(rs2_frame* frame, size_t length)
+      : frame_(frame), length_(length) {}
+
+  static void Release(const Nan::WeakCallbackInfo<FrameArrayBuffer>& info) {
+    auto holder = info.GetParameter();
+    holder->buffer_.Reset();
+    rs2_release_frame(holder->frame_);
+    Nan::AdjustExternalMemory(-static_cast<int>(holder->length_));
+    delete holder;
+  }
+
+  rs2_frame* frame_;
+  size_t length_;
+  Nan::Persistent<v8::ArrayBuffer> buffer_;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -836,10 +891,7 @@ class RSFrame : public Nan::ObjectWrap {
     const auto height = GetNativeResult<int>(rs2_get_frame_height, &me->error_,
         me->frame_, &me->error_);
     const auto length = stride * height;
-    auto array_buffer = v8::ArrayBuffer::New(
-        v8::Isolate::GetCurrent(),
-        static_cast<uint8_t*>(const_cast<void*>(buffer)), length,
-        v8::ArrayBufferCreationMode::kExternalized);
+    auto array_buffer = FrameArrayBuffer::New(me->frame_, buffer, length);
     info.GetReturnValue().Set(array_buffer);
   }
 
@@ -1056,16 +1108,8 @@ class RSFrame : public Nan::ObjectWrap {
         &me->error_, me->frame_, &me->error_);
     if (!vertices || !count) return;
 
-    uint32_t step = 3 * sizeof(float);
-    uint32_t len = count * step;
-    auto vertex_buf = static_cast<uint8_t*>(malloc(len));
-
-    for (size_t i = 0; i < count; i++) {
-      memcpy(vertex_buf+i*step, vertices[i].xyz, step);
-    }
-    auto array_buffer = v8::ArrayBuffer::New(
-        v8::Isolate::GetCurrent(), vertex_buf, len,
-        v8::ArrayBufferCreationMode::kInternalized);
+    auto array_buffer = FrameArrayBuffer::New(me->frame_, vertices,
+        count * sizeof(rs2_vertex));
 
     info.GetReturnValue().Set(v8::Float32Array::New(array_buffer, 0, 3*count));
   }
@@ -1130,16 +1174,8 @@ class RSFrame : public Nan::ObjectWrap {
         &me->error_, me->frame_, &me->error_);
     if (!coords || !count) return;
 
-    uint32_t step = 2 * sizeof(int);
-    uint32_t len = count * step;
-    auto texcoord_buf = static_cast<uint8_t*>(malloc(len));
-
-    for (size_t i = 0; i < count; ++i) {
-      memcpy(texcoord_buf + i * step, coords[i].ij, step);
-    }
-    auto array_buffer = v8::ArrayBuffer::New(
-        v8::Isolate::GetCurrent(), texcoord_buf, len,
-        v8::ArrayBufferCreationMode::kInternalized);
+    auto array_buffer = FrameArrayBuffer::New(me->frame_, coords,
+        count * sizeof(rs2_pixel));
 
     info.GetReturnValue().Set(v8::Int32Array::New(array_buffer, 0, 2*count));
   }
@@ -1807,6 +1843,55 @@ Nan::Persistent<v8::Function> RSFrameSet::constructor_;
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+// Waits for frames on the libuv thread pool, then replaces the frames of the
+// js frameset and calls back on the main thread with (received, error). The
+// owner and the frameset are kept from garbage collection during the wait.
+class WaitForFramesWorker : public Nan::AsyncWorker {
+ public:
+  typedef std::function<rs2_frame*(rs2_error**)> WaitFunction;
+
+  WaitForFramesWorker(Nan::Callback* callback, v8::Local<v8::Object> owner,
+      v8::Local<v8::Object> frameset, WaitFunction wait,
+      std::function<void()> done)
+      : Nan::AsyncWorker(callback, "realsense:waitForFrames"), wait_(wait),
+      done_(done), frames_(nullptr), error_(nullptr) {
+    SaveToPersistent("owner", owner);
+    SaveToPersistent("frameset", frameset);
+  }
+
+  ~WaitForFramesWorker() {
+    if (frames_) rs2_release_frame(frames_);
+    if (error_) rs2_free_error(error_);
+  }
+
+  void Execute() override {
+    frames_ = wait_(&error_);
+  }
+
+  void HandleOKCallback() override {
+    Nan::HandleScope scope;
+    done_();
+
+    v8::Local<v8::Value> argv[2] = { Nan::False(), Nan::Undefined() };
+    if (error_) {
+      argv[1] = ErrorUtil::GetJSErrorObject(error_);
+    } else if (frames_) {
+      auto frameset = Nan::ObjectWrap::Unwrap<RSFrameSet>(
+          GetFromPersistent("frameset")->ToObject());
+      frameset->Replace(frames_);
+      frames_ = nullptr;
+      argv[0] = Nan::True();
+    }
+    callback->Call(2, argv, async_resource);
+  }
+
+ private:
+  WaitFunction wait_;
+  std::function<void()> done_;
+  rs2_frame* frames_;
+  rs2_error* error_;
+};
+
 class RSSyncer : public Nan::ObjectWrap {
  public:
   static void Init(v8::Local<v8::Object> exports) {
@@ -1816,6 +1901,7 @@ class RSSyncer : public Nan::ObjectWrap {
 
     Nan::SetPrototypeMethod(tpl, "destroy", Destroy);
     Nan::SetPrototypeMethod(tpl, "waitForFrames", WaitForFrames);
+    Nan::SetPrototypeMethod(tpl, "waitForFramesAsync", WaitForFramesAsync);
     Nan::SetPrototypeMethod(tpl, "pollForFrames", PollForFrames);
 
     constructor_.Reset(tpl->GetFunction());
@@ -1836,7 +1922,8 @@ class RSSyncer : public Nan::ObjectWrap {
   }
 
  private:
-  RSSyncer() : syncer_(nullptr), frame_queue_(nullptr), error_(nullptr) {}
+  RSSyncer() : syncer_(nullptr), frame_queue_(nullptr), error_(nullptr),
+      waiting_(false), destroy_pending_(false) {}
 
   ~RSSyncer() {
     DestroyMe();
@@ -1881,10 +1968,34 @@ class RSSyncer : public Nan::ObjectWrap {
     info.GetReturnValue().Set(Nan::True());
   }
 
+  static NAN_METHOD(WaitForFramesAsync) {
+    info.GetReturnValue().Set(Nan::False());
+    auto me = Nan::ObjectWrap::Unwrap<RSSyncer>(info.Holder());
+    auto frameset = Nan::ObjectWrap::Unwrap<RSFrameSet>(info[0]->ToObject());
+    auto timeout = info[1]->IntegerValue();
+    if (!me || !frameset || !me->frame_queue_ || me->waiting_) return;
+
+    auto queue = me->frame_queue_;
+    me->waiting_ = true;
+    Nan::AsyncQueueWorker(new WaitForFramesWorker(
+        new Nan::Callback(info[2].As<v8::Function>()), info.Holder(),
+        info[0]->ToObject(),
+        [queue, timeout](rs2_error** error) {
+          return rs2_wait_for_frame(queue, timeout, error);
+        },
+        [me]() {
+          me->waiting_ = false;
+          if (me->destroy_pending_) me->DestroyMe();
+        }));
+    info.GetReturnValue().Set(Nan::True());
+  }
+
   static NAN_METHOD(Destroy) {
     auto me = Nan::ObjectWrap::Unwrap<RSSyncer>(info.Holder());
     if (me) {
-      me->DestroyMe();
+      // The queue is deleted once a pending wait on it returns
+      me->destroy_pending_ = me->waiting_;
+      if (!me->waiting_) me->DestroyMe();
     }
     info.GetReturnValue().Set(Nan::Undefined());
   }
@@ -1909,6 +2020,8 @@ class RSSyncer : public Nan::ObjectWrap {
   rs2_processing_block* syncer_;
   rs2_frame_queue* frame_queue_;
   rs2_error* error_;
+  bool waiting_;
+  bool destroy_pending_;
   friend class RSSensor;
 };
 
@@ -3812,6 +3925,7 @@ class RSPipeline : public Nan::ObjectWrap {
     Nan::SetPrototypeMethod(tpl, "startWithConfig", StartWithConfig);
     Nan::SetPrototypeMethod(tpl, "stop", Stop);
     Nan::SetPrototypeMethod(tpl, "waitForFrames", WaitForFrames);
+    Nan::SetPrototypeMethod(tpl, "waitForFramesAsync", WaitForFramesAsync);
     Nan::SetPrototypeMethod(tpl, "pollForFrames", PollForFrames);
     Nan::SetPrototypeMethod(tpl, "getActiveProfile", GetActiveProfile);
     Nan::SetPrototypeMethod(tpl, "create", Create);
@@ -3836,7 +3950,8 @@ class RSPipeline : public Nan::ObjectWrap {
  private:
   friend class RSConfig;
 
-  RSPipeline() : pipeline_(nullptr), error_(nullptr) {}
+  RSPipeline() : pipeline_(nullptr), error_(nullptr), waiting_(false),
+      destroy_pending_(false) {}
 
   ~RSPipeline() {
     DestroyMe();
@@ -3851,7 +3966,11 @@ class RSPipeline : public Nan::ObjectWrap {
 
   static NAN_METHOD(Destroy) {
     auto me = Nan::ObjectWrap::Unwrap<RSPipeline>(info.Holder());
-    if (me) me->DestroyMe();
+    if (me) {
+      // The pipeline is deleted once a pending wait on it returns
+      me->destroy_pending_ = me->waiting_;
+      if (!me->waiting_) me->DestroyMe();
+    }
     info.GetReturnValue().Set(Nan::Undefined());
   }
 
@@ -3923,6 +4042,28 @@ class RSPipeline : public Nan::ObjectWrap {
     info.GetReturnValue().Set(Nan::True());
   }
 
+  static NAN_METHOD(WaitForFramesAsync) {
+    info.GetReturnValue().Set(Nan::False());
+    auto me = Nan::ObjectWrap::Unwrap<RSPipeline>(info.Holder());
+    auto frameset = Nan::ObjectWrap::Unwrap<RSFrameSet>(info[0]->ToObject());
+    if (!me || !frameset || !me->pipeline_ || me->waiting_) return;
+
+    auto pipeline = me->pipeline_;
+    auto timeout = info[1]->IntegerValue();
+    me->waiting_ = true;
+    Nan::AsyncQueueWorker(new WaitForFramesWorker(
+        new Nan::Callback(info[2].As<v8::Function>()), info.Holder(),
+        info[0]->ToObject(),
+        [pipeline, timeout](rs2_error** error) {
+          return rs2_pipeline_wait_for_frames(pipeline, timeout, error);
+        },
+        [me]() {
+          me->waiting_ = false;
+          if (me->destroy_pending_) me->DestroyMe();
+        }));
+    info.GetReturnValue().Set(Nan::True());
+  }
+
   static NAN_METHOD(PollForFrames) {
     info.GetReturnValue().Set(Nan::False());
     auto me = Nan::ObjectWrap::Unwrap<RSPipeline>(info.Holder());
@@ -3956,6 +4097,8 @@ class RSPipeline : public Nan::ObjectWrap {
 
   rs2_pipeline* pipeline_;
   rs2_error* error_;
+  bool waiting_;
+  bool destroy_pending_;
 };
 
 Nan::Persistent<v8::Function> RSPipeline::constructor_;
@@ -118,6 +118,20 @@ describe('Pipeline method test', () => {
     pipeline.stop();
   });
 
+  it('Testing method waitForFramesAsync', async () => {
+    pipeline.start();
+    let frameSet;
+    for (let n = 0; n < 10 && !(frameSet && frameSet.depthFrame); n++) {
+      frameSet = await pipeline.waitForFramesAsync();
+    }
+    assert(frameSet.depthFrame instanceof rs2.VideoFrame);
+    // The data outlives the frame it was taken from
+    const data = frameSet.depthFrame.data;
+    frameSet.release();
+    assert(data.length > 0);
+    pipeline.stop();
+  });
+
   it('Testing method start', () => {
     assert.doesNotThrow(() => {
       let res = pipeline.start();
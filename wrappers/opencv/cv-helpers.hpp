@@ -7,7 +7,58 @@
 #include <opencv2/opencv.hpp>   // Include OpenCV API
 #include <exception>
 
-// Convert rs2::frame to cv::Mat
+// Allocator of the matrices wrapping frames. The matrix data holds a reference to the frame, so the frame
+// stays alive (and its buffer out of the frame pool) as long as any copy of the matrix, or a UMat made from it
+class frame_mat_allocator : public cv::MatAllocator
+{
+public:
+#if CV_VERSION_MAJOR >= 4
+    typedef cv::AccessFlag access_flag;
+#else
+    typedef int access_flag;
+#endif
+
+    static const frame_mat_allocator* instance()
+    {
+        static frame_mat_allocator allocator;
+        return &allocator;
+    }
+
+    // Wraps the frame data, the frame is released with the last matrix referring to it
+    static cv::Mat wrap(const rs2::frame& f, int rows, int cols, int type, size_t step)
+    {
+        cv::Mat m(rows, cols, type, const_cast<void*>(f.get_data()), step);
+        auto u = new cv::UMatData(instance());
+        u->data = u->origdata = m.data;
+        u->size = step * rows;
+        u->refcount = 1;
+        u->userdata = new rs2::frame(f);
+        m.u = u;
+        return m;
+    }
+
+    // Reallocating a wrapped matrix (Mat::create) gets regular memory
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                           access_flag flags, cv::UMatUsageFlags usage) const override
+    {
+        return cv::Mat::getDefaultAllocator()->allocate(dims, sizes, type, data, step, flags, usage);
+    }
+
+    bool allocate(cv::UMatData* u, access_flag flags, cv::UMatUsageFlags usage) const override
+    {
+        return cv::Mat::getDefaultAllocator()->allocate(u, flags, usage);
+    }
+
+    void deallocate(cv::UMatData* u) const override
+    {
+        if (!u) return;
+        delete static_cast<rs2::frame*>(u->userdata);
+        delete u;
+    }
+};
+
+// Convert rs2::frame to cv::Mat, without copying the frame data.
+// The matrix keeps the frame alive, so it can be stored or passed to other threads without clone()
 static cv::Mat frame_to_mat(const rs2::frame& f)
 {
     using namespace cv;
@@ -16,29 +67,30 @@ static cv::Mat frame_to_mat(const rs2::frame& f)
     auto vf = f.as<video_frame>();
     const int w = vf.get_width();
     const int h = vf.get_height();
+    const size_t step = vf.get_stride_in_bytes();
 
     if (f.get_profile().format() == RS2_FORMAT_BGR8)
     {
-        return Mat(Size(w, h), CV_8UC3, (void*)f.get_data(), Mat::AUTO_STEP);
+        return frame_mat_allocator::wrap(f, h, w, CV_8UC3, step);
     }
     else if (f.get_profile().format() == RS2_FORMAT_RGB8)
     {
-        auto r_rgb = Mat(Size(w, h), CV_8UC3, (void*)f.get_data(), Mat::AUTO_STEP);
+        auto r_rgb = Mat(Size(w, h), CV_8UC3, (void*)f.get_data(), step);
         Mat r_bgr;
         cvtColor(r_rgb, r_bgr, COLOR_RGB2BGR);
         return r_bgr;
     }
     else if (f.get_profile().format() == RS2_FORMAT_Z16)
     {
-        return Mat(Size(w, h), CV_16UC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        return frame_mat_allocator::wrap(f, h, w, CV_16UC1, step);
     }
     else if (f.get_profile().format() == RS2_FORMAT_Y8)
     {
-        return Mat(Size(w, h), CV_8UC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        return frame_mat_allocator::wrap(f, h, w, CV_8UC1, step);
     }
     else if (f.get_profile().format() == RS2_FORMAT_DISPARITY32)
     {
-        return Mat(Size(w, h), CV_32FC1, (void*)f.get_data(), Mat::AUTO_STEP);
+        return frame_mat_allocator::wrap(f, h, w, CV_32FC1, step);
     }
 
     throw std::runtime_error("Frame format is not supported yet!");
@@ -33,6 +33,9 @@ int main(int argc, char** argv) try
     auto profile = config.get_stream(RS2_STREAM_COLOR)
                          .as<video_stream_profile>();
     rs2::align align_to(RS2_STREAM_COLOR);
+    // Resizes and normalizes the color to the planar BGR input of the network
+    rs2::tensor_converter to_tensor(inWidth, inHeight, meanVal, inScaleFactor);
+    to_tensor.set_option(RS2_OPTION_TENSOR_BGR, 1);
 
     Size cropSize;
     if (profile.width() / (float)profile.height() > WHRatio)
@@ -73,8 +76,10 @@ int main(int argc, char** argv) try
         auto color_mat = frame_to_mat(color_frame);
         auto depth_mat = depth_frame_to_meters(depth_frame);
 
-        Mat inputBlob = blobFromImage(color_mat, inScaleFactor,
-                                      Size(inWidth, inHeight), meanVal, false); //Convert Mat to batch of images
+        // Convert the color frame to a batch of one image, without going through an OpenCV matrix
+        auto tensor = to_tensor.process(color_frame);
+        const int blobSize[] = { 1, 3, (int)inHeight, (int)inWidth };
+        Mat inputBlob(4, blobSize, CV_32F, const_cast<void*>(tensor.get_data()));
         net.setInput(inputBlob, "data"); //set the network input
         Mat detection = net.forward("detection_out"); //compute output
 
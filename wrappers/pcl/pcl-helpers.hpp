@@ -0,0 +1,131 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2020 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <librealsense2/rs.hpp> // Include RealSense Cross Platform API
+#include <pcl/point_types.h>    // Include PCL point types
+#include <pcl/point_cloud.h>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+// The points are split in this many ranges, the same for every call with the same number of points
+static size_t pcl_range_count(size_t count)
+{
+    // a range below 16K points does not pay for its thread
+    size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(cores, count / (1 << 14)));
+}
+
+// Calls body(range, begin, end) for every range of [0, count), in parallel
+template<class F>
+static void pcl_parallel_ranges(size_t count, F body)
+{
+    auto ranges = pcl_range_count(count);
+    auto chunk = (count + ranges - 1) / ranges;
+    std::vector<std::thread> workers;
+    for (size_t r = 1; r < ranges; r++)
+        workers.emplace_back(body, r, std::min(count, r * chunk), std::min(count, (r + 1) * chunk));
+    body(0, 0, std::min(count, chunk));
+    for (auto&& w : workers)
+        w.join();
+}
+
+// Fills the cloud with set_point(point, index) for every vertex.
+// Organized clouds keep the sensor layout (width x height, invalid points at the origin),
+// otherwise the points without depth are dropped: every range counts its valid points
+// and then writes them at its offset, so the cloud is sized once and filled in parallel
+template<class PointT, class F>
+static void fill_pcl_cloud(const rs2::points& points, pcl::PointCloud<PointT>& cloud, bool organized, F set_point)
+{
+    auto vertices = points.get_vertices();
+    const size_t count = points.size();
+
+    if (organized)
+    {
+        auto sp = points.get_profile().as<rs2::video_stream_profile>();
+        cloud.points.resize(count);
+        cloud.width = static_cast<uint32_t>(sp.width());
+        cloud.height = static_cast<uint32_t>(sp.height());
+        cloud.is_dense = false;
+        pcl_parallel_ranges(count, [&](size_t, size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+                set_point(cloud.points[i], i);
+        });
+        return;
+    }
+
+    std::vector<size_t> offsets(pcl_range_count(count) + 1, 0);
+    pcl_parallel_ranges(count, [&](size_t range, size_t begin, size_t end)
+    {
+        size_t valid = 0;
+        for (size_t i = begin; i < end; i++)
+            if (vertices[i].z) valid++;
+        offsets[range + 1] = valid;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    cloud.points.resize(offsets.back());
+    cloud.width = static_cast<uint32_t>(offsets.back());
+    cloud.height = 1;
+    cloud.is_dense = true;
+    pcl_parallel_ranges(count, [&](size_t range, size_t begin, size_t end)
+    {
+        auto out = offsets[range];
+        for (size_t i = begin; i < end; i++)
+            if (vertices[i].z) set_point(cloud.points[out++], i);
+    });
+}
+
+// Convert rs2::points to pcl::PointCloud<pcl::PointXYZ>.
+// The vertices cannot be mapped in place since PCL points are padded to 16 bytes
+static pcl::PointCloud<pcl::PointXYZ>::Ptr points_to_pcl(const rs2::points& points, bool organized = true)
+{
+    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
+    auto vertices = points.get_vertices();
+    fill_pcl_cloud(points, *cloud, organized, [vertices](pcl::PointXYZ& p, size_t i)
+    {
+        p.x = vertices[i].x;
+        p.y = vertices[i].y;
+        p.z = vertices[i].z;
+    });
+    return cloud;
+}
+
+// Convert rs2::points to pcl::PointCloud<pcl::PointXYZRGB>, the color is looked up at the texture coordinates
+// of every point. The texture must be RGB8, BGR8, RGBA8 or BGRA8, the frame the points were mapped to
+static pcl::PointCloud<pcl::PointXYZRGB>::Ptr points_to_pcl(const rs2::points& points, const rs2::video_frame& texture, bool organized = true)
+{
+    auto format = texture.get_profile().format();
+    if (format != RS2_FORMAT_RGB8 && format != RS2_FORMAT_BGR8 && format != RS2_FORMAT_RGBA8 && format != RS2_FORMAT_BGRA8)
+        throw std::runtime_error("Texture format is not supported yet!");
+
+    const bool bgr = format == RS2_FORMAT_BGR8 || format == RS2_FORMAT_BGRA8;
+    const int width = texture.get_width();
+    const int height = texture.get_height();
+    const int bpp = texture.get_bytes_per_pixel();
+    const int stride = texture.get_stride_in_bytes();
+    auto data = reinterpret_cast<const uint8_t*>(texture.get_data());
+
+    pcl::PointCloud<pcl::PointXYZRGB>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZRGB>);
+    auto vertices = points.get_vertices();
+    auto tex_coords = points.get_texture_coordinates();
+    fill_pcl_cloud(points, *cloud, organized, [&](pcl::PointXYZRGB& p, size_t i)
+    {
+        p.x = vertices[i].x;
+        p.y = vertices[i].y;
+        p.z = vertices[i].z;
+
+        int x = std::min(std::max(int(tex_coords[i].u * width + .5f), 0), width - 1);
+        int y = std::min(std::max(int(tex_coords[i].v * height + .5f), 0), height - 1);
+        auto texel = data + y * stride + x * bpp;
+        p.r = texel[bgr ? 2 : 0];
+        p.g = texel[1];
+        p.b = texel[bgr ? 0 : 2];
+    });
+    return cloud;
+}
@@ -6,6 +6,7 @@
 
 #include <pcl/point_types.h>
 #include <pcl/filters/passthrough.h>
+#include "../pcl-helpers.hpp"            // Include conversion of rs2::points to pcl::PointCloud
 
 // Struct for managing rotation of pointcloud view
 struct state {
@@ -20,27 +21,6 @@ using pcl_ptr = pcl::PointCloud<pcl::PointXYZ>::Ptr;
 void register_glfw_callbacks(window& app, state& app_state);
 void draw_pointcloud(window& app, state& app_state, const std::vector<pcl_ptr>& points);
 
-pcl_ptr points_to_pcl(const rs2::points& points)
-{
-    pcl_ptr cloud(new pcl::PointCloud<pcl::PointXYZ>);
-
-    auto sp = points.get_profile().as<rs2::video_stream_profile>();
-    cloud->width = sp.width();
-    cloud->height = sp.height();
-    cloud->is_dense = false;
-    cloud->points.resize(points.size());
-    auto ptr = points.get_vertices();
-    for (auto& p : cloud->points)
-    {
-        p.x = ptr->x;
-        p.y = ptr->y;
-        p.z = ptr->z;
-        ptr++;
-    }
-
-    return cloud;
-}
-
 float3 colors[] { { 0.8f, 0.1f, 0.3f }, 
                   { 0.1f, 0.9f, 0.5f },
                 };
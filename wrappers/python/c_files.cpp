@@ -30,11 +30,18 @@ void init_c_files(py::module &m) {
     BIND_ENUM(m, rs2_stream, RS2_STREAM_COUNT, "Streams are different types of data provided by RealSense devices.")
     BIND_ENUM(m, rs2_format, RS2_FORMAT_COUNT, "A stream's format identifies how binary data is encoded within a frame.")
     BIND_ENUM(m, rs2_timestamp_domain, RS2_TIMESTAMP_DOMAIN_COUNT, "Specifies the clock in relation to which the frame timestamp was measured.")
+    BIND_ENUM(m, rs2_frame_drop_cause, RS2_FRAME_DROP_CAUSE_COUNT, "Reasons a frame of a stream did not reach the user.")
+    BIND_ENUM(m, rs2_frame_trace_stage, RS2_FRAME_TRACE_STAGE_COUNT, "Stages of the frame path stamped in the trace of a frame.")
+    BIND_ENUM(m, rs2_memory_category, RS2_MEMORY_CATEGORY_COUNT, "Categories of the memory held by the library.")
+    BIND_ENUM(m, rs2_memory_budget_policy, RS2_MEMORY_BUDGET_POLICY_COUNT, "Behaviors of the allocation of a frame that would exceed a memory budget.")
+    BIND_ENUM(m, rs2_thread_role, RS2_THREAD_ROLE_COUNT, "Roles of the threads the library starts, each with its own CPUs and scheduling.")
+    BIND_ENUM(m, rs2_points_format, RS2_POINTS_FORMAT_COUNT, "Layouts of the points packed out of a points frame.")
     BIND_ENUM(m, rs2_frame_metadata_value, RS2_FRAME_METADATA_COUNT, "Per-Frame-Metadata is the set of read-only properties that might be exposed for each individual frame.")
     BIND_ENUM(m, rs2_option, RS2_OPTION_COUNT, "Defines general configuration controls. These can generally be mapped to camera UVC controls, and can be set / queried at any time unless stated otherwise.")
     // rs2_sr300_visual_preset
     // rs2_rs400_visual_preset
     BIND_ENUM(m, rs2_playback_status, RS2_PLAYBACK_STATUS_COUNT, "") // No docstring in C++
+    BIND_ENUM(m, rs2_frame_compression, RS2_FRAME_COMPRESSION_COUNT, "Compression of the images a recorder writes for a stream.")
     BIND_ENUM(m, rs2_calibration_type, RS2_CALIBRATION_TYPE_COUNT, "Calibration type for use in device_calibration")
     BIND_ENUM_CUSTOM(m, rs2_calibration_status, RS2_CALIBRATION_STATUS_FIRST, RS2_CALIBRATION_STATUS_LAST, "Calibration callback status for use in device_calibration.trigger_device_calibration")
 
@@ -95,6 +102,20 @@ void init_c_files(py::module &m) {
 
     // rs2_vertex
     // rs2_pixel
+
+    py::class_<rs2_pixel_region> pixel_region(m, "pixel_region", "Rectangle of pixels within 2D image, its bounds included.");
+    pixel_region.def(py::init<>())
+        .def(py::init([](int min_x, int min_y, int max_x, int max_y) { return rs2_pixel_region{ min_x, min_y, max_x, max_y }; }),
+            "min_x"_a, "min_y"_a, "max_x"_a, "max_y"_a)
+        .def_readwrite("min_x", &rs2_pixel_region::min_x)
+        .def_readwrite("min_y", &rs2_pixel_region::min_y)
+        .def_readwrite("max_x", &rs2_pixel_region::max_x)
+        .def_readwrite("max_y", &rs2_pixel_region::max_y)
+        .def("__repr__", [](const rs2_pixel_region& self) {
+            std::stringstream ss;
+            ss << "(" << self.min_x << ", " << self.min_y << ") - (" << self.max_x << ", " << self.max_y << ")";
+            return ss.str();
+        });
     
     py::class_<rs2_vector> vector(m, "vector", "3D vector in Euclidean coordinate space.");
     vector.def(py::init<>())
@@ -134,8 +155,31 @@ void init_c_files(py::module &m) {
         .def_readwrite("angular_acceleration", &rs2_pose::angular_acceleration, "X, Y, Z values of angular acceleration, in radians/sec^2")
         .def_readwrite("tracker_confidence", &rs2_pose::tracker_confidence, "Pose confidence 0x0 - Failed, 0x1 - Low, 0x2 - Medium, 0x3 - High")
         .def_readwrite("mapper_confidence", &rs2_pose::mapper_confidence, "Pose map confidence 0x0 - Failed, 0x1 - Low, 0x2 - Medium, 0x3 - High");
+
+    py::class_<rs2_memory_usage> memory_usage(m, "memory_usage", "Bytes held by the library, per category.");
+    memory_usage.def(py::init<>())
+        .def_property_readonly("bytes", [](const rs2_memory_usage& self) {
+            std::map<rs2_memory_category, long long> bytes;
+            for (int i = 0; i < RS2_MEMORY_CATEGORY_COUNT; i++)
+                bytes[rs2_memory_category(i)] = self.bytes[i];
+            return bytes;
+        }, "Bytes currently held, per category")
+        .def_property_readonly("peak_bytes", [](const rs2_memory_usage& self) {
+            std::map<rs2_memory_category, long long> bytes;
+            for (int i = 0; i < RS2_MEMORY_CATEGORY_COUNT; i++)
+                bytes[rs2_memory_category(i)] = self.peak_bytes[i];
+            return bytes;
+        }, "Largest number of bytes held, per category");
     /** end rs_types.h **/
 
+    /** rs_frame.h **/
+    py::class_<rs2_frame_trace_stamp> frame_trace_stamp(m, "frame_trace_stamp", "Time a frame reached a stage of the frame path.");
+    frame_trace_stamp.def(py::init<>())
+        .def_readonly("stage", &rs2_frame_trace_stamp::stage, "Stage of the frame path")
+        .def_property_readonly("name", [](const rs2_frame_trace_stamp& self) { return std::string(self.name); }, "Name of the processing block of the block stages, empty otherwise")
+        .def_readonly("time", &rs2_frame_trace_stamp::time, "System time in milliseconds");
+    /** end rs_frame.h **/
+
     /** rs_sensor.h **/
     py::class_<rs2_extrinsics> extrinsics(m, "extrinsics", "Cross-stream extrinsics: encodes the topology describing how the different devices are oriented.");
     extrinsics.def(py::init<>())
@@ -147,5 +191,50 @@ void init_c_files(py::module &m) {
             ss << "\ntranslation: " << array_to_string(e.translation);
             return ss.str();
         });
+
+    py::class_<rs2_stream_metrics> stream_metrics(m, "stream_metrics", "Counters of a stream of a sensor since the sensor was created.");
+    stream_metrics.def(py::init<>())
+        .def_readonly("stream", &rs2_stream_metrics::stream, "Stream type")
+        .def_readonly("index", &rs2_stream_metrics::index, "Stream index")
+        .def_readonly("arrived", &rs2_stream_metrics::arrived, "Frames received from the backend")
+        .def_readonly("delivered", &rs2_stream_metrics::delivered, "Frames given to the user callback")
+        .def_property_readonly("dropped", [](const rs2_stream_metrics& self) {
+            std::map<rs2_frame_drop_cause, unsigned long long> dropped;
+            for (int i = 0; i < RS2_FRAME_DROP_CAUSE_COUNT; i++)
+                dropped[rs2_frame_drop_cause(i)] = self.dropped[i];
+            return dropped;
+        }, "Frames dropped, per cause")
+        .def_readonly("arrival_fps", &rs2_stream_metrics::arrival_fps, "Frames received per second")
+        .def_readonly("delivered_fps", &rs2_stream_metrics::delivered_fps, "Frames delivered per second")
+        .def_readonly("unpack_time_ms", &rs2_stream_metrics::unpack_time_ms, "Total time spent converting the received frames to the requested formats")
+        .def_readonly("max_unpack_time_ms", &rs2_stream_metrics::max_unpack_time_ms, "Longest conversion of a frame");
+
+    py::class_<rs2_frame_pool_metrics> frame_pool_metrics(m, "frame_pool_metrics", "Usage of the frame buffers of a sensor.");
+    frame_pool_metrics.def(py::init<>())
+        .def_readonly("hits", &rs2_frame_pool_metrics::hits, "Buffers served from the recycled buffers")
+        .def_readonly("misses", &rs2_frame_pool_metrics::misses, "Buffers that had to be allocated")
+        .def_readonly("evictions", &rs2_frame_pool_metrics::evictions, "Recycled buffers released after the retention period")
+        .def_readonly("in_use", &rs2_frame_pool_metrics::in_use, "Frames currently held by the user")
+        .def_readonly("capacity", &rs2_frame_pool_metrics::capacity, "Frames the user may hold before new frames are dropped, 0 when unbounded");
     /** end rs_sensor.h **/
+
+    /** rs_processing.h **/
+    py::class_<rs2_processing_block_metrics> processing_block_metrics(m, "processing_block_metrics", "Counters of a processing block since it was created.");
+    processing_block_metrics.def(py::init<>())
+        .def_readonly("frames", &rs2_processing_block_metrics::frames, "Frames processed")
+        .def_readonly("total_time_ms", &rs2_processing_block_metrics::total_time_ms, "Total time spent processing")
+        .def_readonly("max_time_ms", &rs2_processing_block_metrics::max_time_ms, "Longest processing of a frame");
+
+    py::class_<rs2_frame_queue_metrics> frame_queue_metrics(m, "frame_queue_metrics", "Occupancy of a frame queue.");
+    frame_queue_metrics.def(py::init<>())
+        .def_readonly("size", &rs2_frame_queue_metrics::size, "Frames waiting in the queue")
+        .def_readonly("capacity", &rs2_frame_queue_metrics::capacity, "Frames the queue holds before the oldest ones are dropped")
+        .def_readonly("dropped", &rs2_frame_queue_metrics::dropped, "Frames dropped because the queue was full");
+    /** end rs_processing.h **/
+    /** rs_pipeline.h **/
+    py::class_<rs2_pipeline_start_report> pipeline_start_report(m, "pipeline_start_report", "Outcome of starting one of the pipelines of start_pipelines.");
+    pipeline_start_report.def(py::init<>())
+        .def_readonly("started", &rs2_pipeline_start_report::started, "Non-zero when the pipeline started")
+        .def_readonly("duration_ms", &rs2_pipeline_start_report::duration_ms, "Time spent starting the pipeline, or failing to");
+    /** end rs_pipeline.h **/
 }
@@ -178,6 +178,32 @@ PYBIND11_MODULE(NAME, m) {
         .value("sequence_name", RS2_OPTION_SEQUENCE_NAME)
         .value("sequence_size", RS2_OPTION_SEQUENCE_SIZE)
         .value("sequence_id", RS2_OPTION_SEQUENCE_ID)
+        .value("capture_buffers", RS2_OPTION_CAPTURE_BUFFERS)
+        .value("latest_frame_only", RS2_OPTION_LATEST_FRAME_ONLY)
+        .value("deferred_conversion", RS2_OPTION_DEFERRED_CONVERSION)
+        .value("sync_latency_budget", RS2_OPTION_SYNC_LATENCY_BUDGET)
+        .value("motion_batch_size", RS2_OPTION_MOTION_BATCH_SIZE)
+        .value("global_time_from_metadata", RS2_OPTION_GLOBAL_TIME_FROM_METADATA)
+        .value("auto_exposure_sample_rate", RS2_OPTION_AUTO_EXPOSURE_SAMPLE_RATE)
+        .value("auto_exposure_skip_frames", RS2_OPTION_AUTO_EXPOSURE_SKIP_FRAMES)
+        .value("voxel_size", RS2_OPTION_VOXEL_SIZE)
+        .value("scan_bins", RS2_OPTION_SCAN_BINS)
+        .value("scan_rows", RS2_OPTION_SCAN_ROWS)
+        .value("align_output_downsample", RS2_OPTION_ALIGN_OUTPUT_DOWNSAMPLE)
+        .value("spatial_filter_mode", RS2_OPTION_SPATIAL_FILTER_MODE)
+        .value("spatial_filter_radius", RS2_OPTION_SPATIAL_FILTER_RADIUS)
+        .value("spatial_filter_ir_guided", RS2_OPTION_SPATIAL_FILTER_IR_GUIDED)
+        .value("tensor_width", RS2_OPTION_TENSOR_WIDTH)
+        .value("tensor_height", RS2_OPTION_TENSOR_HEIGHT)
+        .value("tensor_mean", RS2_OPTION_TENSOR_MEAN)
+        .value("tensor_scale", RS2_OPTION_TENSOR_SCALE)
+        .value("tensor_float", RS2_OPTION_TENSOR_FLOAT)
+        .value("tensor_bgr", RS2_OPTION_TENSOR_BGR)
+        .value("frame_decimation", RS2_OPTION_FRAME_DECIMATION)
+        .value("standby", RS2_OPTION_STANDBY)
+        .value("callback_mailbox_size", RS2_OPTION_CALLBACK_MAILBOX_SIZE)
+        .value("points_colors", RS2_OPTION_POINTS_COLORS)
+        .value("frame_pool_retention", RS2_OPTION_FRAME_POOL_RETENTION)
         .value("count", RS2_OPTION_COUNT);
 
     py::enum_<platform::power_state> power_state(m, "power_state");
@@ -16,6 +16,10 @@ void init_context(py::module &m) {
 
     // Not binding devices_changed_callback, templated
 
+    m.def("set_thread_policy", &rs2::set_thread_policy, "Sets the CPUs and the scheduling of the threads of a role, for all the contexts of the process. "
+          "Applies to the threads started after the call. A realtime_priority of 0 keeps the default scheduling.",
+          "role"_a, "cpus"_a = std::vector<int>(), "realtime_priority"_a = 0);
+
     py::class_<rs2::context> context(m, "context", "Librealsense context class. Includes realsense API version.");
     context.def(py::init<>())
         .def("query_devices", (rs2::device_list(rs2::context::*)() const) &rs2::context::query_devices, "Create a static"
@@ -34,7 +38,10 @@ void init_context(py::module &m) {
              "On successful load, the device will be appended to the context and a devices_changed event triggered.",
              "filename"_a)
         .def("unload_device", &rs2::context::unload_device, "filename"_a) // No docstring in C++
-        .def("unload_tracking_module", &rs2::context::unload_tracking_module); // No docstring in C++
+        .def("unload_tracking_module", &rs2::context::unload_tracking_module) // No docstring in C++
+        .def("set_memory_budget", &rs2::context::set_memory_budget, "Limit the frame buffers of the devices of the context, "
+             "0 bytes for no limit.", "bytes"_a, "policy"_a = RS2_MEMORY_BUDGET_POLICY_DROP)
+        .def("get_memory_usage", &rs2::context::get_memory_usage, "Bytes held by the library for the frames of the devices of the context.");
 
     // rs2::device_hub
     /** end rs_context.hpp **/
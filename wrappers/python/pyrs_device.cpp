@@ -23,6 +23,10 @@ void init_device(py::module &m) {
         .def("get_info", &rs2::device::get_info, "Retrieve camera specific information, "
              "like versions of various internal components", "info"_a)
         .def("hardware_reset", &rs2::device::hardware_reset, "Send hardware reset request to the device")
+        .def("get_memory_usage", &rs2::device::get_memory_usage, "Bytes held by the library for the frames of the device")
+        .def("get_numa_node", &rs2::device::get_numa_node, "NUMA node of the USB controller the device is attached to, -1 when unknown")
+        .def("set_frame_memory_policy", &rs2::device::set_frame_memory_policy, "Map the frame buffers of the sensors of the device "
+             "from a NUMA node, -1 for any node, and on huge pages. Must be called while the sensors are not streaming.", "numa_node"_a, "huge_pages"_a)
         .def(py::init<>())
         .def("__nonzero__", &rs2::device::operator bool)
         .def(BIND_DOWNCAST(device, debug_protocol))
@@ -90,6 +94,18 @@ void init_device(py::module &m) {
         {
             return self.run_tare_calibration(ground_truth_mm, json_content, callback, timeout_ms);
         }, "This will adjust camera absolute distance to flat target. This call is executed on the caller's thread.", "ground_truth_mm"_a, "json_content"_a, "callback"_a, "timeout_ms"_a, py::call_guard<py::gil_scoped_release>())
+        .def("run_on_chip_calibration_async", [](const rs2::auto_calibrated_device& self, std::string json_content, std::function<void(rs2::calibration_table, float, std::string)> on_done,
+                                                   std::function<void(float)> on_progress, int timeout_ms)
+        {
+            self.run_on_chip_calibration_async(json_content, on_done, on_progress, timeout_ms);
+        }, "Start on-chip calibration and return once its parameters are validated. on_done(table, health, error_message) is called from the calibration thread, "
+           "error_message is empty when the calibration succeeded.", "json_content"_a, "on_done"_a, "on_progress"_a = nullptr, "timeout_ms"_a = 5000)
+        .def("run_tare_calibration_async", [](const rs2::auto_calibrated_device& self, float ground_truth_mm, std::string json_content,
+                                                std::function<void(rs2::calibration_table, float, std::string)> on_done, std::function<void(float)> on_progress, int timeout_ms)
+        {
+            self.run_tare_calibration_async(ground_truth_mm, json_content, on_done, on_progress, timeout_ms);
+        }, "Start tare calibration and return once its parameters are validated. on_done(table, health, error_message) is called from the calibration thread, "
+           "error_message is empty when the calibration succeeded.", "ground_truth_mm"_a, "json_content"_a, "on_done"_a, "on_progress"_a = nullptr, "timeout_ms"_a = 5000)
         .def("get_calibration_table", &rs2::auto_calibrated_device::get_calibration_table, "Read current calibration table from flash.")
         .def("set_calibration_table", &rs2::auto_calibrated_device::set_calibration_table, "Set current table to dynamic area.")
         .def("reset_to_factory_calibration", &rs2::auto_calibrated_device::reset_to_factory_calibration, "Reset device to factory calibration.");
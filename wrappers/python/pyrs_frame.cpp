@@ -4,6 +4,87 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 #include "python.hpp"
 #include "../include/librealsense2/hpp/rs_frame.hpp"
 
+// Helper function for supporting python's buffer protocol
+static BufData get_frame_buffer(const rs2::frame& self)
+{
+    if (auto vf = self.as<rs2::video_frame>()) {
+        std::map<size_t, std::string> bytes_per_pixel_to_format = { { 1, std::string("@B") },{ 2, std::string("@H") },{ 3, std::string("@I") },{ 4, std::string("@I") } };
+        switch (vf.get_profile().format()) {
+        case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8:
+            return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
+                { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 3 },
+                { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
+            break;
+        case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8:
+            return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
+                { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 4 },
+                { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
+            break;
+        default:
+            return BufData(const_cast<void*>(vf.get_data()), static_cast<size_t>(vf.get_bytes_per_pixel()), bytes_per_pixel_to_format[vf.get_bytes_per_pixel()], 2,
+                { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()) },
+                { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()) });
+        }
+    }
+    else
+        return BufData(const_cast<void*>(self.get_data()), 1, std::string("@B"), 0);
+}
+
+// Keeps the frame alive for as long as its data is in use from Python
+static BufData pin(BufData data, const rs2::frame& f)
+{
+    data._frame = f;
+    return data;
+}
+
+BufData get_frame_data(const rs2::frame& self)
+{
+    return pin(get_frame_buffer(self), self);
+}
+
+// Numpy's __array_interface__ of a buffer: same memory, described without the buffer protocol
+static py::dict get_array_interface(const BufData& self)
+{
+    static const uint16_t one = 1;
+    static const char endian = *reinterpret_cast<const char*>(&one) ? '<' : '>';
+    auto type_of = [](char c) -> std::string {
+        switch (c) {
+        case 'B': return "|u1";
+        case 'H': return std::string(1, endian) + "u2";
+        case 'I': return std::string(1, endian) + "u4";
+        case 'f': return std::string(1, endian) + "f4";
+        default: throw std::runtime_error(std::string("unsupported buffer format '") + c + "'");
+        }
+    };
+
+    py::dict interface;
+    auto types = self._format.substr(1);  // skip the '@'
+    if (types.size() == 1)
+        interface["typestr"] = type_of(types[0]);
+    else
+    {
+        // Vertices ("@fff") and texture coordinates ("@ff") are records of floats
+        static const char* vertex_fields[] = { "x", "y", "z" };
+        static const char* texture_fields[] = { "u", "v" };
+        py::list descr;
+        for (size_t i = 0; i < types.size() && i < 3; ++i)
+            descr.append(py::make_tuple(types.size() == 3 ? vertex_fields[i] : texture_fields[i], type_of(types[i])));
+        interface["typestr"] = "|V" + std::to_string(self._itemsize);
+        interface["descr"] = descr;
+    }
+    py::tuple shape(self._ndim), strides(self._ndim);
+    for (size_t i = 0; i < self._ndim; ++i)
+    {
+        shape[i] = self._shape[i];
+        strides[i] = self._strides[i];
+    }
+    interface["shape"] = shape;
+    interface["strides"] = strides;
+    interface["data"] = py::make_tuple(reinterpret_cast<size_t>(self._ptr), false);
+    interface["version"] = 3;
+    return interface;
+}
+
 void init_frame(py::module &m) {
     py::class_<BufData> BufData_py(m, "BufData", py::buffer_protocol());
     BufData_py.def_buffer([](BufData& self)
@@ -15,32 +96,9 @@ void init_frame(py::module &m) {
         self._shape,
         self._strides); }
     );
+    BufData_py.def_property_readonly("__array_interface__", &get_array_interface, "Numpy array interface of the data. "
+        "The array uses the memory of the frame, which is kept alive as long as the array is.");
 
-    // Helper function for supporting python's buffer protocol
-    auto get_frame_data = [](const rs2::frame& self) ->  BufData
-    {
-        if (auto vf = self.as<rs2::video_frame>()) {
-            std::map<size_t, std::string> bytes_per_pixel_to_format = { { 1, std::string("@B") },{ 2, std::string("@H") },{ 3, std::string("@I") },{ 4, std::string("@I") } };
-            switch (vf.get_profile().format()) {
-            case RS2_FORMAT_RGB8: case RS2_FORMAT_BGR8:
-                return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
-                    { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 3 },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
-                break;
-            case RS2_FORMAT_RGBA8: case RS2_FORMAT_BGRA8:
-                return BufData(const_cast<void*>(vf.get_data()), 1, bytes_per_pixel_to_format[1], 3,
-                    { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()), 4 },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()), 1 });
-                break;
-            default:
-                return BufData(const_cast<void*>(vf.get_data()), static_cast<size_t>(vf.get_bytes_per_pixel()), bytes_per_pixel_to_format[vf.get_bytes_per_pixel()], 2,
-                    { static_cast<size_t>(vf.get_height()), static_cast<size_t>(vf.get_width()) },
-                    { static_cast<size_t>(vf.get_stride_in_bytes()), static_cast<size_t>(vf.get_bytes_per_pixel()) });
-            }
-        }
-        else
-            return BufData(const_cast<void*>(self.get_data()), 1, std::string("@B"), 0); };
-    
     /* rs_frame.hpp */
     py::class_<rs2::stream_profile> stream_profile(m, "stream_profile", "Stores details about the profile of a stream.");
     stream_profile.def(py::init<>())
@@ -102,7 +160,7 @@ void init_frame(py::module &m) {
     pose_stream_profile.def(py::init<const rs2::stream_profile&>(), "sp"_a);
 
     py::class_<rs2::filter_interface> filter_interface(m, "filter_interface", "Interface for frame filtering functionality");
-    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a); // No docstring in C++
+    filter_interface.def("process", &rs2::filter_interface::process, "frame"_a, py::call_guard<py::gil_scoped_release>()); // No docstring in C++
 
     py::class_<rs2::frame> frame(m, "frame", "Base class for multiple frame extensions");
     frame.def(py::init<>())
@@ -116,8 +174,10 @@ void init_frame(py::module &m) {
         .def_property_readonly("frame_timestamp_domain", &rs2::frame::get_frame_timestamp_domain, "The timestamp domain. Identical to calling get_frame_timestamp_domain.")
         .def("get_frame_metadata", &rs2::frame::get_frame_metadata, "Retrieve the current value of a single frame_metadata.", "frame_metadata"_a)
         .def("supports_frame_metadata", &rs2::frame::supports_frame_metadata, "Determine if the device allows a specific metadata to be queried.", "frame_metadata"_a)
+        .def("get_all_frame_metadata", &rs2::frame::get_all_frame_metadata, "Retrieve the supported frame_metadata attributes and their values in one call.")
         .def("get_frame_number", &rs2::frame::get_frame_number, "Retrieve the frame number.")
         .def_property_readonly("frame_number", &rs2::frame::get_frame_number, "The frame number. Identical to calling get_frame_number.")
+        .def("get_trace", &rs2::frame::get_trace, "Retrieve the stamps of the stages of the frame path the frame went through.")
         .def("get_data_size", &rs2::frame::get_data_size, "Retrieve data size from frame handle.")
         .def("get_data", get_frame_data, "Retrieve data from the frame handle.", py::keep_alive<0, 1>())
         .def_property_readonly("data", get_frame_data, "Data from the frame handle. Identical to calling get_data.", py::keep_alive<0, 1>())
@@ -196,11 +256,11 @@ void init_frame(py::module &m) {
             size_t h = profile.height(), w = profile.width();
             switch (dims) {
             case 1:
-                return BufData(verts, sizeof(rs2::vertex), "@fff", self.size());
+                return pin(BufData(verts, sizeof(rs2::vertex), "@fff", self.size()), self);
             case 2:
-                return BufData(verts, sizeof(float), "@f", 3, self.size());
+                return pin(BufData(verts, sizeof(float), "@f", 3, self.size()), self);
             case 3:
-                return BufData(verts, sizeof(float), "@f", 3, { h, w, 3 }, { w*3*sizeof(float), 3*sizeof(float), sizeof(float) });
+                return pin(BufData(verts, sizeof(float), "@f", 3, { h, w, 3 }, { w*3*sizeof(float), 3*sizeof(float), sizeof(float) }), self);
             default:
                 throw std::domain_error("dims arg only supports values of 1, 2 or 3");
             }
@@ -211,15 +271,28 @@ void init_frame(py::module &m) {
             size_t h = profile.height(), w = profile.width();
             switch (dims) {
             case 1:
-                return BufData(tex, sizeof(rs2::texture_coordinate), "@ff", self.size());
+                return pin(BufData(tex, sizeof(rs2::texture_coordinate), "@ff", self.size()), self);
             case 2:
-                return BufData(tex, sizeof(float), "@f", 2, self.size());
+                return pin(BufData(tex, sizeof(float), "@f", 2, self.size()), self);
             case 3:
-                return BufData(tex, sizeof(float), "@f", 2, { h, w, 2 }, { w*2*sizeof(float), 2*sizeof(float), sizeof(float) });
+                return pin(BufData(tex, sizeof(float), "@f", 2, { h, w, 2 }, { w*2*sizeof(float), 2*sizeof(float), sizeof(float) }), self);
             default:
                 throw std::domain_error("dims arg only supports values of 1, 2 or 3");
             }
         }, "Retrieve the texture coordinates (uv map) for the point cloud", py::keep_alive<0, 1>(), "dims"_a=1)
+        .def("get_vertices_in", [](const rs2::points& self, const std::vector<rs2_pixel_region>& regions) {
+            std::vector<rs2_pixel> pixels;
+            auto vertices = self.get_vertices_in(regions, &pixels);
+            std::vector<std::pair<int, int>> coords;
+            for (auto&& p : pixels)
+                coords.emplace_back(p.ij[0], p.ij[1]);
+            return std::make_pair(vertices, coords);
+        }, "Retrieve the points of regions of the depth image as a compact list, with the depth pixel of each point", "regions"_a)
+        .def("pack", [](const rs2::points& self, rs2_points_format format, bool valid_only) {
+            std::vector<int> indices;
+            auto data = self.pack(format, valid_only, &indices);
+            return std::make_pair(py::bytes(reinterpret_cast<const char*>(data.data()), data.size()), indices);
+        }, "Pack the vertices and the texture coordinates or the colors in a compact format, with the index of the pixel of each point", "format"_a, "valid_only"_a = false)
         .def("export_to_ply", &rs2::points::export_to_ply, "Export the point cloud to a PLY file")
         .def("size", &rs2::points::size); // No docstring in C++
 
@@ -236,7 +309,13 @@ void init_frame(py::module &m) {
     py::class_<rs2::motion_frame, rs2::frame> motion_frame(m, "motion_frame", "Extends the frame class with additional motion related attributes and functions");
     motion_frame.def(py::init<rs2::frame>())
         .def("get_motion_data", &rs2::motion_frame::get_motion_data, "Retrieve the motion data from IMU sensor.")
-        .def_property_readonly("motion_data", &rs2::motion_frame::get_motion_data, "Motion data from IMU sensor. Identical to calling get_motion_data.");
+        .def_property_readonly("motion_data", &rs2::motion_frame::get_motion_data, "Motion data from IMU sensor. Identical to calling get_motion_data.")
+        .def("get_samples_count", &rs2::motion_frame::get_samples_count, "Retrieve the number of samples of the frame, more than one when the sensor batches them.")
+        .def("get_motion_samples", [](const rs2::motion_frame& self) {
+            std::vector<double> timestamps;
+            auto samples = self.get_motion_samples(&timestamps);
+            return std::make_pair(samples, timestamps);
+        }, "Retrieve the motion data and the timestamp of all the samples of the frame.");
 
     py::class_<rs2::pose_frame, rs2::frame> pose_frame(m, "pose_frame", "Extends the frame class with additional pose related attributes and functions.");
     pose_frame.def(py::init<rs2::frame>())
@@ -176,6 +176,7 @@ void init_internal(py::module &m) {
         .def("create_message", &rs2::firmware_logger::create_message, "Create FW Log")
         .def("create_parsed_message", &rs2::firmware_logger::create_parsed_message, "Create FW Parsed Log")
         .def("get_firmware_log", &rs2::firmware_logger::get_firmware_log, "Get FW Log", "msg"_a)
+        .def("get_firmware_logs", &rs2::firmware_logger::get_firmware_logs, "Get up to max_count collected FW logs, waiting up to timeout_ms for the first one", "max_count"_a, "timeout_ms"_a = 0)
         .def("get_flash_log", &rs2::firmware_logger::get_flash_log, "Get Flash Log", "msg"_a)
         .def("init_parser", &rs2::firmware_logger::init_parser, "Initialize Parser with content of xml file",
             "xml_content"_a)
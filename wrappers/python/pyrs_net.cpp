@@ -19,6 +19,24 @@ auto device = (py::object) py::module::import("pyrealsense2").attr("device");
 PYBIND11_MODULE(NAME, m) {
     m.doc() = "Wrapper for the librealsense ethernet device extension module";
 
+    py::class_<rs2_net_stream_statistics> net_stream_statistics(m, "net_stream_statistics", "Reception statistics of a stream of a net device");
+    net_stream_statistics.def(py::init<>())
+        .def_readonly("frames_received", &rs2_net_stream_statistics::frames_received)
+        .def_readonly("frames_lost", &rs2_net_stream_statistics::frames_lost)
+        .def_readonly("frames_dropped", &rs2_net_stream_statistics::frames_dropped)
+        .def_readonly("frames_corrupted", &rs2_net_stream_statistics::frames_corrupted)
+        .def_readonly("frames_reordered", &rs2_net_stream_statistics::frames_reordered)
+        .def_readonly("packets_received", &rs2_net_stream_statistics::packets_received)
+        .def_readonly("packets_lost", &rs2_net_stream_statistics::packets_lost)
+        .def_readonly("jitter_ms", &rs2_net_stream_statistics::jitter_ms)
+        .def_readonly("bitrate_kbps", &rs2_net_stream_statistics::bitrate_kbps)
+        .def_readonly("latency_ms", &rs2_net_stream_statistics::latency_ms)
+        .def_readonly("server_latency_ms", &rs2_net_stream_statistics::server_latency_ms);
+
     py::class_<rs2::net_device> net_device(m, "net_device", device);
     net_device.def(py::init<std::string>(), "address"_a);
+    net_device.def(py::init<std::string, std::string>(), "address"_a, "compression"_a);
+    net_device.def("set_jitter_buffer", &rs2::net_device::set_jitter_buffer, "Delay the frames by up to delay_ms in a jitter buffer", "delay_ms"_a);
+    net_device.def("set_transport", &rs2::net_device::set_transport, "Receive the streams started next over TCP or UDP, with a kernel receive buffer of receive_buffer_kb", "over_tcp"_a, "receive_buffer_kb"_a = 0);
+    net_device.def("get_stream_statistics", &rs2::net_device::get_stream_statistics, "Reception statistics of a stream", "stream"_a, "index"_a = 0);
 }
@@ -10,6 +10,8 @@ void init_options(py::module &m) {
     options.def("is_option_read_only", &rs2::options::is_option_read_only, "Check if particular option "
                 "is read only.", "option"_a)
         .def("get_option", &rs2::options::get_option, "Read option value from the device.", "option"_a)
+        .def("get_options", &rs2::options::get_options, "Read the values of several options in one pass, NaN for the options "
+             "that are not supported or failed to read.", "ids"_a)
         .def("get_option_range", &rs2::options::get_option_range, "Retrieve the available range of values "
              "of a supported option", "option"_a)
         .def("set_option", &rs2::options::set_option, "Write new value to device option", "option"_a, "value"_a)
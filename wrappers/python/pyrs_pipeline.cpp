@@ -67,6 +67,10 @@ void init_pipeline(py::module &m) {
              "The stream can still be enabled due to pipeline computer vision module request. This call removes any filter on the stream configuration.", "stream"_a, "index"_a = -1)
         .def("disable_all_streams", &rs2::config::disable_all_streams, "Disable all device stream explicitly, to remove any requests on the streams profiles.\n"
              "The streams can still be enabled due to pipeline computer vision module request. This call removes any filter on the streams configuration.")
+        .def("set_sync_latency_budget", &rs2::config::set_sync_latency_budget, "Limit the time the pipeline waits for the missing streams of a frameset, "
+             "0 disables the limit.", "budget_ms"_a)
+        .def("set_callback_mailbox_size", &rs2::config::set_callback_mailbox_size, "Call the callback of the pipeline on a dedicated thread, "
+             "through a mailbox per stream of size frames, the oldest frame replaced when full. 0 calls it on the syncer thread.", "size"_a)
         .def("resolve", [](rs2::config* c, pipeline_wrapper pw) -> rs2::pipeline_profile { return c->resolve(pw._ptr); }, "Resolve the configuration filters, "
              "to find a matching device and streams profiles.\n"
              "The method resolves the user configuration filters for the device and streams, and combines them with the requirements of the computer vision modules "
@@ -79,6 +83,24 @@ void init_pipeline(py::module &m) {
              "to enforce the device returned by this method is selected by pipeline start(), and configure the device and sensors options or extensions before streaming starts.", "p"_a)
         .def("can_resolve", [](rs2::config* c, pipeline_wrapper pw) -> bool { return c->can_resolve(pw._ptr); }, "Check if the config can resolve the configuration filters, "
              "to find a matching device and streams profiles. The resolution conditions are as described in resolve().", "p"_a);
+
+    m.def("resolve_bandwidth", [](const std::vector<rs2::config>& configs, const std::vector<rs2::pipeline>& pipes) {
+        bool fits;
+        auto profiles = rs2::resolve_bandwidth(configs, pipes, &fits);
+        return std::make_tuple(profiles, fits);
+    }, "Resolve the configs of several pipelines together, for devices that may share USB links.\n"
+       "While the estimated payload of the streams on a link exceeds what the link carries, the most loaded device on it is given "
+       "the next lower frame rate its requests leave unspecified, and then the next smaller resolution. The configs are updated to request "
+       "the planned device and streams. Returns the profile of each config, and False when a link remains oversubscribed.", "configs"_a, "pipes"_a);
+
+    m.def("start_pipelines", [](const std::vector<rs2::pipeline>& pipes, const std::vector<rs2::config>& configs, int max_parallel) {
+        std::vector<rs2_pipeline_start_report> reports;
+        auto profiles = rs2::start_pipelines(pipes, configs, max_parallel, &reports);
+        return std::make_tuple(profiles, reports);
+    }, "Start several pipelines together, as the cameras of a rig, on up to max_parallel threads, 0 to start them all at once.\n"
+       "The configs should select different devices with enable_device(). A failing start does not stop the others, the pipelines "
+       "that started remain started and the error of the first failing pipeline is raised. Returns the active profile and the start "
+       "report of each pipeline.", "pipes"_a, "configs"_a, "max_parallel"_a = 0, py::call_guard<py::gil_scoped_release>());
     
     py::class_<rs2::pipeline> pipeline(m, "pipeline", "The pipeline simplifies the user interaction with the device and computer vision processing modules.\n"
                                        "The class abstracts the camera configuration and streaming, and the vision modules triggering and threading.\n"
@@ -92,7 +114,7 @@ void init_pipeline(py::module &m) {
              "blocks, according to each module requirements and threading model.\n"
              "During the loop execution, the application can access the camera streams by calling wait_for_frames() or poll_for_frames().\n"
              "The streaming loop runs until the pipeline is stopped.\n"
-             "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n")
+             "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n", py::call_guard<py::gil_scoped_release>())
         .def("start", (rs2::pipeline_profile(rs2::pipeline::*)(const rs2::config&)) &rs2::pipeline::start, "Start the pipeline streaming according to the configuraion.\n"
              "The pipeline streaming loop captures samples from the device, and delivers them to the attached computer vision modules and processing blocks, according to "
              "each module requirements and threading model.\n"
@@ -103,12 +125,20 @@ void init_pipeline(py::module &m) {
              "When the rs2::config is provided to the method, the pipeline tries to activate the config resolve() result.\n"
              "If the application requests are conflicting with pipeline computer vision modules or no matching device is available on the platform, the method fails.\n"
              "Available configurations and devices may change between config resolve() call and pipeline start, in case devices are connected or disconnected, or another "
-             "application acquires ownership of a device.", "config"_a)
-        .def("start", [](rs2::pipeline& self, std::function<void(rs2::frame)> f) { return self.start(f); }, "Start the pipeline streaming with its default configuration.\n"
+             "application acquires ownership of a device.", "config"_a, py::call_guard<py::gil_scoped_release>())
+        .def("start", [](rs2::pipeline& self, py::function f) {
+                frame_callback_batcher batcher(f);
+                py::gil_scoped_release release;
+                return self.start(batcher);
+            }, "Start the pipeline streaming with its default configuration.\n"
              "The pipeline captures samples from the device, and delivers them to the provided frame callback.\n"
              "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n"
              "When starting the pipeline with a callback both wait_for_frames() and poll_for_frames() will throw exception.", "callback"_a)
-        .def("start", [](rs2::pipeline& self, const rs2::config& config, std::function<void(rs2::frame)> f) { return self.start(config, f); }, "Start the pipeline streaming according to the configuraion.\n"
+        .def("start", [](rs2::pipeline& self, const rs2::config& config, py::function f) {
+                frame_callback_batcher batcher(f);
+                py::gil_scoped_release release;
+                return self.start(config, batcher);
+            }, "Start the pipeline streaming according to the configuraion.\n"
              "The pipeline captures samples from the device, and delivers them to the provided frame callback.\n"
              "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n"
              "When starting the pipeline with a callback both wait_for_frames() and poll_for_frames() will throw exception.\n"
@@ -120,7 +150,7 @@ void init_pipeline(py::module &m) {
         .def("start", [](rs2::pipeline& self, rs2::frame_queue& queue) { return self.start(queue); },"Start the pipeline streaming with its default configuration.\n"
              "The pipeline captures samples from the device, and delivers them to the provided frame queue.\n"
              "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n"
-             "When starting the pipeline with a callback both wait_for_frames() and poll_for_frames() will throw exception.", "queue"_a)
+             "When starting the pipeline with a callback both wait_for_frames() and poll_for_frames() will throw exception.", "queue"_a, py::call_guard<py::gil_scoped_release>())
         .def("start", [](rs2::pipeline& self, const rs2::config& config, rs2::frame_queue queue) { return self.start(config, queue); }, "Start the pipeline streaming according to the configuraion.\n"
             "The pipeline captures samples from the device, and delivers them to the provided frame queue.\n"
             "Starting the pipeline is possible only when it is not started. If the pipeline was started, an exception is raised.\n"
@@ -129,7 +159,7 @@ void init_pipeline(py::module &m) {
             "When the rs2::config is provided to the method, the pipeline tries to activate the config resolve() result.\n"
             "If the application requests are conflicting with pipeline computer vision modules or no matching device is available on the platform, the method fails.\n"
             "Available configurations and devices may change between config resolve() call and pipeline start, in case devices are connected or disconnected, "
-            "or another application acquires ownership of a device.", "config"_a, "queue"_a)
+            "or another application acquires ownership of a device.", "config"_a, "queue"_a, py::call_guard<py::gil_scoped_release>())
         .def("stop", &rs2::pipeline::stop, "Stop the pipeline streaming.\n"
              "The pipeline stops delivering samples to the attached computer vision modules and processing blocks, stops the device streaming and releases "
              "the device resources used by the pipeline. It is the application's responsibility to release any frame reference it owns.\n"
@@ -154,12 +184,34 @@ void init_pipeline(py::module &m) {
              "To avoid frame drops, this method should be called as fast as the device frame rate.\n"
              "The application can maintain the frames handles to defer processing. However, if the application maintains too long "
              "history, the device may lack memory resources to produce new frames, and the following calls to this method shall "
-             "return no new frames, until resources become available.")
+             "return no new frames, until resources become available.", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frames", [](const rs2::pipeline &self, unsigned int timeout_ms) {
             rs2::frameset fs;
             auto success = self.try_wait_for_frames(&fs, timeout_ms);
             return std::make_tuple(success, fs);
         }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>())
-        .def("get_active_profile", &rs2::pipeline::get_active_profile); // No docstring in C++
+        .def("wait_for_frame_data", [](const rs2::pipeline &self, unsigned int timeout_ms) {
+            // The wait and the collection of the buffers run without the GIL, which is taken once to build the dict
+            std::vector<std::pair<std::string, BufData>> buffers;
+            {
+                py::gil_scoped_release release;
+                auto fs = self.wait_for_frames(timeout_ms);
+                buffers.reserve(fs.size());
+                for (auto&& f : fs)
+                    buffers.emplace_back(f.get_profile().stream_name(), get_frame_data(f));
+            }
+            py::dict arrays;
+            for (auto& b : buffers)
+                arrays[py::str(b.first)] = py::cast(std::move(b.second));
+            return arrays;
+        }, "Wait until a new set of frames becomes available, like wait_for_frames, and return the data of its frames as "
+             "a dict from the stream name (e.g. 'Depth', 'Infrared 1') to a buffer. The buffers do not copy the data: "
+             "numpy.asanyarray() of a buffer uses the memory of its frame, and the frame is released when the last array using it is.",
+             "timeout_ms"_a = 5000)
+        .def("add_consumer", &rs2::pipeline::add_consumer, "Add a consumer queue, receiving every frames set that wait_for_frames returns "
+             "in addition to it. Each queue drops its oldest frames set when it is full.", "queue"_a, py::keep_alive<1, 2>())
+        .def("remove_consumer", &rs2::pipeline::remove_consumer, "Remove a consumer queue added by add_consumer.", "queue"_a)
+        .def("get_active_profile", &rs2::pipeline::get_active_profile) // No docstring in C++
+        .def("get_metrics", &rs2::pipeline::get_metrics, "Retrieve the frame counters of the streams of the sensors used by the pipeline.");
     /** end rs_pipeline.hpp **/
 }
@@ -35,14 +35,26 @@ void init_processing(py::module &m) {
             rs2::frame frame;
             self.poll_for_frame(&frame);
             return frame;
-        }, "Poll if a new frame is available and dequeue it if it is")
+        }, "Poll if a new frame is available and dequeue it if it is", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frame", [](const rs2::frame_queue &self, unsigned int timeout_ms) {
             rs2::frame frame;
             auto success = self.try_wait_for_frame(&frame, timeout_ms);
             return std::make_tuple(success, frame);
         }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()) // No docstring in C++
+        .def("poll_for_frames", [](const rs2::frame_queue &self, size_t max_frames) {
+            std::vector<rs2::frame> frames(max_frames);
+            frames.resize(self.poll_for_frames(frames.data(), max_frames));
+            return frames;
+        }, "Dequeue the frames available in the queue, up to max_frames of them, without waiting.", "max_frames"_a, py::call_guard<py::gil_scoped_release>())
+        .def("wait_for_frames", [](const rs2::frame_queue &self, size_t max_frames, unsigned int timeout_ms) {
+            std::vector<rs2::frame> frames(max_frames);
+            frames.resize(self.wait_for_frames(frames.data(), max_frames, timeout_ms));
+            return frames;
+        }, "Wait until a frame becomes available in the queue, then dequeue it together with the frames following it, up to max_frames frames. "
+           "Returns an empty list if no frame arrived in time.", "max_frames"_a, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>())
         .def("__call__", &rs2::frame_queue::operator(), "Identical to calling enqueue.", "f"_a)
         .def("capacity", &rs2::frame_queue::capacity, "Return the capacity of the queue.")
+        .def("get_metrics", &rs2::frame_queue::get_metrics, "Retrieve the frames waiting in the queue and the frames it dropped.")
         .def("keep_frames", &rs2::frame_queue::keep_frames, "Return whether or not the queue calls keep on enqueued frames.");
 
     py::class_<rs2::processing_block, rs2::options> processing_block(m, "processing_block", "Define the processing block workflow, inherit this class to "
@@ -50,10 +62,13 @@ void init_processing(py::module &m) {
     processing_block.def(py::init([](std::function<void(rs2::frame, rs2::frame_source&)> processing_function) {
             return new rs2::processing_block(processing_function);
         }), "processing_function"_a)
-        .def("start", [](rs2::processing_block& self, std::function<void(rs2::frame)> f) {
-            self.start(f);
+        .def("start", [](rs2::processing_block& self, py::function f) {
+            frame_callback_batcher batcher(f);
+            py::gil_scoped_release release;
+            self.start(batcher);
         }, "Start the processing block with callback function to inform the application the frame is processed.", "callback"_a)
-        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a)
+        .def("invoke", &rs2::processing_block::invoke, "Ask processing block to process the frame", "f"_a, py::call_guard<py::gil_scoped_release>())
+        .def("get_metrics", &rs2::processing_block::get_metrics, "Retrieve the frames processed by the block and the time it spent on them.")
         .def("supports", (bool (rs2::processing_block::*)(rs2_camera_info) const) &rs2::processing_block::supports, "Check if a specific camera info field is supported.")
         .def("get_info", &rs2::processing_block::get_info, "Retrieve camera specific information, like versions of various internal components.");
         /*.def("__call__", &rs2::processing_block::operator(), "f"_a)*/
@@ -80,8 +95,10 @@ void init_processing(py::module &m) {
     py::class_<rs2::pointcloud, rs2::filter> pointcloud(m, "pointcloud", "Generates 3D point clouds based on a depth frame. Can also map textures from a color frame.");
     pointcloud.def(py::init<>())
         .def(py::init<rs2_stream, int>(), "stream"_a, "index"_a = 0)
-        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a)
-        .def("map_to", &rs2::pointcloud::map_to, "Map the point cloud to the given color frame.", "mapped"_a);
+        .def("calculate", &rs2::pointcloud::calculate, "Generate the pointcloud and texture mappings of depth map.", "depth"_a, py::call_guard<py::gil_scoped_release>())
+        .def("map_to", &rs2::pointcloud::map_to, "Map the point cloud to the given color frame.", "mapped"_a, py::call_guard<py::gil_scoped_release>())
+        .def("set_regions", &rs2::pointcloud::set_regions, "Compute the points of regions of the depth image only, "
+            "an empty list processes the whole image again.", "regions"_a);
 
     py::class_<rs2::yuy_decoder, rs2::filter> yuy_decoder(m, "yuy_decoder", "Converts frames in raw YUY format to RGB. This conversion is somewhat costly, "
                                                           "but the SDK will automatically try to use SSE2, AVX, or CUDA instructions where available to "
@@ -93,6 +110,28 @@ void init_processing(py::module &m) {
                                                              "or too small, as a software post-processing step");
     threshold.def(py::init<float, float>(), "min_dist"_a = 0.15f, "max_dist"_a = 4.f);
 
+    py::class_<rs2::voxel_grid_filter, rs2::filter> voxel_grid(m, "voxel_grid_filter", "Downsamples depth frames or points to a point per "
+                                                               "occupied voxel, the centroid of its points.");
+    voxel_grid.def(py::init<float>(), "voxel_size"_a = 0.01f);
+
+    py::class_<rs2::depth_to_scan, rs2::filter> depth_to_scan(m, "depth_to_scan", "Converts a band of depth rows to a 2D scan, "
+                                                              "the nearest range in the horizontal plane per angle bin.");
+    depth_to_scan.def(py::init<int, int>(), "bins"_a = 640, "rows"_a = 10)
+        .def_static("get_angles", [](const rs2_intrinsics& depth_intrinsics, int bins) {
+            float angle_min, angle_increment;
+            rs2::depth_to_scan::get_angles(depth_intrinsics, bins, angle_min, angle_increment);
+            return std::make_tuple(angle_min, angle_increment);
+        }, "Angle of the first bin and angle between bins of the scans of the depth of the given intrinsics, in radians.",
+            "depth_intrinsics"_a, "bins"_a);
+
+    py::class_<rs2::median_filter, rs2::filter> median(m, "median_filter", "Replaces every depth pixel by the median of the valid "
+                                                       "depth of its 3x3 or 5x5 neighborhood, the holes are kept.");
+    median.def(py::init<int>(), "radius"_a = 1);
+
+    py::class_<rs2::tensor_converter, rs2::filter> tensor_converter(m, "tensor_converter", "Converts color to the planar input tensor "
+                                                                    "of a network, resized and normalized to (value - mean) * scale.");
+    tensor_converter.def(py::init<int, int, float, float>(), "width"_a = 300, "height"_a = 300, "mean"_a = 0.f, "scale"_a = 1.f);
+
     py::class_<rs2::units_transform, rs2::filter> units_transform(m, "units_transform");
     units_transform.def(py::init<>());
 
@@ -106,19 +145,36 @@ void init_processing(py::module &m) {
             rs2::frameset frames;
             self.poll_for_frames(&frames);
             return frames;
-        }, "Check if a coherent set of frames is available")
+        }, "Check if a coherent set of frames is available", py::call_guard<py::gil_scoped_release>())
         .def("try_wait_for_frames", [](const rs2::syncer &self, unsigned int timeout_ms) {
             rs2::frameset fs;
             auto success = self.try_wait_for_frames(&fs, timeout_ms);
             return std::make_tuple(success, fs);
-        }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()); // No docstring in C++
+        }, "timeout_ms"_a = 5000, py::call_guard<py::gil_scoped_release>()) // No docstring in C++
+        .def("set_latency_budget", &rs2::syncer::set_latency_budget, "Limit the time a frame waits for the missing streams of its frameset, "
+             "0 disables the limit", "budget_ms"_a);
         /*.def("__call__", &rs2::syncer::operator(), "frame"_a)*/
 
+    py::class_<rs2::multi_device_syncer, rs2::syncer> multi_device_syncer(m, "multi_device_syncer", "Sync instance to match frames from the sensors of several devices on the host clock");
+    multi_device_syncer.def(py::init<float, int>(), "tolerance_ms"_a = 0.f, "queue_size"_a = 1);
+
     py::class_<rs2::align, rs2::filter> align(m, "align", "Performs alignment between depth image and another image.");
     align.def(py::init<rs2_stream>(), "To perform alignment of a depth image to the other, set the align_to parameter with the other stream type.\n"
               "To perform alignment of a non depth image to a depth image, set the align_to parameter to RS2_STREAM_DEPTH.\n"
               "Camera calibration and frame's stream type are determined on the fly, according to the first valid frameset passed to process().", "align_to"_a)
-        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a);
+        .def(py::init<const std::vector<rs2_stream>&>(), "Aligns the depth image to several streams in one pass, for example to both color and infrared.\n"
+              "The output holds an aligned depth frame per target found in the frameset, in the order of the targets.", "align_to"_a)
+        .def("process", (rs2::frameset(rs2::align::*)(rs2::frameset)) &rs2::align::process, "Run thealignment process on the given frames to get an aligned set of frames", "frames"_a, py::call_guard<py::gil_scoped_release>())
+        .def("set_regions", &rs2::align::set_regions, "Align regions of the depth image only, "
+            "an empty list aligns the whole image again.", "regions"_a);
+
+    py::class_<rs2::align_pointcloud, rs2::filter> align_pointcloud(m, "align_pointcloud", "Aligns the depth to another stream and computes "
+        "the pointcloud textured by it, from a single deprojection of each depth pixel.");
+    align_pointcloud.def(py::init<rs2_stream>(), "The output holds the points and the depth aligned to the align_to stream, in place of the depth.", "align_to"_a)
+        .def("process", (rs2::frameset(rs2::align_pointcloud::*)(rs2::frameset)) &rs2::align_pointcloud::process, "Align the depth and compute "
+            "the points of the given frames", "frames"_a, py::call_guard<py::gil_scoped_release>())
+        .def("set_regions", &rs2::align_pointcloud::set_regions, "Process regions of the depth image only, "
+            "an empty list processes the whole image again.", "regions"_a);
 
     py::class_<rs2::colorizer, rs2::filter> colorizer(m, "colorizer", "Colorizer filter generates color images based on input depth frame");
     colorizer.def(py::init<>())
@@ -132,7 +188,7 @@ void init_processing(py::module &m) {
              "6 - Warm\n"
              "7 - Quantized\n"
              "8 - Pattern", "color_scheme"_a)
-        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a)
+        .def("colorize", &rs2::colorizer::colorize, "Start to generate color image base on depth frame", "depth"_a, py::call_guard<py::gil_scoped_release>())
         /*.def("__call__", &rs2::colorizer::operator())*/;
 
     py::class_<rs2::decimation_filter, rs2::filter> decimation_filter(m, "decimation_filter", "Performs downsampling by using the median with specific kernel size.");
@@ -174,6 +230,11 @@ void init_processing(py::module &m) {
              "1 - farest_from_around - Use the value from the neighboring pixel which is furthest away from the sensor\n"
              "2 - nearest_from_around - -Use the value from the neighboring pixel closest to the sensor", "mode"_a);
 
+    py::class_<rs2::depth_filter_chain, rs2::filter> depth_filter_chain(m, "depth_filter_chain", "Runs the recommended depth filters in one pass: "
+                                                                        "decimation, spatial, temporal and hole filling in the disparity domain.");
+    depth_filter_chain.def(py::init<>())
+        .def("get_stage", &rs2::depth_filter_chain::get_stage, "Retrieve a stage of the chain, to set its options.", "stage"_a);
+
     py::class_<rs2::depth_huffman_decoder, rs2::filter> depth_huffman_decoder(m, "depth_huffman_decoder", "Decompresses Huffman-encoded Depth frame to standartized Z16 format");
     depth_huffman_decoder.def(py::init<>());
 
@@ -183,6 +244,10 @@ void init_processing(py::module &m) {
     py::class_<rs2::sequence_id_filter, rs2::filter> sequence_id_filter(m, "sequence_id_filter", "Splits depth frames with different sequence ID");
     sequence_id_filter.def(py::init<>())
         .def(py::init<float>(), "sequence_id"_a);
+
+    py::class_<rs2::sequence_id_demux, rs2::filter> sequence_id_demux(m, "sequence_id_demux", "Splits a stream into virtual streams "
+        "per sequence ID, or per emitter state, without copying the frames");
+    sequence_id_demux.def(py::init<>());
     // rs2::rates_printer
     /** end rs_processing.hpp **/
 }
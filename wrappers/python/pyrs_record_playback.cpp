@@ -22,6 +22,12 @@ void init_record_playback(py::module &m) {
              "play the same way the file was recorded. If the application takes too long to handle the callback, frames may be dropped. In non real time "
              "mode, playback will wait for each callback to finish handling the data before reading the next frame. In this mode no frames will be dropped, "
              "and the application controls the framerate of playback via callback duration.", "real_time"_a)
+        .def("set_ordered_delivery", &rs2::playback::set_ordered_delivery, "Select whether a non real time playback publishes the frames of all the streams "
+             "one at a time in recording order, instead of from a thread per stream.", "ordered"_a)
+        .def("join", &rs2::playback::join, "Play this device together with another playback device, on a single read thread and clock, "
+             "in the order of the recorded system time. The devices are joined while stopped.", "other"_a)
+        .def("set_frame_cache_size", &rs2::playback::set_frame_cache_size, "Keep the last frames read in memory, so stepping back and scrubbing "
+             "around the current time do not read the file again. 0 disables the cache.", "frames"_a)
         // set_playback_speed?
         .def("set_status_changed_callback", [](rs2::playback& self, std::function<void(rs2_playback_status)> callback) {
             self.set_status_changed_callback(callback);
@@ -34,7 +40,22 @@ void init_record_playback(py::module &m) {
     recorder.def(py::init<const std::string&, rs2::device>())
         .def(py::init<const std::string&, rs2::device, bool>())
         .def("pause", &rs2::recorder::pause, "Pause the recording device without stopping the actual device from streaming.")
-        .def("resume", &rs2::recorder::resume, "Unpauses the recording device, making it resume recording.");
+        .def("resume", &rs2::recorder::resume, "Unpauses the recording device, making it resume recording.")
+        .def("set_blocking_write", &rs2::recorder::set_blocking_write, "Select whether a frame arriving while the write cache is full "
+             "waits for the file writer or is dropped.", "blocking"_a)
+        .def("written_frames", &rs2::recorder::written_frames, "Gets the number of frames the recorder wrote to the file")
+        .def("dropped_frames", &rs2::recorder::dropped_frames, "Gets the number of frames the recorder dropped because its write cache was full")
+        .def("set_frame_compression", &rs2::recorder::set_frame_compression, "Select the compression of the images recorded for a stream. "
+             "Depth supports rvl and lz4, color supports jpeg and lz4.", "stream"_a, "compression"_a)
+        .def("set_file_per_stream", &rs2::recorder::set_file_per_stream, "Write every stream to a file of its own, by a thread of its own. "
+             "Playing the recording file plays all of them.", "file_per_stream"_a)
+        .def("set_stream_decimation", &rs2::recorder::set_stream_decimation, "Record only every Nth frame of a stream.", "stream"_a, "every_nth"_a)
+        .def("set_stream_processing", &rs2::recorder::set_stream_processing, "Record the output of a processing block instead of the frames of a stream. "
+             "Must be set before the stream is opened.", "stream"_a, "block"_a)
+        .def("set_stream_trigger", &rs2::recorder::set_stream_trigger, "Record a stream only around triggers, holding its last pre_trigger_seconds "
+             "of frames in memory until trigger is called.", "stream"_a, "pre_trigger_seconds"_a, "post_trigger_seconds"_a)
+        .def("trigger", &rs2::recorder::trigger, "Write the frames held for the triggered streams, and record their following post trigger seconds.")
+        .def("clear_stream_policy", &rs2::recorder::clear_stream_policy, "Record every frame of a stream again.", "stream"_a);
     // filename?
     /** end rs_record_playback.hpp **/
 }
@@ -37,7 +37,7 @@ void init_sensor(py::module &m) {
 
     py::class_<rs2::sensor, rs2::options> sensor(m, "sensor"); // No docstring in C++
     sensor.def("open", (void (rs2::sensor::*)(const rs2::stream_profile&) const) &rs2::sensor::open,
-               "Open sensor for exclusive access, by commiting to a configuration", "profile"_a)
+               "Open sensor for exclusive access, by commiting to a configuration", "profile"_a, py::call_guard<py::gil_scoped_release>())
         .def("supports", (bool (rs2::sensor::*)(rs2_camera_info) const) &rs2::sensor::supports,
              "Check if specific camera info is supported.", "info")
         .def("supports", (bool (rs2::sensor::*)(rs2_option) const) &rs2::options::supports,
@@ -49,20 +49,24 @@ void init_sensor(py::module &m) {
         }, "Register Notifications callback", "callback"_a)
         .def("open", (void (rs2::sensor::*)(const std::vector<rs2::stream_profile>&) const) &rs2::sensor::open,
              "Open sensor for exclusive access, by committing to a composite configuration, specifying one or "
-             "more stream profiles.", "profiles"_a)
+             "more stream profiles.", "profiles"_a, py::call_guard<py::gil_scoped_release>())
         .def("close", &rs2::sensor::close, "Close sensor for exclusive access.", py::call_guard<py::gil_scoped_release>())
-        .def("start", [](const rs2::sensor& self, std::function<void(rs2::frame)> callback) {
-            self.start(callback);
+        .def("start", [](const rs2::sensor& self, py::function callback) {
+            frame_callback_batcher batcher(callback);
+            py::gil_scoped_release release;
+            self.start(batcher);
         }, "Start passing frames into user provided callback.", "callback"_a)
         .def("start", [](const rs2::sensor& self, rs2::syncer& syncer) {
             self.start(syncer);
-        }, "Start passing frames into user provided syncer.", "syncer"_a)
+        }, "Start passing frames into user provided syncer.", "syncer"_a, py::call_guard<py::gil_scoped_release>())
         .def("start", [](const rs2::sensor& self, rs2::frame_queue& queue) {
             self.start(queue);
-        }, "start passing frames into specified frame_queue", "queue"_a)
+        }, "start passing frames into specified frame_queue", "queue"_a, py::call_guard<py::gil_scoped_release>())
         .def("stop", &rs2::sensor::stop, "Stop streaming.", py::call_guard<py::gil_scoped_release>())
         .def("get_stream_profiles", &rs2::sensor::get_stream_profiles, "Retrieves the list of stream profiles supported by the sensor.")
         .def("get_active_streams", &rs2::sensor::get_active_streams, "Retrieves the list of stream profiles currently streaming on the sensor.")
+        .def("get_metrics", &rs2::sensor::get_metrics, "Retrieves the frame counters of the streams of the sensor.")
+        .def("get_frame_pool_metrics", &rs2::sensor::get_frame_pool_metrics, "Retrieves the usage of the frame buffers of the sensor.")
         .def_property_readonly("profiles", &rs2::sensor::get_stream_profiles, "The list of stream profiles supported by the sensor. Identical to calling get_stream_profiles")
         .def("get_recommended_filters", &rs2::sensor::get_recommended_filters, "Return the recommended list of filters by the sensor.")
         .def(py::init<>())
@@ -162,6 +166,17 @@ void init_sensor(py::module &m) {
         .def("remove_static_node", &rs2::pose_sensor::remove_static_node,
              "Removes a named virtual landmark in the current map, known as static node.\n"
              "guid"_a)
+        .def("get_latest_pose", [](const rs2::pose_sensor& self) {
+            rs2_pose pose;
+            double timestamp = 0;
+            bool ok;
+            {
+                py::gil_scoped_release release;
+                ok = self.get_latest_pose(pose, timestamp);
+            }
+            return std::make_tuple(ok, pose, timestamp);
+        }, "Returns the latest pose received from the device and its timestamp, without going through a frame queue or callback.\n"
+           "The first element of the returned tuple is false if no pose was received since the sensor was started.")
         .def("__nonzero__", &rs2::pose_sensor::operator bool); // No docstring in C++
 
     py::class_<rs2::wheel_odometer, rs2::sensor> wheel_odometer(m, "wheel_odometer"); // No docstring in C++
@@ -69,5 +69,49 @@ void init_util(py::module &m) {
     m.def("rs2_project_color_pixel_to_depth_pixel", cp_to_dp, "data"_a, "depth_scale"_a,
           "depth_min"_a, "depth_max"_a, "depth_intrin"_a, "color_intrin"_a, "depth_to_color"_a,
           "color_to_depth"_a, "from_pixel"_a);
+    m.def("rs2_deproject_pixels_to_points", [](const rs2_intrinsics& intrin, const std::vector<std::array<float, 2>>& pixels, const std::vector<float>& depths)
+    {
+        if (pixels.size() != depths.size())
+            throw std::invalid_argument("pixels and depths must be of the same size");
+        std::vector<std::array<float, 3>> points(pixels.size());
+        if (points.empty())
+            return points;
+        rs2_error* e = nullptr;
+        rs2_deproject_pixels_to_points(points[0].data(), &intrin, pixels[0].data(), depths.data(), int(pixels.size()), &e);
+        rs2::error::handle(e);
+        return points;
+    }, "Batch version of rs2_deproject_pixel_to_point", "intrin"_a, "pixels"_a, "depths"_a);
+
+    m.def("rs2_project_points_to_pixels", [](const rs2_intrinsics& intrin, const std::vector<std::array<float, 3>>& points)
+    {
+        std::vector<std::array<float, 2>> pixels(points.size());
+        if (pixels.empty())
+            return pixels;
+        rs2_error* e = nullptr;
+        rs2_project_points_to_pixels(pixels[0].data(), &intrin, points[0].data(), int(points.size()), &e);
+        rs2::error::handle(e);
+        return pixels;
+    }, "Batch version of rs2_project_point_to_pixel", "intrin"_a, "points"_a);
+
+    auto cps_to_dps = [](BufData data, float depth_scale, float depth_min, float depth_max,
+            const rs2_intrinsics& depth_intrin, const rs2_intrinsics& color_intrin,
+            const rs2_extrinsics& color_to_depth, const rs2_extrinsics& depth_to_color,
+            const std::vector<std::array<float, 2>>& from_pixels)
+    {
+        std::vector<std::array<float, 2>> to_pixels(from_pixels.size());
+        if (to_pixels.empty())
+            return to_pixels;
+        rs2_error* e = nullptr;
+        rs2_project_color_pixels_to_depth_pixels(to_pixels[0].data(), static_cast<const uint16_t*>(data._ptr),
+                depth_scale, depth_min, depth_max, &depth_intrin, &color_intrin, &color_to_depth,
+                &depth_to_color, from_pixels[0].data(), int(from_pixels.size()), &e);
+        rs2::error::handle(e);
+        return to_pixels;
+    };
+
+    m.def("rs2_project_color_pixels_to_depth_pixels", cps_to_dps, "Batch version of rs2_project_color_pixel_to_depth_pixel, "
+          "the pixels with no valid depth along their line are mapped to (-1, -1)", "data"_a, "depth_scale"_a,
+          "depth_min"_a, "depth_max"_a, "depth_intrin"_a, "color_intrin"_a, "color_to_depth"_a,
+          "depth_to_color"_a, "from_pixels"_a);
     /** end rsutil.h **/
 }
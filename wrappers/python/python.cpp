@@ -40,6 +40,12 @@ PYBIND11_MODULE(NAME, m) {
 
     m.def("log_to_console", &rs2::log_to_console, "min_severity"_a);
     m.def("log_to_file", &rs2::log_to_file, "min_severity"_a, "file_path"_a);
+    m.def("enable_frame_trace", &rs2::enable_frame_trace, "Stamp the frames with the times they reach the stages of the frame path.", "enable"_a);
+    m.def("start_frame_trace_file", &rs2::start_frame_trace_file, "Enable the frame trace and write the stamps of the released frames to a Chrome trace event file.", "file_path"_a);
+    m.def("stop_frame_trace_file", &rs2::stop_frame_trace_file, "Complete and close the frame trace file.");
+    m.def("get_memory_usage", &rs2::get_memory_usage, "Bytes held by the library in the whole process.");
+    m.def("set_memory_budget", &rs2::set_memory_budget, "Limit the frame buffers of the whole process, 0 bytes for no limit.",
+          "bytes"_a, "policy"_a = RS2_MEMORY_BUDGET_POLICY_DROP);
 
     // Access to log_message is only from a callback (see log_to_callback below) and so already
     // should have the GIL acquired
@@ -25,6 +25,13 @@ Copyright(c) 2017 Intel Corporation. All Rights Reserved. */
 #define SNAME "pyrealsense2"
 // For rs2_format
 #include "../include/librealsense2/h/rs_sensor.h"
+// For the frame a BufData keeps alive
+#include "../include/librealsense2/hpp/rs_frame.hpp"
+
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -201,6 +208,7 @@ public:
     size_t _ndim = 0;             // Number of dimensions
     std::vector<size_t> _shape;   // Shape of the tensor (1 entry per dimension)
     std::vector<size_t> _strides; // Number of entries between adjacent entries (for each per dimension)
+    rs2::frame _frame;            // The frame that owns the storage, kept alive as long as the buffer is
 public:
     BufData(void *ptr, size_t itemsize, const std::string& format, size_t ndim, const std::vector<size_t> &shape, const std::vector<size_t> &strides)
         : _ptr(ptr), _itemsize(itemsize), _format(format), _ndim(ndim), _shape(shape), _strides(strides) {}
@@ -214,6 +222,76 @@ public:
         : BufData(ptr, itemsize, format, 2, std::vector<size_t> { count, dim }, std::vector<size_t> { itemsize*dim, itemsize }) { }
 };
 
+// The data of a frame, without copying it: a video frame as a 2D (or 3D for RGB) array, or the raw bytes otherwise
+BufData get_frame_data(const rs2::frame& self);
+
+// Delivers the frames of a native callback to a Python callable, to be passed where a frame callback is
+// expected. The frames that arrive from other threads while the GIL is taken by the one delivering are
+// queued and delivered by it, so a burst of frames takes the GIL once instead of once per frame.
+class frame_callback_batcher
+{
+    struct state
+    {
+        py::function callback;
+        std::mutex mutex;
+        std::vector<rs2::frame> pending;
+        bool delivering = false;
+
+        ~state()
+        {
+            // The last copy of the callback may go away on a native thread
+            py::gil_scoped_acquire gil;
+            callback = py::function();
+        }
+    };
+    std::shared_ptr<state> _state;
+
+public:
+    // Must be called with the GIL held
+    explicit frame_callback_batcher(py::function callback)
+        : _state(std::make_shared<state>())
+    {
+        _state->callback = std::move(callback);
+    }
+
+    void operator()(rs2::frame f) const
+    {
+        std::vector<rs2::frame> batch;
+        {
+            std::lock_guard<std::mutex> lock(_state->mutex);
+            _state->pending.push_back(std::move(f));
+            if (_state->delivering)
+                return;  // will be delivered with the rest of the batch
+            _state->delivering = true;
+        }
+        py::gil_scoped_acquire gil;
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_state->mutex);
+                batch.clear();
+                batch.swap(_state->pending);
+                if (batch.empty())
+                {
+                    _state->delivering = false;
+                    return;
+                }
+            }
+            for (auto& frame : batch)
+            {
+                try
+                {
+                    _state->callback(frame);
+                }
+                catch (py::error_already_set const& e)
+                {
+                    std::cerr << "exception in python frame callback: " << e.what() << std::endl;
+                }
+            }
+        }
+    }
+};
+
 /*PYBIND11_MAKE_OPAQUE(std::vector<rs2::stream_profile>)*/
 
 // Partial module definition functions
@@ -153,7 +153,7 @@ public class RsPointCloudRenderer : MonoBehaviour
                     if (points.TextureData != IntPtr.Zero)
                     {
                         uvmap.LoadRawTextureData(points.TextureData, points.Count * sizeof(float) * 2);
-                        uvmap.Apply();
+                        uvmap.Apply(false);
                     }
 
                     if (points.VertexData != IntPtr.Zero)
@@ -126,8 +126,9 @@ public class RsStreamTextureRenderer : MonoBehaviour
         {
             if (frame.IsComposite)
             {
+                // The frameset looks the frame up on its native profile, without wrapping the other frames
                 using (var fs = frame.As<FrameSet>())
-                using (var f = fs.FirstOrDefault(matcher))
+                using (var f = fs[_stream, _format, _streamIndex])
                 {
                     if (f != null)
                         q.Enqueue(f);
@@ -192,7 +193,8 @@ public class RsStreamTextureRenderer : MonoBehaviour
             textureBinding.Invoke(texture);
         }
 
+        // The texture has no mipmaps, and keeps its CPU copy for the next LoadRawTextureData
         texture.LoadRawTextureData(frame.Data, frame.Stride * frame.Height);
-        texture.Apply();
+        texture.Apply(false);
     }
 }
@@ -61,6 +61,12 @@ FTextureUpdateData* FDynamicTexture::AllocBuffer()
 {
 	SCOPED_PROFILER;
 
+	if (PendingUpdates.Increment() > MaxPendingUpdates)
+	{
+		PendingUpdates.Decrement();
+		return nullptr;
+	}
+
 	if (!TudPool.empty())
 	{
 		FScopeLock Lock(&TudMx);
@@ -79,10 +85,30 @@ FTextureUpdateData* FDynamicTexture::AllocBuffer()
 	Tud->Stride = Width * Bpp;
 	Tud->Width = Width;
 	Tud->Height = Height;
+	Tud->Frame = nullptr;
+	Tud->FrameData = nullptr;
+	Tud->FrameStride = 0;
 
 	return Tud;
 }
 
+void FDynamicTexture::ReleaseBuffer(FTextureUpdateData* Tud)
+{
+	if (Tud->Frame)
+	{
+		rs2_release_frame(Tud->Frame);
+		Tud->Frame = nullptr;
+		Tud->FrameData = nullptr;
+	}
+
+	{
+		FScopeLock Lock(&TudMx);
+		TudPool.push_back(Tud);
+	}
+
+	PendingUpdates.Decrement();
+}
+
 void FDynamicTexture::EnqueUpdateCommand(FTextureUpdateData* Tud)
 {
 	SCOPED_PROFILER;
@@ -93,6 +119,7 @@ void FDynamicTexture::EnqueUpdateCommand(FTextureUpdateData* Tud)
 	if (!HackIsValidThread)
 	{
 		REALSENSE_ERR(TEXT("EnqueUpdateCommand: invalid thread"));
+		ReleaseBuffer(Tud);
 	}
 	else if (TextureObject && TextureObject->Resource)
 	{
@@ -103,6 +130,10 @@ void FDynamicTexture::EnqueUpdateCommand(FTextureUpdateData* Tud)
 				Tud->Context->RenderCmd_UpdateTexture(Tud);
 			});
 	}
+	else
+	{
+		ReleaseBuffer(Tud);
+	}
 }
 
 void FDynamicTexture::Update(const rs2::video_frame& Frame)
@@ -121,7 +152,25 @@ void FDynamicTexture::Update(const rs2::video_frame& Frame)
 	}
 
 	auto* Tud = AllocBuffer();
-	CopyData(Tud, Frame);
+	if (!Tud)
+	{
+		return;
+	}
+
+	// The texture is updated from the frame memory, the frame is pinned instead of copied
+	rs2::error_ref e;
+	rs2_frame_add_ref(Frame.get(), &e);
+	if (e.success())
+	{
+		Tud->Frame = Frame.get();
+		Tud->FrameData = Frame.get_data();
+		Tud->FrameStride = Frame.get_stride_in_bytes();
+	}
+	else
+	{
+		CopyData(Tud, Frame);
+	}
+
 	EnqueUpdateCommand(Tud);
 }
 
@@ -182,19 +231,17 @@ void FDynamicTexture::RenderCmd_UpdateTexture(FTextureUpdateData* Tud)
 	auto Tex = Tud->Context->TextureObject;
 	if (Tex && Tex->Resource)
 	{
+		// The RHI copies the data before returning, or into the command list when it defers the update
 		RHIUpdateTexture2D(
 			((FTexture2DResource*)Tex->Resource)->GetTexture2DRHI(), 
 			0, 
 			FUpdateTextureRegion2D(0, 0, 0, 0, Tud->Width, Tud->Height), 
-			Tud->Stride, 
-			(const uint8*)Tud->Data
+			Tud->Frame ? Tud->FrameStride : Tud->Stride, 
+			(const uint8*)(Tud->Frame ? Tud->FrameData : Tud->Data)
 		);
 	}
 
-	{
-		FScopeLock Lock(&TudMx);
-		TudPool.push_back(Tud);
-	}
+	ReleaseBuffer(Tud);
 
 	CommandCounter.Decrement();
 }
@@ -8,6 +8,11 @@ struct FTextureUpdateData
 	uint32 Stride;
 	uint32 Width;
 	uint32 Height;
+
+	// Frame the update is made from instead of Data, pinned until the render thread uploaded it
+	rs2_frame* Frame;
+	const void* FrameData;
+	uint32 FrameStride;
 };
 
 class FDynamicTexture
@@ -20,6 +25,10 @@ private:
 	std::vector<FTextureUpdateData*> TudPool;
 	FThreadSafeCounter CommandCounter;
 
+	// Updates allocated and not uploaded yet, a frame arriving when all are in flight is dropped
+	static const int MaxPendingUpdates = 3;
+	FThreadSafeCounter PendingUpdates;
+
 	FCriticalSection StateMx;
 	FCriticalSection TudMx;
 
@@ -33,6 +42,7 @@ private:
 
 	void RenderCmd_CreateTexture();
 	void RenderCmd_UpdateTexture(FTextureUpdateData* Tud);
+	void ReleaseBuffer(FTextureUpdateData* Tud);
 
 public:
 
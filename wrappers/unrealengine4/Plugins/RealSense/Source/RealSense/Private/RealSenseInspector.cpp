@@ -389,8 +389,11 @@ void ARealSenseInspector::ProcessFrameset(rs2::frameset* Frameset)
 		{
 			NAMED_PROFILER("UpdateDepthColorized");
 			auto* Tud = DepthColorizedDtex->AllocBuffer();
-			rs2_utils::colorize_depth((rs2_utils::depth_pixel*)Tud->Data, DepthFrame, (int)DepthColormap, DepthMin, DepthMax, DepthScale, bEqualizeHistogram);
-			DepthColorizedDtex->EnqueUpdateCommand(Tud);
+			if (Tud)
+			{
+				rs2_utils::colorize_depth((rs2_utils::depth_pixel*)Tud->Data, DepthFrame, (int)DepthColormap, DepthMin, DepthMax, DepthScale, bEqualizeHistogram);
+				DepthColorizedDtex->EnqueUpdateCommand(Tud);
+			}
 		}
 
 		if (bEnablePcl && RsPointCloud.Get() && PclCalculateFlag)